@@ -22,6 +22,7 @@
 
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/coupon.hpp>
+#include <ql/cashflows/compactleg.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/solvers1d/newtonsafe.hpp>
@@ -523,6 +524,118 @@ namespace QuantLib {
         bps = basisPoint_ * bps / d;
     }
 
+    void CashFlows::npvbps(const std::vector<Leg>& legs,
+                           const YieldTermStructure& discountCurve,
+                           bool includeSettlementDateFlows,
+                           Date settlementDate,
+                           Date npvDate,
+                           std::vector<Real>& npvs,
+                           std::vector<Real>& bps) {
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        npvs = std::vector<Real>(legs.size(), 0.0);
+        bps = std::vector<Real>(legs.size(), 0.0);
+
+        // flatten the live cash flows; the npv date goes first
+        std::vector<Date> dates(1, npvDate);
+        std::vector<Real> amounts(1, 0.0), accruals(1, 0.0);
+        std::vector<Size> owners(1, 0);
+        for (Size j=0; j<legs.size(); ++j) {
+            const Leg& leg = legs[j];
+            for (Size i=0; i<leg.size(); ++i) {
+                CashFlow& cf = *leg[i];
+                if (!cf.hasOccurred(settlementDate,
+                                    includeSettlementDateFlows) &&
+                    !cf.tradingExCoupon(settlementDate)) {
+                    dates.push_back(cf.date());
+                    amounts.push_back(cf.amount());
+                    Coupon* cp = dynamic_cast<Coupon*>(&cf);
+                    accruals.push_back(cp != 0 ?
+                                       cp->nominal() * cp->accrualPeriod() :
+                                       0.0);
+                    owners.push_back(j);
+                }
+            }
+        }
+
+        Array discounts;
+        discountCurve.discounts(dates, discounts);
+
+        for (Size k=1; k<dates.size(); ++k) {
+            npvs[owners[k]] += amounts[k] * discounts[k];
+            bps[owners[k]] += accruals[k] * discounts[k];
+        }
+        DiscountFactor d = discounts[0];
+        for (Size j=0; j<legs.size(); ++j) {
+            npvs[j] /= d;
+            bps[j] = basisPoint_ * bps[j] / d;
+        }
+    }
+
+    Real CashFlows::npv(const CompactLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+        Real npv, bps;
+        npvbps(leg, discountCurve, includeSettlementDateFlows,
+               settlementDate, npvDate, npv, bps);
+        return npv;
+    }
+
+    void CashFlows::npvbps(const CompactLeg& leg,
+                           const YieldTermStructure& discountCurve,
+                           bool includeSettlementDateFlows,
+                           Date settlementDate,
+                           Date npvDate,
+                           Real& npv,
+                           Real& bps) {
+
+        npv = bps = 0.0;
+        if (leg.empty())
+            return;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        // the npv date goes first
+        std::vector<Date> dates(1, npvDate);
+        std::vector<Size> flows(1, 0);
+        dates.reserve(leg.size()+1);
+        flows.reserve(leg.size()+1);
+        for (Size i=0; i<leg.size(); ++i) {
+            if (!leg.hasOccurred(i, settlementDate,
+                                 includeSettlementDateFlows) &&
+                !leg.tradingExCoupon(i, settlementDate)) {
+                dates.push_back(leg.date(i));
+                flows.push_back(i);
+            }
+        }
+
+        Array discounts;
+        discountCurve.discounts(dates, discounts);
+
+        const std::vector<Real>& nominals = leg.nominals();
+        const std::vector<Real>& accrualPeriods = leg.accrualPeriods();
+        for (Size k=1; k<dates.size(); ++k) {
+            Size i = flows[k];
+            npv += leg.amount(i) * discounts[k];
+            if (leg.isCoupon(i))
+                bps += nominals[i] * accrualPeriods[i] * discounts[k];
+        }
+        DiscountFactor d = discounts[0];
+        npv /= d;
+        bps = basisPoint_ * bps / d;
+    }
+
     Rate CashFlows::atmRate(const Leg& leg,
                             const YieldTermStructure& discountCurve,
                             bool includeSettlementDateFlows,
@@ -35,6 +35,7 @@
 namespace QuantLib {
 
     class YieldTermStructure;
+    class CompactLeg;
 
     //! %cashflow-analysis functions
     /*! \todo add tests */
@@ -195,6 +196,37 @@ namespace QuantLib {
                            Date npvDate,
                            Real& npv,
                            Real& bps);
+        //! NPV and BPS of several legs discounted on the same curve.
+        /*! The dates and amounts of the cash flows of all legs are
+            collected first; the discount factors are then calculated
+            once for each distinct date by means of
+            YieldTermStructure::discounts.  The results for the i-th
+            leg are returned in npvs[i] and bps[i].
+        */
+        static void npvbps(const std::vector<Leg>& legs,
+                           const YieldTermStructure& discountCurve,
+                           bool includeSettlementDateFlows,
+                           Date settlementDate,
+                           Date npvDate,
+                           std::vector<Real>& npvs,
+                           std::vector<Real>& bps);
+        //! NPV of a compact leg
+        static Real npv(const CompactLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        //! NPV and BPS of a compact leg
+        /*! The discount factors are calculated by means of
+            YieldTermStructure::discounts.
+        */
+        static void npvbps(const CompactLeg& leg,
+                           const YieldTermStructure& discountCurve,
+                           bool includeSettlementDateFlows,
+                           Date settlementDate,
+                           Date npvDate,
+                           Real& npv,
+                           Real& bps);
 
         //! At-the-money rate of the cash flows.
         /*! The result is the fixed rate for which a fixed rate cash flow
@@ -0,0 +1,191 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compactleg.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/simplecashflow.hpp>
+#include <ql/settings.hpp>
+#include <ql/utilities/dataformatters.hpp>
+
+namespace QuantLib {
+
+    CompactLeg::CompactLeg(const Leg& leg) {
+        Size n = leg.size();
+        paymentDates_.reserve(n);
+        accrualStartDates_.reserve(n);
+        accrualEndDates_.reserve(n);
+        exCouponDates_.reserve(n);
+        nominals_.reserve(n);
+        accrualPeriods_.reserve(n);
+        fixedAmounts_.reserve(n);
+        gearings_.reserve(n);
+        spreads_.reserve(n);
+        fixingDates_.reserve(n);
+        fixingValueDates_.reserve(n);
+        fixingEndDates_.reserve(n);
+        spanningTimes_.reserve(n);
+
+        for (Size i=0; i<n; ++i) {
+            const CashFlow& cf = *leg[i];
+            paymentDates_.push_back(cf.date());
+            exCouponDates_.push_back(cf.exCouponDate());
+
+            if (const FixedRateCoupon* c =
+                    dynamic_cast<const FixedRateCoupon*>(&cf)) {
+                accrualStartDates_.push_back(c->accrualStartDate());
+                accrualEndDates_.push_back(c->accrualEndDate());
+                nominals_.push_back(c->nominal());
+                accrualPeriods_.push_back(c->accrualPeriod());
+                fixedAmounts_.push_back(c->amount());
+                gearings_.push_back(0.0);
+                spreads_.push_back(0.0);
+                fixingDates_.push_back(Date());
+                fixingValueDates_.push_back(Date());
+                fixingEndDates_.push_back(Date());
+                spanningTimes_.push_back(0.0);
+            } else if (const IborCoupon* c =
+                           dynamic_cast<const IborCoupon*>(&cf)) {
+                QL_REQUIRE(!c->isInArrears(),
+                           io::ordinal(i+1) << " cash flow: "
+                           "in-arrears coupons not supported");
+                boost::shared_ptr<IborIndex> index =
+                    boost::dynamic_pointer_cast<IborIndex>(c->index());
+                if (!index_)
+                    index_ = index;
+                QL_REQUIRE(index == index_,
+                           io::ordinal(i+1) << " cash flow: "
+                           "coupons with different indexes not supported");
+                accrualStartDates_.push_back(c->accrualStartDate());
+                accrualEndDates_.push_back(c->accrualEndDate());
+                nominals_.push_back(c->nominal());
+                accrualPeriods_.push_back(c->accrualPeriod());
+                fixedAmounts_.push_back(0.0);
+                gearings_.push_back(c->gearing());
+                spreads_.push_back(c->spread());
+                Date fixingDate = c->fixingDate();
+                // same as in the IborCoupon constructor
+                Date valueDate = index->fixingCalendar().advance(
+                                     fixingDate, index->fixingDays(), Days);
+                fixingDates_.push_back(fixingDate);
+                fixingValueDates_.push_back(valueDate);
+                fixingEndDates_.push_back(c->fixingEndDate());
+                spanningTimes_.push_back(index->dayCounter().yearFraction(
+                                             valueDate, c->fixingEndDate()));
+            } else {
+                QL_REQUIRE(dynamic_cast<const SimpleCashFlow*>(&cf),
+                           io::ordinal(i+1) << " cash flow: "
+                           "unsupported cash-flow type");
+                accrualStartDates_.push_back(Date());
+                accrualEndDates_.push_back(Date());
+                nominals_.push_back(Null<Real>());
+                accrualPeriods_.push_back(Null<Real>());
+                fixedAmounts_.push_back(cf.amount());
+                gearings_.push_back(0.0);
+                spreads_.push_back(0.0);
+                fixingDates_.push_back(Date());
+                fixingValueDates_.push_back(Date());
+                fixingEndDates_.push_back(Date());
+                spanningTimes_.push_back(0.0);
+            }
+        }
+    }
+
+    Rate CompactLeg::indexFixing(Size i) const {
+        const Date& fixingDate = fixingDates_[i];
+        if (fixingDate == Date())
+            return Null<Rate>();
+
+        // same logic as IborCoupon::indexFixing
+        Date today = Settings::instance().evaluationDate();
+
+        if (fixingDate>today)
+            return index_->forecastFixing(fixingValueDates_[i],
+                                          fixingEndDates_[i],
+                                          spanningTimes_[i]);
+
+        if (fixingDate<today ||
+            Settings::instance().enforcesTodaysHistoricFixings()) {
+            // do not catch exceptions
+            Rate result = index_->pastFixing(fixingDate);
+            QL_REQUIRE(result != Null<Real>(),
+                       "Missing " << index_->name() << " fixing for "
+                       << fixingDate);
+            return result;
+        }
+
+        try {
+            Rate result = index_->pastFixing(fixingDate);
+            if (result!=Null<Real>())
+                return result;
+        } catch (Error&) {
+            ;   // fall through and forecast
+        }
+        return index_->forecastFixing(fixingValueDates_[i],
+                                      fixingEndDates_[i],
+                                      spanningTimes_[i]);
+    }
+
+    Real CompactLeg::amount(Size i) const {
+        if (fixingDates_[i] == Date())
+            return fixedAmounts_[i];
+        Rate rate = gearings_[i]*indexFixing(i) + spreads_[i];
+        return nominals_[i]*accrualPeriods_[i]*rate;
+    }
+
+    bool CompactLeg::hasOccurred(Size i,
+                                 const Date& refDate,
+                                 boost::optional<bool> includeRefDate) const {
+        // same logic as CashFlow::hasOccurred
+        const Date& cf = paymentDates_[i];
+        if (refDate != Date()) {
+            if (refDate < cf)
+                return false;
+            if (cf < refDate)
+                return true;
+        }
+
+        Date today = Settings::instance().evaluationDate();
+        if (refDate == Date() || refDate == today) {
+            boost::optional<bool> includeToday =
+                Settings::instance().includeTodaysCashFlows();
+            if (includeToday)
+                includeRefDate = *includeToday;
+        }
+
+        Date d = refDate != Date() ? refDate : today;
+        bool includeRefDateEvent =
+            includeRefDate ? *includeRefDate :
+                             Settings::instance().includeReferenceDateEvents();
+        if (includeRefDateEvent)
+            return cf < d;
+        else
+            return cf <= d;
+    }
+
+    bool CompactLeg::tradingExCoupon(Size i, const Date& refDate) const {
+        const Date& ecd = exCouponDates_[i];
+        if (ecd == Date())
+            return false;
+
+        Date ref =
+            refDate != Date() ? refDate : Settings::instance().evaluationDate();
+
+        return ecd <= ref;
+    }
+
+}
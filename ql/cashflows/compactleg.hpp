@@ -0,0 +1,117 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compactleg.hpp
+    \brief columnar representation of fixed-rate and ibor legs
+*/
+
+#ifndef quantlib_compact_leg_hpp
+#define quantlib_compact_leg_hpp
+
+#include <ql/cashflow.hpp>
+#include <ql/indexes/iborindex.hpp>
+#include <boost/optional.hpp>
+
+namespace QuantLib {
+
+    //! columnar representation of fixed-rate and ibor legs
+    /*! This class stores the data of the cash flows of a leg in
+        contiguous arrays (one per attribute) instead of a vector of
+        separately allocated, polymorphic and observable cash flows.
+        It is meant for large portfolios of vanilla legs which are
+        only valued, e.g., through CashFlows::npvbps.
+
+        It can be built from legs containing FixedRateCoupon
+        instances, IborCoupon instances with a single index and not
+        paid in arrears, and SimpleCashFlow instances (e.g.,
+        redemptions).  Fixed amounts are calculated once upon
+        construction; floating amounts are calculated upon request
+        from the fixings or the forwarding curve of the index, using
+        the same rules as IborCoupon when no custom coupon pricer
+        is involved.
+
+        \warning Unlike a Leg, this class is a snapshot of the cash
+                 flows and is not observable; the instruments using
+                 the resulting values are not notified of changes in
+                 the fixings or in the forwarding curve.
+    */
+    class CompactLeg {
+      public:
+        CompactLeg() {}
+        explicit CompactLeg(const Leg& leg);
+        //! \name Inspectors
+        //@{
+        Size size() const { return paymentDates_.size(); }
+        bool empty() const { return paymentDates_.empty(); }
+        //! the index of the floating coupons, or null
+        const boost::shared_ptr<IborIndex>& index() const { return index_; }
+        const std::vector<Date>& paymentDates() const {
+            return paymentDates_;
+        }
+        const std::vector<Date>& accrualStartDates() const {
+            return accrualStartDates_;
+        }
+        const std::vector<Date>& accrualEndDates() const {
+            return accrualEndDates_;
+        }
+        //! null dates for fixed cash flows
+        const std::vector<Date>& fixingDates() const {
+            return fixingDates_;
+        }
+        //! null for cash flows other than coupons
+        const std::vector<Real>& nominals() const { return nominals_; }
+        //! null for cash flows other than coupons
+        const std::vector<Real>& accrualPeriods() const {
+            return accrualPeriods_;
+        }
+        //@}
+        //! \name Cash-flow interface
+        /*! These methods are the counterparts of the corresponding
+            CashFlow methods for the i-th cash flow.
+        */
+        //@{
+        const Date& date(Size i) const { return paymentDates_[i]; }
+        Real amount(Size i) const;
+        bool hasOccurred(Size i,
+                         const Date& refDate = Date(),
+                         boost::optional<bool> includeRefDate =
+                                                        boost::none) const;
+        bool tradingExCoupon(Size i, const Date& refDate = Date()) const;
+        //@}
+        //! \name Coupon interface
+        //@{
+        //! whether the i-th cash flow is a coupon
+        bool isCoupon(Size i) const { return nominals_[i] != Null<Real>(); }
+        //! fixing of the index for the i-th cash flow, or null if fixed
+        Rate indexFixing(Size i) const;
+        //@}
+      private:
+        boost::shared_ptr<IborIndex> index_;
+        std::vector<Date> paymentDates_, accrualStartDates_,
+                          accrualEndDates_, exCouponDates_;
+        std::vector<Real> nominals_, accrualPeriods_;
+        // fixed interest or amount; zero for floating coupons
+        std::vector<Real> fixedAmounts_;
+        // floating coupons
+        std::vector<Real> gearings_, spreads_;
+        std::vector<Date> fixingDates_, fixingValueDates_, fixingEndDates_;
+        std::vector<Time> spanningTimes_;
+    };
+
+}
+
+#endif
@@ -258,17 +258,56 @@ namespace QuantLib {
         Real lowerLimit,
         Real upperLimit,
         Real precision,
-        Real hardUpperLimit)
+        Real hardUpperLimit,
+        Size cacheSize)
     : HaganPricer(swaptionVol, modelOfYieldCurve, meanReversion),
        upperLimit_(upperLimit),
        lowerLimit_(lowerLimit),
        requiredStdDeviations_(8),
        precision_(precision),
        refiningIntegrationTolerance_(.0001),
-       hardUpperLimit_(hardUpperLimit) {
+       hardUpperLimit_(hardUpperLimit),
+       cacheSize_(cacheSize) {
 
     }
 
+    bool NumericHaganPricer::CacheKey::operator<(
+                                           const CacheKey& other) const {
+        if (swapIndex != other.swapIndex)
+            return swapIndex < other.swapIndex;
+        if (fixingDate != other.fixingDate)
+            return fixingDate < other.fixingDate;
+        if (paymentDate != other.paymentDate)
+            return paymentDate < other.paymentDate;
+        if (type != other.type)
+            return type < other.type;
+        return strike < other.strike;
+    }
+
+    void NumericHaganPricer::update() {
+        cacheEntries_.clear();
+        cacheIndex_.clear();
+        notifyObservers();
+    }
+
+    void NumericHaganPricer::initialize(const FloatingRateCoupon& coupon) {
+        HaganPricer::initialize(coupon);
+        Date today = Settings::instance().evaluationDate();
+        if (today != cacheDate_) {
+            cacheEntries_.clear();
+            cacheIndex_.clear();
+            cacheDate_ = today;
+        }
+        if (cacheSize_ > 0) {
+            // the cached results depend on the curves of the index
+            const boost::shared_ptr<SwapIndex>& swapIndex =
+                coupon_->swapIndex();
+            registerWith(swapIndex->forwardingTermStructure());
+            if (swapIndex->exogenousDiscount())
+                registerWith(swapIndex->discountingTermStructure());
+        }
+    }
+
     Real NumericHaganPricer::integrate(Real a,
         Real b, const ConundrumIntegrand& integrand) const {
             Real result =.0;
@@ -326,6 +365,21 @@ namespace QuantLib {
     Real NumericHaganPricer::optionletPrice(
                                 Option::Type optionType, Real strike) const {
 
+        CacheKey key = { coupon_->swapIndex().get(), fixingDate_,
+                         paymentDate_, optionType, strike };
+        if (cacheSize_ > 0) {
+            std::map<CacheKey, cache_entries::iterator>::const_iterator i =
+                cacheIndex_.find(key);
+            if (i != cacheIndex_.end()) {
+                cacheEntries_.splice(cacheEntries_.begin(), cacheEntries_,
+                                     i->second);
+                stdDeviationsForUpperLimit_ = requiredStdDeviations_;
+                upperLimit_ = i->second->upperLimit;
+                return coupon_->accrualPeriod() * (discount_/annuity_) *
+                    i->second->value;
+            }
+        }
+
         boost::shared_ptr<ConundrumIntegrand> integrand(new
             ConundrumIntegrand(vanillaOptionPricer_, rateCurve_, gFunction_,
                                fixingDate_, paymentDate_, annuity_,
@@ -349,10 +403,21 @@ namespace QuantLib {
         Real dFdK = integrand->firstDerivativeOfF(strike);
         Real swaptionPrice =
             (*vanillaOptionPricer_)(strike, optionType, annuity_);
+        Real value = (1 + dFdK) * swaptionPrice + optionType*integralValue;
+
+        if (cacheSize_ > 0) {
+            CacheEntry entry = { key, coupon_->swapIndex(), value,
+                                 upperLimit_ };
+            cacheEntries_.push_front(entry);
+            cacheIndex_[key] = cacheEntries_.begin();
+            if (cacheEntries_.size() > cacheSize_) {
+                cacheIndex_.erase(cacheEntries_.back().key);
+                cacheEntries_.pop_back();
+            }
+        }
 
         // v. HAGAN, Conundrums..., formule 2.17a, 2.18a
-        return coupon_->accrualPeriod() * (discount_/annuity_) *
-            ((1 + dFdK) * swaptionPrice + optionType*integralValue);
+        return coupon_->accrualPeriod() * (discount_/annuity_) * value;
     }
 
     Real NumericHaganPricer::swapletPrice() const {
@@ -25,10 +25,13 @@
 
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <list>
+#include <map>
 
 namespace QuantLib {
 
     class CmsCoupon;
+    class SwapIndex;
     class YieldTermStructure;
     class Quote;
 
@@ -245,6 +248,15 @@ namespace QuantLib {
     /*! Prices a cms coupon via static replication as in Hagan's
         "Conundrums..." article via numerical integration based on
         prices of vanilla swaptions
+
+        The results of the replication only depend on the swap
+        index, the fixing and payment dates, the option type and the
+        strike; they are stored for the given number of most
+        recently used combinations, so that coupons sharing them are
+        replicated only once.  The cache is emptied when the pricer
+        is notified (it registers with the curves of the swap indexes
+        it uses) or when the evaluation date changes; a null size
+        disables it.
     */
     class NumericHaganPricer : public HaganPricer {
       public:
@@ -255,7 +267,12 @@ namespace QuantLib {
             Rate lowerLimit = 0.0,
             Rate upperLimit = 1.0,
             Real precision = 1.0e-6,
-            Real hardUpperLimit = QL_MAX_REAL);
+            Real hardUpperLimit = QL_MAX_REAL,
+            Size cacheSize = 1000);
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
 
        Real upperLimit() { return upperLimit_; }
        Real stdDeviations() { return stdDeviationsForUpperLimit_; }
@@ -311,6 +328,30 @@ namespace QuantLib {
         mutable Real upperLimit_, stdDeviationsForUpperLimit_;
         const Real lowerLimit_, requiredStdDeviations_, precision_, refiningIntegrationTolerance_;
         const Real hardUpperLimit_;
+      protected:
+        void initialize(const FloatingRateCoupon& coupon);
+      private:
+        struct CacheKey {
+            const SwapIndex* swapIndex;
+            Date fixingDate, paymentDate;
+            Option::Type type;
+            Real strike;
+            bool operator<(const CacheKey& other) const;
+        };
+        struct CacheEntry {
+            CacheKey key;
+            // keeps the index in the key alive
+            boost::shared_ptr<SwapIndex> swapIndex;
+            // the optionlet price is accrualPeriod*discount/annuity
+            // times this value
+            Real value;
+            Real upperLimit;
+        };
+        typedef std::list<CacheEntry> cache_entries;
+        Size cacheSize_;
+        mutable cache_entries cacheEntries_;
+        mutable std::map<CacheKey, cache_entries::iterator> cacheIndex_;
+        Date cacheDate_;
     };
 
     //! CMS-coupon pricer
@@ -235,8 +235,9 @@ namespace QuantLib {
         }
         if (fixingDate == today) {
             // might have been fixed
-            Rate pastFixing =
-                IndexManager::instance().getHistory((underlying_->index())->name())[fixingDate];
+            IndexManager& manager = IndexManager::instance();
+            Rate pastFixing = manager.fixing(
+                manager.historyId(underlying_->index()->name()), fixingDate);
             if (pastFixing != Null<Real>()) {
                 return underlyingRate + callCsi_ * callPayoff() + putCsi_  * putPayoff();
             } else
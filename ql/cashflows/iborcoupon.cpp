@@ -27,6 +27,7 @@
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/indexes/interestrateindex.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <map>
 
 using boost::shared_ptr;
 
@@ -48,7 +49,7 @@ namespace QuantLib {
                          fixingDays, iborIndex, gearing, spread,
                          refPeriodStart, refPeriodEnd,
                          dayCounter, isInArrears),
-      iborIndex_(iborIndex) {
+      iborIndex_(iborIndex), forecastFixing_(Null<Rate>()) {
 
         fixingDate_ = fixingDate();
 
@@ -91,10 +92,13 @@ namespace QuantLib {
         */
         Date today = Settings::instance().evaluationDate();
 
-        if (fixingDate_>today)
+        if (fixingDate_>today) {
+            if (forecastFixing_ != Null<Rate>())
+                return forecastFixing_;
             return iborIndex_->forecastFixing(fixingValueDate_,
                                               fixingEndDate_,
                                               spanningTime_);
+        }
 
         if (fixingDate_<today ||
             Settings::instance().enforcesTodaysHistoricFixings()) {
@@ -119,6 +123,11 @@ namespace QuantLib {
                                           spanningTime_);
     }
 
+    void IborCoupon::update() {
+        forecastFixing_ = Null<Rate>();
+        FloatingRateCoupon::update();
+    }
+
     void IborCoupon::accept(AcyclicVisitor& v) {
         Visitor<IborCoupon>* v1 =
             dynamic_cast<Visitor<IborCoupon>*>(&v);
@@ -130,6 +139,48 @@ namespace QuantLib {
 
 
 
+    void forecastIborFixings(const std::vector<Leg>& legs) {
+
+        Date today = Settings::instance().evaluationDate();
+
+        // coupons to forecast, grouped by forwarding curve
+        typedef std::map<const YieldTermStructure*,
+                         std::vector<IborCoupon*> > coupon_map;
+        coupon_map coupons;
+        for (Size j=0; j<legs.size(); ++j) {
+            for (Size i=0; i<legs[j].size(); ++i) {
+                IborCoupon* c = dynamic_cast<IborCoupon*>(legs[j][i].get());
+                if (c == 0 || c->fixingDate_ <= today)
+                    continue;
+                const Handle<YieldTermStructure>& h =
+                    c->iborIndex_->forwardingTermStructure();
+                // leave it to indexFixing to complain
+                if (h.empty())
+                    continue;
+                coupons[h.currentLink().get()].push_back(c);
+            }
+        }
+
+        for (coupon_map::const_iterator k = coupons.begin();
+             k != coupons.end(); ++k) {
+            const std::vector<IborCoupon*>& group = k->second;
+            Size n = group.size();
+            std::vector<Date> dates(2*n);
+            for (Size i=0; i<n; ++i) {
+                dates[2*i] = group[i]->fixingValueDate_;
+                dates[2*i+1] = group[i]->fixingEndDate_;
+            }
+            Array discounts;
+            k->first->discounts(dates, discounts);
+            // same formula as IborIndex::forecastFixing
+            for (Size i=0; i<n; ++i)
+                group[i]->forecastFixing_ =
+                    (discounts[2*i]/discounts[2*i+1] - 1.0)
+                    / group[i]->spanningTime_;
+        }
+    }
+
+
     IborLeg::IborLeg(const Schedule& schedule,
                      const shared_ptr<IborIndex>& index)
     : schedule_(schedule), index_(index),
@@ -55,14 +55,22 @@ namespace QuantLib {
         const boost::shared_ptr<IborIndex>& iborIndex() const {
             return iborIndex_;
         }
+        //! start of the period over which the fixing is forecast
+        const Date& fixingValueDate() const { return fixingValueDate_; }
         //! this is dependent on QL_USE_INDEXED_COUPON
         const Date& fixingEndDate() const { return fixingEndDate_; }
+        //! length of the forecast period, as used by indexFixing()
+        Time spanningTime() const { return spanningTime_; }
         //@}
         //! \name FloatingRateCoupon interface
         //@{
         //! Implemented in order to manage the case of par coupon
         Rate indexFixing() const;
         //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
         //! \name Visitability
         //@{
         virtual void accept(AcyclicVisitor&);
@@ -71,9 +79,29 @@ namespace QuantLib {
         boost::shared_ptr<IborIndex> iborIndex_;
         Date fixingDate_, fixingValueDate_, fixingEndDate_;
         Time spanningTime_;
+        // set by forecastIborFixings; cleared upon notification
+        mutable Rate forecastFixing_;
+        friend void forecastIborFixings(const std::vector<Leg>&);
     };
 
 
+    //! forecasts at once the fixings of the ibor coupons in the given legs
+    /*! The future fixings of the IborCoupon instances in the legs are
+        forecast in a single pass for each forwarding curve: their
+        value and end dates are collected and discounted by means of
+        YieldTermStructure::discounts.  The results are stored in the
+        coupons and returned by their indexFixing method until they
+        receive a notification, e.g., from their index or from a
+        change of evaluation date.
+
+        This is an optimization for portfolios of instances sharing a
+        few indexes; the results are the same as the coupons would
+        calculate.  Other cash flows, including capped or floored
+        coupons, are skipped.
+    */
+    void forecastIborFixings(const std::vector<Leg>& legs);
+
+
     //! helper class building a sequence of capped/floored ibor-rate coupons
     class IborLeg {
       public:
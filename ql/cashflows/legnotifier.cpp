@@ -0,0 +1,61 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/legnotifier.hpp>
+
+namespace QuantLib {
+
+    LegNotifier::LegNotifier(const Leg& leg)
+    : forwarder_(new Forwarder) {
+        for (Size i=0; i<leg.size(); ++i) {
+            boost::shared_ptr<Observer> cf =
+                boost::dynamic_pointer_cast<Observer>(leg[i]);
+            if (cf) {
+                forwarder_->registerWithObservables(cf);
+                cf->unregisterWithAll();
+                forwarder_->cashflows.push_back(cf);
+            }
+        }
+    }
+
+    LegNotifier::~LegNotifier() {
+        std::vector<boost::shared_ptr<Observer> >& cashflows =
+            forwarder_->cashflows;
+        for (Size i=0; i<cashflows.size(); ++i)
+            cashflows[i]->registerWithObservables(forwarder_);
+    }
+
+    void LegNotifier::Forwarder::update() {
+        // as in Observable::notifyObservers, all the cash flows are
+        // notified before any error is reported
+        bool successful = true;
+        std::string errMsg;
+        for (Size i=0; i<cashflows.size(); ++i) {
+            try {
+                cashflows[i]->update();
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+        QL_ENSURE(successful,
+                  "could not notify one or more cash flows: " << errMsg);
+    }
+
+}
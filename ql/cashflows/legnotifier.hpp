@@ -0,0 +1,67 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file legnotifier.hpp
+    \brief registration with market data on behalf of a whole leg
+*/
+
+#ifndef quantlib_leg_notifier_hpp
+#define quantlib_leg_notifier_hpp
+
+#include <ql/cashflow.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace QuantLib {
+
+    //! registration with market data on behalf of a whole leg
+    /*! Floating-rate coupons register with their index, their pricer
+        and the evaluation date; in a leg, each of these observables
+        is thus linked to every coupon, and every coupon holds its
+        own links.
+
+        Upon construction, this class registers once with all the
+        observables of the cash flows of the given leg, and the cash
+        flows are unregistered from them; the notifications are
+        forwarded to the cash flows, which in turn notify the
+        instruments holding them as usual.  Upon destruction, the
+        cash flows are registered again with the shared observables.
+
+        \warning Cash flows registering with further observables
+                 after construction (e.g., when their pricer is
+                 replaced) notify their observers directly; when
+                 they register again upon destruction, each of them
+                 is registered with the observables of the whole
+                 leg, which might cause unneeded notifications.
+    */
+    class LegNotifier : private boost::noncopyable {
+      public:
+        explicit LegNotifier(const Leg& leg);
+        ~LegNotifier();
+        //! the number of cash flows being notified
+        Size size() const { return forwarder_->cashflows.size(); }
+      private:
+        class Forwarder : public Observer {
+          public:
+            void update();
+            std::vector<boost::shared_ptr<Observer> > cashflows;
+        };
+        boost::shared_ptr<Forwarder> forwarder_;
+    };
+
+}
+
+#endif
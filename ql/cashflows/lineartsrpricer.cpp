@@ -45,10 +45,12 @@ namespace QuantLib {
         const Handle<Quote> &meanReversion,
         const Handle<YieldTermStructure> &couponDiscountCurve,
         const Settings &settings,
-        const boost::shared_ptr<Integrator> &integrator)
+        const boost::shared_ptr<Integrator> &integrator,
+        Size cacheSize)
         : CmsCouponPricer(swaptionVol), meanReversion_(meanReversion),
           couponDiscountCurve_(couponDiscountCurve), settings_(settings),
-          volDayCounter_(swaptionVol->dayCounter()), integrator_(integrator) {
+          volDayCounter_(swaptionVol->dayCounter()), integrator_(integrator),
+          cacheSize_(cacheSize), cacheMeanReversion_(Null<Real>()) {
 
         if (!couponDiscountCurve_.empty())
             registerWith(couponDiscountCurve_);
@@ -56,6 +58,20 @@ namespace QuantLib {
         if (integrator_ == NULL)
             integrator_ =
                 boost::make_shared<GaussKronrodNonAdaptive>(1E-10, 5000, 1E-10);
+
+        if (settings_.gaussLegendreNodes_ > 0)
+            gaussLegendre_ = boost::make_shared<GaussLegendreIntegration>(
+                                                settings_.gaussLegendreNodes_);
+    }
+
+    void LinearTsrPricer::update() {
+        clearCache();
+        notifyObservers();
+    }
+
+    void LinearTsrPricer::clearCache() {
+        cacheEntries_.clear();
+        cacheIndex_.clear();
     }
 
     Real LinearTsrPricer::GsrG(const Date &d) const {
@@ -82,11 +98,32 @@ namespace QuantLib {
     }
 
     Real LinearTsrPricer::integrand(const Real strike) const {
-        return 2.0 * a_ * smileSection_->optionPrice(
+        return smileSection_->optionPrice(
                               strike, strike < swapRateValue_ ? Option::Put
                                                               : Option::Call);
     }
 
+    Real LinearTsrPricer::integral(Option::Type type,
+                                   Real lower, Real upper) const {
+        if (!gaussLegendre_)
+            return integrator_->operator()(
+                std::bind1st(std::mem_fun(&LinearTsrPricer::integrand), this),
+                lower, upper);
+
+        // the type is the one integrand() would choose on the interval
+        const Array& x = gaussLegendre_->x();
+        const Array& w = gaussLegendre_->weights();
+        Real c = 0.5 * (upper + lower), h = 0.5 * (upper - lower);
+        std::vector<Rate> strikes(x.size());
+        for (Size i = 0; i < x.size(); ++i)
+            strikes[i] = c + h * x[i];
+        std::vector<Real> prices = smileSection_->optionPrices(strikes, type);
+        Real sum = 0.0;
+        for (Size i = 0; i < x.size(); ++i)
+            sum += w[i] * prices[i];
+        return h * sum;
+    }
+
     void LinearTsrPricer::initialize(const FloatingRateCoupon &coupon) {
 
         coupon_ = dynamic_cast<const CmsCoupon *>(&coupon);
@@ -127,60 +164,116 @@ namespace QuantLib {
         if (fixingDate_ > today_) {
 
             swapTenor_ = swapIndex_->tenor();
-            swap_ = swapIndex_->underlyingSwap(fixingDate_);
+            replication_ = replicationData();
 
-            swapRateValue_ = swap_->fairRate();
-            annuity_ = 1.0E4 * std::fabs(swap_->fixedLegBPS());
+            swap_ = replication_->swap;
+            swapRateValue_ = replication_->swapRateValue;
+            annuity_ = replication_->annuity;
+            smileSection_ = replication_->smileSection;
+            adjustedLowerBound_ = replication_->adjustedLowerBound;
+            adjustedUpperBound_ = replication_->adjustedUpperBound;
 
-            boost::shared_ptr<SmileSection> sectionTmp =
-                swaptionVolatility()->smileSection(fixingDate_, swapTenor_);
+            // compute linear model's parameters
 
-            adjustedLowerBound_ = settings_.lowerRateBound_;
-            adjustedUpperBound_ = settings_.upperRateBound_;
+            Real gamma = replication_->gamma, gy = replication_->gy;
 
-            if(sectionTmp->volatilityType() == Normal) {
-                // adjust lower bound if it was not set explicitly
-                if(settings_.defaultBounds_)
-                    adjustedLowerBound_ = std::min(adjustedLowerBound_, -adjustedUpperBound_);
-            } else {
-                // adjust bounds by section's shift
-                adjustedLowerBound_ -= sectionTmp->shift();
-                adjustedUpperBound_ -= sectionTmp->shift();
-            }
+            a_ = discountCurve_->discount(paymentDate_) *
+                 (gamma - GsrG(paymentDate_)) /
+                 (replication_->lastTerm + swapRateValue_ * gy * gamma);
 
-            // if the section does not provide an atm level, we enhance it to
-            // have one, no need to exit with an exception ...
+            b_ = discountCurve_->discount(paymentDate_) / gy -
+                 a_ * swapRateValue_;
+        }
+    }
 
-            if (sectionTmp->atmLevel() == Null<Real>())
-                smileSection_ = boost::make_shared<AtmSmileSection>(
-                    sectionTmp, swapRateValue_);
-            else
-                smileSection_ = sectionTmp;
+    boost::shared_ptr<LinearTsrPricer::ReplicationData>
+    LinearTsrPricer::replicationData() {
 
-            // compute linear model's parameters
+        Real meanReversion = meanReversion_->value();
+        if (today_ != cacheDate_ || meanReversion != cacheMeanReversion_) {
+            clearCache();
+            cacheDate_ = today_;
+            cacheMeanReversion_ = meanReversion;
+        }
 
-            Real gx = 0.0, gy = 0.0;
-            for (Size i = 0; i < swap_->fixedLeg().size(); i++) {
-                boost::shared_ptr<Coupon> c =
-                    boost::dynamic_pointer_cast<Coupon>(swap_->fixedLeg()[i]);
-                Real yf = c->accrualPeriod();
-                Date d = c->date();
-                Real pv = yf * discountCurve_->discount(d);
-                gx += pv * GsrG(d);
-                gy += pv;
+        cache_key key(swapIndex_.get(), fixingDate_);
+        if (cacheSize_ > 0) {
+            std::map<cache_key, cache_entries::iterator>::const_iterator i =
+                cacheIndex_.find(key);
+            if (i != cacheIndex_.end()) {
+                cacheEntries_.splice(cacheEntries_.begin(), cacheEntries_,
+                                     i->second);
+                return i->second->second;
             }
+        }
 
-            Real gamma = gx / gy;
-            Date lastd = swap_->fixedLeg().back()->date();
+        boost::shared_ptr<ReplicationData> data =
+            boost::make_shared<ReplicationData>();
+        // keeps the index (and thus the key) alive
+        data->swapIndex = swapIndex_;
+        data->swap = swapIndex_->underlyingSwap(fixingDate_);
 
-            a_ = discountCurve_->discount(paymentDate_) *
-                 (gamma - GsrG(paymentDate_)) /
-                 (discountCurve_->discount(lastd) * GsrG(lastd) +
-                  swapRateValue_ * gy * gamma);
+        data->swapRateValue = data->swap->fairRate();
+        data->annuity = 1.0E4 * std::fabs(data->swap->fixedLegBPS());
 
-            b_ = discountCurve_->discount(paymentDate_) / gy -
-                 a_ * swapRateValue_;
+        boost::shared_ptr<SmileSection> sectionTmp =
+            swaptionVolatility()->smileSection(fixingDate_, swapTenor_);
+
+        data->adjustedLowerBound = settings_.lowerRateBound_;
+        data->adjustedUpperBound = settings_.upperRateBound_;
+
+        if(sectionTmp->volatilityType() == Normal) {
+            // adjust lower bound if it was not set explicitly
+            if(settings_.defaultBounds_)
+                data->adjustedLowerBound = std::min(data->adjustedLowerBound,
+                                                    -data->adjustedUpperBound);
+        } else {
+            // adjust bounds by section's shift
+            data->adjustedLowerBound -= sectionTmp->shift();
+            data->adjustedUpperBound -= sectionTmp->shift();
+        }
+
+        // if the section does not provide an atm level, we enhance it to
+        // have one, no need to exit with an exception ...
+
+        if (sectionTmp->atmLevel() == Null<Real>())
+            data->smileSection = boost::make_shared<AtmSmileSection>(
+                sectionTmp, data->swapRateValue);
+        else
+            data->smileSection = sectionTmp;
+
+        // terms of the linear model's parameters not depending on the
+        // payment date
+
+        const Leg& fixedLeg = data->swap->fixedLeg();
+        Real gx = 0.0, gy = 0.0;
+        for (Size i = 0; i < fixedLeg.size(); i++) {
+            boost::shared_ptr<Coupon> c =
+                boost::dynamic_pointer_cast<Coupon>(fixedLeg[i]);
+            Real yf = c->accrualPeriod();
+            Date d = c->date();
+            Real pv = yf * discountCurve_->discount(d);
+            gx += pv * GsrG(d);
+            gy += pv;
+        }
+
+        data->gamma = gx / gy;
+        data->gy = gy;
+        Date lastd = fixedLeg.back()->date();
+        data->lastTerm = discountCurve_->discount(lastd) * GsrG(lastd);
+
+        if (cacheSize_ > 0) {
+            // the cached data depend on the curves of the index
+            registerWith(forwardCurve_);
+            registerWith(discountCurve_);
+            cacheEntries_.push_front(std::make_pair(key, data));
+            cacheIndex_[key] = cacheEntries_.begin();
+            if (cacheEntries_.size() > cacheSize_) {
+                cacheIndex_.erase(cacheEntries_.back().first);
+                cacheEntries_.pop_back();
+            }
         }
+        return data;
     }
 
     Real LinearTsrPricer::strikeFromVegaRatio(Real ratio,
@@ -251,6 +344,28 @@ namespace QuantLib {
         if (optionType == Option::Put && strike <= adjustedLowerBound_)
             return 0.0;
 
+        // the integral doesn't depend on the coupon's payment date, so
+        // it can be shared by the coupons using the same data
+        std::pair<Option::Type, Real> key(optionType, strike);
+        std::map<std::pair<Option::Type, Real>, Real>::const_iterator i =
+            replication_->integrals.find(key);
+        Real result;
+        if (i != replication_->integrals.end()) {
+            result = i->second;
+        } else {
+            result = replicationIntegral(optionType, strike);
+            replication_->integrals[key] = result;
+        }
+
+        result = 2.0 * a_ * result + singularTerms(optionType, strike);
+
+        return annuity_ * result * couponDiscountRatio_ *
+               coupon_->accrualPeriod();
+    }
+
+    Real LinearTsrPricer::replicationIntegral(Option::Type optionType,
+                                              Real strike) const {
+
         // determine lower or upper integration bound (depending on option type)
 
         Real lower = strike, upper = strike;
@@ -326,26 +441,15 @@ namespace QuantLib {
         Real tmpBound;
         if (upper > lower) {
             tmpBound = std::min(upper, swapRateValue_);
-            if (tmpBound > lower) {
-                result += integrator_->operator()(
-                    std::bind1st(std::mem_fun(&LinearTsrPricer::integrand),
-                                 this),
-                    lower, tmpBound);
-            }
+            if (tmpBound > lower)
+                result += integral(Option::Put, lower, tmpBound);
             tmpBound = std::max(lower, swapRateValue_);
-            if (upper > tmpBound) {
-                result += integrator_->operator()(
-                    std::bind1st(std::mem_fun(&LinearTsrPricer::integrand),
-                                 this),
-                    tmpBound, upper);
-            }
+            if (upper > tmpBound)
+                result += integral(Option::Call, tmpBound, upper);
             result *= (optionType == Option::Call ? 1.0 : -1.0);
         }
 
-        result += singularTerms(optionType, strike);
-
-        return annuity_ * result * couponDiscountRatio_ *
-               coupon_->accrualPeriod();
+        return result;
     }
 
     Real LinearTsrPricer::meanReversion() const { return meanReversion_->value(); }
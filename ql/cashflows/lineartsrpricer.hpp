@@ -28,6 +28,9 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/indexes/swapindex.hpp>
 #include <ql/math/integrals/integral.hpp>
+#include <ql/math/integrals/gaussianquadratures.hpp>
+#include <list>
+#include <map>
 
 namespace QuantLib {
 
@@ -57,6 +60,23 @@ namespace QuantLib {
         Note that for normal volatility input the lower rate bound
         is adjusted to min(-upperBound, lowerBound), except the bounds
         are set explicitly.
+
+        The replication integrals only depend on the swap index, the
+        fixing date, the option type and the strike, but not on the
+        payment date of the coupon.  They are stored, together with
+        the swap rate, annuity and smile section for the swap index
+        and fixing date, for the most recently used pairs of swap
+        index and fixing date (up to the given cache size), so that
+        coupons sharing them are replicated only once.  The cache is
+        emptied when the pricer is notified (it registers with the
+        curves of the swap indexes it uses) or when the evaluation
+        date or the mean reversion changes; a null size disables it.
+
+        By default, each integral is calculated with the given
+        integrator; alternatively, Gauss-Legendre nodes can be
+        specified in the settings, in which case the option prices
+        are obtained at all the nodes with a single call to
+        SmileSection::optionPrices().
     */
 
     class LinearTsrPricer : public CmsCouponPricer, public MeanRevertingPricer {
@@ -73,7 +93,7 @@ namespace QuantLib {
                 : strategy_(RateBound), vegaRatio_(0.01),
                   priceThreshold_(1.0E-8), stdDevs_(3.0),
                   lowerRateBound_(defaultLowerBound), upperRateBound_(defaultUpperBound),
-                  defaultBounds_(true) {}
+                  defaultBounds_(true), gaussLegendreNodes_(0) {}
 
             Settings &withRateBound(const Real lowerRateBound = defaultLowerBound,
                                     const Real upperRateBound = defaultUpperBound) {
@@ -177,6 +197,15 @@ namespace QuantLib {
                 return *this;
             }
 
+            //! integrate on the given number of Gauss-Legendre nodes
+            /*! This doesn't change the strategy used for the bounds;
+                a null number of nodes restores the integrator.
+            */
+            Settings &withGaussLegendreNodes(const Size nodes = 64) {
+                gaussLegendreNodes_ = nodes;
+                return *this;
+            }
+
             enum Strategy {
                 RateBound,
                 VegaRatio,
@@ -190,6 +219,7 @@ namespace QuantLib {
             Real stdDevs_;
             Real lowerRateBound_, upperRateBound_;
             bool defaultBounds_;
+            Size gaussLegendreNodes_;
         };
 
 
@@ -199,7 +229,8 @@ namespace QuantLib {
                             Handle<YieldTermStructure>(),
                         const Settings &settings = Settings(),
                         const boost::shared_ptr<Integrator> &integrator =
-                            boost::shared_ptr<Integrator>());
+                            boost::shared_ptr<Integrator>(),
+                        Size cacheSize = 250);
 
         /* */
         virtual Real swapletPrice() const;
@@ -216,15 +247,39 @@ namespace QuantLib {
             registerWith(meanReversion_);
             update();
         }
-
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
 
       private:
 
         Real GsrG(const Date &d) const;
         Real singularTerms(const Option::Type type, const Real strike) const;
         Real integrand(const Real strike) const;
+        Real integral(Option::Type type, Real lower, Real upper) const;
+        Real replicationIntegral(Option::Type type, Real strike) const;
         Real a_, b_;
 
+        // data shared by the coupons with the same swap index and
+        // fixing date; the integrals are keyed by type and strike
+        struct ReplicationData {
+            boost::shared_ptr<SwapIndex> swapIndex;
+            boost::shared_ptr<VanillaSwap> swap;
+            Real swapRateValue, annuity;
+            boost::shared_ptr<SmileSection> smileSection;
+            Real adjustedLowerBound, adjustedUpperBound;
+            // terms of the linear model not depending on the payment
+            Real gamma, gy, lastTerm;
+            std::map<std::pair<Option::Type, Real>, Real> integrals;
+        };
+        typedef std::pair<const SwapIndex*, Date> cache_key;
+        typedef std::list<std::pair<cache_key,
+                                    boost::shared_ptr<ReplicationData> > >
+                                                             cache_entries;
+        boost::shared_ptr<ReplicationData> replicationData();
+        void clearCache();
+
         class VegaRatioHelper {
           public:
             VegaRatioHelper(const SmileSection *section, const Real targetVega)
@@ -279,6 +334,14 @@ namespace QuantLib {
         boost::shared_ptr<Integrator> integrator_;
 
         Real adjustedLowerBound_, adjustedUpperBound_;
+
+        boost::shared_ptr<GaussLegendreIntegration> gaussLegendre_;
+        boost::shared_ptr<ReplicationData> replication_;
+        Size cacheSize_;
+        cache_entries cacheEntries_;
+        std::map<cache_key, cache_entries::iterator> cacheIndex_;
+        Date cacheDate_;
+        Real cacheMeanReversion_;
     };
 }
 
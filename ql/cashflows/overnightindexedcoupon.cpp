@@ -35,6 +35,19 @@ namespace QuantLib {
 
     namespace {
 
+        // compounding factor of the forecast fixings between the
+        // two dates, by means of the telescopic property
+        Real forwardCompoundFactor(const shared_ptr<OvernightIndex>& index,
+                                   const Date& start,
+                                   const Date& end) {
+            Handle<YieldTermStructure> curve =
+                index->forwardingTermStructure();
+            QL_REQUIRE(!curve.empty(),
+                       "null term structure set to this instance of "<<
+                       index->name());
+            return curve->discount(start)/curve->discount(end);
+        }
+
         class OvernightIndexedCouponPricer : public FloatingRateCouponPricer {
           public:
             void initialize(const FloatingRateCoupon& coupon) {
@@ -46,58 +59,50 @@ namespace QuantLib {
                 shared_ptr<OvernightIndex> index =
                     dynamic_pointer_cast<OvernightIndex>(coupon_->index());
 
-                const vector<Date>& fixingDates = coupon_->fixingDates();
-                const vector<Time>& dt = coupon_->dt();
-
-                Size n = dt.size(),
-                     i = 0;
-
-                Real compoundFactor = 1.0;
-
-                // already fixed part
                 Date today = Settings::instance().evaluationDate();
-                while (i<n && fixingDates[i]<today) {
-                    // rate must have been fixed
-                    Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
-                    QL_REQUIRE(pastFixing != Null<Real>(),
-                               "Missing " << index->name() <<
-                               " fixing for " << fixingDates[i]);
-                    compoundFactor *= (1.0 + pastFixing*dt[i]);
-                    ++i;
-                }
-
-                // today is a border case
-                if (i<n && fixingDates[i] == today) {
-                    // might have been fixed
-                    try {
-                        Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
-                        if (pastFixing != Null<Real>()) {
-                            compoundFactor *= (1.0 + pastFixing*dt[i]);
-                            ++i;
-                        } else {
-                            ;   // fall through and forecast
+                Real compoundFactor;
+
+                if (coupon_->firstFixingDate() > today) {
+                    // no past fixings; the daily schedule is not
+                    // needed, since the whole period is forecast
+                    // with a single discount ratio
+                    compoundFactor = forwardCompoundFactor(
+                        index, coupon_->startValueDate(),
+                        coupon_->endValueDate());
+                } else {
+                    const vector<Date>& fixingDates = coupon_->fixingDates();
+                    const vector<Time>& dt = coupon_->dt();
+                    Size n = dt.size(), i;
+
+                    // already fixed part
+                    compoundFactor = coupon_->pastCompoundFactor(today, i);
+
+                    // today is a border case
+                    if (i<n && fixingDates[i] == today) {
+                        // might have been fixed
+                        try {
+                            Rate pastFixing = IndexManager::instance().fixing(
+                                IndexManager::instance().historyId(
+                                                             index->name()),
+                                fixingDates[i]);
+                            if (pastFixing != Null<Real>()) {
+                                compoundFactor *= (1.0 + pastFixing*dt[i]);
+                                ++i;
+                            } else {
+                                ;   // fall through and forecast
+                            }
+                        } catch (Error&) {
+                            ;       // fall through and forecast
                         }
-                    } catch (Error&) {
-                        ;       // fall through and forecast
                     }
-                }
-
-                // forward part using telescopic property in order
-                // to avoid the evaluation of multiple forward fixings
-                if (i<n) {
-                    Handle<YieldTermStructure> curve =
-                        index->forwardingTermStructure();
-                    QL_REQUIRE(!curve.empty(),
-                               "null term structure set to this instance of "<<
-                               index->name());
 
-                    const vector<Date>& dates = coupon_->valueDates();
-                    DiscountFactor startDiscount = curve->discount(dates[i]);
-                    DiscountFactor endDiscount = curve->discount(dates[n]);
-
-                    compoundFactor *= startDiscount/endDiscount;
+                    // forward part using telescopic property in order
+                    // to avoid the evaluation of multiple forward fixings
+                    if (i<n) {
+                        const vector<Date>& dates = coupon_->valueDates();
+                        compoundFactor *=
+                            forwardCompoundFactor(index, dates[i], dates[n]);
+                    }
                 }
 
                 Rate rate = (compoundFactor - 1.0) / coupon_->accrualPeriod();
@@ -130,10 +135,10 @@ namespace QuantLib {
                          overnightIndex->fixingDays(), overnightIndex,
                          gearing, spread,
                          refPeriodStart, refPeriodEnd,
-                         dayCounter, false) {
-
-        // value dates
-        Date tmpEndDate = endDate;
+                         dayCounter, false),
+      startDate_(startDate), endDate_(endDate),
+      telescopicValueDates_(telescopicValueDates), n_(0),
+      pastFixings_(0), pastCompoundFactor_(1.0), pastAccumulatedRate_(0.0) {
 
         /* For the coupon's valuation only the first and last future valuation
            dates matter, therefore we can avoid to construct the whole series
@@ -143,34 +148,58 @@ namespace QuantLib {
            a grace period of 7 business after the evluation date). This will
            lead to false coupon projections (see the warning the class header). */
 
+        scheduleEndDate_ = endDate;
         if (telescopicValueDates) {
             // build optimised value dates schedule: front stub goes
             // from start date to max(evalDate,startDate) + 7bd
             Date evalDate = Settings::instance().evaluationDate();
-            tmpEndDate = overnightIndex->fixingCalendar().advance(
+            scheduleEndDate_ = overnightIndex->fixingCalendar().advance(
                 std::max(startDate, evalDate), 7, Days, Following);
-            tmpEndDate = std::min(tmpEndDate, endDate);
+            scheduleEndDate_ = std::min(scheduleEndDate_, endDate);
         }
+
+        // the first and last value dates are those of the daily
+        // schedule built by initializeValueDates
+        const Calendar& calendar = overnightIndex->fixingCalendar();
+        BusinessDayConvention convention =
+            overnightIndex->businessDayConvention();
+        startValueDate_ = calendar.adjust(startDate, convention);
+        endValueDate_ = calendar.adjust(endDate, convention);
+        QL_ENSURE(startValueDate_ < endValueDate_, "degenerate schedule");
+        firstFixingDate_ = overnightIndex->fixingDays() == 0 ?
+            startValueDate_ : overnightIndex->fixingDate(startValueDate_);
+
+        setPricer(shared_ptr<FloatingRateCouponPricer>(new
+                                            OvernightIndexedCouponPricer));
+    }
+
+    void OvernightIndexedCoupon::initializeValueDates() const {
+        if (!valueDates_.empty())
+            return;
+
+        shared_ptr<OvernightIndex> overnightIndex =
+            dynamic_pointer_cast<OvernightIndex>(index_);
+
         Schedule sch =
             MakeSchedule()
-                .from(startDate)
+                .from(startDate_)
                 // .to(endDate)
-                .to(tmpEndDate)
+                .to(scheduleEndDate_)
                 .withTenor(1 * Days)
                 .withCalendar(overnightIndex->fixingCalendar())
                 .withConvention(overnightIndex->businessDayConvention())
                 .backwards();
         valueDates_ = sch.dates();
 
-        if (telescopicValueDates) {
+        if (telescopicValueDates_) {
             // build optimised value dates schedule: back stub
             // contains at least two dates
             Date tmp = overnightIndex->fixingCalendar().advance(
-                endDate, -1, Days, Preceding);
+                endDate_, -1, Days, Preceding);
             if (tmp != valueDates_.back())
                 valueDates_.push_back(tmp);
             tmp = overnightIndex->fixingCalendar().adjust(
-                endDate, overnightIndex->businessDayConvention());
+                endDate_, overnightIndex->businessDayConvention());
             if (tmp != valueDates_.back())
                 valueDates_.push_back(tmp);
         }
@@ -193,12 +222,128 @@ namespace QuantLib {
         const DayCounter& dc = overnightIndex->dayCounter();
         for (Size i=0; i<n_; ++i)
             dt_[i] = dc.yearFraction(valueDates_[i], valueDates_[i+1]);
+    }
 
-        setPricer(shared_ptr<FloatingRateCouponPricer>(new
-                                            OvernightIndexedCouponPricer));
+    const vector<Date>& OvernightIndexedCoupon::fixingDates() const {
+        initializeValueDates();
+        return fixingDates_;
+    }
+
+    const vector<Time>& OvernightIndexedCoupon::dt() const {
+        initializeValueDates();
+        return dt_;
+    }
+
+    const vector<Date>& OvernightIndexedCoupon::valueDates() const {
+        initializeValueDates();
+        return valueDates_;
+    }
+
+    void OvernightIndexedCoupon::updatePastFixings(const Date& today) const {
+        initializeValueDates();
+
+        if (!fixingsObserver_) {
+            fixingsObserver_ =
+                shared_ptr<FixingsObserver>(new FixingsObserver);
+            fixingsObserver_->registerWith(
+                IndexManager::instance().notifier(index_->name()));
+        }
+        // the product and the sum can be extended if the fixings
+        // didn't change and the date moved forward
+        if (!fixingsObserver_->valid || today < pastFixingsDate_) {
+            pastFixings_ = 0;
+            pastCompoundFactor_ = 1.0;
+            pastAccumulatedRate_ = 0.0;
+            fixingsObserver_->valid = true;
+        }
+
+        Size i = pastFixings_;
+        Real compoundFactor = pastCompoundFactor_;
+        Real accumulatedRate = pastAccumulatedRate_;
+        if (i<n_ && fixingDates_[i]<today) {
+            Size historyId =
+                IndexManager::instance().historyId(index_->name());
+            while (i<n_ && fixingDates_[i]<today) {
+                // rate must have been fixed
+                Rate pastFixing = IndexManager::instance().fixing(
+                                                historyId, fixingDates_[i]);
+                QL_REQUIRE(pastFixing != Null<Real>(),
+                           "Missing " << index_->name() <<
+                           " fixing for " << fixingDates_[i]);
+                compoundFactor *= (1.0 + pastFixing*dt_[i]);
+                accumulatedRate += pastFixing*dt_[i];
+                ++i;
+            }
+        }
+
+        pastFixingsDate_ = today;
+        pastFixings_ = i;
+        pastCompoundFactor_ = compoundFactor;
+        pastAccumulatedRate_ = accumulatedRate;
+    }
+
+    Real OvernightIndexedCoupon::pastCompoundFactor(const Date& today,
+                                                    Size& pastFixings) const {
+        updatePastFixings(today);
+        pastFixings = pastFixings_;
+        return pastCompoundFactor_;
+    }
+
+    Real OvernightIndexedCoupon::pastAccumulatedRate(const Date& today,
+                                                     Size& pastFixings) const {
+        updatePastFixings(today);
+        pastFixings = pastFixings_;
+        return pastAccumulatedRate_;
+    }
+
+    Disposable<vector<Rate> >
+    OvernightIndexedCoupon::forecastFixings(Size first) const {
+        initializeValueDates();
+        QL_REQUIRE(first <= n_,
+                   "first fixing (" << first << ") out of range [0, "
+                   << n_ << "]");
+
+        shared_ptr<OvernightIndex> overnightIndex =
+            dynamic_pointer_cast<OvernightIndex>(index_);
+        if (indexStartDates_.empty()) {
+            indexStartDates_.resize(n_);
+            indexEndDates_.resize(n_);
+            indexDt_.resize(n_);
+            const DayCounter& dc = overnightIndex->dayCounter();
+            for (Size i=0; i<n_; ++i) {
+                indexStartDates_[i] =
+                    overnightIndex->valueDate(fixingDates_[i]);
+                indexEndDates_[i] =
+                    overnightIndex->maturityDate(indexStartDates_[i]);
+                indexDt_[i] =
+                    dc.yearFraction(indexStartDates_[i], indexEndDates_[i]);
+            }
+        }
+
+        Handle<YieldTermStructure> curve =
+            overnightIndex->forwardingTermStructure();
+        QL_REQUIRE(!curve.empty(),
+                   "null term structure set to this instance of "<<
+                   index_->name());
+
+        // consecutive index periods usually share their boundary,
+        // whose discount is then retrieved only once
+        vector<Rate> fixings(n_-first);
+        Date endDate;
+        DiscountFactor endDiscount = 0.0;
+        for (Size i=first; i<n_; ++i) {
+            DiscountFactor startDiscount =
+                indexStartDates_[i] == endDate ?
+                endDiscount : curve->discount(indexStartDates_[i]);
+            endDate = indexEndDates_[i];
+            endDiscount = curve->discount(endDate);
+            fixings[i-first] = (startDiscount/endDiscount - 1.0) / indexDt_[i];
+        }
+        return fixings;
     }
 
     const vector<Rate>& OvernightIndexedCoupon::indexFixings() const {
+        initializeValueDates();
         fixings_.resize(n_);
         for (Size i=0; i<n_; ++i)
             fixings_[i] = index_->fixing(fixingDates_[i]);
@@ -31,6 +31,7 @@
 #include <ql/cashflows/floatingratecoupon.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/time/schedule.hpp>
+#include <ql/utilities/disposable.hpp>
 
 namespace QuantLib {
 
@@ -61,28 +62,77 @@ namespace QuantLib {
         //! \name Inspectors
         //@{
         //! fixing dates for the rates to be compounded
-        const std::vector<Date>& fixingDates() const { return fixingDates_; }
+        const std::vector<Date>& fixingDates() const;
         //! accrual (compounding) periods
-        const std::vector<Time>& dt() const { return dt_; }
+        const std::vector<Time>& dt() const;
         //! fixings to be compounded
         const std::vector<Rate>& indexFixings() const;
         //! value dates for the rates to be compounded
-        const std::vector<Date>& valueDates() const { return valueDates_; }
+        const std::vector<Date>& valueDates() const;
+        //! first value date, available without building the schedule
+        const Date& startValueDate() const { return startValueDate_; }
+        //! last value date, available without building the schedule
+        const Date& endValueDate() const { return endValueDate_; }
+        //! fixing date of the first rate to be compounded
+        const Date& firstFixingDate() const { return firstFixingDate_; }
+        //@}
+        //! \name Calculations
+        //@{
+        /*! returns the compounding factor of the fixings before the
+            given date and sets their number.  The result is cached
+            and extended incrementally as the date moves forward,
+            until the fixings of the index change.
+        */
+        Real pastCompoundFactor(const Date& today,
+                                Size& pastFixings) const;
+        /*! returns the sum of the fixings before the given date,
+            weighted by their accrual periods, and sets their number.
+            The result is cached as for pastCompoundFactor.
+        */
+        Real pastAccumulatedRate(const Date& today,
+                                 Size& pastFixings) const;
+        /*! returns the forecasts of the fixings from the given one
+            on.  The index periods of the fixings are calculated when
+            first needed, so that afterwards only discount factors
+            are retrieved from the forwarding curve.
+        */
+        Disposable<std::vector<Rate> > forecastFixings(Size first) const;
         //@}
         //! \name FloatingRateCoupon interface
         //@{
         //! the date when the coupon is fully determined
-        Date fixingDate() const { return fixingDates_.back(); }
+        Date fixingDate() const { return fixingDates().back(); }
         //@}
         //! \name Visitability
         //@{
         void accept(AcyclicVisitor&);
         //@}
       private:
-        std::vector<Date> valueDates_, fixingDates_;
+        class FixingsObserver : public Observer {
+          public:
+            FixingsObserver() : valid(false) {}
+            void update() { valid = false; }
+            bool valid;
+        };
+        // the daily schedule is only built when needed, e.g., when
+        // past fixings are compounded
+        void initializeValueDates() const;
+        void updatePastFixings(const Date& today) const;
+        Date startDate_, scheduleEndDate_, endDate_;
+        bool telescopicValueDates_;
+        Date startValueDate_, endValueDate_, firstFixingDate_;
+        mutable std::vector<Date> valueDates_, fixingDates_;
         mutable std::vector<Rate> fixings_;
-        Size n_;
-        std::vector<Time> dt_;
+        mutable Size n_;
+        mutable std::vector<Time> dt_;
+        // running product and sum of the past fixings
+        mutable boost::shared_ptr<FixingsObserver> fixingsObserver_;
+        mutable Date pastFixingsDate_;
+        mutable Size pastFixings_;
+        mutable Real pastCompoundFactor_, pastAccumulatedRate_;
+        // start, end and accrual period of the index for each fixing
+        mutable std::vector<Date> indexStartDates_, indexEndDates_;
+        mutable std::vector<Time> indexDt_;
     };
 
 
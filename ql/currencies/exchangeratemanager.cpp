@@ -47,6 +47,8 @@ namespace QuantLib {
                                   const Date& endDate) {
         Key k = hash(rate.source(), rate.target());
         data_[k].push_front(Entry(rate,startDate,endDate));
+        // the new rate might take precedence in any chain
+        cache_.clear();
     }
 
     ExchangeRate ExchangeRateManager::lookup(const Currency& source,
@@ -60,6 +62,77 @@ namespace QuantLib {
         if (date == Date())
             date = Settings::instance().evaluationDate();
 
+        // the key is ordered, unlike the one used for the stored rates
+        CacheKey key(std::make_pair(Key(source.numericCode())*1000
+                                    + Key(target.numericCode()), date),
+                     Integer(type));
+        std::map<CacheKey, ExchangeRate>::const_iterator i =
+            cache_.find(key);
+        if (i != cache_.end())
+            return i->second;
+
+        // failed lookups throw and are not cached
+        ExchangeRate rate = uncachedLookup(source, target, date, type);
+        cache_.insert(std::make_pair(key, rate));
+        return rate;
+    }
+
+    std::vector<Money> ExchangeRateManager::convert(
+                                         const std::vector<Money>& amounts,
+                                         const Currency& target,
+                                         Date date,
+                                         ExchangeRate::Type type) const {
+        const Size n = amounts.size();
+        std::vector<Currency> sources(n);
+        std::vector<Real> factors(n);
+        for (Size i=0; i<n; ++i)
+            sources[i] = amounts[i].currency();
+        if (n > 0)
+            conversionFactors(n, &sources[0], target, &factors[0],
+                              date, type);
+
+        std::vector<Money> results;
+        results.reserve(n);
+        for (Size i=0; i<n; ++i)
+            results.push_back(
+                Money(amounts[i].value()*factors[i], target).rounded());
+        return results;
+    }
+
+    void ExchangeRateManager::conversionFactors(
+                                             Size n,
+                                             const Currency* sources,
+                                             const Currency& target,
+                                             Real* factors,
+                                             Date date,
+                                             ExchangeRate::Type type) const {
+        if (date == Date())
+            date = Settings::instance().evaluationDate();
+
+        // each distinct currency is looked up once
+        std::map<Integer, Real> factorsByCode;
+        for (Size i=0; i<n; ++i) {
+            Integer code = sources[i].numericCode();
+            std::map<Integer, Real>::const_iterator f =
+                factorsByCode.find(code);
+            if (f == factorsByCode.end()) {
+                Real factor = 1.0;
+                if (sources[i] != target) {
+                    ExchangeRate rate =
+                        lookup(sources[i], target, date, type);
+                    factor = rate.exchange(Money(1.0, sources[i])).value();
+                }
+                f = factorsByCode.insert(std::make_pair(code, factor)).first;
+            }
+            factors[i] = f->second;
+        }
+    }
+
+    ExchangeRate ExchangeRateManager::uncachedLookup(
+                                             const Currency& source,
+                                             const Currency& target,
+                                             const Date& date,
+                                             ExchangeRate::Type type) const {
         if (type == ExchangeRate::Direct) {
             return directLookup(source,target,date);
         } else if (!source.triangulationCurrency().empty()) {
@@ -83,6 +156,7 @@ namespace QuantLib {
 
     void ExchangeRateManager::clear() {
         data_.clear();
+        cache_.clear();
         addKnownRates();
     }
 
@@ -34,8 +34,14 @@
 namespace QuantLib {
 
     //! exchange-rate repository
-    /*! \test lookup of direct, triangulated, and derived exchange
-              rates is tested.
+    /*! The results of lookups are cached for each pair of currencies,
+        date and type of rate, so that repeated conversions don't
+        search the stored rates again; the cache is emptied when a
+        rate is added or the rates are cleared.
+
+        \test lookup of direct, triangulated, and derived exchange
+              rates is tested; cached lookups and bulk conversions
+              are tested against the stored rates.
     */
     class ExchangeRateManager : public Singleton<ExchangeRateManager> {
         friend class Singleton<ExchangeRateManager>;
@@ -66,6 +72,31 @@ namespace QuantLib {
                             Date date = Date(),
                             ExchangeRate::Type type =
                                                  ExchangeRate::Derived) const;
+        /*! Convert the given amounts to the target currency at the
+            given date.  The exchange rates are looked up once for
+            each distinct currency of the amounts; the converted
+            amounts are rounded as in Money conversions.
+
+            \warning the results might differ from those of separate
+                     conversions of each amount by a rounding error
+                     when the rate is derived from a chain of rates.
+        */
+        std::vector<Money> convert(const std::vector<Money>& amounts,
+                                   const Currency& target,
+                                   Date date = Date(),
+                                   ExchangeRate::Type type =
+                                                 ExchangeRate::Derived) const;
+        /*! Fill the given array with the factors converting one unit
+            of each of the given currencies into the target currency.
+            The factors can be reused for any number of amounts.
+        */
+        void conversionFactors(Size n,
+                               const Currency* sources,
+                               const Currency& target,
+                               Real* factors,
+                               Date date = Date(),
+                               ExchangeRate::Type type =
+                                                 ExchangeRate::Derived) const;
         //! remove the added exchange rates
         void clear();
 
@@ -80,9 +111,16 @@ namespace QuantLib {
       private:
         typedef BigInteger Key;
         mutable std::map<Key, std::list<Entry> > data_;
+        // results of lookup, by source, target, date and type
+        typedef std::pair<std::pair<Key,Date>,Integer> CacheKey;
+        mutable std::map<CacheKey, ExchangeRate> cache_;
         Key hash(const Currency&, const Currency&) const;
         bool hashes(Key, const Currency&) const;
         void addKnownRates();
+        ExchangeRate uncachedLookup(const Currency& source,
+                                    const Currency& target,
+                                    const Date& date,
+                                    ExchangeRate::Type type) const;
         ExchangeRate directLookup(const Currency& source,
                                   const Currency& target,
                                   const Date& date) const;
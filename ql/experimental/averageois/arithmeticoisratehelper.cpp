@@ -20,6 +20,7 @@
 #include <ql/experimental/averageois/arithmeticoisratehelper.hpp>
 #include <ql/experimental/averageois/makearithmeticaverageois.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
 
 using boost::shared_ptr;
 
@@ -47,7 +48,7 @@ namespace QuantLib {
       fixedLegPaymentFrequency_(fixedLegPaymentFrequency),
       overnightLegPaymentFrequency_(overnightLegPaymentFrequency),
       spread_(spread), mrs_(meanReversionSpeed), vol_(volatility),
-      byApprox_(byApprox){
+      byApprox_(byApprox), fixedCoupons_(0) {
         registerWith(overnightIndex_);
         registerWith(discountHandle_);
         registerWith(spread_);
@@ -72,6 +73,28 @@ namespace QuantLib {
         
         earliestDate_ = swap_->startDate();
         latestDate_ = swap_->maturityDate();
+
+        // the cash flows are flattened once, so that the bootstrap
+        // only needs the overnight coupon rates and the discounts
+        coupons_.clear();
+        for (Size j=0; j<2; ++j) {
+            const Leg& leg = j == 0 ? swap_->fixedLeg() : swap_->overnightLeg();
+            for (Size i=0; i<leg.size(); ++i) {
+                shared_ptr<Coupon> c =
+                    boost::dynamic_pointer_cast<Coupon>(leg[i]);
+                QL_REQUIRE(c, "coupon expected");
+                coupons_.push_back(c);
+            }
+            if (j == 0)
+                fixedCoupons_ = coupons_.size();
+        }
+        paymentDates_.resize(coupons_.size());
+        accruals_.resize(coupons_.size());
+        for (Size i=0; i<coupons_.size(); ++i) {
+            paymentDates_[i] = coupons_[i]->date();
+            accruals_[i] =
+                coupons_[i]->nominal() * coupons_[i]->accrualPeriod();
+        }
     }
 
     void ArithmeticOISRateHelper::setTermStructure(YieldTermStructure* t) {
@@ -92,17 +115,35 @@ namespace QuantLib {
 
     Real ArithmeticOISRateHelper::impliedQuote() const {
         QL_REQUIRE(termStructure_ != 0, "term structure not set");
-        // we didn't register as observers - force calculation
-        swap_->recalculate();
-        //return swap_->fairRate();
-        // weak implementation... to be improved
-        static const Spread basisPoint = 1.0e-4;
-        Real floatingLegNPV = swap_->overnightLegNPV();
+        // the swap is not recalculated; its alive coupons are
+        // discounted directly, as a discounting swap engine would
+        const YieldTermStructure& discountCurve =
+            **discountRelinkableHandle_;
+        Date settlementDate = discountCurve.referenceDate();
+        alive_.clear();
+        aliveDates_.clear();
+        for (Size i=0; i<coupons_.size(); ++i) {
+            if (!coupons_[i]->hasOccurred(settlementDate)) {
+                alive_.push_back(i);
+                aliveDates_.push_back(paymentDates_[i]);
+            }
+        }
+        discountCurve.discounts(aliveDates_, discounts_);
+
+        Real fixedLegBPS = 0.0, overnightLegBPS = 0.0, floatingLegNPV = 0.0;
+        for (Size k=0; k<alive_.size(); ++k) {
+            Size i = alive_[k];
+            if (i < fixedCoupons_) {
+                fixedLegBPS += accruals_[i] * discounts_[k];
+            } else {
+                floatingLegNPV += coupons_[i]->amount() * discounts_[k];
+                overnightLegBPS += accruals_[i] * discounts_[k];
+            }
+        }
+        // the swap pays the fixed leg
         Spread spread = spread_.empty() ? 0.0 : spread_->value();
-        Real spreadNPV = swap_->overnightLegBPS() / basisPoint*spread;
-        Real totNPV = -(floatingLegNPV + spreadNPV);
-        Real result = totNPV / (swap_->fixedLegBPS() / basisPoint);
-        return result;
+        Real totNPV = -(floatingLegNPV + overnightLegBPS*spread);
+        return totNPV / (-fixedLegBPS);
     }
 
     void ArithmeticOISRateHelper::accept(AcyclicVisitor& v) {
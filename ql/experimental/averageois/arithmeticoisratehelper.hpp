@@ -26,6 +26,7 @@
 
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/experimental/averageois/arithmeticaverageois.hpp>
+#include <ql/cashflows/coupon.hpp>
 
 namespace QuantLib {
 
@@ -78,7 +79,16 @@ namespace QuantLib {
         Real mrs_;
         Real vol_;
         bool byApprox_;
- 
+
+        // coupons of the fixed leg followed by those of the overnight
+        // leg, with their payment dates and nominal times accrual
+        std::vector<boost::shared_ptr<Coupon> > coupons_;
+        std::vector<Date> paymentDates_;
+        std::vector<Real> accruals_;
+        Size fixedCoupons_;
+        mutable std::vector<Size> alive_;
+        mutable std::vector<Date> aliveDates_;
+        mutable Array discounts_;
     };
 
 }
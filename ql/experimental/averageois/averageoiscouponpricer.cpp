@@ -40,33 +40,35 @@ namespace QuantLib {
         shared_ptr<OvernightIndex> index =
             dynamic_pointer_cast<OvernightIndex>(coupon_->index());
 
+        Date today = Settings::instance().evaluationDate();
+
+        /* forward part using telescopic property in order
+        to avoid the evaluation of multiple forward fixings
+        (approximation proposed by Katsumi Takada); if there are no
+        past fixings, the daily schedule is not needed */
+        if (byApprox_ && coupon_->firstFixingDate() > today) {
+            Rate rate = forwardAccumulatedRate(index,
+                                               coupon_->startValueDate(),
+                                               coupon_->endValueDate())
+                      / coupon_->accrualPeriod();
+            return coupon_->gearing() * rate + coupon_->spread();
+        }
+
         const vector<Date>& fixingDates = coupon_->fixingDates();
         const vector<Time>& dt = coupon_->dt();
 
-        Size n = dt.size(),
-            i = 0;
-
-        Real accumulatedRate = 0.0;
+        Size n = dt.size(), i;
 
         // already fixed part
-        Date today = Settings::instance().evaluationDate();
-        while (i < n && fixingDates[i] < today) {
-            // rate must have been fixed
-            Rate pastFixing = IndexManager::instance().getHistory(
-                index->name())[fixingDates[i]];
-            QL_REQUIRE(pastFixing != Null<Real>(),
-                "Missing " << index->name() <<
-                " fixing for " << fixingDates[i]);
-            accumulatedRate += pastFixing*dt[i];
-            ++i;
-        }
+        Real accumulatedRate = coupon_->pastAccumulatedRate(today, i);
 
         // today is a border case
         if (i < n && fixingDates[i] == today) {
             // might have been fixed
             try {
-                Rate pastFixing = IndexManager::instance().getHistory(
-                    index->name())[fixingDates[i]];
+                Rate pastFixing = IndexManager::instance().fixing(
+                    IndexManager::instance().historyId(index->name()),
+                    fixingDates[i]);
                 if (pastFixing != Null<Real>()) {
                     accumulatedRate += pastFixing*dt[i];
                     ++i;
@@ -80,25 +82,10 @@ namespace QuantLib {
             }
         }
 
-        /* forward part using telescopic property in order
-        to avoid the evaluation of multiple forward fixings
-        (approximation proposed by Katsumi Takada)*/
         if (byApprox_ && i < n) {
-            Handle<YieldTermStructure> curve =
-                index->forwardingTermStructure();
-            QL_REQUIRE(!curve.empty(),
-                "null term structure set to this instance of " <<
-                index->name());
-
             const vector<Date>& dates = coupon_->valueDates();
-            DiscountFactor startDiscount = curve->discount(dates[i]);
-            DiscountFactor endDiscount = curve->discount(dates[n]);
-
-            accumulatedRate += log(startDiscount / endDiscount) - 
-                convAdj1(curve->timeFromReference(dates[i]),
-                         curve->timeFromReference(dates[n])) -
-                convAdj2(curve->timeFromReference(dates[i]),
-                         curve->timeFromReference(dates[n]));
+            accumulatedRate +=
+                forwardAccumulatedRate(index, dates[i], dates[n]);
         }
         // otherwise
         else if (i < n){
@@ -109,20 +96,29 @@ namespace QuantLib {
                 index->name());
 
             const vector<Date>& dates = coupon_->valueDates();
-            Time te = curve->timeFromReference(dates[n]);
-            while (i < n) {
+            // the forecasts only need discount factors; a missing
+            // fixing for today goes through the index, which might
+            // enforce its presence
+            const vector<Rate> forecastFixings =
+                coupon_->forecastFixings(i);
+            Time te = vol_ != 0.0 ? curve->timeFromReference(dates[n]) : 0.0;
+            for (Size k=0; i < n; ++i, ++k) {
                 // forcast fixing
-                Rate forecastFixing = index->fixing(fixingDates[i]);
-                Time ti1 = curve->timeFromReference(dates[i]);
-                Time ti2 = curve->timeFromReference(dates[i + 1]);
+                Rate forecastFixing = fixingDates[i] == today ?
+                    index->fixing(fixingDates[i]) : forecastFixings[k];
                 /*convexity adjustment due to payment dalay of each
-                overnight fixing, supposing an Hull-White short rate model*/
-                Real convAdj = exp( 0.5*pow(vol_, 2.0) / pow(mrs_, 3.0)*
-                    (exp(2 * mrs_*ti1) - 1)*
-                    (exp(-mrs_*ti2) - exp(-mrs_*te))*
-                    (exp(-mrs_*ti2) - exp(-mrs_*ti1)) );
+                overnight fixing, supposing an Hull-White short rate model;
+                it's null without volatility*/
+                Real convAdj = 1.0;
+                if (vol_ != 0.0) {
+                    Time ti1 = curve->timeFromReference(dates[i]);
+                    Time ti2 = curve->timeFromReference(dates[i + 1]);
+                    convAdj = exp( 0.5*pow(vol_, 2.0) / pow(mrs_, 3.0)*
+                        (exp(2 * mrs_*ti1) - 1)*
+                        (exp(-mrs_*ti2) - exp(-mrs_*te))*
+                        (exp(-mrs_*ti2) - exp(-mrs_*ti1)) );
+                }
                 accumulatedRate += convAdj*(1 + forecastFixing*dt[i]) - 1;
-                ++i;
             }
         }
 
@@ -130,6 +126,24 @@ namespace QuantLib {
         return coupon_->gearing() * rate + coupon_->spread();
     }
 
+    Real ArithmeticAveragedOvernightIndexedCouponPricer::forwardAccumulatedRate(
+                                    const shared_ptr<OvernightIndex>& index,
+                                    const Date& start,
+                                    const Date& end) const {
+        Handle<YieldTermStructure> curve =
+            index->forwardingTermStructure();
+        QL_REQUIRE(!curve.empty(),
+            "null term structure set to this instance of " <<
+            index->name());
+
+        DiscountFactor startDiscount = curve->discount(start);
+        DiscountFactor endDiscount = curve->discount(end);
+        Time ts = curve->timeFromReference(start);
+        Time te = curve->timeFromReference(end);
+        return log(startDiscount / endDiscount) -
+            convAdj1(ts, te) - convAdj2(ts, te);
+    }
+
     Real ArithmeticAveragedOvernightIndexedCouponPricer::convAdj1(
                                                     Time ts, Time te) const {
         return vol_ * vol_ / (4.0 * pow(mrs_, 3.0)) *
@@ -50,6 +50,12 @@ namespace QuantLib {
         Real floorletPrice(Rate) const { QL_FAIL("floorletPrice not available"); }
         Rate floorletRate(Rate) const { QL_FAIL("floorletRate not available"); }
     protected:
+        // accumulated rate between the two dates according to the
+        // Takada approximation
+        Real forwardAccumulatedRate(
+                            const boost::shared_ptr<OvernightIndex>& index,
+                            const Date& start,
+                            const Date& end) const;
         Real convAdj1(Time ts, Time te) const;
         Real convAdj2(Time ts, Time te) const;
         const OvernightIndexedCoupon* coupon_;
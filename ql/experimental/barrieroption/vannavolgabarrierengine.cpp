@@ -20,14 +20,10 @@
 #include <ql/experimental/barrieroption/vannavolgabarrierengine.hpp>
 #include <ql/experimental/barrieroption/vannavolgainterpolation.hpp>
 #include <ql/experimental/fx/blackdeltacalculator.hpp>
-#include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/pricingengines/barrier/analyticbarrierengine.hpp>
-#include <ql/quotes/simplequote.hpp>
-#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/pricingengines/blackformula.hpp>
-#include <ql/math/matrix.hpp>
-#include <ql/time/calendars/nullcalendar.hpp>
-#include <boost/make_shared.hpp>
+#include <ql/exercise.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 
 using std::pow;
 using std::log;
@@ -35,6 +31,247 @@ using std::sqrt;
 
 namespace QuantLib {
 
+    VannaVolgaBarrierCalculator::VannaVolgaBarrierCalculator(
+                                        const DeltaVolQuote& atmVol,
+                                        const DeltaVolQuote& vol25Put,
+                                        const DeltaVolQuote& vol25Call,
+                                        Real spotFX,
+                                        const YieldTermStructure& domesticTS,
+                                        const YieldTermStructure& foreignTS,
+                                        const Date& exerciseDate)
+    : spot_(spotFX), T_(atmVol.maturity()),
+      domesticDiscount_(domesticTS.discount(T_)),
+      foreignDiscount_(foreignTS.discount(T_)),
+      atmVol_(atmVol.value()),
+      residualTime_(domesticTS.timeFromReference(exerciseDate)),
+      riskFreeDiscount_(domesticTS.discount(residualTime_)),
+      dividendDiscount_(foreignTS.discount(residualTime_)) {
+
+        QL_REQUIRE(vol25Put.delta() == -0.25, "25 delta put is required by vanna volga method");
+        QL_REQUIRE(vol25Call.delta() == 0.25, "25 delta call is required by vanna volga method");
+        QL_REQUIRE(vol25Put.maturity() == vol25Call.maturity() && vol25Put.maturity() == atmVol.maturity(),
+            "Maturity of 3 vols are not the same");
+
+        BlackDeltaCalculator blackDeltaCalculatorAtm(
+                        Option::Call, atmVol.deltaType(), spot_,
+                        domesticDiscount_, foreignDiscount_,
+                        atmVol_ * sqrt(T_));
+        Real atmStrike = blackDeltaCalculatorAtm.atmStrike(atmVol.atmType());
+
+        Real call25Vol = vol25Call.value();
+        Real put25Vol = vol25Put.value();
+
+        BlackDeltaCalculator blackDeltaCalculatorPut25(Option::Put, vol25Put.deltaType(), spot_,
+                                                      domesticDiscount_, foreignDiscount_,
+                                                      put25Vol * sqrt(T_));
+        Real put25Strike = blackDeltaCalculatorPut25.strikeFromDelta(-0.25);
+        BlackDeltaCalculator blackDeltaCalculatorCall25(Option::Call, vol25Call.deltaType(), spot_,
+                                                      domesticDiscount_, foreignDiscount_,
+                                                      call25Vol * sqrt(T_));
+        Real call25Strike = blackDeltaCalculatorCall25.strikeFromDelta(0.25);
+
+        //vanna volga interpolated smile used to price vanillas
+        strikes_.push_back(put25Strike);
+        vols_.push_back(put25Vol);
+        strikes_.push_back(atmStrike);
+        vols_.push_back(atmVol_);
+        strikes_.push_back(call25Strike);
+        vols_.push_back(call25Vol);
+        VannaVolga vannaVolga(spot_, domesticDiscount_, foreignDiscount_, T_);
+        smile_ = vannaVolga.interpolate(strikes_.begin(), strikes_.end(), vols_.begin());
+        smile_.enableExtrapolation();
+
+        Real forward = spot_ * foreignDiscount_ / domesticDiscount_;
+
+        //smile costs of the pillar options
+        Array costs(3);
+        // the ATM pillar is quoted with the ATM volatility
+        costs[0] = 0.0;
+        costs[1] = blackFormula(Option::Call, call25Strike, forward,
+                                call25Vol * sqrt(T_), domesticDiscount_)
+                 - blackFormula(Option::Call, call25Strike, forward,
+                                atmVol_ * sqrt(T_), domesticDiscount_);
+        costs[2] = blackFormula(Option::Put, put25Strike, forward,
+                                put25Vol * sqrt(T_), domesticDiscount_)
+                 - blackFormula(Option::Put, put25Strike, forward,
+                                atmVol_ * sqrt(T_), domesticDiscount_);
+
+        //Analytical Black Scholes vega, vanna and volga of the pillars
+        NormalDistribution norm;
+        Matrix A(3,3,0.0);
+        Real pillarStrikes[] = { atmStrike, call25Strike, put25Strike };
+        for (Size j=0; j<3; ++j) {
+            Real d1 = (std::log(forward/pillarStrikes[j])
+                       + 0.5*std::pow(atmVol_,2.0) * T_)/(atmVol_ * sqrt(T_));
+            Real vega = spot_ * norm(d1) * sqrt(T_) * foreignDiscount_;
+            A[0][j] = vega;
+            A[1][j] = vega/spot_ *(1.0 - d1/(atmVol_*sqrt(T_)));
+            A[2][j] = vega * d1 * (d1 - atmVol_ * sqrt(T_))/atmVol_;
+        }
+
+        // the adjustment costs*inverse(A)*b is linear in the barrier
+        // greeks b, so that the weights can be calculated once
+        weights_ = transpose(inverse(A)) * costs;
+
+        mu_ = domesticTS.zeroRate(T_, Continuous) - foreignTS.zeroRate(T_, Continuous) - pow(atmVol_, 2.0)/2.0;
+    }
+
+    Real VannaVolgaBarrierCalculator::barrierValue(Barrier::Type barrierType,
+                                                   Real barrier,
+                                                   Real rebate,
+                                                   Option::Type type,
+                                                   Real strike,
+                                                   Real spot,
+                                                   Volatility vol) const {
+        return analyticBarrierValue(barrierType, type, strike, barrier,
+                                    rebate, spot, vol, residualTime_,
+                                    riskFreeDiscount_, dividendDiscount_);
+    }
+
+    VannaVolgaBarrierCalculator::Results
+    VannaVolgaBarrierCalculator::calculate(Barrier::Type barrierType,
+                                           Real barrier,
+                                           Real rebate,
+                                           Option::Type type,
+                                           Real strike,
+                                           Real bsPriceWithSmile) const {
+
+        QL_REQUIRE(barrierType == Barrier::UpIn || barrierType == Barrier::UpOut ||
+            barrierType == Barrier::DownIn || barrierType == Barrier::DownOut,
+            "Invalid barrier type");
+
+        const Real sigmaShift_vega = 0.0001;
+        const Real sigmaShift_volga = 0.0001;
+        const Real spotShift_delta = 0.0001 * spot_;
+        const Real sigmaShift_vanna = 0.0001;
+
+        const bool adaptVanDelta = (bsPriceWithSmile != Null<Real>());
+
+        //vanilla option price
+        Real strikeVol = smile_(strike);
+        Real vanillaOption = blackFormula(type, strike,
+                                      spot_* foreignDiscount_/ domesticDiscount_,
+                                      strikeVol * sqrt(T_),
+                                      domesticDiscount_);
+
+        Results results;
+        results.lambda = Null<Real>();
+
+        //barrier already touched
+        if ((spot_ >= barrier && (barrierType == Barrier::UpOut || barrierType == Barrier::UpIn))
+            || (spot_ <= barrier && (barrierType == Barrier::DownOut || barrierType == Barrier::DownIn))) {
+            Real vanilla = adaptVanDelta ? bsPriceWithSmile : vanillaOption;
+            if (barrierType == Barrier::UpOut || barrierType == Barrier::DownOut)
+                results.value = 0.0;
+            else
+                results.value = vanilla;
+            results.vanillaPrice = vanilla;
+            results.inPrice = vanilla;
+            results.outPrice = 0.0;
+            return results;
+        }
+
+        //only calculate out barrier option price
+        // in barrier price = vanilla - out barrier
+        Barrier::Type outType =
+            (barrierType == Barrier::UpOut || barrierType == Barrier::UpIn) ?
+            Barrier::UpOut : Barrier::DownOut;
+
+        //BS price with atm vol
+        Real priceBS = barrierValue(outType, barrier, rebate, type, strike,
+                                    spot_, atmVol_);
+
+        //BS vega
+        Real vegaBarBS =
+            (barrierValue(outType, barrier, rebate, type, strike,
+                          spot_, atmVol_ + sigmaShift_vega)
+             - priceBS)/sigmaShift_vega;
+
+        //BS volga
+        Real priceBS2 = barrierValue(outType, barrier, rebate, type, strike,
+                                     spot_, atmVol_ + sigmaShift_volga);
+        Real vegaBarBS2 =
+            (barrierValue(outType, barrier, rebate, type, strike, spot_,
+                          atmVol_ + sigmaShift_volga + sigmaShift_vega)
+             - priceBS2)/sigmaShift_vega;
+        Real volgaBarBS = (vegaBarBS2 - vegaBarBS)/sigmaShift_volga;
+
+        //BS vanna
+        Real deltaBar1 =
+            (barrierValue(outType, barrier, rebate, type, strike,
+                          spot_ + spotShift_delta, atmVol_)
+             - barrierValue(outType, barrier, rebate, type, strike,
+                            spot_ - spotShift_delta, atmVol_))
+            /(2.0*spotShift_delta);
+        Real deltaBar2 =
+            (barrierValue(outType, barrier, rebate, type, strike,
+                          spot_ + spotShift_delta, atmVol_ + sigmaShift_vanna)
+             - barrierValue(outType, barrier, rebate, type, strike,
+                            spot_ - spotShift_delta, atmVol_ + sigmaShift_vanna))
+            /(2.0*spotShift_delta);
+        Real vannaBarBS = (deltaBar2 - deltaBar1)/sigmaShift_vanna;
+
+        //touch probability
+        CumulativeNormalDistribution cnd;
+        Real h2 = (log(barrier/spot_) + mu_*T_)/(atmVol_*sqrt(T_));
+        Real h2Prime = (log(spot_/barrier) + mu_*T_)/(atmVol_*sqrt(T_));
+        Real probTouch = 0.0;
+        if (outType == Barrier::UpOut)
+            probTouch = cnd(h2Prime) + pow(barrier/spot_, 2.0*mu_/pow(atmVol_, 2.0))*cnd(-h2);
+        else
+            probTouch = cnd(-h2Prime) + pow(barrier/spot_, 2.0*mu_/pow(atmVol_, 2.0))*cnd(h2);
+        Real p_survival = 1.0 - probTouch;
+
+        Real lambda = p_survival ;
+        Real adjust = weights_[0]*vegaBarBS
+                    + weights_[1]*vannaBarBS
+                    + weights_[2]*volgaBarBS;
+        Real outPrice = priceBS + lambda*adjust;
+        Real inPrice;
+
+        //adapt Vanilla delta
+        if (adaptVanDelta) {
+            outPrice += lambda*(bsPriceWithSmile - vanillaOption);
+            //capfloored by (0, vanilla)
+            outPrice = std::max(0.0, std::min(bsPriceWithSmile, outPrice));
+            inPrice = bsPriceWithSmile - outPrice;
+        }
+        else{
+            //capfloored by (0, vanilla)
+            outPrice = std::max(0.0, std::min(vanillaOption, outPrice));
+            inPrice = vanillaOption - outPrice;
+        }
+
+        if (barrierType == Barrier::DownOut || barrierType == Barrier::UpOut)
+            results.value = outPrice;
+        else
+            results.value = inPrice;
+        results.vanillaPrice = vanillaOption;
+        results.inPrice = inPrice;
+        results.outPrice = outPrice;
+        results.lambda = lambda;
+        return results;
+    }
+
+    std::vector<Real> VannaVolgaBarrierCalculator::values(
+                          const std::vector<Barrier::Type>& barrierTypes,
+                          const std::vector<Real>& barriers,
+                          const std::vector<Real>& rebates,
+                          const std::vector<Option::Type>& types,
+                          const std::vector<Real>& strikes) const {
+        Size n = barrierTypes.size();
+        QL_REQUIRE(barriers.size() == n && rebates.size() == n
+                   && types.size() == n && strikes.size() == n,
+                   "barrier types, barriers, rebates, option types "
+                   "and strikes must have the same size");
+        std::vector<Real> result(n);
+        for (Size i=0; i<n; ++i)
+            result[i] = calculate(barrierTypes[i], barriers[i], rebates[i],
+                                  types[i], strikes[i]).value;
+        return result;
+    }
+
+
     VannaVolgaBarrierEngine::VannaVolgaBarrierEngine(
             const Handle<DeltaVolQuote>& atmVol,
             const Handle<DeltaVolQuote>& vol25Put,
@@ -70,295 +307,30 @@ namespace QuantLib {
 
     void VannaVolgaBarrierEngine::calculate() const {
 
-        QL_REQUIRE(arguments_.barrierType == Barrier::UpIn || arguments_.barrierType == Barrier::UpOut ||
-            arguments_.barrierType == Barrier::DownIn || arguments_.barrierType == Barrier::DownOut,
-            "Invalid barrier type");
-
-        const Real sigmaShift_vega = 0.0001;
-        const Real sigmaShift_volga = 0.0001;
-        const Real spotShift_delta = 0.0001 * spotFX_->value();
-        const Real sigmaShift_vanna = 0.0001;
-
-        Handle<Quote> x0Quote(
-            boost::make_shared<SimpleQuote>(spotFX_->value())); //used for shift
-        Handle<Quote> atmVolQuote(
-            boost::make_shared<SimpleQuote>(atmVol_->value())); //used for shift
-
-        boost::shared_ptr<BlackVolTermStructure> blackVolTS =
-            boost::make_shared<BlackConstantVol>(
-                Settings::instance().evaluationDate(),
-                NullCalendar(), atmVolQuote, Actual365Fixed());
-        boost::shared_ptr<BlackScholesMertonProcess> stochProcess =
-            boost::make_shared<BlackScholesMertonProcess>(
-                                 x0Quote,
-                                 foreignTS_,
-                                 domesticTS_,
-                                 Handle<BlackVolTermStructure>(blackVolTS));
-
-        boost::shared_ptr<PricingEngine> engineBS =
-            boost::make_shared<AnalyticBarrierEngine>(stochProcess);
-
-        BlackDeltaCalculator blackDeltaCalculatorAtm(
-                        Option::Call, atmVol_->deltaType(), x0Quote->value(),
-                        domesticTS_->discount(T_), foreignTS_->discount(T_),
-                        atmVol_->value() * sqrt(T_));
-        Real atmStrike = blackDeltaCalculatorAtm.atmStrike(atmVol_->atmType());
-
-        Real call25Vol = vol25Call_->value();
-        Real put25Vol = vol25Put_->value();
-
-        BlackDeltaCalculator blackDeltaCalculatorPut25(Option::Put, vol25Put_->deltaType(), x0Quote->value(), 
-                                                      domesticTS_->discount(T_), foreignTS_->discount(T_),
-                                                      put25Vol * sqrt(T_));
-        Real put25Strike = blackDeltaCalculatorPut25.strikeFromDelta(-0.25);
-        BlackDeltaCalculator blackDeltaCalculatorCall25(Option::Call, vol25Call_->deltaType(), x0Quote->value(), 
-                                                      domesticTS_->discount(T_), foreignTS_->discount(T_),
-                                                      call25Vol * sqrt(T_));
-        Real call25Strike = blackDeltaCalculatorCall25.strikeFromDelta(0.25);
-
-
-        //here use vanna volga interpolated smile to price vanilla
-        std::vector<Real> strikes;
-        std::vector<Real> vols;
-        strikes.push_back(put25Strike);
-        vols.push_back(put25Vol);
-        strikes.push_back(atmStrike);
-        vols.push_back(atmVol_->value());
-        strikes.push_back(call25Strike);
-        vols.push_back(call25Vol);
-        VannaVolga vannaVolga(x0Quote->value(), domesticTS_->discount(T_), foreignTS_->discount(T_), T_);
-        Interpolation interpolation = vannaVolga.interpolate(strikes.begin(), strikes.end(), vols.begin());
-        interpolation.enableExtrapolation();
         const boost::shared_ptr<StrikedTypePayoff> payoff =
                                         boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
-        Real strikeVol = interpolation(payoff->strike());
-
-        //vanilla option price
-        Real vanillaOption = blackFormula(payoff->optionType(), payoff->strike(), 
-                                      x0Quote->value()* foreignTS_->discount(T_)/ domesticTS_->discount(T_), 
-                                      strikeVol * sqrt(T_),
-                                      domesticTS_->discount(T_));
-
-        //spot > barrier up&out 0
-        if(x0Quote->value() >= arguments_.barrier && arguments_.barrierType == Barrier::UpOut){
-            results_.value = 0.0;
-            results_.additionalResults["VanillaPrice"] = adaptVanDelta_? bsPriceWithSmile_ : vanillaOption;
-            results_.additionalResults["BarrierInPrice"] = adaptVanDelta_? bsPriceWithSmile_ : vanillaOption;
-            results_.additionalResults["BarrierOutPrice"] = 0.0;
-        }
-        //spot > barrier up&in vanilla
-        else if(x0Quote->value() >= arguments_.barrier && arguments_.barrierType == Barrier::UpIn){
-            results_.value = adaptVanDelta_? bsPriceWithSmile_ : vanillaOption;
-            results_.additionalResults["VanillaPrice"] = adaptVanDelta_? bsPriceWithSmile_ : vanillaOption;
-            results_.additionalResults["BarrierInPrice"] = adaptVanDelta_? bsPriceWithSmile_ : vanillaOption;
-            results_.additionalResults["BarrierOutPrice"] = 0.0;
-        }
-        //spot < barrier down&out 0
-        else if(x0Quote->value() <= arguments_.barrier && arguments_.barrierType == Barrier::DownOut){
-            results_.value = 0.0;
-            results_.additionalResults["VanillaPrice"] = adaptVanDelta_? bsPriceWithSmile_ : vanillaOption;
-            results_.additionalResults["BarrierInPrice"] = adaptVanDelta_? bsPriceWithSmile_ : vanillaOption;
-            results_.additionalResults["BarrierOutPrice"] = 0.0;
-        }
-        //spot < barrier down&in vanilla
-        else if(x0Quote->value() <= arguments_.barrier && arguments_.barrierType == Barrier::DownIn){
-            results_.value = adaptVanDelta_? bsPriceWithSmile_ : vanillaOption;
-            results_.additionalResults["VanillaPrice"] = adaptVanDelta_? bsPriceWithSmile_ : vanillaOption;
-            results_.additionalResults["BarrierInPrice"] = adaptVanDelta_? bsPriceWithSmile_ : vanillaOption;
-            results_.additionalResults["BarrierOutPrice"] = 0.0;
-        }
-        else{
-
-            //set up BS barrier option pricing
-            //only calculate out barrier option price
-            // in barrier price = vanilla - out barrier
-            Barrier::Type barrierType;
-            if(arguments_.barrierType == Barrier::UpOut)
-                barrierType = arguments_.barrierType;
-            else if(arguments_.barrierType == Barrier::UpIn)
-                barrierType = Barrier::UpOut;
-            else if(arguments_.barrierType == Barrier::DownOut)
-                barrierType = arguments_.barrierType;
-            else
-                barrierType = Barrier::DownOut;
-
-            BarrierOption barrierOption(barrierType,
-                                        arguments_.barrier,
-                                        arguments_.rebate,
-                                        boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff),
-                                        arguments_.exercise);
-
-            barrierOption.setPricingEngine(engineBS);
-
-            //BS price with atm vol
-            Real priceBS = barrierOption.NPV();
-
-            Real priceAtmCallBS = blackFormula(Option::Call,atmStrike,
-                                              x0Quote->value()* foreignTS_->discount(T_)/ domesticTS_->discount(T_), 
-                                              atmVol_->value() * sqrt(T_),
-                                              domesticTS_->discount(T_));
-            Real price25CallBS = blackFormula(Option::Call,call25Strike,
-                                              x0Quote->value()* foreignTS_->discount(T_)/ domesticTS_->discount(T_), 
-                                              atmVol_->value() * sqrt(T_),
-                                              domesticTS_->discount(T_));
-            Real price25PutBS = blackFormula(Option::Put,put25Strike,
-                                              x0Quote->value()* foreignTS_->discount(T_)/ domesticTS_->discount(T_),
-                                              atmVol_->value() * sqrt(T_),
-                                              domesticTS_->discount(T_));
-
-            //market price
-            Real priceAtmCallMkt = blackFormula(Option::Call,atmStrike,
-                                              x0Quote->value()* foreignTS_->discount(T_)/ domesticTS_->discount(T_), 
-                                              atmVol_->value() * sqrt(T_),
-                                              domesticTS_->discount(T_));
-
-            Real price25CallMkt = blackFormula(Option::Call,call25Strike,
-                                              x0Quote->value()* foreignTS_->discount(T_)/ domesticTS_->discount(T_), 
-                                              call25Vol * sqrt(T_),
-                                              domesticTS_->discount(T_));
-            Real price25PutMkt = blackFormula(Option::Put,put25Strike,
-                                              x0Quote->value()* foreignTS_->discount(T_)/ domesticTS_->discount(T_),
-                                              put25Vol * sqrt(T_),
-                                              domesticTS_->discount(T_));
-
-
-            //Analytical Black Scholes formula for vanilla option
-            NormalDistribution norm;
-            Real d1atm = (std::log(x0Quote->value()* foreignTS_->discount(T_)/ domesticTS_->discount(T_)/atmStrike) 
-                           + 0.5*std::pow(atmVolQuote->value(),2.0) * T_)/(atmVolQuote->value() * sqrt(T_));
-            Real vegaAtm_Analytical = x0Quote->value() * norm(d1atm) * sqrt(T_) * foreignTS_->discount(T_);
-            Real vannaAtm_Analytical = vegaAtm_Analytical/x0Quote->value() *(1.0 - d1atm/(atmVolQuote->value()*sqrt(T_)));
-            Real volgaAtm_Analytical = vegaAtm_Analytical * d1atm * (d1atm - atmVolQuote->value() * sqrt(T_))/atmVolQuote->value();
-
-            Real d125call = (std::log(x0Quote->value()* foreignTS_->discount(T_)/ domesticTS_->discount(T_)/call25Strike) 
-                           + 0.5*std::pow(atmVolQuote->value(),2.0) * T_)/(atmVolQuote->value() * sqrt(T_));
-            Real vega25Call_Analytical = x0Quote->value() * norm(d125call) * sqrt(T_) * foreignTS_->discount(T_);
-            Real vanna25Call_Analytical = vega25Call_Analytical/x0Quote->value() *(1.0 - d125call/(atmVolQuote->value()*sqrt(T_)));
-            Real volga25Call_Analytical = vega25Call_Analytical * d125call * (d125call - atmVolQuote->value() * sqrt(T_))/atmVolQuote->value();
-
-            Real d125Put = (std::log(x0Quote->value()* foreignTS_->discount(T_)/ domesticTS_->discount(T_)/put25Strike) 
-                           + 0.5*std::pow(atmVolQuote->value(),2.0) * T_)/(atmVolQuote->value() * sqrt(T_));
-            Real vega25Put_Analytical = x0Quote->value() * norm(d125Put) * sqrt(T_) * foreignTS_->discount(T_);
-            Real vanna25Put_Analytical = vega25Put_Analytical/x0Quote->value() *(1.0 - d125Put/(atmVolQuote->value()*sqrt(T_)));
-            Real volga25Put_Analytical = vega25Put_Analytical * d125Put * (d125Put - atmVolQuote->value() * sqrt(T_))/atmVolQuote->value();
-
-
-            //BS vega
-            boost::static_pointer_cast<SimpleQuote> (atmVolQuote.currentLink())->setValue(atmVolQuote->value() + sigmaShift_vega);
-            barrierOption.recalculate();
-            Real vegaBarBS = (barrierOption.NPV() - priceBS)/sigmaShift_vega;
-
-            boost::static_pointer_cast<SimpleQuote> (atmVolQuote.currentLink())->setValue(atmVolQuote->value() - sigmaShift_vega);//setback
-
-            //BS volga
-
-            //vegaBar2
-            //base NPV
-            boost::static_pointer_cast<SimpleQuote> (atmVolQuote.currentLink())->setValue(atmVolQuote->value() + sigmaShift_volga);
-            barrierOption.recalculate();
-            Real priceBS2 = barrierOption.NPV();
-
-            //shifted npv
-            boost::static_pointer_cast<SimpleQuote> (atmVolQuote.currentLink())->setValue(atmVolQuote->value() + sigmaShift_vega);
-            barrierOption.recalculate();
-            Real vegaBarBS2 = (barrierOption.NPV() - priceBS2)/sigmaShift_vega;
-            Real volgaBarBS = (vegaBarBS2 - vegaBarBS)/sigmaShift_volga;
-
-            boost::static_pointer_cast<SimpleQuote> (atmVolQuote.currentLink())->setValue(atmVolQuote->value() 
-                                                                                               - sigmaShift_volga 
-                                                                                               - sigmaShift_vega);//setback
-
-            //BS Delta
-            //base delta
-            boost::static_pointer_cast<SimpleQuote> (x0Quote.currentLink())->setValue(x0Quote->value() + spotShift_delta);//shift forth
-            barrierOption.recalculate();
-            Real priceBS_delta1 = barrierOption.NPV();
-
-            boost::static_pointer_cast<SimpleQuote> (x0Quote.currentLink())->setValue(x0Quote->value() - 2 * spotShift_delta);//shift back
-            barrierOption.recalculate();
-            Real priceBS_delta2 = barrierOption.NPV();
-
-            boost::static_pointer_cast<SimpleQuote> (x0Quote.currentLink())->setValue(x0Quote->value() +  spotShift_delta);//set back
-            Real deltaBar1 = (priceBS_delta1 - priceBS_delta2)/(2.0*spotShift_delta);
-
-            //shifted delta
-            boost::static_pointer_cast<SimpleQuote> (atmVolQuote.currentLink())->setValue(atmVolQuote->value() + sigmaShift_vanna);//shift sigma
-            boost::static_pointer_cast<SimpleQuote> (x0Quote.currentLink())->setValue(x0Quote->value() + spotShift_delta);//shift forth
-            barrierOption.recalculate();
-            priceBS_delta1 = barrierOption.NPV();
-
-            boost::static_pointer_cast<SimpleQuote> (x0Quote.currentLink())->setValue(x0Quote->value() - 2 * spotShift_delta);//shift back
-            barrierOption.recalculate();
-            priceBS_delta2 = barrierOption.NPV();
-
-            boost::static_pointer_cast<SimpleQuote> (x0Quote.currentLink())->setValue(x0Quote->value() +  spotShift_delta);//set back
-            Real deltaBar2 = (priceBS_delta1 - priceBS_delta2)/(2.0*spotShift_delta);
-
-            Real vannaBarBS = (deltaBar2 - deltaBar1)/sigmaShift_vanna;
-
-            boost::static_pointer_cast<SimpleQuote> (atmVolQuote.currentLink())->setValue(atmVolQuote->value() - sigmaShift_vanna);//set back
-
-            //Matrix
-            Matrix A(3,3,0.0);
-
-            //analytical
-            A[0][0] = vegaAtm_Analytical;
-            A[0][1] = vega25Call_Analytical;
-            A[0][2] = vega25Put_Analytical;
-            A[1][0] = vannaAtm_Analytical;
-            A[1][1] = vanna25Call_Analytical;
-            A[1][2] = vanna25Put_Analytical;
-            A[2][0] = volgaAtm_Analytical;
-            A[2][1] = volga25Call_Analytical;
-            A[2][2] = volga25Put_Analytical;
-
-            Array b(3,0.0);
-            b[0] = vegaBarBS;
-            b[1] = vannaBarBS;
-            b[2] = volgaBarBS;
-
-            Array q = inverse(A) * b;
-
-            //touch probability
-            CumulativeNormalDistribution cnd;
-            Real mu = domesticTS_->zeroRate(T_, Continuous) - foreignTS_->zeroRate(T_, Continuous) - pow(atmVol_->value(), 2.0)/2.0;
-            Real h2 = (log(arguments_.barrier/x0Quote->value()) + mu*T_)/(atmVol_->value()*sqrt(T_));
-            Real h2Prime = (log(x0Quote->value()/arguments_.barrier) + mu*T_)/(atmVol_->value()*sqrt(T_));
-            Real probTouch = 0.0;
-            if(arguments_.barrierType == Barrier::UpIn || arguments_.barrierType == Barrier::UpOut)
-                probTouch = cnd(h2Prime) + pow(arguments_.barrier/x0Quote->value(), 2.0*mu/pow(atmVol_->value(), 2.0))*cnd(-h2);
-            else
-                probTouch = cnd(-h2Prime) + pow(arguments_.barrier/x0Quote->value(), 2.0*mu/pow(atmVol_->value(), 2.0))*cnd(h2);
-            Real p_survival = 1.0 - probTouch;
-
-            Real lambda = p_survival ;
-            Real adjust = q[0]*(priceAtmCallMkt - priceAtmCallBS) 
-                        + q[1]*(price25CallMkt - price25CallBS)
-                        + q[2]*(price25PutMkt - price25PutBS);
-            Real outPrice = priceBS + lambda*adjust;//
-            Real inPrice;
-
-            //adapt Vanilla delta
-            if(adaptVanDelta_ == true){
-                outPrice += lambda*(bsPriceWithSmile_ - vanillaOption);
-                //capfloored by (0, vanilla)
-                outPrice = std::max(0.0, std::min(bsPriceWithSmile_, outPrice));
-                inPrice = bsPriceWithSmile_ - outPrice;
-            }
-            else{
-                //capfloored by (0, vanilla)
-                outPrice = std::max(0.0, std::min(vanillaOption, outPrice));
-                inPrice = vanillaOption - outPrice;
-            }
-
-            if(arguments_.barrierType == Barrier::DownOut || arguments_.barrierType == Barrier::UpOut)
-                results_.value = outPrice;
-            else
-                results_.value = inPrice;
-            results_.additionalResults["VanillaPrice"] = vanillaOption;
-            results_.additionalResults["BarrierInPrice"] = inPrice;
-            results_.additionalResults["BarrierOutPrice"] = outPrice;
-            results_.additionalResults["lambda"] = lambda;
-         }
+        QL_REQUIRE(payoff, "non-striked payoff given");
+
+        VannaVolgaBarrierCalculator calculator(
+                                    **atmVol_, **vol25Put_, **vol25Call_,
+                                    spotFX_->value(),
+                                    **domesticTS_, **foreignTS_,
+                                    arguments_.exercise->lastDate());
+        VannaVolgaBarrierCalculator::Results results =
+            calculator.calculate(arguments_.barrierType,
+                                 arguments_.barrier,
+                                 arguments_.rebate,
+                                 payoff->optionType(),
+                                 payoff->strike(),
+                                 adaptVanDelta_ ? bsPriceWithSmile_
+                                                : Null<Real>());
+
+        results_.value = results.value;
+        results_.additionalResults["VanillaPrice"] = results.vanillaPrice;
+        results_.additionalResults["BarrierInPrice"] = results.inPrice;
+        results_.additionalResults["BarrierOutPrice"] = results.outPrice;
+        if (results.lambda != Null<Real>())
+            results_.additionalResults["lambda"] = results.lambda;
     }
+
 }
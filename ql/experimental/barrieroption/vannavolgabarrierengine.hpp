@@ -27,9 +27,79 @@
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/instruments/dividendbarrieroption.hpp>
 #include <ql/experimental/fx/deltavolquote.hpp>
+#include <ql/math/interpolation.hpp>
+#include <ql/math/matrix.hpp>
+#include <boost/noncopyable.hpp>
 
 namespace QuantLib {
 
+    //! Vanna Volga pricing of barrier options sharing a smile
+    /*! The quantities depending only on the currency pair and on the
+        expiry, i.e., the strikes of the three pillar options, the
+        interpolated smile, the smile costs of the pillar options and
+        the inverse of their vega/vanna/volga matrix, are calculated
+        once by the constructor.  Barrier options are then priced by
+        analyticBarrierValue() without building instruments, processes
+        or engines, which makes the class suitable for books holding
+        many barrier options with the same expiry.
+
+        The Black-Scholes barrier prices are calculated with the ATM
+        volatility and the time to the exercise date; the smile uses
+        the maturity of the volatility quotes.
+    */
+    class VannaVolgaBarrierCalculator : private boost::noncopyable {
+      public:
+        struct Results {
+            Real value;
+            Real vanillaPrice;
+            Real inPrice;
+            Real outPrice;
+            //! survival probability; null if the barrier was touched
+            Real lambda;
+        };
+        VannaVolgaBarrierCalculator(const DeltaVolQuote& atmVol,
+                                    const DeltaVolQuote& vol25Put,
+                                    const DeltaVolQuote& vol25Call,
+                                    Real spotFX,
+                                    const YieldTermStructure& domesticTS,
+                                    const YieldTermStructure& foreignTS,
+                                    const Date& exerciseDate);
+        /*! If given, the vanilla price with smile replaces the one
+            implied by the vanna-volga smile as in the adapted vanilla
+            delta variant of VannaVolgaBarrierEngine.
+        */
+        Results calculate(Barrier::Type barrierType,
+                          Real barrier,
+                          Real rebate,
+                          Option::Type type,
+                          Real strike,
+                          Real bsPriceWithSmile = Null<Real>()) const;
+        //! values of several options; all vectors must have the same size
+        std::vector<Real> values(
+                          const std::vector<Barrier::Type>& barrierTypes,
+                          const std::vector<Real>& barriers,
+                          const std::vector<Real>& rebates,
+                          const std::vector<Option::Type>& types,
+                          const std::vector<Real>& strikes) const;
+      private:
+        Real barrierValue(Barrier::Type barrierType, Real barrier,
+                          Real rebate, Option::Type type, Real strike,
+                          Real spot, Volatility vol) const;
+        Real spot_;
+        Time T_;
+        DiscountFactor domesticDiscount_, foreignDiscount_;
+        Volatility atmVol_;
+        Rate mu_;
+        Time residualTime_;
+        DiscountFactor riskFreeDiscount_, dividendDiscount_;
+        std::vector<Real> strikes_, vols_;
+        Interpolation smile_;
+        // smile costs of the pillar options times the inverse of
+        // their vega/vanna/volga matrix
+        Array weights_;
+    };
+
+
     //! Vanna Volga barrier option engine
 
     /*!
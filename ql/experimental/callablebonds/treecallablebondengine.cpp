@@ -66,9 +66,7 @@ namespace QuantLib {
         if (lattice_) {
             lattice = lattice_;
         } else {
-            std::vector<Time> times = callableBond.mandatoryTimes();
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
+            lattice = latticeFor(callableBond.mandatoryTimes());
         }
 
         Time redemptionTime =
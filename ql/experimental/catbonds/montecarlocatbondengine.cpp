@@ -20,15 +20,18 @@
 #include <ql/experimental/catbonds/montecarlocatbondengine.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <algorithm>
+#include <numeric>
 
 namespace QuantLib {
 
     MonteCarloCatBondEngine::MonteCarloCatBondEngine(
                              const boost::shared_ptr<CatRisk> catRisk,
                              const Handle<YieldTermStructure>& discountCurve,
-                             boost::optional<bool> includeSettlementDateFlows)
+                             boost::optional<bool> includeSettlementDateFlows,
+                             Size maxPaths)
     : catRisk_(catRisk), discountCurve_(discountCurve),
-      includeSettlementDateFlows_(includeSettlementDateFlows) {
+      includeSettlementDateFlows_(includeSettlementDateFlows),
+      maxPaths_(maxPaths) {
         registerWith(discountCurve_);
     }
 
@@ -73,7 +76,6 @@ namespace QuantLib {
 
     Real MonteCarloCatBondEngine::npv(bool includeSettlementDateFlows, Date settlementDate, Date npvDate, Real& lossProbability, Real &exhaustionProbability, Real& expectedLoss) const
     {
-        const size_t MAX_PATHS = 10000; //TODO
         lossProbability =  0.0;
         exhaustionProbability = 0.0;
         expectedLoss = 0.0;
@@ -86,51 +88,67 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real totalNPV = 0.0;
+        // the discounted amounts don't depend on the path; each path
+        // only scales them by its notional rates on the payment dates
+        std::vector<Date> dates;
+        std::vector<Real> discountedAmounts;
+        for (Size i=0; i<arguments_.cashflows.size(); ++i) {
+            const boost::shared_ptr<CashFlow>& cf = arguments_.cashflows[i];
+            if (!cf->hasOccurred(settlementDate, includeSettlementDateFlows)) {
+                dates.push_back(cf->date());
+                discountedAmounts.push_back(
+                           cf->amount()*discountCurve_->discount(cf->date())); //TODO: fix for more complicated cashflows
+            }
+        }
+        const Real riskFreeNPV = std::accumulate(discountedAmounts.begin(),
+                                                 discountedAmounts.end(), 0.0);
+
         Date effectiveDate = std::max(arguments_.startDate, settlementDate);
         Date maturityDate = (*arguments_.cashflows.rbegin())->date();
         boost::shared_ptr<CatSimulation> catSimulation = catRisk_->newSimulation(effectiveDate, maturityDate);
-        std::vector<std::pair<Date, Real> > eventsPath;
-        NotionalPath notionalPath;
-        Real riskFreeNPV = pathNpv(includeSettlementDateFlows, settlementDate, notionalPath);
-        size_t pathCount=0;
-        while(catSimulation->nextPath(eventsPath) && pathCount<MAX_PATHS)
-        {
-            arguments_.notionalRisk->updatePath(eventsPath, notionalPath);
-            if(notionalPath.loss()>0) { //optimization, most paths will not include any loss
-                totalNPV += pathNpv(includeSettlementDateFlows, settlementDate, notionalPath);
-                lossProbability+=1;
-                if (notionalPath.loss()==1) 
-                    exhaustionProbability+=1;
-                expectedLoss+=notionalPath.loss();
-            } else {
-                totalNPV += riskFreeNPV;
-            }
-            pathCount++;
-        }
-        lossProbability/=pathCount;
-        exhaustionProbability/=pathCount;
-        expectedLoss/=pathCount;
-        return totalNPV/(pathCount*discountCurve_->discount(npvDate));
-    }
 
-    Real MonteCarloCatBondEngine::pathNpv(bool includeSettlementDateFlows, 
-                                          Date settlementDate, 
-                                          const NotionalPath& notionalPath) const {
-        Real totalNPV = 0.0;
-        for (Size i=0; i<arguments_.cashflows.size(); ++i) {
-            if (!arguments_.cashflows[i]->hasOccurred(settlementDate, 
-                                        includeSettlementDateFlows)) {
-                Real amount = cashFlowRiskyValue(arguments_.cashflows[i], notionalPath);
-                totalNPV += amount * discountCurve_->discount(arguments_.cashflows[i]->date());
+        const Size batchSize = 1024;
+        std::vector<std::vector<std::pair<Date, Real> > > eventsPaths(batchSize);
+        const boost::shared_ptr<NotionalRisk>& notionalRisk = arguments_.notionalRisk;
+
+        Real totalNPV = 0.0, losses = 0.0, exhaustions = 0.0, totalLoss = 0.0;
+        Size pathCount = 0;
+        bool morePaths = true;
+        while (morePaths && pathCount<maxPaths_) {
+            // the simulation is sequential, the batch is processed in parallel
+            Size n = 0;
+            while (n<batchSize && pathCount+n<maxPaths_
+                   && (morePaths = catSimulation->nextPath(eventsPaths[n])))
+                ++n;
+
+            #pragma omp parallel
+            {
+                NotionalPath notionalPath;
+                std::vector<Rate> rates;
+
+                #pragma omp for schedule(static) reduction(+:totalNPV,losses,exhaustions,totalLoss)
+                for (Size i=0; i<n; ++i) {
+                    notionalRisk->updatePath(eventsPaths[i], notionalPath);
+                    const Real loss = notionalPath.loss();
+                    if (loss>0) { //optimization, most paths will not include any loss
+                        notionalPath.notionalRates(dates, rates);
+                        for (Size j=0; j<rates.size(); ++j)
+                            totalNPV += rates[j]*discountedAmounts[j];
+                        losses += 1;
+                        if (loss==1)
+                            exhaustions += 1;
+                        totalLoss += loss;
+                    } else {
+                        totalNPV += riskFreeNPV;
+                    }
+                }
             }
+            pathCount += n;
         }
-        return totalNPV;
-    }
-
-    Real MonteCarloCatBondEngine::cashFlowRiskyValue(const boost::shared_ptr<CashFlow> cf, 
-                                                     const NotionalPath& notionalPath) const {
-        return cf->amount()*notionalPath.notionalRate(cf->date()); //TODO: fix for more complicated cashflows
+        lossProbability = losses/pathCount;
+        exhaustionProbability = exhaustions/pathCount;
+        expectedLoss = totalLoss/pathCount;
+        return totalNPV/(pathCount*discountCurve_->discount(npvDate));
     }
 
 }
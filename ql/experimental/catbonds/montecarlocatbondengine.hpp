@@ -28,6 +28,15 @@
 
 namespace QuantLib {
 
+    //! Monte Carlo pricing engine for cat bonds
+    /*! Event paths are drawn from the CatSimulation in batches and
+        mapped to notional paths and values in parallel when OpenMP
+        is enabled; the paths are drawn in the same order whatever
+        the number of threads, so that results don't depend on it.
+
+        At most \c maxPaths paths, i.e., simulated periods, are used;
+        fewer are used if the simulation runs out of data.
+    */
     class MonteCarloCatBondEngine :
         public CatBond::engine
     {
@@ -36,29 +45,24 @@ namespace QuantLib {
               const boost::shared_ptr<CatRisk> catRisk,
               const Handle<YieldTermStructure>& discountCurve =
                                                 Handle<YieldTermStructure>(),
-              boost::optional<bool> includeSettlementDateFlows = boost::none);
+              boost::optional<bool> includeSettlementDateFlows = boost::none,
+              Size maxPaths = 10000);
         void calculate() const;
         Handle<YieldTermStructure> discountCurve() const {
             return discountCurve_;
         }
     protected:
-        Real cashFlowRiskyValue(const boost::shared_ptr<CashFlow> cf, 
-                                const NotionalPath& notionalPath) const;
-
         Real npv(bool includeSettlementDateFlows, 
                  Date settlementDate, 
                  Date npvDate, 
                  Real& lossProbability, 
                  Real& exhaustionProbability, 
                  Real& expectedLoss) const;
-
-        Real pathNpv(bool includeSettlementDateFlows, 
-                     Date settlementDate, 
-                     const NotionalPath& notionalPath) const;
       private:
         boost::shared_ptr<CatRisk> catRisk_;
         Handle<YieldTermStructure> discountCurve_;
         boost::optional<bool> includeSettlementDateFlows_;
+        Size maxPaths_;
     };
 
 }
@@ -35,6 +35,17 @@ namespace QuantLib
         return notionalRate_[i-1].second;
     }
 
+    void NotionalPath::notionalRates(const std::vector<Date>& dates,
+                                     std::vector<Rate>& rates) const {
+        rates.resize(dates.size());
+        Size i = 1;
+        for (Size j=0; j<dates.size(); ++j) {
+            while (i<notionalRate_.size() && notionalRate_[i].first<=dates[j])
+                ++i;
+            rates[j] = notionalRate_[i-1].second;
+        }
+    }
+
     void NotionalPath::reset() {
         notionalRate_.resize(1);
     }
@@ -43,7 +54,7 @@ namespace QuantLib
         notionalRate_.push_back(std::pair<Date, Real>(date, newRate));
     }
 
-    Real NotionalPath::loss() {
+    Real NotionalPath::loss() const {
         return 1.0-notionalRate_.rbegin()->second;
     }
 
@@ -49,11 +49,17 @@ namespace QuantLib {
 
         Rate notionalRate(const Date& date) const; //The fraction of the original notional left on a given date
 
+        /*! notional rates on the given dates, which must be sorted;
+            same as calling notionalRate() for each date, but in a
+            single pass over the reductions */
+        void notionalRates(const std::vector<Date>& dates,
+                           std::vector<Rate>& rates) const;
+
         void reset();
 
         void addReduction(const Date &date, Rate newRate);
 
-        Real loss();
+        Real loss() const;
 
       private:
         std::vector<std::pair<Date, Real> > notionalRate_;
@@ -36,7 +36,10 @@
 namespace QuantLib {
 
     //! Binomial Tsiveriotis-Fernandes engine for convertible bonds
-    /*  \ingroup hybridengines
+    /*! Besides the value, the engine returns the delta and gamma of
+        the convertible, which are calculated on the same tree.
+
+        \ingroup hybridengines
 
         \test the correctness of the returned value is tested by
               checking it against known results in a few corner cases.
@@ -117,14 +120,36 @@ namespace QuantLib {
 
         Real creditSpread = arguments_.creditSpread->value();
 
-        boost::shared_ptr<Lattice> lattice(
+        boost::shared_ptr<TsiveriotisFernandesLattice<T> > lattice(
               new TsiveriotisFernandesLattice<T>(tree,riskFreeRate,maturity,
                                                  timeSteps_,creditSpread,v,q));
 
-        DiscretizedConvertible convertible(arguments_, bs,
-                                           TimeGrid(maturity, timeSteps_));
+        TimeGrid grid(maturity, timeSteps_);
+        DiscretizedConvertible convertible(arguments_, bs, grid);
 
         convertible.initialize(lattice, maturity);
+
+        // Delta and gamma are read from the first levels of the tree
+        // as in BinomialVanillaEngine, so that no bumped trees are
+        // needed.  The tree uses the underlying net of dividends, but
+        // the differences between node values are the same.
+        if (timeSteps_ >= 2) {
+            convertible.rollback(grid[2]);
+            Array va2(convertible.values());
+            Real s2u = lattice->underlying(2, 2);
+            Real s2m = lattice->underlying(2, 1);
+            Real s2d = lattice->underlying(2, 0);
+            Real delta2u = (va2[2] - va2[1])/(s2u - s2m);
+            Real delta2d = (va2[1] - va2[0])/(s2m - s2d);
+            results_.gamma = (delta2u - delta2d) / ((s2u - s2d)/2);
+
+            convertible.rollback(grid[1]);
+            Array va1(convertible.values());
+            Real s1u = lattice->underlying(1, 1);
+            Real s1d = lattice->underlying(1, 0);
+            results_.delta = (va1[1] - va1[0]) / (s1u - s1d);
+        }
+
         convertible.rollback(0.0);
         results_.value = convertible.presentValue();
         QL_ENSURE(results_.value < std::numeric_limits<Real>::max(),
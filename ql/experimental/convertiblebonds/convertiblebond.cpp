@@ -63,6 +63,16 @@ namespace QuantLib {
         errorEstimate_ = Null<Real>();
     }
 
+    Real ConvertibleBond::delta() const {
+        calculate();
+        return option_->delta();
+    }
+
+    Real ConvertibleBond::gamma() const {
+        calculate();
+        return option_->gamma();
+    }
+
 
     ConvertibleZeroCouponBond::ConvertibleZeroCouponBond(
                           const boost::shared_ptr<Exercise>& exercise,
@@ -59,6 +59,14 @@ namespace QuantLib {
         const DividendSchedule& dividends() const { return dividends_; }
         const CallabilitySchedule& callability() const { return callability_; }
         const Handle<Quote>& creditSpread() const { return creditSpread_; }
+        //! \name Sensitivities
+        /*! \warning these are only available if the pricing engine
+                     calculates them.
+        */
+        //@{
+        Real delta() const;
+        Real gamma() const;
+        //@}
       protected:
         ConvertibleBond(const boost::shared_ptr<Exercise>& exercise,
                         Real conversionRatio,
@@ -80,6 +80,12 @@ namespace QuantLib {
             for (Size i=0; i<dividendTimes_.size(); i++)
                 dividendTimes_[i] = grid.closestTime(dividendTimes_[i]);
         }
+
+        // used at each step when adjusting the grid for dividends
+        dividendDiscounts_.resize(dividendTimes_.size());
+        for (Size i=0; i<dividendTimes_.size(); i++)
+            dividendDiscounts_[i] =
+                process_->riskFreeRate()->discount(dividendTimes_[i]);
     }
 
     void DiscretizedConvertible::reset(Size size) {
@@ -136,9 +142,15 @@ namespace QuantLib {
             QL_FAIL("invalid option type");
         }
 
+        // the adjusted grid is calculated at most once per step and
+        // shared between callability and convertibility
+        Array grid;
         for (Size i=0; i<callabilityTimes_.size(); i++) {
-            if (isOnTime(callabilityTimes_[i]))
-                applyCallability(i,convertible);
+            if (isOnTime(callabilityTimes_[i])) {
+                if (grid.empty())
+                    grid = adjustedGrid();
+                applyCallability(i,convertible,grid);
+            }
         }
 
         for (Size i=0; i<couponTimes_.size(); i++) {
@@ -146,12 +158,14 @@ namespace QuantLib {
                 addCoupon(i);
         }
 
-        if (convertible)
-            applyConvertibility();
+        if (convertible) {
+            if (grid.empty())
+                grid = adjustedGrid();
+            applyConvertibility(grid);
+        }
     }
 
-    void DiscretizedConvertible::applyConvertibility() {
-        Array grid = adjustedGrid();
+    void DiscretizedConvertible::applyConvertibility(const Array& grid) {
         for (Size j=0; j<values_.size(); j++) {
             Real payoff = arguments_.conversionRatio*grid[j];
             if (values_[j] <= payoff) {
@@ -161,9 +175,9 @@ namespace QuantLib {
         }
     }
 
-    void DiscretizedConvertible::applyCallability(Size i, bool convertible) {
+    void DiscretizedConvertible::applyCallability(Size i, bool convertible,
+                                                  const Array& grid) {
         Size j;
-        Array grid = adjustedGrid();
         switch (arguments_.callabilityTypes[i]) {
           case Callability::Call:
             if (arguments_.callabilityTriggers[i] != Null<Real>()) {
@@ -215,14 +229,16 @@ namespace QuantLib {
     Disposable<Array> DiscretizedConvertible::adjustedGrid() const {
         Time t = time();
         Array grid = method()->grid(t);
+        DiscountFactor discount = Null<DiscountFactor>();
         // add back all dividend amounts in the future
         for (Size i=0; i<arguments_.dividends.size(); i++) {
             Time dividendTime = dividendTimes_[i];
             if (dividendTime >= t || close(dividendTime,t)) {
                 const boost::shared_ptr<Dividend>& d = arguments_.dividends[i];
+                if (discount == Null<DiscountFactor>())
+                    discount = process_->riskFreeRate()->discount(t);
                 DiscountFactor dividendDiscount =
-                    process_->riskFreeRate()->discount(dividendTime) /
-                    process_->riskFreeRate()->discount(t);
+                    dividendDiscounts_[i] / discount;
                 for (Size j=0; j<grid.size(); j++)
                     grid[j] += d->amount(grid[j])*dividendDiscount;
             }
@@ -68,8 +68,8 @@ namespace QuantLib {
 
       private:
         Disposable<Array> adjustedGrid() const;
-        void applyConvertibility();
-        void applyCallability(Size, bool convertible);
+        void applyConvertibility(const Array& grid);
+        void applyCallability(Size, bool convertible, const Array& grid);
         void addCoupon(Size);
         ConvertibleBond::option::arguments arguments_;
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
@@ -77,6 +77,7 @@ namespace QuantLib {
         std::vector<Time> callabilityTimes_;
         std::vector<Time> couponTimes_;
         std::vector<Time> dividendTimes_;
+        std::vector<DiscountFactor> dividendDiscounts_;
     };
 
 }
@@ -90,6 +90,12 @@ namespace QuantLib {
                                           Array& newConversionProbability,
                                           Array& newSpreadAdjustedRate) const {
 
+        // the discounted value at each node is used by two nodes of
+        // the new level, so it's calculated only once
+        const Real dt = this->dt_, pd = this->pd_, pu = this->pu_;
+        const Rate riskyRate = this->riskFreeRate_ + creditSpread_;
+        Real discountedDown =
+            values[0]/(1+(spreadAdjustedRate[0]*dt));
         for (Size j=0; j<this->size(i); j++) {
 
             // new conversion probability is calculated via backward
@@ -97,18 +103,18 @@ namespace QuantLib {
             // previous conversion probabilities, ie weighted average
             // of previous probabilities.
             newConversionProbability[j] =
-                this->pd_*conversionProbability[j] +
-                this->pu_*conversionProbability[j+1];
+                pd*conversionProbability[j] +
+                pu*conversionProbability[j+1];
 
             // Use blended discounting rate
             newSpreadAdjustedRate[j] =
                 newConversionProbability[j] * this->riskFreeRate_ +
-                (1-newConversionProbability[j])*(this->riskFreeRate_+creditSpread_);
-
-            newValues[j] =
-                (this->pd_*values[j]/(1+(spreadAdjustedRate[j]*this->dt_)))
-              + (this->pu_*values[j+1]/(1+(spreadAdjustedRate[j+1]*this->dt_)));
+                (1-newConversionProbability[j])*riskyRate;
 
+            Real discountedUp =
+                values[j+1]/(1+(spreadAdjustedRate[j+1]*dt));
+            newValues[j] = pd*discountedDown + pu*discountedUp;
+            discountedDown = discountedUp;
         }
     }
 
@@ -150,10 +156,12 @@ namespace QuantLib {
                      convertible.spreadAdjustedRate(), newValues,
                      newConversionProbability,newSpreadAdjustedRate);
 
+            // the new levels are swapped in instead of being copied
             convertible.time() = this->t_[i];
-            convertible.values() = newValues;
-            convertible.spreadAdjustedRate() = newSpreadAdjustedRate;
-            convertible.conversionProbability() = newConversionProbability;
+            convertible.values().swap(newValues);
+            convertible.spreadAdjustedRate().swap(newSpreadAdjustedRate);
+            convertible.conversionProbability().swap(
+                                                 newConversionProbability);
 
             // skip the very last adjustment
             if (i != iTo)
@@ -235,6 +235,9 @@ namespace QuantLib {
         */
         //@{
         Real expectedTrancheLoss(const Date& d) const;
+        //! expected tranche losses at several dates
+        Disposable<std::vector<Real> > expectedTrancheLosses(
+                                      const std::vector<Date>& dates) const;
         /*! The lossFraction is the fraction of losses expressed in 
             inception (no losses) tranche units (e.g. 'attach level'=0%, 
             'detach level'=100%)
@@ -0,0 +1,379 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fftlossmodel.hpp
+    \brief loss model convolving the conditional losses by FFT
+*/
+
+#ifndef quantlib_fft_loss_model_hpp
+#define quantlib_fft_loss_model_hpp
+
+#include <ql/experimental/credit/basket.hpp>
+#include <ql/experimental/credit/constantlosslatentmodel.hpp>
+#include <ql/experimental/credit/defaultlossmodel.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
+#endif
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic pop
+#endif
+#include <algorithm>
+#include <complex>
+#include <map>
+
+namespace QuantLib {
+
+    //! Default loss model for a heterogeneous pool using FFT convolution
+    /*! The individual losses are discretized on a common loss unit as
+        in RecursiveLossModel; conditional on the latent factor, the
+        losses are independent and their sum has the characteristic
+        function
+        \f[
+        \phi(k|\omega) = \prod_i \left( 1 - p_i(\omega)
+                         + p_i(\omega) e^{-2 \pi i k w_i / M} \right)
+        \f]
+        where \f$ w_i \f$ is the loss of the \f$ i \f$-th name in loss
+        units and \f$ M \f$ is a power of two larger than the pool
+        loss. The conditional loss distribution is recovered by an
+        inverse FFT. The powers of the root of unity are tabulated
+        when the basket is set and, the distribution being real, only
+        half of the frequencies are computed.
+
+        The cost of a conditional distribution is thus of
+        \f$ O(NM/2) \f$ complex products and one \f$ O(M \log M) \f$
+        transform, whatever the heterogeneity of the pool; the loss
+        distribution itself is exact up to roundoff and to the loss
+        discretization.
+
+        Notice that, as for the recursive model, using copulas other
+        than the Gaussian is only an approximation.
+    */
+    template<class copulaPolicy>
+    class FFTLossModel : public DefaultLossModel {
+      public:
+        /*! \param nBuckets  number of loss units in the smallest
+                             non-zero loss given default of the pool;
+                             a larger number gives a finer
+                             discretization of the losses and a longer
+                             transform.
+        */
+        FFTLossModel(
+            const boost::shared_ptr<ConstantLossLatentmodel<copulaPolicy> >& m,
+            Size nBuckets = 1)
+        : copula_(m), nBuckets_(nBuckets) {
+            QL_REQUIRE(nBuckets_ > 0, "at least one bucket required");
+        }
+        Real expectedTrancheLoss(const Date& date) const;
+        /*! The conditional distributions at all the dates are
+            computed at each point of the latent-factor integration;
+            this requires an integration providing vector integrands,
+            otherwise the dates are integrated one by one.
+        */
+        Disposable<std::vector<Real> > expectedTrancheLosses(
+            const std::vector<Date>& dates) const;
+        //! probabilities of the pool losing each number of loss units
+        Disposable<std::vector<Real> > lossProbability(const Date& date) const;
+        //! cumulative pool loss distribution
+        Disposable<std::map<Real, Probability> > lossDistribution(
+            const Date& d) const;
+        Probability probOverLoss(const Date& d, Real lossFraction) const;
+        Real percentile(const Date& d, Real percentile) const;
+        //! size of the loss unit of the current basket
+        Real lossUnit() const { return lossUnit_; }
+      protected:
+        void resetModel();
+        const boost::shared_ptr<ConstantLossLatentmodel<copulaPolicy> > copula_;
+      private:
+        Disposable<std::vector<Real> > inverseProbabilities(
+            const Date& d) const;
+        void conditionalLossDensityInvP(const std::vector<Real>& invpDefDate,
+            const std::vector<Real>& mktFactor,
+            std::vector<Probability>& density) const;
+        Disposable<std::vector<Real> > conditionalLossProbInvP(
+            const std::vector<Real>& invpDefDate,
+            const std::vector<Real>& mktFactor) const;
+        Real expectedConditionalLossInvP(const std::vector<Real>& invpDefDate,
+            const std::vector<Real>& mktFactor) const;
+        Disposable<std::vector<Real> > expectedConditionalLossesInvP(
+            const std::vector<std::vector<Real> >& invpDefDates,
+            const std::vector<Real>& mktFactor) const;
+        Real trancheLoss(Size units) const {
+            return std::min(std::max(units * lossUnit_ - attachAmount_, 0.),
+                            detachAmount_ - attachAmount_);
+        }
+
+        const Size nBuckets_;
+        // basket magnitudes
+        mutable Real attachAmount_, detachAmount_;
+        mutable Size remainingBsktSize_;
+        // loss discretization
+        mutable Real lossUnit_;
+        mutable std::vector<Size> wk_;
+        mutable Size maxLoss_;
+        // transform and powers of the root of unity
+        mutable boost::shared_ptr<FastFourierTransform> fft_;
+        mutable std::vector<std::complex<Real> > roots_;
+        // work space
+        mutable std::vector<std::complex<Real> > charFunction_, transform_;
+    };
+
+    typedef FFTLossModel<GaussianCopulaPolicy> FFTGaussLossModel;
+
+
+    // template definitions
+
+    template<class CP>
+    void FFTLossModel<CP>::resetModel() {
+        std::vector<Real> notionals = basket_->remainingNotionals();
+        attachAmount_ = basket_->remainingAttachmentAmount();
+        detachAmount_ = basket_->remainingDetachmentAmount();
+        remainingBsktSize_ = notionals.size();
+
+        copula_->resetBasket(basket_.currentLink());
+
+        std::vector<Real> lgds(remainingBsktSize_);
+        Real minLgd = QL_MAX_REAL;
+        for (Size i=0; i<remainingBsktSize_; ++i) {
+            lgds[i] = notionals[i]*(1.-copula_->recoveries()[i]);
+            if (lgds[i] > 0.)
+                minLgd = std::min(minLgd, lgds[i]);
+        }
+        QL_REQUIRE(minLgd < QL_MAX_REAL, "no losses in the basket");
+        lossUnit_ = minLgd / nBuckets_;
+
+        wk_.resize(remainingBsktSize_);
+        maxLoss_ = 0;
+        for (Size i=0; i<remainingBsktSize_; ++i) {
+            wk_[i] = static_cast<Size>(std::floor(lgds[i]/lossUnit_ + .5));
+            maxLoss_ += wk_[i];
+        }
+
+        // the transform must be longer than the pool loss, or the
+        // largest losses would wrap around; at least two points are
+        // needed for the halving below
+        Size order = std::max<Size>(
+                           FastFourierTransform::min_order(maxLoss_+1), 1);
+        fft_ = boost::make_shared<FastFourierTransform>(order);
+        Size m = fft_->output_size();
+        roots_.resize(m);
+        for (Size j=0; j<m; ++j)
+            roots_[j] = std::polar(1.0, -2.0*M_PI*j/m);
+        charFunction_.resize(m);
+        transform_.resize(m);
+    }
+
+    template<class CP>
+    Disposable<std::vector<Real> >
+    FFTLossModel<CP>::inverseProbabilities(const Date& d) const {
+        std::vector<Probability> uncDefProb =
+            basket_->remainingProbabilities(d);
+        std::vector<Real> invProb(uncDefProb.size());
+        for (Size i=0; i<uncDefProb.size(); ++i)
+            invProb[i] = copula_->inverseCumulativeY(uncDefProb[i], i);
+        return invProb;
+    }
+
+    template<class CP>
+    void FFTLossModel<CP>::conditionalLossDensityInvP(
+                                   const std::vector<Real>& invpDefDate,
+                                   const std::vector<Real>& mktFactor,
+                                   std::vector<Probability>& density) const {
+        const Size m = roots_.size(), half = m/2;
+        std::fill(charFunction_.begin(), charFunction_.begin()+half+1,
+                  std::complex<Real>(1.0));
+        for (Size iName=0; iName<remainingBsktSize_; ++iName) {
+            const Size w = wk_[iName];
+            if (w == 0)
+                continue;
+            Probability pDef =
+                copula_->conditionalDefaultProbabilityInvP(invpDefDate[iName],
+                                                           iName, mktFactor);
+            if (pDef == 0.)
+                continue;
+            // walk the table with stride w modulo m
+            Size j = 0;
+            for (Size k=0; k<=half; ++k) {
+                charFunction_[k] *= (1.-pDef) + pDef*roots_[j];
+                j += w;
+                if (j >= m)
+                    j %= m;
+            }
+        }
+        // the density is real, hence the characteristic function is
+        // symmetric under conjugation
+        for (Size k=1; k<half; ++k)
+            charFunction_[m-k] = std::conj(charFunction_[k]);
+
+        fft_->inverse_transform(charFunction_.begin(), charFunction_.end(),
+                                transform_.begin());
+        density.resize(maxLoss_+1);
+        for (Size l=0; l<=maxLoss_; ++l)
+            density[l] = transform_[l].real()/m;
+    }
+
+    template<class CP>
+    Disposable<std::vector<Real> >
+    FFTLossModel<CP>::conditionalLossProbInvP(
+                                   const std::vector<Real>& invpDefDate,
+                                   const std::vector<Real>& mktFactor) const {
+        std::vector<Probability> density;
+        conditionalLossDensityInvP(invpDefDate, mktFactor, density);
+        return density;
+    }
+
+    template<class CP>
+    Real FFTLossModel<CP>::expectedConditionalLossInvP(
+                                   const std::vector<Real>& invpDefDate,
+                                   const std::vector<Real>& mktFactor) const {
+        std::vector<Probability> density;
+        conditionalLossDensityInvP(invpDefDate, mktFactor, density);
+        Real expLoss = 0.;
+        for (Size l=0; l<density.size(); ++l)
+            expLoss += trancheLoss(l) * density[l];
+        return expLoss;
+    }
+
+    template<class CP>
+    Disposable<std::vector<Real> >
+    FFTLossModel<CP>::expectedConditionalLossesInvP(
+                       const std::vector<std::vector<Real> >& invpDefDates,
+                       const std::vector<Real>& mktFactor) const {
+        std::vector<Real> losses(invpDefDates.size());
+        for (Size k=0; k<invpDefDates.size(); ++k)
+            losses[k] = expectedConditionalLossInvP(invpDefDates[k],
+                                                    mktFactor);
+        return losses;
+    }
+
+    template<class CP>
+    Real FFTLossModel<CP>::expectedTrancheLoss(const Date& date) const {
+        std::vector<Real> invProb = inverseProbabilities(date);
+        return copula_->integratedExpectedValue(
+            boost::function<Real (const std::vector<Real>& v1)>(
+                boost::bind(
+                    &FFTLossModel::expectedConditionalLossInvP,
+                    this,
+                    boost::cref(invProb),
+                    _1)
+                )
+            );
+    }
+
+    template<class CP>
+    Disposable<std::vector<Real> > FFTLossModel<CP>::expectedTrancheLosses(
+                                      const std::vector<Date>& dates) const {
+        std::vector<std::vector<Real> > invProbs(dates.size());
+        for (Size k=0; k<dates.size(); ++k)
+            invProbs[k] = inverseProbabilities(dates[k]);
+
+        std::vector<Real> results;
+        try {
+            results = copula_->integratedExpectedValue(
+                boost::function<Disposable<std::vector<Real> > (
+                                         const std::vector<Real>& v1)>(
+                    boost::bind(
+                        &FFTLossModel::expectedConditionalLossesInvP,
+                        this,
+                        boost::cref(invProbs),
+                        _1)
+                    )
+                );
+        } catch (Error&) {
+            // the integration doesn't support vector integrands
+            results.resize(dates.size());
+            for (Size k=0; k<dates.size(); ++k)
+                results[k] = copula_->integratedExpectedValue(
+                    boost::function<Real (const std::vector<Real>& v1)>(
+                        boost::bind(
+                            &FFTLossModel::expectedConditionalLossInvP,
+                            this,
+                            boost::cref(invProbs[k]),
+                            _1)
+                        )
+                    );
+        }
+        return results;
+    }
+
+    template<class CP>
+    Disposable<std::vector<Real> >
+    FFTLossModel<CP>::lossProbability(const Date& date) const {
+        std::vector<Real> invProb = inverseProbabilities(date);
+        return copula_->integratedExpectedValue(
+            boost::function<Disposable<std::vector<Real> > (
+                                         const std::vector<Real>& v1)>(
+                boost::bind(
+                    &FFTLossModel::conditionalLossProbInvP,
+                    this,
+                    boost::cref(invProb),
+                    _1)
+                )
+            );
+    }
+
+    template<class CP>
+    Disposable<std::map<Real, Probability> >
+    FFTLossModel<CP>::lossDistribution(const Date& d) const {
+        std::map<Real, Probability> distrib;
+        std::vector<Real> values = lossProbability(d);
+        Real sum = 0.;
+        for (Size i=0; i<values.size(); ++i) {
+            sum += values[i];
+            distrib.insert(std::make_pair(i * lossUnit_, sum));
+        }
+        return distrib;
+    }
+
+    template<class CP>
+    Probability FFTLossModel<CP>::probOverLoss(const Date& d,
+                                               Real lossFraction) const {
+        Real portfLoss = attachAmount_
+            + lossFraction * (detachAmount_ - attachAmount_);
+        std::vector<Real> values = lossProbability(d);
+        Probability p = 0.;
+        for (Size l=values.size(); l>0; ) {
+            --l;
+            if (l * lossUnit_ < portfLoss)
+                break;
+            p += values[l];
+        }
+        return std::min(std::max(p, 0.), 1.);
+    }
+
+    template<class CP>
+    Real FFTLossModel<CP>::percentile(const Date& d, Real perc) const {
+        QL_REQUIRE(perc >= 0. && perc <= 1.,
+                   "percentile " << perc << " out of range");
+        std::vector<Real> values = lossProbability(d);
+        Real sum = 0.;
+        Size l = 0;
+        for (; l<values.size()-1; ++l) {
+            sum += values[l];
+            if (sum >= perc)
+                break;
+        }
+        return trancheLoss(l);
+    }
+
+}
+
+#endif
@@ -42,14 +42,39 @@ namespace QuantLib {
         const Real inceptionTrancheNotional = 
             arguments_.basket->trancheNotional();
 
-        // compute expected loss at the beginning of first relevant period
-        Real e1 = 0;
+        // collect the dates first, so that the expected losses are
+        // calculated by the basket at once
+        std::vector<Date> lossDates;
         // todo add includeSettlement date flows variable to engine.
         if (!arguments_.normalizedLeg[0]->hasOccurred(today)) 
              // cast to fixed rate coupon?
-            e1 = arguments_.basket->expectedTrancheLoss(
+            lossDates.push_back(boost::dynamic_pointer_cast<Coupon>(
+                    arguments_.normalizedLeg[0])->accrualStartDate());
+        for (Size i = 0; i < arguments_.normalizedLeg.size(); i++) {
+            if(arguments_.normalizedLeg[i]->hasOccurred(today))
+                continue;
+            const boost::shared_ptr<Coupon> coupon =
                 boost::dynamic_pointer_cast<Coupon>(
-                    arguments_.normalizedLeg[0])->accrualStartDate()); 
+                    arguments_.normalizedLeg[i]);
+            Date d, d0 = coupon->accrualStartDate();
+            Date d2 = coupon->date();
+            do {
+                d = NullCalendar().advance(d0 > today ? d0 : today,
+                                           stepSize_);
+                if (d > d2) d = d2;
+                lossDates.push_back(d);
+                d0 = d;
+            }
+            while (d < d2);
+        }
+        const std::vector<Real> losses =
+            arguments_.basket->expectedTrancheLosses(lossDates);
+        std::vector<Real>::const_iterator nextLoss = losses.begin();
+
+        // compute expected loss at the beginning of first relevant period
+        Real e1 = 0;
+        if (!arguments_.normalizedLeg[0]->hasOccurred(today)) 
+            e1 = *(nextLoss++);
         results_.expectedTrancheLoss.push_back(e1);// zero or realized losses?
 
         for (Size i = 0; i < arguments_.normalizedLeg.size(); i++) {
@@ -73,7 +98,7 @@ namespace QuantLib {
                                            stepSize_);
                 if (d > d2) d = d2;
 
-                e2 = arguments_.basket->expectedTrancheLoss(d);
+                e2 = *(nextLoss++);
 
                 results_.premiumValue
                     // ..check for e2 including past/realized losses
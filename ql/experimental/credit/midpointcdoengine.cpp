@@ -42,17 +42,30 @@ namespace QuantLib {
         const Real inceptionTrancheNotional = 
             arguments_.basket->trancheNotional();
 
+        // collect the dates first, so that the expected losses are
+        // calculated by the basket at once
+        std::vector<Date> lossDates;
+        // todo add includeSettlement date flows variable to engine.
+        if (!arguments_.normalizedLeg[0]->hasOccurred(today))
+            lossDates.push_back(boost::dynamic_pointer_cast<Coupon>(
+                    arguments_.normalizedLeg[0])->accrualStartDate());
+        for (Size i = 0; i < arguments_.normalizedLeg.size(); i++) {
+            if(!arguments_.normalizedLeg[i]->hasOccurred(today))
+                lossDates.push_back(boost::dynamic_pointer_cast<Coupon>(
+                    arguments_.normalizedLeg[i])->accrualEndDate());
+        }
+        const std::vector<Real> losses =
+            arguments_.basket->expectedTrancheLosses(lossDates);
+        std::vector<Real>::const_iterator nextLoss = losses.begin();
+
         // compute expected loss at the beginning of first relevant period
         Real e1 = 0;
-        // todo add includeSettlement date flows variable to engine.
         if (!arguments_.normalizedLeg[0]->hasOccurred(today))
             // Notice that since there might be a gap between the end of 
             // acrrual and payment dates and today be in between
             // the tranche loss on that date might not be contingent but 
             // realized:
-            e1 = arguments_.basket->expectedTrancheLoss(
-                boost::dynamic_pointer_cast<Coupon>(
-                    arguments_.normalizedLeg[0])->accrualStartDate());
+            e1 = *(nextLoss++);
         results_.expectedTrancheLoss.push_back(e1);
         //'e1'  should contain the existing loses.....? use remaining amounts?
         for (Size i = 0; i < arguments_.normalizedLeg.size(); i++) {
@@ -69,7 +82,7 @@ namespace QuantLib {
             // we assume the loss within the period took place on this date:
             Date defaultDate = startDate + (endDate-startDate)/2;
 
-            Real e2 = arguments_.basket->expectedTrancheLoss(endDate);
+            Real e2 = *(nextLoss++);
             results_.expectedTrancheLoss.push_back(e2);
             results_.premiumValue += 
                 ((inceptionTrancheNotional - e2) / inceptionTrancheNotional)
@@ -782,6 +782,80 @@ namespace QuantLib {
             Real pd_;
             const Date curveRef_;
         };
+
+        //! Default day lookup on a default probability curve
+        /*! The curve is tabulated every few days up to the horizon when
+            the table is built; the default day of a given probability is
+            then located in the table and refined by bisection on the
+            days of the bracketing interval, which takes a handful of
+            curve evaluations instead of a root search on the whole
+            horizon.
+
+            Days are counted from the curve reference date, as in Root.
+        */
+        class DefaultDayTable {
+          public:
+            DefaultDayTable(const Handle<DefaultProbabilityTermStructure>& dts,
+                            Size horizon, Size step = 16)
+            : dts_(dts), curveRef_(dts->referenceDate()), step_(step) {
+                for (Size d=0; d<horizon+step_; d+=step_)
+                    probs_.push_back(probability(d));
+            }
+            /*! Number of whole days elapsed before the default
+                probability reaches the given value, i.e., the last day
+                at which it is still lower.
+            */
+            Size defaultDay(Probability pd) const {
+                std::vector<Probability>::const_iterator it =
+                    std::lower_bound(probs_.begin(), probs_.end(), pd);
+                if (it == probs_.begin())
+                    return 0;
+                if (it == probs_.end())
+                    return (probs_.size()-1)*step_;
+                Size hi = (it - probs_.begin())*step_, lo = hi - step_;
+                // here probability(lo) < pd <= probability(hi)
+                while (hi - lo > 1) {
+                    Size mid = (lo + hi)/2;
+                    if (probability(mid) < pd)
+                        lo = mid;
+                    else
+                        hi = mid;
+                }
+                return lo;
+            }
+          private:
+            Probability probability(Size day) const {
+                return dts_->defaultProbability(curveRef_ +
+                    Period(static_cast<Integer>(day), Days), true);
+            }
+            Handle<DefaultProbabilityTermStructure> dts_;
+            Date curveRef_;
+            Size step_;
+            std::vector<Probability> probs_;
+        };
+
+        /*! Value of the latent variable above which a name can't
+            default before the horizon, i.e., such that cumulativeY is
+            larger than the horizon probability for any larger value.
+            Samples above it are discarded without evaluating the
+            cumulative; the inversion is nudged upwards, since it might
+            be numerical.
+        */
+        template <class LatentModel>
+        Real defaultThreshold(const LatentModel& model, Probability p,
+                              Size iName) {
+            if (p <= 0.)
+                return -QL_MAX_REAL;
+            if (p >= 1.)
+                return QL_MAX_REAL;
+            Real y = model.inverseCumulativeY(p, iName);
+            Real dy = 1.0e-8 * std::max(std::fabs(y), 1.0);
+            while (model.cumulativeY(y, iName) <= p) {
+                y += dy;
+                dy *= 2.0;
+            }
+            return y;
+        }
     }
 
     /*
@@ -821,9 +895,17 @@ namespace QuantLib {
         // \todo Consider this to be only a ConstantLossLM instead
         const boost::shared_ptr<DefaultLatentModel<copulaPolicy> > model_;
         const std::vector<Real> recoveries_;
-        // for time inversion:
+        // not used since default times are looked up on a table; kept
+        // for the constructor signatures
         Real accuracy_;
     public:
+        /*! \deprecated The accuracy argument is ignored: simulated
+                        default times are looked up on the default
+                        curves tabulated when the simulation starts,
+                        and are exact to the day.  It is kept for
+                        backward compatibility and will be removed
+                        in a future release.
+        */
         // \todo: Allow a constructor building its own default latent model.
         RandomDefaultLM(
             const boost::shared_ptr<DefaultLatentModel<copulaPolicy> >& model,
@@ -843,6 +925,9 @@ namespace QuantLib {
             this->registerWith(Settings::instance().evaluationDate());
             this->registerWith(model_);
         }
+        /*! \deprecated The accuracy argument is ignored, as in the
+                        constructor above.
+        */
         RandomDefaultLM(
             const boost::shared_ptr<ConstantLossLatentmodel<copulaPolicy> >&
                 model,
@@ -884,10 +969,20 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const boost::shared_ptr<Pool>& pool = this->basket_->pool();
-            for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
-                horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
-                    defaultProbability(this->basket_->defaultKeys()[iName])
-                        ->defaultProbability(maxHorizonDate, true));
+            horizonDefaultPs_.clear();
+            horizonThresholds_.clear();
+            defaultDays_.clear();
+            for(Size iName=0; iName < this->basket_->size(); ++iName) {//use'live'
+                const Handle<DefaultProbabilityTermStructure>& dfts =
+                    pool->get(pool->names()[iName]).
+                    defaultProbability(this->basket_->defaultKeys()[iName]);
+                horizonDefaultPs_.push_back(
+                    dfts->defaultProbability(maxHorizonDate, true));
+                horizonThresholds_.push_back(detail::defaultThreshold(
+                    *model_, horizonDefaultPs_.back(), iName));
+                defaultDays_.push_back(
+                    detail::DefaultDayTable(dfts, this->maxHorizon_));
+            }
         }
         Real getEventRecovery(const defaultSimEvent& evt) const {
             return recoveries_[evt.nameIdx];
@@ -925,6 +1020,10 @@ namespace QuantLib {
         // Default probabilities for each name at the time of the maximun
         //   horizon date. Cached for perf.
         mutable std::vector<Probability> horizonDefaultPs_;
+        // latent variable values above which no default takes place
+        mutable std::vector<Real> horizonThresholds_;
+        // tabulated default curves for the default time lookup
+        mutable std::vector<detail::DefaultDayTable> defaultDays_;
     };
 
 
@@ -935,26 +1034,23 @@ namespace QuantLib {
     void RandomDefaultLM<C, URNG>::nextSample(
         const std::vector<Real>& values) const
     {
-        const boost::shared_ptr<Pool>& pool = this->basket_->pool();
         // starts with no events
         this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
 
         for(Size iName=0; iName<model_->size(); iName++) {
             Real latentVarSample =
                 model_->latentVarValue(values, iName);
+            // most names don't default; skip the cumulative for them
+            if (latentVarSample > horizonThresholds_[iName])
+                continue;
             Probability simDefaultProb =
                model_->cumulativeY(latentVarSample, iName);
             // If the default simulated lies before the max date:
             if (horizonDefaultPs_[iName] >= simDefaultProb) {
-                const Handle<DefaultProbabilityTermStructure>& dfts =
-                    pool->get(pool->names()[iName]).// use 'live' names
-                    defaultProbability(this->basket_->defaultKeys()[iName]);
                 // compute and store default time with respect to the
                 //  curve ref date:
                 Size dateSTride =
-                    static_cast<Size>(Brent().solve(// casted from Real:
-                        detail::Root(dfts, simDefaultProb),
-                            accuracy_,0.,1.));
+                    defaultDays_[iName].defaultDay(simDefaultProb);
                    /*
                    // value if one approximates to a flat HR;
                    //   faster (>x2) but it introduces an error:..
@@ -75,9 +75,17 @@ namespace QuantLib {
         typedef simEvent<RandomLossLM> defaultSimEvent;
 
         const boost::shared_ptr<SpotRecoveryLatentModel<copulaPolicy> > copula_;
-        // for time inversion:
+        // not used since default times are looked up on a table; kept
+        // for the constructor signature
         Real accuracy_;
     public:
+        /*! \deprecated The accuracy argument is ignored: simulated
+                        default times are looked up on the default
+                        curves tabulated when the simulation starts,
+                        and are exact to the day.  It is kept for
+                        backward compatibility and will be removed
+                        in a future release.
+        */
         RandomLossLM(
             const boost::shared_ptr<SpotRecoveryLatentModel<copulaPolicy> >& 
                 copula,
@@ -114,10 +122,20 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const boost::shared_ptr<Pool>& pool = this->basket_->pool();
-            for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
-                horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
-                    defaultProbability(this->basket_->defaultKeys()[iName])
-                        ->defaultProbability(maxHorizonDate, true));
+            horizonDefaultPs_.clear();
+            horizonThresholds_.clear();
+            defaultDays_.clear();
+            for(Size iName=0; iName < this->basket_->size(); ++iName) {//use'live'
+                const Handle<DefaultProbabilityTermStructure>& dfts =
+                    pool->get(pool->names()[iName]).
+                    defaultProbability(this->basket_->defaultKeys()[iName]);
+                horizonDefaultPs_.push_back(
+                    dfts->defaultProbability(maxHorizonDate, true));
+                horizonThresholds_.push_back(detail::defaultThreshold(
+                    *copula_, horizonDefaultPs_.back(), iName));
+                defaultDays_.push_back(
+                    detail::DefaultDayTable(dfts, this->maxHorizon_));
+            }
         }
        Real getEventRecovery(const defaultSimEvent& evt) const {
             return evt.recovery();
@@ -147,6 +165,10 @@ namespace QuantLib {
         // Default probabilities for each name at the time of the maximun 
         //   horizon date. Cached for perf.
         mutable std::vector<Probability> horizonDefaultPs_;
+        // latent variable values above which no default takes place
+        mutable std::vector<Real> horizonThresholds_;
+        // tabulated default curves for the default time lookup
+        mutable std::vector<detail::DefaultDayTable> defaultDays_;
     };
 
 
@@ -172,6 +194,9 @@ namespace QuantLib {
             */
             Real latentVarSample = 
                 copula_->latentVarValue(values, iName);
+            // most names don't default; skip the cumulative for them
+            if (latentVarSample > horizonThresholds_[iName])
+                continue;
             Probability simDefaultProb = 
                 copula_->cumulativeY(latentVarSample, iName);
             // If the default simulated lies before the max date:
@@ -182,8 +207,7 @@ namespace QuantLib {
                 // compute and store default time with respect to the 
                 //  curve ref date:
                 Size dateSTride =
-                    static_cast<Size>(Brent().solve(// casted from Real:
-                    detail::Root(dfts, simDefaultProb), accuracy_, 0., 1.));
+                    defaultDays_[iName].defaultDay(simDefaultProb);
                 /*
                 // value if one approximates to a flat HR; 
                 //   faster (>x2) but it introduces an error:..
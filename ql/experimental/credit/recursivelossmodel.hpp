@@ -84,6 +84,17 @@ namespace QuantLib {
         Real expectedConditionalLossInvP(const std::vector<Real>& pDefDate, 
             //const Date& date,
             const std::vector<Real>& mktFactor) const;
+        /* Dense version of conditionalLossDistribInvP; the loss
+           weights are integer multiples of the loss unit, so the
+           distribution is stored by bucket and convolved in place. */
+        void conditionalLossDensityInvP(const std::vector<Real>& invpDefDate,
+            const std::vector<Real>& mktFactor,
+            std::vector<Probability>& density) const;
+        Real expectedConditionalLoss(
+            const std::vector<Probability>& density) const;
+        Disposable<std::vector<Real> > expectedConditionalLossesInvP(
+            const std::vector<std::vector<Real> >& invpDefDates,
+            const std::vector<Real>& mktFactor) const;
     protected:
         void resetModel();
     public:
@@ -103,6 +114,14 @@ namespace QuantLib {
             makes it easier this way.
         */
        Real expectedTrancheLoss(const Date& date) const;
+       /*! The conditional losses at all the dates are calculated
+           at each point of the latent-factor integration, so that
+           the points and the factor density are evaluated once.
+           This requires an integration providing vector integrands;
+           otherwise, the dates are integrated one by one.
+       */
+       Disposable<std::vector<Real> > expectedTrancheLosses(
+           const std::vector<Date>& dates) const;
        Disposable<std::vector<Real> > lossProbability(const Date& date) const;
        // REMEBER THIS HAS TO BE MOVED TO A DISTRIBUTION OBJECT.............
        Disposable<std::map<Real, Probability> > lossDistribution(
@@ -195,6 +214,49 @@ namespace QuantLib {
             
     }
 
+    template<class CP>
+    Disposable<std::vector<Real> >
+        RecursiveLossModel<CP>::expectedTrancheLosses(
+            const std::vector<Date>& dates) const {
+
+        std::vector<std::vector<Real> > invProbs(dates.size());
+        for (Size k=0; k<dates.size(); ++k) {
+            std::vector<Probability> uncDefProb =
+                basket_->remainingProbabilities(dates[k]);
+            for (Size i=0; i<uncDefProb.size(); ++i)
+                invProbs[k].push_back(
+                    copula_->inverseCumulativeY(uncDefProb[i], i));
+        }
+
+        std::vector<Real> results;
+        try {
+            results = copula_->integratedExpectedValue(
+                boost::function<Disposable<std::vector<Real> > (
+                                         const std::vector<Real>& v1)>(
+                    boost::bind(
+                        &RecursiveLossModel::expectedConditionalLossesInvP,
+                        this,
+                        boost::cref(invProbs),
+                        _1)
+                    )
+                );
+        } catch (Error&) {
+            // the integration doesn't support vector integrands
+            results.resize(dates.size());
+            for (Size k=0; k<dates.size(); ++k)
+                results[k] = copula_->integratedExpectedValue(
+                    boost::function<Real (const std::vector<Real>& v1)>(
+                        boost::bind(
+                            &RecursiveLossModel::expectedConditionalLossInvP,
+                            this,
+                            boost::cref(invProbs[k]),
+                            _1)
+                        )
+                    );
+        }
+        return results;
+    }
+
     template<class CP>
     inline Disposable<std::vector<Real> > 
         RecursiveLossModel<CP>::lossProbability(const Date& date) const {
@@ -234,6 +296,7 @@ namespace QuantLib {
         lgds.erase(std::remove(lgds.begin(), lgds.end(), 0.), lgds.end());
         lossUnit_ = *(std::min_element(lgds.begin(), lgds.end()))
             / nBuckets_;
+        wk_.clear();
         for(Size i=0; i<remainingBsktSize_; ++i)
             wk_.push_back(std::floor(lgdsTmp[i]/lossUnit_ + .5));
     }
@@ -475,30 +538,69 @@ namespace QuantLib {
                                  //const Date& date,
                                  const std::vector<Real>& mktFactor) const 
     {
-        std::map<Real, Probability> pIndepDistrib =
-            conditionalLossDistribInvP(invPDefDate, mktFactor);
+        std::vector<Probability> density;
+        conditionalLossDensityInvP(invPDefDate, mktFactor, density);
+        return expectedConditionalLoss(density);
+    }
 
-        // get the expected value subject to the value of the market
-        //   factor.
-        Real expLoss = 0.;
-        //---------------------------------------------------------------
-        /* This is the original (easy to read) loop which I have partially
-             unroll below to take profit of the fact that once we go over
-             the tranche top the loss amount is fixed:
-        */
-        std::map<Real, Probability>::iterator distIt =
-            pIndepDistrib.begin();
+    template<class CP>
+    void RecursiveLossModel<CP>::conditionalLossDensityInvP(
+        const std::vector<Real>& invpDefDate,
+        const std::vector<Real>& mktFactor,
+        std::vector<Probability>& density) const
+    {
+        // same recursion as in conditionalLossDistribInvP; each bucket
+        // gets the same two terms, so the results are the same
+        Size maxLoss = 0;
+        for(Size iName=0; iName<remainingBsktSize_; ++iName)
+            maxLoss += static_cast<Size>(wk_[iName]);
+        density.assign(maxLoss+1, 0.);
+        density[0] = 1.;
+
+        Size top = 0;
+        for(Size iName=0; iName<remainingBsktSize_; ++iName) {
+            Probability pDef =
+                copula_->conditionalDefaultProbabilityInvP(invpDefDate[iName],
+                    iName, mktFactor);
+            const Size w = static_cast<Size>(wk_[iName]);
+            top += w;
+            // downwards, so that the values read are still the old ones
+            for(Size l=top+1; l>w; ) {
+                --l;
+                density[l] = density[l-w] * pDef + density[l] * (1.-pDef);
+            }
+            for(Size l=0; l<w; ++l)
+                density[l] *= (1.-pDef);
+        }
+    }
 
-        while(distIt != pIndepDistrib.end()) {
-            Real loss = distIt->first * lossUnit_;
-   //         loss = std::max(std::min(loss, detachAmount_)-attachAmount_, 0.);
+    template<class CP>
+    Real RecursiveLossModel<CP>::expectedConditionalLoss(
+        const std::vector<Probability>& density) const
+    {
+        Real expLoss = 0.;
+        for(Size l=0; l<density.size(); ++l) {
+            Real loss = l * lossUnit_;
             loss = std::min(std::max(loss - attachAmount_, 0.), 
                 detachAmount_ - attachAmount_);
-            // MIN MAX BUGS ....???
-            expLoss += loss * distIt->second;
-            ++distIt;
+            expLoss += loss * density[l];
         }
-        return expLoss ;
+        return expLoss;
+    }
+
+    template<class CP>
+    Disposable<std::vector<Real> >
+        RecursiveLossModel<CP>::expectedConditionalLossesInvP(
+            const std::vector<std::vector<Real> >& invpDefDates,
+            const std::vector<Real>& mktFactor) const
+    {
+        std::vector<Real> losses(invpDefDates.size());
+        std::vector<Probability> density;
+        for(Size k=0; k<invpDefDates.size(); ++k) {
+            conditionalLossDensityInvP(invpDefDates[k], mktFactor, density);
+            losses[k] = expectedConditionalLoss(density);
+        }
+        return losses;
     }
 
     template<class CP>
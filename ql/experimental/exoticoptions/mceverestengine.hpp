@@ -50,7 +50,8 @@ namespace QuantLib {
                         Size requiredSamples,
                         Real requiredTolerance,
                         Size maxSamples,
-                        BigNatural seed);
+                        BigNatural seed,
+                        Size workers = 1);
         void calculate() const {
 
             McSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
@@ -72,12 +73,20 @@ namespace QuantLib {
         // McEverest implementation
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_generator_type> pathGenerator() const {
+            return pathGenerator(seed_);
+        }
+        boost::shared_ptr<path_generator_type>
+        workerPathGenerator(Size worker) const {
+            return pathGenerator(this->workerSeed(seed_, worker));
+        }
+        boost::shared_ptr<path_generator_type>
+        pathGenerator(BigNatural seed) const {
 
             Size numAssets = processes_->size();
 
             TimeGrid grid = timeGrid();
             typename RNG::rsg_type gen =
-                RNG::make_sequence_generator(numAssets*(grid.size()-1),seed_);
+                RNG::make_sequence_generator(numAssets*(grid.size()-1),seed);
 
             return boost::shared_ptr<path_generator_type>(
                          new path_generator_type(processes_,
@@ -111,6 +120,7 @@ namespace QuantLib {
         MakeMCEverestEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEverestEngine& withMaxSamples(Size samples);
         MakeMCEverestEngine& withSeed(BigNatural seed);
+        MakeMCEverestEngine& withWorkers(Size workers);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -119,6 +129,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size workers_;
     };
 
 
@@ -147,8 +158,9 @@ namespace QuantLib {
                    Size requiredSamples,
                    Real requiredTolerance,
                    Size maxSamples,
-                   BigNatural seed)
-    : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false),
+                   BigNatural seed,
+                   Size workers)
+    : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false, workers),
       processes_(processes), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
@@ -212,7 +224,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), workers_(1) {}
 
     template <class RNG, class S>
     inline MakeMCEverestEngine<RNG,S>&
@@ -277,6 +289,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEverestEngine<RNG,S>&
+    MakeMCEverestEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEverestEngine<RNG,S>::operator
@@ -293,7 +312,8 @@ namespace QuantLib {
                                    antithetic_,
                                    samples_, tolerance_,
                                    maxSamples_,
-                                   seed_));
+                                   seed_,
+                                   workers_));
     }
 
 }
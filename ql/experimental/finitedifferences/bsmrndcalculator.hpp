@@ -41,6 +41,7 @@ namespace QuantLib {
         Real pdf(Real x, Time t) const;
         Real cdf(Real x, Time t) const;
         Real invcdf(Real q, Time t) const;
+        using RiskNeutralDensityCalculator::invcdf;
 
     private:
         std::pair<Real, Volatility> distributionParams(Real x, Time t) const;
@@ -22,45 +22,14 @@
 */
 
 #include <ql/termstructures/yieldtermstructure.hpp>
-#include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/experimental/processes/extouwithjumpsprocess.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/experimental/processes/extendedornsteinuhlenbeckprocess.hpp>
 #include <ql/experimental/finitedifferences/fdmextoujumpop.hpp>
-#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/experimental/finitedifferences/fdmextendedornsteinuhlenbeckop.hpp>
 
-#if defined(QL_NO_UBLAS_SUPPORT)
-
-#include <ql/methods/finitedifferences/utilities/fdmdirichletboundary.hpp>
-
-#else
-
-#if defined(QL_PATCH_MSVC)
-#pragma warning(push)
-#pragma warning(disable:4180)
-#endif
-
-#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
-#endif
-
-#include <boost/numeric/ublas/vector.hpp>
-#include <boost/numeric/ublas/operation.hpp>
-
-#if defined(QL_PATCH_MSVC)
-#pragma warning(pop)
-#endif
-
-#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
-#pragma GCC diagnostic pop
-#endif
-
-#endif
-
 namespace QuantLib {
 
     FdmExtOUJumpOp::FdmExtOUJumpOp(
@@ -81,50 +50,46 @@ namespace QuantLib {
       dyMap_  (FirstDerivativeOp(1, mesher)
                 .mult(-process->beta()*mesher->locations(1)))
     {
-#if !defined(QL_NO_UBLAS_SUPPORT)
         const Real eta     = process_->eta();
         const Real lambda  = process_->jumpIntensity();
 
         const Array yInt   = gaussLaguerreIntegration_.x();
         const Array weights= gaussLaguerreIntegration_.weights();
 
-        integroPart_ = SparseMatrix(mesher_->layout()->size(),
-                                    mesher_->layout()->size());
-
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         const FdmLinearOpIterator endIter = layout->end();
 
-        Array yLoc(mesher_->layout()->dim()[1]);
+        const Size ny = layout->dim()[1];
+        Array yLoc(ny);
         for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
             ++iter) {
             yLoc[iter.coordinates()[1]] = mesher_->location(iter, 1);
         }
 
-        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
-            ++iter) {
-
-            const Size diag = iter.index();
-            integroPart_(diag, diag) -= lambda;
-
-            const Real y = mesher_->location(iter, 1);
-            const Integer yIndex = iter.coordinates()[1];
+        jumpWeights_ = Matrix(ny, ny, 0.0);
+        jumpBegin_.resize(ny);
+        jumpEnd_.resize(ny);
+        for (Size j=0; j < ny; ++j) {
+            jumpWeights_[j][j] -= lambda;
+            jumpBegin_[j] = j;
+            jumpEnd_[j] = j+1;
 
             for (Size i=0; i < yInt.size(); ++i) {
                 const Real weight = std::exp(-yInt[i])*weights[i];
 
-                const Real ys = y + yInt[i]/eta;
-                const Integer l = (ys > yLoc.back()) ? yLoc.size()-2
+                const Real ys = yLoc[j] + yInt[i]/eta;
+                const Size l = (ys > yLoc[ny-1]) ? ny-2
                     : std::upper_bound(yLoc.begin(),
                                        yLoc.end()-1, ys) - yLoc.begin()-1;
 
                 const Real s = (ys-yLoc[l])/(yLoc[l+1]-yLoc[l]);
-                integroPart_(diag, layout->neighbourhood(iter, 1, l-yIndex))
-                    += weight*lambda*(1-s);
-                integroPart_(diag, layout->neighbourhood(iter, 1, l+1-yIndex))
-                    += weight*lambda*s;
+                jumpWeights_[j][l]   += weight*lambda*(1-s);
+                jumpWeights_[j][l+1] += weight*lambda*s;
+
+                jumpBegin_[j] = std::min(jumpBegin_[j], l);
+                jumpEnd_[j] = std::max(jumpEnd_[j], l+2);
             }
         }
-#endif
     }
 
     Size FdmExtOUJumpOp::size() const {
@@ -143,6 +108,10 @@ namespace QuantLib {
         return  integro(r);
     }
 
+    void FdmExtOUJumpOp::apply_mixed(const Array& r, Array& out) const {
+        integro(r, out);
+    }
+
     Disposable<Array> FdmExtOUJumpOp::apply_direction(Size direction,
                                                       const Array& r) const {
         if (direction == 0)
@@ -175,90 +144,58 @@ namespace QuantLib {
         return ouOp_->solve_splitting(0, r, dt);
     }
 
-#if defined(QL_NO_UBLAS_SUPPORT)
-    FdmExtOUJumpOp::IntegroIntegrand::IntegroIntegrand(
-                    const boost::shared_ptr<LinearInterpolation>& interpl,
-                    const FdmBoundaryConditionSet& bcSet,
-                    Real y, Real eta)
-    : y_      (y),
-      eta_    (eta),
-      bcSet_  (bcSet),
-      interpl_(interpl) { }
-
-    Real FdmExtOUJumpOp::IntegroIntegrand::operator()(Real u) const {
-        const Real y = y_ + u/eta_;
-        Real valueOfDerivative = interpl_->operator()(y, true);
-
-        for (FdmBoundaryConditionSet::const_iterator iter=bcSet_.begin();
-            iter < bcSet_.end(); ++iter) {
-            const boost::shared_ptr<FdmDirichletBoundary> dirichletBC =
-                 boost::dynamic_pointer_cast<FdmDirichletBoundary>(*iter);
-
-            if (dirichletBC != 0) {
-                valueOfDerivative=
-                    dirichletBC->applyAfterApplying(y, valueOfDerivative);
-            }
-        }
-
-        return std::exp(-u)*valueOfDerivative;
+    Disposable<Array> FdmExtOUJumpOp::integro(const Array& r) const {
+        Array retVal(r.size());
+        integro(r, retVal);
+        return retVal;
     }
 
-    Disposable<Array> FdmExtOUJumpOp::integro(const Array& r) const {
-        Array integral(r.size());
+    void FdmExtOUJumpOp::integro(const Array& r, Array& out) const {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
-        const Size extraDims=layout->size()/(layout->dim()[0]*layout->dim()[1]);
-
-        std::vector<Array>  y(extraDims, Array(layout->dim()[1]));
-        std::vector<Matrix> f(extraDims,
-                              Matrix(layout->dim()[1], layout->dim()[0]));
-
-        const FdmLinearOpIterator endIter = layout->end();
-        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
-            ++iter) {
-            const Size i = iter.coordinates()[0];
-            const Size j = iter.coordinates()[1];
-            const Size k = iter.index() / (layout->dim()[0]*layout->dim()[1]);
-
-            y[k][j]    = mesher_->location(iter, 1);
-            f[k][j][i] = r[iter.index()];
-        }
-        std::vector<std::vector<boost::shared_ptr<LinearInterpolation> > >
-            interpl(extraDims, std::vector<
-                     boost::shared_ptr<LinearInterpolation> >(f[0].columns()));
-
-        for (Size k=0; k < extraDims; ++k) {
-            for (Size i=0; i < f[k].columns(); ++i) {
-                interpl[k][i] = boost::shared_ptr<LinearInterpolation>(
-                    new LinearInterpolation(y[k].begin(), y[k].end(),
-                                            f[k].column_begin(i)));
+        const Size ny = layout->dim()[1];
+        const Size stride = layout->spacing()[1];
+        const Size slabs = r.size()/(ny*stride);
+
+        // each row of the result is the combination of a few rows
+        // of r along y; the rows are independent of each other.
+        #pragma omp parallel for
+        for (Size q=0; q < ny*slabs; ++q) {
+            const Size j = q % ny;
+            const Size base = (q/ny)*ny*stride;
+            Real* const o = out.begin() + base + j*stride;
+
+            std::fill(o, o+stride, 0.0);
+            for (Size l=jumpBegin_[j]; l < jumpEnd_[j]; ++l) {
+                const Real w = jumpWeights_[j][l];
+                const Real* const v = r.begin() + base + l*stride;
+                for (Size i=0; i < stride; ++i)
+                    o[i] += w*v[i];
             }
         }
-
-        const Real eta = process_->eta();
-
-        for (FdmLinearOpIterator iter=layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.coordinates()[0];
-            const Size j = iter.coordinates()[1];
-            const Size k = iter.index() / (layout->dim()[0]*layout->dim()[1]);
-
-            integral[iter.index()] = gaussLaguerreIntegration_(
-                        IntegroIntegrand(interpl[k][i], bcSet_, y[k][j], eta));
-        }
-
-        return process_->jumpIntensity()*(integral-r);
-    }
-#else
-    Disposable<Array> FdmExtOUJumpOp::integro(const Array& r) const {
-        return prod(integroPart_, r);
     }
 
+#if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmExtOUJumpOp::toMatrixDecomp() const {
         QL_REQUIRE(bcSet_.empty(), "boundary conditions are not supported");
 
         std::vector<SparseMatrix> retVal(1, ouOp_->toMatrixDecomp().front());
         retVal.push_back(dyMap_.toMatrix());
-        retVal.push_back(integroPart_);
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        SparseMatrix integroPart(layout->size(), layout->size());
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+            ++iter) {
+            const Size j = iter.coordinates()[1];
+            for (Size l=jumpBegin_[j]; l < jumpEnd_[j]; ++l) {
+                const Integer offset = Integer(l) - Integer(j);
+                integroPart(iter.index(),
+                            layout->neighbourhood(iter, 1, offset))
+                    = jumpWeights_[j][l];
+            }
+        }
+        retVal.push_back(integroPart);
 
         return retVal;
     }
@@ -24,6 +24,7 @@
 #ifndef quantlib_fdm_ext_ou_jump_op_hpp
 #define quantlib_fdm_ext_ou_jump_op_hpp
 
+#include <ql/math/matrix.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
@@ -34,13 +35,15 @@ namespace QuantLib {
     
     class FdmMesher;
     class YieldTermStructure;
-    class LinearInterpolation;
     class ExtOUWithJumpsProcess;
     class FdmExtendedOrnsteinUhlenbackOp;
     
     /*! References:
         Kluge, Timo L., 2008. Pricing Swing Options and other 
         Electricity Derivatives, http://eprints.maths.ox.ac.uk/246/1/kluge.pdf
+
+        \warning The boundary conditions are not applied to the jump
+                 integral.
     */
 
     class FdmExtOUJumpOp : public FdmLinearOpComposite {
@@ -56,6 +59,7 @@ namespace QuantLib {
 
         Disposable<Array> apply(const Array& r) const;
         Disposable<Array> apply_mixed(const Array& r) const;
+        void apply_mixed(const Array& r, Array& out) const;
 
         Disposable<Array> apply_direction(Size direction,
                                           const Array& r) const;
@@ -68,6 +72,7 @@ namespace QuantLib {
 #endif
       private:
         Disposable<Array> integro(const Array& r) const;
+        void integro(const Array& r, Array& out) const;
 
         const boost::shared_ptr<FdmMesher> mesher_;
         const boost::shared_ptr<ExtOUWithJumpsProcess> process_;
@@ -80,23 +85,15 @@ namespace QuantLib {
 
         const TripleBandLinearOp dyMap_;
 
-#if defined(QL_NO_UBLAS_SUPPORT)
-        class IntegroIntegrand {
-          public:
-            IntegroIntegrand(const boost::shared_ptr<LinearInterpolation>& i,
-                             const FdmBoundaryConditionSet& bcSet,
-                             Real y, Real eta);
-            Real operator()(Real u) const;
-            
-          private:
-            const Real y_, eta_;
-            const FdmBoundaryConditionSet& bcSet_;
-            const boost::shared_ptr<LinearInterpolation>& interpl_;
-        };
-            
-#else
-        SparseMatrix integroPart_;
-#endif
+        /* The jump integral acts along the y direction only and is
+           the same on every line of the mesh in that direction.  It
+           is discretized once, by Gauss-Laguerre quadrature of the
+           linear interpolation of the values, into a banded matrix;
+           row j has its non-null weights in the columns
+           [jumpBegin_[j], jumpEnd_[j]).
+        */
+        Matrix jumpWeights_;
+        std::vector<Size> jumpBegin_, jumpEnd_;
     };
 }
 
@@ -206,6 +206,54 @@ namespace QuantLib {
         return solve_splitting(0, u, dt);
     }
 
+    const Array& FdmHestonFwdOp::leveraged(const Array& u) const {
+        if (!leverageFct_)
+            return u;
+        if (lu_.size() != u.size())
+            lu_ = Array(u.size());
+        for (Size i=0; i < u.size(); ++i)
+            lu_[i] = L_[i]*u[i];
+        return lu_;
+    }
+
+    void FdmHestonFwdOp::apply(const Array& u, Array& out) const {
+        if (tmp_.size() != u.size())
+            tmp_ = Array(u.size());
+
+        mapX_->apply(u, out);
+        mapY_->apply(u, tmp_);
+        for (Size i=0; i < out.size(); ++i)
+            out[i] += tmp_[i];
+
+        correlation_->apply(leveraged(u), tmp_);
+        for (Size i=0; i < out.size(); ++i)
+            out[i] += tmp_[i];
+    }
+
+    void FdmHestonFwdOp::apply_mixed(const Array& u, Array& out) const {
+        correlation_->apply(leveraged(u), out);
+    }
+
+    void FdmHestonFwdOp::apply_direction(
+        Size direction, const Array& u, Array& out) const {
+        if (direction == 0)
+            mapX_->apply(u, out);
+        else if (direction == 1)
+            mapY_->apply(u, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonFwdOp::solve_splitting(
+        Size direction, const Array& u, Real s, Array& out) const {
+        if (direction == 0)
+            mapX_->solve_splitting(u, s, 1.0, out);
+        else if (direction == 1)
+            mapY_->solve_splitting(1, u, s, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
     Disposable<Array> FdmHestonFwdOp::getLeverageFctSlice(Time t1, Time t2)
     const {
         const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
@@ -61,6 +61,13 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& out) const;
+        void apply_mixed(const Array& r, Array& out) const;
+        void apply_direction(Size direction,
+                             const Array& r, Array& out) const;
+        void solve_splitting(Size direction,
+                             const Array& r, Real s, Array& out) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -86,6 +93,10 @@ namespace QuantLib {
         const boost::shared_ptr<LocalVolTermStructure> leverageFct_;
         const boost::shared_ptr<FdmMesher> mesher_;
         const Array x_;
+
+        // scratch space of the in-place methods
+        mutable Array tmp_, lu_;
+        const Array& leveraged(const Array& u) const;
     };
 }
 
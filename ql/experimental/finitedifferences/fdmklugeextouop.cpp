@@ -82,6 +82,11 @@ namespace QuantLib {
         return  corrMap_.apply(r) + klugeOp_->apply_mixed(r);
     }
 
+    void FdmKlugeExtOUOp::apply_mixed(const Array& r, Array& out) const {
+        klugeOp_->apply_mixed(r, out);
+        out += corrMap_.apply(r);
+    }
+
     Disposable<Array> FdmKlugeExtOUOp::apply_direction(Size direction,
                                                        const Array& r) const {
         return klugeOp_->apply_direction(direction, r)
@@ -75,6 +75,7 @@ namespace QuantLib {
 
         Disposable<Array> apply(const Array& r) const;
         Disposable<Array> apply_mixed(const Array& r) const;
+        void apply_mixed(const Array& r, Array& out) const;
 
         Disposable<Array> apply_direction(Size direction,
                                           const Array& r) const;
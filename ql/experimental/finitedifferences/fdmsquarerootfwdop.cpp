@@ -332,6 +332,26 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmSquareRootFwdOp::apply(const Array& r, Array& out) const {
+        mapX_->apply(r, out);
+    }
+
+    void FdmSquareRootFwdOp::apply_direction(
+        Size direction, const Array& r, Array& out) const {
+        if (direction == direction_)
+            mapX_->apply(r, out);
+        else
+            std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmSquareRootFwdOp::solve_splitting(
+        Size direction, const Array& r, Real dt, Array& out) const {
+        if (direction == direction_)
+            mapX_->solve_splitting(r, dt, 1.0, out);
+        else
+            std::copy(r.begin(), r.end(), out.begin());
+    }
+
     #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmSquareRootFwdOp::toMatrixDecomp() const {
@@ -88,25 +88,37 @@ namespace QuantLib {
         boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
 
         const Size nStates = layout->dim()[stateDirection_];
+        const Size stride = layout->spacing()[stateDirection_];
         const FdmLinearOpIterator endIter = layout->end();
 
-        for (FdmLinearOpIterator iter=layout->begin();iter != endIter; ++iter) {
-            a[iter.index()] += evolve(iter, t);
-        }
-
+        // The prices don't depend on the state; they're calculated
+        // once per line of states, and serially since the calculators
+        // are not required to be thread-safe.
+        std::vector<Size> lines;
+        std::vector<Real> gasPrices, sparkSpreads;
+        lines.reserve(layout->size()/nStates);
+        gasPrices.reserve(layout->size()/nStates);
+        sparkSpreads.reserve(layout->size()/nStates);
         for (FdmLinearOpIterator iter=layout->begin();iter != endIter; ++iter) {
             if (!iter.coordinates()[stateDirection_]) {
+                lines.push_back(iter.index());
+                gasPrices.push_back(gasPrice_->innerValue(iter, t));
+                sparkSpreads.push_back(sparkSpreadPrice_->innerValue(iter, t));
+            }
+        }
 
-                Array x(nStates);
-                for (Size i=0; i < nStates; ++i) {
-                    x[i] = a[layout->neighbourhood(iter, stateDirection_, i)];
-                }
+        #pragma omp parallel for
+        for (Size k=0; k < lines.size(); ++k) {
+            Array x(nStates);
+            for (Size i=0; i < nStates; ++i) {
+                x[i] = a[lines[k] + i*stride];
+                if (!stateEvolveFcts_[i].empty())
+                    x[i] += stateEvolveFcts_[i](sparkSpreads[k]);
+            }
 
-                const Real gasPrice = gasPrice_->innerValue(iter, t);
-                x = changeState(gasPrice, x, t);
-                for (Size i=0; i < nStates; ++i) {
-                    a[layout->neighbourhood(iter, stateDirection_, i)] = x[i];
-                }
+            x = changeState(gasPrices[k], x, t);
+            for (Size i=0; i < nStates; ++i) {
+                a[lines[k] + i*stride] = x[i];
             }
         }
     }
@@ -48,6 +48,11 @@ namespace QuantLib {
         const boost::shared_ptr<FdmMesher> mesher;
     };
 
+    /*! The changes of state on different lines of the mesh are
+        applied in parallel if OpenMP is enabled; changeState() must
+        be thread-safe.  The gas and spark-spread prices must not
+        depend on the state.
+    */
     class FdmVPPStepCondition : public StepCondition<Array> {
       public:
         FdmVPPStepCondition(
@@ -39,6 +39,7 @@ namespace QuantLib {
         Real pdf(Real s, Time t) const;
         Real cdf(Real s, Time t) const;
         Real invcdf(Real q, Time t) const;
+        using RiskNeutralDensityCalculator::invcdf;
 
     private:
         const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
@@ -149,7 +149,7 @@ namespace {
             0.0, 1.0)/M_TWOPI + 0.5;
 
     }
-    Real HestonRNDCalculator::invcdf(Real p, Time t) const {
+    Real HestonRNDCalculator::guess(Real p, Time t) const {
         const Real v0    = hestonProcess_->v0();
         const Real kappa = hestonProcess_->kappa();
         const Real theta = hestonProcess_->theta();
@@ -169,10 +169,25 @@ namespace {
                             expVol,
                             hestonProcess_->riskFreeRate()->dayCounter()))));
 
-        const Real guess = BSMRNDCalculator(bsmProcess).invcdf(p, t);
+        return BSMRNDCalculator(bsmProcess).invcdf(p, t);
+    }
+
+    Real HestonRNDCalculator::invcdf(Real p, Time t) const {
+        return RiskNeutralDensityCalculator::InvCDFHelper(
+            this, guess(p, t), 0.1*integrationEps_, maxIntegrationIterations_)
+            .inverseCDF(p, t);
+    }
+
+    Disposable<Array> HestonRNDCalculator::invcdf(const Array& p, Time t)
+    const {
+        if (p.empty())
+            return Array();
+
+        const Real pm = 0.5*(*std::min_element(p.begin(), p.end())
+                             + *std::max_element(p.begin(), p.end()));
 
         return RiskNeutralDensityCalculator::InvCDFHelper(
-            this, guess, 0.1*integrationEps_, maxIntegrationIterations_)
+            this, guess(pm, t), 0.1*integrationEps_, maxIntegrationIterations_)
             .inverseCDF(p, t);
     }
 }
@@ -53,9 +53,11 @@ namespace QuantLib {
         Real pdf(Real x, Time t) const;
         Real cdf(Real x, Time t) const;
         Real invcdf(Real q, Time t) const;
+        Disposable<Array> invcdf(const Array& q, Time t) const;
 
     private:
         Real x_t(Real x, Time t) const;
+        Real guess(Real q, Time t) const;
 
         const boost::shared_ptr<HestonProcess> hestonProcess_;
         const Real x0_;
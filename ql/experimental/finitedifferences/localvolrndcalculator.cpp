@@ -180,14 +180,10 @@ namespace QuantLib {
         }
     }
 
-    Real LocalVolRNDCalculator::invcdf(Real p, Time t) const {
-        calculate();
-
+    Real LocalVolRNDCalculator::invcdfGuess(Time t) const {
         const Time closeGridTime(timeGrid_->closestTime(t));
         if (closeGridTime == 0.0) {
-            return RiskNeutralDensityCalculator::InvCDFHelper(
-                this, std::log(spot_->value()), 0.1*localVolProbEps_, maxIter_)
-                .inverseCDF(p, t);
+            return std::log(spot_->value());
         }
         else {
             Array xp(xGrid_);
@@ -198,12 +194,27 @@ namespace QuantLib {
             std::transform(x.begin(), x.end(), pm_->row_begin(idx), xp.begin(),
                            std::multiplies<Real>());
 
-            const Real xm = DiscreteSimpsonIntegral()(x, xp);
-            return RiskNeutralDensityCalculator::InvCDFHelper(
-                this, xm, 0.1*localVolProbEps_, maxIter_).inverseCDF(p, t);
+            return DiscreteSimpsonIntegral()(x, xp);
         }
     }
 
+    Real LocalVolRNDCalculator::invcdf(Real p, Time t) const {
+        calculate();
+
+        return RiskNeutralDensityCalculator::InvCDFHelper(
+            this, invcdfGuess(t), 0.1*localVolProbEps_, maxIter_)
+            .inverseCDF(p, t);
+    }
+
+    Disposable<Array> LocalVolRNDCalculator::invcdf(const Array& p, Time t)
+    const {
+        calculate();
+
+        return RiskNeutralDensityCalculator::InvCDFHelper(
+            this, invcdfGuess(t), 0.1*localVolProbEps_, maxIter_)
+            .inverseCDF(p, t);
+    }
+
     boost::shared_ptr<Fdm1dMesher>
     LocalVolRNDCalculator::mesher(Time t) const {
         calculate();
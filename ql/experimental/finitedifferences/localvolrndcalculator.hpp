@@ -69,6 +69,7 @@ namespace QuantLib {
 		Real pdf(Real x, Time t) const;
 		Real cdf(Real x, Time t) const;
 		Real invcdf(Real p, Time t) const;
+		Disposable<Array> invcdf(const Array& p, Time t) const;
 
 		boost::shared_ptr<TimeGrid> timeGrid() const;
 		boost::shared_ptr<Fdm1dMesher> mesher(Time t) const;
@@ -79,6 +80,7 @@ namespace QuantLib {
 
 	  private:
 		Real probabilityInterpolation(Size idx, Real x) const;
+		Real invcdfGuess(Time t) const;
 		Disposable<Array> rescalePDF(const Array& x, const Array& p) const;
 
 
@@ -38,9 +38,17 @@ namespace QuantLib {
         explicit ModTripleBandLinearOp(const TripleBandLinearOp& m)
         : TripleBandLinearOp(m) { }
 
-        boost::shared_array<Real>& lower() { return lower_; }
-        boost::shared_array<Real>& diag()  { return diag_; }
-        boost::shared_array<Real>& upper() { return upper_; }
+        // the stored factorization is dropped since the
+        // coefficients are presumably going to be modified
+        boost::shared_array<Real>& lower() {
+            invalidateFactorization(); return lower_;
+        }
+        boost::shared_array<Real>& diag() {
+            invalidateFactorization(); return diag_;
+        }
+        boost::shared_array<Real>& upper() {
+            invalidateFactorization(); return upper_;
+        }
     };
 }
 
@@ -20,6 +20,7 @@
 
 #include <ql/math/functional.hpp>
 #include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
 
 #include <ql/experimental/finitedifferences/riskneutraldensitycalculator.hpp>
 
@@ -33,8 +34,19 @@
 #endif
 
 #include <boost/function.hpp>
+#include <algorithm>
 
 namespace QuantLib {
+
+    Disposable<Array> RiskNeutralDensityCalculator::invcdf(
+        const Array& p, Time t) const {
+        Array x(p.size());
+        for (Size i=0; i < p.size(); ++i)
+            x[i] = invcdf(p[i], t);
+
+        return x;
+    }
+
     RiskNeutralDensityCalculator::InvCDFHelper::InvCDFHelper(
         const RiskNeutralDensityCalculator* calculator,
         Real guess, Real accuracy, Size maxEvaluations)
@@ -70,4 +82,79 @@ namespace QuantLib {
         return solver.solve(compose(std::bind2nd(std::minus<Real>(), p), cdf),
                             accuracy_, 0.5*(lower + upper), lower, upper);
     }
+
+    Disposable<Array>
+    RiskNeutralDensityCalculator::InvCDFHelper::inverseCDF(
+        const Array& p, Time t, Real maxStep) const {
+        Array x(p.size());
+        if (p.empty())
+            return x;
+
+        const Real pMin = *std::min_element(p.begin(), p.end());
+        const Real pMax = *std::max_element(p.begin(), p.end());
+        QL_REQUIRE(pMin > 0.0 && pMax < 1.0,
+                   "probabilities must be in (0, 1)");
+
+        const Real lower = inverseCDF(pMin, t);
+        if (pMax == pMin) {
+            std::fill(x.begin(), x.end(), lower);
+            return x;
+        }
+        const Real upper = inverseCDF(pMax, t);
+
+        // tabulate the cumulative distribution between the bounds,
+        // bisecting the intervals with large increments
+        const Size n0 = 16;
+        std::vector<Real> xs(n0+1), cs(n0+1);
+        xs.front() = lower; cs.front() = pMin;
+        xs.back() = upper;  cs.back() = pMax;
+        for (Size i=1; i < n0; ++i) {
+            xs[i] = lower + i*(upper-lower)/n0;
+            cs[i] = calculator_->cdf(xs[i], t);
+        }
+
+        Size evaluations = maxEvaluations_;
+        for (bool refined = true; refined && evaluations > 0;) {
+            refined = false;
+            std::vector<Real> xn(1, xs.front()), cn(1, cs.front());
+            for (Size i=1; i < xs.size(); ++i) {
+                if (cs[i]-cs[i-1] > maxStep && evaluations > 0) {
+                    const Real xm = 0.5*(xs[i-1]+xs[i]);
+                    xn.push_back(xm);
+                    cn.push_back(calculator_->cdf(xm, t));
+                    --evaluations;
+                    refined = true;
+                }
+                xn.push_back(xs[i]);
+                cn.push_back(cs[i]);
+            }
+            xs.swap(xn);
+            cs.swap(cn);
+        }
+
+        // the interpolation needs strictly increasing probabilities
+        std::vector<Real> xi(1, xs.front()), ci(1, cs.front());
+        for (Size i=1; i < xs.size(); ++i) {
+            if (cs[i] > ci.back() && (cs[i] < pMax || i == xs.size()-1)) {
+                xi.push_back(xs[i]);
+                ci.push_back(cs[i]);
+            }
+        }
+
+        const MonotonicCubicNaturalSpline interpl(
+            ci.begin(), ci.end(), xi.begin());
+
+        for (Size i=0; i < p.size(); ++i) {
+            const Real guess = interpl(p[i], true);
+
+            const Real pdf = calculator_->pdf(guess, t);
+            const Real polished = (pdf > 0.0)
+                ? guess - (calculator_->cdf(guess, t) - p[i])/pdf : guess;
+
+            x[i] = (polished >= lower && polished <= upper)
+                ? polished : guess;
+        }
+
+        return x;
+    }
 }
@@ -25,7 +25,7 @@
 #ifndef quantlib_risk_neutral_density_calculator_hpp
 #define quantlib_risk_neutral_density_calculator_hpp
 
-#include <ql/types.hpp>
+#include <ql/math/array.hpp>
 
 namespace QuantLib {
     class RiskNeutralDensityCalculator {
@@ -33,6 +33,11 @@ namespace QuantLib {
         virtual Real pdf(Real x, Time t) const = 0;
         virtual Real cdf(Real x, Time t) const = 0;
         virtual Real invcdf(Real p, Time t) const = 0;
+        /*! returns the inverse of the cumulative distribution for a
+            set of probabilities. The default implementation calls
+            invcdf(Real, Time) for each probability.
+        */
+        virtual Disposable<Array> invcdf(const Array& p, Time t) const;
 
         virtual ~RiskNeutralDensityCalculator() {}
 
@@ -43,6 +48,14 @@ namespace QuantLib {
                          Real guess, Real accuracy, Size maxEvaluations);
 
             Real inverseCDF(Real p, Time t) const;
+            /*! The bracket of the probabilities is found by two
+                root searches; the cumulative distribution is then
+                tabulated once on a grid refined until the increments
+                are below maxStep, and inverted by monotonic cubic
+                interpolation followed by a single Newton step.
+            */
+            Disposable<Array> inverseCDF(const Array& p, Time t,
+                                         Real maxStep = 0.005) const;
           private:
             const RiskNeutralDensityCalculator* const calculator_;
             const Real guess_;
@@ -37,6 +37,7 @@ namespace QuantLib {
         Real pdf(Real v, Time t) const;
         Real cdf(Real v, Time t) const;
         Real invcdf(Real q, Time t) const;
+        using RiskNeutralDensityCalculator::invcdf;
 
         Real stationary_pdf(Real v) const;
         Real stationary_cdf(Real v) const;
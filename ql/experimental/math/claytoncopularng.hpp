@@ -25,8 +25,10 @@
 #ifndef quantlib_clayton_copula_rng_hpp
 #define quantlib_clayton_copula_rng_hpp
 
+#include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -39,6 +41,14 @@ namespace QuantLib {
         typedef RNG urng_type;
         explicit ClaytonCopulaRng(const RNG& uniformGenerator,Real theta);
         sample_type next() const;
+        //! fills the buffers with the components of the next n samples
+        /*! The samples are those that n calls to next() would
+            return, the underlying uniform variates being drawn in
+            blocks; their weights are not returned.
+
+            \pre u1 and u2 must have room for n values each
+        */
+        void nextReals(Size n, Real* u1, Real* u2) const;
       private:
         Real theta_;
         RNG uniformGenerator_;
@@ -66,6 +76,26 @@ namespace QuantLib {
         return sample_type(u,v1.weight*v2.weight);
     }
 
+    template <class RNG>
+    inline void ClaytonCopulaRng<RNG>::nextReals(Size n,
+                                                 Real* u1,
+                                                 Real* u2) const {
+        const Size blockSize = 256;
+        Real v[2*blockSize];
+        while (n > 0) {
+            Size m = std::min(blockSize, n);
+            detail::NextReals<RNG>::apply(uniformGenerator_, 2*m, v);
+            for (Size i=0; i<m; ++i) {
+                Real v1 = v[2*i], v2 = v[2*i+1];
+                u1[i] = v1;
+                u2[i] = std::pow(std::pow(v1,-theta_)*(std::pow(v2,-theta_/(theta_+1.0))-1.0)+1.0,-1.0/theta_);
+            }
+            u1 += m;
+            u2 += m;
+            n -= m;
+        }
+    }
+
 }
 
 
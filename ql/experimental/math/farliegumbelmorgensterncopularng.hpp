@@ -25,8 +25,10 @@
 #ifndef quantlib_farlie_gumbel_morgenstern_copula_rng_hpp
 #define quantlib_farlie_gumbel_morgenstern_copula_rng_hpp
 
+#include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -40,6 +42,14 @@ namespace QuantLib {
         explicit FarlieGumbelMorgensternCopulaRng(const RNG& uniformGenerator,
                                                   Real theta);
         sample_type next() const;
+        //! fills the buffers with the components of the next n samples
+        /*! The samples are those that n calls to next() would
+            return, the underlying uniform variates being drawn in
+            blocks; their weights are not returned.
+
+            \pre u1 and u2 must have room for n values each
+        */
+        void nextReals(Size n, Real* u1, Real* u2) const;
       private:
         Real theta_;
         RNG uniformGenerator_;
@@ -68,6 +78,27 @@ namespace QuantLib {
         return sample_type(u,v1.weight*v2.weight);
     }
 
+    template <class RNG>
+    inline void FarlieGumbelMorgensternCopulaRng<RNG>::nextReals(
+                                  Size n, Real* u1, Real* u2) const {
+        const Size blockSize = 256;
+        Real v[2*blockSize];
+        while (n > 0) {
+            Size m = std::min(blockSize, n);
+            detail::NextReals<RNG>::apply(uniformGenerator_, 2*m, v);
+            for (Size i=0; i<m; ++i) {
+                Real v1 = v[2*i], v2 = v[2*i+1];
+                Real a = theta_*(2.0*v1-1.0);
+                Real b = pow(1.0-theta_*(2.0*v1-1.0),2.0)+4.0*theta_*v2*(2.0*v1-1.0);
+                u1[i] = v1;
+                u2[i] = (2.0*v2)/(sqrt(b)-a);
+            }
+            u1 += m;
+            u2 += m;
+            n -= m;
+        }
+    }
+
 }
 
 
@@ -31,13 +31,14 @@ namespace QuantLib {
         boost::shared_ptr<Intensity> intensity,
         boost::shared_ptr<RandomWalk> randomWalk,
         Size Mde, Real mutation,
-        Real crossover, unsigned long seed):
+        Real crossover, unsigned long seed,
+        const PopulationEvaluator& evaluator):
         mutation_(mutation), crossover_(crossover),
         M_(M), Mde_(Mde), Mfa_(M_-Mde_), 
         intensity_(intensity),
         randomWalk_(randomWalk),
         drawIndex_(base_generator_type(seed), uniform_integer(Mfa_, Mde > 0 ? M_-1 : M_)),
-        rng_(seed){
+        rng_(seed), evaluator_(evaluator) {
         QL_REQUIRE(M_ >= Mde_,
             "Differential Evolution subpopulation cannot be larger than total population");
     }
@@ -66,10 +67,13 @@ namespace QuantLib {
                 //Assign X=lb+(ub-lb)*random
                 x[j] = lX_[j] + bounds[j] * sample[j];
             }
-            //Evaluate point
-            values_.push_back(std::make_pair(P.value(x), i));
         }
 
+        //Evaluate points
+        Array values = evaluator_.values(P, x_);
+        for (Size i = 0; i < M_; i++)
+            values_.push_back(std::make_pair(values[i], i));
+
         //init intensity & randomWalk
         intensity_->init(this);
         randomWalk_->init(this);
@@ -90,6 +94,9 @@ namespace QuantLib {
         //Variables for DE
         Array z(N_, 0.0);
         Size indexR1, indexR2;
+        bool serial = evaluator_.type() == PopulationEvaluator::Serial;
+        std::vector<Array> trials;
+        std::vector<Size> trialIndices;
         uniform_integer::param_type nParam(0, N_ - 1);
 
         //Set best value & position
@@ -152,18 +159,30 @@ namespace QuantLib {
                             z[j] = uX_[j];
                         }
                     }
-                    Real val = P.value(z);
-                    if (val < values_[index].first) {
-                        //Accept new point
-                        x = z;
-                        values_[index].first = val;
-                        //mark best
-                        if (val < bestValue) {
-                            bestValue = val;
-                            bestX = x;
-                            iterationStat = 0;
+                    trials.push_back(z);
+                    trialIndices.push_back(index);
+                    if (!serial && i < M_ - 1)
+                        continue;
+
+                    //Evaluate new points
+                    Array vals = evaluator_.values(P, trials);
+                    for (Size k = 0; k < trials.size(); k++) {
+                        Size trialIndex = trialIndices[k];
+                        Real val = vals[k];
+                        if (val < values_[trialIndex].first) {
+                            //Accept new point
+                            x_[trialIndex] = trials[k];
+                            values_[trialIndex].first = val;
+                            //mark best
+                            if (val < bestValue) {
+                                bestValue = val;
+                                bestX = x_[trialIndex];
+                                iterationStat = 0;
+                            }
                         }
                     }
+                    trials.clear();
+                    trialIndices.clear();
                 }
             }
                 
@@ -194,20 +213,29 @@ namespace QuantLib {
                             z[j] = uX_[j];
                         }
                     }
-                    Real val = P.value(z);
-                    if(!boost::math::isnan(val))
-					{
-						//Accept new point
-                        x = z;
+                    trials.push_back(z);
+                    trialIndices.push_back(index);
+                }
+
+                //Evaluate new points
+                Array vals = evaluator_.values(P, trials);
+                for (Size k = 0; k < trials.size(); k++) {
+                    Size index = trialIndices[k];
+                    Real val = vals[k];
+                    if (!boost::math::isnan(val)) {
+                        //Accept new point
+                        x_[index] = trials[k];
                         values_[index].first = val;
                         //mark best
                         if (val < bestValue) {
                             bestValue = val;
-                            bestX = x;
+                            bestX = x_[index];
                             iterationStat = 0;
                         }
-					}
+                    }
                 }
+                trials.clear();
+                trialIndices.clear();
             }
         } while (true);
         if (iteration > maxIteration)
@@ -37,6 +37,7 @@ http://arxiv.org/pdf/1003.1464.pdf
 #include <ql/experimental/math/levyflightdistribution.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/seedgenerator.hpp>
+#include <ql/math/optimization/populationevaluator.hpp>
 
 #include <boost/random/mersenne_twister.hpp>
 typedef boost::mt19937 base_generator_type;
@@ -81,6 +82,13 @@ namespace QuantLib {
                     if R_{i,j} > CR X_{i,j}^{k+1}
     Where CR is the crossover constant, and R is a random uniformly distributed
     number
+
+    The new points are evaluated with the given PopulationEvaluator.
+    With the serial evaluator, each DE point is evaluated (and possibly
+    accepted) before the next one is generated, as in the original
+    algorithm; with the other evaluators, all the DE points of an
+    iteration are generated from the current positions and evaluated
+    together.  The firefly moves are evaluated together in all cases.
     */
     class FireflyAlgorithm : public OptimizationMethod {
       public:
@@ -92,7 +100,8 @@ namespace QuantLib {
             boost::shared_ptr<Intensity> intensity,
             boost::shared_ptr<RandomWalk> randomWalk,
             Size Mde = 0, Real mutationFactor = 1.0,
-            Real crossoverFactor = 0.5, unsigned long seed = SeedGenerator::instance().get());
+            Real crossoverFactor = 0.5, unsigned long seed = SeedGenerator::instance().get(),
+            const PopulationEvaluator& evaluator = PopulationEvaluator());
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem &P, const EndCriteria &endCriteria);
 
@@ -106,6 +115,7 @@ namespace QuantLib {
         boost::shared_ptr<RandomWalk> randomWalk_;
         variate_integer drawIndex_;
         MersenneTwisterUniformRng rng_;
+        PopulationEvaluator evaluator_;
     };
 
     //! Base intensity class
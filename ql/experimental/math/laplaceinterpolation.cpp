@@ -0,0 +1,114 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 Peter Caspers
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/math/laplaceinterpolation.hpp>
+#include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrilupreconditioner.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/bind.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+void laplaceInterpolation(std::vector<Real> &values,
+                          const std::vector<Size> &dims, Real relTol) {
+
+    Size size = 1;
+    for (Size d = 0; d < dims.size(); ++d)
+        size *= dims[d];
+    QL_REQUIRE(!dims.empty() && size == values.size(),
+               "grid dimensions don't match the number of values ("
+                   << values.size() << ")");
+
+    // strides of the row-major layout
+    std::vector<Size> strides(dims.size());
+    for (Size d = dims.size(), s = 1; d-- > 0;) {
+        strides[d] = s;
+        s *= dims[d];
+    }
+
+    // number the missing values, which are the unknowns
+    std::vector<Size> unknown(size, Null<Size>()), missing;
+    Real sum = 0.0;
+    for (Size i = 0; i < size; ++i) {
+        if (values[i] == Null<Real>()) {
+            unknown[i] = missing.size();
+            missing.push_back(i);
+        } else {
+            sum += values[i];
+        }
+    }
+    if (missing.empty())
+        return;
+    QL_REQUIRE(missing.size() < size, "no values given");
+
+    // each missing value times the number of its neighbours minus
+    // its missing neighbours equals the sum of its given neighbours
+    const Size n = missing.size();
+    std::vector<Size> rowPointers(1, 0), columnIndices;
+    std::vector<Real> entries;
+    columnIndices.reserve(n * (2 * dims.size() + 1));
+    entries.reserve(n * (2 * dims.size() + 1));
+    Array rhs(n, 0.0);
+    std::vector<std::pair<Size, Real> > row;
+
+    for (Size k = 0; k < n; ++k) {
+        const Size i = missing[k];
+        Size neighbours = 0;
+        row.clear();
+        for (Size d = 0; d < dims.size(); ++d) {
+            const Size c = (i / strides[d]) % dims[d];
+            for (Integer side = -1; side <= 1; side += 2) {
+                if ((side < 0 && c == 0) || (side > 0 && c + 1 == dims[d]))
+                    continue;
+                const Size j = (side < 0) ? i - strides[d] : i + strides[d];
+                ++neighbours;
+                if (unknown[j] != Null<Size>())
+                    row.push_back(std::make_pair(unknown[j], -1.0));
+                else
+                    rhs[k] += values[j];
+            }
+        }
+        QL_REQUIRE(neighbours > 0, "no neighbours for missing value");
+        row.push_back(std::make_pair(k, Real(neighbours)));
+
+        std::sort(row.begin(), row.end());
+        for (Size l = 0; l < row.size(); ++l) {
+            columnIndices.push_back(row[l].first);
+            entries.push_back(row[l].second);
+        }
+        rowPointers.push_back(columnIndices.size());
+    }
+
+    const CsrMatrix g(n, n, rowPointers, columnIndices, entries);
+    const CsrILUPreconditioner ilu(g);
+
+    const Array guess(n, sum / (size - n));
+    const Array s =
+        BiCGstab(g, 10 * n, relTol,
+                 boost::bind(&CsrILUPreconditioner::apply, &ilu, _1))
+            .solve(rhs, guess)
+            .x;
+
+    // replace missing values by solution
+    for (Size k = 0; k < n; ++k)
+        values[missing[k]] = s[k];
+}
+
+} // namespace QuantLib
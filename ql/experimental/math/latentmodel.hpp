@@ -805,8 +805,10 @@ namespace QuantLib {
             Size i=0;
             for(; i<trng_.size(); i++)//systemic samples plus one idiosyncratic
                 sequence_.value[i] = trng_[i].next().value;
-            for(; i<sequence_.value.size(); i++)//rest of idiosyncratic samples
-                sequence_.value[i] = trng_.back().next().value;
+            //rest of idiosyncratic samples, drawn at once
+            if (i < sequence_.value.size())
+                trng_.back().nextReals(sequence_.value.size()-i,
+                                       &sequence_.value[i]);
             return sequence_;
         }
     private:
@@ -21,18 +21,345 @@
 
 #ifndef QL_PATCH_SOLARIS
 
+#include <map>
+
 namespace QuantLib {
 
+    namespace {
+
+        // number of points evaluated in sequence by the sparse-grid
+        // integrator; the blocks are the unit of work of the threads
+        const Size sparseGridBlockSize = 256;
+
+        Real binomial(Size n, Size k) {
+            Real result = 1.0;
+            for (Size i=1; i<=k; ++i)
+                result = result*(n-k+i)/i;
+            return result;
+        }
+
+        // adds the level vectors l with l_i >= 1 and a given range of
+        // |l|_1 to the given list, from the i-th coordinate onwards
+        void levelVectors(std::vector<Size>& l, Size i, Size sum,
+                          Size minSum, Size maxSum,
+                          std::vector<std::vector<Size> >& result) {
+            if (i == l.size()) {
+                if (sum >= minSum)
+                    result.push_back(l);
+                return;
+            }
+            // the remaining coordinates take at least one each
+            const Size remaining = l.size()-i-1;
+            for (Size k=1; sum+k+remaining <= maxSum; ++k) {
+                l[i] = k;
+                levelVectors(l, i+1, sum+k, minSum, maxSum, result);
+            }
+        }
+
+    }
+
     GaussianQuadMultidimIntegrator::GaussianQuadMultidimIntegrator(
-        Size dimension, Size quadOrder, Real mu) 
-        : integral_(quadOrder, mu),
-          integralV_(quadOrder, mu),
-          integrationEntries_(maxDimensions_),
-          integrationEntriesVR_(maxDimensions_),
-          dimension_(dimension),
-          varBuffer_(dimension_, 0.)
+        Size dimension, Size quadOrder, Real mu, bool parallel)
+    : integral_(quadOrder, mu), dimension_(dimension), parallel_(parallel) {
+        QL_REQUIRE(dimension > 0, "null dimension given");
+    }
+
+    Real GaussianQuadMultidimIntegrator::innerIntegral(
+                                            const ScalarFunction& f,
+                                            std::vector<Real>& x,
+                                            Size n) const {
+        const Array& nodes = integral_.x();
+        const Array& weights = integral_.weights();
+        Real sum = 0.0;
+        for (Integer i = order()-1; i >= 0; --i) {
+            x[n-1] = nodes[i];
+            sum += weights[i] * (n == 1 ? f(x) : innerIntegral(f, x, n-1));
+        }
+        return sum;
+    }
+
+    detail::DispArray GaussianQuadMultidimIntegrator::innerIntegral(
+                                            const VectorFunction& f,
+                                            std::vector<Real>& x,
+                                            Size n) const {
+        const Array& nodes = integral_.x();
+        const Array& weights = integral_.weights();
+        std::vector<Real> sum, term;
+        for (Integer i = order()-1; i >= 0; --i) {
+            x[n-1] = nodes[i];
+            if (n == 1)
+                term = f(x);
+            else
+                term = innerIntegral(f, x, n-1);
+            // we do not know the size of the result before the
+            // first evaluation
+            sum.resize(term.size(), 0.0);
+            for (Size j=0; j<term.size(); ++j)
+                sum[j] += weights[i] * term[j];
+        }
+        return sum;
+    }
+
+    template<>
+    Real GaussianQuadMultidimIntegrator::integrate<Real>(
+        const boost::function<Real (const std::vector<Real>& v1)>& f) const
+    {
+        std::vector<Real> x(dimension_);
+        if (!parallel_ || dimension_ == 1)
+            return innerIntegral(f, x, dimension_);
+
+        // the sum over the outermost dimension is done afterwards, in
+        // the same order, so that the result is the same as above
+        const Size n = order();
+        std::vector<Real> values(n);
+        std::vector<std::string> errors(n);
+        // not vector<bool>, whose elements can't be written concurrently
+        std::vector<int> failed(n, 0);
+
+        #pragma omp parallel for schedule(dynamic) firstprivate(x)
+        for (long i=0; i < long(n); ++i) {
+            try {
+                x[dimension_-1] = integral_.x()[i];
+                values[i] = innerIntegral(f, x, dimension_-1);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+                failed[i] = 1;
+            } catch (...) {
+                errors[i] = "unknown error";
+                failed[i] = 1;
+            }
+        }
+
+        const Array& weights = integral_.weights();
+        Real sum = 0.0;
+        for (Integer i = n-1; i >= 0; --i) {
+            QL_REQUIRE(!failed[i], errors[i]);
+            sum += weights[i] * values[i];
+        }
+        return sum;
+    }
+
+    template<>
+    detail::DispArray
+    GaussianQuadMultidimIntegrator::integrate<detail::DispArray>(
+        const boost::function<detail::DispArray (
+            const std::vector<Real>& v1)>& f) const
     {
-        spawnFcts<maxDimensions_>();
+        std::vector<Real> x(dimension_);
+        if (!parallel_ || dimension_ == 1)
+            return innerIntegral(f, x, dimension_);
+
+        const Size n = order();
+        std::vector<std::vector<Real> > values(n);
+        std::vector<std::string> errors(n);
+        std::vector<int> failed(n, 0);
+
+        #pragma omp parallel for schedule(dynamic) firstprivate(x)
+        for (long i=0; i < long(n); ++i) {
+            try {
+                x[dimension_-1] = integral_.x()[i];
+                values[i] = innerIntegral(f, x, dimension_-1);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+                failed[i] = 1;
+            } catch (...) {
+                errors[i] = "unknown error";
+                failed[i] = 1;
+            }
+        }
+
+        const Array& weights = integral_.weights();
+        std::vector<Real> sum;
+        for (Integer i = n-1; i >= 0; --i) {
+            QL_REQUIRE(!failed[i], errors[i]);
+            sum.resize(values[i].size(), 0.0);
+            for (Size j=0; j<values[i].size(); ++j)
+                sum[j] += weights[i] * values[i][j];
+        }
+        return sum;
+    }
+
+
+    GaussianQuadSparseGridIntegrator::GaussianQuadSparseGridIntegrator(
+        Size dimension, Size level, Real mu, bool parallel)
+    : dimension_(dimension), level_(level), parallel_(parallel) {
+        QL_REQUIRE(dimension > 0, "null dimension given");
+        QL_REQUIRE(level > 0, "null level given");
+
+        // one-dimensional rules with 2l-1 nodes for l = 1, ..., level;
+        // they are made exactly symmetric, so that their nodes at the
+        // origin are shared and merged
+        std::vector<std::vector<Real> > nodes(level+1), weights(level+1);
+        for (Size k=1; k<=level; ++k) {
+            const Size m = 2*k-1;
+            const GaussHermiteIntegration rule(m, mu);
+            nodes[k].resize(m);
+            weights[k].resize(m);
+            for (Size i=0; i<m; ++i) {
+                const Size j = m-1-i;
+                nodes[k][i] = i == j ? 0.0 : 0.5*(rule.x()[i]-rule.x()[j]);
+                weights[k][i] = 0.5*(rule.weights()[i]+rule.weights()[j]);
+            }
+        }
+
+        // combination technique: Q_{l_1} x ... x Q_{l_d} with
+        // L <= |l| <= L+d-1 and coefficients alternating in sign
+        const Size q = level+dimension-1;
+        std::vector<Size> l(dimension);
+        std::vector<std::vector<Size> > levels;
+        levelVectors(l, 0, 0, level, q, levels);
+
+        std::map<std::vector<Real>, Real> grid;
+        std::vector<Real> x(dimension);
+        std::vector<Size> index(dimension);
+        for (Size k=0; k<levels.size(); ++k) {
+            const std::vector<Size>& lk = levels[k];
+            Size sum = 0;
+            for (Size i=0; i<dimension; ++i)
+                sum += lk[i];
+            const Real coefficient = ((q-sum) % 2 == 0 ? 1.0 : -1.0)
+                                   * binomial(dimension-1, q-sum);
+
+            std::fill(index.begin(), index.end(), 0);
+            for (;;) {
+                Real w = coefficient;
+                for (Size i=0; i<dimension; ++i) {
+                    x[i] = nodes[lk[i]][index[i]];
+                    w *= weights[lk[i]][index[i]];
+                }
+                grid[x] += w;
+
+                // next point of the tensor product
+                Size i = 0;
+                while (i < dimension && ++index[i] == nodes[lk[i]].size())
+                    index[i++] = 0;
+                if (i == dimension)
+                    break;
+            }
+        }
+
+        points_.reserve(grid.size()*dimension);
+        weights_.reserve(grid.size());
+        for (std::map<std::vector<Real>, Real>::const_iterator
+                 i = grid.begin(); i != grid.end(); ++i) {
+            points_.insert(points_.end(), i->first.begin(), i->first.end());
+            weights_.push_back(i->second);
+        }
+    }
+
+    std::vector<Real> GaussianQuadSparseGridIntegrator::point(Size i) const {
+        QL_REQUIRE(i < weights_.size(),
+                   "point #" << i << " requested; only "
+                   << weights_.size() << " points in the grid");
+        return std::vector<Real>(points_.begin()+i*dimension_,
+                                 points_.begin()+(i+1)*dimension_);
+    }
+
+    Real GaussianQuadSparseGridIntegrator::blockIntegral(
+                                     const ScalarFunction& f, Size b) const {
+        const Size first = b*sparseGridBlockSize,
+            last = std::min(first+sparseGridBlockSize, weights_.size());
+        std::vector<Real> x(dimension_);
+        Real sum = 0.0;
+        for (Size i=first; i<last; ++i) {
+            std::copy(points_.begin()+i*dimension_,
+                      points_.begin()+(i+1)*dimension_, x.begin());
+            sum += weights_[i] * f(x);
+        }
+        return sum;
+    }
+
+    detail::DispArray GaussianQuadSparseGridIntegrator::blockIntegral(
+                                     const VectorFunction& f, Size b) const {
+        const Size first = b*sparseGridBlockSize,
+            last = std::min(first+sparseGridBlockSize, weights_.size());
+        std::vector<Real> x(dimension_), sum, term;
+        for (Size i=first; i<last; ++i) {
+            std::copy(points_.begin()+i*dimension_,
+                      points_.begin()+(i+1)*dimension_, x.begin());
+            term = f(x);
+            sum.resize(term.size(), 0.0);
+            for (Size j=0; j<term.size(); ++j)
+                sum[j] += weights_[i] * term[j];
+        }
+        return sum;
+    }
+
+    template<>
+    Real GaussianQuadSparseGridIntegrator::integrate<Real>(
+        const boost::function<Real (const std::vector<Real>& v1)>& f) const
+    {
+        const Size blocks =
+            (weights_.size()+sparseGridBlockSize-1)/sparseGridBlockSize;
+        std::vector<Real> partial(blocks);
+        if (parallel_) {
+            std::vector<std::string> errors(blocks);
+            std::vector<int> failed(blocks, 0);
+
+            #pragma omp parallel for schedule(dynamic)
+            for (long b=0; b < long(blocks); ++b) {
+                try {
+                    partial[b] = blockIntegral(f, b);
+                } catch (std::exception& e) {
+                    errors[b] = e.what();
+                    failed[b] = 1;
+                } catch (...) {
+                    errors[b] = "unknown error";
+                    failed[b] = 1;
+                }
+            }
+            for (Size b=0; b<blocks; ++b)
+                QL_REQUIRE(!failed[b], errors[b]);
+        } else {
+            for (Size b=0; b<blocks; ++b)
+                partial[b] = blockIntegral(f, b);
+        }
+
+        Real sum = 0.0;
+        for (Size b=0; b<blocks; ++b)
+            sum += partial[b];
+        return sum;
+    }
+
+    template<>
+    detail::DispArray
+    GaussianQuadSparseGridIntegrator::integrate<detail::DispArray>(
+        const boost::function<detail::DispArray (
+            const std::vector<Real>& v1)>& f) const
+    {
+        const Size blocks =
+            (weights_.size()+sparseGridBlockSize-1)/sparseGridBlockSize;
+        std::vector<std::vector<Real> > partial(blocks);
+        if (parallel_) {
+            std::vector<std::string> errors(blocks);
+            std::vector<int> failed(blocks, 0);
+
+            #pragma omp parallel for schedule(dynamic)
+            for (long b=0; b < long(blocks); ++b) {
+                try {
+                    partial[b] = blockIntegral(f, b);
+                } catch (std::exception& e) {
+                    errors[b] = e.what();
+                    failed[b] = 1;
+                } catch (...) {
+                    errors[b] = "unknown error";
+                    failed[b] = 1;
+                }
+            }
+            for (Size b=0; b<blocks; ++b)
+                QL_REQUIRE(!failed[b], errors[b]);
+        } else {
+            for (Size b=0; b<blocks; ++b)
+                partial[b] = blockIntegral(f, b);
+        }
+
+        std::vector<Real> sum;
+        for (Size b=0; b<blocks; ++b) {
+            sum.resize(partial[b].size(), 0.0);
+            for (Size j=0; j<partial[b].size(); ++j)
+                sum[j] += partial[b][j];
+        }
+        return sum;
     }
 
 }
@@ -33,6 +33,7 @@
 #include <boost/function.hpp>
 #include <boost/bind.hpp>
 #include <boost/lambda/bind.hpp>
+#include <string>
 
 namespace QuantLib {
 
@@ -42,67 +43,45 @@ namespace QuantLib {
 
     /*! \brief Integrates a vector or scalar function of vector domain. 
         
-        A template recursion along dimensions avoids calling depth 
-        test or virtual functions.
+        The integral is the tensor product of a Gauss-Hermite rule
+        along each dimension.  The sums over the dimensions are nested
+        as they would be in a sequence of one-dimensional
+        integrations, but the integrand is called directly at each
+        point of the grid, with no function objects in between.
+
+        Optionally, the nodes of the outermost dimension are
+        distributed over OpenMP threads; each thread has its own
+        buffer for the integration variable, and the results don't
+        depend on the number of threads.
+
+        \warning When the integration is parallel, the integrand must
+                 be safe to call concurrently.
 
         \todo Add coherence test between the integrand function dimensions (the
         vector size) and the declared dimension in the constructor.
-
-        \todo Split into integrator classes for functions returning scalar and 
-            vector?
     */
     class GaussianQuadMultidimIntegrator {
-    private:
-        // Vector integration. Quadrature to functions returning a vector of 
-        // real numbers, turns 1D quadratures into ND
-        class VectorIntegrator : public GaussHermiteIntegration {
-        public:
-            VectorIntegrator(Size n, Real mu = 0.0) 
-            : GaussHermiteIntegration(n, mu) {}
-
-            template <class F> // todo: fix copies.
-            detail::DispArray operator()(const F& f) const {
-                //first one, we do not know the size of the vector returned by f
-                Integer i = order()-1;
-                std::vector<Real> term = f(x_[i]);// potential copy! @#$%^!!!
-                std::for_each(term.begin(), term.end(), 
-                    std::bind1st(std::multiplies<Real>(), w_[i]));
-                std::vector<Real> sum = term;
-           
-                for (i--; i >= 0; --i) {
-                    term = f(x_[i]);// potential copy! @#$%^!!!
-                    // sum[j] += term[j] * w_[i];
-                    std::transform(term.begin(), term.end(), sum.begin(), 
-                        sum.begin(), 
-                        boost::bind(std::plus<Real>(), _2,
-                            boost::bind(std::multiplies<Real>(), w_[i], _1)));
-                }
-                return sum;
-            }
-        };
-
     public:
         /*!
             @param dimension The number of dimensions of the argument of the 
             function we want to integrate.
             @param quadOrder Quadrature order.
             @param mu Parameter in the Gauss Hermite weight (i.e. points load).
+            @param parallel Whether to integrate over the nodes of the
+            outermost dimension concurrently.
         */
         GaussianQuadMultidimIntegrator(Size dimension, Size quadOrder, 
-            Real mu = 0.);
+            Real mu = 0., bool parallel = false);
         //! Integration quadrature order.
-        Size order() const {return integralV_.order();}
+        Size order() const {return integral_.order();}
 
         //! Integrates function f over \f$ R^{dim} \f$
         /* This function is just syntax since the only thing it does is calling 
         to integrate<RetType> which has to exist for the type returned by the 
-        function. So theres one redundant call but there should not be any extra 
-        cost... up to the compiler. It can not be templated all the way since
-        the integration entries functions can not be templates.
-        Most times integrands will return a scalar or vector but could be a 
-        matrix too. Also vectors might be returned as vector or Disposable 
-        wrapped (which is preferred and I have removed the plain vector
-        version).
+        function. Most times integrands will return a scalar or vector but
+        could be a matrix too. Also vectors might be returned as vector or
+        Disposable wrapped (which is preferred and I have removed the plain
+        vector version).
          */
         template<class RetType_T>
         RetType_T operator()(const boost::function<RetType_T (
@@ -111,172 +90,128 @@ namespace QuantLib {
             return integrate<RetType_T>(f);
         }
 
-
-        //---------------------------------------------------------
-        /* Boost fails on MSVC2008 to recognise the return type when 
-        calling op()  , its not boost, its me.... FIX ME*/
-
         // Declare, spezializations follow.
         template<class RetType_T>
         RetType_T integrate(const boost::function<RetType_T (
             const std::vector<Real>& v1)>& f) const;
 
     private:
-        /* The maximum number of dimensions of the integration variable domain
-            A higher than this number of dimension would presumably be 
-           impractical and another integration algorithm (MC) should be 
-           considered.
-           \to do Consider moving it to a library configuration variable.
-        */
-        static const Size maxDimensions_ = 15;
+        typedef boost::function<Real (const std::vector<Real>&)>
+            ScalarFunction;
+        typedef boost::function<detail::DispArray (const std::vector<Real>&)>
+            VectorFunction;
+
+        //! integral over the first \f$ n \f$ coordinates of x
+        Real innerIntegral(const ScalarFunction& f,
+                           std::vector<Real>& x, Size n) const;
+        detail::DispArray innerIntegral(const VectorFunction& f,
+                                        std::vector<Real>& x, Size n) const;
+
+        //! The actual integrator.
+        GaussHermiteIntegration integral_;
+        Size dimension_;
+        bool parallel_;
+    };
 
-        //! \name Integration entry points generation
-        //@{
-        //! Recursive template methods to statically generate (at this 
-        //    class construction time) handles to the integration entry points
-        template<Size levelSpawn>
-        void spawnFcts() const {
-            integrationEntries_[levelSpawn-1] = 
-                boost::bind(
-                &GaussianQuadMultidimIntegrator::scalarIntegrator<levelSpawn>, 
-                    this, _1, _2);
-            integrationEntriesVR_[levelSpawn-1] = 
-                boost::bind(
-                &GaussianQuadMultidimIntegrator::vectorIntegratorVR<levelSpawn>, 
-                    this, _1, _2);
-            spawnFcts<levelSpawn-1>();
-        }
-        //@}
 
-        //---------------------------------------------------------
+    //! Smolyak sparse-grid quadrature of functions of vector domain
+    /*! The integral over \f$ R^d \f$ is approximated by the
+        combination of tensor products of Gauss-Hermite rules
+        \f[
+            A(L,d) = \sum_{L \le |l|_1 \le L+d-1} (-1)^{L+d-1-|l|_1}
+                     \binom{d-1}{L+d-1-|l|_1}
+                     Q_{l_1} \otimes \dots \otimes Q_{l_d},
+        \f]
+        where \f$ Q_l \f$ is the rule with \f$ 2l-1 \f$ nodes; all
+        the rules contain the origin, and points shared by several
+        products are merged.  For a given accuracy on smooth
+        integrands, the number of points grows more slowly with the
+        dimension than for the tensor grid, which makes it possible
+        to integrate over five or more factors.
+
+        The weighted points are calculated once by the constructor;
+        the integrand is then evaluated over them in blocks, which
+        are optionally distributed over OpenMP threads.
+
+        \warning When the integration is parallel, the integrand must
+                 be safe to call concurrently.  Some of the weights
+                 are negative.
+    */
+    class GaussianQuadSparseGridIntegrator {
+      public:
+        /*! @param dimension The number of dimensions of the argument
+            of the function to integrate.
+            @param level The level \f$ L \f$ of the grid; the most
+            accurate one-dimensional rule has \f$ 2L-1 \f$ nodes.
+            @param mu Parameter in the Gauss Hermite weight.
+            @param parallel Whether to evaluate the blocks of points
+            concurrently.
+        */
+        GaussianQuadSparseGridIntegrator(Size dimension, Size level,
+                                         Real mu = 0., bool parallel = false);
 
-        template <int intgDepth>
-        Real scalarIntegrator(
-            boost::function<Real (const std::vector<Real>& arg1)> f, 
-            const Real mFctr) const 
-        {
-            varBuffer_[intgDepth-1] = mFctr;
-            return integral_(boost::bind(
-                &GaussianQuadMultidimIntegrator::scalarIntegrator<intgDepth-1>,
-                this,
-                f,
-                _1)
-            );
+        //! Integrates function f over \f$ R^{dim} \f$
+        template<class RetType_T>
+        RetType_T operator()(const boost::function<RetType_T (
+            const std::vector<Real>& arg)>& f) const {
+            return integrate<RetType_T>(f);
         }
 
-        template <int intgDepth>
-        detail::DispArray vectorIntegratorVR(
-            const boost::function<detail::DispArray(const std::vector<Real>& arg1)>& f,
-            const Real mFctr) const 
-        {
-            varBuffer_[intgDepth-1] = mFctr;
-            return 
-              integralV_(boost::bind(
-               &GaussianQuadMultidimIntegrator::vectorIntegratorVR<intgDepth-1>,
-               this,
-               f,
-               _1)
-            );
-        }
-    private:
-        // Same object for all dimensions poses problems when using the 
-        //   parallelized integrals version.
-        //! The actual integrators.
-        GaussHermiteIntegration integral_;
-        VectorIntegrator integralV_;
-
-        //! Buffer to allow acces to integrations. We do not know at which 
-        //    level/dimension we are going to start integration
-        // \todo Declare typedefs for traits
-        mutable std::vector<
-        boost::function<Real (boost::function<Real (
-            const std::vector<Real>& varg2)> f1, 
-            const Real r3)> > integrationEntries_;
-        mutable std::vector<
-        boost::function<detail::DispArray (const boost::function<detail::DispArray(
-            const std::vector<Real>& vvarg2)>& vf1, 
-            const Real vr3)> > integrationEntriesVR_;
+        //! specialized for scalar and Disposable vector integrands
+        template<class RetType_T>
+        RetType_T integrate(const boost::function<RetType_T (
+            const std::vector<Real>& v1)>& f) const;
 
-        Size dimension_;
-        // integration veriable buffer
-        mutable std::vector<Real> varBuffer_;
+        //! \name Inspectors
+        //@{
+        Size dimension() const { return dimension_; }
+        Size level() const { return level_; }
+        //! number of integrand evaluations
+        Size size() const { return weights_.size(); }
+        //! i-th point of the grid
+        std::vector<Real> point(Size i) const;
+        const std::vector<Real>& weights() const { return weights_; }
+        //@}
+      private:
+        typedef boost::function<Real (const std::vector<Real>&)>
+            ScalarFunction;
+        typedef boost::function<detail::DispArray (const std::vector<Real>&)>
+            VectorFunction;
+
+        //! weighted sum over the points of the b-th block
+        Real blockIntegral(const ScalarFunction& f, Size b) const;
+        detail::DispArray blockIntegral(const VectorFunction& f,
+                                        Size b) const;
+
+        Size dimension_, level_;
+        bool parallel_;
+        // coordinates of the i-th point at [i*dimension_, (i+1)*dimension_)
+        std::vector<Real> points_;
+        std::vector<Real> weights_;
     };
 
 
     // Template specializations ---------------------------------------------
 
     template<>
-    inline Real GaussianQuadMultidimIntegrator::operator()(
-        const boost::function<Real (const std::vector<Real>& v1)>& f) const
-    {
-        return integral_(boost::bind(
-                   // integration entry level is selected now
-                   integrationEntries_[dimension_-1],
-                   boost::cref(f),
-                   _1)
-                   );
-    }
-
-    // Scalar integrand version (merge with vector case?)
-    template<>
-    inline Real GaussianQuadMultidimIntegrator::integrate<Real>(
-        const boost::function<Real (const std::vector<Real>& v1)>& f) const 
-    {
-        // integration variables
-        // call vector quadrature integration with the function and start 
-        // values, kicks in recursion over the dimensions of the integration
-        // variable.
-        return integral_(boost::bind(
-                   // integration entry level is selected now
-                   integrationEntries_[dimension_-1],
-                   boost::cref(f),
-                   _1)
-                   );
-    }
+    Real GaussianQuadMultidimIntegrator::integrate<Real>(
+        const boost::function<Real (const std::vector<Real>& v1)>& f) const;
 
-    // Vector integrand version
     template<>
-    inline detail::DispArray GaussianQuadMultidimIntegrator::integrate<detail::DispArray>(
-        const boost::function<detail::DispArray (const std::vector<Real>& v1)>& f) const
-    {
-        return integralV_(boost::bind(
-                   boost::cref(integrationEntriesVR_[dimension_-1]),
-                   boost::cref(f),
-                   _1)
-                   );
-    } 
-
-    //! Terminal integrand; scalar function version
-    template<> 
-    inline Real GaussianQuadMultidimIntegrator::scalarIntegrator<1>(
-        boost::function<Real (const std::vector<Real>& arg1)> f,
-        const Real mFctr) const
-    {
-        varBuffer_[0] = mFctr;
-        return f(varBuffer_);
-    }
+    detail::DispArray
+    GaussianQuadMultidimIntegrator::integrate<detail::DispArray>(
+        const boost::function<detail::DispArray (
+            const std::vector<Real>& v1)>& f) const;
 
-    //! Terminal integrand; disposable vector function version
     template<>
-    inline detail::DispArray
-        GaussianQuadMultidimIntegrator::vectorIntegratorVR<1>(
-        const boost::function<detail::DispArray (const std::vector<Real>& arg1)>& f,
-        const Real mFctr) const 
-    {
-        varBuffer_[0] = mFctr;
-        return f(varBuffer_);
-    }
+    Real GaussianQuadSparseGridIntegrator::integrate<Real>(
+        const boost::function<Real (const std::vector<Real>& v1)>& f) const;
 
-    //! Terminal level:
     template<>
-    inline void GaussianQuadMultidimIntegrator::spawnFcts<1>() const {
-        integrationEntries_[0] = 
-          boost::bind(&GaussianQuadMultidimIntegrator::scalarIntegrator<1>, 
-          this, _1, _2);
-        integrationEntriesVR_[0] = 
-         boost::bind(&GaussianQuadMultidimIntegrator::vectorIntegratorVR<1>, 
-         this, _1, _2);
-    }
+    detail::DispArray
+    GaussianQuadSparseGridIntegrator::integrate<detail::DispArray>(
+        const boost::function<detail::DispArray (
+            const std::vector<Real>& v1)>& f) const;
 
 }
 
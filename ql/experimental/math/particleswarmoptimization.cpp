@@ -32,10 +32,11 @@ namespace QuantLib {
         boost::shared_ptr<Topology> topology,
         boost::shared_ptr<Inertia> inertia,
         Real c1, Real c2,
-        unsigned long seed)
+        unsigned long seed,
+        const PopulationEvaluator& evaluator)
         : M_(M), rng_(seed),
         topology_(topology),
-        inertia_(inertia) {
+        inertia_(inertia), evaluator_(evaluator) {
         Real phi = c1 + c2;
         QL_ENSURE(phi*phi - 4 * phi, "Invalid phi");
         c0_ = 2.0 / std::abs(2.0 - phi - sqrt(phi*phi - 4 * phi));
@@ -47,9 +48,10 @@ namespace QuantLib {
         boost::shared_ptr<Topology> topology,
         boost::shared_ptr<Inertia> inertia,
         Real omega, Real c1, Real c2,
-        unsigned long seed)
+        unsigned long seed,
+        const PopulationEvaluator& evaluator)
         : M_(M), c0_(omega), c1_(c1), c2_(c2), rng_(seed),
-        topology_(topology), inertia_(inertia) {}
+        topology_(topology), inertia_(inertia), evaluator_(evaluator) {}
 
     void ParticleSwarmOptimization::startState(Problem &P, const EndCriteria &endCriteria) {
         QL_REQUIRE(topology_, "Invalid topology");
@@ -84,10 +86,11 @@ namespace QuantLib {
                 //Assign V=(ub-lb)*2*random-(ub-lb) -> between (lb-ub) and (ub-lb)
                 v[j] = bounds[j] * (2.0*sample[2 * j + 1] - 1.0);
             }
-            //Evaluate X and assign as personal best
+            //Assign X as personal best
             pBX_.push_back(X_.back());
-            pBF_[i] = P.value(X_.back());
         }
+        //Evaluate X
+        pBF_ = evaluator_.values(P, X_);
 
         //init topology & inertia
         topology_->init(this);
@@ -152,8 +155,14 @@ namespace QuantLib {
                         v[j] = 0.0;
                     }
                 }
-                //Evaluate x
-                Real f = P.value(x);
+            }
+
+            //Evaluate particles
+            Array fX = evaluator_.values(P, X_);
+            for (Size i = 0; i < M_; i++) {
+                const Array& x = X_[i];
+                Array& pB = pBX_[i];
+                Real f = fX[i];
                 if (f < pBF_[i]) {
                     //Update personal best
                     pBF_[i] = f;
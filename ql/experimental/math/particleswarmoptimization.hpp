@@ -33,6 +33,7 @@ Computation, 6(2): 58–73.
 
 #include <ql/math/optimization/problem.hpp>
 #include <ql/math/optimization/constraint.hpp>
+#include <ql/math/optimization/populationevaluator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/experimental/math/isotropicrandomwalk.hpp>
 #include <ql/experimental/math/levyflightdistribution.hpp>
@@ -87,6 +88,10 @@ namespace QuantLib {
 
     The optimization stops either because the number of iterations has been reached
     or because the stationary function value limit has been reached.
+
+    The particles are evaluated together once all their positions have
+    been updated, using the given PopulationEvaluator; the results
+    don't depend on whether they are evaluated serially or in parallel.
     */
     class ParticleSwarmOptimization : public OptimizationMethod {
       public:
@@ -98,12 +103,14 @@ namespace QuantLib {
             boost::shared_ptr<Topology> topology,
             boost::shared_ptr<Inertia> inertia,
             Real c1 = 2.05, Real c2 = 2.05,
-            unsigned long seed = SeedGenerator::instance().get());
+            unsigned long seed = SeedGenerator::instance().get(),
+            const PopulationEvaluator& evaluator = PopulationEvaluator());
         explicit ParticleSwarmOptimization(const Size M,
             boost::shared_ptr<Topology> topology,
             boost::shared_ptr<Inertia> inertia,
             Real omega, Real c1, Real c2,
-            unsigned long seed = SeedGenerator::instance().get());
+            unsigned long seed = SeedGenerator::instance().get(),
+            const PopulationEvaluator& evaluator = PopulationEvaluator());
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem &P, const EndCriteria &endCriteria);
 
@@ -116,6 +123,7 @@ namespace QuantLib {
         MersenneTwisterUniformRng rng_;
         boost::shared_ptr<Topology> topology_;
         boost::shared_ptr<Inertia> inertia_;
+        PopulationEvaluator evaluator_;
     };
 
     //! Base inertia class used to alter the PSO state
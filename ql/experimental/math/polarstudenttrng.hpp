@@ -24,8 +24,11 @@
 #ifndef quantlib_polar_student_t_rng_h
 #define quantlib_polar_student_t_rng_h
 
+#include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
+#include <cmath>
 
 namespace QuantLib {
 
@@ -68,6 +71,13 @@ namespace QuantLib {
     public:
         //! returns a sample from a Student-t distribution
         sample_type next() const;
+        //! fills the buffer with the next n samples
+        /*! The samples are those that n calls to next() would
+            return; the uniform variates are drawn in blocks.
+
+            \pre output must have room for n values
+        */
+        void nextReals(Size n, Real* output) const;
     private:
         URNG uniformGenerator_;
         mutable Real degFreedom_;
@@ -89,6 +99,44 @@ namespace QuantLib {
             1.);
     }
 
+    template <class URNG>
+    inline void PolarStudentTRng<URNG>::nextReals(Size n,
+                                                  Real* output) const {
+        const Size blockSize = 256;
+        Real uniforms[2*blockSize];
+        Size k = 0;
+        while (k < n) {
+            // each remaining sample needs at least two uniforms;
+            // drawing no more than that leaves the generator where
+            // n calls to next() would.
+            Size m = 2*std::min(blockSize, n-k);
+            detail::NextReals<URNG>::apply(uniformGenerator_, m, uniforms);
+            for (Size b=0; b<m; b+=2) {
+                Real v = 2.*uniforms[b] - 1.;
+                Real u = 2.*uniforms[b+1] - 1.;
+                Real rSqr = v*v + u*u;
+                if (rSqr < 1.)
+                    output[k++] = u *
+                        std::sqrt(degFreedom_ *
+                                  (std::pow(rSqr, -2./degFreedom_)-1.)
+                                  / rSqr);
+            }
+        }
+    }
+
+    namespace detail {
+
+        template <class URNG>
+        struct NextReals<PolarStudentTRng<URNG> > {
+            static Real apply(const PolarStudentTRng<URNG>& rng,
+                              Size n, Real* output) {
+                rng.nextReals(n, output);
+                return 1.0;
+            }
+        };
+
+    }
+
 }
 
 #endif
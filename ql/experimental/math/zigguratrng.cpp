@@ -19,6 +19,7 @@
 
 #include <ql/experimental/math/zigguratrng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
+#include <algorithm>
 #include <cmath>
 
 namespace QuantLib {
@@ -238,4 +239,50 @@ namespace QuantLib {
         return x;
     }
 
+    void ZigguratRng::nextReals(Size n, Real* output) const {
+        static const int c[2] = {-1, 1};
+        const Size blockSize = 256;
+        unsigned long j[blockSize];
+        Real x[blockSize];
+        int accepted[blockSize];
+
+        Size drawn = 0, used = 0, k = 0;
+        while (k < n) {
+            if (used == drawn) {
+                // each remaining variate needs at least one integer;
+                // drawing no more than that leaves the generator where
+                // n calls to next() would.
+                drawn = std::min(blockSize, n-k);
+                mt32_.nextInt32s(drawn, j);
+                used = 0;
+                for (Size b=0; b<drawn; ++b) {
+                    unsigned long h = j[b] >> 8;
+                    unsigned long i = (j[b] >> 1) & 0x7f;
+                    x[b] = (c[j[b] & 1]*static_cast<long>(h))*w_[i];
+                    accepted[b] = (h < k_[i]);
+                }
+            }
+
+            Size b = used++;
+            if (accepted[b]) {
+                output[k++] = x[b];
+                continue;
+            }
+
+            // rejections are handled as in nextGaussian(); the
+            // uniform variate is drawn from the next integer.
+            int f = j[b] & 1;
+            unsigned long i = (j[b] >> 1) & 0x7f;
+            unsigned long r = (used < drawn) ? j[used++] : mt32_.nextInt32();
+            Real u = (Real(r) + 0.5)/4294967296.0;
+            if (i!=0) { // upper strips
+                if ((f_[i-1]-f_[i])*u + f_[i] < std::exp(-0.5*x[b]*x[b]))
+                    output[k++] = x[b];
+            } else { // base strip, sample from the tail
+                output[k++] = c[f]*InverseCumulativeNormal::standard_value(
+                                                                  p_*u+q_);
+            }
+        }
+    }
+
 }
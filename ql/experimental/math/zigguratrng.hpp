@@ -56,6 +56,17 @@ namespace QuantLib {
         sample_type next() const {
             return sample_type(nextGaussian(),1.0);
         }
+        //! fills the buffer with the next n variates
+        /*! The variates are those that n calls to next() would
+            return.  The underlying integers are drawn in blocks, and
+            the candidate values and the fast acceptance test are
+            computed for a whole block in a loop that the compiler
+            can vectorize; only the rare rejections are handled one
+            at a time.
+
+            \pre output must have room for n values
+        */
+        void nextReals(Size n, Real* output) const;
       private:
         mutable MersenneTwisterUniformRng mt32_;
         Real nextGaussian() const;
@@ -75,6 +86,19 @@ namespace QuantLib {
         }
     };
 
+    namespace detail {
+
+        template <>
+        struct NextReals<ZigguratRng> {
+            static Real apply(const ZigguratRng& rng,
+                              Size n, Real* output) {
+                rng.nextReals(n, output);
+                return 1.0;
+            }
+        };
+
+    }
+
 }
 
 #endif
@@ -6,6 +6,8 @@
 #include <ql/experimental/mcbasket/mcamericanpathengine.hpp>
 #include <ql/experimental/mcbasket/mclongstaffschwartzpathengine.hpp>
 #include <ql/experimental/mcbasket/mcpathbasketengine.hpp>
+#include <ql/experimental/mcbasket/mcscenariobasketengines.hpp>
+#include <ql/experimental/mcbasket/multipathscenarioset.hpp>
 #include <ql/experimental/mcbasket/pathmultiassetoption.hpp>
 #include <ql/experimental/mcbasket/pathpayoff.hpp>
 
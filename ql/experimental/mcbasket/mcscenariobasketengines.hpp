@@ -0,0 +1,258 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mcscenariobasketengines.hpp
+    \brief Monte Carlo basket engines on shared scenario sets
+*/
+
+#ifndef quantlib_mc_scenario_basket_engines_hpp
+#define quantlib_mc_scenario_basket_engines_hpp
+
+#include <ql/experimental/mcbasket/multipathscenarioset.hpp>
+#include <ql/experimental/mcbasket/pathmultiassetoption.hpp>
+#include <ql/instruments/basketoption.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/termstructures/yield/impliedtermstructure.hpp>
+#include <ql/math/statistics/statistics.hpp>
+#include <ql/exercise.hpp>
+#include <boost/make_shared.hpp>
+
+namespace QuantLib {
+
+    //! European basket engine on a shared scenario set
+    /*! The option is priced on the paths stored by the scenario set,
+        which must include its exercise date.  The basket is made of
+        the given assets of the scenario set, in the given order, or
+        of all of them if none are given; the discount curve is the
+        risk-free curve of the first of them, which must be a
+        Black-Scholes process.
+
+        \ingroup basketengines
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MCScenarioBasketEngine : public BasketOption::engine {
+      public:
+        MCScenarioBasketEngine(
+            const boost::shared_ptr<MultiPathScenarioSet<RNG> >& scenarios,
+            const std::vector<Size>& assets = std::vector<Size>(),
+            Size workers = 1);
+        void calculate() const;
+      private:
+        class Pricer {
+          public:
+            Pricer(const boost::shared_ptr<BasketPayoff>& payoff,
+                   const std::vector<Size>& assets,
+                   Size fixing,
+                   DiscountFactor discount)
+            : payoff_(payoff), assets_(assets), fixing_(fixing),
+              discount_(discount), prices_(assets.size()) {}
+            Real operator()(const MultiPathScenarioSet<RNG>& scenarios,
+                            Size path) {
+                for (Size j=0; j<assets_.size(); ++j)
+                    prices_[j] = scenarios.value(path, assets_[j], fixing_);
+                return (*payoff_)(prices_) * discount_;
+            }
+          private:
+            boost::shared_ptr<BasketPayoff> payoff_;
+            std::vector<Size> assets_;
+            Size fixing_;
+            DiscountFactor discount_;
+            Array prices_;
+        };
+        boost::shared_ptr<MultiPathScenarioSet<RNG> > scenarios_;
+        std::vector<Size> assets_;
+        Size workers_;
+    };
+
+
+    //! Path-dependent basket engine on a shared scenario set
+    /*! The option is priced on the paths stored by the scenario set,
+        which must include all its fixing dates; early exercise is
+        ignored, as in MCPathBasketEngine.  The choice of the assets
+        and of the discount curve follows MCScenarioBasketEngine.
+
+        \ingroup basketengines
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MCScenarioPathBasketEngine : public PathMultiAssetOption::engine {
+      public:
+        MCScenarioPathBasketEngine(
+            const boost::shared_ptr<MultiPathScenarioSet<RNG> >& scenarios,
+            const std::vector<Size>& assets = std::vector<Size>(),
+            Size workers = 1);
+        void calculate() const;
+      private:
+        class Pricer {
+          public:
+            Pricer(const boost::shared_ptr<PathPayoff>& payoff,
+                   const std::vector<Size>& assets,
+                   const std::vector<Size>& fixings,
+                   const std::vector<Handle<YieldTermStructure> >&
+                                                     forwardTermStructures,
+                   const Array& discounts)
+            : payoff_(payoff), assets_(assets), fixings_(fixings),
+              forwardTermStructures_(forwardTermStructures),
+              discounts_(discounts),
+              path_(assets.size(), fixings.size()) {}
+            Real operator()(const MultiPathScenarioSet<RNG>& scenarios,
+                            Size path) {
+                for (Size j=0; j<assets_.size(); ++j)
+                    for (Size i=0; i<fixings_.size(); ++i)
+                        path_[j][i] =
+                            scenarios.value(path, assets_[j], fixings_[i]);
+                Array payments(fixings_.size(), 0.0);
+                // ignored
+                Array exercises;
+                std::vector<Array> states;
+                payoff_->value(path_, forwardTermStructures_,
+                               payments, exercises, states);
+                return DotProduct(payments, discounts_);
+            }
+          private:
+            boost::shared_ptr<PathPayoff> payoff_;
+            std::vector<Size> assets_, fixings_;
+            std::vector<Handle<YieldTermStructure> > forwardTermStructures_;
+            Array discounts_;
+            Matrix path_;
+        };
+        boost::shared_ptr<MultiPathScenarioSet<RNG> > scenarios_;
+        std::vector<Size> assets_;
+        Size workers_;
+    };
+
+
+    namespace detail {
+
+        inline std::vector<Size> scenarioAssets(
+                                           const std::vector<Size>& assets,
+                                           Size n) {
+            if (assets.empty()) {
+                std::vector<Size> all(n);
+                for (Size j=0; j<n; ++j)
+                    all[j] = j;
+                return all;
+            }
+            for (Size j=0; j<assets.size(); ++j)
+                QL_REQUIRE(assets[j] < n,
+                           "asset index " << assets[j]
+                           << " out of range; only " << n
+                           << " assets in scenario set");
+            return assets;
+        }
+
+        inline Handle<YieldTermStructure> scenarioDiscountCurve(
+                     const boost::shared_ptr<StochasticProcessArray>& process,
+                     Size asset) {
+            boost::shared_ptr<GeneralizedBlackScholesProcess> p =
+                boost::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                                                     process->process(asset));
+            QL_REQUIRE(p, "Black-Scholes process required");
+            return p->riskFreeRate();
+        }
+
+    }
+
+
+    // template definitions
+
+    template <class RNG, class S>
+    MCScenarioBasketEngine<RNG,S>::MCScenarioBasketEngine(
+            const boost::shared_ptr<MultiPathScenarioSet<RNG> >& scenarios,
+            const std::vector<Size>& assets,
+            Size workers)
+    : scenarios_(scenarios),
+      assets_(detail::scenarioAssets(assets, scenarios->assets())),
+      workers_(workers) {
+        QL_REQUIRE(workers_ > 0, "at least one worker required");
+        registerWith(scenarios_);
+    }
+
+    template <class RNG, class S>
+    void MCScenarioBasketEngine<RNG,S>::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European Option");
+        boost::shared_ptr<BasketPayoff> payoff =
+            boost::dynamic_pointer_cast<BasketPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-basket payoff given");
+
+        Date exerciseDate = arguments_.exercise->lastDate();
+        DiscountFactor discount =
+            detail::scenarioDiscountCurve(scenarios_->process(),
+                                          assets_.front())
+            ->discount(exerciseDate);
+
+        S statistics;
+        scenarios_->accumulate(
+                         Pricer(payoff, assets_,
+                                scenarios_->fixingIndex(exerciseDate),
+                                discount),
+                         statistics, workers_);
+
+        results_.value = statistics.mean();
+        if (RNG::allowsErrorEstimate)
+            results_.errorEstimate = statistics.errorEstimate();
+    }
+
+
+    template <class RNG, class S>
+    MCScenarioPathBasketEngine<RNG,S>::MCScenarioPathBasketEngine(
+            const boost::shared_ptr<MultiPathScenarioSet<RNG> >& scenarios,
+            const std::vector<Size>& assets,
+            Size workers)
+    : scenarios_(scenarios),
+      assets_(detail::scenarioAssets(assets, scenarios->assets())),
+      workers_(workers) {
+        QL_REQUIRE(workers_ > 0, "at least one worker required");
+        registerWith(scenarios_);
+    }
+
+    template <class RNG, class S>
+    void MCScenarioPathBasketEngine<RNG,S>::calculate() const {
+        boost::shared_ptr<PathPayoff> payoff = arguments_.payoff;
+        QL_REQUIRE(payoff, "non-basket payoff given");
+
+        const std::vector<Date>& dates = arguments_.fixingDates;
+        Handle<YieldTermStructure> riskFreeRate =
+            detail::scenarioDiscountCurve(scenarios_->process(),
+                                          assets_.front());
+
+        std::vector<Size> fixings(dates.size());
+        Array discounts(dates.size());
+        std::vector<Handle<YieldTermStructure> >
+                                        forwardTermStructures(dates.size());
+        for (Size i=0; i<dates.size(); ++i) {
+            fixings[i] = scenarios_->fixingIndex(dates[i]);
+            discounts[i] = riskFreeRate->discount(dates[i]);
+            forwardTermStructures[i] = Handle<YieldTermStructure>(
+                boost::make_shared<ImpliedTermStructure>(riskFreeRate,
+                                                         dates[i]));
+        }
+
+        S statistics;
+        scenarios_->accumulate(Pricer(payoff, assets_, fixings,
+                                      forwardTermStructures, discounts),
+                               statistics, workers_);
+
+        results_.value = statistics.mean();
+        if (RNG::allowsErrorEstimate)
+            results_.errorEstimate = statistics.errorEstimate();
+    }
+
+}
+
+
+#endif
@@ -0,0 +1,271 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multipathscenarioset.hpp
+    \brief multi-asset paths shared by several products
+*/
+
+#ifndef quantlib_multi_path_scenario_set_hpp
+#define quantlib_multi_path_scenario_set_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/processes/stochasticprocessarray.hpp>
+#include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/timegrid.hpp>
+#include <algorithm>
+#include <string>
+
+namespace QuantLib {
+
+    //! multi-asset paths shared by several products
+    /*! The paths of all the assets in the process are simulated once
+        on a grid including the union of the fixing dates of the
+        products to be priced, and only their values on the fixing
+        dates are stored.  The products are then priced by evaluating
+        their payoffs over the stored paths, possibly in parallel,
+        instead of simulating paths of their own; see
+        MCScenarioBasketEngine and MCScenarioPathBasketEngine.  The
+        paths are simulated again, lazily, when the process changes.
+
+        The values can be stored in single precision, which halves
+        the memory used at the cost of a relative error of about
+        1e-7 on each value; the payoffs are still evaluated in double
+        precision.  When antithetic variates are used, the paths are
+        stored in pairs, the second of each pair being the antithetic
+        of the first.
+
+        \warning The payoffs are evaluated concurrently when more
+                 than one worker is used; they, and the term
+                 structures they use, must not perform lazy
+                 calculations during the evaluation.
+
+        \ingroup mcarlo
+    */
+    template <class RNG = PseudoRandom>
+    class MultiPathScenarioSet : public LazyObject {
+      public:
+        MultiPathScenarioSet(
+                  const boost::shared_ptr<StochasticProcessArray>& process,
+                  const std::vector<Date>& fixingDates,
+                  Size samples,
+                  BigNatural seed = 0,
+                  bool antitheticVariate = false,
+                  Size timeStepsPerYear = Null<Size>(),
+                  bool singlePrecision = false);
+        //! \name Inspectors
+        //@{
+        const boost::shared_ptr<StochasticProcessArray>& process() const {
+            return process_;
+        }
+        //! the fixing dates, sorted and without duplicates
+        const std::vector<Date>& fixingDates() const { return dates_; }
+        //! index of the given date among the fixing dates
+        Size fixingIndex(const Date& d) const;
+        Size assets() const { return process_->size(); }
+        //! number of independent samples; antithetic pairs count as one
+        Size samples() const { return samples_; }
+        bool antitheticVariate() const { return antithetic_; }
+        //! number of stored paths
+        Size paths() const { return antithetic_ ? 2*samples_ : samples_; }
+        //@}
+        //! \name Path values
+        /*! \pre the paths must have been simulated; this is the case
+                 while evaluating the functor passed to accumulate().
+        */
+        //@{
+        Real value(Size path, Size asset, Size fixing) const {
+            Size i = (path*dates_.size() + fixing)*process_->size() + asset;
+            return singlePrecision_ ? Real(singleValues_[i]) : values_[i];
+        }
+        Real weight(Size path) const { return weights_[path]; }
+        //@}
+        //! evaluates a functor on the paths and accumulates the results
+        /*! The functor is called as f(*this, path) and must return
+            the value of the product on the given path; pairs of
+            antithetic values are averaged before being added to the
+            statistics.  The paths are split among the given number
+            of workers, each using a copy of the functor; the results
+            are accumulated in the same order regardless of the
+            number of workers.
+        */
+        template <class F, class S>
+        void accumulate(const F& f, S& statistics, Size workers = 1) const;
+      private:
+        void performCalculations() const;
+        void store(Size path, const Sample<MultiPath>& sample) const;
+        boost::shared_ptr<StochasticProcessArray> process_;
+        std::vector<Date> dates_;
+        Size samples_;
+        BigNatural seed_;
+        bool antithetic_;
+        Size timeStepsPerYear_;
+        bool singlePrecision_;
+        mutable std::vector<Size> positions_;
+        mutable std::vector<Real> values_;
+        mutable std::vector<float> singleValues_;
+        mutable std::vector<Real> weights_;
+    };
+
+
+    // template definitions
+
+    template <class RNG>
+    MultiPathScenarioSet<RNG>::MultiPathScenarioSet(
+                  const boost::shared_ptr<StochasticProcessArray>& process,
+                  const std::vector<Date>& fixingDates,
+                  Size samples,
+                  BigNatural seed,
+                  bool antitheticVariate,
+                  Size timeStepsPerYear,
+                  bool singlePrecision)
+    : process_(process), dates_(fixingDates), samples_(samples),
+      seed_(seed), antithetic_(antitheticVariate),
+      timeStepsPerYear_(timeStepsPerYear),
+      singlePrecision_(singlePrecision) {
+        QL_REQUIRE(!dates_.empty(), "no fixing dates given");
+        QL_REQUIRE(samples_ > 0, "at least one sample required");
+        QL_REQUIRE(timeStepsPerYear_ != 0,
+                   "timeStepsPerYear must be positive");
+        std::sort(dates_.begin(), dates_.end());
+        dates_.erase(std::unique(dates_.begin(), dates_.end()),
+                     dates_.end());
+        registerWith(process_);
+    }
+
+    template <class RNG>
+    Size MultiPathScenarioSet<RNG>::fixingIndex(const Date& d) const {
+        std::vector<Date>::const_iterator i =
+            std::lower_bound(dates_.begin(), dates_.end(), d);
+        QL_REQUIRE(i != dates_.end() && *i == d,
+                   "fixing date " << d << " not in scenario set");
+        return i - dates_.begin();
+    }
+
+    template <class RNG>
+    void MultiPathScenarioSet<RNG>::performCalculations() const {
+        std::vector<Time> times(dates_.size());
+        for (Size i=0; i<dates_.size(); ++i) {
+            times[i] = process_->time(dates_[i]);
+            QL_REQUIRE(times[i] >= 0.0,
+                       "fixing date " << dates_[i] << " in the past");
+        }
+
+        TimeGrid grid;
+        if (timeStepsPerYear_ != Null<Size>()) {
+            Size steps = static_cast<Size>(timeStepsPerYear_*times.back());
+            grid = TimeGrid(times.begin(), times.end(),
+                            std::max<Size>(steps, 1));
+        } else {
+            grid = TimeGrid(times.begin(), times.end());
+        }
+        positions_.resize(times.size());
+        for (Size i=0; i<times.size(); ++i)
+            positions_[i] = grid.index(times[i]);
+
+        Size size = paths()*dates_.size()*process_->size();
+        if (singlePrecision_) {
+            std::vector<Real>().swap(values_);
+            singleValues_.resize(size);
+        } else {
+            std::vector<float>().swap(singleValues_);
+            values_.resize(size);
+        }
+        weights_.resize(paths());
+
+        typedef typename MultiVariate<RNG>::path_generator_type generator;
+        typename RNG::rsg_type rsg =
+            RNG::make_sequence_generator(process_->factors()*(grid.size()-1),
+                                         seed_);
+        generator pathGenerator(process_, grid, rsg, false);
+        for (Size k=0; k<samples_; ++k) {
+            if (antithetic_) {
+                store(2*k, pathGenerator.next());
+                store(2*k+1, pathGenerator.antithetic());
+                // the weight is the one of the original path
+                weights_[2*k+1] = weights_[2*k];
+            } else {
+                store(k, pathGenerator.next());
+            }
+        }
+    }
+
+    template <class RNG>
+    void MultiPathScenarioSet<RNG>::store(
+                               Size path,
+                               const Sample<MultiPath>& sample) const {
+        const Size m = process_->size();
+        Size i = path*dates_.size()*m;
+        for (Size t=0; t<positions_.size(); ++t) {
+            for (Size j=0; j<m; ++j, ++i) {
+                Real x = sample.value[j][positions_[t]];
+                if (singlePrecision_)
+                    singleValues_[i] = static_cast<float>(x);
+                else
+                    values_[i] = x;
+            }
+        }
+        weights_[path] = sample.weight;
+    }
+
+    template <class RNG>
+    template <class F, class S>
+    void MultiPathScenarioSet<RNG>::accumulate(const F& f,
+                                               S& statistics,
+                                               Size workers) const {
+        QL_REQUIRE(workers > 0, "at least one worker required");
+        calculate();
+
+        const Size n = paths();
+        std::vector<Real> results(n);
+        std::vector<std::string> errors(workers);
+        // not vector<bool>, whose elements can't be written
+        // concurrently
+        std::vector<int> failed(workers, 0);
+
+        #pragma omp parallel for num_threads(workers) schedule(static)
+        for (Size w=0; w<workers; ++w) {
+            try {
+                F pricer(f);
+                Size end = n*(w+1)/workers;
+                for (Size k=n*w/workers; k<end; ++k)
+                    results[k] = pricer(*this, k);
+            } catch (std::exception& e) {
+                errors[w] = e.what();
+                failed[w] = 1;
+            } catch (...) {
+                errors[w] = "unknown error";
+                failed[w] = 1;
+            }
+        }
+
+        for (Size w=0; w<workers; ++w)
+            QL_REQUIRE(!failed[w],
+                       "worker " << w << " failed: " << errors[w]);
+
+        if (antithetic_) {
+            for (Size k=0; k<n; k+=2)
+                statistics.add((results[k]+results[k+1])/2.0, weights_[k]);
+        } else {
+            for (Size k=0; k<n; ++k)
+                statistics.add(results[k], weights_[k]);
+        }
+    }
+
+}
+
+
+#endif
@@ -492,9 +492,9 @@ namespace QuantLib {
                       ? localVol*std::sqrt(scale) : 1.0;
 
                     (*L)[j][i] = std::min(50.0, std::max(0.001, l));
-
-                    leverageFct->setInterpolation(Linear());
                 }
+                // only the current time slice has changed
+                leverageFct->setInterpolation(i, Linear());
 
                 const Real sLowerBound = std::max(x.front(),
                     std::exp(localVolRND.invcdf(
@@ -518,7 +518,7 @@ namespace QuantLib {
                     else if ((*L)[j][i] == Null<Real>())
                         QL_FAIL("internal error");
                 }
-                leverageFct->setInterpolation(Linear());
+                leverageFct->setInterpolation(i, Linear());
 
                 pn = p;
 
@@ -27,6 +27,8 @@
 #include <ql/experimental/processes/hestonslvprocess.hpp>
 
 #include <boost/make_shared.hpp>
+#include <algorithm>
+#include <string>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -37,6 +39,30 @@
 #endif
 
 namespace QuantLib {
+
+    namespace {
+
+        typedef std::vector<std::pair<Real, Real> >::iterator pair_iterator;
+
+        /* Partitions [begin, end) so that each of the bins delimited
+           by the given offsets holds the same elements as it would
+           after a full sort; the elements within a bin stay
+           unordered. */
+        void bucketize(pair_iterator begin,
+                       const std::vector<Size>& offsets,
+                       Size lo, Size hi) {
+            // offsets[lo] and offsets[hi] are already in place
+            if (hi - lo < 2)
+                return;
+            const Size mid = (lo + hi)/2;
+            std::nth_element(begin + offsets[lo], begin + offsets[mid],
+                             begin + offsets[hi]);
+            bucketize(begin, offsets, lo, mid);
+            bucketize(begin, offsets, mid, hi);
+        }
+
+    }
+
     HestonSLVMCModel::HestonSLVMCModel(
         const Handle<LocalVolTermStructure>& localVol,
         const Handle<HestonModel>& hestonModel,
@@ -151,46 +177,79 @@ namespace QuantLib {
             }
         }
 
+        // bin boundaries
+        std::vector<Size> offsets(nBins_+1, 0u);
+        for (Size i=0; i < nBins_; ++i)
+            offsets[i+1] = offsets[i] + k + (i < m);
+
+        std::vector<std::string> errors(calibrationPaths_);
+        // not vector<bool>, whose elements can't be written
+        // concurrently
+        std::vector<int> failed(calibrationPaths_, 0);
+
+        Array binStrikes(nBins_), binVariances(nBins_), binVols(nBins_);
         for (Size n=1; n < timeGrid_->size(); ++n) {
             const Time t = timeGrid_->at(n-1);
             const Time dt = timeGrid_->dt(n-1);
 
-            Array x0(2), dw(2);
+            // the paths only read the leverage function at time t,
+            // which is complete; the term structures of the process
+            // are calculated before the threads share them
+            hestonProcess->riskFreeRate()->forwardRate(t, t+dt, Continuous);
+            hestonProcess->dividendYield()->forwardRate(t, t+dt, Continuous);
 
+            #pragma omp parallel for
             for (Size i=0; i < calibrationPaths_; ++i) {
-                x0[0] = pairs[i].first;
-                x0[1] = pairs[i].second;
-
-                dw[0] = paths[i][n-1][0];
-                dw[1] = paths[i][n-1][1];
-
-                x0 = slvProcess->evolve(t, x0, dt, dw);
-
-                pairs[i].first = x0[0];
-                pairs[i].second = x0[1];
+                try {
+                    Array x0(2), dw(2);
+                    x0[0] = pairs[i].first;
+                    x0[1] = pairs[i].second;
+
+                    dw[0] = paths[i][n-1][0];
+                    dw[1] = paths[i][n-1][1];
+
+                    x0 = slvProcess->evolve(t, x0, dt, dw);
+
+                    pairs[i].first = x0[0];
+                    pairs[i].second = x0[1];
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                    failed[i] = 1;
+                } catch (...) {
+                    errors[i] = "unknown error";
+                    failed[i] = 1;
+                }
             }
+            for (Size i=0; i < calibrationPaths_; ++i)
+                QL_REQUIRE(!failed[i],
+                           "evolution of calibration path #" << i
+                           << " failed at time " << t << ": " << errors[i]);
 
-            std::sort(pairs.begin(), pairs.end());
+            // only the contents of each bin are needed, not their order
+            bucketize(pairs.begin(), offsets, 0, nBins_);
 
-            Size s = 0u, e = 0u;
             for (Size i=0; i < nBins_; ++i) {
-                const Size inc = k + (i < m);
-                e = s + inc;
+                const Size s = offsets[i], e = offsets[i+1];
+                const Size inc = e - s;
 
                 Real sum=0.0;
+                Real lower = pairs[s].first, upper = pairs[s].first;
                 for (Size j=s; j < e; ++j) {
                     sum+=pairs[j].second;
+                    lower = std::min(lower, pairs[j].first);
+                    upper = std::max(upper, pairs[j].first);
                 }
-                sum/=inc;
-
-                vStrikes[n]->at(i) = 0.5*(pairs[e-1].first + pairs[s].first);
-                (*L)[i][n] = std::sqrt(square<Real>()(
-                     localVol_->localVol(t, vStrikes[n]->at(i), true))/sum);
-
-                s = e;
+                binVariances[i] = sum/inc;
+                binStrikes[i] = vStrikes[n]->at(i) = 0.5*(upper + lower);
             }
 
-            leverageFunction_->setInterpolation<Linear>();
+            localVol_->localVols(t, binStrikes, binVols, true);
+            for (Size i=0; i < nBins_; ++i)
+                (*L)[i][n] = std::sqrt(
+                    square<Real>()(binVols[i])/binVariances[i]);
+
+            // earlier slices are final and later ones are not read yet
+            leverageFunction_->setInterpolation<Linear>(n);
         }
     }
 }
@@ -45,6 +45,14 @@ namespace QuantLib {
         return blackVolatility()->blackVol(t, x, true);
     }
 
+    void ExtendedBlackScholesMertonProcess::evolveBatch(Time t0,
+                                                        const Matrix& x0,
+                                                        Time dt,
+                                                        const Matrix& dw,
+                                                        Matrix& x) const {
+        StochasticProcess::evolveBatch(t0, x0, dt, dw, x);
+    }
+
     Real ExtendedBlackScholesMertonProcess::evolve(Time t0, Real x0,
                                                    Time dt, Real dw) const {
         Real predictor, sigma0, sigma1;
@@ -48,6 +48,9 @@ namespace QuantLib {
         Real drift(Time t, Real x) const;
         Real diffusion(Time t, Real x) const;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        //! evolves each path separately with the chosen discretization
+        void evolveBatch(Time t0, const Matrix& x0, Time dt,
+                         const Matrix& dw, Matrix& x) const;
       private:
         const Discretization discretization_;
     };
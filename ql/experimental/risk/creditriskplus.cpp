@@ -18,6 +18,8 @@
 */
 
 #include <ql/experimental/risk/creditriskplus.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+#include <complex>
 #include <map>
 
 using std::sqrt;
@@ -29,10 +31,12 @@ namespace QuantLib {
         const std::vector<Real> &defaultProbability,
         const std::vector<Size> &sector,
         const std::vector<Real> &relativeDefaultVariance,
-        const Matrix &correlation, const Real unit)
+        const Matrix &correlation, const Real unit,
+        Method method, Size maxLossUnits)
         : exposure_(exposure), pd_(defaultProbability), sector_(sector),
           relativeDefaultVariance_(relativeDefaultVariance),
-          correlation_(correlation), unit_(unit) {
+          correlation_(correlation), unit_(unit), method_(method),
+          maxLossUnits_(maxLossUnits) {
 
         m_ = exposure_.size();
 
@@ -75,6 +79,7 @@ namespace QuantLib {
         }
 
         QL_REQUIRE(unit_ > 0.0, "loss unit (" << unit_ << ") must be positive");
+        QL_REQUIRE(maxLossUnits_ > 0, "no loss units allowed");
 
         compute();
     }
@@ -210,26 +215,80 @@ namespace QuantLib {
         Real betaC_ = sigmaC_ * sigmaC_ / pdSum_;
         Real pC_ = betaC_ / (1.0 + betaC_);
 
-        // compute loss distribution
+        // compute loss distribution; only the bands, i.e., the
+        // exposures actually present, enter the calculation
+
+        if (maxLossUnits_ != Null<Size>() && maxLossUnits_ < upperIndex_)
+            upperIndex_ = maxLossUnits_;
+
+        std::vector<std::pair<unsigned long, Real> > bands(epsNuC_.begin(),
+                                                           epsNuC_.end());
+        if (method_ == Fourier)
+            fourierLoss(bands, alphaC_, pC_, pdSum_);
+        else
+            recursiveLoss(bands, alphaC_, pC_, pdSum_);
+    }
+
+    void CreditRiskPlus::recursiveLoss(
+               const std::vector<std::pair<unsigned long, Real> >& bands,
+               Real alphaC, Real pC, Real pdSum) {
 
         loss_.clear();
-        loss_.push_back(std::pow(1.0 - pC_, alphaC_)); // A(0)
+        loss_.reserve(upperIndex_);
+        loss_.push_back(std::pow(1.0 - pC, alphaC)); // A(0)
 
         Real res;
         for (unsigned long n = 0; n < upperIndex_ - 1; ++n) { // compute A(n+1)
                                                               // recursively
             res = 0.0;
-            for (unsigned long j = 0;
-                 j <= std::min<unsigned long>(maxNu_ - 1, n); ++j) {
-                iter = epsNuC_.find(j + 1);
-                if (iter != epsNuC_.end()) {
-                    res += (*iter).second * loss_[n - j] * alphaC_;
-                    if (j <= n - 1)
-                        res += (*iter).second / ((Real)(j + 1)) *
-                               ((Real)(n - j)) * loss_[n - j];
-                }
+            // the bands are sorted; those above n+1 units don't contribute
+            for (Size b = 0; b < bands.size() && bands[b].first <= n + 1;
+                 ++b) {
+                unsigned long j = bands[b].first - 1;
+                res += bands[b].second * loss_[n - j] * alphaC;
+                if (j <= n - 1)
+                    res += bands[b].second / ((Real)(j + 1)) *
+                           ((Real)(n - j)) * loss_[n - j];
             }
-            loss_.push_back(res * pC_ / (pdSum_ * ((Real)(n + 1))));
+            loss_.push_back(res * pC / (pdSum * ((Real)(n + 1))));
         }
     }
+
+    void CreditRiskPlus::fourierLoss(
+               const std::vector<std::pair<unsigned long, Real> >& bands,
+               Real alphaC, Real pC, Real pdSum) {
+
+        // The generating function of the loss is
+        // ((1-p)/(1-p*Q(z)))^alpha, with Q(z) the generating function
+        // of the loss given a default of the synthetic sector, i.e.,
+        // the sum over the bands of eps/nu/pdSum z^nu.  It is
+        // evaluated on the roots of unity and inverted; the losses
+        // beyond the transform size are folded back.
+
+        const Size size = upperIndex_;
+        FastFourierTransform fft(std::max<Size>(
+                               FastFourierTransform::min_order(2 * size), 1));
+        const Size N = fft.output_size();
+
+        std::vector<Real> severity(N, 0.0);
+        for (Size b = 0; b < bands.size(); ++b)
+            severity[bands[b].first % N] +=
+                bands[b].second / (Real(bands[b].first) * pdSum);
+
+        std::vector<std::complex<Real> > transform(N), density(N);
+        fft.transform(severity.begin(), severity.end(), transform.begin());
+
+        const Real logA0 = alphaC * std::log(1.0 - pC);
+        #pragma omp parallel for
+        for (Size k = 0; k < N; ++k)
+            transform[k] = std::exp(logA0 - alphaC * std::log(
+                                  std::complex<Real>(1.0) - pC * transform[k]));
+
+        fft.inverse_transform(transform.begin(), transform.end(),
+                              density.begin());
+
+        loss_.resize(size);
+        for (Size n = 0; n < size; ++n)
+            loss_[n] = density[n].real() / N;
+    }
 }
@@ -27,6 +27,7 @@
 #include <ql/qldefines.hpp>
 #include <ql/types.hpp>
 #include <ql/math/matrix.hpp>
+#include <ql/utilities/null.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -34,6 +35,24 @@ namespace QuantLib {
     /*! Extended CreditRisk+ model as described in [1] Integrating Correlations, Risk,
       July 1999 and the references therein.
 
+      The exposures are rounded to multiples of the loss unit and
+      grouped in bands; the loss distribution is computed on the
+      multiples of the unit, either by the Panjer-type recursion of
+      [1], whose cost is proportional to the number of loss units
+      times the number of distinct bands, or by inverting its
+      generating function with a fast Fourier transform, whose cost
+      only grows as n log n with the number n of loss units and whose
+      pointwise evaluations run in parallel when OpenMP is enabled.
+      The Fourier inversion folds the probability of the losses
+      beyond twice the computed range back into it; this is
+      negligible unless the range is truncated close to the bulk of
+      the distribution.
+
+      By default, the distribution is computed up to the loss of the
+      whole portfolio; for large portfolios, the range can be
+      truncated to a given number of loss units to save memory and
+      time, in which case the quantiles beyond it are not available.
+
       \warning the input correlation matrix is not checked for positive
       definiteness
 
@@ -42,12 +61,15 @@ namespace QuantLib {
     class CreditRiskPlus {
 
       public:
+        enum Method { Recursion, Fourier };
 
         CreditRiskPlus(const std::vector<Real> &exposure,
                        const std::vector<Real> &defaultProbability,
                        const std::vector<Size> &sector,
                        const std::vector<Real> &relativeDefaultVariance,
-                       const Matrix &correlation, const Real unit);
+                       const Matrix &correlation, const Real unit,
+                       Method method = Recursion,
+                       Size maxLossUnits = Null<Size>());
 
         const std::vector<Real> &loss() { return loss_; }
         const std::vector<Real> &marginalLoss() { return marginalLoss_; }
@@ -80,6 +102,8 @@ namespace QuantLib {
         const std::vector<Real> relativeDefaultVariance_;
         const Matrix correlation_;
         const Real unit_;
+        const Method method_;
+        const Size maxLossUnits_;
 
         Size n_, m_; // number of sectors, exposures
 
@@ -90,6 +114,12 @@ namespace QuantLib {
         unsigned long upperIndex_;
 
         void compute();
+        void recursiveLoss(
+               const std::vector<std::pair<unsigned long, Real> >& bands,
+               Real alphaC, Real pC, Real pdSum);
+        void fourierLoss(
+               const std::vector<std::pair<unsigned long, Real> >& bands,
+               Real alphaC, Real pC, Real pdSum);
     };
 }
 
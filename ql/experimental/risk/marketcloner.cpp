@@ -0,0 +1,322 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/marketcloner.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
+#include <ql/termstructures/yield/fittedbonddiscountcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/termstructures/yield/bondhelpers.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/optionlet/constantoptionletvol.hpp>
+#include <ql/termstructures/volatility/swaption/swaptionconstantvol.hpp>
+#include <ql/indexes/swapindex.hpp>
+#include <ql/cashflows/floatingratecoupon.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/math/interpolations/backwardflatinterpolation.hpp>
+
+using boost::shared_ptr;
+
+namespace QuantLib {
+
+    MarketCloner::MarketCloner() {
+        registerType<SimpleQuote>(&MarketCloner::cloneSimpleQuote);
+
+        registerType<FlatForward>(&MarketCloner::cloneFlatForward);
+        registerType<ZeroSpreadedTermStructure>(
+                                          &MarketCloner::cloneZeroSpreaded);
+        registerType<ForwardSpreadedTermStructure>(
+                                       &MarketCloner::cloneForwardSpreaded);
+        registerType<FittedBondDiscountCurve>(
+                                           &MarketCloner::cloneFittedCurve);
+        registerPiecewiseYieldCurve<Discount,LogLinear>();
+        registerPiecewiseYieldCurve<Discount,Linear>();
+        registerPiecewiseYieldCurve<ZeroYield,Linear>();
+        registerPiecewiseYieldCurve<ForwardRate,BackwardFlat>();
+
+        registerBaseType<IborIndex>(&MarketCloner::cloneIborIndex);
+        registerBaseType<SwapIndex>(&MarketCloner::cloneSwapIndex);
+
+        registerType<DepositRateHelper>(&MarketCloner::cloneDepositHelper);
+        registerType<FraRateHelper>(&MarketCloner::cloneFraHelper);
+        registerType<SwapRateHelper>(&MarketCloner::cloneSwapHelper);
+        registerBaseType<BondHelper>(&MarketCloner::cloneBondHelper);
+
+        registerType<BlackConstantVol>(&MarketCloner::cloneBlackConstantVol);
+        registerType<ConstantOptionletVolatility>(
+                                  &MarketCloner::cloneConstantOptionletVol);
+        registerType<ConstantSwaptionVolatility>(
+                                   &MarketCloner::cloneConstantSwaptionVol);
+    }
+
+    shared_ptr<Observable>
+    MarketCloner::cloneObservable(const shared_ptr<Observable>& original) {
+        const Observable* key = original.get();
+        std::map<const Observable*,
+                 std::pair<shared_ptr<Observable>,
+                           shared_ptr<Observable> > >::const_iterator i =
+            clones_.find(key);
+        if (i != clones_.end())
+            return i->second.second;
+
+        std::string type = typeid(*original).name();
+        QL_REQUIRE(inProgress_.find(key) == inProgress_.end(),
+                   "cycle detected while cloning "
+                   << boost::core::demangle(type.c_str()));
+
+        Function f;
+        std::map<std::string, Function>::const_iterator j =
+            functions_.find(type);
+        if (j != functions_.end()) {
+            f = j->second;
+        } else {
+            for (Size k=baseFunctions_.size(); k>0; --k) {
+                if (baseFunctions_[k-1].first(*original)) {
+                    f = baseFunctions_[k-1].second;
+                    break;
+                }
+            }
+        }
+        QL_REQUIRE(f, "no cloning function registered for "
+                   << boost::core::demangle(type.c_str()));
+
+        inProgress_.insert(key);
+        shared_ptr<Observable> copy;
+        try {
+            copy = f(*original, *this);
+        } catch (...) {
+            inProgress_.erase(key);
+            throw;
+        }
+        inProgress_.erase(key);
+        QL_REQUIRE(copy, "null copy returned for "
+                   << boost::core::demangle(type.c_str()));
+
+        const Extrapolator* e =
+            dynamic_cast<const Extrapolator*>(original.get());
+        if (e && e->allowsExtrapolation()) {
+            Extrapolator* c = dynamic_cast<Extrapolator*>(copy.get());
+            if (c)
+                c->enableExtrapolation();
+        }
+
+        clones_[key] = std::make_pair(original, copy);
+        return copy;
+    }
+
+
+    shared_ptr<SimpleQuote>
+    MarketCloner::cloneSimpleQuote(const SimpleQuote& q, MarketCloner&) {
+        return shared_ptr<SimpleQuote>(
+                   new SimpleQuote(q.isValid() ? q.value() : Null<Real>()));
+    }
+
+    shared_ptr<FlatForward>
+    MarketCloner::cloneFlatForward(const FlatForward& c,
+                                   MarketCloner& cloner) {
+        if (c.moving_)
+            return shared_ptr<FlatForward>(
+                new FlatForward(c.settlementDays(), c.calendar(),
+                                cloner.clone(c.forward_), c.dayCounter(),
+                                c.compounding_, c.frequency_));
+        else
+            return shared_ptr<FlatForward>(
+                new FlatForward(c.referenceDate(),
+                                cloner.clone(c.forward_), c.dayCounter(),
+                                c.compounding_, c.frequency_));
+    }
+
+    shared_ptr<ZeroSpreadedTermStructure>
+    MarketCloner::cloneZeroSpreaded(const ZeroSpreadedTermStructure& c,
+                                    MarketCloner& cloner) {
+        return shared_ptr<ZeroSpreadedTermStructure>(
+            new ZeroSpreadedTermStructure(cloner.clone(c.originalCurve_),
+                                          cloner.clone(c.spread_),
+                                          c.comp_, c.freq_, c.dc_));
+    }
+
+    shared_ptr<ForwardSpreadedTermStructure>
+    MarketCloner::cloneForwardSpreaded(const ForwardSpreadedTermStructure& c,
+                                       MarketCloner& cloner) {
+        return shared_ptr<ForwardSpreadedTermStructure>(
+            new ForwardSpreadedTermStructure(cloner.clone(c.originalCurve_),
+                                             cloner.clone(c.spread_)));
+    }
+
+    shared_ptr<FittedBondDiscountCurve>
+    MarketCloner::cloneFittedCurve(const FittedBondDiscountCurve& c,
+                                   MarketCloner& cloner) {
+        std::vector<shared_ptr<BondHelper> > helpers =
+            cloner.clone(c.bondHelpers_);
+        // the copy of the fitting method carries the solution
+        shared_ptr<FittedBondDiscountCurve> result;
+        if (c.moving_)
+            result = shared_ptr<FittedBondDiscountCurve>(
+                new FittedBondDiscountCurve(
+                             c.settlementDays(), c.calendar(), helpers,
+                             c.dayCounter(), *c.fittingMethod_,
+                             c.accuracy_, c.maxEvaluations_,
+                             c.guessSolution_, c.simplexLambda_,
+                             c.maxStationaryStateIterations_));
+        else
+            result = shared_ptr<FittedBondDiscountCurve>(
+                new FittedBondDiscountCurve(
+                             c.referenceDate(), helpers,
+                             c.dayCounter(), *c.fittingMethod_,
+                             c.accuracy_, c.maxEvaluations_,
+                             c.guessSolution_, c.simplexLambda_,
+                             c.maxStationaryStateIterations_));
+
+        if (c.calculated_ && result->referenceDate() == c.referenceDate()) {
+            result->maxDate_ = c.maxDate_;
+            result->calculated_ = true;
+        }
+        return result;
+    }
+
+    shared_ptr<IborIndex>
+    MarketCloner::cloneIborIndex(const IborIndex& i, MarketCloner& cloner) {
+        return i.clone(cloner.clone(i.forwardingTermStructure()));
+    }
+
+    shared_ptr<SwapIndex>
+    MarketCloner::cloneSwapIndex(const SwapIndex& i, MarketCloner& cloner) {
+        if (i.exogenousDiscount())
+            return i.clone(cloner.clone(i.forwardingTermStructure()),
+                           cloner.clone(i.discountingTermStructure()));
+        else
+            return i.clone(cloner.clone(i.forwardingTermStructure()));
+    }
+
+    // The indexes stored by the rate helpers are linked to their own
+    // bootstrap handles; they are only used for their conventions,
+    // since the constructors link a new copy to the new helper.
+
+    shared_ptr<DepositRateHelper>
+    MarketCloner::cloneDepositHelper(const DepositRateHelper& h,
+                                     MarketCloner& cloner) {
+        return shared_ptr<DepositRateHelper>(
+                 new DepositRateHelper(cloner.clone(h.quote()), h.iborIndex_));
+    }
+
+    shared_ptr<FraRateHelper>
+    MarketCloner::cloneFraHelper(const FraRateHelper& h,
+                                 MarketCloner& cloner) {
+        Date pillar = h.pillarChoice_ == Pillar::CustomDate ?
+                      h.pillarDate_ : Date();
+        return shared_ptr<FraRateHelper>(
+                 new FraRateHelper(cloner.clone(h.quote()), h.periodToStart_,
+                                   h.iborIndex_, h.pillarChoice_, pillar));
+    }
+
+    shared_ptr<SwapRateHelper>
+    MarketCloner::cloneSwapHelper(const SwapRateHelper& h,
+                                  MarketCloner& cloner) {
+        Date pillar = h.pillarChoice_ == Pillar::CustomDate ?
+                      h.pillarDate_ : Date();
+        return shared_ptr<SwapRateHelper>(
+            new SwapRateHelper(cloner.clone(h.quote()), h.tenor_,
+                               h.calendar_, h.fixedFrequency_,
+                               h.fixedConvention_, h.fixedDayCount_,
+                               h.iborIndex_, cloner.clone(h.spread_),
+                               h.fwdStart_, cloner.clone(h.discountHandle_),
+                               h.settlementDays_, h.pillarChoice_, pillar));
+    }
+
+    shared_ptr<BondHelper>
+    MarketCloner::cloneBondHelper(const BondHelper& h,
+                                  MarketCloner& cloner) {
+        // the bond is priced by the helper's own engine, so it can't
+        // be shared; a new one is built on the same cash flows
+        const shared_ptr<Bond>& bond = h.bond();
+        QL_REQUIRE(bond->redemptions().size() == 1,
+                   "bonds with " << bond->redemptions().size()
+                   << " redemptions can't be cloned");
+        const Leg& cashflows = bond->cashflows();
+        for (Size i=0; i<cashflows.size(); ++i)
+            QL_REQUIRE(!boost::dynamic_pointer_cast<FloatingRateCoupon>(
+                                                              cashflows[i]),
+                       "bonds with floating-rate coupons can't be cloned");
+        shared_ptr<Bond> copy(new Bond(bond->settlementDays(),
+                                       bond->calendar(),
+                                       bond->notionals().front(),
+                                       bond->maturityDate(),
+                                       bond->issueDate(),
+                                       cashflows));
+        return shared_ptr<BondHelper>(
+                 new BondHelper(cloner.clone(h.quote()), copy,
+                                h.useCleanPrice()));
+    }
+
+    shared_ptr<BlackConstantVol>
+    MarketCloner::cloneBlackConstantVol(const BlackConstantVol& v,
+                                        MarketCloner& cloner) {
+        if (v.moving_)
+            return shared_ptr<BlackConstantVol>(
+                new BlackConstantVol(v.settlementDays(), v.calendar(),
+                                     cloner.clone(v.volatility_),
+                                     v.dayCounter()));
+        else
+            return shared_ptr<BlackConstantVol>(
+                new BlackConstantVol(v.referenceDate(), v.calendar(),
+                                     cloner.clone(v.volatility_),
+                                     v.dayCounter()));
+    }
+
+    shared_ptr<ConstantOptionletVolatility>
+    MarketCloner::cloneConstantOptionletVol(
+                                      const ConstantOptionletVolatility& v,
+                                      MarketCloner& cloner) {
+        if (v.moving_)
+            return shared_ptr<ConstantOptionletVolatility>(
+                new ConstantOptionletVolatility(
+                             v.settlementDays(), v.calendar(),
+                             v.businessDayConvention(),
+                             cloner.clone(v.volatility_), v.dayCounter(),
+                             v.type_, v.displacement_));
+        else
+            return shared_ptr<ConstantOptionletVolatility>(
+                new ConstantOptionletVolatility(
+                             v.referenceDate(), v.calendar(),
+                             v.businessDayConvention(),
+                             cloner.clone(v.volatility_), v.dayCounter(),
+                             v.type_, v.displacement_));
+    }
+
+    shared_ptr<ConstantSwaptionVolatility>
+    MarketCloner::cloneConstantSwaptionVol(
+                                       const ConstantSwaptionVolatility& v,
+                                       MarketCloner& cloner) {
+        if (v.moving_)
+            return shared_ptr<ConstantSwaptionVolatility>(
+                new ConstantSwaptionVolatility(
+                             v.settlementDays(), v.calendar(),
+                             v.businessDayConvention(),
+                             cloner.clone(v.volatility_), v.dayCounter(),
+                             v.volatilityType_, v.shift_));
+        else
+            return shared_ptr<ConstantSwaptionVolatility>(
+                new ConstantSwaptionVolatility(
+                             v.referenceDate(), v.calendar(),
+                             v.businessDayConvention(),
+                             cloner.clone(v.volatility_), v.dayCounter(),
+                             v.volatilityType_, v.shift_));
+    }
+
+}
@@ -0,0 +1,345 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file marketcloner.hpp
+    \brief deep copy of graphs of market objects
+*/
+
+#ifndef quantlib_market_cloner_hpp
+#define quantlib_market_cloner_hpp
+
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <boost/core/demangle.hpp>
+#include <boost/function.hpp>
+#include <map>
+#include <set>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace QuantLib {
+
+    class SimpleQuote;
+    class FlatForward;
+    class ZeroSpreadedTermStructure;
+    class ForwardSpreadedTermStructure;
+    class FittedBondDiscountCurve;
+    class IborIndex;
+    class SwapIndex;
+    class DepositRateHelper;
+    class FraRateHelper;
+    class SwapRateHelper;
+    class BondHelper;
+    class BlackConstantVol;
+    class ConstantOptionletVolatility;
+    class ConstantSwaptionVolatility;
+
+    //! deep copy of graphs of market objects
+    /*! The cloner duplicates quotes, term structures, indexes and
+        rate helpers together with the objects they depend upon.  Each
+        object reached from the cloned ones is copied once, however
+        many paths lead to it: the copies are linked to one another in
+        the same way as the originals, and handles sharing a link in
+        the original graph share a link in the copy.  The copies are
+        independent of the originals, so that each of a set of threads
+        can work on its own copy of a market; see ScenarioRunner.
+
+        Bootstrapped curves (PiecewiseYieldCurve and
+        FittedBondDiscountCurve) copy the nodes or the fitted
+        parameters of the original if it was already calculated and
+        the two curves have the same reference date; they are not
+        bootstrapped again until their inputs change.
+
+        The copy of an object is built by a function registered for
+        its dynamic type; functions registered for a base class (e.g.,
+        IborIndex) are used for derived classes without a function of
+        their own.  Functions are registered by default for:
+        - SimpleQuote;
+        - FlatForward, ZeroSpreadedTermStructure,
+          ForwardSpreadedTermStructure, FittedBondDiscountCurve and
+          PiecewiseYieldCurve with discount/log-linear,
+          discount/linear, zero-yield/linear and forward/backward-flat
+          interpolation; other piecewise curves can be enabled with
+          registerPiecewiseYieldCurve();
+        - IborIndex and SwapIndex, including derived classes;
+        - DepositRateHelper, FraRateHelper, SwapRateHelper and
+          BondHelper, including derived classes;
+        - BlackConstantVol, ConstantOptionletVolatility and
+          ConstantSwaptionVolatility.
+        Objects that can be safely shared by the copies (e.g., a
+        volatility surface with a fixed reference date and no quotes)
+        can be passed to share() instead.
+
+        \warning The copies register with the evaluation date in use
+                 when they are built; to clone a market for a
+                 ValuationContext, bind the context during the
+                 cloning.  Index fixings are stored in the global
+                 IndexManager and are shared by the copies.  Since
+                 some of the copies register with global observables,
+                 a market must not be cloned while other threads are
+                 building or using objects.  Bond helpers are copied
+                 on a new bond with the same cash flows, which is only
+                 possible for bonds with fixed coupons and a single
+                 redemption; derived bond helpers are copied as
+                 BondHelper instances.  Bootstrap settings other than
+                 the accuracy and the interpolator are not copied.
+
+        \ingroup termstructures
+    */
+    class MarketCloner {
+      public:
+        typedef boost::function<boost::shared_ptr<Observable>(
+                               const Observable&, MarketCloner&)> Function;
+
+        MarketCloner();
+
+        //! \name Cloning
+        //@{
+        template <class T>
+        boost::shared_ptr<T> clone(const boost::shared_ptr<T>&);
+        /*! The returned handle can be relinked; handles copied from
+            it share the link. */
+        template <class T>
+        RelinkableHandle<T> clone(const Handle<T>&);
+        template <class T>
+        std::vector<boost::shared_ptr<T> > clone(
+                                 const std::vector<boost::shared_ptr<T> >&);
+        template <class T>
+        std::vector<Handle<T> > clone(const std::vector<Handle<T> >&);
+        //! uses the given object in the copies instead of cloning it
+        template <class T>
+        void share(const boost::shared_ptr<T>&);
+        //! number of objects copied or shared so far
+        Size size() const { return clones_.size(); }
+        //@}
+
+        //! \name Registration
+        //@{
+        //! copies objects of the given dynamic type
+        template <class T>
+        void registerType(const boost::function<boost::shared_ptr<T>(
+                                          const T&, MarketCloner&)>& f);
+        //! copies objects derived from the given type
+        /*! Functions registered later take precedence. */
+        template <class T>
+        void registerBaseType(const boost::function<boost::shared_ptr<T>(
+                                              const T&, MarketCloner&)>& f);
+        template <class Traits, class Interpolator>
+        void registerPiecewiseYieldCurve();
+        //@}
+      private:
+        boost::shared_ptr<Observable> cloneObservable(
+                                   const boost::shared_ptr<Observable>& o);
+        std::map<std::string, Function> functions_;
+        std::vector<std::pair<boost::function<bool(const Observable&)>,
+                              Function> > baseFunctions_;
+        // originals are kept alive so that their addresses aren't reused
+        std::map<const Observable*,
+                 std::pair<boost::shared_ptr<Observable>,
+                           boost::shared_ptr<Observable> > > clones_;
+        std::map<const Observable*,
+                 std::pair<boost::shared_ptr<Observable>,
+                           boost::shared_ptr<void> > > links_;
+        std::set<const Observable*> inProgress_;
+        // cloning functions for the types supported by default
+        template <class Curve>
+        static boost::shared_ptr<Curve> clonePiecewiseYieldCurve(
+                                          const Curve&, MarketCloner&);
+        static boost::shared_ptr<SimpleQuote> cloneSimpleQuote(
+                                    const SimpleQuote&, MarketCloner&);
+        static boost::shared_ptr<FlatForward> cloneFlatForward(
+                                    const FlatForward&, MarketCloner&);
+        static boost::shared_ptr<ZeroSpreadedTermStructure>
+        cloneZeroSpreaded(const ZeroSpreadedTermStructure&, MarketCloner&);
+        static boost::shared_ptr<ForwardSpreadedTermStructure>
+        cloneForwardSpreaded(const ForwardSpreadedTermStructure&,
+                             MarketCloner&);
+        static boost::shared_ptr<FittedBondDiscountCurve>
+        cloneFittedCurve(const FittedBondDiscountCurve&, MarketCloner&);
+        static boost::shared_ptr<IborIndex> cloneIborIndex(
+                                      const IborIndex&, MarketCloner&);
+        static boost::shared_ptr<SwapIndex> cloneSwapIndex(
+                                      const SwapIndex&, MarketCloner&);
+        static boost::shared_ptr<DepositRateHelper> cloneDepositHelper(
+                                const DepositRateHelper&, MarketCloner&);
+        static boost::shared_ptr<FraRateHelper> cloneFraHelper(
+                                    const FraRateHelper&, MarketCloner&);
+        static boost::shared_ptr<SwapRateHelper> cloneSwapHelper(
+                                   const SwapRateHelper&, MarketCloner&);
+        static boost::shared_ptr<BondHelper> cloneBondHelper(
+                                       const BondHelper&, MarketCloner&);
+        static boost::shared_ptr<BlackConstantVol> cloneBlackConstantVol(
+                                 const BlackConstantVol&, MarketCloner&);
+        static boost::shared_ptr<ConstantOptionletVolatility>
+        cloneConstantOptionletVol(const ConstantOptionletVolatility&,
+                                  MarketCloner&);
+        static boost::shared_ptr<ConstantSwaptionVolatility>
+        cloneConstantSwaptionVol(const ConstantSwaptionVolatility&,
+                                 MarketCloner&);
+    };
+
+
+    namespace detail {
+
+        template <class T>
+        class MarketClonerFunction {
+          public:
+            typedef boost::function<boost::shared_ptr<T>(
+                                      const T&, MarketCloner&)> function;
+            explicit MarketClonerFunction(const function& f) : f_(f) {}
+            boost::shared_ptr<Observable> operator()(const Observable& o,
+                                                     MarketCloner& c) const {
+                return f_(dynamic_cast<const T&>(o), c);
+            }
+          private:
+            function f_;
+        };
+
+        template <class T>
+        bool isMarketObjectOfType(const Observable& o) {
+            return dynamic_cast<const T*>(&o) != 0;
+        }
+
+    }
+
+
+    // template definitions
+
+    template <class T>
+    boost::shared_ptr<T>
+    MarketCloner::clone(const boost::shared_ptr<T>& p) {
+        if (!p)
+            return boost::shared_ptr<T>();
+        boost::shared_ptr<T> result =
+            boost::dynamic_pointer_cast<T>(cloneObservable(p));
+        QL_REQUIRE(result, "copy of " << boost::core::demangle(
+                                                    typeid(*p).name())
+                   << " is not a " << boost::core::demangle(
+                                                    typeid(T).name()));
+        return result;
+    }
+
+    template <class T>
+    RelinkableHandle<T> MarketCloner::clone(const Handle<T>& h) {
+        boost::shared_ptr<Observable> link = h;
+        typename std::map<const Observable*,
+                          std::pair<boost::shared_ptr<Observable>,
+                                    boost::shared_ptr<void> > >::iterator i =
+            links_.find(link.get());
+        if (i != links_.end())
+            return *boost::static_pointer_cast<RelinkableHandle<T> >(
+                                                           i->second.second);
+        boost::shared_ptr<RelinkableHandle<T> > copy(
+                                                  new RelinkableHandle<T>);
+        if (!h.empty())
+            copy->linkTo(clone(h.currentLink()));
+        links_[link.get()] = std::make_pair(link,
+                                            boost::shared_ptr<void>(copy));
+        return *copy;
+    }
+
+    template <class T>
+    std::vector<boost::shared_ptr<T> >
+    MarketCloner::clone(const std::vector<boost::shared_ptr<T> >& v) {
+        std::vector<boost::shared_ptr<T> > result(v.size());
+        for (Size i=0; i<v.size(); ++i)
+            result[i] = clone(v[i]);
+        return result;
+    }
+
+    template <class T>
+    std::vector<Handle<T> >
+    MarketCloner::clone(const std::vector<Handle<T> >& v) {
+        std::vector<Handle<T> > result;
+        result.reserve(v.size());
+        for (Size i=0; i<v.size(); ++i)
+            result.push_back(clone(v[i]));
+        return result;
+    }
+
+    template <class T>
+    void MarketCloner::share(const boost::shared_ptr<T>& p) {
+        QL_REQUIRE(p, "null object given");
+        boost::shared_ptr<Observable> o = p;
+        clones_[o.get()] = std::make_pair(o, o);
+    }
+
+    template <class T>
+    void MarketCloner::registerType(
+              const boost::function<boost::shared_ptr<T>(
+                                       const T&, MarketCloner&)>& f) {
+        QL_REQUIRE(f, "null cloning function given");
+        functions_[typeid(T).name()] = detail::MarketClonerFunction<T>(f);
+    }
+
+    template <class T>
+    void MarketCloner::registerBaseType(
+              const boost::function<boost::shared_ptr<T>(
+                                       const T&, MarketCloner&)>& f) {
+        QL_REQUIRE(f, "null cloning function given");
+        baseFunctions_.push_back(
+            std::make_pair(
+                boost::function<bool(const Observable&)>(
+                                  &detail::isMarketObjectOfType<T>),
+                Function(detail::MarketClonerFunction<T>(f))));
+    }
+
+    template <class Traits, class Interpolator>
+    void MarketCloner::registerPiecewiseYieldCurve() {
+        typedef PiecewiseYieldCurve<Traits,Interpolator> Curve;
+        registerType<Curve>(&MarketCloner::clonePiecewiseYieldCurve<Curve>);
+    }
+
+    template <class Curve>
+    boost::shared_ptr<Curve>
+    MarketCloner::clonePiecewiseYieldCurve(const Curve& c,
+                                           MarketCloner& cloner) {
+        std::vector<boost::shared_ptr<typename Curve::traits_type::helper> >
+            instruments = cloner.clone(c.instruments_);
+        std::vector<Handle<Quote> > jumps = cloner.clone(c.jumps());
+        boost::shared_ptr<Curve> result;
+        if (c.moving_)
+            result = boost::shared_ptr<Curve>(
+                new Curve(c.settlementDays(), c.calendar(), instruments,
+                          c.dayCounter(), jumps, c.jumpDates(),
+                          c.accuracy_, c.interpolator_));
+        else
+            result = boost::shared_ptr<Curve>(
+                new Curve(c.referenceDate(), instruments,
+                          c.dayCounter(), jumps, c.jumpDates(),
+                          c.accuracy_, c.interpolator_));
+
+        if (c.calculated_ && result->referenceDate() == c.referenceDate()) {
+            // the nodes are copied rather than bootstrapped again;
+            // the bootstrap is initialized when the inputs change
+            result->dates_ = c.dates_;
+            result->times_ = c.times_;
+            result->data_ = c.data_;
+            result->maxDate_ = c.maxDate_;
+            result->interpolation_ =
+                result->interpolator_.interpolate(result->times_.begin(),
+                                                  result->times_.end(),
+                                                  result->data_.begin());
+            result->interpolation_.update();
+            result->calculated_ = true;
+        }
+        return result;
+    }
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/marketsnapshot.hpp>
+#include <boost/cstdint.hpp>
+#include <istream>
+#include <ostream>
+
+namespace QuantLib {
+
+    namespace {
+
+        // format: the magic number, the version and the number of
+        // records, followed by the records.  Each record holds its
+        // name, its kind, and its dates (as serial numbers), values
+        // and sizes, each preceded by their number.
+        const boost::uint32_t magicNumber = 0x514c534e;  // "QLSN"
+        const boost::uint32_t formatVersion = 1;
+
+        template <class T>
+        void writeRaw(std::ostream& out, T x) {
+            out.write(reinterpret_cast<const char*>(&x), sizeof(T));
+        }
+
+        template <class T>
+        T readRaw(std::istream& in) {
+            T x;
+            in.read(reinterpret_cast<char*>(&x), sizeof(T));
+            QL_REQUIRE(in, "unexpected end of snapshot");
+            return x;
+        }
+
+        void writeSize(std::ostream& out, Size n) {
+            writeRaw(out, boost::uint64_t(n));
+        }
+
+        Size readSize(std::istream& in) {
+            return Size(readRaw<boost::uint64_t>(in));
+        }
+
+    }
+
+    void MarketSnapshot::add(const std::string& name,
+                             const CalibratedModel& model) {
+        Array parameters = model.params();
+        Record r;
+        r.kind = ModelRecord;
+        r.values.assign(parameters.begin(), parameters.end());
+        records_[name] = r;
+    }
+
+    bool MarketSnapshot::restore(const std::string& name,
+                                 CalibratedModel& model) const {
+        const Record& r = record(name, ModelRecord);
+        QL_REQUIRE(r.values.size() == model.params().size(),
+                   "snapshot for " << name << " has " << r.values.size()
+                   << " parameters; " << model.params().size()
+                   << " required by the model");
+        Array parameters(r.values.begin(), r.values.end());
+        model.setParams(parameters);
+        return true;
+    }
+
+    bool MarketSnapshot::has(const std::string& name) const {
+        return records_.find(name) != records_.end();
+    }
+
+    const MarketSnapshot::Record&
+    MarketSnapshot::record(const std::string& name, Kind kind) const {
+        std::map<std::string, Record>::const_iterator i =
+            records_.find(name);
+        QL_REQUIRE(i != records_.end(), "no snapshot for " << name);
+        QL_REQUIRE(i->second.kind == kind,
+                   "snapshot for " << name
+                   << " was taken from a different kind of object");
+        return i->second;
+    }
+
+    void MarketSnapshot::save(std::ostream& out) const {
+        writeRaw(out, magicNumber);
+        writeRaw(out, formatVersion);
+        writeSize(out, records_.size());
+        for (std::map<std::string, Record>::const_iterator i =
+                 records_.begin(); i != records_.end(); ++i) {
+            writeSize(out, i->first.size());
+            out.write(i->first.data(), i->first.size());
+            write(out, i->second);
+        }
+        QL_REQUIRE(out, "error while writing snapshot");
+    }
+
+    void MarketSnapshot::load(std::istream& in) {
+        QL_REQUIRE(readRaw<boost::uint32_t>(in) == magicNumber,
+                   "not a snapshot, or written with a different "
+                   "byte order");
+        boost::uint32_t version = readRaw<boost::uint32_t>(in);
+        QL_REQUIRE(version == formatVersion,
+                   "unsupported snapshot version (" << version << ")");
+        std::map<std::string, Record> records;
+        Size n = readSize(in);
+        for (Size i=0; i<n; ++i) {
+            std::string name(readSize(in), '\0');
+            if (!name.empty())
+                in.read(&name[0], name.size());
+            QL_REQUIRE(in, "unexpected end of snapshot");
+            records[name] = read(in);
+        }
+        records_.swap(records);
+    }
+
+    void MarketSnapshot::write(std::ostream& out, const Record& r) {
+        writeRaw(out, boost::int32_t(r.kind));
+        writeSize(out, r.dates.size());
+        for (Size i=0; i<r.dates.size(); ++i)
+            writeRaw(out, boost::int32_t(r.dates[i].serialNumber()));
+        writeSize(out, r.values.size());
+        for (Size i=0; i<r.values.size(); ++i)
+            writeRaw(out, double(r.values[i]));
+        writeSize(out, r.sizes.size());
+        for (Size i=0; i<r.sizes.size(); ++i)
+            writeSize(out, r.sizes[i]);
+    }
+
+    MarketSnapshot::Record MarketSnapshot::read(std::istream& in) {
+        Record r;
+        boost::int32_t kind = readRaw<boost::int32_t>(in);
+        QL_REQUIRE(kind >= YieldCurveRecord && kind <= ModelRecord,
+                   "unknown kind of record (" << kind << ") in snapshot");
+        r.kind = Kind(kind);
+        r.dates.resize(readSize(in));
+        for (Size i=0; i<r.dates.size(); ++i) {
+            boost::int32_t serial = readRaw<boost::int32_t>(in);
+            r.dates[i] = serial == 0 ? Date() : Date(serial);
+        }
+        r.values.resize(readSize(in));
+        for (Size i=0; i<r.values.size(); ++i)
+            r.values[i] = readRaw<double>(in);
+        r.sizes.resize(readSize(in));
+        for (Size i=0; i<r.sizes.size(); ++i)
+            r.sizes[i] = readSize(in);
+        return r;
+    }
+
+}
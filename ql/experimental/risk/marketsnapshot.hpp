@@ -0,0 +1,344 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file marketsnapshot.hpp
+    \brief binary snapshots of bootstrapped and calibrated objects
+*/
+
+#ifndef quantlib_market_snapshot_hpp
+#define quantlib_market_snapshot_hpp
+
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/credit/piecewisedefaultcurve.hpp>
+#include <ql/termstructures/volatility/swaption/swaptionvolcube1.hpp>
+#include <ql/models/model.hpp>
+#include <algorithm>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! binary snapshots of bootstrapped and calibrated objects
+    /*! A snapshot stores, under a name chosen by the user, the results
+        of the expensive calculations performed by a few classes:
+        - the nodes of PiecewiseYieldCurve and PiecewiseDefaultCurve
+          instances;
+        - the SABR parameters calibrated at the nodes of
+          SwaptionVolCube1x instances;
+        - the parameters of CalibratedModel instances (e.g.,
+          HestonModel or MarkovFunctional).
+
+        The snapshot can be written to and read from a stream in a
+        compact, versioned binary format.  It doesn't store the
+        objects themselves: after a restart, the objects are built as
+        usual from their quotes, so that they are registered with
+        their observables, and their state is then restored from the
+        snapshot instead of being bootstrapped or calibrated again.
+        The restored objects are notified as usual when their inputs
+        change, and recalculate their results.
+
+        A curve is restored only if its reference date and the values
+        of its helper quotes are the same as when the snapshot was
+        taken; otherwise, the snapshot is stale and the curve is left
+        untouched, so that it's bootstrapped as usual.  The nodes of a
+        swaption cube are used as the results of their previous
+        calibration: the nodes whose inputs didn't change are not
+        calibrated again.  Model parameters are restored
+        unconditionally, since the inputs of a calibration are not
+        available to the model.
+
+        \warning The binary format uses the byte order of the machine
+                 writing it; streams written on a machine with a
+                 different byte order are rejected.  Streams must be
+                 opened in binary mode.
+
+        \ingroup termstructures
+    */
+    class MarketSnapshot {
+      public:
+        //! \name Recording
+        //@{
+        /*! The curve is bootstrapped if needed. */
+        template <class Traits, class Interpolator,
+                  template <class> class Bootstrap>
+        void add(const std::string& name,
+                 const PiecewiseYieldCurve<Traits,Interpolator,
+                                           Bootstrap>& curve);
+        /*! The curve is bootstrapped if needed. */
+        template <class Traits, class Interpolator,
+                  template <class> class Bootstrap>
+        void add(const std::string& name,
+                 const PiecewiseDefaultCurve<Traits,Interpolator,
+                                             Bootstrap>& curve);
+        /*! The cube is calibrated if needed. */
+        template <class Model>
+        void add(const std::string& name,
+                 const SwaptionVolCube1x<Model>& cube);
+        void add(const std::string& name, const CalibratedModel& model);
+        //@}
+        //! \name Restoring
+        //@{
+        /*! Returns false if the snapshot is stale; in that case, the
+            curve is left untouched.
+        */
+        template <class Traits, class Interpolator,
+                  template <class> class Bootstrap>
+        bool restore(const std::string& name,
+                     PiecewiseYieldCurve<Traits,Interpolator,
+                                         Bootstrap>& curve) const;
+        /*! Returns false if the snapshot is stale; in that case, the
+            curve is left untouched.
+        */
+        template <class Traits, class Interpolator,
+                  template <class> class Bootstrap>
+        bool restore(const std::string& name,
+                     PiecewiseDefaultCurve<Traits,Interpolator,
+                                           Bootstrap>& curve) const;
+        /*! Returns false if the cube has a different number of nodes;
+            in that case, it is calibrated as usual.
+        */
+        template <class Model>
+        bool restore(const std::string& name,
+                     SwaptionVolCube1x<Model>& cube) const;
+        bool restore(const std::string& name, CalibratedModel& model) const;
+        //@}
+        //! \name Input/output
+        //@{
+        void save(std::ostream& out) const;
+        //! replaces the contents of the snapshot
+        void load(std::istream& in);
+        //@}
+        //! \name Inspectors
+        //@{
+        bool has(const std::string& name) const;
+        Size size() const { return records_.size(); }
+        //@}
+      private:
+        enum Kind { YieldCurveRecord = 1, DefaultCurveRecord,
+                    SwaptionCubeRecord, ModelRecord };
+        struct Record {
+            Kind kind;
+            std::vector<Date> dates;
+            std::vector<Real> values;
+            std::vector<Size> sizes;
+        };
+        const Record& record(const std::string& name, Kind kind) const;
+        template <class Curve>
+        void addCurve(const std::string& name, const Curve& curve,
+                      Kind kind);
+        template <class Curve>
+        bool restoreCurve(const std::string& name, Curve& curve,
+                          Kind kind) const;
+        template <class Helper>
+        static std::vector<Real> quoteValues(
+                      const std::vector<boost::shared_ptr<Helper> >& helpers);
+        static void write(std::ostream& out, const Record& r);
+        static Record read(std::istream& in);
+        std::map<std::string, Record> records_;
+    };
+
+
+    // template definitions
+
+    template <class T, class I, template <class> class B>
+    inline void MarketSnapshot::add(
+                        const std::string& name,
+                        const PiecewiseYieldCurve<T,I,B>& curve) {
+        addCurve(name, curve, YieldCurveRecord);
+    }
+
+    template <class T, class I, template <class> class B>
+    inline void MarketSnapshot::add(
+                        const std::string& name,
+                        const PiecewiseDefaultCurve<T,I,B>& curve) {
+        addCurve(name, curve, DefaultCurveRecord);
+    }
+
+    template <class T, class I, template <class> class B>
+    inline bool MarketSnapshot::restore(
+                        const std::string& name,
+                        PiecewiseYieldCurve<T,I,B>& curve) const {
+        return restoreCurve(name, curve, YieldCurveRecord);
+    }
+
+    template <class T, class I, template <class> class B>
+    inline bool MarketSnapshot::restore(
+                        const std::string& name,
+                        PiecewiseDefaultCurve<T,I,B>& curve) const {
+        return restoreCurve(name, curve, DefaultCurveRecord);
+    }
+
+    template <class Helper>
+    std::vector<Real> MarketSnapshot::quoteValues(
+                    const std::vector<boost::shared_ptr<Helper> >& helpers) {
+        // the bootstrap sorts the helpers, so the order is not relevant
+        std::vector<Real> values(helpers.size());
+        for (Size i=0; i<helpers.size(); ++i)
+            values[i] = helpers[i]->quote()->value();
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+
+    template <class Curve>
+    void MarketSnapshot::addCurve(const std::string& name,
+                                  const Curve& curve, Kind kind) {
+        curve.calculate();
+        // layout: the node dates followed by the max date; the node
+        // times and data followed by the helper quotes.
+        Record r;
+        r.kind = kind;
+        r.dates = curve.dates_;
+        r.dates.push_back(curve.maxDate_);
+        std::vector<Real> quotes = quoteValues(curve.instruments_);
+        r.values = curve.times_;
+        r.values.insert(r.values.end(),
+                        curve.data_.begin(), curve.data_.end());
+        r.values.insert(r.values.end(), quotes.begin(), quotes.end());
+        r.sizes.push_back(curve.times_.size());
+        r.sizes.push_back(quotes.size());
+        records_[name] = r;
+    }
+
+    template <class Curve>
+    bool MarketSnapshot::restoreCurve(const std::string& name,
+                                      Curve& curve, Kind kind) const {
+        const Record& r = record(name, kind);
+        Size n = r.sizes[0], m = r.sizes[1];
+        QL_REQUIRE(r.dates.size() == n+1 && r.values.size() == 2*n+m,
+                   "corrupted snapshot for " << name);
+
+        if (n == 0 || r.dates[0] != curve.referenceDate())
+            return false;
+        std::vector<Real> quotes = quoteValues(curve.instruments_);
+        if (quotes.size() != m ||
+            !std::equal(quotes.begin(), quotes.end(), r.values.begin()+2*n))
+            return false;
+
+        curve.dates_.assign(r.dates.begin(), r.dates.begin()+n);
+        curve.maxDate_ = r.dates.back();
+        curve.times_.assign(r.values.begin(), r.values.begin()+n);
+        curve.data_.assign(r.values.begin()+n, r.values.begin()+2*n);
+        curve.interpolation_ =
+            curve.interpolator_.interpolate(curve.times_.begin(),
+                                            curve.times_.end(),
+                                            curve.data_.begin());
+        curve.interpolation_.update();
+        // the bootstrap is initialized when the inputs change
+        curve.calculated_ = true;
+        curve.notifyObservers();
+        return true;
+    }
+
+    template <class M>
+    void MarketSnapshot::add(const std::string& name,
+                             const SwaptionVolCube1x<M>& cube) {
+        typedef typename SwaptionVolCube1x<M>::NodeCalibration Node;
+        cube.calculate();
+        // layout: the number of sparse and dense nodes, followed by
+        // the number of strikes, guesses and parameters of each node;
+        // for each node, its scalar results and inputs followed by
+        // its strikes, volatilities, guesses and parameters.
+        Record r;
+        r.kind = SwaptionCubeRecord;
+        r.sizes.push_back(cube.sparseCalibrations_.size());
+        r.sizes.push_back(cube.denseCalibrations_.size());
+        for (Size l=0; l<2; ++l) {
+            const std::vector<Node>& nodes =
+                l == 0 ? cube.sparseCalibrations_ : cube.denseCalibrations_;
+            for (Size i=0; i<nodes.size(); ++i) {
+                const Node& node = nodes[i];
+                r.sizes.push_back(node.strikes.size());
+                r.sizes.push_back(node.guess.size());
+                r.sizes.push_back(node.parameters.size());
+                r.values.push_back(node.forward);
+                r.values.push_back(node.shift);
+                r.values.push_back(node.optionTime);
+                r.values.push_back(node.error);
+                r.values.push_back(node.maxError);
+                r.values.push_back(Real(node.endCriteria));
+                r.values.insert(r.values.end(), node.strikes.begin(),
+                                node.strikes.end());
+                r.values.insert(r.values.end(), node.volatilities.begin(),
+                                node.volatilities.end());
+                r.values.insert(r.values.end(), node.guess.begin(),
+                                node.guess.end());
+                r.values.insert(r.values.end(), node.parameters.begin(),
+                                node.parameters.end());
+            }
+        }
+        records_[name] = r;
+    }
+
+    template <class M>
+    bool MarketSnapshot::restore(const std::string& name,
+                                 SwaptionVolCube1x<M>& cube) const {
+        typedef typename SwaptionVolCube1x<M>::NodeCalibration Node;
+        const Record& r = record(name, SwaptionCubeRecord);
+        QL_REQUIRE(r.sizes.size() >= 2 &&
+                   r.sizes.size() == 2 + 3*(r.sizes[0]+r.sizes[1]),
+                   "corrupted snapshot for " << name);
+
+        std::vector<Node> nodes[2];
+        Size s = 2, v = 0;
+        for (Size l=0; l<2; ++l) {
+            nodes[l].resize(r.sizes[l]);
+            for (Size i=0; i<nodes[l].size(); ++i, s+=3) {
+                Size nStrikes = r.sizes[s], nGuess = r.sizes[s+1],
+                     nParameters = r.sizes[s+2];
+                QL_REQUIRE(v + 6 + 2*nStrikes + nGuess + nParameters
+                           <= r.values.size(),
+                           "corrupted snapshot for " << name);
+                Node& node = nodes[l][i];
+                node.forward = r.values[v++];
+                node.shift = r.values[v++];
+                node.optionTime = r.values[v++];
+                node.error = r.values[v++];
+                node.maxError = r.values[v++];
+                node.endCriteria = EndCriteria::Type(int(r.values[v++]));
+                std::vector<Real>::const_iterator begin =
+                    r.values.begin() + v;
+                node.strikes.assign(begin, begin+nStrikes);
+                begin += nStrikes;
+                node.volatilities.assign(begin, begin+nStrikes);
+                begin += nStrikes;
+                node.guess.assign(begin, begin+nGuess);
+                begin += nGuess;
+                node.parameters.assign(begin, begin+nParameters);
+                v += 2*nStrikes + nGuess + nParameters;
+            }
+        }
+        QL_REQUIRE(v == r.values.size(),
+                   "corrupted snapshot for " << name);
+
+        Size nodesInCube =
+            cube.optionTenors().size()*cube.swapTenors().size();
+        if (nodes[0].size() != nodesInCube)
+            return false;
+
+        // the restored nodes are used as previous calibrations; the
+        // ones whose inputs are unchanged are not calibrated again
+        cube.sparseCalibrations_.swap(nodes[0]);
+        cube.denseCalibrations_.swap(nodes[1]);
+        cube.update();
+        return true;
+    }
+
+}
+
+#endif
@@ -0,0 +1,195 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/scenariorunner.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace QuantLib {
+
+    ScenarioRunner::ScenarioRunner(const MarketFactory& factory,
+                                   Size workers)
+    : factory_(factory), workers_(workers) {
+        QL_REQUIRE(factory_, "null market factory given");
+        if (workers_ == Null<Size>()) {
+            workers_ = 1;
+            #ifdef _OPENMP
+            workers_ = omp_get_max_threads();
+            #endif
+        }
+        QL_REQUIRE(workers_ > 0, "at least one worker required");
+    }
+
+    const std::string& ScenarioRunner::error(Size scenario) const {
+        QL_REQUIRE(scenario < errors_.size(),
+                   "scenario #" << scenario << " not available; "
+                   << errors_.size() << " scenarios calculated");
+        return errors_[scenario];
+    }
+
+    std::vector<ScenarioRunner::Scenario>
+    ScenarioRunner::bucketScenarios(Size quotes, Real shift) {
+        std::vector<Scenario> scenarios(quotes);
+        for (Size i=0; i<quotes; ++i)
+            scenarios[i].push_back(std::make_pair(i, shift));
+        return scenarios;
+    }
+
+    ScenarioRunner::Scenario
+    ScenarioRunner::parallelScenario(Size quotes, Real shift) {
+        Scenario scenario(quotes);
+        for (Size i=0; i<quotes; ++i)
+            scenario[i] = std::make_pair(i, shift);
+        return scenario;
+    }
+
+    void ScenarioRunner::buildMarkets() {
+        if (!markets_.empty())
+            return;
+
+        // the copies are built sequentially, since their objects
+        // might register with shared observables (e.g., indexes)
+        std::vector<boost::shared_ptr<ValuationContext> > contexts;
+        std::vector<Market> markets;
+        for (Size w=0; w<workers_; ++w) {
+            boost::shared_ptr<ValuationContext> context(
+                                                     new ValuationContext);
+            Market market;
+            {
+                ValuationContext::Binding binding(*context);
+                market = factory_();
+            }
+            for (Size i=0; i<market.quotes.size(); ++i)
+                QL_REQUIRE(market.quotes[i],
+                           "null quote #" << i << " returned by factory");
+            for (Size i=0; i<market.instruments.size(); ++i)
+                QL_REQUIRE(market.instruments[i],
+                           "null instrument #" << i
+                           << " returned by factory");
+            if (w > 0) {
+                QL_REQUIRE(market.quotes.size() == markets[0].quotes.size(),
+                           "market copy #" << w << " has "
+                           << market.quotes.size() << " quotes; "
+                           << markets[0].quotes.size() << " expected");
+                QL_REQUIRE(market.instruments.size() ==
+                           markets[0].instruments.size(),
+                           "market copy #" << w << " has "
+                           << market.instruments.size() << " instruments; "
+                           << markets[0].instruments.size() << " expected");
+            }
+            contexts.push_back(context);
+            markets.push_back(market);
+        }
+
+        baseValues_.resize(markets[0].quotes.size());
+        for (Size i=0; i<baseValues_.size(); ++i) {
+            QL_REQUIRE(markets[0].quotes[i]->isValid(),
+                       "quote #" << i << " has no value");
+            baseValues_[i] = markets[0].quotes[i]->value();
+        }
+
+        contexts_.swap(contexts);
+        markets_.swap(markets);
+    }
+
+    void ScenarioRunner::applyScenario(Size worker,
+                                       const std::vector<Real>& values) {
+        // quotes already at the required value don't notify
+        const std::vector<boost::shared_ptr<SimpleQuote> >& quotes =
+            markets_[worker].quotes;
+        for (Size i=0; i<quotes.size(); ++i)
+            quotes[i]->setValue(values[i]);
+    }
+
+    Matrix ScenarioRunner::calculate(const std::vector<Scenario>& scenarios) {
+        buildMarkets();
+
+        const Size n = scenarios.size();
+        const Size nQuotes = baseValues_.size();
+        const Size nInstruments = markets_[0].instruments.size();
+        for (Size s=0; s<n; ++s) {
+            for (Size k=0; k<scenarios[s].size(); ++k)
+                QL_REQUIRE(scenarios[s][k].first < nQuotes,
+                           "scenario #" << s << " shifts quote #"
+                           << scenarios[s][k].first << "; "
+                           << nQuotes << " quotes given");
+        }
+
+        for (Size w=0; w<workers_; ++w) {
+            ValuationContext::Binding binding(*contexts_[w]);
+            applyScenario(w, baseValues_);
+        }
+        baseNPVs_.resize(nInstruments);
+        {
+            ValuationContext::Binding binding(*contexts_[0]);
+            for (Size j=0; j<nInstruments; ++j) {
+                try {
+                    baseNPVs_[j] = markets_[0].instruments[j]->NPV();
+                } catch (std::exception& e) {
+                    QL_FAIL("instrument #" << j
+                            << " failed in base scenario: " << e.what());
+                }
+            }
+        }
+
+        Matrix results(n, nInstruments, Null<Real>());
+        errors_.assign(n, std::string());
+
+        #pragma omp parallel for schedule(dynamic) num_threads(int(workers_))
+        for (Size s=0; s<n; ++s) {
+            Size w = 0;
+            #ifdef _OPENMP
+            w = omp_get_thread_num();
+            #endif
+            ValuationContext::Binding binding(*contexts_[w]);
+            const Market& market = markets_[w];
+            try {
+                std::vector<Real> values(baseValues_);
+                for (Size k=0; k<scenarios[s].size(); ++k)
+                    values[scenarios[s][k].first] += scenarios[s][k].second;
+                applyScenario(w, values);
+            } catch (std::exception& e) {
+                errors_[s] = e.what();
+                continue;
+            } catch (...) {
+                errors_[s] = "unknown error";
+                continue;
+            }
+            for (Size j=0; j<nInstruments; ++j) {
+                try {
+                    results[s][j] = market.instruments[j]->NPV()
+                                  - baseNPVs_[j];
+                } catch (std::exception& e) {
+                    if (errors_[s].empty())
+                        errors_[s] = e.what();
+                } catch (...) {
+                    if (errors_[s].empty())
+                        errors_[s] = "unknown error";
+                }
+            }
+        }
+
+        for (Size w=0; w<workers_; ++w) {
+            ValuationContext::Binding binding(*contexts_[w]);
+            applyScenario(w, baseValues_);
+        }
+
+        return results;
+    }
+
+}
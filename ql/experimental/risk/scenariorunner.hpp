@@ -0,0 +1,132 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file scenariorunner.hpp
+    \brief concurrent evaluation of quote-shift scenarios
+*/
+
+#ifndef quantlib_scenario_runner_hpp
+#define quantlib_scenario_runner_hpp
+
+#include <ql/instrument.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/settings.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/function.hpp>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! concurrent evaluation of quote-shift scenarios
+    /*! This class generalizes the functions in sensitivityanalysis.hpp:
+        a scenario shifts any number of market quotes at the same
+        time, and the P&L of a set of instruments is calculated for a
+        whole set of scenarios.
+
+        Since the objects in a market graph are modified during the
+        evaluation of a scenario, each worker thread needs its own
+        copy of the market, i.e., of the quotes, of the term
+        structures built upon them and of the instruments.  The copies
+        are built by a factory, which is called once for each worker;
+        it must return the quotes and instruments in the same order
+        each time, and can use a MarketCloner to copy an existing
+        market.  Each copy is built and evaluated within its own
+        ValuationContext, so that the copies don't share the
+        evaluation date, whose observers would otherwise be notified
+        by any thread.  The copies are built on the first calculation
+        and reused afterwards.
+
+        In each worker, a scenario is applied by moving each quote to
+        its value in the scenario, i.e., its base value plus the
+        shifts of the scenario.  The quotes that already have that
+        value (e.g., quotes not shifted by either the previous or the
+        current scenario) are not modified.  Also, lazy objects
+        forward only the first of the notifications raised by the
+        shifted quotes.  Each term structure depending on the shifted
+        quotes is therefore recalculated once per scenario,
+        regardless of the number of quotes shifted.  Instruments not
+        affected by a scenario are not repriced.  The scenarios are
+        distributed dynamically among the workers if OpenMP is
+        enabled, and evaluated sequentially otherwise.
+
+        \warning Objects lazily updated during pricing and shared
+                 among the copies (e.g., index fixings looked up for
+                 the first time) must be prepared beforehand.  The
+                 shifts are additive; quotes are restored to their
+                 base values after the calculation.
+
+        \ingroup instruments
+    */
+    class ScenarioRunner {
+      public:
+        //! a copy of the market
+        struct Market {
+            std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+            std::vector<boost::shared_ptr<Instrument> > instruments;
+        };
+        typedef boost::function<Market()> MarketFactory;
+        //! shifts of some of the quotes, as (quote index, shift) pairs
+        /*! Shifts of the same quote are added together. */
+        typedef std::vector<std::pair<Size, Real> > Scenario;
+
+        /*! By default, a worker is used for each thread available to
+            OpenMP.
+        */
+        explicit ScenarioRunner(const MarketFactory& factory,
+                                Size workers = Null<Size>());
+
+        //! P&L of each instrument (column) in each scenario (row)
+        /*! The P&L of an instrument whose pricing failed in a given
+            scenario is set to Null<Real>; the error can be retrieved
+            with the error() method.
+        */
+        Matrix calculate(const std::vector<Scenario>& scenarios);
+
+        //! \name Inspectors
+        //@{
+        Size workers() const { return workers_; }
+        //! NPVs of the instruments in the base scenario
+        /*! They are available after a calculation. */
+        const std::vector<Real>& baseNPVs() const { return baseNPVs_; }
+        //! first error raised in the given scenario, if any
+        const std::string& error(Size scenario) const;
+        //@}
+
+        //! \name Scenario generation
+        //@{
+        //! scenarios shifting one of the quotes each
+        static std::vector<Scenario> bucketScenarios(Size quotes,
+                                                     Real shift);
+        //! scenario shifting all the quotes together
+        static Scenario parallelScenario(Size quotes, Real shift);
+        //@}
+      private:
+        void buildMarkets();
+        void applyScenario(Size worker, const std::vector<Real>& values);
+        MarketFactory factory_;
+        Size workers_;
+        std::vector<boost::shared_ptr<ValuationContext> > contexts_;
+        std::vector<Market> markets_;
+        std::vector<Real> baseValues_, baseNPVs_;
+        std::vector<std::string> errors_;
+    };
+
+}
+
+#endif
@@ -37,9 +37,11 @@ QuantLib::Real secondElement(const std::pair< QuantLib::Date, QuantLib::Real > &
 namespace QuantLib {
 
 //! Multi curve sensitivities
-/*! This class provides a simple (yet most likely not the fastest) way to create sensitivities
-  to the <em>par quotes</em>, provided in the piecewiseyieldcurve for stripping. If constructed with more
-than one curve, the class iterates over all quotes of the provided curves and shifts each quote of all provided curves
+/*! This class provides sensitivities to the <em>par quotes</em>, provided in the piecewiseyieldcurve for stripping.
+  The curves are bootstrapped once; by the implicit function theorem, the sensitivities are then obtained by
+inverting the Jacobian of the quotes implied by the helpers with respect to the curve nodes.  If constructed with
+a single curve, the Jacobian is provided by its bootstrapper (see IterativeBootstrap::pillarSensitivities).  If
+constructed with more than one curve, the nodes of each curve are shifted in turn and all helpers are repriced,
 taking interdependence into account.
 
 The class computes the sensitvities as a QuantLib Matrix class in the form:
@@ -104,26 +106,51 @@ private:
 };
 
 inline void MultiCurveSensitivities::performCalculations() const {
-  std::vector< Rate > sensiVector;
+  typedef PiecewiseYieldCurve< ZeroYield, Linear > curve_type;
   origZeros_ = allZeros();
-  for (std::vector< Handle< Quote > >::const_iterator it = allQuotes_.begin(); it != allQuotes_.end(); ++it) {
-    Rate bps = +1e-4;
-    Rate origQuote = (*it)->value();
-    boost::shared_ptr< SimpleQuote > q = boost::dynamic_pointer_cast< SimpleQuote >((*it).currentLink());
-    q->setValue(origQuote + bps);
-    try {
-      std::vector< Rate > tmp(allZeros());
-      for (Size i = 0; i < tmp.size(); ++i)
-        sensiVector.push_back((tmp[i] - origZeros_[i]) / bps);
-      q->setValue(origQuote);
-    } catch (...) {
-      q->setValue(origQuote);
-      QL_FAIL("Application of shift to quote led to exception.");
+  Size n = origZeros_.size();
+  QL_REQUIRE(n == allQuotes_.size(),
+             "expired instruments are not supported: " << allQuotes_.size() << " quotes provided, " << n
+                                                        << " nodes bootstrapped");
+
+  // sensi_[j][i] is the derivative of the i-th zero with respect to the j-th quote
+  if (curves_.size() == 1) {
+    boost::shared_ptr< curve_type > curve =
+        boost::dynamic_pointer_cast< curve_type >(curves_.begin()->second.currentLink());
+    sensi_ = transpose(curve->bootstrap_.pillarSensitivities());
+    invSensi_ = inverse(sensi_);
+    return;
+  }
+
+  // jacobian[i][k] is the derivative of the i-th implied quote with respect to the k-th zero
+  std::vector< boost::shared_ptr< BootstrapHelper< YieldTermStructure > > > helpers;
+  for (curvespec::const_iterator it = curves_.begin(); it != curves_.end(); ++it) {
+    boost::shared_ptr< curve_type > curve = boost::dynamic_pointer_cast< curve_type >(it->second.currentLink());
+    helpers.insert(helpers.end(), curve->instruments_.begin(), curve->instruments_.end());
+  }
+  const Real h = 1.0e-5;
+  Matrix jacobian(n, n);
+  Size k = 0;
+  for (curvespec::const_iterator it = curves_.begin(); it != curves_.end(); ++it) {
+    boost::shared_ptr< curve_type > curve = boost::dynamic_pointer_cast< curve_type >(it->second.currentLink());
+    std::vector< Real >& data = curve->data_;
+    for (Size j = 1; j < data.size(); ++j, ++k) {
+      const Real z = data[j], z0 = data[0];
+      curve_type::traits_type::updateGuess(data, z + h, j);
+      curve->interpolation_.update();
+      for (Size i = 0; i < n; ++i)
+        jacobian[i][k] = helpers[i]->impliedQuote();
+      curve_type::traits_type::updateGuess(data, z - h, j);
+      curve->interpolation_.update();
+      for (Size i = 0; i < n; ++i)
+        jacobian[i][k] = (jacobian[i][k] - helpers[i]->impliedQuote()) / (2.0 * h);
+      data[j] = z;
+      data[0] = z0;
+      curve->interpolation_.update();
     }
   }
-  Matrix result(origZeros_.size(), origZeros_.size(), sensiVector.begin(), sensiVector.end());
-  sensi_ = result;
-  invSensi_ = inverse(sensi_);
+  invSensi_ = transpose(jacobian);
+  sensi_ = inverse(invSensi_);
 }
 
 inline Matrix MultiCurveSensitivities::sensitivities() const {
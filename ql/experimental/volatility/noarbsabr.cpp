@@ -29,6 +29,8 @@
 #include <boost/assign/std/vector.hpp>
 #include <boost/functional/hash.hpp>
 
+#include <map>
+
 namespace QuantLib {
 
 class NoArbSabrModel::integrand {
@@ -42,6 +44,29 @@ class NoArbSabrModel::integrand {
     }
 };
 
+// density evaluations are stored by abscissa, so that the integrals
+// over a segment share the nodes evaluated by both of them
+class NoArbSabrModel::memoizedDensity {
+    const NoArbSabrModel* model;
+    std::map<Real, Real>* values;
+    Real strike;
+  public:
+    memoizedDensity(const NoArbSabrModel* model,
+                    std::map<Real, Real>* values, Real strike = Null<Real>())
+    : model(model), values(values), strike(strike) {}
+    Real operator()(Real f) const {
+        std::map<Real, Real>::const_iterator i = values->find(f);
+        Real v;
+        if (i != values->end()) {
+            v = i->second;
+        } else {
+            v = model->p(f);
+            values->insert(std::make_pair(f, v));
+        }
+        return strike == Null<Real>() ? v : std::max(f - strike, 0.0) * v;
+    }
+};
+
 NoArbSabrModel::NoArbSabrModel(const Real expiryTime, const Real forward,
                                const Real alpha, const Real beta, const Real nu,
                                const Real rho)
@@ -118,6 +143,43 @@ Real NoArbSabrModel::optionPrice(const Real strike) const {
             numericalIntegralOverP_);
 }
 
+std::vector<Real>
+NoArbSabrModel::optionPrices(const std::vector<Real>& strikes) const {
+    Size n = strikes.size();
+    std::vector<Real> result(n, 0.0);
+    if (n == 0)
+        return result;
+
+    std::vector<std::pair<Real, Size> > sorted(n);
+    for (Size i = 0; i < n; ++i)
+        sorted[i] = std::make_pair(strikes[i], i);
+    std::sort(sorted.begin(), sorted.end());
+    Real upper = std::max(fmax_, 2.0 * sorted.back().first);
+
+    // going down from the highest strike, tail0 is the integral of
+    // the density from the current strike to the upper bound and
+    // tail1 is the undiscounted call price times the normalization
+    std::map<Real, Real> values;
+    Real tail0 = 0.0, tail1 = 0.0, right = upper;
+    for (Size i = n; i > 0; --i) {
+        Real strike = sorted[i-1].first;
+        if (strike < right) {
+            Real seg0 = (*integrator_)(memoizedDensity(this, &values),
+                                       strike, right);
+            Real seg1 = (*integrator_)(memoizedDensity(this, &values, strike),
+                                       strike, right);
+            tail1 += (right - strike) * tail0 + seg1;
+            tail0 += seg0;
+            right = strike;
+        }
+        if (p(std::max(forward_, strike)) >=
+            detail::NoArbSabrModel::density_threshold)
+            result[sorted[i-1].second] =
+                (1.0 - absProb_) * (tail1 / numericalIntegralOverP_);
+    }
+    return result;
+}
+
 Real NoArbSabrModel::digitalOptionPrice(const Real strike) const {
     if (strike < QL_MIN_POSITIVE_REAL)
         return 1.0;
@@ -106,6 +106,18 @@ class NoArbSabrModel {
               const Real beta, const Real nu, const Real rho);
 
     Real optionPrice(const Real strike) const;
+    /*! Call prices at several strikes.  The density is integrated
+        once over the segments between consecutive strikes and the
+        results are accumulated from the highest strike down, so
+        that each density evaluation is shared among all
+        strikes.
+
+        \note The integration is carried up to twice the highest
+              strike for all strikes, while optionPrice() stops at
+              twice the given strike; the results can therefore
+              differ slightly at high strikes.
+    */
+    std::vector<Real> optionPrices(const std::vector<Real>& strikes) const;
     Real digitalOptionPrice(const Real strike) const;
     Real density(const Real strike) const {
         return p(strike) * (1 - absProb_) / numericalIntegralOverP_;
@@ -132,6 +144,8 @@ class NoArbSabrModel {
     boost::shared_ptr<GaussLobattoIntegral> integrator_;
     class integrand;
     friend class integrand;
+    class memoizedDensity;
+    friend class memoizedDensity;
 };
 
 namespace detail {
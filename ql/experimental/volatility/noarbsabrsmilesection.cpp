@@ -72,17 +72,34 @@ Real NoArbSabrSmileSection::density(Rate strike, Real discount, Real) const {
 }
 
 Real NoArbSabrSmileSection::volatilityImpl(Rate strike) const {
+    return impliedVolatility(strike, model_->optionPrice(strike));
+}
+
+std::vector<Volatility>
+NoArbSabrSmileSection::volatilities(const std::vector<Rate> &strikes) const {
+    std::vector<Real> calls = model_->optionPrices(strikes);
+    std::vector<Volatility> result(strikes.size());
+    for (Size i = 0; i < strikes.size(); ++i)
+        result[i] = impliedVolatility(strikes[i], calls[i]);
+    return result;
+}
+
+Volatility NoArbSabrSmileSection::impliedVolatility(Rate strike,
+                                                    Real call) const {
 
     Real impliedVol = 0.0;
     try {
         Option::Type type;
-        if (strike >= forward_)
+        Real price;
+        if (strike >= forward_) {
             type = Option::Call;
-        else
+            price = call;
+        } else {
             type = Option::Put;
+            price = call - (forward_ - strike);
+        }
         impliedVol =
-            blackFormulaImpliedStdDev(type, strike, forward_,
-                                      optionPrice(strike, type, 1.0), 1.0) /
+            blackFormulaImpliedStdDev(type, strike, forward_, price, 1.0) /
             std::sqrt(exerciseTime());
     } catch (...) {
     }
@@ -49,6 +49,8 @@ class NoArbSabrSmileSection : public SmileSection {
     Real digitalOptionPrice(Rate strike, Option::Type type = Option::Call,
                             Real discount = 1.0, Real gap = 1.0e-5) const;
     Real density(Rate strike, Real discount = 1.0, Real gap = 1.0E-4) const;
+    //! volatilities at the given strikes, sharing the density integration
+    std::vector<Volatility> volatilities(const std::vector<Rate>& strikes) const;
 
     boost::shared_ptr<NoArbSabrModel> model() { return model_; }
 
@@ -57,6 +59,7 @@ class NoArbSabrSmileSection : public SmileSection {
 
   private:
     void init();
+    Volatility impliedVolatility(Rate strike, Real call) const;
     boost::shared_ptr<NoArbSabrModel> model_;
     Rate forward_;
     std::vector<Real> params_;
@@ -91,20 +91,26 @@ namespace QuantLib {
                         ValueIterator vBegin,
                         bool forceOverwrite = false) {
             checkNativeFixingsAllowed();
-            std::string tag = name();
-            TimeSeries<Real> h = IndexManager::instance().getHistory(tag);
+            IndexManager& manager = IndexManager::instance();
+            Size id = manager.historyId(name());
+            // new fixings; they're stored together at the end
+            TimeSeries<Real> added;
+            const TimeSeries<Real>& current = added;
             bool noInvalidFixing = true, noDuplicatedFixing = true;
             Date invalidDate, duplicatedDate;
             Real nullValue = Null<Real>();
             Real invalidValue = Null<Real>();
             Real duplicatedValue = Null<Real>();
+            Real presentValue = Null<Real>();
             while (dBegin != dEnd) {
                 bool validFixing = isValidFixingDate(*dBegin);
-                Real currentValue = h[*dBegin];
+                Real currentValue = current[*dBegin];
+                if (currentValue == nullValue)
+                    currentValue = manager.fixing(id, *dBegin);
                 bool missingFixing = forceOverwrite || currentValue == nullValue;
                 if (validFixing) {
                     if (missingFixing)
-                        h[*(dBegin++)] = *(vBegin++);
+                        added[*(dBegin++)] = *(vBegin++);
                     else if (close(currentValue,*(vBegin))) {
                         ++dBegin;
                         ++vBegin;
@@ -112,6 +118,7 @@ namespace QuantLib {
                         noDuplicatedFixing = false;
                         duplicatedDate = *(dBegin++);
                         duplicatedValue = *(vBegin++);
+                        presentValue = currentValue;
                     }
                 } else {
                     noInvalidFixing = false;
@@ -119,7 +126,7 @@ namespace QuantLib {
                     invalidValue = *(vBegin++);
                 }
             }
-            IndexManager::instance().setHistory(tag, h);
+            manager.addFixings(id, added);
             QL_REQUIRE(noInvalidFixing,
                        "At least one invalid fixing provided: " <<
                        invalidDate.weekday() << " " << invalidDate <<
@@ -127,7 +134,7 @@ namespace QuantLib {
             QL_REQUIRE(noDuplicatedFixing,
                        "At least one duplicated fixing provided: " <<
                        duplicatedDate << ", " << duplicatedValue <<
-                       " while " << h[duplicatedDate] <<
+                       " while " << presentValue <<
                        " value is already present");
         }
         //! clears all stored historical fixings
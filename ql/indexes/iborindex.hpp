@@ -83,6 +83,7 @@ namespace QuantLib {
                             const Date& endDate,
                             Time t) const;
         friend class IborCoupon;
+        friend class CompactLeg;
     };
 
 
@@ -27,45 +27,241 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <boost/cstdint.hpp>
+#include <istream>
+#include <ostream>
+#include <cstring>
+
 using boost::algorithm::to_upper_copy;
 using std::string;
 
 namespace QuantLib {
 
+    namespace {
+
+        const char magic[4] = { 'Q', 'L', 'F', 'X' };
+        const boost::uint32_t version = 1;
+
+        template <class T>
+        void write(std::ostream& out, const T& x) {
+            out.write(reinterpret_cast<const char*>(&x), sizeof(T));
+        }
+
+        template <class T>
+        void read(std::istream& in, T& x) {
+            in.read(reinterpret_cast<char*>(&x), sizeof(T));
+            QL_REQUIRE(in, "unexpected end of fixing data");
+        }
+
+    }
+
+    IndexManager::History& IndexManager::history(const string& name) const {
+        string tag = to_upper_copy(name);
+        std::map<string, Size>::const_iterator i = ids_.find(tag);
+        if (i != ids_.end()) {
+            History& h = histories_[i->second];
+            h.listed = true;
+            return h;
+        }
+        ids_[tag] = histories_.size();
+        names_.push_back(tag);
+        histories_.push_back(History());
+        return histories_.back();
+    }
+
+    void IndexManager::store(History& h, const Date& d, Real value) {
+        Date::serial_type serial = d.serialNumber();
+        if (h.values.empty()) {
+            h.firstSerial = serial;
+            h.values.push_back(Null<Real>());
+        } else if (serial < h.firstSerial) {
+            h.values.insert(h.values.begin(), h.firstSerial - serial,
+                            Null<Real>());
+            h.firstSerial = serial;
+        } else if (serial - h.firstSerial >=
+                   static_cast<Date::serial_type>(h.values.size())) {
+            h.values.resize(serial - h.firstSerial + 1, Null<Real>());
+        }
+        h.values[serial - h.firstSerial] = value;
+        if (h.series)
+            (*h.series)[d] = value;
+    }
+
+    void IndexManager::rebuildSeries(History& h) {
+        *h.series = TimeSeries<Real>();
+        for (Size i=0; i<h.values.size(); ++i) {
+            if (h.values[i] != Null<Real>())
+                (*h.series)[Date(h.firstSerial + i)] = h.values[i];
+        }
+    }
+
+    void IndexManager::clear(History& h) {
+        h.values.clear();
+        h.firstSerial = 0;
+        if (h.series)
+            *h.series = TimeSeries<Real>();
+    }
+
     bool IndexManager::hasHistory(const string& name) const {
-        return data_.find(to_upper_copy(name)) != data_.end();
+        std::map<string, Size>::const_iterator i =
+            ids_.find(to_upper_copy(name));
+        return i != ids_.end() && histories_[i->second].listed;
     }
 
     const TimeSeries<Real>&
     IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        History& h = history(name);
+        if (!h.series) {
+            h.series = boost::shared_ptr<TimeSeries<Real> >(
+                                                        new TimeSeries<Real>);
+            rebuildSeries(h);
+        }
+        return *h.series;
     }
 
     void IndexManager::setHistory(const string& name,
                                   const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+        History& h = this->history(name);
+        clear(h);
+        for (TimeSeries<Real>::const_iterator i = history.begin();
+             i != history.end(); ++i) {
+            if (i->second != Null<Real>())
+                store(h, i->first, i->second);
+        }
+        h.notifier->notifyObservers();
     }
 
     boost::shared_ptr<Observable>
     IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+        return history(name).notifier;
     }
 
     std::vector<string> IndexManager::histories() const {
         std::vector<string> temp;
-        temp.reserve(data_.size());
-        for (history_map::const_iterator i=data_.begin();
-             i!=data_.end(); ++i)
-            temp.push_back(i->first);
+        temp.reserve(histories_.size());
+        for (Size i=0; i<histories_.size(); ++i)
+            if (histories_[i].listed)
+                temp.push_back(names_[i]);
         return temp;
     }
 
     void IndexManager::clearHistory(const string& name) {
-        data_.erase(to_upper_copy(name));
+        std::map<string, Size>::const_iterator i =
+            ids_.find(to_upper_copy(name));
+        if (i != ids_.end()) {
+            History& h = histories_[i->second];
+            clear(h);
+            h.listed = false;
+            h.notifier->notifyObservers();
+        }
     }
 
     void IndexManager::clearHistories() {
-        data_.clear();
+        for (Size i=0; i<histories_.size(); ++i) {
+            History& h = histories_[i];
+            clear(h);
+            h.listed = false;
+            h.notifier->notifyObservers();
+        }
+    }
+
+    Size IndexManager::historyId(const string& name) const {
+        return &history(name) - &histories_[0];
+    }
+
+    Real IndexManager::fixing(Size historyId, const Date& d) const {
+        QL_REQUIRE(historyId < histories_.size(),
+                   "invalid history id (" << historyId << ")");
+        const History& h = histories_[historyId];
+        Date::serial_type offset = d.serialNumber() - h.firstSerial;
+        if (offset < 0 ||
+            offset >= static_cast<Date::serial_type>(h.values.size()))
+            return Null<Real>();
+        return h.values[offset];
+    }
+
+    void IndexManager::addFixings(Size historyId,
+                                  const TimeSeries<Real>& fixings) {
+        QL_REQUIRE(historyId < histories_.size(),
+                   "invalid history id (" << historyId << ")");
+        History& h = histories_[historyId];
+        h.listed = true;
+        for (TimeSeries<Real>::const_iterator i = fixings.begin();
+             i != fixings.end(); ++i)
+            store(h, i->first, i->second);
+        h.notifier->notifyObservers();
+    }
+
+    void IndexManager::save(std::ostream& out) const {
+        std::vector<Size> stored;
+        for (Size i=0; i<histories_.size(); ++i)
+            if (histories_[i].listed)
+                stored.push_back(i);
+
+        out.write(magic, sizeof(magic));
+        write(out, version);
+        write(out, boost::uint32_t(sizeof(Real)));
+        write(out, boost::uint64_t(stored.size()));
+        for (Size k=0; k<stored.size(); ++k) {
+            const History& h = histories_[stored[k]];
+            const string& name = names_[stored[k]];
+            write(out, boost::uint64_t(name.size()));
+            out.write(name.data(), name.size());
+            write(out, boost::int64_t(h.firstSerial));
+            write(out, boost::uint64_t(h.values.size()));
+            if (!h.values.empty())
+                out.write(reinterpret_cast<const char*>(&h.values[0]),
+                          h.values.size()*sizeof(Real));
+        }
+        QL_REQUIRE(out, "error while writing fixing data");
+    }
+
+    void IndexManager::load(std::istream& in) {
+        char header[sizeof(magic)];
+        in.read(header, sizeof(header));
+        QL_REQUIRE(in && std::memcmp(header, magic, sizeof(magic)) == 0,
+                   "invalid fixing data");
+        boost::uint32_t fileVersion, realSize;
+        read(in, fileVersion);
+        QL_REQUIRE(fileVersion == version,
+                   "unsupported fixing data version (" << fileVersion << ")");
+        read(in, realSize);
+        QL_REQUIRE(realSize == sizeof(Real),
+                   "fixing data stored with a different Real type");
+        boost::uint64_t count;
+        read(in, count);
+
+        // read everything first, so that a failure leaves us unchanged
+        std::vector<string> names(count);
+        std::vector<History> loaded(count);
+        for (Size k=0; k<count; ++k) {
+            boost::uint64_t length, size;
+            boost::int64_t firstSerial;
+            read(in, length);
+            names[k].resize(length);
+            if (length > 0) {
+                in.read(&names[k][0], length);
+                QL_REQUIRE(in, "unexpected end of fixing data");
+            }
+            read(in, firstSerial);
+            read(in, size);
+            loaded[k].firstSerial = firstSerial;
+            loaded[k].values.resize(size);
+            if (size > 0) {
+                in.read(reinterpret_cast<char*>(&loaded[k].values[0]),
+                        size*sizeof(Real));
+                QL_REQUIRE(in, "unexpected end of fixing data");
+            }
+        }
+
+        for (Size k=0; k<count; ++k) {
+            History& h = history(names[k]);
+            h.firstSerial = loaded[k].firstSerial;
+            h.values.swap(loaded[k].values);
+            if (h.series)
+                rebuildSeries(h);
+            h.notifier->notifyObservers();
+        }
     }
 
 }
@@ -26,13 +26,24 @@
 
 #include <ql/timeseries.hpp>
 #include <ql/patterns/singleton.hpp>
-#include <ql/utilities/observablevalue.hpp>
+#include <ql/patterns/observable.hpp>
+#include <iosfwd>
+#include <map>
+#include <vector>
 
 
 namespace QuantLib {
 
     //! global repository for past index fixings
-    /*! \note index names are case insensitive */
+    /*! The fixings of each index are stored in a dense array indexed
+        by the offset of their date from the earliest stored fixing;
+        missing fixings are stored as Null<Real>().  Lookups through
+        a history id don't involve any search.  A TimeSeries copy of
+        a history is only built when requested through getHistory,
+        and it's kept in sync with later changes.
+
+        \note index names are case insensitive
+    */
     class IndexManager : public Singleton<IndexManager> {
         friend class Singleton<IndexManager>;
       private:
@@ -52,10 +63,52 @@ namespace QuantLib {
         void clearHistory(const std::string& name);
         //! clears all stored fixings
         void clearHistories();
+        //! \name Fast access
+        //@{
+        //! returns the id of the history of the index
+        /*! The id of a given index never changes, even if its
+            history is cleared; it can be stored for later lookups.
+        */
+        Size historyId(const std::string& name) const;
+        //! returns the fixing stored at the given date, or null
+        Real fixing(Size historyId, const Date& d) const;
+        /*! stores the given fixings, overwriting any value already
+            present at the same dates, and notifies the observers
+        */
+        void addFixings(Size historyId, const TimeSeries<Real>& fixings);
+        //@}
+        //! \name Bulk storage
+        /*! The histories are written and read in a binary format,
+            each as a single block of values; the format is
+            platform-dependent.
+        */
+        //@{
+        //! writes all stored histories to the stream
+        void save(std::ostream& out) const;
+        /*! reads histories from the stream, replacing those of the
+            indexes with the same names, and notifies the observers
+        */
+        void load(std::istream& in);
+        //@}
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > >
-                                                                  history_map;
-        mutable history_map data_;
+        struct History {
+            History() : listed(true), firstSerial(0),
+                        notifier(new Observable) {}
+            bool listed;
+            // serial number of the date of values[0]
+            Date::serial_type firstSerial;
+            std::vector<Real> values;
+            boost::shared_ptr<Observable> notifier;
+            // built only if requested
+            boost::shared_ptr<TimeSeries<Real> > series;
+        };
+        History& history(const std::string& name) const;
+        static void store(History&, const Date&, Real);
+        static void rebuildSeries(History&);
+        static void clear(History&);
+        mutable std::map<std::string, Size> ids_;
+        mutable std::vector<History> histories_;
+        mutable std::vector<std::string> names_;
     };
 
 }
@@ -179,6 +179,44 @@ namespace QuantLib {
     }
 
 
+    std::vector<Rate> ZeroInflationIndex::fixings(
+                              const std::vector<Date>& fixingDates) const {
+        std::vector<Rate> results(fixingDates.size());
+        std::vector<Size> forecasted;
+        std::vector<Date> forecastDates;
+        for (Size i=0; i<fixingDates.size(); ++i) {
+            if (needsForecast(fixingDates[i])) {
+                forecasted.push_back(i);
+                forecastDates.push_back(fixingDates[i]);
+            } else {
+                results[i] = fixing(fixingDates[i]);
+            }
+        }
+        if (forecastDates.empty())
+            return results;
+
+        // same as forecastFixing, with the base fixing and the zero
+        // rates retrieved once for all the dates
+        Date baseDate = zeroInflation_->baseDate();
+        QL_REQUIRE(!needsForecast(baseDate),
+                   name() << " index fixing at base date is not available");
+        Real baseFixing = fixing(baseDate);
+        DayCounter dc = zeroInflation_->dayCounter();
+        bool forceLinearInterpolation = false;
+        std::vector<Rate> zeros =
+            zeroInflation_->zeroRates(forecastDates, Period(0,Days),
+                                      forceLinearInterpolation);
+        for (Size j=0; j<forecastDates.size(); ++j) {
+            Date effectiveFixingDate = interpolated() ?
+                forecastDates[j] :
+                inflationPeriod(forecastDates[j], frequency()).first;
+            Time t = dc.yearFraction(baseDate, effectiveFixingDate);
+            results[forecasted[j]] = baseFixing * std::pow(1.0 + zeros[j], t);
+        }
+        return results;
+    }
+
+
     boost::shared_ptr<ZeroInflationIndex> ZeroInflationIndex::clone(
                           const Handle<ZeroInflationTermStructure>& h) const {
         return boost::shared_ptr<ZeroInflationIndex>(
@@ -157,6 +157,13 @@ namespace QuantLib {
         //@}
         //! \name Other methods
         //@{
+        //! fixings at the given dates
+        /*! The results are the same as those of fixing() for each
+            date; the forecast fixings are calculated together, so
+            that the base fixing and the seasonality factors are
+            retrieved only once.
+        */
+        std::vector<Rate> fixings(const std::vector<Date>& fixingDates) const;
         Handle<ZeroInflationTermStructure> zeroInflationTermStructure() const;
         boost::shared_ptr<ZeroInflationIndex> clone(
                            const Handle<ZeroInflationTermStructure>& h) const;
@@ -34,7 +34,7 @@ namespace QuantLib {
                                          const DayCounter& dayCounter)
     : familyName_(familyName), tenor_(tenor), fixingDays_(fixingDays),
       currency_(currency), dayCounter_(dayCounter),
-      fixingCalendar_(fixingCalendar) {
+      fixingCalendar_(fixingCalendar), historyId_(Null<Size>()) {
         tenor_.normalize();
 
         std::ostringstream out;
@@ -91,6 +91,9 @@ namespace QuantLib {
         std::string name_;
       private:
         Calendar fixingCalendar_;
+        // looked up upon first use, since derived classes might
+        // change the name in their constructors
+        mutable Size historyId_;
     };
 
 
@@ -127,7 +130,10 @@ namespace QuantLib {
     inline Rate InterestRateIndex::pastFixing(const Date& fixingDate) const {
         QL_REQUIRE(isValidFixingDate(fixingDate),
                    fixingDate << " is not a valid fixing date");
-        return timeSeries()[fixingDate];
+        IndexManager& manager = IndexManager::instance();
+        if (historyId_ == Null<Size>())
+            historyId_ = manager.historyId(name());
+        return manager.fixing(historyId_, fixingDate);
     }
 
 }
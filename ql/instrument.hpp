@@ -165,7 +165,11 @@ namespace QuantLib {
         engine_->reset();
         setupArguments(engine_->getArguments());
         engine_->getArguments()->validate();
-        engine_->calculate();
+        {
+            QL_INSTRUMENT_OBJECT_SCOPE("PricingEngine::calculate",
+                                       engine_.get());
+            engine_->calculate();
+        }
         fetchResults(engine_->getResults());
     }
 
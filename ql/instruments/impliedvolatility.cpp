@@ -67,7 +67,8 @@ namespace QuantLib {
                                                  Real accuracy,
                                                  Natural maxEvaluations,
                                                  Volatility minVol,
-                                                 Volatility maxVol) {
+                                                 Volatility maxVol,
+                                                 Volatility guess) {
 
             instrument.setupArguments(engine.getArguments());
             engine.getArguments()->validate();
@@ -75,10 +76,17 @@ namespace QuantLib {
             PriceError f(engine, volQuote, targetValue);
             Brent solver;
             solver.setMaxEvaluations(maxEvaluations);
-            Volatility guess = (minVol+maxVol)/2.0;
-            Volatility result = solver.solve(f, accuracy, guess,
-                                             minVol, maxVol);
-            return result;
+            if (guess != Null<Volatility>() && guess > minVol
+                                            && guess < maxVol) {
+                // the root is expected to be close to the guess
+                solver.setLowerBound(minVol);
+                solver.setUpperBound(maxVol);
+                Real step = std::max(0.05*guess, accuracy);
+                return solver.solve(f, accuracy, guess, step);
+            } else {
+                guess = (minVol+maxVol)/2.0;
+                return solver.solve(f, accuracy, guess, minVol, maxVol);
+            }
         }
 
         boost::shared_ptr<GeneralizedBlackScholesProcess>
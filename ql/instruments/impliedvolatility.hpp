@@ -27,6 +27,7 @@
 #include <ql/instrument.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/utilities/null.hpp>
 
 namespace QuantLib {
 
@@ -36,6 +37,11 @@ namespace QuantLib {
         /*! The passed engine must be linked to the passed quote (see,
              e.g., VanillaOption to see how this can be achieved.)
 
+             If a guess is passed (e.g., the implied volatility of a
+             neighboring option) the root is bracketed starting from
+             it instead of evaluating the instrument at the minimum
+             and maximum volatilities.
+
              \note this function is meant for developers of option
                    classes so that they can implement an
                    impliedVolatility() method.
@@ -49,7 +55,8 @@ namespace QuantLib {
                                         Real accuracy,
                                         Natural maxEvaluations,
                                         Volatility minVol,
-                                        Volatility maxVol);
+                                        Volatility maxVol,
+                                        Volatility guess = Null<Volatility>());
             // utilities
 
             /*! The returned process is equal to the passed one, except
@@ -25,7 +25,6 @@
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fdbermudanengine.hpp>
 #include <ql/exercise.hpp>
-#include <boost/scoped_ptr.hpp>
 
 namespace QuantLib {
 
@@ -35,6 +34,30 @@ namespace QuantLib {
     : OneAssetOption(payoff, exercise) {}
 
 
+    namespace {
+
+        // engines are built-in for the time being
+        boost::shared_ptr<PricingEngine> impliedVolatilityEngine(
+             Exercise::Type type,
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process) {
+            switch (type) {
+              case Exercise::European:
+                return boost::shared_ptr<PricingEngine>(
+                                       new AnalyticEuropeanEngine(process));
+              case Exercise::American:
+                return boost::shared_ptr<PricingEngine>(
+                             new FDAmericanEngine<CrankNicolson>(process));
+              case Exercise::Bermudan:
+                return boost::shared_ptr<PricingEngine>(
+                             new FDBermudanEngine<CrankNicolson>(process));
+              default:
+                QL_FAIL("unknown exercise type");
+            }
+        }
+
+    }
+
+
     Volatility VanillaOption::impliedVolatility(
              Real targetValue,
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
@@ -50,21 +73,8 @@ namespace QuantLib {
         boost::shared_ptr<GeneralizedBlackScholesProcess> newProcess =
             detail::ImpliedVolatilityHelper::clone(process, volQuote);
 
-        // engines are built-in for the time being
-        boost::scoped_ptr<PricingEngine> engine;
-        switch (exercise_->type()) {
-          case Exercise::European:
-            engine.reset(new AnalyticEuropeanEngine(newProcess));
-            break;
-          case Exercise::American:
-            engine.reset(new FDAmericanEngine<CrankNicolson>(newProcess));
-            break;
-          case Exercise::Bermudan:
-            engine.reset(new FDBermudanEngine<CrankNicolson>(newProcess));
-            break;
-          default:
-            QL_FAIL("unknown exercise type");
-        }
+        boost::shared_ptr<PricingEngine> engine =
+            impliedVolatilityEngine(exercise_->type(), newProcess);
 
         return detail::ImpliedVolatilityHelper::calculate(*this,
                                                           *engine,
@@ -75,5 +85,74 @@ namespace QuantLib {
                                                           minVol, maxVol);
     }
 
+
+    VanillaImpliedVolatilitySolver::VanillaImpliedVolatilitySolver(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Real accuracy,
+             Size maxEvaluations,
+             Volatility minVol,
+             Volatility maxVol)
+    : process_(process), accuracy_(accuracy),
+      maxEvaluations_(maxEvaluations), minVol_(minVol), maxVol_(maxVol),
+      volQuote_(new SimpleQuote), lastResult_(Null<Volatility>()) {
+        QL_REQUIRE(process_, "null process given");
+        QL_REQUIRE(minVol_ < maxVol_,
+                   "invalid volatility range: [" << minVol_ << ", "
+                   << maxVol_ << "]");
+    }
+
+    void VanillaImpliedVolatilitySolver::setup() const {
+        Date referenceDate = process_->blackVolatility()->referenceDate();
+        if (newProcess_ && referenceDate == referenceDate_)
+            return;
+        // the flat volatility built by the helper is fixed at the
+        // current reference date, so everything is rebuilt
+        referenceDate_ = referenceDate;
+        newProcess_ = detail::ImpliedVolatilityHelper::clone(process_,
+                                                             volQuote_);
+        engines_.clear();
+        lastResult_ = Null<Volatility>();
+    }
+
+    Volatility VanillaImpliedVolatilitySolver::impliedVolatility(
+                          const boost::shared_ptr<VanillaOption>& option,
+                          Real price) const {
+        QL_REQUIRE(!option->isExpired(), "option expired");
+
+        setup();
+        Exercise::Type type = option->exercise()->type();
+        boost::shared_ptr<PricingEngine>& engine = engines_[type];
+        if (!engine)
+            engine = impliedVolatilityEngine(type, newProcess_);
+
+        lastResult_ =
+            detail::ImpliedVolatilityHelper::calculate(*option,
+                                                       *engine,
+                                                       *volQuote_,
+                                                       price,
+                                                       accuracy_,
+                                                       maxEvaluations_,
+                                                       minVol_, maxVol_,
+                                                       lastResult_);
+        return lastResult_;
+    }
+
+    std::vector<Volatility>
+    VanillaImpliedVolatilitySolver::impliedVolatilities(
+                const std::vector<boost::shared_ptr<VanillaOption> >& options,
+                const std::vector<Real>& prices) const {
+        QL_REQUIRE(options.size() == prices.size(),
+                   "wrong number of prices (" << prices.size()
+                   << ") for " << options.size() << " options");
+        std::vector<Volatility> results(options.size());
+        for (Size i=0; i<options.size(); ++i)
+            results[i] = impliedVolatility(options[i], prices[i]);
+        return results;
+    }
+
+    void VanillaImpliedVolatilitySolver::reset() const {
+        lastResult_ = Null<Volatility>();
+    }
+
 }
 
@@ -27,6 +27,9 @@
 
 #include <ql/instruments/oneassetoption.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/exercise.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -66,6 +69,55 @@ namespace QuantLib {
              Volatility maxVol = 4.0) const;
     };
 
+
+    //! Implied volatilities of several vanilla options
+    /*! This class returns the same implied volatilities as
+        VanillaOption::impliedVolatility, but it can be used for
+        several options (e.g., a chain of American options on the
+        same underlying) without rebuilding the volatility quote, the
+        process and the pricing engine for each of them.  Moreover,
+        each calculation starts from the result of the previous one,
+        so that the root is usually bracketed with a few evaluations
+        of the engine when options are passed in order of strike.
+
+        The process, the engines and the last result are kept until
+        the reference date of the volatility of the passed process
+        changes.
+
+        \warning the caveats listed for
+                 VanillaOption::impliedVolatility also apply here.
+    */
+    class VanillaImpliedVolatilitySolver {
+      public:
+        VanillaImpliedVolatilitySolver(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Real accuracy = 1.0e-4,
+             Size maxEvaluations = 100,
+             Volatility minVol = 1.0e-7,
+             Volatility maxVol = 4.0);
+        Volatility impliedVolatility(
+                                const boost::shared_ptr<VanillaOption>& option,
+                                Real price) const;
+        //! implied volatilities of the given options, in the same order
+        std::vector<Volatility> impliedVolatilities(
+                const std::vector<boost::shared_ptr<VanillaOption> >& options,
+                const std::vector<Real>& prices) const;
+        //! forgets the last result, so that the next calculation is cold
+        void reset() const;
+      private:
+        void setup() const;
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Real accuracy_;
+        Size maxEvaluations_;
+        Volatility minVol_, maxVol_;
+        boost::shared_ptr<SimpleQuote> volQuote_;
+        mutable Date referenceDate_;
+        mutable boost::shared_ptr<GeneralizedBlackScholesProcess> newProcess_;
+        mutable std::map<Exercise::Type,
+                         boost::shared_ptr<PricingEngine> > engines_;
+        mutable Volatility lastResult_;
+    };
+
 }
 
 
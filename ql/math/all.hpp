@@ -12,14 +12,20 @@
 #include <ql/math/errorfunction.hpp>
 #include <ql/math/factorial.hpp>
 #include <ql/math/fastfouriertransform.hpp>
+#include <ql/math/fastmath.hpp>
+#include <ql/math/fixedarray.hpp>
+#include <ql/math/fixedmatrix.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/hugepageallocator.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 #include <ql/math/kernelfunctions.hpp>
 #include <ql/math/incompletegamma.hpp>
 #include <ql/math/interpolation.hpp>
 #include <ql/math/lexicographicalview.hpp>
 #include <ql/math/linearleastsquaresregression.hpp>
 #include <ql/math/matrix.hpp>
+#include <ql/math/memorypool.hpp>
 #include <ql/math/modifiedbessel.hpp>
 #include <ql/math/pascaltriangle.hpp>
 #include <ql/math/polynomialmathfunction.hpp>
@@ -30,6 +30,7 @@
 #include <ql/errors.hpp>
 #include <ql/utilities/disposable.hpp>
 #include <ql/utilities/null.hpp>
+#include <ql/math/memorypool.hpp>
 #include <boost/iterator/reverse_iterator.hpp>
 #include <boost/scoped_array.hpp>
 #include <boost/type_traits.hpp>
@@ -40,15 +41,105 @@
 
 namespace QuantLib {
 
+    class Array;
+
+    namespace detail {
+
+        /* Array arithmetic is implemented by means of expression
+           templates: operators don't compute their result but return
+           a lightweight object describing it, which is evaluated
+           element by element in a single loop when assigned to an
+           array.  This class is the common base of such objects
+           (including Array itself) and gives access to the actual
+           expression type. */
+        template <class E>
+        class ArrayExpression {
+          public:
+            const E& self() const { return static_cast<const E&>(*this); }
+        };
+
+        // arrays are held by reference, sub-expressions by value
+        template <class E>
+        struct ArrayExpressionStorage {
+            typedef const E type;
+        };
+
+        template <>
+        struct ArrayExpressionStorage<Array> {
+            typedef const Array& type;
+        };
+
+        template <class E, class F>
+        class ArrayUnaryExpression
+            : public ArrayExpression<ArrayUnaryExpression<E,F> > {
+          public:
+            ArrayUnaryExpression(const E& e, const F& f) : e_(e), f_(f) {}
+            Size size() const { return e_.size(); }
+            Real operator[](Size i) const { return f_(e_[i]); }
+            operator Disposable<Array>() const;
+          private:
+            typename ArrayExpressionStorage<E>::type e_;
+            F f_;
+        };
+
+        template <class E1, class E2, class Op>
+        class ArrayBinaryExpression
+            : public ArrayExpression<ArrayBinaryExpression<E1,E2,Op> > {
+          public:
+            ArrayBinaryExpression(const E1& e1, const E2& e2)
+            : e1_(e1), e2_(e2) {}
+            Size size() const { return e1_.size(); }
+            Real operator[](Size i) const { return op_(e1_[i], e2_[i]); }
+            operator Disposable<Array>() const;
+          private:
+            typename ArrayExpressionStorage<E1>::type e1_;
+            typename ArrayExpressionStorage<E2>::type e2_;
+            Op op_;
+        };
+
+        // binary operations with a scalar operand
+
+        template <class Op>
+        class ScalarOnLeft {
+          public:
+            explicit ScalarOnLeft(Real x) : x_(x) {}
+            Real operator()(Real y) const { return op_(x_, y); }
+          private:
+            Real x_;
+            Op op_;
+        };
+
+        template <class Op>
+        class ScalarOnRight {
+          public:
+            explicit ScalarOnRight(Real y) : y_(y) {}
+            Real operator()(Real x) const { return op_(x, y_); }
+          private:
+            Real y_;
+            Op op_;
+        };
+
+        struct Unchanged {
+            Real operator()(Real x) const { return x; }
+        };
+
+    }
+
     //! 1-D array used in linear algebra.
     /*! This class implements the concept of vector as used in linear
         algebra.
         As such, it is <b>not</b> meant to be used as a container -
         <tt>std::vector</tt> should be used instead.
 
+        Algebraic operators return expression objects which are
+        evaluated in a single loop, without temporary arrays, when they
+        are assigned to an array or converted into one.  Expressions
+        keep references to their array operands and should not outlive
+        the statement in which they are created.
+
         \test construction of arrays is checked in a number of cases
     */
-    class Array {
+    class Array : public detail::ArrayExpression<Array> {
       public:
         //! \name Constructors, destructor, and assignment
         //@{
@@ -61,13 +152,31 @@ namespace QuantLib {
         */
         Array(Size size, Real value, Real increment);
         Array(const Array&);
+        #if defined(QL_USE_DISPOSABLE)
         Array(const Disposable<Array>&);
+        #else
+        Array(Array&&);
+        #endif
+        //! creates the array by evaluating an algebraic expression
+        template <class E>
+        Array(const detail::ArrayExpression<E>&);
         //! creates the array from an iterable sequence
         template <class ForwardIterator>
         Array(ForwardIterator begin, ForwardIterator end);
 
         Array& operator=(const Array&);
+        #if defined(QL_USE_DISPOSABLE)
         Array& operator=(const Disposable<Array>&);
+        #else
+        Array& operator=(Array&&);
+        #endif
+        /*! evaluates the expression in place if the sizes match.
+            Since each element of the result only depends on the
+            corresponding elements of the operands, the array can
+            appear in the expression itself.
+        */
+        template <class E>
+        Array& operator=(const detail::ArrayExpression<E>&);
         bool operator==(const Array&) const;
         bool operator!=(const Array&) const;
         //@}
@@ -91,6 +200,14 @@ namespace QuantLib {
         const Array& operator*=(Real);
         const Array& operator/=(const Array&);
         const Array& operator/=(Real);
+        template <class E>
+        const Array& operator+=(const detail::ArrayExpression<E>&);
+        template <class E>
+        const Array& operator-=(const detail::ArrayExpression<E>&);
+        template <class E>
+        const Array& operator*=(const detail::ArrayExpression<E>&);
+        template <class E>
+        const Array& operator/=(const detail::ArrayExpression<E>&);
         //@}
         //! \name Element access
         //@{
@@ -135,7 +252,7 @@ namespace QuantLib {
         //@}
 
       private:
-        boost::scoped_array<Real> data_;
+        detail::PooledBuffer data_;
         Size n_;
     };
 
@@ -157,47 +274,87 @@ namespace QuantLib {
 
     // unary operators
     /*! \relates Array */
-    const Disposable<Array> operator+(const Array& v);
+    template <class E>
+    const detail::ArrayUnaryExpression<E,detail::Unchanged>
+    operator+(const detail::ArrayExpression<E>&);
     /*! \relates Array */
-    const Disposable<Array> operator-(const Array& v);
+    template <class E>
+    const detail::ArrayUnaryExpression<E,std::negate<Real> >
+    operator-(const detail::ArrayExpression<E>&);
 
     // binary operators
     /*! \relates Array */
-    const Disposable<Array> operator+(const Array&, const Array&);
+    template <class E1, class E2>
+    const detail::ArrayBinaryExpression<E1,E2,std::plus<Real> >
+    operator+(const detail::ArrayExpression<E1>&,
+              const detail::ArrayExpression<E2>&);
     /*! \relates Array */
-    const Disposable<Array> operator+(const Array&, Real);
+    template <class E>
+    const detail::ArrayUnaryExpression<
+                              E,detail::ScalarOnRight<std::plus<Real> > >
+    operator+(const detail::ArrayExpression<E>&, Real);
     /*! \relates Array */
-    const Disposable<Array> operator+(Real, const Array&);
+    template <class E>
+    const detail::ArrayUnaryExpression<
+                              E,detail::ScalarOnLeft<std::plus<Real> > >
+    operator+(Real, const detail::ArrayExpression<E>&);
     /*! \relates Array */
-    const Disposable<Array> operator-(const Array&, const Array&);
+    template <class E1, class E2>
+    const detail::ArrayBinaryExpression<E1,E2,std::minus<Real> >
+    operator-(const detail::ArrayExpression<E1>&,
+              const detail::ArrayExpression<E2>&);
     /*! \relates Array */
-    const Disposable<Array> operator-(const Array&, Real);
+    template <class E>
+    const detail::ArrayUnaryExpression<
+                             E,detail::ScalarOnRight<std::minus<Real> > >
+    operator-(const detail::ArrayExpression<E>&, Real);
     /*! \relates Array */
-    const Disposable<Array> operator-(Real, const Array&);
+    template <class E>
+    const detail::ArrayUnaryExpression<
+                              E,detail::ScalarOnLeft<std::minus<Real> > >
+    operator-(Real, const detail::ArrayExpression<E>&);
     /*! \relates Array */
-    const Disposable<Array> operator*(const Array&, const Array&);
+    template <class E1, class E2>
+    const detail::ArrayBinaryExpression<E1,E2,std::multiplies<Real> >
+    operator*(const detail::ArrayExpression<E1>&,
+              const detail::ArrayExpression<E2>&);
     /*! \relates Array */
-    const Disposable<Array> operator*(const Array&, Real);
+    template <class E>
+    const detail::ArrayUnaryExpression<
+                        E,detail::ScalarOnRight<std::multiplies<Real> > >
+    operator*(const detail::ArrayExpression<E>&, Real);
     /*! \relates Array */
-    const Disposable<Array> operator*(Real, const Array&);
+    template <class E>
+    const detail::ArrayUnaryExpression<
+                         E,detail::ScalarOnLeft<std::multiplies<Real> > >
+    operator*(Real, const detail::ArrayExpression<E>&);
     /*! \relates Array */
-    const Disposable<Array> operator/(const Array&, const Array&);
+    template <class E1, class E2>
+    const detail::ArrayBinaryExpression<E1,E2,std::divides<Real> >
+    operator/(const detail::ArrayExpression<E1>&,
+              const detail::ArrayExpression<E2>&);
     /*! \relates Array */
-    const Disposable<Array> operator/(const Array&, Real);
+    template <class E>
+    const detail::ArrayUnaryExpression<
+                           E,detail::ScalarOnRight<std::divides<Real> > >
+    operator/(const detail::ArrayExpression<E>&, Real);
     /*! \relates Array */
-    const Disposable<Array> operator/(Real, const Array&);
+    template <class E>
+    const detail::ArrayUnaryExpression<
+                            E,detail::ScalarOnLeft<std::divides<Real> > >
+    operator/(Real, const detail::ArrayExpression<E>&);
 
     // math functions
     /*! \relates Array */
-    const Disposable<Array> Abs(const Array&);
+    Disposable<Array> Abs(const Array&);
     /*! \relates Array */
-    const Disposable<Array> Sqrt(const Array&);
+    Disposable<Array> Sqrt(const Array&);
     /*! \relates Array */
-    const Disposable<Array> Log(const Array&);
+    Disposable<Array> Log(const Array&);
     /*! \relates Array */
-    const Disposable<Array> Exp(const Array&);
+    Disposable<Array> Exp(const Array&);
     /*! \relates Array */
-    const Disposable<Array> Pow(const Array&, Real);
+    Disposable<Array> Pow(const Array&, Real);
 
     // utilities
     /*! \relates Array */
@@ -211,37 +368,53 @@ namespace QuantLib {
     // inline definitions
 
     inline Array::Array(Size size)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {}
+    : data_(size), n_(size) {}
 
     inline Array::Array(Size size, Real value)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : data_(size), n_(size) {
         std::fill(begin(),end(),value);
     }
 
     inline Array::Array(Size size, Real value, Real increment)
-    : data_(size ? new Real[size] : (Real*)(0)), n_(size) {
+    : data_(size), n_(size) {
         for (iterator i=begin(); i!=end(); ++i, value+=increment)
             *i = value;
     }
 
     inline Array::Array(const Array& from)
-    : data_(from.n_ ? new Real[from.n_] : (Real*)(0)), n_(from.n_) {
+    : data_(from.n_), n_(from.n_) {
         #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
         if (n_)
         #endif
         std::copy(from.begin(),from.end(),begin());
     }
 
+    #if defined(QL_USE_DISPOSABLE)
     inline Array::Array(const Disposable<Array>& from)
-    : data_((Real*)(0)), n_(0) {
+    : n_(0) {
         swap(const_cast<Disposable<Array>&>(from));
     }
+    #else
+    inline Array::Array(Array&& from)
+    : n_(0) {
+        swap(from);
+    }
+    #endif
+
+    template <class E>
+    inline Array::Array(const detail::ArrayExpression<E>& e)
+    : data_(e.self().size()), n_(e.self().size()) {
+        const E& expression = e.self();
+        iterator out = begin();
+        for (Size i=0; i<n_; ++i)
+            out[i] = expression[i];
+    }
 
     namespace detail {
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
+                                 detail::PooledBuffer& data_,
                                  Size& n_,
                                  I begin, I end,
                                  const boost::true_type&) {
@@ -251,20 +424,20 @@ namespace QuantLib {
             // Array with a given value, which we do here.
             Size n = begin;
             Real value = end;
-            data_.reset(n ? new Real[n] : (Real*)(0));
+            data_.reset(n);
             n_ = n;
             std::fill(a.begin(),a.end(),value);
         }
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 boost::scoped_array<Real>& data_,
+                                 detail::PooledBuffer& data_,
                                  Size& n_,
                                  I begin, I end,
                                  const boost::false_type&) {
             // true iterators
             Size n = std::distance(begin, end);
-            data_.reset(n ? new Real[n] : (Real*)(0));
+            data_.reset(n);
             n_ = n;
             #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
             if (n_)
@@ -297,10 +470,31 @@ namespace QuantLib {
         return !(this->operator==(to));
     }
 
+    #if defined(QL_USE_DISPOSABLE)
     inline Array& Array::operator=(const Disposable<Array>& from) {
         swap(const_cast<Disposable<Array>&>(from));
         return *this;
     }
+    #else
+    inline Array& Array::operator=(Array&& from) {
+        swap(from);
+        return *this;
+    }
+    #endif
+
+    template <class E>
+    inline Array& Array::operator=(const detail::ArrayExpression<E>& e) {
+        const E& expression = e.self();
+        if (n_ == expression.size()) {
+            iterator out = begin();
+            for (Size i=0; i<n_; ++i)
+                out[i] = expression[i];
+        } else {
+            Array temp(e);
+            swap(temp);
+        }
+        return *this;
+    }
 
     inline const Array& Array::operator+=(const Array& v) {
         QL_REQUIRE(n_ == v.n_,
@@ -363,6 +557,58 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class E>
+    inline const Array&
+    Array::operator+=(const detail::ArrayExpression<E>& e) {
+        const E& expression = e.self();
+        QL_REQUIRE(n_ == expression.size(),
+                   "arrays with different sizes (" << n_ << ", "
+                   << expression.size() << ") cannot be added");
+        iterator out = begin();
+        for (Size i=0; i<n_; ++i)
+            out[i] += expression[i];
+        return *this;
+    }
+
+    template <class E>
+    inline const Array&
+    Array::operator-=(const detail::ArrayExpression<E>& e) {
+        const E& expression = e.self();
+        QL_REQUIRE(n_ == expression.size(),
+                   "arrays with different sizes (" << n_ << ", "
+                   << expression.size() << ") cannot be subtracted");
+        iterator out = begin();
+        for (Size i=0; i<n_; ++i)
+            out[i] -= expression[i];
+        return *this;
+    }
+
+    template <class E>
+    inline const Array&
+    Array::operator*=(const detail::ArrayExpression<E>& e) {
+        const E& expression = e.self();
+        QL_REQUIRE(n_ == expression.size(),
+                   "arrays with different sizes (" << n_ << ", "
+                   << expression.size() << ") cannot be multiplied");
+        iterator out = begin();
+        for (Size i=0; i<n_; ++i)
+            out[i] *= expression[i];
+        return *this;
+    }
+
+    template <class E>
+    inline const Array&
+    Array::operator/=(const detail::ArrayExpression<E>& e) {
+        const E& expression = e.self();
+        QL_REQUIRE(n_ == expression.size(),
+                   "arrays with different sizes (" << n_ << ", "
+                   << expression.size() << ") cannot be divided");
+        iterator out = begin();
+        for (Size i=0; i<n_; ++i)
+            out[i] /= expression[i];
+        return *this;
+    }
+
     inline Real Array::operator[](Size i) const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(i<n_,
@@ -475,7 +721,7 @@ namespace QuantLib {
         QL_REQUIRE(v1.size() == v2.size(),
                    "arrays with different sizes (" << v1.size() << ", "
                    << v2.size() << ") cannot be multiplied");
-        return std::inner_product(v1.begin(),v1.end(),v2.begin(),0.0);
+        return std::inner_product(v1.begin(),v1.end(),v2.begin(),Real(0.0));
     }
 
     inline Real Norm2(const Array& v) {
@@ -484,154 +730,185 @@ namespace QuantLib {
 
     // overloaded operators
 
-    // unary
-
-    inline const Disposable<Array> operator+(const Array& v) {
-        Array result = v;
-        return result;
-    }
-
-    inline const Disposable<Array> operator-(const Array& v) {
-        Array result(v.size());
-        std::transform(v.begin(),v.end(),result.begin(),
-                       std::negate<Real>());
-        return result;
-    }
-
-
-    // binary operators
-
-    inline const Disposable<Array> operator+(const Array& v1,
-                                             const Array& v2) {
-        QL_REQUIRE(v1.size() == v2.size(),
-                   "arrays with different sizes (" << v1.size() << ", "
-                   << v2.size() << ") cannot be added");
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::plus<Real>());
-        return result;
-    }
-
-    inline const Disposable<Array> operator+(const Array& v1, Real a) {
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::plus<Real>(),a));
-        return result;
-    }
-
-    inline const Disposable<Array> operator+(Real a, const Array& v2) {
-        Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::plus<Real>(),a));
-        return result;
-    }
+    namespace detail {
 
-    inline const Disposable<Array> operator-(const Array& v1,
-                                             const Array& v2) {
-        QL_REQUIRE(v1.size() == v2.size(),
-                   "arrays with different sizes (" << v1.size() << ", "
-                   << v2.size() << ") cannot be subtracted");
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::minus<Real>());
-        return result;
-    }
+        template <class E, class F>
+        inline ArrayUnaryExpression<E,F>::operator Disposable<Array>() const {
+            // through the base class; when Disposable<Array> is Array,
+            // C++17 compilers might otherwise call this operator again
+            const ArrayExpression<ArrayUnaryExpression>& e = *this;
+            Array result(e);
+            return result;
+        }
 
-    inline const Disposable<Array> operator-(const Array& v1, Real a) {
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::minus<Real>(),a));
-        return result;
-    }
+        template <class E1, class E2, class Op>
+        inline ArrayBinaryExpression<E1,E2,Op>::operator
+        Disposable<Array>() const {
+            const ArrayExpression<ArrayBinaryExpression>& e = *this;
+            Array result(e);
+            return result;
+        }
 
-    inline const Disposable<Array> operator-(Real a, const Array& v2) {
-        Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::minus<Real>(),a));
-        return result;
     }
 
-    inline const Disposable<Array> operator*(const Array& v1,
-                                             const Array& v2) {
-        QL_REQUIRE(v1.size() == v2.size(),
-                   "arrays with different sizes (" << v1.size() << ", "
-                   << v2.size() << ") cannot be multiplied");
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::multiplies<Real>());
-        return result;
-    }
+    // unary
 
-    inline const Disposable<Array> operator*(const Array& v1, Real a) {
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::multiplies<Real>(),a));
-        return result;
+    template <class E>
+    inline const detail::ArrayUnaryExpression<E,detail::Unchanged>
+    operator+(const detail::ArrayExpression<E>& e) {
+        return detail::ArrayUnaryExpression<E,detail::Unchanged>(
+                                           e.self(), detail::Unchanged());
     }
 
-    inline const Disposable<Array> operator*(Real a, const Array& v2) {
-        Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::multiplies<Real>(),a));
-        return result;
+    template <class E>
+    inline const detail::ArrayUnaryExpression<E,std::negate<Real> >
+    operator-(const detail::ArrayExpression<E>& e) {
+        return detail::ArrayUnaryExpression<E,std::negate<Real> >(
+                                          e.self(), std::negate<Real>());
     }
 
-    inline const Disposable<Array> operator/(const Array& v1,
-                                             const Array& v2) {
-        QL_REQUIRE(v1.size() == v2.size(),
-                   "arrays with different sizes (" << v1.size() << ", "
-                   << v2.size() << ") cannot be divided");
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),v2.begin(),result.begin(),
-                       std::divides<Real>());
-        return result;
-    }
 
-    inline const Disposable<Array> operator/(const Array& v1, Real a) {
-        Array result(v1.size());
-        std::transform(v1.begin(),v1.end(),result.begin(),
-                       std::bind2nd(std::divides<Real>(),a));
-        return result;
-    }
+    // binary operators
 
-    inline const Disposable<Array> operator/(Real a, const Array& v2) {
-        Array result(v2.size());
-        std::transform(v2.begin(),v2.end(),result.begin(),
-                       std::bind1st(std::divides<Real>(),a));
-        return result;
+    template <class E1, class E2>
+    inline const detail::ArrayBinaryExpression<E1,E2,std::plus<Real> >
+    operator+(const detail::ArrayExpression<E1>& e1,
+              const detail::ArrayExpression<E2>& e2) {
+        QL_REQUIRE(e1.self().size() == e2.self().size(),
+                   "arrays with different sizes (" << e1.self().size()
+                   << ", " << e2.self().size() << ") cannot be added");
+        return detail::ArrayBinaryExpression<E1,E2,std::plus<Real> >(
+                                                      e1.self(), e2.self());
+    }
+
+    template <class E>
+    inline const detail::ArrayUnaryExpression<
+                              E,detail::ScalarOnRight<std::plus<Real> > >
+    operator+(const detail::ArrayExpression<E>& e, Real a) {
+        typedef detail::ScalarOnRight<std::plus<Real> > F;
+        return detail::ArrayUnaryExpression<E,F>(e.self(), F(a));
+    }
+
+    template <class E>
+    inline const detail::ArrayUnaryExpression<
+                              E,detail::ScalarOnLeft<std::plus<Real> > >
+    operator+(Real a, const detail::ArrayExpression<E>& e) {
+        typedef detail::ScalarOnLeft<std::plus<Real> > F;
+        return detail::ArrayUnaryExpression<E,F>(e.self(), F(a));
+    }
+
+    template <class E1, class E2>
+    inline const detail::ArrayBinaryExpression<E1,E2,std::minus<Real> >
+    operator-(const detail::ArrayExpression<E1>& e1,
+              const detail::ArrayExpression<E2>& e2) {
+        QL_REQUIRE(e1.self().size() == e2.self().size(),
+                   "arrays with different sizes (" << e1.self().size()
+                   << ", " << e2.self().size() << ") cannot be subtracted");
+        return detail::ArrayBinaryExpression<E1,E2,std::minus<Real> >(
+                                                      e1.self(), e2.self());
+    }
+
+    template <class E>
+    inline const detail::ArrayUnaryExpression<
+                             E,detail::ScalarOnRight<std::minus<Real> > >
+    operator-(const detail::ArrayExpression<E>& e, Real a) {
+        typedef detail::ScalarOnRight<std::minus<Real> > F;
+        return detail::ArrayUnaryExpression<E,F>(e.self(), F(a));
+    }
+
+    template <class E>
+    inline const detail::ArrayUnaryExpression<
+                              E,detail::ScalarOnLeft<std::minus<Real> > >
+    operator-(Real a, const detail::ArrayExpression<E>& e) {
+        typedef detail::ScalarOnLeft<std::minus<Real> > F;
+        return detail::ArrayUnaryExpression<E,F>(e.self(), F(a));
+    }
+
+    template <class E1, class E2>
+    inline const detail::ArrayBinaryExpression<E1,E2,std::multiplies<Real> >
+    operator*(const detail::ArrayExpression<E1>& e1,
+              const detail::ArrayExpression<E2>& e2) {
+        QL_REQUIRE(e1.self().size() == e2.self().size(),
+                   "arrays with different sizes (" << e1.self().size()
+                   << ", " << e2.self().size() << ") cannot be multiplied");
+        return detail::ArrayBinaryExpression<E1,E2,std::multiplies<Real> >(
+                                                      e1.self(), e2.self());
+    }
+
+    template <class E>
+    inline const detail::ArrayUnaryExpression<
+                        E,detail::ScalarOnRight<std::multiplies<Real> > >
+    operator*(const detail::ArrayExpression<E>& e, Real a) {
+        typedef detail::ScalarOnRight<std::multiplies<Real> > F;
+        return detail::ArrayUnaryExpression<E,F>(e.self(), F(a));
+    }
+
+    template <class E>
+    inline const detail::ArrayUnaryExpression<
+                         E,detail::ScalarOnLeft<std::multiplies<Real> > >
+    operator*(Real a, const detail::ArrayExpression<E>& e) {
+        typedef detail::ScalarOnLeft<std::multiplies<Real> > F;
+        return detail::ArrayUnaryExpression<E,F>(e.self(), F(a));
+    }
+
+    template <class E1, class E2>
+    inline const detail::ArrayBinaryExpression<E1,E2,std::divides<Real> >
+    operator/(const detail::ArrayExpression<E1>& e1,
+              const detail::ArrayExpression<E2>& e2) {
+        QL_REQUIRE(e1.self().size() == e2.self().size(),
+                   "arrays with different sizes (" << e1.self().size()
+                   << ", " << e2.self().size() << ") cannot be divided");
+        return detail::ArrayBinaryExpression<E1,E2,std::divides<Real> >(
+                                                      e1.self(), e2.self());
+    }
+
+    template <class E>
+    inline const detail::ArrayUnaryExpression<
+                           E,detail::ScalarOnRight<std::divides<Real> > >
+    operator/(const detail::ArrayExpression<E>& e, Real a) {
+        typedef detail::ScalarOnRight<std::divides<Real> > F;
+        return detail::ArrayUnaryExpression<E,F>(e.self(), F(a));
+    }
+
+    template <class E>
+    inline const detail::ArrayUnaryExpression<
+                            E,detail::ScalarOnLeft<std::divides<Real> > >
+    operator/(Real a, const detail::ArrayExpression<E>& e) {
+        typedef detail::ScalarOnLeft<std::divides<Real> > F;
+        return detail::ArrayUnaryExpression<E,F>(e.self(), F(a));
     }
 
     // functions
 
-    inline const Disposable<Array> Abs(const Array& v) {
+    inline Disposable<Array> Abs(const Array& v) {
         Array result(v.size());
         std::transform(v.begin(),v.end(),result.begin(),
                        std::ptr_fun<Real,Real>(std::fabs));
         return result;
     }
 
-    inline const Disposable<Array> Sqrt(const Array& v) {
+    inline Disposable<Array> Sqrt(const Array& v) {
         Array result(v.size());
         std::transform(v.begin(),v.end(),result.begin(),
                        std::ptr_fun<Real,Real>(std::sqrt));
         return result;
     }
 
-    inline const Disposable<Array> Log(const Array& v) {
+    inline Disposable<Array> Log(const Array& v) {
         Array result(v.size());
         std::transform(v.begin(),v.end(),result.begin(),
                        std::ptr_fun<Real,Real>(std::log));
         return result;
     }
 
-    inline const Disposable<Array> Exp(const Array& v) {
+    inline Disposable<Array> Exp(const Array& v) {
         Array result(v.size());
         std::transform(v.begin(),v.end(),result.begin(),
                        std::ptr_fun<Real,Real>(std::exp));
         return result;
     }
 
-    inline const Disposable<Array> Pow(const Array& v, Real alpha) {
+    inline Disposable<Array> Pow(const Array& v, Real alpha) {
         Array result(v.size());
         std::transform(v.begin(), v.end(), result.begin(),
             std::bind2nd(std::ptr_fun<Real, Real, Real>(std::pow), alpha));
@@ -22,6 +22,8 @@
 
 #include <ql/math/distributions/bivariatenormaldistribution.hpp>
 #include <ql/math/integrals/gaussianquadratures.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace QuantLib {
 
@@ -111,76 +113,39 @@ namespace QuantLib {
     }
 
 
+    void BivariateCumulativeNormalDistributionDr78::operator()(
+                     const Real* a, const Real* b, Real* out, Size n) const {
+        for (Size i=0; i<n; ++i)
+            out[i] = (*this)(a[i], b[i]);
+    }
+
+
     // West 2004
 
-    namespace {
+    /* The implementation is described at section 2.4 "Hybrid
+       Numerical Integration Algorithms" of "Numerical Computation
+       of Rectangular Bivariate an Trivariate Normal and t
+       Probabilities", Genz (2004), Statistics and Computing 14,
+       151-160. (available at
+       www.sci.wsu.edu/math/faculty/henz/homepage)
 
-        class eqn3 { /* Relates to eqn3 Genz 2004 */
-          public:
-            eqn3(Real h, Real k, Real asr) {
-                hk_ = h * k;
-                hs_  = (h * h + k * k) / 2;
-                asr_ = asr;
-            }
-            Real operator()(Real x) const {
-                Real sn = std::sin(asr_ * (-x + 1) * 0.5);
-                return std::exp((sn * hk_ - hs_) / (1.0 - sn * sn));
-            }
-          private:
-            Real hk_, asr_, hs_;
-        };
-
-        class eqn6 { /* Relates to eqn6 Genz 2004 */
-          public:
-            eqn6(Real a, Real c, Real d, Real bs, Real hk)
-            : a_(a), c_(c), d_(d), bs_(bs), hk_(hk) {}
-            Real operator()(Real x) const {
-                Real xs = a_ * (-x + 1);
-                xs = std::fabs(xs*xs);
-                Real rs = std::sqrt(1 - xs);
-                Real asr = -(bs_ / xs + hk_) / 2;
-                if (asr > -100.0) {
-                    return (a_ * std::exp(asr) *
-                            (std::exp(-hk_ * (1 - rs) / (2 * (1 + rs))) / rs -
-                             (1 + c_ * xs * (1 + d_ * xs))));
-                } else {
-                    return 0.0;
-                }
-            }
-          private:
-            Real a_, c_, d_, bs_, hk_;
-        };
+       The Gauss-Legendre quadrature have been extracted to
+       TabulatedGaussLegendre (x,w zero-based)
 
-    }
+       The terms of the functions to be integrated numerically
+       (eqns 3 and 6 in Genz 2004) that don't depend on the
+       point are calculated by the constructor
+
+       Change some magic numbers to M_PI */
 
     BivariateCumulativeNormalDistributionWe04DP::
     BivariateCumulativeNormalDistributionWe04DP(Real rho)
-    : correlation_(rho) {
+    : correlation_(rho), asr_(0.0), ass_(0.0) {
 
         QL_REQUIRE(rho>=-1.0,
                    "rho must be >= -1.0 (" << rho << " not allowed)");
         QL_REQUIRE(rho<=1.0,
                    "rho must be <= 1.0 (" << rho << " not allowed)");
-    }
-
-
-    Real BivariateCumulativeNormalDistributionWe04DP::operator()(
-                                                       Real x, Real y) const {
-
-        /* The implementation is described at section 2.4 "Hybrid
-           Numerical Integration Algorithms" of "Numerical Computation
-           of Rectangular Bivariate an Trivariate Normal and t
-           Probabilities", Genz (2004), Statistics and Computing 14,
-           151-160. (available at
-           www.sci.wsu.edu/math/faculty/henz/homepage)
-
-           The Gauss-Legendre quadrature have been extracted to
-           TabulatedGaussLegendre (x,w zero-based)
-
-           Tthe functions ot be integrated numerically have been moved
-           to classes eqn3 and eqn6
-
-           Change some magic numbers to M_PI */
 
         TabulatedGaussLegendre gaussLegendreQuad(20);
         if (std::fabs(correlation_) < 0.3) {
@@ -188,6 +153,34 @@ namespace QuantLib {
         } else if (std::fabs(correlation_) < 0.75) {
             gaussLegendreQuad.order(12);
         }
+        order_ = gaussLegendreQuad.order();
+        const Array x = gaussLegendreQuad.x();
+        const Array w = gaussLegendreQuad.weights();
+        std::copy(w.begin(), w.end(), w_);
+
+        if (std::fabs(correlation_) < 0.925) {
+            if (std::fabs(correlation_) > 0) {
+                asr_ = std::asin(correlation_);
+                for (Size j=0; j<order_; ++j) {
+                    Real sn = std::sin(asr_ * (-x[j] + 1) * 0.5);
+                    sn_[j] = sn;
+                    den_[j] = 1.0 - sn * sn;
+                }
+            }
+        } else if (std::fabs(correlation_) < 1) {
+            ass_ = (1 - correlation_) * (1 + correlation_);
+            Real a = std::sqrt(ass_) / 2;
+            for (Size j=0; j<order_; ++j) {
+                Real xs = a * (-x[j] + 1);
+                xs_[j] = std::fabs(xs*xs);
+                rs_[j] = std::sqrt(1 - xs_[j]);
+            }
+        }
+    }
+
+
+    Real BivariateCumulativeNormalDistributionWe04DP::operator()(
+                                                       Real x, Real y) const {
 
         Real h = -x;
         Real k = -y;
@@ -198,10 +191,10 @@ namespace QuantLib {
         {
             if (std::fabs(correlation_) > 0)
             {
-                Real asr = std::asin(correlation_);
-                eqn3 f(h,k,asr);
-                BVN = gaussLegendreQuad(f);
-                BVN *= asr * (0.25 / M_PI);
+                Real hs = (h * h + k * k) / 2;
+                for (Size j=0; j<order_; ++j)
+                    BVN += w_[j] * std::exp((sn_[j] * hk - hs) / den_[j]);
+                BVN *= asr_ * (0.25 / M_PI);
             }
             BVN += cumnorm_(-h) * cumnorm_(-k);
         }
@@ -212,48 +205,123 @@ namespace QuantLib {
                 k *= -1;
                 hk *= -1;
             }
+            Real quadrature = 0.0;
             if (std::fabs(correlation_) < 1)
             {
-                Real Ass = (1 - correlation_) * (1 + correlation_);
-                Real a = std::sqrt(Ass);
+                Real a = std::sqrt(ass_) / 2;
                 Real bs = (h-k)*(h-k);
                 Real c = (4 - hk) / 8;
                 Real d = (12 - hk) / 16;
-                Real asr = -(bs / Ass + hk) / 2;
-                if (asr > -100)
-                {
-                    BVN = a * std::exp(asr) *
-                        (1 - c * (bs - Ass) * (1 - d * bs / 5) / 3 +
-                         c * d * Ass * Ass / 5);
-                }
-                if (-hk < 100)
-                {
-                    Real B = std::sqrt(bs);
-                    BVN -= std::exp(-hk / 2) * 2.506628274631 *
-                        cumnorm_(-B / a) * B *
-                        (1 - c * bs * (1 - d * bs / 5) / 3);
+                for (Size j=0; j<order_; ++j) {
+                    Real asr = -(bs / xs_[j] + hk) / 2;
+                    if (asr > -100.0) {
+                        quadrature += w_[j] * (a * std::exp(asr) *
+                            (std::exp(-hk * (1 - rs_[j]) / (2 * (1 + rs_[j])))
+                             / rs_[j] - (1 + c * xs_[j] * (1 + d * xs_[j]))));
+                    }
                 }
-                a /= 2;
-                eqn6 f(a,c,d,bs,hk);
-                BVN += gaussLegendreQuad(f);
-                BVN /= (-2.0 * M_PI);
             }
+            BVN = highCorrelationValue(h, k, quadrature);
+        }
+        return BVN;
+    }
 
-            if (correlation_ > 0) {
-                BVN += cumnorm_(-std::max(h, k));
+
+    void BivariateCumulativeNormalDistributionWe04DP::operator()(
+                     const Real* x, const Real* y, Real* out, Size n) const {
+
+        if (std::fabs(correlation_) < 0.925) {
+            std::vector<Real> cumnorm(2*n);
+            if (n > 0) {
+                cumnorm_(x, &cumnorm[0], n);
+                cumnorm_(y, &cumnorm[n], n);
+            }
+            if (std::fabs(correlation_) > 0) {
+                std::fill(out, out+n, 0.0);
+                for (Size j=0; j<order_; ++j) {
+                    const Real wj = w_[j], snj = sn_[j], denj = den_[j];
+                    for (Size i=0; i<n; ++i) {
+                        const Real h = -x[i], k = -y[i];
+                        const Real hk = h * k, hs = (h * h + k * k) / 2;
+                        out[i] += wj * std::exp((snj * hk - hs) / denj);
+                    }
+                }
+                for (Size i=0; i<n; ++i)
+                    out[i] = out[i] * (asr_ * (0.25 / M_PI))
+                           + cumnorm[i] * cumnorm[n+i];
             } else {
-                BVN *= -1;
-                if (k > h) {
-                    // evaluate cumnorm where it is most precise, that
-                    // is in the lower tail because of double accuracy
-                    // around 0.0 vs around 1.0
-                    if (h >= 0) {
-                        BVN += cumnorm_(-h) - cumnorm_(-k);
-                    } else {
-                        BVN += cumnorm_(k) - cumnorm_(h);
+                for (Size i=0; i<n; ++i)
+                    out[i] = cumnorm[i] * cumnorm[n+i];
+            }
+        } else {
+            const Real sign = correlation_ < 0 ? 1.0 : -1.0;
+            std::fill(out, out+n, 0.0);
+            if (std::fabs(correlation_) < 1) {
+                const Real a = std::sqrt(ass_) / 2;
+                for (Size j=0; j<order_; ++j) {
+                    const Real wj = w_[j], xsj = xs_[j], rsj = rs_[j];
+                    for (Size i=0; i<n; ++i) {
+                        const Real h = -x[i], k = sign * y[i];
+                        const Real hk = h * k, bs = (h-k)*(h-k);
+                        const Real c = (4 - hk) / 8, d = (12 - hk) / 16;
+                        const Real asr = -(bs / xsj + hk) / 2;
+                        const Real term = a * std::exp(asr) *
+                            (std::exp(-hk * (1 - rsj) / (2 * (1 + rsj)))
+                             / rsj - (1 + c * xsj * (1 + d * xsj)));
+                        out[i] += asr > -100.0 ? wj * term : 0.0;
                     }
                 }
             }
+            for (Size i=0; i<n; ++i)
+                out[i] = highCorrelationValue(-x[i], sign * y[i], out[i]);
+        }
+    }
+
+
+    Real BivariateCumulativeNormalDistributionWe04DP::highCorrelationValue(
+                                   Real h, Real k, Real quadrature) const {
+        // k has already been changed in sign for negative correlation
+        Real hk = h * k;
+        Real BVN = 0.0;
+        if (std::fabs(correlation_) < 1)
+        {
+            Real Ass = ass_;
+            Real a = std::sqrt(Ass);
+            Real bs = (h-k)*(h-k);
+            Real c = (4 - hk) / 8;
+            Real d = (12 - hk) / 16;
+            Real asr = -(bs / Ass + hk) / 2;
+            if (asr > -100)
+            {
+                BVN = a * std::exp(asr) *
+                    (1 - c * (bs - Ass) * (1 - d * bs / 5) / 3 +
+                     c * d * Ass * Ass / 5);
+            }
+            if (-hk < 100)
+            {
+                Real B = std::sqrt(bs);
+                BVN -= std::exp(-hk / 2) * 2.506628274631 *
+                    cumnorm_(-B / a) * B *
+                    (1 - c * bs * (1 - d * bs / 5) / 3);
+            }
+            BVN += quadrature;
+            BVN /= (-2.0 * M_PI);
+        }
+
+        if (correlation_ > 0) {
+            BVN += cumnorm_(-std::max(h, k));
+        } else {
+            BVN *= -1;
+            if (k > h) {
+                // evaluate cumnorm where it is most precise, that
+                // is in the lower tail because of double accuracy
+                // around 0.0 vs around 1.0
+                if (h >= 0) {
+                    BVN += cumnorm_(-h) - cumnorm_(-k);
+                } else {
+                    BVN += cumnorm_(k) - cumnorm_(h);
+                }
+            }
         }
         return BVN;
     }
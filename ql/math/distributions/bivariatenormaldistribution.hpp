@@ -61,6 +61,10 @@ namespace QuantLib {
         BivariateCumulativeNormalDistributionDr78(Real rho);
         // function
         Real operator()(Real a, Real b) const;
+        //! evaluates the function at the n points (a[i], b[i])
+        /*! The results are the same as those of operator(). */
+        void operator()(const Real* a, const Real* b, Real* out,
+                        Size n) const;
       private:
         Real rho_, rho2_;
         static const Real x_[], y_[];
@@ -85,6 +89,9 @@ namespace QuantLib {
         - The implementation of the cumulative normal distribution is
           QuantLib::CumulativeNormalDistribution
         - The arrays XX and W are zero-based
+        - The terms of the integrands that only depend on the
+          quadrature nodes and on the correlation are calculated
+          once, by the constructor
 
         \test the correctness of the returned value is tested by
               checking it against known good results.
@@ -94,9 +101,29 @@ namespace QuantLib {
         BivariateCumulativeNormalDistributionWe04DP(Real rho);
         // function
         Real operator()(Real a, Real b) const;
+        //! evaluates the function at the n points (a[i], b[i])
+        /*! The quadratures are performed node by node for all points
+            in loops without branches, which compilers can vectorize
+            for the instruction set they target.  When the absolute
+            value of the correlation is less than 0.925, the
+            univariate cumulative normal terms are calculated by the
+            batch method of CumulativeNormalDistribution; the results
+            might then differ from those of operator() by a few
+            units of \f$ 10^{-16} \f$.  Otherwise, they are the same.
+        */
+        void operator()(const Real* a, const Real* b, Real* out,
+                        Size n) const;
       private:
+        Real highCorrelationValue(Real h, Real k, Real quadrature) const;
         Real correlation_;
         CumulativeNormalDistribution cumnorm_;
+        // quadrature weights, in the order in which they are summed
+        Size order_;
+        Real w_[20];
+        // terms depending on the nodes: sine and denominator for
+        // |rho| < 0.925, square and root for |rho| >= 0.925
+        Real asr_, sn_[20], den_[20];
+        Real ass_, xs_[20], rs_[20];
     };
 
     //! default bivariate implementation
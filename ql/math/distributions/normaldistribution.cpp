@@ -36,6 +36,72 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // Coefficients of Cody's approximations; see W. J. Cody,
+        // "Algorithm 715", ACM Transactions on Mathematical Software
+        // 19 (1993), pp. 22-32.
+
+        // central region, |z| <= 0.67448975
+        const Real codyA[5] = {
+            2.2352520354606839287,  1.6102823106855587881e2,
+            1.0676894854603709582e3, 1.8154981253343561249e4,
+            6.5682337918207449113e-2 };
+        const Real codyB[4] = {
+            4.7202581904688241870e1, 9.7609855173777669322e2,
+            1.0260932208618978205e4, 4.5507789335026729956e4 };
+
+        // intermediate region, 0.67448975 < |z| <= sqrt(32)
+        const Real codyC[9] = {
+            3.9894151208813466764e-1, 8.8831497943883759412,
+            9.3506656132177855979e1,  5.9727027639480026226e2,
+            2.4945375852903726711e3,  6.8481904505362823326e3,
+            1.1602651437647350124e4,  9.8427148383839780218e3,
+            1.0765576773720192317e-8 };
+        const Real codyD[8] = {
+            2.2266688044328115691e1, 2.3538790178262499861e2,
+            1.5193775994075548050e3, 6.4855582982667607550e3,
+            1.8615571640885098091e4, 3.4900952721145977266e4,
+            3.8912003286093271411e4, 1.9685429676859990727e4 };
+
+        // tails, |z| > sqrt(32)
+        const Real codyP[6] = {
+            2.1589853405795699e-1, 1.274011611602473639e-1,
+            2.2235277870649807e-2, 1.421619193227893466e-3,
+            2.9112874951168792e-5, 2.307344176494017303e-2 };
+        const Real codyQ[5] = {
+            1.28426009614491121,    4.68238212480865118e-1,
+            6.59881378689285515e-2, 3.78239633202758244e-3,
+            7.29751555083966205e-5 };
+
+        const Real codyCentralLimit = 0.67448975;
+        const Real codyTailLimit = 5.656854249492380195; // sqrt(32)
+        const Real codyOneOverSqrt2Pi = 3.9894228040143267794e-1;
+
+        /* exp(-y*y/2), with y*y split so that the rounding error
+           isn't amplified by the exponential */
+        inline Real codyGaussian(Real y) {
+            const Real ysq = std::floor(y*16.0)/16.0;
+            const Real del = (y-ysq)*(y+ysq);
+            return std::exp(-ysq*ysq*0.5)*std::exp(-del*0.5);
+        }
+
+        // cumulative normal for |z| > sqrt(32)
+        Real codyTail(Real z) {
+            const Real y = std::fabs(z);
+            const Real ysq = 1.0/(z*z);
+            Real num = codyP[5]*ysq, den = ysq;
+            for (Size i=0; i<4; ++i) {
+                num = (num + codyP[i])*ysq;
+                den = (den + codyQ[i])*ysq;
+            }
+            const Real r = ysq*(num + codyP[4])/(den + codyQ[4]);
+            const Real lower = codyGaussian(y)*(codyOneOverSqrt2Pi-r)/y;
+            return z > 0.0 ? 1.0-lower : lower;
+        }
+
+    }
+
     Real CumulativeNormalDistribution::operator()(Real z) const {
         //QL_REQUIRE(!(z >= average_ && 2.0*average_-z > average_),
         //           "not a real number. ");
@@ -63,6 +129,47 @@ namespace QuantLib {
         return result;
     }
 
+    void CumulativeNormalDistribution::operator()(const Real* x, Real* out,
+                                                  Size n) const {
+        int tails = 0;
+        for (Size i=0; i<n; ++i) {
+            const Real z = (x[i] - average_) / sigma_;
+            const Real y = std::fabs(z);
+
+            // both the central and the intermediate approximation
+            // are calculated and the right one is selected, which
+            // avoids branches
+            const Real zsq = z*z;
+            Real num = codyA[4]*zsq, den = zsq;
+            for (Size j=0; j<3; ++j) {
+                num = (num + codyA[j])*zsq;
+                den = (den + codyB[j])*zsq;
+            }
+            const Real central = 0.5 + z*(num + codyA[3])/(den + codyB[3]);
+
+            num = codyC[8]*y;
+            den = y;
+            for (Size j=0; j<7; ++j) {
+                num = (num + codyC[j])*y;
+                den = (den + codyD[j])*y;
+            }
+            const Real lower =
+                codyGaussian(y)*(num + codyC[7])/(den + codyD[7]);
+            const Real intermediate = z > 0.0 ? 1.0-lower : lower;
+
+            out[i] = y <= codyCentralLimit ? central : intermediate;
+            // NaNs are also left to the second pass
+            tails |= int(!(y <= codyTailLimit));
+        }
+        if (tails) {
+            for (Size i=0; i<n; ++i) {
+                const Real z = (x[i] - average_) / sigma_;
+                if (!(std::fabs(z) <= codyTailLimit))
+                    out[i] = codyTail(z);
+            }
+        }
+    }
+
     #if !defined(QL_PATCH_SOLARIS)
     const CumulativeNormalDistribution InverseCumulativeNormal::f_;
     #endif
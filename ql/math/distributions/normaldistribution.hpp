@@ -73,6 +73,25 @@ namespace QuantLib {
         // function
         Real operator()(Real x) const;
         Real derivative(Real x) const;
+        //! evaluates the function at the n points x[0], ..., x[n-1]
+        /*! The values are calculated with Cody's rational Chebyshev
+            approximations (W. J. Cody, "Algorithm 715", ACM
+            Transactions on Mathematical Software 19, 1993, pp.
+            22-32), whose relative error is less than 1e-15 on the
+            whole range.  They differ from the results of operator()
+            by less than \f$ 10^{-15} \f$ in absolute value; in the
+            far lower tail, where operator() has a relative error of
+            about \f$ 10^{-7} \f$, they are more accurate.
+
+            Outside the tails \f$ |z| > \sqrt{32} \f$, which are
+            evaluated in a separate pass, the loop over the points
+            has no branches and can be vectorized by the compiler for
+            the instruction set it targets (e.g., with -mavx2 or
+            -mavx512f on x86-64, or by default with NEON on AArch64),
+            provided that a vector implementation of std::exp is
+            available, e.g., from glibc's libmvec.
+        */
+        void operator()(const Real* x, Real* out, Size n) const;
       private:
         Real average_, sigma_;
         NormalDistribution gaussian_;
@@ -136,6 +155,25 @@ namespace QuantLib {
 
             return z;
         }
+        //! applies operator() to the sequence [begin, end)
+        /*! The results are the same as those of operator(); however,
+            the central region, in which most values fall, is
+            evaluated first for the whole sequence by a loop without
+            branches or calls that the compiler can vectorize, and the
+            tails are corrected in a second pass.
+
+            \pre InputIterator and OutputIterator must be random-access
+        */
+        template <class InputIterator, class OutputIterator>
+        void transform(InputIterator begin, InputIterator end,
+                       OutputIterator out) const;
+        //! evaluates the function at the n points x[0], ..., x[n-1]
+        /*! This is equivalent to transform(x, x+n, out); the results
+            have the same accuracy as those of operator().
+        */
+        void operator()(const Real* x, Real* out, Size n) const {
+            transform(x, x+n, out);
+        }
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
@@ -311,6 +349,35 @@ namespace QuantLib {
                    << sigma_ << " not allowed)");
     }
 
+    template <class InputIterator, class OutputIterator>
+    inline void InverseCumulativeNormal::transform(InputIterator begin,
+                                                   InputIterator end,
+                                                   OutputIterator out) const {
+        #ifdef REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+        for (; begin != end; ++begin, ++out)
+            *out = (*this)(*begin);
+        #else
+        const Size n = end - begin;
+        int tails = 0;
+        for (Size i=0; i<n; ++i) {
+            const Real x = begin[i];
+            const Real z = x - 0.5;
+            const Real r = z*z;
+            out[i] = average_ + sigma_*(
+                (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0));
+            tails |= int(x < x_low_) | int(x_high_ < x);
+        }
+        if (tails) {
+            for (Size i=0; i<n; ++i) {
+                const Real x = begin[i];
+                if (x < x_low_ || x_high_ < x)
+                    out[i] = average_ + sigma_*tail_value(x);
+            }
+        }
+        #endif
+    }
+
     inline MoroInverseCumulativeNormal::MoroInverseCumulativeNormal(
                                                  Real average, Real sigma)
     : average_(average), sigma_(sigma) {
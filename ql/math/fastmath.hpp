@@ -0,0 +1,232 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fastmath.hpp
+    \brief math policies for exponentials and logarithms in hot kernels
+*/
+
+#ifndef quantlib_fast_math_hpp
+#define quantlib_fast_math_hpp
+
+#include <ql/types.hpp>
+#include <ql/mathconstants.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! transcendental functions of the standard library
+    /*! This is the default math policy of the library kernels; its
+        results are the same as those of the corresponding functions
+        in namespace std.
+    */
+    class StandardMath {
+      public:
+        static Real exp(Real x) { return std::exp(x); }
+        static Real log(Real x) { return std::log(x); }
+        static Real pow(Real x, Real y) { return std::pow(x, y); }
+        static void exp(Size n, const Real* x, Real* y) {
+            for (Size i=0; i<n; ++i)
+                y[i] = std::exp(x[i]);
+        }
+        static void log(Size n, const Real* x, Real* y) {
+            for (Size i=0; i<n; ++i)
+                y[i] = std::log(x[i]);
+        }
+    };
+
+    namespace detail {
+
+        // 1/k! for k = 0, ..., 11
+        const double expCoefficients[] = {
+            1.0, 1.0, 1.0/2, 1.0/6, 1.0/24, 1.0/120, 1.0/720,
+            1.0/5040, 1.0/40320, 1.0/362880, 1.0/3628800, 1.0/39916800
+        };
+
+        // 2/(2k+1) for k = 0, ..., 7
+        const double logCoefficients[] = {
+            2.0, 2.0/3, 2.0/5, 2.0/7, 2.0/9, 2.0/11, 2.0/13, 2.0/15
+        };
+
+        // ln 2 split in a part with trailing zero bits and a remainder
+        const double ln2Hi = 6.93147180369123816490e-01;
+        const double ln2Lo = 1.90821492927058770002e-10;
+
+        inline boost::uint64_t doubleToBits(double x) {
+            boost::uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(double));
+            return bits;
+        }
+
+        inline double bitsToDouble(boost::uint64_t bits) {
+            double x;
+            std::memcpy(&x, &bits, sizeof(double));
+            return x;
+        }
+
+        // nearest integer to x for |x| < 2^51; unlike std::floor or
+        // std::round, the addition and subtraction of 1.5 * 2^52 can
+        // be vectorized without special instructions
+        inline double roundToInteger(double x) {
+            const double shift = 6755399441055744.0;
+            return (x + shift) - shift;
+        }
+
+        // 2^k for integer k with -1022 <= k <= 1023; the biased
+        // exponent is obtained in the low bits of 2^52 + 1023 + k,
+        // which avoids a conversion to an integer type
+        inline double powerOfTwo(double k) {
+            return bitsToDouble(
+                doubleToBits(k + 4503599627371519.0) << 52);
+        }
+
+        // Horner evaluation of c[0] + c[1] x + ... + c[N] x^N,
+        // unrolled at compile time
+        template <Size N>
+        struct Polynomial {
+            static double value(const double* c, double x) {
+                return c[0] + x*Polynomial<N-1>::value(c+1, x);
+            }
+        };
+
+        template <>
+        struct Polynomial<0> {
+            static double value(const double* c, double) {
+                return c[0];
+            }
+        };
+
+    }
+
+    //! polynomial approximations of transcendental functions
+    /*! The exponential is reduced to \f$ 2^k e^r \f$ with
+        \f$ |r| \le \ln 2/2 \f$, and \f$ e^r \f$ is approximated by
+        its Taylor polynomial of degree <tt>ExpDegree</tt>.  The
+        logarithm is reduced to \f$ k \ln 2 + \ln m \f$ with
+        \f$ \sqrt{2}/2 \le m < \sqrt{2} \f$, and \f$ \ln m =
+        2\,\mathrm{atanh}(s) \f$ with \f$ s = (m-1)/(m+1) \f$ is
+        approximated by the first <tt>LogTerms</tt> terms of its
+        series.
+
+        Special arguments are handled by selecting the result rather
+        than by branching, so that the loops in the batch versions
+        can be vectorized by the compiler.  The power is calculated
+        as \f$ e^{y \ln x} \f$ for positive \f$ x \f$, so that its
+        relative error grows with \f$ |y \ln x| \f$.
+
+        \warning the implementation relies on the IEEE 754 layout of
+                 double-precision numbers and on floating-point
+                 operations not being reassociated by the compiler
+                 (as they would be, e.g., by -ffast-math.)
+    */
+    template <Size ExpDegree, Size LogTerms>
+    class ApproximateMath {
+      public:
+        static Real exp(Real x) {
+            const double maxArgument = 709.78;
+            const double minArgument = -745.13;
+            const double xc = (x > maxArgument) ? maxArgument
+                            : (x > minArgument) ? double(x)
+                            : minArgument;
+
+            const double kr = detail::roundToInteger(xc*M_LOG2E);
+            const double r = (xc - kr*detail::ln2Hi) - kr*detail::ln2Lo;
+            const double p = detail::Polynomial<ExpDegree>::value(
+                                          detail::expCoefficients, r);
+
+            // the scaling is split in two factors, so that both are
+            // normal numbers even when the result is subnormal or
+            // close to overflowing
+            const double k1 = detail::roundToInteger(0.5*kr);
+            const double y = p*detail::powerOfTwo(k1)
+                              *detail::powerOfTwo(kr - k1);
+
+            const double inf = std::numeric_limits<double>::infinity();
+            return (x != x) ? x
+                 : (x > maxArgument) ? inf
+                 : (x < minArgument) ? 0.0
+                 : y;
+        }
+        static Real log(Real x) {
+            const double minNormal = std::numeric_limits<double>::min();
+            const double scale = 18014398509481984.0; // 2^54
+            const bool subnormal = (x < minNormal);
+            const double xs = subnormal ? x*scale : double(x);
+
+            const boost::uint64_t bits = detail::doubleToBits(xs);
+            const double m0 = detail::bitsToDouble(
+                (bits & 0x000FFFFFFFFFFFFFULL) | 0x3FF0000000000000ULL);
+            const bool large = (m0 > M_SQRT2);
+            const double m = large ? 0.5*m0 : m0;
+            const double k = double(int((bits >> 52) & 0x7FF) - 1023)
+                           + (large ? 1.0 : 0.0)
+                           - (subnormal ? 54.0 : 0.0);
+
+            const double s = (m - 1.0)/(m + 1.0);
+            const double s2 = s*s;
+            const double p = detail::Polynomial<LogTerms-1>::value(
+                                          detail::logCoefficients, s2);
+            const double y = k*detail::ln2Hi + (s*p + k*detail::ln2Lo);
+
+            const double inf = std::numeric_limits<double>::infinity();
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            return (x != x || x == inf) ? x
+                 : (x < 0.0) ? nan
+                 : (x == 0.0) ? -inf
+                 : y;
+        }
+        static Real pow(Real x, Real y) {
+            return x > 0.0 ? exp(y*log(x)) : std::pow(x, y);
+        }
+        static void exp(Size n, const Real* x, Real* y) {
+            for (Size i=0; i<n; ++i)
+                y[i] = exp(x[i]);
+        }
+        static void log(Size n, const Real* x, Real* y) {
+            for (Size i=0; i<n; ++i)
+                y[i] = log(x[i]);
+        }
+    };
+
+    //! approximations with relative error below \f$ 10^{-12} \f$
+    typedef ApproximateMath<11,8> AccurateApproximateMath;
+
+    //! approximations with relative error below \f$ 10^{-7} \f$
+    typedef ApproximateMath<7,5> FastApproximateMath;
+
+    //! math policy used by the simulation kernels of the library
+    /*! The standard library functions are used unless QL_FAST_MATH
+        is defined, in which case AccurateApproximateMath is used, or
+        FastApproximateMath if QL_FAST_MATH_LOW_ACCURACY is also
+        defined.
+    */
+    #if defined(QL_FAST_MATH)
+    #  if defined(QL_FAST_MATH_LOW_ACCURACY)
+    typedef FastApproximateMath KernelMath;
+    #  else
+    typedef AccurateApproximateMath KernelMath;
+    #  endif
+    #else
+    typedef StandardMath KernelMath;
+    #endif
+
+}
+
+#endif
@@ -0,0 +1,242 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fixedarray.hpp
+    \brief 1-D array with a size known at compile time
+*/
+
+#ifndef quantlib_fixed_array_hpp
+#define quantlib_fixed_array_hpp
+
+#include <ql/math/array.hpp>
+#include <boost/static_assert.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! 1-D array with a size known at compile time
+    /*! This class provides the same vector algebra as Array for
+        arrays whose size is fixed at compile time, e.g., the state
+        variables of a low-dimensional stochastic process.  The
+        elements are stored inside the object, so that no heap
+        allocation is performed when instances are created, copied
+        or returned; and since all loops have a constant number of
+        iterations, compilers can unroll them.
+
+        Unlike Array, the elements are not initialized unless a
+        value is passed to the constructor.
+    */
+    template <Size N>
+    class FixedArray {
+        BOOST_STATIC_ASSERT(N > 0);
+      public:
+        //! \name Constructors
+        //@{
+        FixedArray() {}
+        //! creates the array and fills it with <tt>value</tt>
+        explicit FixedArray(Real value) {
+            std::fill(data_, data_+N, value);
+        }
+        /*! creates the array from a dynamic one
+            \pre the size of the given array must be N
+        */
+        explicit FixedArray(const Array& from) {
+            QL_REQUIRE(from.size() == N,
+                       "array of size " << N << " cannot be initialized "
+                       "from an array of size " << from.size());
+            std::copy(from.begin(), from.end(), data_);
+        }
+        //@}
+        //! \name Conversion
+        //@{
+        //! returns a dynamic array with the same elements
+        Disposable<Array> toArray() const {
+            Array result(data_, data_+N);
+            return result;
+        }
+        //@}
+        /*! \name Vector algebra
+
+            Operators have the same meaning as the corresponding
+            Array ones.
+        */
+        //@{
+        const FixedArray& operator+=(const FixedArray& v) {
+            for (Size i=0; i<N; ++i)
+                data_[i] += v.data_[i];
+            return *this;
+        }
+        const FixedArray& operator+=(Real x) {
+            for (Size i=0; i<N; ++i)
+                data_[i] += x;
+            return *this;
+        }
+        const FixedArray& operator-=(const FixedArray& v) {
+            for (Size i=0; i<N; ++i)
+                data_[i] -= v.data_[i];
+            return *this;
+        }
+        const FixedArray& operator-=(Real x) {
+            for (Size i=0; i<N; ++i)
+                data_[i] -= x;
+            return *this;
+        }
+        const FixedArray& operator*=(const FixedArray& v) {
+            for (Size i=0; i<N; ++i)
+                data_[i] *= v.data_[i];
+            return *this;
+        }
+        const FixedArray& operator*=(Real x) {
+            for (Size i=0; i<N; ++i)
+                data_[i] *= x;
+            return *this;
+        }
+        const FixedArray& operator/=(const FixedArray& v) {
+            for (Size i=0; i<N; ++i)
+                data_[i] /= v.data_[i];
+            return *this;
+        }
+        const FixedArray& operator/=(Real x) {
+            for (Size i=0; i<N; ++i)
+                data_[i] /= x;
+            return *this;
+        }
+        bool operator==(const FixedArray& v) const {
+            return std::equal(data_, data_+N, v.data_);
+        }
+        bool operator!=(const FixedArray& v) const {
+            return !(*this == v);
+        }
+        //@}
+        //! \name Element access
+        //@{
+        Real operator[](Size i) const {
+            #if defined(QL_EXTRA_SAFETY_CHECKS)
+            QL_REQUIRE(i<N,
+                       "index (" << i << ") must be less than " << N <<
+                       ": array access out of range");
+            #endif
+            return data_[i];
+        }
+        Real& operator[](Size i) {
+            #if defined(QL_EXTRA_SAFETY_CHECKS)
+            QL_REQUIRE(i<N,
+                       "index (" << i << ") must be less than " << N <<
+                       ": array access out of range");
+            #endif
+            return data_[i];
+        }
+        //@}
+        //! \name Inspectors
+        //@{
+        //! dimension of the array
+        static Size size() { return N; }
+        //@}
+        typedef Size size_type;
+        typedef Real value_type;
+        typedef Real* iterator;
+        typedef const Real* const_iterator;
+        //! \name Iterator access
+        //@{
+        const_iterator begin() const { return data_; }
+        iterator begin() { return data_; }
+        const_iterator end() const { return data_+N; }
+        iterator end() { return data_+N; }
+        //@}
+      private:
+        Real data_[N];
+    };
+
+
+    /*! \relates FixedArray */
+    template <Size N>
+    inline FixedArray<N> operator-(const FixedArray<N>& v) {
+        FixedArray<N> result;
+        for (Size i=0; i<N; ++i)
+            result[i] = -v[i];
+        return result;
+    }
+
+    /*! \relates FixedArray */
+    template <Size N>
+    inline FixedArray<N> operator+(FixedArray<N> v1, const FixedArray<N>& v2) {
+        return v1 += v2;
+    }
+
+    /*! \relates FixedArray */
+    template <Size N>
+    inline FixedArray<N> operator-(FixedArray<N> v1, const FixedArray<N>& v2) {
+        return v1 -= v2;
+    }
+
+    /*! \relates FixedArray */
+    template <Size N>
+    inline FixedArray<N> operator*(FixedArray<N> v1, const FixedArray<N>& v2) {
+        return v1 *= v2;
+    }
+
+    /*! \relates FixedArray */
+    template <Size N>
+    inline FixedArray<N> operator*(FixedArray<N> v, Real a) {
+        return v *= a;
+    }
+
+    /*! \relates FixedArray */
+    template <Size N>
+    inline FixedArray<N> operator*(Real a, FixedArray<N> v) {
+        return v *= a;
+    }
+
+    /*! \relates FixedArray */
+    template <Size N>
+    inline FixedArray<N> operator/(FixedArray<N> v, Real a) {
+        return v /= a;
+    }
+
+    /*! \relates FixedArray */
+    template <Size N>
+    inline Real DotProduct(const FixedArray<N>& v1, const FixedArray<N>& v2) {
+        Real result = 0.0;
+        for (Size i=0; i<N; ++i)
+            result += v1[i]*v2[i];
+        return result;
+    }
+
+    /*! \relates FixedArray */
+    template <Size N>
+    inline Real Norm2(const FixedArray<N>& v) {
+        return std::sqrt(DotProduct(v, v));
+    }
+
+    /*! \relates FixedArray */
+    template <Size N>
+    inline std::ostream& operator<<(std::ostream& out,
+                                    const FixedArray<N>& a) {
+        std::streamsize width = out.width();
+        out << "[ ";
+        for (Size n=0; n<N-1; ++n)
+            out << std::setw(int(width)) << a[n] << "; ";
+        out << std::setw(int(width)) << a[N-1];
+        out << " ]";
+        return out;
+    }
+
+}
+
+
+#endif
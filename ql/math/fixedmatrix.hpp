@@ -0,0 +1,221 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fixedmatrix.hpp
+    \brief matrix with sizes known at compile time
+*/
+
+#ifndef quantlib_fixed_matrix_hpp
+#define quantlib_fixed_matrix_hpp
+
+#include <ql/math/fixedarray.hpp>
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! matrix with sizes known at compile time
+    /*! This class is the counterpart of FixedArray for matrices: the
+        \f$ R \times C \f$ elements are stored inside the object in
+        row-major order, and no heap allocation is performed.
+
+        Unlike Matrix, the elements are not initialized unless a
+        value is passed to the constructor.
+    */
+    template <Size R, Size C>
+    class FixedMatrix {
+        BOOST_STATIC_ASSERT(R > 0 && C > 0);
+      public:
+        //! \name Constructors
+        //@{
+        FixedMatrix() {}
+        //! creates the matrix and fills it with <tt>value</tt>
+        explicit FixedMatrix(Real value) {
+            std::fill(data_, data_+R*C, value);
+        }
+        /*! creates the matrix from a dynamic one
+            \pre the sizes of the given matrix must be R and C
+        */
+        explicit FixedMatrix(const Matrix& from) {
+            QL_REQUIRE(from.rows() == R && from.columns() == C,
+                       R << "x" << C << " matrix cannot be initialized "
+                       "from a " << from.rows() << "x" << from.columns()
+                       << " matrix");
+            std::copy(from.begin(), from.end(), data_);
+        }
+        //@}
+        //! \name Conversion
+        //@{
+        //! returns a dynamic matrix with the same elements
+        Disposable<Matrix> toMatrix() const {
+            Matrix result(R, C);
+            std::copy(data_, data_+R*C, result.begin());
+            return result;
+        }
+        //@}
+        //! \name Algebraic operators
+        //@{
+        const FixedMatrix& operator+=(const FixedMatrix& m) {
+            for (Size i=0; i<R*C; ++i)
+                data_[i] += m.data_[i];
+            return *this;
+        }
+        const FixedMatrix& operator-=(const FixedMatrix& m) {
+            for (Size i=0; i<R*C; ++i)
+                data_[i] -= m.data_[i];
+            return *this;
+        }
+        const FixedMatrix& operator*=(Real x) {
+            for (Size i=0; i<R*C; ++i)
+                data_[i] *= x;
+            return *this;
+        }
+        const FixedMatrix& operator/=(Real x) {
+            for (Size i=0; i<R*C; ++i)
+                data_[i] /= x;
+            return *this;
+        }
+        //@}
+        //! \name Element access
+        //@{
+        //! returns the beginning of the i-th row
+        const Real* operator[](Size i) const {
+            #if defined(QL_EXTRA_SAFETY_CHECKS)
+            QL_REQUIRE(i<R,
+                       "row index (" << i << ") must be less than " << R <<
+                       ": matrix cannot be accessed out of range");
+            #endif
+            return data_+i*C;
+        }
+        Real* operator[](Size i) {
+            #if defined(QL_EXTRA_SAFETY_CHECKS)
+            QL_REQUIRE(i<R,
+                       "row index (" << i << ") must be less than " << R <<
+                       ": matrix cannot be accessed out of range");
+            #endif
+            return data_+i*C;
+        }
+        //@}
+        //! \name Inspectors
+        //@{
+        static Size rows() { return R; }
+        static Size columns() { return C; }
+        //@}
+        typedef Real* iterator;
+        typedef const Real* const_iterator;
+        //! \name Iterator access
+        //@{
+        const_iterator begin() const { return data_; }
+        iterator begin() { return data_; }
+        const_iterator end() const { return data_+R*C; }
+        iterator end() { return data_+R*C; }
+        //@}
+      private:
+        Real data_[R*C];
+    };
+
+
+    /*! \relates FixedMatrix */
+    template <Size R, Size C>
+    inline FixedMatrix<R,C> operator+(FixedMatrix<R,C> m1,
+                                      const FixedMatrix<R,C>& m2) {
+        return m1 += m2;
+    }
+
+    /*! \relates FixedMatrix */
+    template <Size R, Size C>
+    inline FixedMatrix<R,C> operator-(FixedMatrix<R,C> m1,
+                                      const FixedMatrix<R,C>& m2) {
+        return m1 -= m2;
+    }
+
+    /*! \relates FixedMatrix */
+    template <Size R, Size C>
+    inline FixedMatrix<R,C> operator*(FixedMatrix<R,C> m, Real x) {
+        return m *= x;
+    }
+
+    /*! \relates FixedMatrix */
+    template <Size R, Size C>
+    inline FixedMatrix<R,C> operator*(Real x, FixedMatrix<R,C> m) {
+        return m *= x;
+    }
+
+    /*! \relates FixedMatrix */
+    template <Size R, Size C>
+    inline FixedArray<R> operator*(const FixedMatrix<R,C>& m,
+                                   const FixedArray<C>& v) {
+        FixedArray<R> result;
+        for (Size i=0; i<R; ++i) {
+            Real sum = 0.0;
+            for (Size j=0; j<C; ++j)
+                sum += m[i][j]*v[j];
+            result[i] = sum;
+        }
+        return result;
+    }
+
+    /*! \relates FixedMatrix */
+    template <Size R, Size C>
+    inline FixedArray<C> operator*(const FixedArray<R>& v,
+                                   const FixedMatrix<R,C>& m) {
+        FixedArray<C> result(0.0);
+        for (Size i=0; i<R; ++i)
+            for (Size j=0; j<C; ++j)
+                result[j] += v[i]*m[i][j];
+        return result;
+    }
+
+    /*! \relates FixedMatrix */
+    template <Size R, Size K, Size C>
+    inline FixedMatrix<R,C> operator*(const FixedMatrix<R,K>& m1,
+                                      const FixedMatrix<K,C>& m2) {
+        FixedMatrix<R,C> result(0.0);
+        for (Size i=0; i<R; ++i)
+            for (Size k=0; k<K; ++k)
+                for (Size j=0; j<C; ++j)
+                    result[i][j] += m1[i][k]*m2[k][j];
+        return result;
+    }
+
+    /*! \relates FixedMatrix */
+    template <Size R, Size C>
+    inline FixedMatrix<C,R> transpose(const FixedMatrix<R,C>& m) {
+        FixedMatrix<C,R> result;
+        for (Size i=0; i<R; ++i)
+            for (Size j=0; j<C; ++j)
+                result[j][i] = m[i][j];
+        return result;
+    }
+
+    /*! \relates FixedMatrix */
+    template <Size R, Size C>
+    inline std::ostream& operator<<(std::ostream& out,
+                                    const FixedMatrix<R,C>& m) {
+        std::streamsize width = out.width();
+        for (Size i=0; i<R; ++i) {
+            out << "| ";
+            for (Size j=0; j<C; ++j)
+                out << std::setw(int(width)) << m[i][j] << " ";
+            out << "|\n";
+        }
+        return out;
+    }
+
+}
+
+
+#endif
@@ -0,0 +1,141 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/hugepageallocator.hpp>
+#include <new>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace QuantLib {
+
+    namespace {
+
+        const Size hugePageSize = 2*1024*1024;
+
+        #if defined(__linux__)
+
+        Size systemPageSize() {
+            long size = sysconf(_SC_PAGESIZE);
+            return size > 0 ? Size(size) : Size(4096);
+        }
+
+        // maps length bytes aligned on a huge page, so that they can
+        // be backed by transparent huge pages
+        void* mapAligned(Size length) {
+            Size mapped = length + hugePageSize;
+            void* p = mmap(0, mapped, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                return p;
+            char* begin = static_cast<char*>(p);
+            Size head = (hugePageSize - reinterpret_cast<Size>(begin)
+                                        % hugePageSize) % hugePageSize;
+            if (head > 0)
+                munmap(begin, head);
+            munmap(begin + head + length, mapped - head - length);
+            return begin + head;
+        }
+
+        void interleave(void* p, Size length) {
+            #if defined(SYS_mbind)
+            // all the nodes; the kernel restricts them to those
+            // available to the process.  Errors are ignored, since
+            // the default policy is still a valid placement.
+            const int MPOL_INTERLEAVE_ = 3;
+            unsigned long nodes = ~0UL;
+            syscall(SYS_mbind, p, length, MPOL_INTERLEAVE_, &nodes,
+                    8*sizeof(nodes) + 1, 0);
+            #endif
+        }
+
+        void touch(void* p, Size length) {
+            char* begin = static_cast<char*>(p);
+            const Size page = systemPageSize();
+            const Size pages = length/page;
+            // the same static partition as the loops over the mesh
+            #pragma omp parallel for schedule(static)
+            for (Size i=0; i<pages; ++i)
+                begin[i*page] = 0;
+        }
+
+        #endif
+
+    }
+
+    HugePageAllocator::HugePageAllocator(bool hugePages,
+                                         Placement placement)
+    : hugePages_(hugePages), placement_(placement) {}
+
+    Size HugePageAllocator::pageSize() const {
+        #if defined(__linux__)
+        return hugePages_ ? hugePageSize : systemPageSize();
+        #else
+        return 1;
+        #endif
+    }
+
+    Size HugePageAllocator::mappedLength(Size bytes) const {
+        Size page = pageSize();
+        return ((bytes + page - 1)/page)*page;
+    }
+
+    void* HugePageAllocator::allocate(Size bytes) {
+        #if defined(__linux__)
+        const Size length = mappedLength(bytes);
+        void* p = MAP_FAILED;
+        if (hugePages_) {
+            #if defined(MAP_HUGETLB)
+            // reserved huge pages, if any
+            p = mmap(0, length, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            #endif
+            if (p == MAP_FAILED) {
+                p = mapAligned(length);
+                #if defined(MADV_HUGEPAGE)
+                if (p != MAP_FAILED)
+                    madvise(p, length, MADV_HUGEPAGE);
+                #endif
+            }
+        } else {
+            p = mmap(0, length, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        }
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+
+        if (placement_ == Interleaved)
+            interleave(p, length);
+        else if (placement_ == ParallelFirstTouch)
+            touch(p, length);
+        return p;
+        #else
+        return ::operator new(bytes);
+        #endif
+    }
+
+    void HugePageAllocator::deallocate(void* p, Size bytes) {
+        #if defined(__linux__)
+        munmap(p, mappedLength(bytes));
+        #else
+        ::operator delete(p);
+        #endif
+    }
+
+}
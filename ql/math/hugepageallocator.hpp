@@ -0,0 +1,85 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file hugepageallocator.hpp
+    \brief allocation of large buffers on huge pages and NUMA nodes
+*/
+
+#ifndef quantlib_huge_page_allocator_hpp
+#define quantlib_huge_page_allocator_hpp
+
+#include <ql/math/memorypool.hpp>
+
+namespace QuantLib {
+
+    //! allocation of large buffers on huge pages and NUMA nodes
+    /*! The buffers are mapped directly from the operating system.
+        When huge pages are requested, their size is rounded up to a
+        multiple of 2MB; explicitly reserved huge pages are used if
+        available, and transparent huge pages are requested
+        otherwise.  This reduces the TLB misses of the sweeps over
+        large finite-difference meshes.
+
+        The pages of a buffer can be placed in different ways on a
+        NUMA machine:
+        - FirstTouch leaves the choice to the operating system, which
+          usually places each page on the node of the thread writing
+          it first; when a buffer is initialized by a single thread,
+          all of it ends up on one node.
+        - Interleaved distributes the pages among all the nodes in a
+          round-robin fashion, which balances the memory bandwidth
+          available to the threads regardless of the way they
+          partition the work.
+        - ParallelFirstTouch writes the pages when the buffer is
+          allocated, from a parallel loop with static schedule.  Each
+          page is thus placed on the node of the thread to which the
+          static partition of the OpenMP loops over the mesh assigns
+          it, e.g., in TripleBandLinearOp::apply or in the sweeps
+          along the first direction of the layout; it is the best
+          choice when the thread count and affinity are fixed.
+
+        Typical use:
+        \code
+        MemoryPool::setLargeBufferAllocator(
+            boost::make_shared<HugePageAllocator>(
+                true, HugePageAllocator::ParallelFirstTouch),
+            1 << 16);
+        \endcode
+
+        Huge pages and placement are only available on Linux; on
+        other platforms, the buffers are obtained from the heap.  The
+        placement is a hint: if the system doesn't support it, the
+        default policy is used.
+    */
+    class HugePageAllocator : public LargeBufferAllocator {
+      public:
+        enum Placement { FirstTouch, Interleaved, ParallelFirstTouch };
+        explicit HugePageAllocator(bool hugePages = true,
+                                   Placement placement = FirstTouch);
+        void* allocate(Size bytes);
+        void deallocate(void* p, Size bytes);
+        //! size of the pages used for the buffers
+        Size pageSize() const;
+      private:
+        Size mappedLength(Size bytes) const;
+        bool hugePages_;
+        Placement placement_;
+    };
+
+}
+
+#endif
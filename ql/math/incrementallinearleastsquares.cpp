@@ -0,0 +1,85 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/incrementallinearleastsquares.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
+
+namespace QuantLib {
+
+    IncrementalLinearLeastSquares::IncrementalLinearLeastSquares(
+                                                              Size dimension)
+    : samples_(0), r_(dimension, dimension, 0.0),
+      qty_(dimension, 0.0), row_(dimension) {
+        QL_REQUIRE(dimension > 0, "null dimension");
+    }
+
+    void IncrementalLinearLeastSquares::update(Real y) {
+        const Size m = row_.size();
+        // rotate the new row into the triangular factor, zeroing
+        // one element at a time
+        for (Size k=0; k<m; ++k) {
+            const Real a = row_[k];
+            if (a == 0.0)
+                continue;
+            const Real d = r_[k][k];
+            const Real h = std::sqrt(d*d + a*a);
+            const Real c = d/h, s = a/h;
+            r_[k][k] = h;
+            for (Size j=k+1; j<m; ++j) {
+                const Real t = r_[k][j];
+                r_[k][j] = c*t + s*row_[j];
+                row_[j] = c*row_[j] - s*t;
+            }
+            const Real t = qty_[k];
+            qty_[k] = c*t + s*y;
+            y = c*y - s*t;
+        }
+        ++samples_;
+    }
+
+    Disposable<Array> IncrementalLinearLeastSquares::coefficients() const {
+        const Size m = row_.size();
+
+        // same solution and threshold as GeneralLinearLeastSquares,
+        // since the design matrix and its triangular factor have the
+        // same singular values
+        const SVD svd(r_);
+        const Matrix& V = svd.V();
+        const Matrix& U = svd.U();
+        const Array& w = svd.singularValues();
+        const Real threshold = samples_ * QL_EPSILON * w[0];
+
+        Array a(m, 0.0);
+        for (Size i=0; i<m; ++i) {
+            if (w[i] > threshold) {
+                const Real u = std::inner_product(U.column_begin(i),
+                                                  U.column_end(i),
+                                                  qty_.begin(), 0.0)/w[i];
+                for (Size j=0; j<m; ++j)
+                    a[j] += u*V[j][i];
+            }
+        }
+        return a;
+    }
+
+    void IncrementalLinearLeastSquares::reset() {
+        samples_ = 0;
+        std::fill(r_.begin(), r_.end(), 0.0);
+        std::fill(qty_.begin(), qty_.end(), 0.0);
+    }
+
+}
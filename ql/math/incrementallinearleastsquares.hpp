@@ -0,0 +1,78 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file incrementallinearleastsquares.hpp
+    \brief linear least-squares regression accumulated one sample at a time
+*/
+
+#ifndef quantlib_incremental_linear_least_squares_hpp
+#define quantlib_incremental_linear_least_squares_hpp
+
+#include <ql/math/matrix.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    //! linear least-squares regression accumulated one sample at a time
+    /*! The samples are not stored; instead, each one is used to update
+        the QR decomposition of the design matrix by means of Givens
+        rotations, which only requires the \f$ m \times m \f$ triangular
+        factor and the transformed targets.  The memory needed is
+        therefore independent of the number of samples, and no
+        \f$ n \times m \f$ matrix is built.
+
+        The coefficients are obtained from the singular-value
+        decomposition of the triangular factor, with the same
+        threshold on the singular values as GeneralLinearLeastSquares;
+        the two classes return the same fit up to rounding.
+
+        \test the results are checked against GeneralLinearLeastSquares.
+    */
+    class IncrementalLinearLeastSquares {
+      public:
+        explicit IncrementalLinearLeastSquares(Size dimension);
+        //! adds a sample given the values of the basis functions
+        template <class Iterator>
+        void add(Iterator begin, Iterator end, Real y) {
+            QL_REQUIRE(Size(std::distance(begin, end)) == row_.size(),
+                       "wrong number of basis values ("
+                       << std::distance(begin, end) << " instead of "
+                       << row_.size() << ")");
+            std::copy(begin, end, row_.begin());
+            update(y);
+        }
+        void add(const Array& x, Real y) { add(x.begin(), x.end(), y); }
+        //! number of samples added
+        Size size() const { return samples_; }
+        //! number of basis functions
+        Size dim() const { return row_.size(); }
+        //! least-squares coefficients of the basis functions
+        /*! If fewer than dim() samples were added, the solution of
+            minimum norm is returned.
+        */
+        Disposable<Array> coefficients() const;
+        void reset();
+      private:
+        void update(Real y);
+        Size samples_;
+        Matrix r_;
+        Array qty_, row_;
+    };
+
+}
+
+#endif
@@ -25,14 +25,95 @@
 #include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/math/matrixutilities/tqreigendecomposition.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <algorithm>
+#include <map>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace {
+
+        struct QuadratureRule {
+            std::string name;
+            Size order;
+            Real parameter1, parameter2;
+
+            bool operator<(const QuadratureRule& r) const {
+                if (name != r.name)
+                    return name < r.name;
+                if (order != r.order)
+                    return order < r.order;
+                if (parameter1 != r.parameter1)
+                    return parameter1 < r.parameter1;
+                return parameter2 < r.parameter2;
+            }
+        };
+
+        // std::vector rather than Array, whose storage might come from
+        // the memory pool of the thread that filled the cache
+        struct QuadratureNodes {
+            std::vector<Real> x, w;
+        };
+
+        typedef std::map<QuadratureRule, QuadratureNodes> QuadratureCache;
+
+        QuadratureCache& quadratureCache() {
+            static QuadratureCache cache;
+            return cache;
+        }
+
+    }
+
     GaussianQuadrature::GaussianQuadrature(
                                 Size n,
                                 const GaussianOrthogonalPolynomial& orthPoly)
     : x_(n), w_(n) {
+        calculate(n, orthPoly);
+    }
 
+    GaussianQuadrature::GaussianQuadrature(
+                                Size n,
+                                const GaussianOrthogonalPolynomial& orthPoly,
+                                const std::string& rule,
+                                Real parameter1,
+                                Real parameter2)
+    : x_(n), w_(n) {
+        QuadratureRule key;
+        key.name = rule;
+        key.order = n;
+        key.parameter1 = parameter1;
+        key.parameter2 = parameter2;
+
+        bool cached = false;
+        #pragma omp critical(ql_gaussian_quadrature_cache)
+        {
+            const QuadratureCache& cache = quadratureCache();
+            QuadratureCache::const_iterator i = cache.find(key);
+            if (i != cache.end()) {
+                std::copy(i->second.x.begin(), i->second.x.end(),
+                          x_.begin());
+                std::copy(i->second.w.begin(), i->second.w.end(),
+                          w_.begin());
+                cached = true;
+            }
+        }
+        if (cached)
+            return;
+
+        // calculated outside the critical section, which exceptions
+        // can't leave; concurrent first requests may do it twice
+        calculate(n, orthPoly);
+        #pragma omp critical(ql_gaussian_quadrature_cache)
+        {
+            QuadratureNodes& nodes = quadratureCache()[key];
+            nodes.x.assign(x_.begin(), x_.end());
+            nodes.w.assign(w_.begin(), w_.end());
+        }
+    }
+
+    void GaussianQuadrature::calculate(
+                                Size n,
+                                const GaussianOrthogonalPolynomial& orthPoly) {
         // set-up matrix to compute the roots and the weights
         Array e(n-1);
 
@@ -77,6 +158,30 @@ namespace QuantLib {
         }
     }
 
+    Disposable<Array> TabulatedGaussLegendre::x() const {
+        Array result(order_);
+        const Size isOrderOdd = order_ & 1;
+        if (isOrderOdd)
+            result[0] = x_[0];
+        for (Size i=isOrderOdd, j=isOrderOdd; i<n_; ++i) {
+            result[j++] =  x_[i];
+            result[j++] = -x_[i];
+        }
+        return result;
+    }
+
+    Disposable<Array> TabulatedGaussLegendre::weights() const {
+        Array result(order_);
+        const Size isOrderOdd = order_ & 1;
+        if (isOrderOdd)
+            result[0] = w_[0];
+        for (Size i=isOrderOdd, j=isOrderOdd; i<n_; ++i) {
+            result[j++] = w_[i];
+            result[j++] = w_[i];
+        }
+        return result;
+    }
+
 
     // Abscissas and Weights from Abramowitz and Stegun
 
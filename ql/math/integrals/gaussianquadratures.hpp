@@ -27,6 +27,7 @@
 
 #include <ql/math/array.hpp>
 #include <ql/math/integrals/gaussianorthogonalpolynomial.hpp>
+#include <string>
 
 namespace QuantLib {
     class GaussianOrthogonalPolynomial;
@@ -41,6 +42,10 @@ namespace QuantLib {
         "Numerical Recipes in C", 2nd edition,
         Press, Teukolsky, Vetterling, Flannery,
 
+        The nodes and weights of the predefined rules below are
+        calculated once per process for each order and set of
+        parameters and then shared by all instances.
+
         \test the correctness of the result is tested by checking it
               against known good values.
     */
@@ -58,12 +63,42 @@ namespace QuantLib {
             return sum;
         }
 
+        //! integrand evaluated on all nodes at once
+        /*! f takes the array of the nodes and returns the array of
+            the values of the integrand at the nodes.
+        */
+        template <class F>
+        Real integrateOnNodes(const F& f) const {
+            const Array values = f(x_);
+            QL_REQUIRE(values.size() == order(),
+                       values.size() << " values returned for "
+                       << order() << " nodes");
+            Real sum = 0.0;
+            for (Integer i = order()-1; i >= 0; --i) {
+                sum += w_[i] * values[i];
+            }
+            return sum;
+        }
+
         Size order() const { return x_.size(); }
-        const Array& weights() { return w_; }
-        const Array& x()       { return x_; }
+        const Array& weights() const { return w_; }
+        const Array& x() const       { return x_; }
         
       protected:
+        /*! The nodes and weights are stored in a process-wide cache
+            under the given rule name and parameters, which must
+            identify the polynomial; they're only calculated the
+            first time the rule is requested with the given order.
+        */
+        GaussianQuadrature(Size n,
+                           const GaussianOrthogonalPolynomial& p,
+                           const std::string& rule,
+                           Real parameter1 = 0.0,
+                           Real parameter2 = 0.0);
+
         Array x_, w_;
+      private:
+        void calculate(Size n, const GaussianOrthogonalPolynomial& p);
     };
 
 
@@ -81,7 +116,7 @@ namespace QuantLib {
     class GaussLaguerreIntegration : public GaussianQuadrature {
       public:
         GaussLaguerreIntegration(Size n, Real s = 0.0)
-        : GaussianQuadrature(n, GaussLaguerrePolynomial(s)) {}
+        : GaussianQuadrature(n, GaussLaguerrePolynomial(s), "Laguerre", s) {}
     };
 
     //! generalized Gauss-Hermite integration
@@ -98,7 +133,7 @@ namespace QuantLib {
     class GaussHermiteIntegration : public GaussianQuadrature {
       public:
         GaussHermiteIntegration(Size n, Real mu = 0.0)
-        : GaussianQuadrature(n, GaussHermitePolynomial(mu)) {}
+        : GaussianQuadrature(n, GaussHermitePolynomial(mu), "Hermite", mu) {}
     };
 
     //! Gauss-Jacobi integration
@@ -114,7 +149,8 @@ namespace QuantLib {
     class GaussJacobiIntegration : public GaussianQuadrature {
       public:
         GaussJacobiIntegration(Size n, Real alpha, Real beta)
-        : GaussianQuadrature(n, GaussJacobiPolynomial(alpha, beta)) {}
+        : GaussianQuadrature(n, GaussJacobiPolynomial(alpha, beta),
+                             "Jacobi", alpha, beta) {}
     };
 
     //! Gauss-Hyperbolic integration
@@ -130,7 +166,7 @@ namespace QuantLib {
     class GaussHyperbolicIntegration : public GaussianQuadrature {
       public:
         GaussHyperbolicIntegration(Size n)
-        : GaussianQuadrature(n, GaussHyperbolicPolynomial()) {}
+        : GaussianQuadrature(n, GaussHyperbolicPolynomial(), "Hyperbolic") {}
     };
 
     //! Gauss-Legendre integration
@@ -146,7 +182,8 @@ namespace QuantLib {
     class GaussLegendreIntegration : public GaussianQuadrature {
       public:
         GaussLegendreIntegration(Size n)
-        : GaussianQuadrature(n, GaussJacobiPolynomial(0.0, 0.0)) {}
+        : GaussianQuadrature(n, GaussJacobiPolynomial(0.0, 0.0),
+                             "Jacobi", 0.0, 0.0) {}
     };
 
     //! Gauss-Chebyshev integration
@@ -162,7 +199,8 @@ namespace QuantLib {
     class GaussChebyshevIntegration : public GaussianQuadrature {
       public:
         GaussChebyshevIntegration(Size n)
-        : GaussianQuadrature(n, GaussJacobiPolynomial(-0.5, -0.5)) {}
+        : GaussianQuadrature(n, GaussJacobiPolynomial(-0.5, -0.5),
+                             "Jacobi", -0.5, -0.5) {}
     };
 
     //! Gauss-Chebyshev integration (second kind)
@@ -178,7 +216,8 @@ namespace QuantLib {
     class GaussChebyshev2ndIntegration : public GaussianQuadrature {
       public:
         GaussChebyshev2ndIntegration(Size n)
-      : GaussianQuadrature(n, GaussJacobiPolynomial(0.5, 0.5)) {}
+      : GaussianQuadrature(n, GaussJacobiPolynomial(0.5, 0.5),
+                           "Jacobi", 0.5, 0.5) {}
     };
 
     //! Gauss-Gegenbauer integration
@@ -194,8 +233,8 @@ namespace QuantLib {
     class GaussGegenbauerIntegration : public GaussianQuadrature {
       public:
         GaussGegenbauerIntegration(Size n, Real lambda)
-        : GaussianQuadrature(n, GaussJacobiPolynomial(lambda-0.5, lambda-0.5))
-        {}
+        : GaussianQuadrature(n, GaussJacobiPolynomial(lambda-0.5, lambda-0.5),
+                             "Jacobi", lambda-0.5, lambda-0.5) {}
     };
 
 
@@ -230,6 +269,10 @@ namespace QuantLib {
 
         void order(Size);
         Size order() const { return order_; }
+        //! abscissas, in the order in which they are summed
+        Disposable<Array> x() const;
+        //! weights, in the order in which they are summed
+        Disposable<Array> weights() const;
 
       private:
         Size order_;
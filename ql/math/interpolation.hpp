@@ -28,7 +28,13 @@
 
 #include <ql/math/interpolations/extrapolation.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/math/array.hpp>
 #include <ql/errors.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 105300
+#include <boost/atomic.hpp>
+#define QL_INTERPOLATION_HINT
+#endif
 #include <vector>
 
 namespace QuantLib {
@@ -38,6 +44,17 @@ namespace QuantLib {
         values from two sequences of equal length, representing
         discretized values of a variable and a function of the former,
         respectively.
+
+        The interval containing the last requested point is stored and
+        checked first at the next request, together with the following
+        one; this makes requests for increasing values of x, as
+        happens when an interpolation is sampled on a grid, cost a
+        constant time instead of a binary search.  The stored
+        interval is an atomic variable accessed with relaxed ordering
+        and is validated before use, so that concurrent calls to an
+        instance (or to copies sharing its implementation) are safe;
+        with Boost versions lacking Boost.Atomic, a binary search is
+        performed at each request.
     */
     class Interpolation : public Extrapolator {
       protected:
@@ -67,6 +84,9 @@ namespace QuantLib {
             templateImpl(const I1& xBegin, const I1& xEnd, const I2& yBegin,
                          const int requiredPoints = 2)
             : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin) {
+                #if defined(QL_INTERPOLATION_HINT)
+                hint_.store(0, boost::memory_order_relaxed);
+                #endif
                 QL_REQUIRE(static_cast<int>(xEnd_-xBegin_) >= requiredPoints,
                            "not enough points to interpolate: at least " <<
                            requiredPoints <<
@@ -102,11 +122,32 @@ namespace QuantLib {
                     return 0;
                 else if (x > *(xEnd_-1))
                     return xEnd_-xBegin_-2;
-                else
-                    return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                #if defined(QL_INTERPOLATION_HINT)
+                // the interval of the last call and the next one are
+                // checked first; the last interval is closed
+                Size n = xEnd_-xBegin_,
+                     i = hint_.load(boost::memory_order_relaxed);
+                if (i+1 < n && *(xBegin_+i) <= x) {
+                    if (i+2 == n || x < *(xBegin_+i+1))
+                        return i;
+                    ++i;
+                    if (i+2 == n || x < *(xBegin_+i+1)) {
+                        hint_.store(i, boost::memory_order_relaxed);
+                        return i;
+                    }
+                }
+                i = std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                hint_.store(i, boost::memory_order_relaxed);
+                return i;
+                #else
+                return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                #endif
             }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
+            #if defined(QL_INTERPOLATION_HINT)
+            mutable boost::atomic<Size> hint_;
+            #endif
         };
       public:
         Interpolation() {}
@@ -116,6 +157,19 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        //! interpolated values at a sequence of points
+        /*! Increasing sequences are the most efficient; see the
+            class documentation.
+        */
+        void operator()(const Array& x, Array& y,
+                        bool allowExtrapolation = false) const {
+            if (y.size() != x.size())
+                y = Array(x.size());
+            for (Size i=0; i<x.size(); ++i) {
+                checkRange(x[i],allowExtrapolation);
+                y[i] = impl_->value(x[i]);
+            }
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
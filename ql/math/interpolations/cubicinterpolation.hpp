@@ -93,6 +93,11 @@ namespace QuantLib {
         Quintic Hermite Interpolation"
         Mathematics Of Computation, v. 52, n. 186, April 1989, pp. 471-494.
 
+        When the interpolation is updated after some of the $f_i$ values
+        changed (as it happens, e.g., during a bootstrap) the local schemes
+        only recalculate the coefficients of the affected segments, and the
+        spline schemes reuse the factorization of their linear system.
+
         \todo implement missing schemes (FourthOrder and ModifiedParabolic) and
               missing boundary conditions (Periodic and Lagrange).
 
@@ -378,7 +383,7 @@ namespace QuantLib {
               leftType_(leftCondition), rightType_(rightCondition),
               leftValue_(leftConditionValue),
               rightValue_(rightConditionValue),
-              tmp_(n_), dx_(n_-1), S_(n_-1), L_(n_) {
+              tmp_(n_), dx_(n_-1), S_(n_-1), L_(n_), D_(n_) {
                 if (leftType_ == CubicInterpolation::Lagrange
                     || rightType_ == CubicInterpolation::Lagrange) {
                     QL_REQUIRE((xEnd-xBegin) >= 4,
@@ -389,354 +394,98 @@ namespace QuantLib {
 
             void update() {
 
-                for (Size i=0; i<n_-1; ++i) {
-                    dx_[i] = this->xBegin_[i+1] - this->xBegin_[i];
+                // the nodes and values of the last call are stored, so
+                // that only the changed parts need to be recalculated
+                bool newNodes = (xValues_.size() != n_);
+                for (Size i=0; i<n_ && !newNodes; ++i)
+                    newNodes = (this->xBegin_[i] != xValues_[i]);
+                Size first = 0, last = n_-1;
+                if (newNodes) {
+                    xValues_.resize(n_);
+                    yValues_.resize(n_);
+                    for (Size i=0; i<n_; ++i)
+                        xValues_[i] = this->xBegin_[i];
+                    for (Size i=0; i<n_-1; ++i)
+                        dx_[i] = this->xBegin_[i+1] - this->xBegin_[i];
+                } else {
+                    while (first < n_ && this->yBegin_[first] == yValues_[first])
+                        ++first;
+                    if (first == n_)
+                        return;
+                    while (this->yBegin_[last] == yValues_[last])
+                        --last;
+                }
+                for (Size i=first; i<=last; ++i)
+                    yValues_[i] = this->yBegin_[i];
+
+                // slopes of the segments adjacent to the changed values
+                Size sFirst = (first > 0 ? first-1 : 0);
+                Size sLast = std::min(last, n_-2);
+                for (Size i=sFirst; i<=sLast; ++i)
                     S_[i] = (this->yBegin_[i+1] - this->yBegin_[i])/dx_[i];
+
+                // derivatives to be recalculated: all of them for the
+                // global schemes; for the local ones (and for the Hyman
+                // filter) the i-th depends on the slopes S[i-2]...S[i+1]
+                Size dFirst = 0, dLast = n_-1;
+                if (da_ != CubicInterpolation::Spline &&
+                    da_ != CubicInterpolation::SplineOM1 &&
+                    da_ != CubicInterpolation::SplineOM2) {
+                    dFirst = (sFirst > 0 ? sFirst-1 : 0);
+                    dLast = std::min(sLast+2, n_-1);
                 }
 
                 // first derivative approximation
                 if (da_==CubicInterpolation::Spline) {
-                    for (Size i=1; i<n_-1; ++i) {
-                        L_.setMidRow(i, dx_[i], 2.0*(dx_[i]+dx_[i-1]), dx_[i-1]);
-                        tmp_[i] = 3.0*(dx_[i]*S_[i-1] + dx_[i-1]*S_[i]);
-                    }
-
-                    // left boundary condition
-                    switch (leftType_) {
-                      case CubicInterpolation::NotAKnot:
-                        // ignoring end condition value
-                        L_.setFirstRow(dx_[1]*(dx_[1]+dx_[0]),
-                                      (dx_[0]+dx_[1])*(dx_[0]+dx_[1]));
-                        tmp_[0] = S_[0]*dx_[1]*(2.0*dx_[1]+3.0*dx_[0]) +
-                                 S_[1]*dx_[0]*dx_[0];
-                        break;
-                      case CubicInterpolation::FirstDerivative:
-                        L_.setFirstRow(1.0, 0.0);
-                        tmp_[0] = leftValue_;
-                        break;
-                      case CubicInterpolation::SecondDerivative:
-                        L_.setFirstRow(2.0, 1.0);
-                        tmp_[0] = 3.0*S_[0] - leftValue_*dx_[0]/2.0;
-                        break;
-                      case CubicInterpolation::Periodic:
-                        QL_FAIL("this end condition is not implemented yet");
-                      case CubicInterpolation::Lagrange:
-                        L_.setFirstRow(1.0, 0.0);
-                        tmp_[0] = cubicInterpolatingPolynomialDerivative(
-                                            this->xBegin_[0],this->xBegin_[1],
-                                            this->xBegin_[2],this->xBegin_[3],
-                                            this->yBegin_[0],this->yBegin_[1],
-                                            this->yBegin_[2],this->yBegin_[3],
-                                            this->xBegin_[0]);
-                        break;
-                      default:
-                        QL_FAIL("unknown end condition");
-                    }
-
-                    // right boundary condition
-                    switch (rightType_) {
-                      case CubicInterpolation::NotAKnot:
-                        // ignoring end condition value
-                        L_.setLastRow(-(dx_[n_-2]+dx_[n_-3])*(dx_[n_-2]+dx_[n_-3]),
-                                     -dx_[n_-3]*(dx_[n_-3]+dx_[n_-2]));
-                        tmp_[n_-1] = -S_[n_-3]*dx_[n_-2]*dx_[n_-2] -
-                                     S_[n_-2]*dx_[n_-3]*(3.0*dx_[n_-2]+2.0*dx_[n_-3]);
-                        break;
-                      case CubicInterpolation::FirstDerivative:
-                        L_.setLastRow(0.0, 1.0);
-                        tmp_[n_-1] = rightValue_;
-                        break;
-                      case CubicInterpolation::SecondDerivative:
-                        L_.setLastRow(1.0, 2.0);
-                        tmp_[n_-1] = 3.0*S_[n_-2] + rightValue_*dx_[n_-2]/2.0;
-                        break;
-                      case CubicInterpolation::Periodic:
-                        QL_FAIL("this end condition is not implemented yet");
-                      case CubicInterpolation::Lagrange:
-                        L_.setLastRow(0.0,1.0);
-                        tmp_[n_-1] = cubicInterpolatingPolynomialDerivative(
-                                      this->xBegin_[n_-4],this->xBegin_[n_-3],
-                                      this->xBegin_[n_-2],this->xBegin_[n_-1],
-                                      this->yBegin_[n_-4],this->yBegin_[n_-3],
-                                      this->yBegin_[n_-2],this->yBegin_[n_-1],
-                                      this->xBegin_[n_-1]);
-                        break;
-                      default:
-                        QL_FAIL("unknown end condition");
-                    }
-
-                    // solve the system
+                    // the operator only depends on the nodes and keeps
+                    // its factorization between calls
+                    if (newNodes)
+                        setSplineOperator();
+                    setSplineRightHandSide();
                     L_.solveFor(tmp_, tmp_);
-                } else if (da_==CubicInterpolation::SplineOM1) {
-                    Matrix T_(n_-2, n_, 0.0);
-                    for (Size i=0; i<n_-2; ++i) {
-                        T_[i][i]=dx_[i]/6.0;
-                        T_[i][i+1]=(dx_[i+1]+dx_[i])/3.0;
-                        T_[i][i+2]=dx_[i+1]/6.0;
-                    }
-                    Matrix S_(n_-2, n_, 0.0);
-                    for (Size i=0; i<n_-2; ++i) {
-                        S_[i][i]=1.0/dx_[i];
-                        S_[i][i+1]=-(1.0/dx_[i+1]+1.0/dx_[i]);
-                        S_[i][i+2]=1.0/dx_[i+1];
-                    }
-                    Matrix Up_(n_, 2, 0.0);
-                    Up_[0][0]=1;
-                    Up_[n_-1][1]=1;
-                    Matrix Us_(n_, n_-2, 0.0);
-                    for (Size i=0; i<n_-2; ++i)
-                        Us_[i+1][i]=1;
-                    Matrix Z_ = Us_*inverse(T_*Us_);
-                    Matrix I_(n_, n_, 0.0);
-                    for (Size i=0; i<n_; ++i)
-                        I_[i][i]=1;
-                    Matrix V_ = (I_-Z_*T_)*Up_;
-                    Matrix W_ = Z_*S_;
-                    Matrix Q_(n_, n_, 0.0);
-                    Q_[0][0]=1.0/(n_-1)*dx_[0]*dx_[0]*dx_[0];
-                    Q_[0][1]=7.0/8*1.0/(n_-1)*dx_[0]*dx_[0]*dx_[0];
-                    for (Size i=1; i<n_-1; ++i) {
-                        Q_[i][i-1]=7.0/8*1.0/(n_-1)*dx_[i-1]*dx_[i-1]*dx_[i-1];
-                        Q_[i][i]=1.0/(n_-1)*dx_[i]*dx_[i]*dx_[i]+1.0/(n_-1)*dx_[i-1]*dx_[i-1]*dx_[i-1];
-                        Q_[i][i+1]=7.0/8*1.0/(n_-1)*dx_[i]*dx_[i]*dx_[i];
+                } else if (da_==CubicInterpolation::SplineOM1 ||
+                           da_==CubicInterpolation::SplineOM2) {
+                    if (newNodes) {
+                        if (da_==CubicInterpolation::SplineOM1)
+                            setSplineOM1Matrix();
+                        else
+                            setSplineOM2Matrix();
                     }
-                    Q_[n_-1][n_-2]=7.0/8*1.0/(n_-1)*dx_[n_-2]*dx_[n_-2]*dx_[n_-2];
-                    Q_[n_-1][n_-1]=1.0/(n_-1)*dx_[n_-2]*dx_[n_-2]*dx_[n_-2];
-                    Matrix J_ = (I_-V_*inverse(transpose(V_)*Q_*V_)*transpose(V_)*Q_)*W_;
-                    Array Y_(n_);
-                    for (Size i=0; i<n_; ++i)
-                        Y_[i]=this->yBegin_[i];
-                    Array D_ = J_*Y_;
-                    for (Size i=0; i<n_-1; ++i)
-                        tmp_[i]=(Y_[i+1]-Y_[i])/dx_[i]-(2.0*D_[i]+D_[i+1])*dx_[i]/6.0;
-                    tmp_[n_-1]=tmp_[n_-2]+D_[n_-2]*dx_[n_-2]+(D_[n_-1]-D_[n_-2])*dx_[n_-2]/2.0;
-
-                } else if (da_==CubicInterpolation::SplineOM2) {
-                    Matrix T_(n_-2, n_, 0.0);
-                    for (Size i=0; i<n_-2; ++i) {
-                        T_[i][i]=dx_[i]/6.0;
-                        T_[i][i+1]=(dx_[i]+dx_[i+1])/3.0;
-                        T_[i][i+2]=dx_[i+1]/6.0;
-                    }
-                    Matrix S_(n_-2, n_, 0.0);
-                    for (Size i=0; i<n_-2; ++i) {
-                        S_[i][i]=1.0/dx_[i];
-                        S_[i][i+1]=-(1.0/dx_[i+1]+1.0/dx_[i]);
-                        S_[i][i+2]=1.0/dx_[i+1];
-                    }
-                    Matrix Up_(n_, 2, 0.0);
-                    Up_[0][0]=1;
-                    Up_[n_-1][1]=1;
-                    Matrix Us_(n_, n_-2, 0.0);
-                    for (Size i=0; i<n_-2; ++i)
-                        Us_[i+1][i]=1;
-                    Matrix Z_ = Us_*inverse(T_*Us_);
-                    Matrix I_(n_, n_, 0.0);
-                    for (Size i=0; i<n_; ++i)
-                        I_[i][i]=1;
-                    Matrix V_ = (I_-Z_*T_)*Up_;
-                    Matrix W_ = Z_*S_;
-                    Matrix Q_(n_, n_, 0.0);
-                    Q_[0][0]=1.0/(n_-1)*dx_[0];
-                    Q_[0][1]=1.0/2*1.0/(n_-1)*dx_[0];
-                    for (Size i=1; i<n_-1; ++i) {
-                        Q_[i][i-1]=1.0/2*1.0/(n_-1)*dx_[i-1];
-                        Q_[i][i]=1.0/(n_-1)*dx_[i]+1.0/(n_-1)*dx_[i-1];
-                        Q_[i][i+1]=1.0/2*1.0/(n_-1)*dx_[i];
+                    for (Size i=0; i<n_; ++i) {
+                        D_[i] = 0.0;
+                        for (Size j=0; j<n_; ++j)
+                            D_[i] += J_[i][j]*this->yBegin_[j];
                     }
-                    Q_[n_-1][n_-2]=1.0/2*1.0/(n_-1)*dx_[n_-2];
-                    Q_[n_-1][n_-1]=1.0/(n_-1)*dx_[n_-2];
-                    Matrix J_ = (I_-V_*inverse(transpose(V_)*Q_*V_)*transpose(V_)*Q_)*W_;
-                    Array Y_(n_);
-                    for (Size i=0; i<n_; ++i)
-                        Y_[i]=this->yBegin_[i];
-                    Array D_ = J_*Y_;
                     for (Size i=0; i<n_-1; ++i)
-                        tmp_[i]=(Y_[i+1]-Y_[i])/dx_[i]-(2.0*D_[i]+D_[i+1])*dx_[i]/6.0;
+                        tmp_[i]=S_[i]-(2.0*D_[i]+D_[i+1])*dx_[i]/6.0;
                     tmp_[n_-1]=tmp_[n_-2]+D_[n_-2]*dx_[n_-2]+(D_[n_-1]-D_[n_-2])*dx_[n_-2]/2.0;
                 } else { // local schemes
                     if (n_==2)
                         tmp_[0] = tmp_[1] = S_[0];
                     else {
-                        switch (da_) {
-                            case CubicInterpolation::FourthOrder:
-                                QL_FAIL("FourthOrder not implemented yet");
-                                break;
-                            case CubicInterpolation::Parabolic:
-                                // intermediate points
-                                for (Size i=1; i<n_-1; ++i)
-                                    tmp_[i] = (dx_[i-1]*S_[i]+dx_[i]*S_[i-1])/(dx_[i]+dx_[i-1]);
-                                // end points
-                                tmp_[0]    = ((2.0*dx_[   0]+dx_[   1])*S_[   0] - dx_[   0]*S_[   1]) / (dx_[   0]+dx_[   1]);
-                                tmp_[n_-1] = ((2.0*dx_[n_-2]+dx_[n_-3])*S_[n_-2] - dx_[n_-2]*S_[n_-3]) / (dx_[n_-2]+dx_[n_-3]);
-                                break;
-                            case CubicInterpolation::FritschButland:
-                                // intermediate points
-                                for (Size i=1; i<n_-1; ++i) {
-                                    Real Smin = std::min(S_[i-1], S_[i]);
-                                    Real Smax = std::max(S_[i-1], S_[i]);
-                                    tmp_[i] = 3.0*Smin*Smax/(Smax+2.0*Smin);
-                                }
-                                // end points
-                                tmp_[0]    = ((2.0*dx_[   0]+dx_[   1])*S_[   0] - dx_[   0]*S_[   1]) / (dx_[   0]+dx_[   1]);
-                                tmp_[n_-1] = ((2.0*dx_[n_-2]+dx_[n_-3])*S_[n_-2] - dx_[n_-2]*S_[n_-3]) / (dx_[n_-2]+dx_[n_-3]);
-                                break;
-                            case CubicInterpolation::Akima:
-                                tmp_[0] = (std::abs(S_[1]-S_[0])*2*S_[0]*S_[1]+std::abs(2*S_[0]*S_[1]-4*S_[0]*S_[0]*S_[1])*S_[0])/(std::abs(S_[1]-S_[0])+std::abs(2*S_[0]*S_[1]-4*S_[0]*S_[0]*S_[1]));
-                                tmp_[1] = (std::abs(S_[2]-S_[1])*S_[0]+std::abs(S_[0]-2*S_[0]*S_[1])*S_[1])/(std::abs(S_[2]-S_[1])+std::abs(S_[0]-2*S_[0]*S_[1]));
-                                for (Size i=2; i<n_-2; ++i) {
-                                    if ((S_[i-2]==S_[i-1]) && (S_[i]!=S_[i+1]))
-                                        tmp_[i] = S_[i-1];
-                                    else if ((S_[i-2]!=S_[i-1]) && (S_[i]==S_[i+1]))
-                                        tmp_[i] = S_[i];
-                                    else if (S_[i]==S_[i-1])
-                                        tmp_[i] = S_[i];
-                                    else if ((S_[i-2]==S_[i-1]) && (S_[i-1]!=S_[i]) && (S_[i]==S_[i+1]))
-                                        tmp_[i] = (S_[i-1]+S_[i])/2.0;
-                                    else
-                                        tmp_[i] = (std::abs(S_[i+1]-S_[i])*S_[i-1]+std::abs(S_[i-1]-S_[i-2])*S_[i])/(std::abs(S_[i+1]-S_[i])+std::abs(S_[i-1]-S_[i-2]));
-                                 }
-                                 tmp_[n_-2] = (std::abs(2*S_[n_-2]*S_[n_-3]-S_[n_-2])*S_[n_-3]+std::abs(S_[n_-3]-S_[n_-4])*S_[n_-2])/(std::abs(2*S_[n_-2]*S_[n_-3]-S_[n_-2])+std::abs(S_[n_-3]-S_[n_-4]));
-                                 tmp_[n_-1] = (std::abs(4*S_[n_-2]*S_[n_-2]*S_[n_-3]-2*S_[n_-2]*S_[n_-3])*S_[n_-2]+std::abs(S_[n_-2]-S_[n_-3])*2*S_[n_-2]*S_[n_-3])/(std::abs(4*S_[n_-2]*S_[n_-2]*S_[n_-3]-2*S_[n_-2]*S_[n_-3])+std::abs(S_[n_-2]-S_[n_-3]));
-                                 break;
-                            case CubicInterpolation::Kruger:
-                                // intermediate points
-                                for (Size i=1; i<n_-1; ++i) {
-                                    if (S_[i-1]*S_[i]<0.0)
-                                        // slope changes sign at point
-                                        tmp_[i] = 0.0;
-                                    else
-                                        // slope will be between the slopes of the adjacent
-                                        // straight lines and should approach zero if the
-                                        // slope of either line approaches zero
-                                        tmp_[i] = 2.0/(1.0/S_[i-1]+1.0/S_[i]);
-                                }
-                                // end points
-                                tmp_[0] = (3.0*S_[0]-tmp_[1])/2.0;
-                                tmp_[n_-1] = (3.0*S_[n_-2]-tmp_[n_-2])/2.0;
-                                break;
-                            case CubicInterpolation::Harmonic:
-                                // intermediate points
-                                for (Size i=1; i<n_-1; ++i) {
-                                    Real w1 = 2*dx_[i]+dx_[i-1];
-                                    Real w2 = dx_[i]+2*dx_[i-1];
-                                    if (S_[i-1]*S_[i]<=0.0)
-                                        // slope changes sign at point
-                                        tmp_[i] = 0.0;
-                                    else
-                                        // weighted harmonic mean of S_[i] and S_[i-1] if they
-                                        // have the same sign; otherwise 0
-                                        tmp_[i] = (w1+w2)/(w1/S_[i-1]+w2/S_[i]);
-                                }
-                                // end points [0]
-                                tmp_[0] = ((2 * dx_[0] + dx_[1])*S_[0] - dx_[0] * S_[1]) / (dx_[1] + dx_[0]);
-                                if (tmp_[0]*S_[0]<0.0) {
-                                    tmp_[0] = 0;
-                                }
-                                else if (S_[0]*S_[1]<0) {
-                                    if (std::fabs(tmp_[0])>std::fabs(3*S_[0])) {
-                                            tmp_[0] = 3*S_[0];
-                                    }
-                                }
-                                // end points [n-1]
-                                tmp_[n_-1] = ((2*dx_[n_-2]+dx_[n_-3])*S_[n_-2]-dx_[n_-2]*S_[n_-3])/(dx_[n_-3]+dx_[n_-2]);
-                                if (tmp_[n_-1]*S_[n_-2]<0.0) {
-                                    tmp_[n_-1] = 0;
-                                }
-                                else if (S_[n_-2]*S_[n_-3]<0) {
-                                    if (std::fabs(tmp_[n_-1])>std::fabs(3*S_[n_-2])) {
-                                        tmp_[n_-1] = 3*S_[n_-2];
-                                    }
-                                }
-                                break;
-                            default:
-                                QL_FAIL("unknown scheme");
-                        }
+                        for (Size i=dFirst; i<=dLast; ++i)
+                            tmp_[i] = localDerivative(i);
                     }
                 }
 
-                std::fill(monotonicityAdjustments_.begin(),
-                          monotonicityAdjustments_.end(), false);
-                // Hyman monotonicity constrained filter
-                if (monotonic_) {
-                    Real correction;
-                    Real pm, pu, pd, M;
-                    for (Size i=0; i<n_; ++i) {
-                        if (i==0) {
-                            if (tmp_[i]*S_[0]>0.0) {
-                                correction = tmp_[i]/std::fabs(tmp_[i]) *
-                                    std::min<Real>(std::fabs(tmp_[i]),
-                                                   std::fabs(3.0*S_[0]));
-                            } else {
-                                correction = 0.0;
-                            }
-                            if (correction!=tmp_[i]) {
-                                tmp_[i] = correction;
-                                monotonicityAdjustments_[i] = true;
-                            }
-                        } else if (i==n_-1) {
-                            if (tmp_[i]*S_[n_-2]>0.0) {
-                                correction = tmp_[i]/std::fabs(tmp_[i]) *
-                                    std::min<Real>(std::fabs(tmp_[i]),
-                                                   std::fabs(3.0*S_[n_-2]));
-                            } else {
-                                correction = 0.0;
-                            }
-                            if (correction!=tmp_[i]) {
-                                tmp_[i] = correction;
-                                monotonicityAdjustments_[i] = true;
-                            }
-                        } else {
-                            pm=(S_[i-1]*dx_[i]+S_[i]*dx_[i-1])/
-                                (dx_[i-1]+dx_[i]);
-                            M = 3.0 * std::min(std::min(std::fabs(S_[i-1]),
-                                                        std::fabs(S_[i])),
-                                               std::fabs(pm));
-                            if (i>1) {
-                                if ((S_[i-1]-S_[i-2])*(S_[i]-S_[i-1])>0.0) {
-                                    pd=(S_[i-1]*(2.0*dx_[i-1]+dx_[i-2])
-                                        -S_[i-2]*dx_[i-1])/
-                                        (dx_[i-2]+dx_[i-1]);
-                                    if (pm*pd>0.0 && pm*(S_[i-1]-S_[i-2])>0.0) {
-                                        M = std::max<Real>(M, 1.5*std::min(
-                                                std::fabs(pm),std::fabs(pd)));
-                                    }
-                                }
-                            }
-                            if (i<n_-2) {
-                                if ((S_[i]-S_[i-1])*(S_[i+1]-S_[i])>0.0) {
-                                    pu=(S_[i]*(2.0*dx_[i]+dx_[i+1])-S_[i+1]*dx_[i])/
-                                        (dx_[i]+dx_[i+1]);
-                                    if (pm*pu>0.0 && -pm*(S_[i]-S_[i-1])>0.0) {
-                                        M = std::max<Real>(M, 1.5*std::min(
-                                                std::fabs(pm),std::fabs(pu)));
-                                    }
-                                }
-                            }
-                            if (tmp_[i]*pm>0.0) {
-                                correction = tmp_[i]/std::fabs(tmp_[i]) *
-                                    std::min(std::fabs(tmp_[i]), M);
-                            } else {
-                                correction = 0.0;
-                            }
-                            if (correction!=tmp_[i]) {
-                                tmp_[i] = correction;
-                                monotonicityAdjustments_[i] = true;
-                            }
-                        }
-                    }
+                for (Size i=dFirst; i<=dLast; ++i) {
+                    monotonicityAdjustments_[i] = false;
+                    // Hyman monotonicity constrained filter
+                    if (monotonic_)
+                        applyHymanFilter(i);
                 }
 
-
                 // cubic coefficients
-                for (Size i=0; i<n_-1; ++i) {
+                Size cFirst = (dFirst > 0 ? dFirst-1 : 0);
+                Size cLast = std::min(dLast, n_-2);
+                for (Size i=cFirst; i<=cLast; ++i) {
                     a_[i] = tmp_[i];
                     b_[i] = (3.0*S_[i] - tmp_[i+1] - 2.0*tmp_[i])/dx_[i];
                     c_[i] = (tmp_[i+1] + tmp_[i] - 2.0*S_[i])/(dx_[i]*dx_[i]);
                 }
 
                 primitiveConst_[0] = 0.0;
-                for (Size i=1; i<n_-1; ++i) {
+                for (Size i=std::max<Size>(cFirst,1); i<n_-1; ++i) {
                     primitiveConst_[i] = primitiveConst_[i-1]
                         + dx_[i-1] *
                         (this->yBegin_[i-1] + dx_[i-1] *
@@ -767,6 +516,345 @@ namespace QuantLib {
                 return 2.0*b_[j] + 6.0*c_[j]*dx_;
             }
           private:
+            void setSplineOperator() {
+                for (Size i=1; i<n_-1; ++i)
+                    L_.setMidRow(i, dx_[i], 2.0*(dx_[i]+dx_[i-1]), dx_[i-1]);
+
+                // left boundary condition
+                switch (leftType_) {
+                  case CubicInterpolation::NotAKnot:
+                    L_.setFirstRow(dx_[1]*(dx_[1]+dx_[0]),
+                                  (dx_[0]+dx_[1])*(dx_[0]+dx_[1]));
+                    break;
+                  case CubicInterpolation::FirstDerivative:
+                  case CubicInterpolation::Lagrange:
+                    L_.setFirstRow(1.0, 0.0);
+                    break;
+                  case CubicInterpolation::SecondDerivative:
+                    L_.setFirstRow(2.0, 1.0);
+                    break;
+                  case CubicInterpolation::Periodic:
+                    QL_FAIL("this end condition is not implemented yet");
+                  default:
+                    QL_FAIL("unknown end condition");
+                }
+
+                // right boundary condition
+                switch (rightType_) {
+                  case CubicInterpolation::NotAKnot:
+                    L_.setLastRow(-(dx_[n_-2]+dx_[n_-3])*(dx_[n_-2]+dx_[n_-3]),
+                                 -dx_[n_-3]*(dx_[n_-3]+dx_[n_-2]));
+                    break;
+                  case CubicInterpolation::FirstDerivative:
+                  case CubicInterpolation::Lagrange:
+                    L_.setLastRow(0.0, 1.0);
+                    break;
+                  case CubicInterpolation::SecondDerivative:
+                    L_.setLastRow(1.0, 2.0);
+                    break;
+                  case CubicInterpolation::Periodic:
+                    QL_FAIL("this end condition is not implemented yet");
+                  default:
+                    QL_FAIL("unknown end condition");
+                }
+            }
+
+            void setSplineRightHandSide() {
+                for (Size i=1; i<n_-1; ++i)
+                    tmp_[i] = 3.0*(dx_[i]*S_[i-1] + dx_[i-1]*S_[i]);
+
+                // left boundary condition
+                switch (leftType_) {
+                  case CubicInterpolation::NotAKnot:
+                    // ignoring end condition value
+                    tmp_[0] = S_[0]*dx_[1]*(2.0*dx_[1]+3.0*dx_[0]) +
+                             S_[1]*dx_[0]*dx_[0];
+                    break;
+                  case CubicInterpolation::FirstDerivative:
+                    tmp_[0] = leftValue_;
+                    break;
+                  case CubicInterpolation::SecondDerivative:
+                    tmp_[0] = 3.0*S_[0] - leftValue_*dx_[0]/2.0;
+                    break;
+                  case CubicInterpolation::Lagrange:
+                    tmp_[0] = cubicInterpolatingPolynomialDerivative(
+                                        this->xBegin_[0],this->xBegin_[1],
+                                        this->xBegin_[2],this->xBegin_[3],
+                                        this->yBegin_[0],this->yBegin_[1],
+                                        this->yBegin_[2],this->yBegin_[3],
+                                        this->xBegin_[0]);
+                    break;
+                  default:
+                    QL_FAIL("unknown end condition");
+                }
+
+                // right boundary condition
+                switch (rightType_) {
+                  case CubicInterpolation::NotAKnot:
+                    // ignoring end condition value
+                    tmp_[n_-1] = -S_[n_-3]*dx_[n_-2]*dx_[n_-2] -
+                                 S_[n_-2]*dx_[n_-3]*(3.0*dx_[n_-2]+2.0*dx_[n_-3]);
+                    break;
+                  case CubicInterpolation::FirstDerivative:
+                    tmp_[n_-1] = rightValue_;
+                    break;
+                  case CubicInterpolation::SecondDerivative:
+                    tmp_[n_-1] = 3.0*S_[n_-2] + rightValue_*dx_[n_-2]/2.0;
+                    break;
+                  case CubicInterpolation::Lagrange:
+                    tmp_[n_-1] = cubicInterpolatingPolynomialDerivative(
+                                  this->xBegin_[n_-4],this->xBegin_[n_-3],
+                                  this->xBegin_[n_-2],this->xBegin_[n_-1],
+                                  this->yBegin_[n_-4],this->yBegin_[n_-3],
+                                  this->yBegin_[n_-2],this->yBegin_[n_-1],
+                                  this->xBegin_[n_-1]);
+                    break;
+                  default:
+                    QL_FAIL("unknown end condition");
+                }
+            }
+
+            // the second derivatives are J*y, J only depending on the nodes
+            void setSplineOM1Matrix() {
+                Matrix T_(n_-2, n_, 0.0);
+                for (Size i=0; i<n_-2; ++i) {
+                    T_[i][i]=dx_[i]/6.0;
+                    T_[i][i+1]=(dx_[i+1]+dx_[i])/3.0;
+                    T_[i][i+2]=dx_[i+1]/6.0;
+                }
+                Matrix S_(n_-2, n_, 0.0);
+                for (Size i=0; i<n_-2; ++i) {
+                    S_[i][i]=1.0/dx_[i];
+                    S_[i][i+1]=-(1.0/dx_[i+1]+1.0/dx_[i]);
+                    S_[i][i+2]=1.0/dx_[i+1];
+                }
+                Matrix Up_(n_, 2, 0.0);
+                Up_[0][0]=1;
+                Up_[n_-1][1]=1;
+                Matrix Us_(n_, n_-2, 0.0);
+                for (Size i=0; i<n_-2; ++i)
+                    Us_[i+1][i]=1;
+                Matrix Z_ = Us_*inverse(T_*Us_);
+                Matrix I_(n_, n_, 0.0);
+                for (Size i=0; i<n_; ++i)
+                    I_[i][i]=1;
+                Matrix V_ = (I_-Z_*T_)*Up_;
+                Matrix W_ = Z_*S_;
+                Matrix Q_(n_, n_, 0.0);
+                Q_[0][0]=1.0/(n_-1)*dx_[0]*dx_[0]*dx_[0];
+                Q_[0][1]=7.0/8*1.0/(n_-1)*dx_[0]*dx_[0]*dx_[0];
+                for (Size i=1; i<n_-1; ++i) {
+                    Q_[i][i-1]=7.0/8*1.0/(n_-1)*dx_[i-1]*dx_[i-1]*dx_[i-1];
+                    Q_[i][i]=1.0/(n_-1)*dx_[i]*dx_[i]*dx_[i]+1.0/(n_-1)*dx_[i-1]*dx_[i-1]*dx_[i-1];
+                    Q_[i][i+1]=7.0/8*1.0/(n_-1)*dx_[i]*dx_[i]*dx_[i];
+                }
+                Q_[n_-1][n_-2]=7.0/8*1.0/(n_-1)*dx_[n_-2]*dx_[n_-2]*dx_[n_-2];
+                Q_[n_-1][n_-1]=1.0/(n_-1)*dx_[n_-2]*dx_[n_-2]*dx_[n_-2];
+                J_ = (I_-V_*inverse(transpose(V_)*Q_*V_)*transpose(V_)*Q_)*W_;
+            }
+
+            void setSplineOM2Matrix() {
+                Matrix T_(n_-2, n_, 0.0);
+                for (Size i=0; i<n_-2; ++i) {
+                    T_[i][i]=dx_[i]/6.0;
+                    T_[i][i+1]=(dx_[i]+dx_[i+1])/3.0;
+                    T_[i][i+2]=dx_[i+1]/6.0;
+                }
+                Matrix S_(n_-2, n_, 0.0);
+                for (Size i=0; i<n_-2; ++i) {
+                    S_[i][i]=1.0/dx_[i];
+                    S_[i][i+1]=-(1.0/dx_[i+1]+1.0/dx_[i]);
+                    S_[i][i+2]=1.0/dx_[i+1];
+                }
+                Matrix Up_(n_, 2, 0.0);
+                Up_[0][0]=1;
+                Up_[n_-1][1]=1;
+                Matrix Us_(n_, n_-2, 0.0);
+                for (Size i=0; i<n_-2; ++i)
+                    Us_[i+1][i]=1;
+                Matrix Z_ = Us_*inverse(T_*Us_);
+                Matrix I_(n_, n_, 0.0);
+                for (Size i=0; i<n_; ++i)
+                    I_[i][i]=1;
+                Matrix V_ = (I_-Z_*T_)*Up_;
+                Matrix W_ = Z_*S_;
+                Matrix Q_(n_, n_, 0.0);
+                Q_[0][0]=1.0/(n_-1)*dx_[0];
+                Q_[0][1]=1.0/2*1.0/(n_-1)*dx_[0];
+                for (Size i=1; i<n_-1; ++i) {
+                    Q_[i][i-1]=1.0/2*1.0/(n_-1)*dx_[i-1];
+                    Q_[i][i]=1.0/(n_-1)*dx_[i]+1.0/(n_-1)*dx_[i-1];
+                    Q_[i][i+1]=1.0/2*1.0/(n_-1)*dx_[i];
+                }
+                Q_[n_-1][n_-2]=1.0/2*1.0/(n_-1)*dx_[n_-2];
+                Q_[n_-1][n_-1]=1.0/(n_-1)*dx_[n_-2];
+                J_ = (I_-V_*inverse(transpose(V_)*Q_*V_)*transpose(V_)*Q_)*W_;
+            }
+
+            // the i-th derivative only depends on S[i-2]...S[i+1];
+            // the ones at the end points are overwritten in this order,
+            // as they were when the schemes were calculated in a loop
+            Real localDerivative(Size i) const {
+                switch (da_) {
+                  case CubicInterpolation::FourthOrder:
+                    QL_FAIL("FourthOrder not implemented yet");
+                  case CubicInterpolation::Parabolic:
+                    if (i == 0)
+                        return ((2.0*dx_[   0]+dx_[   1])*S_[   0] - dx_[   0]*S_[   1]) / (dx_[   0]+dx_[   1]);
+                    if (i == n_-1)
+                        return ((2.0*dx_[n_-2]+dx_[n_-3])*S_[n_-2] - dx_[n_-2]*S_[n_-3]) / (dx_[n_-2]+dx_[n_-3]);
+                    // intermediate points
+                    return (dx_[i-1]*S_[i]+dx_[i]*S_[i-1])/(dx_[i]+dx_[i-1]);
+                  case CubicInterpolation::FritschButland:
+                    if (i == 0)
+                        return ((2.0*dx_[   0]+dx_[   1])*S_[   0] - dx_[   0]*S_[   1]) / (dx_[   0]+dx_[   1]);
+                    if (i == n_-1)
+                        return ((2.0*dx_[n_-2]+dx_[n_-3])*S_[n_-2] - dx_[n_-2]*S_[n_-3]) / (dx_[n_-2]+dx_[n_-3]);
+                    // intermediate points
+                    {
+                        Real Smin = std::min(S_[i-1], S_[i]);
+                        Real Smax = std::max(S_[i-1], S_[i]);
+                        return 3.0*Smin*Smax/(Smax+2.0*Smin);
+                    }
+                  case CubicInterpolation::Akima:
+                    if (i == n_-1)
+                        return (std::abs(4*S_[n_-2]*S_[n_-2]*S_[n_-3]-2*S_[n_-2]*S_[n_-3])*S_[n_-2]+std::abs(S_[n_-2]-S_[n_-3])*2*S_[n_-2]*S_[n_-3])/(std::abs(4*S_[n_-2]*S_[n_-2]*S_[n_-3]-2*S_[n_-2]*S_[n_-3])+std::abs(S_[n_-2]-S_[n_-3]));
+                    if (i == n_-2)
+                        return (std::abs(2*S_[n_-2]*S_[n_-3]-S_[n_-2])*S_[n_-3]+std::abs(S_[n_-3]-S_[n_-4])*S_[n_-2])/(std::abs(2*S_[n_-2]*S_[n_-3]-S_[n_-2])+std::abs(S_[n_-3]-S_[n_-4]));
+                    if (i == 0)
+                        return (std::abs(S_[1]-S_[0])*2*S_[0]*S_[1]+std::abs(2*S_[0]*S_[1]-4*S_[0]*S_[0]*S_[1])*S_[0])/(std::abs(S_[1]-S_[0])+std::abs(2*S_[0]*S_[1]-4*S_[0]*S_[0]*S_[1]));
+                    if (i == 1)
+                        return (std::abs(S_[2]-S_[1])*S_[0]+std::abs(S_[0]-2*S_[0]*S_[1])*S_[1])/(std::abs(S_[2]-S_[1])+std::abs(S_[0]-2*S_[0]*S_[1]));
+                    if ((S_[i-2]==S_[i-1]) && (S_[i]!=S_[i+1]))
+                        return S_[i-1];
+                    else if ((S_[i-2]!=S_[i-1]) && (S_[i]==S_[i+1]))
+                        return S_[i];
+                    else if (S_[i]==S_[i-1])
+                        return S_[i];
+                    else if ((S_[i-2]==S_[i-1]) && (S_[i-1]!=S_[i]) && (S_[i]==S_[i+1]))
+                        return (S_[i-1]+S_[i])/2.0;
+                    else
+                        return (std::abs(S_[i+1]-S_[i])*S_[i-1]+std::abs(S_[i-1]-S_[i-2])*S_[i])/(std::abs(S_[i+1]-S_[i])+std::abs(S_[i-1]-S_[i-2]));
+                  case CubicInterpolation::Kruger:
+                    // end points
+                    if (i == 0)
+                        return (3.0*S_[0]-localDerivative(1))/2.0;
+                    if (i == n_-1)
+                        return (3.0*S_[n_-2]-localDerivative(n_-2))/2.0;
+                    // intermediate points
+                    if (S_[i-1]*S_[i]<0.0)
+                        // slope changes sign at point
+                        return 0.0;
+                    else
+                        // slope will be between the slopes of the adjacent
+                        // straight lines and should approach zero if the
+                        // slope of either line approaches zero
+                        return 2.0/(1.0/S_[i-1]+1.0/S_[i]);
+                  case CubicInterpolation::Harmonic:
+                    if (i == 0) {
+                        // end points [0]
+                        Real d = ((2 * dx_[0] + dx_[1])*S_[0] - dx_[0] * S_[1]) / (dx_[1] + dx_[0]);
+                        if (d*S_[0]<0.0) {
+                            d = 0;
+                        }
+                        else if (S_[0]*S_[1]<0) {
+                            if (std::fabs(d)>std::fabs(3*S_[0])) {
+                                    d = 3*S_[0];
+                            }
+                        }
+                        return d;
+                    }
+                    if (i == n_-1) {
+                        // end points [n-1]
+                        Real d = ((2*dx_[n_-2]+dx_[n_-3])*S_[n_-2]-dx_[n_-2]*S_[n_-3])/(dx_[n_-3]+dx_[n_-2]);
+                        if (d*S_[n_-2]<0.0) {
+                            d = 0;
+                        }
+                        else if (S_[n_-2]*S_[n_-3]<0) {
+                            if (std::fabs(d)>std::fabs(3*S_[n_-2])) {
+                                d = 3*S_[n_-2];
+                            }
+                        }
+                        return d;
+                    }
+                    // intermediate points
+                    {
+                        Real w1 = 2*dx_[i]+dx_[i-1];
+                        Real w2 = dx_[i]+2*dx_[i-1];
+                        if (S_[i-1]*S_[i]<=0.0)
+                            // slope changes sign at point
+                            return 0.0;
+                        else
+                            // weighted harmonic mean of S_[i] and S_[i-1] if they
+                            // have the same sign; otherwise 0
+                            return (w1+w2)/(w1/S_[i-1]+w2/S_[i]);
+                    }
+                  default:
+                    QL_FAIL("unknown scheme");
+                }
+            }
+
+            // the correction at the i-th point only depends on the
+            // derivative there and on S[i-2]...S[i+1]
+            void applyHymanFilter(Size i) {
+                Real correction;
+                Real pm, pu, pd, M;
+                if (i==0) {
+                    if (tmp_[i]*S_[0]>0.0) {
+                        correction = tmp_[i]/std::fabs(tmp_[i]) *
+                            std::min<Real>(std::fabs(tmp_[i]),
+                                           std::fabs(3.0*S_[0]));
+                    } else {
+                        correction = 0.0;
+                    }
+                } else if (i==n_-1) {
+                    if (tmp_[i]*S_[n_-2]>0.0) {
+                        correction = tmp_[i]/std::fabs(tmp_[i]) *
+                            std::min<Real>(std::fabs(tmp_[i]),
+                                           std::fabs(3.0*S_[n_-2]));
+                    } else {
+                        correction = 0.0;
+                    }
+                } else {
+                    pm=(S_[i-1]*dx_[i]+S_[i]*dx_[i-1])/
+                        (dx_[i-1]+dx_[i]);
+                    M = 3.0 * std::min(std::min(std::fabs(S_[i-1]),
+                                                std::fabs(S_[i])),
+                                       std::fabs(pm));
+                    if (i>1) {
+                        if ((S_[i-1]-S_[i-2])*(S_[i]-S_[i-1])>0.0) {
+                            pd=(S_[i-1]*(2.0*dx_[i-1]+dx_[i-2])
+                                -S_[i-2]*dx_[i-1])/
+                                (dx_[i-2]+dx_[i-1]);
+                            if (pm*pd>0.0 && pm*(S_[i-1]-S_[i-2])>0.0) {
+                                M = std::max<Real>(M, 1.5*std::min(
+                                        std::fabs(pm),std::fabs(pd)));
+                            }
+                        }
+                    }
+                    if (i<n_-2) {
+                        if ((S_[i]-S_[i-1])*(S_[i+1]-S_[i])>0.0) {
+                            pu=(S_[i]*(2.0*dx_[i]+dx_[i+1])-S_[i+1]*dx_[i])/
+                                (dx_[i]+dx_[i+1]);
+                            if (pm*pu>0.0 && -pm*(S_[i]-S_[i-1])>0.0) {
+                                M = std::max<Real>(M, 1.5*std::min(
+                                        std::fabs(pm),std::fabs(pu)));
+                            }
+                        }
+                    }
+                    if (tmp_[i]*pm>0.0) {
+                        correction = tmp_[i]/std::fabs(tmp_[i]) *
+                            std::min(std::fabs(tmp_[i]), M);
+                    } else {
+                        correction = 0.0;
+                    }
+                }
+                if (correction!=tmp_[i]) {
+                    tmp_[i] = correction;
+                    monotonicityAdjustments_[i] = true;
+                }
+            }
+
             CubicInterpolation::DerivativeApprox da_;
             bool monotonic_;
             CubicInterpolation::BoundaryCondition leftType_, rightType_;
@@ -774,6 +862,9 @@ namespace QuantLib {
             mutable Array tmp_;
             mutable std::vector<Real> dx_, S_;
             mutable TridiagonalOperator L_;
+            std::vector<Real> xValues_, yValues_;
+            Matrix J_;
+            std::vector<Real> D_;
 
             inline Real cubicInterpolatingPolynomialDerivative(
                                Real a, Real b, Real c, Real d,
@@ -40,6 +40,12 @@ namespace QuantLib {
         representing the discretized values of the \f$ x \f$ and \f$ y
         \f$ variables, and a \f$ N \times M \f$ matrix representing
         the tabulated function values.
+
+        As for 1-D interpolations, the intervals containing the last
+        requested point are checked first at the next request.
+
+        \warning the above makes concurrent calls to an instance (or to
+                 copies sharing its implementation) unsafe.
     */
     class Interpolation2D : public Extrapolator {
       protected:
@@ -73,7 +79,7 @@ namespace QuantLib {
                          const I2& yBegin, const I2& yEnd,
                          const M& zData)
             : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin), yEnd_(yEnd),
-              zData_(zData) {
+              zData_(zData), xHint_(0), yHint_(0) {
                 QL_REQUIRE(xEnd_-xBegin_ >= 2,
                            "not enough x points to interpolate: at least 2 "
                            "required, " << xEnd_-xBegin_ << " provided");
@@ -126,28 +132,39 @@ namespace QuantLib {
                 for (I1 i=xBegin_, j=xBegin_+1; j!=xEnd_; ++i, ++j)
                     QL_REQUIRE(*j > *i, "unsorted x values");
                 #endif
-                if (x < *xBegin_)
-                    return 0;
-                else if (x > *(xEnd_-1))
-                    return xEnd_-xBegin_-2;
-                else
-                    return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                return locate(xBegin_, xEnd_, x, xHint_);
             }
             Size locateY(Real y) const {
                 #if defined(QL_EXTRA_SAFETY_CHECKS)
                 for (I2 k=yBegin_, l=yBegin_+1; l!=yEnd_; ++k, ++l)
                     QL_REQUIRE(*l > *k, "unsorted y values");
                 #endif
-                if (y < *yBegin_)
-                    return 0;
-                else if (y > *(yEnd_-1))
-                    return yEnd_-yBegin_-2;
-                else
-                    return std::upper_bound(yBegin_,yEnd_-1,y)-yBegin_-1;
+                return locate(yBegin_, yEnd_, y, yHint_);
             }
             I1 xBegin_, xEnd_;
             I2 yBegin_, yEnd_;
             const M& zData_;
+          private:
+            template <class I>
+            static Size locate(const I& begin, const I& end, Real x,
+                               Size& hint) {
+                if (x < *begin)
+                    return 0;
+                else if (x > *(end-1))
+                    return end-begin-2;
+                // the interval of the last call and the next one are
+                // checked first; the last interval is closed
+                Size n = end-begin, i = hint;
+                if (i+1 < n && *(begin+i) <= x) {
+                    if (i+2 == n || x < *(begin+i+1))
+                        return i;
+                    ++i;
+                    if (i+2 == n || x < *(begin+i+1))
+                        return hint = i;
+                }
+                return hint = std::upper_bound(begin,end-1,x)-begin-1;
+            }
+            mutable Size xHint_, yHint_;
         };
       public:
         Interpolation2D() {}
@@ -23,6 +23,12 @@
 
 #include <ql/math/interpolation.hpp>
 #include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <ql/math/matrixutilities/csrilupreconditioner.hpp>
+#include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/bind.hpp>
+#include <algorithm>
 
 /*! \file kernelinterpolation.hpp
     \brief Kernel interpolation
@@ -32,6 +38,19 @@ namespace QuantLib {
 
     namespace detail {
 
+        /* solves the sparse system K a = b arising from kernel
+           interpolations with a finite support radius; the kernel
+           matrix K is symmetric and stores its whole diagonal. */
+        inline Disposable<Array> solveKernelSystem(const CsrMatrix& K,
+                                                   const Array& b) {
+            const CsrILUPreconditioner ilu(K);
+            const BiCGstab solver(
+                K, std::max<Size>(100, K.rows()), 1e-14,
+                boost::bind(&CsrILUPreconditioner::apply, &ilu, _1));
+            Array a = solver.solve(b).x;
+            return a;
+        }
+
         template <class I1, class I2, class Kernel>
         class KernelInterpolationImpl
             : public Interpolation::templateImpl<I1,I2> {
@@ -39,25 +58,38 @@ namespace QuantLib {
             KernelInterpolationImpl(const I1& xBegin, const I1& xEnd,
                                     const I2& yBegin,
                                     const Kernel& kernel,
-                                    const Real epsilon)
+                                    const Real epsilon,
+                                    const Real supportRadius)
             : Interpolation::templateImpl<I1,I2>(xBegin, xEnd, yBegin),
               xSize_(Size(xEnd-xBegin)), invPrec_(epsilon),
-              M_(xSize_,xSize_), alphaVec_(xSize_), yVec_(xSize_),
+              supportRadius_(supportRadius),
+              M_(supportRadius == Null<Real>() ? xSize_ : 0,
+                 supportRadius == Null<Real>() ? xSize_ : 0),
+              alphaVec_(xSize_), yVec_(xSize_),
               kernel_(kernel) {}
 
             void update() {
-                updateAlphaVec();
+                if (supportRadius_ == Null<Real>())
+                    updateAlphaVec();
+                else
+                    updateSparseAlphaVec();
             }
 
             Real value(Real x) const {
 
-                Real res=0.0;
+                Size begin = 0, end = xSize_;
+                if (supportRadius_ != Null<Real>())
+                    neighbours(x, begin, end);
+
+                Real res=0.0, gamma=0.0;
 
-                for( Size i=0; i< xSize_;++i){
-                    res+=alphaVec_[i]*kernelAbs(x,this->xBegin_[i]);
+                for (Size i=begin; i<end; ++i) {
+                    const Real k = kernelAbs(x,this->xBegin_[i]);
+                    res+=alphaVec_[i]*k;
+                    gamma+=k;
                 }
 
-                return res/gammaFunc(x);
+                return res/gamma;
             }
 
             Real primitive(Real) const {
@@ -81,6 +113,14 @@ namespace QuantLib {
                 return kernel_(std::fabs(x1-x2));
             }
 
+            // range of the pillars within the support radius of x
+            void neighbours(Real x, Size& begin, Size& end) const {
+                begin = std::lower_bound(this->xBegin_, this->xEnd_,
+                                         x-supportRadius_) - this->xBegin_;
+                end = std::upper_bound(this->xBegin_+begin, this->xEnd_,
+                                       x+supportRadius_) - this->xBegin_;
+            }
+
             Real gammaFunc(Real x)const{
 
                 Real res=0.0;
@@ -123,8 +163,43 @@ namespace QuantLib {
                 }
             }
 
+            void updateSparseAlphaVec() {
+                // M = D^{-1} K with K the kernel matrix and D the
+                // diagonal of its row sums, hence M*alpha = y is
+                // solved as the sparse symmetric system K*alpha = D*y.
+                std::vector<Size> rowPointers(1, 0), columnIndices;
+                std::vector<Real> values;
+                Array gamma(xSize_);
+
+                for (Size i=0; i<xSize_; ++i) {
+                    Size begin, end;
+                    neighbours(this->xBegin_[i], begin, end);
+
+                    gamma[i] = 0.0;
+                    for (Size j=begin; j<end; ++j) {
+                        const Real k = kernelAbs(this->xBegin_[i],
+                                                 this->xBegin_[j]);
+                        columnIndices.push_back(j);
+                        values.push_back(k);
+                        gamma[i] += k;
+                    }
+                    rowPointers.push_back(columnIndices.size());
+                    yVec_[i] = this->yBegin_[i];
+                }
+
+                const CsrMatrix K(xSize_, xSize_,
+                                  rowPointers, columnIndices, values);
+                alphaVec_ = solveKernelSystem(K, gamma*yVec_);
+
+                const Array diffVec = Abs(K.apply(alphaVec_)/gamma - yVec_);
+                for (Size i=0; i<diffVec.size(); ++i) {
+                    QL_REQUIRE(diffVec[i] < invPrec_,
+                               "Inversion failed in 1d kernel interpolation");
+                }
+            }
+
             Size xSize_;
-            Real invPrec_;
+            Real invPrec_, supportRadius_;
             Matrix M_;
             Array alphaVec_,yVec_;
             Kernel kernel_;
@@ -154,16 +229,27 @@ namespace QuantLib {
             be thrown if
             \f[
             \left\| Ma-y \right\|_\infty \geq \epsilon
-            \f] */
+            \f]
+
+            If a support radius is given, the kernel is taken to
+            vanish beyond it: \f$ M \f$ is stored as a sparse matrix
+            and solved iteratively, and each evaluation only sums
+            over the pillars within the radius, which are found by
+            binary search.  This is exact for compactly supported
+            kernels such as WendlandKernel and truncates any other
+            kernel, e.g., a Gaussian at a few standard deviations.
+        */
         template <class I1, class I2, class Kernel>
         KernelInterpolation(const I1& xBegin, const I1& xEnd,
                             const I2& yBegin,
                             const Kernel& kernel,
-                            const double epsilon = 1.0E-7) {
+                            const Real epsilon = 1.0E-7,
+                            const Real supportRadius = Null<Real>()) {
             impl_ = boost::shared_ptr<Interpolation::Impl>(new
                 detail::KernelInterpolationImpl<I1,I2,Kernel>(xBegin, xEnd,
                                                               yBegin, kernel,
-                                                              epsilon));
+                                                              epsilon,
+                                                              supportRadius));
             impl_->update();
         }
 
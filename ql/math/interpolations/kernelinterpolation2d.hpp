@@ -25,7 +25,7 @@
 #define quantlib_kernel_interpolation2D_hpp
 
 #include <ql/math/interpolations/interpolation2d.hpp>
-#include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <ql/math/interpolations/kernelinterpolation.hpp>
 
 /*
   Grid Explanation:
@@ -59,13 +59,16 @@ namespace QuantLib {
             KernelInterpolation2DImpl(const I1& xBegin, const I1& xEnd,
                                       const I2& yBegin, const I2& yEnd,
                                       const M& zData,
-                                      const Kernel& kernel)
+                                      const Kernel& kernel,
+                                      const Real supportRadius)
             : Interpolation2D::templateImpl<I1,I2,M>(xBegin, xEnd,
                                                      yBegin, yEnd, zData),
               xSize_(Size(xEnd-xBegin)), ySize_(Size(yEnd-yBegin)),
               xySize_(xSize_*ySize_), invPrec_(1.0e-10),
+              supportRadius_(supportRadius),
               alphaVec_(xySize_), yVec_(xySize_),
-              M_(xySize_,xySize_),
+              M_(supportRadius == Null<Real>() ? xySize_ : 0,
+                 supportRadius == Null<Real>() ? xySize_ : 0),
               kernel_(kernel) {
 
                 QL_REQUIRE(zData.rows()==xSize_,
@@ -75,11 +78,17 @@ namespace QuantLib {
             }
 
             void calculate() {
-                updateAlphaVec();
+                if (supportRadius_ == Null<Real>())
+                    updateAlphaVec();
+                else
+                    updateSparseAlphaVec();
             }
 
             Real value(Real x1, Real x2) const {
 
+                if (supportRadius_ != Null<Real>())
+                    return localValue(x1, x2);
+
                 Real res=0.0;
 
                 Array X(2),Xn(2);
@@ -174,10 +183,90 @@ namespace QuantLib {
                 }
             }
 
+            // ranges of the pillars within the support radius of x
+            void neighbours(Real x1, Real x2,
+                            Size& xBegin, Size& xEnd,
+                            Size& yBegin, Size& yEnd) const {
+                const Real h = supportRadius_;
+                xBegin = std::lower_bound(this->xBegin_, this->xEnd_,
+                                          x1-h) - this->xBegin_;
+                xEnd = std::upper_bound(this->xBegin_+xBegin, this->xEnd_,
+                                        x1+h) - this->xBegin_;
+                yBegin = std::lower_bound(this->yBegin_, this->yEnd_,
+                                          x2-h) - this->yBegin_;
+                yEnd = std::upper_bound(this->yBegin_+yBegin, this->yEnd_,
+                                        x2+h) - this->yBegin_;
+            }
+
+            Real localValue(Real x1, Real x2) const {
+                Size xBegin, xEnd, yBegin, yEnd;
+                neighbours(x1, x2, xBegin, xEnd, yBegin, yEnd);
+
+                Real res=0.0, gamma=0.0;
+                for (Size j=yBegin; j<yEnd; ++j) {
+                    const Real dy = x2-this->yBegin_[j];
+                    for (Size i=xBegin; i<xEnd; ++i) {
+                        const Real dx = x1-this->xBegin_[i];
+                        const Real d = std::sqrt(dx*dx+dy*dy);
+                        if (d <= supportRadius_) {
+                            const Real k = kernel_(d);
+                            res+=alphaVec_[j*xSize_+i]*k;
+                            gamma+=k;
+                        }
+                    }
+                }
+                return res/gamma;
+            }
+
+            void updateSparseAlphaVec() {
+                // as in the 1D case, M*alpha = y is solved as the
+                // sparse symmetric system K*alpha = D*y with K the
+                // kernel matrix and D the diagonal of its row sums.
+                std::vector<Size> rowPointers(1, 0), columnIndices;
+                std::vector<Real> values;
+                Array gamma(xySize_);
+
+                for (Size j=0, row=0; j<ySize_; ++j) {
+                    for (Size i=0; i<xSize_; ++i, ++row) {
+                        const Real x1 = this->xBegin_[i];
+                        const Real x2 = this->yBegin_[j];
+                        Size xBegin, xEnd, yBegin, yEnd;
+                        neighbours(x1, x2, xBegin, xEnd, yBegin, yEnd);
+
+                        gamma[row] = 0.0;
+                        for (Size jM=yBegin; jM<yEnd; ++jM) {
+                            const Real dy = x2-this->yBegin_[jM];
+                            for (Size iM=xBegin; iM<xEnd; ++iM) {
+                                const Real dx = x1-this->xBegin_[iM];
+                                const Real d = std::sqrt(dx*dx+dy*dy);
+                                if (d <= supportRadius_) {
+                                    const Real k = kernel_(d);
+                                    columnIndices.push_back(jM*xSize_+iM);
+                                    values.push_back(k);
+                                    gamma[row] += k;
+                                }
+                            }
+                        }
+                        rowPointers.push_back(columnIndices.size());
+                        yVec_[row] = this->zData_[i][j];
+                    }
+                }
+
+                const CsrMatrix K(xySize_, xySize_,
+                                  rowPointers, columnIndices, values);
+                alphaVec_ = solveKernelSystem(K, gamma*yVec_);
+
+                const Array diffVec = Abs(K.apply(alphaVec_)/gamma - yVec_);
+                for (Size i=0; i<diffVec.size(); ++i) {
+                    QL_REQUIRE(diffVec[i]<invPrec_,
+                               "inversion failed in 2d kernel interpolation");
+                }
+            }
+
           private:
 
             Size xSize_,ySize_,xySize_;
-            Real invPrec_;
+            Real invPrec_, supportRadius_;
             Array alphaVec_, yVec_;
             Matrix M_;
             Kernel kernel_;
@@ -192,22 +281,28 @@ namespace QuantLib {
 
         The kernel in the implementation is kept general, although a
         Gaussian is considered in the cited text.
+
+        As for KernelInterpolation, an optional support radius gives
+        sparse calibration and local evaluation, which makes large
+        grids tractable.
     */
     class KernelInterpolation2D : public Interpolation2D{
       public:
-        /*! \pre the \f$ x \f$ values must be sorted.
+        /*! \pre the \f$ x \f$ and \f$ y \f$ values must be sorted.
             \pre kernel needs a Real operator()(Real x) implementation
         */
         template <class I1, class I2, class M, class Kernel>
         KernelInterpolation2D(const I1& xBegin, const I1& xEnd,
                             const I2& yBegin, const I2& yEnd,
                             const M& zData,
-                            const Kernel& kernel) {
+                            const Kernel& kernel,
+                            const Real supportRadius = Null<Real>()) {
 
             impl_ = boost::shared_ptr<Interpolation2D::Impl>(new
                 detail::KernelInterpolation2DImpl<I1,I2,M,Kernel>(xBegin, xEnd,
                                                                   yBegin, yEnd,
-                                                                  zData, kernel));
+                                                                  zData, kernel,
+                                                                  supportRadius));
             this->update();
         }
     };
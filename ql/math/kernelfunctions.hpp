@@ -67,6 +67,41 @@ namespace QuantLib {
         Real normFact_;
     };
 
+
+    //! Wendland's compactly supported kernel function
+    /*! The function
+        \f[
+        k(x) = \left(1-\frac{|x|}{h}\right)_+^4
+               \left(4\frac{|x|}{h}+1\right)
+        \f]
+        is positive definite in up to three dimensions and vanishes
+        beyond the support radius \f$ h \f$.  Passing the radius to
+        the kernel interpolations makes their matrices sparse.
+
+        \note unlike GaussianKernel, the function is normalized to
+              one at the origin rather than integrating to one.
+    */
+    class WendlandKernel : public KernelFunction {
+      public:
+        explicit WendlandKernel(Real radius)
+        : radius_(radius) {
+            QL_REQUIRE(radius > 0.0, "positive support radius required");
+        }
+
+        Real operator()(Real x) const {
+            const Real r = std::fabs(x)/radius_;
+            if (r >= 1.0)
+                return 0.0;
+            const Real s = (1.0-r)*(1.0-r);
+            return s*s*(4.0*r+1.0);
+        }
+
+        Real radius() const { return radius_; }
+
+      private:
+        Real radius_;
+    };
+
 }
 
 
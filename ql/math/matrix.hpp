@@ -28,15 +28,98 @@
 
 #include <ql/math/array.hpp>
 #include <ql/utilities/steppingiterator.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 
 namespace QuantLib {
 
+    class Matrix;
+
+    namespace detail {
+
+        /* Element-wise matrix arithmetic is implemented by means of
+           expression templates, as for arrays; this class is the
+           common base of the expression objects (including Matrix
+           itself).  Elements are accessed in row-major order. */
+        template <class E>
+        class MatrixExpression {
+          public:
+            const E& self() const { return static_cast<const E&>(*this); }
+        };
+
+        // gives matrices the interface of expressions
+        class MatrixReference {
+          public:
+            MatrixReference(const Matrix& m) : m_(m) {}
+            Size rows() const;
+            Size columns() const;
+            Real element(Size i) const;
+          private:
+            const Matrix& m_;
+        };
+
+        // matrices are held by reference, sub-expressions by value
+        template <class E>
+        struct MatrixExpressionStorage {
+            typedef const E type;
+        };
+
+        template <>
+        struct MatrixExpressionStorage<Matrix> {
+            typedef const MatrixReference type;
+        };
+
+        template <class E, class F>
+        class MatrixUnaryExpression
+            : public MatrixExpression<MatrixUnaryExpression<E,F> > {
+          public:
+            MatrixUnaryExpression(const E& e, const F& f) : e_(e), f_(f) {}
+            Size rows() const { return e_.rows(); }
+            Size columns() const { return e_.columns(); }
+            Real element(Size i) const { return f_(e_.element(i)); }
+            Real operator()(Size i, Size j) const {
+                return element(i*columns()+j);
+            }
+            operator Disposable<Matrix>() const;
+          private:
+            typename MatrixExpressionStorage<E>::type e_;
+            F f_;
+        };
+
+        template <class E1, class E2, class Op>
+        class MatrixBinaryExpression
+            : public MatrixExpression<MatrixBinaryExpression<E1,E2,Op> > {
+          public:
+            MatrixBinaryExpression(const E1& e1, const E2& e2)
+            : e1_(e1), e2_(e2) {}
+            Size rows() const { return e1_.rows(); }
+            Size columns() const { return e1_.columns(); }
+            Real element(Size i) const {
+                return op_(e1_.element(i), e2_.element(i));
+            }
+            Real operator()(Size i, Size j) const {
+                return element(i*columns()+j);
+            }
+            operator Disposable<Matrix>() const;
+          private:
+            typename MatrixExpressionStorage<E1>::type e1_;
+            typename MatrixExpressionStorage<E2>::type e2_;
+            Op op_;
+        };
+
+    }
+
     //! %Matrix used in linear algebra.
     /*! This class implements the concept of Matrix as used in linear
         algebra. As such, it is <b>not</b> meant to be used as a
         container.
+
+        Element-wise algebraic operators return expression objects
+        which are evaluated in a single loop when they are assigned to
+        a matrix or converted into one.  Expressions keep references to
+        their matrix operands and should not outlive the statement in
+        which they are created.
     */
-    class Matrix {
+    class Matrix : public detail::MatrixExpression<Matrix> {
       public:
         //! \name Constructors, destructor, and assignment
         //@{
@@ -54,9 +137,23 @@ namespace QuantLib {
         template <class Iterator>
         Matrix(Size rows, Size columns, Iterator begin, Iterator end);
         Matrix(const Matrix &);
+        #if defined(QL_USE_DISPOSABLE)
         Matrix(const Disposable<Matrix>&);
+        #else
+        Matrix(Matrix&&);
+        #endif
+        //! creates the matrix by evaluating an algebraic expression
+        template <class E>
+        Matrix(const detail::MatrixExpression<E>&);
         Matrix& operator=(const Matrix&);
+        #if defined(QL_USE_DISPOSABLE)
         Matrix& operator=(const Disposable<Matrix>&);
+        #else
+        Matrix& operator=(Matrix&&);
+        #endif
+        //! evaluates the expression in place if the sizes match
+        template <class E>
+        Matrix& operator=(const detail::MatrixExpression<E>&);
         //@}
 
         //! \name Algebraic operators
@@ -68,6 +165,10 @@ namespace QuantLib {
         const Matrix& operator-=(const Matrix&);
         const Matrix& operator*=(Real);
         const Matrix& operator/=(Real);
+        template <class E>
+        const Matrix& operator+=(const detail::MatrixExpression<E>&);
+        template <class E>
+        const Matrix& operator-=(const detail::MatrixExpression<E>&);
         //@}
 
         typedef Real* iterator;
@@ -137,44 +238,59 @@ namespace QuantLib {
         void swap(Matrix&);
         //@}
       private:
-        boost::scoped_array<Real> data_;
+        detail::PooledBuffer data_;
         Size rows_, columns_;
     };
 
     // algebraic operators
 
     /*! \relates Matrix */
-    const Disposable<Matrix> operator+(const Matrix&, const Matrix&);
+    template <class E1, class E2>
+    const detail::MatrixBinaryExpression<E1,E2,std::plus<Real> >
+    operator+(const detail::MatrixExpression<E1>&,
+              const detail::MatrixExpression<E2>&);
     /*! \relates Matrix */
-    const Disposable<Matrix> operator-(const Matrix&, const Matrix&);
+    template <class E1, class E2>
+    const detail::MatrixBinaryExpression<E1,E2,std::minus<Real> >
+    operator-(const detail::MatrixExpression<E1>&,
+              const detail::MatrixExpression<E2>&);
     /*! \relates Matrix */
-    const Disposable<Matrix> operator*(const Matrix&, Real);
+    template <class E>
+    const detail::MatrixUnaryExpression<
+                        E,detail::ScalarOnRight<std::multiplies<Real> > >
+    operator*(const detail::MatrixExpression<E>&, Real);
     /*! \relates Matrix */
-    const Disposable<Matrix> operator*(Real, const Matrix&);
+    template <class E>
+    const detail::MatrixUnaryExpression<
+                         E,detail::ScalarOnLeft<std::multiplies<Real> > >
+    operator*(Real, const detail::MatrixExpression<E>&);
     /*! \relates Matrix */
-    const Disposable<Matrix> operator/(const Matrix&, Real);
+    template <class E>
+    const detail::MatrixUnaryExpression<
+                           E,detail::ScalarOnRight<std::divides<Real> > >
+    operator/(const detail::MatrixExpression<E>&, Real);
 
 
     // vectorial products
 
     /*! \relates Matrix */
-    const Disposable<Array> operator*(const Array&, const Matrix&);
+    Disposable<Array> operator*(const Array&, const Matrix&);
     /*! \relates Matrix */
-    const Disposable<Array> operator*(const Matrix&, const Array&);
+    Disposable<Array> operator*(const Matrix&, const Array&);
     /*! \relates Matrix */
-    const Disposable<Matrix> operator*(const Matrix&, const Matrix&);
+    Disposable<Matrix> operator*(const Matrix&, const Matrix&);
 
     // misc. operations
 
     /*! \relates Matrix */
-    const Disposable<Matrix> transpose(const Matrix&);
+    Disposable<Matrix> transpose(const Matrix&);
 
     /*! \relates Matrix */
-    const Disposable<Matrix> outerProduct(const Array& v1, const Array& v2);
+    Disposable<Matrix> outerProduct(const Array& v1, const Array& v2);
 
     /*! \relates Matrix */
     template<class Iterator1, class Iterator2>
-    const Disposable<Matrix> outerProduct(Iterator1 v1begin, Iterator1 v1end,
+    Disposable<Matrix> outerProduct(Iterator1 v1begin, Iterator1 v1end,
                                           Iterator2 v2begin, Iterator2 v2end);
 
     /*! \relates Matrix */
@@ -192,14 +308,14 @@ namespace QuantLib {
     // inline definitions
 
     inline Matrix::Matrix()
-    : data_((Real*)(0)), rows_(0), columns_(0) {}
+    : rows_(0), columns_(0) {}
 
     inline Matrix::Matrix(Size rows, Size columns)
-    : data_(rows*columns > 0 ? new Real[rows*columns] : (Real*)(0)),
+    : data_(rows*columns),
       rows_(rows), columns_(columns) {}
 
     inline Matrix::Matrix(Size rows, Size columns, Real value)
-    : data_(rows*columns > 0 ? new Real[rows*columns] : (Real*)(0)),
+    : data_(rows*columns),
       rows_(rows), columns_(columns) {
         std::fill(begin(),end(),value);
     }
@@ -207,13 +323,13 @@ namespace QuantLib {
     template <class Iterator>
     inline Matrix::Matrix(Size rows, Size columns,
                           Iterator begin, Iterator end)
-        : data_(rows * columns > 0 ? new Real[rows * columns] : (Real *)(0)),
+        : data_(rows * columns),
           rows_(rows), columns_(columns) {
         std::copy(begin, end, this->begin());
     }
 
     inline Matrix::Matrix(const Matrix& from)
-    : data_(!from.empty() ? new Real[from.rows_*from.columns_] : (Real*)(0)),
+    : data_(from.rows_*from.columns_),
       rows_(from.rows_), columns_(from.columns_) {
         #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
         if (!from.empty())
@@ -221,10 +337,28 @@ namespace QuantLib {
         std::copy(from.begin(),from.end(),begin());
     }
 
+    #if defined(QL_USE_DISPOSABLE)
     inline Matrix::Matrix(const Disposable<Matrix>& from)
-    : data_((Real*)(0)), rows_(0), columns_(0) {
+    : rows_(0), columns_(0) {
         swap(const_cast<Disposable<Matrix>&>(from));
     }
+    #else
+    inline Matrix::Matrix(Matrix&& from)
+    : rows_(0), columns_(0) {
+        swap(from);
+    }
+    #endif
+
+    template <class E>
+    inline Matrix::Matrix(const detail::MatrixExpression<E>& e)
+    : data_(e.self().rows()*e.self().columns()),
+      rows_(e.self().rows()), columns_(e.self().columns()) {
+        const E& expression = e.self();
+        const Size size = rows_*columns_;
+        iterator out = begin();
+        for (Size i=0; i<size; ++i)
+            out[i] = expression.element(i);
+    }
 
     inline Matrix& Matrix::operator=(const Matrix& from) {
         // strong guarantee
@@ -233,10 +367,32 @@ namespace QuantLib {
         return *this;
     }
 
+    #if defined(QL_USE_DISPOSABLE)
     inline Matrix& Matrix::operator=(const Disposable<Matrix>& from) {
         swap(const_cast<Disposable<Matrix>&>(from));
         return *this;
     }
+    #else
+    inline Matrix& Matrix::operator=(Matrix&& from) {
+        swap(from);
+        return *this;
+    }
+    #endif
+
+    template <class E>
+    inline Matrix& Matrix::operator=(const detail::MatrixExpression<E>& e) {
+        const E& expression = e.self();
+        if (rows_ == expression.rows() && columns_ == expression.columns()) {
+            const Size size = rows_*columns_;
+            iterator out = begin();
+            for (Size i=0; i<size; ++i)
+                out[i] = expression.element(i);
+        } else {
+            Matrix temp(e);
+            swap(temp);
+        }
+        return *this;
+    }
 
     inline void Matrix::swap(Matrix& from) {
         using std::swap;
@@ -279,6 +435,40 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class E>
+    inline const Matrix&
+    Matrix::operator+=(const detail::MatrixExpression<E>& e) {
+        const E& expression = e.self();
+        QL_REQUIRE(rows_ == expression.rows() &&
+                   columns_ == expression.columns(),
+                   "matrices with different sizes (" <<
+                   expression.rows() << "x" << expression.columns() << ", "
+                   << rows_ << "x" << columns_ << ") cannot be "
+                   "added");
+        const Size size = rows_*columns_;
+        iterator out = begin();
+        for (Size i=0; i<size; ++i)
+            out[i] += expression.element(i);
+        return *this;
+    }
+
+    template <class E>
+    inline const Matrix&
+    Matrix::operator-=(const detail::MatrixExpression<E>& e) {
+        const E& expression = e.self();
+        QL_REQUIRE(rows_ == expression.rows() &&
+                   columns_ == expression.columns(),
+                   "matrices with different sizes (" <<
+                   expression.rows() << "x" << expression.columns() << ", "
+                   << rows_ << "x" << columns_ << ") cannot be "
+                   "subtracted");
+        const Size size = rows_*columns_;
+        iterator out = begin();
+        for (Size i=0; i<size; ++i)
+            out[i] -= expression.element(i);
+        return *this;
+    }
+
     inline Matrix::const_iterator Matrix::begin() const {
         return data_.get();
     }
@@ -476,56 +666,95 @@ namespace QuantLib {
         return rows_ == 0 || columns_ == 0;
     }
 
-    inline const Disposable<Matrix> operator+(const Matrix& m1,
-                                              const Matrix& m2) {
+    namespace detail {
+
+        inline Size MatrixReference::rows() const {
+            return m_.rows();
+        }
+
+        inline Size MatrixReference::columns() const {
+            return m_.columns();
+        }
+
+        inline Real MatrixReference::element(Size i) const {
+            return m_.begin()[i];
+        }
+
+        template <class E, class F>
+        inline MatrixUnaryExpression<E,F>::operator
+        Disposable<Matrix>() const {
+            // through the base class; when Disposable<Matrix> is Matrix,
+            // C++17 compilers might otherwise call this operator again
+            const MatrixExpression<MatrixUnaryExpression>& e = *this;
+            Matrix result(e);
+            return result;
+        }
+
+        template <class E1, class E2, class Op>
+        inline MatrixBinaryExpression<E1,E2,Op>::operator
+        Disposable<Matrix>() const {
+            const MatrixExpression<MatrixBinaryExpression>& e = *this;
+            Matrix result(e);
+            return result;
+        }
+
+    }
+
+    template <class E1, class E2>
+    inline const detail::MatrixBinaryExpression<E1,E2,std::plus<Real> >
+    operator+(const detail::MatrixExpression<E1>& e1,
+              const detail::MatrixExpression<E2>& e2) {
+        const E1& m1 = e1.self();
+        const E2& m2 = e2.self();
         QL_REQUIRE(m1.rows() == m2.rows() &&
                    m1.columns() == m2.columns(),
                    "matrices with different sizes (" <<
                    m1.rows() << "x" << m1.columns() << ", " <<
                    m2.rows() << "x" << m2.columns() << ") cannot be "
                    "added");
-        Matrix temp(m1.rows(),m1.columns());
-        std::transform(m1.begin(),m1.end(),m2.begin(),temp.begin(),
-                       std::plus<Real>());
-        return temp;
+        return detail::MatrixBinaryExpression<E1,E2,std::plus<Real> >(m1, m2);
     }
 
-    inline const Disposable<Matrix> operator-(const Matrix& m1,
-                                              const Matrix& m2) {
+    template <class E1, class E2>
+    inline const detail::MatrixBinaryExpression<E1,E2,std::minus<Real> >
+    operator-(const detail::MatrixExpression<E1>& e1,
+              const detail::MatrixExpression<E2>& e2) {
+        const E1& m1 = e1.self();
+        const E2& m2 = e2.self();
         QL_REQUIRE(m1.rows() == m2.rows() &&
                    m1.columns() == m2.columns(),
                    "matrices with different sizes (" <<
                    m1.rows() << "x" << m1.columns() << ", " <<
                    m2.rows() << "x" << m2.columns() << ") cannot be "
                    "subtracted");
-        Matrix temp(m1.rows(),m1.columns());
-        std::transform(m1.begin(),m1.end(),m2.begin(),temp.begin(),
-                       std::minus<Real>());
-        return temp;
+        return detail::MatrixBinaryExpression<E1,E2,std::minus<Real> >(m1, m2);
     }
 
-    inline const Disposable<Matrix> operator*(const Matrix& m, Real x) {
-        Matrix temp(m.rows(),m.columns());
-        std::transform(m.begin(),m.end(),temp.begin(),
-                       std::bind2nd(std::multiplies<Real>(),x));
-        return temp;
+    template <class E>
+    inline const detail::MatrixUnaryExpression<
+                        E,detail::ScalarOnRight<std::multiplies<Real> > >
+    operator*(const detail::MatrixExpression<E>& e, Real x) {
+        typedef detail::ScalarOnRight<std::multiplies<Real> > F;
+        return detail::MatrixUnaryExpression<E,F>(e.self(), F(x));
     }
 
-    inline const Disposable<Matrix> operator*(Real x, const Matrix& m) {
-        Matrix temp(m.rows(),m.columns());
-        std::transform(m.begin(),m.end(),temp.begin(),
-                       std::bind2nd(std::multiplies<Real>(),x));
-        return temp;
+    template <class E>
+    inline const detail::MatrixUnaryExpression<
+                         E,detail::ScalarOnLeft<std::multiplies<Real> > >
+    operator*(Real x, const detail::MatrixExpression<E>& e) {
+        typedef detail::ScalarOnLeft<std::multiplies<Real> > F;
+        return detail::MatrixUnaryExpression<E,F>(e.self(), F(x));
     }
 
-    inline const Disposable<Matrix> operator/(const Matrix& m, Real x) {
-        Matrix temp(m.rows(),m.columns());
-        std::transform(m.begin(),m.end(),temp.begin(),
-                       std::bind2nd(std::divides<Real>(),x));
-        return temp;
+    template <class E>
+    inline const detail::MatrixUnaryExpression<
+                           E,detail::ScalarOnRight<std::divides<Real> > >
+    operator/(const detail::MatrixExpression<E>& e, Real x) {
+        typedef detail::ScalarOnRight<std::divides<Real> > F;
+        return detail::MatrixUnaryExpression<E,F>(e.self(), F(x));
     }
 
-    inline const Disposable<Array> operator*(const Array& v, const Matrix& m) {
+    inline Disposable<Array> operator*(const Array& v, const Matrix& m) {
         QL_REQUIRE(v.size() == m.rows(),
                    "vectors and matrices with different sizes ("
                    << v.size() << ", " << m.rows() << "x" << m.columns() <<
@@ -534,11 +763,11 @@ namespace QuantLib {
         for (Size i=0; i<result.size(); i++)
             result[i] =
                 std::inner_product(v.begin(),v.end(),
-                                   m.column_begin(i),0.0);
+                                   m.column_begin(i),Real(0.0));
         return result;
     }
 
-    inline const Disposable<Array> operator*(const Matrix& m, const Array& v) {
+    inline Disposable<Array> operator*(const Matrix& m, const Array& v) {
         QL_REQUIRE(v.size() == m.columns(),
                    "vectors and matrices with different sizes ("
                    << v.size() << ", " << m.rows() << "x" << m.columns() <<
@@ -546,11 +775,11 @@ namespace QuantLib {
         Array result(m.rows());
         for (Size i=0; i<result.size(); i++)
             result[i] =
-                std::inner_product(v.begin(),v.end(),m.row_begin(i),0.0);
+                std::inner_product(v.begin(),v.end(),m.row_begin(i),Real(0.0));
         return result;
     }
 
-    inline const Disposable<Matrix> operator*(const Matrix& m1,
+    inline Disposable<Matrix> operator*(const Matrix& m1,
                                               const Matrix& m2) {
         QL_REQUIRE(m1.columns() == m2.rows(),
                    "matrices with different sizes (" <<
@@ -558,6 +787,13 @@ namespace QuantLib {
                    m2.rows() << "x" << m2.columns() << ") cannot be "
                    "multiplied");
         Matrix result(m1.rows(),m2.columns(),0.0);
+        #if defined(QL_USE_LAPACK)
+        if (result.rows()*m1.columns()*result.columns()
+                                     >= detail::blasMinimumProductSize) {
+            detail::blasMultiply(m1, m2, result);
+            return result;
+        }
+        #endif
         for (Size i=0; i<result.rows(); ++i) {
             for (Size k=0; k<m1.columns(); ++k) {
                 for (Size j=0; j<result.columns(); ++j) {
@@ -568,7 +804,7 @@ namespace QuantLib {
         return result;
     }
 
-    inline const Disposable<Matrix> transpose(const Matrix& m) {
+    inline Disposable<Matrix> transpose(const Matrix& m) {
         Matrix result(m.columns(),m.rows());
         #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
         if (!m.empty())
@@ -578,13 +814,13 @@ namespace QuantLib {
         return result;
     }
 
-    inline const Disposable<Matrix> outerProduct(const Array& v1,
+    inline Disposable<Matrix> outerProduct(const Array& v1,
                                                  const Array& v2) {
         return outerProduct(v1.begin(), v1.end(), v2.begin(), v2.end());
     }
 
     template<class Iterator1, class Iterator2>
-    inline const Disposable<Matrix> outerProduct(Iterator1 v1begin,
+    inline Disposable<Matrix> outerProduct(Iterator1 v1begin,
                                                  Iterator1 v1end,
                                                  Iterator2 v2begin,
                                                  Iterator2 v2end) {
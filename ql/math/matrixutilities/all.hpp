@@ -4,9 +4,12 @@
 #include <ql/math/matrixutilities/basisincompleteordered.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <ql/math/matrixutilities/csrilupreconditioner.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/factorreduction.hpp>
 #include <ql/math/matrixutilities/getcovariance.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/matrixutilities/qrdecomposition.hpp>
 #include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
@@ -24,6 +24,9 @@
 
 
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
 
 namespace QuantLib {
 
@@ -34,6 +37,15 @@ namespace QuantLib {
       maxIter_(maxIter), relTol_(relTol) {
     }
 
+    BiCGstab::BiCGstab(const CsrMatrix& A,
+                       Size maxIter, Real relTol,
+                       const BiCGstab::MatrixMult& preConditioner)
+    : A_(boost::bind(&CsrMatrix::apply,
+                     boost::make_shared<CsrMatrix>(A), _1)),
+      M_(preConditioner),
+      maxIter_(maxIter), relTol_(relTol) {
+    }
+
     BiCGStabResult BiCGstab::solve(const Array& b, const Array& x0) const {
         Real bnorm2 = Norm2(b);
         if (bnorm2 == 0.0) {
@@ -30,6 +30,8 @@
 
 namespace QuantLib {
 
+    class CsrMatrix;
+
     struct BiCGStabResult {
         Size iterations;
         Real error;
@@ -42,6 +44,9 @@ namespace QuantLib {
         
         BiCGstab(const MatrixMult& A, Size maxIter, Real relTol,
                  const MatrixMult& preConditioner = MatrixMult());
+        //! solves systems with the given matrix, which is copied
+        BiCGstab(const CsrMatrix& A, Size maxIter, Real relTol,
+                 const MatrixMult& preConditioner = MatrixMult());
         
         BiCGStabResult solve(const Array& b, const Array& x0 = Array()) const;
         
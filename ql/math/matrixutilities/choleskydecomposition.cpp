@@ -19,11 +19,12 @@
 */
 
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 #include <ql/math/comparison.hpp>
 
 namespace QuantLib {
 
-    const Disposable<Matrix> CholeskyDecomposition(const Matrix &S,
+    Disposable<Matrix> CholeskyDecomposition(const Matrix &S,
                                                    bool flexible) {
         Size i, j, size = S.rows();
 
@@ -36,6 +37,16 @@ namespace QuantLib {
                            "input matrix is not symmetric");
         #endif
 
+        #if defined(QL_USE_LAPACK)
+        // the built-in algorithm is used for matrices that are not
+        // positive definite, which LAPACK doesn't handle
+        if (size >= detail::lapackMinimumSize) {
+            Matrix L;
+            if (detail::lapackCholesky(S, L))
+                return L;
+        }
+        #endif
+
         Matrix result(size, size, 0.0);
         Real sum;
         for (i=0; i<size; i++) {
@@ -29,7 +29,7 @@
 namespace QuantLib {
 
     /*! \relates Matrix */
-    const Disposable<Matrix> CholeskyDecomposition(const Matrix& m,
+    Disposable<Matrix> CholeskyDecomposition(const Matrix& m,
                                                    bool flexible = false);
 
 }
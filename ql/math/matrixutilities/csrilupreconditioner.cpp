@@ -0,0 +1,97 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrilupreconditioner.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    CsrILUPreconditioner::CsrILUPreconditioner(const CsrMatrix& A)
+    : lu_(A), diagonal_(A.rows()) {
+        QL_REQUIRE(A.rows() == A.columns(),
+                   "ILU preconditioner works only with square matrices");
+
+        const Size n = lu_.rows();
+        const std::vector<Size>& rowPointers = lu_.rowPointers();
+        const std::vector<Size>& columns = lu_.columnIndices();
+        std::vector<Real>& values = lu_.values();
+
+        // position of each element of the current row, if stored
+        const Size none = Null<Size>();
+        std::vector<Size> position(n, none);
+
+        for (Size i=0; i<n; ++i) {
+            const Size begin = rowPointers[i], end = rowPointers[i+1];
+            for (Size k=begin; k<end; ++k)
+                position[columns[k]] = k;
+
+            Size k = begin;
+            for (; k<end && columns[k]<i; ++k) {
+                // the rows above are already factorized
+                const Size j = columns[k];
+                const Real factor = values[k] /= values[diagonal_[j]];
+                for (Size l=diagonal_[j]+1; l<rowPointers[j+1]; ++l) {
+                    const Size p = position[columns[l]];
+                    if (p != none)
+                        values[p] -= factor*values[l];
+                }
+            }
+            QL_REQUIRE(k<end && columns[k] == i,
+                       "missing diagonal element in row " << i);
+            QL_REQUIRE(values[k] != 0.0,
+                       "zero pivot in row " << i);
+            diagonal_[i] = k;
+
+            for (k=begin; k<end; ++k)
+                position[columns[k]] = none;
+        }
+    }
+
+    Disposable<Array> CsrILUPreconditioner::apply(const Array& b) const {
+        Array x(b.size());
+        solve(b, x);
+        return x;
+    }
+
+    void CsrILUPreconditioner::solve(const Array& b, Array& x) const {
+        const Size n = lu_.rows();
+        QL_REQUIRE(b.size() == n && x.size() == n,
+                   "inconsistent array sizes (" << b.size() << ", "
+                   << x.size() << ") for a " << n << "x" << n
+                   << " preconditioner");
+
+        const std::vector<Size>& rowPointers = lu_.rowPointers();
+        const std::vector<Size>& columns = lu_.columnIndices();
+        const std::vector<Real>& values = lu_.values();
+
+        // forward substitution with the unit lower factor
+        for (Size i=0; i<n; ++i) {
+            Real t = b[i];
+            for (Size k=rowPointers[i]; k<diagonal_[i]; ++k)
+                t -= values[k]*x[columns[k]];
+            x[i] = t;
+        }
+        // backward substitution with the upper factor
+        for (Size i=n; i-- > 0; ) {
+            Real t = x[i];
+            for (Size k=diagonal_[i]+1; k<rowPointers[i+1]; ++k)
+                t -= values[k]*x[columns[k]];
+            x[i] = t/values[diagonal_[i]];
+        }
+    }
+
+}
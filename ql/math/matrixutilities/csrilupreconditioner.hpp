@@ -0,0 +1,69 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrilupreconditioner.hpp
+    \brief incomplete LU preconditioner for CSR matrices
+*/
+
+#ifndef quantlib_csr_ilu_preconditioner_hpp
+#define quantlib_csr_ilu_preconditioner_hpp
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+
+namespace QuantLib {
+
+    //! zero fill-in incomplete LU preconditioner
+    /*! The ILU(0) factorization keeps the sparsity pattern of the
+        given matrix: the strictly lower part of the result holds
+        the unit lower-triangular factor L, the rest holds U.  It is
+        the same preconditioner as SparseILUPreconditioner with no
+        fill-in level, but it's computed and applied directly on the
+        CSR arrays.
+
+        References:
+        Saad, Yousef. 1996, Iterative methods for sparse linear systems,
+        algorithm 10.4, http://www-users.cs.umn.edu/~saad/books.html
+
+        \pre the matrix must be square and all its diagonal elements
+             must be stored.
+
+        \test the preconditioner is checked against
+              SparseILUPreconditioner.
+    */
+    class CsrILUPreconditioner {
+      public:
+        explicit CsrILUPreconditioner(const CsrMatrix& A);
+
+        //! L and U stored in the sparsity pattern of A
+        const CsrMatrix& LU() const { return lu_; }
+
+        //! solves L U x = b
+        Disposable<Array> apply(const Array& b) const;
+        /*! in-place variant of apply()
+            \pre x must have the right size and be distinct from b
+        */
+        void solve(const Array& b, Array& x) const;
+
+      private:
+        CsrMatrix lu_;
+        std::vector<Size> diagonal_;
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,153 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    CsrMatrix::CsrMatrix()
+    : columns_(0), rowPointers_(1, 0) {}
+
+    CsrMatrix::CsrMatrix(Size rows, Size columns,
+                         const std::vector<Size>& rowPointers,
+                         const std::vector<Size>& columnIndices,
+                         const std::vector<Real>& values)
+    : columns_(columns), rowPointers_(rowPointers),
+      columnIndices_(columnIndices), values_(values) {
+        QL_REQUIRE(rowPointers_.size() == rows+1,
+                   rows+1 << " row pointers required, "
+                   << rowPointers_.size() << " given");
+        QL_REQUIRE(rowPointers_.front() == 0,
+                   "the first row pointer must be null");
+        QL_REQUIRE(columnIndices_.size() == values_.size(),
+                   "the number of column indices ("
+                   << columnIndices_.size()
+                   << ") differs from the number of values ("
+                   << values_.size() << ")");
+        QL_REQUIRE(rowPointers_.back() == values_.size(),
+                   "the last row pointer (" << rowPointers_.back()
+                   << ") differs from the number of values ("
+                   << values_.size() << ")");
+        for (Size i=0; i<rows; ++i) {
+            QL_REQUIRE(rowPointers_[i] <= rowPointers_[i+1],
+                       "decreasing row pointers at row " << i);
+            for (Size k=rowPointers_[i]; k<rowPointers_[i+1]; ++k) {
+                QL_REQUIRE(columnIndices_[k] < columns_,
+                           "column index (" << columnIndices_[k]
+                           << ") out of range in row " << i);
+                QL_REQUIRE(k == rowPointers_[i]
+                           || columnIndices_[k-1] < columnIndices_[k],
+                           "unsorted column indices in row " << i);
+            }
+        }
+    }
+
+    #if !defined(QL_NO_UBLAS_SUPPORT)
+    CsrMatrix::CsrMatrix(const SparseMatrix& m)
+    : columns_(m.size2()), rowPointers_(m.size1()+1) {
+        // compressed_matrix uses the same layout, but its row
+        // pointers are only filled up to the last non-empty row
+        const Size filled = m.filled1()-1;
+        for (Size i=0; i<rowPointers_.size(); ++i)
+            rowPointers_[i] = m.index1_data()[std::min(i, filled)];
+        const Size n = rowPointers_.back();
+        columnIndices_.assign(m.index2_data().begin(),
+                              m.index2_data().begin()+n);
+        values_.assign(m.value_data().begin(), m.value_data().begin()+n);
+    }
+
+    Disposable<SparseMatrix> CsrMatrix::toSparseMatrix() const {
+        SparseMatrix m(rows(), columns_, nonZeros());
+        for (Size i=0; i<rows(); ++i)
+            for (Size k=rowPointers_[i]; k<rowPointers_[i+1]; ++k)
+                m.push_back(i, columnIndices_[k], values_[k]);
+        return m;
+    }
+    #endif
+
+    Real CsrMatrix::operator()(Size i, Size j) const {
+        QL_REQUIRE(i < rows() && j < columns_,
+                   "element (" << i << "," << j << ") out of range");
+        const std::vector<Size>::const_iterator begin =
+            columnIndices_.begin()+rowPointers_[i];
+        const std::vector<Size>::const_iterator end =
+            columnIndices_.begin()+rowPointers_[i+1];
+        const std::vector<Size>::const_iterator k =
+            std::lower_bound(begin, end, j);
+        return (k != end && *k == j) ?
+            values_[k-columnIndices_.begin()] : 0.0;
+    }
+
+    void CsrMatrix::multiply(const Array& x, Array& y) const {
+        QL_REQUIRE(x.size() == columns_,
+                   "array of size " << x.size() << " cannot be multiplied "
+                   "by a matrix with " << columns_ << " columns");
+        QL_REQUIRE(y.size() == rows(),
+                   "result array of size " << y.size() << " given for a "
+                   "matrix with " << rows() << " rows");
+
+        // raw pointers let the compiler keep everything in registers
+        const Size n = rows();
+        const Size* rowPointers = &rowPointers_[0];
+        const Size* columnIndices =
+            columnIndices_.empty() ? 0 : &columnIndices_[0];
+        const Real* values = values_.empty() ? 0 : &values_[0];
+        const Real* px = x.begin();
+        Real* py = y.begin();
+
+        #pragma omp parallel for
+        for (Size i=0; i<n; ++i) {
+            Real t = 0.0;
+            const Size end = rowPointers[i+1];
+            for (Size k=rowPointers[i]; k<end; ++k)
+                t += values[k]*px[columnIndices[k]];
+            py[i] = t;
+        }
+    }
+
+    void CsrMatrix::transposeMultiply(const Array& x, Array& y) const {
+        QL_REQUIRE(x.size() == rows(),
+                   "array of size " << x.size() << " cannot be multiplied "
+                   "by the transpose of a matrix with " << rows()
+                   << " rows");
+        QL_REQUIRE(y.size() == columns_,
+                   "result array of size " << y.size() << " given for the "
+                   "transpose of a matrix with " << columns_ << " columns");
+
+        std::fill(y.begin(), y.end(), 0.0);
+        for (Size i=0; i<rows(); ++i) {
+            const Real xi = x[i];
+            for (Size k=rowPointers_[i]; k<rowPointers_[i+1]; ++k)
+                y[columnIndices_[k]] += values_[k]*xi;
+        }
+    }
+
+    Disposable<Array> CsrMatrix::apply(const Array& x) const {
+        Array y(rows());
+        multiply(x, y);
+        return y;
+    }
+
+    void CsrMatrix::swap(CsrMatrix& from) {
+        std::swap(columns_, from.columns_);
+        rowPointers_.swap(from.rowPointers_);
+        columnIndices_.swap(from.columnIndices_);
+        values_.swap(from.values_);
+    }
+
+}
@@ -0,0 +1,119 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrmatrix.hpp
+    \brief sparse matrix in compressed sparse-row format
+*/
+
+#ifndef quantlib_csr_matrix_hpp
+#define quantlib_csr_matrix_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! sparse matrix in compressed sparse-row (CSR) format
+    /*! The non-zero elements are stored row by row in three plain
+        arrays: the values, their column indices and, for each row,
+        the position of its first element (the last entry being the
+        number of non-zero elements).  Unlike the ublas-based
+        SparseMatrix, element access is never needed in the
+        matrix-vector product, whose inner loop runs over contiguous
+        memory; rows are processed in parallel when OpenMP is enabled.
+
+        The class is meant for the iterative solvers and
+        preconditioners; SparseMatrix instances, e.g., returned by
+        FdmLinearOpComposite::toMatrix(), can be converted in linear
+        time.
+
+        \pre column indices must be sorted within each row.
+    */
+    class CsrMatrix {
+      public:
+        //! \name Constructors
+        //@{
+        //! creates a null matrix
+        CsrMatrix();
+        CsrMatrix(Size rows, Size columns,
+                  const std::vector<Size>& rowPointers,
+                  const std::vector<Size>& columnIndices,
+                  const std::vector<Real>& values);
+        #if !defined(QL_NO_UBLAS_SUPPORT)
+        explicit CsrMatrix(const SparseMatrix& m);
+        #endif
+        //@}
+        //! \name Inspectors
+        //@{
+        Size rows() const { return rowPointers_.size()-1; }
+        Size columns() const { return columns_; }
+        Size nonZeros() const { return values_.size(); }
+        const std::vector<Size>& rowPointers() const { return rowPointers_; }
+        const std::vector<Size>& columnIndices() const {
+            return columnIndices_;
+        }
+        const std::vector<Real>& values() const { return values_; }
+        //! allows to modify the values while keeping the sparsity pattern
+        std::vector<Real>& values() { return values_; }
+        //! element access by binary search; not meant for inner loops
+        Real operator()(Size i, Size j) const;
+        //@}
+        //! \name Products
+        //@{
+        /*! y = A x
+            \pre y must have the right size and be distinct from x
+        */
+        void multiply(const Array& x, Array& y) const;
+        /*! y = A^T x
+            \pre y must have the right size and be distinct from x
+        */
+        void transposeMultiply(const Array& x, Array& y) const;
+        //! returns A x; can be bound to the solvers' MatrixMult
+        Disposable<Array> apply(const Array& x) const;
+        //@}
+        #if !defined(QL_NO_UBLAS_SUPPORT)
+        Disposable<SparseMatrix> toSparseMatrix() const;
+        #endif
+        void swap(CsrMatrix&);
+      private:
+        Size columns_;
+        std::vector<Size> rowPointers_, columnIndices_;
+        std::vector<Real> values_;
+    };
+
+    /*! \relates CsrMatrix */
+    Disposable<Array> prod(const CsrMatrix& A, const Array& x);
+
+    /*! \relates CsrMatrix */
+    void swap(CsrMatrix&, CsrMatrix&);
+
+
+    // inline definitions
+
+    inline Disposable<Array> prod(const CsrMatrix& A, const Array& x) {
+        return A.apply(x);
+    }
+
+    inline void swap(CsrMatrix& m1, CsrMatrix& m2) {
+        m1.swap(m2);
+    }
+
+}
+
+
+#endif
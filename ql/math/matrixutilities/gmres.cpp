@@ -24,7 +24,10 @@
 
 #include <ql/math/functional.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
 
 #include <numeric>
 
@@ -39,6 +42,17 @@ namespace QuantLib {
         QL_REQUIRE(maxIter_ > 0, "maxIter must be greater then zero");
     }
 
+    GMRES::GMRES(const CsrMatrix& A,
+                 Size maxIter, Real relTol,
+                 const GMRES::MatrixMult& preConditioner)
+    : A_(boost::bind(&CsrMatrix::apply,
+                     boost::make_shared<CsrMatrix>(A), _1)),
+      M_(preConditioner),
+      maxIter_(maxIter), relTol_(relTol) {
+
+        QL_REQUIRE(maxIter_ > 0, "maxIter must be greater then zero");
+    }
+
     GMRESResult GMRES::solve(const Array& b, const Array& x0) const {
         const GMRESResult result = solveImpl(b, x0);
 
@@ -31,6 +31,8 @@
 
 namespace QuantLib {
 
+    class CsrMatrix;
+
     /*! References:
         Saad, Yousef. 1996, Iterative methods for sparse linear systems,
         http://www-users.cs.umn.edu/~saad/books.html
@@ -57,6 +59,9 @@ namespace QuantLib {
 
         GMRES(const MatrixMult& A, Size maxIter, Real relTol,
                  const MatrixMult& preConditioner = MatrixMult());
+        //! solves systems with the given matrix, which is copied
+        GMRES(const CsrMatrix& A, Size maxIter, Real relTol,
+                 const MatrixMult& preConditioner = MatrixMult());
 
         GMRESResult solve(const Array& b, const Array& x0 = Array()) const;
         GMRESResult solveWithRestart(
@@ -0,0 +1,148 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/lapack.hpp>
+
+#if defined(QL_USE_LAPACK)
+
+#include <ql/math/matrix.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+#include <vector>
+
+// Fortran interface, available in all BLAS and LAPACK implementations
+extern "C" {
+
+    void dgemm_(const char* transa, const char* transb,
+                const int* m, const int* n, const int* k,
+                const double* alpha, const double* a, const int* lda,
+                const double* b, const int* ldb,
+                const double* beta, double* c, const int* ldc);
+
+    void dpotrf_(const char* uplo, const int* n,
+                 double* a, const int* lda, int* info);
+
+    void dgesdd_(const char* jobz, const int* m, const int* n,
+                 double* a, const int* lda, double* s,
+                 double* u, const int* ldu, double* vt, const int* ldvt,
+                 double* work, const int* lwork, int* iwork, int* info);
+
+    void dsyevd_(const char* jobz, const char* uplo, const int* n,
+                 double* a, const int* lda, double* w,
+                 double* work, const int* lwork,
+                 int* iwork, const int* liwork, int* info);
+
+}
+
+namespace QuantLib {
+
+    namespace detail {
+
+        /* The routines work on column-major matrices; a row-major
+           Matrix is seen by them as its transpose, which is taken
+           into account in the calls below. */
+
+        BOOST_STATIC_ASSERT((boost::is_same<Real, double>::value));
+
+        void blasMultiply(const Matrix& m1, const Matrix& m2,
+                          Matrix& result) {
+            // result^T = m2^T m1^T in column-major terms
+            const int m = int(m2.columns()), n = int(m1.rows()),
+                      k = int(m1.columns());
+            const double one = 1.0, zero = 0.0;
+            dgemm_("N", "N", &m, &n, &k,
+                   &one, m2.begin(), &m, m1.begin(), &k,
+                   &zero, result.begin(), &m);
+        }
+
+        bool lapackCholesky(const Matrix& S, Matrix& L) {
+            const int n = int(S.rows());
+            L = S;
+            // the upper factor of the transpose is the lower factor
+            // of the row-major matrix
+            int info;
+            dpotrf_("U", &n, L.begin(), &n, &info);
+            if (info != 0)
+                return false;
+            for (Size i=0; i<S.rows(); ++i)
+                std::fill(L.row_begin(i)+i+1, L.row_end(i), 0.0);
+            return true;
+        }
+
+        bool lapackSVD(const Matrix& A, Matrix& U, Array& s, Matrix& V) {
+            // A^T = U' S V'^T is decomposed, so that U = V' and V = U'
+            const int m = int(A.columns()), n = int(A.rows());
+            Matrix a = A;
+            std::vector<double> u(m*m), vt(m*n);
+            std::vector<int> iw(8*m);
+            Array w(m);
+            int lwork = -1, info;
+            double size;
+            dgesdd_("S", &m, &n, a.begin(), &m, w.begin(),
+                    &u[0], &m, &vt[0], &m, &size, &lwork, &iw[0], &info);
+            if (info != 0)
+                return false;
+            lwork = int(size);
+            std::vector<double> work(lwork);
+            dgesdd_("S", &m, &n, a.begin(), &m, w.begin(),
+                    &u[0], &m, &vt[0], &m, &work[0], &lwork, &iw[0], &info);
+            if (info != 0)
+                return false;
+            s.swap(w);
+            // V'^T is m x n in column-major order, i.e., V' in row-major
+            U = Matrix(n, m);
+            std::copy(vt.begin(), vt.end(), U.begin());
+            // U' is read transposed
+            V = Matrix(m, m);
+            for (Size i=0; i<Size(m); ++i)
+                for (Size j=0; j<Size(m); ++j)
+                    V[i][j] = u[i+j*m];
+            return true;
+        }
+
+        bool lapackSymmetricEigen(const Matrix& S, Array& eigenvalues,
+                                  Matrix& eigenvectors) {
+            const int n = int(S.rows());
+            Matrix z = S;
+            Array w(n);
+            int lwork = -1, liwork = -1, info, isize;
+            double size;
+            dsyevd_("V", "U", &n, z.begin(), &n, w.begin(),
+                    &size, &lwork, &isize, &liwork, &info);
+            if (info != 0)
+                return false;
+            lwork = int(size);
+            liwork = isize;
+            std::vector<double> work(lwork);
+            std::vector<int> iwork(liwork);
+            dsyevd_("V", "U", &n, z.begin(), &n, w.begin(),
+                    &work[0], &lwork, &iwork[0], &liwork, &info);
+            if (info != 0)
+                return false;
+            eigenvalues.swap(w);
+            // the eigenvectors are the columns of the column-major
+            // result, i.e., the rows of z
+            eigenvectors = transpose(z);
+            return true;
+        }
+
+    }
+
+}
+
+#endif
@@ -0,0 +1,80 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lapack.hpp
+    \brief optional BLAS and LAPACK backend for matrix operations
+*/
+
+#ifndef quantlib_lapack_hpp
+#define quantlib_lapack_hpp
+
+#include <ql/qldefines.hpp>
+
+#if defined(QL_USE_LAPACK)
+
+#include <ql/types.hpp>
+
+namespace QuantLib {
+
+    class Array;
+    class Matrix;
+
+    namespace detail {
+
+        /* When QL_USE_LAPACK is defined, matrix products and the
+           Cholesky, singular-value and symmetric eigenvalue
+           decompositions are delegated to the following wrappers
+           around the BLAS and LAPACK routines (dgemm, dpotrf, dgesdd
+           and dsyevd) provided by the library QuantLib is linked to,
+           e.g., the reference implementation, OpenBLAS or MKL.
+
+           The decompositions return false if the routine fails, in
+           which case the caller falls back on its own algorithm; the
+           output arguments are only modified in case of success. */
+
+        // the minimum number of multiplications for which a matrix
+        // product is delegated to BLAS
+        const Size blasMinimumProductSize = 32*32*32;
+
+        // the minimum size of the matrices whose decompositions are
+        // delegated to LAPACK; the built-in algorithms are as fast
+        // and slightly more accurate for smaller ones
+        const Size lapackMinimumSize = 16;
+
+        //! result = m1*m2; the result must already have the right size
+        void blasMultiply(const Matrix& m1, const Matrix& m2,
+                          Matrix& result);
+
+        //! lower-triangular L such that S = L L^T
+        /*! L is also modified if the routine fails */
+        bool lapackCholesky(const Matrix& S, Matrix& L);
+
+        //! A = U diag(s) V^T, with singular values in decreasing order
+        /*! \pre A must have at least as many rows as columns */
+        bool lapackSVD(const Matrix& A, Matrix& U, Array& s, Matrix& V);
+
+        //! eigenvalues (in increasing order) and eigenvectors of S
+        bool lapackSymmetricEigen(const Matrix& S, Array& eigenvalues,
+                                  Matrix& eigenvectors);
+
+    }
+
+}
+
+#endif
+
+#endif
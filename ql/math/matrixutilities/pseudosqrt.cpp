@@ -22,10 +22,13 @@
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/math/matrixutilities/tqreigendecomposition.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/math/optimization/conjugategradient.hpp>
 #include <ql/math/optimization/problem.hpp>
 #include <ql/math/optimization/constraint.hpp>
+#include <boost/function.hpp>
+#include <boost/bind.hpp>
 
 namespace QuantLib {
 
@@ -293,8 +296,8 @@ namespace QuantLib {
         }
 
         // Take a matrix and make all the eigenvalues non-negative
-        const Disposable <Matrix>
-        projectToPositiveSemidefiniteMatrix(Matrix& M) {
+        Disposable<Matrix>
+        projectToPositiveSemidefiniteMatrix(const Matrix& M) {
             Size size = M.rows();
             QL_REQUIRE(size == M.columns(),
                        "matrix not square");
@@ -311,10 +314,15 @@ namespace QuantLib {
 
         // implementation of the Higham algorithm to find the nearest
         // correlation matrix.
+        typedef boost::function<Disposable<Matrix>(const Matrix&)>
+                                                              Projection;
+
         const Disposable <Matrix>
         highamImplementation(const Matrix& A,
                              const Size maxIterations,
-                             const Real& tolerance) {
+                             const Real& tolerance,
+                             const Projection& projectToPositiveSemidefinite =
+                                        projectToPositiveSemidefiniteMatrix) {
 
             Size size = A.rows();
             Matrix R, Y(A), X(A), deltaS(size, size, 0.0);
@@ -324,7 +332,7 @@ namespace QuantLib {
 
             for (Size i=0; i<maxIterations; ++i) {
                 R = Y - deltaS;
-                X = projectToPositiveSemidefiniteMatrix(R);
+                X = projectToPositiveSemidefinite(R);
                 deltaS = X - R;
                 Y = projectToUnitDiagonalMatrix(X);
 
@@ -348,10 +356,125 @@ namespace QuantLib {
             return Y;
         }
 
+        // factor reduction
+        Size numberOfRetainedFactors(const Array& eigenValues,
+                                     Size maxRank,
+                                     Real componentRetainedPercentage) {
+            Size size = eigenValues.size();
+            Real enough = componentRetainedPercentage *
+                          std::accumulate(eigenValues.begin(),
+                                          eigenValues.end(), Real(0.0));
+            if (componentRetainedPercentage == 1.0) {
+                // numerical glitches might cause some factors to be
+                // discarded
+                enough *= 1.1;
+            }
+            // retain at least one factor
+            Real components = eigenValues[0];
+            Size retainedFactors = 1;
+            for (Size i=1; components<enough && i<size; ++i) {
+                components += eigenValues[i];
+                retainedFactors++;
+            }
+            // output is granted to have a rank<=maxRank
+            return std::min(retainedFactors, maxRank);
+        }
+
+        // Householder reduction of a symmetric matrix to tridiagonal
+        // form.  On output, z contains the orthogonal matrix Q such
+        // that Q^T A Q is tridiagonal, with diagonal d and
+        // sub-diagonal elements e[1]...e[n-1]; e[0] is set to zero.
+        // See Golub and van Loan, section 8.3.1.
+        void tridiagonalize(Matrix& z, Array& d, Array& e) {
+            Size n = z.rows();
+            for (Size i=n-1; i>0; --i) {
+                Size l = i-1;
+                Real h = 0.0;
+                if (l > 0) {
+                    Real scale = 0.0;
+                    for (Size k=0; k<i; ++k)
+                        scale += std::fabs(z[i][k]);
+                    if (scale == 0.0) {
+                        e[i] = z[i][l];
+                    } else {
+                        for (Size k=0; k<i; ++k) {
+                            z[i][k] /= scale;
+                            h += z[i][k]*z[i][k];
+                        }
+                        Real f = z[i][l];
+                        Real g = (f >= 0.0 ? -std::sqrt(h) : std::sqrt(h));
+                        e[i] = scale*g;
+                        h -= f*g;
+                        z[i][l] = f-g;
+                        f = 0.0;
+                        for (Size j=0; j<i; ++j) {
+                            z[j][i] = z[i][j]/h;
+                            g = 0.0;
+                            for (Size k=0; k<=j; ++k)
+                                g += z[j][k]*z[i][k];
+                            for (Size k=j+1; k<i; ++k)
+                                g += z[k][j]*z[i][k];
+                            e[j] = g/h;
+                            f += e[j]*z[i][j];
+                        }
+                        Real hh = f/(h+h);
+                        for (Size j=0; j<i; ++j) {
+                            f = z[i][j];
+                            e[j] = g = e[j]-hh*f;
+                            for (Size k=0; k<=j; ++k)
+                                z[j][k] -= f*e[k]+g*z[i][k];
+                        }
+                    }
+                } else {
+                    e[i] = z[i][l];
+                }
+                d[i] = h;
+            }
+            d[0] = 0.0;
+            e[0] = 0.0;
+            // accumulation of the transformations
+            for (Size i=0; i<n; ++i) {
+                if (d[i] != 0.0) {
+                    for (Size j=0; j<i; ++j) {
+                        Real g = 0.0;
+                        for (Size k=0; k<i; ++k)
+                            g += z[i][k]*z[k][j];
+                        for (Size k=0; k<i; ++k)
+                            z[k][j] -= g*z[k][i];
+                    }
+                }
+                d[i] = z[i][i];
+                z[i][i] = 1.0;
+                for (Size j=0; j<i; ++j)
+                    z[j][i] = z[i][j] = 0.0;
+            }
+        }
+
+        // result = m1*m2 without allocating; result must be distinct
+        // from the operands
+        void multiply(const Matrix& m1, const Matrix& m2, Matrix& result) {
+            if (result.rows() != m1.rows() ||
+                result.columns() != m2.columns())
+                result = Matrix(m1.rows(), m2.columns());
+            std::fill(result.begin(), result.end(), 0.0);
+            for (Size i=0; i<m1.rows(); ++i)
+                for (Size k=0; k<m1.columns(); ++k)
+                    for (Size j=0; j<m2.columns(); ++j)
+                        result[i][j] += m1[i][k]*m2[k][j];
+        }
+
+        // a warm start is only attempted when the off-diagonal part
+        // of the rotated matrix is this small with respect to its norm
+        const Real warmStartThreshold = 1.0e-4;
+        const Size maxJacobiSweeps = 3;
+        // round-off errors in the eigenvectors accumulate between warm
+        // starts; a full decomposition is performed every so often
+        const Size maxConsecutiveWarmStarts = 10;
+
     }
 
 
-    const Disposable<Matrix> pseudoSqrt(const Matrix& matrix,
+    Disposable<Matrix> pseudoSqrt(const Matrix& matrix,
                                         SalvagingAlgorithm::Type sa) {
         Size size = matrix.rows();
 
@@ -432,7 +555,7 @@ namespace QuantLib {
     }
 
 
-    const Disposable<Matrix> rankReducedSqrt(const Matrix& matrix,
+    Disposable<Matrix> rankReducedSqrt(const Matrix& matrix,
                                              Size maxRank,
                                              Real componentRetainedPercentage,
                                              SalvagingAlgorithm::Type sa) {
@@ -486,23 +609,8 @@ namespace QuantLib {
             QL_FAIL("unknown or invalid salvaging algorithm");
         }
 
-        // factor reduction
-        Real enough = componentRetainedPercentage *
-                      std::accumulate(eigenValues.begin(),
-                                      eigenValues.end(), Real(0.0));
-        if (componentRetainedPercentage == 1.0) {
-            // numerical glitches might cause some factors to be discarded
-            enough *= 1.1;
-        }
-        // retain at least one factor
-        Real components = eigenValues[0];
-        Size retainedFactors = 1;
-        for (Size i=1; components<enough && i<size; ++i) {
-            components += eigenValues[i];
-            retainedFactors++;
-        }
-        // output is granted to have a rank<=maxRank
-        retainedFactors=std::min(retainedFactors, maxRank);
+        Size retainedFactors = numberOfRetainedFactors(
+                       eigenValues, maxRank, componentRetainedPercentage);
 
         Matrix diagonal(size, retainedFactors, 0.0);
         for (Size i=0; i<retainedFactors; ++i)
@@ -513,4 +621,306 @@ namespace QuantLib {
         return result;
     }
 
+
+
+    PseudoSqrtCalculator::PseudoSqrtCalculator(SalvagingAlgorithm::Type sa)
+    : sa_(sa), consecutiveWarmStarts_(0), warmStarts_(0) {}
+
+    void PseudoSqrtCalculator::reset() {
+        eigenvalues_ = Array();
+        eigenvectors_ = Matrix();
+        consecutiveWarmStarts_ = 0;
+    }
+
+    Disposable<Matrix> PseudoSqrtCalculator::pseudoSqrt(const Matrix& matrix) {
+        Size size = matrix.rows();
+
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+        checkSymmetry(matrix);
+        #else
+        QL_REQUIRE(size == matrix.columns(),
+                   "non square matrix: " << size << " rows, " <<
+                   matrix.columns() << " columns");
+        #endif
+
+        Matrix result;
+        switch (sa_) {
+          case SalvagingAlgorithm::None:
+            decompose(matrix);
+            // eigenvalues are sorted in decreasing order
+            QL_REQUIRE(eigenvalues_[size-1]>=-1e-16,
+                       "negative eigenvalue(s) ("
+                       << std::scientific << eigenvalues_[size-1]
+                       << ")");
+            result = CholeskyDecomposition(matrix, true);
+            break;
+          case SalvagingAlgorithm::Spectral:
+          case SalvagingAlgorithm::Hypersphere:
+          case SalvagingAlgorithm::LowerDiagonal: {
+              decompose(matrix);
+              // negative eigenvalues set to zero
+              bool negative = false;
+              result = Matrix(size, size);
+              for (Size j=0; j<size; ++j) {
+                  if (eigenvalues_[j]<0.0) negative = true;
+                  Real lambda =
+                      std::sqrt(std::max<Real>(eigenvalues_[j], 0.0));
+                  for (Size i=0; i<size; ++i)
+                      result[i][j] = eigenvectors_[i][j]*lambda;
+              }
+              normalizePseudoRoot(matrix, result);
+
+              if (negative && sa_ != SalvagingAlgorithm::Spectral)
+                  result = hypersphereOptimize(
+                      matrix, result,
+                      sa_ == SalvagingAlgorithm::LowerDiagonal);
+            }
+            break;
+          case SalvagingAlgorithm::Higham: {
+              Size maxIterations = 40;
+              Real tol = 1e-6;
+              result = highamImplementation(
+                  matrix, maxIterations, tol,
+                  boost::bind(
+                      &PseudoSqrtCalculator::projectToPositiveSemidefinite,
+                      this, _1));
+              result = CholeskyDecomposition(result, true);
+            }
+            break;
+          default:
+            QL_FAIL("unknown salvaging algorithm");
+        }
+
+        return result;
+    }
+
+    Disposable<Matrix> PseudoSqrtCalculator::rankReducedSqrt(
+                                      const Matrix& matrix,
+                                      Size maxRank,
+                                      Real componentRetainedPercentage) {
+        Size size = matrix.rows();
+
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+        checkSymmetry(matrix);
+        #else
+        QL_REQUIRE(size == matrix.columns(),
+                   "non square matrix: " << size << " rows, " <<
+                   matrix.columns() << " columns");
+        #endif
+
+        QL_REQUIRE(componentRetainedPercentage>0.0,
+                   "no eigenvalues retained");
+
+        QL_REQUIRE(componentRetainedPercentage<=1.0,
+                   "percentage to be retained > 100%");
+
+        QL_REQUIRE(maxRank>=1,
+                   "max rank required < 1");
+
+        switch (sa_) {
+          case SalvagingAlgorithm::None:
+            decompose(matrix);
+            // eigenvalues are sorted in decreasing order
+            QL_REQUIRE(eigenvalues_[size-1]>=-1e-16,
+                       "negative eigenvalue(s) ("
+                       << std::scientific << eigenvalues_[size-1]
+                       << ")");
+            break;
+          case SalvagingAlgorithm::Spectral:
+            decompose(matrix);
+            break;
+          case SalvagingAlgorithm::Higham: {
+              Size maxIterations = 40;
+              Real tolerance = 1e-6;
+              decompose(highamImplementation(
+                  matrix, maxIterations, tolerance,
+                  boost::bind(
+                      &PseudoSqrtCalculator::projectToPositiveSemidefinite,
+                      this, _1)));
+            }
+            break;
+          default:
+            QL_FAIL("unknown or invalid salvaging algorithm");
+        }
+
+        Array eigenValues = eigenvalues_;
+        if (sa_ == SalvagingAlgorithm::Spectral) {
+            // negative eigenvalues set to zero
+            for (Size i=0; i<size; ++i)
+                eigenValues[i] = std::max<Real>(eigenValues[i], 0.0);
+        }
+
+        Size retainedFactors = numberOfRetainedFactors(
+                       eigenValues, maxRank, componentRetainedPercentage);
+
+        Matrix result(size, retainedFactors);
+        for (Size j=0; j<retainedFactors; ++j) {
+            Real lambda = std::sqrt(eigenValues[j]);
+            for (Size i=0; i<size; ++i)
+                result[i][j] = eigenvectors_[i][j]*lambda;
+        }
+
+        normalizePseudoRoot(matrix, result);
+        return result;
+    }
+
+    void PseudoSqrtCalculator::decompose(const Matrix& matrix) {
+        if (eigenvectors_.rows() == matrix.rows() &&
+            consecutiveWarmStarts_ < maxConsecutiveWarmStarts &&
+            jacobiRefinement(matrix)) {
+            ++consecutiveWarmStarts_;
+            ++warmStarts_;
+        } else {
+            tridiagonalDecomposition(matrix);
+            consecutiveWarmStarts_ = 0;
+        }
+        sortEigenvalues();
+    }
+
+    void PseudoSqrtCalculator::tridiagonalDecomposition(
+                                                     const Matrix& matrix) {
+        Size size = matrix.rows();
+        if (rotated_.rows() != size)
+            rotated_ = Matrix(size, size);
+        std::copy(matrix.begin(), matrix.end(), rotated_.begin());
+
+        Array diagonal(size), subDiagonal(size);
+        tridiagonalize(rotated_, diagonal, subDiagonal);
+
+        TqrEigenDecomposition tqr(
+                   diagonal, Array(subDiagonal.begin()+1, subDiagonal.end()));
+        eigenvalues_ = tqr.eigenvalues();
+        multiply(rotated_, tqr.eigenvectors(), eigenvectors_);
+    }
+
+    bool PseudoSqrtCalculator::jacobiRefinement(const Matrix& matrix) {
+        Size size = matrix.rows();
+
+        // the previous eigenvectors V are used to rotate the matrix;
+        // if they are still close to the new eigenvectors, V^T M V
+        // is nearly diagonal.
+        multiply(matrix, eigenvectors_, product_);
+        if (rotated_.rows() != size)
+            rotated_ = Matrix(size, size);
+        for (Size i=0; i<size; ++i) {
+            for (Size j=0; j<=i; ++j) {
+                Real sum = 0.0;
+                for (Size k=0; k<size; ++k)
+                    sum += eigenvectors_[k][i]*product_[k][j];
+                rotated_[i][j] = rotated_[j][i] = sum;
+            }
+        }
+
+        Real offDiagonal = 0.0, norm = 0.0;
+        for (Size i=0; i<size; ++i) {
+            norm += rotated_[i][i]*rotated_[i][i];
+            for (Size j=0; j<i; ++j)
+                offDiagonal += 2.0*rotated_[i][j]*rotated_[i][j];
+        }
+        norm = std::sqrt(norm+offDiagonal);
+        offDiagonal = std::sqrt(offDiagonal);
+        if (offDiagonal > warmStartThreshold*norm)
+            return false;
+
+        // cyclic Jacobi sweeps, see Golub and van Loan, section 8.4.
+        // Elements below the accuracy of the tridiagonal algorithm
+        // are not rotated away.
+        if (rotations_.rows() != size)
+            rotations_ = Matrix(size, size);
+        std::fill(rotations_.begin(), rotations_.end(), 0.0);
+        for (Size i=0; i<size; ++i)
+            rotations_[i][i] = 1.0;
+
+        Real threshold = QL_EPSILON*norm;
+        bool converged = false, rotated = false;
+        for (Size sweep=0; sweep<maxJacobiSweeps && !converged; ++sweep) {
+            converged = true;
+            for (Size p=0; p<size; ++p) {
+                for (Size q=p+1; q<size; ++q) {
+                    Real apq = rotated_[p][q];
+                    if (std::fabs(apq) <= threshold)
+                        continue;
+                    converged = false;
+                    rotated = true;
+
+                    Real tau = (rotated_[q][q]-rotated_[p][p])/(2.0*apq);
+                    Real t = (tau >= 0.0 ? 1.0 : -1.0) /
+                        (std::fabs(tau) + std::sqrt(1.0+tau*tau));
+                    Real c = 1.0/std::sqrt(1.0+t*t), s = t*c;
+
+                    for (Size k=0; k<size; ++k) {
+                        Real akp = rotated_[k][p], akq = rotated_[k][q];
+                        rotated_[k][p] = c*akp - s*akq;
+                        rotated_[k][q] = s*akp + c*akq;
+                    }
+                    for (Size k=0; k<size; ++k) {
+                        Real apk = rotated_[p][k], aqk = rotated_[q][k];
+                        rotated_[p][k] = c*apk - s*aqk;
+                        rotated_[q][k] = s*apk + c*aqk;
+                    }
+                    rotated_[p][q] = rotated_[q][p] = 0.0;
+                    for (Size k=0; k<size; ++k) {
+                        Real vkp = rotations_[k][p], vkq = rotations_[k][q];
+                        rotations_[k][p] = c*vkp - s*vkq;
+                        rotations_[k][q] = s*vkp + c*vkq;
+                    }
+                }
+            }
+        }
+        if (!converged)
+            return false;
+
+        for (Size i=0; i<size; ++i)
+            eigenvalues_[i] = rotated_[i][i];
+        if (rotated) {
+            multiply(eigenvectors_, rotations_, product_);
+            eigenvectors_.swap(product_);
+        }
+        return true;
+    }
+
+    void PseudoSqrtCalculator::sortEigenvalues() {
+        // same ordering and sign conventions as
+        // SymmetricSchurDecomposition
+        Size size = eigenvalues_.size();
+        std::vector<std::pair<Real, Size> > order(size);
+        for (Size i=0; i<size; ++i)
+            order[i] = std::make_pair(eigenvalues_[i], i);
+        std::sort(order.begin(), order.end(),
+                  std::greater<std::pair<Real, Size> >());
+
+        if (product_.rows() != size || product_.columns() != size)
+            product_ = Matrix(size, size);
+        Real maxEv = order[0].first;
+        for (Size j=0; j<size; ++j) {
+            // check for round-off errors
+            eigenvalues_[j] =
+                (std::fabs(order[j].first/maxEv)<1e-16 ? 0.0 :
+                                                         order[j].first);
+            Size col = order[j].second;
+            Real sign = (eigenvectors_[0][col]<0.0 ? -1.0 : 1.0);
+            for (Size i=0; i<size; ++i)
+                product_[i][j] = sign*eigenvectors_[i][col];
+        }
+        eigenvectors_.swap(product_);
+    }
+
+    Disposable<Matrix>
+    PseudoSqrtCalculator::projectToPositiveSemidefinite(const Matrix& M) {
+        decompose(M);
+        Size size = M.rows();
+        Matrix result(size, size);
+        for (Size i=0; i<size; ++i) {
+            for (Size j=0; j<=i; ++j) {
+                Real sum = 0.0;
+                for (Size k=0; k<size; ++k)
+                    sum += eigenvectors_[i][k] *
+                        std::max<Real>(eigenvalues_[k], 0.0) *
+                        eigenvectors_[j][k];
+                result[i][j] = result[j][i] = sum;
+            }
+        }
+        return result;
+    }
+
 }
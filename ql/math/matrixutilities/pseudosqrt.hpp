@@ -61,7 +61,7 @@ namespace QuantLib {
         - the correctness of the results is tested by checking
           returned values against numerical calculations.
     */
-    const Disposable<Matrix> pseudoSqrt(
+    Disposable<Matrix> pseudoSqrt(
                         const Matrix&,
                         SalvagingAlgorithm::Type = SalvagingAlgorithm::None);
 
@@ -78,11 +78,74 @@ namespace QuantLib {
 
         \relates Matrix
     */
-    const Disposable<Matrix> rankReducedSqrt(const Matrix&,
+    Disposable<Matrix> rankReducedSqrt(const Matrix&,
                                              Size maxRank,
                                              Real componentRetainedPercentage,
                                              SalvagingAlgorithm::Type);
 
+
+    //! pseudo square roots of a sequence of slowly changing matrices
+    /*! This class returns the same results as the pseudoSqrt and
+        rankReducedSqrt functions (to within round-off errors) but it
+        is meant to be used when they are needed repeatedly, e.g.,
+        inside calibration loops.
+
+        The spectral decomposition is obtained by Householder
+        tridiagonalization followed by TqrEigenDecomposition instead
+        of Jacobi iterations.  Furthermore, when a matrix has the same
+        size as the previous one, the previous eigenvectors are used
+        as a starting point: if they nearly diagonalize the new
+        matrix, a few Jacobi sweeps are enough to complete the
+        decomposition.  This also speeds up the Higham algorithm,
+        whose iterations work on converging matrices.  Workspace
+        buffers are kept between calls.
+
+        \warning the eigenvectors corresponding to degenerate
+                 eigenvalues can be a different basis of the same
+                 eigenspace than the one returned by the functions.
+        \warning instances are not thread-safe.
+
+        \test the results are checked against the ones of the
+              pseudoSqrt and rankReducedSqrt functions.
+    */
+    class PseudoSqrtCalculator {
+      public:
+        explicit PseudoSqrtCalculator(
+                  SalvagingAlgorithm::Type sa = SalvagingAlgorithm::Spectral);
+        //! same as the pseudoSqrt function
+        Disposable<Matrix> pseudoSqrt(const Matrix&);
+        //! same as the rankReducedSqrt function
+        /*! \pre the salvaging algorithm must be None, Spectral or
+                 Higham.
+        */
+        Disposable<Matrix> rankReducedSqrt(const Matrix&,
+                                           Size maxRank,
+                                           Real componentRetainedPercentage);
+        //! \name Inspectors
+        //@{
+        //! eigenvalues of the last decomposed matrix, in decreasing order
+        const Array& eigenvalues() const { return eigenvalues_; }
+        //! the corresponding eigenvectors, by column
+        const Matrix& eigenvectors() const { return eigenvectors_; }
+        //! number of decompositions started from the previous one
+        Size warmStarts() const { return warmStarts_; }
+        //@}
+        //! forgets the previous decomposition
+        void reset();
+      private:
+        void decompose(const Matrix&);
+        void tridiagonalDecomposition(const Matrix&);
+        bool jacobiRefinement(const Matrix&);
+        void sortEigenvalues();
+        Disposable<Matrix> projectToPositiveSemidefinite(const Matrix&);
+        SalvagingAlgorithm::Type sa_;
+        Array eigenvalues_;
+        Matrix eigenvectors_;
+        Size consecutiveWarmStarts_, warmStarts_;
+        // workspace
+        Matrix rotated_, product_, rotations_;
+    };
+
 }
 
 
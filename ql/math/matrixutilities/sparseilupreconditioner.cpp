@@ -47,10 +47,11 @@ namespace QuantLib {
         compressed_matrix<Integer> levs(n,n);
         Integer lfilp = lfil + 1;
 
+        const CsrMatrix a(A);
         for (Integer ii=0; ii<n; ++ii) {
-            Array w(n);
-            for(Integer k=0; k<n; ++k) {
-                w[k] = A(ii,k);
+            Array w(n, 0.0);
+            for (Size k=a.rowPointers()[ii]; k<a.rowPointers()[ii+1]; ++k) {
+                w[a.columnIndices()[k]] = a.values()[k];
             }
 
             std::vector<Integer> levii(n, 0);
@@ -148,6 +149,9 @@ namespace QuantLib {
         uBands_.resize(uBandSet.size());
         std::copy(lBandSet.begin(), lBandSet.end(), lBands_.begin());
         std::copy(uBandSet.begin(), uBandSet.end(), uBands_.begin());
+
+        CsrMatrix(L_).swap(lCsr_);
+        CsrMatrix(U_).swap(uCsr_);
     }
 
     const SparseMatrix& SparseILUPreconditioner::L() const {
@@ -164,30 +168,35 @@ namespace QuantLib {
 
     Disposable<Array> SparseILUPreconditioner::forwardSolve(
                                                        const Array& b) const {
-        Integer n = b.size();
+        // the elements of each row are accessed in the same order as
+        // with the band structure, but without searching for them
+        const std::vector<Size>& rowStart = lCsr_.rowPointers();
+        const std::vector<Size>& column = lCsr_.columnIndices();
+        const std::vector<Real>& value = lCsr_.values();
+        Size n = b.size();
         Array y(n, 0.0);
-        y[0]=b[0]/L_(0,0);
-        for (Integer i=1; i<=n-1; ++i) {
-            y[i] = b[i]/L_(i,i);
-            for (Integer j=lBands_.size()-1;
-                 j>=0 && i-Integer(lBands_[j]) <= i-1; --j) {
-                const Integer k = i-Integer(lBands_[j]);
-                if (k >= 0)
-                    y[i]-=L_(i,k)*y[k]/L_(i,i);
-            }
+        for (Size i=0; i<n; ++i) {
+            const Real lii = lCsr_(i,i);
+            y[i] = b[i]/lii;
+            for (Size k=rowStart[i]; k<rowStart[i+1] && column[k]<i; ++k)
+                y[i] -= value[k]*y[column[k]]/lii;
         }
         return y;
     }
 
     Disposable<Array> SparseILUPreconditioner::backwardSolve(
                                                        const Array& y) const {
+        const std::vector<Size>& rowStart = uCsr_.rowPointers();
+        const std::vector<Size>& column = uCsr_.columnIndices();
+        const std::vector<Real>& value = uCsr_.values();
         Size n = y.size();
         Array x(n, 0.0);
-        x[n-1] = y[n-1]/U_(n-1,n-1);
-        for (Integer i=n-2; i>=0; --i) {
-            x[i] = y[i]/U_(i,i);
-            for (Size j=0; j<uBands_.size() && i+uBands_[j] <= n-1; ++j) {
-                x[i] -= U_(i,i+uBands_[j])*x[i+uBands_[j]]/U_(i,i);
+        for (Size i=n; i-- > 0; ) {
+            const Real uii = uCsr_(i,i);
+            x[i] = y[i]/uii;
+            for (Size k=rowStart[i]; k<rowStart[i+1]; ++k) {
+                if (column[k] > i)
+                    x[i] -= value[k]*x[column[k]]/uii;
             }
         }
         return x;
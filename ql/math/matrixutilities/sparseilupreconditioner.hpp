@@ -29,7 +29,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #if !defined(QL_NO_UBLAS_SUPPORT)
 
 #include <ql/math/array.hpp>
-#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 
 namespace QuantLib {
 
@@ -49,6 +49,8 @@ namespace QuantLib {
       private:
         SparseMatrix L_, U_;
         std::vector<Size> lBands_, uBands_;
+        // copies used by the triangular solves
+        CsrMatrix lCsr_, uCsr_;
 
         Disposable<Array> forwardSolve(const Array& b) const;
         Disposable<Array> backwardSolve(const Array& y) const;
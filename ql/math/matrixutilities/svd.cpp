@@ -34,6 +34,7 @@
 
 
 #include <ql/math/matrixutilities/svd.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 
 namespace QuantLib {
 
@@ -91,6 +92,12 @@ namespace QuantLib {
 
         // we're sure that m_ >= n_
 
+        #if defined(QL_USE_LAPACK)
+        if (n_ >= detail::lapackMinimumSize
+            && detail::lapackSVD(A, U_, s_, V_))
+            return;
+        #endif
+
         s_ = Array(n_);
         U_ = Matrix(m_,n_, 0.0);
         V_ = Matrix(n_,n_);
@@ -48,6 +48,9 @@ namespace QuantLib {
     /*! Refer to Golub and Van Loan: Matrix computation,
         The Johns Hopkins University Press
 
+        If QL_USE_LAPACK is defined, the decomposition is performed
+        by the LAPACK dgesdd routine instead.
+
         \test the correctness of the returned values is tested by
               checking their properties.
     */
@@ -19,6 +19,7 @@
 */
 
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/math/matrixutilities/lapack.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -29,6 +30,43 @@ namespace QuantLib {
         QL_REQUIRE(s.rows() > 0 && s.columns() > 0, "null matrix given");
         QL_REQUIRE(s.rows()==s.columns(), "input matrix must be square");
 
+        #if defined(QL_USE_LAPACK)
+        if (s.rows() < detail::lapackMinimumSize
+            || !detail::lapackSymmetricEigen(s, diagonal_, eigenVectors_))
+            jacobiDecomposition_(s);
+        #else
+        jacobiDecomposition_(s);
+        #endif
+
+        // sort (eigenvalues, eigenvectors)
+        Size size = s.rows();
+        std::vector<std::pair<Real, std::vector<Real> > > temp(size);
+        std::vector<Real> eigenVector(size);
+        Size row, col;
+        for (col=0; col<size; col++) {
+            std::copy(eigenVectors_.column_begin(col),
+                      eigenVectors_.column_end(col), eigenVector.begin());
+            temp[col] = std::make_pair(diagonal_[col], eigenVector);
+        }
+        std::sort(temp.begin(), temp.end(),
+            std::greater<std::pair<Real, std::vector<Real> > >());
+        Real maxEv = temp[0].first;
+        for (col=0; col<size; col++) {
+            // check for round-off errors
+            diagonal_[col] =
+                (std::fabs(temp[col].first/maxEv)<1e-16 ? 0.0 :
+                                                          temp[col].first);
+            Real sign = 1.0;
+            if (temp[col].second[0]<0.0)
+                sign = -1.0;
+            for (row=0; row<size; row++) {
+                eigenVectors_[row][col] = sign * temp[col].second[row];
+            }
+        }
+    }
+
+    void SymmetricSchurDecomposition::jacobiDecomposition_(const Matrix& s) {
+
         Size size = s.rows();
         for (Size q=0; q<size; q++) {
             diagonal_[q] = s[q][q];
@@ -110,32 +148,6 @@ namespace QuantLib {
 
         QL_ENSURE(ite<=maxIterations,
                   "Too many iterations (" << maxIterations << ") reached");
-
-
-        // sort (eigenvalues, eigenvectors)
-        std::vector<std::pair<Real, std::vector<Real> > > temp(size);
-        std::vector<Real> eigenVector(size);
-        Size row, col;
-        for (col=0; col<size; col++) {
-            std::copy(eigenVectors_.column_begin(col),
-                      eigenVectors_.column_end(col), eigenVector.begin());
-            temp[col] = std::make_pair(diagonal_[col], eigenVector);
-        }
-        std::sort(temp.begin(), temp.end(),
-            std::greater<std::pair<Real, std::vector<Real> > >());
-        Real maxEv = temp[0].first;
-        for (col=0; col<size; col++) {
-            // check for round-off errors
-            diagonal_[col] =
-                (std::fabs(temp[col].first/maxEv)<1e-16 ? 0.0 :
-                                                          temp[col].first);
-            Real sign = 1.0;
-            if (temp[col].second[0]<0.0)
-                sign = -1.0;
-            for (row=0; row<size; row++) {
-                eigenVectors_[row][col] = sign * temp[col].second[row];
-            }
-        }
     }
 
 }
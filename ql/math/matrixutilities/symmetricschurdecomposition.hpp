@@ -44,6 +44,10 @@ namespace QuantLib {
         second edition, by Golub and Van Loan,
         The Johns Hopkins University Press
 
+        If QL_USE_LAPACK is defined, the decomposition is performed
+        by the LAPACK dsyevd routine instead, and the Jacobi algorithm
+        is only used if the latter fails.
+
         \test the correctness of the returned values is tested by
               checking their properties.
     */
@@ -56,6 +60,7 @@ namespace QuantLib {
       private:
         Array diagonal_;
         Matrix eigenVectors_;
+        void jacobiDecomposition_(const Matrix& s);
         void jacobiRotate_(Matrix & m, Real rot, Real dil,
                            Size j1, Size k1, Size j2, Size k2) const;
     };
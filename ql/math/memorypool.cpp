@@ -0,0 +1,212 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/memorypool.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <algorithm>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace {
+
+        // Each buffer is preceded by a header storing its size and
+        // the allocator that provided it, if any; the header also
+        // links the buffer into a free list while pooled.
+        struct Block {
+            Size size;
+            Block* next;
+            LargeBufferAllocator* allocator;
+        };
+
+        // The space taken by the header is rounded up to a multiple
+        // of sizeof(Real), so that the data that follows it is
+        // correctly aligned; this is not the case for sizeof(Block)
+        // on 32-bit targets, where it takes 12 bytes.
+        const Size headerSize =
+            ((sizeof(Block) + sizeof(Real) - 1) / sizeof(Real))
+            * sizeof(Real);
+        BOOST_STATIC_ASSERT(headerSize >= sizeof(Block));
+        BOOST_STATIC_ASSERT(headerSize % boost::alignment_of<Real>::value
+                            == 0);
+
+        inline Size bytes(Size n) {
+            return headerSize + n*sizeof(Real);
+        }
+
+        void release(Block* b) {
+            if (b->allocator)
+                b->allocator->deallocate(b, bytes(b->size));
+            else
+                ::operator delete(b);
+        }
+
+        inline Real* data(Block* b) {
+            return reinterpret_cast<Real*>(
+                                     reinterpret_cast<char*>(b) + headerSize);
+        }
+
+        inline Block* header(Real* p) {
+            return reinterpret_cast<Block*>(
+                                     reinterpret_cast<char*>(p) - headerSize);
+        }
+
+        class FreeLists {
+          public:
+            ~FreeLists() {
+                for (Size i=0; i<lists_.size(); ++i) {
+                    Block* b = lists_[i].second;
+                    while (b) {
+                        Block* next = b->next;
+                        release(b);
+                        b = next;
+                    }
+                }
+            }
+            Block* pop(Size size) {
+                for (Size i=0; i<lists_.size(); ++i) {
+                    if (lists_[i].first == size) {
+                        Block* b = lists_[i].second;
+                        if (b)
+                            lists_[i].second = b->next;
+                        return b;
+                    }
+                }
+                return 0;
+            }
+            void push(Block* b) {
+                for (Size i=0; i<lists_.size(); ++i) {
+                    if (lists_[i].first == b->size) {
+                        b->next = lists_[i].second;
+                        lists_[i].second = b;
+                        return;
+                    }
+                }
+                b->next = 0;
+                lists_.push_back(std::make_pair(b->size, b));
+            }
+          private:
+            // few distinct sizes are expected; a linear search is
+            // faster than a map in this case
+            std::vector<std::pair<Size, Block*> > lists_;
+        };
+
+        QL_THREAD_LOCAL FreeLists* pool_ = 0;
+        QL_THREAD_LOCAL Size depth_ = 0;
+        QL_THREAD_LOCAL Size heapAllocations_ = 0;
+        QL_THREAD_LOCAL Size pooledAllocations_ = 0;
+
+        LargeBufferAllocator* largeAllocator_ = 0;
+        Size largeSize_ = 0;
+
+        // the allocators installed so far, which must outlive the
+        // buffers they provided
+        std::vector<boost::shared_ptr<LargeBufferAllocator> >&
+        installedAllocators() {
+            static std::vector<boost::shared_ptr<LargeBufferAllocator> >
+                allocators;
+            return allocators;
+        }
+
+    }
+
+    MemoryPool::Scope::Scope() {
+        if (depth_ == 0)
+            pool_ = new FreeLists;
+        ++depth_;
+    }
+
+    MemoryPool::Scope::~Scope() {
+        if (--depth_ == 0) {
+            delete pool_;
+            pool_ = 0;
+        }
+    }
+
+    Real* MemoryPool::allocate(Size n) {
+        if (pool_) {
+            Block* b = pool_->pop(n);
+            if (b) {
+                ++pooledAllocations_;
+                return data(b);
+            }
+        }
+        Block* b;
+        if (largeAllocator_ && n >= largeSize_) {
+            b = static_cast<Block*>(largeAllocator_->allocate(bytes(n)));
+            b->allocator = largeAllocator_;
+        } else {
+            b = static_cast<Block*>(::operator new(bytes(n)));
+            b->allocator = 0;
+        }
+        b->size = n;
+        ++heapAllocations_;
+        return data(b);
+    }
+
+    void MemoryPool::deallocate(Real* p) {
+        Block* b = header(p);
+        if (pool_)
+            pool_->push(b);
+        else
+            release(b);
+    }
+
+    bool MemoryPool::active() {
+        return pool_ != 0;
+    }
+
+    Size MemoryPool::heapAllocations() {
+        return heapAllocations_;
+    }
+
+    Size MemoryPool::pooledAllocations() {
+        return pooledAllocations_;
+    }
+
+    void MemoryPool::resetCounters() {
+        heapAllocations_ = pooledAllocations_ = 0;
+    }
+
+    void MemoryPool::setLargeBufferAllocator(
+                     const boost::shared_ptr<LargeBufferAllocator>& allocator,
+                     Size minimumSize) {
+        if (allocator) {
+            std::vector<boost::shared_ptr<LargeBufferAllocator> >&
+                allocators = installedAllocators();
+            if (std::find(allocators.begin(), allocators.end(),
+                          allocator) == allocators.end())
+                allocators.push_back(allocator);
+        }
+        largeAllocator_ = allocator.get();
+        largeSize_ = minimumSize;
+    }
+
+    boost::shared_ptr<LargeBufferAllocator>
+    MemoryPool::largeBufferAllocator() {
+        std::vector<boost::shared_ptr<LargeBufferAllocator> >& allocators =
+            installedAllocators();
+        for (Size i=0; i<allocators.size(); ++i)
+            if (allocators[i].get() == largeAllocator_)
+                return allocators[i];
+        return boost::shared_ptr<LargeBufferAllocator>();
+    }
+
+}
@@ -0,0 +1,173 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file memorypool.hpp
+    \brief thread-local pool for array and matrix storage
+*/
+
+#ifndef quantlib_memory_pool_hpp
+#define quantlib_memory_pool_hpp
+
+#include <ql/types.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/shared_array.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    //! placement of large buffers
+    /*! Buffers at least as large as the threshold passed to
+        MemoryPool::setLargeBufferAllocator are obtained from an
+        instance of this class instead of the heap, so that their
+        memory pages can be chosen and placed, e.g., on huge pages or
+        across the nodes of a NUMA machine.
+    */
+    class LargeBufferAllocator {
+      public:
+        virtual ~LargeBufferAllocator() {}
+        //! returns storage for the given number of bytes
+        /*! The storage must be aligned at least as required by a Real;
+            an exception must be thrown if no storage is available.
+        */
+        virtual void* allocate(Size bytes) = 0;
+        //! releases storage obtained from allocate with the same size
+        virtual void deallocate(void* p, Size bytes) = 0;
+    };
+
+    //! thread-local pool for the storage of arrays and matrices
+    /*! Array and Matrix instances obtain their storage through this
+        class.  By default, each request is forwarded to the heap.
+
+        While at least an instance of MemoryPool::Scope is alive on a
+        given thread, the buffers released on that thread are kept in
+        per-size free lists instead of being returned to the heap, and
+        later requests of the same size made on that thread are served
+        from them.  Tight loops creating temporaries of a few fixed
+        sizes (e.g., the steps of a finite-difference scheme or the
+        iterations of an optimizer) thus stop allocating after their
+        first iteration.  The pooled buffers are returned to the heap
+        when the outermost scope on the thread is destroyed.
+
+        Buffers can be released on a thread other than the one that
+        allocated them; they are then pooled or freed according to
+        the state of the releasing thread.
+
+        The number of requests served by the heap and by the pool on
+        the current thread are available for inspection, e.g., to
+        verify that a given loop doesn't allocate.
+
+        Finally, a LargeBufferAllocator can be installed to serve the
+        requests above a given size; this affects the large arrays
+        and matrices used, e.g., by finite-difference meshes and
+        batched Monte Carlo paths, as well as the band storage of the
+        finite-difference operators.  Large buffers are pooled as the
+        others while a scope is active.
+    */
+    class MemoryPool {
+      public:
+        //! activates the pool on the current thread during its lifetime
+        class Scope : private boost::noncopyable {
+          public:
+            Scope();
+            ~Scope();
+        };
+
+        //! returns storage for n > 0 reals
+        static Real* allocate(Size n);
+        //! releases storage obtained from allocate
+        static void deallocate(Real* p);
+
+        //! whether a scope is active on the current thread
+        static bool active();
+
+        //! \name Counters for the current thread
+        //@{
+        //! requests served by the heap since the last reset
+        static Size heapAllocations();
+        //! requests served by the pool since the last reset
+        static Size pooledAllocations();
+        static void resetCounters();
+        //@}
+
+        //! \name Large buffers
+        //@{
+        /*! Requests for at least minimumSize reals are served by the
+            given allocator from now on; a null allocator restores
+            the default.  The buffers already allocated are released
+            through the allocator that provided them, which is kept
+            alive until the end of the program.
+
+            \warning This setting is global; it is not synchronized
+                     and must not be changed while other threads
+                     allocate arrays or matrices.
+        */
+        static void setLargeBufferAllocator(
+                     const boost::shared_ptr<LargeBufferAllocator>& allocator,
+                     Size minimumSize);
+        static boost::shared_ptr<LargeBufferAllocator>
+                                                    largeBufferAllocator();
+        //@}
+    };
+
+    namespace detail {
+
+        // storage used by Array and Matrix
+        class PooledBuffer : private boost::noncopyable {
+          public:
+            explicit PooledBuffer(Size n = 0)
+            : data_(n ? MemoryPool::allocate(n) : (Real*)(0)) {}
+            ~PooledBuffer() {
+                if (data_)
+                    MemoryPool::deallocate(data_);
+            }
+            Real* get() const { return data_; }
+            Real& operator[](Size i) const { return data_[i]; }
+            void reset(Size n) {
+                PooledBuffer temp(n);
+                swap(temp);
+            }
+            void swap(PooledBuffer& from) {
+                std::swap(data_, from.data_);
+            }
+          private:
+            Real* data_;
+        };
+
+        struct PooledArrayDeleter {
+            template <class T>
+            void operator()(T* p) const {
+                if (p)
+                    MemoryPool::deallocate(reinterpret_cast<Real*>(p));
+            }
+        };
+
+        // pooled storage for n > 0 uninitialized instances of a
+        // built-in type, such as the bands of the FDM operators
+        template <class T>
+        boost::shared_array<T> pooledArray(Size n) {
+            Size reals = (n*sizeof(T) + sizeof(Real) - 1)/sizeof(Real);
+            return boost::shared_array<T>(
+                reinterpret_cast<T*>(MemoryPool::allocate(reals)),
+                PooledArrayDeleter());
+        }
+
+    }
+
+}
+
+#endif
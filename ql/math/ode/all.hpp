@@ -2,4 +2,5 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/math/ode/adaptiverungekutta.hpp>
+#include <ql/math/ode/batchadaptiverungekutta.hpp>
 
@@ -0,0 +1,319 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchadaptiverungekutta.hpp
+    \brief Runge-Kutta ODE integration of a batch of systems
+
+    Runge Kutta method with adaptive stepsize as described in
+    Numerical Recipes in C, Chapter 16.2, applied in lockstep to a
+    number of independent systems of the same dimension
+*/
+
+#ifndef quantlib_batch_adaptive_runge_kutta_hpp
+#define quantlib_batch_adaptive_runge_kutta_hpp
+
+#include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <boost/function.hpp>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! adaptive Runge-Kutta integration of a batch of ODE systems
+    /*! The batch is made of \f$ K \f$ independent systems (lanes) of
+        dimension \f$ n \f$, integrated over the same interval.  The
+        states are stored in struct-of-arrays layout, i.e., the
+        \f$ i \f$-th component of the \f$ k \f$-th system is found at
+        position \f$ iK+k \f$, so that the right-hand side can be
+        evaluated for all lanes in a single call and the loops over
+        the lanes can be vectorized.
+
+        With per-lane step control, each lane has its own abscissa
+        and step size and follows the same sequence of steps as
+        AdaptiveRungeKutta would; lanes that reached the end of the
+        interval are kept frozen until all of them are done.  With
+        shared step control, all lanes advance with the step size
+        required by the least accurate one.
+
+        The work buffers are allocated at construction, so that no
+        allocation is performed during the integration.
+    */
+    template <class T = Real>
+    class BatchAdaptiveRungeKutta {
+      public:
+        /*! The right-hand side receives the abscissae of the \f$ K \f$
+            lanes and their states, and must write the derivatives
+            into the last argument using the same layout. */
+        typedef boost::function<void (const Real*, const T*, T*)> OdeFct;
+        enum StepControl { Shared, PerLane };
+
+        /*! The class is constructed with the following inputs:
+            - dimension  dimension of each system
+            - lanes      number of systems
+            - control    shared or per-lane step control
+            - eps        prescribed error for the solution
+            - h1         start step size
+            - hmin       smallest step size allowed
+        */
+        BatchAdaptiveRungeKutta(Size dimension,
+                                Size lanes,
+                                StepControl control = PerLane,
+                                const Real eps=1.0e-6,
+                                const Real h1=1.0e-4,
+                                const Real hmin=0.0)
+        : n_(dimension), lanes_(lanes),
+          groups_(control == PerLane ? lanes : 1),
+          eps_(eps), h1_(h1), hmin_(hmin),
+          dydx_(n_*lanes_), ak2_(n_*lanes_), ak3_(n_*lanes_),
+          ak4_(n_*lanes_), ak5_(n_*lanes_), ak6_(n_*lanes_),
+          ytemp_(n_*lanes_), yout_(n_*lanes_), yerr_(n_*lanes_),
+          yScale_(n_*lanes_), xs_(lanes_), hs_(lanes_), active_(lanes_),
+          x_(groups_), h_(groups_), errmax_(groups_), steps_(groups_),
+          status_(groups_),
+          a2(0.2), a3(0.3), a4(0.6), a5(1.0), a6(0.875),
+          b21(0.2), b31(3.0/40.0), b32(9.0/40.0), b41(0.3), b42(-0.9), b43(1.2),
+          b51(-11.0/54.0), b52(2.5), b53(-70.0/27.0), b54(35.0/27.0),
+          b61(1631.0/55296.0), b62(175.0/512.0), b63(575.0/13824.0),
+          b64(44275.0/110592.0), b65(253.0/4096.0),
+          c1(37.0/378.0), c3(250.0/621.0), c4(125.0/594.0), c6(512.0/1771.0),
+          dc1(c1-2825.0/27648.0), dc3(c3-18575.0/48384.0),
+          dc4(c4-13525.0/55296.0), dc5(-277.0/14336.0), dc6(c6-0.25),
+          ADAPTIVERK_MAXSTP(10000), ADAPTIVERK_TINY(1.0E-30),
+          ADAPTIVERK_SAFETY(0.9), ADAPTIVERK_PGROW(-0.2),
+          ADAPTIVERK_PSHRINK(-0.25), ADAPTIVERK_ERRCON(1.89E-4) {
+            QL_REQUIRE(n_ > 0, "null dimension given");
+            QL_REQUIRE(lanes_ > 0, "null number of lanes given");
+        }
+
+        /*! Integrate the systems from \f$ x1 \f$ to \f$ x2 \f$; on
+            input, \f$ y \f$ contains the initial values, which are
+            replaced by the solutions at \f$ x2 \f$. */
+        void operator()(const OdeFct& ode,
+                        std::vector<T>& y,
+                        const Real x1,
+                        const Real x2);
+
+        Size dimension() const { return n_; }
+        Size lanes() const { return lanes_; }
+
+      private:
+        enum Status { NewStep, Retry, Done };
+
+        Size group(Size lane) const { return groups_ == 1 ? 0 : lane; }
+        void rkck(const std::vector<T>& y, const OdeFct& derivs);
+        void evaluate(const OdeFct& derivs, Real a,
+                      const std::vector<T>& y, std::vector<T>& dydx);
+
+        const Size n_, lanes_, groups_;
+        const Real eps_, h1_, hmin_;
+        // work buffers of the lanes, in struct-of-arrays layout
+        std::vector<T> dydx_, ak2_, ak3_, ak4_, ak5_, ak6_;
+        std::vector<T> ytemp_, yout_, yerr_;
+        std::vector<Real> yScale_;
+        std::vector<Real> xs_, hs_;
+        std::vector<bool> active_;
+        // step control, per lane or shared
+        std::vector<Real> x_, h_, errmax_;
+        std::vector<Size> steps_;
+        std::vector<Status> status_;
+        const Real a2,a3,a4,a5,a6,
+                   b21,b31,b32,b41,b42,b43,b51,b52,b53,b54,b61,b62,b63,b64,b65,
+                   c1,c3,c4,c6,dc1,dc3,dc4,dc5,dc6;
+        const double ADAPTIVERK_MAXSTP, ADAPTIVERK_TINY, ADAPTIVERK_SAFETY,
+                   ADAPTIVERK_PGROW, ADAPTIVERK_PSHRINK, ADAPTIVERK_ERRCON;
+    };
+
+
+    template <class T>
+    void BatchAdaptiveRungeKutta<T>::operator()(const OdeFct& ode,
+                                                std::vector<T>& y,
+                                                const Real x1,
+                                                const Real x2) {
+        QL_REQUIRE(y.size() == n_*lanes_,
+                   "wrong size of the initial values: " << y.size()
+                   << " given, " << n_ << "x" << lanes_ << " required");
+
+        std::fill(x_.begin(), x_.end(), x1);
+        std::fill(h_.begin(), h_.end(), h1_* (x1<=x2 ? 1 : -1));
+        std::fill(steps_.begin(), steps_.end(), Size(0));
+        std::fill(status_.begin(), status_.end(), NewStep);
+        Size running = groups_;
+
+        while (running > 0) {
+            // derivatives at the start of the new steps; lanes
+            // retrying a step get the same values again
+            bool newSteps = false;
+            for (Size g=0; g<groups_; ++g)
+                newSteps = newSteps || (status_[g] == NewStep);
+            if (newSteps) {
+                for (Size k=0; k<lanes_; ++k)
+                    xs_[k] = x_[group(k)];
+                ode(&xs_[0], &y[0], &dydx_[0]);
+            }
+
+            for (Size k=0; k<lanes_; ++k) {
+                const Size g = group(k);
+                active_[k] = (status_[g] != Done);
+                hs_[k] = active_[k] ? h_[g] : 0.0;
+                if (status_[g] == NewStep) {
+                    for (Size i=0; i<n_; ++i) {
+                        const Size j = i*lanes_+k;
+                        yScale_[j] = std::abs(y[j])
+                            + std::abs(dydx_[j]*hs_[k]) + ADAPTIVERK_TINY;
+                    }
+                }
+            }
+            for (Size g=0; g<groups_; ++g) {
+                if (status_[g] == NewStep) {
+                    QL_REQUIRE(++steps_[g] <= ADAPTIVERK_MAXSTP,
+                               "Too many steps (" << ADAPTIVERK_MAXSTP
+                               << ") in BatchAdaptiveRungeKutta");
+                    if ((x_[g]+h_[g]-x2)*(x_[g]+h_[g]-x1) > 0.0)
+                        h_[g] = x2-x_[g];
+                }
+            }
+            for (Size k=0; k<lanes_; ++k)
+                hs_[k] = active_[k] ? h_[group(k)] : 0.0;
+
+            rkck(y, ode);
+
+            std::fill(errmax_.begin(), errmax_.end(), 0.0);
+            for (Size i=0; i<n_; ++i) {
+                for (Size k=0; k<lanes_; ++k) {
+                    const Size j = i*lanes_+k;
+                    Real& errmax = errmax_[group(k)];
+                    errmax = std::max(errmax,
+                                      std::abs(yerr_[j]/yScale_[j]));
+                }
+            }
+
+            for (Size g=0; g<groups_; ++g) {
+                if (status_[g] == Done)
+                    continue;
+                const Real errmax = errmax_[g]/eps_;
+                Real& h = h_[g];
+                if (errmax>1.0) {
+                    Real htemp1 =
+                        ADAPTIVERK_SAFETY*h*std::pow(errmax,ADAPTIVERK_PSHRINK);
+                    Real htemp2 = h / 10;
+                    Real max_positive = htemp1 > htemp2 ? htemp1 : htemp2;
+                    Real max_negative = htemp1 < htemp2 ? htemp1 : htemp2;
+                    h = ((h >= 0.0) ? max_positive : max_negative);
+                    if (x_[g]+h == x_[g])
+                        QL_FAIL("Stepsize underflow (" << h << " at x = "
+                                << x_[g] << ") in BatchAdaptiveRungeKutta");
+                    status_[g] = Retry;
+                } else {
+                    Real hnext;
+                    if (errmax>ADAPTIVERK_ERRCON)
+                        hnext =
+                            ADAPTIVERK_SAFETY*h*std::pow(errmax,ADAPTIVERK_PGROW);
+                    else
+                        hnext = 5.0*h;
+                    x_[g] += h;
+                    if ((x_[g]-x2)*(x2-x1) >= 0.0) {
+                        status_[g] = Done;
+                        --running;
+                    } else {
+                        if (std::fabs(hnext) <= hmin_)
+                            QL_FAIL("Step size (" << hnext << ") too small ("
+                                    << hmin_ << " min) in "
+                                    "BatchAdaptiveRungeKutta");
+                        status_[g] = NewStep;
+                    }
+                    h = hnext;
+                    // the accepted lanes are marked for the update below
+                    errmax_[g] = -1.0;
+                }
+            }
+
+            for (Size i=0; i<n_; ++i) {
+                for (Size k=0; k<lanes_; ++k) {
+                    const Size j = i*lanes_+k;
+                    if (errmax_[group(k)] < 0.0)
+                        y[j] = yout_[j];
+                }
+            }
+        }
+    }
+
+    template <class T>
+    void BatchAdaptiveRungeKutta<T>::evaluate(const OdeFct& derivs,
+                                              Real a,
+                                              const std::vector<T>& y,
+                                              std::vector<T>& dydx) {
+        for (Size k=0; k<lanes_; ++k)
+            xs_[k] = x_[group(k)]+a*hs_[k];
+        derivs(&xs_[0], &y[0], &dydx[0]);
+    }
+
+    template <class T>
+    void BatchAdaptiveRungeKutta<T>::rkck(const std::vector<T>& y,
+                                          const OdeFct& derivs) {
+        const std::vector<T>& dydx = dydx_;
+        std::vector<T>& ytemp = ytemp_;
+        std::vector<T> &ak2 = ak2_, &ak3 = ak3_, &ak4 = ak4_,
+                       &ak5 = ak5_, &ak6 = ak6_;
+
+        // first step
+        for (Size i=0, j=0; i<n_; ++i)
+            for (Size k=0; k<lanes_; ++k, ++j)
+                ytemp[j]=y[j]+b21*hs_[k]*dydx[j];
+
+        // second step
+        evaluate(derivs, a2, ytemp, ak2);
+        for (Size i=0, j=0; i<n_; ++i)
+            for (Size k=0; k<lanes_; ++k, ++j)
+                ytemp[j]=y[j]+hs_[k]*(b31*dydx[j]+b32*ak2[j]);
+
+        // third step
+        evaluate(derivs, a3, ytemp, ak3);
+        for (Size i=0, j=0; i<n_; ++i)
+            for (Size k=0; k<lanes_; ++k, ++j)
+                ytemp[j]=y[j]+hs_[k]*(b41*dydx[j]+b42*ak2[j]+b43*ak3[j]);
+
+        // fourth step
+        evaluate(derivs, a4, ytemp, ak4);
+        for (Size i=0, j=0; i<n_; ++i)
+            for (Size k=0; k<lanes_; ++k, ++j)
+                ytemp[j]=y[j]+hs_[k]*(b51*dydx[j]+b52*ak2[j]+b53*ak3[j]
+                                      +b54*ak4[j]);
+
+        // fifth step
+        evaluate(derivs, a5, ytemp, ak5);
+        for (Size i=0, j=0; i<n_; ++i)
+            for (Size k=0; k<lanes_; ++k, ++j)
+                ytemp[j]=y[j]+hs_[k]*(b61*dydx[j]+b62*ak2[j]+b63*ak3[j]
+                                      +b64*ak4[j]+b65*ak5[j]);
+
+        // sixth step
+        evaluate(derivs, a6, ytemp, ak6);
+        for (Size i=0, j=0; i<n_; ++i) {
+            for (Size k=0; k<lanes_; ++k, ++j) {
+                yout_[j]=y[j]+hs_[k]*(c1*dydx[j]+c3*ak3[j]+c4*ak4[j]
+                                      +c6*ak6[j]);
+                yerr_[j]=hs_[k]*(dc1*dydx[j]+dc3*ak3[j]+dc4*ak4[j]
+                                 +dc5*ak5[j]+dc6*ak6[j]);
+            }
+        }
+    }
+
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include <ql/math/array.hpp>
 #include <ql/math/matrix.hpp>
 #include <ql/math/functional.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -45,6 +46,21 @@ namespace QuantLib {
         //! method to overload to compute the cost function values in x
         virtual Disposable<Array> values(const Array& x) const =0;
 
+        //! method to overload to compute the cost function value at
+        //  each of the given points
+        /*! The default implementation calls value() for each point;
+            cost functions that can evaluate several points at once
+            (e.g., by vectorizing the computation) can overload it.
+            It is used by population-based optimizers.
+        */
+        virtual Disposable<Array> populationValues(
+                                      const std::vector<Array>& x) const {
+            Array result(x.size());
+            for (Size i=0; i<x.size(); ++i)
+                result[i] = value(x[i]);
+            return result;
+        }
+
         //! method to overload to compute grad_f, the first derivative of
         //  the cost function with respect to x
         virtual void gradient(Array& grad, const Array& x) const {
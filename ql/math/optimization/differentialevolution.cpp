@@ -259,13 +259,16 @@ namespace QuantLib {
                                - lowerBound_[memIter]);
                 }
             }
-            // evaluate objective function as soon as possible to avoid unnecessary loops
-            try {
-                population[popIter].cost = costFunction.value(population[popIter].values);
-            } catch (Error&) {
-                population[popIter].cost = QL_MAX_REAL;
-            }
         }
+
+        // evaluate the objective function for the whole generation
+        std::vector<Array> members(population.size());
+        for (Size popIter = 0; popIter < population.size(); popIter++)
+            members[popIter] = population[popIter].values;
+        Array costs = configuration().evaluator.values(costFunction, members,
+                                                       QL_MAX_REAL);
+        for (Size popIter = 0; popIter < population.size(); popIter++)
+            population[popIter].cost = costs[popIter];
     }
 
     void DifferentialEvolution::getCrossoverMask(
@@ -344,15 +347,21 @@ namespace QuantLib {
 
         // use initial values provided by the user
         population.front().values = p.currentValue();
-        population.front().cost = p.costFunction().value(population.front().values);
         // rest of the initial population is random
         for (Size j = 1; j < population.size(); ++j) {
             for (Size i = 0; i < p.currentValue().size(); ++i) {
                 Real l = lowerBound_[i], u = upperBound_[i];
                 population[j].values[i] = l + (u-l)*rng_.nextReal();
             }
-            population[j].cost = p.costFunction().value(population[j].values);
         }
+
+        std::vector<Array> members(population.size());
+        for (Size j = 0; j < population.size(); ++j)
+            members[j] = population[j].values;
+        Array costs = configuration().evaluator.values(p.costFunction(),
+                                                       members);
+        for (Size j = 0; j < population.size(); ++j)
+            population[j].cost = costs[j];
     }
 
 }
@@ -27,6 +27,7 @@
 
 #include <ql/math/optimization/constraint.hpp>
 #include <ql/math/optimization/problem.hpp>
+#include <ql/math/optimization/populationevaluator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 
 namespace QuantLib {
@@ -87,6 +88,7 @@ namespace QuantLib {
             Real stepsizeWeight, crossoverProbability;
             unsigned long seed;
             bool applyBounds, crossoverIsAdaptive;
+            PopulationEvaluator evaluator;
 
             Configuration()
             : strategy(BestMemberWithJitter),
@@ -144,6 +146,15 @@ namespace QuantLib {
                 strategy = s;
                 return *this;
             }
+
+            /*! the members of each generation are evaluated together
+                after all of them have been generated, so that the
+                results don't depend on the chosen evaluator.
+            */
+            Configuration& withEvaluator(const PopulationEvaluator& e) {
+                evaluator = e;
+                return *this;
+            }
         };
 
 
@@ -21,6 +21,8 @@
 #include <ql/math/optimization/constraint.hpp>
 #include <ql/math/optimization/lmdif.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/math/memorypool.hpp>
+#include <algorithm>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -37,14 +39,68 @@ namespace QuantLib {
                                            Real gtol,
                                            bool useCostFunctionsJacobian)
         : info_(0), epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol),
-          useCostFunctionsJacobian_(useCostFunctionsJacobian) {}
+          useCostFunctionsJacobian_(useCostFunctionsJacobian),
+          patternRows_(0) {}
+
+    #if !defined(QL_NO_UBLAS_SUPPORT)
+    LevenbergMarquardt::LevenbergMarquardt(const SparseMatrix& pattern,
+                                           Real epsfcn,
+                                           Real xtol,
+                                           Real gtol)
+        : info_(0), epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol),
+          useCostFunctionsJacobian_(false),
+          patternRows_(pattern.size1()),
+          columnRows_(pattern.size2()) {
+
+        Size m = pattern.size1(), n = pattern.size2();
+        QL_REQUIRE(m > 0 && n > 0, "empty Jacobian pattern given");
+
+        // structure of the pattern by rows and by columns
+        std::vector<std::vector<Size> > rowColumns(m);
+        for (SparseMatrix::const_iterator1 i = pattern.begin1();
+             i != pattern.end1(); ++i) {
+            for (SparseMatrix::const_iterator2 j = i.begin();
+                 j != i.end(); ++j) {
+                rowColumns[j.index1()].push_back(j.index2());
+                columnRows_[j.index2()].push_back(j.index1());
+            }
+        }
+
+        // greedy grouping: each column goes to the first group
+        // containing no column with a non-zero in the same rows
+        std::vector<Size> group(n, Null<Size>());
+        for (Size j=0; j<n; ++j) {
+            std::vector<bool> forbidden(groups_.size(), false);
+            for (Size k=0; k<columnRows_[j].size(); ++k) {
+                const std::vector<Size>& cols =
+                    rowColumns[columnRows_[j][k]];
+                for (Size l=0; l<cols.size(); ++l)
+                    if (group[cols[l]] != Null<Size>())
+                        forbidden[group[cols[l]]] = true;
+            }
+            Size g = std::find(forbidden.begin(), forbidden.end(), false)
+                   - forbidden.begin();
+            if (g == groups_.size())
+                groups_.push_back(std::vector<Size>());
+            groups_[g].push_back(j);
+            group[j] = g;
+        }
+    }
+    #endif
 
     Integer LevenbergMarquardt::getInfo() const {
         return info_;
     }
 
+    Size LevenbergMarquardt::jacobianGroups() const {
+        return groups_.size();
+    }
+
     EndCriteria::Type LevenbergMarquardt::minimize(Problem& P,
                                                    const EndCriteria& endCriteria) {
+        // the cost function is evaluated many times on arrays of the
+        // same size; reuse their storage
+        MemoryPool::Scope pool;
         EndCriteria::Type ecType = EndCriteria::None;
         P.reset();
         Array x_ = P.currentValue();
@@ -56,6 +112,13 @@ namespace QuantLib {
             initJacobian_ = Matrix(m,n);
             P.costFunction().jacobian(initJacobian_, x_);
         }
+        if (!groups_.empty()) {
+            QL_REQUIRE(patternRows_ == Size(m) && columnRows_.size() == Size(n),
+                       "Jacobian pattern (" << patternRows_ << "x"
+                       << columnRows_.size() << ") doesn't match problem ("
+                       << m << " functions, " << n << " variables)");
+        }
+        lastX_ = Array();
         boost::scoped_array<Real> xx(new Real[n]);
         std::copy(x_.begin(), x_.end(), xx.get());
         boost::scoped_array<Real> fvec(new Real[m]);
@@ -93,7 +156,10 @@ namespace QuantLib {
             useCostFunctionsJacobian_
                 ? boost::bind(&LevenbergMarquardt::jacFcn, this, _1, _2, _3,
                               _4, _5)
-                : MINPACK::LmdifCostFunction(NULL);
+                : (!groups_.empty()
+                   ? boost::bind(&LevenbergMarquardt::groupedJacFcn, this,
+                                 _1, _2, _3, _4, _5)
+                   : MINPACK::LmdifCostFunction(NULL));
         MINPACK::lmdif(m, n, xx.get(), fvec.get(),
                        endCriteria.functionEpsilon(),
                        xtol_,
@@ -141,6 +207,10 @@ namespace QuantLib {
         } else {
             std::copy(initCostValues_.begin(), initCostValues_.end(), fvec);
         }
+        if (!groups_.empty()) {
+            lastX_ = xt;
+            lastValues_ = Array(fvec, fvec+initCostValues_.size());
+        }
     }
 
     void LevenbergMarquardt::jacFcn(int m, int n, Real* x, Real* fjac, int*) {
@@ -159,4 +229,43 @@ namespace QuantLib {
         }
     }
 
+    void LevenbergMarquardt::groupedJacFcn(int m, int n, Real* x,
+                                           Real* fjac, int* iflag) {
+        // same steps as the forward differences in MINPACK (fdjac2)
+        Real eps = std::sqrt(std::max(epsfcn_, QL_EPSILON));
+
+        // lmdif asks for the Jacobian at the last point it evaluated
+        Array fvec(m);
+        bool cached = lastX_.size() == Size(n);
+        for (Size j=0; cached && j<Size(n); ++j)
+            cached = (lastX_[j] == x[j]);
+        if (cached)
+            fvec = lastValues_;
+        else
+            fcn(m, n, x, fvec.begin(), iflag);
+
+        std::fill(fjac, fjac+m*n, 0.0);
+        Array xx(x, x+n), fp(m), h(n);
+        for (Size g=0; g<groups_.size(); ++g) {
+            const std::vector<Size>& columns = groups_[g];
+            for (Size k=0; k<columns.size(); ++k) {
+                Size j = columns[k];
+                h[j] = eps*std::fabs(x[j]);
+                if (h[j] == 0.0)
+                    h[j] = eps;
+                xx[j] = x[j] + h[j];
+            }
+            fcn(m, n, xx.begin(), fp.begin(), iflag);
+            for (Size k=0; k<columns.size(); ++k) {
+                Size j = columns[k];
+                const std::vector<Size>& rows = columnRows_[j];
+                for (Size r=0; r<rows.size(); ++r) {
+                    Size i = rows[r];
+                    fjac[i+j*m] = (fp[i]-fvec[i])/h[j];
+                }
+                xx[j] = x[j];
+            }
+        }
+    }
+
 }
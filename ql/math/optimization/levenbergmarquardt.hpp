@@ -26,6 +26,8 @@
 #define quantlib_optimization_levenberg_marquardt_hpp
 
 #include <ql/math/optimization/problem.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -44,6 +46,15 @@ namespace QuantLib {
         evaluations) compared to the forward
         difference implemented here (order 1).
 
+        When the Jacobian is sparse (e.g., banded or block-structured,
+        as in curve fits where each quote only depends on a few
+        nodes) its pattern can be passed instead.  The columns of the
+        Jacobian are then partitioned into groups without structurally
+        non-zero entries in common, and each group is estimated by a
+        single forward difference; this takes as many cost-function
+        evaluations per iteration as there are groups, instead of one
+        for each variable.
+
         \ingroup optimizers
     */
     class LevenbergMarquardt : public OptimizationMethod {
@@ -52,11 +63,25 @@ namespace QuantLib {
                            Real xtol = 1.0e-8,
                            Real gtol = 1.0e-8,
                            bool useCostFunctionsJacobian = false);
+        #if !defined(QL_NO_UBLAS_SUPPORT)
+        /*! \param jacobianPattern  matrix whose stored entries mark
+                                    the structurally non-zero elements
+                                    of the Jacobian; its values are
+                                    not used.
+        */
+        LevenbergMarquardt(const SparseMatrix& jacobianPattern,
+                           Real epsfcn = 1.0e-8,
+                           Real xtol = 1.0e-8,
+                           Real gtol = 1.0e-8);
+        #endif
         virtual EndCriteria::Type minimize(Problem& P,
                                            const EndCriteria& endCriteria //= EndCriteria()
                                            );
                                            //      = EndCriteria(400, 1.0e-8, 1.0e-8)
         virtual Integer getInfo() const;
+        //! number of groups in which the Jacobian columns are estimated
+        /*! This is zero if no Jacobian pattern was given. */
+        Size jacobianGroups() const;
         void fcn(int m,
                  int n,
                  Real* x,
@@ -67,6 +92,11 @@ namespace QuantLib {
                  Real* x,
                  Real* fjac,
                  int* iflag);
+        void groupedJacFcn(int m,
+                           int n,
+                           Real* x,
+                           Real* fjac,
+                           int* iflag);
 
       private:
         Problem* currentProblem_;
@@ -75,6 +105,11 @@ namespace QuantLib {
         mutable Integer info_;
         const Real epsfcn_, xtol_, gtol_;
         bool useCostFunctionsJacobian_;
+        // Jacobian pattern and column groups
+        Size patternRows_;
+        std::vector<std::vector<Size> > columnRows_, groups_;
+        // last point evaluated by fcn
+        Array lastX_, lastValues_;
     };
 
 }
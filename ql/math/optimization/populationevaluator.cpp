@@ -0,0 +1,115 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/optimization/populationevaluator.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <string>
+
+namespace QuantLib {
+
+    namespace {
+
+        Real pointValue(const CostFunction& costFunction, const Array& x,
+                        Real failureValue) {
+            if (failureValue == Null<Real>())
+                return costFunction.value(x);
+            try {
+                return costFunction.value(x);
+            } catch (Error&) {
+                return failureValue;
+            }
+        }
+
+    }
+
+    Disposable<Array> PopulationEvaluator::values(
+                                        const CostFunction& costFunction,
+                                        const std::vector<Array>& points,
+                                        Real failureValue) const {
+        Size n = points.size();
+        Array result(n);
+
+        switch (type_) {
+          case Serial:
+            for (Size i=0; i<n; ++i)
+                result[i] = pointValue(costFunction, points[i], failureValue);
+            break;
+          case Parallel: {
+              std::vector<std::string> errors(n);
+              // not vector<bool>, whose elements can't be written
+              // concurrently
+              std::vector<int> failed(n, 0);
+
+              #pragma omp parallel for schedule(dynamic)
+              for (Size i=0; i<n; ++i) {
+                  try {
+                      result[i] = costFunction.value(points[i]);
+                  } catch (Error& e) {
+                      if (failureValue != Null<Real>()) {
+                          result[i] = failureValue;
+                      } else {
+                          errors[i] = e.what();
+                          failed[i] = 1;
+                      }
+                  } catch (std::exception& e) {
+                      errors[i] = e.what();
+                      failed[i] = 1;
+                  } catch (...) {
+                      errors[i] = "unknown error";
+                      failed[i] = 1;
+                  }
+              }
+
+              for (Size i=0; i<n; ++i)
+                  QL_REQUIRE(!failed[i],
+                             "evaluation of the " << io::ordinal(i+1)
+                             << " point failed: " << errors[i]);
+            }
+            break;
+          case Batched:
+            try {
+                result = costFunction.populationValues(points);
+            } catch (Error&) {
+                if (failureValue == Null<Real>())
+                    throw;
+                // find out which points failed
+                for (Size i=0; i<n; ++i)
+                    result[i] = pointValue(costFunction, points[i],
+                                           failureValue);
+            }
+            QL_ENSURE(result.size() == n,
+                      result.size() << " values returned for "
+                      << n << " points");
+            break;
+          default:
+            QL_FAIL("unknown evaluation type (" << Integer(type_) << ")");
+        }
+
+        return result;
+    }
+
+    Disposable<Array> PopulationEvaluator::values(
+                                        Problem& problem,
+                                        const std::vector<Array>& points,
+                                        Real failureValue) const {
+        Array result = values(problem.costFunction(), points, failureValue);
+        problem.functionEvaluation_ += Integer(points.size());
+        return result;
+    }
+
+}
+
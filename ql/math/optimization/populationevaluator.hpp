@@ -0,0 +1,80 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file populationevaluator.hpp
+    \brief evaluation of a cost function over a population of points
+*/
+
+#ifndef quantlib_optimization_population_evaluator_hpp
+#define quantlib_optimization_population_evaluator_hpp
+
+#include <ql/math/optimization/problem.hpp>
+#include <ql/utilities/null.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Evaluation of a cost function over a population of points
+    /*! Population-based optimizers such as DifferentialEvolution,
+        ParticleSwarmOptimization or FireflyAlgorithm use this class
+        to compute the cost of all their trial points at once.  The
+        points can be evaluated
+
+        - serially, by calling CostFunction::value for each point;
+        - in parallel, by calling CostFunction::value for each point
+          from different threads (when QuantLib is compiled with
+          OpenMP support; otherwise, serially);
+        - in a single batch, by calling CostFunction::populationValues,
+          which vectorized cost functions can override.
+
+        The optimizers draw all their random numbers before the
+        evaluation; therefore, their results don't depend on the
+        chosen policy or on the number of threads.
+
+        \warning In parallel mode, the cost function must be safe to
+                 call concurrently; this is usually not the case when
+                 it prices instruments sharing a model or an engine.
+
+        \ingroup optimizers
+    */
+    class PopulationEvaluator {
+      public:
+        enum Type { Serial, Parallel, Batched };
+        explicit PopulationEvaluator(Type type = Serial) : type_(type) {}
+        Type type() const { return type_; }
+        /*! Returns the cost of each of the given points.  If a
+            failure value is given, points whose evaluation throws a
+            QuantLib::Error are assigned that cost; otherwise, the
+            error is propagated to the caller.
+        */
+        Disposable<Array> values(const CostFunction& costFunction,
+                                 const std::vector<Array>& points,
+                                 Real failureValue = Null<Real>()) const;
+        /*! As above, also incrementing the evaluation counter of the
+            problem.
+        */
+        Disposable<Array> values(Problem& problem,
+                                 const std::vector<Array>& points,
+                                 Real failureValue = Null<Real>()) const;
+      private:
+        Type type_;
+    };
+
+}
+
+
+#endif
@@ -39,6 +39,7 @@ namespace QuantLib {
                  Problem instance.
     */
     class Problem {
+        friend class PopulationEvaluator;
       public:
         //! default constructor
         Problem(CostFunction& costFunction,
@@ -45,4 +45,18 @@ namespace QuantLib {
         return costFunction_.values(actualParameters_);
     }
 
+    void ProjectedCostFunction::jacobian(Matrix& jac,
+                                         const Array& freeParameters) const {
+        mapFreeParameters(freeParameters);
+        Matrix fullJacobian(jac.rows(), actualParameters_.size());
+        costFunction_.jacobian(fullJacobian, actualParameters_);
+        for (Size j=0, k=0; j<fixParameters_.size(); ++j) {
+            if (!fixParameters_[j]) {
+                for (Size i=0; i<jac.rows(); ++i)
+                    jac[i][k] = fullJacobian[i][j];
+                ++k;
+            }
+        }
+    }
+
 }
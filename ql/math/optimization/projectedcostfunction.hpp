@@ -50,6 +50,10 @@ namespace QuantLib {
             virtual Real value(const Array& freeParameters) const;
             virtual Disposable<Array>
                                    values(const Array& freeParameters) const;
+            /*! the jacobian of the underlying cost function is
+                restricted to the columns of the free parameters */
+            virtual void jacobian(Matrix& jac,
+                                  const Array& freeParameters) const;
             //@}
 
         private:
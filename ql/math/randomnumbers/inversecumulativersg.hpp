@@ -26,10 +26,31 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        template <class IC, class I, class O>
+        inline void inverseCumulativeTransform(const IC& ic, I begin, I end,
+                                               O out) {
+            for (; begin != end; ++begin, ++out)
+                *out = ic(*begin);
+        }
+
+        // the whole sequence is passed to the normal distribution so
+        // that its central region can be evaluated in a vectorizable loop
+        template <class I, class O>
+        inline void inverseCumulativeTransform(
+                                  const InverseCumulativeNormal& ic,
+                                  I begin, I end, O out) {
+            ic.transform(begin, end, out);
+        }
+
+    }
+
     //! Inverse cumulative random sequence generator
     /*! It uses a sequence of uniform deviate in (0, 1) as the
         source of cumulative distribution values.
@@ -63,6 +84,11 @@ namespace QuantLib {
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
+        //! skips the given number of sequences
+        /*! USG must provide a jumpAhead method. */
+        void jumpAhead(BigNatural n) {
+            uniformSequenceGenerator_.jumpAhead(n);
+        }
       private:
         USG uniformSequenceGenerator_;
         Size dimension_;
@@ -90,9 +116,10 @@ namespace QuantLib {
         typename USG::sample_type sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
-        }
+        detail::inverseCumulativeTransform(ICD_,
+                                           sample.value.begin(),
+                                           sample.value.begin()+dimension_,
+                                           x_.value.begin());
         return x_;
     }
 
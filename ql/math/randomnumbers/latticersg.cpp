@@ -22,6 +22,9 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
 #include <ql/math/randomnumbers/latticersg.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <cmath>
+
 namespace QuantLib 
 {
 
@@ -33,6 +36,7 @@ namespace QuantLib
         N_(N),
         i_(0),
         z_(z),
+        shift_(dimensionality, 0.0),
         sequence_(std::vector<Real> (dimensionality), 1.0)
     {
     }
@@ -42,12 +46,20 @@ namespace QuantLib
         i_+=n;
     }
 
+    void LatticeRsg::randomize(unsigned long seed)
+    {
+        MersenneTwisterUniformRng rng(seed);
+        for (Size j=0; j < dimensionality_; ++j)
+            shift_[j] = rng.nextReal();
+        i_ = 0;
+    }
+
     const LatticeRsg::sample_type& LatticeRsg::nextSequence()
     {
         for (Size j=0; j < dimensionality_; ++j)
         {
             Real theta = i_*z_[j]/N_;
-            sequence_.value[j]= std::fmod(theta,1.0);
+            sequence_.value[j]= std::fmod(theta+shift_[j],1.0);
         }
         ++i_;
 
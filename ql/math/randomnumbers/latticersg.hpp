@@ -39,6 +39,12 @@ namespace QuantLib {
              Size N);
         /*! skip to the n-th sample in the low-discrepancy sequence */
         void skipTo(unsigned long n);
+        /*! adds a random shift, modulo one, to the points of the
+            lattice; the sequence restarts from its first point.
+            Different seeds give independent randomizations of the
+            rule.
+        */
+        void randomize(unsigned long seed);
         const LatticeRsg::sample_type& nextSequence();     
         Size dimension() const { return dimensionality_; }
         const sample_type& lastSequence() const { return sequence_; }
@@ -48,7 +54,8 @@ namespace QuantLib {
         Size N_;
         Size i_;
         std::vector<Real> z_;
-        
+        std::vector<Real> shift_;
+
         sample_type sequence_;
     };
 
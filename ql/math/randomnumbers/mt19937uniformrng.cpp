@@ -68,9 +68,195 @@
 
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/errors.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        /* Polynomials over GF(2) are stored as bit vectors, bit i
+           being the coefficient of x^i. */
+        typedef boost::uint64_t word_type;
+        const Size wordSize = 64;
+
+        // degree of the characteristic polynomial of MT19937
+        const Size degree = 19937;
+        const Size polynomialWords = degree/wordSize + 1;
+
+        // below this number of blocks, twisting is faster than jumping
+        const boost::uint64_t jumpThreshold = 10000;
+
+        inline bool bitAt(const std::vector<word_type>& v, Size i) {
+            return ((v[i/wordSize] >> (i%wordSize)) & 1) != 0;
+        }
+
+        inline void flipBit(std::vector<word_type>& v, Size i) {
+            v[i/wordSize] ^= word_type(1) << (i%wordSize);
+        }
+
+        inline word_type parity(word_type x) {
+            x ^= x >> 32;
+            x ^= x >> 16;
+            x ^= x >> 8;
+            x ^= x >> 4;
+            x ^= x >> 2;
+            x ^= x >> 1;
+            return x & 1;
+        }
+
+        // interleaves the lower 32 bits of x with zeros
+        inline word_type spread(word_type x) {
+            x &= 0x00000000FFFFFFFFULL;
+            x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+            x = (x | (x << 8))  & 0x00FF00FF00FF00FFULL;
+            x = (x | (x << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+            x = (x | (x << 2))  & 0x3333333333333333ULL;
+            x = (x | (x << 1))  & 0x5555555555555555ULL;
+            return x;
+        }
+
+        // v += w * x^shift, w having the given number of words
+        void addShifted(std::vector<word_type>& v,
+                        const std::vector<word_type>& w,
+                        Size words, Size shift) {
+            Size offset = shift/wordSize, s = shift%wordSize;
+            for (Size k=0; k<words; ++k) {
+                v[k+offset] ^= w[k] << s;
+                if (s != 0)
+                    v[k+offset+1] ^= w[k] >> (wordSize-s);
+            }
+        }
+
+        /* The characteristic polynomial is the minimal polynomial of
+           any non-null sequence of bits linearly generated by the
+           recurrence, since it is irreducible.  It is obtained here
+           by means of the Berlekamp-Massey algorithm applied to the
+           least significant bits of the output.
+        */
+        std::vector<word_type> characteristicPolynomial() {
+            const Size n = 2*degree;
+            const Size words = 2*n/wordSize + 2;
+
+            // the sequence is stored in reverse order, so that the
+            // discrepancy is the parity of a bitwise product
+            std::vector<word_type> r(words, 0);
+            MersenneTwisterUniformRng rng(42);
+            for (Size i=0; i<n; ++i) {
+                if (rng.nextInt32() & 1)
+                    flipBit(r, n-1-i);
+            }
+
+            std::vector<word_type> c(words, 0), b(words, 0), t;
+            c[0] = b[0] = 1;
+            Size L = 0, Lb = 0, m = 1;
+            for (Size i=0; i<n; ++i) {
+                Size o = n-1-i;
+                word_type d = 0;
+                for (Size k=0; k<=L/wordSize; ++k) {
+                    Size position = o + k*wordSize;
+                    Size w = position/wordSize, s = position%wordSize;
+                    word_type v = r[w] >> s;
+                    if (s != 0)
+                        v |= r[w+1] << (wordSize-s);
+                    d ^= c[k] & v;
+                }
+                if (parity(d) == 0) {
+                    ++m;
+                } else if (2*L <= i) {
+                    t = c;
+                    addShifted(c, b, Lb/wordSize+1, m);
+                    Lb = L;
+                    L = i+1-L;
+                    b = t;
+                    m = 1;
+                } else {
+                    addShifted(c, b, Lb/wordSize+1, m);
+                    ++m;
+                }
+            }
+            QL_ENSURE(L == degree,
+                      "wrong degree (" << L << ") of characteristic "
+                      "polynomial, " << degree << " expected");
+
+            // reciprocal of the connection polynomial
+            std::vector<word_type> phi(polynomialWords, 0);
+            for (Size i=0; i<=L; ++i) {
+                if (bitAt(c, i))
+                    flipBit(phi, L-i);
+            }
+            return phi;
+        }
+
+        // characteristic polynomial multiplied by x^s, s = 0,...,63
+        std::vector<std::vector<word_type> > shiftedPolynomials() {
+            const std::vector<word_type> phi = characteristicPolynomial();
+            std::vector<std::vector<word_type> > result(wordSize);
+            for (Size s=0; s<wordSize; ++s) {
+                result[s] = std::vector<word_type>(polynomialWords+1, 0);
+                addShifted(result[s], phi, polynomialWords, s);
+            }
+            return result;
+        }
+
+        // binary digits of a*b, least significant first
+        std::vector<bool> binaryProduct(boost::uint64_t a, Size b) {
+            const Size aBits = 8*sizeof(boost::uint64_t),
+                       bBits = 8*sizeof(Size);
+            std::vector<bool> result(aBits+bBits+1, false);
+            for (Size j=0; j<bBits; ++j) {
+                if (((b >> j) & 1) == 0)
+                    continue;
+                bool carry = false;
+                for (Size i=j; i<result.size(); ++i) {
+                    bool x = (i-j < aBits) && (((a >> (i-j)) & 1) != 0);
+                    bool sum = (result[i] != x) != carry;
+                    carry = (result[i] && x) || (carry && (result[i] != x));
+                    result[i] = sum;
+                }
+            }
+            return result;
+        }
+
+        // x^e modulo the characteristic polynomial
+        std::vector<word_type> jumpPolynomial(const std::vector<bool>& e) {
+            static const std::vector<std::vector<word_type> > phi =
+                shiftedPolynomials();
+
+            std::vector<word_type> p(polynomialWords, 0),
+                                   q(2*polynomialWords, 0);
+            p[0] = 1;
+            for (Size i=e.size(); i>0; --i) {
+                // square...
+                for (Size k=0; k<polynomialWords; ++k) {
+                    q[2*k] = spread(p[k]);
+                    q[2*k+1] = spread(p[k] >> 32);
+                }
+                // ...multiply by x if needed...
+                if (e[i-1]) {
+                    for (Size k=q.size()-1; k>0; --k)
+                        q[k] = (q[k] << 1) | (q[k-1] >> (wordSize-1));
+                    q[0] <<= 1;
+                }
+                // ...and reduce
+                for (Size b=2*degree-1; b>=degree; --b) {
+                    if (bitAt(q, b)) {
+                        Size shift = b-degree;
+                        const std::vector<word_type>& f =
+                            phi[shift%wordSize];
+                        Size offset = shift/wordSize;
+                        for (Size k=0; k<f.size(); ++k)
+                            q[k+offset] ^= f[k];
+                    }
+                }
+                std::copy(q.begin(), q.begin()+polynomialWords, p.begin());
+            }
+            return p;
+        }
+
+    }
+
     // constant vector a
     const unsigned long MersenneTwisterUniformRng::MATRIX_A = 0x9908b0dfUL;
     // most significant w-r bits
@@ -123,23 +309,133 @@ namespace QuantLib {
     }
 
     void MersenneTwisterUniformRng::twist() const {
-        static const unsigned long mag01[2]={0x0UL, MATRIX_A};
-        /* mag01[x] = x * MATRIX_A  for x=0,1 */
+        /* (0UL - (y & 0x1UL)) & MATRIX_A is y * MATRIX_A for the last
+           bit of y; unlike a table lookup, it allows the compiler to
+           vectorize the loops */
         Size kk;
         unsigned long y;
 
         for (kk=0;kk<N-M;kk++) {
             y = (mt[kk]&UPPER_MASK)|(mt[kk+1]&LOWER_MASK);
-            mt[kk] = mt[kk+M] ^ (y >> 1) ^ mag01[y & 0x1UL];
+            mt[kk] = mt[kk+M] ^ (y >> 1) ^ ((0UL - (y & 0x1UL)) & MATRIX_A);
         }
         for (;kk<N-1;kk++) {
             y = (mt[kk]&UPPER_MASK)|(mt[kk+1]&LOWER_MASK);
-            mt[kk] = mt[(kk+M)-N] ^ (y >> 1) ^ mag01[y & 0x1UL];
+            mt[kk] = mt[(kk+M)-N] ^ (y >> 1)
+                   ^ ((0UL - (y & 0x1UL)) & MATRIX_A);
         }
         y = (mt[N-1]&UPPER_MASK)|(mt[0]&LOWER_MASK);
-        mt[N-1] = mt[M-1] ^ (y >> 1) ^ mag01[y & 0x1UL];
+        mt[N-1] = mt[M-1] ^ (y >> 1) ^ ((0UL - (y & 0x1UL)) & MATRIX_A);
 
         mti = 0;
     }
 
+    namespace {
+
+        inline unsigned long tempered(unsigned long y) {
+            y ^= (y >> 11);
+            y ^= (y << 7) & 0x9d2c5680UL;
+            y ^= (y << 15) & 0xefc60000UL;
+            y ^= (y >> 18);
+            return y;
+        }
+
+    }
+
+    void MersenneTwisterUniformRng::nextInt32s(Size n,
+                                               unsigned long* output) const {
+        while (n > 0) {
+            if (mti == N)
+                twist();
+            Size m = std::min(n, Size(N-mti));
+            const unsigned long* state = mt + mti;
+            for (Size i=0; i<m; ++i)
+                output[i] = tempered(state[i]);
+            mti += m;
+            output += m;
+            n -= m;
+        }
+    }
+
+    void MersenneTwisterUniformRng::nextReals(Size n, Real* output) const {
+        while (n > 0) {
+            if (mti == N)
+                twist();
+            Size m = std::min(n, Size(N-mti));
+            const unsigned long* state = mt + mti;
+            for (Size i=0; i<m; ++i) {
+                /* same as (Real(y) + 0.5)/2^32, but converting from a
+                   signed 32-bit integer, for which SIMD instructions
+                   are available */
+                boost::int32_t y = static_cast<boost::int32_t>(
+                                   tempered(state[i]) ^ 0x80000000UL);
+                output[i] = (Real(y) + 2147483648.5)/4294967296.0;
+            }
+            mti += m;
+            output += m;
+            n -= m;
+        }
+    }
+
+    void MersenneTwisterUniformRng::jumpAhead(boost::uint64_t n) {
+        /* The state array holds N consecutive words of the sequence
+           generated by the recurrence, the next draw being the one
+           at position mti.  After the jump, the array will hold a
+           later block of N words. */
+        if (n <= N-mti) {
+            mti += n;
+            return;
+        }
+
+        boost::uint64_t blocks = n/N;
+        Size position = Size(n%N) + mti;
+        if (position >= N) {
+            position -= N;
+            ++blocks;
+        }
+        // the first word of the array must have been already drawn,
+        // since the jump doesn't reproduce its lower bits
+        if (position == 0) {
+            position = N;
+            --blocks;
+        }
+
+        advance(blocks);
+        mti = position;
+    }
+
+    void MersenneTwisterUniformRng::advance(boost::uint64_t blocks) {
+        if (blocks <= jumpThreshold) {
+            for (boost::uint64_t i=0; i<blocks; ++i)
+                twist();
+            return;
+        }
+
+        const std::vector<word_type> p =
+            jumpPolynomial(binaryProduct(blocks, N));
+
+        // evaluate p(A)x, where A is the transition matrix of the
+        // recurrence and x is the current state
+        std::vector<unsigned long> state(mt, mt+N), result(N, 0UL);
+        Size start = 0;
+        for (Size i=0; i<degree; ++i) {
+            if (bitAt(p, i)) {
+                for (Size j=start; j<N; ++j)
+                    result[j-start] ^= state[j];
+                for (Size j=0; j<start; ++j)
+                    result[j+N-start] ^= state[j];
+            }
+            // single step of the recurrence
+            Size next = (start+1 == N ? 0 : start+1);
+            Size shifted = (start+M < N ? start+M : start+M-N);
+            unsigned long y =
+                (state[start]&UPPER_MASK)|(state[next]&LOWER_MASK);
+            state[start] =
+                state[shifted] ^ (y >> 1) ^ ((y & 0x1UL) ? MATRIX_A : 0x0UL);
+            start = next;
+        }
+
+        std::copy(result.begin(), result.end(), mt);
+    }
+
 }
@@ -26,6 +26,7 @@
 #define quantlib_mersennetwister_uniform_rng_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <boost/cstdint.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -35,8 +36,19 @@ namespace QuantLib {
 
         For more details see http://www.math.keio.ac.jp/matumoto/emt.html
 
-        \test the correctness of the returned values is tested by
-              checking them against known good results.
+        The generator can be advanced by any number of draws in a
+        time proportional to the logarithm of the number of skipped
+        draws by means of the polynomial jump-ahead algorithm
+        described in H. Haramoto, M. Matsumoto, T. Nishimura,
+        F. Panneton and P. L'Ecuyer, "Efficient jump ahead for
+        F2-linear random number generators", INFORMS Journal on
+        Computing, 20(3), 2008.
+
+        \test
+        - the correctness of the returned values is tested by
+          checking them against known good results.
+        - the jump-ahead is tested by comparing the results with
+          those obtained by drawing the skipped numbers.
     */
     class MersenneTwisterUniformRng {
       private:
@@ -70,9 +82,31 @@ namespace QuantLib {
             y ^= (y >> 18);
             return y;
         }
+        //! fills the buffer with the next n random integers
+        /*! The integers are those that n calls to nextInt32() would
+            return; they are tempered in blocks, in a loop that the
+            compiler can vectorize.
+
+            \pre output must have room for n values
+        */
+        void nextInt32s(Size n, unsigned long* output) const;
+        //! fills the buffer with the next n random numbers in (0.0, 1.0)
+        /*! The numbers are those that n calls to nextReal() would
+            return.
+
+            \pre output must have room for n values
+        */
+        void nextReals(Size n, Real* output) const;
+        //! advance the generator by the given number of draws
+        /*! The count is a 64-bit integer, since the draws skipped by
+            parallel workers can exceed the range of unsigned long on
+            platforms where the latter has 32 bits.
+        */
+        void jumpAhead(boost::uint64_t n);
       private:
         void seedInitialization(unsigned long seed);
         void twist() const;
+        void advance(boost::uint64_t blocks);
         mutable unsigned long mt[N];
         mutable Size mti;
         static const unsigned long MATRIX_A, UPPER_MASK, LOWER_MASK;
@@ -24,12 +24,45 @@
 #ifndef quantlib_random_sequence_generator_h
 #define quantlib_random_sequence_generator_h
 
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/errors.hpp>
+#include <boost/cstdint.hpp>
 #include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        /* Draws n values from the generator and returns the product
+           of their weights.  Generators that can fill a buffer
+           faster than by repeated calls to next(), and whose samples
+           have unit weight, specialize it to call their nextReals
+           method. */
+        template <class RNG>
+        struct NextReals {
+            static Real apply(const RNG& rng, Size n, Real* output) {
+                Real weight = 1.0;
+                for (Size i=0; i<n; ++i) {
+                    typename RNG::sample_type x(rng.next());
+                    output[i] = x.value;
+                    weight *= x.weight;
+                }
+                return weight;
+            }
+        };
+
+        template <>
+        struct NextReals<MersenneTwisterUniformRng> {
+            static Real apply(const MersenneTwisterUniformRng& rng,
+                              Size n, Real* output) {
+                rng.nextReals(n, output);
+                return 1.0;
+            }
+        };
+
+    }
+
     //! Random sequence generator based on a pseudo-random number generator
     /*! Random sequence generator based on a pseudo-random number
         generator RNG.
@@ -43,6 +76,15 @@ namespace QuantLib {
         \code
             unsigned long RNG::nextInt32() const;
         \endcode
+        and if it wants to use the jumpAhead method, class RNG must
+        implement
+        \code
+            void RNG::jumpAhead(boost::uint64_t n);
+        \endcode
+
+        The values of each sequence are drawn at once when the
+        generator provides a block method, as MersenneTwisterUniformRng
+        and ZigguratRng do; see detail::NextReals.
 
         \warning do not use with low-discrepancy sequence generator.
     */
@@ -66,12 +108,9 @@ namespace QuantLib {
           int32Sequence_(dimensionality) {}
 
         const sample_type& nextSequence() const {
-            sequence_.weight = 1.0;
-            for (Size i=0; i<dimensionality_; i++) {
-                typename RNG::sample_type x(rng_.next());
-                sequence_.value[i] = x.value;
-                sequence_.weight  *= x.weight;
-            }
+            sequence_.weight =
+                detail::NextReals<RNG>::apply(rng_, dimensionality_,
+                                              &sequence_.value[0]);
             return sequence_;
         }
         std::vector<BigNatural> nextInt32Sequence() const {
@@ -83,6 +122,16 @@ namespace QuantLib {
         const sample_type& lastSequence() const {
             return sequence_;
         }
+        //! skips the given number of sequences
+        void jumpAhead(BigNatural n) {
+            // the product is taken in 64 bits, since unsigned long
+            // might have only 32
+            QL_REQUIRE(boost::uint64_t(n) <=
+                       boost::uint64_t(-1)/dimensionality_,
+                       "cannot skip " << n << " sequences of dimension "
+                       << dimensionality_ << ": too many draws");
+            rng_.jumpAhead(boost::uint64_t(n)*dimensionality_);
+        }
         Size dimension() const {return dimensionality_;}
       private:
         Size dimensionality_;
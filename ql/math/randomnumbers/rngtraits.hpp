@@ -54,6 +54,18 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /*! returns a generator whose first sequence is the given one
+            in the stream obtained with the given seed; this allows
+            to split the stream into disjoint blocks, e.g., among
+            several workers.  URNG must provide a jumpAhead method.
+        */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                BigNatural firstSequence) {
+            ursg_type g(dimension, seed);
+            g.jumpAhead(firstSequence);
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
         // data
         static boost::shared_ptr<IC> icInstance;
     };
@@ -91,6 +103,18 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        /*! returns a generator whose first sequence is the given one
+            in the sequence obtained with the given seed; this allows
+            to split the sequence into disjoint blocks, e.g., among
+            several workers.  URSG must provide a skipTo method.
+        */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                BigNatural firstSequence) {
+            ursg_type g(dimension, seed);
+            g.skipTo(firstSequence);
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
         // data
         static boost::shared_ptr<IC> icInstance;
     };
@@ -104,6 +128,73 @@ namespace QuantLib {
     typedef GenericLowDiscrepancy<SobolRsg,
                                   InverseCumulativeNormal> LowDiscrepancy;
 
+
+    //! traits for randomized low-discrepancy sequence generation
+    /*! The sequence generators are randomized with the given seed,
+        which URSG must support through a randomize method; the
+        generators built with different seeds are independent
+        randomizations of the same sequence.  McSimulation runs the
+        given number of randomizations and estimates the error from
+        the spread of their results.
+    */
+    template <class URSG, class IC, Size Replications = 16>
+    struct GenericRandomizedLowDiscrepancy {
+        // typedefs
+        typedef URSG ursg_type;
+        typedef InverseCumulativeRsg<ursg_type,IC> rsg_type;
+        // more traits
+        enum { allowsErrorEstimate = 1 };
+        enum { replications = Replications };
+        // factory
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed) {
+            ursg_type g(dimension, seed);
+            g.randomize(seed);
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                BigNatural firstSequence) {
+            ursg_type g(dimension, seed);
+            g.randomize(seed);
+            g.skipTo(firstSequence);
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
+        // data
+        static boost::shared_ptr<IC> icInstance;
+    };
+
+    // static member initialization
+    template<class URSG, class IC, Size Replications>
+    boost::shared_ptr<IC>
+    GenericRandomizedLowDiscrepancy<URSG, IC, Replications>::icInstance;
+
+
+    //! default traits for randomized low-discrepancy sequence generation
+    /*! \test the engines using it are checked against analytic
+              results within their error estimate.
+    */
+    typedef GenericRandomizedLowDiscrepancy<SobolRsg,
+                                 InverseCumulativeNormal> RandomizedLowDiscrepancy;
+
+
+    namespace detail {
+
+        // number of randomizations run by McSimulation; zero for
+        // the traits that don't randomize their sequences
+        template <class RNG>
+        struct RandomizedReplications {
+            enum { value = 0 };
+        };
+
+        template <class URSG, class IC, Size Replications>
+        struct RandomizedReplications<
+                GenericRandomizedLowDiscrepancy<URSG, IC, Replications> > {
+            enum { value = Replications };
+        };
+
+    }
+
 }
 
 
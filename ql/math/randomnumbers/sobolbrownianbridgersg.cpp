@@ -29,22 +29,38 @@ namespace QuantLib {
         Size factors, Size steps,
         SobolBrownianGenerator::Ordering ordering,
         unsigned long seed,
-        SobolRsg::DirectionIntegers directionIntegers)
+        SobolRsg::DirectionIntegers directionIntegers,
+        Size blockSize)
     : factors_(factors), steps_(steps), dim_(factors*steps),
+      blockSize_(blockSize),
       seq_(sample_type::value_type(factors*steps), 1.0),
-      gen_(factors, steps, ordering, seed, directionIntegers) {
+      gen_(factors, steps, ordering, seed, directionIntegers),
+      next_(blockSize) {
+        QL_REQUIRE(blockSize > 0, "block size must be positive");
     }
 
     const SobolBrownianBridgeRsg::sample_type&
     SobolBrownianBridgeRsg::nextSequence() const {
-        gen_.nextPath();
-        std::vector<Real> output(factors_);
-        for (Size i=0; i < steps_; ++i) {
-            gen_.nextStep(output);
-            std::copy(output.begin(), output.end(),
-                      seq_.value.begin()+i*factors_);
+        if (blockSize_ == 1) {
+            gen_.nextPath();
+            std::vector<Real> output(factors_);
+            for (Size i=0; i < steps_; ++i) {
+                gen_.nextStep(output);
+                std::copy(output.begin(), output.end(),
+                          seq_.value.begin()+i*factors_);
+            }
+            return seq_;
         }
 
+        if (next_ == blockSize_) {
+            gen_.nextPaths(blockSize_, weights_, stepWeights_, block_);
+            next_ = 0;
+        }
+        // the block holds the variates of all the sequences by dimension
+        for (Size k=0; k<dim_; ++k)
+            seq_.value[k] = block_[k*blockSize_+next_];
+        seq_.weight = weights_[next_];
+        ++next_;
         return seq_;
     }
 
@@ -29,6 +29,18 @@
 
 namespace QuantLib {
 
+    //! Sobol Brownian-bridge sequence generator
+    /*! The sequences are those of a SobolBrownianGenerator, with the
+        variates of each step stored together, i.e., the i-th factor
+        of the j-th step is the (j*factors+i)-th element.
+
+        If a block size larger than 1 is passed, the sequences are
+        generated in blocks by means of
+        SobolBrownianGenerator::nextPaths() and returned one at a time;
+        this makes the generation faster when a large number of
+        sequences is drawn, e.g., by a PathGenerator or
+        MultiPathGenerator, without changing the results.
+    */
     class SobolBrownianBridgeRsg {
       public:
         typedef Sample<std::vector<Real> > sample_type;
@@ -38,16 +50,20 @@ namespace QuantLib {
                                    = SobolBrownianGenerator::Diagonal,
                                unsigned long seed = 0,
                                SobolRsg::DirectionIntegers directionIntegers
-                                   = SobolRsg::JoeKuoD7);
+                                   = SobolRsg::JoeKuoD7,
+                               Size blockSize = 1);
 
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const;
         Size dimension() const;
 
       private:
-        const Size factors_, steps_, dim_;
+        const Size factors_, steps_, dim_, blockSize_;
         mutable sample_type seq_;
         mutable SobolBrownianGenerator gen_;
+        // the current block and the next sequence to be returned
+        mutable std::vector<Real> weights_, stepWeights_, block_;
+        mutable Size next_;
     };
 }
 
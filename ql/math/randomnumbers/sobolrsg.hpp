@@ -27,6 +27,7 @@
 #define quantlib_sobol_ld_rsg_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <boost/shared_ptr.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -100,6 +101,15 @@ namespace QuantLib {
         or so dimensions which is why we have the Alternative
         Primitive Polynomials.
 
+        The direction integers are calculated once for a given
+        choice of initialization numbers and seed, and shared by the
+        generators using them, including those of lower
+        dimensionality; this makes the construction of generators of
+        high dimensionality cheap after the first.  This is not
+        possible when the dimensionality exceeds the tabulated
+        initialization numbers and a null seed is passed, since a
+        random seed is used in that case.
+
         \test
         - the correctness of the returned values is tested by
           reproducing known good values.
@@ -117,16 +127,47 @@ namespace QuantLib {
         SobolRsg(Size dimensionality,
                  unsigned long seed = 0,
                  DirectionIntegers directionIntegers = Jaeckel);
-        /*! skip to the n-th sample in the low-discrepancy sequence */
+        /*! skip to the n-th sample in the low-discrepancy sequence.
+            The number of operations is proportional to the logarithm
+            of n; samples drawn before the call are not relevant,
+            so that disjoint blocks of the sequence can be assigned
+            to different generators.
+        */
         void skipTo(unsigned long n);
+        /*! randomizes the sequence by a random linear scrambling of
+            the direction integers, followed by a random digital
+            shift (Matousek, 1998).  The scrambled points keep the
+            net properties of the original sequence, and the
+            sequences obtained with different seeds are independent
+            randomizations, whose spread can be used to estimate the
+            integration error.  The sequence restarts from its first
+            point; the returned values are moved to the centers of
+            their binary intervals, so that they can't be zero.
+
+            The scrambled direction integers are owned by the
+            generator and not shared with other instances.
+        */
+        void randomize(unsigned long seed);
         const std::vector<unsigned long>& nextInt32Sequence() const;
         const SobolRsg::sample_type& nextSequence() const {
             const std::vector<unsigned long>& v = nextInt32Sequence();
             // normalize to get a double in (0,1)
             for (Size k=0; k<dimensionality_; ++k)
-                sequence_.value[k] = v[k] * normalizationFactor_;
+                sequence_.value[k] = v[k] * normalizationFactor_ + offset_;
             return sequence_;
         }
+        //! draws the next n samples at once
+        /*! The k-th component of the i-th sample is stored in
+            output[k*n+i], so that the values of each dimension are
+            contiguous.  The samples are the same that n calls to
+            nextSequence() would return; however, the Gray-code
+            increments are applied along each dimension for all the
+            samples in a single loop.  After the call, lastSequence()
+            returns the last of the samples.
+
+            \pre output must have room for n*dimension() values
+        */
+        void nextSequences(Size n, Real* output) const;
         const sample_type& lastSequence() const { return sequence_; }
         Size dimension() const { return dimensionality_; }
       private:
@@ -137,7 +178,15 @@ namespace QuantLib {
         mutable bool firstDraw_;
         mutable sample_type sequence_;
         mutable std::vector<unsigned long> integerSequence_;
-        std::vector<std::vector<unsigned long> > directionIntegers_;
+        // the j-th direction integer of dimension k is stored at
+        // j*stride_+k; the table might be shared with generators
+        // of higher dimensionality.
+        boost::shared_ptr<const std::vector<unsigned long> >
+                                                        directionIntegers_;
+        Size stride_;
+        // digital shift and offset set by randomize()
+        std::vector<unsigned long> shift_;
+        Real offset_;
     };
 
 }
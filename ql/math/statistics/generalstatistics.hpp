@@ -168,6 +168,9 @@ namespace QuantLib {
                 add(*begin, *wbegin);
         }
 
+        //! adds the data collected by another instance
+        void merge(const GeneralStatistics& other);
+
         //! resets the data to a null set
         void reset();
 
@@ -225,6 +228,17 @@ namespace QuantLib {
         sorted_ = false;
     }
 
+    inline void GeneralStatistics::merge(const GeneralStatistics& other) {
+        // indices rather than iterators, as other might be *this
+        Size n = other.samples_.size();
+        if (n == 0)
+            return;
+        samples_.reserve(samples_.size() + n);
+        for (Size i=0; i<n; ++i)
+            samples_.push_back(other.samples_[i]);
+        sorted_ = false;
+    }
+
     inline void GeneralStatistics::reset() {
         samples_ = std::vector<std::pair<Real,Real> >();
         sorted_ = true;
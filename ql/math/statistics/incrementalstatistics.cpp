@@ -20,6 +20,8 @@
 */
 
 #include <ql/math/statistics/incrementalstatistics.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 
 namespace QuantLib {
@@ -29,28 +31,23 @@ namespace QuantLib {
     }
 
     Size IncrementalStatistics::samples() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::count>(acc_);
+        return samples_;
     }
 
     Real IncrementalStatistics::weightSum() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::sum_of_weights>(acc_);
+        return weightSum_;
     }
 
     Real IncrementalStatistics::mean() const {
         QL_REQUIRE(weightSum() > 0.0, "sampleWeight_= 0, unsufficient");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::weighted_mean>(acc_);
+        return mean_;
     }
 
     Real IncrementalStatistics::variance() const {
         QL_REQUIRE(weightSum() > 0.0, "sampleWeight_= 0, unsufficient");
         QL_REQUIRE(samples() > 1, "sample number <= 1, unsufficient");
         Real n = static_cast<Real>(samples());
-        return n / (n - 1.0) *
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::weighted_variance>(acc_);
+        return n / (n - 1.0) * m2_ / weightSum_;
     }
 
     Real IncrementalStatistics::standardDeviation() const {
@@ -66,47 +63,36 @@ namespace QuantLib {
         Real n = static_cast<Real>(samples());
         Real r1 = n / (n - 2.0);
         Real r2 = (n - 1.0) / (n - 2.0);
-        return std::sqrt(r1 * r2) * 
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::weighted_skewness>(acc_);
+        return std::sqrt(r1 * r2) *
+               std::sqrt(weightSum_) * m3_ / std::pow(m2_, 1.5);
     }
 
     Real IncrementalStatistics::kurtosis() const {
         QL_REQUIRE(samples() > 3,
                    "sample number <= 3, unsufficient");
-        boost::accumulators::extract_result<
-            boost::accumulators::tag::weighted_kurtosis>(acc_);
         Real n = static_cast<Real>(samples());
         Real r1 = (n - 1.0) / (n - 2.0);
         Real r2 = (n + 1.0) / (n - 3.0);
         Real r3 = (n - 1.0) / (n - 3.0);
-        return ((3.0 + boost::accumulators::extract_result<
-                           boost::accumulators::tag::weighted_kurtosis>(acc_)) *
-                    r2 -
-                3.0 * r3) *
-               r1;
+        return (weightSum_ * m4_ / (m2_ * m2_) * r2 - 3.0 * r3) * r1;
     }
 
     Real IncrementalStatistics::min() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::min>(acc_);
+        return min_;
     }
 
     Real IncrementalStatistics::max() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::max>(acc_);
+        return max_;
     }
 
     Size IncrementalStatistics::downsideSamples() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::count>(downsideAcc_);
+        return downsideSamples_;
     }
 
     Real IncrementalStatistics::downsideWeightSum() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::sum_of_weights>(downsideAcc_);
+        return downsideWeightSum_;
     }
 
     Real IncrementalStatistics::downsideVariance() const {
@@ -114,9 +100,7 @@ namespace QuantLib {
         QL_REQUIRE(downsideSamples() > 1, "sample number <= 1, unsufficient");
         Real n = static_cast<Real>(downsideSamples());
         Real r1 = n / (n - 1.0);
-        return r1 *
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::moment<2> >(downsideAcc_);
+        return r1 * downsideQuadraticSum_ / downsideWeightSum_;
     }
 
     Real IncrementalStatistics::downsideDeviation() const {
@@ -126,14 +110,62 @@ namespace QuantLib {
     void IncrementalStatistics::add(Real value, Real valueWeight) {
         QL_REQUIRE(valueWeight >= 0.0, "negative weight (" << valueWeight
                                                            << ") not allowed");
-        acc_(value, boost::accumulators::weight = valueWeight);
-        if(value < 0.0)
-            downsideAcc_(value, boost::accumulators::weight = valueWeight);
+        accumulate(1, valueWeight, value, 0.0, 0.0, 0.0);
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        if (value < 0.0) {
+            ++downsideSamples_;
+            downsideWeightSum_ += valueWeight;
+            downsideQuadraticSum_ += valueWeight * value * value;
+        }
+    }
+
+    void IncrementalStatistics::merge(const IncrementalStatistics& other) {
+        if (other.samples_ == 0)
+            return;
+        accumulate(other.samples_, other.weightSum_, other.mean_,
+                   other.m2_, other.m3_, other.m4_);
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        downsideSamples_ += other.downsideSamples_;
+        downsideWeightSum_ += other.downsideWeightSum_;
+        downsideQuadraticSum_ += other.downsideQuadraticSum_;
+    }
+
+    /* Combines the current moments with those of another set of
+       samples (Pebay, "Formulas for robust, one-pass parallel
+       computation of covariances and arbitrary-order statistical
+       moments", Sandia Report SAND2008-6212, 2008.)  Adding a single
+       sample is the particular case with null m2, m3 and m4. */
+    void IncrementalStatistics::accumulate(Size samples, Real weight,
+                                           Real mean, Real m2, Real m3,
+                                           Real m4) {
+        samples_ += samples;
+        Real wa = weightSum_, wb = weight, w = wa + wb;
+        if (wb == 0.0)
+            return;
+        Real delta = mean - mean_;
+        Real delta2 = delta * delta;
+        m4_ += m4
+            + delta2 * delta2 * wa * wb * (wa * wa - wa * wb + wb * wb)
+                                                              / (w * w * w)
+            + 6.0 * delta2 * (wa * wa * m2 + wb * wb * m2_) / (w * w)
+            + 4.0 * delta * (wa * m3 - wb * m3_) / w;
+        m3_ += m3
+            + delta2 * delta * wa * wb * (wa - wb) / (w * w)
+            + 3.0 * delta * (wa * m2 - wb * m2_) / w;
+        m2_ += m2 + delta2 * wa * wb / w;
+        mean_ += delta * wb / w;
+        weightSum_ = w;
     }
 
     void IncrementalStatistics::reset() {
-        acc_ = accumulator_set();
-        downsideAcc_ = downside_accumulator_set();
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = QL_MAX_REAL;
+        max_ = QL_MIN_REAL;
+        downsideSamples_ = 0;
+        downsideWeightSum_ = downsideQuadraticSum_ = 0.0;
     }
 
 }
@@ -21,8 +21,6 @@
 
 /*! \file incrementalstatistics.hpp
     \brief statistics tool based on incremental accumulation
-           in the meantime, this is just a wrapper to the boost
-           accumulator library, kept for backward compatibility
 */
 
 #ifndef quantlib_incremental_statistics_hpp
@@ -31,31 +29,15 @@
 #include <ql/utilities/null.hpp>
 #include <ql/errors.hpp>
 
-#if defined(__clang__)
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wc++11-extensions"
-#endif
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/count.hpp>
-#include <boost/accumulators/statistics/sum.hpp>
-#include <boost/accumulators/statistics/min.hpp>
-#include <boost/accumulators/statistics/max.hpp>
-#include <boost/accumulators/statistics/weighted_mean.hpp>
-#include <boost/accumulators/statistics/weighted_variance.hpp>
-#include <boost/accumulators/statistics/weighted_skewness.hpp>
-#include <boost/accumulators/statistics/weighted_kurtosis.hpp>
-#include <boost/accumulators/statistics/weighted_moment.hpp>
-#if defined(__clang__)
-#pragma clang diagnostic pop
-#endif
-
 namespace QuantLib {
 
     //! Statistics tool based on incremental accumulation
     /*! It can accumulate a set of data and return statistics (e.g: mean,
         variance, skewness, kurtosis, error estimation, etc.).
-        This class is a wrapper to the boost accumulator library.
+
+        The samples are not stored; the central moments are updated
+        as they're added.  Two instances can be merged, e.g., to
+        combine the results of different threads.
     */
 
     class IncrementalStatistics {
@@ -153,29 +135,24 @@ namespace QuantLib {
             for (;begin!=end;++begin,++wbegin)
                 add(*begin, *wbegin);
         }
+        //! adds the data collected by another instance
+        /*! The result is the same (up to rounding) as if the samples
+            of the other instance had been added to this one.
+        */
+        void merge(const IncrementalStatistics& other);
         //! resets the data to a null set
         void reset();
         //@}
      private:
-       typedef boost::accumulators::accumulator_set<
-           Real,
-           boost::accumulators::stats<
-               boost::accumulators::tag::count, boost::accumulators::tag::min,
-               boost::accumulators::tag::max,
-               boost::accumulators::tag::weighted_mean,
-               boost::accumulators::tag::weighted_variance,
-               boost::accumulators::tag::weighted_skewness,
-               boost::accumulators::tag::weighted_kurtosis,
-               boost::accumulators::tag::sum_of_weights>,
-           Real> accumulator_set;
-        accumulator_set acc_;
-        typedef boost::accumulators::accumulator_set<
-            Real, boost::accumulators::stats<
-                      boost::accumulators::tag::count,
-                      boost::accumulators::tag::weighted_moment<2>,
-                      boost::accumulators::tag::sum_of_weights>,
-            Real> downside_accumulator_set;
-        downside_accumulator_set downsideAcc_;
+        void accumulate(Size samples, Real weight, Real mean,
+                        Real m2, Real m3, Real m4);
+        // m2_, m3_ and m4_ are the weighted sums of the powers of
+        // the deviations from the mean
+        Size samples_;
+        Real weightSum_, mean_, m2_, m3_, m4_, min_, max_;
+        // weighted sum of the squares of the negative samples
+        Size downsideSamples_;
+        Real downsideWeightSum_, downsideQuadraticSum_;
     };
 
 }
@@ -27,6 +27,7 @@
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/math/matrix.hpp>
+#include <numeric>
 
 namespace QuantLib {
 
@@ -131,20 +132,38 @@ namespace QuantLib {
                        "sample size mismatch: " << dimension_ <<
                        " required, " << std::distance(begin, end) <<
                        " provided");
+            QL_REQUIRE(weight >= 0.0, "negative weight not allowed");
 
-            quadraticSum_ += weight * outerProduct(begin, end,
-                                                   begin, end);
-
-            for (Size i=0; i<dimension_; ++begin, ++i)
+            Real scale = std::sqrt(weight);
+            for (Size i=0; i<dimension_; ++begin, ++i) {
+                pending_[i][pendingSamples_] = scale * (*begin);
                 stats_[i].add(*begin, weight);
+            }
 
+            if (++pendingSamples_ == pending_.columns())
+                updateQuadraticSum();
         }
+        //! adds the data collected by another instance
+        /*! The result is the same (up to rounding) as if the samples
+            of the other instance had been added to this one.
+
+            \pre the underlying statistics class must provide a
+                 corresponding <tt>merge</tt> method.
+        */
+        void merge(const GenericSequenceStatistics& other);
         //@}
       protected:
+        void updateQuadraticSum() const;
         Size dimension_;
         std::vector<statistics_type> stats_;
         mutable std::vector<Real> results_;
-        Matrix quadraticSum_;
+        mutable Matrix quadraticSum_;
+        // samples not yet added to quadraticSum_, stored by column
+        // and scaled by the square root of their weight; they're
+        // added in batches, which is faster than adding the outer
+        // product of each sample
+        mutable Matrix pending_;
+        mutable Size pendingSamples_;
     };
 
     //! default multi-dimensional statistics tool
@@ -158,7 +177,7 @@ namespace QuantLib {
 
     template <class Stat>
     inline GenericSequenceStatistics<Stat>::GenericSequenceStatistics(Size dimension)
-    : dimension_(0) {
+    : dimension_(0), pendingSamples_(0) {
         reset(dimension);
     }
 
@@ -239,9 +258,48 @@ namespace QuantLib {
                 results_ = std::vector<Real>(dimension);
             }
             quadraticSum_ = Matrix(dimension_, dimension_, 0.0);
+            pending_ = Matrix(dimension_, 64);
         } else {
             dimension_ = dimension;
         }
+        pendingSamples_ = 0;
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                    const GenericSequenceStatistics& other) {
+        if (other.samples() == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+
+        other.updateQuadraticSum();
+        updateQuadraticSum();
+        quadraticSum_ += other.quadraticSum_;
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::updateQuadraticSum() const {
+        if (pendingSamples_ == 0)
+            return;
+        // rank-k update; only the lower triangle is calculated
+        for (Size i=0; i<dimension_; ++i) {
+            for (Size j=0; j<=i; ++j) {
+                Real sum = std::inner_product(
+                                   pending_.row_begin(i),
+                                   pending_.row_begin(i) + pendingSamples_,
+                                   pending_.row_begin(j), Real(0.0));
+                quadraticSum_[i][j] += sum;
+                if (j != i)
+                    quadraticSum_[j][i] += sum;
+            }
+        }
+        pendingSamples_ = 0;
     }
 
     template <class Stat>
@@ -254,6 +312,8 @@ namespace QuantLib {
         QL_REQUIRE(sampleNumber > 1.0,
                    "sample number <=1, unsufficient");
 
+        updateQuadraticSum();
+
         std::vector<Real> m = mean();
         Real inv = 1.0/sampleWeight;
 
@@ -0,0 +1,250 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/tdigeststatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        // scale function limiting the size of the centroids; the
+        // centroid starting at quantile q can extend to the quantile
+        // where the scale has increased by one
+        Real quantileLimit(Real q, Real compression) {
+            Real k = compression/(2.0*M_PI) * std::asin(2.0*q-1.0) + 1.0;
+            if (k >= compression/4.0)
+                return 1.0;
+            return 0.5 * (std::sin(2.0*M_PI*k/compression) + 1.0);
+        }
+
+    }
+
+    TDigestStatistics::TDigestStatistics(Real compression)
+    : compression_(compression) {
+        QL_REQUIRE(compression >= 10.0,
+                   "compression (" << compression << ") must be at least 10");
+        bufferSize_ = static_cast<Size>(5.0*std::ceil(compression));
+        reset();
+    }
+
+    void TDigestStatistics::reset() {
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = QL_MAX_REAL;
+        max_ = QL_MIN_REAL;
+        centroids_ = std::vector<Centroid>();
+        buffer_ = std::vector<Centroid>();
+    }
+
+    Real TDigestStatistics::mean() const {
+        QL_REQUIRE(samples_ != 0, "empty sample set");
+        QL_REQUIRE(weightSum_ > 0.0, "null weight sum");
+        return mean_;
+    }
+
+    Real TDigestStatistics::variance() const {
+        Size N = samples();
+        QL_REQUIRE(N > 1,
+                   "sample number <=1, unsufficient");
+        QL_REQUIRE(weightSum_ > 0.0, "null weight sum");
+        return (m2_/weightSum_)*N/(N-1.0);
+    }
+
+    Real TDigestStatistics::skewness() const {
+        Size N = samples();
+        QL_REQUIRE(N > 2,
+                   "sample number <=2, unsufficient");
+
+        Real x = m3_/weightSum_;
+        Real sigma = standardDeviation();
+
+        return (x/(sigma*sigma*sigma))*(N/(N-1.0))*(N/(N-2.0));
+    }
+
+    Real TDigestStatistics::kurtosis() const {
+        Size N = samples();
+        QL_REQUIRE(N > 3,
+                   "sample number <=3, unsufficient");
+
+        Real x = m4_/weightSum_;
+        Real sigma2 = variance();
+
+        Real c1 = (N/(N-1.0)) * (N/(N-2.0)) * ((N+1.0)/(N-3.0));
+        Real c2 = 3.0 * ((N-1.0)/(N-2.0)) * ((N-1.0)/(N-3.0));
+
+        return c1*(x/(sigma2*sigma2))-c2;
+    }
+
+    Real TDigestStatistics::percentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0,
+                   "empty sample set");
+
+        compress();
+
+        // each centroid is taken to be spread around its mean; the
+        // first and last ones extend to the extrema of the samples
+        const std::vector<Centroid>& c = centroids_;
+        Real target = percent*weightSum_;
+        Real left = 0.0;
+        Size i = 0;
+        // skip leading centroids with null weight
+        while (c[i].weight == 0.0)
+            ++i;
+        Real middle = c[i].weight/2.0;
+        if (target < middle) {
+            if (c[i].samples == 1)
+                return c[i].mean;
+            return min_ + (c[i].mean-min_)*target/middle;
+        }
+        for (Size j=i+1; j<c.size(); ++j) {
+            if (c[j].weight == 0.0)
+                continue;
+            Real next = left + c[i].weight + c[j].weight/2.0;
+            if (target <= next) {
+                // single samples are points, not spread
+                Real from = middle, to = next;
+                if (c[i].samples == 1 && c[j].samples == 1)
+                    return target <= left + c[i].weight ? c[i].mean
+                                                        : c[j].mean;
+                if (c[i].samples == 1)
+                    from = left + c[i].weight;
+                if (c[j].samples == 1)
+                    to = left + c[i].weight;
+                if (target <= from)
+                    return c[i].mean;
+                if (target >= to)
+                    return c[j].mean;
+                return c[i].mean +
+                    (c[j].mean-c[i].mean)*(target-from)/(to-from);
+            }
+            left += c[i].weight;
+            middle = next;
+            i = j;
+        }
+        if (c[i].samples == 1)
+            return c[i].mean;
+        return c[i].mean +
+            (max_-c[i].mean)*(target-middle)/(weightSum_-middle);
+    }
+
+    Real TDigestStatistics::topPercentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0,
+                   "empty sample set");
+
+        if (percent == 1.0)
+            return min_;
+        return percentile(1.0-percent);
+    }
+
+    void TDigestStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight>=0.0, "negative weight not allowed");
+        accumulate(1, weight, value, 0.0, 0.0, 0.0);
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        Centroid c = { value, weight, 1 };
+        buffer_.push_back(c);
+        if (buffer_.size() >= bufferSize_)
+            compress();
+    }
+
+    void TDigestStatistics::merge(const TDigestStatistics& other) {
+        if (other.samples_ == 0)
+            return;
+        accumulate(other.samples_, other.weightSum_, other.mean_,
+                   other.m2_, other.m3_, other.m4_);
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        buffer_.insert(buffer_.end(),
+                       other.centroids_.begin(), other.centroids_.end());
+        buffer_.insert(buffer_.end(),
+                       other.buffer_.begin(), other.buffer_.end());
+        compress();
+    }
+
+    /* Combines the current moments with those of another set of
+       samples (Pebay, "Formulas for robust, one-pass parallel
+       computation of covariances and arbitrary-order statistical
+       moments", Sandia Report SAND2008-6212, 2008.) */
+    void TDigestStatistics::accumulate(Size samples, Real weight, Real mean,
+                                       Real m2, Real m3, Real m4) {
+        samples_ += samples;
+        Real wa = weightSum_, wb = weight, w = wa + wb;
+        if (wb == 0.0)
+            return;
+        Real delta = mean - mean_;
+        Real delta2 = delta*delta;
+        m4_ += m4
+            + delta2*delta2*wa*wb*(wa*wa - wa*wb + wb*wb)/(w*w*w)
+            + 6.0*delta2*(wa*wa*m2 + wb*wb*m2_)/(w*w)
+            + 4.0*delta*(wa*m3 - wb*m3_)/w;
+        m3_ += m3
+            + delta2*delta*wa*wb*(wa - wb)/(w*w)
+            + 3.0*delta*(wa*m2 - wb*m2_)/w;
+        m2_ += m2 + delta2*wa*wb/w;
+        mean_ += delta*wb/w;
+        weightSum_ = w;
+    }
+
+    void TDigestStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end());
+
+        Real totalWeight = 0.0;
+        for (Size i=0; i<buffer_.size(); ++i)
+            totalWeight += buffer_[i].weight;
+
+        std::vector<Centroid> merged;
+        merged.reserve(std::min<Size>(buffer_.size(), bufferSize_));
+        Centroid current = buffer_[0];
+        Real weightBefore = 0.0;
+        Real limit = totalWeight > 0.0 ?
+            quantileLimit(0.0, compression_) * totalWeight : 0.0;
+        for (Size i=1; i<buffer_.size(); ++i) {
+            const Centroid& next = buffer_[i];
+            if (weightBefore + current.weight + next.weight <= limit) {
+                Real w = current.weight + next.weight;
+                if (w > 0.0)
+                    current.mean += (next.mean-current.mean)*next.weight/w;
+                current.weight = w;
+                current.samples += next.samples;
+            } else {
+                weightBefore += current.weight;
+                merged.push_back(current);
+                current = next;
+                if (totalWeight > 0.0)
+                    limit = quantileLimit(weightBefore/totalWeight,
+                                          compression_) * totalWeight;
+            }
+        }
+        merged.push_back(current);
+
+        centroids_.swap(merged);
+        buffer_.clear();
+    }
+
+}
@@ -0,0 +1,276 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file tdigeststatistics.hpp
+    \brief bounded-memory statistics tool based on a t-digest
+*/
+
+#ifndef quantlib_tdigest_statistics_hpp
+#define quantlib_tdigest_statistics_hpp
+
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Bounded-memory statistics tool
+    /*! This class returns the same statistics as GeneralStatistics,
+        but it doesn't store the samples; instead, it summarizes their
+        distribution with a t-digest (see Dunning and Ertl, "Computing
+        extremely accurate quantiles using t-digests", 2019).  The
+        samples are grouped in clusters (centroids) whose size is
+        limited by their position in the distribution, so that the
+        clusters in the tails hold few samples; the memory used is
+        bounded by a multiple of the compression parameter.
+
+        Two instances can be merged, e.g., to combine the results of
+        different threads or processes.
+
+        The number of samples, their weight sum, mean, variance,
+        skewness, kurtosis, minimum and maximum are calculated exactly.
+        Percentiles and expectation values are calculated by taking
+        the samples in each cluster to be spread around its mean; the
+        results are exact when the clusters hold single samples, which
+        is the case for small sample sets and for the extreme tails.
+        Higher compressions give more accurate results; a compression
+        of a few hundreds is advisable for tail measures such as the
+        expected shortfall.
+    */
+    class TDigestStatistics {
+      public:
+        typedef Real value_type;
+        /*! \param compression  controls the number of centroids, and
+                                therefore the accuracy and the memory
+                                used; typical values range from 100
+                                to 1000.
+        */
+        explicit TDigestStatistics(Real compression = 100.0);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const;
+
+        //! sum of data weights
+        Real weightSum() const;
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \sigma^2 = \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        /*! Expectation value of a function \f$ f \f$ on a given
+            range \f$ \mathcal{R} \f$, i.e.,
+            \f[ \mathrm{E}\left[f \;|\; \mathcal{R}\right] =
+                \frac{\sum_{x_i \in \mathcal{R}} f(x_i) w_i}{
+                      \sum_{x_i \in \mathcal{R}} w_i}. \f]
+            The range is passed as a boolean function returning
+            <tt>true</tt> if the argument belongs to the range
+            or <tt>false</tt> otherwise.
+
+            The samples of each centroid are approximated by up to 16
+            points with equal weights, centered on its mean and spread
+            uniformly up to the midpoints to its neighbours.
+
+            The function returns a pair made of the result and
+            the number of observations in the given range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            compress();
+            Real num = 0.0, den = 0.0;
+            Size N = 0;
+            const std::vector<Centroid>& c = centroids_;
+            for (Size i=0; i<c.size(); ++i) {
+                Size n = std::min<Size>(c[i].samples, 16);
+                Real lower = (i == 0 ? min_ : 0.5*(c[i-1].mean+c[i].mean));
+                Real upper = (i == c.size()-1 ? max_
+                                              : 0.5*(c[i].mean+c[i+1].mean));
+                Real width = n > 1 ? upper - lower : 0.0;
+                for (Size k=0; k<n; ++k) {
+                    Real x = c[i].mean + ((k+0.5)/n - 0.5)*width;
+                    if (inRange(x)) {
+                        num += f(x)*c[i].weight/n;
+                        den += c[i].weight/n;
+                        N += c[i].samples*(k+1)/n - c[i].samples*k/n;
+                    }
+                }
+            }
+            if (N == 0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,N);
+        }
+
+        /*! approximate \f$ y \f$-th percentile, defined as the value
+            \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i < \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! approximate \f$ y \f$-th top percentile, defined as the
+            value \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i > \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+
+        //! compression parameter
+        Real compression() const;
+
+        //! number of centroids currently used to summarize the data
+        Size centroids() const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weights must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the data collected by another instance
+        /*! The result is the same (up to the approximation of the
+            digest) as if the samples of the other instance had been
+            added to this one.
+        */
+        void merge(const TDigestStatistics& other);
+
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Real mean, weight;
+            Size samples;
+            bool operator<(const Centroid& c) const { return mean < c.mean; }
+        };
+        void accumulate(Size samples, Real weight, Real mean,
+                        Real m2, Real m3, Real m4);
+        void compress() const;
+        Real compression_;
+        Size bufferSize_;
+        // exact moments; m2_, m3_ and m4_ are the weighted sums of
+        // the powers of the deviations from the mean
+        Size samples_;
+        Real weightSum_, mean_, m2_, m3_, m4_, min_, max_;
+        // the buffer holds the samples not yet merged in the centroids
+        mutable std::vector<Centroid> centroids_, buffer_;
+    };
+
+    //! risk measures based on bounded-memory statistics
+    /*! A compression other than the default can be used by
+        initializing an instance with a TDigestStatistics one.
+    */
+    typedef GenericRiskStatistics<TDigestStatistics> TDigestRiskStatistics;
+
+
+    // inline definitions
+
+    inline Size TDigestStatistics::samples() const {
+        return samples_;
+    }
+
+    inline Real TDigestStatistics::weightSum() const {
+        return weightSum_;
+    }
+
+    inline Real TDigestStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    inline Real TDigestStatistics::errorEstimate() const {
+        return std::sqrt(variance()/samples());
+    }
+
+    inline Real TDigestStatistics::min() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return min_;
+    }
+
+    inline Real TDigestStatistics::max() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return max_;
+    }
+
+    inline Real TDigestStatistics::compression() const {
+        return compression_;
+    }
+
+    inline Size TDigestStatistics::centroids() const {
+        compress();
+        return centroids_.size();
+    }
+
+}
+
+
+#endif
@@ -27,6 +27,8 @@
 #include <ql/methods/finitedifferences/stepcondition.hpp>
 #include <ql/methods/finitedifferences/boundarycondition.hpp>
 #include <ql/methods/finitedifferences/operatortraits.hpp>
+#include <ql/math/memorypool.hpp>
+#include <ql/utilities/instrumentation.hpp>
 
 namespace QuantLib {
 
@@ -94,7 +96,12 @@ namespace QuantLib {
 
             QL_REQUIRE(from >= to,
                        "trying to roll back from " << from << " to " << to);
+            QL_INSTRUMENT_SCOPE("FiniteDifferenceModel::rollback");
+            QL_INSTRUMENT_COUNT("FiniteDifferenceModel::steps", steps);
 
+            // the evolvers create temporaries of the same sizes at
+            // each step; reuse their storage
+            MemoryPool::Scope pool;
             Time dt = (from-to)/steps, t = from;
             evolver_.setStep(dt);
 
@@ -132,11 +132,13 @@ namespace QuantLib {
     Disposable<Array> FdmMesherComposite::locations(Size direction) const {
         Array retVal(layout_->size());
 
-        const FdmLinearOpIterator endIter = layout_->end();
-        for (FdmLinearOpIterator iter = layout_->begin();
-             iter != endIter; ++iter) {
-            retVal[iter.index()] =
-                mesher_[direction]->locations()[iter.coordinates()[direction]];
+        const std::vector<Real>& x = mesher_[direction]->locations();
+        const Size stride = layout_->spacing()[direction];
+        const Size nLines = layout_->lines(direction);
+        for (Size l=0; l < nLines; ++l) {
+            Size i = layout_->lineStart(direction, l);
+            for (Size k=0; k < x.size(); ++k, i+=stride)
+                retVal[i] = x[k];
         }
 
         return retVal;
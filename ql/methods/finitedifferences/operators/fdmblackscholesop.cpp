@@ -21,6 +21,8 @@
 
 #include <ql/math/functional.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
@@ -59,22 +61,37 @@ namespace QuantLib {
             const FdmLinearOpIterator endIter = layout->end();
 
             Array v(layout->size());
-            for (FdmLinearOpIterator iter = layout->begin();
-                 iter!=endIter; ++iter) {
-                const Size i = iter.index();
+            bool done = false;
+            // the surface can share the work depending on time among
+            // all the mesh points; if any of them fails, the points
+            // are taken one by one below
+            try {
+                localVol_->localVols(0.5*(t1+t2), x_, v, true);
+                std::transform(v.begin(), v.end(), v.begin(),
+                               square<Real>());
+                done = true;
+            } catch (Error&) {
+                if (illegalLocalVolOverwrite_ < 0.0)
+                    throw;
+            }
+            if (!done) {
+                for (FdmLinearOpIterator iter = layout->begin();
+                     iter!=endIter; ++iter) {
+                    const Size i = iter.index();
 
-                if (illegalLocalVolOverwrite_ < 0.0) {
-                    v[i] = square<Real>()(
-                                localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                }
-                else {
-                    try {
+                    if (illegalLocalVolOverwrite_ < 0.0) {
                         v[i] = square<Real>()(
                                 localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                    } catch (Error&) {
-                        v[i] = square<Real>()(illegalLocalVolOverwrite_);
                     }
+                    else {
+                        try {
+                            v[i] = square<Real>()(
+                                localVol_->localVol(0.5*(t1+t2), x_[i], true));
+                        } catch (Error&) {
+                            v[i] = square<Real>()(illegalLocalVolOverwrite_);
+                        }
 
+                    }
                 }
             }
             mapT_.axpyb(r - q - 0.5*v, dxMap_,
@@ -89,6 +106,13 @@ namespace QuantLib {
         }
     }
 
+    bool FdmBlackScholesOp::isTimeDependent() const {
+        return localVol_
+            || !boost::dynamic_pointer_cast<FlatForward>(rTS_)
+            || !boost::dynamic_pointer_cast<FlatForward>(qTS_)
+            || !boost::dynamic_pointer_cast<BlackConstantVol>(volTS_);
+    }
+
     Size FdmBlackScholesOp::size() const {
         return 1u;
     }
@@ -127,6 +151,16 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply_columns(const Matrix& r,
+                                          Matrix& out) const {
+        mapT_.apply(r, out);
+    }
+
+    void FdmBlackScholesOp::solve_splitting_columns(const Matrix& r, Real dt,
+                                                    Matrix& out) const {
+        mapT_.solve_splitting(r, dt, 1.0, out);
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmBlackScholesOp::toMatrixDecomp() const {
@@ -46,6 +46,8 @@ namespace QuantLib {
 
         Size size() const;
         void setTime(Time t1, Time t2);
+        //! false for flat rates and constant volatility
+        bool isTimeDependent() const;
 
         Disposable<Array> apply(const Array& r) const;
         Disposable<Array> apply_mixed(const Array& r) const;
@@ -55,6 +57,16 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        /*! \name Batch evaluation
+            The columns of r are independent vectors on the mesh,
+            e.g., the values of several options sharing the process.
+        */
+        //@{
+        void apply_columns(const Matrix& r, Matrix& out) const;
+        void solve_splitting_columns(const Matrix& r, Real s,
+                                     Matrix& out) const;
+        //@}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
@@ -0,0 +1,120 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/functional.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmdupireop.hpp>
+
+namespace QuantLib {
+
+    FdmDupireOp::FdmDupireOp(
+        const boost::shared_ptr<FdmMesher>& mesher,
+        const boost::shared_ptr<YieldTermStructure>& rTS,
+        const boost::shared_ptr<YieldTermStructure>& qTS,
+        const boost::shared_ptr<LocalVolTermStructure>& localVol,
+        Real illegalLocalVolOverwrite,
+        Size direction)
+    : mesher_(mesher),
+      rTS_   (rTS),
+      qTS_   (qTS),
+      localVol_(localVol),
+      strikes_(Exp(mesher->locations(direction))),
+      dyMap_ (FirstDerivativeOp(direction, mesher)),
+      dyyMap_(SecondDerivativeOp(direction, mesher)),
+      mapT_  (direction, mesher),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      direction_(direction) {
+    }
+
+    void FdmDupireOp::setTime(Time t1, Time t2) {
+        const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
+        const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
+        const FdmLinearOpIterator endIter = layout->end();
+
+        Array v(layout->size());
+        for (FdmLinearOpIterator iter = layout->begin();
+             iter!=endIter; ++iter) {
+            const Size i = iter.index();
+
+            if (illegalLocalVolOverwrite_ < 0.0) {
+                v[i] = square<Real>()(
+                    localVol_->localVol(0.5*(t1+t2), strikes_[i], true));
+            }
+            else {
+                try {
+                    v[i] = square<Real>()(
+                        localVol_->localVol(0.5*(t1+t2), strikes_[i], true));
+                } catch (Error&) {
+                    v[i] = square<Real>()(illegalLocalVolOverwrite_);
+                }
+            }
+        }
+        mapT_.axpyb(q - r - 0.5*v, dyMap_,
+                    dyyMap_.mult(0.5*v), Array(1, -q));
+    }
+
+    Size FdmDupireOp::size() const {
+        return 1u;
+    }
+
+    Disposable<Array> FdmDupireOp::apply(const Array& u) const {
+        return mapT_.apply(u);
+    }
+
+    Disposable<Array> FdmDupireOp::apply_direction(Size direction,
+                                                   const Array& r) const {
+        if (direction == direction_)
+            return mapT_.apply(r);
+        else {
+            Array retVal(r.size(), 0.0);
+            return retVal;
+        }
+    }
+
+    Disposable<Array> FdmDupireOp::apply_mixed(const Array& r) const {
+        Array retVal(r.size(), 0.0);
+        return retVal;
+    }
+
+    Disposable<Array> FdmDupireOp::solve_splitting(Size direction,
+                                                   const Array& r,
+                                                   Real dt) const {
+        if (direction == direction_)
+            return mapT_.solve_splitting(r, dt, 1.0);
+        else {
+            Array retVal(r);
+            return retVal;
+        }
+    }
+
+    Disposable<Array> FdmDupireOp::preconditioner(const Array& r,
+                                                  Real dt) const {
+        return solve_splitting(direction_, r, dt);
+    }
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    Disposable<std::vector<SparseMatrix> >
+    FdmDupireOp::toMatrixDecomp() const {
+        std::vector<SparseMatrix> retVal(1, mapT_.toMatrix());
+        return retVal;
+    }
+#endif
+}
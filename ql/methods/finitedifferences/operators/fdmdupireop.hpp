@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmdupireop.hpp
+    \brief Dupire forward operator for call prices in log-strike
+*/
+
+#ifndef quantlib_fdm_dupire_op_hpp
+#define quantlib_fdm_dupire_op_hpp
+
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
+#include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
+#include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+
+namespace QuantLib {
+
+    //! Dupire forward operator
+    /*! The operator evolves the call prices \f$ C(T, K) \f$ forward in
+        the maturity \f$ T \f$, with the log-strike \f$ y = \ln K \f$
+        as the spatial variable:
+        \f[
+        \frac{\partial C}{\partial T} =
+            \frac{1}{2}\sigma^2(T, K)\left(\frac{\partial^2 C}{\partial y^2}
+                                  - \frac{\partial C}{\partial y}\right)
+            - (r - q)\frac{\partial C}{\partial y} - q C
+        \f]
+        The times passed to setTime() are maturities, i.e., the
+        operator is meant to be stepped forward from 0.
+    */
+    class FdmDupireOp : public FdmLinearOpComposite {
+      public:
+        FdmDupireOp(
+            const boost::shared_ptr<FdmMesher>& mesher,
+            const boost::shared_ptr<YieldTermStructure>& rTS,
+            const boost::shared_ptr<YieldTermStructure>& qTS,
+            const boost::shared_ptr<LocalVolTermStructure>& localVol,
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            Size direction = 0);
+
+        Size size() const;
+        void setTime(Time t1, Time t2);
+
+        Disposable<Array> apply(const Array& r) const;
+        Disposable<Array> apply_mixed(const Array& r) const;
+        Disposable<Array> apply_direction(Size direction,
+                                          const Array& r) const;
+        Disposable<Array> solve_splitting(Size direction,
+                                          const Array& r, Real s) const;
+        Disposable<Array> preconditioner(const Array& r, Real s) const;
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
+#endif
+      private:
+        const boost::shared_ptr<FdmMesher> mesher_;
+        const boost::shared_ptr<YieldTermStructure> rTS_, qTS_;
+        const boost::shared_ptr<LocalVolTermStructure> localVol_;
+        const Array strikes_;
+        const FirstDerivativeOp  dyMap_;
+        const TripleBandLinearOp dyyMap_;
+        TripleBandLinearOp mapT_;
+        const Real illegalLocalVolOverwrite_;
+        const Size direction_;
+    };
+}
+
+#endif
@@ -201,6 +201,49 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonOp::apply(const Array& u, Array& out) const {
+        if (tmp_.size() != u.size())
+            tmp_ = Array(u.size());
+
+        dyMap_.getMap().apply(u, out);
+        dxMap_.getMap().apply(u, tmp_);
+        for (Size i=0; i < out.size(); ++i)
+            out[i] += tmp_[i];
+
+        const Array& l = dxMap_.getL();
+        correlationMap_.apply(u, tmp_);
+        for (Size i=0; i < out.size(); ++i)
+            out[i] += l[i]*tmp_[i];
+    }
+
+    void FdmHestonOp::apply_mixed(const Array& r, Array& out) const {
+        const Array& l = dxMap_.getL();
+        correlationMap_.apply(r, out);
+        for (Size i=0; i < out.size(); ++i)
+            out[i] *= l[i];
+    }
+
+    void FdmHestonOp::apply_direction(Size direction,
+                                      const Array& r, Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply(r, out);
+        else if (direction == 1)
+            dyMap_.getMap().apply(r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::solve_splitting(Size direction,
+                                      const Array& r, Real a,
+                                      Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting(r, a, 1.0, out);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting(r, a, 1.0, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHestonOp::toMatrixDecomp() const {
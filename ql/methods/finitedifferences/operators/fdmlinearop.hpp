@@ -37,6 +37,12 @@ namespace QuantLib {
         virtual ~FdmLinearOp() { }
         virtual Disposable<array_type> apply(const array_type& r) const = 0;
 
+        /*! in-place variant writing the result into a preallocated
+            array of the same size as r; out must not be r. */
+        virtual void apply(const array_type& r, array_type& out) const {
+            out = apply(r);
+        }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<SparseMatrix> toMatrix() const = 0;
 #endif
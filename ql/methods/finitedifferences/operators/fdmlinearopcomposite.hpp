@@ -42,6 +42,12 @@ namespace QuantLib {
         //! Time \f$t1 <= t2\f$ is required
         virtual void setTime(Time t1, Time t2) = 0;
 
+        /*! Operators whose coefficients don't depend on time can
+            return false; schemes then call setTime only once and
+            reuse the factorizations of the operator at each step.
+        */
+        virtual bool isTimeDependent() const { return true; }
+
         virtual Disposable<Array> apply_mixed(const Array& r) const = 0;
         
         virtual Disposable<Array> 
@@ -51,6 +57,26 @@ namespace QuantLib {
         virtual Disposable<Array> 
             preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name In-place variants
+            The result is written into a preallocated array of the same
+            size as r, which must not be r itself. The default
+            implementations forward to the methods above; operators
+            used in performance-critical schemes should override them.
+        */
+        //@{
+        virtual void apply_mixed(const Array& r, Array& out) const {
+            out = apply_mixed(r);
+        }
+        virtual void apply_direction(Size direction,
+                                     const Array& r, Array& out) const {
+            out = apply_direction(direction, r);
+        }
+        virtual void solve_splitting(Size direction, const Array& r,
+                                     Real s, Array& out) const {
+            out = solve_splitting(direction, r, s);
+        }
+        //@}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
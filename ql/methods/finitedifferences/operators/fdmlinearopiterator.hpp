@@ -49,10 +49,12 @@ namespace QuantLib {
           dim_(dim),
           coordinates_(coordinates) {}
 
+        #if defined(QL_USE_DISPOSABLE)
         FdmLinearOpIterator(
             const Disposable<FdmLinearOpIterator> & from) {
             swap(const_cast<Disposable<FdmLinearOpIterator> & >(from));
         }
+        #endif
 
         void operator++() {
             ++index_;
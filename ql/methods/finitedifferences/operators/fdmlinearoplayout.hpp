@@ -27,6 +27,7 @@
 #define quantlib_linear_op_layout_hpp
 
 #include <ql/methods/finitedifferences/operators/fdmlinearopiterator.hpp>
+#include <ql/errors.hpp>
 #include <functional>
 
 namespace QuantLib {
@@ -34,12 +35,23 @@ namespace QuantLib {
     class FdmLinearOpLayout {
       public:
         explicit FdmLinearOpLayout(const std::vector<Size>& dim)
-        : dim_(dim), spacing_(dim.size()) {
+        : dim_(dim), spacing_(dim.size()),
+          lowerOffsets_(dim.size()), upperOffsets_(dim.size()) {
             spacing_[0] = 1;
             std::partial_sum(dim.begin(), dim.end()-1,
                 spacing_.begin()+1, std::multiplies<Size>());
 
             size_ = spacing_.back()*dim.back();
+
+            // offsets of the next neighbours along each direction,
+            // reflected at the boundaries as in neighbourhood()
+            for (Size i=0; i < dim_.size(); ++i) {
+                const Integer s = Integer(spacing_[i]);
+                lowerOffsets_[i].resize(dim_[i], -s);
+                upperOffsets_[i].resize(dim_[i],  s);
+                lowerOffsets_[i].front() = s;
+                upperOffsets_[i].back() = -s;
+            }
         }
 
         FdmLinearOpIterator begin() const {
@@ -68,6 +80,52 @@ namespace QuantLib {
                                       spacing_.begin(), Size(0));
         }
 
+        //! coordinate of the point with the given index along direction i
+        Size coordinate(Size index, Size i) const {
+            return (index/spacing_[i]) % dim_[i];
+        }
+
+        /*! \name Lines along a direction
+            The points of the layout can be split into lines along a
+            given direction; the points of a line only differ by their
+            coordinate along the direction, and the point with
+            coordinate k on the line is found at index
+            lineStart(i, line) + k*spacing()[i].  Loops over lines
+            don't need iterators and can be parallelized.
+        */
+        //@{
+        Size lines(Size i) const {
+            return size_/dim_[i];
+        }
+
+        Size lineStart(Size i, Size line) const {
+            const Size s = spacing_[i];
+            return line%s + (line/s)*s*dim_[i];
+        }
+        //@}
+
+        /*! returns the offsets, indexed by the coordinate along
+            direction i, to be added to the index of a point to obtain
+            the index of its lower (offset = -1) or upper (offset = 1)
+            neighbour along the same direction.  The neighbours are
+            reflected at the boundaries as in neighbourhood().
+        */
+        const std::vector<Integer>& neighbourOffsets(Size i,
+                                                     Integer offset) const {
+            QL_REQUIRE(offset == 1 || offset == -1,
+                       "offset must be either 1 or -1");
+            return offset < 0 ? lowerOffsets_[i] : upperOffsets_[i];
+        }
+
+        //! iterator pointing to the point with the given index
+        Disposable<FdmLinearOpIterator> iteratorAt(Size index) const {
+            std::vector<Size> coordinates(dim_.size());
+            for (Size i=0; i < dim_.size(); ++i)
+                coordinates[i] = coordinate(index, i);
+            FdmLinearOpIterator retVal(dim_, coordinates, index);
+            return retVal;
+        }
+
         Size neighbourhood(const FdmLinearOpIterator& iterator,
                            Size i, Integer offset) const;
 
@@ -82,6 +140,7 @@ namespace QuantLib {
       private:
         Size size_;
         std::vector<Size> dim_, spacing_;
+        std::vector<std::vector<Integer> > lowerOffsets_, upperOffsets_;
     };
 }
 
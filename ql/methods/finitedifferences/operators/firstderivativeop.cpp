@@ -31,10 +31,13 @@ namespace QuantLib {
     : TripleBandLinearOp(direction, mesher) {
 
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
+        const Size n = layout->dim()[direction_];
+        const Size stride = layout->spacing()[direction_];
 
-        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.index();
+        // the weights only depend on the coordinate along the direction
+        std::vector<Real> lower(n), diag(n), upper(n);
+        for (Size k=0; k < n; ++k) {
+            const FdmLinearOpIterator iter = layout->iteratorAt(k*stride);
             const Real hm = mesher->dminus(iter, direction_);
             const Real hp = mesher->dplus(iter, direction_);
 
@@ -42,21 +45,30 @@ namespace QuantLib {
             const Real zeta0  = hm*hp;
             const Real zetap1 = hp*(hm+hp);
 
-            if (iter.coordinates()[direction_] == 0) {
+            if (k == 0) {
                 //upwinding scheme
-                lower_[i] = 0.0;
-                diag_[i]  = -(upper_[i] = 1/hp);
+                lower[k] = 0.0;
+                diag[k]  = -(upper[k] = 1/hp);
             }
-            else if (   iter.coordinates()[direction_]
-                     == layout->dim()[direction]-1) {
+            else if (k == n-1) {
                  // downwinding scheme
-                lower_[i] = -(diag_[i] = 1/hm);
-                upper_[i] = 0.0;
+                lower[k] = -(diag[k] = 1/hm);
+                upper[k] = 0.0;
             }
             else {
-                lower_[i] = -hp/zetam1;
-                diag_[i]  = (hp-hm)/zeta0;
-                upper_[i] = hm/zetap1;
+                lower[k] = -hp/zetam1;
+                diag[k]  = (hp-hm)/zeta0;
+                upper[k] = hm/zetap1;
+            }
+        }
+
+        const Size nLines = layout->lines(direction_);
+        for (Size l=0; l < nLines; ++l) {
+            Size i = layout->lineStart(direction_, l);
+            for (Size k=0; k < n; ++k, i+=stride) {
+                lower_[i] = lower[k];
+                diag_[i]  = diag[k];
+                upper_[i] = upper[k];
             }
         }
     }
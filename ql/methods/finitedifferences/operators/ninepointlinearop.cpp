@@ -29,23 +29,23 @@ namespace QuantLib {
         Size d0, Size d1,
         const boost::shared_ptr<FdmMesher>& mesher)
     : d0_(d0), d1_(d1),
-      i00_(new Size[mesher->layout()->size()]),
-      i10_(new Size[mesher->layout()->size()]),
-      i20_(new Size[mesher->layout()->size()]),
-      i01_(new Size[mesher->layout()->size()]),
-      i21_(new Size[mesher->layout()->size()]),
-      i02_(new Size[mesher->layout()->size()]),
-      i12_(new Size[mesher->layout()->size()]),
-      i22_(new Size[mesher->layout()->size()]),
-      a00_(new Real[mesher->layout()->size()]),
-      a10_(new Real[mesher->layout()->size()]),
-      a20_(new Real[mesher->layout()->size()]),
-      a01_(new Real[mesher->layout()->size()]),
-      a11_(new Real[mesher->layout()->size()]),
-      a21_(new Real[mesher->layout()->size()]),
-      a02_(new Real[mesher->layout()->size()]),
-      a12_(new Real[mesher->layout()->size()]),
-      a22_(new Real[mesher->layout()->size()]),
+      i00_(detail::pooledArray<Size>(mesher->layout()->size())),
+      i10_(detail::pooledArray<Size>(mesher->layout()->size())),
+      i20_(detail::pooledArray<Size>(mesher->layout()->size())),
+      i01_(detail::pooledArray<Size>(mesher->layout()->size())),
+      i21_(detail::pooledArray<Size>(mesher->layout()->size())),
+      i02_(detail::pooledArray<Size>(mesher->layout()->size())),
+      i12_(detail::pooledArray<Size>(mesher->layout()->size())),
+      i22_(detail::pooledArray<Size>(mesher->layout()->size())),
+      a00_(detail::pooledArray<Real>(mesher->layout()->size())),
+      a10_(detail::pooledArray<Real>(mesher->layout()->size())),
+      a20_(detail::pooledArray<Real>(mesher->layout()->size())),
+      a01_(detail::pooledArray<Real>(mesher->layout()->size())),
+      a11_(detail::pooledArray<Real>(mesher->layout()->size())),
+      a21_(detail::pooledArray<Real>(mesher->layout()->size())),
+      a02_(detail::pooledArray<Real>(mesher->layout()->size())),
+      a12_(detail::pooledArray<Real>(mesher->layout()->size())),
+      a22_(detail::pooledArray<Real>(mesher->layout()->size())),
       mesher_(mesher) {
 
         QL_REQUIRE(   d0_ != d1_
@@ -56,38 +56,47 @@ namespace QuantLib {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
         const FdmLinearOpIterator endIter = layout->end();
 
+        const std::vector<Integer>& lower0 = layout->neighbourOffsets(d0_,-1);
+        const std::vector<Integer>& upper0 = layout->neighbourOffsets(d0_, 1);
+        const std::vector<Integer>& lower1 = layout->neighbourOffsets(d1_,-1);
+        const std::vector<Integer>& upper1 = layout->neighbourOffsets(d1_, 1);
+
         for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
             const Size i = iter.index();
-
-            i10_[i] = layout->neighbourhood(iter, d1_, -1);
-            i01_[i] = layout->neighbourhood(iter, d0_, -1);
-            i21_[i] = layout->neighbourhood(iter, d0_,  1);
-            i12_[i] = layout->neighbourhood(iter, d1_,  1);
-            i00_[i] = layout->neighbourhood(iter, d0_, -1, d1_, -1);
-            i20_[i] = layout->neighbourhood(iter, d0_,  1, d1_, -1);
-            i02_[i] = layout->neighbourhood(iter, d0_, -1, d1_,  1);
-            i22_[i] = layout->neighbourhood(iter, d0_,  1, d1_,  1);
+            const Integer m0 = lower0[iter.coordinates()[d0_]];
+            const Integer p0 = upper0[iter.coordinates()[d0_]];
+            const Integer m1 = lower1[iter.coordinates()[d1_]];
+            const Integer p1 = upper1[iter.coordinates()[d1_]];
+
+            i10_[i] = i + m1;
+            i01_[i] = i + m0;
+            i21_[i] = i + p0;
+            i12_[i] = i + p1;
+            i00_[i] = i + m0 + m1;
+            i20_[i] = i + p0 + m1;
+            i02_[i] = i + m0 + p1;
+            i22_[i] = i + p0 + p1;
         }
     }
 
     NinePointLinearOp::NinePointLinearOp(const NinePointLinearOp& m)
-    : i00_(new Size[m.mesher_->layout()->size()]),
-      i10_(new Size[m.mesher_->layout()->size()]),
-      i20_(new Size[m.mesher_->layout()->size()]),
-      i01_(new Size[m.mesher_->layout()->size()]),
-      i21_(new Size[m.mesher_->layout()->size()]),
-      i02_(new Size[m.mesher_->layout()->size()]),
-      i12_(new Size[m.mesher_->layout()->size()]),
-      i22_(new Size[m.mesher_->layout()->size()]),
-      a00_(new Real[m.mesher_->layout()->size()]),
-      a10_(new Real[m.mesher_->layout()->size()]),
-      a20_(new Real[m.mesher_->layout()->size()]),
-      a01_(new Real[m.mesher_->layout()->size()]),
-      a11_(new Real[m.mesher_->layout()->size()]),
-      a21_(new Real[m.mesher_->layout()->size()]),
-      a02_(new Real[m.mesher_->layout()->size()]),
-      a12_(new Real[m.mesher_->layout()->size()]),
-      a22_(new Real[m.mesher_->layout()->size()]),
+    : i00_(detail::pooledArray<Size>(m.mesher_->layout()->size())),
+      i10_(detail::pooledArray<Size>(m.mesher_->layout()->size())),
+      i20_(detail::pooledArray<Size>(m.mesher_->layout()->size())),
+      i01_(detail::pooledArray<Size>(m.mesher_->layout()->size())),
+      i21_(detail::pooledArray<Size>(m.mesher_->layout()->size())),
+      i02_(detail::pooledArray<Size>(m.mesher_->layout()->size())),
+      i12_(detail::pooledArray<Size>(m.mesher_->layout()->size())),
+      i22_(detail::pooledArray<Size>(m.mesher_->layout()->size())),
+      a00_(detail::pooledArray<Real>(m.mesher_->layout()->size())),
+      a10_(detail::pooledArray<Real>(m.mesher_->layout()->size())),
+      a20_(detail::pooledArray<Real>(m.mesher_->layout()->size())),
+      a01_(detail::pooledArray<Real>(m.mesher_->layout()->size())),
+      a11_(detail::pooledArray<Real>(m.mesher_->layout()->size())),
+      a21_(detail::pooledArray<Real>(m.mesher_->layout()->size())),
+      a02_(detail::pooledArray<Real>(m.mesher_->layout()->size())),
+      a12_(detail::pooledArray<Real>(m.mesher_->layout()->size())),
+      a22_(detail::pooledArray<Real>(m.mesher_->layout()->size())),
       mesher_(m.mesher_) {
 
         const Size size = mesher_->layout()->size();
@@ -117,6 +126,7 @@ namespace QuantLib {
         return *this;
     }
 
+    #if defined(QL_USE_DISPOSABLE)
     NinePointLinearOp& NinePointLinearOp::operator=(
         const Disposable<NinePointLinearOp>& m) {
         swap(const_cast<Disposable<NinePointLinearOp>&>(m));
@@ -127,15 +137,33 @@ namespace QuantLib {
         const Disposable<NinePointLinearOp>& from) {
         swap(const_cast<Disposable<NinePointLinearOp>&>(from));
     }
+    #else
+    NinePointLinearOp& NinePointLinearOp::operator=(NinePointLinearOp&& m) {
+        swap(m);
+        return *this;
+    }
+
+    NinePointLinearOp::NinePointLinearOp(NinePointLinearOp&& from) {
+        swap(from);
+    }
+    #endif
 
     Disposable<Array> NinePointLinearOp::apply(const Array& u)
         const {
+        Array retVal(u.size());
+        apply(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply(const Array& u, Array& retVal) const {
 
         const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
+        QL_REQUIRE(retVal.size() == u.size(),
+                   "inconsistent length of result");
 
-        Array retVal(u.size());
+        const Size size = u.size();
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -144,8 +172,8 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
+        #pragma omp parallel for
+        for (Size i=0; i < size; ++i) {
             retVal[i] =   a00[i]*u[i00[i]]
                         + a01[i]*u[i01[i]]
                         + a02[i]*u[i02[i]]
@@ -156,7 +184,6 @@ namespace QuantLib {
                         + a21[i]*u[i21[i]]
                         + a22[i]*u[i22[i]];
         }
-        return retVal;
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
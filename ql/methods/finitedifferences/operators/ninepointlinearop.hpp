@@ -39,11 +39,19 @@ namespace QuantLib {
         NinePointLinearOp(Size d0, Size d1,
                 const boost::shared_ptr<FdmMesher>& mesher);
         NinePointLinearOp(const NinePointLinearOp& m);
-        NinePointLinearOp(const Disposable<NinePointLinearOp>& m);
         NinePointLinearOp& operator=(const NinePointLinearOp& m);
+        #if defined(QL_USE_DISPOSABLE)
+        NinePointLinearOp(const Disposable<NinePointLinearOp>& m);
         NinePointLinearOp& operator=(const Disposable<NinePointLinearOp>& m);
+        #else
+        NinePointLinearOp(NinePointLinearOp&& m);
+        NinePointLinearOp& operator=(NinePointLinearOp&& m);
+        #endif
 
         Disposable<Array> apply(const Array& r) const;
+        // in-place variant; out must have the size of r and be
+        // distinct from it
+        void apply(const Array& r, Array& out) const;
         Disposable<NinePointLinearOp> mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m);
@@ -56,6 +64,7 @@ namespace QuantLib {
         NinePointLinearOp() {}
 
         Size d0_, d1_;
+        // obtained from the MemoryPool, like the storage of arrays
         boost::shared_array<Size> i00_, i10_, i20_;
         boost::shared_array<Size> i01_, i21_;
         boost::shared_array<Size> i02_, i12_, i22_;
@@ -31,10 +31,13 @@ namespace QuantLib {
     : TripleBandLinearOp(direction, mesher) {
 
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
+        const Size n = layout->dim()[direction_];
+        const Size stride = layout->spacing()[direction_];
 
-        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.index();
+        // the weights only depend on the coordinate along the direction
+        std::vector<Real> lower(n, 0.0), diag(n, 0.0), upper(n, 0.0);
+        for (Size k=1; k < n-1; ++k) {
+            const FdmLinearOpIterator iter = layout->iteratorAt(k*stride);
             const Real hm = mesher->dminus(iter, direction_);
             const Real hp = mesher->dplus(iter, direction_);
 
@@ -42,14 +45,18 @@ namespace QuantLib {
             const Real zeta0  = hm*hp;
             const Real zetap1 = hp*(hm+hp);
 
-            const Size co = iter.coordinates()[direction_];
-            if (co == 0 || co == layout->dim()[direction]-1) {
-                lower_[i] = diag_[i] = upper_[i] = 0.0;
-            }
-            else {
-                lower_[i] =  2.0/zetam1;
-                diag_[i]  = -2.0/zeta0;
-                upper_[i] =  2.0/zetap1;
+            lower[k] =  2.0/zetam1;
+            diag[k]  = -2.0/zeta0;
+            upper[k] =  2.0/zetap1;
+        }
+
+        const Size nLines = layout->lines(direction_);
+        for (Size l=0; l < nLines; ++l) {
+            Size i = layout->lineStart(direction_, l);
+            for (Size k=0; k < n; ++k, i+=stride) {
+                lower_[i] = lower[k];
+                diag_[i]  = diag[k];
+                upper_[i] = upper[k];
             }
         }
     }
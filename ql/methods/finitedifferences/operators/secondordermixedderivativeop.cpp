@@ -31,12 +31,31 @@ namespace QuantLib {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
         const FdmLinearOpIterator endIter = layout->end();
 
+        // the grid spacings only depend on the coordinate along
+        // their direction
+        std::vector<Real> hm0(layout->dim()[d0_]), hp0(hm0.size());
+        for (Size k=0; k < hm0.size(); ++k) {
+            const FdmLinearOpIterator iter =
+                layout->iteratorAt(k*layout->spacing()[d0_]);
+            hm0[k] = mesher->dminus(iter, d0_);
+            hp0[k] = mesher->dplus(iter, d0_);
+        }
+        std::vector<Real> hm1(layout->dim()[d1_]), hp1(hm1.size());
+        for (Size k=0; k < hm1.size(); ++k) {
+            const FdmLinearOpIterator iter =
+                layout->iteratorAt(k*layout->spacing()[d1_]);
+            hm1[k] = mesher->dminus(iter, d1_);
+            hp1[k] = mesher->dplus(iter, d1_);
+        }
+
         for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
             const Size i = iter.index();
-            const Real hm_d0 = mesher->dminus(iter, d0_);
-            const Real hp_d0 = mesher->dplus(iter, d0_);
-            const Real hm_d1 = mesher->dminus(iter, d1_);
-            const Real hp_d1 = mesher->dplus(iter, d1_);
+            const Size c0 = iter.coordinates()[d0_];
+            const Size c1 = iter.coordinates()[d1_];
+            const Real hm_d0 = hm0[c0];
+            const Real hp_d0 = hp0[c0];
+            const Real hm_d1 = hm1[c1];
+            const Real hp_d1 = hp1[c1];
 
             const Real zetam1 = hm_d0*(hm_d0+hp_d0);
             const Real zeta0  = hm_d0*hp_d0;
@@ -45,8 +64,6 @@ namespace QuantLib {
             const Real phi0   = hm_d1*hp_d1;
             const Real phip1  = hp_d1*(hm_d1+hp_d1);
 
-            const Size c0 = iter.coordinates()[d0_];
-            const Size c1 = iter.coordinates()[d1_];
             if (c0 == 0 && c1 == 0) {
                 // lower left corner
                 a00_[i] = a01_[i] = a02_[i] = a10_[i] = a20_[i] = 0.0;
@@ -31,45 +31,45 @@ namespace QuantLib {
         Size direction,
         const boost::shared_ptr<FdmMesher>& mesher)
     : direction_(direction),
-      i0_       (new Size[mesher->layout()->size()]),
-      i2_       (new Size[mesher->layout()->size()]),
-      reverseIndex_ (new Size[mesher->layout()->size()]),
-      lower_    (new Real[mesher->layout()->size()]),
-      diag_     (new Real[mesher->layout()->size()]),
-      upper_    (new Real[mesher->layout()->size()]),
-      mesher_(mesher) {
+      i0_       (detail::pooledArray<Size>(mesher->layout()->size())),
+      i2_       (detail::pooledArray<Size>(mesher->layout()->size())),
+      reverseIndex_ (detail::pooledArray<Size>(mesher->layout()->size())),
+      lower_    (detail::pooledArray<Real>(mesher->layout()->size())),
+      diag_     (detail::pooledArray<Real>(mesher->layout()->size())),
+      upper_    (detail::pooledArray<Real>(mesher->layout()->size())),
+      mesher_(mesher),
+      factorA_(Null<Real>()), factorB_(Null<Real>()) {
 
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
 
-        std::vector<Size> newDim(layout->dim());
-        std::iter_swap(newDim.begin(), newDim.begin()+direction_);
-        std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
-        std::iter_swap(newSpacing.begin(), newSpacing.begin()+direction_);
-
-        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.index();
-
-            i0_[i] = layout->neighbourhood(iter, direction, -1);
-            i2_[i] = layout->neighbourhood(iter, direction,  1);
-
-            const std::vector<Size>& coordinates = iter.coordinates();
-            const Size newIndex =
-                  std::inner_product(coordinates.begin(), coordinates.end(),
-                                     newSpacing.begin(), Size(0));
-            reverseIndex_[newIndex] = i;
+        // the reverse index enumerates the mesh line by line along
+        // the given direction (see solve_splitting)
+        const Size lineLength = layout->dim()[direction_];
+        const Size stride = layout->spacing()[direction_];
+        const Size nLines = layout->lines(direction_);
+        const Integer* lower = &layout->neighbourOffsets(direction_, -1)[0];
+        const Integer* upper = &layout->neighbourOffsets(direction_,  1)[0];
+
+        for (Size l=0, j=0; l < nLines; ++l) {
+            Size i = layout->lineStart(direction_, l);
+            for (Size k=0; k < lineLength; ++k, ++j, i+=stride) {
+                i0_[i] = i + lower[k];
+                i2_[i] = i + upper[k];
+                reverseIndex_[j] = i;
+            }
         }
     }
 
     TripleBandLinearOp::TripleBandLinearOp(const TripleBandLinearOp& m)
     : direction_(m.direction_),
-      i0_   (new Size[m.mesher_->layout()->size()]),
-      i2_   (new Size[m.mesher_->layout()->size()]),
-      reverseIndex_(new Size[m.mesher_->layout()->size()]),
-      lower_(new Real[m.mesher_->layout()->size()]),
-      diag_ (new Real[m.mesher_->layout()->size()]),
-      upper_(new Real[m.mesher_->layout()->size()]),
-      mesher_(m.mesher_) {
+      i0_   (detail::pooledArray<Size>(m.mesher_->layout()->size())),
+      i2_   (detail::pooledArray<Size>(m.mesher_->layout()->size())),
+      reverseIndex_(detail::pooledArray<Size>(m.mesher_->layout()->size())),
+      lower_(detail::pooledArray<Real>(m.mesher_->layout()->size())),
+      diag_ (detail::pooledArray<Real>(m.mesher_->layout()->size())),
+      upper_(detail::pooledArray<Real>(m.mesher_->layout()->size())),
+      mesher_(m.mesher_),
+      factorA_(Null<Real>()), factorB_(Null<Real>()) {
         const Size len = m.mesher_->layout()->size();
         std::copy(m.i0_.get(), m.i0_.get() + len, i0_.get());
         std::copy(m.i2_.get(), m.i2_.get() + len, i2_.get());
@@ -81,10 +81,8 @@ namespace QuantLib {
     }
 
 
-    TripleBandLinearOp::TripleBandLinearOp(
-        const Disposable<TripleBandLinearOp>& from) {
-        swap(const_cast<Disposable<TripleBandLinearOp>&>(from));
-    }
+    TripleBandLinearOp::TripleBandLinearOp()
+    : factorA_(Null<Real>()), factorB_(Null<Real>()) {}
 
     TripleBandLinearOp& TripleBandLinearOp::operator=(
         const TripleBandLinearOp& m) {
@@ -93,11 +91,30 @@ namespace QuantLib {
         return *this;
     }
 
+    #if defined(QL_USE_DISPOSABLE)
+    TripleBandLinearOp::TripleBandLinearOp(
+        const Disposable<TripleBandLinearOp>& from)
+    : factorA_(Null<Real>()), factorB_(Null<Real>()) {
+        swap(const_cast<Disposable<TripleBandLinearOp>&>(from));
+    }
+
     TripleBandLinearOp& TripleBandLinearOp::operator=(
         const Disposable<TripleBandLinearOp>& m) {
         swap(const_cast<Disposable<TripleBandLinearOp>&>(m));
         return *this;
     }
+    #else
+    TripleBandLinearOp::TripleBandLinearOp(TripleBandLinearOp&& from)
+    : factorA_(Null<Real>()), factorB_(Null<Real>()) {
+        swap(from);
+    }
+
+    TripleBandLinearOp& TripleBandLinearOp::operator=(
+        TripleBandLinearOp&& m) {
+        swap(m);
+        return *this;
+    }
+    #endif
 
     void TripleBandLinearOp::swap(TripleBandLinearOp& m) {
         std::swap(mesher_, m.mesher_);
@@ -106,12 +123,21 @@ namespace QuantLib {
         i0_.swap(m.i0_); i2_.swap(m.i2_);
         reverseIndex_.swap(m.reverseIndex_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
+        tmp_.swap(m.tmp_);
+        inversePivots_.swap(m.inversePivots_);
+        std::swap(factorA_, m.factorA_);
+        std::swap(factorB_, m.factorB_);
+    }
+
+    void TripleBandLinearOp::invalidateFactorization() {
+        factorA_ = factorB_ = Null<Real>();
     }
 
     void TripleBandLinearOp::axpyb(const Array& a,
                                    const TripleBandLinearOp& x,
                                    const TripleBandLinearOp& y,
                                    const Array& b) {
+        invalidateFactorization();
         const Size size = mesher_->layout()->size();
 
         Real *diag(diag_.get());
@@ -246,9 +272,17 @@ namespace QuantLib {
     }
 
     Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
+        array_type retVal(r.size());
+        apply(r, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply(const Array& r, Array& retVal) const {
         const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
         QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        QL_REQUIRE(retVal.size() == r.size(),
+                   "inconsistent length of result");
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
@@ -256,13 +290,11 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
-        array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
+        const Size size = index->size();
+        #pragma omp parallel for
+        for (Size i=0; i < size; ++i) {
             retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
         }
-
-        return retVal;
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -284,8 +316,17 @@ namespace QuantLib {
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        Array retVal(r.size());
+        solve_splitting(r, a, b, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b,
+                                             Array& retVal) const {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
+        QL_REQUIRE(retVal.size() == r.size(),
+                   "inconsistent size of result");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
         for (FdmLinearOpIterator iter = layout->begin();
@@ -298,36 +339,158 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
+        if (a != factorA_ || b != factorB_)
+            factorize(a, b);
+
+        const Real* lptr = lower_.get();
+        const Real* tptr = tmp_.begin();
+        const Real* pptr = inversePivots_.begin();
+        const Size* rptr = reverseIndex_.get();
+
+        const Size lineLength = layout->dim()[direction_];
+        const Size nLines = layout->size()/lineLength;
 
+        #pragma omp parallel for
+        for (Size l=0; l < nLines; ++l) {
+            const Size j0 = l*lineLength, j1 = j0 + lineLength;
+
+            Size rim1 = rptr[j0];
+            retVal[rim1] = r[rim1]*pptr[j0];
+            for (Size j=j0+1; j < j1; ++j) {
+                const Size ri = rptr[j];
+                retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*pptr[j];
+                rim1 = ri;
+            }
+            // cannot be j>=0 with Size j
+            for (Size j=j1-1; j > j0; --j)
+                retVal[rptr[j-1]] -= tptr[j]*retVal[rptr[j]];
+        }
+    }
+
+    void TripleBandLinearOp::apply(const Matrix& r, Matrix& out) const {
+        const Size size = mesher_->layout()->size();
+        QL_REQUIRE(r.rows() == size, "inconsistent length of r");
+        QL_REQUIRE(out.rows() == size && out.columns() == r.columns(),
+                   "inconsistent size of result");
+
+        const Size m = r.columns();
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
+        const Size* i0ptr = i0_.get();
+        const Size* i2ptr = i2_.get();
+
+        #pragma omp parallel for
+        for (Size i=0; i < size; ++i) {
+            const Real* r0 = r.row_begin(i0ptr[i]);
+            const Real* r1 = r.row_begin(i);
+            const Real* r2 = r.row_begin(i2ptr[i]);
+            Real* o = out.row_begin(i);
+            const Real l = lptr[i], d = dptr[i], u = uptr[i];
+            for (Size k=0; k < m; ++k)
+                o[k] = r0[k]*l + r1[k]*d + r2[k]*u;
+        }
+    }
+
+    void TripleBandLinearOp::solve_splitting(const Matrix& r, Real a, Real b,
+                                             Matrix& out) const {
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        QL_REQUIRE(r.rows() == layout->size(), "inconsistent size of rhs");
+        QL_REQUIRE(out.rows() == r.rows() && out.columns() == r.columns(),
+                   "inconsistent size of result");
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        if (a != factorA_ || b != factorB_)
+            factorize(a, b);
 
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+        const Size m = r.columns();
+        const Real* lptr = lower_.get();
+        const Real* tptr = tmp_.begin();
+        const Real* pptr = inversePivots_.begin();
+        const Size* rptr = reverseIndex_.get();
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+        const Size lineLength = layout->dim()[direction_];
+        const Size nLines = layout->size()/lineLength;
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+        #pragma omp parallel for
+        for (Size l=0; l < nLines; ++l) {
+            const Size j0 = l*lineLength, j1 = j0 + lineLength;
+
+            Size rim1 = rptr[j0];
+            {
+                const Real* ri = r.row_begin(rim1);
+                Real* oi = out.row_begin(rim1);
+                for (Size k=0; k < m; ++k)
+                    oi[k] = ri[k]*pptr[j0];
+            }
+            for (Size j=j0+1; j < j1; ++j) {
+                const Size ri = rptr[j];
+                const Real* rr = r.row_begin(ri);
+                const Real* om1 = out.row_begin(rim1);
+                Real* oi = out.row_begin(ri);
+                const Real al = a*lptr[ri], p = pptr[j];
+                for (Size k=0; k < m; ++k)
+                    oi[k] = (rr[k]-al*om1[k])*p;
+                rim1 = ri;
+            }
+            for (Size j=j1-1; j > j0; --j) {
+                const Real* op1 = out.row_begin(rptr[j]);
+                Real* oi = out.row_begin(rptr[j-1]);
+                const Real t = tptr[j];
+                for (Size k=0; k < m; ++k)
+                    oi[k] -= t*op1[k];
+            }
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+    }
 
-        return retVal;
+    void TripleBandLinearOp::factorize(Real a, Real b) const {
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size size = layout->size();
+        if (tmp_.size() != size) {
+            tmp_ = Array(size);
+            inversePivots_ = Array(size);
+        }
+        Real* tmp = tmp_.begin();
+        Real* pivots = inversePivots_.begin();
+
+        const Real* lptr = lower_.get();
+        const Real* dptr = diag_.get();
+        const Real* uptr = upper_.get();
+        const Size* rptr = reverseIndex_.get();
+
+        // The reverse index enumerates the mesh line by line along
+        // the given direction. Since the operator doesn't couple
+        // different lines, each of them is an independent tridiagonal
+        // system and they can be factorized concurrently.
+        const Size lineLength = layout->dim()[direction_];
+        const Size nLines = size/lineLength;
+
+        bool zeroPivot = false;
+
+        #pragma omp parallel for reduction(||:zeroPivot)
+        for (Size l=0; l < nLines; ++l) {
+            const Size j0 = l*lineLength, j1 = j0 + lineLength;
+
+            // forward elimination of the Thomson algorithm. Example
+            // code taken from Tridiagonalopertor and changed to fit
+            // for the triple band operator.
+            Size rim1 = rptr[j0];
+            Real bet = a*dptr[rim1]+b;
+            zeroPivot = zeroPivot || (bet == 0.0);
+            pivots[j0] = bet = 1.0/bet;
+
+            for (Size j=j0+1; j < j1; ++j) {
+                const Size ri = rptr[j];
+                tmp[j] = a*uptr[rim1]*bet;
+
+                bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
+                zeroPivot = zeroPivot || (bet == 0.0);
+                pivots[j] = bet = 1.0/bet;
+                rim1 = ri;
+            }
+        }
+        QL_ENSURE(!zeroPivot, "division by zero");
+
+        factorA_ = a;
+        factorB_ = b;
     }
 }
@@ -31,13 +31,16 @@ namespace QuantLib {
         theta_(theta),
         mu_   (mu),
         map_  (map),
-        bcSet_(bcSet) {
+        bcSet_(bcSet), timeSet_(false) {
     }
 
     void CraigSneydScheme::step(array_type& a, Time t) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
 
-        map_->setTime(std::max(0.0, t-dt_), t);
+        if (!timeSet_ || map_->isTimeDependent()) {
+            map_->setTime(std::max(0.0, t-dt_), t);
+            timeSet_ = true;
+        }
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
@@ -55,6 +55,7 @@ namespace QuantLib {
         const Real mu_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        bool timeSet_;
     };
 }
 
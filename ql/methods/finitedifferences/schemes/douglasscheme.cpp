@@ -29,25 +29,43 @@ namespace QuantLib {
     : dt_(Null<Real>()),
       theta_(theta),
       map_(map),
-      bcSet_(bcSet) {
+      bcSet_(bcSet), timeSet_(false) {
     }
 
     void DouglasScheme::step(array_type& a, Time t) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
-        map_->setTime(std::max(0.0, t-dt_), t);
+        if (!timeSet_ || map_->isTimeDependent()) {
+            map_->setTime(std::max(0.0, t-dt_), t);
+            timeSet_ = true;
+        }
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        initializeBuffers(a.size());
+        const Size n = a.size();
+
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply(a, tmp_);
+        for (Size j=0; j < n; ++j)
+            y_[j] = a[j] + dt_*tmp_[j];
+        bcSet_.applyAfterApplying(y_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction(i, a, tmp_);
+            for (Size j=0; j < n; ++j)
+                rhs_[j] = y_[j] - theta_*dt_*tmp_[j];
+            map_->solve_splitting(i, rhs_, -theta_*dt_, y_);
         }
-        bcSet_.applyAfterSolving(y);
+        bcSet_.applyAfterSolving(y_);
 
-        a = y;
+        std::copy(y_.begin(), y_.end(), a.begin());
+    }
+
+    void DouglasScheme::initializeBuffers(Size size) {
+        if (y_.size() != size) {
+            y_ = Array(size);
+            rhs_ = Array(size);
+            tmp_ = Array(size);
+        }
     }
 
     void DouglasScheme::setStep(Time dt) {
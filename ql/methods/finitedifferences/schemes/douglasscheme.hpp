@@ -54,6 +54,12 @@ namespace QuantLib {
         const Real theta_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        bool timeSet_;
+
+      private:
+        void initializeBuffers(Size size);
+        // preallocated scratch space reused across steps
+        Array y_, rhs_, tmp_;
     };
 }
 
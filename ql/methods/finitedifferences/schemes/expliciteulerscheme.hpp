@@ -53,6 +53,7 @@ namespace QuantLib {
         Time dt_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        bool timeSet_;
     };
 }
 
@@ -31,37 +31,63 @@ namespace QuantLib {
       theta_(theta),
       mu_   (mu),
       map_  (map),
-      bcSet_(bcSet) {
+      bcSet_(bcSet), timeSet_(false) {
     }
 
     void HundsdorferScheme::step(array_type& a, Time t) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
 
-        map_->setTime(std::max(0.0, t-dt_), t);
+        if (!timeSet_ || map_->isTimeDependent()) {
+            map_->setTime(std::max(0.0, t-dt_), t);
+            timeSet_ = true;
+        }
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        initializeBuffers(a.size());
+        const Size n = a.size();
+
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply(a, tmp_);
+        for (Size j=0; j < n; ++j)
+            y_[j] = a[j] + dt_*tmp_[j];
+        bcSet_.applyAfterApplying(y_);
 
-        Array y0 = y;
+        std::copy(y_.begin(), y_.end(), y0_.begin());
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction(i, a, tmp_);
+            for (Size j=0; j < n; ++j)
+                rhs_[j] = y_[j] - theta_*dt_*tmp_[j];
+            map_->solve_splitting(i, rhs_, -theta_*dt_, y_);
         }
 
         bcSet_.applyBeforeApplying(*map_);
-        Array yt = y0 + mu_*dt_*map_->apply(y-a);
-        bcSet_.applyAfterApplying(yt);
+        for (Size j=0; j < n; ++j)
+            rhs_[j] = y_[j] - a[j];
+        map_->apply(rhs_, tmp_);
+        for (Size j=0; j < n; ++j)
+            yt_[j] = y0_[j] + mu_*dt_*tmp_[j];
+        bcSet_.applyAfterApplying(yt_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = yt - theta_*dt_*map_->apply_direction(i, y);
-            yt = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction(i, y_, tmp_);
+            for (Size j=0; j < n; ++j)
+                rhs_[j] = yt_[j] - theta_*dt_*tmp_[j];
+            map_->solve_splitting(i, rhs_, -theta_*dt_, yt_);
         }
-        bcSet_.applyAfterSolving(yt);
+        bcSet_.applyAfterSolving(yt_);
 
-        a = yt;
+        std::copy(yt_.begin(), yt_.end(), a.begin());
+    }
+
+    void HundsdorferScheme::initializeBuffers(Size size) {
+        if (y_.size() != size) {
+            y_ = Array(size);
+            y0_ = Array(size);
+            yt_ = Array(size);
+            rhs_ = Array(size);
+            tmp_ = Array(size);
+        }
     }
 
     void HundsdorferScheme::setStep(Time dt) {
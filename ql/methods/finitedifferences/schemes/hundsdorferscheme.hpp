@@ -59,6 +59,12 @@ namespace QuantLib {
 
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        bool timeSet_;
+
+      private:
+        void initializeBuffers(Size size);
+        // preallocated scratch space reused across steps
+        Array y_, y0_, yt_, rhs_, tmp_;
     };
 }
 
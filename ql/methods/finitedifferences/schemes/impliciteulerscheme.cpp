@@ -22,6 +22,8 @@
 #include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmmultigridsolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmmultisnapshotcondition.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -39,13 +41,19 @@ namespace QuantLib {
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const bc_set& bcSet,
         Real relTol,
-        SolverType solverType)
+        SolverType solverType,
+        const boost::shared_ptr<FdmLinearOpLayout>& layout)
     : dt_        (Null<Real>()),
       iterations_(boost::make_shared<Size>(0u)),
       relTol_    (relTol),
       map_       (map),
       bcSet_     (bcSet),
-      solverType_(solverType){
+      solverType_(solverType),
+      timeSet_   (false),
+      layout_    (layout),
+      multigridDt_(Null<Real>()) {
+        QL_REQUIRE(solverType_ != Multigrid || layout_,
+                   "the multigrid solver needs the layout of the mesh");
     }
 
     Disposable<Array> ImplicitEulerScheme::apply(const Array& r) const {
@@ -54,11 +62,22 @@ namespace QuantLib {
 
     void ImplicitEulerScheme::step(array_type& a, Time t) {
         QL_REQUIRE(t-dt_ > -1e-8, "a step towards negative time given");
-        map_->setTime(std::max(0.0, t-dt_), t);
+        if (!timeSet_ || map_->isTimeDependent()) {
+            map_->setTime(std::max(0.0, t-dt_), t);
+            timeSet_ = true;
+        }
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeSolving(*map_, a);
 
+        Array guess;
+        if (warmStart_) {
+            const Size i = warmStart_->index(std::max(0.0, t-dt_));
+            if (i != Null<Size>() && warmStart_->hasValues(i))
+                guess = warmStart_->values(i);
+        }
+        const Array& x0 = (guess.size() == a.size()) ? guess : a;
+
         if (solverType_ == BiCGstab) {
             const BiCGStabResult result =
                 QuantLib::BiCGstab(
@@ -68,7 +87,7 @@ namespace QuantLib {
                     boost::function<Disposable<Array>(const Array&)>(
                         boost::bind(&FdmLinearOpComposite::preconditioner,
                                     map_, _1, -dt_))
-                ).solve(a, a);
+                ).solve(a, x0);
 
             (*iterations_) += result.iterations;
             a = result.x;
@@ -82,11 +101,30 @@ namespace QuantLib {
                     boost::function<Disposable<Array>(const Array&)>(
                         boost::bind(&FdmLinearOpComposite::preconditioner,
                                     map_, _1, -dt_))
-                ).solve(a, a);
+                ).solve(a, x0);
 
             (*iterations_) += result.errors.size();
             a = result.x;
         }
+        else if (solverType_ == Multigrid) {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+            if (!multigrid_ || dt_ != multigridDt_
+                || map_->isTimeDependent()) {
+                SparseMatrix m = -dt_*map_->toMatrix();
+                for (Size i=0; i < m.size1(); ++i)
+                    m(i, i) += 1.0;
+                multigrid_ = boost::make_shared<FdmMultigridSolver>(
+                    m, layout_, std::max(Size(10), a.size()/10u), relTol_);
+                multigridDt_ = dt_;
+            }
+            const FdmMultigridResult result = multigrid_->solve(a, x0);
+
+            (*iterations_) += result.iterations;
+            a = result.x;
+#else
+            QL_FAIL("the multigrid solver requires ublas support");
+#endif
+        }
         else
             QL_FAIL("unknown/illegal solver type");
         
@@ -97,6 +135,11 @@ namespace QuantLib {
         dt_=dt;
     }
 
+    void ImplicitEulerScheme::setWarmStart(
+              const boost::shared_ptr<FdmMultiSnapshotCondition>& snapshots) {
+        warmStart_ = snapshots;
+    }
+
     Size ImplicitEulerScheme::numberOfIterations() const {
         return *iterations_;    }
 }
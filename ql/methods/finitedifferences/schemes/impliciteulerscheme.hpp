@@ -32,9 +32,18 @@
 
 namespace QuantLib {
 
+    class FdmLinearOpLayout;
+    class FdmMultigridSolver;
+    class FdmMultiSnapshotCondition;
+
     class ImplicitEulerScheme {
       public:
-        enum SolverType { BiCGstab, GMRES };
+        /*! Multigrid needs the layout of the mesh and the matrix
+            representation of the operator; the multigrid hierarchy
+            is kept across steps if the operator is not time
+            dependent.
+        */
+        enum SolverType { BiCGstab, GMRES, Multigrid };
 
         // typedefs
         typedef OperatorTraits<FdmLinearOp> traits;
@@ -48,11 +57,21 @@ namespace QuantLib {
             const boost::shared_ptr<FdmLinearOpComposite>& map,
             const bc_set& bcSet = bc_set(),
             Real relTol = 1e-8,
-            SolverType solverType = BiCGstab);
+            SolverType solverType = BiCGstab,
+            const boost::shared_ptr<FdmLinearOpLayout>& layout
+                = boost::shared_ptr<FdmLinearOpLayout>());
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
 
+        /*! The values stored by the given snapshots, e.g., by a
+            previous rollback with slightly different inputs, are
+            used as starting points of the iterative solvers when
+            they are available for the end of a step.
+        */
+        void setWarmStart(
+            const boost::shared_ptr<FdmMultiSnapshotCondition>& snapshots);
+
         Size numberOfIterations() const;
       protected:
         Disposable<Array> apply(const Array& r) const;   
@@ -64,6 +83,11 @@ namespace QuantLib {
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
         const SolverType solverType_;
+        bool timeSet_;
+        const boost::shared_ptr<FdmLinearOpLayout> layout_;
+        boost::shared_ptr<FdmMultigridSolver> multigrid_;
+        Time multigridDt_;
+        boost::shared_ptr<FdmMultiSnapshotCondition> warmStart_;
     };
 }
 
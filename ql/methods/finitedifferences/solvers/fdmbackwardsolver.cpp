@@ -34,7 +34,76 @@
 #include <boost/make_shared.hpp>
 
 namespace QuantLib {
-    
+
+    namespace {
+
+        template <class Evolver>
+        Size adaptiveRollback(Evolver& evolver,
+                              const FdmStepConditionComposite& condition,
+                              Array& a, Time from, Time to,
+                              Real tolerance, Time dt, Size order) {
+
+            const std::vector<Time>& stoppingTimes = condition.stoppingTimes();
+            const Real minDt = (from-to)*std::sqrt(QL_EPSILON);
+            // error of the two half steps by Richardson extrapolation
+            const Real errorScale = 1.0/((1 << order) - 1);
+            const Real exponent = 1.0/(order+1);
+
+            Size steps = 0;
+            Time t = from;
+            Array full, half;
+            while (t - to > minDt) {
+                Time next = to;
+                for (Size i=0; i < stoppingTimes.size(); ++i) {
+                    if (stoppingTimes[i] < t - minDt && stoppingTimes[i] > next)
+                        next = stoppingTimes[i];
+                }
+                // avoid leaving a tiny step before the stopping time
+                const Time h = (t - dt < next + 0.1*dt) ? t - next : dt;
+
+                full = a;
+                evolver.setStep(h);
+                evolver.step(full, t);
+
+                half = a;
+                evolver.setStep(0.5*h);
+                evolver.step(half, t);
+                condition.applyTo(half, t - 0.5*h);
+                evolver.step(half, t - 0.5*h);
+
+                Real maxError = 0.0, maxValue = 1.0;
+                for (Size i=0; i < a.size(); ++i) {
+                    maxError = std::max(maxError,
+                                        std::fabs(half[i] - full[i]));
+                    maxValue = std::max(maxValue, std::fabs(half[i]));
+                }
+                const Real error =
+                    errorScale*maxError/(tolerance*maxValue);
+
+                const Real factor = (error > 0.0)
+                    ? std::min(2.0, std::max(0.2,
+                                             0.9*std::pow(error, -exponent)))
+                    : 2.0;
+
+                if (error <= 1.0) {
+                    a.swap(half);
+                    t = (h == t - next) ? next : t - h;
+                    condition.applyTo(a, t);
+                    ++steps;
+                    // a step shortened to hit a stopping time gives
+                    // no reason to reduce the step size
+                    dt = (h < dt) ? std::max(dt, h*factor) : h*factor;
+                } else {
+                    dt = h*factor;
+                }
+                QL_REQUIRE(dt > minDt,
+                           "time step (" << dt << ") too small at t = " << t);
+            }
+            return steps;
+        }
+
+    }
+
     FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
     : type(aType), theta(aTheta), mu(aMu) { }
 
@@ -73,13 +142,15 @@ namespace QuantLib {
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const FdmBoundaryConditionSet& bcSet,
         const boost::shared_ptr<FdmStepConditionComposite> condition,
-        const FdmSchemeDesc& schemeDesc)
+        const FdmSchemeDesc& schemeDesc,
+        const boost::shared_ptr<FdmMultiSnapshotCondition>& warmStart)
     : map_(map), bcSet_(bcSet),
       condition_((condition) ? condition 
                              : boost::make_shared<FdmStepConditionComposite>(
                                      std::list<std::vector<Time> >(),
                                      FdmStepConditionComposite::Conditions())),
-      schemeDesc_(schemeDesc) {
+      schemeDesc_(schemeDesc),
+      warmStart_(warmStart) {
      }
         
     void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs, 
@@ -92,7 +163,8 @@ namespace QuantLib {
                     
         if (   dampingSteps 
             && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
-            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
+            ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+            implicitEvolver.setWarmStart(warmStart_);
             FiniteDifferenceModel<ImplicitEulerScheme> 
                     dampingModel(implicitEvolver, condition_->stoppingTimes());
             dampingModel.rollback(rhs, from, dampingTo, 
@@ -139,6 +211,7 @@ namespace QuantLib {
           case FdmSchemeDesc::ImplicitEulerType:
             {
                 ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+                implicitEvolver.setWarmStart(warmStart_);
                 FiniteDifferenceModel<ImplicitEulerScheme> 
                    implicitModel(implicitEvolver, condition_->stoppingTimes());
                 implicitModel.rollback(rhs, from, to, allSteps, *condition_);
@@ -156,4 +229,95 @@ namespace QuantLib {
             QL_FAIL("Unknown scheme type");
         }
     }
+
+    Size FdmBackwardSolver::rollbackAdaptive(
+                                FdmBackwardSolver::array_type& rhs,
+                                Time from, Time to, Real tolerance,
+                                Size initialSteps, Size dampingSteps) {
+        QL_REQUIRE(from >= to,
+                   "trying to roll back from " << from << " to " << to);
+        QL_REQUIRE(tolerance > 0.0, "positive tolerance required");
+        QL_REQUIRE(initialSteps > 0, "at least one initial step required");
+
+        const Time dt = (from - to)/initialSteps;
+        const std::vector<Time>& stoppingTimes = condition_->stoppingTimes();
+
+        Size steps = 0;
+        Time dampingTo = from;
+        if (dampingSteps
+            && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
+            dampingTo = std::max(to, from - dt*dampingSteps);
+            ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+            implicitEvolver.setWarmStart(warmStart_);
+            FiniteDifferenceModel<ImplicitEulerScheme>
+                    dampingModel(implicitEvolver, stoppingTimes);
+            dampingModel.rollback(rhs, from, dampingTo,
+                                  dampingSteps, *condition_);
+            steps = dampingSteps;
+        }
+        else if (!stoppingTimes.empty() && stoppingTimes.back() == from) {
+            condition_->applyTo(rhs, from);
+        }
+
+        // second-order schemes except for explicit and implicit Euler
+        // or theta schemes with theta != 1/2
+        const Size order =
+            (   schemeDesc_.type == FdmSchemeDesc::ImplicitEulerType
+             || schemeDesc_.type == FdmSchemeDesc::ExplicitEulerType
+             || (schemeDesc_.type == FdmSchemeDesc::DouglasType
+                 && schemeDesc_.theta != 0.5)) ? 1 : 2;
+
+        switch (schemeDesc_.type) {
+          case FdmSchemeDesc::HundsdorferType:
+            {
+                HundsdorferScheme evolver(schemeDesc_.theta, schemeDesc_.mu,
+                                          map_, bcSet_);
+                steps += adaptiveRollback(evolver, *condition_, rhs,
+                                          dampingTo, to, tolerance, dt, order);
+            }
+            break;
+          case FdmSchemeDesc::DouglasType:
+            {
+                DouglasScheme evolver(schemeDesc_.theta, map_, bcSet_);
+                steps += adaptiveRollback(evolver, *condition_, rhs,
+                                          dampingTo, to, tolerance, dt, order);
+            }
+            break;
+          case FdmSchemeDesc::CraigSneydType:
+            {
+                CraigSneydScheme evolver(schemeDesc_.theta, schemeDesc_.mu,
+                                         map_, bcSet_);
+                steps += adaptiveRollback(evolver, *condition_, rhs,
+                                          dampingTo, to, tolerance, dt, order);
+            }
+            break;
+          case FdmSchemeDesc::ModifiedCraigSneydType:
+            {
+                ModifiedCraigSneydScheme evolver(schemeDesc_.theta,
+                                                 schemeDesc_.mu,
+                                                 map_, bcSet_);
+                steps += adaptiveRollback(evolver, *condition_, rhs,
+                                          dampingTo, to, tolerance, dt, order);
+            }
+            break;
+          case FdmSchemeDesc::ImplicitEulerType:
+            {
+                ImplicitEulerScheme evolver(map_, bcSet_);
+                evolver.setWarmStart(warmStart_);
+                steps += adaptiveRollback(evolver, *condition_, rhs,
+                                          dampingTo, to, tolerance, dt, order);
+            }
+            break;
+          case FdmSchemeDesc::ExplicitEulerType:
+            {
+                ExplicitEulerScheme evolver(map_, bcSet_);
+                steps += adaptiveRollback(evolver, *condition_, rhs,
+                                          dampingTo, to, tolerance, dt, order);
+            }
+            break;
+          default:
+            QL_FAIL("Unknown scheme type");
+        }
+        return steps;
+    }
 }
@@ -31,6 +31,7 @@ namespace QuantLib {
 
     class FdmLinearOpComposite;
     class FdmStepConditionComposite;
+    class FdmMultiSnapshotCondition;
 
     struct FdmSchemeDesc {
         enum FdmSchemeType { HundsdorferType, DouglasType, 
@@ -56,21 +57,44 @@ namespace QuantLib {
       public:
         typedef FdmLinearOp::array_type array_type;
         
+        /*! If given, the warm-start snapshots are passed to the
+            implicit Euler steps, see ImplicitEulerScheme::setWarmStart.
+        */
         FdmBackwardSolver(
           const boost::shared_ptr<FdmLinearOpComposite>& map,
           const FdmBoundaryConditionSet& bcSet,
           const boost::shared_ptr<FdmStepConditionComposite> condition,
-          const FdmSchemeDesc& schemeDesc);
+          const FdmSchemeDesc& schemeDesc,
+          const boost::shared_ptr<FdmMultiSnapshotCondition>& warmStart
+              = boost::shared_ptr<FdmMultiSnapshotCondition>());
 
         void rollback(array_type& a, 
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        /*! Rolls back with a variable time step. The local error of
+            each step is estimated by step doubling, i.e., by
+            comparing a full step with two half steps, and the step is
+            grown or shrunk so as to keep the error relative to the
+            maximum value close to the given tolerance. The steps
+            always end on the stopping times of the step conditions.
+
+            The damping steps are implicit Euler steps of length
+            (from-to)/initialSteps, which is also the initial size of
+            the adaptive steps.
+
+            Returns the number of accepted steps.
+        */
+        Size rollbackAdaptive(array_type& a,
+                              Time from, Time to, Real tolerance,
+                              Size initialSteps = 10, Size dampingSteps = 0);
+
       protected:
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
         const boost::shared_ptr<FdmStepConditionComposite> condition_;
         const FdmSchemeDesc schemeDesc_;
+        const boost::shared_ptr<FdmMultiSnapshotCondition> warmStart_;
     };
 }
 
@@ -0,0 +1,205 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmsparsegridsolver.hpp
+    \brief sparse-grid combination technique for multi-dimensional problems
+*/
+
+#ifndef quantlib_fdm_sparse_grid_solver_hpp
+#define quantlib_fdm_sparse_grid_solver_hpp
+
+#include <ql/methods/finitedifferences/solvers/fdmndimsolver.hpp>
+#include <string>
+
+namespace QuantLib {
+
+    //! factory of the component problems of a sparse-grid solver
+    /*! Given the number of points in each direction, the problem
+        returns the solver description (mesher, boundary and step
+        conditions, inner values) and the operator to be used on
+        that mesh.
+    */
+    class FdmSparseGridProblem {
+      public:
+        virtual ~FdmSparseGridProblem() {}
+        virtual FdmSolverDesc solverDesc(
+                                   const std::vector<Size>& dim) const = 0;
+        virtual boost::shared_ptr<FdmLinearOpComposite> op(
+                          const boost::shared_ptr<FdmMesher>& mesher) const = 0;
+    };
+
+    //! sparse-grid combination technique
+    /*! The solution is approximated by a linear combination of the
+        solutions on a set of anisotropic full grids,
+        \f[
+            u_L = \sum_{q=0}^{N-1} (-1)^q \binom{N-1}{q}
+                  \sum_{|l|_1 = L-q} u_l,
+        \f]
+        where the grid with level vector \f$ l \f$ has
+        \f$ (m_i-1)2^{l_i}+1 \f$ points in the \f$ i \f$-th direction
+        and \f$ m_i \f$ are the given minimum grid sizes.  The number
+        of points grows as \f$ O(2^L L^{N-1}) \f$ instead of the
+        \f$ O(2^{NL}) \f$ of the corresponding full grid.
+
+        The component grids are independent of each other and are
+        solved concurrently when the library is compiled with
+        OpenMP support.
+
+        \warning When OpenMP is enabled, the term structures and
+                 processes used by the component operators must be
+                 safe to use concurrently, e.g., by being calculated
+                 beforehand.
+    */
+    template <Size N>
+    class FdmSparseGridSolver : public LazyObject {
+      public:
+        FdmSparseGridSolver(
+                const boost::shared_ptr<FdmSparseGridProblem>& problem,
+                const std::vector<Size>& minGrid,
+                Size level,
+                const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas());
+
+        Real interpolateAt(const std::vector<Real>& x) const;
+
+        //! \name Inspectors
+        //@{
+        //! number of points of the component grids
+        const std::vector<std::vector<Size> >& grids() const;
+        //! combination coefficients of the component grids
+        const std::vector<Real>& coefficients() const;
+        //@}
+
+      protected:
+        void performCalculations() const;
+
+      private:
+        void addGrids(std::vector<Size>& levels, Size i, Size remaining,
+                      Real coefficient);
+
+        const boost::shared_ptr<FdmSparseGridProblem> problem_;
+        const std::vector<Size> minGrid_;
+        const FdmSchemeDesc schemeDesc_;
+
+        std::vector<std::vector<Size> > grids_;
+        std::vector<Real> coefficients_;
+        mutable std::vector<boost::shared_ptr<FdmNdimSolver<N> > > solvers_;
+    };
+
+
+    template <Size N> inline
+    FdmSparseGridSolver<N>::FdmSparseGridSolver(
+                const boost::shared_ptr<FdmSparseGridProblem>& problem,
+                const std::vector<Size>& minGrid,
+                Size level,
+                const FdmSchemeDesc& schemeDesc)
+    : problem_(problem), minGrid_(minGrid), schemeDesc_(schemeDesc) {
+        QL_REQUIRE(problem_, "null problem given");
+        QL_REQUIRE(minGrid_.size() == N,
+                   "solver dim " << N << " does not fit to the "
+                   << minGrid_.size() << " minimum grid sizes given");
+        for (Size i=0; i < N; ++i)
+            QL_REQUIRE(minGrid_[i] >= 3,
+                       "at least three points required in direction "
+                       << i << ", " << minGrid_[i] << " given");
+
+        Real binomial = 1.0;
+        for (Size q=0; q < N && q <= level; ++q) {
+            std::vector<Size> levels(N);
+            addGrids(levels, 0, level-q, (q % 2 == 0) ? binomial : -binomial);
+            binomial *= Real(N-1-q)/Real(q+1);
+        }
+    }
+
+    template <Size N> inline
+    void FdmSparseGridSolver<N>::addGrids(std::vector<Size>& levels,
+                                          Size i, Size remaining,
+                                          Real coefficient) {
+        if (i == N-1) {
+            levels[i] = remaining;
+            std::vector<Size> dim(N);
+            for (Size j=0; j < N; ++j)
+                dim[j] = (minGrid_[j]-1)*(Size(1) << levels[j]) + 1;
+            grids_.push_back(dim);
+            coefficients_.push_back(coefficient);
+        }
+        else {
+            for (Size l=0; l <= remaining; ++l) {
+                levels[i] = l;
+                addGrids(levels, i+1, remaining-l, coefficient);
+            }
+        }
+    }
+
+    template <Size N> inline
+    void FdmSparseGridSolver<N>::performCalculations() const {
+        const Size m = grids_.size();
+        solvers_.resize(m);
+        for (Size k=0; k < m; ++k) {
+            const FdmSolverDesc desc = problem_->solverDesc(grids_[k]);
+            solvers_[k] = boost::shared_ptr<FdmNdimSolver<N> >(
+                new FdmNdimSolver<N>(desc, schemeDesc_,
+                                     problem_->op(desc.mesher)));
+        }
+    }
+
+    template <Size N> inline
+    Real FdmSparseGridSolver<N>::interpolateAt(
+                                        const std::vector<Real>& x) const {
+        calculate();
+
+        // the first call rolls back the component grids
+        const Size m = solvers_.size();
+        std::vector<Real> values(m);
+        std::vector<std::string> errors(m);
+        // not vector<bool>, whose elements can't be written concurrently
+        std::vector<int> failed(m, 0);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (long k=0; k < long(m); ++k) {
+            try {
+                values[k] = solvers_[k]->interpolateAt(x);
+            } catch (std::exception& e) {
+                errors[k] = e.what();
+                failed[k] = 1;
+            } catch (...) {
+                errors[k] = "unknown error";
+                failed[k] = 1;
+            }
+        }
+
+        Real result = 0.0;
+        for (Size k=0; k < m; ++k) {
+            QL_REQUIRE(!failed[k],
+                       "component grid #" << k << " failed: " << errors[k]);
+            result += coefficients_[k]*values[k];
+        }
+        return result;
+    }
+
+    template <Size N> inline
+    const std::vector<std::vector<Size> >&
+    FdmSparseGridSolver<N>::grids() const {
+        return grids_;
+    }
+
+    template <Size N> inline
+    const std::vector<Real>& FdmSparseGridSolver<N>::coefficients() const {
+        return coefficients_;
+    }
+}
+
+#endif
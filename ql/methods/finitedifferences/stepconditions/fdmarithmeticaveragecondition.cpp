@@ -61,24 +61,35 @@ namespace QuantLib {
         const Size nTimes
             = std::count(averageTimes_.begin(), averageTimes_.end(), t);
         if (nTimes > 0) {
-            Array aCopy(a);
             const Size iT = iter - averageTimes_.begin() + 1 + pastFixings_;
+            const Real wa = (iT-nTimes)/Real(iT), wx = nTimes/Real(iT);
             const Size averageDirection = equityDirection_ == 0 ? 1 : 0;
             const Size xSpacing = mesher_->layout()->spacing()[equityDirection_];
             const Size aSpacing = mesher_->layout()->spacing()[averageDirection];
-            Array tmp(a_.size());
+            const Size n = a_.size();
 
+            // each line along the average direction is remapped on its
+            // own. The new averages are increasing along the line, so
+            // that the spline segments can be found by a single sweep.
+            #pragma omp parallel for
             for (Size i=0; i<x_.size(); ++i) {
-                for (Size j=0; j<a_.size(); ++j) {
-                    Size index = i*xSpacing + j*aSpacing;
-                    tmp[j] = aCopy[index];
-                }
-                MonotonicCubicNaturalSpline interp(a_.begin(), a_.end(),
-                                           tmp.begin());
-                for (Size j=0; j<a_.size(); ++j) {
-                    Size index = i*xSpacing + j*aSpacing;
-                    a[index] = interp((iT-nTimes)/(double)(iT)*a_[j] +
-                                      nTimes/(double)(iT)*x_[i], true);
+                Array tmp(n);
+                for (Size j=0; j<n; ++j)
+                    tmp[j] = a[i*xSpacing + j*aSpacing];
+
+                const MonotonicCubicNaturalSpline interp(
+                    a_.begin(), a_.end(), tmp.begin());
+                const std::vector<Real>& c1 = interp.aCoefficients();
+                const std::vector<Real>& c2 = interp.bCoefficients();
+                const std::vector<Real>& c3 = interp.cCoefficients();
+
+                for (Size j=0, k=0; j<n; ++j) {
+                    const Real avg = wa*a_[j] + wx*x_[i];
+                    while (k < n-2 && avg >= a_[k+1])
+                        ++k;
+                    const Real dx = avg - a_[k];
+                    a[i*xSpacing + j*aSpacing] =
+                        tmp[k] + dx*(c1[k] + dx*(c2[k] + dx*c3[k]));
                 }
             }
         }
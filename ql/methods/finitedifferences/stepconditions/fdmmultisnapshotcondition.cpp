@@ -0,0 +1,75 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/stepconditions/fdmmultisnapshotcondition.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    FdmMultiSnapshotCondition::FdmMultiSnapshotCondition(
+                                               const std::vector<Time>& times)
+    : times_(times) {
+        std::sort(times_.begin(), times_.end());
+        times_.erase(std::unique(times_.begin(), times_.end()),
+                     times_.end());
+        taken_.resize(times_.size(), false);
+    }
+
+    void FdmMultiSnapshotCondition::applyTo(Array& a, Time t) const {
+        const Size i = index(t);
+        if (i == Null<Size>())
+            return;
+
+        if (values_.columns() != a.size()) {
+            values_ = Matrix(times_.size(), a.size());
+            std::fill(taken_.begin(), taken_.end(), false);
+        }
+        std::copy(a.begin(), a.end(), values_.row_begin(i));
+        taken_[i] = true;
+    }
+
+    const std::vector<Time>& FdmMultiSnapshotCondition::times() const {
+        return times_;
+    }
+
+    Size FdmMultiSnapshotCondition::index(Time t) const {
+        // allows for the rounding of the step sizes
+        const Time tol = 1e-10;
+        const std::vector<Time>::const_iterator i =
+            std::lower_bound(times_.begin(), times_.end(), t - tol);
+        if (i != times_.end() && *i <= t + tol)
+            return i - times_.begin();
+        else
+            return Null<Size>();
+    }
+
+    bool FdmMultiSnapshotCondition::hasValues(Size i) const {
+        QL_REQUIRE(i < times_.size(),
+                   "snapshot #" << i << " not available; "
+                   << times_.size() << " times given");
+        return taken_[i];
+    }
+
+    Disposable<Array> FdmMultiSnapshotCondition::values(Size i) const {
+        QL_REQUIRE(hasValues(i),
+                   "no snapshot taken at t = " << times_[i]);
+        Array result(values_.row_begin(i), values_.row_end(i));
+        return result;
+    }
+
+}
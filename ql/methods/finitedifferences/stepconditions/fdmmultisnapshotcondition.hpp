@@ -0,0 +1,66 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmmultisnapshotcondition.hpp
+    \brief step condition storing the values at several times
+*/
+
+#ifndef quantlib_fdm_multi_snapshot_condition_hpp
+#define quantlib_fdm_multi_snapshot_condition_hpp
+
+#include <ql/methods/finitedifferences/stepcondition.hpp>
+#include <ql/math/matrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! step condition storing the values at several times
+    /*! This generalizes FdmSnapshotCondition to a set of times. The
+        values are stored without loss of precision in a single
+        matrix having one row per time, so that taking a snapshot
+        doesn't allocate memory once the first one was taken.
+
+        The stored values can also be used as starting points of the
+        iterative solvers when the problem is solved again with
+        slightly different inputs, see ImplicitEulerScheme.
+
+        \note The times must be among the stopping times of the
+              rollback, e.g., by passing the condition through
+              FdmStepConditionComposite::joinConditions.
+    */
+    class FdmMultiSnapshotCondition : public StepCondition<Array> {
+      public:
+        explicit FdmMultiSnapshotCondition(const std::vector<Time>& times);
+
+        void applyTo(Array& a, Time t) const;
+
+        //! sorted snapshot times
+        const std::vector<Time>& times() const;
+        //! index of the given snapshot time, or Null<Size>() if none
+        Size index(Time t) const;
+        bool hasValues(Size i) const;
+        Disposable<Array> values(Size i) const;
+
+      private:
+        std::vector<Time> times_;
+        mutable Matrix values_;
+        mutable std::vector<bool> taken_;
+    };
+
+}
+
+#endif
@@ -67,14 +67,19 @@ namespace QuantLib {
             const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
             const FdmLinearOpIterator endIter = layout->end();
 
+            // the calculator is not required to be thread-safe
+            Array prices(a.size());
             for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
                  ++iter) {
+                prices[iter.index()] = calculator_->innerValue(iter, t);
+            }
 
-                const std::vector<Size>& coor = iter.coordinates();
-                const Real x = x_[coor[0]];
-                const Real y = y_[coor[1]];
+            #pragma omp parallel for
+            for (Size i=0; i < a.size(); ++i) {
+                const Real x = x_[i % x_.size()];
+                const Real y = y_[i / x_.size()];
 
-                const Real price = calculator_->innerValue(iter, t);
+                const Real price = prices[i];
 
                 const Real maxWithDraw = std::min(y-y_.front(), changeRate_);
                 const Real sellPrice   = interpl(x, y-maxWithDraw);
@@ -83,7 +88,7 @@ namespace QuantLib {
                 const Real buyPrice  = interpl(x, y+maxInject);
 
                 // bang-bang-wait strategy
-                Real currentValue = std::max(a[iter.index()],
+                Real currentValue = std::max(a[i],
                     std::max(buyPrice - price*maxInject,
                              sellPrice + price*maxWithDraw));
 
@@ -102,7 +107,7 @@ namespace QuantLib {
                     ++yIter;
                 }
 
-                retVal[iter.index()] = currentValue;
+                retVal[i] = currentValue;
             }
             a = retVal;
         }
@@ -41,33 +41,41 @@ namespace QuantLib {
         const Size maxExerciseValue=mesher_->layout()->dim()[swingDirection_]-1;
 
         if (iter != exerciseTimes_.end()) {
-            Array retVal= a;
-
             const Size d = std::distance(iter, exerciseTimes_.end());
 
             const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
             const FdmLinearOpIterator endIter = layout->end();
-            
+
+            // the calculator isn't required to be thread-safe
+            Array cashflows(layout->size());
             for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
                  ++iter) {
-                
-                const std::vector<Size>& coor = iter.coordinates();
-                
-                const Size exercisesUsed = coor[swingDirection_];
-                
-                if (exercisesUsed < maxExerciseValue) {
-                    const Real cashflow = calculator_->innerValue(iter, t);
-                    const Real currentValue = a[iter.index()];
+                if (iter.coordinates()[swingDirection_] < maxExerciseValue)
+                    cashflows[iter.index()] = calculator_->innerValue(iter, t);
+            }
+
+            // a layer of exercises used only depends on itself and on the
+            // next layer, hence the layers can be updated in place in
+            // increasing order and each layer in parallel.
+            const Size stride = layout->spacing()[swingDirection_];
+            const Size nLines = layout->lines(swingDirection_);
+
+            for (Size exercisesUsed=0; exercisesUsed < maxExerciseValue;
+                 ++exercisesUsed) {
+                const bool forced = (exercisesUsed + d <= minExercises_);
+
+                #pragma omp parallel for
+                for (Size l=0; l < nLines; ++l) {
+                    const Size i = layout->lineStart(swingDirection_, l)
+                                 + exercisesUsed*stride;
                     const Real valuePlusOneExercise
-                         = a[layout->neighbourhood(iter, swingDirection_, 1)];
-                    
-                    if (   currentValue < valuePlusOneExercise + cashflow
-                        || exercisesUsed + d <=  minExercises_) {
-                        retVal[iter.index()] = valuePlusOneExercise + cashflow;
+                         = a[i+stride] + cashflows[i];
+
+                    if (a[i] < valuePlusOneExercise || forced) {
+                        a[i] = valuePlusOneExercise;
                     }
                 }
             }
-            a = retVal;
         }
     }
 }
@@ -24,6 +24,7 @@
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmdividendhandler.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmmultisnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmamericanstepcondition.hpp>
@@ -81,6 +82,23 @@ namespace QuantLib {
             new FdmStepConditionComposite(stoppingTimes, conditions));
     }
 
+    boost::shared_ptr<FdmStepConditionComposite>
+    FdmStepConditionComposite::joinConditions(
+                const boost::shared_ptr<FdmMultiSnapshotCondition>& c1,
+                const boost::shared_ptr<FdmStepConditionComposite>& c2) {
+
+        std::list<std::vector<Time> > stoppingTimes;
+        stoppingTimes.push_back(c2->stoppingTimes());
+        stoppingTimes.push_back(c1->times());
+
+        FdmStepConditionComposite::Conditions conditions;
+        conditions.push_back(c2);
+        conditions.push_back(c1);
+
+        return boost::shared_ptr<FdmStepConditionComposite>(
+            new FdmStepConditionComposite(stoppingTimes, conditions));
+    }
+
     boost::shared_ptr<FdmStepConditionComposite> 
     FdmStepConditionComposite::vanillaComposite(
                  const DividendSchedule& cashFlow,
@@ -38,6 +38,7 @@ namespace QuantLib {
     class FdmMesher;
     class Exercise;
     class FdmSnapshotCondition;
+    class FdmMultiSnapshotCondition;
     class FdmInnerValueCalculator;
     
     class FdmStepConditionComposite : public StepCondition<Array> {
@@ -56,6 +57,10 @@ namespace QuantLib {
                     const boost::shared_ptr<FdmSnapshotCondition>& c1,
                     const boost::shared_ptr<FdmStepConditionComposite>& c2);
 
+        static boost::shared_ptr<FdmStepConditionComposite> joinConditions(
+                    const boost::shared_ptr<FdmMultiSnapshotCondition>& c1,
+                    const boost::shared_ptr<FdmStepConditionComposite>& c2);
+
         static boost::shared_ptr<FdmStepConditionComposite> vanillaComposite(
              const DividendSchedule& schedule,
              const boost::shared_ptr<Exercise>& exercise,
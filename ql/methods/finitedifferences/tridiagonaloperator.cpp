@@ -22,7 +22,8 @@
 
 namespace QuantLib {
 
-    TridiagonalOperator::TridiagonalOperator(Size size) {
+    TridiagonalOperator::TridiagonalOperator(Size size)
+    : factorized_(false) {
         if (size>=2) {
             n_ = size;
             diagonal_      = Array(size);
@@ -45,7 +46,8 @@ namespace QuantLib {
                                              const Array& mid,
                                              const Array& high)
     : n_(mid.size()),
-      diagonal_(mid), lowerDiagonal_(low), upperDiagonal_(high), temp_(n_) {
+      diagonal_(mid), lowerDiagonal_(low), upperDiagonal_(high), temp_(n_),
+      factorized_(false) {
         QL_REQUIRE(low.size() == n_-1,
                    "low diagonal vector of size " << low.size() <<
                    " instead of " << n_-1);
@@ -54,10 +56,13 @@ namespace QuantLib {
                    " instead of " << n_-1);
     }
 
+    #if defined(QL_USE_DISPOSABLE)
     TridiagonalOperator::TridiagonalOperator(
-                                const Disposable<TridiagonalOperator>& from) {
+                                const Disposable<TridiagonalOperator>& from)
+    : factorized_(false) {
         swap(const_cast<Disposable<TridiagonalOperator>&>(from));
     }
+    #endif
 
     Disposable<Array> TridiagonalOperator::applyTo(const Array& v) const {
         QL_REQUIRE(n_!=0,
@@ -97,21 +102,35 @@ namespace QuantLib {
                    "rhs vector of size " << rhs.size() <<
                    " instead of " << n_);
 
+        if (!factorized_)
+            factorize();
+
+        result[0] = rhs[0]*inversePivots_[0];
+        for (Size j=1; j<=n_-1; ++j)
+            result[j] = (rhs[j] - lowerDiagonal_[j-1]*result[j-1])
+                      * inversePivots_[j];
+        // cannot be j>=0 with Size j
+        for (Size j=n_-2; j>0; --j)
+            result[j] -= temp_[j+1]*result[j+1];
+        result[0] -= temp_[1]*result[1];
+    }
+
+    void TridiagonalOperator::factorize() const {
+        if (inversePivots_.size() != n_)
+            inversePivots_ = Array(n_);
+
         Real bet = diagonal_[0];
         QL_REQUIRE(!close(bet, 0.0),
                    "diagonal's first element (" << bet <<
                    ") cannot be close to zero");
-        result[0] = rhs[0]/bet;
+        inversePivots_[0] = 1.0/bet;
         for (Size j=1; j<=n_-1; ++j) {
             temp_[j] = upperDiagonal_[j-1]/bet;
             bet = diagonal_[j]-lowerDiagonal_[j-1]*temp_[j];
             QL_ENSURE(!close(bet, 0.0), "division by zero");
-            result[j] = (rhs[j] - lowerDiagonal_[j-1]*result[j-1])/bet;
+            inversePivots_[j] = 1.0/bet;
         }
-        // cannot be j>=0 with Size j
-        for (Size j=n_-2; j>0; --j)
-            result[j] -= temp_[j+1]*result[j+1];
-        result[0] -= temp_[1]*result[1];
+        factorized_ = true;
     }
 
     Disposable<Array> TridiagonalOperator::SOR(const Array& rhs,
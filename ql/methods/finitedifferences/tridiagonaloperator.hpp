@@ -68,13 +68,19 @@ namespace QuantLib {
         TridiagonalOperator(const Array& low,
                             const Array& mid,
                             const Array& high);
+        #if defined(QL_USE_DISPOSABLE)
         TridiagonalOperator(const Disposable<TridiagonalOperator>&);
         TridiagonalOperator& operator=(const Disposable<TridiagonalOperator>&);
+        #endif
         //! \name Operator interface
         //@{
         //! apply operator to a given array
         Disposable<Array> applyTo(const Array& v) const;
-        //! solve linear system for a given right-hand side
+        /*! solve linear system for a given right-hand side
+
+            The factorization of the operator is stored and reused by
+            later calls until the operator is modified.
+        */
         Disposable<Array> solveFor(const Array& rhs) const;
         /*! solve linear system for a given right-hand side
             without result Array allocation. The rhs and result parameters
@@ -118,8 +124,11 @@ namespace QuantLib {
       protected:
         Size n_;
         Array diagonal_, lowerDiagonal_, upperDiagonal_;
-        mutable Array temp_;
+        mutable Array temp_, inversePivots_;
+        mutable bool factorized_;
         boost::shared_ptr<TimeSetter> timeSetter_;
+      private:
+        void factorize() const;
     };
 
     /* \relates TridiagonalOperator */
@@ -128,16 +137,23 @@ namespace QuantLib {
 
     // inline definitions
 
+    #if defined(QL_USE_DISPOSABLE)
     inline TridiagonalOperator& TridiagonalOperator::operator=(
                                 const Disposable<TridiagonalOperator>& from) {
         swap(const_cast<Disposable<TridiagonalOperator>&>(from));
         return *this;
     }
+    #endif
 
     inline void TridiagonalOperator::setFirstRow(Real valB,
                                                  Real valC) {
-        diagonal_[0]      = valB;
-        upperDiagonal_[0] = valC;
+        // boundary conditions set the same rows at each step; keep
+        // the factorization if nothing changes
+        if (diagonal_[0] != valB || upperDiagonal_[0] != valC) {
+            diagonal_[0]      = valB;
+            upperDiagonal_[0] = valC;
+            factorized_ = false;
+        }
     }
 
     inline void TridiagonalOperator::setMidRow(Size i,
@@ -149,6 +165,7 @@ namespace QuantLib {
         lowerDiagonal_[i-1] = valA;
         diagonal_[i]        = valB;
         upperDiagonal_[i]   = valC;
+        factorized_ = false;
     }
 
     inline void TridiagonalOperator::setMidRows(Real valA,
@@ -159,17 +176,23 @@ namespace QuantLib {
             diagonal_[i]        = valB;
             upperDiagonal_[i]   = valC;
         }
+        factorized_ = false;
     }
 
     inline void TridiagonalOperator::setLastRow(Real valA,
                                                 Real valB) {
-        lowerDiagonal_[n_-2] = valA;
-        diagonal_[n_-1]      = valB;
+        if (lowerDiagonal_[n_-2] != valA || diagonal_[n_-1] != valB) {
+            lowerDiagonal_[n_-2] = valA;
+            diagonal_[n_-1]      = valB;
+            factorized_ = false;
+        }
     }
 
     inline void TridiagonalOperator::setTime(Time t) {
-        if (timeSetter_)
+        if (timeSetter_) {
             timeSetter_->setTime(t, *this);
+            factorized_ = false;
+        }
     }
 
     inline void TridiagonalOperator::swap(TridiagonalOperator& from) {
@@ -179,6 +202,8 @@ namespace QuantLib {
         lowerDiagonal_.swap(from.lowerDiagonal_);
         upperDiagonal_.swap(from.upperDiagonal_);
         temp_.swap(from.temp_);
+        inversePivots_.swap(from.inversePivots_);
+        swap(factorized_, from.factorized_);
         swap(timeSetter_, from.timeSetter_);
     }
 
@@ -9,6 +9,8 @@
 #include <ql/methods/finitedifferences/utilities/fdmindicesonboundary.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmmultigridsolver.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmshoutloginnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmtimedepdirichletboundary.hpp>
 
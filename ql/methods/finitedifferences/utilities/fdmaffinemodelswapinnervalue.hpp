@@ -25,17 +25,25 @@
 
 #include <ql/indexes/iborindex.hpp>
 #include <ql/instruments/vanillaswap.hpp>
-#include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
-#include <ql/methods/finitedifferences/utilities/fdmaffinemodeltermstructure.hpp>
-#include <ql/cashflows/coupon.hpp>
+#include <ql/settings.hpp>
 
 #include <map>
 
 namespace QuantLib {
 
+    /*! The swap is valued on all the mesher nodes at once for each
+        exercise date.  The cash-flow dates and amounts and the
+        coefficients of the affine discount-bond formula
+        \f$ P(t,T,x) = A(t,T) e^{-B(t,T) \cdot x} \f$ for the
+        needed maturities are calculated once per exercise date;
+        the values at the nodes are then obtained from the model
+        state without building term structures or coupons.
+    */
     template <class ModelType>
     class FdmAffineModelSwapInnerValue : public FdmInnerValueCalculator {
       public:
@@ -56,14 +64,36 @@ namespace QuantLib {
             Time t,
             const FdmLinearOpIterator& iter) const;
 
-        RelinkableHandle<YieldTermStructure> disTs_, fwdTs_;
-        const boost::shared_ptr<ModelType> disModel_, fwdModel_;
+        // discount bonds A*exp(-B.x) from the exercise time; the
+        // legs share most of their dates, so maturities are merged
+        struct Bonds {
+            Time t;
+            std::vector<Real> A;
+            std::vector<Array> B;
+            std::map<Time, Size> index;
+            Size add(const boost::shared_ptr<ModelType>& model,
+                     Time maturity, Size factors);
+            Real value(Size i, const Array& x) const {
+                return A[i]*std::exp(-DotProduct(B[i], x));
+            }
+        };
+        // each cash flow is worth P(payment)*(amount +
+        // forwardAmount*P(forwardStart)/P(forwardEnd))
+        struct Cashflow {
+            Size payment, forwardStart, forwardEnd;
+            Real amount, forwardAmount;
+        };
 
-        const boost::shared_ptr<IborIndex> index_;
+        void calculate(Time t);
+
+        const boost::shared_ptr<ModelType> disModel_, fwdModel_;
         const boost::shared_ptr<VanillaSwap> swap_;
         const std::map<Time, Date> exerciseDates_;
         const boost::shared_ptr<FdmMesher> mesher_;
         const Size direction_;
+
+        Time calculatedTime_;
+        std::vector<Real> innerValues_;
     };
 
     template <class ModelType> inline
@@ -76,75 +106,151 @@ namespace QuantLib {
         Size direction)
     : disModel_(disModel),
       fwdModel_(fwdModel),
-      index_(swap->iborIndex()),
-      swap_(boost::shared_ptr<VanillaSwap>(
-          new VanillaSwap(swap->type(),
-                          swap->nominal(),
-                          swap->fixedSchedule(),
-                          swap->fixedRate(),
-                          swap->fixedDayCount(),
-                          swap->floatingSchedule(),
-                          swap->iborIndex()->clone(fwdTs_),
-                          swap->spread(),
-                          swap->floatingDayCount(),
-                          swap->paymentConvention()))),
+      swap_(swap),
       exerciseDates_(exerciseDates),
       mesher_(mesher),
-      direction_(direction) {
+      direction_(direction),
+      calculatedTime_(Null<Time>()) {
     }
 
     template <class ModelType> inline
-    Real FdmAffineModelSwapInnerValue<ModelType>::innerValue(
-        const FdmLinearOpIterator& iter, Time t) {
+    Size FdmAffineModelSwapInnerValue<ModelType>::Bonds::add(
+        const boost::shared_ptr<ModelType>& model,
+        Time maturity, Size factors) {
 
-        const Date& iterExerciseDate = exerciseDates_.find(t)->second;
+        const std::map<Time, Size>::const_iterator i = index.find(maturity);
+        if (i != index.end())
+            return i->second;
 
-        const Array disRate(getState(disModel_, t, iter));
-        const Array fwdRate(getState(fwdModel_, t, iter));
+        // the model is affine in its factors, so that A and B can be
+        // read off its discount bonds at the origin and at unit states
+        Array x(factors, 0.0);
+        const Real a = model->discountBond(t, maturity, x);
+        Array b(factors);
+        for (Size i=0; i < factors; ++i) {
+            x[i] = 1.0;
+            b[i] = std::log(a/model->discountBond(t, maturity, x));
+            x[i] = 0.0;
+        }
+        A.push_back(a);
+        B.push_back(b);
+        return index[maturity] = A.size()-1;
+    }
 
-        if (disTs_.empty() || iterExerciseDate != disTs_->referenceDate()) {
+    template <class ModelType> inline
+    void FdmAffineModelSwapInnerValue<ModelType>::calculate(Time t) {
 
-            const Handle<YieldTermStructure> discount
-                = disModel_->termStructure();
+        const std::map<Time, Date>::const_iterator e = exerciseDates_.find(t);
+        QL_REQUIRE(e != exerciseDates_.end(),
+                   "no exercise date given for time " << t);
+        const Date& exerciseDate = e->second;
 
-            disTs_.linkTo(boost::shared_ptr<YieldTermStructure>(
-                new FdmAffineModelTermStructure(disRate,
-                    discount->calendar(), discount->dayCounter(),
-                    iterExerciseDate, discount->referenceDate(),
-                    disModel_)));
+        const FdmLinearOpIterator begin = mesher_->layout()->begin();
+        const Size factors = getState(disModel_, t, begin).size();
 
-            const Handle<YieldTermStructure> fwd = fwdModel_->termStructure();
+        // times in the model are measured from the reference date of
+        // its term structure, using its day counter
+        const Handle<YieldTermStructure> disTs = disModel_->termStructure();
+        const Handle<YieldTermStructure> fwdTs = fwdModel_->termStructure();
+        const DayCounter disDc = disTs->dayCounter();
+        const DayCounter fwdDc = fwdTs->dayCounter();
 
-            fwdTs_.linkTo(boost::shared_ptr<YieldTermStructure>(
-                new FdmAffineModelTermStructure(fwdRate,
-                    fwd->calendar(), fwd->dayCounter(),
-                    iterExerciseDate, fwd->referenceDate(),
-                    fwdModel_)));
+        Bonds disBonds, fwdBonds;
+        disBonds.t = disDc.yearFraction(disTs->referenceDate(), exerciseDate);
+        fwdBonds.t = fwdDc.yearFraction(fwdTs->referenceDate(), exerciseDate);
 
-        }
-        else {
-            boost::dynamic_pointer_cast<FdmAffineModelTermStructure>(
-                disTs_.currentLink())->setVariable(disRate);
-            boost::dynamic_pointer_cast<FdmAffineModelTermStructure>(
-                fwdTs_.currentLink())->setVariable(fwdRate);
-        }
+        const Date today = Settings::instance().evaluationDate();
+        const bool enforceTodaysFixings =
+            Settings::instance().enforcesTodaysHistoricFixings();
 
-        Real npv = 0.0;
+        std::vector<Cashflow> cashflows;
         for (Size j = 0; j < 2; j++) {
-            for (Leg::const_iterator i = swap_->leg(j).begin();
-                 i != swap_->leg(j).end(); ++i) {
-                npv += boost::dynamic_pointer_cast<Coupon>(*i)
-                                    ->accrualStartDate() >= iterExerciseDate
-                            ? (*i)->amount() * disTs_->discount((*i)->date())
-                            : 0.0;
+            // the fixed leg is paid by the payer swap
+            Real sign = (j == 0) ? -1.0 : 1.0;
+            if (swap_->type() == VanillaSwap::Receiver)
+                sign = -sign;
+
+            const Leg& leg = swap_->leg(j);
+            for (Leg::const_iterator i = leg.begin(); i != leg.end(); ++i) {
+                const boost::shared_ptr<Coupon> coupon =
+                    boost::dynamic_pointer_cast<Coupon>(*i);
+                if (coupon->accrualStartDate() < exerciseDate)
+                    continue;
+
+                Cashflow c;
+                c.payment = disBonds.add(disModel_, disBonds.t +
+                    disDc.yearFraction(exerciseDate, coupon->date()),
+                    factors);
+                c.forwardStart = c.forwardEnd = Null<Size>();
+                c.forwardAmount = 0.0;
+
+                const boost::shared_ptr<IborCoupon> iborCoupon =
+                    boost::dynamic_pointer_cast<IborCoupon>(coupon);
+                bool forecast = false;
+                if (iborCoupon) {
+                    // same logic as IborCoupon::indexFixing
+                    const Date fixingDate = iborCoupon->fixingDate();
+                    forecast = fixingDate > today
+                        || (fixingDate == today && !enforceTodaysFixings
+                            && iborCoupon->index()->pastFixing(fixingDate)
+                                                        == Null<Real>());
+                }
+
+                if (forecast) {
+                    // amount = N*tau*(g*(P(v)/P(e)-1)/s + spread)
+                    const Real factor = coupon->nominal()
+                        * coupon->accrualPeriod() * iborCoupon->gearing()
+                        / iborCoupon->spanningTime();
+                    c.amount = sign * (coupon->nominal()
+                        * coupon->accrualPeriod() * iborCoupon->spread()
+                        - factor);
+                    c.forwardAmount = sign * factor;
+                    c.forwardStart = fwdBonds.add(fwdModel_, fwdBonds.t +
+                        fwdDc.yearFraction(exerciseDate,
+                                           iborCoupon->fixingValueDate()),
+                        factors);
+                    c.forwardEnd = fwdBonds.add(fwdModel_, fwdBonds.t +
+                        fwdDc.yearFraction(exerciseDate,
+                                           iborCoupon->fixingEndDate()),
+                        factors);
+                }
+                else {
+                    c.amount = sign * coupon->amount();
+                }
+                cashflows.push_back(c);
+            }
+        }
+
+        const Size n = mesher_->layout()->size();
+        innerValues_.resize(n);
+        const FdmLinearOpIterator end = mesher_->layout()->end();
+        for (FdmLinearOpIterator iter = begin; iter != end; ++iter) {
+            const Array disState(getState(disModel_, t, iter));
+            const Array fwdState(getState(fwdModel_, t, iter));
+
+            Real npv = 0.0;
+            for (Size i = 0; i < cashflows.size(); ++i) {
+                const Cashflow& c = cashflows[i];
+                Real amount = c.amount;
+                if (c.forwardStart != Null<Size>())
+                    amount += c.forwardAmount
+                        * fwdBonds.value(c.forwardStart, fwdState)
+                        / fwdBonds.value(c.forwardEnd, fwdState);
+                npv += amount * disBonds.value(c.payment, disState);
             }
-            if (j == 0)
-                npv *= -1.0;
+            innerValues_[iter.index()] = std::max(0.0, npv);
         }
-        if (swap_->type() == VanillaSwap::Receiver)
-            npv *= -1.0;
+        calculatedTime_ = t;
+    }
+
+    template <class ModelType> inline
+    Real FdmAffineModelSwapInnerValue<ModelType>::innerValue(
+        const FdmLinearOpIterator& iter, Time t) {
+
+        if (t != calculatedTime_)
+            calculate(t);
 
-        return std::max(0.0, npv);
+        return innerValues_[iter.index()];
     }
 
     template <class ModelType> inline
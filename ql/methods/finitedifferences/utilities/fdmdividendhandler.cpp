@@ -20,9 +20,9 @@
 */
 
 #include <ql/time/daycounter.hpp>
-#include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmdividendhandler.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -53,6 +53,24 @@ namespace QuantLib {
          for (Size i = 0; i < x_.size(); ++i) {
              x_[i] = std::exp(tmp[i*spacing]);
          }
+
+         // The shifted spot values only depend on the mesher and on the
+         // dividend; the linear interpolation segments and weights are
+         // computed here once and applied to every line of the mesher.
+         const Size n = x_.size();
+         QL_REQUIRE(n > 1, "at least two grid points required");
+         remapIndices_.resize(dividends_.size(), std::vector<Size>(n));
+         remapWeights_.resize(dividends_.size(), Array(n));
+         for (Size d = 0; d < dividends_.size(); ++d) {
+             for (Size k = 0; k < n; ++k) {
+                 const Real s = std::max(x_[0], x_[k]-dividends_[d]);
+                 const Size i = std::min<Size>(
+                     std::upper_bound(x_.begin(), x_.end(), s)-x_.begin()-1,
+                     n-2);
+                 remapIndices_[d][k] = i;
+                 remapWeights_[d][k] = (s-x_[i])/(x_[i+1]-x_[i]);
+             }
+         }
     }
 
     const std::vector<Time>& FdmDividendHandler::dividendTimes() const {
@@ -67,42 +85,64 @@ namespace QuantLib {
         return dividends_;
     }
 
-    void FdmDividendHandler::applyTo(Array& a, Time t) const {
-        Array aCopy(a);
+    Size FdmDividendHandler::dividendIndex(Time t) const {
+        return std::find(dividendTimes_.begin(), dividendTimes_.end(), t)
+            - dividendTimes_.begin();
+    }
 
-        std::vector<Time>::const_iterator iter
-            = std::find(dividendTimes_.begin(), dividendTimes_.end(), t);
+    void FdmDividendHandler::applyTo(Array& a, Time t) const {
+        const Size d = dividendIndex(t);
 
-        if (iter != dividendTimes_.end()) {
-            const Real dividend = dividends_[iter - dividendTimes_.begin()];
+        if (d != dividendTimes_.size()) {
+            const boost::shared_ptr<FdmLinearOpLayout> layout
+                = mesher_->layout();
+            const Size n = x_.size();
+            const Size stride = layout->spacing()[equityDirection_];
+            const Size nLines = layout->lines(equityDirection_);
+            const std::vector<Size>& idx = remapIndices_[d];
+            const Array& w = remapWeights_[d];
 
-            if (mesher_->layout()->dim().size() == 1) {
-                LinearInterpolation interp(x_.begin(), x_.end(), aCopy.begin());
-                for (Size k=0; k<x_.size(); ++k) {
-                    a[k] = interp(std::max(x_[0], x_[k]-dividend), true);
+            #pragma omp parallel for
+            for (Size l=0; l < nLines; ++l) {
+                const Size start = layout->lineStart(equityDirection_, l);
+                Array tmp(n);
+                for (Size k=0; k<n; ++k)
+                    tmp[k] = a[start + k*stride];
+                for (Size k=0; k<n; ++k) {
+                    const Size i = idx[k];
+                    a[start + k*stride] = tmp[i] + w[k]*(tmp[i+1]-tmp[i]);
                 }
             }
-            else {
-                Array tmp(x_.size());
-                Size xSpacing = mesher_->layout()->spacing()[equityDirection_];
-                
-                for (Size i=0; i<mesher_->layout()->dim().size(); ++i) {
-                    if (i!=equityDirection_) {
-                        Size ySpacing = mesher_->layout()->spacing()[i];
-                        for (Size j=0; j<mesher_->layout()->dim()[i]; ++j) {
-                            for (Size k=0; k<x_.size(); ++k) {
-                                Size index = j*ySpacing + k*xSpacing;
-                                tmp[k] = aCopy[index];
-                            }
-                            LinearInterpolation interp(x_.begin(), x_.end(),
-                                                       tmp.begin());
-                            for (Size k=0; k<x_.size(); ++k) {
-                                Size index = j*ySpacing + k*xSpacing;
-                                a[index] = interp(
-                                        std::max(x_[0], x_[k]-dividend), true);
-                            }
-                        }
-                    }
+        }
+    }
+
+    void FdmDividendHandler::applyTo(Matrix& a, Time t) const {
+        const Size d = dividendIndex(t);
+
+        if (d != dividendTimes_.size()) {
+            const boost::shared_ptr<FdmLinearOpLayout> layout
+                = mesher_->layout();
+            QL_REQUIRE(a.rows() == layout->size(),
+                       "inconsistent number of rows");
+            const Size n = x_.size(), m = a.columns();
+            const Size stride = layout->spacing()[equityDirection_];
+            const Size nLines = layout->lines(equityDirection_);
+            const std::vector<Size>& idx = remapIndices_[d];
+            const Array& w = remapWeights_[d];
+
+            #pragma omp parallel for
+            for (Size l=0; l < nLines; ++l) {
+                const Size start = layout->lineStart(equityDirection_, l);
+                Matrix tmp(n, m);
+                for (Size k=0; k<n; ++k)
+                    std::copy(a.row_begin(start + k*stride),
+                              a.row_end(start + k*stride), tmp.row_begin(k));
+                for (Size k=0; k<n; ++k) {
+                    const Real* y0 = tmp.row_begin(idx[k]);
+                    const Real* y1 = tmp.row_begin(idx[k]+1);
+                    Real* y = a.row_begin(start + k*stride);
+                    for (Size j=0; j<m; ++j)
+                        y[j] = y0[j] + w[k]*(y1[j]-y0[j]);
                 }
             }
         }
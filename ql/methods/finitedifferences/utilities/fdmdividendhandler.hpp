@@ -27,6 +27,7 @@
 #define quantlib_fdm_dividend_handler_hpp
 
 #include <ql/instruments/dividendschedule.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/methods/finitedifferences/stepcondition.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 
@@ -43,13 +44,24 @@ namespace QuantLib {
                            Size equityDirection);
         
         void applyTo(Array& a, Time t) const;
+        /*! applies the dividend to each column of the matrix, e.g.,
+            to the values of several options rolled back together;
+            the rows correspond to the points of the mesher.
+        */
+        void applyTo(Matrix& a, Time t) const;
  
         const std::vector<Time>& dividendTimes() const;
         const std::vector<Date>& dividendDates() const;
         const std::vector<Real>& dividends() const;
         
       private:
+        Size dividendIndex(Time t) const;
+
         Array x_; // grid-equity values in physical units
+        // for each dividend, the lower grid point of the interpolation
+        // segment and the interpolation weight of each grid point
+        std::vector<std::vector<Size> > remapIndices_;
+        std::vector<Array> remapWeights_;
 
         std::vector<Time> dividendTimes_;
         std::vector<Date> dividendDates_;
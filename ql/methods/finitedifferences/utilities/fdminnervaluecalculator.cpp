@@ -23,7 +23,7 @@
     \brief layer of abstraction to calculate the inner value
 */
 
-#include <ql/payoff.hpp>
+#include <ql/instruments/payoffs.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/integrals/simpsonintegral.hpp>
 #include <ql/instruments/basketoption.hpp>
@@ -31,10 +31,42 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 
-#include <deque>
 
 namespace QuantLib {
 
+    namespace {
+
+        // cell average of the payoff of exp(x) over [a, b] for the
+        // payoffs whose integral is known in closed form; Null<Real>()
+        // for any other payoff.
+        Real closedFormAverage(const Payoff& payoff, Real a, Real b) {
+            const StrikedTypePayoff* striked =
+                dynamic_cast<const StrikedTypePayoff*>(&payoff);
+            if (striked == 0 || !(b > a))
+                return Null<Real>();
+
+            const Real k = striked->strike();
+            const Real c = (k > 0.0)
+                ? std::min(std::max(std::log(k), a), b) : a;
+            const bool call = (striked->optionType() == Option::Call);
+
+            // integrals of 1 and of exp(x) over the in-the-money part
+            const Real cash  = call ? b-c : c-a;
+            const Real asset = call ? std::exp(b)-std::exp(c)
+                                    : std::exp(c)-std::exp(a);
+
+            if (dynamic_cast<const PlainVanillaPayoff*>(striked) != 0)
+                return (call ? asset-k*cash : k*cash-asset)/(b-a);
+            else if (const CashOrNothingPayoff* digital =
+                     dynamic_cast<const CashOrNothingPayoff*>(striked))
+                return digital->cashPayoff()*cash/(b-a);
+            else if (dynamic_cast<const AssetOrNothingPayoff*>(striked) != 0)
+                return asset/(b-a);
+            else
+                return Null<Real>();
+        }
+    }
+
     FdmLogInnerValue::FdmLogInnerValue(
         const boost::shared_ptr<Payoff>& payoff,
         const boost::shared_ptr<FdmMesher>& mesher,
@@ -45,26 +77,31 @@ namespace QuantLib {
     }
 
     Real FdmLogInnerValue::innerValue(const FdmLinearOpIterator& iter, Time) {
-        const Real s = std::exp(mesher_->location(iter, direction_));
-        return payoff_->operator()(s);
+        if (innerValues_.empty()) {
+            // the payoff only depends on the coordinate along direction_
+            const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
+            innerValues_.resize(layout->dim()[direction_]);
+            for (Size xn=0; xn < innerValues_.size(); ++xn) {
+                const FdmLinearOpIterator iter =
+                    layout->iteratorAt(xn*layout->spacing()[direction_]);
+                innerValues_[xn] = payoff_->operator()(
+                           std::exp(mesher_->location(iter, direction_)));
+            }
+        }
+
+        return innerValues_[iter.coordinates()[direction_]];
     }
 
     Real FdmLogInnerValue::avgInnerValue(
                                     const FdmLinearOpIterator& iter, Time t) {
         if (avgInnerValues_.empty()) {
             // calculate caching values
-            avgInnerValues_.resize(mesher_->layout()->dim()[direction_]);
-            std::deque<bool> initialized(avgInnerValues_.size(), false);
-
             const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
-            const FdmLinearOpIterator endIter = layout->end();
-            for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
-                 ++iter) {
-                const Size xn = iter.coordinates()[direction_];
-                if (!initialized[xn]) {
-                    initialized[xn]     = true;
-                    avgInnerValues_[xn] = avgInnerValueCalc(iter, t);
-                }
+            avgInnerValues_.resize(layout->dim()[direction_]);
+            for (Size xn=0; xn < avgInnerValues_.size(); ++xn) {
+                const FdmLinearOpIterator iter =
+                    layout->iteratorAt(xn*layout->spacing()[direction_]);
+                avgInnerValues_[xn] = avgInnerValueCalc(iter, t);
             }
         }
         
@@ -84,6 +121,11 @@ namespace QuantLib {
         if (coord < dim-1) {
             b += mesher_->dplus(iter, direction_)/2.0;
         }
+
+        const Real closedForm = closedFormAverage(*payoff_, a, b);
+        if (closedForm != Null<Real>())
+            return closedForm;
+
         boost::function1<Real, Real> f = compose(
             std::bind1st(std::mem_fun(&Payoff::operator()), payoff_.get()),
                          std::ptr_fun<Real,Real>(std::exp));
@@ -46,6 +46,13 @@ namespace QuantLib {
     };
 
 
+    //! inner value of a payoff on a log-spaced mesher direction
+    /*! Inner values and cell averages only depend on the coordinate
+        along the given direction and are cached on first use.  Cell
+        averages are calculated in closed form for plain-vanilla,
+        cash-or-nothing and asset-or-nothing payoffs and numerically
+        for any other payoff.
+    */
     class FdmLogInnerValue : public FdmInnerValueCalculator {
       public:
         FdmLogInnerValue(const boost::shared_ptr<Payoff>& payoff,
@@ -62,7 +69,7 @@ namespace QuantLib {
         const boost::shared_ptr<Payoff> payoff_;
         const boost::shared_ptr<FdmMesher> mesher_;
         const Size direction_;
-        std::vector<Real> avgInnerValues_;
+        std::vector<Real> innerValues_, avgInnerValues_;
     };
 
     class FdmLogBasketInnerValue : public FdmInnerValueCalculator {
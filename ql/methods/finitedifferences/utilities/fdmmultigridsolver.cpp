@@ -0,0 +1,259 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/utilities/fdmmultigridsolver.hpp>
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+
+#include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <map>
+
+namespace QuantLib {
+
+    FdmMultigridSolver::FdmMultigridSolver(
+                        const SparseMatrix& a,
+                        const boost::shared_ptr<FdmLinearOpLayout>& layout,
+                        Size maxIter, Real relTol, Size smoothingSteps)
+    : maxIter_(maxIter), relTol_(relTol), smoothingSteps_(smoothingSteps) {
+
+        const Size n = layout->size();
+        QL_REQUIRE(a.size1() == n && a.size2() == n,
+                   "matrix size (" << a.size1() << "x" << a.size2()
+                   << ") doesn't match the layout size (" << n << ")");
+
+        // finest level: copy of the given matrix in CSR format
+        levels_.push_back(Level());
+        CsrMatrix(a).swap(levels_.back().a);
+
+        std::vector<Size> dim = layout->dim();
+        for (;;) {
+            std::vector<Size> coarseDim(dim);
+            for (Size d=0; d < dim.size(); ++d)
+                if (dim[d] >= 5)
+                    coarseDim[d] = dim[d]/2 + 1;
+            if (coarseDim == dim)
+                break;
+
+            const FdmLinearOpLayout fineLayout(dim);
+            const FdmLinearOpLayout coarseLayout(coarseDim);
+            const std::vector<Size>& coarseSpacing = coarseLayout.spacing();
+
+            // prolongation by multi-linear interpolation; a fine point
+            // lies on a coarse one or halfway between two of them
+            // along each coarsened direction
+            std::vector<Size> pRowStart, pColumn;
+            std::vector<Real> pValue;
+            pRowStart.reserve(fineLayout.size()+1);
+            pRowStart.push_back(0);
+            const FdmLinearOpIterator endIter = fineLayout.end();
+            for (FdmLinearOpIterator iter = fineLayout.begin();
+                 iter != endIter; ++iter) {
+                std::vector<Size> index(1, 0);
+                std::vector<Real> weight(1, 1.0);
+                for (Size d=0; d < dim.size(); ++d) {
+                    const Size i = iter.coordinates()[d];
+                    std::vector<Size> c;
+                    if (coarseDim[d] == dim[d])
+                        c.push_back(i);
+                    else if (i == dim[d]-1)
+                        c.push_back(coarseDim[d]-1);
+                    else if (i % 2 == 0)
+                        c.push_back(i/2);
+                    else {
+                        c.push_back((i-1)/2);
+                        c.push_back((i+1)/2);
+                    }
+                    const Real w = 1.0/c.size();
+
+                    std::vector<Size> newIndex;
+                    std::vector<Real> newWeight;
+                    for (Size k=0; k < index.size(); ++k) {
+                        for (Size l=0; l < c.size(); ++l) {
+                            newIndex.push_back(
+                                index[k] + c[l]*coarseSpacing[d]);
+                            newWeight.push_back(weight[k]*w);
+                        }
+                    }
+                    index.swap(newIndex);
+                    weight.swap(newWeight);
+                }
+                std::vector<std::pair<Size, Real> > row(index.size());
+                for (Size k=0; k < index.size(); ++k)
+                    row[k] = std::make_pair(index[k], weight[k]);
+                std::sort(row.begin(), row.end());
+                for (Size k=0; k < row.size(); ++k) {
+                    pColumn.push_back(row[k].first);
+                    pValue.push_back(row[k].second);
+                }
+                pRowStart.push_back(pColumn.size());
+            }
+            const CsrMatrix p(fineLayout.size(), coarseLayout.size(),
+                              pRowStart, pColumn, pValue);
+
+            // Galerkin coarse operator P^T A P
+            const CsrMatrix& fine = levels_.back().a;
+            const std::vector<Size>& fineRowStart = fine.rowPointers();
+            const std::vector<Size>& fineColumn = fine.columnIndices();
+            const std::vector<Real>& fineValue = fine.values();
+            std::vector<std::map<Size, Real> > coarse(coarseLayout.size());
+            for (Size i=0; i < fine.rows(); ++i) {
+                for (Size k=fineRowStart[i]; k < fineRowStart[i+1]; ++k) {
+                    const Size j = fineColumn[k];
+                    const Real v = fineValue[k];
+                    for (Size r=pRowStart[i]; r < pRowStart[i+1]; ++r) {
+                        std::map<Size, Real>& row = coarse[pColumn[r]];
+                        const Real vr = pValue[r]*v;
+                        for (Size s=pRowStart[j]; s < pRowStart[j+1]; ++s)
+                            row[pColumn[s]] += vr*pValue[s];
+                    }
+                }
+            }
+
+            std::vector<Size> rowStart(1, 0), column;
+            std::vector<Real> value;
+            for (Size i=0; i < coarse.size(); ++i) {
+                for (std::map<Size, Real>::const_iterator iter
+                         = coarse[i].begin(); iter != coarse[i].end(); ++iter) {
+                    column.push_back(iter->first);
+                    value.push_back(iter->second);
+                }
+                rowStart.push_back(column.size());
+            }
+
+            levels_.push_back(Level());
+            Level& level = levels_.back();
+            level.prolongation = p;
+            CsrMatrix(coarse.size(), coarse.size(),
+                      rowStart, column, value).swap(level.a);
+
+            dim = coarseDim;
+        }
+
+        for (Size l=0; l < levels_.size(); ++l) {
+            const CsrMatrix& m = levels_[l].a;
+            std::vector<Real>& inverseDiagonal = levels_[l].inverseDiagonal;
+            inverseDiagonal.resize(m.rows(), 0.0);
+            for (Size i=0; i < m.rows(); ++i) {
+                inverseDiagonal[i] = m(i, i);
+                QL_REQUIRE(inverseDiagonal[i] != 0.0,
+                           "zero diagonal element in row " << i
+                           << " of level " << l);
+                inverseDiagonal[i] = 1.0/inverseDiagonal[i];
+            }
+        }
+
+        // the system on the coarsest mesh is solved exactly
+        const CsrMatrix& coarsest = levels_.back().a;
+        Matrix dense(coarsest.rows(), coarsest.rows(), 0.0);
+        for (Size i=0; i < coarsest.rows(); ++i)
+            for (Size k=coarsest.rowPointers()[i];
+                 k < coarsest.rowPointers()[i+1]; ++k)
+                dense[i][coarsest.columnIndices()[k]] = coarsest.values()[k];
+        coarseInverse_ = inverse(dense);
+    }
+
+    Disposable<Array> FdmMultigridSolver::residual(
+                        Size level, const Array& b, const Array& x) const {
+        Array r(b.size());
+        levels_[level].a.multiply(x, r);
+        for (Size i=0; i < r.size(); ++i)
+            r[i] = b[i] - r[i];
+        return r;
+    }
+
+    void FdmMultigridSolver::smooth(Size level, const Array& b, Array& x,
+                                    bool forward) const {
+        const CsrMatrix& m = levels_[level].a;
+        const std::vector<Size>& rowStart = m.rowPointers();
+        const std::vector<Size>& column = m.columnIndices();
+        const std::vector<Real>& value = m.values();
+        const std::vector<Real>& inverseDiagonal =
+            levels_[level].inverseDiagonal;
+        const Size n = m.rows();
+        for (Size j=0; j < n; ++j) {
+            const Size i = forward ? j : n-1-j;
+            Real r = b[i];
+            for (Size k=rowStart[i]; k < rowStart[i+1]; ++k)
+                r -= value[k]*x[column[k]];
+            x[i] += r*inverseDiagonal[i];
+        }
+    }
+
+    void FdmMultigridSolver::cycle(Size level,
+                                   const Array& b, Array& x) const {
+        if (level == levels_.size()-1) {
+            x = coarseInverse_*b;
+            return;
+        }
+
+        for (Size s=0; s < smoothingSteps_; ++s)
+            smooth(level, b, x, true);
+
+        // restriction of the residual, i.e., P^T r
+        const Array r = residual(level, b, x);
+        const CsrMatrix& p = levels_[level+1].prolongation;
+        Array coarseB(levels_[level+1].a.rows());
+        p.transposeMultiply(r, coarseB);
+
+        Array coarseX(coarseB.size(), 0.0);
+        cycle(level+1, coarseB, coarseX);
+
+        // coarse-grid correction
+        Array correction(x.size());
+        p.multiply(coarseX, correction);
+        x += correction;
+
+        for (Size s=0; s < smoothingSteps_; ++s)
+            smooth(level, b, x, false);
+    }
+
+    Disposable<Array> FdmMultigridSolver::vCycle(const Array& b) const {
+        QL_REQUIRE(b.size() == levels_.front().a.rows(),
+                   "inconsistent size of rhs");
+        Array x(b.size(), 0.0);
+        cycle(0, b, x);
+        return x;
+    }
+
+    FdmMultigridResult FdmMultigridSolver::solve(const Array& b,
+                                                 const Array& x0) const {
+        const Size n = levels_.front().a.rows();
+        QL_REQUIRE(b.size() == n, "inconsistent size of rhs");
+
+        QL_REQUIRE(x0.empty() || x0.size() == n, "inconsistent size of x0");
+
+        // the V-cycles are accelerated by BiCGstab; on their own, they
+        // diverge when the smoother does, e.g., on the rows given by
+        // one-sided mixed derivatives at the corners of the mesh
+        const BiCGStabResult r = BiCGstab(
+            boost::bind(&CsrMatrix::apply, &levels_.front().a, _1),
+            maxIter_, relTol_,
+            boost::bind(&FdmMultigridSolver::vCycle, this, _1)).solve(b, x0);
+
+        FdmMultigridResult result;
+        result.iterations = r.iterations;
+        result.error = r.error;
+        result.x = r.x;
+        return result;
+    }
+
+}
+
+#endif
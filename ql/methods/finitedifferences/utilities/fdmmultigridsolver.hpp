@@ -0,0 +1,99 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmmultigridsolver.hpp
+    \brief geometric multigrid solver for finite-difference operators
+*/
+
+#ifndef quantlib_fdm_multigrid_solver_hpp
+#define quantlib_fdm_multigrid_solver_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class FdmLinearOpLayout;
+
+    struct FdmMultigridResult {
+        Size iterations;
+        Real error;
+        Array x;
+    };
+
+    //! Geometric multigrid solver for systems on a finite-difference mesh
+    /*! The coarse meshes are obtained from the layout of the fine one
+        by dropping every other point along each direction with at
+        least five points; values are transferred between meshes by
+        multi-linear interpolation and full weighting.  The coarse
+        operators are built as Galerkin products \f$ P^T A P \f$,
+        since a composite operator can't be discretized again on an
+        arbitrary mesh; the system on the coarsest mesh is solved
+        exactly.  Symmetric Gauss-Seidel sweeps are used as smoother.
+
+        solve() uses V-cycles as the preconditioner of BiCGstab, which
+        keeps it convergent when plain V-cycles are not, i.e., when
+        the matrix is far from diagonally dominant in a few rows;
+        vCycle() can also be used as a preconditioner for GMRES.
+
+        \warning the matrix is expected to have a non-zero diagonal.
+    */
+    class FdmMultigridSolver {
+      public:
+        FdmMultigridSolver(const SparseMatrix& a,
+                           const boost::shared_ptr<FdmLinearOpLayout>& layout,
+                           Size maxIter, Real relTol,
+                           Size smoothingSteps = 2);
+
+        FdmMultigridResult solve(const Array& b,
+                                 const Array& x0 = Array()) const;
+
+        //! one V-cycle starting from a null guess
+        Disposable<Array> vCycle(const Array& b) const;
+
+        Size levels() const { return levels_.size(); }
+
+      private:
+        struct Level {
+            CsrMatrix a;
+            // interpolation from this level to the next finer one
+            CsrMatrix prolongation;
+            std::vector<Real> inverseDiagonal;
+        };
+
+        void cycle(Size level, const Array& b, Array& x) const;
+        void smooth(Size level, const Array& b, Array& x, bool forward) const;
+        Disposable<Array> residual(Size level,
+                                   const Array& b, const Array& x) const;
+
+        std::vector<Level> levels_;
+        Matrix coarseInverse_;
+        const Size maxIter_;
+        const Real relTol_;
+        const Size smoothingSteps_;
+    };
+
+}
+
+#endif
+
+#endif
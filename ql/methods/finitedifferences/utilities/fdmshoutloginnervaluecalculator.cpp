@@ -0,0 +1,75 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/instruments/payoffs.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmshoutloginnervaluecalculator.hpp>
+
+namespace QuantLib {
+
+    FdmShoutLogInnerValueCalculator::FdmShoutLogInnerValueCalculator(
+        const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        Time maturity,
+        const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+        const boost::shared_ptr<FdmMesher>& mesher,
+        Size direction)
+    : process_(process), maturity_(maturity), payoff_(payoff),
+      mesher_(mesher), direction_(direction), t_(Null<Time>()),
+      riskFreeDiscount_(1.0), dividendDiscount_(1.0) {
+        QL_REQUIRE(payoff_, "plain-vanilla payoff required");
+    }
+
+    Real FdmShoutLogInnerValueCalculator::innerValue(
+                                    const FdmLinearOpIterator& iter, Time t) {
+        const Real s = std::exp(mesher_->location(iter, direction_));
+        const Real intrinsic = (*payoff_)(s);
+        if (t >= maturity_)
+            return intrinsic;
+
+        if (t != t_) {
+            riskFreeDiscount_ =
+                process_->riskFreeRate()->discount(maturity_)
+                / process_->riskFreeRate()->discount(t);
+            dividendDiscount_ =
+                process_->dividendYield()->discount(maturity_)
+                / process_->dividendYield()->discount(t);
+            t_ = t;
+        }
+
+        // after shouting, the remaining option is struck at the
+        // underlying value if it's in the money
+        const Option::Type type = payoff_->optionType();
+        const Real strike = (type == Option::Call)
+            ? std::max(s, payoff_->strike())
+            : std::min(s, payoff_->strike());
+        const Real stdDev = std::sqrt(
+            process_->blackVolatility()->blackForwardVariance(
+                                           t, maturity_, strike, true));
+        const Real forward = s*dividendDiscount_/riskFreeDiscount_;
+
+        return riskFreeDiscount_*intrinsic
+            + blackFormula(type, strike, forward, stdDev,
+                           riskFreeDiscount_);
+    }
+
+    Real FdmShoutLogInnerValueCalculator::avgInnerValue(
+                                    const FdmLinearOpIterator& iter, Time t) {
+        return innerValue(iter, t);
+    }
+}
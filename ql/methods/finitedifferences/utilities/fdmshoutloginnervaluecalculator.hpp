@@ -0,0 +1,69 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmshoutloginnervaluecalculator.hpp
+    \brief inner value of a shout option on a logarithmic mesher
+*/
+
+#ifndef quantlib_fdm_shout_log_inner_value_calculator_hpp
+#define quantlib_fdm_shout_log_inner_value_calculator_hpp
+
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+
+namespace QuantLib {
+
+    class PlainVanillaPayoff;
+    class GeneralizedBlackScholesProcess;
+
+    //! inner value of a shout option
+    /*! The holder of a shout option can lock in, once during the
+        life of the option, its intrinsic value at the shout time;
+        the payoff at maturity is then the larger of the locked-in
+        value and of the final payoff.  The value of shouting at time
+        \f$ t \f$ with the underlying at \f$ S \f$ is therefore the
+        discounted intrinsic value plus the Black value of an option
+        struck at \f$ S \f$ (or at the original strike if the option
+        is out of the money).
+
+        Used with an American step condition, this calculator prices
+        shout options.
+    */
+    class FdmShoutLogInnerValueCalculator : public FdmInnerValueCalculator {
+      public:
+        FdmShoutLogInnerValueCalculator(
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Time maturity,
+            const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+            const boost::shared_ptr<FdmMesher>& mesher,
+            Size direction);
+
+        Real innerValue(const FdmLinearOpIterator& iter, Time t);
+        Real avgInnerValue(const FdmLinearOpIterator& iter, Time t);
+
+      private:
+        const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        const Time maturity_;
+        const boost::shared_ptr<PlainVanillaPayoff> payoff_;
+        const boost::shared_ptr<FdmMesher> mesher_;
+        const Size direction_;
+        // discount factors from the last time used to maturity
+        Time t_;
+        DiscountFactor riskFreeDiscount_, dividendDiscount_;
+    };
+}
+
+#endif
@@ -84,8 +84,15 @@ namespace QuantLib {
     template <class T>
     void BlackScholesLattice<T>::stepback(Size i, const Array& values,
                                           Array& newValues) const {
-        for (Size j=0; j<size(i); j++)
-            newValues[j] = (pd_*values[j] + pu_*values[j+1])*discount_;
+        // local copies, so that the compiler doesn't need to reload
+        // them after each store and can vectorize the loop
+        const Real pd = pd_, pu = pu_;
+        const DiscountFactor discount = discount_;
+        const Real* v = values.begin();
+        Real* newV = newValues.begin();
+        const Size n = size(i);
+        for (Size j=0; j<n; j++)
+            newV[j] = (pd*v[j] + pu*v[j+1])*discount;
     }
 
 }
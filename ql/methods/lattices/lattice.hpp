@@ -28,6 +28,7 @@
 #include <ql/numericalmethod.hpp>
 #include <ql/discretizedasset.hpp>
 #include <ql/patterns/curiouslyrecurring.hpp>
+#include <ql/utilities/dataformatters.hpp>
 
 namespace QuantLib {
 
@@ -49,7 +50,13 @@ namespace QuantLib {
           void stepback(Size i,
                         const Array& values,
                         Array& newValues) const;
+          void batchStepback(Size i,
+                             const std::vector<const Array*>& values,
+                             std::vector<Array>& newValues) const;
         \endcode
+        The latter is used when several assets are rolled back
+        together; the default implementation calls stepback for each
+        of them.
 
         \ingroup lattices
     */
@@ -70,6 +77,9 @@ namespace QuantLib {
         void initialize(DiscretizedAsset&, Time t) const;
         void rollback(DiscretizedAsset&, Time to) const;
         void partialRollback(DiscretizedAsset&, Time to) const;
+        void rollback(const std::vector<DiscretizedAsset*>&, Time to) const;
+        void partialRollback(const std::vector<DiscretizedAsset*>&,
+                             Time to) const;
         //! Computes the present value of an asset using Arrow-Debrew prices
         Real presentValue(DiscretizedAsset&) const;
         //@}
@@ -80,6 +90,10 @@ namespace QuantLib {
                       const Array& values,
                       Array& newValues) const;
 
+        void batchStepback(Size i,
+                           const std::vector<const Array*>& values,
+                           std::vector<Array>& newValues) const;
+
       protected:
         void computeStatePrices(Size until) const;
 
@@ -152,17 +166,87 @@ namespace QuantLib {
         Integer iFrom = Integer(t_.index(from));
         Integer iTo = Integer(t_.index(to));
 
+        // the two buffers are swapped at each step, so that memory
+        // is only allocated when the size of the lattice changes
+        Array newValues;
         for (Integer i=iFrom-1; i>=iTo; --i) {
-            Array newValues(this->impl().size(i));
+            if (newValues.size() != this->impl().size(i))
+                newValues = Array(this->impl().size(i));
             this->impl().stepback(i, asset.values(), newValues);
             asset.time() = t_[i];
-            asset.values() = newValues;
+            asset.values().swap(newValues);
             // skip the very last adjustment
             if (i != iTo)
                 asset.adjustValues();
         }
     }
 
+    template <class Impl>
+    inline void TreeLattice<Impl>::rollback(
+                               const std::vector<DiscretizedAsset*>& assets,
+                               Time to) const {
+        partialRollback(assets,to);
+        for (Size k=0; k<assets.size(); ++k)
+            assets[k]->adjustValues();
+    }
+
+    template <class Impl>
+    void TreeLattice<Impl>::partialRollback(
+                               const std::vector<DiscretizedAsset*>& assets,
+                               Time to) const {
+
+        if (assets.empty())
+            return;
+
+        Time from = assets[0]->time();
+        for (Size k=1; k<assets.size(); ++k)
+            QL_REQUIRE(close(assets[k]->time(), from),
+                       "assets to be rolled back together must be at the "
+                       "same time (" << io::ordinal(k+1) << " asset at t = "
+                       << assets[k]->time() << ", first one at t = "
+                       << from << ")");
+
+        if (close(from,to))
+            return;
+
+        QL_REQUIRE(from > to,
+                   "cannot roll the assets back to" << to
+                   << " (they are already at t = " << from << ")");
+
+        Integer iFrom = Integer(t_.index(from));
+        Integer iTo = Integer(t_.index(to));
+
+        Size m = assets.size();
+        std::vector<const Array*> values(m);
+        std::vector<Array> newValues(m);
+        for (Integer i=iFrom-1; i>=iTo; --i) {
+            for (Size k=0; k<m; ++k) {
+                values[k] = &(assets[k]->values());
+                if (newValues[k].size() != this->impl().size(i))
+                    newValues[k] = Array(this->impl().size(i));
+            }
+            this->impl().batchStepback(i, values, newValues);
+            for (Size k=0; k<m; ++k) {
+                assets[k]->time() = t_[i];
+                assets[k]->values().swap(newValues[k]);
+            }
+            // skip the very last adjustment
+            if (i != iTo) {
+                for (Size k=0; k<m; ++k)
+                    assets[k]->adjustValues();
+            }
+        }
+    }
+
+    template <class Impl>
+    void TreeLattice<Impl>::batchStepback(
+                                    Size i,
+                                    const std::vector<const Array*>& values,
+                                    std::vector<Array>& newValues) const {
+        for (Size k=0; k<values.size(); ++k)
+            this->impl().stepback(i, *values[k], newValues[k]);
+    }
+
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
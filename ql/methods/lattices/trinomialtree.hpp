@@ -27,6 +27,7 @@
 
 #include <ql/methods/lattices/tree.hpp>
 #include <ql/timegrid.hpp>
+#include <ql/math/array.hpp>
 
 namespace QuantLib {
     class StochasticProcess1D;
@@ -53,6 +54,16 @@ namespace QuantLib {
         Size descendant(Size i, Size index, Size branch) const;
         Real probability(Size i, Size index, Size branch) const;
 
+        /*! Stores in result the expectations at the nodes of the i-th
+            level of the given values at the nodes of the next one. */
+        void expectedValues(Size i, const Array& values,
+                            Array& result) const;
+        /*! Same as above for a number of sets of values; the branch
+            data of each node are read once for all of them. */
+        void expectedValues(Size i,
+                            const std::vector<const Array*>& values,
+                            std::vector<Array>& results) const;
+
       protected:
         std::vector<Branching> branchings_;
         Real x0_;
@@ -68,6 +79,9 @@ namespace QuantLib {
             Branching();
             Size descendant(Size index, Size branch) const;
             Real probability(Size index, Size branch) const;
+            void expectedValues(const Array& values, Array& result) const;
+            void expectedValues(const std::vector<const Array*>& values,
+                                std::vector<Array>& results) const;
             Size size() const;
             Integer jMin() const;
             Integer jMax() const;
@@ -102,6 +116,18 @@ namespace QuantLib {
         return branchings_[i].probability(j, b);
     }
 
+    inline void TrinomialTree::expectedValues(Size i, const Array& values,
+                                              Array& result) const {
+        branchings_[i].expectedValues(values, result);
+    }
+
+    inline void TrinomialTree::expectedValues(
+                                    Size i,
+                                    const std::vector<const Array*>& values,
+                                    std::vector<Array>& results) const {
+        branchings_[i].expectedValues(values, results);
+    }
+
     inline TrinomialTree::Branching::Branching()
     : probs_(3), kMin_(QL_MAX_INTEGER), jMin_(QL_MAX_INTEGER),
                  kMax_(QL_MIN_INTEGER), jMax_(QL_MIN_INTEGER) {}
@@ -116,6 +142,33 @@ namespace QuantLib {
         return probs_[branch][index];
     }
 
+    inline void TrinomialTree::Branching::expectedValues(
+                                                  const Array& values,
+                                                  Array& result) const {
+        // the probabilities are stored by branch, so that each of them
+        // is read sequentially
+        const Real* p0 = &probs_[0][0];
+        const Real* p1 = &probs_[1][0];
+        const Real* p2 = &probs_[2][0];
+        for (Size j=0; j<k_.size(); ++j) {
+            const Real* v = values.begin() + (k_[j] - jMin_ - 1);
+            result[j] = p0[j]*v[0] + p1[j]*v[1] + p2[j]*v[2];
+        }
+    }
+
+    inline void TrinomialTree::Branching::expectedValues(
+                                    const std::vector<const Array*>& values,
+                                    std::vector<Array>& results) const {
+        for (Size j=0; j<k_.size(); ++j) {
+            Size d = k_[j] - jMin_ - 1;
+            Real p0 = probs_[0][j], p1 = probs_[1][j], p2 = probs_[2][j];
+            for (Size a=0; a<values.size(); ++a) {
+                const Real* v = values[a]->begin() + d;
+                results[a][j] = p0*v[0] + p1*v[1] + p2*v[2];
+            }
+        }
+    }
+
     inline Size TrinomialTree::Branching::size() const {
         return jMax_ - jMin_ + 1;
     }
@@ -1,15 +1,19 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/methods/montecarlo/blackscholesbackwardpathgenerator.hpp>
 #include <ql/methods/montecarlo/brownianbridge.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
 #include <ql/methods/montecarlo/exercisestrategy.hpp>
+#include <ql/methods/montecarlo/exposureprofile.hpp>
 #include <ql/methods/montecarlo/genericlsregression.hpp>
 #include <ql/methods/montecarlo/longstaffschwartzpathpricer.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/multipathbatch.hpp>
+#include <ql/methods/montecarlo/multipathbatchgenerator.hpp>
 #include <ql/methods/montecarlo/multipathgenerator.hpp>
 #include <ql/methods/montecarlo/nodedata.hpp>
 #include <ql/methods/montecarlo/parametricexercise.hpp>
@@ -17,4 +21,8 @@
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/methods/montecarlo/samplecommunicator.hpp>
+#include <ql/methods/montecarlo/scenariocube.hpp>
+#include <ql/methods/montecarlo/singleprecisionpaths.hpp>
+#include <ql/methods/montecarlo/spectralpathconstruction.hpp>
 
@@ -0,0 +1,105 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/montecarlo/blackscholesbackwardpathgenerator.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
+
+namespace QuantLib {
+
+    BlackScholesBackwardPathGenerator::BlackScholesBackwardPathGenerator(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             const TimeGrid& timeGrid,
+             Size samples,
+             bool antitheticVariate,
+             BigNatural seed)
+    : grid_(timeGrid), antithetic_(antitheticVariate),
+      rng_(PseudoRandom::urng_type(seed)),
+      variances_(timeGrid.size()), forwards_(timeGrid.size()),
+      brownians_(antitheticVariate ? 2*samples : samples, 0.0),
+      values_(brownians_.size()),
+      current_(Null<Size>()), path_(timeGrid) {
+
+        QL_REQUIRE(process, "null process");
+        QL_REQUIRE(samples > 0, "null number of samples");
+        QL_REQUIRE(grid_.size() > 1, "at least one time step required");
+
+        const boost::shared_ptr<BlackVolTermStructure>& vol =
+            process->blackVolatility().currentLink();
+        QL_REQUIRE(boost::dynamic_pointer_cast<BlackConstantVol>(vol)
+                   || boost::dynamic_pointer_cast<BlackVarianceCurve>(vol),
+                   "volatility must not depend on the underlying");
+
+        // the value of the process at t is a function of the
+        // driving Brownian motion W(v(t)), with v(t) the variance:
+        // S(t) = S(0) D_q(t)/D_r(t) exp(-v(t)/2 + W(v(t)))
+        const Real x0 = process->x0();
+        for (Size i=0; i<grid_.size(); ++i) {
+            const Time t = grid_[i];
+            variances_[i] = vol->blackVariance(t, x0, true);
+            forwards_[i] = x0 * process->dividendYield()->discount(t, true)
+                / process->riskFreeRate()->discount(t, true)
+                * std::exp(-0.5*variances_[i]);
+        }
+    }
+
+    void BlackScholesBackwardPathGenerator::moveTo(Size i) {
+        const Size last = grid_.size()-1;
+        QL_REQUIRE((current_ == Null<Size>() && i == last)
+                   || (current_ != Null<Size>() && current_ > 0
+                       && i == current_-1),
+                   "paths must be generated backwards from the last time; "
+                   << "time index " << i << " requested");
+
+        const Size n = brownians_.size();
+        const Size step = antithetic_ ? 2 : 1;
+        if (i == last) {
+            const Real stdDev = std::sqrt(variances_[last]);
+            for (Size j=0; j<n; j+=step)
+                brownians_[j] = stdDev*rng_.next().value;
+        } else if (variances_[i] > 0.0) {
+            // Brownian bridge between the origin and the later value
+            const Real v = variances_[i], v1 = variances_[i+1];
+            const Real weight = v/v1;
+            const Real stdDev = std::sqrt(v*(v1-v)/v1);
+            for (Size j=0; j<n; j+=step)
+                brownians_[j] = weight*brownians_[j]
+                              + stdDev*rng_.next().value;
+        } else {
+            std::fill(brownians_.begin(), brownians_.end(), 0.0);
+        }
+        if (antithetic_) {
+            for (Size j=0; j<n; j+=2)
+                brownians_[j+1] = -brownians_[j];
+        }
+
+        for (Size j=0; j<n; ++j)
+            values_[j] = forwards_[i] * std::exp(brownians_[j]);
+        current_ = i;
+    }
+
+    const Path& BlackScholesBackwardPathGenerator::path(Size j) const {
+        QL_REQUIRE(current_ != Null<Size>(), "no paths generated yet");
+        QL_REQUIRE(j < values_.size(),
+                   "path #" << j << " not available; "
+                   << values_.size() << " paths generated");
+        path_[current_] = values_[j];
+        return path_;
+    }
+
+}
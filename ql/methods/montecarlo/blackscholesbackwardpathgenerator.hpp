@@ -0,0 +1,92 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blackscholesbackwardpathgenerator.hpp
+    \brief Black-Scholes paths generated backwards by Brownian bridging
+*/
+
+#ifndef quantlib_black_scholes_backward_path_generator_hpp
+#define quantlib_black_scholes_backward_path_generator_hpp
+
+#include <ql/methods/montecarlo/path.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace QuantLib {
+
+    class GeneralizedBlackScholesProcess;
+
+    //! Black-Scholes paths generated backwards by Brownian bridging
+    /*! All the paths are moved together from the last time of the
+        grid towards the first.  The value of the driving Brownian
+        motion at the last time is drawn first; at each earlier time,
+        it is drawn conditionally on its value at the following one,
+        i.e., from the Brownian bridge between the origin and the
+        later value.  At any given time, only the current value of
+        each path is stored; the memory needed is therefore
+        proportional to the number of paths, regardless of the number
+        of time steps.
+
+        This is the order in which the Longstaff-Schwartz regression
+        needs the simulated values; see
+        LongstaffSchwartzPathPricer::calibrate.
+
+        The paths have the same distribution as those generated
+        forwards by the process, which simulates them exactly when the
+        volatility doesn't depend on the underlying; the volatility
+        structure is therefore required to be a BlackConstantVol or a
+        BlackVarianceCurve.
+
+        \warning only the value at the current time is set in the
+                 returned paths; they can only be used with pricers
+                 depending on the current value of the underlying.
+    */
+    class BlackScholesBackwardPathGenerator {
+      public:
+        typedef Path path_type;
+        /*! \param samples number of paths drawn; if the antithetic
+                           variate is used, as many antithetic paths
+                           are added.
+        */
+        BlackScholesBackwardPathGenerator(
+               const boost::shared_ptr<GeneralizedBlackScholesProcess>&,
+               const TimeGrid& timeGrid,
+               Size samples,
+               bool antitheticVariate,
+               BigNatural seed = 0);
+        //! number of paths
+        Size size() const { return values_.size(); }
+        //! moves all paths to the i-th time of the grid
+        /*! \pre the first call must be for the last time of the grid;
+                 each following one for the previous time.
+        */
+        void moveTo(Size i);
+        //! the j-th path; only its value at the current time is set
+        const Path& path(Size j) const;
+      private:
+        TimeGrid grid_;
+        bool antithetic_;
+        PseudoRandom::rng_type rng_;
+        std::vector<Real> variances_, forwards_;
+        std::vector<Real> brownians_, values_;
+        Size current_;
+        mutable Path path_;
+    };
+
+}
+
+#endif
@@ -109,5 +109,42 @@ namespace QuantLib {
         }
     }
 
+    void BrownianBridge::transformLanes(const Real* input,
+                                        Real* output,
+                                        Size lanes) const {
+        // same as transform(), with each value replaced by a row of lanes
+        Real* last = output + (size_-1)*lanes;
+        for (Size m=0; m<lanes; ++m)
+            last[m] = stdDev_[0] * input[m];
+        for (Size i=1; i<size_; ++i) {
+            Size j = leftIndex_[i];
+            Size k = rightIndex_[i];
+            Size l = bridgeIndex_[i];
+            const Real* z = input + i*lanes;
+            const Real* right = output + k*lanes;
+            Real* out = output + l*lanes;
+            const Real wr = rightWeight_[i], sigma = stdDev_[i];
+            if (j != 0) {
+                const Real* left = output + (j-1)*lanes;
+                const Real wl = leftWeight_[i];
+                for (Size m=0; m<lanes; ++m)
+                    out[m] = wl * left[m] + wr * right[m] + sigma * z[m];
+            } else {
+                for (Size m=0; m<lanes; ++m)
+                    out[m] = wr * right[m] + sigma * z[m];
+            }
+        }
+        for (Size i=size_-1; i>=1; --i) {
+            Real* out = output + i*lanes;
+            const Real* previous = output + (i-1)*lanes;
+            for (Size m=0; m<lanes; ++m) {
+                out[m] -= previous[m];
+                out[m] /= sqrtdt_[i];
+            }
+        }
+        for (Size m=0; m<lanes; ++m)
+            output[m] /= sqrtdt_[0];
+    }
+
 }
 
@@ -135,6 +135,20 @@ namespace QuantLib {
             }
             output[0] /= sqrtdt_[0];
         }
+        //! Brownian-bridge generator function for a block of paths
+        /*! Transforms the random variates of a number of paths
+            ("lanes") at once.  The i-th variate of the k-th lane is
+            read from input[i*lanes+k], and the corresponding
+            variation is written to output[i*lanes+k]; the results
+            are the same as those of transform() applied to each
+            lane, but each step of the bridge is performed for all
+            the lanes in a loop that the compiler can vectorize.
+
+            \pre input and output must not overlap.
+        */
+        void transformLanes(const Real* input,
+                            Real* output,
+                            Size lanes) const;
       private:
         void initialize();
         Size size_;
@@ -0,0 +1,124 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/montecarlo/exposureprofile.hpp>
+#include <ql/models/model.hpp>
+#include <ql/models/shortrate/onefactormodels/gaussian1dmodel.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        void checkCashFlows(const std::vector<Time>& paymentTimes,
+                            const std::vector<Real>& amounts) {
+            QL_REQUIRE(paymentTimes.size() == amounts.size(),
+                       "payment times (" << paymentTimes.size()
+                       << ") and amounts (" << amounts.size()
+                       << ") differ in size");
+        }
+
+    }
+
+    AffineCashFlowValuation::AffineCashFlowValuation(
+                                 const boost::shared_ptr<AffineModel>& model,
+                                 const std::vector<Time>& paymentTimes,
+                                 const std::vector<Real>& amounts)
+    : model_(model), paymentTimes_(paymentTimes), amounts_(amounts) {
+        QL_REQUIRE(model_, "null model");
+        checkCashFlows(paymentTimes_, amounts_);
+    }
+
+    void AffineCashFlowValuation::addValues(Time t,
+                                            const Real* states,
+                                            Size paths,
+                                            Size factors,
+                                            Real* values) const {
+        Array state(factors);
+        for (Size p=0; p<paths; ++p) {
+            std::copy(states+p*factors, states+(p+1)*factors, state.begin());
+            for (Size i=0; i<paymentTimes_.size(); ++i)
+                if (paymentTimes_[i] > t)
+                    values[p] += amounts_[i] *
+                        model_->discountBond(t, paymentTimes_[i], state);
+        }
+    }
+
+    Gaussian1dCashFlowValuation::Gaussian1dCashFlowValuation(
+                             const boost::shared_ptr<Gaussian1dModel>& model,
+                             const std::vector<Time>& paymentTimes,
+                             const std::vector<Real>& amounts)
+    : model_(model), paymentTimes_(paymentTimes), amounts_(amounts) {
+        QL_REQUIRE(model_, "null model");
+        checkCashFlows(paymentTimes_, amounts_);
+    }
+
+    void Gaussian1dCashFlowValuation::addValues(Time t,
+                                                const Real* states,
+                                                Size paths,
+                                                Size factors,
+                                                Real* values) const {
+        QL_REQUIRE(factors == 1,
+                   "one-factor states required, " << factors << " given");
+        const boost::shared_ptr<StochasticProcess1D>& process =
+            model_->stateProcess();
+        // the states are normalized as in Gaussian1dModel
+        Real mean = 0.0, stdDev = 1.0;
+        if (t > 0.0) {
+            mean = process->expectation(0.0, 0.0, t);
+            stdDev = process->stdDeviation(0.0, 0.0, t);
+        }
+        for (Size p=0; p<paths; ++p) {
+            Real y = t > 0.0 ? (states[p]-mean)/stdDev : 0.0;
+            for (Size i=0; i<paymentTimes_.size(); ++i)
+                if (paymentTimes_[i] > t)
+                    values[p] += amounts_[i] *
+                        model_->zerobond(paymentTimes_[i], t, y);
+        }
+    }
+
+
+    ExposureProfile::ExposureProfile(
+                const ScenarioCube& cube,
+                const std::vector<boost::shared_ptr<ScenarioValuation> >&
+                                                                nettingSet)
+    : times_(cube.times()), epe_(cube.dates()), ene_(cube.dates()),
+      ev_(cube.dates()) {
+        QL_REQUIRE(!nettingSet.empty(), "empty netting set");
+        for (Size k=0; k<nettingSet.size(); ++k)
+            QL_REQUIRE(nettingSet[k], "null valuation #" << k);
+
+        const Size paths = cube.paths(), factors = cube.factors();
+        std::vector<Real> values(paths);
+        for (Size d=0; d<cube.dates(); ++d) {
+            std::fill(values.begin(), values.end(), 0.0);
+            const Real* states = cube.slice(d);
+            for (Size k=0; k<nettingSet.size(); ++k)
+                nettingSet[k]->addValues(times_[d], states, paths, factors,
+                                         &values[0]);
+
+            Real positive = 0.0, negative = 0.0;
+            for (Size p=0; p<paths; ++p) {
+                positive += std::max(values[p], 0.0);
+                negative += std::min(values[p], 0.0);
+            }
+            epe_[d] = positive/paths;
+            ene_[d] = negative/paths;
+            ev_[d] = (positive+negative)/paths;
+        }
+    }
+
+}
@@ -0,0 +1,119 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file exposureprofile.hpp
+    \brief exposure profiles calculated on a scenario cube
+*/
+
+#ifndef quantlib_exposure_profile_hpp
+#define quantlib_exposure_profile_hpp
+
+#include <ql/methods/montecarlo/scenariocube.hpp>
+
+namespace QuantLib {
+
+    class AffineModel;
+    class Gaussian1dModel;
+
+    //! Valuation of an instrument on the states of a scenario cube
+    class ScenarioValuation {
+      public:
+        virtual ~ScenarioValuation() {}
+        /*! adds to the given values those of the instrument at time
+            t for the given model states; states are stored as in
+            ScenarioCube, i.e., paths by factors.
+        */
+        virtual void addValues(Time t,
+                               const Real* states,
+                               Size paths,
+                               Size factors,
+                               Real* values) const = 0;
+    };
+
+    //! Fixed cash flows valued with an affine model
+    /*! The value at time t is the sum of the cash flows paid after t,
+        each discounted with the discountBond() method of the model
+        for the given state; this works with HullWhite,
+        simulated by HullWhiteProcess, and with G2, simulated by
+        G2Process.
+    */
+    class AffineCashFlowValuation : public ScenarioValuation {
+      public:
+        AffineCashFlowValuation(const boost::shared_ptr<AffineModel>& model,
+                                const std::vector<Time>& paymentTimes,
+                                const std::vector<Real>& amounts);
+        void addValues(Time t, const Real* states, Size paths, Size factors,
+                       Real* values) const;
+      private:
+        boost::shared_ptr<AffineModel> model_;
+        std::vector<Time> paymentTimes_;
+        std::vector<Real> amounts_;
+    };
+
+    //! Fixed cash flows valued with a Gaussian one-factor model
+    /*! The states are those of the model's state process, e.g., a
+        GsrProcess; they are normalized before being passed to the
+        zerobond() method of the model.
+    */
+    class Gaussian1dCashFlowValuation : public ScenarioValuation {
+      public:
+        Gaussian1dCashFlowValuation(
+                             const boost::shared_ptr<Gaussian1dModel>& model,
+                             const std::vector<Time>& paymentTimes,
+                             const std::vector<Real>& amounts);
+        void addValues(Time t, const Real* states, Size paths, Size factors,
+                       Real* values) const;
+      private:
+        boost::shared_ptr<Gaussian1dModel> model_;
+        std::vector<Time> paymentTimes_;
+        std::vector<Real> amounts_;
+    };
+
+
+    //! Expected exposures of a netting set on a scenario cube
+    /*! The values of the instruments in the netting set are summed
+        on each path; the expected positive and negative exposures
+        and the expected value are then calculated for each date of
+        the cube.  Values and expectations are taken in the measure
+        and numeraire in which the states were simulated.
+
+        \ingroup mcarlo
+    */
+    class ExposureProfile {
+      public:
+        ExposureProfile(
+                const ScenarioCube& cube,
+                const std::vector<boost::shared_ptr<ScenarioValuation> >&
+                                                                nettingSet);
+        const std::vector<Time>& times() const { return times_; }
+        //! expected positive exposure, \f$ E[\max(V,0)] \f$
+        const std::vector<Real>& expectedPositiveExposure() const {
+            return epe_;
+        }
+        //! expected negative exposure, \f$ E[\min(V,0)] \f$
+        const std::vector<Real>& expectedNegativeExposure() const {
+            return ene_;
+        }
+        const std::vector<Real>& expectedValue() const { return ev_; }
+      private:
+        std::vector<Time> times_;
+        std::vector<Real> epe_, ene_, ev_;
+    };
+
+}
+
+#endif
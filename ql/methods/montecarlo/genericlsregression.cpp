@@ -18,8 +18,8 @@
 */
 
 #include <ql/methods/montecarlo/genericlsregression.hpp>
-#include <ql/math/statistics/sequencestatistics.hpp>
-#include <ql/math/matrixutilities/svd.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
+#include <ql/math/statistics/statistics.hpp>
 
 namespace QuantLib {
 
@@ -34,38 +34,24 @@ namespace QuantLib {
 
             std::vector<NodeData>& exerciseData = simulationData[i];
 
-            // 1) find the covariance matrix of basis function values and
-            //    deflated cash-flows
+            // 1) regress the deflated cash-flows on the basis function
+            //    values; the regression is accumulated path by path,
+            //    without storing the samples
             Size N = exerciseData.front().values.size();
-            std::vector<Real> temp(N+1);
-            SequenceStatistics stats(N+1);
+            IncrementalLinearLeastSquares regression(N);
 
             Size j;
             for (j=0; j<exerciseData.size(); ++j) {
                 if (exerciseData[j].isValid) {
-                    std::copy(exerciseData[j].values.begin(),
-                              exerciseData[j].values.end(),
-                              temp.begin());
-                    temp.back() = exerciseData[j].cumulatedCashFlows
-                                - exerciseData[j].controlValue;
-
-                    stats.add(temp);
+                    regression.add(exerciseData[j].values.begin(),
+                                   exerciseData[j].values.end(),
+                                   exerciseData[j].cumulatedCashFlows
+                                   - exerciseData[j].controlValue);
                 }
             }
 
-            std::vector<Real> means = stats.mean();
-            Matrix covariance = stats.covariance();
-
-            Matrix C(N,N);
-            Array target(N);
-            for (Size k=0; k<N; ++k) {
-                target[k] = covariance[k][N] + means[k]*means[N];
-                for (Size l=0; l<=k; ++l)
-                    C[k][l] = C[l][k] = covariance[k][l] + means[k]*means[l];
-            }
-
             // 2) solve for least squares regression
-            Array alphas = SVD(C).solveFor(target);
+            Array alphas = regression.coefficients();
             basisCoefficients[i-1].resize(N);
             std::copy(alphas.begin(), alphas.end(),
                       basisCoefficients[i-1].begin());
@@ -28,10 +28,11 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
-#include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
+#include <ql/methods/montecarlo/singleprecisionpaths.hpp>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -45,9 +46,28 @@
 #endif
 
 #include <boost/function.hpp>
+#include <numeric>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // the calibration paths stored during the calibration phase,
+        // seen through the interface of a backward path generator
+        template <class PathType>
+        class StoredPaths {
+          public:
+            explicit StoredPaths(const std::vector<PathType>& paths)
+            : paths_(paths) {}
+            Size size() const { return paths_.size(); }
+            void moveTo(Size) {}
+            const PathType& path(Size j) const { return paths_[j]; }
+          private:
+            const std::vector<PathType>& paths_;
+        };
+
+    }
+
     //! Longstaff-Schwarz path pricer for early exercise options
     /*! References:
 
@@ -55,6 +75,11 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        If required, the calibration paths are stored in single
+        precision (see SinglePrecisionPaths), which halves the memory
+        they need at the price of a small error on the regression
+        coefficients.
+
         \ingroup mcarlo
 
         \test the correctness of the returned value is tested by
@@ -68,10 +93,30 @@ namespace QuantLib {
         LongstaffSchwartzPathPricer(
             const TimeGrid& times,
             const boost::shared_ptr<EarlyExercisePathPricer<PathType> >& ,
-            const boost::shared_ptr<YieldTermStructure>& termStructure);
+            const boost::shared_ptr<YieldTermStructure>& termStructure,
+            bool singlePrecisionPaths = false);
 
         Real operator()(const PathType& path) const;
+        //! calibrates on the paths stored during the calibration phase
         virtual void calibrate();
+        //! calibrates on paths provided backwards by a generator
+        /*! The paths are not stored; they are requested from the
+            generator time by time, from the last time of the grid to
+            the first, which allows generators to keep only the current
+            value of each path in memory (see, e.g.,
+            BlackScholesBackwardPathGenerator.)
+
+            Generator must implement the following interface:
+            \code
+                Size Generator::size() const;
+                void Generator::moveTo(Size timeIndex);
+                const PathType& Generator::path(Size j) const;
+            \endcode
+            where the path returned for the j-th sample needs only be
+            correct at the time given to the last call to moveTo.
+        */
+        template <class Generator>
+        void calibrate(Generator& generator);
 
         Real exerciseProbability() const;
 
@@ -93,6 +138,9 @@ namespace QuantLib {
         const   std::vector<boost::function1<Real, StateType> > v_;
 
         const Size len_;
+
+        const bool singlePrecisionPaths_;
+        mutable SinglePrecisionPaths<PathType> compactPaths_;
     };
 
     template <class PathType> inline
@@ -100,13 +148,15 @@ namespace QuantLib {
         const TimeGrid& times,
         const boost::shared_ptr<EarlyExercisePathPricer<PathType> >&
             pathPricer,
-        const boost::shared_ptr<YieldTermStructure>& termStructure)
+        const boost::shared_ptr<YieldTermStructure>& termStructure,
+        bool singlePrecisionPaths)
     : calibrationPhase_(true),
       pathPricer_(pathPricer),
       coeff_     (new Array[times.size()-2]),
       dF_        (new DiscountFactor[times.size()-1]),
       v_         (pathPricer_->basisSystem()),
-      len_       (times.size()) {
+      len_       (times.size()),
+      singlePrecisionPaths_(singlePrecisionPaths) {
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
@@ -119,7 +169,10 @@ namespace QuantLib {
         (const PathType& path) const {
         if (calibrationPhase_) {
             // store paths for the calibration
-            paths_.push_back(path);
+            if (singlePrecisionPaths_)
+                compactPaths_.add(path);
+            else
+                paths_.push_back(path);
             // result doesn't matter
             return 0.0;
         }
@@ -157,36 +210,67 @@ namespace QuantLib {
 
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
-        const Size n = paths_.size();
+        if (singlePrecisionPaths_) {
+            calibrate(compactPaths_);
+            compactPaths_.clear();
+            return;
+        }
+
+        detail::StoredPaths<PathType> storedPaths(paths_);
+        calibrate(storedPaths);
+
+        // remove calibration paths and release memory
+        std::vector<PathType> empty;
+        paths_.swap(empty);
+    }
+
+    template <class PathType>
+    template <class Generator>
+    inline void LongstaffSchwartzPathPricer<PathType>::calibrate(
+                                                       Generator& generator) {
+        const Size n = generator.size();
         Array prices(n), exercise(n);
         std::vector<StateType> p_state(n);
         std::vector<Real> p_price(n), p_exercise(n);
 
+        generator.moveTo(len_-1);
         for (Size i=0; i<n; ++i) {
-            p_state[i] = pathPricer_->state(paths_[i],len_-1);
-            prices[i] = p_price[i] = (*pathPricer_)(paths_[i], len_-1);
+            const PathType& path = generator.path(i);
+            p_state[i] = pathPricer_->state(path,len_-1);
+            prices[i] = p_price[i] = (*pathPricer_)(path, len_-1);
             p_exercise[i] = prices[i];
         }
 
         post_processing(len_ - 1, p_state, p_price, p_exercise);
 
-        std::vector<Real>      y;
-        std::vector<StateType> x;
+        // the basis functions are evaluated once for each in-the-money
+        // path and kept for the exercise decision below; the regression
+        // is accumulated as they are evaluated, without storing the
+        // design matrix.
+        const Size m = v_.size();
+        Matrix basis(n, m);
+        IncrementalLinearLeastSquares regression(m);
         for (Size i=len_-2; i>0; --i) {
-            y.clear();
-            x.clear();
+            regression.reset();
 
             //roll back step
+            generator.moveTo(i);
+            Size itm = 0;
             for (Size j=0; j<n; ++j) {
-                exercise[j]=(*pathPricer_)(paths_[j], i);
+                const PathType& path = generator.path(j);
+                p_state[j] = pathPricer_->state(path, i);
+                exercise[j]=(*pathPricer_)(path, i);
                 if (exercise[j]>0.0) {
-                    x.push_back(pathPricer_->state(paths_[j], i));
-                    y.push_back(dF_[i]*prices[j]);
+                    const StateType& regValue = p_state[j];
+                    Matrix::row_iterator b = basis.row_begin(itm++);
+                    for (Size l=0; l<m; ++l)
+                        b[l] = v_[l](regValue);
+                    regression.add(b, b+m, dF_[i]*prices[j]);
                 }
             }
 
-            if (v_.size() <=  x.size()) {
-                coeff_[i-1] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+            if (m <= itm) {
+                coeff_[i-1] = regression.coefficients();
             }
             else {
             // if number of itm paths is smaller then the number of
@@ -197,16 +281,15 @@ namespace QuantLib {
             for (Size j=0, k=0; j<n; ++j) {
                 prices[j]*=dF_[i];
                 if (exercise[j]>0.0) {
-                    Real continuationValue = 0.0;
-                    for (Size l=0; l<v_.size(); ++l) {
-                        continuationValue += coeff_[i-1][l] * v_[l](x[k]);
-                    }
+                    const Real continuationValue =
+                        std::inner_product(coeff_[i-1].begin(),
+                                           coeff_[i-1].end(),
+                                           basis.row_begin(k), 0.0);
                     if (continuationValue < exercise[j]) {
                         prices[j] = exercise[j];
                     }
                     ++k;
                 }
-                p_state[j] = pathPricer_->state(paths_[j],i);
                 p_price[j] = prices[j];
                 p_exercise[j] = exercise[j];
             }
@@ -214,9 +297,6 @@ namespace QuantLib {
             post_processing(i, p_state, p_price, p_exercise);
         }
 
-        // remove calibration paths and release memory
-        std::vector<PathType> empty;
-        paths_.swap(empty);
         // entering the calculation phase
         calibrationPhase_ = false;
     }
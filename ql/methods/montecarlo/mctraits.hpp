@@ -29,6 +29,7 @@
 #include <ql/methods/montecarlo/multipathgenerator.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/array.hpp>
 
 namespace QuantLib {
 
@@ -45,6 +46,21 @@ namespace QuantLib {
         enum { allowsErrorEstimate = RNG::allowsErrorEstimate };
     };
 
+    //! Monte Carlo traits for single-variate models with several values
+    /*! The path pricer returns a value for each of a number of
+        instruments priced on the same path; the samples should be
+        accumulated by a sequence statistics class.
+    */
+    template <class RNG = PseudoRandom>
+    struct SingleVariateSequence {
+        typedef RNG rng_traits;
+        typedef Path path_type;
+        typedef PathPricer<path_type,Array> path_pricer_type;
+        typedef typename RNG::rsg_type rsg_type;
+        typedef PathGenerator<rsg_type> path_generator_type;
+        enum { allowsErrorEstimate = RNG::allowsErrorEstimate };
+    };
+
     //! default Monte Carlo traits for multi-variate models
     template <class RNG = PseudoRandom>
     struct MultiVariate {
@@ -27,7 +27,10 @@
 
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
+#include <ql/utilities/instrumentation.hpp>
 #include <boost/shared_ptr.hpp>
+#include <vector>
+#include <utility>
 
 namespace QuantLib {
 
@@ -79,8 +82,28 @@ namespace QuantLib {
                 isControlVariate_ = true;
         }
         void addSamples(Size samples);
+        //! draws samples without adding them to the accumulator
+        /*! The (value, weight) pairs of the drawn samples are
+            appended to the given buffer.  Together with
+            addSampleValues(), this allows several models to draw
+            samples concurrently and to accumulate them afterwards
+            in a fixed order.
+        */
+        void drawSamples(Size samples,
+                         std::vector<std::pair<result_type,Real> >& values);
+        //! adds previously drawn samples to the accumulator
+        void addSampleValues(
+                const std::vector<std::pair<result_type,Real> >& values);
+        //! skips the paths of the given number of samples
+        /*! The samples are neither drawn nor priced; this allows
+            several models, e.g., in different processes, to draw
+            disjoint blocks of samples from the same stream.  The
+            path generator must provide a jumpAhead method.
+        */
+        void jumpAhead(BigNatural samples);
         const stats_type& sampleAccumulator(void) const;
       private:
+        result_type nextSample(Real& weight);
         boost::shared_ptr<path_generator_type> pathGenerator_;
         boost::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -93,41 +116,80 @@ namespace QuantLib {
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
-    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
-        for(Size j = 1; j <= samples; j++) {
+    inline typename MonteCarloModel<MC,RNG,S>::result_type
+    MonteCarloModel<MC,RNG,S>::nextSample(Real& weight) {
+
+        const sample_type& path = pathGenerator_->next();
+        result_type price = (*pathPricer_)(path.value);
+
+        if (isControlVariate_) {
+            if (!cvPathGenerator_) {
+                price += cvOptionValue_-(*cvPathPricer_)(path.value);
+            }
+            else {
+                const sample_type& cvPath = cvPathGenerator_->next();
+                price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+            }
+        }
 
-            const sample_type& path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+        weight = path.weight;
 
+        if (isAntitheticVariate_) {
+            const sample_type& atPath = pathGenerator_->antithetic();
+            result_type price2 = (*pathPricer_)(atPath.value);
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
+                if (!cvPathGenerator_)
+                    price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
                 else {
-                    const sample_type& cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                    const sample_type& cvPath = cvPathGenerator_->antithetic();
+                    price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
                 }
             }
 
-            if (isAntitheticVariate_) {
-                const sample_type& atPath = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(atPath.value);
-                if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
-                    else {
-                        const sample_type& cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                    }
-                }
+            return result_type((price+price2)/2.0);
+        } else {
+            return price;
+        }
+    }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
-                sampleAccumulator_.add(price, path.weight);
-            }
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        QL_INSTRUMENT_SCOPE("MonteCarloModel::addSamples");
+        QL_INSTRUMENT_COUNT("MonteCarloModel::samples", samples);
+        for(Size j = 1; j <= samples; j++) {
+            Real weight;
+            result_type price = nextSample(weight);
+            sampleAccumulator_.add(price, weight);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::drawSamples(
+                       Size samples,
+                       std::vector<std::pair<result_type,Real> >& values) {
+        values.reserve(values.size()+samples);
+        for(Size j = 1; j <= samples; j++) {
+            Real weight;
+            result_type price = nextSample(weight);
+            values.push_back(std::make_pair(price, weight));
         }
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSampleValues(
+                 const std::vector<std::pair<result_type,Real> >& values) {
+        for (Size j=0; j<values.size(); j++)
+            sampleAccumulator_.add(values[j].first, values[j].second);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::jumpAhead(BigNatural samples) {
+        // antithetic paths are obtained from the same draws
+        pathGenerator_->jumpAhead(samples);
+        if (cvPathGenerator_)
+            cvPathGenerator_->jumpAhead(samples);
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline const typename MonteCarloModel<MC,RNG,S>::stats_type&
     MonteCarloModel<MC,RNG,S>::sampleAccumulator() const {
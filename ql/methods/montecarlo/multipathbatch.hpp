@@ -0,0 +1,101 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multipathbatch.hpp
+    \brief Batch of multiple asset paths in struct-of-arrays layout
+*/
+
+#ifndef quantlib_montecarlo_multi_path_batch_hpp
+#define quantlib_montecarlo_multi_path_batch_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! Batch of multiple asset paths in struct-of-arrays layout
+    /*! The values of a number of independent multi-asset paths
+        ("lanes") are stored by time, i.e., batch[i][j][k] is the
+        value of the j-th asset at the i-th time on the k-th lane.
+        At each time, the values of the same asset on all the lanes
+        are contiguous in memory.
+
+        \ingroup mcarlo
+    */
+    class MultiPathBatch {
+      public:
+        MultiPathBatch() {}
+        MultiPathBatch(Size nAsset,
+                       const TimeGrid& timeGrid,
+                       Size lanes);
+        //! \name inspectors
+        //@{
+        Size assetNumber() const { return nAsset_; }
+        Size pathSize() const { return values_.size(); }
+        Size lanes() const { return weights_.size(); }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //! weight of the path on the k-th lane
+        Real weight(Size k) const { return weights_[k]; }
+        //@}
+        //! \name read/write access to components
+        //@{
+        //! values of all the assets (rows) on all the lanes (columns)
+        const Matrix& operator[](Size i) const { return values_[i]; }
+        Matrix& operator[](Size i) { return values_[i]; }
+        Real& weight(Size k) { return weights_[k]; }
+        //@}
+        //! \name utilities
+        //@{
+        //! copies the path on the k-th lane, e.g., for a path pricer
+        void path(Size k, MultiPath& multiPath) const;
+        //@}
+      private:
+        Size nAsset_;
+        TimeGrid timeGrid_;
+        std::vector<Matrix> values_;
+        std::vector<Real> weights_;
+    };
+
+
+    // inline definitions
+
+    inline MultiPathBatch::MultiPathBatch(Size nAsset,
+                                          const TimeGrid& timeGrid,
+                                          Size lanes)
+    : nAsset_(nAsset), timeGrid_(timeGrid),
+      values_(timeGrid.size(), Matrix(nAsset, lanes)),
+      weights_(lanes, 1.0) {
+        QL_REQUIRE(nAsset > 0, "number of asset must be positive");
+        QL_REQUIRE(lanes > 0, "number of lanes must be positive");
+    }
+
+    inline void MultiPathBatch::path(Size k, MultiPath& multiPath) const {
+        QL_REQUIRE(k < lanes(),
+                   "lane #" << k << " not available; "
+                   << lanes() << " lanes in batch");
+        if (multiPath.assetNumber() != nAsset_
+            || multiPath.pathSize() != pathSize())
+            multiPath = MultiPath(nAsset_, timeGrid_);
+        for (Size i=0; i<values_.size(); ++i)
+            for (Size j=0; j<nAsset_; ++j)
+                multiPath[j][i] = values_[i][j][k];
+    }
+
+}
+
+
+#endif
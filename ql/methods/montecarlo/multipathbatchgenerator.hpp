@@ -0,0 +1,235 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multipathbatchgenerator.hpp
+    \brief Generates a batch of multi paths from a random-array generator
+*/
+
+#ifndef quantlib_multi_path_batch_generator_hpp
+#define quantlib_multi_path_batch_generator_hpp
+
+#include <ql/methods/montecarlo/multipathbatch.hpp>
+#include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/spectralpathconstruction.hpp>
+#include <ql/stochasticprocess.hpp>
+
+namespace QuantLib {
+
+    //! Generates a batch of multipaths from a random number generator.
+    /*! The paths are the same that a MultiPathGenerator would return
+        by drawing the same sequences one after the other; however,
+        all the lanes are evolved together at each time step through
+        StochasticProcess::evolveBatch(), so that the processes can
+        calculate their time-dependent quantities and perform the
+        correlation of the factors once per step for all the lanes.
+
+        Path pricers written for MultiPath can be applied to each
+        lane by means of MultiPathBatch::path().
+
+        For one-factor processes, the random numbers can be
+        transformed by a Brownian bridge as in PathGenerator; the
+        bridge is applied to all the lanes together.  For any number
+        of factors, a SpectralPathConstruction can be used instead;
+        it is applied to the whole batch as a blocked matrix product.
+
+        \ingroup mcarlo
+
+        \test the generated paths are checked against those returned
+              by MultiPathGenerator.
+    */
+    template <class GSG>
+    class MultiPathBatchGenerator {
+      public:
+        typedef MultiPathBatch sample_type;
+        MultiPathBatchGenerator(const boost::shared_ptr<StochasticProcess>&,
+                                const TimeGrid&,
+                                GSG generator,
+                                Size lanes,
+                                bool brownianBridge = false);
+        MultiPathBatchGenerator(
+                        const boost::shared_ptr<StochasticProcess>&,
+                        const TimeGrid&,
+                        GSG generator,
+                        Size lanes,
+                        const SpectralPathConstruction& construction);
+        const sample_type& next() const;
+        const sample_type& antithetic() const;
+      private:
+        const sample_type& next(bool antithetic) const;
+        void checkDimension(const TimeGrid& times) const;
+        boost::shared_ptr<StochasticProcess> process_;
+        GSG generator_;
+        bool brownianBridge_;
+        BrownianBridge bb_;
+        SpectralPathConstruction construction_;
+        mutable sample_type next_;
+        // the random numbers of the last batch, by time step
+        mutable std::vector<Matrix> dw_;
+        mutable Matrix temp_;
+        // the sequences of the last batch by dimension, before and
+        // after the Brownian bridge or the spectral construction
+        mutable std::vector<Real> variates_, bridged_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    MultiPathBatchGenerator<GSG>::MultiPathBatchGenerator(
+                   const boost::shared_ptr<StochasticProcess>& process,
+                   const TimeGrid& times,
+                   GSG generator,
+                   Size lanes,
+                   bool brownianBridge)
+    : process_(process), generator_(generator),
+      brownianBridge_(brownianBridge), bb_(times),
+      next_(process->size(), times, lanes),
+      dw_(times.size()-1, Matrix(process->factors(), lanes)),
+      temp_(process->factors(), lanes) {
+        checkDimension(times);
+        if (brownianBridge_) {
+            QL_REQUIRE(process->factors() == 1,
+                       "Brownian bridge only supported for "
+                       "one-factor processes");
+            variates_.resize((times.size()-1)*lanes);
+            bridged_.resize((times.size()-1)*lanes);
+        }
+    }
+
+    template <class GSG>
+    MultiPathBatchGenerator<GSG>::MultiPathBatchGenerator(
+                   const boost::shared_ptr<StochasticProcess>& process,
+                   const TimeGrid& times,
+                   GSG generator,
+                   Size lanes,
+                   const SpectralPathConstruction& construction)
+    : process_(process), generator_(generator),
+      brownianBridge_(false), bb_(times), construction_(construction),
+      next_(process->size(), times, lanes),
+      dw_(times.size()-1, Matrix(process->factors(), lanes)),
+      temp_(process->factors(), lanes),
+      variates_(generator.dimension()*lanes),
+      bridged_(generator.dimension()*lanes) {
+        checkDimension(times);
+        QL_REQUIRE(!construction_.empty(), "empty path construction");
+        QL_REQUIRE(construction_.timeGrid().size() == times.size() &&
+                   std::equal(times.begin(), times.end(),
+                              construction_.timeGrid().begin()),
+                   "path construction built on a different time grid");
+        QL_REQUIRE(construction_.factors() == process->factors(),
+                   "path construction for " << construction_.factors()
+                   << " factors given for a process with "
+                   << process->factors() << " factors");
+    }
+
+    template <class GSG>
+    void MultiPathBatchGenerator<GSG>::checkDimension(
+                                           const TimeGrid& times) const {
+        QL_REQUIRE(generator_.dimension() ==
+                   process_->factors()*(times.size()-1),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << process_->factors() << " * " << times.size()-1
+                   << ") the number of factors "
+                   << "times the number of time steps");
+        QL_REQUIRE(times.size() > 1,
+                   "no times given");
+    }
+
+    template <class GSG>
+    inline const typename MultiPathBatchGenerator<GSG>::sample_type&
+    MultiPathBatchGenerator<GSG>::next() const {
+        return next(false);
+    }
+
+    template <class GSG>
+    inline const typename MultiPathBatchGenerator<GSG>::sample_type&
+    MultiPathBatchGenerator<GSG>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG>
+    const typename MultiPathBatchGenerator<GSG>::sample_type&
+    MultiPathBatchGenerator<GSG>::next(bool antithetic) const {
+
+        typedef typename GSG::sample_type sequence_type;
+
+        const Size m = process_->size();
+        const Size n = process_->factors();
+        const Size lanes = next_.lanes();
+
+        if (!antithetic && brownianBridge_) {
+            const Size steps = dw_.size();
+            for (Size k=0; k<lanes; ++k) {
+                const sequence_type& sequence = generator_.nextSequence();
+                next_.weight(k) = sequence.weight;
+                for (Size i=0; i<steps; ++i)
+                    variates_[i*lanes+k] = sequence.value[i];
+            }
+            bb_.transformLanes(&variates_[0], &bridged_[0], lanes);
+            for (Size i=0; i<steps; ++i)
+                std::copy(bridged_.begin()+i*lanes,
+                          bridged_.begin()+(i+1)*lanes,
+                          dw_[i].row_begin(0));
+        } else if (!antithetic && !construction_.empty()) {
+            const Size dimension = dw_.size()*n;
+            for (Size k=0; k<lanes; ++k) {
+                const sequence_type& sequence = generator_.nextSequence();
+                next_.weight(k) = sequence.weight;
+                for (Size d=0; d<dimension; ++d)
+                    variates_[d*lanes+k] = sequence.value[d];
+            }
+            construction_.transformLanes(&variates_[0], &bridged_[0],
+                                         lanes);
+            for (Size i=0; i<dw_.size(); ++i)
+                for (Size f=0; f<n; ++f)
+                    std::copy(bridged_.begin()+(i*n+f)*lanes,
+                              bridged_.begin()+(i*n+f+1)*lanes,
+                              dw_[i].row_begin(f));
+        } else if (!antithetic) {
+            for (Size k=0; k<lanes; ++k) {
+                const sequence_type& sequence = generator_.nextSequence();
+                next_.weight(k) = sequence.weight;
+                for (Size i=0; i<dw_.size(); ++i)
+                    for (Size f=0; f<n; ++f)
+                        dw_[i][f][k] = sequence.value[i*n+f];
+            }
+        }
+
+        const Array asset = process_->initialValues();
+        for (Size j=0; j<m; ++j)
+            std::fill(next_[0].row_begin(j), next_[0].row_end(j), asset[j]);
+
+        const TimeGrid& timeGrid = next_.timeGrid();
+        for (Size i=1; i<next_.pathSize(); ++i) {
+            const Time t = timeGrid[i-1];
+            const Time dt = timeGrid.dt(i-1);
+            if (antithetic) {
+                std::transform(dw_[i-1].begin(), dw_[i-1].end(),
+                               temp_.begin(), std::negate<Real>());
+                process_->evolveBatch(t, next_[i-1], dt, temp_, next_[i]);
+            } else {
+                process_->evolveBatch(t, next_[i-1], dt, dw_[i-1],
+                                      next_[i]);
+            }
+        }
+        return next_;
+    }
+
+}
+
+#endif
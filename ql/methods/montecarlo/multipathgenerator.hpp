@@ -29,6 +29,7 @@
 
 #include <ql/methods/montecarlo/multipath.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/methods/montecarlo/spectralpathconstruction.hpp>
 #include <ql/stochasticprocess.hpp>
 
 namespace QuantLib {
@@ -42,6 +43,10 @@ namespace QuantLib {
         };
         \endcode
 
+        The random sequences can be transformed into paths by a
+        SpectralPathConstruction built on the same time grid, which
+        makes better use of low-discrepancy sequences.
+
         \ingroup mcarlo
 
         \test the generated paths are checked against cached results
@@ -54,14 +59,25 @@ namespace QuantLib {
                            const TimeGrid&,
                            GSG generator,
                            bool brownianBridge = false);
+        MultiPathGenerator(const boost::shared_ptr<StochasticProcess>&,
+                           const TimeGrid&,
+                           GSG generator,
+                           const SpectralPathConstruction& construction);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        //! skips the given number of paths
+        /*! GSG must provide a jumpAhead method. */
+        void jumpAhead(BigNatural n) { generator_.jumpAhead(n); }
       private:
         const sample_type& next(bool antithetic) const;
+        void checkDimension(const TimeGrid& times) const;
         bool brownianBridge_;
         boost::shared_ptr<StochasticProcess> process_;
         GSG generator_;
         mutable sample_type next_;
+        SpectralPathConstruction construction_;
+        // the last sequence after the spectral construction
+        mutable typename GSG::sample_type::value_type variations_;
     };
 
 
@@ -75,12 +91,39 @@ namespace QuantLib {
                    bool brownianBridge)
     : brownianBridge_(brownianBridge), process_(process),
       generator_(generator), next_(MultiPath(process->size(), times), 1.0) {
+        checkDimension(times);
+    }
+
+    template <class GSG>
+    MultiPathGenerator<GSG>::MultiPathGenerator(
+                   const boost::shared_ptr<StochasticProcess>& process,
+                   const TimeGrid& times,
+                   GSG generator,
+                   const SpectralPathConstruction& construction)
+    : brownianBridge_(false), process_(process),
+      generator_(generator), next_(MultiPath(process->size(), times), 1.0),
+      construction_(construction) {
+        checkDimension(times);
+        QL_REQUIRE(!construction_.empty(), "empty path construction");
+        QL_REQUIRE(construction_.timeGrid().size() == times.size() &&
+                   std::equal(times.begin(), times.end(),
+                              construction_.timeGrid().begin()),
+                   "path construction built on a different time grid");
+        QL_REQUIRE(construction_.factors() == process->factors(),
+                   "path construction for " << construction_.factors()
+                   << " factors given for a process with "
+                   << process->factors() << " factors");
+        variations_.resize(construction_.size());
+    }
 
+    template <class GSG>
+    void MultiPathGenerator<GSG>::checkDimension(
+                                           const TimeGrid& times) const {
         QL_REQUIRE(generator_.dimension() ==
-                   process->factors()*(times.size()-1),
+                   process_->factors()*(times.size()-1),
                    "dimension (" << generator_.dimension()
                    << ") is not equal to ("
-                   << process->factors() << " * " << times.size()-1
+                   << process_->factors() << " * " << times.size()-1
                    << ") the number of factors "
                    << "times the number of time steps");
         QL_REQUIRE(times.size() > 1,
@@ -114,6 +157,15 @@ namespace QuantLib {
                 antithetic ? generator_.lastSequence()
                            : generator_.nextSequence();
 
+            // the construction is linear, so that the antithetic
+            // variations are the opposite of the last ones
+            if (!construction_.empty() && !antithetic)
+                construction_.transform(sequence_.value.begin(),
+                                        sequence_.value.end(),
+                                        variations_.begin());
+            const typename sequence_type::value_type& variations =
+                construction_.empty() ? sequence_.value : variations_;
+
             Size m = process_->size();
             Size n = process_->factors();
 
@@ -133,13 +185,13 @@ namespace QuantLib {
                 t = timeGrid[i-1];
                 dt = timeGrid.dt(i-1);
                 if (antithetic)
-                    std::transform(sequence_.value.begin()+offset,
-                                   sequence_.value.begin()+offset+n,
+                    std::transform(variations.begin()+offset,
+                                   variations.begin()+offset+n,
                                    temp.begin(),
                                    std::negate<Real>());
                 else
-                    std::copy(sequence_.value.begin()+offset,
-                              sequence_.value.begin()+offset+n,
+                    std::copy(variations.begin()+offset,
+                              variations.begin()+offset+n,
                               temp.begin());
 
                 asset = process_->evolve(t, asset, dt, temp);
@@ -61,6 +61,9 @@ namespace QuantLib {
         Size size() const { return dimension_; }
         const TimeGrid& timeGrid() const { return timeGrid_; }
         //@}
+        //! skips the given number of paths
+        /*! GSG must provide a jumpAhead method. */
+        void jumpAhead(BigNatural n) { generator_.jumpAhead(n); }
       private:
         const sample_type& next(bool antithetic) const;
         bool brownianBridge_;
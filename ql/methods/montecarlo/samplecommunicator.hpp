@@ -0,0 +1,177 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file samplecommunicator.hpp
+    \brief exchange of Monte Carlo samples among processes
+*/
+
+#ifndef quantlib_sample_communicator_hpp
+#define quantlib_sample_communicator_hpp
+
+#include <ql/types.hpp>
+#include <ql/errors.hpp>
+#include <vector>
+
+#if defined(QL_ENABLE_MPI)
+#include <boost/static_assert.hpp>
+#include <mpi.h>
+#include <algorithm>
+#endif
+
+namespace QuantLib {
+
+    //! Exchange of Monte Carlo samples among processes
+    /*! A simulation distributed among several processes draws a
+        block of samples in each of them; the drawn values are then
+        collected through this interface.  The calls are collective:
+        they must be performed by all the processes, in the same
+        order.
+
+        \ingroup mcarlo
+    */
+    class SampleCommunicator {
+      public:
+        virtual ~SampleCommunicator() {}
+        //! index of the calling process
+        virtual Size rank() const = 0;
+        //! number of processes
+        virtual Size size() const = 0;
+        //! collects the data of all processes in each of them
+        /*! On return, values[i] holds the data passed by the i-th
+            process.
+        */
+        virtual void allGather(
+                     const std::vector<Real>& data,
+                     std::vector<std::vector<Real> >& values) const = 0;
+        //! collects the data of all processes in the first one
+        /*! On return, values[i] holds the data passed by the i-th
+            process in the first process, and values is empty in the
+            others.
+        */
+        virtual void gather(
+                     const std::vector<Real>& data,
+                     std::vector<std::vector<Real> >& values) const = 0;
+    };
+
+
+    #if defined(QL_ENABLE_MPI)
+
+    //! Sample communicator based on MPI
+    /*! MPI must have been initialized by the caller before the
+        communicator is built, and finalized after it is no longer
+        used.
+
+        \ingroup mcarlo
+    */
+    class MpiSampleCommunicator : public SampleCommunicator {
+      public:
+        explicit MpiSampleCommunicator(
+                                  MPI_Comm communicator = MPI_COMM_WORLD);
+        Size rank() const { return rank_; }
+        Size size() const { return size_; }
+        void allGather(const std::vector<Real>& data,
+                       std::vector<std::vector<Real> >& values) const;
+        void gather(const std::vector<Real>& data,
+                    std::vector<std::vector<Real> >& values) const;
+      private:
+        void collect(const std::vector<Real>& data,
+                     std::vector<std::vector<Real> >& values,
+                     bool toAll) const;
+        MPI_Comm communicator_;
+        Size rank_, size_;
+    };
+
+
+    // inline definitions
+
+    inline MpiSampleCommunicator::MpiSampleCommunicator(
+                                                 MPI_Comm communicator)
+    : communicator_(communicator) {
+        int initialized = 0;
+        MPI_Initialized(&initialized);
+        QL_REQUIRE(initialized, "MPI not initialized");
+        int rank, size;
+        QL_REQUIRE(MPI_Comm_rank(communicator_, &rank) == MPI_SUCCESS &&
+                   MPI_Comm_size(communicator_, &size) == MPI_SUCCESS,
+                   "unable to query MPI communicator");
+        rank_ = rank;
+        size_ = size;
+    }
+
+    inline void MpiSampleCommunicator::allGather(
+                          const std::vector<Real>& data,
+                          std::vector<std::vector<Real> >& values) const {
+        collect(data, values, true);
+    }
+
+    inline void MpiSampleCommunicator::gather(
+                          const std::vector<Real>& data,
+                          std::vector<std::vector<Real> >& values) const {
+        collect(data, values, false);
+    }
+
+    inline void MpiSampleCommunicator::collect(
+                                 const std::vector<Real>& data,
+                                 std::vector<std::vector<Real> >& values,
+                                 bool toAll) const {
+        // the data are sent as MPI_DOUBLE
+        BOOST_STATIC_ASSERT(sizeof(Real) == sizeof(double));
+
+        int n = static_cast<int>(data.size());
+        std::vector<int> counts(size_), offsets(size_);
+        int result = toAll ?
+            MPI_Allgather(&n, 1, MPI_INT, &counts[0], 1, MPI_INT,
+                          communicator_) :
+            MPI_Gather(&n, 1, MPI_INT, &counts[0], 1, MPI_INT,
+                       0, communicator_);
+        QL_REQUIRE(result == MPI_SUCCESS,
+                   "unable to collect sample sizes (MPI error "
+                   << result << ")");
+
+        int total = 0;
+        for (Size i=0; i<size_; ++i) {
+            offsets[i] = total;
+            total += counts[i];
+        }
+        std::vector<Real> buffer(std::max(total, 1));
+        Real* sent = data.empty() ? &buffer[0] : const_cast<Real*>(&data[0]);
+        result = toAll ?
+            MPI_Allgatherv(sent, n, MPI_DOUBLE,
+                           &buffer[0], &counts[0], &offsets[0], MPI_DOUBLE,
+                           communicator_) :
+            MPI_Gatherv(sent, n, MPI_DOUBLE,
+                        &buffer[0], &counts[0], &offsets[0], MPI_DOUBLE,
+                        0, communicator_);
+        QL_REQUIRE(result == MPI_SUCCESS,
+                   "unable to collect samples (MPI error "
+                   << result << ")");
+
+        values.clear();
+        if (toAll || rank_ == 0) {
+            values.resize(size_);
+            for (Size i=0; i<size_; ++i)
+                values[i].assign(buffer.begin() + offsets[i],
+                                 buffer.begin() + offsets[i] + counts[i]);
+        }
+    }
+
+    #endif
+
+}
+
+
+#endif
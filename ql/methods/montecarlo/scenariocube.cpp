@@ -0,0 +1,147 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/montecarlo/scenariocube.hpp>
+#include <ql/utilities/null.hpp>
+#include <cstdio>
+
+namespace QuantLib {
+
+    ScenarioCube::ScenarioCube(const std::vector<Time>& times,
+                               Size paths,
+                               Size factors,
+                               Precision precision)
+    : times_(times), paths_(paths), factors_(factors),
+      precision_(precision), bufferedDate_(Null<Size>()) {
+        QL_REQUIRE(!times_.empty(), "no dates given");
+        QL_REQUIRE(paths_ > 0, "null number of paths");
+        QL_REQUIRE(factors_ > 0, "null number of factors");
+        for (Size i=1; i<times_.size(); ++i)
+            QL_REQUIRE(times_[i] > times_[i-1],
+                       "times must be strictly increasing");
+        Size n = times_.size()*paths_*factors_;
+        if (precision_ == Single) {
+            singleData_.resize(n);
+            buffer_.resize(paths_*factors_);
+        } else {
+            data_.resize(n);
+        }
+    }
+
+    ScenarioCube::ScenarioCube(const std::vector<Time>& times,
+                               Size paths,
+                               Size factors,
+                               const std::string& fileName,
+                               Precision precision)
+    : times_(times), paths_(paths), factors_(factors), fileName_(fileName),
+      precision_(precision), buffer_(paths*factors),
+      bufferedDate_(Null<Size>()) {
+        QL_REQUIRE(!times_.empty(), "no dates given");
+        QL_REQUIRE(paths_ > 0, "null number of paths");
+        QL_REQUIRE(factors_ > 0, "null number of factors");
+        for (Size i=1; i<times_.size(); ++i)
+            QL_REQUIRE(times_[i] > times_[i-1],
+                       "times must be strictly increasing");
+        QL_REQUIRE(!fileName_.empty(), "empty file name given");
+
+        file_.open(fileName_.c_str(), std::ios::in | std::ios::out |
+                                      std::ios::binary | std::ios::trunc);
+        QL_REQUIRE(file_.is_open(), "unable to open " << fileName_);
+        // allocate the whole file
+        std::vector<char> zeros(buffer_.size()*valueSize(), 0);
+        for (Size d=0; d<times_.size(); ++d)
+            file_.write(&zeros[0], zeros.size());
+        QL_REQUIRE(file_.good(), "unable to write to " << fileName_);
+    }
+
+    ScenarioCube::~ScenarioCube() {
+        if (onDisk()) {
+            file_.close();
+            std::remove(fileName_.c_str());
+        }
+    }
+
+    void ScenarioCube::checkDate(Size date) const {
+        QL_REQUIRE(date < times_.size(),
+                   "date #" << date << " not available; "
+                   << times_.size() << " dates given");
+    }
+
+    Size ScenarioCube::valueSize() const {
+        return precision_ == Single ? sizeof(float) : sizeof(Real);
+    }
+
+    void ScenarioCube::write(Size date, Size firstPath, Size n,
+                             const Real* states) {
+        checkDate(date);
+        QL_REQUIRE(firstPath+n <= paths_,
+                   "paths [" << firstPath << ", " << firstPath+n
+                   << ") out of range; " << paths_ << " paths given");
+        Size offset = (date*paths_ + firstPath)*factors_;
+        if (bufferedDate_ == date)
+            bufferedDate_ = Null<Size>();
+        if (onDisk()) {
+            file_.seekp(offset*valueSize());
+            if (precision_ == Single) {
+                std::vector<float> values(states, states+n*factors_);
+                file_.write(reinterpret_cast<const char*>(&values[0]),
+                            values.size()*sizeof(float));
+            } else {
+                file_.write(reinterpret_cast<const char*>(states),
+                            n*factors_*sizeof(Real));
+            }
+            QL_REQUIRE(file_.good(), "unable to write to " << fileName_);
+        } else if (precision_ == Single) {
+            for (Size i=0; i<n*factors_; ++i)
+                singleData_[offset+i] = static_cast<float>(states[i]);
+        } else {
+            std::copy(states, states+n*factors_, data_.begin()+offset);
+        }
+    }
+
+    const Real* ScenarioCube::slice(Size date) const {
+        checkDate(date);
+        if (!onDisk() && precision_ == Double)
+            return &data_[date*paths_*factors_];
+
+        if (bufferedDate_ != date) {
+            Size n = paths_*factors_;
+            if (!onDisk()) {
+                std::copy(singleData_.begin() + date*n,
+                          singleData_.begin() + (date+1)*n,
+                          buffer_.begin());
+            } else if (precision_ == Single) {
+                std::vector<float> values(n);
+                file_.seekg(date*n*sizeof(float));
+                file_.read(reinterpret_cast<char*>(&values[0]),
+                           n*sizeof(float));
+                QL_REQUIRE(file_.good(),
+                           "unable to read from " << fileName_);
+                std::copy(values.begin(), values.end(), buffer_.begin());
+            } else {
+                file_.seekg(date*n*sizeof(Real));
+                file_.read(reinterpret_cast<char*>(&buffer_[0]),
+                           n*sizeof(Real));
+                QL_REQUIRE(file_.good(),
+                           "unable to read from " << fileName_);
+            }
+            bufferedDate_ = date;
+        }
+        return &buffer_[0];
+    }
+
+}
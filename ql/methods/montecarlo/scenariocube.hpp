@@ -0,0 +1,153 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file scenariocube.hpp
+    \brief storage of simulated model states on a date grid
+*/
+
+#ifndef quantlib_scenario_cube_hpp
+#define quantlib_scenario_cube_hpp
+
+#include <ql/methods/montecarlo/multipathgenerator.hpp>
+#include <ql/methods/montecarlo/mctraits.hpp>
+#include <boost/noncopyable.hpp>
+#include <fstream>
+#include <string>
+
+namespace QuantLib {
+
+    //! Simulated states of a model on a grid of dates
+    /*! The cube stores, for each date, path and factor, the state of
+        a process; it is filled once and can then be used to evaluate
+        any number of instruments, e.g., by ExposureProfile.
+
+        The values are stored by date; for each date, the states of
+        all paths follow each other, and the factors of each state
+        are contiguous.  The cube is either kept in memory or, when
+        a file name is given, stored in that file with the same
+        layout as raw native-endian doubles; in the latter case, only
+        the slice of the date being read is kept in memory.  The file
+        is removed when the cube is destroyed.
+
+        If required, the values are stored in single precision, in
+        memory or on disk, which halves the size of the cube; the
+        slices are still returned in double precision, with a relative
+        error of the order of the single-precision epsilon.
+
+        \ingroup mcarlo
+    */
+    class ScenarioCube : private boost::noncopyable {
+      public:
+        enum Precision { Double, Single };
+        //! cube kept in memory
+        ScenarioCube(const std::vector<Time>& times,
+                     Size paths,
+                     Size factors,
+                     Precision precision = Double);
+        //! cube stored in the given file, which is overwritten
+        ScenarioCube(const std::vector<Time>& times,
+                     Size paths,
+                     Size factors,
+                     const std::string& fileName,
+                     Precision precision = Double);
+        ~ScenarioCube();
+        //! \name Inspectors
+        //@{
+        const std::vector<Time>& times() const { return times_; }
+        Size dates() const { return times_.size(); }
+        Size paths() const { return paths_; }
+        Size factors() const { return factors_; }
+        bool onDisk() const { return !fileName_.empty(); }
+        Precision precision() const { return precision_; }
+        //@}
+        //! \name Data access
+        //@{
+        /*! stores the states of the n paths starting at the given
+            one, i.e., n*factors() values, on the given date.
+        */
+        void write(Size date, Size firstPath, Size n, const Real* states);
+        /*! returns the paths()*factors() states on the given date.
+            For cubes stored on disk or in single precision, the
+            returned pointer is only valid until the next call.
+        */
+        const Real* slice(Size date) const;
+        //@}
+      private:
+        void checkDate(Size date) const;
+        Size valueSize() const;
+        std::vector<Time> times_;
+        Size paths_, factors_;
+        std::string fileName_;
+        Precision precision_;
+        std::vector<Real> data_;
+        std::vector<float> singleData_;
+        mutable std::fstream file_;
+        mutable std::vector<Real> buffer_;
+        mutable Size bufferedDate_;
+    };
+
+
+    //! fills the cube with paths of the given process
+    /*! The process is evolved from one date of the cube to the next
+        with its own discretization; processes with exact evolution,
+        such as HullWhiteProcess or G2Process, need no intermediate
+        steps.
+    */
+    template <class RNG>
+    void simulateScenarioCube(
+                        ScenarioCube& cube,
+                        const boost::shared_ptr<StochasticProcess>& process,
+                        BigNatural seed = 0) {
+        QL_REQUIRE(process, "null process");
+        QL_REQUIRE(process->size() == cube.factors(),
+                   "process size (" << process->size() << ") differs "
+                   "from the number of factors of the cube ("
+                   << cube.factors() << ")");
+
+        const std::vector<Time>& times = cube.times();
+        TimeGrid grid(times.begin(), times.end());
+        std::vector<Size> index(times.size());
+        for (Size d=0; d<times.size(); ++d)
+            index[d] = grid.index(times[d]);
+
+        typedef typename RNG::rsg_type rsg_type;
+        rsg_type rsg = RNG::make_sequence_generator(
+                                   process->factors()*(grid.size()-1), seed);
+        MultiPathGenerator<rsg_type> generator(process, grid, rsg, false);
+
+        // paths are generated in blocks, so that each date can be
+        // written in one go
+        const Size paths = cube.paths(), factors = cube.factors();
+        const Size blockSize = std::min<Size>(paths, 1024);
+        std::vector<std::vector<Real> > block(times.size(),
+                                   std::vector<Real>(blockSize*factors));
+        for (Size first=0; first<paths; first+=blockSize) {
+            Size n = std::min(blockSize, paths-first);
+            for (Size p=0; p<n; ++p) {
+                const MultiPath& path = generator.next().value;
+                for (Size d=0; d<times.size(); ++d)
+                    for (Size f=0; f<factors; ++f)
+                        block[d][p*factors+f] = path[f][index[d]];
+            }
+            for (Size d=0; d<times.size(); ++d)
+                cube.write(d, first, n, &block[d][0]);
+        }
+    }
+
+}
+
+#endif
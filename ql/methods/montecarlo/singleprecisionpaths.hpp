@@ -0,0 +1,169 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file singleprecisionpaths.hpp
+    \brief set of paths stored in single precision
+*/
+
+#ifndef quantlib_single_precision_paths_hpp
+#define quantlib_single_precision_paths_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        inline Size pathAssets(const Path&) { return 1; }
+        inline Size pathAssets(const MultiPath& p) { return p.assetNumber(); }
+
+        inline Size pathLength(const Path& p) { return p.length(); }
+        inline Size pathLength(const MultiPath& p) { return p.pathSize(); }
+
+        inline Real pathValue(const Path& p, Size, Size i) { return p[i]; }
+        inline Real pathValue(const MultiPath& p, Size a, Size i) {
+            return p[a][i];
+        }
+
+        inline Real& pathValue(Path& p, Size, Size i) { return p[i]; }
+        inline Real& pathValue(MultiPath& p, Size a, Size i) {
+            return p[a][i];
+        }
+
+    }
+
+    //! Set of paths stored in single precision
+    /*! The values of the added paths are stored as floats, one after
+        the other, without the time grid that each Path carries; this
+        halves (at least) the memory used by large sets of stored
+        paths, such as the calibration paths of the Longstaff-Schwartz
+        algorithm, and the memory traffic needed to read them.  All
+        calculations on the stored values are still performed in
+        double precision, and the relative error on each value is of
+        the order of the single-precision epsilon (about 6e-8).
+
+        Besides the methods to add and read values, the class
+        implements the interface of the generators used by
+        LongstaffSchwartzPathPricer::calibrate(Generator&); the path
+        returned for a given sample is only filled at the time given
+        to the last call to moveTo.
+
+        PathType can be either Path or MultiPath.
+
+        \ingroup mcarlo
+
+        \test the values and the resulting Longstaff-Schwartz prices
+              are tested against those obtained from paths stored in
+              double precision.
+    */
+    template <class PathType>
+    class SinglePrecisionPaths {
+      public:
+        SinglePrecisionPaths()
+        : assets_(0), length_(0), size_(0), time_(0) {}
+        //! \name Storage
+        //@{
+        void add(const PathType& path);
+        //! removes the stored paths and releases the memory
+        void clear();
+        //@}
+        //! \name Inspectors
+        //@{
+        Size size() const { return size_; }
+        //! value of the given path and asset at the given time
+        Real value(Size path, Size asset, Size time) const;
+        //! memory used by the stored values, in bytes
+        Size bytes() const { return values_.capacity()*sizeof(float); }
+        //@}
+        //! \name Generator interface
+        //@{
+        void moveTo(Size time);
+        const PathType& path(Size j) const;
+        //@}
+      private:
+        Size assets_, length_, size_, time_;
+        // the values of each path follow each other, asset by asset
+        std::vector<float> values_;
+        // the first path added, used as a buffer
+        mutable boost::scoped_ptr<PathType> buffer_;
+    };
+
+
+    // template definitions
+
+    template <class PathType>
+    inline void SinglePrecisionPaths<PathType>::add(const PathType& path) {
+        if (size_ == 0) {
+            assets_ = detail::pathAssets(path);
+            length_ = detail::pathLength(path);
+            buffer_.reset(new PathType(path));
+        } else {
+            QL_REQUIRE(detail::pathAssets(path) == assets_ &&
+                       detail::pathLength(path) == length_,
+                       "path size (" << detail::pathAssets(path)
+                       << "x" << detail::pathLength(path)
+                       << ") differs from that of stored paths ("
+                       << assets_ << "x" << length_ << ")");
+        }
+        for (Size a=0; a<assets_; ++a)
+            for (Size i=0; i<length_; ++i)
+                values_.push_back(
+                           static_cast<float>(detail::pathValue(path, a, i)));
+        ++size_;
+    }
+
+    template <class PathType>
+    inline void SinglePrecisionPaths<PathType>::clear() {
+        std::vector<float> empty;
+        values_.swap(empty);
+        buffer_.reset();
+        assets_ = length_ = size_ = time_ = 0;
+    }
+
+    template <class PathType>
+    inline Real SinglePrecisionPaths<PathType>::value(Size path,
+                                                      Size asset,
+                                                      Size time) const {
+        QL_REQUIRE(path < size_, "path #" << path << " not available; "
+                   << size_ << " paths stored");
+        QL_REQUIRE(asset < assets_ && time < length_,
+                   "value out of range");
+        return values_[(path*assets_ + asset)*length_ + time];
+    }
+
+    template <class PathType>
+    inline void SinglePrecisionPaths<PathType>::moveTo(Size time) {
+        QL_REQUIRE(time < length_, "time #" << time << " not available; "
+                   << length_ << " times stored");
+        time_ = time;
+    }
+
+    template <class PathType>
+    inline const PathType& SinglePrecisionPaths<PathType>::path(
+                                                              Size j) const {
+        const float* v = &values_[j*assets_*length_ + time_];
+        for (Size a=0; a<assets_; ++a, v+=length_)
+            detail::pathValue(*buffer_, a, time_) = *v;
+        return *buffer_;
+    }
+
+}
+
+
+#endif
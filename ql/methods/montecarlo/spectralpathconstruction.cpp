@@ -0,0 +1,181 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/montecarlo/spectralpathconstruction.hpp>
+#include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        struct larger_variance {
+            bool operator()(const std::pair<Real, Size>& a,
+                            const std::pair<Real, Size>& b) const {
+                return a.first > b.first;
+            }
+        };
+
+        // lanes transformed together; the variates of a block for a
+        // grid of a few hundred steps fit in the L2 cache
+        const Size laneBlock = 64;
+
+    }
+
+    SpectralPathConstruction::SpectralPathConstruction(
+                                                const TimeGrid& timeGrid,
+                                                Size factors) {
+        QL_REQUIRE(factors > 0, "null number of factors given");
+        initialize(timeGrid, factors, Array(factors, 1.0));
+    }
+
+    SpectralPathConstruction::SpectralPathConstruction(
+                                                const TimeGrid& timeGrid,
+                                                const Matrix& correlation) {
+        QL_REQUIRE(correlation.rows() > 0, "null correlation given");
+        QL_REQUIRE(correlation.rows() == correlation.columns(),
+                   "correlation matrix is not square: "
+                   << correlation.rows() << " rows, "
+                   << correlation.columns() << " columns");
+        Array weights =
+            SymmetricSchurDecomposition(correlation).eigenvalues();
+        for (Size b=0; b<weights.size(); ++b)
+            weights[b] = std::max<Real>(weights[b], 0.0);
+        initialize(timeGrid, correlation.rows(), weights);
+    }
+
+    void SpectralPathConstruction::initialize(const TimeGrid& timeGrid,
+                                              Size factors,
+                                              const Array& weights) {
+        QL_REQUIRE(timeGrid.size() > 1, "no times given");
+        const Size n = timeGrid.size()-1;
+
+        boost::shared_ptr<Data> data(new Data);
+        data->timeGrid = timeGrid;
+        data->steps = n;
+        data->factors = factors;
+
+        // covariance of the Wiener process at the grid times
+        Matrix covariance(n, n);
+        const Time t0 = timeGrid.front();
+        for (Size i=0; i<n; ++i)
+            for (Size j=0; j<=i; ++j)
+                covariance[i][j] = covariance[j][i] =
+                    std::min(timeGrid[i+1], timeGrid[j+1]) - t0;
+
+        SymmetricSchurDecomposition decomposition(covariance);
+        data->eigenvalues = decomposition.eigenvalues();
+        const Matrix& vectors = decomposition.eigenvectors();
+
+        data->increments = Matrix(n, n);
+        for (Size j=0; j<n; ++j) {
+            Real lambda = std::max<Real>(data->eigenvalues[j], 0.0);
+            data->eigenvalues[j] = lambda;
+            Real scale = std::sqrt(lambda);
+            for (Size i=0; i<n; ++i) {
+                Real previous = i == 0 ? 0.0 : vectors[i-1][j];
+                data->increments[i][j] =
+                    (vectors[i][j]-previous) * scale
+                    / std::sqrt(timeGrid.dt(i));
+            }
+        }
+
+        // variates assigned by decreasing variance of the component
+        // they drive; ties keep the order by time component
+        std::vector<std::pair<Real, Size> > order(n*factors);
+        for (Size j=0; j<n; ++j)
+            for (Size b=0; b<factors; ++b)
+                order[j*factors+b] =
+                    std::make_pair(data->eigenvalues[j]*weights[b],
+                                   j*factors+b);
+        std::stable_sort(order.begin(), order.end(), larger_variance());
+        data->variates.resize(n*factors);
+        for (Size k=0; k<order.size(); ++k) {
+            Size j = order[k].second / factors;
+            Size b = order[k].second % factors;
+            data->variates[b*n+j] = k;
+        }
+
+        data_ = data;
+    }
+
+    void SpectralPathConstruction::transformLanes(const Real* input,
+                                                  Real* output,
+                                                  Size lanes) const {
+        QL_REQUIRE(data_, "empty path construction");
+        const Size n = data_->steps, m = data_->factors;
+        const Matrix& increments = data_->increments;
+        for (Size first=0; first<lanes; first+=laneBlock) {
+            const Size block = std::min(laneBlock, lanes-first);
+            for (Size b=0; b<m; ++b) {
+                const Size* variates = &data_->variates[b*n];
+                for (Size i=0; i<n; ++i) {
+                    Real* out = output + (i*m+b)*lanes + first;
+                    std::fill(out, out+block, 0.0);
+                    for (Size j=0; j<n; ++j) {
+                        const Real w = increments[i][j];
+                        const Real* z = input + variates[j]*lanes + first;
+                        for (Size l=0; l<block; ++l)
+                            out[l] += w * z[l];
+                    }
+                }
+            }
+        }
+    }
+
+
+    SpectralPathConstructionCache::SpectralPathConstructionCache(
+                                                              Size maxSize)
+    : maxSize_(maxSize) {
+        QL_REQUIRE(maxSize_ > 0, "null maximum size given");
+    }
+
+    SpectralPathConstruction SpectralPathConstructionCache::construction(
+                                                const TimeGrid& timeGrid,
+                                                Size factors) {
+        Key key(std::make_pair(factors,
+                               std::vector<Time>(timeGrid.begin(),
+                                                 timeGrid.end())),
+                std::vector<Real>());
+        std::map<Key, SpectralPathConstruction>::const_iterator i =
+            constructions_.find(key);
+        if (i != constructions_.end())
+            return i->second;
+        if (constructions_.size() >= maxSize_)
+            constructions_.clear();
+        return constructions_[key] =
+            SpectralPathConstruction(timeGrid, factors);
+    }
+
+    SpectralPathConstruction SpectralPathConstructionCache::construction(
+                                                const TimeGrid& timeGrid,
+                                                const Matrix& correlation) {
+        Key key(std::make_pair(correlation.rows(),
+                               std::vector<Time>(timeGrid.begin(),
+                                                 timeGrid.end())),
+                std::vector<Real>(correlation.begin(), correlation.end()));
+        std::map<Key, SpectralPathConstruction>::const_iterator i =
+            constructions_.find(key);
+        if (i != constructions_.end())
+            return i->second;
+        if (constructions_.size() >= maxSize_)
+            constructions_.clear();
+        return constructions_[key] =
+            SpectralPathConstruction(timeGrid, correlation);
+    }
+
+}
@@ -0,0 +1,187 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file spectralpathconstruction.hpp
+    \brief principal-component construction of multi-factor Wiener paths
+*/
+
+#ifndef quantlib_spectral_path_construction_hpp
+#define quantlib_spectral_path_construction_hpp
+
+#include <ql/timegrid.hpp>
+#include <ql/math/matrix.hpp>
+#include <map>
+
+namespace QuantLib {
+
+    //! Builds multi-factor Wiener paths from their principal components
+    /*! The class plays the role of BrownianBridge for multi-factor
+        paths.  The covariance min(t_i,t_j) of the Wiener process on
+        the time grid is diagonalized, and each factor is built as
+        \f[
+            W_b(t_i) = \sum_j V_{ij} \sqrt{\lambda_j} \, z_{b,j};
+        \f]
+        the returned values are the increments of the path,
+        normalized to unit variance over each time step, laid out by
+        time step and then by factor as expected by
+        MultiPathGenerator.
+
+        The input variates are assigned to the components in order
+        of decreasing variance \f$ \lambda_j \mu_b \f$, where
+        \f$ \mu_b \f$ are the eigenvalues of the given correlation
+        (or one if no correlation is given.)  Processes such as
+        StochasticProcessArray correlate their factors through the
+        spectral pseudo-square root of the correlation, whose b-th
+        column is the b-th principal direction; therefore, the first
+        variates drive the principal components of the joint
+        covariance of all the assets at all times, which is where
+        low-discrepancy sequences are most uniform.
+
+        Copies of an instance share its data.
+
+        \ingroup mcarlo
+
+        \test the generated variations are checked against the
+              covariance of the Wiener process and against the
+              principal components.
+    */
+    class SpectralPathConstruction {
+      public:
+        //! builds an empty instance, to be assigned later
+        SpectralPathConstruction() {}
+        /*! \param timeGrid the time grid of the paths
+            \param factors  the number of independent factors
+        */
+        SpectralPathConstruction(const TimeGrid& timeGrid,
+                                 Size factors = 1);
+        /*! \param timeGrid    the time grid of the paths
+            \param correlation the correlation of the factors, which
+                               only determines the order in which
+                               the variates are used
+        */
+        SpectralPathConstruction(const TimeGrid& timeGrid,
+                                 const Matrix& correlation);
+        //! \name inspectors
+        //@{
+        bool empty() const { return !data_; }
+        Size steps() const { return data_->steps; }
+        Size factors() const { return data_->factors; }
+        //! the number of variates, i.e., steps times factors
+        Size size() const { return data_->steps*data_->factors; }
+        const TimeGrid& timeGrid() const { return data_->timeGrid; }
+        //! the eigenvalues of the covariance in time, in decreasing order
+        const Array& eigenvalues() const { return data_->eigenvalues; }
+        /*! the index of the variate driving the j-th time component
+            of the b-th factor
+        */
+        Size variate(Size factor, Size component) const {
+            return data_->variates[factor*data_->steps+component];
+        }
+        //@}
+        //! path generator function
+        /*! Transforms a sequence of steps()*factors() independent
+            variates into normalized variations of the factors.  The
+            variation of the b-th factor over the i-th step is
+            written to output[i*factors()+b].
+
+            \pre input and output must not overlap.
+        */
+        template <class RandomAccessIterator1,
+                  class RandomAccessIterator2>
+        void transform(RandomAccessIterator1 begin,
+                       RandomAccessIterator1 end,
+                       RandomAccessIterator2 output) const {
+            QL_REQUIRE(data_, "empty path construction");
+            QL_REQUIRE(end >= begin, "invalid sequence");
+            QL_REQUIRE(Size(end-begin) == size(),
+                       "incompatible sequence size");
+            const Size n = data_->steps, m = data_->factors;
+            const Matrix& increments = data_->increments;
+            for (Size b=0; b<m; ++b) {
+                const Size* variates = &data_->variates[b*n];
+                for (Size i=0; i<n; ++i) {
+                    Real sum = 0.0;
+                    for (Size j=0; j<n; ++j)
+                        sum += increments[i][j] * begin[variates[j]];
+                    output[i*m+b] = sum;
+                }
+            }
+        }
+        //! path generator function for a block of paths
+        /*! Transforms the variates of a number of paths ("lanes") at
+            once.  The k-th variate of the l-th lane is read from
+            input[k*lanes+l], and the variation of the b-th factor
+            over the i-th step is written to
+            output[(i*factors()+b)*lanes+l].  The transformation is
+            performed for each factor as a matrix product, blocked
+            over the lanes so that the variates being combined stay
+            in cache.
+
+            \pre input and output must not overlap.
+        */
+        void transformLanes(const Real* input,
+                            Real* output,
+                            Size lanes) const;
+      private:
+        void initialize(const TimeGrid& timeGrid,
+                        Size factors,
+                        const Array& weights);
+        struct Data {
+            TimeGrid timeGrid;
+            Size steps, factors;
+            Array eigenvalues;
+            // normalized increments of the eigenvectors, by step
+            Matrix increments;
+            std::vector<Size> variates;
+        };
+        boost::shared_ptr<const Data> data_;
+    };
+
+
+    //! cache of spectral path constructions
+    /*! The cache returns the same construction when asked repeatedly
+        for the same time grid and correlation, so that engines
+        pricing a number of instruments only perform the
+        decomposition once per grid.
+
+        The cache is emptied when it reaches its maximum size.
+
+        \warning The cache is not thread-safe; each thread should
+                 use its own.
+    */
+    class SpectralPathConstructionCache {
+      public:
+        explicit SpectralPathConstructionCache(Size maxSize = 100);
+        //! same as SpectralPathConstruction(timeGrid, factors)
+        SpectralPathConstruction construction(const TimeGrid& timeGrid,
+                                              Size factors = 1);
+        //! same as SpectralPathConstruction(timeGrid, correlation)
+        SpectralPathConstruction construction(const TimeGrid& timeGrid,
+                                              const Matrix& correlation);
+        Size size() const { return constructions_.size(); }
+        void clear() { constructions_.clear(); }
+      private:
+        typedef std::pair<std::pair<Size, std::vector<Time> >,
+                          std::vector<Real> > Key;
+        Size maxSize_;
+        std::map<Key, SpectralPathConstruction> constructions_;
+    };
+
+}
+
+
+#endif
@@ -84,4 +84,50 @@ namespace QuantLib {
         
         return error;
     }
+
+    Disposable<Array> CalibrationHelper::modelValueGradient() const {
+        QL_FAIL("model value gradient not available");
+    }
+
+    Disposable<Array> CalibrationHelper::calibrationErrorGradient() {
+        Array gradient = modelValueGradient();
+
+        switch (calibrationErrorType_) {
+          case RelativePriceError:
+            gradient *= (marketValue() >= modelValue() ? -1.0 : 1.0)
+                         /marketValue();
+            break;
+          case PriceError:
+            gradient *= -1.0;
+            break;
+          case ImpliedVolError:
+            {
+              Real minVol = volatilityType_ == ShiftedLognormal ? 0.0010 : 0.00005;
+              Real maxVol = volatilityType_ == ShiftedLognormal ? 10.0 : 0.50;
+              const Real lowerPrice = blackPrice(minVol);
+              const Real upperPrice = blackPrice(maxVol);
+              const Real modelPrice = modelValue();
+
+              if (modelPrice <= lowerPrice || modelPrice >= upperPrice) {
+                  // the implied volatility is floored or capped
+                  gradient = Array(gradient.size(), 0.0);
+              } else {
+                  const Volatility implied = this->impliedVolatility(
+                                   modelPrice, 1e-12, 5000, minVol, maxVol);
+                  const Real h = 1e-6;
+                  const Real vega =
+                      (blackPrice(implied+h) - blackPrice(implied-h))/(2*h);
+                  QL_REQUIRE(vega > 0.0, "null vega at implied volatility "
+                             << implied);
+                  gradient /= vega;
+              }
+            }
+            break;
+          default:
+            QL_FAIL("unknown Calibration Error Type");
+        }
+
+        return gradient;
+    }
+
 }
@@ -26,6 +26,7 @@
 #define quantlib_interest_rate_modelling_calibration_helper_h
 
 #include <ql/quote.hpp>
+#include <ql/math/array.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
 #include <ql/patterns/lazyobject.hpp>
@@ -63,6 +64,16 @@ namespace QuantLib {
         //! returns the volatility type
         VolatilityType volatilityType() const { return volatilityType_; }
 
+        //! returns the type of the calibration error
+        CalibrationErrorType calibrationErrorType() const {
+            return calibrationErrorType_;
+        }
+
+        //! returns the engine used for the model value
+        const boost::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
+
         //! returns the actual price of the instrument (from volatility)
         Real marketValue() const { calculate(); return marketValue_; }
 
@@ -72,6 +83,22 @@ namespace QuantLib {
         //! returns the error resulting from the model valuation
         virtual Real calibrationError();
 
+        //! whether the model value gradient is available
+        virtual bool hasModelValueGradient() const { return false; }
+
+        /*! returns the derivatives of the model value with respect to
+            the model parameters, in the order given by the params()
+            method of the model.
+        */
+        virtual Disposable<Array> modelValueGradient() const;
+
+        //! returns the derivatives of calibrationError()
+        /*! The implementation is based on modelValueGradient(); the
+            gradient is therefore only available when
+            hasModelValueGradient() returns true.
+        */
+        virtual Disposable<Array> calibrationErrorGradient();
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
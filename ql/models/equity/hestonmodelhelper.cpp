@@ -21,6 +21,7 @@
 
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/instruments/payoffs.hpp>
 #include <ql/quotes/simplequote.hpp>
@@ -84,6 +85,24 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    bool HestonModelHelper::hasModelValueGradient() const {
+        boost::shared_ptr<AnalyticHestonEngine> engine =
+            boost::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        return engine && engine->hasValueGradient();
+    }
+
+    Disposable<Array> HestonModelHelper::modelValueGradient() const {
+        calculate();
+        boost::shared_ptr<AnalyticHestonEngine> engine =
+            boost::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        QL_REQUIRE(engine, "analytic Heston engine required");
+
+        VanillaOption::arguments arguments;
+        option_->setupArguments(&arguments);
+        arguments.validate();
+        return engine->valueGradient(arguments);
+    }
+
     Real HestonModelHelper::blackPrice(Real volatility) const {
         calculate();
         const Real stdDev = volatility * std::sqrt(maturity());
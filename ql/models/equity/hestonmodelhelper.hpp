@@ -56,6 +56,12 @@ namespace QuantLib {
         void addTimesTo(std::list<Time>&) const {}
         void performCalculations() const;
         Real modelValue() const;
+        /*! the gradient is available when the pricing engine is an
+            AnalyticHestonEngine providing it; see
+            AnalyticHestonEngine::hasValueGradient().
+        */
+        bool hasModelValueGradient() const;
+        Disposable<Array> modelValueGradient() const;
         Real blackPrice(Real volatility) const;
         Time maturity() const  { calculate(); return tau_; }
       private:
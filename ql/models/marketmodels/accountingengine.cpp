@@ -22,6 +22,7 @@
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
+#include <ql/math/memorypool.hpp>
 #include <algorithm>
 
 namespace QuantLib {
@@ -115,6 +116,7 @@ namespace QuantLib {
     void AccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
                                               Size numberOfPaths)
     {
+        MemoryPool::Scope pool;
         std::vector<Real> values(product_->numberOfProducts());
         for (Size i=0; i<numberOfPaths; ++i) {
             Real weight = singlePathValues(values);
@@ -122,4 +124,16 @@ namespace QuantLib {
         }
     }
 
+    void AccountingEngine::drawPathValues(
+                     Size numberOfPaths,
+                     std::vector<std::pair<std::vector<Real>,Real> >& values) {
+        MemoryPool::Scope pool;
+        std::vector<Real> pathValues(product_->numberOfProducts());
+        values.reserve(values.size()+numberOfPaths);
+        for (Size i=0; i<numberOfPaths; ++i) {
+            Real weight = singlePathValues(pathValues);
+            values.push_back(std::make_pair(pathValues, weight));
+        }
+    }
+
 }
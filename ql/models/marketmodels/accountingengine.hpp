@@ -48,6 +48,14 @@ namespace QuantLib {
                          Real initialNumeraireValue);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
+        //! simulates the given number of paths and stores their values
+        /*! The values and weight of each path are appended to the
+            passed vector instead of being added to statistics; this
+            is used by ParallelAccountingEngine.
+        */
+        void drawPathValues(
+                      Size numberOfPaths,
+                      std::vector<std::pair<std::vector<Real>,Real> >& values);
       private:
         Real singlePathValues(std::vector<Real>& values);
 
@@ -2,10 +2,12 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/batchaccountingengine.hpp>
 #include <ql/models/marketmodels/browniangenerator.hpp>
 #include <ql/models/marketmodels/constrainedevolver.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
+#include <ql/models/marketmodels/distributedaccountingengine.hpp>
 #include <ql/models/marketmodels/duffsdeviceinnerproduct.hpp>
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/evolver.hpp>
@@ -15,6 +17,7 @@
 #include <ql/models/marketmodels/marketmodel.hpp>
 #include <ql/models/marketmodels/marketmodeldifferences.hpp>
 #include <ql/models/marketmodels/multiproduct.hpp>
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
 #include <ql/models/marketmodels/pathwiseaccountingengine.hpp>
 #include <ql/models/marketmodels/pathwisemultiproduct.hpp>
 #include <ql/models/marketmodels/pathwisediscounter.hpp>
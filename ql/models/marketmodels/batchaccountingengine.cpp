@@ -0,0 +1,136 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/batchaccountingengine.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcbatch.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/curvestate.hpp>
+#include <ql/math/memorypool.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    BatchAccountingEngine::BatchAccountingEngine(
+                     const boost::shared_ptr<LogNormalFwdRatePcBatch>& evolver,
+                     const Clone<MarketModelMultiProduct>& product,
+                     Real initialNumeraireValue)
+    : evolver_(evolver), products_(evolver->lanes(), product),
+      initialNumeraireValue_(initialNumeraireValue),
+      numberProducts_(product->numberOfProducts()),
+      values_(evolver->lanes(),
+              std::vector<Real>(product->numberOfProducts())),
+      principals_(evolver->lanes()), done_(evolver->lanes()),
+      numberCashFlowsThisStep_(product->numberOfProducts()),
+      cashFlowsGenerated_(product->numberOfProducts()) {
+        for (Size i=0; i<numberProducts_; ++i)
+            cashFlowsGenerated_[i].resize(
+                       product->maxNumberOfCashFlowsPerProductPerStep());
+
+        const std::vector<Time>& cashFlowTimes =
+            product->possibleCashFlowTimes();
+        const std::vector<Rate>& rateTimes = product->evolution().rateTimes();
+        discounters_.reserve(cashFlowTimes.size());
+        for (Size j=0; j<cashFlowTimes.size(); ++j)
+            discounters_.push_back(MarketModelDiscounter(cashFlowTimes[j],
+                                                         rateTimes));
+    }
+
+    void BatchAccountingEngine::batchValues(Size n) {
+        evolver_->startNewPaths(n, weights_);
+        for (Size l=0; l<n; ++l) {
+            products_[l]->reset();
+            std::fill(values_[l].begin(), values_[l].end(), 0.0);
+            principals_[l] = 1.0;
+            done_[l] = false;
+        }
+
+        Size running = n;
+        while (running > 0) {
+            Size thisStep = evolver_->currentStep();
+            evolver_->advanceStep(stepWeights_);
+            Size numeraire = evolver_->numeraires()[thisStep];
+
+            for (Size l=0; l<n; ++l) {
+                if (done_[l])
+                    continue;
+
+                weights_[l] *= stepWeights_[l];
+                const CurveState& state = evolver_->currentState(l);
+                bool done = products_[l]->nextTimeStep(
+                                                    state,
+                                                    numberCashFlowsThisStep_,
+                                                    cashFlowsGenerated_);
+
+                // convert the cash flows to numeraire bonds, as in
+                // AccountingEngine
+                std::vector<Real>& numerairesHeld = values_[l];
+                for (Size i=0; i<numberProducts_; ++i) {
+                    const std::vector<MarketModelMultiProduct::CashFlow>&
+                        cashflows = cashFlowsGenerated_[i];
+                    for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j) {
+                        const MarketModelDiscounter& discounter =
+                            discounters_[cashflows[j].timeIndex];
+                        Real bonds = cashflows[j].amount *
+                            discounter.numeraireBonds(state, numeraire);
+                        numerairesHeld[i] += bonds/principals_[l];
+                    }
+                }
+
+                if (done) {
+                    done_[l] = true;
+                    --running;
+                } else {
+                    Size nextNumeraire = evolver_->numeraires()[thisStep+1];
+                    principals_[l] *=
+                        state.discountRatio(numeraire, nextNumeraire);
+                }
+            }
+        }
+
+        for (Size l=0; l<n; ++l)
+            for (Size i=0; i<numberProducts_; ++i)
+                values_[l][i] *= initialNumeraireValue_;
+    }
+
+    void BatchAccountingEngine::multiplePathValues(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        MemoryPool::Scope pool;
+        Size lanes = evolver_->lanes();
+        for (Size i=0; i<numberOfPaths; i+=lanes) {
+            Size n = std::min(lanes, numberOfPaths-i);
+            batchValues(n);
+            for (Size l=0; l<n; ++l)
+                stats.add(values_[l], weights_[l]);
+        }
+    }
+
+    void BatchAccountingEngine::drawPathValues(
+                     Size numberOfPaths,
+                     std::vector<std::pair<std::vector<Real>,Real> >& values) {
+        MemoryPool::Scope pool;
+        values.reserve(values.size()+numberOfPaths);
+        Size lanes = evolver_->lanes();
+        for (Size i=0; i<numberOfPaths; i+=lanes) {
+            Size n = std::min(lanes, numberOfPaths-i);
+            batchValues(n);
+            for (Size l=0; l<n; ++l)
+                values.push_back(std::make_pair(values_[l], weights_[l]));
+        }
+    }
+
+}
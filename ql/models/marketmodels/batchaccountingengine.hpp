@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchaccountingengine.hpp
+    \brief engine collecting cash flows along batches of LMM paths
+*/
+
+#ifndef quantlib_batch_accounting_engine_hpp
+#define quantlib_batch_accounting_engine_hpp
+
+#include <ql/models/marketmodels/multiproduct.hpp>
+#include <ql/models/marketmodels/discounter.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/utilities/clone.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class LogNormalFwdRatePcBatch;
+
+    //! Engine collecting cash flows along batches of market-model paths
+    /*! This engine performs the same accounting as AccountingEngine,
+        but the paths are evolved in batches by a
+        LogNormalFwdRatePcBatch evolver; a clone of the product is
+        kept for each lane.  The path values are added to the
+        statistics in the order in which the paths are drawn.
+
+        Any product can be used; the lanes whose product is done
+        before the others stop collecting cash flows, although their
+        rates keep being evolved with the rest of the batch.
+
+        The interface is the same as AccountingEngine's, so that the
+        engine can be used as a worker of ParallelAccountingEngine.
+    */
+    class BatchAccountingEngine {
+      public:
+        BatchAccountingEngine(
+                     const boost::shared_ptr<LogNormalFwdRatePcBatch>& evolver,
+                     const Clone<MarketModelMultiProduct>& product,
+                     Real initialNumeraireValue);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+        //! simulates the given number of paths and stores their values
+        void drawPathValues(
+                      Size numberOfPaths,
+                      std::vector<std::pair<std::vector<Real>,Real> >& values);
+      private:
+        // simulates a batch of n paths
+        void batchValues(Size n);
+
+        boost::shared_ptr<LogNormalFwdRatePcBatch> evolver_;
+        std::vector<Clone<MarketModelMultiProduct> > products_;
+
+        Real initialNumeraireValue_;
+        Size numberProducts_;
+
+        // workspace
+        std::vector<std::vector<Real> > values_;
+        std::vector<Real> weights_, stepWeights_, principals_;
+        std::vector<bool> done_;
+        std::vector<Size> numberCashFlowsThisStep_;
+        std::vector<std::vector<MarketModelMultiProduct::CashFlow> >
+                                                         cashFlowsGenerated_;
+        std::vector<MarketModelDiscounter> discounters_;
+    };
+
+}
+
+#endif
@@ -37,6 +37,25 @@ namespace QuantLib {
 
         virtual Size numberOfFactors() const = 0;
         virtual Size numberOfSteps() const = 0;
+
+        //! draws the next n paths at once
+        /*! The i-th variate of the j-th step of the k-th path is
+            stored in variates[(j*numberOfFactors()+i)*n+k], so that
+            the values for all the paths are contiguous; the weights
+            of the k-th path and of its j-th step are stored in
+            weights[k] and stepWeights[j*n+k], respectively.
+
+            The default implementation draws the paths one after the
+            other; generators that can produce them together should
+            override it.  Whatever the implementation, the paths
+            must be the same that nextPath() and nextStep() would
+            return.  After the call, nextPath() must be called again
+            before nextStep().
+        */
+        virtual void nextPaths(Size n,
+                               std::vector<Real>& weights,
+                               std::vector<Real>& stepWeights,
+                               std::vector<Real>& variates);
     };
 
     class BrownianGeneratorFactory {
@@ -47,6 +66,28 @@ namespace QuantLib {
                                                             Size steps) const = 0;
     };
 
+
+    // inline definitions
+
+    inline void BrownianGenerator::nextPaths(Size n,
+                                             std::vector<Real>& weights,
+                                             std::vector<Real>& stepWeights,
+                                             std::vector<Real>& variates) {
+        const Size factors = numberOfFactors(), steps = numberOfSteps();
+        weights.resize(n);
+        stepWeights.resize(steps*n);
+        variates.resize(steps*factors*n);
+        std::vector<Real> step(factors);
+        for (Size k=0; k<n; ++k) {
+            weights[k] = nextPath();
+            for (Size j=0; j<steps; ++j) {
+                stepWeights[j*n+k] = nextStep(step);
+                for (Size i=0; i<factors; ++i)
+                    variates[(j*factors+i)*n+k] = step[i];
+            }
+        }
+    }
+
 }
 
 #endif
@@ -23,9 +23,14 @@ namespace QuantLib {
 
     MTBrownianGenerator::MTBrownianGenerator(Size factors,
                                              Size steps,
-                                             unsigned long seed)
+                                             unsigned long seed,
+                                             unsigned long skip)
     : factors_(factors), steps_(steps), lastStep_(0),
-      generator_(factors*steps, MersenneTwisterUniformRng(seed)) {}
+      generator_(factors*steps, MersenneTwisterUniformRng(seed)) {
+        // each path uses a single sequence
+        if (skip > 0)
+            generator_.jumpAhead(skip);
+    }
 
     Real MTBrownianGenerator::nextStep(std::vector<Real>& output) {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
@@ -57,13 +62,15 @@ namespace QuantLib {
     Size MTBrownianGenerator::numberOfSteps() const { return steps_; }
 
 
-    MTBrownianGeneratorFactory::MTBrownianGeneratorFactory(unsigned long seed)
-    : seed_(seed) {}
+    MTBrownianGeneratorFactory::MTBrownianGeneratorFactory(
+                                                        unsigned long seed,
+                                                        unsigned long skip)
+    : seed_(seed), skip_(skip) {}
 
     boost::shared_ptr<BrownianGenerator>
     MTBrownianGeneratorFactory::create(Size factors, Size steps) const {
         return boost::shared_ptr<BrownianGenerator>(
-                              new MTBrownianGenerator(factors, steps, seed_));
+                       new MTBrownianGenerator(factors, steps, seed_, skip_));
     }
 
 }
@@ -39,12 +39,18 @@ namespace QuantLib {
               instead of a RandomSequenceGenerator; however, it is not
               clear how much of a difference this would make when
               compared to the inverse-cumulative Gaussian calculation.
+
+        If a number of paths to skip is given, the generator starts
+        from the corresponding point of the random stream, which is
+        reached by jumping ahead instead of drawing the skipped
+        numbers.
     */
     class MTBrownianGenerator : public BrownianGenerator {
       public:
         MTBrownianGenerator(Size factors,
                             Size steps,
-                            unsigned long seed = 0);
+                            unsigned long seed = 0,
+                            unsigned long skip = 0);
 
         Real nextStep(std::vector<Real>&);
         Real nextPath();
@@ -60,11 +66,12 @@ namespace QuantLib {
 
     class MTBrownianGeneratorFactory : public BrownianGeneratorFactory {
       public:
-        MTBrownianGeneratorFactory(unsigned long seed = 0);
+        MTBrownianGeneratorFactory(unsigned long seed = 0,
+                                   unsigned long skip = 0);
         boost::shared_ptr<BrownianGenerator> create(Size factors,
                                                     Size steps) const;
       private:
-        unsigned long seed_;
+        unsigned long seed_, skip_;
     };
 
 }
@@ -24,6 +24,16 @@ namespace QuantLib {
 
     namespace {
 
+        SobolRsg sobolSequence(Size dimension,
+                               unsigned long seed,
+                               SobolRsg::DirectionIntegers integers,
+                               unsigned long skip) {
+            SobolRsg rsg(dimension, seed, integers);
+            if (skip > 0)
+                rsg.skipTo(skip);
+            return rsg;
+        }
+
         void fillByFactor(std::vector<std::vector<Size> >& M,
                           Size factors, Size steps) {
             Size counter = 0;
@@ -112,12 +122,13 @@ namespace QuantLib {
                                         Size steps,
                                         Ordering ordering,
                                         unsigned long seed,
-                                        SobolRsg::DirectionIntegers integers)
+                                        SobolRsg::DirectionIntegers integers,
+                                        unsigned long skip)
     : factors_(factors), steps_(steps), ordering_(ordering),
-      generator_(SobolRsg(factors*steps, seed, integers),
-                 InverseCumulativeNormal()),
+      generator_(sobolSequence(factors*steps, seed, integers, skip)),
       bridge_(steps), lastStep_(0),
       orderedIndices_(factors, std::vector<Size>(steps)),
+      variates_(factors*steps),
       bridgedVariates_(factors, std::vector<Real>(steps)) {
 
         switch (ordering_) {
@@ -137,24 +148,65 @@ namespace QuantLib {
 
 
     Real SobolBrownianGenerator::nextPath() {
-        typedef InverseCumulativeRsg<SobolRsg,
-                                     InverseCumulativeNormal>::sample_type
-            sample_type;
-
-        const sample_type& sample = generator_.nextSequence();
+        const SobolRsg::sample_type& sample = generator_.nextSequence();
+        for (Size k=0; k<variates_.size(); ++k)
+            variates_[k] = inverseCumulative_(sample.value[k]);
         // Brownian-bridge the variates according to the ordered indices
         for (Size i=0; i<factors_; ++i) {
             bridge_.transform(boost::make_permutation_iterator(
-                                                  sample.value.begin(),
+                                                  variates_.begin(),
                                                   orderedIndices_[i].begin()),
                               boost::make_permutation_iterator(
-                                                  sample.value.begin(),
+                                                  variates_.begin(),
                                                   orderedIndices_[i].end()),
                               bridgedVariates_[i].begin());
         }
         lastStep_ = 0;
         return sample.weight;
     }
+
+    void SobolBrownianGenerator::nextPaths(Size n,
+                                           std::vector<Real>& weights,
+                                           std::vector<Real>& stepWeights,
+                                           std::vector<Real>& variates) {
+        const Size dim = factors_*steps_;
+        uniforms_.resize(dim*n);
+        gaussians_.resize(dim*n);
+        if (n == 0) {
+            weights.clear();
+            stepWeights.clear();
+            variates.clear();
+            return;
+        }
+
+        generator_.nextSequences(n, &uniforms_[0]);
+        // the Gaussian variates are arranged by factor and step
+        // according to the ordered indices, so that each factor
+        // can be bridged as a contiguous block.
+        for (Size i=0; i<factors_; ++i) {
+            for (Size j=0; j<steps_; ++j) {
+                const Real* u = &uniforms_[orderedIndices_[i][j]*n];
+                inverseCumulative_(u, &gaussians_[(i*steps_+j)*n], n);
+            }
+        }
+        // the uniforms are no longer needed; their storage is
+        // reused for the bridged variates.
+        for (Size i=0; i<factors_; ++i)
+            bridge_.transformLanes(&gaussians_[i*steps_*n],
+                                   &uniforms_[i*steps_*n], n);
+
+        variates.resize(dim*n);
+        for (Size j=0; j<steps_; ++j) {
+            for (Size i=0; i<factors_; ++i) {
+                const Real* from = &uniforms_[(i*steps_+j)*n];
+                std::copy(from, from+n, variates.begin()+(j*factors_+i)*n);
+            }
+        }
+        weights.assign(n, 1.0);
+        stepWeights.assign(steps_*n, 1.0);
+        // the paths must be started again by nextPath()
+        lastStep_ = steps_;
+    }
     
     
     const std::vector<std::vector<Size> >& 
@@ -213,14 +265,16 @@ namespace QuantLib {
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
                                     SobolBrownianGenerator::Ordering ordering,
                                     unsigned long seed,
-                                    SobolRsg::DirectionIntegers integers)
-    : ordering_(ordering), seed_(seed), integers_(integers) {}
+                                    SobolRsg::DirectionIntegers integers,
+                                    unsigned long skip)
+    : ordering_(ordering), seed_(seed), integers_(integers), skip_(skip) {}
 
     boost::shared_ptr<BrownianGenerator>
     SobolBrownianGeneratorFactory::create(Size factors, Size steps) const {
         return boost::shared_ptr<BrownianGenerator>(
                          new SobolBrownianGenerator(factors, steps, ordering_,
-                                                    seed_, integers_));
+                                                    seed_, integers_,
+                                                    skip_));
     }
 
 }
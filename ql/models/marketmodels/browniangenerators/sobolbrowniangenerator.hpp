@@ -33,6 +33,16 @@ namespace QuantLib {
     //! Sobol Brownian generator for market-model simulations
     /*! Incremental Brownian generator using a Sobol generator,
         inverse-cumulative Gaussian method, and Brownian bridging.
+
+        If a number of paths to skip is given, the generator starts
+        from the corresponding point of the Sobol sequence; this
+        allows disjoint blocks of paths to be assigned to different
+        generators, e.g., when simulating in parallel.
+
+        Blocks of paths drawn with nextPaths() are generated
+        together: the Sobol points are drawn as a block, and the
+        inverse cumulative normal and the Brownian bridge are applied
+        to all the paths in each step.
     */
     class SobolBrownianGenerator : public BrownianGenerator {
       public:
@@ -52,10 +62,15 @@ namespace QuantLib {
                            Ordering ordering,
                            unsigned long seed = 0,
                            SobolRsg::DirectionIntegers directionIntegers
-                                                        = SobolRsg::Jaeckel);
+                                                        = SobolRsg::Jaeckel,
+                           unsigned long skip = 0);
 
         Real nextPath();
         Real nextStep(std::vector<Real>&);
+        void nextPaths(Size n,
+                       std::vector<Real>& weights,
+                       std::vector<Real>& stepWeights,
+                       std::vector<Real>& variates);
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
@@ -68,12 +83,16 @@ namespace QuantLib {
       private:
         Size factors_, steps_;
         Ordering ordering_;
-        InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> generator_;
+        SobolRsg generator_;
+        InverseCumulativeNormal inverseCumulative_;
         BrownianBridge bridge_;
         // work variables
         Size lastStep_;
         std::vector<std::vector<Size> > orderedIndices_;
+        std::vector<Real> variates_;
         std::vector<std::vector<Real> > bridgedVariates_;
+        // blocks of uniform and Gaussian variates, by dimension
+        std::vector<Real> uniforms_, gaussians_;
     };
 
     class SobolBrownianGeneratorFactory : public BrownianGeneratorFactory {
@@ -82,13 +101,15 @@ namespace QuantLib {
                            SobolBrownianGenerator::Ordering ordering,
                            unsigned long seed = 0,
                            SobolRsg::DirectionIntegers directionIntegers
-                                                         = SobolRsg::Jaeckel);
+                                                         = SobolRsg::Jaeckel,
+                           unsigned long skip = 0);
         boost::shared_ptr<BrownianGenerator> create(Size factors,
                                                     Size steps) const;
       private:
         SobolBrownianGenerator::Ordering ordering_;
         unsigned long seed_;
         SobolRsg::DirectionIntegers integers_;
+        unsigned long skip_;
     };
 
 }
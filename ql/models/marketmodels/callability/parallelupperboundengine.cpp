@@ -0,0 +1,105 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/callability/parallelupperboundengine.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+namespace QuantLib {
+
+    namespace {
+
+        Real secondsSince(const boost::posix_time::ptime& start) {
+            boost::posix_time::time_duration elapsed =
+                boost::posix_time::microsec_clock::universal_time() - start;
+            return elapsed.total_microseconds()*1.0e-6;
+        }
+
+    }
+
+    ParallelUpperBoundEngine::ParallelUpperBoundEngine(
+             const std::vector<boost::shared_ptr<UpperBoundEngine> >& workers)
+    : workers_(workers), times_(workers.size(), 0.0), elapsed_(0.0) {
+        QL_REQUIRE(!workers_.empty(), "no workers given");
+        for (Size i=0; i<workers_.size(); ++i)
+            QL_REQUIRE(workers_[i], "null worker #" << i);
+    }
+
+    Size ParallelUpperBoundEngine::firstPath(Size worker,
+                                             Size workers,
+                                             Size outerPaths) {
+        QL_REQUIRE(worker < workers,
+                   "worker #" << worker << " not available; "
+                   << workers << " workers given");
+        Size r = outerPaths % workers;
+        return worker*(outerPaths/workers) + std::min(worker, r);
+    }
+
+    void ParallelUpperBoundEngine::multiplePathValues(Statistics& stats,
+                                                      Size outerPaths,
+                                                      Size innerPaths) {
+        boost::posix_time::ptime start =
+            boost::posix_time::microsec_clock::universal_time();
+
+        Size n = workers_.size();
+        std::vector<std::vector<std::pair<Real,Real> > > values(n);
+        std::vector<std::string> errors(n);
+        // not vector<bool>, whose elements can't be written
+        // concurrently
+        std::vector<int> failed(n, 0);
+
+        #pragma omp parallel for num_threads(n) schedule(static)
+        for (Size i=0; i<n; ++i) {
+            boost::posix_time::ptime workerStart =
+                boost::posix_time::microsec_clock::universal_time();
+            Size batch = outerPaths/n + (i < outerPaths%n ? 1 : 0);
+            try {
+                workers_[i]->drawPathValues(batch, innerPaths, values[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+                failed[i] = 1;
+            } catch (...) {
+                errors[i] = "unknown error";
+                failed[i] = 1;
+            }
+            times_[i] = secondsSince(workerStart);
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(!failed[i],
+                       "worker " << i << " failed: " << errors[i]);
+
+        for (Size i=0; i<n; ++i)
+            for (Size j=0; j<values[i].size(); ++j)
+                stats.add(values[i][j].first, values[i][j].second);
+
+        elapsed_ = secondsSince(start);
+    }
+
+    Real ParallelUpperBoundEngine::cpuTime() const {
+        return std::accumulate(times_.begin(), times_.end(), Real(0.0));
+    }
+
+    Real ParallelUpperBoundEngine::workNormalizedVariance(
+                                             const Statistics& stats) const {
+        Real error = stats.errorEstimate();
+        return error*error*cpuTime();
+    }
+
+}
@@ -0,0 +1,84 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallelupperboundengine.hpp
+    \brief multi-threaded upper-bound estimation for market models
+*/
+
+#ifndef quantlib_parallel_upper_bound_engine_hpp
+#define quantlib_parallel_upper_bound_engine_hpp
+
+#include <ql/models/marketmodels/callability/upperboundengine.hpp>
+#include <ql/math/statistics/statistics.hpp>
+
+namespace QuantLib {
+
+    //! Engine distributing an upper-bound estimation among workers
+    /*! The outer paths are split into contiguous blocks, one for each
+        of the given engines; the blocks, together with their nested
+        inner simulations, are run concurrently when OpenMP is
+        enabled.  The path values are added to the statistics in the
+        order of the workers, so that results don't depend on thread
+        scheduling.
+
+        Each worker must be built with its own evolvers; the market
+        model and the products can be shared, since the engines only
+        read the former and store clones of the latter.  In order to
+        reproduce a serial run, the outer generator of the i-th worker
+        must start from the path returned by firstPath(), and each of
+        its inner generators from that path times the number of inner
+        paths.  Building the inner evolvers of a worker from
+        generators with the same seed makes the inner simulations at
+        different exercise times use common random numbers.
+
+        The time spent by each worker in the last simulation is
+        stored, so that the variance of the estimate can be compared
+        with its computational cost.
+    */
+    class ParallelUpperBoundEngine {
+      public:
+        explicit ParallelUpperBoundEngine(
+              const std::vector<boost::shared_ptr<UpperBoundEngine> >& workers);
+        void multiplePathValues(Statistics& stats,
+                                Size outerPaths,
+                                Size innerPaths);
+        //! \name Inspectors
+        //@{
+        Size numberOfWorkers() const { return workers_.size(); }
+        //! time in seconds spent by each worker in the last simulation
+        const std::vector<Real>& workerTimes() const { return times_; }
+        //! total time in seconds spent by the workers
+        Real cpuTime() const;
+        //! elapsed time in seconds of the last simulation
+        Real elapsedTime() const { return elapsed_; }
+        /*! variance of the estimate times the total time spent by
+            the workers; the lower, the more efficient the
+            simulation.
+        */
+        Real workNormalizedVariance(const Statistics& stats) const;
+        //@}
+        //! index of the first outer path simulated by the given worker
+        static Size firstPath(Size worker, Size workers, Size outerPaths);
+      private:
+        std::vector<boost::shared_ptr<UpperBoundEngine> > workers_;
+        std::vector<Real> times_;
+        Real elapsed_;
+    };
+
+}
+
+#endif
@@ -177,6 +177,16 @@ namespace QuantLib {
     }
 
 
+    void UpperBoundEngine::drawPathValues(
+                                Size outerPaths,
+                                Size innerPaths,
+                                std::vector<std::pair<Real,Real> >& values) {
+        values.reserve(values.size()+outerPaths);
+        for (Size i=0; i<outerPaths; ++i)
+            values.push_back(singlePathValue(innerPaths));
+    }
+
+
     std::pair<Real,Real> UpperBoundEngine::singlePathValue(Size innerPaths) {
 
         DecoratedHedge& callable =
@@ -56,6 +56,10 @@ namespace QuantLib {
                                 Size outerPaths,
                                 Size innerPaths);
         std::pair<Real,Real> singlePathValue(Size innerPaths);
+        //! appends the values and weights of the given number of paths
+        void drawPathValues(Size outerPaths,
+                            Size innerPaths,
+                            std::vector<std::pair<Real,Real> >& values);
       private:
         Real collectCashFlows(Size currentStep,
                               Real principalInNumerairePortfolio,
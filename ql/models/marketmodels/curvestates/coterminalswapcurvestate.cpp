@@ -32,7 +32,8 @@ namespace QuantLib {
       cmSwapRates_(numberOfRates_),
       cmSwapAnnuities_(numberOfRates_, rateTaus_[numberOfRates_-1]),
       cotSwapRates_(numberOfRates_),
-      cotAnnuities_(numberOfRates_, rateTaus_[numberOfRates_-1]) {}
+      cotAnnuities_(numberOfRates_, rateTaus_[numberOfRates_-1]),
+      forwardRatesComped_(false), cmSpanningForwards_(0) {}
 
       void CoterminalSwapCurveState::setOnCoterminalSwapRates(
                                         const std::vector<Rate>& rates,
@@ -60,9 +61,11 @@ namespace QuantLib {
         }
         discRatios_[first_] = 1.0 + cotSwapRates_[first_] * cotAnnuities_[first_];
 
-        // Insert here lazy evaluation of:
+        // lazy evaluation of:
         // - forward rates
         // - constant maturity swap rates/annuities
+        forwardRatesComped_ = false;
+        cmSpanningForwards_ = 0;
     }
 
     Real CoterminalSwapCurveState::discountRatio(Size i, Size j) const {
@@ -75,7 +78,7 @@ namespace QuantLib {
     Rate CoterminalSwapCurveState::forwardRate(Size i) const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
-        forwardsFromDiscountRatios(first_, discRatios_, rateTaus_, forwardRates_);
+        computeForwardRates();
         return forwardRates_[i];
     }
 
@@ -102,10 +105,7 @@ namespace QuantLib {
                    "invalid numeraire");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
 
-        // consider lazy evaluation here
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCmSwapRates(spanningForwards);
         return cmSwapAnnuities_[i]/discRatios_[numeraire];
     }
 
@@ -114,16 +114,13 @@ namespace QuantLib {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
 
-        // consider lazy evaluation here
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCmSwapRates(spanningForwards);
         return cmSwapRates_[i];
     }
 
     const std::vector<Rate>& CoterminalSwapCurveState::forwardRates() const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
-        forwardsFromDiscountRatios(first_, discRatios_, rateTaus_, forwardRates_);
+        computeForwardRates();
         return forwardRates_;
     }
 
@@ -134,10 +131,27 @@ namespace QuantLib {
 
     const std::vector<Rate>& CoterminalSwapCurveState::cmSwapRates(Size spanningForwards) const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCmSwapRates(spanningForwards);
         return cmSwapRates_;
     }
 
+    void CoterminalSwapCurveState::computeForwardRates() const {
+        if (!forwardRatesComped_) {
+            forwardsFromDiscountRatios(first_, discRatios_, rateTaus_,
+                                       forwardRates_);
+            forwardRatesComped_ = true;
+        }
+    }
+
+    void CoterminalSwapCurveState::computeCmSwapRates(
+                                           Size spanningForwards) const {
+        if (spanningForwards != cmSpanningForwards_) {
+            constantMaturityFromDiscountRatios(spanningForwards, first_,
+                                               discRatios_, rateTaus_,
+                                               cmSwapRates_,
+                                               cmSwapAnnuities_);
+            cmSpanningForwards_ = spanningForwards;
+        }
+    }
+
 }
@@ -77,6 +77,8 @@ namespace QuantLib {
                 new CoterminalSwapCurveState(*this));
         }
       private:
+        void computeForwardRates() const;
+        void computeCmSwapRates(Size spanningForwards) const;
         Size first_;
         std::vector<DiscountFactor> discRatios_;
         mutable std::vector<Rate> forwardRates_;
@@ -84,6 +86,11 @@ namespace QuantLib {
         mutable std::vector<Real> cmSwapAnnuities_;
         std::vector<Rate> cotSwapRates_;
         std::vector<Real> cotAnnuities_;
+        // lazily calculated quantities are flagged as outdated
+        // whenever the state is set
+        mutable bool forwardRatesComped_;
+        // spanning forwards of the cached cm swap rates, or 0 if none
+        mutable Size cmSpanningForwards_;
     };
 
 }
@@ -35,7 +35,8 @@ namespace QuantLib {
       cotSwapRates_(numberOfRates_),
       cotAnnuities_(numberOfRates_,
       rateTaus_[numberOfRates_-1]),
-      firstCotAnnuityComped_(numberOfRates_)
+      firstCotAnnuityComped_(numberOfRates_),
+      cotSwapRatesComped_(false), cmSpanningForwards_(0)
     {}
 
     void LMMCurveState::setOnForwardRates(const std::vector<Rate>& rates,
@@ -65,6 +66,8 @@ namespace QuantLib {
         // - constant maturity swap rates/annuities
 
         firstCotAnnuityComped_ = numberOfRates_;
+        cotSwapRatesComped_ = false;
+        cmSpanningForwards_ = 0;
     }
 
     void LMMCurveState::setOnDiscountRatios(const std::vector<DiscountFactor>& discRatios,
@@ -93,6 +96,8 @@ namespace QuantLib {
         // - constant maturity swap rates/annuities
 
         firstCotAnnuityComped_ = numberOfRates_;
+        cotSwapRatesComped_ = false;
+        cmSpanningForwards_ = 0;
     }
 
     Real LMMCurveState::discountRatio(Size i, Size j) const {
@@ -155,10 +160,7 @@ namespace QuantLib {
                    "invalid numeraire");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
 
-        // consider lazy evaluation here
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCmSwapRates(spanningForwards);
         return cmSwapAnnuities_[i]/discRatios_[numeraire];
     }
 
@@ -167,10 +169,7 @@ namespace QuantLib {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
 
-        // consider lazy evaluation here
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCmSwapRates(spanningForwards);
         return cmSwapRates_[i];
     }
 
@@ -181,18 +180,33 @@ namespace QuantLib {
 
     const std::vector<Rate>& LMMCurveState::coterminalSwapRates() const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
-        coterminalFromDiscountRatios(first_,
-                                     discRatios_, rateTaus_,
-                                     cotSwapRates_, cotAnnuities_);
+        if (!cotSwapRatesComped_) {
+            // completes the suffix sums of the annuities, if needed...
+            coterminalSwapAnnuity(numberOfRates_, first_);
+            // ...and divides the bond spreads by them
+            for (Size i=first_; i<numberOfRates_; ++i)
+                cotSwapRates_[i] =
+                    (discRatios_[i]-discRatios_[numberOfRates_]) /
+                    cotAnnuities_[i];
+            cotSwapRatesComped_ = true;
+        }
         return cotSwapRates_;
     }
 
     const std::vector<Rate>& LMMCurveState::cmSwapRates(Size spanningForwards) const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCmSwapRates(spanningForwards);
         return cmSwapRates_;
     }
 
+    void LMMCurveState::computeCmSwapRates(Size spanningForwards) const {
+        if (spanningForwards != cmSpanningForwards_) {
+            constantMaturityFromDiscountRatios(spanningForwards, first_,
+                                               discRatios_, rateTaus_,
+                                               cmSwapRates_,
+                                               cmSwapAnnuities_);
+            cmSpanningForwards_ = spanningForwards;
+        }
+    }
+
 }
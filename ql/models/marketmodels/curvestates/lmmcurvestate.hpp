@@ -82,6 +82,7 @@ namespace QuantLib {
         }
 
       private:
+        void computeCmSwapRates(Size spanningForwards) const;
         Size first_;
         std::vector<DiscountFactor> discRatios_;
         std::vector<Rate> forwardRates_;
@@ -90,7 +91,12 @@ namespace QuantLib {
         mutable std::vector<Rate> cotSwapRates_;
         mutable std::vector<Real> cotAnnuities_;
 
+        // lazily calculated quantities are flagged as outdated
+        // whenever the state is set
         mutable Size firstCotAnnuityComped_;
+        mutable bool cotSwapRatesComped_;
+        // spanning forwards of the cached cm swap rates, or 0 if none
+        mutable Size cmSpanningForwards_;
     };
 
 }
@@ -0,0 +1,119 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file distributedaccountingengine.hpp
+    \brief simulation of market-model products on several processes
+*/
+
+#ifndef quantlib_distributed_accounting_engine_hpp
+#define quantlib_distributed_accounting_engine_hpp
+
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
+#include <ql/methods/montecarlo/samplecommunicator.hpp>
+
+namespace QuantLib {
+
+    //! Engine distributing a market-model simulation among processes
+    /*! Each process, e.g., each MPI rank, simulates a contiguous
+        block of the paths with its own engine; the path values are
+        then collected in the first process and added to its
+        statistics in process order.  The statistics passed by the
+        other processes are not modified.
+
+        Engine can be AccountingEngine or PathwiseAccountingEngine.
+        In order to reproduce a serial simulation, the Brownian
+        generator of each process must start from the path returned
+        by firstPath(); this is obtained by passing it as the number
+        of paths to skip to SobolBrownianGeneratorFactory or
+        MTBrownianGeneratorFactory.  The number of paths must be the
+        same in all processes.
+
+        \note The path values of each process are sent as a whole;
+              the required memory is proportional to the number of
+              paths times the number of values.
+    */
+    template <class Engine>
+    class DistributedAccountingEngine {
+      public:
+        DistributedAccountingEngine(
+                     const boost::shared_ptr<Engine>& engine,
+                     const boost::shared_ptr<SampleCommunicator>& comm);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+        //! index of the first path simulated by the given process
+        static Size firstPath(Size rank, Size processes,
+                              Size numberOfPaths) {
+            return ParallelAccountingEngine<Engine>::firstPath(
+                                           rank, processes, numberOfPaths);
+        }
+      private:
+        boost::shared_ptr<Engine> engine_;
+        boost::shared_ptr<SampleCommunicator> communicator_;
+    };
+
+
+    // template definitions
+
+    template <class Engine>
+    DistributedAccountingEngine<Engine>::DistributedAccountingEngine(
+                     const boost::shared_ptr<Engine>& engine,
+                     const boost::shared_ptr<SampleCommunicator>& comm)
+    : engine_(engine), communicator_(comm) {
+        QL_REQUIRE(engine_, "null engine");
+        QL_REQUIRE(communicator_, "null communicator");
+    }
+
+    template <class Engine>
+    void DistributedAccountingEngine<Engine>::multiplePathValues(
+                                                  SequenceStatisticsInc& stats,
+                                                  Size numberOfPaths) {
+        const Size n = communicator_->size(), rank = communicator_->rank();
+        QL_REQUIRE(rank < n, "invalid rank (" << rank << ") for "
+                   << n << " processes");
+        Size paths = numberOfPaths/n + (rank < numberOfPaths%n ? 1 : 0);
+
+        std::vector<std::pair<std::vector<Real>,Real> > values;
+        engine_->drawPathValues(paths, values);
+
+        // each path is sent as the number of values, the values and
+        // the weight
+        std::vector<Real> data;
+        for (Size j=0; j<values.size(); ++j) {
+            data.push_back(static_cast<Real>(values[j].first.size()));
+            data.insert(data.end(),
+                        values[j].first.begin(), values[j].first.end());
+            data.push_back(values[j].second);
+        }
+
+        std::vector<std::vector<Real> > allData;
+        communicator_->gather(data, allData);
+
+        for (Size i=0; i<allData.size(); ++i) {
+            std::vector<Real>::const_iterator p = allData[i].begin();
+            while (p != allData[i].end()) {
+                Size m = static_cast<Size>(*p++);
+                QL_REQUIRE(allData[i].end() - p > Integer(m),
+                           "truncated path values from process " << i);
+                stats.add(p, p+m, *(p+m));
+                p += m+1;
+            }
+        }
+    }
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -37,7 +38,7 @@ namespace QuantLib {
       numeraire_(numeraire), alive_(alive),
       displacements_(displacements), oneOverTaus_(taus.size()),
       pseudo_(pseudo), tmp_(taus.size(), 0.0),
-      e_(pseudo_.columns(), pseudo_.rows(), 0.0),
+      e_(pseudo_.rows(), pseudo_.columns(), 0.0),
       downs_(taus.size()), ups_(taus.size()) {
 
         // Check requirements
@@ -128,9 +129,14 @@ namespace QuantLib {
             tmp_[i] = (forwards[i]+displacements_[i]) /
                 (oneOverTaus_[i]+forwards[i]);
 
+        // The partial sums e_ are stored by rate, so that the loops
+        // over factors below run on contiguous memory in both e_ and
+        // pseudo_ and can be vectorized.
+        const Size factors = numberOfFactors_;
+
         // Enforce initialization
-        for (Size r=0; r<numberOfFactors_; ++r)
-            e_[r][std::max(0,static_cast<Integer>(numeraire_)-1)] = 0.0;
+        Size first = std::max(0,static_cast<Integer>(numeraire_)-1);
+        std::fill(e_.row_begin(first), e_.row_end(first), 0.0);
 
         // Now compute drifts: take the numeraire P_N (numeraire_=N)
         // as the reference point, divide the summation into 3 steps,
@@ -142,41 +148,138 @@ namespace QuantLib {
 
         // 2nd step: then, move backward from N-2 (included) back to
         // alive (included) (if N=0 jumps to 3rd step, if N=numberOfRates_ the
-        // e_[r][N-1] are correctly initialized):
+        // e_[N-1][r] are correctly initialized):
 
         for (Integer i=static_cast<Integer>(numeraire_)-2;
              i>=static_cast<Integer>(alive_); --i) {
-            drifts[i] = 0.0;
-            for (Size r=0; r<numberOfFactors_; ++r) {
-                e_[r][i] = e_[r][i+1] + tmp_[i+1] * pseudo_[i+1][r];
-                drifts[i] -= e_[r][i]*pseudo_[i][r];
-            }
-
-            /*
-            Matrix::column_iterator p1 = e_.column_begin(i);
-            Matrix::column_iterator end = e_.column_end(i);
-            Matrix::const_column_iterator p2 = e_.column_begin(i+1);
-            Matrix::const_row_iterator q1 = pseudo_.row_begin(i);
-            Matrix::const_row_iterator q2 = pseudo_.row_begin(i+1);
-            Real x = tmp_[i+1];
-            while (p1 != end) {
-                *p1 = *p2 + x*(*q2);
-                drifts[i] -= *p1*(*q1);
-                ++p1; ++p2; ++q1; ++q2;
+            const Real x = tmp_[i+1];
+            const Real* p = pseudo_.row_begin(i);
+            const Real* p1 = pseudo_.row_begin(i+1);
+            const Real* e1 = e_.row_begin(i+1);
+            Real* e = e_.row_begin(i);
+            Real drift = 0.0;
+            for (Size r=0; r<factors; ++r) {
+                e[r] = e1[r] + x * p1[r];
+                drift -= e[r]*p[r];
             }
-            */
+            drifts[i] = drift;
         }
 
         // 3rd step: now, move forward from N (included) up to n (excluded)
         // (if N=0 this is the only relevant computation):
         for (Size i=numeraire_; i<numberOfRates_; ++i) {
-            drifts[i] = 0.0;
-            for (Size r=0; r<numberOfFactors_; ++r) {
-                if (i==0)
-                    e_[r][i] = tmp_[i] * pseudo_[i][r];
-                else
-                    e_[r][i] = e_[r][i-1] + tmp_[i] * pseudo_[i][r];
-                drifts[i] += e_[r][i]*pseudo_[i][r];
+            const Real x = tmp_[i];
+            const Real* p = pseudo_.row_begin(i);
+            Real* e = e_.row_begin(i);
+            Real drift = 0.0;
+            if (i==0) {
+                for (Size r=0; r<factors; ++r) {
+                    e[r] = x * p[r];
+                    drift += e[r]*p[r];
+                }
+            } else {
+                const Real* e0 = e_.row_begin(i-1);
+                for (Size r=0; r<factors; ++r) {
+                    e[r] = e0[r] + x * p[r];
+                    drift += e[r]*p[r];
+                }
+            }
+            drifts[i] = drift;
+        }
+    }
+
+    void LMMDriftCalculator::computeBatch(const Matrix& forwards,
+                                          Matrix& drifts,
+                                          Size lanes) const {
+        QL_REQUIRE(forwards.rows()==numberOfRates_,
+                   "forwards.rows() <> dim");
+        QL_REQUIRE(drifts.rows()==numberOfRates_,
+                   "drifts.rows() <> dim");
+        QL_REQUIRE(lanes<=forwards.columns() && lanes<=drifts.columns(),
+                   "not enough columns for " << lanes << " paths");
+
+        const Size n = lanes;
+        if (batchTmp_.columns() != n)
+            batchTmp_ = Matrix(numberOfRates_, n, 0.0);
+
+        // Precompute forwards factor
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = forwards.row_begin(i);
+            Real* x = batchTmp_.row_begin(i);
+            const Real d = displacements_[i], t = oneOverTaus_[i];
+            for (Size l=0; l<n; ++l)
+                x[l] = (f[l]+d) / (t+f[l]);
+        }
+
+        if (isFullFactor_) {
+            // same as computePlain, one rate at a time
+            for (Size i=alive_; i<numberOfRates_; ++i) {
+                Real* drift = drifts.row_begin(i);
+                std::fill(drift, drift+n, 0.0);
+                for (Size j=downs_[i]; j<ups_[i]; ++j) {
+                    const Real c = C_[i][j];
+                    const Real* x = batchTmp_.row_begin(j);
+                    for (Size l=0; l<n; ++l)
+                        drift[l] += x[l]*c;
+                }
+                if (numeraire_>i+1)
+                    for (Size l=0; l<n; ++l)
+                        drift[l] = -drift[l];
+            }
+            return;
+        }
+
+        // same as computeReduced; the partial sums are stored with
+        // the rates and factors on the rows and the paths on the
+        // columns
+        const Size factors = numberOfFactors_;
+        if (batchE_.columns() != n)
+            batchE_ = Matrix(numberOfRates_*factors, n, 0.0);
+
+        Size first = std::max(0,static_cast<Integer>(numeraire_)-1);
+        std::fill(batchE_.row_begin(first*factors),
+                  batchE_.row_begin(first*factors) + factors*n, 0.0);
+
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_begin(numeraire_-1) + n, 0.0);
+
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            const Real* x = batchTmp_.row_begin(i+1);
+            const Real* p = pseudo_.row_begin(i);
+            const Real* p1 = pseudo_.row_begin(i+1);
+            Real* drift = drifts.row_begin(i);
+            std::fill(drift, drift+n, 0.0);
+            for (Size r=0; r<factors; ++r) {
+                const Real* e1 = batchE_.row_begin((i+1)*factors+r);
+                Real* e = batchE_.row_begin(i*factors+r);
+                for (Size l=0; l<n; ++l) {
+                    e[l] = e1[l] + x[l] * p1[r];
+                    drift[l] -= e[l]*p[r];
+                }
+            }
+        }
+
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            const Real* x = batchTmp_.row_begin(i);
+            const Real* p = pseudo_.row_begin(i);
+            Real* drift = drifts.row_begin(i);
+            std::fill(drift, drift+n, 0.0);
+            for (Size r=0; r<factors; ++r) {
+                Real* e = batchE_.row_begin(i*factors+r);
+                if (i==0) {
+                    for (Size l=0; l<n; ++l) {
+                        e[l] = x[l] * p[r];
+                        drift[l] += e[l]*p[r];
+                    }
+                } else {
+                    const Real* e0 = batchE_.row_begin((i-1)*factors+r);
+                    for (Size l=0; l<n; ++l) {
+                        e[l] = e0[l] + x[l] * p[r];
+                        drift[l] += e[l]*p[r];
+                    }
+                }
             }
         }
     }
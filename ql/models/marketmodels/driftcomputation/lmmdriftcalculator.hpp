@@ -64,6 +64,16 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! Computes the drifts of several paths at once.  Forwards
+            and drifts are stored as rates by paths, and the first
+            \c lanes columns are used; the results are the same as
+            those of compute() applied to each column.  The innermost
+            loops run over paths, so that they can be vectorized.
+        */
+        void computeBatch(const Matrix& fwds,
+                          Matrix& drifts,
+                          Size lanes) const;
+
       private:
         Size numberOfRates_, numberOfFactors_;
         bool isFullFactor_;
@@ -73,7 +83,10 @@ namespace QuantLib {
         Matrix C_, pseudo_;
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
+        // partial sums for the reduced-factor drifts, rates by factors
         mutable Matrix e_;
+        // workspace for computeBatch, resized on demand
+        mutable Matrix batchTmp_, batchE_;
         std::vector<Size> downs_, ups_;
     };
 
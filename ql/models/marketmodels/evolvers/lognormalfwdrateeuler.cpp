@@ -23,6 +23,7 @@
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/browniangenerator.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/math/fastmath.hpp>
 
 namespace QuantLib {
 
@@ -122,7 +123,7 @@ namespace QuantLib {
             logForwards_[i] +=
                 std::inner_product(A.row_begin(i), A.row_end(i),
                                    brownians_.begin(), 0.0);
-            forwards_[i] = std::exp(logForwards_[i]) - displacements_[i];
+            forwards_[i] = KernelMath::exp(logForwards_[i]) - displacements_[i];
         }
 
         // same as PC evolver with two steps dropped
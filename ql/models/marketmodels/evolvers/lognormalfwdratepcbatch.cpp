@@ -0,0 +1,215 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcbatch.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+#include <ql/math/fastmath.hpp>
+
+namespace QuantLib {
+
+    LogNormalFwdRatePcBatch::LogNormalFwdRatePcBatch(
+                           const boost::shared_ptr<MarketModel>& marketModel,
+                           const BrownianGeneratorFactory& factory,
+                           const std::vector<Size>& numeraires,
+                           Size lanes,
+                           Size initialStep)
+    : marketModel_(marketModel),
+      numeraires_(numeraires),
+      initialStep_(initialStep), lanes_(lanes), activeLanes_(0),
+      numberOfRates_(marketModel->numberOfRates()),
+      numberOfFactors_(marketModel->numberOfFactors()),
+      numberOfSteps_(marketModel->evolution().numberOfSteps()),
+      curveStates_(lanes,
+                   LMMCurveState(marketModel->evolution().rateTimes())),
+      currentStep_(initialStep),
+      displacements_(marketModel->displacements()),
+      initialLogForwards_(numberOfRates_), initialDrifts_(numberOfRates_),
+      forwards_(numberOfRates_, lanes), logForwards_(numberOfRates_, lanes),
+      drifts1_(numberOfRates_, lanes), drifts2_(numberOfRates_, lanes),
+      laneSums_(lanes), laneForwards_(numberOfRates_),
+      stepWeights_(numberOfSteps_-initialStep, lanes),
+      alive_(marketModel->evolution().firstAliveRate())
+    {
+        QL_REQUIRE(lanes > 0, "null number of lanes");
+        QL_REQUIRE(initialStep < numberOfSteps_,
+                   "initial step (" << initialStep << ") out of range; "
+                   << numberOfSteps_ << " steps given");
+        checkCompatibility(marketModel->evolution(), numeraires);
+
+        generator_ = factory.create(numberOfFactors_,
+                                    numberOfSteps_-initialStep_);
+
+        calculators_.reserve(numberOfSteps_);
+        fixedDrifts_.reserve(numberOfSteps_);
+        for (Size j=0; j<numberOfSteps_; ++j) {
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            calculators_.push_back(
+                LMMDriftCalculator(A,
+                                   displacements_,
+                                   marketModel->evolution().rateTaus(),
+                                   numeraires[j],
+                                   alive_[j]));
+            std::vector<Real> fixed(numberOfRates_);
+            for (Size k=0; k<numberOfRates_; ++k) {
+                Real variance =
+                    std::inner_product(A.row_begin(k), A.row_end(k),
+                                       A.row_begin(k), 0.0);
+                fixed[k] = -0.5*variance;
+            }
+            fixedDrifts_.push_back(fixed);
+        }
+
+        pathBrownians_.resize(numberOfSteps_-initialStep_,
+                              Matrix(numberOfFactors_, lanes));
+
+        const std::vector<Rate>& initialForwards =
+            marketModel_->initialRates();
+        for (Size i=0; i<numberOfRates_; ++i) {
+            initialLogForwards_[i] = std::log(initialForwards[i] +
+                                              displacements_[i]);
+            std::fill(forwards_.row_begin(i), forwards_.row_end(i),
+                      initialForwards[i]);
+        }
+        calculators_[initialStep_].compute(initialForwards, initialDrifts_);
+    }
+
+    const std::vector<Size>& LogNormalFwdRatePcBatch::numeraires() const {
+        return numeraires_;
+    }
+
+    Size LogNormalFwdRatePcBatch::lanes() const {
+        return lanes_;
+    }
+
+    Size LogNormalFwdRatePcBatch::activeLanes() const {
+        return activeLanes_;
+    }
+
+    void LogNormalFwdRatePcBatch::startNewPaths(Size n,
+                                                std::vector<Real>& weights) {
+        QL_REQUIRE(n <= lanes_,
+                   n << " paths required, only " << lanes_ << " lanes");
+        activeLanes_ = n;
+        currentStep_ = initialStep_;
+        weights.resize(n);
+
+        Size steps = numberOfSteps_-initialStep_;
+        generator_->nextPaths(n, weights, blockStepWeights_, blockBrownians_);
+        for (Size k=0; k<steps; ++k) {
+            std::copy(blockStepWeights_.begin()+k*n,
+                      blockStepWeights_.begin()+(k+1)*n,
+                      stepWeights_.row_begin(k));
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                std::vector<Real>::const_iterator from =
+                    blockBrownians_.begin()+(k*numberOfFactors_+r)*n;
+                std::copy(from, from+n, pathBrownians_[k].row_begin(r));
+            }
+        }
+
+        for (Size i=0; i<numberOfRates_; ++i)
+            std::fill(logForwards_.row_begin(i), logForwards_.row_begin(i)+n,
+                      initialLogForwards_[i]);
+    }
+
+    void LogNormalFwdRatePcBatch::advanceStep(std::vector<Real>& weights) {
+        QL_REQUIRE(currentStep_ < numberOfSteps_, "all steps performed");
+
+        // we're going from T1 to T2
+        const Size n = activeLanes_;
+
+        // a) compute drifts D1 at T1;
+        if (currentStep_ > initialStep_) {
+            calculators_[currentStep_].computeBatch(forwards_, drifts1_, n);
+        } else {
+            for (Size i=0; i<numberOfRates_; ++i)
+                std::fill(drifts1_.row_begin(i), drifts1_.row_begin(i)+n,
+                          initialDrifts_[i]);
+        }
+
+        // b) evolve forwards up to T2 using D1;
+        Size k = currentStep_-initialStep_;
+        weights.resize(n);
+        std::copy(stepWeights_.row_begin(k), stepWeights_.row_begin(k)+n,
+                  weights.begin());
+        const Matrix& Z = pathBrownians_[k];
+        const Matrix& A = marketModel_->pseudoRoot(currentStep_);
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+
+        Size alive = alive_[currentStep_];
+        for (Size i=alive; i<numberOfRates_; ++i) {
+            Real* logF = logForwards_.row_begin(i);
+            Real* f = forwards_.row_begin(i);
+            const Real* d1 = drifts1_.row_begin(i);
+            const Real fixed = fixedDrift[i], displacement = displacements_[i];
+            std::fill(laneSums_.begin(), laneSums_.begin()+n, 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real a = A[i][r];
+                const Real* z = Z.row_begin(r);
+                for (Size l=0; l<n; ++l)
+                    laneSums_[l] += a*z[l];
+            }
+            for (Size l=0; l<n; ++l) {
+                logF[l] += d1[l] + fixed;
+                logF[l] += laneSums_[l];
+                f[l] = KernelMath::exp(logF[l]) - displacement;
+            }
+        }
+
+        // c) recompute drifts D2 using the predicted forwards;
+        calculators_[currentStep_].computeBatch(forwards_, drifts2_, n);
+
+        // d) correct forwards using both drifts
+        for (Size i=alive; i<numberOfRates_; ++i) {
+            Real* logF = logForwards_.row_begin(i);
+            Real* f = forwards_.row_begin(i);
+            const Real* d1 = drifts1_.row_begin(i);
+            const Real* d2 = drifts2_.row_begin(i);
+            const Real displacement = displacements_[i];
+            for (Size l=0; l<n; ++l) {
+                logF[l] += (d2[l]-d1[l])/2.0;
+                f[l] = KernelMath::exp(logF[l]) - displacement;
+            }
+        }
+
+        // e) update curve states
+        for (Size l=0; l<n; ++l) {
+            for (Size i=0; i<numberOfRates_; ++i)
+                laneForwards_[i] = forwards_[i][l];
+            curveStates_[l].setOnForwardRates(laneForwards_);
+        }
+
+        ++currentStep_;
+    }
+
+    Size LogNormalFwdRatePcBatch::currentStep() const {
+        return currentStep_;
+    }
+
+    const Matrix& LogNormalFwdRatePcBatch::forwards() const {
+        return forwards_;
+    }
+
+    const CurveState& LogNormalFwdRatePcBatch::currentState(Size lane) const {
+        QL_REQUIRE(lane < activeLanes_,
+                   "lane #" << lane << " not available; "
+                   << activeLanes_ << " paths in the current batch");
+        return curveStates_[lane];
+    }
+
+}
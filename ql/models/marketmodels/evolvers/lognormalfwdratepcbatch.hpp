@@ -0,0 +1,106 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lognormalfwdratepcbatch.hpp
+    \brief predictor-corrector evolution of several LMM paths at once
+*/
+
+#ifndef quantlib_forward_rate_pc_batch_evolver_hpp
+#define quantlib_forward_rate_pc_batch_evolver_hpp
+
+#include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/math/matrix.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+    class BrownianGenerator;
+    class BrownianGeneratorFactory;
+
+    //! Predictor-Corrector evolution of a batch of paths
+    /*! This class evolves a number of paths (lanes) of a log-normal
+        forward-rate market model together, with the same
+        predictor-corrector scheme as LogNormalFwdRatePc.  Forwards
+        and drifts are stored as rates by lanes, so that the work of
+        each step (drift computation, correlation of the Brownian
+        increments, exponentiation) is performed in loops over the
+        lanes which can be vectorized.
+
+        The Brownian increments of the whole batch are drawn when the
+        paths are started, one path after the other; therefore, the
+        lanes reproduce the paths of LogNormalFwdRatePc built with
+        the same generator factory as long as all paths are evolved
+        up to the last step.
+
+        It is meant to be used through BatchAccountingEngine.
+    */
+    class LogNormalFwdRatePcBatch {
+      public:
+        LogNormalFwdRatePcBatch(const boost::shared_ptr<MarketModel>&,
+                                const BrownianGeneratorFactory&,
+                                const std::vector<Size>& numeraires,
+                                Size lanes,
+                                Size initialStep = 0);
+        const std::vector<Size>& numeraires() const;
+        //! maximum number of paths evolved together
+        Size lanes() const;
+        //! number of paths in the current batch
+        Size activeLanes() const;
+        /*! starts n new paths (n <= lanes()) and stores their
+            weights in the passed vector.
+        */
+        void startNewPaths(Size n, std::vector<Real>& weights);
+        /*! evolves all active paths by one step and stores the
+            weights of the step in the passed vector.
+        */
+        void advanceStep(std::vector<Real>& weights);
+        Size currentStep() const;
+        //! rates by lanes
+        const Matrix& forwards() const;
+        const CurveState& currentState(Size lane) const;
+      private:
+        // inputs
+        boost::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size initialStep_, lanes_, activeLanes_;
+        boost::shared_ptr<BrownianGenerator> generator_;
+        // fixed variables
+        std::vector<std::vector<Real> > fixedDrifts_;
+        // working variables
+        Size numberOfRates_, numberOfFactors_, numberOfSteps_;
+        std::vector<LMMCurveState> curveStates_;
+        Size currentStep_;
+        std::vector<Rate> displacements_, initialLogForwards_;
+        std::vector<Real> initialDrifts_;
+        Matrix forwards_, logForwards_, drifts1_, drifts2_;
+        std::vector<Real> laneSums_, laneForwards_;
+        // Brownian increments (factors by lanes) and weights
+        // (steps by lanes) of the current batch
+        std::vector<Matrix> pathBrownians_;
+        Matrix stepWeights_;
+        // the same, as returned by the generator
+        std::vector<Real> blockBrownians_, blockStepWeights_;
+        std::vector<Size> alive_;
+        // helper classes
+        std::vector<LMMDriftCalculator> calculators_;
+    };
+
+}
+
+#endif
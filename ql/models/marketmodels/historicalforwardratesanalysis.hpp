@@ -36,9 +36,75 @@
 #include <ql/quotes/simplequote.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/time/date.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <sstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // deposit and swap helpers quoted by the given quotes, in
+        // the same order as the indexes
+        inline std::vector<boost::shared_ptr<RateHelper> >
+        historicalRateHelpers(
+                const std::vector<boost::shared_ptr<IborIndex> >& iborIndexes,
+                const std::vector<boost::shared_ptr<SwapIndex> >& swapIndexes,
+                const std::vector<boost::shared_ptr<SimpleQuote> >& quotes) {
+            std::vector<boost::shared_ptr<RateHelper> > rateHelpers;
+            Size k = 0;
+
+            // Create DepositRateHelper
+            std::vector<boost::shared_ptr<IborIndex> >::const_iterator ibor;
+            for (ibor=iborIndexes.begin(); ibor!=iborIndexes.end(); ++ibor) {
+                Handle<Quote> quoteHandle(quotes[k++]);
+                rateHelpers.push_back(boost::shared_ptr<RateHelper> (new
+                    DepositRateHelper(quoteHandle,
+                                      (*ibor)->tenor(),
+                                      (*ibor)->fixingDays(),
+                                      (*ibor)->fixingCalendar(),
+                                      (*ibor)->businessDayConvention(),
+                                      (*ibor)->endOfMonth(),
+                                      (*ibor)->dayCounter())));
+            }
+
+            // Create SwapRateHelper
+            std::vector<boost::shared_ptr<SwapIndex> >::const_iterator swap;
+            for (swap=swapIndexes.begin(); swap!=swapIndexes.end(); ++swap) {
+                Handle<Quote> quoteHandle(quotes[k++]);
+                rateHelpers.push_back(boost::shared_ptr<RateHelper> (new
+                    SwapRateHelper(quoteHandle,
+                                   (*swap)->tenor(),
+                                   (*swap)->fixingCalendar(),
+                                   (*swap)->fixedLegTenor().frequency(),
+                                   (*swap)->fixedLegConvention(),
+                                   (*swap)->dayCounter(),
+                                   (*swap)->iborIndex())));
+            }
+            return rateHelpers;
+        }
+
+    }
+
+    /*! The quotes of the indexes are read first for all dates.  The
+        curves are then bootstrapped on consecutive dates, each date
+        starting from the curve of the previous one as a guess, and
+        the forward-rate changes are added to the statistics in
+        chronological order.
+
+        When sessions are enabled, the dates are split in blocks of
+        consecutive dates which are bootstrapped concurrently with
+        OpenMP, each thread on its own set of helpers and its own
+        curve; the results don't depend on the number of threads
+        except for the bootstrap accuracy.
+
+        \warning Concurrent bootstraps require sessionId() to return
+                 a different id for each OpenMP thread.  The index
+                 fixings are copied to the session of each thread.
+    */
     template<class Traits, class Interpolator>
     void historicalForwardRatesAnalysis(
                 SequenceStatistics& statistics,
@@ -70,42 +136,6 @@ namespace QuantLib {
         SavedSettings backup;
         Settings::instance().enforcesTodaysHistoricFixings() = true;
 
-        std::vector<boost::shared_ptr<RateHelper> > rateHelpers;
-
-        // Create DepositRateHelper
-        std::vector<boost::shared_ptr<SimpleQuote> > iborQuotes;
-        std::vector<boost::shared_ptr<IborIndex> >::const_iterator ibor;
-        for (ibor=iborIndexes.begin(); ibor!=iborIndexes.end(); ++ibor) {
-            boost::shared_ptr<SimpleQuote> quote(new SimpleQuote);
-            iborQuotes.push_back(quote);
-            Handle<Quote> quoteHandle(quote);
-            rateHelpers.push_back(boost::shared_ptr<RateHelper> (new
-                DepositRateHelper(quoteHandle,
-                                  (*ibor)->tenor(),
-                                  (*ibor)->fixingDays(),
-                                  (*ibor)->fixingCalendar(),
-                                  (*ibor)->businessDayConvention(),
-                                  (*ibor)->endOfMonth(),
-                                  (*ibor)->dayCounter())));
-        }
-
-        // Create SwapRateHelper
-        std::vector<boost::shared_ptr<SimpleQuote> > swapQuotes;
-        std::vector<boost::shared_ptr<SwapIndex> >::const_iterator swap;
-        for (swap=swapIndexes.begin(); swap!=swapIndexes.end(); ++swap) {
-            boost::shared_ptr<SimpleQuote> quote(new SimpleQuote);
-            swapQuotes.push_back(quote);
-            Handle<Quote> quoteHandle(quote);
-            rateHelpers.push_back(boost::shared_ptr<RateHelper> (new
-                SwapRateHelper(quoteHandle,
-                               (*swap)->tenor(),
-                               (*swap)->fixingCalendar(),
-                               (*swap)->fixedLegTenor().frequency(),
-                               (*swap)->fixedLegConvention(),
-                               (*swap)->dayCounter(),
-                               (*swap)->iborIndex())));
-        }
-
         // Set up the forward rates time grid
         Period indexTenor = fwdIndex->tenor();
         Period fixingPeriod = initialGap;
@@ -116,79 +146,139 @@ namespace QuantLib {
 
         Size nRates = fixingPeriods.size();
         statistics.reset(nRates);
-        std::vector<Rate> fwdRates(nRates);
-        std::vector<Rate> prevFwdRates(nRates);
-        std::vector<Rate> fwdRatesDiff(nRates);
         DayCounter indexDayCounter = fwdIndex->dayCounter();
         Calendar cal = fwdIndex->fixingCalendar();
+        Size nQuotes = iborIndexes.size() + swapIndexes.size();
 
-        // Bootstrap the yield curve at the currentDate
-        Natural settlementDays = 0;
-        PiecewiseYieldCurve<Traits, Interpolator> yc(settlementDays,
-                                                     cal,
-                                                     rateHelpers,
-                                                     yieldCurveDayCounter,
-                                                     std::vector<Handle<Quote> >(),
-                                                     std::vector<Date>(),
-                                                     yieldCurveAccuracy,
-                                                     i);
-
-        // start with a valid business date
+        // Read the quotes for the historical dataset,
+        // starting with a valid business date
+        std::vector<Date> dates;
+        std::vector<std::vector<Rate> > quotes;
         Date currentDate = cal.advance(startDate, 1*Days, Following);
-        bool isFirst = true;
-        // Loop over the historical dataset
         for (; currentDate<=endDate;
             currentDate = cal.advance(currentDate, step, Following)) {
 
-            // move the evaluationDate to currentDate
-            // and update ratehelpers dates...
             Settings::instance().evaluationDate() = currentDate;
 
+            std::vector<Rate> q(nQuotes);
             try {
-                // update the quotes...
-                for (Size i=0; i<iborIndexes.size(); ++i) {
-                    Rate fixing = iborIndexes[i]->fixing(currentDate, false);
-                    iborQuotes[i]->setValue(fixing);
-                }
-                for (Size i=0; i<swapIndexes.size(); ++i) {
-                    Rate fixing = swapIndexes[i]->fixing(currentDate, false);
-                    swapQuotes[i]->setValue(fixing);
-                }
+                for (Size j=0; j<iborIndexes.size(); ++j)
+                    q[j] = iborIndexes[j]->fixing(currentDate, false);
+                for (Size j=0; j<swapIndexes.size(); ++j)
+                    q[iborIndexes.size()+j] =
+                        swapIndexes[j]->fixing(currentDate, false);
             } catch (std::exception& e) {
                 skippedDates.push_back(currentDate);
                 skippedDatesErrorMessage.push_back(e.what());
                 continue;
             }
+            dates.push_back(currentDate);
+            quotes.push_back(q);
+        }
 
+        Size nDates = dates.size();
+        Size nBlocks = 1;
+        #if defined(QL_ENABLE_SESSIONS) && defined(_OPENMP)
+        nBlocks = std::max<Size>(std::min<Size>(omp_get_max_threads(),
+                                                nDates), 1);
+        std::string fixings;
+        {
+            std::ostringstream out;
+            IndexManager::instance().save(out);
+            fixings = out.str();
+        }
+        #endif
+
+        std::vector<std::vector<Rate> > fwdRates(nDates,
+                                                 std::vector<Rate>(nRates));
+        std::vector<std::string> errors(nDates);
+        // not vector<bool>, whose elements can't be written concurrently
+        std::vector<int> failed(nDates, 0);
+
+        #if defined(QL_ENABLE_SESSIONS)
+        #pragma omp parallel for schedule(static)
+        #endif
+        for (Size b=0; b<nBlocks; ++b) {
+            Size first = b*nDates/nBlocks, last = (b+1)*nDates/nBlocks;
             try {
-                for (Size i=0; i<nRates; ++i) {
-                    // Time-to-go forwards
-                    Date d = currentDate + fixingPeriods[i];
-                    fwdRates[i] = yc.forwardRate(d,
-                                                 indexTenor,
-                                                 indexDayCounter,
-                                                 Simple);
+                #if defined(QL_ENABLE_SESSIONS) && defined(_OPENMP)
+                SavedSettings threadBackup;
+                Settings::instance().enforcesTodaysHistoricFixings() = true;
+                std::istringstream in(fixings);
+                IndexManager::instance().load(in);
+                #endif
+
+                std::vector<boost::shared_ptr<SimpleQuote> > q(nQuotes);
+                for (Size j=0; j<nQuotes; ++j)
+                    q[j] = boost::shared_ptr<SimpleQuote>(new SimpleQuote);
+                std::vector<boost::shared_ptr<RateHelper> > rateHelpers =
+                    detail::historicalRateHelpers(iborIndexes,
+                                                  swapIndexes, q);
+
+                // Bootstrap the yield curve at the currentDate
+                Natural settlementDays = 0;
+                PiecewiseYieldCurve<Traits, Interpolator> yc(
+                                                 settlementDays,
+                                                 cal,
+                                                 rateHelpers,
+                                                 yieldCurveDayCounter,
+                                                 std::vector<Handle<Quote> >(),
+                                                 std::vector<Date>(),
+                                                 yieldCurveAccuracy,
+                                                 i);
+
+                for (Size k=first; k<last; ++k) {
+                    // move the evaluationDate to the current date
+                    // and update ratehelpers dates and quotes...
+                    Settings::instance().evaluationDate() = dates[k];
+                    for (Size j=0; j<nQuotes; ++j)
+                        q[j]->setValue(quotes[k][j]);
+
+                    try {
+                        for (Size j=0; j<nRates; ++j) {
+                            // Time-to-go forwards
+                            Date d = dates[k] + fixingPeriods[j];
+                            fwdRates[k][j] = yc.forwardRate(d,
+                                                            indexTenor,
+                                                            indexDayCounter,
+                                                            Simple);
+                        }
+                    } catch (std::exception& e) {
+                        failed[k] = 1;
+                        errors[k] = e.what();
+                    }
                 }
             } catch (std::exception& e) {
-                failedDates.push_back(currentDate);
-                failedDatesErrorMessage.push_back(e.what());
-                continue;
+                for (Size k=first; k<last; ++k) {
+                    failed[k] = 1;
+                    errors[k] = e.what();
+                }
+            } catch (...) {
+                for (Size k=first; k<last; ++k) {
+                    failed[k] = 1;
+                    errors[k] = "unknown error";
+                }
             }
+        }
 
-            // From 2nd step onwards, calculate forward rate
-            // relative differences
-            if (!isFirst){
-                for (Size i=0; i<nRates; ++i)
-                    fwdRatesDiff[i] = fwdRates[i]/prevFwdRates[i] -1.0;
+        // From the 2nd successful date onwards, calculate forward
+        // rate relative differences
+        std::vector<Rate> fwdRatesDiff(nRates);
+        const std::vector<Rate>* prevFwdRates = 0;
+        for (Size k=0; k<nDates; ++k) {
+            if (failed[k]) {
+                failedDates.push_back(dates[k]);
+                failedDatesErrorMessage.push_back(errors[k]);
+                continue;
+            }
+            if (prevFwdRates != 0) {
+                for (Size j=0; j<nRates; ++j)
+                    fwdRatesDiff[j] = fwdRates[k][j]/(*prevFwdRates)[j] - 1.0;
                 // add observation
                 statistics.add(fwdRatesDiff.begin(), fwdRatesDiff.end());
             }
-            else
-                isFirst = false;
-
             // Store last calculated forward rates
-            std::swap(prevFwdRates, fwdRates);
-
+            prevFwdRates = &fwdRates[k];
         }
     }
 
@@ -70,6 +70,10 @@ namespace QuantLib {
                    ") must be greater than zero");
 
         AbcdFunction abcd(a, b, c, d);
+        // the integrated covariances between all the rates are
+        // calculated together for each time interval
+        const vector<Time> fixingTimes(rateTimes.begin(),
+                                       rateTimes.end()-1);
         Time effStopTime = 0.0;
         const vector<Time>& corrTimes = corr->times();
         const vector<Time>& evolTimes = evolution.evolutionTimes();
@@ -84,12 +88,12 @@ namespace QuantLib {
                 Time effStartTime = effStopTime;
                 effStopTime = corrTimes[kk];
                 const Matrix& corrMatrix = corr->correlation(kk);
+                Matrix abcdCovariance = abcd.covariance(effStartTime,
+                                                        effStopTime,
+                                                        fixingTimes);
                 for (Size i=0; i<numberOfRates_; ++i) {
                     for (Size j=i; j<numberOfRates_; ++j) {
-                        Real cov = ks[i]*ks[j]* abcd.covariance(effStartTime,
-                                                                effStopTime,
-                                                                rateTimes[i],
-                                                                rateTimes[j]);
+                        Real cov = ks[i]*ks[j]*abcdCovariance[i][j];
                         covariance[i][j] += cov * corrMatrix[i][j];
                     }
                 }
@@ -98,12 +102,12 @@ namespace QuantLib {
             Time effStartTime = effStopTime;
             effStopTime = evolTimes[k];
             const Matrix& corrMatrix = corr->correlation(kk);
+            Matrix abcdCovariance = abcd.covariance(effStartTime,
+                                                    effStopTime,
+                                                    fixingTimes);
             for (Size i=0; i<numberOfRates_; ++i) {
                 for (Size j=i; j<numberOfRates_; ++j) {
-                    Real cov = ks[i]*ks[j]* abcd.covariance(effStartTime,
-                                                            effStopTime,
-                                                            rateTimes[i],
-                                                            rateTimes[j]);
+                    Real cov = ks[i]*ks[j]*abcdCovariance[i][j];
                     covariance[i][j] += cov * corrMatrix[i][j];
                 }
             }
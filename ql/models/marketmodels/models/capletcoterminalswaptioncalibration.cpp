@@ -88,10 +88,10 @@ namespace QuantLib {
 
         // factor reduction
         std::vector<Matrix> corrPseudo(corr.times().size());
+        PseudoSqrtCalculator pseudoSqrtCalculator(SalvagingAlgorithm::None);
         for (Size i=0; i<corrPseudo.size(); ++i)
-            corrPseudo[i] = rankReducedSqrt(corr.correlation(i),
-                                            numberOfFactors, 1.0,
-                                            SalvagingAlgorithm::None);
+            corrPseudo[i] = pseudoSqrtCalculator.rankReducedSqrt(
+                                   corr.correlation(i), numberOfFactors, 1.0);
 
         Matrix zedMatrix =
             SwapForwardMappings::coterminalSwapZedMatrix(cs, displacement);
@@ -0,0 +1,241 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallelaccountingengine.hpp
+    \brief multi-threaded simulation of market-model products
+*/
+
+#ifndef quantlib_parallel_accounting_engine_hpp
+#define quantlib_parallel_accounting_engine_hpp
+
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/errors.hpp>
+#include <boost/shared_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Engine distributing a market-model simulation among workers
+    /*! The paths are split into contiguous blocks, one for each of
+        the given engines; the blocks are simulated concurrently when
+        OpenMP is enabled, and the resulting path values are added to
+        the statistics in the order of the workers, so that results
+        don't depend on thread scheduling.
+
+        Engine can be AccountingEngine, PathwiseAccountingEngine,
+        ProxyGreekEngine, PathwiseVegasAccountingEngine or
+        PathwiseVegasOuterAccountingEngine; each worker must be built
+        with its own
+        evolver and product clone.  In order to reproduce a serial
+        simulation, the Brownian generator of the i-th worker must
+        start from the path returned by firstPath(); with Sobol
+        generators, this is obtained by passing it as the number of
+        paths to skip to SobolBrownianGeneratorFactory.  Pseudo-random
+        generators can be given different seeds instead.
+
+        \note The values of all paths are stored before being added
+              to the statistics; the required memory is proportional
+              to the number of paths times the number of values.
+              This is not the case for the pathwise-vega engines,
+              whose workers only return the sums of the values and
+              of their squares.
+    */
+    template <class Engine>
+    class ParallelAccountingEngine {
+      public:
+        explicit ParallelAccountingEngine(
+                      const std::vector<boost::shared_ptr<Engine> >& workers);
+        //! for AccountingEngine and PathwiseAccountingEngine
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+        //! for ProxyGreekEngine
+        void multiplePathValues(
+                 SequenceStatisticsInc& stats,
+                 std::vector<std::vector<SequenceStatisticsInc> >& modifiedStats,
+                 Size numberOfPaths);
+        //! for PathwiseVegasAccountingEngine and PathwiseVegasOuterAccountingEngine
+        /*! The results are those of the multiplePathValues method of
+            the former and of the multiplePathValuesElementary method
+            of the latter.
+        */
+        void multiplePathValues(std::vector<Real>& means,
+                                std::vector<Real>& errors,
+                                Size numberOfPaths);
+        Size numberOfWorkers() const { return workers_.size(); }
+        //! index of the first path simulated by the given worker
+        static Size firstPath(Size worker, Size workers, Size numberOfPaths);
+      private:
+        typedef std::vector<std::pair<std::vector<Real>,Real> > path_values;
+        void drawPathValues(Size numberOfPaths,
+                            std::vector<path_values>& values);
+        std::vector<boost::shared_ptr<Engine> > workers_;
+    };
+
+
+    // template definitions
+
+    template <class Engine>
+    ParallelAccountingEngine<Engine>::ParallelAccountingEngine(
+                      const std::vector<boost::shared_ptr<Engine> >& workers)
+    : workers_(workers) {
+        QL_REQUIRE(!workers_.empty(), "no workers given");
+        for (Size i=0; i<workers_.size(); ++i)
+            QL_REQUIRE(workers_[i], "null worker #" << i);
+    }
+
+    template <class Engine>
+    Size ParallelAccountingEngine<Engine>::firstPath(Size worker,
+                                                     Size workers,
+                                                     Size numberOfPaths) {
+        QL_REQUIRE(worker < workers,
+                   "worker #" << worker << " not available; "
+                   << workers << " workers given");
+        Size r = numberOfPaths % workers;
+        return worker*(numberOfPaths/workers) + std::min(worker, r);
+    }
+
+    template <class Engine>
+    void ParallelAccountingEngine<Engine>::drawPathValues(
+                                         Size numberOfPaths,
+                                         std::vector<path_values>& values) {
+        Size n = workers_.size();
+        values.resize(n);
+        std::vector<std::string> errors(n);
+        // not vector<bool>, whose elements can't be written
+        // concurrently
+        std::vector<int> failed(n, 0);
+
+        #pragma omp parallel for num_threads(n) schedule(static)
+        for (Size i=0; i<n; ++i) {
+            Size batch = numberOfPaths/n + (i < numberOfPaths%n ? 1 : 0);
+            try {
+                workers_[i]->drawPathValues(batch, values[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+                failed[i] = 1;
+            } catch (...) {
+                errors[i] = "unknown error";
+                failed[i] = 1;
+            }
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(!failed[i],
+                       "worker " << i << " failed: " << errors[i]);
+    }
+
+    template <class Engine>
+    void ParallelAccountingEngine<Engine>::multiplePathValues(
+                                                  SequenceStatisticsInc& stats,
+                                                  Size numberOfPaths) {
+        std::vector<path_values> values;
+        drawPathValues(numberOfPaths, values);
+        for (Size i=0; i<values.size(); ++i)
+            for (Size j=0; j<values[i].size(); ++j)
+                stats.add(values[i][j].first, values[i][j].second);
+    }
+
+    template <class Engine>
+    void ParallelAccountingEngine<Engine>::multiplePathValues(
+                 SequenceStatisticsInc& stats,
+                 std::vector<std::vector<SequenceStatisticsInc> >& modifiedStats,
+                 Size numberOfPaths) {
+        std::vector<path_values> values;
+        drawPathValues(numberOfPaths, values);
+
+        Size greeks = 0;
+        for (Size k=0; k<modifiedStats.size(); ++k)
+            greeks += modifiedStats[k].size();
+
+        for (Size i=0; i<values.size(); ++i) {
+            for (Size j=0; j<values[i].size(); ++j) {
+                const std::vector<Real>& v = values[i][j].first;
+                QL_REQUIRE(v.size() % (greeks+1) == 0,
+                           "wrong number of path values (" << v.size()
+                           << ") for " << greeks << " Greeks");
+                Size N = v.size()/(greeks+1);
+                stats.add(v.begin(), v.begin()+N);
+                Size offset = N;
+                for (Size k=0; k<modifiedStats.size(); ++k) {
+                    for (Size l=0; l<modifiedStats[k].size(); ++l) {
+                        modifiedStats[k][l].add(v.begin()+offset,
+                                                v.begin()+offset+N);
+                        offset += N;
+                    }
+                }
+            }
+        }
+    }
+
+    template <class Engine>
+    void ParallelAccountingEngine<Engine>::multiplePathValues(
+                                                  std::vector<Real>& means,
+                                                  std::vector<Real>& errors,
+                                                  Size numberOfPaths) {
+        Size n = workers_.size();
+        std::vector<std::vector<Real> > sums(n), sumsOfSquares(n);
+        std::vector<std::string> messages(n);
+        std::vector<int> failed(n, 0);
+
+        #pragma omp parallel for num_threads(n) schedule(static)
+        for (Size i=0; i<n; ++i) {
+            Size batch = numberOfPaths/n + (i < numberOfPaths%n ? 1 : 0);
+            try {
+                workers_[i]->sumPathValues(batch, sums[i],
+                                           sumsOfSquares[i]);
+            } catch (std::exception& e) {
+                messages[i] = e.what();
+                failed[i] = 1;
+            } catch (...) {
+                messages[i] = "unknown error";
+                failed[i] = 1;
+            }
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(!failed[i],
+                       "worker " << i << " failed: " << messages[i]);
+
+        // the sums are combined in the order of the workers
+        Size m = sums.front().size();
+        means.assign(m, 0.0);
+        errors.resize(m);
+        std::vector<Real> meanSquares(m, 0.0);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(sums[i].size() == m,
+                       "worker " << i << " returned " << sums[i].size()
+                       << " values instead of " << m);
+            for (Size j=0; j<m; ++j) {
+                means[j] += sums[i][j];
+                meanSquares[j] += sumsOfSquares[i][j];
+            }
+        }
+        for (Size j=0; j<m; ++j) {
+            means[j] /= numberOfPaths;
+            meanSquares[j] /= numberOfPaths;
+            Real variance = meanSquares[j] - means[j]*means[j];
+            errors[j] = std::sqrt(variance/numberOfPaths);
+        }
+    }
+
+}
+
+
+#endif
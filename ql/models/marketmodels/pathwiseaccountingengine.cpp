@@ -23,7 +23,9 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/math/memorypool.hpp>
 #include <algorithm>
+#include <numeric>
 
 namespace QuantLib {
 
@@ -312,6 +314,7 @@ namespace QuantLib {
     void PathwiseAccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
         Size numberOfPaths)
     {
+        MemoryPool::Scope pool;
         std::vector<Real> values(product_->numberOfProducts()*(numberRates_+1));
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -320,6 +323,21 @@ namespace QuantLib {
         }
     }
 
+    void PathwiseAccountingEngine::drawPathValues(
+                     Size numberOfPaths,
+                     std::vector<std::pair<std::vector<Real>,Real> >& values)
+    {
+        MemoryPool::Scope pool;
+        std::vector<Real> pathValues(
+                          product_->numberOfProducts()*(numberRates_+1));
+        values.reserve(values.size()+numberOfPaths);
+        for (Size i=0; i<numberOfPaths; ++i)
+        {
+            Real weight = singlePathValues(pathValues);
+            values.push_back(std::make_pair(pathValues, weight));
+        }
+    }
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
  
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -357,17 +375,31 @@ namespace QuantLib {
 
         numberBumps_ = vegaBumps[0].size();
 
+        Size factors = pseudoRootStructure_->numberOfFactors();
+
+        // the bumps are stored contiguously, one row for each step and bump
+        vegaBumps_ = Matrix(numberSteps_*numberBumps_, numberRates_*factors);
+
         for (Size i =0; i < numberSteps_; ++i)
         {
             Size thisSize = vegaBumps[i].size();
             QL_REQUIRE(thisSize == numberBumps_,"We must have precisely the same number of bumps for each step.");
-            jacobianComputers_.push_back(RatePseudoRootJacobian(pseudoRootStructure_->pseudoRoot(i),evolution.firstAliveRate()[i],
+            jacobianComputers_.push_back(RatePseudoRootJacobianAllElements(pseudoRootStructure_->pseudoRoot(i),evolution.firstAliveRate()[i],
                                 numeraires_[i],
                                 evolution.rateTaus(),
-                                vegaBumps[i], pseudoRootStructure_->displacements()));
+                                pseudoRootStructure_->displacements()));
+
+            for (Size j=0; j < numberBumps_; ++j)
+            {
+                QL_REQUIRE(vegaBumps[i][j].rows()==numberRates_,
+                    "vegaBumps[i][j].rows()<> number of rates with i = " << i << " and j = " << j);
 
-            jacobiansThisPaths_.push_back(Matrix(numberBumps_,pseudoRootStructure_->numberOfRates()));
+                QL_REQUIRE(vegaBumps[i][j].columns()==factors,
+                    "vegaBumps[i][j].columns()<> factors with i = " << i << " and j = " << j);
 
+                std::copy(vegaBumps[i][j].begin(), vegaBumps[i][j].end(),
+                          vegaBumps_.row_begin(i*numberBumps_+j));
+            }
         }
 
 
@@ -409,6 +441,20 @@ namespace QuantLib {
         StepsDiscountsSquared_ = VModel;
         LIBORRates_ =VModel;
 
+        // the rates before the first step are used by the jacobian computers
+        std::copy(pseudoRootStructure_->initialRates().begin(),
+                  pseudoRootStructure_->initialRates().end(),
+                  LIBORRates_.row_begin(0));
+
+        StepsDiscounts_ = Matrix(numberSteps_+1,numberRates_+1);
+        for (Size i=0; i <= numberSteps_; ++i)
+            StepsDiscounts_[i][0] = 1.0;
+
+        brownians_ = Matrix(numberSteps_,pseudoRootStructure_->numberOfFactors());
+        browniansThisStep_.resize(pseudoRootStructure_->numberOfFactors());
+        rateSensitivities_.resize(numberRates_);
+        elementaryVegas_ = Matrix(numberRates_,pseudoRootStructure_->numberOfFactors());
+
 
 
 
@@ -503,11 +549,13 @@ namespace QuantLib {
                 Discounts_[storeStep][i+1] = evolver_->currentState().discountRatio(i+1,0);
             }
 
-            jacobianComputers_[thisStep].getBumps(lastForwards_,
-                                         stepsDiscounts_,
-                                         currentForwards_,
-                                         evolver_->browniansThisStep(),
-                                         jacobiansThisPaths_[thisStep]);
+            // the derivatives with respect to the pseudo-roots are computed
+            // during the backward sweep; only what they need is stored
+            std::copy(stepsDiscounts_.begin(), stepsDiscounts_.end(),
+                      StepsDiscounts_.row_begin(storeStep));
+            std::copy(evolver_->browniansThisStep().begin(),
+                      evolver_->browniansThisStep().end(),
+                      brownians_.row_begin(thisStep));
 
 
 
@@ -583,17 +631,6 @@ namespace QuantLib {
                                 V_[j][stepToUse][i-1] += thisDerivative; // zeroth row of V is t =0 not t_0
                             }
 
-                            // ok we've got the derivatives and stored them, now add them to vegas
-                            // this corresponds to the \frac{\partial F_n}[\partial theta} term
-                            // we add the indirect terms later
-
-                            for (Size k=0; k < numberBumps_; ++k)
-                                for (Size i=0; i < numberRates_; ++i)
-                                {
-                                    vegasThisPath_[j][k] +=  fullDerivatives_[i]*jacobiansThisPaths_[stepToUse-1][k][i];
-                                }
-
-
                         } // end of (numberCashFlowsThisIndex_[j][cashFlowIndex] > 0)
                     } // end of (Size j=0; j < numberProducts_; ++j)
                 } // end of  if (!noFlows)
@@ -644,15 +681,6 @@ namespace QuantLib {
 
                         } //end of  for (Size j=0; j < numberRates_; ++j)
 
-                    // we've done the Vs now the vegas
-
-                        if (nextStepIndex >0)
-
-                            for (Size l=0; l < numberBumps_; ++l)
-                                for (Size j=0; j < numberRates_; ++j)
-                                    vegasThisPath_[i][l] +=  V_[i][nextStepIndex][j] * jacobiansThisPaths_[nextStepIndex-1][l][j];
-
-
                     } // end of (Size i=0; i < numberProducts_; ++i)
 
 
@@ -662,6 +690,41 @@ namespace QuantLib {
 
         } // end of  for (Integer currentStep =  numberSteps_-1; currentStep >=0 ; --currentStep)
 
+        // all V's computed, we now pair them against the sensitivities of the rates to the bumps
+        // each step is done in reverse mode: the sensitivities of V to the elementary vegas are computed
+        // without the derivatives of the rates, and then combined with the bumps of the step
+
+        for (Integer step = finalStepDone; step >= 0; --step)
+        {
+            std::copy(brownians_.row_begin(step), brownians_.row_end(step),
+                      browniansThisStep_.begin());
+            std::copy(LIBORRates_.row_begin(step), LIBORRates_.row_end(step),
+                      lastForwards_.begin());
+            std::copy(LIBORRates_.row_begin(step+1), LIBORRates_.row_end(step+1),
+                      currentForwards_.begin());
+            std::copy(StepsDiscounts_.row_begin(step+1), StepsDiscounts_.row_end(step+1),
+                      stepsDiscounts_.begin());
+
+            for (Size i=0; i < numberProducts_; ++i)
+            {
+                std::copy(V_[i].row_begin(step+1), V_[i].row_end(step+1),
+                          rateSensitivities_.begin());
+
+                jacobianComputers_[step].getVegas(lastForwards_,
+                                                 stepsDiscounts_,
+                                                 currentForwards_,
+                                                 browniansThisStep_,
+                                                 rateSensitivities_,
+                                                 elementaryVegas_);
+
+                for (Size l=0; l < numberBumps_; ++l)
+                    vegasThisPath_[i][l] += std::inner_product(elementaryVegas_.begin(),
+                                                               elementaryVegas_.end(),
+                                                               vegaBumps_.row_begin(step*numberBumps_+l),
+                                                               0.0);
+            }
+        }
+
         // write answer into values
 
         Size entriesPerProduct = 1+numberRates_+numberBumps_;
@@ -678,16 +741,17 @@ namespace QuantLib {
         return 1.0; // we have put the weight in already, this results in lower variance since weight changes along the path
     }
 
-    void PathwiseVegasAccountingEngine::multiplePathValues(std::vector<Real>& means, std::vector<Real>& errors,
-        Size numberOfPaths)
+    void PathwiseVegasAccountingEngine::sumPathValues(Size numberOfPaths,
+        std::vector<Real>& sums, std::vector<Real>& sumsqs)
     {
         std::vector<Real> values(product_->numberOfProducts()*(1+numberRates_+numberBumps_));
-        means.resize(values.size());
-        errors.resize(values.size());
-        std::vector<Real> sums(values.size(),0.0);
-        std::vector<Real> sumsqs(values.size(),0.0);
-
-
+        if (sums.empty())
+            sums.resize(values.size(), 0.0);
+        if (sumsqs.empty())
+            sumsqs.resize(values.size(), 0.0);
+        QL_REQUIRE(sums.size() == values.size() && sumsqs.size() == values.size(),
+                   "we need " << values.size() << " sums, " << sums.size()
+                   << " and " << sumsqs.size() << " given");
 
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -700,8 +764,17 @@ namespace QuantLib {
 
             }
         }
+    }
 
-        for (Size j=0; j < values.size(); ++j)
+    void PathwiseVegasAccountingEngine::multiplePathValues(std::vector<Real>& means, std::vector<Real>& errors,
+        Size numberOfPaths)
+    {
+        std::vector<Real> sums, sumsqs;
+        sumPathValues(numberOfPaths, sums, sumsqs);
+        means.resize(sums.size());
+        errors.resize(sums.size());
+
+        for (Size j=0; j < sums.size(); ++j)
             {
                 means[j] = sums[j]/numberOfPaths;
                 Real meanSq = sumsqs[j]/numberOfPaths;
@@ -731,7 +804,6 @@ namespace QuantLib {
         numberCashFlowsThisStep_(product->numberOfProducts()),
         cashFlowsGenerated_(product->numberOfProducts()),
         stepsDiscounts_(pseudoRootStructure_->numberOfRates()+1),
-        elementary_vegas_ThisPath_(product->numberOfProducts()),
         deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1)
     {
 
@@ -751,21 +823,12 @@ namespace QuantLib {
 
         numberBumps_ = vegaBumps[0].size();
 
-       std::vector<Matrix> jacobiansThisPathsModel;
-       for (Size i =0; i < numberRates_; ++i)
-              jacobiansThisPathsModel.push_back(Matrix(numberRates_,factors_));
-
-
-
         for (Size i =0; i < numberSteps_; ++i)
         {
               jacobianComputers_.push_back(RatePseudoRootJacobianAllElements(pseudoRootStructure_->pseudoRoot(i),evolution.firstAliveRate()[i],
                                 numeraires_[i],
                                 evolution.rateTaus(),
                                 pseudoRootStructure_->displacements()));
-
-              // vector of vector of matrices to store jacobians of rates with respect to pseudo-root elements
-            jacobiansThisPaths_.push_back(jacobiansThisPathsModel);
         }
 
 
@@ -807,6 +870,20 @@ namespace QuantLib {
         StepsDiscountsSquared_ = VModel;
         LIBORRates_ =VModel;
 
+        // the rates before the first step are used by the jacobian computers
+        std::copy(pseudoRootStructure_->initialRates().begin(),
+                  pseudoRootStructure_->initialRates().end(),
+                  LIBORRates_.row_begin(0));
+
+        StepsDiscounts_ = Matrix(numberSteps_+1,numberRates_+1);
+        for (Size i=0; i <= numberSteps_; ++i)
+            StepsDiscounts_[i][0] = 1.0;
+
+        brownians_ = Matrix(numberSteps_,pseudoRootStructure_->numberOfFactors());
+        browniansThisStep_.resize(pseudoRootStructure_->numberOfFactors());
+        rateSensitivities_.resize(numberRates_);
+        elementaryVegas_ = Matrix(numberRates_,pseudoRootStructure_->numberOfFactors());
+
 
 
 
@@ -842,23 +919,6 @@ namespace QuantLib {
 
         partials_ = Matrix(pseudoRootStructure_->numberOfFactors(),numberRates_);
 
-//      set up this container object        
-//        std::vector<std::vector<std::vector<Matrix> >  > elementary_vegas_ThisPath_;  // dimensions are product, step, rate, rate and factor
-
-        { // force destruction of modelVegaMatrix as soon as no longer needed 
-            Matrix modelVegaMatrix(numberRates_, factors_,0.0);
-
-            for (Size i=0; i < numberProducts_; ++i)
-            {  
-                elementary_vegas_ThisPath_[i].resize(numberSteps_);
-                for (Size j=0; j < numberSteps_; ++j)
-                {
-                   
-                        elementary_vegas_ThisPath_[i][j]= modelVegaMatrix;
-                }
-            }
-        } // modelVegaMatrix destroyed here 
-
         numberElementaryVegas_ = numberSteps_*numberRates_*factors_;
 /*
         gaussians_.resize(numberSteps_);
@@ -924,13 +984,13 @@ namespace QuantLib {
                 Discounts_[storeStep][i+1] = evolver_->currentState().discountRatio(i+1,0);
             }
 
-            jacobianComputers_[thisStep].getBumps(lastForwards_,
-                                         stepsDiscounts_,
-                                         currentForwards_,
-                                         evolver_->browniansThisStep(),
-                                         jacobiansThisPaths_[thisStep]);
-
-//            gaussians_[thisStep] = evolver_->browniansThisStep();
+            // the derivatives with respect to the pseudo-roots are computed
+            // during the backward sweep; only what they need is stored
+            std::copy(stepsDiscounts_.begin(), stepsDiscounts_.end(),
+                      StepsDiscounts_.row_begin(storeStep));
+            std::copy(evolver_->browniansThisStep().begin(),
+                      evolver_->browniansThisStep().end(),
+                      brownians_.row_begin(thisStep));
 
 
 
@@ -1064,39 +1124,6 @@ namespace QuantLib {
         } // end of  for (Integer currentStep =  numberSteps_-1; currentStep >=0 ; --currentStep)
 
 
-        // all V matrices computed we now compute the elementary vegas for this path 
-
-        for (Size i=0; i < numberProducts_; ++i)
-        {
-                for (Size j=0; j < numberSteps_; ++j)
-                {
-                    Size nextIndex = j+1;
-
-                    // we know V, we need to pair against the senstivity of the rate to the elementary vega
-                    // note the simplification here arising from the fact that the elementary vega affects the evolution on precisely one step
-
-                    for (Size k=0; k < numberRates_; ++k)
-                        for (Size f=0; f < factors_; ++f)
-                        {
-                                Real sensitivity =0.0;
-
-                                for (Size r=0; r < numberRates_; ++r)
-                                {
-                                        sensitivity += V_[i][nextIndex][r]*jacobiansThisPaths_[j][r][k][f];
-
-                                  }
-/*
-                                  if (j ==distinguishedStep_ && k ==distinguishedRate_ &&f== distinguishedFactor_)
-                                      std::cout << sensitivity << "," <<  jacobiansThisPaths_[j][j][k][f] << "," << gaussians_[j][f] << "," << V_[i][nextIndex][j] << "," << LIBORRates_[nextIndex][j] << "\n";
-  */                
-
-
-                                elementary_vegas_ThisPath_[i][j][k][f] = sensitivity;
-                        }
-                }
-        }
-
-
         // write answer into values
 
         Size entriesPerProduct = 1+numberRates_+numberElementaryVegas_;
@@ -1107,29 +1134,62 @@ namespace QuantLib {
             for (Size j=0; j < numberRates_; ++j)
                 values[i*entriesPerProduct+1+j] = V_[i][0][j]*initialNumeraireValue_;
 
-            for (Size k=0; k < numberSteps_; ++k)
-                for (Size l=0; l < numberRates_; ++l)
-                    for (Size m=0; m < factors_; ++m)
-                        values[i*entriesPerProduct + numberRates_ +1 + m+ l*factors_ + k*numberRates_*factors_] = elementary_vegas_ThisPath_[i][k][l][m]*initialNumeraireValue_;
+            // steps after the end of the path don't contribute
+            std::fill(values.begin()+i*entriesPerProduct+1+numberRates_+(finalStepDone+1)*numberRates_*factors_,
+                      values.begin()+(i+1)*entriesPerProduct,
+                      0.0);
+        }
+
+        // all V matrices computed we now compute the elementary vegas for this path
+        // we know V, we need to pair against the senstivity of the rate to the elementary vega
+        // note the simplification here arising from the fact that the elementary vega affects the evolution on precisely one step
+        // the sensitivities are obtained for each step in reverse mode, without storing the derivatives of the rates
+
+        for (Integer step = finalStepDone; step >= 0; --step)
+        {
+            std::copy(brownians_.row_begin(step), brownians_.row_end(step),
+                      browniansThisStep_.begin());
+            std::copy(LIBORRates_.row_begin(step), LIBORRates_.row_end(step),
+                      lastForwards_.begin());
+            std::copy(LIBORRates_.row_begin(step+1), LIBORRates_.row_end(step+1),
+                      currentForwards_.begin());
+            std::copy(StepsDiscounts_.row_begin(step+1), StepsDiscounts_.row_end(step+1),
+                      stepsDiscounts_.begin());
 
+            for (Size i=0; i < numberProducts_; ++i)
+            {
+                std::copy(V_[i].row_begin(step+1), V_[i].row_end(step+1),
+                          rateSensitivities_.begin());
+
+                jacobianComputers_[step].getVegas(lastForwards_,
+                                                 stepsDiscounts_,
+                                                 currentForwards_,
+                                                 browniansThisStep_,
+                                                 rateSensitivities_,
+                                                 elementaryVegas_);
+
+                std::vector<Real>::iterator out =
+                    values.begin() + i*entriesPerProduct + numberRates_ + 1 + step*numberRates_*factors_;
+                for (Matrix::const_iterator e = elementaryVegas_.begin(); e != elementaryVegas_.end(); ++e, ++out)
+                    *out = (*e)*initialNumeraireValue_;
+            }
         }
 
         return 1.0; // we have put the weight in already, this results in lower variance since weight changes along the path
     
 }
 
-    void PathwiseVegasOuterAccountingEngine::multiplePathValuesElementary(std::vector<Real>& means, std::vector<Real>& errors,
-        Size numberOfPaths)
+    void PathwiseVegasOuterAccountingEngine::sumPathValues(Size numberOfPaths,
+        std::vector<Real>& sums, std::vector<Real>& sumsqs)
     {
-        Size numberOfElementaryVegas = numberRates_*numberSteps_*factors_;
-
-        std::vector<Real> values(product_->numberOfProducts()*(1+numberRates_+numberOfElementaryVegas));
-        means.resize(values.size());
-        errors.resize(values.size());
-        std::vector<Real> sums(values.size(),0.0);
-        std::vector<Real> sumsqs(values.size(),0.0);
-
-
+        std::vector<Real> values(product_->numberOfProducts()*(1+numberRates_+numberElementaryVegas_));
+        if (sums.empty())
+            sums.resize(values.size(), 0.0);
+        if (sumsqs.empty())
+            sumsqs.resize(values.size(), 0.0);
+        QL_REQUIRE(sums.size() == values.size() && sumsqs.size() == values.size(),
+                   "we need " << values.size() << " sums, " << sums.size()
+                   << " and " << sumsqs.size() << " given");
 
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -1142,8 +1202,17 @@ namespace QuantLib {
 
             }
         }
+    }
+
+    void PathwiseVegasOuterAccountingEngine::multiplePathValuesElementary(std::vector<Real>& means, std::vector<Real>& errors,
+        Size numberOfPaths)
+    {
+        std::vector<Real> sums, sumsqs;
+        sumPathValues(numberOfPaths, sums, sumsqs);
+        means.resize(sums.size());
+        errors.resize(sums.size());
 
-        for (Size j=0; j < values.size(); ++j)
+        for (Size j=0; j < sums.size(); ++j)
             {
                 means[j] = sums[j]/numberOfPaths;
                 Real meanSq = sumsqs[j]/numberOfPaths;
@@ -51,6 +51,14 @@ namespace QuantLib {
 
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
+        //! simulates the given number of paths and stores their values
+        /*! The values and weight of each path are appended to the
+            passed vector instead of being added to statistics; this
+            is used by ParallelAccountingEngine.
+        */
+        void drawPathValues(
+                      Size numberOfPaths,
+                      std::vector<std::pair<std::vector<Real>,Real> >& values);
       private:
           Real singlePathValues(std::vector<Real>& values);
 
@@ -108,6 +116,9 @@ namespace QuantLib {
     // To compute a vega means changing the pseudo-square root at each time step
     // So for each vega, we have a vector of matrices. So we need a vector of vectors of matrices to compute all the vegas.
     // We do the outermost vector by time step and inner one by which vega.
+    // The derivatives of the rates with respect to the pseudo-roots are not stored;
+    // they are contracted with the V's step by step during the backward sweep,
+    // so that only the Brownians and discount ratios of each step are kept along the path.
     // This is tested in MarketModelTest::testPathwiseVegas
 
     class PathwiseVegasAccountingEngine 
@@ -122,6 +133,14 @@ namespace QuantLib {
         void multiplePathValues(std::vector<Real>& means,
                                 std::vector<Real>& errors,
                                 Size numberOfPaths);
+        //! simulates the given number of paths and adds their values
+        //  and squared values to the passed vectors
+        /*! The vectors are resized if empty; this is used by
+            ParallelAccountingEngine.
+        */
+        void sumPathValues(Size numberOfPaths,
+                           std::vector<Real>& sums,
+                           std::vector<Real>& sumsOfSquares);
       private:
           Real singlePathValues(std::vector<Real>& values);
 
@@ -137,7 +156,8 @@ namespace QuantLib {
         Size numberSteps_;
         Size numberBumps_;
 
-        std::vector<RatePseudoRootJacobian> jacobianComputers_;
+        std::vector<RatePseudoRootJacobianAllElements> jacobianComputers_;
+        Matrix vegaBumps_; // dimensions are step times bump, and rate times factor
 
         
         bool doDeflation_;
@@ -157,16 +177,21 @@ namespace QuantLib {
         Matrix Discounts_; // dimensions are step and rate number, goes from 0 to n. P(t_0, t_j)
 
         Matrix StepsDiscountsSquared_; // dimensions are step and rate number
+        Matrix StepsDiscounts_; // dimensions are step and rate number, goes from 0 to n
+        Matrix brownians_; // dimensions are step and factor
         std::vector<Real> stepsDiscounts_;
 
         Matrix LIBORRates_; // dimensions are step and rate number
         Matrix partials_; // dimensions are factor and rate
 
         Matrix vegasThisPath_; // dimensions are product and which vega
-        std::vector<Matrix> jacobiansThisPaths_; // dimensions are step, rate and factor
 
         std::vector<Real> deflatorAndDerivatives_;
         std::vector<Real> fullDerivatives_;
+
+        // workspace for the contraction of each step
+        std::vector<Real> browniansThisStep_, rateSensitivities_;
+        Matrix elementaryVegas_; // dimensions are rate and factor
         
         std::vector<std::vector<Size> > numberCashFlowsThisIndex_;
         std::vector<Matrix> totalCashFlowsThisIndex_; // need product cross times cross which sensitivity
@@ -187,6 +212,8 @@ namespace QuantLib {
     // We do the outermost vector by time step and inner one by which vega.
     // This implementation is different in that all the linear combinations by the bumps are done as late as possible,
     // whereas PathwiseVegasAccountingEngine does them as early as possible. 
+    // As in PathwiseVegasAccountingEngine, the elementary vegas are obtained step by step
+    // in reverse mode without storing the derivatives of the rates.
     // This is tested in MarketModelTest::testPathwiseVegas
 
     class PathwiseVegasOuterAccountingEngine 
@@ -208,6 +235,16 @@ namespace QuantLib {
                                 std::vector<Real>& errors,
                                 Size numberOfPaths);
 
+        //! simulates the given number of paths and adds their values
+        //  and squared values to the passed vectors
+        /*! The values are those returned by multiplePathValuesElementary;
+            the vectors are resized if empty.  This is used by
+            ParallelAccountingEngine.
+        */
+        void sumPathValues(Size numberOfPaths,
+                           std::vector<Real>& sums,
+                           std::vector<Real>& sumsOfSquares);
+
       private:
           Real singlePathValues(std::vector<Real>& values);
 
@@ -246,16 +283,19 @@ namespace QuantLib {
         Matrix Discounts_; // dimensions are step and rate number, goes from 0 to n. P(t_0, t_j)
 
         Matrix StepsDiscountsSquared_; // dimensions are step and rate number
+        Matrix StepsDiscounts_; // dimensions are step and rate number, goes from 0 to n
+        Matrix brownians_; // dimensions are step and factor
         std::vector<Real> stepsDiscounts_;
 
         Matrix LIBORRates_; // dimensions are step and rate number
         Matrix partials_; // dimensions are factor and rate
 
-        std::vector<std::vector<Matrix>   > elementary_vegas_ThisPath_;  // dimensions are product, step,  rate and factor
-        std::vector<std::vector<Matrix> > jacobiansThisPaths_;                      // dimensions are step, rate, rate and factor
-
         std::vector<Real> deflatorAndDerivatives_;
         std::vector<Real> fullDerivatives_;
+
+        // workspace for the contraction of each step
+        std::vector<Real> browniansThisStep_, rateSensitivities_;
+        Matrix elementaryVegas_; // dimensions are rate and factor
         
         std::vector<std::vector<Size> > numberCashFlowsThisIndex_;
         std::vector<Matrix> totalCashFlowsThisIndex_; // need product cross times cross which sensitivity
@@ -255,7 +255,8 @@ namespace QuantLib
         factors_(pseudoRoot.columns()),
      //   bumpedRates_(taus.size()),
         e_(pseudoRoot.rows(), pseudoRoot.columns()),
-        ratios_(taus_.size())
+        ratios_(taus_.size()),
+        sums_(pseudoRoot.columns())
     {
         Size numberRates= taus.size();
 
@@ -330,6 +331,58 @@ namespace QuantLib
             }
     }
 
+    void RatePseudoRootJacobianAllElements::getVegas(const std::vector<Rate>& oldRates,
+        const std::vector<Real>& discountRatios,
+        const std::vector<Rate>& newRates,
+        const std::vector<Real>& gaussians,
+        const std::vector<Real>& rateSensitivities,
+        Matrix& vegas)
+    {
+        Size numberRates = taus_.size();
+
+        QL_REQUIRE(rateSensitivities.size() == numberRates, "we need rateSensitivities.size() which is " << rateSensitivities.size() << " to equal numberRates which is "  << numberRates);
+        QL_REQUIRE(vegas.rows() == numberRates && vegas.columns() == factors_, "we need vegas.rows() which is " << vegas.rows() << " to equal numberRates which is "  << numberRates <<
+            " and vegas.columns() which is " << vegas.columns() << " to be equal to factors which is " << factors_);
+
+        for (Size j=aliveIndex_; j < numberRates; ++j)
+            ratios_[j] = (oldRates[j] + displacements_[j])*discountRatios[j+1];
+
+        for (Size f=0; f < factors_; ++f)
+        {
+            e_[aliveIndex_][f] = 0;
+
+            for (Size j= aliveIndex_+1; j < numberRates; ++j)
+                e_[j][f] = e_[j-1][f] + ratios_[j-1]*pseudoRoot_[j-1][f];
+        }
+
+        // rates that have already reset don't depend on the pseudo-root
+        for (Size k=0; k < aliveIndex_; ++k)
+            for (Size f=0; f < factors_; ++f)
+                vegas[k][f] = 0.0;
+
+        // element (k,f) affects rate k through the diagonal term of
+        // getBumps and the later rates through their drifts; the
+        // latter are summed backwards over the rates
+        std::fill(sums_.begin(), sums_.end(), 0.0);
+        for (Size k=numberRates; k > aliveIndex_; --k)
+        {
+            Size j = k-1;
+            Real w = rateSensitivities[j];
+            Real driftTerm = ratios_[j]*taus_[j];
+            for (Size f=0; f < factors_; ++f)
+            {
+                Real tmp = 2*ratios_[j]*taus_[j]*pseudoRoot_[j][f];
+                tmp -=  pseudoRoot_[j][f];
+                tmp += e_[j][f]*taus_[j];
+                tmp += gaussians[f];
+                tmp *= (newRates[j]+displacements_[j]);
+
+                vegas[j][f] = w*tmp + driftTerm*sums_[f];
+                sums_[f] += w*newRates[j]*pseudoRoot_[j][f];
+            }
+        }
+    }
+
     
 }
 
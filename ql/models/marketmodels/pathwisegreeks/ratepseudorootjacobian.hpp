@@ -129,6 +129,21 @@ namespace QuantLib
             const std::vector<Real>& gaussians,
             std::vector<Matrix>& B); // one Matrix for each rate, the elements of the matrix are the derivatives of that rate with respect to each pseudo-root element
 
+        /*! derivatives of the sum of the new rates, weighted by the
+            given sensitivities, with respect to each pseudo-root
+            element; this is the sum of the matrices returned by
+            getBumps weighted by the sensitivities, but it is
+            calculated in reverse mode without storing them, so that
+            it takes O(rates*factors) instead of O(rates^2*factors)
+            operations and memory.
+        */
+        void getVegas(const std::vector<Rate>& oldRates,
+            const std::vector<Real>& oneStepDFs,
+            const std::vector<Rate>& newRates,
+            const std::vector<Real>& gaussians,
+            const std::vector<Real>& rateSensitivities,
+            Matrix& vegas); // rows are rates, columns are factors
+
     private:
 
         //! this data does not change after construction
@@ -143,6 +158,7 @@ namespace QuantLib
 
         Matrix e_;
         std::vector<Real> ratios_;
+        std::vector<Real> sums_;
    
     };
 
@@ -19,11 +19,13 @@
 
 #include <ql/models/marketmodels/products/compositeproduct.hpp>
 #include <ql/models/marketmodels/utilities.hpp>
+#include <ql/models/marketmodels/curvestate.hpp>
+#include <typeinfo>
 
 namespace QuantLib {
 
     MarketModelComposite::MarketModelComposite()
-    : finalized_(false) {}
+    : finalized_(false), parallelEvaluation_(false) {}
 
     const EvolutionDescription& MarketModelComposite::evolution() const {
         QL_REQUIRE(finalized_, "composite not finalized");
@@ -134,6 +136,22 @@ namespace QuantLib {
             }
         }
 
+        // group the subproducts by type for parallel evaluation
+        std::vector<const std::type_info*> types;
+        for (Size n=0; n<components_.size(); ++n) {
+            const std::type_info& type = typeid(*(components_[n].product));
+            Size k = 0;
+            while (k < types.size() && *types[k] != type)
+                ++k;
+            if (k == types.size()) {
+                types.push_back(&type);
+                batches_.push_back(std::vector<Size>());
+            }
+            batches_[k].push_back(n);
+        }
+        evolved_ = std::vector<int>(components_.size(), 0);
+        done_ = std::vector<int>(components_.size(), 0);
+
         evolution_ = EvolutionDescription(rateTimes_, evolutionTimes_);
 
         // all done.
@@ -156,4 +174,80 @@ namespace QuantLib {
         return components_.at(i).multiplier;
     }
 
+    void MarketModelComposite::setParallelEvaluation(bool flag) {
+        parallelEvaluation_ = flag;
+    }
+
+    bool MarketModelComposite::parallelEvaluation() const {
+        return parallelEvaluation_;
+    }
+
+    const std::vector<std::vector<Size> >&
+    MarketModelComposite::batches() const {
+        QL_REQUIRE(finalized_, "composite not finalized");
+        return batches_;
+    }
+
+    void MarketModelComposite::evolveComponents(
+                                         const CurveState& currentState) {
+        Size n = 0, active = 0;
+        for (iterator i=components_.begin(); i!=components_.end(); ++i, ++n) {
+            evolved_[n] = isInSubset_[n][currentIndex_] && !i->done;
+            done_[n] = 0;
+            if (evolved_[n])
+                ++active;
+        }
+
+        if (!parallelEvaluation_ || active < 2) {
+            for (n=0; n<components_.size(); ++n) {
+                if (evolved_[n]) {
+                    SubProduct& c = components_[n];
+                    done_[n] = c.product->nextTimeStep(currentState,
+                                                       c.numberOfCashflows,
+                                                       c.cashflows);
+                }
+            }
+            return;
+        }
+
+        std::vector<std::string> errors(components_.size());
+        std::vector<int> failed(components_.size(), 0);
+        #pragma omp parallel
+        {
+            // lazily calculated quantities make the curve state
+            // unsafe to share among threads
+            std::auto_ptr<CurveState> state;
+            try {
+                state = currentState.clone();
+            } catch (...) {}
+            for (Size b=0; b<batches_.size(); ++b) {
+                const std::vector<Size>& batch = batches_[b];
+                // members of a batch have comparable costs
+                #pragma omp for schedule(static)
+                for (long k=0; k<long(batch.size()); ++k) {
+                    Size m = batch[k];
+                    if (!evolved_[m])
+                        continue;
+                    try {
+                        QL_REQUIRE(state.get(),
+                                   "unable to copy the curve state");
+                        SubProduct& c = components_[m];
+                        done_[m] = c.product->nextTimeStep(*state,
+                                                           c.numberOfCashflows,
+                                                           c.cashflows);
+                    } catch (std::exception& e) {
+                        errors[m] = e.what();
+                        failed[m] = 1;
+                    } catch (...) {
+                        errors[m] = "unknown error";
+                        failed[m] = 1;
+                    }
+                }
+            }
+        }
+        for (n=0; n<components_.size(); ++n)
+            QL_REQUIRE(!failed[n],
+                       "subproduct " << n << " failed: " << errors[n]);
+    }
+
 }
@@ -31,7 +31,19 @@ namespace QuantLib {
     /*! Instances of this class build a market-model product by
         composing one or more subproducts.
 
+        Optionally, the subproducts can be evolved in parallel at
+        each step.  In this case they are grouped at finalization
+        into batches of products of the same type, and the members of
+        each batch are distributed among the available threads; each
+        thread uses its own copy of the curve state, whose lazily
+        calculated quantities are not thread-safe.  The cash flows
+        are collected in the same order as in serial evaluation, so
+        that the results don't depend on the evaluation mode.
+
         \pre All subproducts must have the same rate times.
+
+        \warning In parallel evaluation, subproducts must not share
+                 any mutable state.
     */
     class MarketModelComposite : public MarketModelMultiProduct {
       public:
@@ -54,6 +66,11 @@ namespace QuantLib {
         const MarketModelMultiProduct& item(Size i) const;
         MarketModelMultiProduct& item(Size i);
         Real multiplier(Size i) const;
+        //! evolves the subproducts in parallel at each step
+        void setParallelEvaluation(bool flag);
+        bool parallelEvaluation() const;
+        //! groups of subproducts of the same type, in order of addition
+        const std::vector<std::vector<Size> >& batches() const;
         //@}
       protected:
         // subproducts
@@ -72,8 +89,15 @@ namespace QuantLib {
         std::vector<Time> rateTimes_;
         std::vector<Time> evolutionTimes_;
         EvolutionDescription evolution_;
+        /* evolves the subproducts active at the current step;
+           evolved_[n] is set for the n-th subproduct if it was
+           evolved, and done_[n] if it returned true. */
+        void evolveComponents(const CurveState& currentState);
         // working variables
         bool finalized_;
+        bool parallelEvaluation_;
+        std::vector<std::vector<Size> > batches_;
+        std::vector<int> evolved_, done_;
         Size currentIndex_;
         std::vector<Time> cashflowTimes_;
         std::vector<std::vector<Time> > allEvolutionTimes_;
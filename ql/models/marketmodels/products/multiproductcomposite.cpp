@@ -44,18 +44,16 @@ namespace QuantLib {
                      std::vector<Size>& numberCashFlowsThisStep,
                      std::vector<std::vector<CashFlow> >& cashFlowsGenerated) {
         QL_REQUIRE(finalized_, "composite not finalized");
+        evolveComponents(currentState);
         bool done = true;
         Size n = 0, offset = 0;
         // for each sub-product...
         for (iterator i=components_.begin(); i!=components_.end(); ++i, ++n) {
-            if (isInSubset_[n][currentIndex_] && !i->done) {
-                // ...make it evolve...
-                bool thisDone = i->product->nextTimeStep(currentState,
-                                                         i->numberOfCashflows,
-                                                         i->cashflows);
-                // ...and copy the results. Time indices need to be remapped
-                // so that they point into all cash-flow times. Amounts need
-                // to be adjusted by the corresponding multiplier.
+            if (evolved_[n]) {
+                // ...copy the results of its evolution. Time indices need
+                // to be remapped so that they point into all cash-flow
+                // times. Amounts need to be adjusted by the corresponding
+                // multiplier.
                 for (Size j=0; j<i->product->numberOfProducts(); ++j) {
                     numberCashFlowsThisStep[j+offset] =
                         i->numberOfCashflows[j];
@@ -67,7 +65,7 @@ namespace QuantLib {
                     }
                 }
                 // finally, set done to false if this product isn't done
-                done = done && thisDone;
+                done = done && done_[n];
             }
             else
                 for (Size j=0; j<i->product->numberOfProducts(); ++j)
@@ -22,6 +22,7 @@
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/constrainedevolver.hpp>
+#include <ql/math/memorypool.hpp>
 #include <algorithm>
 
 namespace QuantLib {
@@ -82,6 +83,7 @@ namespace QuantLib {
                   SequenceStatisticsInc& stats,
                   std::vector<std::vector<SequenceStatisticsInc> >& modifiedStats,
                   Size numberOfPaths) {
+        MemoryPool::Scope pool;
         Size N = product_->numberOfProducts();
 
         std::vector<Real> values(N);
@@ -113,6 +115,48 @@ namespace QuantLib {
         }
     }
 
+    void ProxyGreekEngine::drawPathValues(
+                     Size numberOfPaths,
+                     std::vector<std::pair<std::vector<Real>,Real> >& values) {
+        MemoryPool::Scope pool;
+        Size N = product_->numberOfProducts();
+
+        std::vector<Real> pathValues(N);
+        std::vector<std::vector<std::vector<Real> > > modifiedValues;
+        modifiedValues.resize(constrainedEvolvers_.size());
+        for (Size i=0; i<modifiedValues.size(); ++i) {
+            modifiedValues[i].resize(constrainedEvolvers_[i].size());
+            for (Size j=0; j<modifiedValues[i].size(); ++j)
+                modifiedValues[i][j].resize(N);
+        }
+
+        Size greeks = 0;
+        for (Size j=0; j<diffWeights_.size(); ++j)
+            greeks += diffWeights_[j].size();
+
+        values.reserve(values.size()+numberOfPaths);
+        for (Size i=0; i<numberOfPaths; ++i) {
+            singlePathValues(pathValues, modifiedValues);
+
+            std::vector<Real> results(N*(greeks+1));
+            std::copy(pathValues.begin(), pathValues.end(), results.begin());
+            Size offset = N;
+            for (Size j=0; j<diffWeights_.size(); ++j) {
+                for (Size k=0; k<diffWeights_[j].size(); ++k) {
+                    const std::vector<Real>& weights = diffWeights_[j][k];
+                    for (Size l=0; l<N; ++l) {
+                        Real result = weights[0]*pathValues[l];
+                        for (Size n=1; n<weights.size(); ++n)
+                            result += weights[n]*modifiedValues[j][n-1][l];
+                        results[offset+l] = result;
+                    }
+                    offset += N;
+                }
+            }
+            values.push_back(std::make_pair(results, 1.0));
+        }
+    }
+
     void ProxyGreekEngine::singleEvolverValues(MarketModelEvolver& evolver,
                                                std::vector<Real>& values,
                                                bool storeRates) {
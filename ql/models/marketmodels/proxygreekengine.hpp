@@ -50,6 +50,17 @@ namespace QuantLib {
                   SequenceStatisticsInc& stats,
                   std::vector<std::vector<SequenceStatisticsInc> >& modifiedStats,
                   Size numberOfPaths);
+        //! simulates the given number of paths and stores their values
+        /*! For each path, the product values are appended to the
+            passed vector followed by the Greeks for each constraint
+            and set of weights, in the order in which they would be
+            added to the modified statistics by multiplePathValues.
+            The weight of each path is 1.  This is used by
+            ParallelAccountingEngine.
+        */
+        void drawPathValues(
+                      Size numberOfPaths,
+                      std::vector<std::pair<std::vector<Real>,Real> >& values);
         void singlePathValues(
                 std::vector<Real>& values,
                 std::vector<std::vector<std::vector<Real> > >& modifiedValues);
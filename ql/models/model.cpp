@@ -24,6 +24,12 @@
 #include <ql/math/optimization/projectedconstraint.hpp>
 
 #include <ql/utilities/null_deleter.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
+#include <string>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using std::vector;
 using boost::shared_ptr;
@@ -33,7 +39,8 @@ namespace QuantLib {
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None),
+      parallelCalibration_(false) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
@@ -42,15 +49,34 @@ namespace QuantLib {
                             const vector<Real>& weights,
                             const Projection& projection)
             : model_(model, null_deleter()), instruments_(h),
-              weights_(weights), projection_(projection) { }
+              weights_(weights), projection_(projection) {
+            if (model_->parallelCalibration_) {
+                for (Size i=0; i<instruments_.size(); i++) {
+                    QL_REQUIRE(instruments_[i]->calibrationErrorType() !=
+                               CalibrationHelper::ImpliedVolError,
+                               "implied-volatility errors not supported "
+                               "in parallel calibration ("
+                               << io::ordinal(i+1) << " helper)");
+                    for (Size j=0; j<i; j++)
+                        QL_REQUIRE(instruments_[i]->pricingEngine() !=
+                                   instruments_[j]->pricingEngine(),
+                                   "the " << io::ordinal(j+1) << " and "
+                                   << io::ordinal(i+1) << " helpers share "
+                                   "their pricing engine; parallel "
+                                   "calibration requires one engine "
+                                   "per helper");
+                }
+            }
+        }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
             model_->setParams(projection_.include(params));
+            Array errors = calibrationErrors();
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
+                Real diff = errors[i];
                 value += diff*diff*weights_[i];
             }
             return std::sqrt(value);
@@ -58,17 +84,99 @@ namespace QuantLib {
 
         virtual Disposable<Array> values(const Array& params) const {
             model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
+            Array values = calibrationErrors();
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] *= std::sqrt(weights_[i]);
             }
             return values;
         }
 
+        // the analytic derivatives are used when all the helpers
+        // provide them; otherwise, finite differences are used
+        virtual void gradient(Array& grad, const Array& params) const {
+            if (!analyticGradient()) {
+                CostFunction::gradient(grad, params);
+                return;
+            }
+            model_->setParams(projection_.include(params));
+            Real value = 0.0;
+            std::fill(grad.begin(), grad.end(), 0.0);
+            for (Size i=0; i<instruments_.size(); i++) {
+                Real diff = instruments_[i]->calibrationError();
+                Array g = projection_.project(
+                             instruments_[i]->calibrationErrorGradient());
+                value += diff*diff*weights_[i];
+                for (Size k=0; k<grad.size(); ++k)
+                    grad[k] += diff*weights_[i]*g[k];
+            }
+            value = std::sqrt(value);
+            if (value > 0.0)
+                grad /= value;
+        }
+
+        virtual void jacobian(Matrix& jac, const Array& params) const {
+            if (!analyticGradient()) {
+                CostFunction::jacobian(jac, params);
+                return;
+            }
+            model_->setParams(projection_.include(params));
+            for (Size i=0; i<instruments_.size(); i++) {
+                Array g = projection_.project(
+                             instruments_[i]->calibrationErrorGradient());
+                for (Size k=0; k<g.size(); ++k)
+                    jac[i][k] = g[k]*std::sqrt(weights_[i]);
+            }
+        }
+
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        Disposable<Array> calibrationErrors() const {
+            Size n = instruments_.size();
+            Array errors(n);
+            if (!model_->parallelCalibration_) {
+                for (Size i=0; i<n; i++)
+                    errors[i] = instruments_[i]->calibrationError();
+                return errors;
+            }
+
+            // market values are calculated lazily; the helpers are
+            // updated here so that they're only read by the threads
+            for (Size i=0; i<n; i++)
+                instruments_[i]->marketValue();
+
+            std::vector<std::string> messages(n);
+            // not vector<bool>, whose elements can't be written
+            // concurrently
+            std::vector<int> failed(n, 0);
+
+            #pragma omp parallel for schedule(dynamic)
+            for (Size i=0; i<n; i++) {
+                try {
+                    errors[i] = instruments_[i]->calibrationError();
+                } catch (std::exception& e) {
+                    messages[i] = e.what();
+                    failed[i] = 1;
+                } catch (...) {
+                    messages[i] = "unknown error";
+                    failed[i] = 1;
+                }
+            }
+
+            for (Size i=0; i<n; i++)
+                QL_REQUIRE(!failed[i],
+                           io::ordinal(i+1) << " helper failed: "
+                           << messages[i]);
+            return errors;
+        }
+
+        bool analyticGradient() const {
+            for (Size i=0; i<instruments_.size(); i++)
+                if (!instruments_[i]->hasModelValueGradient())
+                    return false;
+            return !instruments_.empty();
+        }
+
         shared_ptr<CalibratedModel> model_;
         const vector<shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
@@ -150,4 +258,56 @@ namespace QuantLib {
     ShortRateModel::ShortRateModel(Size nArguments)
     : CalibratedModel(nArguments) {}
 
+    void ShortRateModel::update() {
+        trees_.clear();
+        CalibratedModel::update();
+    }
+
+    namespace {
+
+        bool sameParams(const Array& p1, const Array& p2) {
+            return p1.size() == p2.size()
+                && std::equal(p1.begin(), p1.end(), p2.begin());
+        }
+
+        bool sameGrid(const TimeGrid& g1, const TimeGrid& g2) {
+            return g1.size() == g2.size()
+                && std::equal(g1.begin(), g1.end(), g2.begin());
+        }
+
+    }
+
+    boost::shared_ptr<Lattice>
+    ShortRateModel::cachedTree(const TimeGrid& grid) const {
+        #ifdef _OPENMP
+        // the store is not shared among threads
+        if (omp_in_parallel())
+            return boost::shared_ptr<Lattice>();
+        #endif
+        if (!sameParams(params(), treeParams_)) {
+            trees_.clear();
+            return boost::shared_ptr<Lattice>();
+        }
+        for (Size i=0; i<trees_.size(); ++i) {
+            if (sameGrid(trees_[i].first, grid))
+                return trees_[i].second;
+        }
+        return boost::shared_ptr<Lattice>();
+    }
+
+    void ShortRateModel::cacheTree(
+                            const TimeGrid& grid,
+                            const boost::shared_ptr<Lattice>& tree) const {
+        #ifdef _OPENMP
+        if (omp_in_parallel())
+            return;
+        #endif
+        Array params = this->params();
+        if (!sameParams(params, treeParams_)) {
+            trees_.clear();
+            treeParams_ = params;
+        }
+        trees_.push_back(std::make_pair(grid, tree));
+    }
+
 }
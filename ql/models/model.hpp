@@ -121,6 +121,27 @@ namespace QuantLib {
         virtual void setParams(const Array& params);
         Integer functionEvaluation() const { return functionEvaluation_; }
 
+        /*! \name Parallel calibration
+
+            When enabled, the calibration errors of the helpers are
+            evaluated concurrently for each set of parameters if
+            OpenMP is available; this also applies to each column of
+            a finite-difference Jacobian.  Each helper must have its
+            own pricing engine and a price-based error type, and the
+            model must be safe to read from several threads once its
+            parameters are set.
+
+            @{
+        */
+        void enableParallelCalibration(bool b = true) {
+            parallelCalibration_ = b;
+        }
+        void disableParallelCalibration() { parallelCalibration_ = false; }
+        bool allowsParallelCalibration() const {
+            return parallelCalibration_;
+        }
+        //@}
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -128,6 +149,7 @@ namespace QuantLib {
         EndCriteria::Type shortRateEndCriteria_;
         Array problemValues_;
         Integer functionEvaluation_;
+        bool parallelCalibration_;
 
       private:
         //! Constraint imposed on arguments
@@ -143,6 +165,24 @@ namespace QuantLib {
       public:
         ShortRateModel(Size nArguments);
         virtual boost::shared_ptr<Lattice> tree(const TimeGrid&) const = 0;
+        void update();
+      protected:
+        /*! Returns the tree stored by cacheTree() for the same time
+            grid, provided that the model parameters didn't change and
+            that no notification was received since; returns a null
+            pointer otherwise.
+
+            Models whose tree() fits the lattice to a term structure
+            can use these methods to avoid building the same tree for
+            each engine, e.g., for each helper during calibration.
+        */
+        boost::shared_ptr<Lattice> cachedTree(const TimeGrid&) const;
+        void cacheTree(const TimeGrid&,
+                       const boost::shared_ptr<Lattice>&) const;
+      private:
+        mutable Array treeParams_;
+        mutable std::vector<std::pair<TimeGrid,
+                                      boost::shared_ptr<Lattice> > > trees_;
     };
 
 
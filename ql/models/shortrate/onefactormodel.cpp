@@ -64,7 +64,7 @@ namespace QuantLib {
                 <TermStructureFittingParameter::NumericalImpl>& theta,
             const TimeGrid& timeGrid)
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)),
-      tree_(tree), dynamics_(dynamics) {
+      tree_(tree), dynamics_(dynamics), discounts_(timeGrid.size()) {
 
         theta->reset();
         Real value = 1.0;
@@ -87,7 +87,34 @@ namespace QuantLib {
                          const boost::shared_ptr<ShortRateDynamics>& dynamics,
                          const TimeGrid& timeGrid)
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)),
-      tree_(tree), dynamics_(dynamics) {}
+      tree_(tree), dynamics_(dynamics), discounts_(timeGrid.size()) {}
+
+    const Array& OneFactorModel::ShortRateTree::discounts(Size i) const {
+        Array& discounts = discounts_[i];
+        if (discounts.empty()) {
+            discounts = Array(size(i));
+            for (Size j=0; j<discounts.size(); j++)
+                discounts[j] = discount(i, j);
+        }
+        return discounts;
+    }
+
+    void OneFactorModel::ShortRateTree::stepback(Size i,
+                                                 const Array& values,
+                                                 Array& newValues) const {
+        tree_->expectedValues(i, values, newValues);
+        newValues *= discounts(i);
+    }
+
+    void OneFactorModel::ShortRateTree::batchStepback(
+                                    Size i,
+                                    const std::vector<const Array*>& values,
+                                    std::vector<Array>& newValues) const {
+        tree_->expectedValues(i, values, newValues);
+        const Array& d = discounts(i);
+        for (Size k=0; k<newValues.size(); k++)
+            newValues[k] *= d;
+    }
 
     OneFactorModel::OneFactorModel(Size nArguments)
     : ShortRateModel(nArguments) {}
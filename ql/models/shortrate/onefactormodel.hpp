@@ -28,6 +28,7 @@
 #include <ql/models/model.hpp>
 #include <ql/methods/lattices/lattice1d.hpp>
 #include <ql/methods/lattices/trinomialtree.hpp>
+#include <utility>
 
 namespace QuantLib {
     class StochasticProcess1D;
@@ -103,9 +104,19 @@ namespace QuantLib {
         Real probability(Size i, Size index, Size branch) const {
             return tree_->probability(i, index, branch);
         }
+        /*! The discount factors of each level are stored the first
+            time the level is rolled back through; therefore, the tree
+            must be fitted to the term structure before it's used.
+        */
+        void stepback(Size i, const Array& values, Array& newValues) const;
+        void batchStepback(Size i,
+                           const std::vector<const Array*>& values,
+                           std::vector<Array>& newValues) const;
       private:
+        const Array& discounts(Size i) const;
         boost::shared_ptr<TrinomialTree> tree_;
         boost::shared_ptr<ShortRateDynamics> dynamics_;
+        mutable std::vector<Array> discounts_;
         class Helper;
     };
 
@@ -135,6 +146,17 @@ namespace QuantLib {
             return A(now, maturity)*std::exp(-B(now, maturity)*rate);
         }
 
+        //! coefficients of the discount bond
+        /*! returns \f$ A(t,T) \f$ and \f$ B(t,T) \f$ such that
+            \f$ P(t,T,r) = A(t,T) e^{-B(t,T) r} \f$; engines
+            evaluating the same bonds for several rates can compute
+            them once.
+        */
+        std::pair<Real,Real> discountBondCoefficients(Time now,
+                                                      Time maturity) const {
+            return std::make_pair(A(now, maturity), B(now, maturity));
+        }
+
         DiscountFactor discount(Time t) const;
       protected:
         virtual Real A(Time t, Time T) const = 0;
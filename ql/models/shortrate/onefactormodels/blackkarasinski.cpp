@@ -19,7 +19,7 @@
 
 #include <ql/models/shortrate/onefactormodels/blackkarasinski.hpp>
 #include <ql/methods/lattices/trinomialtree.hpp>
-#include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/solvers1d/newtonsafe.hpp>
 
 namespace QuantLib {
 
@@ -46,6 +46,17 @@ namespace QuantLib {
             return value;
         }
 
+        Real derivative(Real theta) const {
+            Real value = 0.0;
+            Real x = xMin_;
+            for (Size j=0; j<size_; j++) {
+                Real rdt = std::exp(theta+x)*dt_;
+                value += statePrices_[j]*std::exp(-rdt)*rdt;
+                x += dx_;
+            }
+            return value;
+        }
+
       private:
         Size size_;
         Time dt_;
@@ -68,6 +79,10 @@ namespace QuantLib {
     boost::shared_ptr<Lattice>
     BlackKarasinski::tree(const TimeGrid& grid) const {
 
+        boost::shared_ptr<Lattice> cached = cachedTree(grid);
+        if (cached)
+            return cached;
+
         TermStructureFittingParameter phi(termStructure());
 
         boost::shared_ptr<ShortRateDynamics> numericDynamics(
@@ -90,13 +105,16 @@ namespace QuantLib {
             Real xMin = trinomial->underlying(i, 0);
             Real dx = trinomial->dx(i);
             Helper finder(i, xMin, dx, discountBond, numericTree);
-            Brent s1d;
+            // the bond price is monotonic in theta and its derivative
+            // is available, so that Newton steps can be taken
+            NewtonSafe s1d;
             s1d.setMaxEvaluations(1000);
             value = s1d.solve(finder, 1e-7, value, vMin, vMax);
             impl->set(grid[i], value);
             // vMin = value - 10.0;
             // vMax = value + 10.0;
         }
+        cacheTree(grid, numericTree);
         return numericTree;
     }
 
@@ -69,20 +69,7 @@ Real Gaussian1dModel::swapRate(const Date &fixing, const Period &tenor,
         swapIdx->discountingTermStructure(); // either might be empty, then
                                              // use model curve
 
-    Schedule sched, floatSched;
-
-    boost::shared_ptr<VanillaSwap> underlying =
-        underlyingSwap(swapIdx, fixing, tenor);
-
-    sched = underlying->fixedSchedule();
-
-    boost::shared_ptr<OvernightIndexedSwapIndex> oisIdx =
-        boost::dynamic_pointer_cast<OvernightIndexedSwapIndex>(swapIdx);
-    if (oisIdx != NULL) {
-        floatSched = sched;
-    } else {
-        floatSched = underlying->floatingSchedule();
-    }
+    const CachedSwap &underlying = cachedSwap(swapIdx, fixing, tenor);
 
     Real annuity = swapAnnuity(fixing, tenor, referenceDate, y,
                                swapIdx);  // should be fine for
@@ -91,20 +78,17 @@ Real Gaussian1dModel::swapRate(const Date &fixing, const Period &tenor,
     Rate floatleg = 0.0;
     if (ytsf.empty() && ytsd.empty()) { // simple 100-formula can be used
                                         // only in one curve setup
-        floatleg =
-            (zerobond(sched.dates().front(), referenceDate, y) -
-             zerobond(sched.calendar().adjust(sched.dates().back(),
-                                              underlying->paymentConvention()),
-                      referenceDate, y));
+        floatleg = (zerobond(underlying.startDate, referenceDate, y) -
+                    zerobond(underlying.endDate, referenceDate, y));
     } else {
-        for (Size i = 1; i < floatSched.size(); i++) {
+        const std::vector<Date> &floatDates = underlying.floatDates;
+        for (Size i = 1; i < floatDates.size(); i++) {
             floatleg +=
-                (zerobond(floatSched[i - 1], referenceDate, y, ytsf) /
-                     zerobond(floatSched[i], referenceDate, y, ytsf) -
+                (zerobond(floatDates[i - 1], referenceDate, y, ytsf) /
+                     zerobond(floatDates[i], referenceDate, y, ytsf) -
                  1.0) *
-                zerobond(floatSched.calendar().adjust(
-                             floatSched[i], underlying->paymentConvention()),
-                         referenceDate, y, ytsd);
+                zerobond(underlying.floatPaymentDates[i - 1], referenceDate,
+                         y, ytsd);
         }
     }
     return floatleg / annuity;
@@ -122,22 +106,184 @@ Real Gaussian1dModel::swapAnnuity(const Date &fixing, const Period &tenor,
         swapIdx->discountingTermStructure(); // might be empty, then use
                                              // model curve
 
-    boost::shared_ptr<VanillaSwap> underlying =
-        underlyingSwap(swapIdx, fixing, tenor);
-
-    Schedule sched = underlying->fixedSchedule();
+    const CachedSwap &underlying = cachedSwap(swapIdx, fixing, tenor);
 
     Real annuity = 0.0;
-    for (unsigned int j = 1; j < sched.size(); j++) {
-        annuity += zerobond(sched.calendar().adjust(
-                                sched.date(j), underlying->paymentConvention()),
-                            referenceDate, y, ytsd) *
-                   swapIdx->dayCounter().yearFraction(sched.date(j - 1),
-                                                      sched.date(j));
+    for (Size j = 0; j < underlying.fixedPaymentDates.size(); j++) {
+        annuity += zerobond(underlying.fixedPaymentDates[j], referenceDate, y,
+                            ytsd) *
+                   underlying.fixedAccruals[j];
     }
     return annuity;
 }
 
+namespace {
+
+    std::vector<Time>
+    timesFromReference(const Handle<YieldTermStructure> &ts,
+                       const std::vector<Date> &dates) {
+        std::vector<Time> times(dates.size());
+        for (Size i = 0; i < dates.size(); i++)
+            times[i] = ts->timeFromReference(dates[i]);
+        return times;
+    }
+
+}
+
+const Disposable<Array>
+Gaussian1dModel::forwardRate(const Date &fixing, const Date &referenceDate,
+                             const Array &y,
+                             boost::shared_ptr<IborIndex> iborIdx) const {
+
+    QL_REQUIRE(iborIdx != NULL, "no ibor index given");
+
+    calculate();
+
+    if (fixing <=
+        (evaluationDate_ + (enforcesTodaysHistoricFixings_ ? 0 : -1))) {
+        Array result(y.size(), iborIdx->fixing(fixing));
+        return result;
+    }
+
+    Handle<YieldTermStructure> yts =
+        iborIdx->forwardingTermStructure(); // might be empty, then use
+                                            // model curve
+
+    Date valueDate = iborIdx->valueDate(fixing);
+    Date endDate = iborIdx->fixingCalendar().advance(
+        valueDate, iborIdx->tenor(), iborIdx->businessDayConvention(),
+        iborIdx->endOfMonth());
+    Real dcf = iborIdx->dayCounter().yearFraction(valueDate, endDate);
+    Time t = referenceDate != Null<Date>()
+                 ? termStructure()->timeFromReference(referenceDate)
+                 : 0.0;
+
+    std::vector<Time> T(2);
+    T[0] = termStructure()->timeFromReference(valueDate);
+    T[1] = termStructure()->timeFromReference(endDate);
+    Matrix p = zerobond(T, t, y, yts);
+    Array result(y.size());
+    for (Size k = 0; k < y.size(); k++)
+        result[k] = (p[0][k] - p[1][k]) / (dcf * p[1][k]);
+    return result;
+}
+
+const Disposable<Array>
+Gaussian1dModel::swapRate(const Date &fixing, const Period &tenor,
+                          const Date &referenceDate, const Array &y,
+                          boost::shared_ptr<SwapIndex> swapIdx) const {
+
+    QL_REQUIRE(swapIdx != NULL, "no swap index given");
+
+    calculate();
+
+    if (fixing <=
+        (evaluationDate_ + (enforcesTodaysHistoricFixings_ ? 0 : -1))) {
+        Array result(y.size(), swapIdx->fixing(fixing));
+        return result;
+    }
+
+    Handle<YieldTermStructure> ytsf =
+        swapIdx->iborIndex()->forwardingTermStructure();
+    Handle<YieldTermStructure> ytsd =
+        swapIdx->discountingTermStructure(); // either might be empty, then
+                                             // use model curve
+
+    const CachedSwap &underlying = cachedSwap(swapIdx, fixing, tenor);
+    Time t = referenceDate != Null<Date>()
+                 ? termStructure()->timeFromReference(referenceDate)
+                 : 0.0;
+
+    Array result = swapAnnuity(fixing, tenor, referenceDate, y, swapIdx);
+    if (ytsf.empty() && ytsd.empty()) { // simple 100-formula can be used
+                                        // only in one curve setup
+        std::vector<Time> T(2);
+        T[0] = termStructure()->timeFromReference(underlying.startDate);
+        T[1] = termStructure()->timeFromReference(underlying.endDate);
+        Matrix p = zerobond(T, t, y);
+        for (Size k = 0; k < y.size(); k++)
+            result[k] = (p[0][k] - p[1][k]) / result[k];
+    } else {
+        Matrix pf = zerobond(
+            timesFromReference(termStructure(), underlying.floatDates), t,
+            y, ytsf);
+        Matrix pd = zerobond(timesFromReference(termStructure(),
+                                                underlying.floatPaymentDates),
+                             t, y, ytsd);
+        for (Size k = 0; k < y.size(); k++) {
+            Real floatleg = 0.0;
+            for (Size i = 1; i < pf.rows(); i++)
+                floatleg += (pf[i - 1][k] / pf[i][k] - 1.0) * pd[i - 1][k];
+            result[k] = floatleg / result[k];
+        }
+    }
+    return result;
+}
+
+const Disposable<Array>
+Gaussian1dModel::swapAnnuity(const Date &fixing, const Period &tenor,
+                             const Date &referenceDate, const Array &y,
+                             boost::shared_ptr<SwapIndex> swapIdx) const {
+
+    QL_REQUIRE(swapIdx != NULL, "no swap index given");
+
+    calculate();
+
+    Handle<YieldTermStructure> ytsd =
+        swapIdx->discountingTermStructure(); // might be empty, then use
+                                             // model curve
+
+    const CachedSwap &underlying = cachedSwap(swapIdx, fixing, tenor);
+    Time t = referenceDate != Null<Date>()
+                 ? termStructure()->timeFromReference(referenceDate)
+                 : 0.0;
+
+    Matrix p = zerobond(
+        timesFromReference(termStructure(), underlying.fixedPaymentDates), t,
+        y, ytsd);
+    Array result(y.size(), 0.0);
+    for (Size j = 0; j < p.rows(); j++)
+        for (Size k = 0; k < y.size(); k++)
+            result[k] += p[j][k] * underlying.fixedAccruals[j];
+    return result;
+}
+
+const Gaussian1dModel::CachedSwap &
+Gaussian1dModel::cachedSwap(const boost::shared_ptr<SwapIndex> &index,
+                            const Date &expiry, const Period &tenor) const {
+
+    CachedSwapKey k = {index, expiry, tenor};
+    CacheType::iterator i = swapCache_.find(k);
+    if (i != swapCache_.end())
+        return i->second;
+
+    CachedSwap c;
+    c.swap = index->clone(tenor)->underlyingSwap(expiry);
+
+    const Schedule &sched = c.swap->fixedSchedule();
+    BusinessDayConvention paymentConvention = c.swap->paymentConvention();
+    for (Size j = 1; j < sched.size(); j++) {
+        c.fixedPaymentDates.push_back(
+            sched.calendar().adjust(sched.date(j), paymentConvention));
+        c.fixedAccruals.push_back(index->dayCounter().yearFraction(
+            sched.date(j - 1), sched.date(j)));
+    }
+    c.startDate = sched.dates().front();
+    c.endDate = sched.calendar().adjust(sched.dates().back(),
+                                        paymentConvention);
+
+    boost::shared_ptr<OvernightIndexedSwapIndex> oisIdx =
+        boost::dynamic_pointer_cast<OvernightIndexedSwapIndex>(index);
+    const Schedule &floatSched =
+        oisIdx != NULL ? sched : c.swap->floatingSchedule();
+    c.floatDates = floatSched.dates();
+    for (Size j = 1; j < floatSched.size(); j++)
+        c.floatPaymentDates.push_back(floatSched.calendar().adjust(
+            floatSched[j], paymentConvention));
+
+    return swapCache_.insert(std::make_pair(k, c)).first->second;
+}
+
 Real Gaussian1dModel::zerobondOption(
     const Option::Type &type, const Date &expiry, const Date &valueDate,
     const Date &maturity, const Rate strike, const Date &referenceDate,
@@ -244,6 +390,22 @@ Real Gaussian1dModel::gaussianShiftedPolynomialIntegral(
         a * h * h * h * h - b * h * h * h + c * h * h - d * h + e, x0, x1);
 }
 
+void Gaussian1dModel::numerairesImpl(const Time t, const Array &y,
+                                     const Handle<YieldTermStructure> &yts,
+                                     Array &result) const {
+    for (Size j = 0; j < y.size(); j++)
+        result[j] = numeraireImpl(t, y[j], yts);
+}
+
+void Gaussian1dModel::zerobondsImpl(const std::vector<Time> &T, const Time t,
+                                    const Array &y,
+                                    const Handle<YieldTermStructure> &yts,
+                                    Matrix &result) const {
+    for (Size i = 0; i < T.size(); i++)
+        for (Size j = 0; j < y.size(); j++)
+            result[i][j] = zerobondImpl(T[i], t, y[j], yts);
+}
+
 const Disposable<Array> Gaussian1dModel::yGrid(const Real stdDevs,
                                                const int gridPoints,
                                                const Real T, const Real t,
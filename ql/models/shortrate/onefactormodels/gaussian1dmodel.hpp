@@ -29,6 +29,7 @@
 
 #include <ql/models/model.hpp>
 #include <ql/models/parameter.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/indexes/swapindex.hpp>
 #include <ql/instruments/vanillaswap.hpp>
@@ -94,6 +95,21 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
         const Real y = 0.0,
         const Handle<YieldTermStructure> &yts = Handle<YieldTermStructure>()) const;
 
+    /*! Returns the numeraire at time t for each of the given
+        states. */
+    const Disposable<Array>
+    numeraire(const Time t, const Array &y,
+              const Handle<YieldTermStructure> &yts =
+                  Handle<YieldTermStructure>()) const;
+
+    /*! Returns the zero bonds for the given maturities conditional
+        on each of the given states at time t; maturities are on
+        the rows of the result and states on its columns. */
+    const Disposable<Matrix>
+    zerobond(const std::vector<Time> &T, const Time t, const Array &y,
+             const Handle<YieldTermStructure> &yts =
+                 Handle<YieldTermStructure>()) const;
+
     Real zerobondOption(
         const Option::Type &type, const Date &expiry, const Date &valueDate,
         const Date &maturity, const Rate strike,
@@ -118,6 +134,25 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
         const Date &referenceDate = Null<Date>(), const Real y = 0.0,
         boost::shared_ptr<SwapIndex> swapIdx = boost::shared_ptr<SwapIndex>()) const;
 
+    /*! Returns the forward rate for each of the given states. */
+    const Disposable<Array>
+    forwardRate(const Date &fixing, const Date &referenceDate,
+                const Array &y,
+                boost::shared_ptr<IborIndex> iborIdx) const;
+
+    /*! Returns the swap rate for each of the given states; the
+        zero bonds of all the payment dates are retrieved at once. */
+    const Disposable<Array>
+    swapRate(const Date &fixing, const Period &tenor,
+             const Date &referenceDate, const Array &y,
+             boost::shared_ptr<SwapIndex> swapIdx) const;
+
+    /*! Returns the swap annuity for each of the given states. */
+    const Disposable<Array>
+    swapAnnuity(const Date &fixing, const Period &tenor,
+                const Date &referenceDate, const Array &y,
+                boost::shared_ptr<SwapIndex> swapIdx) const;
+
     /*! Computes the integral
     \f[ {2\pi}^{-0.5} \int_{a}^{b} p(x) \exp{-0.5*x*x} \mathrm{d}x \f]
     with
@@ -176,11 +211,30 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
         }
     };
 
-    typedef boost::unordered_map<CachedSwapKey, boost::shared_ptr<VanillaSwap>,
+    // Together with the swap, we store the dates and accruals needed
+    // to price it on the model states, so that its schedules are only
+    // walked once.
+
+    struct CachedSwap {
+        boost::shared_ptr<VanillaSwap> swap;
+        std::vector<Date> fixedPaymentDates;
+        std::vector<Real> fixedAccruals;
+        // start and adjusted end of the fixed schedule, used in the
+        // single curve setup
+        Date startDate, endDate;
+        // floating schedule and adjusted payment dates, used otherwise
+        std::vector<Date> floatDates, floatPaymentDates;
+    };
+
+    typedef boost::unordered_map<CachedSwapKey, CachedSwap,
                                  CachedSwapKeyHasher> CacheType;
 
     mutable CacheType swapCache_;
 
+    const CachedSwap &cachedSwap(const boost::shared_ptr<SwapIndex> &index,
+                                 const Date &expiry,
+                                 const Period &tenor) const;
+
   protected:
     // we let derived classes register with the termstructure
     Gaussian1dModel(const Handle<YieldTermStructure> &yieldTermStructure)
@@ -197,6 +251,20 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
     virtual Real zerobondImpl(const Time T, const Time t, const Real y,
                               const Handle<YieldTermStructure> &yts) const = 0;
 
+    /*! The default implementations of the array versions call the
+        scalar ones in a loop; models should override them when the
+        work depending only on the times can be shared among
+        states. */
+    virtual void
+    numerairesImpl(const Time t, const Array &y,
+                   const Handle<YieldTermStructure> &yts,
+                   Array &result) const;
+
+    virtual void
+    zerobondsImpl(const std::vector<Time> &T, const Time t, const Array &y,
+                  const Handle<YieldTermStructure> &yts,
+                  Matrix &result) const;
+
     void performCalculations() const {
         evaluationDate_ = Settings::instance().evaluationDate();
         enforcesTodaysHistoricFixings_ =
@@ -213,16 +281,7 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
     boost::shared_ptr<VanillaSwap>
     underlyingSwap(const boost::shared_ptr<SwapIndex> &index,
                    const Date &expiry, const Period &tenor) const {
-
-        CachedSwapKey k = {index, expiry, tenor};
-        CacheType::iterator i = swapCache_.find(k);
-        if (i == swapCache_.end()) {
-            boost::shared_ptr<VanillaSwap> underlying =
-                index->clone(tenor)->underlyingSwap(expiry);
-            swapCache_.insert(std::make_pair(k, underlying));
-            return underlying;
-        }
-        return i->second;
+        return cachedSwap(index, expiry, tenor).swap;
     }
 
     boost::shared_ptr<StochasticProcess1D> stateProcess_;
@@ -250,6 +309,23 @@ Gaussian1dModel::zerobond(const Time T, const Time t, const Real y,
     return zerobondImpl(T, t, y, yts);
 }
 
+inline const Disposable<Array>
+Gaussian1dModel::numeraire(const Time t, const Array &y,
+                           const Handle<YieldTermStructure> &yts) const {
+    Array result(y.size());
+    numerairesImpl(t, y, yts, result);
+    return result;
+}
+
+inline const Disposable<Matrix>
+Gaussian1dModel::zerobond(const std::vector<Time> &T, const Time t,
+                          const Array &y,
+                          const Handle<YieldTermStructure> &yts) const {
+    Matrix result(T.size(), y.size());
+    zerobondsImpl(T, t, y, yts, result);
+    return result;
+}
+
 inline Real
 Gaussian1dModel::numeraire(const Date &referenceDate, const Real y,
                            const Handle<YieldTermStructure> &yts) const {
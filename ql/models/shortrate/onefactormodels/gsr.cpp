@@ -205,6 +205,70 @@ Real Gsr::zerobondImpl(const Time T, const Time t, const Real y,
     return d * exp(-x * gtT - 0.5 * p->y(t) * gtT * gtT);
 }
 
+void Gsr::zerobondsImpl(const std::vector<Time> &T, const Time t,
+                        const Array &y, const Handle<YieldTermStructure> &yts,
+                        Matrix &result) const {
+
+    calculate();
+
+    if (t == 0.0) {
+        for (Size i = 0; i < T.size(); i++)
+            std::fill(result.row_begin(i), result.row_end(i),
+                      yts.empty() ? this->termStructure()->discount(T[i], true)
+                                  : yts->discount(T[i], true));
+        return;
+    }
+
+    boost::shared_ptr<GsrProcess> p =
+        boost::dynamic_pointer_cast<GsrProcess>(stateProcess_);
+
+    // the state standardization and G(t,T) don't depend on the
+    // state, so that the inner loop only exponentiates
+    const Real stdDev = stateProcess_->stdDeviation(0.0, 0.0, t);
+    const Real mean = stateProcess_->expectation(0.0, 0.0, t);
+    const Real yt = p->y(t);
+    const Real dt = yts.empty() ? termStructure()->discount(t, true)
+                                : yts->discount(t, true);
+    const Size n = y.size();
+
+    Array x(n);
+    for (Size j = 0; j < n; j++)
+        x[j] = y[j] * stdDev + mean;
+
+    for (Size i = 0; i < T.size(); i++) {
+        const Real gtT = p->G(t, T[i], 0.0);
+        const Real d = (yts.empty() ? termStructure()->discount(T[i], true)
+                                    : yts->discount(T[i], true)) / dt;
+        const Real c = 0.5 * yt * gtT * gtT;
+        Real *r = result.row_begin(i);
+        for (Size j = 0; j < n; j++)
+            r[j] = d * exp(-x[j] * gtT - c);
+    }
+}
+
+void Gsr::numerairesImpl(const Time t, const Array &y,
+                         const Handle<YieldTermStructure> &yts,
+                         Array &result) const {
+
+    calculate();
+
+    boost::shared_ptr<GsrProcess> p =
+        boost::dynamic_pointer_cast<GsrProcess>(stateProcess_);
+
+    if (t == 0) {
+        std::fill(result.begin(), result.end(),
+                  yts.empty() ? this->termStructure()->discount(
+                                    p->getForwardMeasureTime(), true)
+                              : yts->discount(p->getForwardMeasureTime()));
+        return;
+    }
+
+    std::vector<Time> T(1, p->getForwardMeasureTime());
+    Matrix zerobonds(1, y.size());
+    zerobondsImpl(T, t, y, yts, zerobonds);
+    std::copy(zerobonds.row_begin(0), zerobonds.row_end(0), result.begin());
+}
+
 Real Gsr::numeraireImpl(const Time t, const Real y,
                         const Handle<YieldTermStructure> &yts) const {
 
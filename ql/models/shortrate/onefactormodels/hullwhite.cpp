@@ -42,6 +42,10 @@ namespace QuantLib {
 
     boost::shared_ptr<Lattice> HullWhite::tree(const TimeGrid& grid) const {
 
+        boost::shared_ptr<Lattice> cached = cachedTree(grid);
+        if (cached)
+            return cached;
+
         TermStructureFittingParameter phi(termStructure());
         boost::shared_ptr<ShortRateDynamics> numericDynamics(
                                              new Dynamics(phi, a(), sigma()));
@@ -69,6 +73,7 @@ namespace QuantLib {
             value = std::log(value/discountBond)/dt;
             impl->set(grid[i], value);
         }
+        cacheTree(grid, numericTree);
         return numericTree;
     }
 
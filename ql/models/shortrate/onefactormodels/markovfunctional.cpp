@@ -454,6 +454,20 @@ namespace QuantLib {
         modelOutputs_.digitalsAdjustmentFactors_.clear();
 
         int idx = times_.size() - 2;
+        int n = y_.size();
+
+        // the swap rates of the previous tabulation are kept as initial
+        // guesses for the next one, e.g., during the calibration of the
+        // volatilities or after a change of the yield term structure
+        bool warmStartAll = swapRateGuesses_.rows() == times_.size() - 1 &&
+                            swapRateGuesses_.columns() == y_.size();
+        if (!warmStartAll)
+            swapRateGuesses_ = Matrix(times_.size() - 1, y_.size());
+
+        std::vector<Real> digitals(n), swapRates(n);
+        std::vector<std::string> errors(n);
+        // not vector<bool>, whose elements can't be written concurrently
+        std::vector<int> solved(n), failed(n, 0);
 
         for (std::map<Date, CalibrationPoint>::reverse_iterator
                  i = calibrationPoints_.rbegin();
@@ -488,6 +502,11 @@ namespace QuantLib {
 
             Real digital = 0.0, swapRate, swapRate0;
 
+            const Date &expiry = i->first;
+            const CalibrationPoint &p = i->second;
+            Real shift = p.rawSmileSection_->shift();
+            bool warmStart = warmStartAll;
+
             for (int c = 0;
                  c == 0 || (c == 1 && (modelSettings_.adjustments_ &
                                        ModelSettings::AdjustDigitals));
@@ -499,10 +518,9 @@ namespace QuantLib {
                         digitalsCorrectionFactor;
                 }
 
+                // digital prices on the grid, accumulated from the right
                 digital = 0.0;
-                swapRate0 =
-                    modelSettings_.upperRateBound_ / 2.0; // initial guess
-                for (int j = y_.size() - 1; j >= 0; j--) {
+                for (int j = n - 1; j >= 0; j--) {
 
                     Real integral = 0.0;
 
@@ -547,40 +565,66 @@ namespace QuantLib {
                     }
 
                     digital += integral * numeraire0 * digitalsCorrectionFactor;
+                    digitals[j] = digital;
+                }
 
-                    if (digital >= i->second.minRateDigital_)
-                        swapRate = modelSettings_.lowerRateBound_ -
-                                   i->second.rawSmileSection_->shift();
-                    else {
-                        if (digital <= i->second.maxRateDigital_)
-                            swapRate = modelSettings_.upperRateBound_;
-                        else {
-                            swapRate = marketSwapRate(
-                                i->first, i->second, digital, swapRate0,
-                                i->second.rawSmileSection_->shift());
-                            if (j < (int)y_.size() - 1 &&
-                                swapRate > swapRate0) {
-                                QL_MFMESSAGE(
-                                    modelOutputs_,
-                                    "WARNING: swap rate is decreasing in y for "
-                                    "t="
-                                        << times_[idx] << ", j=" << j
-                                        << " (y, swap rate) is (" << y_[j]
-                                        << "," << swapRate
-                                        << ") but for j=" << j + 1 << " it is ("
-                                        << y_[j + 1] << "," << swapRate0
-                                        << ") --- reset rate to " << swapRate0
-                                        << " in node j=" << j);
-                                swapRate = swapRate0;
-                            }
+                // the swap rates implied by the digitals are independent
+                // of each other; the previous tabulation, if any,
+                // provides the initial guesses
+                #pragma omp parallel for schedule(dynamic)
+                for (int j = 0; j < n; j++) {
+                    solved[j] = 0;
+                    if (digitals[j] >= p.minRateDigital_) {
+                        swapRates[j] = modelSettings_.lowerRateBound_ - shift;
+                    } else if (digitals[j] <= p.maxRateDigital_) {
+                        swapRates[j] = modelSettings_.upperRateBound_;
+                    } else {
+                        Real guess =
+                            warmStart ? swapRateGuesses_[idx][j] : p.atm_;
+                        try {
+                            swapRates[j] = marketSwapRate(expiry, p,
+                                                          digitals[j], guess,
+                                                          shift);
+                            solved[j] = 1;
+                        } catch (std::exception &e) {
+                            errors[j] = e.what();
+                            failed[j] = 1;
+                        } catch (...) {
+                            errors[j] = "unknown error";
+                            failed[j] = 1;
                         }
                     }
+                }
+
+                for (int j = 0; j < n; j++)
+                    QL_REQUIRE(!failed[j], "could not imply swap rate for t="
+                                               << times_[idx] << ", j=" << j
+                                               << ": " << errors[j]);
+
+                swapRate0 = modelSettings_.upperRateBound_ / 2.0;
+                for (int j = n - 1; j >= 0; j--) {
+                    swapRate = swapRates[j];
+                    if (solved[j] && j < n - 1 && swapRate > swapRate0) {
+                        QL_MFMESSAGE(modelOutputs_,
+                                     "WARNING: swap rate is decreasing in y for "
+                                     "t="
+                                         << times_[idx] << ", j=" << j
+                                         << " (y, swap rate) is (" << y_[j]
+                                         << "," << swapRate
+                                         << ") but for j=" << j + 1 << " it is ("
+                                         << y_[j + 1] << "," << swapRate0
+                                         << ") --- reset rate to " << swapRate0
+                                         << " in node j=" << j);
+                        swapRate = swapRate0;
+                    }
                     swapRate0 = swapRate;
+                    swapRateGuesses_[idx][j] = swapRate;
                     Real numeraire =
                         1.0 / (swapRate * discreteDeflatedAnnuities[j] +
                                deflatedFinalPayments[j]);
                     (*discreteNumeraire_)[idx][j] = numeraire * normalization;
                 }
+                warmStart = true;
             }
 
             if (modelSettings_.adjustments_ & ModelSettings::AdjustYts) {
@@ -811,6 +855,56 @@ namespace QuantLib {
                                      termStructure()->discount(T)));
     }
 
+    void MarkovFunctional::numerairesImpl(
+        const Time t, const Array &y, const Handle<YieldTermStructure> &yts,
+        Array &result) const {
+
+        if (t == 0) {
+            std::fill(result.begin(), result.end(),
+                      yts.empty()
+                          ? this->termStructure()->discount(numeraireTime(),
+                                                            true)
+                          : yts->discount(numeraireTime()));
+            return;
+        }
+
+        Array numeraires = numeraireArray(t, y);
+        Real adjustment =
+            yts.empty() ? 1.0
+                        : (yts->discount(numeraireTime()) / yts->discount(t) *
+                           termStructure()->discount(t) /
+                           termStructure()->discount(numeraireTime()));
+        for (Size j = 0; j < y.size(); j++)
+            result[j] = numeraires[j] * adjustment;
+    }
+
+    void MarkovFunctional::zerobondsImpl(
+        const std::vector<Time> &T, const Time t, const Array &y,
+        const Handle<YieldTermStructure> &yts, Matrix &result) const {
+
+        if (t == 0.0) {
+            for (Size i = 0; i < T.size(); i++)
+                std::fill(result.row_begin(i), result.row_end(i),
+                          yts.empty()
+                              ? this->termStructure()->discount(T[i], true)
+                              : yts->discount(T[i], true));
+            return;
+        }
+
+        // the numeraire at t is interpolated once for all maturities
+        Array numeraires = numeraireArray(t, y);
+        for (Size i = 0; i < T.size(); i++) {
+            Array deflated = deflatedZerobondArray(T[i], t, y);
+            Real adjustment =
+                yts.empty() ? 1.0 : (yts->discount(T[i]) / yts->discount(t) *
+                                     termStructure()->discount(t) /
+                                     termStructure()->discount(T[i]));
+            Real *r = result.row_begin(i);
+            for (Size j = 0; j < y.size(); j++)
+                r[j] = deflated[j] * numeraires[j] * adjustment;
+        }
+    }
+
     Real MarkovFunctional::deflatedZerobond(Time T, Time t,
                                             Real y) const {
 
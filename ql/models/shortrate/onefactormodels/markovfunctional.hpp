@@ -92,6 +92,13 @@ namespace QuantLib {
       When using a shifted lognormal smile input the lower rate bound is adjusted
       by the shift so that a lower bound of 0.0 always corresponds to the lower
       bound of the shifted distribution.
+
+      The swap rates on the grid of each expiry are implied in parallel when
+      OpenMP is enabled, so the smile sections must support concurrent
+      digital price calculations once they are updated. The rates of the last
+      tabulation are used as initial guesses for the next one, which speeds up
+      the volatility calibration and the recalculation after a change of the
+      yield term structure.
 */
 
     class MarkovFunctional : public Gaussian1dModel, public CalibratedModel {
@@ -342,6 +349,15 @@ namespace QuantLib {
         Real zerobondImpl(const Time T, const Time t, const Real y,
                           const Handle<YieldTermStructure> &yts) const;
 
+        void numerairesImpl(const Time t, const Array &y,
+                            const Handle<YieldTermStructure> &yts,
+                            Array &result) const;
+
+        void zerobondsImpl(const std::vector<Time> &T, const Time t,
+                           const Array &y,
+                           const Handle<YieldTermStructure> &yts,
+                           Matrix &result) const;
+
         void generateArguments() {
             // if calculate triggers performCalculations, updateNumeraireTabulations
             // is called twice. If we can not check the lazy object status this seem
@@ -488,6 +504,8 @@ namespace QuantLib {
         boost::shared_ptr<IborIndex> iborIndex_;
 
         mutable std::map<Date, CalibrationPoint> calibrationPoints_;
+        // swap rates of the last numeraire tabulation
+        mutable Matrix swapRateGuesses_;
         mutable std::vector<Real> times_;
         Array y_;
 
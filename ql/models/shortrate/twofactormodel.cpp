@@ -28,6 +28,10 @@ namespace QuantLib {
 
     boost::shared_ptr<Lattice>
     TwoFactorModel::tree(const TimeGrid& grid) const {
+        boost::shared_ptr<Lattice> cached = cachedTree(grid);
+        if (cached)
+            return cached;
+
         boost::shared_ptr<ShortRateDynamics> dyn = dynamics();
 
         boost::shared_ptr<TrinomialTree> tree1(
@@ -35,8 +39,10 @@ namespace QuantLib {
         boost::shared_ptr<TrinomialTree> tree2(
                                     new TrinomialTree(dyn->yProcess(), grid));
 
-        return boost::shared_ptr<Lattice>(
+        boost::shared_ptr<Lattice> lattice(
                         new TwoFactorModel::ShortRateTree(tree1, tree2, dyn));
+        cacheTree(grid, lattice);
+        return lattice;
     }
 
     TwoFactorModel::ShortRateTree::ShortRateTree(
@@ -20,9 +20,9 @@
 
 #include <ql/models/shortrate/twofactormodels/g2.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
-#include <ql/math/integrals/segmentintegral.hpp>
 #include <ql/pricingengines/blackformula.hpp>
-#include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/solvers1d/newtonsafe.hpp>
+#include <ql/math/comparison.hpp>
 
 namespace QuantLib {
 
@@ -144,57 +144,105 @@ namespace QuantLib {
 
         Real mux() const { return mux_; }
         Real sigmax() const { return sigmax_; }
-        Real operator()(Real x) const {
-            CumulativeNormalDistribution phi;
-            Real temp = (x - mux_)/sigmax_;
-            Real txy = std::sqrt(1.0 - rhoxy_*rhoxy_);
-
-            Array lambda(size_);
-            Size i;
-            for (i=0; i<size_; i++) {
+        /* Trapezoidal integral of the pricing function over
+           [lower, upper].  The terms depending on the coupons are
+           computed for all nodes at once, cashflow by cashflow, so
+           that the inner loops run over contiguous arrays; the root
+           in y at each node is used as the initial guess for the
+           next one, since it moves little between nodes. */
+        Real integral(Real lower, Real upper, Size intervals) const {
+            if (close_enough(lower, upper))
+                return 0.0;
+
+            const Size nodes = intervals+1;
+            const Real dx = (upper-lower)/intervals;
+            const Real txy = std::sqrt(1.0 - rhoxy_*rhoxy_);
+
+            std::vector<Real> x(nodes);
+            for (Size k=0; k<nodes; k++)
+                x[k] = lower + k*dx;
+
+            // coupon factors and terms of the exponents not
+            // depending on x
+            Array c(size_), k0(size_), k1(size_), shift(size_);
+            for (Size i=0; i<size_; i++) {
                 Real tau = (i==0 ? t_[0] - T_ : t_[i] - t_[i-1]);
-                Real c = (i==size_-1 ? (1.0+rate_*tau) : rate_*tau);
-                lambda[i] = c*A_[i]*std::exp(-Ba_[i]*x);
+                c[i] = (i==size_-1 ? (1.0+rate_*tau) : rate_*tau)*A_[i];
+                k0[i] = -Bb_[i]*(muy_ - 0.5*txy*txy*sigmay_*sigmay_*Bb_[i]
+                                 - rhoxy_*sigmay_*mux_/sigmax_);
+                k1[i] = -Bb_[i]*rhoxy_*sigmay_/sigmax_;
+                shift[i] = Bb_[i]*sigmay_*txy;
             }
 
-            SolvingFunction function(lambda, Bb_) ;
-            Brent s1d;
-            s1d.setMaxEvaluations(1000);
-            Real yb = s1d.solve(function, 1e-6, 0.00, -100.0, 100.0);
-
-            Real h1 = (yb - muy_)/(sigmay_*txy) -
-                rhoxy_*(x  - mux_)/(sigmax_*txy);
-            Real value = phi(-w_*h1);
+            // lambda[i*nodes+k] for the i-th cashflow at the k-th node
+            std::vector<Real> lambda(size_*nodes), kappa(size_*nodes);
+            for (Size i=0; i<size_; i++) {
+                Real* l = &lambda[i*nodes];
+                Real* e = &kappa[i*nodes];
+                for (Size k=0; k<nodes; k++) {
+                    l[k] = c[i]*std::exp(-Ba_[i]*x[k]);
+                    e[k] = std::exp(k0[i] + k1[i]*x[k]);
+                }
+            }
 
+            std::vector<Real> h1(nodes);
+            NewtonSafe s1d;
+            s1d.setMaxEvaluations(1000);
+            s1d.setLowerBound(-100.0);
+            s1d.setUpperBound(100.0);
+            Real yb = 0.0;
+            for (Size k=0; k<nodes; k++) {
+                SolvingFunction function(&lambda[k], nodes, Bb_);
+                yb = s1d.solve(function, 1e-6, yb, 0.01);
+                h1[k] = (yb - muy_)/(sigmay_*txy) -
+                    rhoxy_*(x[k] - mux_)/(sigmax_*txy);
+            }
 
-            for (i=0; i<size_; i++) {
-                Real h2 = h1 +
-                    Bb_[i]*sigmay_*std::sqrt(1.0-rhoxy_*rhoxy_);
-                Real kappa = - Bb_[i] *
-                    (muy_ - 0.5*txy*txy*sigmay_*sigmay_*Bb_[i] +
-                     rhoxy_*sigmay_*(x-mux_)/sigmax_);
-                value -= lambda[i] *std::exp(kappa)*phi(-w_*h2);
+            CumulativeNormalDistribution phi;
+            std::vector<Real> value(nodes);
+            for (Size k=0; k<nodes; k++)
+                value[k] = phi(-w_*h1[k]);
+            for (Size i=0; i<size_; i++) {
+                const Real* l = &lambda[i*nodes];
+                const Real* e = &kappa[i*nodes];
+                for (Size k=0; k<nodes; k++)
+                    value[k] -= l[k]*e[k]*phi(-w_*(h1[k]+shift[i]));
             }
 
-            return std::exp(-0.5*temp*temp)*value/
-                (sigmax_*std::sqrt(2.0*M_PI));
+            Real sum = 0.0;
+            for (Size k=0; k<nodes; k++) {
+                Real temp = (x[k] - mux_)/sigmax_;
+                Real weight = (k==0 || k==nodes-1 ? 0.5 : 1.0);
+                sum += weight*std::exp(-0.5*temp*temp)*value[k];
+            }
+            return sum*dx/(sigmax_*std::sqrt(2.0*M_PI));
         }
 
 
       private:
         class SolvingFunction {
           public:
-            SolvingFunction(const Array& lambda, const Array& Bb)
-            : lambda_(lambda), Bb_(Bb) {}
+            // lambda[i*stride] is the factor of the i-th cashflow
+            SolvingFunction(const Real* lambda, Size stride,
+                            const Array& Bb)
+            : lambda_(lambda), stride_(stride), Bb_(Bb) {}
             Real operator()(Real y) const {
                 Real value = 1.0;
-                for (Size i=0; i<lambda_.size(); i++) {
-                    value -= lambda_[i]*std::exp(-Bb_[i]*y);
+                for (Size i=0; i<Bb_.size(); i++) {
+                    value -= lambda_[i*stride_]*std::exp(-Bb_[i]*y);
+                }
+                return value;
+            }
+            Real derivative(Real y) const {
+                Real value = 0.0;
+                for (Size i=0; i<Bb_.size(); i++) {
+                    value += lambda_[i*stride_]*Bb_[i]*std::exp(-Bb_[i]*y);
                 }
                 return value;
             }
           private:
-            const Array& lambda_;
+            const Real* lambda_;
+            Size stride_;
             const Array& Bb_;
         };
 
@@ -229,9 +277,8 @@ namespace QuantLib {
 
         Real upper = function.mux() + range*function.sigmax();
         Real lower = function.mux() - range*function.sigmax();
-        SegmentIntegral integrator(intervals);
         return arguments.nominal*w*termStructure()->discount(start)*
-            integrator(function, lower, upper);
+            function.integral(lower, upper, intervals);
     }
 
 }
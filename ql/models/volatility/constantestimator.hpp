@@ -25,6 +25,8 @@
 #define quantlib_constant_estimator_hpp
 
 #include <ql/volatilitymodel.hpp>
+#include <cmath>
+#include <iterator>
 #include <vector>
 
 namespace QuantLib {
@@ -39,9 +41,56 @@ namespace QuantLib {
         ConstantEstimator(Size size)
         : size_(size) {}
         TimeSeries<Volatility> calculate(const TimeSeries<Volatility>&);
+        /*! same as above for series stored in other containers, such
+            as SortedDateMap; the values are read in place.
+        */
+        template <class C>
+        TimeSeries<Volatility> calculate(
+                                const TimeSeries<Volatility, C>& series) {
+            return estimate(series);
+        }
         void calibrate(const TimeSeries<Volatility>&) {}
+      private:
+        template <class C>
+        TimeSeries<Volatility> estimate(
+                                const TimeSeries<Volatility, C>&) const;
     };
 
+
+    // template definitions
+
+    template <class C>
+    TimeSeries<Volatility> ConstantEstimator::estimate(
+                    const TimeSeries<Volatility, C>& volatilitySeries) const {
+        typedef typename TimeSeries<Volatility, C>::const_iterator
+                                                            const_iterator;
+        typedef typename TimeSeries<Volatility, C>::const_value_iterator
+                                                      const_value_iterator;
+        TimeSeries<Volatility> retval;
+        if (volatilitySeries.size() <= size_)
+            return retval;
+        // the values in each window are read through the iterators
+        // of the series instead of being copied
+        const_value_iterator start = volatilitySeries.cbegin_values();
+        const_iterator cur = volatilitySeries.begin();
+        std::advance(cur, size_);
+        for (Size i=size_; i < volatilitySeries.size(); i++) {
+            Real sumu2=0.0, sumu=0.0;
+            const_value_iterator u = start;
+            for (Size j=0; j<size_; ++j, ++u) {
+                Volatility x = *u;
+                sumu += x;
+                sumu2 += x*x;
+            }
+            Real s = std::sqrt(sumu2/(Real)size_ - sumu*sumu / (Real) size_ /
+                               (Real) (size_+1));
+            retval[cur->first] = s;
+            ++cur;
+            ++start;
+        }
+        return retval;
+    }
+
 }
 
 
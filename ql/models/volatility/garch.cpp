@@ -51,6 +51,10 @@ namespace QuantLib {
         };
 
 
+        // The log-likelihood is evaluated in a single pass over the
+        // squared returns.  The gradient carries the derivatives of
+        // the variance with respect to the parameters through the
+        // recursion sigma2 = omega + alpha*u2 + beta*sigma2.
         class Garch11CostFunction : public CostFunction {
           public:
             explicit Garch11CostFunction (const std::vector<Volatility> &);
@@ -67,73 +71,66 @@ namespace QuantLib {
         : r2_(r2) {}
 
         Real Garch11CostFunction::value(const Array& x) const {
+            const Real omega = x[0], alpha = x[1], beta = x[2];
+            const Size n = r2_.size();
+            const Volatility* r2 = n > 0 ? &r2_[0] : 0;
             Real retval(0.0);
             Real sigma2 = 0;
             Real u2 = 0;
-            BOOST_FOREACH (Volatility r2, r2_) {
-                sigma2 = x[0] + x[1] * u2 + x[2] * sigma2;
-                u2 = r2;
+            for (Size i=0; i<n; ++i) {
+                sigma2 = omega + alpha * u2 + beta * sigma2;
+                u2 = r2[i];
                 retval += std::log(sigma2) + u2 / sigma2;
             }
-            return retval / (2.0*r2_.size());
+            return retval / (2.0*n);
         }
 
         Disposable<Array> Garch11CostFunction::values(const Array& x) const {
-            Array retval (r2_.size());
+            const Real omega = x[0], alpha = x[1], beta = x[2];
+            const Size n = r2_.size();
+            const Real norm = 2.0 * n;
+            Array retval (n);
             Real sigma2 = 0;
             Real u2 = 0;
-            Size i = 0;
-            BOOST_FOREACH (Volatility r2, r2_) {
-                sigma2 = x[0] + x[1] * u2 + x[2] * sigma2;
-                u2 = r2;
-                retval[i++] = (std::log(sigma2) + u2 / sigma2)/(2.0*r2_.size());
+            for (Size i=0; i<n; ++i) {
+                sigma2 = omega + alpha * u2 + beta * sigma2;
+                u2 = r2_[i];
+                retval[i] = (std::log(sigma2) + u2 / sigma2)/norm;
             }
             return retval;
         }
 
         void Garch11CostFunction::gradient(Array& grad, const Array& x) const {
-            std::fill (grad.begin(), grad.end(), 0.0);
-            Real sigma2 = 0;
-            Real u2 = 0;
-            Real sigma2prev = sigma2;
-            Real u2prev = u2;
-            Real norm = 2.0 * r2_.size();
-            BOOST_FOREACH (Volatility r2, r2_) {
-                sigma2 = x[0] + x[1] * u2 + x[2] * sigma2;
-                u2 = r2;
-                Real w = (sigma2 - u2) / (sigma2*sigma2);
-                grad[0] += w;
-                grad[1] += u2prev * w;
-                grad[2] += sigma2prev * w;
-                u2prev = u2;
-                sigma2prev = sigma2;
-            }
-            std::transform(grad.begin(), grad.end(), grad.begin(),
-                           std::bind2nd(std::divides<Real>(), norm));
+            valueAndGradient(grad, x);
         }
 
         Real Garch11CostFunction::valueAndGradient(Array& grad,
                                                    const Array& x) const {
-            std::fill (grad.begin(), grad.end(), 0.0);
+            const Real omega = x[0], alpha = x[1], beta = x[2];
+            const Size n = r2_.size();
+            const Volatility* r2 = n > 0 ? &r2_[0] : 0;
             Real retval(0.0);
             Real sigma2 = 0;
             Real u2 = 0;
-            Real sigma2prev = sigma2;
-            Real u2prev = u2;
-            Real norm = 2.0 * r2_.size();
-            BOOST_FOREACH (Volatility r2, r2_) {
-                sigma2 = x[0] + x[1] * u2 + x[2] * sigma2;
-                u2 = r2;
+            // derivatives of sigma2 with respect to omega, alpha, beta
+            Real dOmega = 0, dAlpha = 0, dBeta = 0;
+            Real gOmega = 0, gAlpha = 0, gBeta = 0;
+            for (Size i=0; i<n; ++i) {
+                dOmega = 1.0 + beta * dOmega;
+                dAlpha = u2 + beta * dAlpha;
+                dBeta = sigma2 + beta * dBeta;
+                sigma2 = omega + alpha * u2 + beta * sigma2;
+                u2 = r2[i];
                 retval += std::log(sigma2) + u2 / sigma2;
                 Real w = (sigma2 - u2) / (sigma2*sigma2);
-                grad[0] += w;
-                grad[1] += u2prev * w;
-                grad[2] += sigma2prev * w;
-                u2prev = u2;
-                sigma2prev = sigma2;
+                gOmega += w * dOmega;
+                gAlpha += w * dAlpha;
+                gBeta += w * dBeta;
             }
-            std::transform(grad.begin(), grad.end(), grad.begin(),
-                           std::bind2nd(std::divides<Real>(), norm));
+            const Real norm = 2.0 * n;
+            grad[0] = gOmega / norm;
+            grad[1] = gAlpha / norm;
+            grad[2] = gBeta / norm;
             return retval / norm;
         }
 
@@ -368,6 +365,134 @@ namespace QuantLib {
             return gammaLower;
         }
 
+        boost::shared_ptr<Problem> optimizeFromGuess(
+                                        const std::vector<Volatility> &r2,
+                                        OptimizationMethod &method,
+                                        Constraint &constraints,
+                                        const EndCriteria &endCriteria,
+                                        const Garch11CostFunction &cost,
+                                        Array &opt, Real &fCost) {
+            boost::shared_ptr<Problem> ret;
+            try {
+                Real alpha, beta, omega;
+                ret = Garch11::calibrate_r2(r2, method, constraints,
+                                            endCriteria, opt,
+                                            alpha, beta, omega);
+                opt[1] = alpha;
+                opt[2] = beta;
+                opt[0] = omega;
+                if (constraints.test(opt))
+                    fCost = std::min(fCost, cost.value(opt));
+            } catch (const std::exception &) {
+                fCost = QL_MAX_REAL;
+            }
+            return ret;
+        }
+
+        // Calibration from the two initial guesses based on fitting
+        // ACF.  The guesses are independent and are computed in
+        // parallel when OpenMP is enabled; so are the two
+        // optimizations in the DoubleOptimization mode, provided that
+        // each one is given its own optimization method.
+        boost::shared_ptr<Problem> calibrateFromGuesses(
+                                        Garch11::Mode mode,
+                                        const std::vector<Volatility> &r2,
+                                        Real mean_r2,
+                                        OptimizationMethod &method1,
+                                        OptimizationMethod &method2,
+                                        const EndCriteria &endCriteria,
+                                        Real &alpha, Real &beta,
+                                        Real &omega) {
+            Real dataSize = Real(r2.size());
+            alpha = 0.0;
+            beta = 0.0;
+            omega = 0.0;
+            QL_REQUIRE (dataSize >= 4,
+                        "Data series is too short to fit GARCH model");
+            QL_REQUIRE (mean_r2 > 0, "Data series is constant");
+            omega = mean_r2 * dataSize / (dataSize - 1);
+
+            // ACF
+            Size maxLag = (Size)std::sqrt(dataSize);
+            Array acf(maxLag+1);
+            std::vector<Volatility> tmp(r2.size());
+            std::transform (r2.begin(), r2.end(), tmp.begin(),
+                            std::bind2nd(std::minus<Real>(), mean_r2));
+            autocovariances (tmp.begin(), tmp.end(), acf.begin(), maxLag);
+            QL_REQUIRE (acf[0] > 0, "Data series is constant");
+
+            Garch11CostFunction cost (r2);
+
+            // two initial guesses based on fitting ACF
+            const bool useGuess1 = (mode != Garch11::GammaGuess);
+            const bool useGuess2 = (mode != Garch11::MomentMatchingGuess);
+            Real gammaLower1 = 0.0, gammaLower2 = 0.0;
+            Array opt1(3), opt2(3);
+            Real fCost1 = QL_MAX_REAL, fCost2 = QL_MAX_REAL;
+            #pragma omp parallel sections if(useGuess1 && useGuess2)
+            {
+                #pragma omp section
+                if (useGuess1) {
+                    gammaLower1 = initialGuess1(acf, mean_r2,
+                                                opt1[1], opt1[2], opt1[0]);
+                    fCost1 = cost.value(opt1);
+                }
+                #pragma omp section
+                if (useGuess2) {
+                    gammaLower2 = initialGuess2(acf, mean_r2,
+                                                opt2[1], opt2[2], opt2[0]);
+                    fCost2 = cost.value(opt2);
+                }
+            }
+            Real gammaLower = useGuess2 ? gammaLower2 : gammaLower1;
+
+            Garch11Constraint constraints(gammaLower, 1.0 - tol_level);
+
+            boost::shared_ptr<Problem> ret;
+            if (mode != Garch11::DoubleOptimization) {
+                try {
+                    ret = Garch11::calibrate_r2(r2, method1, constraints,
+                                                endCriteria,
+                                                fCost1 <= fCost2 ? opt1 : opt2,
+                                                alpha, beta, omega);
+                } catch (const std::exception &) {
+                    if (fCost1 <= fCost2) {
+                        alpha = opt1[1];
+                        beta = opt1[2];
+                        omega = opt1[0];
+                    } else {
+                        alpha = opt2[1];
+                        beta = opt2[2];
+                        omega = opt2[0];
+                    }
+                }
+            } else {
+                boost::shared_ptr<Problem> ret1, ret2;
+                #pragma omp parallel sections if(&method1 != &method2)
+                {
+                    #pragma omp section
+                    ret1 = optimizeFromGuess(r2, method1, constraints,
+                                             endCriteria, cost, opt1, fCost1);
+                    #pragma omp section
+                    ret2 = optimizeFromGuess(r2, method2, constraints,
+                                             endCriteria, cost, opt2, fCost2);
+                }
+
+                if (fCost1 <= fCost2) {
+                    alpha = opt1[1];
+                    beta = opt1[2];
+                    omega = opt1[0];
+                    ret = ret1;
+                } else {
+                    alpha = opt2[1];
+                    beta = opt2[2];
+                    omega = opt2[0];
+                    ret = ret2;
+                }
+            }
+            return ret;
+        }
+
     }
 
     Garch11::time_series
@@ -394,109 +519,17 @@ namespace QuantLib {
                    Mode mode, const std::vector<Volatility> &r2, Real mean_r2,
                    Real &alpha, Real &beta, Real &omega) {
         EndCriteria endCriteria(10000, 500, tol_level, tol_level, tol_level);
-        Simplex method(0.001);
-        return calibrate_r2(mode, r2, mean_r2, method, endCriteria,
-                            alpha, beta, omega);
+        Simplex method1(0.001), method2(0.001);
+        return calibrateFromGuesses(mode, r2, mean_r2, method1, method2,
+                                    endCriteria, alpha, beta, omega);
     }
 
     boost::shared_ptr<Problem> Garch11::calibrate_r2(
                    Mode mode, const std::vector<Volatility> &r2, Real mean_r2,
                    OptimizationMethod &method, const EndCriteria &endCriteria,
                    Real &alpha, Real &beta, Real &omega) {
-        Real dataSize = Real(r2.size());
-        alpha = 0.0;
-        beta = 0.0;
-        omega = 0.0;
-        QL_REQUIRE (dataSize >= 4,
-                    "Data series is too short to fit GARCH model");
-        QL_REQUIRE (mean_r2 > 0, "Data series is constant");
-        omega = mean_r2 * dataSize / (dataSize - 1);
-
-        // ACF
-        Size maxLag = (Size)std::sqrt(dataSize);
-        Array acf(maxLag+1);
-        std::vector<Volatility> tmp(r2.size());
-        std::transform (r2.begin(), r2.end(), tmp.begin(),
-                        std::bind2nd(std::minus<Real>(), mean_r2));
-        autocovariances (tmp.begin(), tmp.end(), acf.begin(), maxLag);
-        QL_REQUIRE (acf[0] > 0, "Data series is constant");
-
-        Garch11CostFunction cost (r2);
-
-        // two initial guesses based on fitting ACF
-        Real gammaLower = 0.0;
-        Array opt1(3);
-        Real fCost1 = QL_MAX_REAL;
-        if (mode != GammaGuess) {
-            gammaLower = initialGuess1(acf, mean_r2, opt1[1], opt1[2], opt1[0]);
-            fCost1 = cost.value(opt1);
-        }
-
-        Array opt2(3);
-        Real fCost2 = QL_MAX_REAL;
-        if (mode != MomentMatchingGuess) {
-            gammaLower = initialGuess2(acf, mean_r2, opt2[1], opt2[2], opt2[0]);
-            fCost2 = cost.value(opt2);
-        }
-
-        Garch11Constraint constraints(gammaLower, 1.0 - tol_level);
-
-        boost::shared_ptr<Problem> ret;
-        if (mode != DoubleOptimization) {
-            try {
-                ret = calibrate_r2(r2, method, constraints, endCriteria,
-                                   fCost1 <= fCost2 ? opt1 : opt2,
-                                   alpha, beta, omega);
-            } catch (const std::exception &) {
-                if (fCost1 <= fCost2) {
-                    alpha = opt1[1];
-                    beta = opt1[2];
-                    omega = opt1[0];
-                } else {
-                    alpha = opt2[1];
-                    beta = opt2[2];
-                    omega = opt2[0];
-                }
-            }
-        } else {
-            boost::shared_ptr<Problem> ret1, ret2;
-            try {
-                ret1 = calibrate_r2(r2, method, constraints, endCriteria,
-                                    opt1, alpha, beta, omega);
-                opt1[1] = alpha;
-                opt1[2] = beta;
-                opt1[0] = omega;
-                if (constraints.test(opt1))
-                    fCost1 = std::min(fCost1, cost.value(opt1));
-            } catch (const std::exception &) {
-                fCost1 = QL_MAX_REAL;
-            }
-
-            try {
-                ret2 = calibrate_r2(r2, method, constraints, endCriteria,
-                                    opt2, alpha, beta, omega);
-                opt2[1] = alpha;
-                opt2[2] = beta;
-                opt2[0] = omega;
-                if (constraints.test(opt2))
-                    fCost2 = std::min(fCost2, cost.value(opt2));
-            } catch (const std::exception &) {
-                fCost2 = QL_MAX_REAL;
-            }
-
-            if (fCost1 <= fCost2) {
-                alpha = opt1[1];
-                beta = opt1[2];
-                omega = opt1[0];
-                ret = ret1;
-            } else {
-                alpha = opt2[1];
-                beta = opt2[2];
-                omega = opt2[0];
-                ret = ret2;
-            }
-        }
-        return ret;
+        return calibrateFromGuesses(mode, r2, mean_r2, method, method,
+                                    endCriteria, alpha, beta, omega);
     }
 
     boost::shared_ptr<Problem> Garch11::calibrate_r2(
@@ -166,7 +166,12 @@ namespace QuantLib {
             return mean_r2;
         }
 
-        /*! calibrates GARCH for r^2 */
+        /*! calibrates GARCH for r^2
+
+            When OpenMP is enabled, the two initial guesses and the
+            two optimizations of the DoubleOptimization mode are run
+            in parallel.
+        */
         static boost::shared_ptr<Problem> calibrate_r2(
                                         Mode mode,
                                         const std::vector<Volatility>& r2,
@@ -176,7 +181,12 @@ namespace QuantLib {
                                         Real& omega);
 
         /*! calibrates GARCH for r^2 with user-defined optimization
-            method and end criteria */
+            method and end criteria
+
+            The optimizations of the DoubleOptimization mode share
+            the given method and are therefore run one after the
+            other.
+        */
         static boost::shared_ptr<Problem> calibrate_r2(
                                         Mode mode,
                                         const std::vector<Volatility>& r2,
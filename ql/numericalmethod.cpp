@@ -0,0 +1,37 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/numericalmethod.hpp>
+#include <ql/discretizedasset.hpp>
+
+namespace QuantLib {
+
+    void Lattice::rollback(const std::vector<DiscretizedAsset*>& assets,
+                           Time to) const {
+        for (Size i=0; i<assets.size(); ++i)
+            rollback(*assets[i], to);
+    }
+
+    void Lattice::partialRollback(
+                               const std::vector<DiscretizedAsset*>& assets,
+                               Time to) const {
+        for (Size i=0; i<assets.size(); ++i)
+            partialRollback(*assets[i], to);
+    }
+
+}
+
@@ -27,6 +27,7 @@
 
 #include <ql/timegrid.hpp>
 #include <ql/math/array.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -83,6 +84,21 @@ namespace QuantLib {
         virtual void partialRollback(DiscretizedAsset&,
                                      Time to) const = 0;
 
+        /*! Roll back a number of assets, all initialized on this
+            lattice at the same time, until the given time, performing
+            any needed adjustment.  The default implementation rolls
+            back each asset in turn; lattices can override it so that
+            the work of each step is shared among the assets.
+        */
+        virtual void rollback(const std::vector<DiscretizedAsset*>&,
+                              Time to) const;
+
+        /*! Roll back a number of assets until the given time, but do
+            not perform the final adjustment.
+        */
+        virtual void partialRollback(const std::vector<DiscretizedAsset*>&,
+                                     Time to) const;
+
         //! computes the present value of an asset.
         virtual Real presentValue(DiscretizedAsset&) const = 0;
 
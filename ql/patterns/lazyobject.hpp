@@ -25,6 +25,7 @@
 #define quantlib_lazy_object_h
 
 #include <ql/patterns/observable.hpp>
+#include <ql/utilities/instrumentation.hpp>
 
 namespace QuantLib {
 
@@ -32,6 +33,7 @@ namespace QuantLib {
     /*! \ingroup patterns */
     class LazyObject : public virtual Observable,
                        public virtual Observer {
+        friend class ObserverGraph;
       public:
         LazyObject();
         virtual ~LazyObject() {}
@@ -164,6 +166,7 @@ namespace QuantLib {
 
     inline void LazyObject::calculate() const {
         if (!calculated_ && !frozen_) {
+            QL_INSTRUMENT_OBJECT_SCOPE("LazyObject::calculate", this);
             calculated_ = true;   // prevent infinite recursion in
                                   // case of bootstrapping
             try {
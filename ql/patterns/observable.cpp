@@ -20,24 +20,58 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 
 #include <ql/patterns/observable.hpp>
+#include <ql/utilities/instrumentation.hpp>
 
 #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
+#include <algorithm>
+
 namespace QuantLib {
 
-    void ObservableSettings::enableUpdates() {
-        updatesEnabled_  = true;
-        updatesDeferred_ = false;
+    void ObservableSettings::visit(Observer* o,
+                                   set_type& visited,
+                                   std::vector<Observer*>& order) {
+        // depth-first visit of the observers downstream of o; each
+        // observer is appended after all the observers depending on it
+        if (!visited.insert(o).second)
+            return;
+        const Observable* observable = dynamic_cast<Observable*>(o);
+        if (observable) {
+            for (Observable::iterator i = observable->observers_.begin();
+                 i != observable->observers_.end(); ++i)
+                visit(*i, visited, order);
+        }
+        order.push_back(o);
+    }
 
+    void ObservableSettings::enableUpdates() {
         // if there are outstanding deferred updates, do the notification
-        if (deferredObservers_.size()) {
-            bool successful = true;
-            std::string errMsg;
-
+        bool successful = true;
+        std::string errMsg;
+
+        // Each deferred observer is updated once, after the ones it
+        // depends upon.  The notifications sent from within the
+        // updates are deferred as well; since the observers are
+        // sorted topologically, they reach the corresponding
+        // observers before their turn comes.  The loop only runs
+        // more than once if the updates modify the dependency graph.
+        updatesEnabled_  = false;
+        updatesDeferred_ = true;
+        while (!deferredObservers_.empty()) {
+            std::vector<Observer*> order;
+            set_type visited;
             for (iterator i=deferredObservers_.begin();
-                i!=deferredObservers_.end(); ++i) {
+                 i!=deferredObservers_.end(); ++i)
+                visit(*i, visited, order);
+            std::reverse(order.begin(), order.end());
+
+            for (Size i=0; i<order.size(); ++i) {
+                // observers destroyed during the loop are no longer
+                // in the deferred set, so they are never reached here
+                if (deferredObservers_.erase(order[i]) == 0)
+                    continue;
                 try {
-                    (*i)->update();
+                    order[i]->update();
                 } catch (std::exception& e) {
                     successful = false;
                     errMsg = e.what();
@@ -45,12 +79,12 @@ namespace QuantLib {
                     successful = false;
                 }
             }
+        }
+        updatesEnabled_  = true;
+        updatesDeferred_ = false;
 
-            deferredObservers_.clear();
-
-            QL_ENSURE(successful,
+        QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
-        }
     }
 
 
@@ -58,13 +92,24 @@ namespace QuantLib {
         if (!settings_.updatesEnabled()) {
             // if updates are only deferred, flag this for later notification
             // these are held centrally by the settings singleton
-            settings_.registerDeferredObservers(observers_);
+            settings_.registerDeferredObservers(*this);
         }
         else if (observers_.size()) {
+            QL_INSTRUMENT_COUNT("Observable::notifyObservers", 1);
+            QL_INSTRUMENT_COUNT("Observable::fanOut", observers_.size());
             bool successful = true;
             std::string errMsg;
-            for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
+            // observers may register or unregister with this observable
+            // from within their update, which invalidates the iterators
+            // of the set; the loop is therefore run on a copy, and the
+            // observers unregistered in the meantime (possibly because
+            // they were destroyed) are skipped.
+            const set_type observers(observers_);
+            for (iterator i=observers.begin(); i!=observers.end(); ++i) {
+                if (observers_.count(*i) == 0)
+                    continue;
                 try {
+                    QL_INSTRUMENT_OBJECT_SCOPE("Observer::update", *i);
                     (*i)->update();
                 } catch (std::exception& e) {
                     // quite a dilemma. If we don't catch the exception,
@@ -89,54 +134,42 @@ namespace QuantLib {
 
 #else
 
-#include <boost/signals2/signal_type.hpp>
-
 namespace QuantLib {
 
-    namespace detail {
-
-        class Signal {
-          public:
-            typedef boost::signals2::signal_type<
-                void(),
-                boost::signals2::keywords::mutex_type<boost::recursive_mutex> >
-                ::type signal_type;
-
-            void connect(const signal_type::slot_type& slot) {
-                sig_.connect(slot);
+    void Observer::Proxy::update() const {
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        if (active_) {
+            const boost::weak_ptr<Observer> o = observer_->weak_from_this();
+            if (!o._empty()) {
+                const boost::shared_ptr<Observer> obs(o.lock());
+                if (obs)
+                    obs->update();
             }
-
-            template <class T>
-            void disconnect(const T& slot) {
-                sig_.disconnect(slot);
-            }
-
-            void operator()() const {
-                sig_.operator()();
+            else {
+                observer_->update();
             }
-          private:
-            signal_type sig_;
-        };
+        }
+    }
 
+    void Observer::Proxy::deactivate() {
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        active_ = false;
     }
 
+
     void Observable::registerObserver(
         const boost::shared_ptr<Observer::Proxy>& observerProxy) {
-        {
-            boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-            observers_.insert(observerProxy);
-        }
-
-        detail::Signal::signal_type::slot_type slot(&Observer::Proxy::update,
-                                    observerProxy.get());
-        sig_->connect(slot.track(observerProxy));
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        if (observers_.insert(observerProxy).second)
+            publishProxies();
     }
 
     void Observable::unregisterObserver(
         const boost::shared_ptr<Observer::Proxy>& observerProxy) {
         {
             boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-            observers_.erase(observerProxy);
+            if (observers_.erase(observerProxy) != 0)
+                publishProxies();
         }
 
         if (settings_.updatesDeferred()) {
@@ -145,19 +178,55 @@ namespace QuantLib {
                 settings_.unregisterDeferredObserver(observerProxy);
             }
         }
+    }
 
-        sig_->disconnect(boost::bind(&Observer::Proxy::update,
-                             observerProxy.get()));
+    void Observable::publishProxies() {
+        // notifications in progress keep using the old snapshot
+        boost::shared_ptr<const proxy_list> proxies;
+        if (!observers_.empty())
+            proxies.reset(new proxy_list(observers_.begin(),
+                                         observers_.end()));
+        boost::atomic_store(&proxies_, proxies);
+    }
+
+    void Observable::notifyProxies() {
+        const boost::shared_ptr<const proxy_list> proxies =
+            boost::atomic_load(&proxies_);
+        if (!proxies)
+            return;
+
+        QL_INSTRUMENT_COUNT("Observable::notifyObservers", 1);
+        QL_INSTRUMENT_COUNT("Observable::fanOut", proxies->size());
+
+        bool successful = true;
+        std::string errMsg;
+        for (proxy_list::const_iterator i=proxies->begin();
+             i!=proxies->end(); ++i) {
+            try {
+                QL_INSTRUMENT_OBJECT_SCOPE("Observer::update", i->get());
+                (*i)->update();
+            } catch (std::exception& e) {
+                // as in the non-thread-safe version, try and notify
+                // all observers while raising an exception if
+                // something bad happened.
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
     }
 
     void Observable::notifyObservers() {
         if (settings_.updatesEnabled()) {
-            return sig_->operator()();
+            return notifyProxies();
         }
 
         boost::lock_guard<boost::mutex> sLock(settings_.mutex_);
         if (settings_.updatesEnabled()) {
-            return sig_->operator()();
+            return notifyProxies();
         }
         else if (settings_.updatesDeferred()) {
             boost::lock_guard<boost::recursive_mutex> lock(mutex_);
@@ -168,12 +237,10 @@ namespace QuantLib {
     }
 
     Observable::Observable()
-    : sig_(new detail::Signal()),
-      settings_(ObservableSettings::instance()) { }
+    : settings_(ObservableSettings::instance()) { }
 
     Observable::Observable(const Observable&)
-    : sig_(new detail::Signal()),
-      settings_(ObservableSettings::instance()) {
+    : settings_(ObservableSettings::instance()) {
         // the observer set is not copied; no observer asked to
         // register with this object
     }
@@ -32,6 +32,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
 #include <ql/patterns/singleton.hpp>
+#include <ql/utilities/smallset.hpp>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/unordered_set.hpp>
@@ -45,6 +46,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #if BOOST_VERSION < 104700
 #include <set>
 #endif
+#include <vector>
 
 namespace QuantLib {
 
@@ -60,6 +62,13 @@ namespace QuantLib {
             updatesEnabled_  = false;
             updatesDeferred_ = deferred;
         }
+        /*! If updates were deferred, the observers that would have
+            been notified in the meantime are now updated.  Each of
+            them is updated only once, and only after any other
+            deferred observer it depends upon; the notifications
+            triggered by the updates are consolidated in the same
+            way.
+        */
         void enableUpdates();
 
         bool updatesEnabled()  {return updatesEnabled_;}
@@ -69,12 +78,12 @@ namespace QuantLib {
         : updatesEnabled_(true),
           updatesDeferred_(false) {}
 
-        void registerDeferredObservers(
-            const boost::unordered_set<Observer*>& observers);
+        void registerDeferredObservers(const Observable&);
         void unregisterDeferredObserver(Observer*);
 
         typedef boost::unordered_set<Observer*> set_type;
         typedef set_type::iterator iterator;
+        static void visit(Observer*, set_type&, std::vector<Observer*>&);
         set_type deferredObservers_;
 
         bool updatesEnabled_,  updatesDeferred_;
@@ -84,6 +93,8 @@ namespace QuantLib {
     /*! \ingroup patterns */
     class Observable {
         friend class Observer;
+        friend class ObservableSettings;
+        friend class ObserverGraph;
       public:
         // constructors, assignment, destructor
         Observable() : settings_(ObservableSettings::instance()) {}
@@ -95,10 +106,15 @@ namespace QuantLib {
         */
         void notifyObservers();
       private:
-        typedef boost::unordered_set<Observer*>::iterator iterator;
+        /* Most observables are observed by a few objects; their
+           observers are stored inline, and a hash set is only
+           allocated for the ones with more observers. */
+        typedef SmallSet<Observer*, boost::unordered_set<Observer*> >
+                                                             set_type;
+        typedef set_type::iterator iterator;
         std::pair<iterator, bool> registerObserver(Observer*);
         Size unregisterObserver(Observer*);
-        boost::unordered_set<Observer*> observers_;
+        set_type observers_;
         ObservableSettings& settings_;
     };
 
@@ -106,10 +122,15 @@ namespace QuantLib {
     /*! \ingroup patterns */
     class Observer {
       public:
+        // as for observables, the first few links are stored inline
 #if BOOST_VERSION < 104700
-        typedef std::set<boost::shared_ptr<Observable> > set_type;
+        typedef SmallSet<boost::shared_ptr<Observable>,
+                         std::set<boost::shared_ptr<Observable> > >
+                                                             set_type;
 #else
-        typedef boost::unordered_set<boost::shared_ptr<Observable> > set_type;
+        typedef SmallSet<boost::shared_ptr<Observable>,
+                   boost::unordered_set<boost::shared_ptr<Observable> > >
+                                                             set_type;
 #endif
         typedef set_type::iterator iterator;
 
@@ -145,9 +166,10 @@ namespace QuantLib {
     // inline definitions
 
     inline void ObservableSettings::registerDeferredObservers(
-        const boost::unordered_set<Observer*>& observers) {
+                                                      const Observable& o) {
         if (updatesDeferred()) {
-            deferredObservers_.insert(observers.begin(), observers.end());
+            deferredObservers_.insert(o.observers_.begin(),
+                                      o.observers_.end());
         }
     }
 
@@ -177,7 +199,7 @@ namespace QuantLib {
         return *this;
     }
 
-    inline std::pair<boost::unordered_set<Observer*>::iterator, bool>
+    inline std::pair<Observable::iterator, bool>
     Observable::registerObserver(Observer* o) {
         return observers_.insert(o);
     }
@@ -253,6 +275,7 @@ namespace QuantLib {
 #include <boost/smart_ptr/owner_less.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <set>
+#include <vector>
 
 namespace QuantLib {
 
@@ -264,6 +287,7 @@ namespace QuantLib {
     class Observer : public boost::enable_shared_from_this<Observer> {
         friend class Observable;
         friend class ObservableSettings;
+        friend class ObserverGraph;
       public:
         typedef boost::unordered_set<boost::shared_ptr<Observable> > set_type;
         typedef set_type::iterator iterator;
@@ -290,33 +314,22 @@ namespace QuantLib {
         virtual void update() = 0;
       private:
 
+        /* The proxy locks on update, so that the updates of an
+           observer are serialized even when its observables notify
+           from different threads; deactivate() takes the same lock,
+           so that no update reaches the observer after it returns.
+           The mutex is recursive since an observer can be notified
+           again, or destroyed, from within its own update. */
         class Proxy {
+            friend class ObserverGraph;
           public:
             explicit Proxy(Observer* const observer)
              : active_  (true),
                observer_(observer) {
             }
 
-            void update() const {
-                boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-                if (active_) {
-                    const boost::weak_ptr<Observer> o
-                        = observer_->weak_from_this();
-                    if (!o._empty()) {
-                        const boost::shared_ptr<Observer> obs(o.lock());
-                        if (obs)
-                            obs->update();
-                    }
-                    else {
-                        observer_->update();
-                    }
-                }
-            }
-
-            void deactivate() {
-                boost::lock_guard<boost::recursive_mutex> lock(mutex_);
-                active_ = false;
-            }
+            void update() const;
+            void deactivate();
 
         private:
             bool active_;
@@ -330,14 +343,16 @@ namespace QuantLib {
         set_type observables_;
     };
 
-	namespace detail {
-		class Signal;
-	}
-
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! Notification doesn't lock nor allocate: the observers are
+        read from an immutable snapshot of the observer set, which
+        registration and deregistration replace atomically.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
+        friend class ObserverGraph;
       public:
         typedef boost::unordered_set<boost::shared_ptr<Observer::Proxy> >
             set_type;
@@ -355,8 +370,13 @@ namespace QuantLib {
       private:
         void registerObserver(const boost::shared_ptr<Observer::Proxy>&);
         void unregisterObserver(const boost::shared_ptr<Observer::Proxy>&);
+        void notifyProxies();
+        // must be called with the mutex locked
+        void publishProxies();
 
-        boost::shared_ptr<detail::Signal> sig_;
+        typedef std::vector<boost::shared_ptr<Observer::Proxy> > proxy_list;
+        // null when there are no observers; accessed atomically
+        boost::shared_ptr<const proxy_list> proxies_;
 
         set_type observers_;
         mutable boost::recursive_mutex mutex_;
@@ -546,4 +566,53 @@ namespace QuantLib {
     }
 }
 #endif
+
+#include <boost/noncopyable.hpp>
+
+namespace QuantLib {
+
+    //! batch of notifications
+    /*! While an instance is alive, notifications are deferred (see
+        ObservableSettings::disableUpdates) instead of being sent as
+        they are raised; a typical use is the update of a whole set
+        of market quotes.  When the batch is closed, the collected
+        notifications are sent by ObservableSettings::enableUpdates,
+        which notifies each affected observer once.
+
+        A batch created while updates are already disabled (e.g.,
+        inside another batch) has no effect; the notifications will
+        be sent when updates are enabled again.
+
+        \warning An exception raised by an observer during the
+                 notification is propagated by close() but is lost
+                 if the batch is closed by its destructor.  With the
+                 thread-safe observer pattern, the deferred
+                 notifications are sent as before, without
+                 consolidating the ones triggered by the updates.
+    */
+    class NotificationBatch : private boost::noncopyable {
+      public:
+        NotificationBatch()
+        : open_(ObservableSettings::instance().updatesEnabled()) {
+            if (open_)
+                ObservableSettings::instance().disableUpdates(true);
+        }
+        ~NotificationBatch() {
+            try {
+                close();
+            } catch (...) {}
+        }
+        //! sends the deferred notifications
+        void close() {
+            if (open_) {
+                open_ = false;
+                ObservableSettings::instance().enableUpdates();
+            }
+        }
+      private:
+        bool open_;
+    };
+
+}
+
 #endif
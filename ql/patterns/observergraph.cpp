@@ -0,0 +1,205 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/patterns/observergraph.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 105600
+#include <boost/core/demangle.hpp>
+#endif
+#include <algorithm>
+#include <map>
+#include <ostream>
+#include <typeinfo>
+
+namespace QuantLib {
+
+    namespace {
+
+        std::string typeName(const std::type_info& type) {
+            #if BOOST_VERSION >= 105600
+            return boost::core::demangle(type.name());
+            #else
+            return type.name();
+            #endif
+        }
+
+        void writeEscaped(std::ostream& out, const std::string& s) {
+            for (Size i=0; i<s.size(); ++i) {
+                if (s[i] == '"' || s[i] == '\\')
+                    out << '\\';
+                out << s[i];
+            }
+        }
+
+    }
+
+    std::vector<Observer*> ObserverGraph::observersOf(const Observable& o) {
+        std::vector<Observer*> result;
+        #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        result.assign(o.observers_.begin(), o.observers_.end());
+        #else
+        const boost::shared_ptr<const Observable::proxy_list> proxies =
+            boost::atomic_load(&o.proxies_);
+        if (proxies) {
+            for (Size i=0; i<proxies->size(); ++i) {
+                const Observer::Proxy& proxy = *(*proxies)[i];
+                boost::lock_guard<boost::recursive_mutex> lock(proxy.mutex_);
+                if (proxy.active_)
+                    result.push_back(proxy.observer_);
+            }
+        }
+        #endif
+        return result;
+    }
+
+    ObserverGraph::ObserverGraph(const Observable& root) {
+        // breadth-first visit from the root; the nodes are identified
+        // by the address of the complete object, since observers and
+        // observables are reached through different base classes.
+        std::map<const void*, Size> index;
+
+        Node n = { 0, &root, typeName(typeid(root)), 0, 0,
+                   false, false, false, false };
+        if (const LazyObject* lazy = dynamic_cast<const LazyObject*>(&root)) {
+            n.lazy = true;
+            n.calculated = lazy->calculated_;
+            n.frozen = lazy->frozen_;
+            n.alwaysForward = lazy->alwaysForward_;
+        }
+        nodes_.push_back(n);
+        observers_.push_back(std::vector<Size>());
+        index[dynamic_cast<const void*>(&root)] = 0;
+
+        for (Size k=0; k<nodes_.size(); ++k) {
+            if (!nodes_[k].observable)
+                continue;
+            std::vector<Observer*> observers =
+                observersOf(*nodes_[k].observable);
+            nodes_[k].fanOut = observers.size();
+            for (Size i=0; i<observers.size(); ++i) {
+                const Observer* o = observers[i];
+                const void* address = dynamic_cast<const void*>(o);
+                std::map<const void*, Size>::const_iterator j =
+                    index.find(address);
+                Size to;
+                if (j != index.end()) {
+                    to = j->second;
+                } else {
+                    to = nodes_.size();
+                    Node m = { o, dynamic_cast<const Observable*>(o),
+                               typeName(typeid(*o)), nodes_[k].depth+1, 0,
+                               false, false, false, false };
+                    if (const LazyObject* lazy =
+                                       dynamic_cast<const LazyObject*>(o)) {
+                        m.lazy = true;
+                        m.calculated = lazy->calculated_;
+                        m.frozen = lazy->frozen_;
+                        m.alwaysForward = lazy->alwaysForward_;
+                    }
+                    nodes_.push_back(m);
+                    observers_.push_back(std::vector<Size>());
+                    index[address] = to;
+                }
+                Edge e = { k, to };
+                edges_.push_back(e);
+                observers_[k].push_back(to);
+            }
+        }
+    }
+
+    Size ObserverGraph::depth() const {
+        // the nodes are sorted by depth
+        return nodes_.back().depth;
+    }
+
+    Size ObserverGraph::lazyObjects() const {
+        Size n = 0;
+        for (Size i=0; i<nodes_.size(); ++i)
+            if (nodes_[i].lazy)
+                ++n;
+        return n;
+    }
+
+    ObserverGraph::Notification ObserverGraph::dryNotify() const {
+        Notification result = { 0, 0, 0 };
+        std::vector<bool> calculated(nodes_.size()),
+                          notifying(nodes_.size(), false);
+        for (Size i=0; i<nodes_.size(); ++i)
+            calculated[i] = nodes_[i].calculated;
+        notifying[0] = true;
+        notify(0, 1, result, calculated, notifying);
+        return result;
+    }
+
+    void ObserverGraph::notify(Size k, Size level, Notification& result,
+                               std::vector<bool>& calculated,
+                               std::vector<bool>& notifying) const {
+        // same logic as Observable::notifyObservers() and
+        // LazyObject::update().  An observable already notifying
+        // further up the stack would recurse forever; the real
+        // notification would, too, so the cycle is cut here.
+        for (Size i=0; i<observers_[k].size(); ++i) {
+            Size j = observers_[k][i];
+            const Node& node = nodes_[j];
+            ++result.updates;
+            result.depth = std::max(result.depth, level);
+
+            bool forward;
+            if (node.lazy) {
+                forward = (calculated[j] || node.alwaysForward)
+                       && !node.frozen;
+                if (calculated[j] && !node.frozen)
+                    ++result.invalidated;
+                calculated[j] = false;
+            } else {
+                forward = (node.observable != 0);
+            }
+
+            if (forward && !notifying[j]) {
+                notifying[j] = true;
+                notify(j, level+1, result, calculated, notifying);
+                notifying[j] = false;
+            }
+        }
+    }
+
+    void ObserverGraph::write(std::ostream& out) const {
+        out << "digraph observers {\n";
+        for (Size i=0; i<nodes_.size(); ++i) {
+            const Node& n = nodes_[i];
+            out << "    n" << i << " [label=\"";
+            writeEscaped(out, n.type);
+            if (n.lazy) {
+                out << "\\n" << (n.calculated ? "calculated" : "invalidated");
+                if (n.frozen)
+                    out << ", frozen";
+            }
+            out << "\"";
+            if (i == 0)
+                out << ", shape=doubleoctagon";
+            else if (n.lazy)
+                out << ", shape=box";
+            out << "];\n";
+        }
+        for (Size i=0; i<edges_.size(); ++i)
+            out << "    n" << edges_[i].from << " -> n" << edges_[i].to
+                << ";\n";
+        out << "}\n";
+    }
+
+}
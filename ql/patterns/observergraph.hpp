@@ -0,0 +1,124 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file observergraph.hpp
+    \brief inspection of the observers reached by a notification
+*/
+
+#ifndef quantlib_observer_graph_hpp
+#define quantlib_observer_graph_hpp
+
+#include <ql/patterns/observable.hpp>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! snapshot of the observers reached by a notification
+    /*! The graph contains the given observable and all the observers
+        that would be reached, directly or indirectly, by its
+        notifications; that is, the observers registered with it, the
+        observers registered with those of them that are observables
+        in turn, and so on.  The fan-out and the distance from the
+        root of each node are available, as well as the number of
+        lazy objects in the graph.
+
+        The graph can also be used to simulate a notification from
+        its root without sending it; this follows the same rules as
+        LazyObject::update(), so that lazy objects that are already
+        invalidated or frozen stop the cascade, and reports how many
+        update() calls would be made, how deep the cascade would go
+        and how many lazy objects would have to recalculate.  The
+        time actually spent in each update can be recorded by
+        compiling the library with QL_ENABLE_INSTRUMENTATION; see
+        the Instrumentation class.
+
+        \warning The simulation assumes that observers don't
+                 override LazyObject::update() in ways that change
+                 the forwarding of notifications, and that any other
+                 observable forwards the notifications it receives.
+                 The graph is a snapshot; it must not be used after
+                 any of its nodes is destroyed or reregistered.
+
+        \ingroup patterns
+    */
+    class ObserverGraph {
+      public:
+        struct Node {
+            //! null for the root
+            const Observer* observer;
+            //! null for observers that are not observable
+            const Observable* observable;
+            //! the dynamic type of the node
+            std::string type;
+            //! length of the shortest path from the root
+            Size depth;
+            //! number of registered observers
+            Size fanOut;
+            bool lazy;
+            //! whether a lazy object holds calculated results
+            bool calculated;
+            bool frozen;
+            bool alwaysForward;
+        };
+        //! an observer (to) registered with an observable (from)
+        struct Edge {
+            Size from, to;
+        };
+        //! results of a simulated notification
+        struct Notification {
+            //! calls to Observer::update()
+            Size updates;
+            //! maximum nesting of the calls
+            Size depth;
+            //! lazy objects whose results would be discarded
+            Size invalidated;
+        };
+
+        explicit ObserverGraph(const Observable& root);
+
+        //! \name Inspectors
+        //@{
+        //! the root first, then the other nodes in order of depth
+        const std::vector<Node>& nodes() const { return nodes_; }
+        const std::vector<Edge>& edges() const { return edges_; }
+        //! length of the longest of the shortest paths from the root
+        Size depth() const;
+        Size lazyObjects() const;
+        //@}
+
+        //! simulates a notification from the root
+        Notification dryNotify() const;
+
+        //! writes the graph in Graphviz format
+        void write(std::ostream&) const;
+      private:
+        static std::vector<Observer*> observersOf(const Observable&);
+        std::vector<Node> nodes_;
+        std::vector<Edge> edges_;
+        // indices of the observers of each node
+        std::vector<std::vector<Size> > observers_;
+        void notify(Size node, Size level, Notification&,
+                    std::vector<bool>& calculated,
+                    std::vector<bool>& notifying) const;
+    };
+
+}
+
+
+#endif
@@ -26,33 +26,27 @@
 
 #include <ql/qldefines.hpp>
 
+// compilers initializing function-local statics in a thread-safe way
+#if defined(__GNUC__) || (defined(_MSC_VER) && _MSC_VER >= 1900)
+    #define QL_SINGLETON_THREAD_SAFE_STATICS
+#endif
+
 #ifdef QL_ENABLE_SINGLETON_THREAD_SAFE_INIT
-    #if defined(QL_ENABLE_SESSIONS)
+    #include <boost/atomic.hpp>
+    #include <boost/thread/mutex.hpp>
+    #if !defined(BOOST_ATOMIC_ADDRESS_LOCK_FREE) && \
+        !defined(QL_SINGLETON_THREAD_SAFE_STATICS)
         #ifdef BOOST_MSVC
             #pragma message(\
-                "Thread-safe singleton initialization not supported "  \
-                "when sessions are enabled.")
+                "Thread-safe singleton initialization "  \
+                "may degrade performances.")
         #else
             #warning \
-                Thread-safe singleton initialization not supported \
-                when sessions are enabled.
+                Thread-safe singleton initialization \
+                may degrade performances.
         #endif
-    #else
-        #include <boost/atomic.hpp>
-        #include <boost/thread/mutex.hpp>
-        #if !defined(BOOST_ATOMIC_ADDRESS_LOCK_FREE)
-            #ifdef BOOST_MSVC
-                #pragma message(\
-                    "Thread-safe singleton initialization "  \
-                    "may degrade performances.")
-            #else
-                #warning \
-                    Thread-safe singleton initialization \
-                    may degrade performances.
-            #endif
-        #endif
-        #define QL_SINGLETON_THREAD_SAFE_INIT
     #endif
+    #define QL_SINGLETON_THREAD_SAFE_INIT
 #endif
 
 #include <ql/types.hpp>
@@ -105,11 +99,19 @@ namespace QuantLib {
         as a single implemementation point should synchronization
         features be added.
 
+        The instance is created on first access.  On compilers
+        initializing local statics in a thread-safe way, the creation
+        is thread-safe and later accesses don't lock.  When sessions
+        are enabled, each thread caches the instance for the last
+        session it accessed, so that the instances are only looked up
+        when the session changes; the creation of new instances is
+        serialized if QL_ENABLE_SINGLETON_THREAD_SAFE_INIT is defined.
+
         \ingroup patterns
     */
     template <class T>
     class Singleton : private boost::noncopyable {
-    #if (QL_MANAGED == 1) && !defined(QL_SINGLETON_THREAD_SAFE_INIT)
+    #if (QL_MANAGED == 1)
       private:
         static std::map<Integer, boost::shared_ptr<T> > instances_;
     #endif
@@ -125,34 +127,76 @@ namespace QuantLib {
         static T& instance();
       protected:
         Singleton() {}
+      private:
+        static T* sessionInstance(Integer id);
     };
 
     // static member definitions
-    
-    #if (QL_MANAGED == 1) && !defined(QL_SINGLETON_THREAD_SAFE_INIT)
+
+    #if (QL_MANAGED == 1)
       template <class T>
       std::map<Integer, boost::shared_ptr<T> > Singleton<T>::instances_;
     #endif
 
-    #if defined(QL_SINGLETON_THREAD_SAFE_INIT) 
+    #if defined(QL_SINGLETON_THREAD_SAFE_INIT)
     template <class T>  boost::atomic<T*> Singleton<T>::instance_;
     template <class T> boost::mutex Singleton<T>::mutex_;
     #endif
-    
+
     // template definitions
 
     template <class T>
-    T& Singleton<T>::instance() {
+    T* Singleton<T>::sessionInstance(Integer id) {
 
-        #if (QL_MANAGED == 0) && !defined(QL_SINGLETON_THREAD_SAFE_INIT)
+        #if (QL_MANAGED == 0)
         static std::map<Integer, boost::shared_ptr<T> > instances_;
         #endif
 
-        // thread safe double checked locking pattern with atomic memory calls
-        #if defined(QL_SINGLETON_THREAD_SAFE_INIT) 
+        #if defined(QL_SINGLETON_THREAD_SAFE_INIT)
+        boost::mutex::scoped_lock guard(mutex_);
+        #endif
+
+        // instances are never removed, so that pointers to them
+        // can be cached
+        boost::shared_ptr<T>& instance = instances_[id];
+        if (!instance)
+            instance = boost::shared_ptr<T>(new T);
+        return instance.get();
+    }
+
+    template <class T>
+    T& Singleton<T>::instance() {
+
+        #if defined(QL_ENABLE_SESSIONS)
 
+        #if (QL_MANAGED == 0)
+        // each thread caches the instance for the last session it
+        // asked for; the map is only looked up when the session
+        // changes, which is rare since sessions usually map to threads
+        static QL_THREAD_LOCAL T* cached = 0;
+        static QL_THREAD_LOCAL Integer cachedId = 0;
+        Integer id = sessionId();
+        if (cached == 0 || cachedId != id) {
+            cached = sessionInstance(id);
+            cachedId = id;
+        }
+        return *cached;
+        #else
+        return *sessionInstance(sessionId());
+        #endif
+
+        #elif defined(QL_SINGLETON_THREAD_SAFE_STATICS) && (QL_MANAGED == 0)
+
+        // the compiler guarantees a thread-safe initialization; after
+        // that, the access is a check of the guard variable
+        static boost::shared_ptr<T> instance(new T);
+        return *instance;
+
+        #elif defined(QL_SINGLETON_THREAD_SAFE_INIT)
+
+        // thread safe double checked locking pattern with atomic memory calls
         T* instance =  instance_.load(boost::memory_order_consume);
-        
+
         if (!instance) {
             boost::mutex::scoped_lock guard(mutex_);
             instance = instance_.load(boost::memory_order_consume);
@@ -161,22 +205,13 @@ namespace QuantLib {
                 instance_.store(instance, boost::memory_order_release);
             }
         }
+        return *instance;
 
         #else //this is not thread safe
 
-        #if defined(QL_ENABLE_SESSIONS)
-        Integer id = sessionId();
-        #else
-        Integer id = 0;
-        #endif
-
-        boost::shared_ptr<T>& instance = instances_[id];
-        if (!instance)
-            instance = boost::shared_ptr<T>(new T);
+        return *sessionInstance(0);
 
         #endif
-
-        return *instance;
     }
 
     // reverts the change above
@@ -187,5 +222,6 @@ namespace QuantLib {
 }
 
 #undef QL_MANAGED
+#undef QL_SINGLETON_THREAD_SAFE_STATICS
 
 #endif
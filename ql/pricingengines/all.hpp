@@ -3,14 +3,20 @@
 
 #include <ql/pricingengines/americanpayoffatexpiry.hpp>
 #include <ql/pricingengines/americanpayoffathit.hpp>
+#include <ql/pricingengines/batchblackformula.hpp>
 #include <ql/pricingengines/blackcalculator.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/blackscholescalculator.hpp>
+#include <ql/pricingengines/cachingengine.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/pricingengines/greeks.hpp>
+#include <ql/pricingengines/gridcalibrator.hpp>
 #include <ql/pricingengines/latticeshortratemodelengine.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/pricingengines/portfoliopricer.hpp>
+#include <ql/pricingengines/pricingenginepool.hpp>
+#include <ql/pricingengines/valuationqueue.hpp>
 
 #include <ql/pricingengines/asian/all.hpp>
 #include <ql/pricingengines/barrier/all.hpp>
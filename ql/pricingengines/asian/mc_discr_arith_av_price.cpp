@@ -51,4 +51,43 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+
+    ArithmeticAPOBatchPricer::ArithmeticAPOBatchPricer(
+                                         Option::Type type,
+                                         Real strike, DiscountFactor discount,
+                                         Real runningSum, Size pastFixings)
+    : payoff_(type, strike), discount_(discount),
+      runningSum_(runningSum), pastFixings_(pastFixings) {
+        QL_REQUIRE(strike>=0.0,
+            "strike less than zero not allowed");
+    }
+
+    Array ArithmeticAPOBatchPricer::operator()(
+                                          const MultiPathBatch& paths) const {
+        Size n = paths.pathSize();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        // the fixings are added in the same order as in
+        // ArithmeticAPOPathPricer, so that the results are the same
+        Size lanes = paths.lanes();
+        Array sum(lanes, runningSum_);
+        Size first, fixings;
+        if (paths.timeGrid().mandatoryTimes()[0]==0.0) {
+            // include initial fixing
+            first = 0;
+            fixings = pastFixings_ + n;
+        } else {
+            first = 1;
+            fixings = pastFixings_ + n - 1;
+        }
+        for (Size i=first; i<n; ++i) {
+            Matrix::const_row_iterator price = paths[i].row_begin(0);
+            for (Size k=0; k<lanes; ++k)
+                sum[k] += price[k];
+        }
+        for (Size k=0; k<lanes; ++k)
+            sum[k] = discount_ * payoff_(sum[k]/fixings);
+        return sum;
+    }
+
 }
@@ -64,10 +64,17 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size workers = 1,
+             Size lanes = 1);
       protected:
+        typedef
+        typename MCDiscreteAveragingAsianEngine<RNG,S>::batch_pricer_type
+            batch_pricer_type;
         boost::shared_ptr<path_pricer_type> pathPricer() const;
         boost::shared_ptr<path_pricer_type> controlPathPricer() const;
+        boost::shared_ptr<batch_pricer_type> batchPathPricer() const;
+        boost::shared_ptr<batch_pricer_type> controlBatchPathPricer() const;
         boost::shared_ptr<PricingEngine> controlPricingEngine() const {
             return boost::shared_ptr<PricingEngine>(
                 new AnalyticDiscreteGeometricAveragePriceAsianEngine(
@@ -92,6 +99,24 @@ namespace QuantLib {
     };
 
 
+    //! batch counterpart of ArithmeticAPOPathPricer
+    class ArithmeticAPOBatchPricer
+        : public PathPricer<MultiPathBatch,Array> {
+      public:
+        ArithmeticAPOBatchPricer(Option::Type type,
+                                 Real strike,
+                                 DiscountFactor discount,
+                                 Real runningSum = 0.0,
+                                 Size pastFixings = 0);
+        Array operator()(const MultiPathBatch& paths) const;
+      private:
+        PlainVanillaPayoff payoff_;
+        DiscountFactor discount_;
+        Real runningSum_;
+        Size pastFixings_;
+    };
+
+
     // inline definitions
 
     template <class RNG, class S>
@@ -104,7 +129,9 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             Size workers,
+             Size lanes)
     : MCDiscreteAveragingAsianEngine<RNG,S>(process,
                                             brownianBridge,
                                             antitheticVariate,
@@ -112,7 +139,9 @@ namespace QuantLib {
                                             requiredSamples,
                                             requiredTolerance,
                                             maxSamples,
-                                            seed) {}
+                                            seed,
+                                            workers,
+                                            lanes) {}
 
     template <class RNG, class S>
     inline
@@ -169,6 +198,47 @@ namespace QuantLib {
                                                    this->timeGrid().back())));
     }
 
+    template <class RNG, class S>
+    inline
+    boost::shared_ptr<
+            typename MCDiscreteArithmeticAPEngine<RNG,S>::batch_pricer_type>
+        MCDiscreteArithmeticAPEngine<RNG,S>::batchPathPricer() const {
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        return boost::shared_ptr<batch_pricer_type>(
+                new ArithmeticAPOBatchPricer(
+                    payoff->optionType(),
+                    payoff->strike(),
+                    this->process_->riskFreeRate()->discount(
+                                                     this->timeGrid().back()),
+                    this->arguments_.runningAccumulator,
+                    this->arguments_.pastFixings));
+    }
+
+    template <class RNG, class S>
+    inline
+    boost::shared_ptr<
+            typename MCDiscreteArithmeticAPEngine<RNG,S>::batch_pricer_type>
+        MCDiscreteArithmeticAPEngine<RNG,S>::controlBatchPathPricer() const {
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        // must match controlPathPricer()
+        return boost::shared_ptr<batch_pricer_type>(
+            new GeometricAPOBatchPricer(
+              payoff->optionType(),
+              payoff->strike(),
+              this->process_->riskFreeRate()->discount(
+                                                   this->timeGrid().back())));
+    }
+
     template <class RNG = PseudoRandom, class S = Statistics>
     class MakeMCDiscreteArithmeticAPEngine {
       public:
@@ -182,6 +252,8 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withWorkers(Size workers);
+        MakeMCDiscreteArithmeticAPEngine& withLanes(Size lanes);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -191,6 +263,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size workers_, lanes_;
     };
 
     template <class RNG, class S>
@@ -199,7 +272,8 @@ namespace QuantLib {
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false), controlVariate_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0),
+      workers_(1), lanes_(1) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
@@ -258,6 +332,20 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withLanes(Size lanes) {
+        lanes_ = lanes;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -268,7 +356,9 @@ namespace QuantLib {
                                                 antithetic_, controlVariate_,
                                                 samples_, tolerance_,
                                                 maxSamples_,
-                                                seed_));
+                                                seed_,
+                                                workers_,
+                                                lanes_));
     }
 
 
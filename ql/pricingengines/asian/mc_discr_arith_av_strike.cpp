@@ -49,5 +49,46 @@ namespace QuantLib {
             * PlainVanillaPayoff(type_, averageStrike)(path.back());
     }
 
+
+    ArithmeticASOBatchPricer::ArithmeticASOBatchPricer(Option::Type type,
+                                                       DiscountFactor discount,
+                                                       Real runningSum,
+                                                       Size pastFixings)
+    : type_(type), discount_(discount),
+      runningSum_(runningSum), pastFixings_(pastFixings) {}
+
+
+    Array ArithmeticASOBatchPricer::operator()(
+                                          const MultiPathBatch& paths) const {
+        Size n = paths.pathSize();
+        QL_REQUIRE(n > 1, "the path cannot be empty");
+
+        Size lanes = paths.lanes();
+        Array sum(lanes, runningSum_);
+        Size first, fixings;
+        if (paths.timeGrid().mandatoryTimes()[0]==0.0) {
+            // include initial fixing
+            first = 0;
+            fixings = pastFixings_ + n;
+        } else {
+            first = 1;
+            fixings = pastFixings_ + n - 1;
+        }
+        for (Size i=first; i<n; ++i) {
+            Matrix::const_row_iterator price = paths[i].row_begin(0);
+            for (Size k=0; k<lanes; ++k)
+                sum[k] += price[k];
+        }
+
+        // same as PlainVanillaPayoff(type_, averageStrike)(last)
+        Matrix::const_row_iterator last = paths[n-1].row_begin(0);
+        for (Size k=0; k<lanes; ++k) {
+            Real averageStrike = sum[k]/fixings;
+            sum[k] = discount_
+                * std::max<Real>(type_*(last[k]-averageStrike), 0.0);
+        }
+        return sum;
+    }
+
 }
 
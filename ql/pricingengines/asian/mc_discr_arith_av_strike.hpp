@@ -50,9 +50,15 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size workers = 1,
+             Size lanes = 1);
       protected:
+        typedef
+        typename MCDiscreteAveragingAsianEngine<RNG,S>::batch_pricer_type
+            batch_pricer_type;
         boost::shared_ptr<path_pricer_type> pathPricer() const;
+        boost::shared_ptr<batch_pricer_type> batchPathPricer() const;
     };
 
 
@@ -71,6 +77,23 @@ namespace QuantLib {
     };
 
 
+    //! batch counterpart of ArithmeticASOPathPricer
+    class ArithmeticASOBatchPricer
+        : public PathPricer<MultiPathBatch,Array> {
+      public:
+        ArithmeticASOBatchPricer(Option::Type type,
+                                 DiscountFactor discount,
+                                 Real runningSum = 0.0,
+                                 Size pastFixings = 0);
+        Array operator()(const MultiPathBatch& paths) const;
+      private:
+        Option::Type type_;
+        DiscountFactor discount_;
+        Real runningSum_;
+        Size pastFixings_;
+    };
+
+
 
     // inline definitions
 
@@ -83,7 +106,9 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             Size workers,
+             Size lanes)
     : MCDiscreteAveragingAsianEngine<RNG,S>(process,
                                             brownianBridge,
                                             antitheticVariate,
@@ -91,7 +116,9 @@ namespace QuantLib {
                                             requiredSamples,
                                             requiredTolerance,
                                             maxSamples,
-                                            seed) {}
+                                            seed,
+                                            workers,
+                                            lanes) {}
 
     template <class RNG, class S>
     inline
@@ -119,6 +146,26 @@ namespace QuantLib {
                     this->arguments_.pastFixings));
     }
 
+    template <class RNG, class S>
+    inline
+    boost::shared_ptr<
+              typename MCDiscreteArithmeticASEngine<RNG,S>::batch_pricer_type>
+    MCDiscreteArithmeticASEngine<RNG,S>::batchPathPricer() const {
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        return boost::shared_ptr<batch_pricer_type>(
+                new ArithmeticASOBatchPricer(
+                    payoff->optionType(),
+                    this->process_->riskFreeRate()->discount(
+                                                     this->timeGrid().back()),
+                    this->arguments_.runningAccumulator,
+                    this->arguments_.pastFixings));
+    }
+
 
 
     template <class RNG = PseudoRandom, class S = Statistics>
@@ -133,6 +180,8 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticASEngine& withMaxSamples(Size samples);
         MakeMCDiscreteArithmeticASEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticASEngine& withAntitheticVariate(bool b = true);
+        MakeMCDiscreteArithmeticASEngine& withWorkers(Size workers);
+        MakeMCDiscreteArithmeticASEngine& withLanes(Size lanes);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -142,6 +191,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size workers_, lanes_;
     };
 
     template <class RNG, class S>
@@ -150,7 +200,8 @@ namespace QuantLib {
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0),
+      workers_(1), lanes_(1) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticASEngine<RNG,S>&
@@ -202,6 +253,20 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticASEngine<RNG,S>&
+    MakeMCDiscreteArithmeticASEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticASEngine<RNG,S>&
+    MakeMCDiscreteArithmeticASEngine<RNG,S>::withLanes(Size lanes) {
+        lanes_ = lanes;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticASEngine<RNG,S>::
@@ -212,7 +277,9 @@ namespace QuantLib {
                                                     antithetic_,
                                                     samples_, tolerance_,
                                                     maxSamples_,
-                                                    seed_));
+                                                    seed_,
+                                                    workers_,
+                                                    lanes_));
     }
 
 }
@@ -58,4 +58,37 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+
+    GeometricAPOBatchPricer::GeometricAPOBatchPricer(
+                                         Option::Type type,
+                                         Real strike, DiscountFactor discount,
+                                         Real runningProduct, Size pastFixings)
+    : payoff_(type, strike), discount_(discount),
+      runningLog_(std::log(runningProduct)), pastFixings_(pastFixings) {
+        QL_REQUIRE(strike>=0.0, "negative strike given");
+    }
+
+    Array GeometricAPOBatchPricer::operator()(
+                                          const MultiPathBatch& paths) const {
+        Size n = paths.pathSize() - 1;
+        QL_REQUIRE(n>0, "the path cannot be empty");
+
+        Size lanes = paths.lanes();
+        Array logSum(lanes, runningLog_);
+        Size fixings = n+pastFixings_;
+        Size first = 1;
+        if (paths.timeGrid().mandatoryTimes()[0]==0.0) {
+            fixings += 1;
+            first = 0;
+        }
+        for (Size i=first; i<n+1; i++) {
+            Matrix::const_row_iterator price = paths[i].row_begin(0);
+            for (Size k=0; k<lanes; ++k)
+                logSum[k] += std::log(price[k]);
+        }
+        for (Size k=0; k<lanes; ++k)
+            logSum[k] = discount_ * payoff_(std::exp(logSum[k]/fixings));
+        return logSum;
+    }
+
 }
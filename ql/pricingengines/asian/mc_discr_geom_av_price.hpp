@@ -59,9 +59,15 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size workers = 1,
+             Size lanes = 1);
       protected:
+        typedef
+        typename MCDiscreteAveragingAsianEngine<RNG,S>::batch_pricer_type
+            batch_pricer_type;
         boost::shared_ptr<path_pricer_type> pathPricer() const;
+        boost::shared_ptr<batch_pricer_type> batchPathPricer() const;
     };
 
 
@@ -81,6 +87,28 @@ namespace QuantLib {
     };
 
 
+    //! batch counterpart of GeometricAPOPathPricer
+    /*! The average is calculated as the exponential of the mean of
+        the logarithms of the fixings, which cannot overflow; the
+        results equal those of GeometricAPOPathPricer up to rounding.
+    */
+    class GeometricAPOBatchPricer
+        : public PathPricer<MultiPathBatch,Array> {
+      public:
+        GeometricAPOBatchPricer(Option::Type type,
+                                Real strike,
+                                DiscountFactor discount,
+                                Real runningProduct = 1.0,
+                                Size pastFixings = 0);
+        Array operator()(const MultiPathBatch& paths) const;
+      private:
+        PlainVanillaPayoff payoff_;
+        DiscountFactor discount_;
+        Real runningLog_;
+        Size pastFixings_;
+    };
+
+
     // inline definitions
 
     template <class RNG, class S>
@@ -92,7 +120,9 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             Size workers,
+             Size lanes)
     : MCDiscreteAveragingAsianEngine<RNG,S>(process,
                                             brownianBridge,
                                             antitheticVariate,
@@ -100,7 +130,9 @@ namespace QuantLib {
                                             requiredSamples,
                                             requiredTolerance,
                                             maxSamples,
-                                            seed) {}
+                                            seed,
+                                            workers,
+                                            lanes) {}
 
 
 
@@ -131,6 +163,27 @@ namespace QuantLib {
                     this->arguments_.pastFixings));
     }
 
+    template <class RNG, class S>
+    inline
+    boost::shared_ptr<
+            typename MCDiscreteGeometricAPEngine<RNG,S>::batch_pricer_type>
+        MCDiscreteGeometricAPEngine<RNG,S>::batchPathPricer() const {
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        return boost::shared_ptr<batch_pricer_type>(
+                new GeometricAPOBatchPricer(
+                    payoff->optionType(),
+                    payoff->strike(),
+                    this->process_->riskFreeRate()->discount(
+                                                   this->timeGrid().back()),
+                    this->arguments_.runningAccumulator,
+                    this->arguments_.pastFixings));
+    }
+
 
     template <class RNG = PseudoRandom, class S = Statistics>
     class MakeMCDiscreteGeometricAPEngine {
@@ -144,6 +197,8 @@ namespace QuantLib {
         MakeMCDiscreteGeometricAPEngine& withMaxSamples(Size samples);
         MakeMCDiscreteGeometricAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteGeometricAPEngine& withAntitheticVariate(bool b = true);
+        MakeMCDiscreteGeometricAPEngine& withWorkers(Size workers);
+        MakeMCDiscreteGeometricAPEngine& withLanes(Size lanes);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -153,6 +208,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size workers_, lanes_;
     };
 
     template <class RNG, class S>
@@ -161,7 +217,8 @@ namespace QuantLib {
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0),
+      workers_(1), lanes_(1) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteGeometricAPEngine<RNG,S>&
@@ -213,6 +270,20 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteGeometricAPEngine<RNG,S>&
+    MakeMCDiscreteGeometricAPEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCDiscreteGeometricAPEngine<RNG,S>&
+    MakeMCDiscreteGeometricAPEngine<RNG,S>::withLanes(Size lanes) {
+        lanes_ = lanes;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteGeometricAPEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -223,7 +294,9 @@ namespace QuantLib {
                                                antithetic_,
                                                samples_, tolerance_,
                                                maxSamples_,
-                                               seed_));
+                                               seed_,
+                                               workers_,
+                                               lanes_));
     }
 
 }
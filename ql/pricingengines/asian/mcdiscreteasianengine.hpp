@@ -27,13 +27,26 @@
 #define quantlib_mcdiscreteasian_engine_hpp
 
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/methods/montecarlo/multipathbatchgenerator.hpp>
 #include <ql/instruments/asianoption.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/exercise.hpp>
 
 namespace QuantLib {
 
     //! Pricing engine for discrete average Asians using Monte Carlo simulation
-    /*! \warning control-variate calculation is disabled under VC++6.
+    /*! When a number of lanes larger than one is given, the paths
+        are generated in batches by a MultiPathBatchGenerator and
+        priced together by the pricer returned by batchPathPricer();
+        the batches are split among the workers, if any.  Engines
+        that don't provide a batch pricer can only be used with a
+        single lane.
+
+        The price of the control variate is cached and only
+        recalculated when the process or the relevant arguments
+        change.
+
+        \warning control-variate calculation is disabled under VC++6.
 
         \ingroup asianengines
     */
@@ -49,6 +62,9 @@ namespace QuantLib {
             path_pricer_type;
         typedef typename McSimulation<SingleVariate,RNG,S>::stats_type
             stats_type;
+        typedef MultiPathBatchGenerator<typename RNG::rsg_type>
+            batch_generator_type;
+        typedef PathPricer<MultiPathBatch,Array> batch_pricer_type;
         // constructor
         MCDiscreteAveragingAsianEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
@@ -58,8 +74,12 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size workers = 1,
+             Size lanes = 1);
         void calculate() const {
+            if (lanes_ > 1)
+                initializeBatches();
             McSimulation<SingleVariate,RNG,S>::calculate(requiredTolerance_,
                                                          requiredSamples_,
                                                          maxSamples_);
@@ -75,25 +95,64 @@ namespace QuantLib {
             results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
         }
+        void update();
       protected:
         // McSimulation implementation
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_generator_type> pathGenerator() const {
+            return pathGenerator(seed_);
+        }
+        boost::shared_ptr<path_generator_type>
+        workerPathGenerator(Size worker) const {
+            // in batch mode, the workers use batch generators instead
+            if (lanes_ > 1)
+                return boost::shared_ptr<path_generator_type>();
+            return pathGenerator(this->workerSeed(seed_, worker));
+        }
+        boost::shared_ptr<path_generator_type>
+        pathGenerator(BigNatural seed) const {
 
             TimeGrid grid = this->timeGrid();
             typename RNG::rsg_type gen =
-                RNG::make_sequence_generator(grid.size()-1,seed_);
+                RNG::make_sequence_generator(grid.size()-1,seed);
             return boost::shared_ptr<path_generator_type>(
                          new path_generator_type(process_, grid,
                                                  gen, brownianBridge_));
         }
         Real controlVariateValue() const;
+        void addSamples(Size samples) const;
+        //! pricer of the lanes of a batch of paths
+        /*! Engines supporting batch simulation must return a pricer
+            giving the same results as pathPricer() on each lane.
+        */
+        virtual boost::shared_ptr<batch_pricer_type> batchPathPricer() const {
+            return boost::shared_ptr<batch_pricer_type>();
+        }
+        //! batch counterpart of controlPathPricer()
+        virtual boost::shared_ptr<batch_pricer_type>
+        controlBatchPathPricer() const {
+            return boost::shared_ptr<batch_pricer_type>();
+        }
         // data members
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size requiredSamples_, maxSamples_;
         Real requiredTolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size lanes_;
+      private:
+        void initializeBatches() const;
+        void drawBatches(Size worker, Size samples,
+                         std::vector<std::pair<Real,Real> >& values) const;
+        bool sameControlArguments() const;
+        mutable std::vector<boost::shared_ptr<batch_generator_type> >
+                                                          batchGenerators_;
+        mutable std::vector<boost::shared_ptr<batch_pricer_type> >
+                                            batchPricers_, controlPricers_;
+        mutable Real batchControlValue_;
+        mutable boost::shared_ptr<PricingEngine> controlEngine_;
+        mutable DiscreteAveragingAsianOption::arguments controlArguments_;
+        mutable Real controlValue_;
     };
 
 
@@ -109,14 +168,25 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
-    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, controlVariate),
+             BigNatural seed,
+             Size workers,
+             Size lanes)
+    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, controlVariate,
+                                        workers),
       process_(process), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      brownianBridge_(brownianBridge), seed_(seed), lanes_(lanes),
+      controlValue_(Null<Real>()) {
+        QL_REQUIRE(lanes_ > 0, "at least one lane required");
         registerWith(process_);
     }
 
+    template<class RNG, class S>
+    inline void MCDiscreteAveragingAsianEngine<RNG,S>::update() {
+        controlValue_ = Null<Real>();
+        DiscreteAveragingAsianOption::engine::update();
+    }
+
     template <class RNG, class S>
     inline TimeGrid MCDiscreteAveragingAsianEngine<RNG,S>::timeGrid() const {
 
@@ -139,23 +209,173 @@ namespace QuantLib {
     inline
     Real MCDiscreteAveragingAsianEngine<RNG,S>::controlVariateValue() const {
 
-        boost::shared_ptr<PricingEngine> controlPE =
-                this->controlPricingEngine();
-            QL_REQUIRE(controlPE,
+        if (controlValue_ != Null<Real>() && sameControlArguments())
+            return controlValue_;
+
+        if (!controlEngine_) {
+            controlEngine_ = this->controlPricingEngine();
+            QL_REQUIRE(controlEngine_,
                        "engine does not provide "
                        "control variation pricing engine");
+        }
+
+        DiscreteAveragingAsianOption::arguments* controlArguments =
+            dynamic_cast<DiscreteAveragingAsianOption::arguments*>(
+                controlEngine_->getArguments());
+        *controlArguments = arguments_;
+        controlEngine_->reset();
+        controlEngine_->calculate();
+
+        const DiscreteAveragingAsianOption::results* controlResults =
+            dynamic_cast<const DiscreteAveragingAsianOption::results*>(
+                controlEngine_->getResults());
+
+        controlArguments_ = arguments_;
+        controlValue_ = controlResults->value;
+        return controlValue_;
+    }
+
+    template<class RNG, class S>
+    inline
+    bool MCDiscreteAveragingAsianEngine<RNG,S>::sameControlArguments() const {
+        const DiscreteAveragingAsianOption::arguments& a = arguments_;
+        const DiscreteAveragingAsianOption::arguments& c = controlArguments_;
+        if (a.averageType != c.averageType
+            || a.runningAccumulator != c.runningAccumulator
+            || a.pastFixings != c.pastFixings
+            || a.fixingDates != c.fixingDates)
+            return false;
+
+        boost::shared_ptr<StrikedTypePayoff> p1 =
+            boost::dynamic_pointer_cast<StrikedTypePayoff>(a.payoff);
+        boost::shared_ptr<StrikedTypePayoff> p2 =
+            boost::dynamic_pointer_cast<StrikedTypePayoff>(c.payoff);
+        if (!p1 || !p2
+            || p1->name() != p2->name()
+            || p1->optionType() != p2->optionType()
+            || p1->strike() != p2->strike())
+            return false;
+
+        return a.exercise && c.exercise
+            && a.exercise->type() == c.exercise->type()
+            && a.exercise->dates() == c.exercise->dates();
+    }
+
+    template<class RNG, class S>
+    inline
+    void MCDiscreteAveragingAsianEngine<RNG,S>::initializeBatches() const {
+
+        batchGenerators_.clear();
+        batchPricers_.clear();
+        controlPricers_.clear();
+
+        // low-discrepancy sequences can't be split by reseeding
+        Size n = RNG::allowsErrorEstimate ? this->workers_ : 1;
+        TimeGrid grid = this->timeGrid();
+        for (Size i=0; i<n; ++i) {
+            typename RNG::rsg_type gen =
+                RNG::make_sequence_generator(grid.size()-1,
+                                             this->workerSeed(seed_, i));
+            batchGenerators_.push_back(
+                boost::shared_ptr<batch_generator_type>(
+                    new batch_generator_type(process_, grid, gen,
+                                             lanes_, brownianBridge_)));
 
-            DiscreteAveragingAsianOption::arguments* controlArguments =
-                dynamic_cast<DiscreteAveragingAsianOption::arguments*>(
-                    controlPE->getArguments());
-            *controlArguments = arguments_;
-            controlPE->calculate();
+            boost::shared_ptr<batch_pricer_type> pricer =
+                this->batchPathPricer();
+            QL_REQUIRE(pricer,
+                       "engine does not support batch simulation");
+            batchPricers_.push_back(pricer);
 
-            const DiscreteAveragingAsianOption::results* controlResults =
-                dynamic_cast<const DiscreteAveragingAsianOption::results*>(
-                    controlPE->getResults());
+            if (this->controlVariate_) {
+                boost::shared_ptr<batch_pricer_type> controlPricer =
+                    this->controlBatchPathPricer();
+                QL_REQUIRE(controlPricer,
+                           "engine does not provide "
+                           "control-variation batch pricer");
+                controlPricers_.push_back(controlPricer);
+            }
+        }
+
+        if (this->controlVariate_)
+            batchControlValue_ = controlVariateValue();
+    }
+
+    template<class RNG, class S>
+    inline
+    void MCDiscreteAveragingAsianEngine<RNG,S>::addSamples(
+                                                        Size samples) const {
+
+        if (lanes_ == 1) {
+            McSimulation<SingleVariate,RNG,S>::addSamples(samples);
+            return;
+        }
+
+        Size n = batchGenerators_.size();
+        std::vector<std::vector<std::pair<Real,Real> > > values(n);
+        std::vector<std::string> errors(n);
+        std::vector<int> failed(n, 0);
+
+        #pragma omp parallel for num_threads(n) schedule(static)
+        for (Size i=0; i<n; ++i) {
+            Size batch = samples/n + (i < samples%n ? 1 : 0);
+            try {
+                drawBatches(i, batch, values[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+                failed[i] = 1;
+            } catch (...) {
+                errors[i] = "unknown error";
+                failed[i] = 1;
+            }
+        }
 
-            return controlResults->value;
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(!failed[i],
+                       "worker " << i << " failed: " << errors[i]);
+
+        for (Size i=0; i<n; ++i)
+            this->mcModel_->addSampleValues(values[i]);
+    }
+
+    template<class RNG, class S>
+    inline
+    void MCDiscreteAveragingAsianEngine<RNG,S>::drawBatches(
+                         Size worker, Size samples,
+                         std::vector<std::pair<Real,Real> >& values) const {
+
+        const batch_generator_type& generator = *batchGenerators_[worker];
+        const batch_pricer_type& pricer = *batchPricers_[worker];
+
+        // same calculations as MonteCarloModel, lane by lane; the
+        // lanes exceeding the required samples are discarded.
+        values.reserve(values.size()+samples);
+        while (samples > 0) {
+            const MultiPathBatch& paths = generator.next();
+            Array prices = pricer(paths);
+            if (this->controlVariate_) {
+                Array controls = (*controlPricers_[worker])(paths);
+                for (Size k=0; k<lanes_; ++k)
+                    prices[k] += batchControlValue_ - controls[k];
+            }
+
+            if (this->antitheticVariate_) {
+                const MultiPathBatch& antiPaths = generator.antithetic();
+                Array prices2 = pricer(antiPaths);
+                if (this->controlVariate_) {
+                    Array controls = (*controlPricers_[worker])(antiPaths);
+                    for (Size k=0; k<lanes_; ++k)
+                        prices2[k] += batchControlValue_ - controls[k];
+                }
+                for (Size k=0; k<lanes_; ++k)
+                    prices[k] = (prices[k]+prices2[k])/2.0;
+            }
+
+            Size m = std::min(lanes_, samples);
+            for (Size k=0; k<m; ++k)
+                values.push_back(std::make_pair(prices[k], paths.weight(k)));
+            samples -= m;
+        }
     }
 
 }
@@ -26,6 +26,106 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // terms of the formulas in Haug's book
+        class BarrierFormula {
+          public:
+            BarrierFormula(Real strike, Real barrier, Real rebate,
+                           Real spot, Volatility volatility,
+                           Time residualTime,
+                           DiscountFactor riskFreeDiscount,
+                           DiscountFactor dividendDiscount)
+            : strike_(strike), barrier_(barrier), rebate_(rebate),
+              spot_(spot), volatility_(volatility),
+              stdDev_(volatility*std::sqrt(residualTime)),
+              riskFreeDiscount_(riskFreeDiscount),
+              dividendDiscount_(dividendDiscount) {
+                // same as the continuous zero rates of the curves
+                riskFreeRate_ = std::log(1.0/riskFreeDiscount)/residualTime;
+                Rate dividendYield =
+                    std::log(1.0/dividendDiscount)/residualTime;
+                mu_ = (riskFreeRate_ - dividendYield)
+                    / (volatility*volatility) - 0.5;
+                muSigma_ = (1 + mu_) * stdDev_;
+            }
+            Real A(Real phi) const {
+                Real x1 = std::log(spot_/strike_)/stdDev_ + muSigma_;
+                Real N1 = f_(phi*x1);
+                Real N2 = f_(phi*(x1-stdDev_));
+                return phi*(spot_ * dividendDiscount_ * N1
+                            - strike_ * riskFreeDiscount_ * N2);
+            }
+            Real B(Real phi) const {
+                Real x2 = std::log(spot_/barrier_)/stdDev_ + muSigma_;
+                Real N1 = f_(phi*x2);
+                Real N2 = f_(phi*(x2-stdDev_));
+                return phi*(spot_ * dividendDiscount_ * N1
+                            - strike_ * riskFreeDiscount_ * N2);
+            }
+            Real C(Real eta, Real phi) const {
+                Real HS = barrier_/spot_;
+                Real powHS0 = std::pow(HS, 2 * mu_);
+                Real powHS1 = powHS0 * HS * HS;
+                Real y1 = std::log(barrier_*HS/strike_)/stdDev_ + muSigma_;
+                Real N1 = f_(eta*y1);
+                Real N2 = f_(eta*(y1-stdDev_));
+                return phi*(spot_ * dividendDiscount_ * powHS1 * N1
+                            - strike_ * riskFreeDiscount_ * powHS0 * N2);
+            }
+            Real D(Real eta, Real phi) const {
+                Real HS = barrier_/spot_;
+                Real powHS0 = std::pow(HS, 2 * mu_);
+                Real powHS1 = powHS0 * HS * HS;
+                Real y2 = std::log(barrier_/spot_)/stdDev_ + muSigma_;
+                Real N1 = f_(eta*y2);
+                Real N2 = f_(eta*(y2-stdDev_));
+                return phi*(spot_ * dividendDiscount_ * powHS1 * N1
+                            - strike_ * riskFreeDiscount_ * powHS0 * N2);
+            }
+            Real E(Real eta) const {
+                if (rebate_ > 0) {
+                    Real powHS0 = std::pow(barrier_/spot_, 2 * mu_);
+                    Real x2 = std::log(spot_/barrier_)/stdDev_ + muSigma_;
+                    Real y2 = std::log(barrier_/spot_)/stdDev_ + muSigma_;
+                    Real N1 = f_(eta*(x2 - stdDev_));
+                    Real N2 = f_(eta*(y2 - stdDev_));
+                    return rebate_ * riskFreeDiscount_ * (N1 - powHS0 * N2);
+                } else {
+                    return 0.0;
+                }
+            }
+            Real F(Real eta) const {
+                if (rebate_ > 0) {
+                    Real lambda =
+                        std::sqrt(mu_*mu_ + 2.0*riskFreeRate_
+                                            /(volatility_*volatility_));
+                    Real HS = barrier_/spot_;
+                    Real powHSplus = std::pow(HS, mu_ + lambda);
+                    Real powHSminus = std::pow(HS, mu_ - lambda);
+
+                    Real z = std::log(barrier_/spot_)/stdDev_
+                        + lambda * stdDev_;
+
+                    Real N1 = f_(eta * z);
+                    Real N2 = f_(eta * (z - 2.0 * lambda * stdDev_));
+                    return rebate_ * (powHSplus * N1 + powHSminus * N2);
+                } else {
+                    return 0.0;
+                }
+            }
+          private:
+            Real strike_, barrier_, rebate_, spot_;
+            Volatility volatility_;
+            Real stdDev_;
+            DiscountFactor riskFreeDiscount_, dividendDiscount_;
+            Rate riskFreeRate_;
+            Real mu_, muSigma_;
+            CumulativeNormalDistribution f_;
+        };
+
+    }
+
     AnalyticBarrierEngine::AnalyticBarrierEngine(
             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process) {
@@ -45,204 +145,85 @@ namespace QuantLib {
         QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
         QL_REQUIRE(!triggered(spot), "barrier touched");
 
-        Barrier::Type barrierType = arguments_.barrierType;
+        Time residualTime = process_->time(arguments_.exercise->lastDate());
+        results_.value = analyticBarrierValue(
+            arguments_.barrierType, payoff->optionType(), strike,
+            arguments_.barrier, arguments_.rebate, spot,
+            process_->blackVolatility()->blackVol(residualTime, strike),
+            residualTime,
+            process_->riskFreeRate()->discount(residualTime),
+            process_->dividendYield()->discount(residualTime));
+    }
+
 
-        switch (payoff->optionType()) {
+    Real analyticBarrierValue(Barrier::Type barrierType,
+                              Option::Type type,
+                              Real strike,
+                              Real barrier,
+                              Real rebate,
+                              Real spot,
+                              Volatility volatility,
+                              Time residualTime,
+                              DiscountFactor riskFreeDiscount,
+                              DiscountFactor dividendDiscount) {
+
+        BarrierFormula f(strike, barrier, rebate, spot, volatility,
+                         residualTime, riskFreeDiscount, dividendDiscount);
+
+        switch (type) {
           case Option::Call:
             switch (barrierType) {
               case Barrier::DownIn:
-                if (strike >= barrier())
-                    results_.value = C(1,1) + E(1);
+                if (strike >= barrier)
+                    return f.C(1,1) + f.E(1);
                 else
-                    results_.value = A(1) - B(1) + D(1,1) + E(1);
-                break;
+                    return f.A(1) - f.B(1) + f.D(1,1) + f.E(1);
               case Barrier::UpIn:
-                if (strike >= barrier())
-                    results_.value = A(1) + E(-1);
+                if (strike >= barrier)
+                    return f.A(1) + f.E(-1);
                 else
-                    results_.value = B(1) - C(-1,1) + D(-1,1) + E(-1);
-                break;
+                    return f.B(1) - f.C(-1,1) + f.D(-1,1) + f.E(-1);
               case Barrier::DownOut:
-                if (strike >= barrier())
-                    results_.value = A(1) - C(1,1) + F(1);
+                if (strike >= barrier)
+                    return f.A(1) - f.C(1,1) + f.F(1);
                 else
-                    results_.value = B(1) - D(1,1) + F(1);
-                break;
+                    return f.B(1) - f.D(1,1) + f.F(1);
               case Barrier::UpOut:
-                if (strike >= barrier())
-                    results_.value = F(-1);
+                if (strike >= barrier)
+                    return f.F(-1);
                 else
-                    results_.value = A(1) - B(1) + C(-1,1) - D(-1,1) + F(-1);
-                break;
+                    return f.A(1) - f.B(1) + f.C(-1,1) - f.D(-1,1) + f.F(-1);
+              default:
+                QL_FAIL("unknown barrier type");
             }
-            break;
           case Option::Put:
             switch (barrierType) {
               case Barrier::DownIn:
-                if (strike >= barrier())
-                    results_.value = B(-1) - C(1,-1) + D(1,-1) + E(1);
+                if (strike >= barrier)
+                    return f.B(-1) - f.C(1,-1) + f.D(1,-1) + f.E(1);
                 else
-                    results_.value = A(-1) + E(1);
-                break;
+                    return f.A(-1) + f.E(1);
               case Barrier::UpIn:
-                if (strike >= barrier())
-                    results_.value = A(-1) - B(-1) + D(-1,-1) + E(-1);
+                if (strike >= barrier)
+                    return f.A(-1) - f.B(-1) + f.D(-1,-1) + f.E(-1);
                 else
-                    results_.value = C(-1,-1) + E(-1);
-                break;
+                    return f.C(-1,-1) + f.E(-1);
               case Barrier::DownOut:
-                if (strike >= barrier())
-                    results_.value = A(-1) - B(-1) + C(1,-1) - D(1,-1) + F(1);
+                if (strike >= barrier)
+                    return f.A(-1) - f.B(-1) + f.C(1,-1) - f.D(1,-1) + f.F(1);
                 else
-                    results_.value = F(1);
-                break;
+                    return f.F(1);
               case Barrier::UpOut:
-                if (strike >= barrier())
-                    results_.value = B(-1) - D(-1,-1) + F(-1);
+                if (strike >= barrier)
+                    return f.B(-1) - f.D(-1,-1) + f.F(-1);
                 else
-                    results_.value = A(-1) - C(-1,-1) + F(-1);
-                break;
+                    return f.A(-1) - f.C(-1,-1) + f.F(-1);
+              default:
+                QL_FAIL("unknown barrier type");
             }
-            break;
           default:
             QL_FAIL("unknown type");
         }
     }
 
-
-    Real AnalyticBarrierEngine::underlying() const {
-        return process_->x0();
-    }
-
-    Real AnalyticBarrierEngine::strike() const {
-        boost::shared_ptr<PlainVanillaPayoff> payoff =
-            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
-        QL_REQUIRE(payoff, "non-plain payoff given");
-        return payoff->strike();
-    }
-
-    Time AnalyticBarrierEngine::residualTime() const {
-        return process_->time(arguments_.exercise->lastDate());
-    }
-
-    Volatility AnalyticBarrierEngine::volatility() const {
-        return process_->blackVolatility()->blackVol(residualTime(), strike());
-    }
-
-    Real AnalyticBarrierEngine::stdDeviation() const {
-        return volatility() * std::sqrt(residualTime());
-    }
-
-    Real AnalyticBarrierEngine::barrier() const {
-        return arguments_.barrier;
-    }
-
-    Real AnalyticBarrierEngine::rebate() const {
-        return arguments_.rebate;
-    }
-
-    Rate AnalyticBarrierEngine::riskFreeRate() const {
-        return process_->riskFreeRate()->zeroRate(residualTime(), Continuous,
-                                                  NoFrequency);
-    }
-
-    DiscountFactor AnalyticBarrierEngine::riskFreeDiscount() const {
-        return process_->riskFreeRate()->discount(residualTime());
-    }
-
-    Rate AnalyticBarrierEngine::dividendYield() const {
-        return process_->dividendYield()->zeroRate(residualTime(),
-                                                   Continuous, NoFrequency);
-    }
-
-    DiscountFactor AnalyticBarrierEngine::dividendDiscount() const {
-        return process_->dividendYield()->discount(residualTime());
-    }
-
-    Rate AnalyticBarrierEngine::mu() const {
-        Volatility vol = volatility();
-        return (riskFreeRate() - dividendYield())/(vol * vol) - 0.5;
-    }
-
-    Real AnalyticBarrierEngine::muSigma() const {
-        return (1 + mu()) * stdDeviation();
-    }
-
-    Real AnalyticBarrierEngine::A(Real phi) const {
-        Real x1 =
-            std::log(underlying()/strike())/stdDeviation() + muSigma();
-        Real N1 = f_(phi*x1);
-        Real N2 = f_(phi*(x1-stdDeviation()));
-        return phi*(underlying() * dividendDiscount() * N1
-                    - strike() * riskFreeDiscount() * N2);
-    }
-
-    Real AnalyticBarrierEngine::B(Real phi) const {
-        Real x2 =
-            std::log(underlying()/barrier())/stdDeviation() + muSigma();
-        Real N1 = f_(phi*x2);
-        Real N2 = f_(phi*(x2-stdDeviation()));
-        return phi*(underlying() * dividendDiscount() * N1
-                    - strike() * riskFreeDiscount() * N2);
-    }
-
-    Real AnalyticBarrierEngine::C(Real eta, Real phi) const {
-        Real HS = barrier()/underlying();
-        Real powHS0 = std::pow(HS, 2 * mu());
-        Real powHS1 = powHS0 * HS * HS;
-        Real y1 = std::log(barrier()*HS/strike())/stdDeviation() + muSigma();
-        Real N1 = f_(eta*y1);
-        Real N2 = f_(eta*(y1-stdDeviation()));
-        return phi*(underlying() * dividendDiscount() * powHS1 * N1
-                    - strike() * riskFreeDiscount() * powHS0 * N2);
-    }
-
-    Real AnalyticBarrierEngine::D(Real eta, Real phi) const {
-        Real HS = barrier()/underlying();
-        Real powHS0 = std::pow(HS, 2 * mu());
-        Real powHS1 = powHS0 * HS * HS;
-        Real y2 = std::log(barrier()/underlying())/stdDeviation() + muSigma();
-        Real N1 = f_(eta*y2);
-        Real N2 = f_(eta*(y2-stdDeviation()));
-        return phi*(underlying() * dividendDiscount() * powHS1 * N1
-                    - strike() * riskFreeDiscount() * powHS0 * N2);
-    }
-
-    Real AnalyticBarrierEngine::E(Real eta) const {
-        if (rebate() > 0) {
-            Real powHS0 = std::pow(barrier()/underlying(), 2 * mu());
-            Real x2 =
-                std::log(underlying()/barrier())/stdDeviation() + muSigma();
-            Real y2 =
-                std::log(barrier()/underlying())/stdDeviation() + muSigma();
-            Real N1 = f_(eta*(x2 - stdDeviation()));
-            Real N2 = f_(eta*(y2 - stdDeviation()));
-            return rebate() * riskFreeDiscount() * (N1 - powHS0 * N2);
-        } else {
-            return 0.0;
-        }
-    }
-
-    Real AnalyticBarrierEngine::F(Real eta) const {
-        if (rebate() > 0) {
-            Rate m = mu();
-            Volatility vol = volatility();
-            Real lambda = std::sqrt(m*m + 2.0*riskFreeRate()/(vol * vol));
-            Real HS = barrier()/underlying();
-            Real powHSplus = std::pow(HS, m + lambda);
-            Real powHSminus = std::pow(HS, m - lambda);
-
-            Real sigmaSqrtT = stdDeviation();
-            Real z = std::log(barrier()/underlying())/sigmaSqrtT
-                + lambda * sigmaSqrtT;
-
-            Real N1 = f_(eta * z);
-            Real N2 = f_(eta * (z - 2.0 * lambda * sigmaSqrtT));
-            return rebate() * (powHSplus * N1 + powHSminus * N2);
-        } else {
-            return 0.0;
-        }
-    }
-
 }
-
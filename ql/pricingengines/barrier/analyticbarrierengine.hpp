@@ -50,29 +50,27 @@ namespace QuantLib {
         void calculate() const;
       private:
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
-        CumulativeNormalDistribution f_;
-        // helper methods
-        Real underlying() const;
-        Real strike() const;
-        Time residualTime() const;
-        Volatility volatility() const;
-        Real barrier() const;
-        Real rebate() const;
-        Real stdDeviation() const;
-        Rate riskFreeRate() const;
-        DiscountFactor riskFreeDiscount() const;
-        Rate dividendYield() const;
-        DiscountFactor dividendDiscount() const;
-        Rate mu() const;
-        Real muSigma() const;
-        Real A(Real phi) const;
-        Real B(Real phi) const;
-        Real C(Real eta, Real phi) const;
-        Real D(Real eta, Real phi) const;
-        Real E(Real eta) const;
-        Real F(Real eta) const;
     };
 
+
+    //! value of a barrier option given its market data
+    /*! This is the formula used by AnalyticBarrierEngine; it allows
+        engines pricing many barrier options on the same market data
+        to skip building instruments and processes for each of them.
+        The rates are the ones implied by the discount factors with
+        continuous compounding.
+    */
+    Real analyticBarrierValue(Barrier::Type barrierType,
+                              Option::Type type,
+                              Real strike,
+                              Real barrier,
+                              Real rebate,
+                              Real spot,
+                              Volatility volatility,
+                              Time residualTime,
+                              DiscountFactor riskFreeDiscount,
+                              DiscountFactor dividendDiscount);
+
 }
 
 
@@ -248,4 +248,93 @@ namespace QuantLib {
         }
     }
 
+
+    BarrierFamilyPathPricer::BarrierFamilyPathPricer(
+                    const std::vector<BarrierOptionTerms>& family,
+                    const std::vector<DiscountFactor>& discounts,
+                    const boost::shared_ptr<StochasticProcess1D>& diffProcess,
+                    const PseudoRandom::ursg_type& sequenceGen,
+                    bool isBiased)
+    : family_(family), discounts_(discounts), diffProcess_(diffProcess),
+      sequenceGen_(sequenceGen), isBiased_(isBiased),
+      logs_(discounts.size()), thresholds_(discounts.size()-1, 0.0) {
+        QL_REQUIRE(!family_.empty(), "no options given");
+        for (Size j=0; j<family_.size(); ++j) {
+            QL_REQUIRE(family_[j].strike>=0.0,
+                       "strike less than zero not allowed");
+            QL_REQUIRE(family_[j].barrier>0.0,
+                       "barrier less/equal zero not allowed");
+            payoffs_.push_back(PlainVanillaPayoff(family_[j].type,
+                                                  family_[j].strike));
+            logBarriers_.push_back(std::log(family_[j].barrier));
+        }
+    }
+
+
+    Array BarrierFamilyPathPricer::operator()(const Path& path) const {
+        static Size null = Null<Size>();
+        Size n = path.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+        QL_REQUIRE(n == logs_.size(), "wrong path length");
+
+        // quantities shared by all the options
+        for (Size i=0; i<n; i++)
+            logs_[i] = std::log(path[i]);
+        if (!isBiased_) {
+            const TimeGrid& timeGrid = path.timeGrid();
+            const std::vector<Real>& u = sequenceGen_.nextSequence().value;
+            for (Size i=0; i<n-1; i++) {
+                // terminal or initial vol?
+                Volatility vol = diffProcess_->diffusion(timeGrid[i],
+                                                         path[i]);
+                thresholds_[i] = -0.5*vol*vol*timeGrid.dt(i)*std::log(u[i]);
+            }
+        }
+
+        Array values(family_.size());
+        for (Size j=0; j<family_.size(); j++) {
+            const BarrierOptionTerms& terms = family_[j];
+            const Real logBarrier = logBarriers_[j];
+            bool down = (terms.barrierType == Barrier::DownIn ||
+                         terms.barrierType == Barrier::DownOut);
+
+            // the barrier is crossed at the first fixing where it's
+            // touched, or in the preceding step with the probability
+            // given by the bridge
+            Size knockNode = null;
+            Real d0 = logs_[0] - logBarrier;
+            for (Size i=0; i<n-1; i++) {
+                Real d1 = logs_[i+1] - logBarrier;
+                if ((down ? d1 <= 0.0 : d1 >= 0.0)
+                    || d0*d1 < thresholds_[i]) {
+                    knockNode = i+1;
+                    break;
+                }
+                d0 = d1;
+            }
+
+            bool isOptionActive;
+            switch (terms.barrierType) {
+              case Barrier::DownIn:
+              case Barrier::UpIn:
+                isOptionActive = (knockNode != null);
+                break;
+              case Barrier::DownOut:
+              case Barrier::UpOut:
+                isOptionActive = (knockNode == null);
+                break;
+              default:
+                QL_FAIL("unknown barrier type");
+            }
+
+            if (isOptionActive)
+                values[j] = payoffs_[j](path.back()) * discounts_.back();
+            else if (knockNode == null)
+                values[j] = terms.rebate * discounts_.back();
+            else
+                values[j] = terms.rebate * discounts_[knockNode];
+        }
+        return values;
+    }
+
 }
@@ -29,10 +29,26 @@
 #include <ql/instruments/barrieroption.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/exercise.hpp>
 
 namespace QuantLib {
 
+    //! terms of a barrier option in a family priced on the same paths
+    struct BarrierOptionTerms {
+        BarrierOptionTerms(Barrier::Type barrierType,
+                           Real barrier,
+                           Real rebate,
+                           Option::Type type,
+                           Real strike)
+        : barrierType(barrierType), barrier(barrier), rebate(rebate),
+          type(type), strike(strike) {}
+        Barrier::Type barrierType;
+        Real barrier, rebate;
+        Option::Type type;
+        Real strike;
+    };
+
     //! Pricing engine for barrier options using Monte Carlo simulation
     /*! Uses the Brownian-bridge correction for the barrier found in
         <i>
@@ -47,6 +63,13 @@ namespace QuantLib {
         Journal of Derivatives; Winter 1998; 6, 2; pg. 65-83
         </i>
 
+        If a family of barrier options is passed, the engine prices
+        all of them on the same paths the first time any of them is
+        calculated, and returns the stored results for the others
+        until the process changes or an option with a different
+        maturity is calculated.  The option being priced must be one
+        of the family, and a number of samples must be given.
+
         \ingroup barrierengines
 
         \test the correctness of the returned value is tested by
@@ -74,11 +97,18 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed);
+             BigNatural seed,
+             Size workers = 1,
+             const std::vector<BarrierOptionTerms>& family =
+                                          std::vector<BarrierOptionTerms>());
         void calculate() const {
             Real spot = process_->x0();
             QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
             QL_REQUIRE(!triggered(spot), "barrier touched");
+            if (!family_.empty()) {
+                calculateFamily();
+                return;
+            }
             McSimulation<SingleVariate,RNG,S>::calculate(requiredTolerance_,
                                                          requiredSamples_,
                                                          maxSamples_);
@@ -87,18 +117,35 @@ namespace QuantLib {
             results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
         }
+        void update();
       protected:
         // McSimulation implementation
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_generator_type> pathGenerator() const {
+            return pathGenerator(seed_);
+        }
+        boost::shared_ptr<path_generator_type>
+        workerPathGenerator(Size worker) const {
+            return pathGenerator(this->workerSeed(seed_, worker));
+        }
+        boost::shared_ptr<path_generator_type>
+        pathGenerator(BigNatural seed) const {
             TimeGrid grid = timeGrid();
             typename RNG::rsg_type gen =
-                RNG::make_sequence_generator(grid.size()-1,seed_);
+                RNG::make_sequence_generator(grid.size()-1,seed);
             return boost::shared_ptr<path_generator_type>(
                          new path_generator_type(process_,
                                                  grid, gen, brownianBridge_));
         }
-        boost::shared_ptr<path_pricer_type> pathPricer() const;
+        boost::shared_ptr<path_pricer_type> pathPricer() const {
+            return pathPricer(5);
+        }
+        boost::shared_ptr<path_pricer_type>
+        workerPathPricer(Size worker) const {
+            return pathPricer(this->workerSeed(5, worker));
+        }
+        boost::shared_ptr<path_pricer_type>
+        pathPricer(BigNatural bridgeSeed) const;
         // data members
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
@@ -107,6 +154,14 @@ namespace QuantLib {
         bool isBiased_;
         bool brownianBridge_;
         BigNatural seed_;
+        std::vector<BarrierOptionTerms> family_;
+      private:
+        void calculateFamily() const;
+        void simulateFamily() const;
+        boost::shared_ptr<PathPricer<Path,Array> >
+        familyPathPricer(BigNatural bridgeSeed) const;
+        mutable Date familyMaturity_;
+        mutable std::vector<Real> familyValues_, familyErrors_;
     };
 
 
@@ -126,6 +181,9 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withWorkers(Size workers);
+        MakeMCBarrierEngine& withFamily(
+                               const std::vector<BarrierOptionTerms>& family);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -134,6 +192,8 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size workers_;
+        std::vector<BarrierOptionTerms> family_;
     };
 
 
@@ -178,6 +238,45 @@ namespace QuantLib {
     };
 
 
+    //! prices a family of barrier options on each path
+    /*! The quantities depending on the path only (the logarithms of
+        the asset values and, unless the pricer is biased, the
+        thresholds for the crossing of the barrier between the
+        fixings) are calculated once for all the options.  A barrier
+        is crossed between \f$ t_i \f$ and \f$ t_{i+1} \f$ with
+        probability
+        \f[
+        p = \exp\left(-\frac{2 \ln(S_i/B) \ln(S_{i+1}/B)}
+                              {\sigma^2 \Delta t}\right)
+        \f]
+        so that, given a uniform deviate \f$ u \f$ shared by all
+        the options, the crossing reduces to comparing the product
+        of the logarithms with \f$ -\sigma^2 \Delta t \ln(u)/2 \f$.
+        This is the same Brownian-bridge correction used by
+        BarrierPathPricer, expressed in terms of the probability
+        instead of the extremum.
+    */
+    class BarrierFamilyPathPricer : public PathPricer<Path,Array> {
+      public:
+        BarrierFamilyPathPricer(
+                    const std::vector<BarrierOptionTerms>& family,
+                    const std::vector<DiscountFactor>& discounts,
+                    const boost::shared_ptr<StochasticProcess1D>& diffProcess,
+                    const PseudoRandom::ursg_type& sequenceGen,
+                    bool isBiased);
+        Array operator()(const Path& path) const;
+      private:
+        std::vector<BarrierOptionTerms> family_;
+        std::vector<PlainVanillaPayoff> payoffs_;
+        std::vector<Real> logBarriers_;
+        std::vector<DiscountFactor> discounts_;
+        boost::shared_ptr<StochasticProcess1D> diffProcess_;
+        PseudoRandom::ursg_type sequenceGen_;
+        bool isBiased_;
+        mutable std::vector<Real> logs_, thresholds_;
+    };
+
+
 
     // template definitions
 
@@ -192,14 +291,16 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed)
-    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, false),
+             BigNatural seed,
+             Size workers,
+             const std::vector<BarrierOptionTerms>& family)
+    : McSimulation<SingleVariate,RNG,S>(antitheticVariate, false, workers),
       process_(process), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
       requiredTolerance_(requiredTolerance),
       isBiased_(isBiased),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      brownianBridge_(brownianBridge), seed_(seed), family_(family) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -215,6 +316,12 @@ namespace QuantLib {
         registerWith(process_);
     }
 
+    template <class RNG, class S>
+    inline void MCBarrierEngine<RNG,S>::update() {
+        familyValues_.clear();
+        BarrierOption::engine::update();
+    }
+
     template <class RNG, class S>
     inline TimeGrid MCBarrierEngine<RNG,S>::timeGrid() const {
 
@@ -233,7 +340,7 @@ namespace QuantLib {
     template <class RNG, class S>
     inline
     boost::shared_ptr<typename MCBarrierEngine<RNG,S>::path_pricer_type>
-    MCBarrierEngine<RNG,S>::pathPricer() const {
+    MCBarrierEngine<RNG,S>::pathPricer(BigNatural bridgeSeed) const {
         boost::shared_ptr<PlainVanillaPayoff> payoff =
             boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non-plain payoff given");
@@ -255,8 +362,8 @@ namespace QuantLib {
                        payoff->strike(),
                        discounts));
         } else {
-            PseudoRandom::ursg_type sequenceGen(grid.size()-1,
-                                                PseudoRandom::urng_type(5));
+            PseudoRandom::ursg_type sequenceGen(
+                             grid.size()-1, PseudoRandom::urng_type(bridgeSeed));
             return boost::shared_ptr<
                         typename MCBarrierEngine<RNG,S>::path_pricer_type>(
                 new BarrierPathPricer(
@@ -272,13 +379,118 @@ namespace QuantLib {
     }
 
 
+    template <class RNG, class S>
+    inline boost::shared_ptr<PathPricer<Path,Array> >
+    MCBarrierEngine<RNG,S>::familyPathPricer(BigNatural bridgeSeed) const {
+        TimeGrid grid = timeGrid();
+        std::vector<DiscountFactor> discounts(grid.size());
+        for (Size i=0; i<grid.size(); i++)
+            discounts[i] = process_->riskFreeRate()->discount(grid[i]);
+
+        PseudoRandom::ursg_type sequenceGen(
+                             grid.size()-1, PseudoRandom::urng_type(bridgeSeed));
+        return boost::shared_ptr<PathPricer<Path,Array> >(
+            new BarrierFamilyPathPricer(family_, discounts, process_,
+                                        sequenceGen, isBiased_));
+    }
+
+
+    template <class RNG, class S>
+    inline void MCBarrierEngine<RNG,S>::calculateFamily() const {
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        Size j = 0;
+        while (j < family_.size()) {
+            const BarrierOptionTerms& terms = family_[j];
+            if (terms.barrierType == arguments_.barrierType
+                && terms.barrier == arguments_.barrier
+                && terms.rebate == arguments_.rebate
+                && terms.type == payoff->optionType()
+                && terms.strike == payoff->strike())
+                break;
+            ++j;
+        }
+        QL_REQUIRE(j < family_.size(),
+                   "option not in the family priced by the engine");
+
+        Date maturity = arguments_.exercise->lastDate();
+        if (familyValues_.empty() || maturity != familyMaturity_) {
+            simulateFamily();
+            familyMaturity_ = maturity;
+        }
+        results_.value = familyValues_[j];
+        if (RNG::allowsErrorEstimate)
+            results_.errorEstimate = familyErrors_[j];
+    }
+
+
+    template <class RNG, class S>
+    inline void MCBarrierEngine<RNG,S>::simulateFamily() const {
+        QL_REQUIRE(requiredSamples_ != Null<Size>(),
+                   "number of samples required to price a family");
+
+        typedef MonteCarloModel<SingleVariateSequence,RNG,
+                                GenericSequenceStatistics<S> > model_type;
+        typedef std::vector<std::pair<Array,Real> > values_type;
+
+        // the workers are seeded as in McSimulation; low-discrepancy
+        // sequences can't be split by reseeding
+        Size n = RNG::allowsErrorEstimate ? this->workers_ : 1;
+        std::vector<boost::shared_ptr<model_type> > models(n);
+        for (Size i=0; i<n; ++i)
+            models[i] = boost::shared_ptr<model_type>(
+                new model_type(pathGenerator(this->workerSeed(seed_, i)),
+                               familyPathPricer(this->workerSeed(5, i)),
+                               GenericSequenceStatistics<S>(family_.size()),
+                               this->antitheticVariate_));
+
+        if (n == 1) {
+            models[0]->addSamples(requiredSamples_);
+        } else {
+            std::vector<values_type> values(n);
+            std::vector<std::string> errors(n);
+            std::vector<int> failed(n, 0);
+
+            #pragma omp parallel for num_threads(n) schedule(static)
+            for (Size i=0; i<n; ++i) {
+                Size batch = requiredSamples_/n
+                           + (i < requiredSamples_%n ? 1 : 0);
+                try {
+                    models[i]->drawSamples(batch, values[i]);
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                    failed[i] = 1;
+                } catch (...) {
+                    errors[i] = "unknown error";
+                    failed[i] = 1;
+                }
+            }
+
+            for (Size i=0; i<n; ++i)
+                QL_REQUIRE(!failed[i],
+                           "worker " << i << " failed: " << errors[i]);
+
+            for (Size i=0; i<n; ++i)
+                models[0]->addSampleValues(values[i]);
+        }
+
+        const GenericSequenceStatistics<S>& stats =
+            models[0]->sampleAccumulator();
+        familyValues_ = stats.mean();
+        if (RNG::allowsErrorEstimate)
+            familyErrors_ = stats.errorEstimate();
+    }
+
+
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>::MakeMCBarrierEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), brownianBridge_(false), antithetic_(false),
       biased_(false), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), workers_(1) {}
 
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>&
@@ -350,6 +562,21 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withFamily(
+                              const std::vector<BarrierOptionTerms>& family) {
+        family_ = family;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -367,7 +594,9 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_));
+                                   seed_,
+                                   workers_,
+                                   family_));
     }
 
 }
@@ -29,12 +29,19 @@
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
+#include <ql/methods/montecarlo/spectralpathconstruction.hpp>
 #include <ql/exercise.hpp>
 
 namespace QuantLib {
 
     //! Pricing engine for European basket options using Monte Carlo simulation
-    /*! \ingroup basketengines
+    /*! Instead of a Brownian bridge, which is not supported for
+        multi-asset paths, the paths can be built from the principal
+        components of their joint covariance by means of a
+        SpectralPathConstruction; the decomposition is performed
+        once for each time grid and correlation.
+
+        \ingroup basketengines
 
         \test the correctness of the returned value is tested by
               reproducing results available in literature.
@@ -58,7 +65,8 @@ namespace QuantLib {
                                Size requiredSamples,
                                Real requiredTolerance,
                                Size maxSamples,
-                               BigNatural seed);
+                               BigNatural seed,
+                               bool spectralConstruction = false);
         void calculate() const {
             McSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
                                                         requiredSamples_,
@@ -84,6 +92,12 @@ namespace QuantLib {
             typename RNG::rsg_type gen =
                 RNG::make_sequence_generator(numAssets*(grid.size()-1),seed_);
 
+            if (spectralConstruction_)
+                return boost::shared_ptr<path_generator_type>(
+                    new path_generator_type(
+                        processes_, grid, gen,
+                        constructions_.construction(
+                                       grid, processes_->correlation())));
             return boost::shared_ptr<path_generator_type>(
                          new path_generator_type(processes_,
                                                  grid, gen, brownianBridge_));
@@ -97,6 +111,8 @@ namespace QuantLib {
         Real requiredTolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        bool spectralConstruction_;
+        mutable SpectralPathConstructionCache constructions_;
     };
 
 
@@ -110,6 +126,7 @@ namespace QuantLib {
         MakeMCEuropeanBasketEngine& withSteps(Size steps);
         MakeMCEuropeanBasketEngine& withStepsPerYear(Size steps);
         MakeMCEuropeanBasketEngine& withBrownianBridge(bool b = true);
+        MakeMCEuropeanBasketEngine& withSpectralConstruction(bool b = true);
         MakeMCEuropeanBasketEngine& withAntitheticVariate(bool b = true);
         MakeMCEuropeanBasketEngine& withSamples(Size samples);
         MakeMCEuropeanBasketEngine& withAbsoluteTolerance(Real tolerance);
@@ -119,7 +136,7 @@ namespace QuantLib {
         operator boost::shared_ptr<PricingEngine>() const;
       private:
         boost::shared_ptr<StochasticProcessArray> process_;
-        bool brownianBridge_, antithetic_;
+        bool brownianBridge_, spectralConstruction_, antithetic_;
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
@@ -149,13 +166,18 @@ namespace QuantLib {
                    Size requiredSamples,
                    Real requiredTolerance,
                    Size maxSamples,
-                   BigNatural seed)
+                   BigNatural seed,
+                   bool spectralConstruction)
     : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false),
       processes_(processes), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
       requiredTolerance_(requiredTolerance),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      brownianBridge_(brownianBridge), seed_(seed),
+      spectralConstruction_(spectralConstruction) {
+        QL_REQUIRE(!brownianBridge || !spectralConstruction,
+                   "Brownian bridge and spectral construction "
+                   "cannot be used together");
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -211,7 +233,8 @@ namespace QuantLib {
     template <class RNG, class S>
     inline MakeMCEuropeanBasketEngine<RNG,S>::MakeMCEuropeanBasketEngine(
                      const boost::shared_ptr<StochasticProcessArray>& process)
-    : process_(process), brownianBridge_(false), antithetic_(false),
+    : process_(process), brownianBridge_(false),
+      spectralConstruction_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
       tolerance_(Null<Real>()), seed_(0) {}
@@ -237,6 +260,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanBasketEngine<RNG,S>&
+    MakeMCEuropeanBasketEngine<RNG,S>::withSpectralConstruction(bool b) {
+        spectralConstruction_ = b;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCEuropeanBasketEngine<RNG,S>&
     MakeMCEuropeanBasketEngine<RNG,S>::withAntitheticVariate(bool b) {
@@ -295,7 +325,8 @@ namespace QuantLib {
                                           antithetic_,
                                           samples_, tolerance_,
                                           maxSamples_,
-                                          seed_));
+                                          seed_,
+                                          spectralConstruction_));
     }
 
 }
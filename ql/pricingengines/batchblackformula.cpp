@@ -0,0 +1,271 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/batchblackformula.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/utilities/null.hpp>
+#include <ql/mathconstants.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        // Coefficients of the rational approximations to erf and erfc
+        // given by W. J. Cody (see the CALERF routine in netlib/specfun)
+
+        const Real a[5] = { 3.16112374387056560e00, 1.13864154151050156e02,
+                            3.77485237685302021e02, 3.20937758913846947e03,
+                            1.85777706184603153e-1 };
+        const Real b[4] = { 2.36012909523441209e01, 2.44024637934444173e02,
+                            1.28261652607737228e03, 2.84423683343917062e03 };
+        const Real c[9] = { 5.64188496988670089e-1, 8.88314979438837594e00,
+                            6.61191906371416295e01, 2.98635138197400131e02,
+                            8.81952221241769090e02, 1.71204761263407058e03,
+                            2.05107837782607147e03, 1.23033935479799725e03,
+                            2.15311535474403846e-8 };
+        const Real d[8] = { 1.57449261107098347e01, 1.17693950891312499e02,
+                            5.37181101862009858e02, 1.62138957456669019e03,
+                            3.29079923573345963e03, 4.36261909014324716e03,
+                            3.43936767414372164e03, 1.23033935480374942e03 };
+        const Real p[6] = { 3.05326634961232344e-1, 3.60344899949804439e-1,
+                            1.25781726111229246e-1, 1.60837851487422766e-2,
+                            6.58749161529837803e-4, 1.63153871373020978e-2 };
+        const Real q[5] = { 2.56852019228982242e00, 1.87295284992346725e00,
+                            5.27905102951428412e-1, 6.05183413124413191e-2,
+                            2.33520497626869185e-3 };
+
+        /* Cumulative normal distribution, given the argument x and
+           the value exp(-x*x/2) which is shared with other quantities
+           in the caller.  The three ranges of Cody's approximation are
+           all evaluated and the result is selected afterwards, so that
+           no branch depends on the argument. */
+        inline Real cumulativeNormal(Real x, Real gaussian) {
+            const Real y = std::fabs(x)*M_SQRT1_2;
+            const Real ysq = y*y;
+
+            // erfc(y) for y <= 0.46875
+            Real num = a[4]*ysq, den = ysq;
+            for (Size i=0; i<3; ++i) {
+                num = (num + a[i])*ysq;
+                den = (den + b[i])*ysq;
+            }
+            const Real small = 1.0 - y*(num + a[3])/(den + b[3]);
+
+            // erfc(y)*exp(y*y) for 0.46875 < y <= 4
+            num = c[8]*y;
+            den = y;
+            for (Size i=0; i<7; ++i) {
+                num = (num + c[i])*y;
+                den = (den + d[i])*y;
+            }
+            const Real medium = (num + c[7])/(den + d[7]);
+
+            // erfc(y)*exp(y*y) for y > 4
+            const Real yinv = 1.0/std::max(y, Real(0.25));
+            const Real z = yinv*yinv;
+            num = p[5]*z;
+            den = z;
+            for (Size i=0; i<4; ++i) {
+                num = (num + p[i])*z;
+                den = (den + q[i])*z;
+            }
+            const Real large =
+                (M_1_SQRTPI - z*(num + p[4])/(den + q[4]))*yinv;
+
+            const Real erfc =
+                y <= 0.46875 ? small : gaussian*(y <= 4.0 ? medium : large);
+            return x < 0.0 ? 0.5*erfc : 1.0 - 0.5*erfc;
+        }
+
+        const Size householderIterations = 4;
+
+    }
+
+    void blackFormula(Option::Type optionType,
+                      Size n,
+                      const Real* strikes,
+                      const Real* forwards,
+                      const Real* stdDevs,
+                      const Real* discounts,
+                      Real* prices,
+                      Real* stdDevDerivatives,
+                      Real displacement) {
+
+        QL_REQUIRE(displacement >= 0.0, "displacement ("
+                                            << displacement
+                                            << ") must be non-negative");
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(strikes[i] + displacement >= 0.0,
+                       "strike + displacement (" << strikes[i] << " + "
+                       << displacement << ") must be non-negative "
+                       "for option #" << i);
+            QL_REQUIRE(forwards[i] + displacement > 0.0,
+                       "forward + displacement (" << forwards[i] << " + "
+                       << displacement << ") must be positive "
+                       "for option #" << i);
+            QL_REQUIRE(stdDevs[i] >= 0.0,
+                       "stdDev (" << stdDevs[i] << ") must be non-negative "
+                       "for option #" << i);
+            QL_REQUIRE(discounts[i] > 0.0,
+                       "discount (" << discounts[i] << ") must be positive "
+                       "for option #" << i);
+        }
+
+        const Real w = Real(optionType);
+        const bool computeDerivatives = (stdDevDerivatives != 0);
+
+        for (Size i=0; i<n; ++i) {
+            const Real strike = strikes[i] + displacement;
+            const Real forward = forwards[i] + displacement;
+            const Real stdDev = stdDevs[i];
+            const Real discount = discounts[i];
+
+            // null strikes and standard deviations give the intrinsic
+            // value; safe inputs are used for them in the calculation
+            // below, whose result is then discarded
+            const bool regular = (stdDev > 0.0 && strike > 0.0);
+            const Real s = regular ? stdDev : 1.0;
+            const Real k = regular ? strike : forward;
+
+            const Real d1 = std::log(forward/k)/s + 0.5*s;
+            const Real d2 = d1 - s;
+            // exp(-d2*d2/2) = exp(-d1*d1/2)*forward/strike
+            const Real g1 = std::exp(-0.5*d1*d1);
+            const Real g2 = g1*forward/k;
+            const Real nd1 = cumulativeNormal(w*d1, g1);
+            const Real nd2 = cumulativeNormal(w*d2, g2);
+            const Real price = std::max(
+                discount * w * (forward*nd1 - strike*nd2), Real(0.0));
+            const Real intrinsic =
+                std::max(w*(forward-strike), Real(0.0))*discount;
+            prices[i] = regular ? price : intrinsic;
+
+            if (computeDerivatives) {
+                const Real density = M_SQRT_2 * M_1_SQRTPI * g1;
+                stdDevDerivatives[i] =
+                    regular ? discount * forward * density : 0.0;
+            }
+        }
+    }
+
+    Size blackFormulaImpliedStdDev(Option::Type optionType,
+                                   Size n,
+                                   const Real* strikes,
+                                   const Real* forwards,
+                                   const Real* blackPrices,
+                                   const Real* discounts,
+                                   Real* stdDevs,
+                                   Real displacement,
+                                   Real accuracy,
+                                   Natural maxIterations) {
+
+        QL_REQUIRE(displacement >= 0.0, "displacement ("
+                                            << displacement
+                                            << ") must be non-negative");
+
+        const Real w0 = Real(optionType);
+
+        for (Size i=0; i<n; ++i) {
+            const Real strike = strikes[i] + displacement;
+            const Real forward = forwards[i] + displacement;
+            const Real discount = discounts[i];
+
+            // the out-of-the-money option has the greater vega/price
+            // ratio and is numerically more robust
+            const Real w = strike >= forward ? 1.0 : -1.0;
+            const Real price = (blackPrices[i]
+                - (w != w0 ? w0*(forward-strike)*discount : 0.0))/discount;
+            const Real bound = std::min(forward, strike);
+
+            // invalid quotes are flagged, and safe inputs are used for
+            // them in the calculation below, whose result is then
+            // discarded
+            const bool valid = (strike >= 0.0 && forward > 0.0
+                                && discount > 0.0
+                                && price >= 0.0 && price < bound);
+            const bool regular = valid && price > 0.0;
+            const Real f = regular ? forward : 1.0;
+            const Real k = regular ? strike : 1.0;
+            const Real p = regular ? price : 0.5;
+
+            // Corrado-Miller initial guess
+            const Real delta = w*(f-k);
+            const Real t = p - 0.5*delta;
+            Real s = std::sqrt(2.0*M_PI)/(f+k)
+                * (t + std::sqrt(std::max(t*t - delta*delta/M_PI, 0.0)));
+            s = s > 0.0 ? s : 0.1;
+
+            const Real x = std::log(f/k);
+            const Real logPrice = std::log(p);
+            Real step = 0.0;
+            for (Size j=0; j<householderIterations; ++j) {
+                // derivatives of the price with respect to s over vega
+                const Real d1 = x/s + 0.5*s, d2 = d1 - s;
+                const Real g1 = std::exp(-0.5*d1*d1);
+                const Real g2 = g1*f/k;
+                const Real value = w*(f*cumulativeNormal(w*d1, g1)
+                                      - k*cumulativeNormal(w*d2, g2));
+                const Real vega = M_SQRT_2 * M_1_SQRTPI * f * g1;
+                const Real h2 = d1*d2/s;
+                const Real h3 = h2*h2 - 3.0*x*x/(s*s*s*s) - 0.25;
+
+                // the same for log(value) - log(price)
+                const Real r = vega/value;
+                const Real nu = (logPrice - std::log(value))/r;
+                const Real l2 = h2 - r;
+                const Real l3 = h3 - 3.0*r*h2 + 2.0*r*r;
+                const Real householder =
+                    nu*(1.0 + 0.5*nu*l2)/(1.0 + nu*(l2 + nu*l3/6.0));
+
+                // a vanishing value means s is far too low
+                step = value > 0.0 && householder == householder ?
+                    householder : s;
+                s = std::min(std::max(s + step, 0.25*s), 4.0*s);
+            }
+
+            // quotes that did not converge are marked with a negative
+            // (or NaN) result and passed to the scalar solver below
+            const bool converged = std::fabs(step) <= accuracy;
+            stdDevs[i] = regular ? (converged ? s : -s) :
+                                   (valid ? 0.0 : Real(Null<Real>()));
+        }
+
+        Size flagged = 0;
+        for (Size i=0; i<n; ++i) {
+            if (stdDevs[i] == Null<Real>()) {
+                ++flagged;
+            } else if (!(stdDevs[i] >= 0.0)) {
+                const Real guess =
+                    stdDevs[i] < 0.0 ? -stdDevs[i] : Real(Null<Real>());
+                try {
+                    stdDevs[i] = blackFormulaImpliedStdDev(
+                        optionType, strikes[i], forwards[i], blackPrices[i],
+                        discounts[i], displacement, guess,
+                        accuracy, maxIterations);
+                } catch (Error&) {
+                    stdDevs[i] = Null<Real>();
+                    ++flagged;
+                }
+            }
+        }
+        return flagged;
+    }
+
+}
@@ -0,0 +1,98 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchblackformula.hpp
+    \brief Black formula for batches of options
+*/
+
+#ifndef quantlib_batch_black_formula_hpp
+#define quantlib_batch_black_formula_hpp
+
+#include <ql/option.hpp>
+
+namespace QuantLib {
+
+    /*! Black 1976 formula for a batch of options
+
+        The \f$ n \f$ options are described by contiguous arrays of
+        strikes, forwards, standard deviations and discounts
+        (struct-of-arrays layout) and share the option type and the
+        displacement.  The resulting prices are written into
+        <tt>prices</tt>; if <tt>stdDevDerivatives</tt> is not null,
+        the derivatives with respect to the standard deviation (as
+        returned by blackFormulaStdDevDerivative) are written into it.
+
+        The inputs are validated as in blackFormula before any
+        calculation is performed.  The pricing loop itself contains no
+        data-dependent branch and uses a rational approximation of the
+        cumulative normal distribution (W. J. Cody, "Rational Chebyshev
+        approximations for the error function", Mathematics of
+        Computation 23, 1969) which can be vectorized by the compiler,
+        provided that vector versions of std::exp and std::log are
+        available.
+
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    void blackFormula(Option::Type optionType,
+                      Size n,
+                      const Real* strikes,
+                      const Real* forwards,
+                      const Real* stdDevs,
+                      const Real* discounts,
+                      Real* prices,
+                      Real* stdDevDerivatives = 0,
+                      Real displacement = 0.0);
+
+    /*! Black 1976 implied standard deviation for a batch of quotes
+
+        The \f$ n \f$ quotes are described by contiguous arrays of
+        strikes, forwards, option prices and discounts and share the
+        option type and the displacement; the resulting implied
+        standard deviations are written into <tt>stdDevs</tt>.
+
+        Each quote is converted by put-call parity into the price of
+        the out-of-the-money option, for which the Corrado-Miller
+        approximation provides the initial guess.  A fixed number of
+        third-order Householder iterations on the logarithm of the
+        price is then performed on all quotes in lockstep, with no
+        data-dependent branch.  The few quotes for which the last
+        iteration still moved the result by more than the given
+        accuracy are passed to blackFormulaImpliedStdDev.
+
+        Quotes that admit no solution (i.e., outside the arbitrage
+        bounds) or have invalid parameters don't cause an exception;
+        instead, the corresponding result is set to Null<Real>().
+        The number of such quotes is returned.
+
+        \warning instead of volatility it returns standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    Size blackFormulaImpliedStdDev(Option::Type optionType,
+                                   Size n,
+                                   const Real* strikes,
+                                   const Real* forwards,
+                                   const Real* blackPrices,
+                                   const Real* discounts,
+                                   Real* stdDevs,
+                                   Real displacement = 0.0,
+                                   Real accuracy = 1.0e-6,
+                                   Natural maxIterations = 100);
+
+}
+
+#endif
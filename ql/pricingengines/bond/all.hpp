@@ -1,6 +1,7 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/pricingengines/bond/bondbatch.hpp>
 #include <ql/pricingengines/bond/bondfunctions.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 
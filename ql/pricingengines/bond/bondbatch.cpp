@@ -0,0 +1,411 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/bond/bondbatch.hpp>
+#include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/interestrate.hpp>
+#include <ql/utilities/null.hpp>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        // same as in cashflows.cpp
+        Time stepwiseDiscountTime(const boost::shared_ptr<CashFlow>& cashFlow,
+                                  const DayCounter& dc,
+                                  const Date& npvDate,
+                                  const Date& lastDate) {
+            Date cashFlowDate = cashFlow->date();
+            Date refStartDate, refEndDate;
+            boost::shared_ptr<Coupon> coupon =
+                boost::dynamic_pointer_cast<Coupon>(cashFlow);
+            if (coupon) {
+                refStartDate = coupon->referencePeriodStart();
+                refEndDate = coupon->referencePeriodEnd();
+            } else {
+                if (lastDate == npvDate) {
+                    // we don't have a previous coupon date,
+                    // so we fake it
+                    refStartDate = cashFlowDate - 1*Years;
+                } else  {
+                    refStartDate = lastDate;
+                }
+                refEndDate = cashFlowDate;
+            }
+
+            if (coupon && lastDate != coupon->accrualStartDate()) {
+                Time couponPeriod =
+                    dc.yearFraction(coupon->accrualStartDate(),
+                                    cashFlowDate, refStartDate, refEndDate);
+                Time accruedPeriod =
+                    dc.yearFraction(coupon->accrualStartDate(),
+                                    lastDate, refStartDate, refEndDate);
+                return couponPeriod - accruedPeriod;
+            } else {
+                return dc.yearFraction(lastDate, cashFlowDate,
+                                       refStartDate, refEndDate);
+            }
+        }
+
+        // The formulas below follow InterestRate::compoundFactor and
+        // the corresponding CashFlows functions; n is the frequency.
+
+        bool isSimple(Compounding c, Real n, Time t) {
+            switch (c) {
+              case Simple:
+                return true;
+              case SimpleThenCompounded:
+                return t <= 1.0/n;
+              case CompoundedThenSimple:
+                return t > 1.0/n;
+              default:
+                return false;
+            }
+        }
+
+        DiscountFactor discount(Compounding c, Rate r, Real n, Time t) {
+            if (isSimple(c, n, t))
+                return 1.0/(1.0 + r*t);
+            else if (c == Continuous)
+                return std::exp(-r*t);
+            else
+                return std::pow(1.0 + r/n, -n*t);
+        }
+
+        // minus the derivative of log(discount) with respect to r
+        Real logDiscountDerivative(Compounding c, Rate r, Real n, Time t) {
+            if (isSimple(c, n, t))
+                return t/(1.0 + r*t);
+            else if (c == Continuous)
+                return t;
+            else
+                return t/(1.0 + r/n);
+        }
+
+        // minus the derivative of the discount with respect to r,
+        // as used by CashFlows::duration
+        Real durationTerm(Compounding c, Rate r, Real n, Time t,
+                          DiscountFactor B) {
+            if (isSimple(c, n, t))
+                return B*B*t;
+            else if (c == Continuous)
+                return B*t;
+            else
+                return t*B/(1.0 + r/n);
+        }
+
+        // second derivative of the discount with respect to r,
+        // as used by CashFlows::convexity
+        Real convexityTerm(Compounding c, Rate r, Real n, Time t,
+                           DiscountFactor B) {
+            if (isSimple(c, n, t))
+                return 2.0*B*B*B*t*t;
+            else if (c == Continuous)
+                return B*t*t;
+            else
+                return B*t*(n*t+1)/(n*(1+r/n)*(1+r/n));
+        }
+
+        bool allowed(Compounding c, Rate r, Real n) {
+            // the discount factors must stay positive and finite
+            switch (c) {
+              case Continuous:
+                return true;
+              case Simple:
+                return r > -1.0;
+              default:
+                return r > -n;
+            }
+        }
+
+    }
+
+
+    BondBatch::Entry::Entry(const boost::shared_ptr<Bond>& b)
+    : bond(b), valid(false), tradable(false) {
+        const Leg& leg = bond->cashflows();
+        for (Size i=0; i<leg.size(); ++i)
+            registerWith(leg[i]);
+    }
+
+    void BondBatch::Entry::setup(Date settlement, const DayCounter& dc) {
+        if (settlement == Date())
+            settlement = bond->settlementDate();
+        if (valid && settlement == settlementDate && dc == dayCounter)
+            return;
+
+        settlementDate = settlement;
+        dayCounter = dc;
+        steps.clear();
+        times.clear();
+        amounts.clear();
+        accruedAmount = 0.0;
+
+        tradable = BondFunctions::isTradable(*bond, settlement);
+        if (tradable) {
+            const Leg& leg = bond->cashflows();
+            const Real scale = 100.0/bond->notional(settlement);
+            Date lastDate = settlement;
+            Time t = 0.0;
+            for (Size i=0; i<leg.size(); ++i) {
+                if (leg[i]->hasOccurred(settlement, false))
+                    continue;
+                Real c = leg[i]->tradingExCoupon(settlement) ?
+                         0.0 : leg[i]->amount();
+                Time dt = stepwiseDiscountTime(leg[i], dc,
+                                               settlement, lastDate);
+                t += dt;
+                steps.push_back(dt);
+                times.push_back(t);
+                amounts.push_back(c*scale);
+                lastDate = leg[i]->date();
+            }
+            accruedAmount = bond->accruedAmount(settlement);
+        }
+        valid = true;
+    }
+
+
+    BondBatch::BondBatch(const std::vector<boost::shared_ptr<Bond> >& bonds) {
+        entries_.reserve(bonds.size());
+        for (Size i=0; i<bonds.size(); ++i) {
+            QL_REQUIRE(bonds[i], "null bond given");
+            entries_.push_back(boost::shared_ptr<Entry>(new Entry(bonds[i])));
+        }
+    }
+
+    const boost::shared_ptr<Bond>& BondBatch::bond(Size i) const {
+        QL_REQUIRE(i < entries_.size(),
+                   "bond index (" << i << ") out of range");
+        return entries_[i]->bond;
+    }
+
+    Size BondBatch::yields(const Real* cleanPrices,
+                           const DayCounter& dayCounter,
+                           Compounding compounding,
+                           Frequency frequency,
+                           Rate* yields,
+                           Date settlementDate,
+                           Real accuracy,
+                           Size maxIterations,
+                           Rate guess) const {
+        // validates the conventions
+        const InterestRate rate(guess, dayCounter, compounding, frequency);
+        const Real n = Real(Integer(rate.frequency()));
+        const Compounding c = compounding;
+        const Size size = entries_.size();
+
+        // 0: iterating, 1: converged, 2: to be passed to the scalar solver
+        std::vector<int> status(size, 0);
+        std::vector<Real> targets(size);
+        for (Size i=0; i<size; ++i) {
+            Entry& e = *entries_[i];
+            e.setup(settlementDate, dayCounter);
+            if (!e.tradable || e.amounts.empty()) {
+                status[i] = 2;
+            } else {
+                targets[i] = cleanPrices[i] + e.accruedAmount;
+                yields[i] = guess;
+            }
+        }
+
+        // As in CashFlows::npv, the discount factors are products of
+        // the discounts over each period; with compounded or
+        // continuous rates, this is the discount over the whole time,
+        // which is faster to calculate.
+        const bool stepwise =
+            c == Simple || c == SimpleThenCompounded
+                        || c == CompoundedThenSimple;
+        for (Size k=0; k<maxIterations; ++k) {
+            bool done = true;
+            for (Size i=0; i<size; ++i) {
+                if (status[i] != 0)
+                    continue;
+                const Entry& e = *entries_[i];
+                const Rate r = yields[i];
+                const Size m = e.amounts.size();
+                Real P = 0.0, dPdr = 0.0;
+                if (stepwise) {
+                    DiscountFactor B = 1.0;
+                    Real G = 0.0;
+                    for (Size j=0; j<m; ++j) {
+                        B *= discount(c, r, n, e.steps[j]);
+                        G += logDiscountDerivative(c, r, n, e.steps[j]);
+                        P += e.amounts[j]*B;
+                        dPdr -= e.amounts[j]*B*G;
+                    }
+                } else {
+                    const Real a = (c == Continuous) ? r
+                                                     : n*std::log(1.0+r/n);
+                    const Real dadr = (c == Continuous) ? 1.0
+                                                        : 1.0/(1.0+r/n);
+                    const Real* amounts = &e.amounts[0];
+                    const Time* times = &e.times[0];
+                    Real dP = 0.0;
+                    for (Size j=0; j<m; ++j) {
+                        const Real x = amounts[j]*std::exp(-a*times[j]);
+                        P += x;
+                        dP += x*times[j];
+                    }
+                    dPdr = -dP*dadr;
+                }
+
+                const Real dx = (P - targets[i])/dPdr;
+                const Rate next = r - dx;
+                if (!(std::fabs(dx) < QL_MAX_REAL) || !allowed(c, next, n)) {
+                    status[i] = 2;
+                } else {
+                    yields[i] = next;
+                    if (std::fabs(dx) < accuracy)
+                        status[i] = 1;
+                    else
+                        done = false;
+                }
+            }
+            if (done)
+                break;
+        }
+
+        Size failures = 0;
+        for (Size i=0; i<size; ++i) {
+            if (status[i] == 1)
+                continue;
+            const Entry& e = *entries_[i];
+            yields[i] = Null<Rate>();
+            if (e.tradable) {
+                try {
+                    yields[i] = BondFunctions::yield(*e.bond, cleanPrices[i],
+                                                     dayCounter, compounding,
+                                                     frequency,
+                                                     e.settlementDate,
+                                                     accuracy, maxIterations,
+                                                     guess);
+                } catch (std::exception&) {}
+            }
+            if (yields[i] == Null<Rate>())
+                ++failures;
+        }
+        return failures;
+    }
+
+    Size BondBatch::cleanPrices(const Rate* yields,
+                                const DayCounter& dayCounter,
+                                Compounding compounding,
+                                Frequency frequency,
+                                Real* cleanPrices,
+                                Date settlementDate) const {
+        const InterestRate rate(0.0, dayCounter, compounding, frequency);
+        const Real n = Real(Integer(rate.frequency()));
+
+        Size failures = 0;
+        for (Size i=0; i<entries_.size(); ++i) {
+            Entry& e = *entries_[i];
+            e.setup(settlementDate, dayCounter);
+            const Rate r = yields[i];
+            if (!e.tradable || r == Null<Rate>()) {
+                cleanPrices[i] = Null<Real>();
+                ++failures;
+                continue;
+            }
+            Real P = 0.0;
+            DiscountFactor B = 1.0;
+            for (Size j=0; j<e.amounts.size(); ++j) {
+                B *= discount(compounding, r, n, e.steps[j]);
+                P += e.amounts[j]*B;
+            }
+            cleanPrices[i] = P - e.accruedAmount;
+        }
+        return failures;
+    }
+
+    Size BondBatch::durations(const Rate* yields,
+                              const DayCounter& dayCounter,
+                              Compounding compounding,
+                              Frequency frequency,
+                              Duration::Type type,
+                              Time* durations,
+                              Date settlementDate) const {
+        const InterestRate rate(0.0, dayCounter, compounding, frequency);
+        const Real n = Real(Integer(rate.frequency()));
+        QL_REQUIRE(type != Duration::Macaulay || compounding == Compounded,
+                   "compounded rate required");
+
+        Size failures = 0;
+        for (Size i=0; i<entries_.size(); ++i) {
+            Entry& e = *entries_[i];
+            e.setup(settlementDate, dayCounter);
+            const Rate r = yields[i];
+            if (!e.tradable || r == Null<Rate>()) {
+                durations[i] = Null<Real>();
+                ++failures;
+                continue;
+            }
+            Real P = 0.0, dPdy = 0.0;
+            for (Size j=0; j<e.amounts.size(); ++j) {
+                const Time t = e.times[j];
+                const DiscountFactor B = discount(compounding, r, n, t);
+                P += e.amounts[j]*B;
+                if (type == Duration::Simple)
+                    dPdy += t*e.amounts[j]*B;
+                else
+                    dPdy += e.amounts[j]*durationTerm(compounding, r, n, t, B);
+            }
+            if (P == 0.0)
+                durations[i] = 0.0;
+            else if (type == Duration::Macaulay)
+                durations[i] = (1.0+r/n)*dPdy/P;
+            else
+                durations[i] = dPdy/P;
+        }
+        return failures;
+    }
+
+    Size BondBatch::convexities(const Rate* yields,
+                                const DayCounter& dayCounter,
+                                Compounding compounding,
+                                Frequency frequency,
+                                Real* convexities,
+                                Date settlementDate) const {
+        const InterestRate rate(0.0, dayCounter, compounding, frequency);
+        const Real n = Real(Integer(rate.frequency()));
+
+        Size failures = 0;
+        for (Size i=0; i<entries_.size(); ++i) {
+            Entry& e = *entries_[i];
+            e.setup(settlementDate, dayCounter);
+            const Rate r = yields[i];
+            if (!e.tradable || r == Null<Rate>()) {
+                convexities[i] = Null<Real>();
+                ++failures;
+                continue;
+            }
+            Real P = 0.0, d2Pdy2 = 0.0;
+            for (Size j=0; j<e.amounts.size(); ++j) {
+                const Time t = e.times[j];
+                const DiscountFactor B = discount(compounding, r, n, t);
+                P += e.amounts[j]*B;
+                d2Pdy2 += e.amounts[j]*convexityTerm(compounding, r, n, t, B);
+            }
+            convexities[i] = (P == 0.0) ? 0.0 : d2Pdy2/P;
+        }
+        return failures;
+    }
+
+}
+
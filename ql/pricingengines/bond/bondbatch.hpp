@@ -0,0 +1,122 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file bondbatch.hpp
+    \brief yield, price and risk calculations for batches of bonds
+*/
+
+#ifndef quantlib_bond_batch_hpp
+#define quantlib_bond_batch_hpp
+
+#include <ql/instruments/bond.hpp>
+#include <ql/cashflows/duration.hpp>
+#include <ql/compounding.hpp>
+#include <ql/time/daycounter.hpp>
+
+namespace QuantLib {
+
+    //! yield, price and risk calculations for batches of bonds
+    /*! The methods of this class give the same results as the
+        corresponding BondFunctions methods (up to the accuracy of
+        the yield calculation) for each bond in the batch, but they
+        don't walk the cashflows of the bonds at each call.  Instead,
+        the times and amounts of the cashflows of each bond are
+        calculated once for a given settlement date and day counter,
+        and kept until the cashflows of the bond send a notification
+        (e.g., because the fixing of a floating coupon changed) or
+        until a different settlement date or day counter is used.
+
+        Yields are found by Newton iterations performed in lockstep
+        on all the bonds in the batch, using the exact derivative of
+        the price; bonds for which the iteration doesn't converge are
+        passed to BondFunctions::yield.
+
+        When no settlement date is given, the settlement date of each
+        bond is used.  Prices are clean, as in BondFunctions.  Results
+        that can't be calculated (e.g., because a bond is not tradable
+        at the settlement date, or because no yield reproduces the
+        given price) don't cause an exception; instead, they're set to
+        Null<Real>() and their number is returned.
+    */
+    class BondBatch {
+      public:
+        explicit BondBatch(
+                      const std::vector<boost::shared_ptr<Bond> >& bonds);
+        //! \name Inspectors
+        //@{
+        Size size() const { return entries_.size(); }
+        const boost::shared_ptr<Bond>& bond(Size i) const;
+        //@}
+        //! \name Calculations
+        /*! The inputs and results are contiguous arrays with one
+            element for each bond in the batch.
+        */
+        //@{
+        Size yields(const Real* cleanPrices,
+                    const DayCounter& dayCounter,
+                    Compounding compounding,
+                    Frequency frequency,
+                    Rate* yields,
+                    Date settlementDate = Date(),
+                    Real accuracy = 1.0e-10,
+                    Size maxIterations = 100,
+                    Rate guess = 0.05) const;
+        Size cleanPrices(const Rate* yields,
+                         const DayCounter& dayCounter,
+                         Compounding compounding,
+                         Frequency frequency,
+                         Real* cleanPrices,
+                         Date settlementDate = Date()) const;
+        Size durations(const Rate* yields,
+                       const DayCounter& dayCounter,
+                       Compounding compounding,
+                       Frequency frequency,
+                       Duration::Type type,
+                       Time* durations,
+                       Date settlementDate = Date()) const;
+        Size convexities(const Rate* yields,
+                         const DayCounter& dayCounter,
+                         Compounding compounding,
+                         Frequency frequency,
+                         Real* convexities,
+                         Date settlementDate = Date()) const;
+        //@}
+      private:
+        class Entry : public Observer {
+          public:
+            explicit Entry(const boost::shared_ptr<Bond>& bond);
+            void update() { valid = false; }
+            //! recalculates the cashflow data if needed
+            void setup(Date settlementDate, const DayCounter& dayCounter);
+            boost::shared_ptr<Bond> bond;
+            bool valid, tradable;
+            Date settlementDate;
+            DayCounter dayCounter;
+            // time from the previous cashflow (or the settlement date)
+            // and from the settlement date; amounts are scaled to a
+            // notional of 100.
+            std::vector<Time> steps, times;
+            std::vector<Real> amounts;
+            Real accruedAmount;
+        };
+        std::vector<boost::shared_ptr<Entry> > entries_;
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,165 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cachingengine.hpp
+    \brief pricing engine storing the results of another engine
+*/
+
+#ifndef quantlib_caching_engine_hpp
+#define quantlib_caching_engine_hpp
+
+#include <ql/pricingengine.hpp>
+#include <boost/function.hpp>
+#include <boost/unordered_map.hpp>
+#include <list>
+#include <string>
+
+namespace QuantLib {
+
+    //! pricing engine storing the results of another engine
+    /*! Instruments sharing this engine and passing it the same
+        arguments (e.g., the same option held in several books) get
+        the results of a single calculation of the underlying engine.
+        The arguments are identified by the string returned by the
+        given key function, which must encode all the data used by
+        the underlying engine; an empty key disables caching for the
+        arguments it was returned for.
+
+        The stored results are discarded when the underlying engine
+        notifies a change of its market data; as usual, the
+        notification is then forwarded to the instruments.  When the
+        given capacity is exceeded, the least recently used results
+        are discarded.
+
+        \warning The underlying engine must have the same argument
+                 and result types as this one.  Market data that
+                 don't notify the underlying engine when they change
+                 (e.g., quotes that were frozen or whose notifications
+                 were disabled) are not detected; the cache must be
+                 cleared explicitly in that case.
+
+        \ingroup engines
+    */
+    template <class ArgumentsType, class ResultsType>
+    class CachingEngine : public GenericEngine<ArgumentsType, ResultsType> {
+      public:
+        typedef boost::function<std::string (const ArgumentsType&)>
+                                                               KeyFunction;
+        CachingEngine(const boost::shared_ptr<PricingEngine>& engine,
+                      const KeyFunction& key,
+                      Size capacity = 1000);
+        void calculate() const;
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+        //! \name Inspectors
+        //@{
+        const boost::shared_ptr<PricingEngine>& engine() const {
+            return engine_;
+        }
+        Size capacity() const { return capacity_; }
+        //! number of stored results
+        Size size() const { return entries_.size(); }
+        Size hits() const { return hits_; }
+        Size misses() const { return misses_; }
+        //@}
+        //! discards the stored results; the counters are not reset
+        void clear();
+      private:
+        typedef std::list<std::pair<std::string, ResultsType> > entries;
+        boost::shared_ptr<PricingEngine> engine_;
+        KeyFunction key_;
+        Size capacity_;
+        // most recently used first
+        mutable entries entries_;
+        mutable boost::unordered_map<std::string,
+                                     typename entries::iterator> index_;
+        mutable Size hits_, misses_;
+    };
+
+
+    // template definitions
+
+    template <class A, class R>
+    CachingEngine<A,R>::CachingEngine(
+                              const boost::shared_ptr<PricingEngine>& engine,
+                              const KeyFunction& key,
+                              Size capacity)
+    : engine_(engine), key_(key), capacity_(capacity),
+      hits_(0), misses_(0) {
+        QL_REQUIRE(engine_, "null underlying engine");
+        QL_REQUIRE(key_, "null key function");
+        QL_REQUIRE(capacity_ > 0, "null capacity given");
+        QL_REQUIRE(dynamic_cast<A*>(engine_->getArguments()) != 0,
+                   "wrong argument type for underlying engine");
+        this->registerWith(engine_);
+    }
+
+    template <class A, class R>
+    void CachingEngine<A,R>::calculate() const {
+        const std::string key = key_(this->arguments_);
+
+        if (!key.empty()) {
+            typename boost::unordered_map<std::string,
+                                          typename entries::iterator>
+                ::const_iterator i = index_.find(key);
+            if (i != index_.end()) {
+                entries_.splice(entries_.begin(), entries_, i->second);
+                this->results_ = i->second->second;
+                ++hits_;
+                return;
+            }
+            ++misses_;
+        }
+
+        engine_->reset();
+        A* arguments = dynamic_cast<A*>(engine_->getArguments());
+        QL_REQUIRE(arguments != 0,
+                   "wrong argument type for underlying engine");
+        *arguments = this->arguments_;
+        engine_->calculate();
+        const R* results = dynamic_cast<const R*>(engine_->getResults());
+        QL_REQUIRE(results != 0,
+                   "wrong result type from underlying engine");
+        this->results_ = *results;
+
+        if (!key.empty()) {
+            entries_.push_front(std::make_pair(key, this->results_));
+            index_[key] = entries_.begin();
+            if (entries_.size() > capacity_) {
+                index_.erase(entries_.back().first);
+                entries_.pop_back();
+            }
+        }
+    }
+
+    template <class A, class R>
+    void CachingEngine<A,R>::update() {
+        clear();
+        this->notifyObservers();
+    }
+
+    template <class A, class R>
+    void CachingEngine<A,R>::clear() {
+        entries_.clear();
+        index_.clear();
+    }
+
+}
+
+#endif
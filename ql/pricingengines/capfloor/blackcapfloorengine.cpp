@@ -21,7 +21,7 @@
 */
 
 #include <ql/pricingengines/capfloor/blackcapfloorengine.hpp>
-#include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/batchblackformula.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/termstructures/volatility/optionlet/constantoptionletvol.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
@@ -86,60 +86,87 @@ namespace QuantLib {
         Date today = vol_->referenceDate();
         Date settlement = discountCurve_->referenceDate();
 
+        // the data of the alive optionlets are gathered first, so
+        // that all of them can be priced by a single call to the
+        // batch Black formula
+        std::vector<Size> alive;
+        std::vector<Real> forwards, discounts, sqrtTimes;
+        alive.reserve(optionlets);
+        forwards.reserve(optionlets);
+        discounts.reserve(optionlets);
+        sqrtTimes.reserve(optionlets);
         for (Size i=0; i<optionlets; ++i) {
             Date paymentDate = arguments_.endDates[i];
             // handling of settlementDate, npvDate and includeSettlementFlows
             // should be implemented.
             // For the time being just discard expired caplets
             if (paymentDate > settlement) {
-                DiscountFactor d = arguments_.nominals[i] *
-                                   arguments_.gearings[i] *
-                                   discountCurve_->discount(paymentDate) *
-                                   arguments_.accrualTimes[i];
-
-                Rate forward = arguments_.forwards[i];
+                alive.push_back(i);
+                discounts.push_back(arguments_.nominals[i] *
+                                    arguments_.gearings[i] *
+                                    discountCurve_->discount(paymentDate) *
+                                    arguments_.accrualTimes[i]);
+                forwards.push_back(arguments_.forwards[i]);
 
                 Date fixingDate = arguments_.fixingDates[i];
                 Time sqrtTime = 0.0;
                 if (fixingDate > today)
                     sqrtTime = std::sqrt(vol_->timeFromReference(fixingDate));
+                sqrtTimes.push_back(sqrtTime);
+            }
+        }
 
-                if (type == CapFloor::Cap || type == CapFloor::Collar) {
-                    Rate strike = arguments_.capRates[i];
-                    if (sqrtTime>0.0) {
-                        stdDevs[i] = std::sqrt(vol_->blackVariance(fixingDate,
-                                                                   strike));
-                        vegas[i] = blackFormulaStdDevDerivative(strike,
-                            forward, stdDevs[i], d, displacement_) * sqrtTime;
-                    }
-                    // include caplets with past fixing date
-                    values[i] = blackFormula(Option::Call,
-                        strike, forward, stdDevs[i], d, displacement_);
-                }
-                if (type == CapFloor::Floor || type == CapFloor::Collar) {
-                    Rate strike = arguments_.floorRates[i];
-                    Real floorletVega = 0.0;
-                    if (sqrtTime>0.0) {
-                        stdDevs[i] = std::sqrt(vol_->blackVariance(fixingDate,
-                                                                   strike));
-                        floorletVega = blackFormulaStdDevDerivative(strike,
-                            forward, stdDevs[i], d, displacement_) * sqrtTime;
-                    }
-                    Real floorlet = blackFormula(Option::Put,
-                        strike, forward, stdDevs[i], d, displacement_);
-                    if (type == CapFloor::Floor) {
-                        values[i] = floorlet;
-                        vegas[i] = floorletVega;
-                    } else {
-                        // a collar is long a cap and short a floor
-                        values[i] -= floorlet;
-                        vegas[i] -= floorletVega;
-                    }
+        Size n = alive.size();
+        std::vector<Real> strikes(n), devs(n), prices(n), derivatives(n);
+        for (Size leg=0; leg<2 && n>0; ++leg) {
+            Option::Type optionType;
+            if (leg == 0) {
+                if (type == CapFloor::Floor)
+                    continue;
+                optionType = Option::Call;
+            } else {
+                if (type == CapFloor::Cap)
+                    continue;
+                optionType = Option::Put;
+            }
+            const std::vector<Rate>& rates =
+                optionType == Option::Call ? arguments_.capRates
+                                           : arguments_.floorRates;
+
+            for (Size j=0; j<n; ++j) {
+                Size i = alive[j];
+                strikes[j] = rates[i];
+                // caplets with past fixing date are included with
+                // null standard deviation
+                devs[j] = sqrtTimes[j] > 0.0 ?
+                    std::sqrt(vol_->blackVariance(arguments_.fixingDates[i],
+                                                  strikes[j])) :
+                    0.0;
+            }
+
+            blackFormula(optionType, n, &strikes[0], &forwards[0],
+                         &devs[0], &discounts[0], &prices[0],
+                         &derivatives[0], displacement_);
+
+            for (Size j=0; j<n; ++j) {
+                Size i = alive[j];
+                stdDevs[i] = devs[j];
+                Real optionletVega = derivatives[j] * sqrtTimes[j];
+                if (type == CapFloor::Collar && optionType == Option::Put) {
+                    // a collar is long a cap and short a floor
+                    values[i] -= prices[j];
+                    vegas[i] -= optionletVega;
+                } else {
+                    values[i] = prices[j];
+                    vegas[i] = optionletVega;
                 }
-                value += values[i];
-                vega += vegas[i];
             }
         }
+
+        for (Size j=0; j<n; ++j) {
+            value += values[alive[j]];
+            vega += vegas[alive[j]];
+        }
         results_.value = value;
         results_.additionalResults["vega"] = vega;
 
@@ -49,6 +49,147 @@ namespace QuantLib {
         registerWith(discountCurve_);
     }
 
+    void IsdaCdsEngine::update() {
+        curveState_.clear();
+        CreditDefaultSwap::engine::update();
+    }
+
+    /* The curves might also be modified without notification, e.g.,
+       while a piecewise curve is being bootstrapped; therefore, their
+       nodes and data are compared with those of the curves on which
+       the stored results were calculated. */
+    const std::vector<Date>& IsdaCdsEngine::nodes() const {
+
+        // collect nodes from both curves and sort them
+        std::vector<Date> yDates, cDates;
+        std::vector<Real> state;
+        state.push_back(discountCurve_->referenceDate().serialNumber());
+        state.push_back(probability_->referenceDate().serialNumber());
+
+        if(boost::shared_ptr<InterpolatedDiscountCurve<LogLinear> > castY1 =
+            boost::dynamic_pointer_cast<
+                InterpolatedDiscountCurve<LogLinear> >(*discountCurve_)) {
+            yDates = castY1->dates();
+            state.insert(state.end(),
+                         castY1->data().begin(), castY1->data().end());
+        } else if(boost::shared_ptr<InterpolatedForwardCurve<BackwardFlat> >
+        castY2 = boost::dynamic_pointer_cast<
+            InterpolatedForwardCurve<BackwardFlat> >(*discountCurve_)) {
+            yDates = castY2->dates();
+            state.insert(state.end(),
+                         castY2->data().begin(), castY2->data().end());
+        } else if(boost::shared_ptr<InterpolatedForwardCurve<ForwardFlat> >
+        castY3 = boost::dynamic_pointer_cast<
+            InterpolatedForwardCurve<ForwardFlat> >(*discountCurve_)) {
+            yDates = castY3->dates();
+            state.insert(state.end(),
+                         castY3->data().begin(), castY3->data().end());
+        } else if(boost::shared_ptr<FlatForward> castY4 =
+            boost::dynamic_pointer_cast<FlatForward>(*discountCurve_)) {
+            state.push_back(castY4->discount(1.0));
+        } else {
+            QL_FAIL("Yield curve must be flat forward interpolated");
+        }
+
+        if(boost::shared_ptr<InterpolatedSurvivalProbabilityCurve<LogLinear> >
+        castC1 = boost::dynamic_pointer_cast<
+            InterpolatedSurvivalProbabilityCurve<LogLinear> >(
+            *probability_)) {
+            cDates = castC1->dates();
+            state.insert(state.end(),
+                         castC1->data().begin(), castC1->data().end());
+        } else if(
+        boost::shared_ptr<InterpolatedHazardRateCurve<BackwardFlat> > castC2 =
+            boost::dynamic_pointer_cast<
+            InterpolatedHazardRateCurve<BackwardFlat> >(*probability_)) {
+            cDates = castC2->dates();
+            state.insert(state.end(),
+                         castC2->data().begin(), castC2->data().end());
+        } else if(
+        boost::shared_ptr<FlatHazardRate> castC3 =
+            boost::dynamic_pointer_cast<FlatHazardRate>(*probability_)) {
+            state.push_back(castC3->survivalProbability(1.0));
+        } else{
+            QL_FAIL("Credit curve must be flat forward interpolated");
+        }
+
+        std::vector<Date> nodes;
+        std::set_union(yDates.begin(), yDates.end(), cDates.begin(), cDates.end(), std::back_inserter(nodes));
+        for (Size i=0; i<nodes.size(); ++i)
+            state.push_back(nodes[i].serialNumber());
+
+        if (state == curveState_)
+            return nodes_;
+
+        curveState_.swap(state);
+        nodes_.swap(nodes);
+        discounts_.clear();
+        survivalProbabilities_.clear();
+        protectionStart_ = Date();
+        protectionSums_.clear();
+        return nodes_;
+    }
+
+    DiscountFactor IsdaCdsEngine::discount(const Date& d) const {
+        std::map<Date, DiscountFactor>::const_iterator i = discounts_.find(d);
+        if (i != discounts_.end())
+            return i->second;
+        DiscountFactor P = discountCurve_->discount(d);
+        discounts_.insert(std::make_pair(d, P));
+        return P;
+    }
+
+    Probability IsdaCdsEngine::survivalProbability(const Date& d) const {
+        std::map<Date, Probability>::const_iterator i =
+            survivalProbabilities_.find(d);
+        if (i != survivalProbabilities_.end())
+            return i->second;
+        Probability Q = probability_->survivalProbability(d);
+        survivalProbabilities_.insert(std::make_pair(d, Q));
+        return Q;
+    }
+
+    Real IsdaCdsEngine::protectionIncrement(Real P0, Real Q0,
+                                            Real P1, Real Q1) const {
+        const Real nFix = (numericalFix_ == None ? 1E-50 : 0.0);
+
+        Real fhat = std::log(P0) - std::log(P1);
+        Real hhat = std::log(Q0) - std::log(Q1);
+        Real fhphh = fhat + hhat;
+
+        if (fhphh < 1E-4 && numericalFix_ == Taylor) {
+            Real fhphhq = fhphh * fhphh;
+            return P0 * Q0 * hhat * (1.0 - 0.5 * fhphh + 1.0 / 6.0 * fhphhq -
+                                     1.0 / 24.0 * fhphhq * fhphh +
+                                     1.0 / 120 * fhphhq * fhphhq);
+        } else {
+            return hhat / (fhphh + nFix) * (P0 * Q0 - P1 * Q1);
+        }
+    }
+
+    /* Protection (per unit claim) from the day before the given start
+       to the n-th node following it.  The partial sums are extended
+       only as far as required, so that the curves are not asked for
+       dates after the maturities being priced.  The nodes must be up
+       to date. */
+    Real IsdaCdsEngine::protectionSum(const Date& start, Size n) const {
+        if (start != protectionStart_) {
+            protectionSums_.assign(1, 0.0);
+            protectionStart_ = start;
+        }
+
+        std::vector<Date>::const_iterator first =
+            std::upper_bound(nodes_.begin(), nodes_.end(), start);
+        for (Size k=protectionSums_.size(); k<=n; ++k) {
+            Date d0 = (k == 1 ? start-1 : *(first+(k-2)));
+            Date d1 = *(first+(k-1));
+            protectionSums_.push_back(protectionSums_.back() +
+                protectionIncrement(discount(d0), survivalProbability(d0),
+                                    discount(d1), survivalProbability(d1)));
+        }
+        return protectionSums_[n];
+    }
+
     void IsdaCdsEngine::calculate() const {
 
         QL_REQUIRE(numericalFix_ == None || numericalFix_ == Taylor,
@@ -102,89 +243,42 @@ namespace QuantLib {
         Date effectiveProtectionStart =
             std::max<Date>(arguments_.protectionStart, evalDate + 1);
 
-        // collect nodes from both curves and sort them
-        std::vector<Date> yDates, cDates;
-
-        if(boost::shared_ptr<InterpolatedDiscountCurve<LogLinear> > castY1 =
-            boost::dynamic_pointer_cast<
-                InterpolatedDiscountCurve<LogLinear> >(*discountCurve_)) {
-            yDates = castY1->dates();
-        } else if(boost::shared_ptr<InterpolatedForwardCurve<BackwardFlat> >
-        castY2 = boost::dynamic_pointer_cast<
-            InterpolatedForwardCurve<BackwardFlat> >(*discountCurve_)) {
-            yDates = castY2->dates();
-        } else if(boost::shared_ptr<InterpolatedForwardCurve<ForwardFlat> >
-        castY3 = boost::dynamic_pointer_cast<
-            InterpolatedForwardCurve<ForwardFlat> >(*discountCurve_)) {
-            yDates = castY3->dates();
-        } else if(boost::shared_ptr<FlatForward> castY4 =
-            boost::dynamic_pointer_cast<FlatForward>(*discountCurve_)) {
-        } else {
-            QL_FAIL("Yield curve must be flat forward interpolated");
-        }
-
-        if(boost::shared_ptr<InterpolatedSurvivalProbabilityCurve<LogLinear> >
-        castC1 = boost::dynamic_pointer_cast<
-            InterpolatedSurvivalProbabilityCurve<LogLinear> >(
-            *probability_)) {
-            cDates = castC1->dates();
-        } else if(
-        boost::shared_ptr<InterpolatedHazardRateCurve<BackwardFlat> > castC2 =
-            boost::dynamic_pointer_cast<
-            InterpolatedHazardRateCurve<BackwardFlat> >(*probability_)) {
-            cDates = castC2->dates();
-        } else if(
-        boost::shared_ptr<FlatHazardRate> castC3 =
-            boost::dynamic_pointer_cast<FlatHazardRate>(*probability_)) {
-        } else{
-            QL_FAIL("Credit curve must be flat forward interpolated");
-        }
-
-        std::vector<Date> nodes;
-        std::set_union(yDates.begin(), yDates.end(), cDates.begin(), cDates.end(), std::back_inserter(nodes));
-
-
-        if(nodes.empty()){
-            nodes.push_back(maturity);
-        }
+        const std::vector<Date>& curveNodes = this->nodes();
+        bool flatCurves = curveNodes.empty();
+        // with flat curves, the only node is the maturity
+        std::vector<Date> maturityNode(1, maturity);
+        const std::vector<Date>& nodes =
+            flatCurves ? maturityNode : curveNodes;
         const Real nFix = (numericalFix_ == None ? 1E-50 : 0.0);
 
         // protection leg pricing (npv is always negative at this stage)
         Real protectionNpv = 0.0;
 
-        Date d0 = effectiveProtectionStart-1;
-        Real P0 = discountCurve_->discount(d0);
-        Real Q0 = probability_->survivalProbability(d0);
-        Date d1;
-        std::vector<Date>::const_iterator it =
-            std::upper_bound(nodes.begin(), nodes.end(), effectiveProtectionStart);
-
-        for(;it != nodes.end(); ++it) {
-            if(*it > maturity) {
-                d1 = maturity;
-                it = nodes.end() - 1; //early exit
-            } else {
-                d1 = *it;
+        std::vector<Date>::const_iterator first =
+            std::upper_bound(nodes.begin(), nodes.end(),
+                             effectiveProtectionStart);
+        std::vector<Date>::const_iterator last =
+            std::upper_bound(first, nodes.end(), maturity);
+        if (flatCurves) {
+            if (first != nodes.end()) {
+                Date d0 = effectiveProtectionStart-1;
+                protectionNpv = protectionIncrement(
+                    discount(d0), survivalProbability(d0),
+                    discount(maturity), survivalProbability(maturity));
             }
-            Real P1 = discountCurve_->discount(d1);
-            Real Q1 = probability_->survivalProbability(d1);
-
-            Real fhat = std::log(P0) - std::log(P1);
-            Real hhat = std::log(Q0) - std::log(Q1);
-            Real fhphh = fhat + hhat;
-
-            if (fhphh < 1E-4 && numericalFix_ == Taylor) {
-                Real fhphhq = fhphh * fhphh;
-                protectionNpv +=
-                    P0 * Q0 * hhat * (1.0 - 0.5 * fhphh + 1.0 / 6.0 * fhphhq -
-                                      1.0 / 24.0 * fhphhq * fhphh +
-                                      1.0 / 120 * fhphhq * fhphhq);
-            } else {
-                protectionNpv += hhat / (fhphh + nFix) * (P0 * Q0 - P1 * Q1);
+        } else {
+            // the full node intervals up to the maturity are shared
+            // with the other CDS priced on the same curves...
+            protectionNpv =
+                protectionSum(effectiveProtectionStart, last - first);
+            // ...and the last one is cut at the maturity
+            if (last != nodes.end()) {
+                Date d0 = (last == first ? effectiveProtectionStart-1
+                                         : *(last-1));
+                protectionNpv += protectionIncrement(
+                    discount(d0), survivalProbability(d0),
+                    discount(maturity), survivalProbability(maturity));
             }
-            d0 = d1;
-            P0 = P1;
-            Q0 = Q1;
         }
         protectionNpv *= arguments_.claim->amount(
             Null<Date>(), arguments_.notional, recoveryRate_);
@@ -210,8 +304,8 @@ namespace QuantLib {
                                                 includeSettlementDateFlows_)) {
                 premiumNpv +=
                     coupon->amount() *
-                    discountCurve_->discount(coupon->date()) *
-                    probability_->survivalProbability(coupon->date()-1);
+                    discount(coupon->date()) *
+                    survivalProbability(coupon->date()-1);
             }
 
             // default accruals
@@ -239,13 +333,13 @@ namespace QuantLib {
                 Real defaultAccrThisNode = 0.;
                 std::vector<Date>::const_iterator node = localNodes.begin();
                 Real t0 = discountCurve_->timeFromReference(*node);
-                Real P0 = discountCurve_->discount(*node);
-                Real Q0 = probability_->survivalProbability(*node);
+                Real P0 = discount(*node);
+                Real Q0 = survivalProbability(*node);
 
                 for (++node; node != localNodes.end(); ++node) {
                     Real t1 = discountCurve_->timeFromReference(*node);
-                    Real P1 = discountCurve_->discount(*node);
-                    Real Q1 = probability_->survivalProbability(*node);
+                    Real P1 = discount(*node);
+                    Real Q1 = survivalProbability(*node);
                     Real fhat = std::log(P0) - std::log(P1);
                     Real hhat = std::log(Q0) - std::log(Q1);
                     Real fhphh = fhat + hhat;
@@ -28,6 +28,7 @@
 #include <ql/instruments/creditdefaultswap.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/termstructures/defaulttermstructure.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -92,6 +93,13 @@ namespace QuantLib {
 
             Furthermore, the ibor index in the swap rate helpers should not
             provide the evaluation date's fixing.
+
+            The discount factors and survival probabilities used, and
+            the protection leg integrals over the merged curve nodes,
+            are stored until either curve changes.  Thus, a number of
+            CDS sharing the same engine (e.g., a maturity strip on a
+            single name) only pay for the work depending on their own
+            schedules.
         */
 
         IsdaCdsEngine(
@@ -111,8 +119,15 @@ namespace QuantLib {
         }
 
         void calculate() const;
+        void update();
 
       private:
+        const std::vector<Date>& nodes() const;
+        DiscountFactor discount(const Date& d) const;
+        Probability survivalProbability(const Date& d) const;
+        Real protectionIncrement(Real P0, Real Q0, Real P1, Real Q1) const;
+        Real protectionSum(const Date& start, Size n) const;
+
         Handle<DefaultProbabilityTermStructure> probability_;
         const Real recoveryRate_;
         Handle<YieldTermStructure> discountCurve_;
@@ -120,6 +135,13 @@ namespace QuantLib {
         const NumericalFix numericalFix_;
         const AccrualBias accrualBias_;
         const ForwardsInCouponPeriod forwardsInCouponPeriod_;
+        // work shared among calculations on the same curves
+        mutable std::vector<Real> curveState_;
+        mutable std::vector<Date> nodes_;
+        mutable std::map<Date, DiscountFactor> discounts_;
+        mutable std::map<Date, Probability> survivalProbabilities_;
+        mutable Date protectionStart_;
+        mutable std::vector<Real> protectionSums_;
     };
 }
 
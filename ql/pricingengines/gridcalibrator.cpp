@@ -0,0 +1,183 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/gridcalibrator.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace QuantLib {
+
+    namespace {
+
+        Size refinedSize(Size n, Real factor) {
+            return n == 0 ? 0 : Size(std::ceil(n*factor - 1.0e-8));
+        }
+
+    }
+
+    GridCalibrator::Grid GridCalibrator::Grid::refined(Real factor) const {
+        return Grid(refinedSize(tGrid, factor),
+                    refinedSize(xGrid, factor),
+                    refinedSize(vGrid, factor),
+                    dampingSteps);
+    }
+
+    GridCalibrator::GridCalibrator(const EngineFactory& factory,
+                                   const Grid& coarsestGrid,
+                                   Real tolerance,
+                                   Size maxLevels,
+                                   Real refinement,
+                                   const std::vector<Time>& maturityBuckets,
+                                   const std::vector<Real>& moneynessBuckets)
+    : factory_(factory), coarsestGrid_(coarsestGrid), tolerance_(tolerance),
+      maxLevels_(maxLevels), refinement_(refinement),
+      maturityBuckets_(maturityBuckets), moneynessBuckets_(moneynessBuckets) {
+        QL_REQUIRE(!factory_.empty(), "no engine factory given");
+        QL_REQUIRE(tolerance_ > 0.0,
+                   "positive tolerance required: " << tolerance_
+                   << " not allowed");
+        QL_REQUIRE(maxLevels_ >= 3,
+                   "at least three levels required: " << maxLevels_
+                   << " not allowed");
+        QL_REQUIRE(refinement_ > 1.0,
+                   "refinement factor must be greater than one: "
+                   << refinement_ << " not allowed");
+        QL_REQUIRE(std::adjacent_find(maturityBuckets_.begin(),
+                                      maturityBuckets_.end(),
+                                      std::greater_equal<Time>())
+                   == maturityBuckets_.end(),
+                   "maturity buckets must be increasing");
+        QL_REQUIRE(std::adjacent_find(moneynessBuckets_.begin(),
+                                      moneynessBuckets_.end(),
+                                      std::greater_equal<Real>())
+                   == moneynessBuckets_.end(),
+                   "moneyness buckets must be increasing");
+    }
+
+    GridCalibrator::Study GridCalibrator::study(
+                                            Instrument& instrument) const {
+        Study s;
+        s.selected = Null<Size>();
+        s.extrapolatedPrice = Null<Real>();
+        s.order = Null<Real>();
+
+        Grid grid = coarsestGrid_;
+        for (Size k=0; k<maxLevels_; ++k) {
+            instrument.setPricingEngine(factory_(grid));
+            s.grids.push_back(grid);
+            s.prices.push_back(instrument.NPV());
+            s.errors.push_back(Null<Real>());
+            grid = grid.refined(refinement_);
+            if (k < 2)
+                continue;
+
+            // Richardson extrapolation from the last three prices
+            Real d1 = s.prices[k-1] - s.prices[k-2];
+            Real d2 = s.prices[k] - s.prices[k-1];
+            if (std::fabs(d2) < std::fabs(d1) || d1 == 0.0) {
+                // converging: if the differences decrease by the ratio
+                // r at each level, the ones still to come add up to
+                // d2/(r-1).
+                Real tail = 0.0;
+                s.order = Null<Real>();
+                if (d2 != 0.0) {
+                    Real r = d1/d2;
+                    tail = d2/(r-1.0);
+                    s.order = std::log(std::fabs(r))/std::log(refinement_);
+                }
+                s.extrapolatedPrice = s.prices[k] + tail;
+                s.errors[k] = std::fabs(tail);
+                s.errors[k-1] = std::fabs(d2 + tail);
+            } else {
+                // not converging yet: no better estimate than the
+                // last differences
+                s.order = Null<Real>();
+                s.extrapolatedPrice = s.prices[k];
+                s.errors[k] = std::max(std::fabs(d1), std::fabs(d2));
+            }
+
+            if (s.errors[k-1] != Null<Real>() &&
+                s.errors[k-1] <= tolerance_) {
+                s.selected = k-1;
+                return s;
+            }
+            if (s.errors[k] <= tolerance_) {
+                s.selected = k;
+                return s;
+            }
+        }
+
+        QL_FAIL("tolerance " << tolerance_ << " not reached with "
+                << maxLevels_ << " grids; last price "
+                << s.prices.back() << ", estimated error "
+                << s.errors.back());
+    }
+
+    GridCalibrator::Grid GridCalibrator::grid(
+                                            const std::string& productClass,
+                                            Time maturity,
+                                            Real moneyness,
+                                            Instrument& instrument) {
+        Key k = key(productClass, maturity, moneyness);
+        std::map<Key, Grid>::const_iterator i = grids_.find(k);
+        if (i != grids_.end())
+            return i->second;
+        Study s = study(instrument);
+        return grids_[k] = s.grids[s.selected];
+    }
+
+    boost::shared_ptr<PricingEngine> GridCalibrator::engine(
+                                            const std::string& productClass,
+                                            Time maturity,
+                                            Real moneyness) const {
+        std::map<Key, Grid>::const_iterator i =
+            grids_.find(key(productClass, maturity, moneyness));
+        QL_REQUIRE(i != grids_.end(),
+                   "no grid calibrated for " << productClass
+                   << " with maturity " << maturity
+                   << " and moneyness " << moneyness);
+        return factory_(i->second);
+    }
+
+    bool GridCalibrator::hasGrid(const std::string& productClass,
+                                 Time maturity,
+                                 Real moneyness) const {
+        return grids_.find(key(productClass, maturity, moneyness))
+            != grids_.end();
+    }
+
+    void GridCalibrator::setGrid(const std::string& productClass,
+                                 Time maturity,
+                                 Real moneyness,
+                                 const Grid& grid) {
+        grids_[key(productClass, maturity, moneyness)] = grid;
+    }
+
+    GridCalibrator::Key GridCalibrator::key(const std::string& productClass,
+                                            Time maturity,
+                                            Real moneyness) const {
+        Size m = std::lower_bound(maturityBuckets_.begin(),
+                                  maturityBuckets_.end(), maturity)
+            - maturityBuckets_.begin();
+        Size x = std::lower_bound(moneynessBuckets_.begin(),
+                                  moneynessBuckets_.end(), moneyness)
+            - moneynessBuckets_.begin();
+        return std::make_pair(productClass, std::make_pair(m, x));
+    }
+
+}
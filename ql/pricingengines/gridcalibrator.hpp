@@ -0,0 +1,171 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file gridcalibrator.hpp
+    \brief accuracy-targeted choice of finite-difference and tree grids
+*/
+
+#ifndef quantlib_grid_calibrator_hpp
+#define quantlib_grid_calibrator_hpp
+
+#include <ql/instrument.hpp>
+#include <boost/function.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! accuracy-targeted choice of finite-difference and tree grids
+    /*! The calibrator runs a convergence study on a representative
+        instrument.  It prices the instrument on a sequence of grids,
+        each one refined by a constant factor in every dimension,
+        and estimates the error of each price by Richardson
+        extrapolation from the observed order of convergence.  The
+        coarsest grid whose estimated error is below the tolerance is
+        selected.
+
+        The engines are built by a user-provided factory, which
+        passes the grid sizes to the constructor of the engine in
+        use; e.g., tGrid, xGrid and dampingSteps to
+        FdBlackScholesVanillaEngine, all four sizes to
+        FdHestonVanillaEngine or FdHestonBarrierEngine, or tGrid as
+        the number of time steps to BinomialVanillaEngine.
+
+        The selected grids are cached by product class, maturity
+        bucket and moneyness bucket, so that the study is run once
+        for each bucket and the chosen grid can be reused for other
+        instruments falling in the same bucket.
+
+        \warning The error estimate assumes that the prices are in
+                 the asymptotic regime of convergence on the
+                 refined grids.  Engines whose convergence is not
+                 monotonic, such as binomial trees on options with
+                 strikes between nodes, should be calibrated with a
+                 refinement factor preserving the node alignment, or
+                 smoothed (e.g., with the Leisen-Reimer tree.)
+
+        \ingroup engines
+    */
+    class GridCalibrator {
+      public:
+        //! grid sizes passed to the engine factory
+        struct Grid {
+            Grid(Size tGrid = 100, Size xGrid = 100,
+                 Size vGrid = 50, Size dampingSteps = 0)
+            : tGrid(tGrid), xGrid(xGrid), vGrid(vGrid),
+              dampingSteps(dampingSteps) {}
+            /*! returns the grid refined by the given factor in time
+                and space; damping steps are not changed.
+            */
+            Grid refined(Real factor) const;
+            Size tGrid, xGrid, vGrid, dampingSteps;
+        };
+        //! results of a convergence study
+        struct Study {
+            //! the grids used, from the coarsest
+            std::vector<Grid> grids;
+            std::vector<Real> prices;
+            //! the estimated errors; null when not available
+            std::vector<Real> errors;
+            //! the index of the selected grid
+            Size selected;
+            //! the extrapolated price
+            Real extrapolatedPrice;
+            //! the observed order of convergence
+            Real order;
+        };
+        typedef boost::function<
+            boost::shared_ptr<PricingEngine>(const Grid&)> EngineFactory;
+        /*! \param factory       builds an engine using the given grid.
+            \param coarsestGrid  the first grid of the study.
+            \param tolerance     the required absolute accuracy of the
+                                 price.
+            \param maxLevels     the maximum number of grids priced
+                                 in the study; at least three are
+                                 needed for the error estimate.
+            \param refinement    the factor by which the grid sizes
+                                 are increased at each level.
+            \param maturityBuckets  upper bounds (included) of the
+                                    maturity buckets; maturities
+                                    above the last one fall in a
+                                    further bucket.
+            \param moneynessBuckets upper bounds (included) of the
+                                    moneyness buckets, defined as
+                                    above.
+        */
+        GridCalibrator(const EngineFactory& factory,
+                       const Grid& coarsestGrid,
+                       Real tolerance,
+                       Size maxLevels = 6,
+                       Real refinement = 2.0,
+                       const std::vector<Time>& maturityBuckets =
+                                                      std::vector<Time>(),
+                       const std::vector<Real>& moneynessBuckets =
+                                                      std::vector<Real>());
+        //! runs a convergence study on the given instrument
+        /*! The pricing engine of the instrument is replaced by the
+            ones built by the factory.  The selected grid is not
+            cached.  An exception is raised if the tolerance can't be
+            met within the maximum number of levels.
+        */
+        Study study(Instrument& instrument) const;
+        //! returns the grid for the given bucket
+        /*! If no grid was chosen yet for the bucket, a convergence
+            study is run on the given instrument and the selected grid
+            is cached.
+        */
+        Grid grid(const std::string& productClass,
+                  Time maturity,
+                  Real moneyness,
+                  Instrument& instrument);
+        //! returns an engine using the grid cached for the bucket
+        boost::shared_ptr<PricingEngine> engine(
+                                        const std::string& productClass,
+                                        Time maturity,
+                                        Real moneyness) const;
+        //! \name Cache management
+        //@{
+        bool hasGrid(const std::string& productClass,
+                     Time maturity,
+                     Real moneyness) const;
+        //! stores a grid, e.g., the result of a previous calibration
+        void setGrid(const std::string& productClass,
+                     Time maturity,
+                     Real moneyness,
+                     const Grid& grid);
+        Size size() const { return grids_.size(); }
+        void clear() { grids_.clear(); }
+        //@}
+      private:
+        typedef std::pair<std::string, std::pair<Size, Size> > Key;
+        Key key(const std::string& productClass,
+                Time maturity,
+                Real moneyness) const;
+        EngineFactory factory_;
+        Grid coarsestGrid_;
+        Real tolerance_;
+        Size maxLevels_;
+        Real refinement_;
+        std::vector<Time> maturityBuckets_;
+        std::vector<Real> moneynessBuckets_;
+        std::map<Key, Grid> grids_;
+    };
+
+}
+
+#endif
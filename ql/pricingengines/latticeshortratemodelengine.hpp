@@ -49,9 +49,19 @@ namespace QuantLib {
                                const TimeGrid& timeGrid);
         void update();
       protected:
+        //! lattice on a grid containing the given mandatory times
+        /*! The lattice is reused by later calls with the same
+            mandatory times until the model changes, so that
+            instruments with the same schedule share it.
+        */
+        boost::shared_ptr<Lattice> latticeFor(
+                               const std::vector<Time>& mandatoryTimes) const;
         TimeGrid timeGrid_;
         Size timeSteps_;
         boost::shared_ptr<Lattice> lattice_;
+      private:
+        mutable std::vector<Time> latticeTimes_;
+        mutable boost::shared_ptr<Lattice> cachedLattice_;
     };
 
     template <class Arguments, class Results>
@@ -90,9 +100,24 @@ namespace QuantLib {
     {
         if (!timeGrid_.empty())
             lattice_ = this->model_->tree(timeGrid_);
+        cachedLattice_.reset();
+        latticeTimes_.clear();
         GenericModelEngine<ShortRateModel, Arguments, Results>::update();
     }
 
+    template <class Arguments, class Results>
+    boost::shared_ptr<Lattice>
+    LatticeShortRateModelEngine<Arguments, Results>::latticeFor(
+                            const std::vector<Time>& mandatoryTimes) const {
+        if (!cachedLattice_ || mandatoryTimes != latticeTimes_) {
+            TimeGrid timeGrid(mandatoryTimes.begin(), mandatoryTimes.end(),
+                              timeSteps_);
+            cachedLattice_ = this->model_->tree(timeGrid);
+            latticeTimes_ = mandatoryTimes;
+        }
+        return cachedLattice_;
+    }
+
 }
 
 
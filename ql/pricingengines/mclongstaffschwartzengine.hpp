@@ -91,6 +91,10 @@ namespace QuantLib {
       protected:
         virtual boost::shared_ptr<LongstaffSchwartzPathPricer<path_type> >
                                                    lsmPathPricer() const = 0;
+        /*! calibrates the path pricer; by default, the calibration
+            paths are simulated forwards and stored by the pricer.
+        */
+        virtual void calibratePathPricer() const;
 
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_pricer_type> pathPricer() const;
@@ -183,6 +187,24 @@ namespace QuantLib {
                                           RNG_Calibration>::calculate() const {
         // calibration
         pathPricer_ = this->lsmPathPricer();
+        this->calibratePathPricer();
+        // pricing
+        McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
+                                          requiredSamples_,
+                                          maxSamples_);
+        this->results_.value = this->mcModel_->sampleAccumulator().mean();
+        this->results_.additionalResults["exerciseProbability"] =
+            this->pathPricer_->exerciseProbability();
+        if (RNG::allowsErrorEstimate) {
+            this->results_.errorEstimate =
+                this->mcModel_->sampleAccumulator().errorEstimate();
+        }
+    }
+
+    template <class GenericEngine, template <class> class MC, class RNG,
+              class S, class RNG_Calibration>
+    inline void MCLongstaffSchwartzEngine<GenericEngine, MC, RNG, S,
+                                RNG_Calibration>::calibratePathPricer() const {
         Size dimensions = process_->factors();
         TimeGrid grid = this->timeGrid();
         typename RNG_Calibration::rsg_type generator =
@@ -200,17 +222,6 @@ namespace QuantLib {
 
         mcModelCalibration_->addSamples(nCalibrationSamples_);
         pathPricer_->calibrate();
-        // pricing
-        McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
-                                          requiredSamples_,
-                                          maxSamples_);
-        this->results_.value = this->mcModel_->sampleAccumulator().mean();
-        this->results_.additionalResults["exerciseProbability"] =
-            this->pathPricer_->exerciseProbability();
-        if (RNG::allowsErrorEstimate) {
-            this->results_.errorEstimate =
-                this->mcModel_->sampleAccumulator().errorEstimate();
-        }
     }
 
     template <class GenericEngine, template <class> class MC, class RNG,
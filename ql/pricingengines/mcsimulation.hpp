@@ -28,6 +28,10 @@
 
 #include <ql/grid.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <ql/methods/montecarlo/samplecommunicator.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/array.hpp>
+#include <boost/weak_ptr.hpp>
 
 namespace QuantLib {
 
@@ -37,6 +41,47 @@ namespace QuantLib {
         Carlo engine.
 
         See McVanillaEngine as an example.
+
+        Samples can be drawn by several worker threads when the
+        library is compiled with OpenMP support.  In this case, each
+        worker uses its own path generator and pricer, as returned by
+        workerPathGenerator() and workerPathPricer(); each batch of
+        samples is split evenly among the workers and the drawn
+        samples are added to the accumulator in worker order, so that
+        results are reproducible for a given seed and number of
+        workers.  Without OpenMP, the workers are run sequentially and
+        the results are the same.
+
+        The samples can also be distributed among several processes,
+        e.g., with MPI, by passing a communicator to
+        distributeSamples().  Each batch of samples is then split
+        among the processes, each of which skips ahead in the random
+        stream to its own block; the drawn values are collected in
+        all the processes and added to the accumulators in process
+        order.  Each process thus holds the statistics of the whole
+        simulation, and the tolerance-driven loop reaches the same
+        decisions in all of them; the results are the same as those
+        of a serial simulation with the same seed.  Distribution
+        requires pseudo-random numbers; workers are not used in this
+        mode.
+
+        When the random-number traits are randomized low-discrepancy
+        ones, e.g., RandomizedLowDiscrepancy, the simulation is run
+        as a number of independent randomizations of the sequence,
+        each with its own path generator and pricer as returned by
+        workerPathGenerator() and workerPathPricer(); they are drawn
+        in parallel with OpenMP.  Each randomization gives an
+        unbiased estimate of the price; their mean is returned, and
+        their spread gives the error estimate.  When a tolerance is
+        required, the number of samples of each randomization is
+        doubled until the error estimate is below it.  Afterwards,
+        the sample accumulator holds the results of the
+        randomizations rather than those of the single paths.
+
+        \warning in parallel mode, the stochastic process and the
+                 term structures it refers to are accessed
+                 concurrently by the path generators.  They should
+                 not perform lazy calculations during the simulation.
     */
 
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -65,11 +110,24 @@ namespace QuantLib {
         void calculate(Real requiredTolerance,
                        Size requiredSamples,
                        Size maxSamples) const;
+        //! distributes the samples among the given processes
+        /*! All the processes must price the same instrument with
+            engines built with the same parameters and seed.  A null
+            pointer restores the simulation in a single process.
+        */
+        void distributeSamples(
+                      const boost::shared_ptr<SampleCommunicator>& comm) {
+            communicator_ = comm;
+        }
       protected:
         McSimulation(bool antitheticVariate,
-                     bool controlVariate)
+                     bool controlVariate,
+                     Size workers = 1)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), workers_(workers),
+          streamPosition_(0) {
+            QL_REQUIRE(workers_ > 0, "at least one worker required");
+        }
         virtual boost::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual boost::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
@@ -87,6 +145,36 @@ namespace QuantLib {
         virtual result_type controlVariateValue() const {
             return Null<result_type>();
         }
+        //! path generator used by the given worker in parallel mode
+        /*! The first worker uses the generator returned by
+            pathGenerator(); the generators for the other workers
+            must draw from independent streams, e.g., by using the
+            seed returned by workerSeed().  The default implementation
+            returns a null pointer, in which case the samples are
+            drawn serially.
+        */
+        virtual boost::shared_ptr<path_generator_type>
+        workerPathGenerator(Size) const {
+            return boost::shared_ptr<path_generator_type>();
+        }
+        //! path pricer used by the given worker in parallel mode
+        virtual boost::shared_ptr<path_pricer_type>
+        workerPathPricer(Size) const {
+            return this->pathPricer();
+        }
+        //! seed of the random stream used by the given worker
+        /*! A null seed is passed through unchanged, so that each
+            worker is seeded by the SeedGenerator.
+        */
+        static BigNatural workerSeed(BigNatural seed, Size worker);
+        //! simulates the given number of samples
+        /*! The default implementation draws them from the model, or
+            splits them among the workers in parallel mode.  Engines
+            that draw their samples in a different way, e.g., in
+            batches, can override it; the samples must be added to
+            mcModel_ in any case.
+        */
+        virtual void addSamples(Size samples) const;
         template <class Sequence>
         static Real maxError(const Sequence& sequence) {
             return *std::max_element(sequence.begin(), sequence.end());
@@ -97,9 +185,84 @@ namespace QuantLib {
         
         mutable boost::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size workers_;
+      private:
+        void initializeWorkers(const boost::shared_ptr<path_pricer_type>&,
+                               result_type controlVariateValue) const;
+        void addDistributedSamples(Size samples) const;
+        typedef std::vector<boost::shared_ptr<MonteCarloModel<MC,RNG,S> > >
+                                                                model_list;
+        void calculateRandomizations(Real requiredTolerance,
+                                     Size requiredSamples,
+                                     Size maxSamples) const;
+        static void addRandomizedSamples(const model_list& models,
+                                         Size samples);
+        void collectRandomizations(
+                const model_list& models,
+                const boost::shared_ptr<path_generator_type>& generator,
+                const boost::shared_ptr<path_pricer_type>& pricer) const;
+        mutable model_list workerModels_;
+        boost::shared_ptr<SampleCommunicator> communicator_;
+        // the model whose stream is being split, and the number of
+        // samples of the stream drawn or skipped so far by it
+        mutable boost::weak_ptr<MonteCarloModel<MC,RNG,S> > distributedModel_;
+        mutable BigNatural streamPosition_;
     };
 
 
+    namespace detail {
+
+        // skipping ahead is only available for pseudo-random numbers
+        template <bool allowsJumpAhead>
+        struct McJumpAhead {
+            template <class Model>
+            static void apply(Model& model, BigNatural samples) {
+                model.jumpAhead(samples);
+            }
+        };
+
+        template <>
+        struct McJumpAhead<false> {
+            template <class Model>
+            static void apply(Model&, BigNatural) {
+                QL_FAIL("low-discrepancy sequences can't be distributed");
+            }
+        };
+
+        // samples are exchanged as sequences of reals
+        inline void packMcSample(Real value, std::vector<Real>& data) {
+            data.push_back(value);
+        }
+
+        inline void packMcSample(const Array& value, std::vector<Real>& data) {
+            data.push_back(static_cast<Real>(value.size()));
+            data.insert(data.end(), value.begin(), value.end());
+        }
+
+        template <class T>
+        void packMcSample(const T&, std::vector<Real>&) {
+            QL_FAIL("samples of this type can't be distributed");
+        }
+
+        inline const Real* unpackMcSample(const Real* data, Real& value) {
+            value = *data;
+            return data+1;
+        }
+
+        inline const Real* unpackMcSample(const Real* data, Array& value) {
+            Size n = static_cast<Size>(*data++);
+            value = Array(data, data+n);
+            return data+n;
+        }
+
+        template <class T>
+        const Real* unpackMcSample(const Real*, T&) {
+            QL_FAIL("samples of this type can't be distributed");
+        }
+
+    }
+
+
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline typename McSimulation<MC,RNG,S>::result_type
@@ -109,7 +272,7 @@ namespace QuantLib {
         Size sampleNumber =
             mcModel_->sampleAccumulator().samples();
         if (sampleNumber<minSamples) {
-            mcModel_->addSamples(minSamples-sampleNumber);
+            addSamples(minSamples-sampleNumber);
             sampleNumber = mcModel_->sampleAccumulator().samples();
         }
 
@@ -131,7 +294,7 @@ namespace QuantLib {
             // do not exceed maxSamples
             nextBatch = std::min(nextBatch, maxSamples-sampleNumber);
             sampleNumber += nextBatch;
-            mcModel_->addSamples(nextBatch);
+            addSamples(nextBatch);
             error = result_type(mcModel_->sampleAccumulator().errorEstimate());
         }
 
@@ -149,7 +312,7 @@ namespace QuantLib {
                    "number of already simulated samples (" << sampleNumber
                    << ") greater than requested samples (" << samples << ")");
 
-        mcModel_->addSamples(samples-sampleNumber);
+        addSamples(samples-sampleNumber);
 
         return result_type(mcModel_->sampleAccumulator().mean());
     }
@@ -164,6 +327,12 @@ namespace QuantLib {
                    requiredSamples != Null<Size>(),
                    "neither tolerance nor number of samples set");
 
+        if (detail::RandomizedReplications<RNG>::value > 0) {
+            calculateRandomizations(requiredTolerance, requiredSamples,
+                                    maxSamples);
+            return;
+        }
+
         //! Initialize the one-factor Monte Carlo
         if (this->controlVariate_) {
 
@@ -187,12 +356,21 @@ namespace QuantLib {
                            pathGenerator(), this->pathPricer(), stats_type(),
                            this->antitheticVariate_, controlPP,
                            controlVariateValue, controlPG));
+
+            if (controlPG)
+                // the control paths can't be split among workers
+                workerModels_.clear();
+            else
+                initializeWorkers(controlPP, controlVariateValue);
         } else {
             this->mcModel_ =
                 boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), S(),
                            this->antitheticVariate_));
+
+            initializeWorkers(boost::shared_ptr<path_pricer_type>(),
+                              result_type());
         }
 
         if (requiredTolerance != Null<Real>()) {
@@ -206,6 +384,276 @@ namespace QuantLib {
 
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::initializeWorkers(
+                     const boost::shared_ptr<path_pricer_type>& controlPP,
+                     result_type controlVariateValue) const {
+
+        workerModels_.clear();
+        // low-discrepancy sequences can't be split by reseeding
+        if (workers_ == 1 || !RNG::allowsErrorEstimate)
+            return;
+
+        workerModels_.push_back(mcModel_);
+        for (Size i=1; i<workers_; ++i) {
+            boost::shared_ptr<path_generator_type> generator =
+                this->workerPathGenerator(i);
+            if (!generator) {
+                // the engine doesn't support parallel simulation
+                workerModels_.clear();
+                return;
+            }
+            boost::shared_ptr<path_pricer_type> cvPathPricer;
+            if (controlPP)
+                cvPathPricer = this->controlPathPricer();
+            workerModels_.push_back(
+                boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                    new MonteCarloModel<MC,RNG,S>(
+                           generator, this->workerPathPricer(i), S(),
+                           this->antitheticVariate_, cvPathPricer,
+                           controlVariateValue)));
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::addSamples(Size samples) const {
+
+        if (communicator_) {
+            addDistributedSamples(samples);
+            return;
+        }
+
+        if (workerModels_.empty()) {
+            mcModel_->addSamples(samples);
+            return;
+        }
+
+        Size n = workerModels_.size();
+        std::vector<std::vector<std::pair<result_type,Real> > > values(n);
+        std::vector<std::string> errors(n);
+        // not vector<bool>, whose elements can't be written
+        // concurrently
+        std::vector<int> failed(n, 0);
+
+        #pragma omp parallel for num_threads(n) schedule(static)
+        for (Size i=0; i<n; ++i) {
+            Size batch = samples/n + (i < samples%n ? 1 : 0);
+            try {
+                workerModels_[i]->drawSamples(batch, values[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+                failed[i] = 1;
+            } catch (...) {
+                errors[i] = "unknown error";
+                failed[i] = 1;
+            }
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(!failed[i],
+                       "worker " << i << " failed: " << errors[i]);
+
+        for (Size i=0; i<n; ++i)
+            mcModel_->addSampleValues(values[i]);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::addDistributedSamples(
+                                                        Size samples) const {
+        if (distributedModel_.lock() != mcModel_) {
+            // a new simulation was started
+            distributedModel_ = mcModel_;
+            streamPosition_ = 0;
+        }
+
+        // all processes hold the samples drawn so far by all of them
+        const Size n = communicator_->size(), rank = communicator_->rank();
+        QL_REQUIRE(rank < n, "invalid rank (" << rank << ") for "
+                   << n << " processes");
+        BigNatural first = mcModel_->sampleAccumulator().samples()
+                         + (samples/n)*rank + std::min(rank, samples%n);
+        Size batch = samples/n + (rank < samples%n ? 1 : 0);
+        QL_REQUIRE(first >= streamPosition_,
+                   "samples added outside the distributed simulation");
+
+        detail::McJumpAhead<RNG::allowsErrorEstimate != 0 &&
+                            detail::RandomizedReplications<RNG>::value == 0>
+            ::apply(
+                                          *mcModel_, first - streamPosition_);
+        std::vector<std::pair<result_type,Real> > values;
+        mcModel_->drawSamples(batch, values);
+        streamPosition_ = first + batch;
+
+        std::vector<Real> data;
+        data.reserve(2*batch);
+        for (Size j=0; j<batch; ++j) {
+            detail::packMcSample(values[j].first, data);
+            data.push_back(values[j].second);
+        }
+
+        std::vector<std::vector<Real> > allData;
+        communicator_->allGather(data, allData);
+        QL_REQUIRE(allData.size() == n,
+                   "samples received from " << allData.size()
+                   << " processes instead of " << n);
+
+        for (Size i=0; i<n; ++i) {
+            values.clear();
+            const Real* p = allData[i].empty() ? 0 : &allData[i][0];
+            const Real* end = p + allData[i].size();
+            while (p != end) {
+                std::pair<result_type,Real> sample;
+                p = detail::unpackMcSample(p, sample.first);
+                sample.second = *p++;
+                values.push_back(sample);
+            }
+            mcModel_->addSampleValues(values);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::calculateRandomizations(
+                                                Real requiredTolerance,
+                                                Size requiredSamples,
+                                                Size maxSamples) const {
+        const Size m = detail::RandomizedReplications<RNG>::value;
+        QL_REQUIRE(m > 1, "at least two randomizations required");
+        QL_REQUIRE(!communicator_,
+                   "randomized sequences can't be distributed");
+
+        result_type controlVariateValue = result_type();
+        if (this->controlVariate_) {
+            controlVariateValue = this->controlVariateValue();
+            QL_REQUIRE(controlVariateValue != Null<result_type>(),
+                       "engine does not provide "
+                       "control-variation price");
+            QL_REQUIRE(!this->controlPathGenerator(),
+                       "control-variation path generator not supported "
+                       "with randomized sequences");
+        }
+
+        model_list models(m);
+        boost::shared_ptr<path_generator_type> firstGenerator;
+        boost::shared_ptr<path_pricer_type> firstPricer;
+        for (Size i=0; i<m; ++i) {
+            boost::shared_ptr<path_generator_type> generator =
+                i == 0 ? this->pathGenerator() : this->workerPathGenerator(i);
+            QL_REQUIRE(generator,
+                       "engine does not support randomized sequences");
+            boost::shared_ptr<path_pricer_type> pricer =
+                i == 0 ? this->pathPricer() : this->workerPathPricer(i);
+            boost::shared_ptr<path_pricer_type> controlPP;
+            if (this->controlVariate_) {
+                controlPP = this->controlPathPricer();
+                QL_REQUIRE(controlPP,
+                           "engine does not provide "
+                           "control-variation path pricer");
+            }
+            models[i] = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                new MonteCarloModel<MC,RNG,S>(
+                           generator, pricer, S(), this->antitheticVariate_,
+                           controlPP, controlVariateValue));
+            if (i == 0) {
+                firstGenerator = generator;
+                firstPricer = pricer;
+            }
+        }
+
+        if (requiredTolerance == Null<Real>()) {
+            addRandomizedSamples(models, (requiredSamples+m-1)/m);
+            collectRandomizations(models, firstGenerator, firstPricer);
+            return;
+        }
+
+        const Size limit =
+            (maxSamples != Null<Size>() ? maxSamples : QL_MAX_INTEGER)/m;
+        QL_REQUIRE(limit > 0,
+                   "max number of samples (" << maxSamples
+                   << ") less than the number of randomizations ("
+                   << m << ")");
+        // powers of two preserve the equidistribution of the
+        // sequences within each randomization
+        Size samples = 1;
+        while (samples*m < 1024)
+            samples *= 2;
+        samples = std::min(samples, limit);
+        addRandomizedSamples(models, samples);
+        collectRandomizations(models, firstGenerator, firstPricer);
+
+        result_type error(mcModel_->sampleAccumulator().errorEstimate());
+        while (maxError(error) > requiredTolerance) {
+            QL_REQUIRE(samples < limit,
+                       "max number of samples (" << samples*m
+                       << ") reached, while error (" << error
+                       << ") is still above tolerance ("
+                       << requiredTolerance << ")");
+            Size nextBatch = std::min(samples, limit-samples);
+            addRandomizedSamples(models, nextBatch);
+            samples += nextBatch;
+            collectRandomizations(models, firstGenerator, firstPricer);
+            error = result_type(mcModel_->sampleAccumulator().errorEstimate());
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::addRandomizedSamples(
+                                                    const model_list& models,
+                                                    Size samples) {
+        Size n = models.size();
+        std::vector<std::string> errors(n);
+        std::vector<int> failed(n, 0);
+
+        #pragma omp parallel for schedule(static)
+        for (Size i=0; i<n; ++i) {
+            try {
+                models[i]->addSamples(samples);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+                failed[i] = 1;
+            } catch (...) {
+                errors[i] = "unknown error";
+                failed[i] = 1;
+            }
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(!failed[i],
+                       "randomization " << i << " failed: " << errors[i]);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::collectRandomizations(
+               const model_list& models,
+               const boost::shared_ptr<path_generator_type>& generator,
+               const boost::shared_ptr<path_pricer_type>& pricer) const {
+        // the accumulator holds one sample per randomization, so
+        // that its mean and error estimate are those of the
+        // randomized estimator
+        std::vector<std::pair<result_type,Real> > values;
+        for (Size i=0; i<models.size(); ++i)
+            values.push_back(std::make_pair(
+                result_type(models[i]->sampleAccumulator().mean()), 1.0));
+        this->mcModel_ =
+            boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                new MonteCarloModel<MC,RNG,S>(generator, pricer, S(),
+                                              this->antitheticVariate_));
+        this->mcModel_->addSampleValues(values);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline BigNatural McSimulation<MC,RNG,S>::workerSeed(BigNatural seed,
+                                                         Size worker) {
+        if (seed == 0 || worker == 0)
+            return seed;
+
+        MersenneTwisterUniformRng rng(seed);
+        BigNatural s = 0;
+        for (Size i=0; i<worker; ++i)
+            s = rng.nextInt32();
+        // a null seed would make the worker use a random one
+        return s == 0 ? 1 : s;
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::errorEstimate() const {
@@ -0,0 +1,144 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/portfoliopricer.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace QuantLib {
+
+    Size PortfolioPricer::addGroup(const EngineFactory& factory) {
+        QL_REQUIRE(factory, "null engine factory given");
+        factories_.push_back(factory);
+        return factories_.size()-1;
+    }
+
+    Size PortfolioPricer::add(const boost::shared_ptr<Instrument>& instrument,
+                              Size group) {
+        QL_REQUIRE(instrument, "null instrument given");
+        QL_REQUIRE(group < factories_.size(),
+                   "group #" << group << " not available; "
+                   << factories_.size() << " groups given");
+        instruments_.push_back(instrument);
+        groups_.push_back(group);
+        npvs_.push_back(Null<Real>());
+        errors_.push_back(std::string());
+        pricingTimes_.push_back(0.0);
+        return instruments_.size()-1;
+    }
+
+    void PortfolioPricer::addMarketObject(
+                                  const boost::shared_ptr<LazyObject>& o) {
+        QL_REQUIRE(o, "null market object given");
+        marketObjects_.push_back(o);
+    }
+
+    void PortfolioPricer::checkIndex(Size i) const {
+        QL_REQUIRE(i < instruments_.size(),
+                   "instrument #" << i << " not available; "
+                   << instruments_.size() << " instruments given");
+    }
+
+    const boost::shared_ptr<Instrument>&
+    PortfolioPricer::instrument(Size i) const {
+        checkIndex(i);
+        return instruments_[i];
+    }
+
+    Real PortfolioPricer::NPV(Size i) const {
+        checkIndex(i);
+        return npvs_[i];
+    }
+
+    const std::string& PortfolioPricer::error(Size i) const {
+        checkIndex(i);
+        return errors_[i];
+    }
+
+    Real PortfolioPricer::pricingTime(Size i) const {
+        checkIndex(i);
+        return pricingTimes_[i];
+    }
+
+    void PortfolioPricer::calculate() {
+        Size n = instruments_.size();
+
+        Size threads = 1;
+        #ifdef _OPENMP
+        threads = omp_get_max_threads();
+        #endif
+
+        // engines register with market objects when built, so they
+        // are created here rather than in the worker threads
+        std::vector<bool> used(factories_.size(), false);
+        for (Size i=0; i<n; ++i)
+            used[groups_[i]] = true;
+        std::vector<std::vector<boost::shared_ptr<PricingEngine> > >
+            engines(threads, std::vector<boost::shared_ptr<PricingEngine> >(
+                                                           factories_.size()));
+        for (Size t=0; t<threads; ++t) {
+            for (Size g=0; g<factories_.size(); ++g) {
+                if (used[g]) {
+                    engines[t][g] = factories_[g]();
+                    QL_REQUIRE(engines[t][g],
+                               "null engine returned for group #" << g);
+                }
+            }
+        }
+
+        // detach the instruments from their current engines, whose
+        // observer lists can't be modified concurrently
+        for (Size i=0; i<n; ++i)
+            instruments_[i]->setPricingEngine(
+                                      boost::shared_ptr<PricingEngine>());
+
+        for (Size k=0; k<marketObjects_.size(); ++k)
+            marketObjects_[k]->recalculate();
+        for (Size k=0; k<marketObjects_.size(); ++k)
+            marketObjects_[k]->freeze();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (Size i=0; i<n; ++i) {
+            Size t = 0;
+            #ifdef _OPENMP
+            t = omp_get_thread_num();
+            #endif
+            boost::posix_time::ptime start =
+                boost::posix_time::microsec_clock::universal_time();
+            npvs_[i] = Null<Real>();
+            errors_[i] = std::string();
+            try {
+                instruments_[i]->setPricingEngine(engines[t][groups_[i]]);
+                npvs_[i] = instruments_[i]->NPV();
+            } catch (std::exception& e) {
+                errors_[i] = e.what();
+            } catch (...) {
+                errors_[i] = "unknown error";
+            }
+            boost::posix_time::time_duration elapsed =
+                boost::posix_time::microsec_clock::universal_time() - start;
+            pricingTimes_[i] = elapsed.total_microseconds()*1.0e-6;
+        }
+
+        for (Size k=0; k<marketObjects_.size(); ++k)
+            marketObjects_[k]->unfreeze();
+    }
+
+}
+
@@ -0,0 +1,106 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file portfoliopricer.hpp
+    \brief concurrent pricing of a portfolio of instruments
+*/
+
+#ifndef quantlib_portfolio_pricer_hpp
+#define quantlib_portfolio_pricer_hpp
+
+#include <ql/instrument.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <boost/function.hpp>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! concurrent pricing of a portfolio of instruments
+    /*! Instruments are divided into groups, each of which is priced
+        with engines returned by a given factory, e.g., engines of the
+        same type built on the same term structures.  Since engines
+        store their arguments and results, an engine can't price two
+        instruments at the same time; therefore, one engine per group
+        is created for each worker thread before pricing, and each
+        instrument is set to use the engine of the thread it is
+        priced in.  The instruments are distributed dynamically among
+        the threads if OpenMP is enabled, and priced sequentially
+        otherwise.
+
+        The market objects on which the engines depend (e.g.,
+        bootstrapped curves) can be given to the pricer, which
+        recalculates and freezes them during the pricing and unfreezes
+        them afterwards; frozen objects are never recalculated, which
+        makes it safe to share them among threads.
+
+        \warning After pricing, each instrument is left with the
+                 engine it was priced with.  The instruments must be
+                 distinct and must not be observed by other objects;
+                 objects lazily updated during pricing (e.g., index
+                 fixings looked up for the first time or term
+                 structures with a reference date not yet calculated)
+                 must be prepared beforehand.
+
+        \ingroup instruments
+    */
+    class PortfolioPricer {
+      public:
+        typedef boost::function<boost::shared_ptr<PricingEngine>()>
+                                                             EngineFactory;
+        //! adds a group of instruments and returns its index
+        /*! The factory is called once for each worker thread and
+            must return a new engine each time.
+        */
+        Size addGroup(const EngineFactory& factory);
+        //! adds an instrument to a group and returns its index
+        Size add(const boost::shared_ptr<Instrument>& instrument,
+                 Size group);
+        //! adds a market object to be frozen during the pricing
+        /*! Market objects are recalculated in the order in which they
+            were added; objects should therefore be added after the
+            objects they depend upon.
+        */
+        void addMarketObject(const boost::shared_ptr<LazyObject>&);
+        //! prices all instruments
+        void calculate();
+        //! \name Inspectors
+        //@{
+        Size size() const { return instruments_.size(); }
+        const boost::shared_ptr<Instrument>& instrument(Size i) const;
+        //! NPV of the i-th instrument, or null if its pricing failed
+        Real NPV(Size i) const;
+        //! error raised when pricing the i-th instrument, if any
+        const std::string& error(Size i) const;
+        //! wall-clock time taken by the i-th instrument
+        /*! The time is given in seconds. */
+        Real pricingTime(Size i) const;
+        //@}
+      private:
+        void checkIndex(Size i) const;
+        std::vector<EngineFactory> factories_;
+        std::vector<boost::shared_ptr<Instrument> > instruments_;
+        std::vector<Size> groups_;
+        std::vector<boost::shared_ptr<LazyObject> > marketObjects_;
+        std::vector<Real> npvs_;
+        std::vector<std::string> errors_;
+        std::vector<Real> pricingTimes_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,75 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/pricingenginepool.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace QuantLib {
+
+    PricingEnginePool::PricingEnginePool(const EngineFactory& factory,
+                                         Size threads) {
+        QL_REQUIRE(factory, "null engine factory given");
+        if (threads == Null<Size>()) {
+            threads = 1;
+            #ifdef _OPENMP
+            threads = omp_get_max_threads();
+            #endif
+        }
+        QL_REQUIRE(threads > 0, "at least one engine required");
+        engines_.resize(threads);
+        for (Size i=0; i<threads; ++i) {
+            engines_[i] = factory();
+            QL_REQUIRE(engines_[i], "null engine returned by factory");
+            for (Size j=0; j<i; ++j)
+                QL_REQUIRE(engines_[i] != engines_[j],
+                           "the factory must return a new engine "
+                           "each time it is called");
+            registerWith(engines_[i]);
+        }
+    }
+
+    const boost::shared_ptr<PricingEngine>& PricingEnginePool::engine() const {
+        Size thread = 0;
+        #ifdef _OPENMP
+        thread = omp_get_thread_num();
+        #endif
+        QL_REQUIRE(thread < engines_.size(),
+                   "no engine available for thread #" << thread << "; "
+                   << engines_.size() << " engines in pool");
+        return engines_[thread];
+    }
+
+    PricingEngine::arguments* PricingEnginePool::getArguments() const {
+        return engine()->getArguments();
+    }
+
+    const PricingEngine::results* PricingEnginePool::getResults() const {
+        return engine()->getResults();
+    }
+
+    void PricingEnginePool::reset() {
+        engine()->reset();
+    }
+
+    void PricingEnginePool::calculate() const {
+        engine()->calculate();
+    }
+
+}
+
@@ -0,0 +1,93 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pricingenginepool.hpp
+    \brief pricing engine dispatching to a separate engine per thread
+*/
+
+#ifndef quantlib_pricing_engine_pool_hpp
+#define quantlib_pricing_engine_pool_hpp
+
+#include <ql/pricingengine.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/function.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! pricing engine dispatching to a separate engine per thread
+    /*! Engines store the arguments and results of the calculation
+        in progress, so a single engine can't price two instruments at
+        the same time.  This class holds one engine per OpenMP thread
+        and forwards each call to the engine of the calling thread;
+        it can be passed to Instrument::setPricingEngine() as any
+        other engine, after which instruments sharing it can be
+        priced in parallel regions without locks.  Notifications from
+        the underlying engines are forwarded to the instruments.
+
+        The engines are created by the given factory when the pool is
+        built, since their construction registers them with the
+        market objects they depend on and the observer pattern can't
+        be modified concurrently.
+
+        \warning The calling thread is identified by its
+                 OpenMP thread number (zero outside parallel
+                 regions, or when OpenMP is not enabled); engines
+                 shouldn't be used from nested parallel regions or
+                 from other threading libraries.  The market objects
+                 should be calculated, and possibly frozen, before
+                 pricing in parallel.
+
+        \ingroup engines
+    */
+    class PricingEnginePool : public PricingEngine,
+                              public Observer {
+      public:
+        typedef boost::function<boost::shared_ptr<PricingEngine>()>
+                                                             EngineFactory;
+        /*! \param factory  must return a new engine each time it is
+                            called.
+            \param threads  the number of engines to create; if not
+                            given, the maximum number of OpenMP
+                            threads is used.
+        */
+        explicit PricingEnginePool(const EngineFactory& factory,
+                                   Size threads = Null<Size>());
+        //! \name PricingEngine interface
+        //@{
+        arguments* getArguments() const;
+        const results* getResults() const;
+        void reset();
+        void calculate() const;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update() { notifyObservers(); }
+        //@}
+        //! \name Inspectors
+        //@{
+        Size size() const { return engines_.size(); }
+        //! the engine used by the calling thread
+        const boost::shared_ptr<PricingEngine>& engine() const;
+        //@}
+      private:
+        std::vector<boost::shared_ptr<PricingEngine> > engines_;
+    };
+
+}
+
+#endif
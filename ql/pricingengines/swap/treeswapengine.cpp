@@ -67,8 +67,7 @@ namespace QuantLib {
         if (lattice_) {
             lattice = lattice_;
         } else {
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
+            lattice = latticeFor(times);
         }
 
         swap.initialize(lattice, times.back());
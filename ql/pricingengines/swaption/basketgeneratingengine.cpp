@@ -31,6 +31,15 @@ using std::fabs;
 
 namespace QuantLib {
 
+    const Disposable<Array>
+    BasketGeneratingEngine::underlyingNpvs(const Date &expiry,
+                                           const Array &y) const {
+        Array result(y.size());
+        for (Size i = 0; i < y.size(); ++i)
+            result[i] = underlyingNpv(expiry, y[i]);
+        return result;
+    }
+
     Disposable<std::vector<boost::shared_ptr<CalibrationHelper> > >
     BasketGeneratingEngine::calibrationBasket(
         const boost::shared_ptr<Exercise> &exercise,
@@ -117,16 +126,24 @@ namespace QuantLib {
                                            ->dayCounter()
                                            .yearFraction(expiry, rebateDate));
 
-                Real npvm = underlyingNpv(expiry, -h) +
+                // the three npvs are calculated together, so that the
+                // engine can share the roll back of the deal among them
+                Array states(3);
+                states[0] = -h;
+                states[1] = 0.0;
+                states[2] = h;
+                Array npvs = underlyingNpvs(expiry, states);
+
+                Real npvm = npvs[0] +
                             rebate *
                                 onefactormodel_->zerobond(rebateDate, expiry,
                                                           -h, discountCurve_) *
                                 zSpreadDsc;
-                Real npv = underlyingNpv(expiry, 0.0) +
+                Real npv = npvs[1] +
                            rebate * onefactormodel_->zerobond(
                                         rebateDate, expiry, 0, discountCurve_) *
                                zSpreadDsc;
-                Real npvp = underlyingNpv(expiry, h) +
+                Real npvp = npvs[2] +
                             rebate *
                                 onefactormodel_->zerobond(rebateDate, expiry, h,
                                                           discountCurve_) *
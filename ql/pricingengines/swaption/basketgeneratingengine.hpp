@@ -34,6 +34,7 @@
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -83,6 +84,13 @@ namespace QuantLib {
         virtual Real underlyingNpv(const Date &expiry,
                                    const Real y) const = 0;
 
+        /*! Returns the underlying npv for each of the given states;
+            the default implementation calls underlyingNpv for each of
+            them, engines should override it when a part of the work
+            can be shared among the states. */
+        virtual const Disposable<Array>
+        underlyingNpvs(const Date &expiry, const Array &y) const;
+
         virtual VanillaSwap::Type underlyingType() const = 0;
 
         virtual const Date underlyingLastDate() const = 0;
@@ -111,27 +119,61 @@ namespace QuantLib {
                   expiry_(expiry), maxMaturity_(maxMaturity), npv_(npv),
                   delta_(delta), gamma_(gamma), h_(h) {}
 
-            Real NPV(boost::shared_ptr<VanillaSwap> swap, Real fixedRate,
-                     Real nominal, Real y, int type) const {
-                Real npv = 0.0;
+            // coupon data of a standard swap
+            struct SwapData {
+                std::vector<Date> fixedDates, floatFixingDates, floatDates;
+                std::vector<Real> fixedAccruals, floatAccruals;
+                boost::shared_ptr<IborIndex> iborIndex;
+            };
+
+            // The standard swaps only depend on their maturity, which
+            // takes a few distinct values during the optimization; their
+            // coupon data are extracted once and reused.
+            const SwapData &swapData(const Period &maturity) const {
+                const Size months = maturity.length() *
+                                    (maturity.units() == Years ? 12 : 1);
+                std::map<Size, SwapData>::const_iterator cached =
+                    swaps_.find(months);
+                if (cached != swaps_.end())
+                    return cached->second;
+
+                boost::shared_ptr<VanillaSwap> swap =
+                    indexBase_->clone(maturity)->underlyingSwap(expiry_);
+                SwapData &data = swaps_[months];
                 for (Size i = 0; i < swap->fixedLeg().size(); i++) {
                     boost::shared_ptr<FixedRateCoupon> c =
                         boost::dynamic_pointer_cast<FixedRateCoupon>(
                             swap->fixedLeg()[i]);
-                    npv -=
-                        fixedRate * c->accrualPeriod() * nominal *
-                        mdl_->zerobond(c->date(), expiry_, y,
-                                       indexBase_->discountingTermStructure());
+                    data.fixedDates.push_back(c->date());
+                    data.fixedAccruals.push_back(c->accrualPeriod());
                 }
                 for (Size i = 0; i < swap->floatingLeg().size(); i++) {
                     boost::shared_ptr<IborCoupon> c =
                         boost::dynamic_pointer_cast<IborCoupon>(
                             swap->floatingLeg()[i]);
+                    data.floatFixingDates.push_back(c->fixingDate());
+                    data.floatDates.push_back(c->date());
+                    data.floatAccruals.push_back(c->accrualPeriod());
+                    data.iborIndex = c->iborIndex();
+                }
+                return data;
+            }
+
+            Real NPV(const SwapData &swap, Real fixedRate,
+                     Real nominal, Real y, int type) const {
+                Real npv = 0.0;
+                for (Size i = 0; i < swap.fixedDates.size(); i++) {
+                    npv -=
+                        fixedRate * swap.fixedAccruals[i] * nominal *
+                        mdl_->zerobond(swap.fixedDates[i], expiry_, y,
+                                       indexBase_->discountingTermStructure());
+                }
+                for (Size i = 0; i < swap.floatDates.size(); i++) {
                     npv +=
-                        mdl_->forwardRate(c->fixingDate(), expiry_, y,
-                                          c->iborIndex()) *
-                        c->accrualPeriod() * nominal *
-                        mdl_->zerobond(c->date(), expiry_, y,
+                        mdl_->forwardRate(swap.floatFixingDates[i], expiry_, y,
+                                          swap.iborIndex) *
+                        swap.floatAccruals[i] * nominal *
+                        mdl_->zerobond(swap.floatDates[i], expiry_, y,
                                        indexBase_->discountingTermStructure());
                 }
                 return (Real)type * npv;
@@ -175,13 +217,8 @@ namespace QuantLib {
                 Period lowerPeriod =
                     years * Years + months * Months;           //+days*Days;
                 Period upperPeriod = lowerPeriod + 1 * Months; // 1*Days;
-                boost::shared_ptr<SwapIndex> tmpIndexLower, tmpIndexUpper;
-                tmpIndexLower = indexBase_->clone(lowerPeriod);
-                tmpIndexUpper = indexBase_->clone(upperPeriod);
-                boost::shared_ptr<VanillaSwap> swapLower =
-                    tmpIndexLower->underlyingSwap(expiry_);
-                boost::shared_ptr<VanillaSwap> swapUpper =
-                    tmpIndexUpper->underlyingSwap(expiry_);
+                const SwapData &swapLower = swapData(lowerPeriod);
+                const SwapData &swapUpper = swapData(upperPeriod);
                 // compute npv, delta, gamma
                 Real npvm =
                     alpha * NPV(swapLower, fixedRate, nominal, -h_, type) +
@@ -226,6 +263,7 @@ namespace QuantLib {
             const Date expiry_;
             const Real maxMaturity_;
             const Real npv_, delta_, gamma_, h_;
+            mutable std::map<Size, SwapData> swaps_;
         };
     };
 }
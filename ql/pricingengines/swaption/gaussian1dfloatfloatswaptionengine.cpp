@@ -40,17 +40,26 @@ namespace QuantLib {
         rebatedExercise_ =
             boost::dynamic_pointer_cast<RebatedExercise>(arguments_.exercise);
 
-        std::pair<Real, Real> result =
-            npvs(settlement, 0.0, includeTodaysExercise_, true);
+        std::pair<Array, Array> result =
+            npvs(settlement, Array(1, 0.0), includeTodaysExercise_, true);
 
-        results_.value = result.first;
-        results_.additionalResults["underlyingValue"] = result.second;
+        results_.value = result.first[0];
+        results_.additionalResults["underlyingValue"] = result.second[0];
     }
 
     Real
     Gaussian1dFloatFloatSwaptionEngine::underlyingNpv(const Date &expiry,
                                                       const Real y) const {
-        return npvs(expiry, y, true).second;
+        return npvs(expiry, Array(1, y), true).second[0];
+    }
+
+    const Disposable<Array>
+    Gaussian1dFloatFloatSwaptionEngine::underlyingNpvs(const Date &expiry,
+                                                       const Array &y) const {
+        // the roll back down to the first event after expiry does not
+        // depend on the states and is done only once
+        Array result = npvs(expiry, y, true).second;
+        return result;
     }
 
     VanillaSwap::Type
@@ -96,9 +105,9 @@ namespace QuantLib {
         return initial;
     }
 
-    // calculate npv and underlying npv as of expiry date
-    const std::pair<Real, Real> Gaussian1dFloatFloatSwaptionEngine::npvs(
-        const Date &expiry, const Real y, const bool includeExerciseOnExpiry,
+    // calculate npv and underlying npv as of expiry date for each state
+    const std::pair<Array, Array> Gaussian1dFloatFloatSwaptionEngine::npvs(
+        const Date &expiry, const Array &y, const bool includeExerciseOnExpiry,
         const bool considerProbabilities) const {
 
         // pricing
@@ -135,12 +144,12 @@ namespace QuantLib {
         Option::Type type =
             arguments_.type == VanillaSwap::Payer ? Option::Call : Option::Put;
 
-        Array npv0(2 * integrationPoints_ + 1, 0.0),
-            npv1(2 * integrationPoints_ + 1, 0.0); // arrays for npvs of the
-                                                   // option
-        Array npv0a(2 * integrationPoints_ + 1, 0.0),
-            npv1a(2 * integrationPoints_ + 1, 0.0); // arrays for npvs of the
-                                                    // underlying
+        // the arrays hold the values on the grid after expiry and on
+        // the given states on expiry
+        Size n = std::max<Size>(2 * integrationPoints_ + 1, y.size());
+        Array npv0(n, 0.0), npv1(n, 0.0); // arrays for npvs of the option
+        Array npv0a(n, 0.0), npv1a(n, 0.0); // arrays for npvs of the
+                                            // underlying
         Array z = model_->yGrid(stddevs_, integrationPoints_);
         Array p(z.size(), 0.0), pa(z.size(), 0.0);
 
@@ -155,8 +164,8 @@ namespace QuantLib {
         Size exIdx = noEx; // current exercise index
         if (considerProbabilities && probabilities_ != None) {
             for (Size i = 0; i < noEx+1 ; ++i) {
-                Array npvTmp0(2 * integrationPoints_ + 1, 0.0);
-                Array npvTmp1(2 * integrationPoints_ + 1, 0.0);
+                Array npvTmp0(n, 0.0);
+                Array npvTmp1(n, 0.0);
                 npvp0.push_back(npvTmp0);
                 npvp1.push_back(npvTmp1);
             }
@@ -226,21 +235,241 @@ namespace QuantLib {
             event0Time = std::max(
                 model_->termStructure()->timeFromReference(event0), 0.0);
 
-            // todo add openmp support later on (as in gaussian1dswaptionengine)
+            // the states on which the values are calculated
+            const Array &states = event0 > expiry ? z : y;
+
+            // the deflated flows fixing on the event date and the
+            // deflated rebate are calculated on all the states before
+            // the roll back, the model being asked for the rates, zero
+            // bonds and numeraires of all the states in one go; this
+            // also ensures that neither lazy object recalculation nor
+            // write access to the caches of the model occur in the
+            // parallelized loop below
+            Array flows(states.size(), 0.0), rebates(states.size(), 0.0);
+            Array numeraires;
+            Real zerobond0 = 1.0;
+
+            if (isEventDate) {
+
+                Time t = model_->termStructure()->timeFromReference(event0);
+                numeraires =
+                    model_->numeraire(event0Time, states, discountCurve_);
+
+                if (isLeg1Fixing) { // if event is a fixing date and
+                                    // exercise date,
+                    // the coupon is part of the exercise into right (by
+                    // definition)
+                    Size j = std::find(arguments_.leg1FixingDates.begin(),
+                                       arguments_.leg1FixingDates.end(),
+                                       event0) -
+                             arguments_.leg1FixingDates.begin();
+                    Real zSpreadDf =
+                        oas_.empty()
+                            ? 1.0
+                            : std::exp(
+                                  -oas_->value() *
+                                  (model_->termStructure()
+                                       ->dayCounter()
+                                       .yearFraction(
+                                            event0,
+                                            arguments_.leg1PayDates[j])));
+                    bool done = false;
+                    do {
+                        Array amounts(states.size(),
+                                      arguments_.leg1Coupons[j]);
+                        if (!arguments_.leg1IsRedemptionFlow[j]) {
+                            Array estFixings(states.size(), 0.0);
+                            if (ibor1 != NULL)
+                                estFixings = model_->forwardRate(
+                                    arguments_.leg1FixingDates[j], event0,
+                                    states, ibor1);
+                            if (cms1 != NULL)
+                                estFixings = model_->swapRate(
+                                    arguments_.leg1FixingDates[j],
+                                    cms1->tenor(), event0, states, cms1);
+                            if (cmsspread1 != NULL) {
+                                Array rates1 = model_->swapRate(
+                                    arguments_.leg1FixingDates[j],
+                                    cmsspread1->swapIndex1()->tenor(), event0,
+                                    states, cmsspread1->swapIndex1());
+                                Array rates2 = model_->swapRate(
+                                    arguments_.leg1FixingDates[j],
+                                    cmsspread1->swapIndex2()->tenor(), event0,
+                                    states, cmsspread1->swapIndex2());
+                                for (Size k = 0; k < states.size(); k++)
+                                    estFixings[k] =
+                                        cmsspread1->gearing1() * rates1[k] +
+                                        cmsspread1->gearing2() * rates2[k];
+                            }
+                            for (Size k = 0; k < states.size(); k++) {
+                                Real rate =
+                                    arguments_.leg1Spreads[j] +
+                                    arguments_.leg1Gearings[j] * estFixings[k];
+                                if (arguments_.leg1CappedRates[j] !=
+                                    Null<Real>())
+                                    rate = std::min(
+                                        arguments_.leg1CappedRates[j], rate);
+                                if (arguments_.leg1FlooredRates[j] !=
+                                    Null<Real>())
+                                    rate = std::max(
+                                        arguments_.leg1FlooredRates[j], rate);
+                                amounts[k] = rate * arguments_.nominal1[j] *
+                                             arguments_.leg1AccrualTimes[j];
+                            }
+                        }
+
+                        std::vector<Time> payTime(
+                            1, model_->termStructure()->timeFromReference(
+                                   arguments_.leg1PayDates[j]));
+                        Matrix zerobonds = model_->zerobond(
+                            payTime, t, states, discountCurve_);
+                        for (Size k = 0; k < states.size(); k++)
+                            flows[k] -= amounts[k] * zerobonds[0][k] /
+                                        numeraires[k] * zSpreadDf;
+
+                        if (j < arguments_.leg1FixingDates.size() - 1) {
+                            j++;
+                            done = (event0 != arguments_.leg1FixingDates[j]);
+                        } else
+                            done = true;
+
+                    } while (!done);
+                }
+
+                if (isLeg2Fixing) { // if event is a fixing date and
+                                    // exercise date,
+                    // the coupon is part of the exercise into right (by
+                    // definition)
+                    Size j = std::find(arguments_.leg2FixingDates.begin(),
+                                       arguments_.leg2FixingDates.end(),
+                                       event0) -
+                             arguments_.leg2FixingDates.begin();
+                    Real zSpreadDf =
+                        oas_.empty()
+                            ? 1.0
+                            : std::exp(
+                                  -oas_->value() *
+                                  (model_->termStructure()
+                                       ->dayCounter()
+                                       .yearFraction(
+                                            event0,
+                                            arguments_.leg2PayDates[j])));
+                    bool done;
+                    do {
+                        Array amounts(states.size(),
+                                      arguments_.leg2Coupons[j]);
+                        if (!arguments_.leg2IsRedemptionFlow[j]) {
+                            Array estFixings(states.size(), 0.0);
+                            if (ibor2 != NULL)
+                                estFixings = model_->forwardRate(
+                                    arguments_.leg2FixingDates[j], event0,
+                                    states, ibor2);
+                            if (cms2 != NULL)
+                                estFixings = model_->swapRate(
+                                    arguments_.leg2FixingDates[j],
+                                    cms2->tenor(), event0, states, cms2);
+                            if (cmsspread2 != NULL) {
+                                Array rates1 = model_->swapRate(
+                                    arguments_.leg2FixingDates[j],
+                                    cmsspread2->swapIndex1()->tenor(), event0,
+                                    states, cmsspread2->swapIndex1());
+                                Array rates2 = model_->swapRate(
+                                    arguments_.leg2FixingDates[j],
+                                    cmsspread2->swapIndex2()->tenor(), event0,
+                                    states, cmsspread2->swapIndex2());
+                                for (Size k = 0; k < states.size(); k++)
+                                    estFixings[k] =
+                                        cmsspread2->gearing1() * rates1[k] +
+                                        cmsspread2->gearing2() * rates2[k];
+                            }
+                            for (Size k = 0; k < states.size(); k++) {
+                                Real rate =
+                                    arguments_.leg2Spreads[j] +
+                                    arguments_.leg2Gearings[j] * estFixings[k];
+                                if (arguments_.leg2CappedRates[j] !=
+                                    Null<Real>())
+                                    rate = std::min(
+                                        arguments_.leg2CappedRates[j], rate);
+                                if (arguments_.leg2FlooredRates[j] !=
+                                    Null<Real>())
+                                    rate = std::max(
+                                        arguments_.leg2FlooredRates[j], rate);
+                                amounts[k] = rate * arguments_.nominal2[j] *
+                                             arguments_.leg2AccrualTimes[j];
+                            }
+                        }
+
+                        std::vector<Time> payTime(
+                            1, model_->termStructure()->timeFromReference(
+                                   arguments_.leg2PayDates[j]));
+                        Matrix zerobonds = model_->zerobond(
+                            payTime, t, states, discountCurve_);
+                        for (Size k = 0; k < states.size(); k++)
+                            flows[k] += amounts[k] * zerobonds[0][k] /
+                                        numeraires[k] * zSpreadDf;
+
+                        if (j < arguments_.leg2FixingDates.size() - 1) {
+                            j++;
+                            done = (event0 != arguments_.leg2FixingDates[j]);
+                        } else
+                            done = true;
+
+                    } while (!done);
+                }
+
+                if (isExercise) {
+                    Size j = std::find(arguments_.exercise->dates().begin(),
+                                       arguments_.exercise->dates().end(),
+                                       event0) -
+                             arguments_.exercise->dates().begin();
+                    Real rebate = 0.0;
+                    Real zSpreadDf = 1.0;
+                    Date rebateDate = event0;
+                    if (rebatedExercise_ != NULL) {
+                        rebate = rebatedExercise_->rebate(j);
+                        rebateDate = rebatedExercise_->rebatePaymentDate(j);
+                        zSpreadDf =
+                            oas_.empty()
+                                ? 1.0
+                                : std::exp(-oas_->value() *
+                                           (model_->termStructure()
+                                                ->dayCounter()
+                                                .yearFraction(event0,
+                                                              rebateDate)));
+                    }
+                    Real rebateValue =
+                        rebate * model_->zerobond(rebateDate, event0) *
+                        zSpreadDf;
+                    for (Size k = 0; k < states.size(); k++)
+                        rebates[k] = rebateValue / numeraires[k];
+                    if (considerProbabilities && probabilities_ == Digital)
+                        zerobond0 = model_->zerobond(event0Time, 0.0, 0.0,
+                                                     discountCurve_);
+                }
+            }
+
+            Real zSpreadDf0 =
+                (event1Time == Null<Real>() || oas_.empty())
+                    ? 1.0
+                    : std::exp(-oas_->value() * (event1Time - event0Time));
 
-            for (Size k = 0; k < (event0 > expiry ? npv0.size() : 1); k++) {
+#ifdef _OPENMP
+            if (event1Time != Null<Real>())
+                model_->yGrid(stddevs_, integrationPoints_, event1Time,
+                              event0Time, 0.0);
+#endif
+
+#pragma omp parallel for default(shared) firstprivate(p, pa) if(event0>expiry)
+            for (Size k = 0; k < states.size(); k++) {
 
                 // roll back
 
                 Real price = 0.0, pricea = 0.0;
                 if (event1Time != Null<Real>()) {
-                    Real zSpreadDf = oas_.empty()
-                                         ? 1.0
-                                         : std::exp(-oas_->value() *
-                                                    (event1Time - event0Time));
+                    const Real zSpreadDf = zSpreadDf0;
                     Array yg =
                         model_->yGrid(stddevs_, integrationPoints_, event1Time,
-                                      event0Time, event0 > expiry ? z[k] : y);
+                                      event0Time, states[k]);
                     CubicInterpolation payoff0(
                         z.begin(), z.end(), npv1.begin(),
                         CubicInterpolation::Spline, true,
@@ -348,14 +577,10 @@ namespace QuantLib {
                     for (Size m = 0; m < npvp0.size(); m++) {
                         Real price = 0.0;
                         if (event1Time != Null<Real>()) {
-                            Real zSpreadDf =
-                                oas_.empty()
-                                    ? 1.0
-                                    : std::exp(-oas_->value() *
-                                               (event1Time - event0Time));
+                            const Real zSpreadDf = zSpreadDf0;
                             Array yg = model_->yGrid(
                                 stddevs_, integrationPoints_, event1Time,
-                                event0Time, event0 > expiry ? z[k] : 0.0);
+                                event0Time, states[k]);
                             CubicInterpolation payoff0(
                                 z.begin(), z.end(), npvp1[m].begin(),
                                 CubicInterpolation::Spline, true,
@@ -437,194 +662,12 @@ namespace QuantLib {
 
                 if (isEventDate) {
 
-                    Real zk = event0 > expiry ? z[k] : y;
-
-                    if (isLeg1Fixing) { // if event is a fixing date and
-                                        // exercise date,
-                        // the coupon is part of the exercise into right (by
-                        // definition)
-                        Size j = std::find(arguments_.leg1FixingDates.begin(),
-                                           arguments_.leg1FixingDates.end(),
-                                           event0) -
-                                 arguments_.leg1FixingDates.begin();
-                        Real zSpreadDf =
-                            oas_.empty()
-                                ? 1.0
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(
-                                                event0,
-                                                arguments_.leg1PayDates[j])));
-                        bool done = false;
-                        do {
-                            Real amount;
-                            if (arguments_.leg1IsRedemptionFlow[j]) {
-                                amount = arguments_.leg1Coupons[j];
-                            } else {
-                                Real estFixing = 0.0;
-                                if(ibor1 != NULL) {
-                                    estFixing = model_->forwardRate(
-                                        arguments_.leg1FixingDates[j], event0,
-                                        zk, ibor1);
-                                }
-                                if(cms1 != NULL) {
-                                    estFixing = model_->swapRate(
-                                        arguments_.leg1FixingDates[j],
-                                        cms1->tenor(), event0, zk, cms1);
-                                }
-                                if (cmsspread1 != NULL)
-                                    estFixing =
-                                        cmsspread1->gearing1() *
-                                            model_->swapRate(
-                                                arguments_.leg1FixingDates[j],
-                                                cmsspread1->swapIndex1()
-                                                    ->tenor(),
-                                                event0, zk,
-                                                cmsspread1->swapIndex1()) +
-                                        cmsspread1->gearing2() *
-                                            model_->swapRate(
-                                                arguments_.leg1FixingDates[j],
-                                                cmsspread1->swapIndex2()
-                                                    ->tenor(),
-                                                event0, zk,
-                                                cmsspread1->swapIndex2());
-                                Real rate =
-                                    arguments_.leg1Spreads[j] +
-                                    arguments_.leg1Gearings[j] * estFixing;
-                                if (arguments_.leg1CappedRates[j] !=
-                                    Null<Real>())
-                                    rate = std::min(
-                                        arguments_.leg1CappedRates[j], rate);
-                                if (arguments_.leg1FlooredRates[j] !=
-                                    Null<Real>())
-                                    rate = std::max(
-                                        arguments_.leg1FlooredRates[j], rate);
-                                amount = rate * arguments_.nominal1[j] *
-                                         arguments_.leg1AccrualTimes[j];
-                            }
-
-                            npv0a[k] -=
-                                amount *
-                                model_->zerobond(arguments_.leg1PayDates[j],
-                                                 event0, zk, discountCurve_) /
-                                model_->numeraire(event0Time, zk,
-                                                  discountCurve_) *
-                                zSpreadDf;
-
-                            if (j < arguments_.leg1FixingDates.size() - 1) {
-                                j++;
-                                done =
-                                    (event0 != arguments_.leg1FixingDates[j]);
-                            } else
-                                done = true;
-
-                        } while (!done);
-                    }
-
-                    if (isLeg2Fixing) { // if event is a fixing date and
-                                        // exercise date,
-                        // the coupon is part of the exercise into right (by
-                        // definition)
-                        Size j = std::find(arguments_.leg2FixingDates.begin(),
-                                           arguments_.leg2FixingDates.end(),
-                                           event0) -
-                                 arguments_.leg2FixingDates.begin();
-                        Real zSpreadDf =
-                            oas_.empty()
-                                ? 1.0
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(
-                                                event0,
-                                                arguments_.leg2PayDates[j])));
-                        bool done;
-                        do {
-                            Real amount;
-                            if (arguments_.leg2IsRedemptionFlow[j]) {
-                                amount = arguments_.leg2Coupons[j];
-                            } else {
-                                Real estFixing = 0.0;
-                                if(ibor2 != NULL)
-                                    estFixing = model_->forwardRate(arguments_.leg2FixingDates[j],event0,zk,ibor2);
-                                if(cms2 != NULL)
-                                    estFixing = model_->swapRate(arguments_.leg2FixingDates[j],cms2->tenor(),event0,zk,cms2);
-                                if (cmsspread2 != NULL)
-                                    estFixing =
-                                        cmsspread2->gearing1() *
-                                            model_->swapRate(
-                                                arguments_.leg2FixingDates[j],
-                                                cmsspread2->swapIndex1()
-                                                    ->tenor(),
-                                                event0, zk,
-                                                cmsspread2->swapIndex1()) +
-                                        cmsspread2->gearing2() *
-                                            model_->swapRate(
-                                                arguments_.leg2FixingDates[j],
-                                                cmsspread2->swapIndex2()
-                                                    ->tenor(),
-                                                event0, zk,
-                                                cmsspread2->swapIndex2());
-                                Real rate =
-                                    arguments_.leg2Spreads[j] +
-                                    arguments_.leg2Gearings[j] * estFixing;
-                                if (arguments_.leg2CappedRates[j] !=
-                                    Null<Real>())
-                                    rate = std::min(
-                                        arguments_.leg2CappedRates[j], rate);
-                                if (arguments_.leg2FlooredRates[j] !=
-                                    Null<Real>())
-                                    rate = std::max(
-                                        arguments_.leg2FlooredRates[j], rate);
-                                amount = rate * arguments_.nominal2[j] *
-                                         arguments_.leg2AccrualTimes[j];
-                            }
-
-                            npv0a[k] +=
-                                amount *
-                                model_->zerobond(arguments_.leg2PayDates[j],
-                                                 event0, zk, discountCurve_) /
-                                model_->numeraire(event0Time, zk,
-                                                  discountCurve_) *
-                                zSpreadDf;
-                            if (j < arguments_.leg2FixingDates.size() - 1) {
-                                j++;
-                                done =
-                                    (event0 != arguments_.leg2FixingDates[j]);
-                            } else
-                                done = true;
-
-                        } while (!done);
-                    }
+                    npv0a[k] += flows[k];
 
                     if (isExercise) {
-                        Size j = std::find(arguments_.exercise->dates().begin(),
-                                           arguments_.exercise->dates().end(),
-                                           event0) -
-                                 arguments_.exercise->dates().begin();
-                        Real rebate = 0.0;
-                        Real zSpreadDf = 1.0;
-                        Date rebateDate = event0;
-                        if (rebatedExercise_ != NULL) {
-                            rebate = rebatedExercise_->rebate(j);
-                            rebateDate = rebatedExercise_->rebatePaymentDate(j);
-                            zSpreadDf =
-                                oas_.empty()
-                                    ? 1.0
-                                    : std::exp(-oas_->value() *
-                                               (model_->termStructure()
-                                                    ->dayCounter()
-                                                    .yearFraction(event0,
-                                                                  rebateDate)));
-                        }
                         Real exerciseValue =
                             (type == Option::Call ? 1.0 : -1.0) * npv0a[k] +
-                            rebate * model_->zerobond(rebateDate, event0) *
-                                zSpreadDf / model_->numeraire(event0Time, zk,
-                                                              discountCurve_);
+                            rebates[k];
 
                         if (considerProbabilities && probabilities_ != None) {
                             if (exIdx == noEx) {
@@ -634,23 +677,13 @@ namespace QuantLib {
                                 npvp0.back()[k] =
                                     probabilities_ == Naive
                                         ? 1.0
-                                        : 1.0 / (model_->zerobond(
-                                                     event0Time, 0.0, 0.0,
-                                                     discountCurve_) *
-                                                 model_->numeraire(
-                                                     event0, z[k],
-                                                     discountCurve_));
+                                        : 1.0 / (zerobond0 * numeraires[k]);
                             }
                             if (exerciseValue >= npv0[k]) {
                                 npvp0[exIdx-1][k] =
                                     probabilities_ == Naive
                                         ? 1.0
-                                        : 1.0 / (model_->zerobond(
-                                                     event0Time, 0.0, 0.0,
-                                                     discountCurve_) *
-                                                 model_->numeraire(
-                                                     event0Time, z[k],
-                                                     discountCurve_));
+                                        : 1.0 / (zerobond0 * numeraires[k]);
                                 for (Size ii = exIdx; ii < noEx+1; ++ii)
                                     npvp0[ii][k] = 0.0;
                             }
@@ -681,10 +714,13 @@ namespace QuantLib {
 
         } while (--idx >= -1);
 
-        std::pair<Real, Real> res(
-            npv1[0] * model_->numeraire(event1Time, y, discountCurve_),
-            npv1a[0] * model_->numeraire(event1Time, y, discountCurve_) *
-                (type == Option::Call ? 1.0 : -1.0));
+        Array numeraires = model_->numeraire(event1Time, y, discountCurve_);
+        std::pair<Array, Array> res(Array(y.size()), Array(y.size()));
+        for (Size k = 0; k < y.size(); k++) {
+            res.first[k] = npv1[k] * numeraires[k];
+            res.second[k] = npv1a[k] * numeraires[k] *
+                            (type == Option::Call ? 1.0 : -1.0);
+        }
 
         // for probability computation
         if (considerProbabilities && probabilities_ != None) {
@@ -103,6 +103,8 @@ namespace QuantLib {
 
       protected:
         Real underlyingNpv(const Date &expiry, const Real y) const;
+        const Disposable<Array> underlyingNpvs(const Date &expiry,
+                                               const Array &y) const;
         VanillaSwap::Type underlyingType() const;
         const Date underlyingLastDate() const;
         const Disposable<Array> initialGuess(const Date &expiry) const;
@@ -117,8 +119,8 @@ namespace QuantLib {
         const bool includeTodaysExercise_;
         const Probabilities probabilities_;
 
-        const std::pair<Real, Real>
-        npvs(const Date &expiry, const Real y,
+        const std::pair<Array, Array>
+        npvs(const Date &expiry, const Array &y,
              const bool includeExerciseOnxpiry,
              const bool considerProbabilities=false) const;
 
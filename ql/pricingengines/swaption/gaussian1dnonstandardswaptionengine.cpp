@@ -32,6 +32,12 @@ namespace QuantLib {
     Real
     Gaussian1dNonstandardSwaptionEngine::underlyingNpv(const Date &expiry,
                                                        const Real y) const {
+        return underlyingNpvs(expiry, Array(1, y))[0];
+    }
+
+    const Disposable<Array>
+    Gaussian1dNonstandardSwaptionEngine::underlyingNpvs(const Date &expiry,
+                                                        const Array &y) const {
 
         // determine the indices on both legs representing the cashflows that
         // are part of the exercise into right
@@ -45,47 +51,66 @@ namespace QuantLib {
                              arguments_.floatingResetDates.end(), expiry - 1) -
             arguments_.floatingResetDates.begin();
 
-        // calculate the npv of these cashflows conditional on y at expiry
+        // calculate the npv of these cashflows conditional on y at expiry,
+        // the zero bonds being calculated by the model on all the states
+        // in one go
 
         Real type = (Real)arguments_.type;
+        Time t = model_->termStructure()->timeFromReference(expiry);
 
-        Real npv = 0.0;
+        std::vector<Time> fixedTimes, floatingTimes;
+        for (Size i = fixedIdx; i < arguments_.fixedResetDates.size(); i++)
+            fixedTimes.push_back(model_->termStructure()->timeFromReference(
+                arguments_.fixedPayDates[i]));
+        for (Size i = floatingIdx; i < arguments_.floatingResetDates.size();
+             i++)
+            floatingTimes.push_back(
+                model_->termStructure()->timeFromReference(
+                    arguments_.floatingPayDates[i]));
+        Matrix fixedZerobonds =
+            model_->zerobond(fixedTimes, t, y, discountCurve_);
+        Matrix floatingZerobonds =
+            model_->zerobond(floatingTimes, t, y, discountCurve_);
+
+        Array npv(y.size(), 0.0);
         for (Size i = fixedIdx; i < arguments_.fixedResetDates.size(); i++) {
-            npv -=
-                arguments_.fixedCoupons[i] *
-                model_->zerobond(arguments_.fixedPayDates[i], expiry, y,
-                                 discountCurve_) *
-                (oas_.empty()
-                     ? 1.0
-                     : exp(-oas_->value() *
-                           model_->termStructure()->dayCounter().yearFraction(
-                               expiry, arguments_.fixedPayDates[i])));
+            Real zSpreadDf =
+                oas_.empty()
+                    ? 1.0
+                    : exp(-oas_->value() *
+                          model_->termStructure()->dayCounter().yearFraction(
+                              expiry, arguments_.fixedPayDates[i]));
+            for (Size k = 0; k < y.size(); k++)
+                npv[k] -= arguments_.fixedCoupons[i] *
+                          fixedZerobonds[i - fixedIdx][k] * zSpreadDf;
         }
 
         for (Size i = floatingIdx; i < arguments_.floatingResetDates.size();
              i++) {
-            Real amount;
-            if (!arguments_.floatingIsRedemptionFlow[i])
-                amount = (arguments_.floatingGearings[i] *
-                              model_->forwardRate(
-                                  arguments_.floatingFixingDates[i], expiry, y,
-                                  arguments_.swap->iborIndex()) +
-                          arguments_.floatingSpreads[i]) *
-                         arguments_.floatingAccrualTimes[i] *
-                         arguments_.floatingNominal[i];
-            else
-                amount = arguments_.floatingCoupons[i];
-            npv +=
-                amount * model_->zerobond(arguments_.floatingPayDates[i],
-                                          expiry, y, discountCurve_) *
-                (oas_.empty()
-                     ? 1.0
-                     : exp(-oas_->value() *
-                           model_->termStructure()->dayCounter().yearFraction(
-                               expiry, arguments_.floatingPayDates[i])));
+            Real zSpreadDf =
+                oas_.empty()
+                    ? 1.0
+                    : exp(-oas_->value() *
+                          model_->termStructure()->dayCounter().yearFraction(
+                              expiry, arguments_.floatingPayDates[i]));
+            Array amounts(y.size(), arguments_.floatingCoupons[i]);
+            if (!arguments_.floatingIsRedemptionFlow[i]) {
+                amounts = model_->forwardRate(
+                    arguments_.floatingFixingDates[i], expiry, y,
+                    arguments_.swap->iborIndex());
+                for (Size k = 0; k < y.size(); k++)
+                    amounts[k] = (arguments_.floatingGearings[i] * amounts[k] +
+                                  arguments_.floatingSpreads[i]) *
+                                 arguments_.floatingAccrualTimes[i] *
+                                 arguments_.floatingNominal[i];
+            }
+            for (Size k = 0; k < y.size(); k++)
+                npv[k] += amounts[k] *
+                          floatingZerobonds[i - floatingIdx][k] * zSpreadDf;
         }
 
-        return type * npv;
+        npv *= type;
+        return npv;
     }
 
     VanillaSwap::Type
@@ -198,8 +223,119 @@ namespace QuantLib {
                                  arguments_.floatingResetDates.end(), expiry0 - 1) -
                 arguments_.floatingResetDates.begin();
 
-            // todo add openmp support later on (as in gaussian1dswaptionengine)
+            // the exercise values on the whole grid are calculated
+            // before the roll back, the model being asked for the
+            // zero bonds, forward rates and numeraires of all the
+            // states in one go; this also ensures that neither lazy
+            // object recalculation nor write access to the caches of
+            // the model occur in the parallelized loop below
+            Array exerciseValues, numeraires;
+            Real zerobond0 = 1.0;
+            if (expiry0 > settlement) {
+                Time t = model_->termStructure()->timeFromReference(expiry0);
+                std::vector<Time> floatingTimes, fixedTimes;
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++)
+                    floatingTimes.push_back(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.floatingPayDates[l]));
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++)
+                    fixedTimes.push_back(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.fixedPayDates[l]));
+                std::vector<Time> rebateTime(
+                    1, model_->termStructure()->timeFromReference(
+                           rebatedExercise != NULL
+                               ? rebatedExercise->rebatePaymentDate(idx)
+                               : expiry0));
+                Matrix floatingZerobonds =
+                    model_->zerobond(floatingTimes, t, z, discountCurve_);
+                Matrix fixedZerobonds =
+                    model_->zerobond(fixedTimes, t, z, discountCurve_);
+                Matrix rebateZerobonds =
+                    model_->zerobond(rebateTime, t, z, discountCurve_);
+                numeraires =
+                    model_->numeraire(expiry0Time, z, discountCurve_);
+                if (probabilities_ == Digital)
+                    zerobond0 = model_->zerobond(expiry0Time, 0.0, 0.0,
+                                                 discountCurve_);
+
+                Array underlyingNpv(z.size(), 0.0);
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
+                    Real zSpreadDf =
+                        oas_.empty()
+                            ? 1.0
+                            : std::exp(-oas_->value() *
+                                       (model_->termStructure()
+                                            ->dayCounter()
+                                            .yearFraction(
+                                                 expiry0,
+                                                 arguments_
+                                                     .floatingPayDates[l])));
+                    Array amounts(z.size(), arguments_.floatingCoupons[l]);
+                    if (!arguments_.floatingIsRedemptionFlow[l]) {
+                        amounts = model_->forwardRate(
+                            arguments_.floatingFixingDates[l], expiry0, z,
+                            arguments_.swap->iborIndex());
+                        for (Size k = 0; k < z.size(); k++)
+                            amounts[k] = arguments_.floatingNominal[l] *
+                                         arguments_.floatingAccrualTimes[l] *
+                                         (arguments_.floatingGearings[l] *
+                                              amounts[k] +
+                                          arguments_.floatingSpreads[l]);
+                    }
+                    for (Size k = 0; k < z.size(); k++)
+                        underlyingNpv[k] += amounts[k] *
+                                            floatingZerobonds[l - k1][k] *
+                                            zSpreadDf;
+                }
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
+                    Real zSpreadDf =
+                        oas_.empty()
+                            ? 1.0
+                            : std::exp(
+                                  -oas_->value() *
+                                  (model_->termStructure()
+                                       ->dayCounter()
+                                       .yearFraction(
+                                            expiry0,
+                                            arguments_.fixedPayDates[l])));
+                    for (Size k = 0; k < z.size(); k++)
+                        underlyingNpv[k] -= arguments_.fixedCoupons[l] *
+                                            fixedZerobonds[l - j1][k] *
+                                            zSpreadDf;
+                }
+                Real rebate = 0.0;
+                Real zSpreadDf = 1.0;
+                if (rebatedExercise != NULL) {
+                    rebate = rebatedExercise->rebate(idx);
+                    zSpreadDf =
+                        oas_.empty()
+                            ? 1.0
+                            : std::exp(
+                                  -oas_->value() *
+                                  (model_->termStructure()
+                                       ->dayCounter()
+                                       .yearFraction(
+                                            expiry0,
+                                            rebatedExercise
+                                                ->rebatePaymentDate(idx))));
+                }
+                exerciseValues = Array(z.size());
+                for (Size k = 0; k < z.size(); k++)
+                    exerciseValues[k] =
+                        ((type == Option::Call ? 1.0 : -1.0) *
+                             underlyingNpv[k] +
+                         rebate * rebateZerobonds[0][k] * zSpreadDf) /
+                        numeraires[k];
+            }
+
+#ifdef _OPENMP
+            if (expiry1Time != Null<Real>())
+                model_->yGrid(stddevs_, integrationPoints_, expiry1Time,
+                              expiry0Time, 0.0);
+#endif
 
+#pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
             for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
                  k++) {
 
@@ -360,78 +496,7 @@ namespace QuantLib {
                 // end probability computation
 
                 if (expiry0 > settlement) {
-                    Real floatingLegNpv = 0.0;
-                    for (Size l = k1; l < arguments_.floatingCoupons.size();
-                         l++) {
-                        Real zSpreadDf =
-                            oas_.empty()
-                                ? 1.0
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(
-                                                expiry0,
-                                                arguments_
-                                                    .floatingPayDates[l])));
-                        Real amount;
-                        if (arguments_.floatingIsRedemptionFlow[l])
-                            amount = arguments_.floatingCoupons[l];
-                        else
-                            amount = arguments_.floatingNominal[l] *
-                                     arguments_.floatingAccrualTimes[l] *
-                                     (arguments_.floatingGearings[l] *
-                                          model_->forwardRate(
-                                              arguments_.floatingFixingDates[l],
-                                              expiry0, z[k],
-                                              arguments_.swap->iborIndex()) +
-                                      arguments_.floatingSpreads[l]);
-                        floatingLegNpv +=
-                            amount *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
-                    }
-                    Real fixedLegNpv = 0.0;
-                    for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                        Real zSpreadDf =
-                            oas_.empty()
-                                ? 1.0
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(
-                                                expiry0,
-                                                arguments_.fixedPayDates[l])));
-                        fixedLegNpv +=
-                            arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
-                    }
-                    Real rebate = 0.0;
-                    Real zSpreadDf = 1.0;
-                    Date rebateDate = expiry0;
-                    if (rebatedExercise != NULL) {
-                        rebate = rebatedExercise->rebate(idx);
-                        rebateDate = rebatedExercise->rebatePaymentDate(idx);
-                        zSpreadDf =
-                            oas_.empty()
-                                ? 1.0
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(expiry0, rebateDate)));
-                    }
-                    Real exerciseValue =
-                        ((type == Option::Call ? 1.0 : -1.0) *
-                             (floatingLegNpv - fixedLegNpv) +
-                         rebate * model_->zerobond(rebateDate, expiry0, z[k],
-                                                   discountCurve_) *
-                             zSpreadDf) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                    Real exerciseValue = exerciseValues[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
@@ -443,21 +508,12 @@ namespace QuantLib {
                             npvp0.back()[k] =
                                 probabilities_ == Naive
                                     ? 1.0
-                                    : 1.0 / (model_->zerobond(expiry0Time, 0.0,
-                                                              0.0,
-                                                              discountCurve_) *
-                                             model_->numeraire(expiry0, z[k],
-                                                               discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                         if (exerciseValue >= npv0[k]) {
                             npvp0[idx - minIdxAlive][k] =
                                 probabilities_ == Naive
                                     ? 1.0
-                                    : 1.0 /
-                                          (model_->zerobond(expiry0Time, 0.0,
-                                                            0.0,
-                                                            discountCurve_) *
-                                           model_->numeraire(expiry0Time, z[k],
-                                                             discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                             for (Size ii = idx - minIdxAlive + 1;
                                  ii < npvp0.size(); ii++)
                                 npvp0[ii][k] = 0.0;
@@ -94,6 +94,8 @@ namespace QuantLib {
 
       protected:
         Real underlyingNpv(const Date &expiry, const Real y) const;
+        const Disposable<Array> underlyingNpvs(const Date &expiry,
+                                               const Array &y) const;
         VanillaSwap::Type underlyingType() const;
         const Date underlyingLastDate() const;
         const Disposable<Array> initialGuess(const Date &expiry) const;
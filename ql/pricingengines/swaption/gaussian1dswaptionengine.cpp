@@ -114,6 +114,29 @@ namespace QuantLib {
             }
 #endif
 
+            // zero bonds and numeraires on the whole grid, calculated
+            // by the model in one go
+            Matrix floatingZerobonds, fixedZerobonds;
+            Array numeraires;
+            if (expiry0 > settlement) {
+                Time t = model_->termStructure()->timeFromReference(expiry0);
+                std::vector<Time> floatingTimes, fixedTimes;
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++)
+                    floatingTimes.push_back(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.floatingPayDates[l]));
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++)
+                    fixedTimes.push_back(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.fixedPayDates[l]));
+                floatingZerobonds =
+                    model_->zerobond(floatingTimes, t, z, discountCurve_);
+                fixedZerobonds =
+                    model_->zerobond(fixedTimes, t, z, discountCurve_);
+                numeraires =
+                    model_->numeraire(expiry0Time, z, discountCurve_);
+            }
+
 #pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
             for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
                  k++) {
@@ -263,20 +286,17 @@ namespace QuantLib {
                              model_->forwardRate(
                                  arguments_.floatingFixingDates[l], expiry0,
                                  z[k], arguments_.swap->iborIndex())) *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                            floatingZerobonds[l - k1][k];
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
                         fixedLegNpv +=
                             arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                            fixedZerobonds[l - j1][k];
                     }
                     Real exerciseValue =
                         (type == Option::Call ? 1.0 : -1.0) *
-                        (floatingLegNpv - fixedLegNpv) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                        (floatingLegNpv - fixedLegNpv) / numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
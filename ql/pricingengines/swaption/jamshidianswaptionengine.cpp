@@ -19,37 +19,54 @@
 */
 
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
-#include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/solvers1d/newtonsafe.hpp>
 
 namespace QuantLib {
 
     class JamshidianSwaptionEngine::rStarFinder {
       public:
+        /* the value of the fixed leg at the exercise time, relative
+           to the bond maturing at the value time, is
+           sum_i a_i exp(-b_i r) with the coefficients below. */
         rStarFinder(const boost::shared_ptr<OneFactorAffineModel>& model,
                     Real nominal,
                     Time maturity,
                     Time valueTime,
                     const std::vector<Time>& fixedPayTimes,
                     const std::vector<Real>& amounts)
-        : strike_(nominal), maturity_(maturity), valueTime_(valueTime), times_(fixedPayTimes), amounts_(amounts), model_(model) {}
+        : strike_(nominal), ratios_(fixedPayTimes.size()),
+          a_(fixedPayTimes.size()), b_(fixedPayTimes.size()) {
+            std::pair<Real,Real> v =
+                model->discountBondCoefficients(maturity, valueTime);
+            for (Size i=0; i<fixedPayTimes.size(); i++) {
+                std::pair<Real,Real> p =
+                    model->discountBondCoefficients(maturity,
+                                                    fixedPayTimes[i]);
+                ratios_[i] = p.first/v.first;
+                b_[i] = p.second - v.second;
+                a_[i] = amounts[i]*ratios_[i];
+            }
+        }
 
         Real operator()(Rate x) const {
             Real value = strike_;
-            Real B = model_->discountBond(maturity_, valueTime_, x);
-            Size size = times_.size();
-            for (Size i=0; i<size; i++) {
-                Real dbValue =
-                    model_->discountBond(maturity_, times_[i], x) / B;
-                value -= amounts_[i]*dbValue;
-            }
+            for (Size i=0; i<a_.size(); i++)
+                value -= a_[i]*std::exp(-b_[i]*x);
             return value;
         }
+        Real derivative(Rate x) const {
+            Real value = 0.0;
+            for (Size i=0; i<a_.size(); i++)
+                value += a_[i]*b_[i]*std::exp(-b_[i]*x);
+            return value;
+        }
+        //! the strike of the i-th bond option for the given rate
+        Real strike(Size i, Rate x) const {
+            return ratios_[i]*std::exp(-b_[i]*x);
+        }
       private:
         Real strike_;
-        Time maturity_,valueTime_;
-        std::vector<Time> times_;
-        const std::vector<Real>& amounts_;
-        const boost::shared_ptr<OneFactorAffineModel>& model_;
+        std::vector<Real> ratios_, a_, b_;
     };
 
     void JamshidianSwaptionEngine::calculate() const {
@@ -90,7 +107,7 @@ namespace QuantLib {
 
         rStarFinder finder(*model_, arguments_.nominal, maturity, valueTime,
                            fixedPayTimes, amounts);
-        Brent s1d;
+        NewtonSafe s1d;
         Rate minStrike = -10.0;
         Rate maxStrike = 10.0;
         s1d.setMaxEvaluations(10000);
@@ -103,18 +120,12 @@ namespace QuantLib {
         Size size = arguments_.fixedCoupons.size();
 
         Real value = 0.0;
-        Real B = model_->discountBond(maturity, valueTime, rStar);
         for (Size i=0; i<size; i++) {
-            Real fixedPayTime =
-                dayCounter.yearFraction(referenceDate,
-                                        arguments_.fixedPayDates[i]);
-            Real strike = model_->discountBond(maturity,
-                                               fixedPayTime,
-                                               rStar) / B;
+            Real strike = finder.strike(i, rStar);
             // Looks like the swaption decomposed into individual options adjusted for maturity. Each individual option is valued by Hull-White (or other one-factor model).
             Real dboValue = model_->discountBondOption(
                                                w, strike, maturity, valueTime,
-                                               fixedPayTime);
+                                               fixedPayTimes[i]);
             value += amounts[i]*dboValue;
         }
         results_.value = value;
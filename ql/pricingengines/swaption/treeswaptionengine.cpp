@@ -78,9 +78,7 @@ namespace QuantLib {
         if (lattice_) {
             lattice = lattice_;
         } else {
-            std::vector<Time> times = swaption.mandatoryTimes();
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
+            lattice = latticeFor(swaption.mandatoryTimes());
         }
 
         std::vector<Time> stoppingTimes(arguments_.exercise->dates().size());
@@ -0,0 +1,140 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/valuationqueue.hpp>
+
+namespace QuantLib {
+
+    bool ValuationQueue::Future::ready() const {
+        QL_REQUIRE(state_, "invalid future");
+        return state_->queue == 0;
+    }
+
+    void ValuationQueue::Future::wait() const {
+        QL_REQUIRE(state_, "invalid future");
+        if (state_->queue != 0)
+            state_->queue->run();
+    }
+
+    Real ValuationQueue::Future::get() const {
+        wait();
+        QL_REQUIRE(state_->error.empty(), state_->error);
+        return state_->npv;
+    }
+
+    const std::string& ValuationQueue::Future::error() const {
+        wait();
+        return state_->error;
+    }
+
+    Real ValuationQueue::Future::pricingTime() const {
+        wait();
+        return state_->pricingTime;
+    }
+
+
+    ValuationQueue::~ValuationQueue() {
+        for (Size i=0; i<pending_.size(); ++i) {
+            pending_[i].state->queue = 0;
+            pending_[i].state->error = "valuation queue destroyed";
+        }
+    }
+
+    Size ValuationQueue::addGroup(const EngineFactory& factory) {
+        QL_REQUIRE(factory, "null engine factory given");
+        factories_.push_back(factory);
+        return factories_.size()-1;
+    }
+
+    void ValuationQueue::addMarketObject(
+                                  const boost::shared_ptr<LazyObject>& o) {
+        QL_REQUIRE(o, "null market object given");
+        marketObjects_.push_back(o);
+    }
+
+    ValuationQueue::Future ValuationQueue::submit(
+                          const boost::shared_ptr<Instrument>& instrument,
+                          Size group) {
+        QL_REQUIRE(instrument, "null instrument given");
+        QL_REQUIRE(group < factories_.size(),
+                   "group #" << group << " not available; "
+                   << factories_.size() << " groups given");
+
+        std::map<const Instrument*, Size>::const_iterator i =
+            pendingIndex_.find(instrument.get());
+        if (i != pendingIndex_.end()) {
+            QL_REQUIRE(pending_[i->second].group == group,
+                       "instrument already pending in group #"
+                       << pending_[i->second].group);
+            return Future(pending_[i->second].state);
+        }
+
+        Pending p;
+        p.instrument = instrument;
+        p.group = group;
+        p.state = boost::shared_ptr<State>(new State);
+        p.state->queue = this;
+        pendingIndex_[instrument.get()] = pending_.size();
+        pending_.push_back(p);
+        return Future(p.state);
+    }
+
+    void ValuationQueue::run() {
+        if (pending_.empty())
+            return;
+
+        // the pending valuations are taken out of the queue first, so
+        // that valuations submitted while running (e.g., by observers)
+        // are left for the next run
+        std::vector<Pending> batch;
+        batch.swap(pending_);
+        pendingIndex_.clear();
+
+        PortfolioPricer pricer;
+        for (Size g=0; g<factories_.size(); ++g)
+            pricer.addGroup(factories_[g]);
+        for (Size k=0; k<marketObjects_.size(); ++k)
+            pricer.addMarketObject(marketObjects_[k]);
+        for (Size i=0; i<batch.size(); ++i)
+            pricer.add(batch[i].instrument, batch[i].group);
+
+        try {
+            pricer.calculate();
+        } catch (std::exception& e) {
+            for (Size i=0; i<batch.size(); ++i) {
+                batch[i].state->queue = 0;
+                batch[i].state->error = e.what();
+            }
+            throw;
+        } catch (...) {
+            for (Size i=0; i<batch.size(); ++i) {
+                batch[i].state->queue = 0;
+                batch[i].state->error = "unknown error";
+            }
+            throw;
+        }
+
+        for (Size i=0; i<batch.size(); ++i) {
+            State& s = *(batch[i].state);
+            s.npv = pricer.NPV(i);
+            s.error = pricer.error(i);
+            s.pricingTime = pricer.pricingTime(i);
+            s.queue = 0;
+        }
+    }
+
+}
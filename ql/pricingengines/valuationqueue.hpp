@@ -0,0 +1,123 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file valuationqueue.hpp
+    \brief deferred valuation of instruments returning futures
+*/
+
+#ifndef quantlib_valuation_queue_hpp
+#define quantlib_valuation_queue_hpp
+
+#include <ql/pricingengines/portfoliopricer.hpp>
+#include <boost/noncopyable.hpp>
+#include <map>
+
+namespace QuantLib {
+
+    //! deferred valuation of instruments returning futures
+    /*! Valuations are submitted to the queue, which returns a future
+        for each of them without pricing the instrument.  Pending
+        valuations are performed together, either when run() is
+        called or when the result of any pending future is
+        requested; they are distributed among the available threads
+        by a PortfolioPricer, with engines built by the factory of
+        the group each instrument belongs to.
+
+        Before each run, the market objects added to the queue are
+        recalculated once, in the order in which they were added, and
+        frozen for the duration of the run.  Instruments depending on
+        the same object (e.g., a bootstrapped curve) thus share its
+        calculation instead of triggering it from each thread.
+        Submitting an instrument which is already pending returns the
+        future of the pending valuation.
+
+        \warning The queue must outlive the pending futures it
+                 returned; pending futures are completed with an
+                 error when the queue is destroyed.  The warnings
+                 on PortfolioPricer apply to the queued instruments.
+
+        \ingroup instruments
+    */
+    class ValuationQueue : private boost::noncopyable {
+      private:
+        struct State {
+            State() : queue(0), npv(Null<Real>()), pricingTime(0.0) {}
+            ValuationQueue* queue;
+            Real npv;
+            std::string error;
+            Real pricingTime;
+        };
+      public:
+        typedef PortfolioPricer::EngineFactory EngineFactory;
+        //! result of a deferred valuation
+        class Future {
+          public:
+            Future() {}
+            //! whether the future refers to a valuation
+            bool valid() const { return static_cast<bool>(state_); }
+            //! whether the valuation was performed
+            bool ready() const;
+            //! the NPV of the instrument
+            /*! If the valuation is still pending, all the pending
+                valuations in the queue are performed first.  The
+                error raised by the valuation, if any, is raised
+                again.
+            */
+            Real get() const;
+            //! the error raised by the valuation, if any
+            const std::string& error() const;
+            //! wall-clock time taken by the valuation, in seconds
+            Real pricingTime() const;
+          private:
+            friend class ValuationQueue;
+            explicit Future(const boost::shared_ptr<State>& state)
+            : state_(state) {}
+            void wait() const;
+            boost::shared_ptr<State> state_;
+        };
+
+        ValuationQueue() {}
+        ~ValuationQueue();
+        //! adds a group of instruments and returns its index
+        /*! The factory is called once for each worker thread at each
+            run and must return a new engine each time.
+        */
+        Size addGroup(const EngineFactory& factory);
+        //! adds a market object to be shared by the valuations
+        void addMarketObject(const boost::shared_ptr<LazyObject>&);
+        //! submits a valuation and returns its future
+        Future submit(const boost::shared_ptr<Instrument>& instrument,
+                      Size group);
+        //! performs all the pending valuations
+        void run();
+        //! the number of pending valuations
+        Size pending() const { return pending_.size(); }
+      private:
+        struct Pending {
+            boost::shared_ptr<Instrument> instrument;
+            Size group;
+            boost::shared_ptr<State> state;
+        };
+        std::vector<EngineFactory> factories_;
+        std::vector<boost::shared_ptr<LazyObject> > marketObjects_;
+        std::vector<Pending> pending_;
+        std::map<const Instrument*, Size> pendingIndex_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,273 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/vanilla/americanapproximationbatchpricer.hpp>
+#include <ql/pricingengines/vanilla/bjerksundstenslandengine.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/exercise.hpp>
+#include <map>
+
+namespace QuantLib {
+
+    AmericanApproximationBatchPricer::AmericanApproximationBatchPricer(
+              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+              Approximation approximation,
+              Real tolerance)
+    : process_(process), approximation_(approximation),
+      tolerance_(tolerance) {
+        QL_REQUIRE(tolerance > 0.0, "positive tolerance required");
+    }
+
+
+    std::vector<Real> AmericanApproximationBatchPricer::NPVs(
+        const std::vector<boost::shared_ptr<VanillaOption> >& options) const {
+
+        const Size n = options.size();
+        std::vector<Option::Type> types(n);
+        std::vector<Real> strikes(n), variances(n), results(n);
+        std::vector<DiscountFactor> riskFreeDiscounts(n),
+                                    dividendDiscounts(n);
+
+        // options in a chain share a few maturities
+        typedef std::map<Date, std::pair<DiscountFactor,DiscountFactor> >
+                                                                discount_map;
+        discount_map discounts;
+
+        for (Size i=0; i<n; ++i) {
+            boost::shared_ptr<AmericanExercise> ex =
+                boost::dynamic_pointer_cast<AmericanExercise>(
+                                                    options[i]->exercise());
+            QL_REQUIRE(ex, "option " << i << ": non-American exercise given");
+            QL_REQUIRE(!ex->payoffAtExpiry(),
+                       "option " << i << ": payoff at expiry not handled");
+
+            boost::shared_ptr<StrikedTypePayoff> payoff;
+            if (approximation_ == BjerksundStensland)
+                payoff = boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                     options[i]->payoff());
+            else
+                payoff = boost::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                     options[i]->payoff());
+            QL_REQUIRE(payoff, "option " << i << ": unsupported payoff given");
+
+            Date maturity = ex->lastDate();
+            discount_map::const_iterator d = discounts.find(maturity);
+            if (d == discounts.end())
+                d = discounts.insert(std::make_pair(maturity,
+                        std::make_pair(
+                            process_->riskFreeRate()->discount(maturity),
+                            process_->dividendYield()->discount(maturity))))
+                    .first;
+
+            types[i] = payoff->optionType();
+            strikes[i] = payoff->strike();
+            riskFreeDiscounts[i] = d->second.first;
+            dividendDiscounts[i] = d->second.second;
+            variances[i] = process_->blackVolatility()->blackVariance(
+                                                       maturity, strikes[i]);
+        }
+
+        if (n > 0)
+            values(n, &types[0], &strikes[0],
+                   process_->stateVariable()->value(),
+                   &riskFreeDiscounts[0], &dividendDiscounts[0],
+                   &variances[0], &results[0]);
+        return results;
+    }
+
+
+    void AmericanApproximationBatchPricer::values(
+                                    Size n,
+                                    const Option::Type* types,
+                                    const Real* strikes,
+                                    Real spot,
+                                    const DiscountFactor* riskFreeDiscounts,
+                                    const DiscountFactor* dividendDiscounts,
+                                    const Real* variances,
+                                    Real* values) const {
+
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+
+        // Black values, or closed-form approximations; the options for
+        // which early exercise can be optimal and which need a
+        // critical price are collected for the iterations below.
+        std::vector<Size> early;
+        for (Size i=0; i<n; ++i) {
+            DiscountFactor rfD = riskFreeDiscounts[i];
+            DiscountFactor dD = dividendDiscounts[i];
+            if (approximation_ == BjerksundStensland) {
+                Real s = spot, x = strikes[i];
+                if (types[i] == Option::Put) {
+                    // use put-call symmetry
+                    std::swap(s, x);
+                    std::swap(rfD, dD);
+                }
+                if (dD >= 1.0)
+                    values[i] = blackFormula(Option::Call, x, s*dD/rfD,
+                                             std::sqrt(variances[i])) * rfD;
+                else
+                    values[i] = BjerksundStenslandApproximationEngine::
+                        americanCallApproximation(s, x, rfD, dD,
+                                                  variances[i]);
+            } else if (dD >= 1.0 && types[i] == Option::Call) {
+                // early exercise never optimal
+                values[i] = blackFormula(Option::Call, strikes[i],
+                                         spot*dD/rfD,
+                                         std::sqrt(variances[i])) * rfD;
+            } else {
+                early.push_back(i);
+            }
+        }
+
+        if (early.empty())
+            return;
+
+        // Critical prices as in
+        // BaroneAdesiWhaleyApproximationEngine::criticalPrice.  For
+        // each option, the values below are those at the last iterate.
+        const Size m = early.size();
+        std::vector<Real> phi(m), stdDev(m), Q(m), Si(m), forwardSi(m),
+                          d1(m), cnd1(m), cnd2(m), pdf(m), black(m),
+                          LHS(m), RHS(m), bi(m);
+        for (Size k=0; k<m; ++k) {
+            Size i = early[k];
+            DiscountFactor rfD = riskFreeDiscounts[i];
+            DiscountFactor dD = dividendDiscounts[i];
+            Real variance = variances[i], strike = strikes[i];
+            phi[k] = (types[i] == Option::Call ? 1.0 : -1.0);
+            stdDev[k] = std::sqrt(variance);
+
+            // seed value
+            Real nn = 2.0*std::log(dD/rfD)/variance;
+            Real mm = -2.0*std::log(rfD)/variance;
+            Real bT = std::log(dD/rfD);
+            Real root = std::sqrt((nn-1.0)*(nn-1.0) + 4.0*mm);
+            Real qu = (-(nn-1.0) + phi[k]*root)/2.0;
+            Real Su = strike / (1.0 - 1.0/qu);
+            if (phi[k] > 0.0) {
+                Real h = -(bT + 2.0*stdDev[k]) * strike / (Su - strike);
+                Si[k] = strike + (Su - strike) * (1.0 - std::exp(h));
+            } else {
+                Real h = (bT - 2.0*stdDev[k]) * strike / (strike - Su);
+                Si[k] = Su + (strike - Su) * std::exp(h);
+            }
+
+            Real kk = (!close(rfD, 1.0, 1000))
+                ? -2.0*std::log(rfD) / (variance*(1.0-rfD))
+                : 2.0/variance;
+            Q[k] = (-(nn-1.0) + phi[k]*std::sqrt((nn-1.0)*(nn-1.0) + 4*kk))
+                   / 2;
+        }
+
+        CumulativeNormalDistribution cumNormalDist;
+        std::vector<Size> active(m), stillActive;
+        for (Size k=0; k<m; ++k)
+            active[k] = k;
+        stillActive.reserve(m);
+
+        while (!active.empty()) {
+            const Size a = active.size();
+            for (Size j=0; j<a; ++j) {
+                Size k = active[j], i = early[k];
+                forwardSi[k] =
+                    Si[k] * dividendDiscounts[i] / riskFreeDiscounts[i];
+                d1[k] = (std::log(forwardSi[k]/strikes[i])
+                         + 0.5*variances[i]) / stdDev[k];
+            }
+            // N(phi*d1) is used both by the Black formula and by the
+            // Newton step, so two evaluations are enough
+            for (Size j=0; j<a; ++j) {
+                Size k = active[j];
+                cnd1[k] = cumNormalDist(phi[k]*d1[k]);
+                cnd2[k] = cumNormalDist(phi[k]*(d1[k]-stdDev[k]));
+                pdf[k] = cumNormalDist.derivative(d1[k]);
+            }
+            stillActive.clear();
+            for (Size j=0; j<a; ++j) {
+                Size k = active[j], i = early[k];
+                DiscountFactor dD = dividendDiscounts[i];
+                Real strike = strikes[i];
+                black[k] = phi[k] * riskFreeDiscounts[i]
+                         * (forwardSi[k]*cnd1[k] - strike*cnd2[k]);
+                LHS[k] = phi[k] * (Si[k] - strike);
+                RHS[k] = black[k]
+                       + phi[k] * (1 - dD * cnd1[k]) * Si[k] / Q[k];
+                bi[k] = phi[k] * dD * cnd1[k] * (1 - 1/Q[k])
+                      + phi[k] * (1 - phi[k] * dD * pdf[k] / stdDev[k])
+                        / Q[k];
+                if (std::fabs(LHS[k] - RHS[k])/strike > tolerance_) {
+                    Si[k] = (strike + phi[k]*RHS[k] - phi[k]*bi[k]*Si[k])
+                          / (1 - phi[k]*bi[k]);
+                    stillActive.push_back(k);
+                }
+            }
+            active.swap(stillActive);
+        }
+
+        for (Size k=0; k<m; ++k) {
+            Size i = early[k];
+            DiscountFactor rfD = riskFreeDiscounts[i];
+            DiscountFactor dD = dividendDiscounts[i];
+            Real strike = strikes[i], variance = variances[i];
+            Real Sk = Si[k];
+
+            if (phi[k]*(Sk-spot) <= 0.0) {
+                // exercise immediately
+                values[i] = phi[k] * (spot - strike);
+                continue;
+            }
+
+            Real europeanValue =
+                blackFormula(types[i], strike, spot*dD/rfD, stdDev[k]) * rfD;
+
+            if (approximation_ == BaroneAdesiWhaley) {
+                Real a = phi[k] * (Sk/Q[k]) * (1.0 - dD * cnd1[k]);
+                values[i] = europeanValue + a * std::pow(spot/Sk, Q[k]);
+            } else {
+                // same as JuQuadraticApproximationEngine
+                Real alpha = -2.0*std::log(rfD)/variance;
+                Real beta = 2.0*std::log(dD/rfD)/variance;
+                Real h = 1 - rfD;
+                Real tempRoot = std::sqrt((beta-1)*(beta-1) + (4*alpha)/h);
+                Real lambda = (-(beta-1) + phi[k] * tempRoot) / 2;
+                Real lambdaPrime = - phi[k] * alpha / (h*h * tempRoot);
+
+                Real hA = phi[k] * (Sk - strike) - black[k];
+
+                Real part1 = forwardSi[k] * pdf[k] / (alpha * stdDev[k]);
+                Real part2 = - phi[k] * forwardSi[k] * cnd1[k] *
+                    std::log(dD) / std::log(rfD);
+                Real part3 = + phi[k] * strike * cnd2[k];
+                Real V_E_h = part1 + part2 + part3;
+
+                Real b = (1-h) * alpha * lambdaPrime
+                       / (2*(2*lambda + beta - 1));
+                Real c = - ((1 - h) * alpha / (2 * lambda + beta - 1)) *
+                    (V_E_h / hA + 1 / h + lambdaPrime / (2*lambda + beta - 1));
+                Real spotRatio = std::log(spot / Sk);
+                Real chi = spotRatio * (b * spotRatio + c);
+
+                values[i] = europeanValue +
+                    hA * std::pow(spot/Sk, lambda) / (1 - chi);
+            }
+        }
+    }
+
+}
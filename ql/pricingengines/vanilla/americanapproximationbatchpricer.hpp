@@ -0,0 +1,93 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file americanapproximationbatchpricer.hpp
+    \brief Analytic approximations for several American options
+           sharing the same Black-Scholes process
+*/
+
+#ifndef quantlib_american_approximation_batch_pricer_hpp
+#define quantlib_american_approximation_batch_pricer_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class GeneralizedBlackScholesProcess;
+
+    //! Analytic American approximations for a chain of options
+    /*! The values are the same as those returned by the
+        BaroneAdesiWhaleyApproximationEngine,
+        BjerksundStenslandApproximationEngine and
+        JuQuadraticApproximationEngine classes (up to the accuracy of
+        the critical price) but are calculated for a whole set of
+        options on the same underlying at once.  The term structures
+        of the process are only read once for each maturity, and the
+        Newton iterations for the critical prices of the
+        Barone-Adesi-Whaley and Ju approximations are performed in
+        lockstep on all the options, in loops over contiguous arrays;
+        the normal cumulative distribution is evaluated twice per
+        iteration instead of three times.
+
+        Only the values are calculated; the engines are still needed
+        for the Greeks.
+
+        \ingroup vanillaengines
+
+        \test the returned values are tested against those of the
+              corresponding engines.
+    */
+    class AmericanApproximationBatchPricer {
+      public:
+        enum Approximation { BaroneAdesiWhaley,
+                             BjerksundStensland,
+                             JuQuadratic };
+
+        AmericanApproximationBatchPricer(
+                const boost::shared_ptr<GeneralizedBlackScholesProcess>&,
+                Approximation approximation,
+                Real tolerance = 1.0e-6);
+
+        //! values of the given options, in the same order
+        std::vector<Real> NPVs(
+            const std::vector<boost::shared_ptr<VanillaOption> >&) const;
+
+        //! values of options given as contiguous arrays
+        /*! The inputs and results have one element for each option;
+            the discount factors and variances are those at the
+            maturity of the option.  The process passed to the
+            constructor is not used.
+        */
+        void values(Size n,
+                    const Option::Type* types,
+                    const Real* strikes,
+                    Real spot,
+                    const DiscountFactor* riskFreeDiscounts,
+                    const DiscountFactor* dividendDiscounts,
+                    const Real* variances,
+                    Real* values) const;
+
+      private:
+        const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        const Approximation approximation_;
+        const Real tolerance_;
+    };
+
+}
+
+#endif
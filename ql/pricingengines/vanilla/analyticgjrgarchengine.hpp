@@ -29,6 +29,7 @@
 #include <ql/instruments/vanillaoption.hpp>
 #include <ql/math/integrals/gaussianquadratures.hpp>
 #include <complex>
+#include <map>
 
 namespace QuantLib {
 
@@ -41,6 +42,13 @@ namespace QuantLib {
     Journal of Computational Finance, Volume 9, Number 3,
     Spring 2006
 
+        The moments of the log-return require a number of operations
+        growing with the cube of the number of days to maturity.  The
+        part that doesn't depend on the rates is stored for each
+        number of days, so that options with the same maturity (for
+        instance, those of an option chain) only calculate it once.
+        The stored values are discarded when the model changes.
+
         \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
@@ -55,35 +63,15 @@ namespace QuantLib {
       public:
         AnalyticGJRGARCHEngine(const boost::shared_ptr<GJRGARCHModel>& model);
         void calculate() const;
-        // call back for extended stochastic volatility
-        // plus jump diffusion engines like bates model
+        void update();
       private:
-// store parameters
-    mutable bool init_;
-    mutable Real h1_;
-    mutable Real b0_;
-    mutable Real b1_;
-    mutable Real b2_;
-    mutable Real b3_;
-    mutable Real la_;
-    mutable Real r_;
-    mutable Size T_;
-// intermediate constants determined by b1,b2,b3,la
-    mutable Real m1_;
-    mutable Real m2_;
-    mutable Real m3_;
-    mutable Real v1_;
-    mutable Real v2_;
-    mutable Real v3_;
-    mutable Real z1_;
-    mutable Real z2_;
-    mutable Real x1_;
-// statistical data for the GJR-GARCH process determined by
-// h1,b0,b1,b2,b3,r,T
-    mutable Real ex_; // mean
-    mutable Real sigma_; // variance
-    mutable Real k3_; // skewness
-    mutable Real k4_; // kurtosis
+        // sums over the variance path that determine the moments of
+        // the log-return; they don't depend on the rates
+        struct MomentSums {
+            Real sEh, SD1, SD3, ST1, ST2, ST3, ST4, SQ2, SQ4, SQ5;
+        };
+        const MomentSums& momentSums(Size days) const;
+        mutable std::map<Size, MomentSums> momentSums_;
     };
 
 }
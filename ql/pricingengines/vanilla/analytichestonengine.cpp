@@ -153,6 +153,15 @@ namespace QuantLib {
 
         Real operator()(Real phi) const;
 
+        // exponent of the integrand in Gatheral's formulation, save
+        // for the strike-dependent term i*phi*(dd-sx); phi must not
+        // be null
+        std::complex<Real> gatheralExponent(Real phi) const;
+        // derivatives of the above with respect to theta, kappa,
+        // sigma, rho and v0, followed by those of the add-on term
+        std::vector<std::complex<Real> >
+        gatheralExponentGradient(Real phi) const;
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -251,8 +260,8 @@ namespace QuantLib {
     }
 
 
-    Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
-    {
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::gatheralExponent(Real phi) const {
         const Real rpsig(rsigma_*phi);
 
         const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
@@ -263,33 +272,89 @@ namespace QuantLib {
         const std::complex<Real> addOnTerm
             = engine_ ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
+        if (sigma_ > 1e-5) {
+            const std::complex<Real> p = (t1-d)/(t1+d);
+            const std::complex<Real> g = std::log((1.0 - p*ex)/(1.0 - p));
+
+            return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                + addOnTerm;
+        }
+        else {
+            const std::complex<Real> td = phi/(2.0*t1)
+                *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+            const std::complex<Real> p = td*sigma2_/(t1+d);
+            const std::complex<Real> g = p*(1.0-ex);
+
+            return v0_*td*(1.0-ex)/(1.0-p*ex)
+                + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                + addOnTerm;
+        }
+    }
+
+    std::vector<std::complex<Real> >
+    AnalyticHestonEngine::Fj_Helper::gatheralExponentGradient(
+                                                         Real phi) const {
+        const Real rho = rsigma_/sigma_;
+        const Real ind = (j_== 1)? 1.0 : 0.0;
+        const std::complex<Real> a(-phi, (j_== 1)? 1 : -1);
+
+        const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rsigma_*phi);
+        const std::complex<Real> d = std::sqrt(t1*t1 - sigma2_*phi*a);
+        const std::complex<Real> ex = std::exp(-d*term_);
+        const std::complex<Real> q = t1-d, r = t1+d;
+        const std::complex<Real> p = q/r;
+        const std::complex<Real> g = std::log((1.0 - p*ex)/(1.0 - p));
+
+        const std::complex<Real> N = q*(1.0-ex);
+        const std::complex<Real> D = sigma2_*(1.0-ex*p);
+        const std::complex<Real> C = q*term_-2.0*g;
+
+        std::vector<std::complex<Real> > gradient(5);
+        for (Size k=0; k<5; ++k) {
+            // unit variation of theta, kappa, sigma, rho, v0
+            const Real dTheta = (k == 0)? 1.0 : 0.0;
+            const Real dKappa = (k == 1)? 1.0 : 0.0;
+            const Real dSigma = (k == 2)? 1.0 : 0.0;
+            const Real dRho   = (k == 3)? 1.0 : 0.0;
+            const Real dV0    = (k == 4)? 1.0 : 0.0;
+
+            const std::complex<Real> dt1 = dKappa
+                - (dRho*sigma_ + rho*dSigma)*std::complex<Real>(ind, phi);
+            const std::complex<Real> dd = (t1*dt1 - sigma_*dSigma*phi*a)/d;
+            const std::complex<Real> dex = -term_*ex*dd;
+            const std::complex<Real> dq = dt1-dd, dr = dt1+dd;
+            const std::complex<Real> dp = (dq*r - q*dr)/(r*r);
+            const std::complex<Real> dg = dp/(1.0 - p)
+                - (dp*ex + p*dex)/(1.0 - p*ex);
+
+            const std::complex<Real> dN = dq*(1.0-ex) - q*dex;
+            const std::complex<Real> dD = 2.0*sigma_*dSigma*(1.0-ex*p)
+                - sigma2_*(dex*p + ex*dp);
+            const std::complex<Real> dC = dq*term_ - 2.0*dg;
+
+            gradient[k] = dV0*N/D + v0_*(dN*D - N*dD)/(D*D)
+                + (dKappa*theta_ + kappa_*dTheta)/sigma2_*C
+                - 2.0*kappa_*theta_*dSigma/(sigma2_*sigma_)*C
+                + kappa_*theta_/sigma2_*dC;
+        }
+
+        if (engine_) {
+            const std::vector<std::complex<Real> > addOn =
+                engine_->addOnTermGradient(phi, term_, j_);
+            gradient.insert(gradient.end(), addOn.begin(), addOn.end());
+        }
+
+        return gradient;
+    }
+
+    Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
         if (cpxLog_ == Gatheral) {
             if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+                return std::exp(gatheralExponent(phi)
+                                + std::complex<Real>(0.0, phi*(dd_-sx_))
+                                ).imag()/phi;
             }
             else {
                 // use l'Hospital's rule to get lim_{phi->0}
@@ -315,6 +380,16 @@ namespace QuantLib {
             }
         }
         else if (cpxLog_ == BranchCorrection) {
+            const Real rpsig(rsigma_*phi);
+
+            const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
+            const std::complex<Real> d =
+                std::sqrt(t1*t1 - sigma2_*phi
+                          *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
+            const std::complex<Real> ex = std::exp(-d*term_);
+            const std::complex<Real> addOnTerm
+                = engine_ ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+
             const std::complex<Real> p = (t1+d)/(t1-d);
 
             // next term: g = std::log((1.0 - p*std::exp(d*term_))/(1.0 - p))
@@ -485,6 +560,145 @@ namespace QuantLib {
         return evaluations_;
     }
 
+    void AnalyticHestonEngine::update() {
+        quadratureCache_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    const AnalyticHestonEngine::QuadratureCache&
+    AnalyticHestonEngine::quadratureCache(Time term,
+                                          bool withGradient) const {
+        std::map<Time, QuadratureCache>::iterator i =
+            quadratureCache_.find(term);
+        if (i != quadratureCache_.end()
+            && (!withGradient || !i->second.gradient1.empty()))
+            return i->second;
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+
+        // unit spot, strike and ratio; the strike-dependent phase is
+        // added when the cache is used
+        const Fj_Helper f1(kappa, theta, sigma, v0, 1.0, rho, this,
+                           cpxLog_, term, 1.0, 1.0, 1);
+        const Fj_Helper f2(kappa, theta, sigma, v0, 1.0, rho, this,
+                           cpxLog_, term, 1.0, 1.0, 2);
+
+        if (i == quadratureCache_.end()) {
+            const Real c_inf = std::min(0.2, std::max(0.0001,
+                std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*term);
+
+            QuadratureCache cache;
+            std::vector<Real> weights;
+            integration_->quadratureNodes(c_inf, cache.nodes, weights);
+
+            const Size n = cache.nodes.size();
+            cache.amplitude1.resize(n, 0.0);
+            cache.phase1.resize(n, 0.0);
+            cache.amplitude2.resize(n, 0.0);
+            cache.phase2.resize(n, 0.0);
+            for (Size k=0; k<n; ++k) {
+                const Real u = cache.nodes[k];
+                if (weights[k] != 0.0) {
+                    const std::complex<Real> e1 = f1.gatheralExponent(u);
+                    cache.amplitude1[k] = weights[k]*std::exp(e1.real())/u;
+                    cache.phase1[k] = e1.imag();
+                    const std::complex<Real> e2 = f2.gatheralExponent(u);
+                    cache.amplitude2[k] = weights[k]*std::exp(e2.real())/u;
+                    cache.phase2[k] = e2.imag();
+                }
+            }
+            i = quadratureCache_.insert(std::make_pair(term, cache)).first;
+        }
+
+        if (withGradient) {
+            QuadratureCache& cache = i->second;
+            const Size n = cache.nodes.size();
+            const Size m = model_->params().size();
+            std::vector<std::complex<Real> > gradient1(n*m), gradient2(n*m);
+            for (Size k=0; k<n; ++k) {
+                const Real u = cache.nodes[k];
+                if (cache.amplitude1[k] != 0.0) {
+                    const std::vector<std::complex<Real> > g =
+                        f1.gatheralExponentGradient(u);
+                    std::copy(g.begin(), g.end(), gradient1.begin()+k*m);
+                }
+                if (cache.amplitude2[k] != 0.0) {
+                    const std::vector<std::complex<Real> > g =
+                        f2.gatheralExponentGradient(u);
+                    std::copy(g.begin(), g.end(), gradient2.begin()+k*m);
+                }
+            }
+            cache.gradient1.swap(gradient1);
+            cache.gradient2.swap(gradient2);
+        }
+
+        return i->second;
+    }
+
+    bool AnalyticHestonEngine::hasValueGradient() const {
+        return cpxLog_ == Gatheral
+            && integration_->isGaussianQuadrature()
+            && model_->params().size()
+                   == 5 + addOnTermGradient(1.0, 1.0, 1).size();
+    }
+
+    Disposable<Array> AnalyticHestonEngine::valueGradient(
+                       const VanillaOption::arguments& arguments) const {
+        QL_REQUIRE(hasValueGradient(),
+                   "parameter gradient only available with Gatheral's "
+                   "formula, a Gaussian quadrature and derivatives of "
+                   "the add-on term for all additional model parameters");
+        QL_REQUIRE(arguments.exercise->type() == Exercise::European,
+                   "not an European option");
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+        const Date maturity = arguments.exercise->lastDate();
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+        const Real strikePrice = payoff->strike();
+        const Time term = process->time(maturity);
+
+        const QuadratureCache& cache = quadratureCache(term, true);
+        const Real y = std::log(spotPrice*dividendDiscount
+                                /(strikePrice*riskFreeDiscount));
+
+        // the payoff type doesn't matter: by put-call parity, the
+        // difference of the values doesn't depend on the parameters
+        const Size n = cache.nodes.size();
+        const Size m = model_->params().size();
+        const Real c1 = spotPrice*dividendDiscount/M_PI;
+        const Real c2 = strikePrice*riskFreeDiscount/M_PI;
+        Array gradient(m, 0.0);
+        for (Size k=0; k<n; ++k) {
+            const Real a1 = c1*cache.amplitude1[k];
+            const Real a2 = c2*cache.amplitude2[k];
+            const Real s1 = std::sin(cache.phase1[k] + cache.nodes[k]*y);
+            const Real k1 = std::cos(cache.phase1[k] + cache.nodes[k]*y);
+            const Real s2 = std::sin(cache.phase2[k] + cache.nodes[k]*y);
+            const Real k2 = std::cos(cache.phase2[k] + cache.nodes[k]*y);
+            for (Size l=0; l<m; ++l) {
+                const std::complex<Real>& g1 = cache.gradient1[k*m+l];
+                const std::complex<Real>& g2 = cache.gradient2[k*m+l];
+                gradient[l] += a1*(s1*g1.real() + k1*g1.imag())
+                             - a2*(s2*g2.real() + k2*g2.imag());
+            }
+        }
+        return gradient;
+    }
+
     void AnalyticHestonEngine::doCalculation(Real riskFreeDiscount,
                                              Real dividendDiscount,
                                              Real spotPrice,
@@ -603,6 +817,44 @@ namespace QuantLib {
         const Real strikePrice = payoff->strike();
         const Real term = process->time(arguments_.exercise->lastDate());
 
+        if (cpxLog_ == Gatheral && integration_->isGaussianQuadrature()) {
+            const Size cachedExpiries = quadratureCache_.size();
+            const QuadratureCache& cache = quadratureCache(term, false);
+            evaluations_ = quadratureCache_.size() > cachedExpiries
+                ? 2*cache.nodes.size() : 0;
+
+            // log-moneyness, i.e., dd-sx in Fj_Helper
+            const Real y = std::log(spotPrice*dividendDiscount
+                                    /(strikePrice*riskFreeDiscount));
+
+            // real-valued sums over contiguous arrays; no complex
+            // arithmetic is left in the loop
+            const Size n = cache.nodes.size();
+            Real p1 = 0.0, p2 = 0.0;
+            for (Size k=0; k<n; ++k) {
+                p1 += cache.amplitude1[k]
+                    *std::sin(cache.phase1[k] + cache.nodes[k]*y);
+                p2 += cache.amplitude2[k]
+                    *std::sin(cache.phase2[k] + cache.nodes[k]*y);
+            }
+            p1 /= M_PI;
+            p2 /= M_PI;
+
+            switch (payoff->optionType()) {
+              case Option::Call:
+                results_.value = spotPrice*dividendDiscount*(p1+0.5)
+                               - strikePrice*riskFreeDiscount*(p2+0.5);
+                break;
+              case Option::Put:
+                results_.value = spotPrice*dividendDiscount*(p1-0.5)
+                               - strikePrice*riskFreeDiscount*(p2-0.5);
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
+            return;
+        }
+
         doCalculation(riskFreeDiscount,
                       dividendDiscount,
                       spotPrice,
@@ -735,6 +987,41 @@ namespace QuantLib {
             || intAlgo_ == Trapezoid;
     }
 
+    bool AnalyticHestonEngine::Integration::isGaussianQuadrature() const {
+        return intAlgo_ == GaussLaguerre
+            || intAlgo_ == GaussLegendre
+            || intAlgo_ == GaussChebyshev
+            || intAlgo_ == GaussChebyshev2nd;
+    }
+
+    void AnalyticHestonEngine::Integration::quadratureNodes(
+                                           Real c_inf,
+                                           std::vector<Real>& nodes,
+                                           std::vector<Real>& weights) const {
+        QL_REQUIRE(isGaussianQuadrature(),
+                   "integration algorithm has no fixed nodes");
+
+        const Array& x = gaussianQuadrature_->x();
+        const Array& w = gaussianQuadrature_->weights();
+        const Size n = gaussianQuadrature_->order();
+        nodes.resize(n);
+        weights.resize(n);
+
+        for (Size i=0; i<n; ++i) {
+            if (intAlgo_ == GaussLaguerre) {
+                nodes[i] = x[i];
+                weights[i] = w[i];
+            } else if ((1.0-x[i])*c_inf > QL_EPSILON) {
+                // same change of variable as integrand1
+                nodes[i] = -std::log(0.5-0.5*x[i])/c_inf;
+                weights[i] = w[i]/((1.0-x[i])*c_inf);
+            } else {
+                nodes[i] = 0.0;
+                weights[i] = 0.0;
+            }
+        }
+    }
+
     Real AnalyticHestonEngine::Integration::calculate(
                                Real c_inf,
                                const boost::function1<Real, Real>& f,
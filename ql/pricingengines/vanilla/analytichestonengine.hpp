@@ -34,6 +34,8 @@
 
 #include <boost/function.hpp>
 #include <complex>
+#include <map>
+#include <vector>
 
 namespace QuantLib {
 
@@ -48,6 +50,26 @@ namespace QuantLib {
         needs some sort of "branch correction" to work properly.
         Gatheral's version does also work with adaptive integration
         routines and should be preferred over the original Heston version.
+
+        Strike batching:
+        When Gatheral's formulation is used together with a Gaussian
+        quadrature, the nodes of the Fourier integral don't depend on
+        the strike of the option; the strike only enters through a
+        phase factor.  The engine therefore stores the characteristic
+        function at the quadrature nodes for each expiry it prices and
+        reuses it for any further strike with the same expiry, so
+        that each additional option only costs a real-valued sum over
+        the nodes.  This applies automatically to the calibration of
+        HestonModelHelper instances sharing an engine.  The stored
+        values are discarded whenever the model notifies a change.
+
+        Parameter gradient:
+        Under the same conditions, the engine can return the gradient
+        of the option value with respect to the model parameters by
+        differentiating the characteristic function under the
+        integral; see valueGradient().  Engines whose add-on term
+        depends on further model parameters must also provide its
+        derivatives through addOnTermGradient().
     */
 
     /*! References:
@@ -117,8 +139,18 @@ namespace QuantLib {
         std::complex<Real> lnChF(const std::complex<Real>& z, Time t) const;
 
         void calculate() const;
+        void update();
         Size numberOfEvaluations() const;
 
+        //! whether valueGradient() is available for the given setup
+        bool hasValueGradient() const;
+        /*! returns the derivatives of the option value with respect to
+            the model parameters, in the order given by the params()
+            method of the model.
+        */
+        Disposable<Array> valueGradient(
+                             const VanillaOption::arguments& arguments) const;
+
         static void doCalculation(Real riskFreeDiscount,
                                   Real dividendDiscount,
                                   Real spotPrice,
@@ -138,11 +170,31 @@ namespace QuantLib {
         virtual std::complex<Real> addOnTerm(Real phi,
                                              Time t,
                                              Size j) const;
+        // derivatives of addOnTerm with respect to the model
+        // parameters following the five Heston ones; the default
+        // returns an empty vector
+        virtual std::vector<std::complex<Real> > addOnTermGradient(
+                                              Real phi, Time t, Size j) const;
 
       private:
         class Fj_Helper;
         class AP_Helper;
 
+        // characteristic function at the quadrature nodes for a given
+        // expiry; the integrand of P_j for the log-moneyness y is
+        // amplitude_j[i]*sin(phase_j[i] + nodes[i]*y)
+        // the optional gradient of the exponents, with the model
+        // parameters varying fastest, is filled on demand
+        struct QuadratureCache {
+            std::vector<Real> nodes;
+            std::vector<Real> amplitude1, phase1;
+            std::vector<Real> amplitude2, phase2;
+            std::vector<std::complex<Real> > gradient1, gradient2;
+        };
+        const QuadratureCache& quadratureCache(Time term,
+                                               bool withGradient) const;
+
+        mutable std::map<Time, QuadratureCache> quadratureCache_;
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const boost::shared_ptr<Integration> integration_;
@@ -185,6 +237,15 @@ namespace QuantLib {
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
 
+        // true if the integration uses a fixed set of nodes, i.e.,
+        // one of the Gaussian quadratures
+        bool isGaussianQuadrature() const;
+        // nodes and weights of the Gaussian quadrature, mapped onto
+        // the integration domain [0, \infty) of the Fourier integral
+        void quadratureNodes(Real c_inf,
+                             std::vector<Real>& nodes,
+                             std::vector<Real>& weights) const;
+
       private:
         enum Algorithm
             { GaussLobatto, GaussKronrod, Simpson, Trapezoid,
@@ -211,6 +272,11 @@ namespace QuantLib {
                                                        Size) const {
         return std::complex<Real>(0,0);
     }
+
+    inline std::vector<std::complex<Real> >
+    AnalyticHestonEngine::addOnTermGradient(Real, Time, Size) const {
+        return std::vector<std::complex<Real> >();
+    }
 }
 
 #endif
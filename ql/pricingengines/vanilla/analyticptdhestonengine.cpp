@@ -28,6 +28,81 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // model parameters on the part of a period of the model time
+        // grid before the maturity
+        struct Segment {
+            Time tau;
+            Real kappa, theta, sigma, rho;
+            Rate drift;
+        };
+
+        std::vector<Segment> segments(
+                         const PiecewiseTimeDependentHestonModel& model,
+                         Time term) {
+            const TimeGrid& timeGrid = model.timeGrid();
+            std::vector<Segment> result;
+            for (Size i=0; i+1 < timeGrid.size() && timeGrid[i] < term; ++i) {
+                const Time begin = timeGrid[i];
+                const Time end   = std::min(term, timeGrid[i+1]);
+                const Time t     = 0.5*(end+begin);
+
+                Segment segment;
+                segment.tau   = end - begin;
+                segment.kappa = model.kappa(t);
+                segment.theta = model.theta(t);
+                segment.sigma = model.sigma(t);
+                segment.rho   = model.rho(t);
+                segment.drift = model.riskFreeRate()
+                        ->forwardRate(begin, end, Continuous, NoFrequency)
+                        .rate()
+                    - model.dividendYield()
+                        ->forwardRate(begin, end, Continuous, NoFrequency)
+                        .rate();
+                result.push_back(segment);
+            }
+            return result;
+        }
+
+        // log of the normalized characteristic function
+        std::complex<Real> piecewiseLnChF(
+                                       const std::vector<Segment>& segments,
+                                       Real v0, const std::complex<Real>& z) {
+            std::complex<Real> D = 0.0;
+            std::complex<Real> C = 0.0;
+
+            for (Integer i=Integer(segments.size())-1; i >= 0; --i) {
+                const Time tau   = segments[i].tau;
+                const Real kappa = segments[i].kappa;
+                const Real sigma = segments[i].sigma;
+                const Real theta = segments[i].theta;
+                const Real rho   = segments[i].rho;
+
+                const Real sigma2 = sigma*sigma;
+
+                const std::complex<Real> k
+                    = kappa + rho*sigma*std::complex<Real>(z.imag(), -z.real());
+
+                const std::complex<Real> d = std::sqrt(
+                    k*k + (z*z + std::complex<Real>(-z.imag(), z.real()))*sigma2);
+
+                const std::complex<Real> g = (k-d)/(k+d);
+
+                const std::complex<Real> gt = (k-d-D*sigma2)/(k+d-D*sigma2);
+
+                C += kappa*theta/sigma2*( (k-d)*tau
+                       - 2.0*std::log((1.0-gt*std::exp(-d*tau))/(1.0-gt)));
+
+                D = (k+d)/sigma2 * (g - gt*std::exp(-d*tau))
+                        /(1.0 - gt*std::exp(-d*tau));
+            }
+
+            return D*v0 + C;
+        }
+
+    }
+
     // helper class for integration
     class AnalyticPTDHestonEngine::Fj_Helper
         : public std::unary_function<Real, Real> {
@@ -38,41 +113,61 @@ namespace QuantLib {
             Time term, Real strike, Size j);
     
         Real operator()(Real phi) const;
+
+        // exponent of the integrand, save for the strike-dependent
+        // term i*phi*(x-sx); phi must not be null
+        std::complex<Real> exponent(Real phi) const;
         
       private:
         const Size j_;    
-        const Time term_;
         const Real v0_, x_, sx_;
         
-        std::vector<Rate> r_, q_;
-        const boost::shared_ptr<YieldTermStructure> qTS_;
-        const Handle<PiecewiseTimeDependentHestonModel> model_;
-        
-        const TimeGrid timeGrid_;
+        const std::vector<Segment> segments_;
     };
         
     AnalyticPTDHestonEngine::Fj_Helper::Fj_Helper(
         const Handle<PiecewiseTimeDependentHestonModel>& model,
         Time term, Real strike, Size j)
     : j_(j),
-      term_(term),
-
       v0_(model->v0()),
       x_ (std::log(model->s0())),
       sx_(std::log(strike)),
-      r_(model->timeGrid().size()-1),
-      q_(model->timeGrid().size()-1),
-      model_(model),
-      timeGrid_(model->timeGrid()){
-        
-        for (Size i=0; i <timeGrid_.size()-1; ++i) {
-            const Time begin = std::min(term_, timeGrid_[i]);
-            const Time end   = std::min(term_, timeGrid_[i+1]);
-            r_[i] = model->riskFreeRate()
-                    ->forwardRate(begin, end, Continuous, NoFrequency).rate();
-            q_[i] = model->dividendYield()
-                    ->forwardRate(begin, end, Continuous, NoFrequency).rate();
+      segments_(segments(**model, term)) {}
+
+    std::complex<Real>
+    AnalyticPTDHestonEngine::Fj_Helper::exponent(Real phi) const {
+        std::complex<Real> D = 0.0;
+        std::complex<Real> C = 0.0;
+
+        for (Integer i=Integer(segments_.size())-1; i >= 0; --i) {
+            const Time tau = segments_[i].tau;
+
+            const Real rho = segments_[i].rho;
+            const Real sigma = segments_[i].sigma;
+            const Real kappa = segments_[i].kappa;
+            const Real theta = segments_[i].theta;
+
+            const Real sigma2 = sigma*sigma;
+            const Real t0 = kappa - ((j_== 1)? rho*sigma : 0);
+            const Real rpsig = rho*sigma*phi;
+
+            const std::complex<Real> t1 = t0+std::complex<Real>(0, -rpsig);
+            const std::complex<Real> d  = std::sqrt(t1*t1 - sigma2*phi
+                             *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
+            const std::complex<Real> g = (t1-d)/(t1+d);
+            const std::complex<Real> gt 
+                                   = (t1-d - D*sigma2)/(t1+d - D*sigma2);
+            
+            D = (t1+d)/sigma2*(g-gt*std::exp(-d*tau))
+                /(1.0-gt*std::exp(-d*tau));
+            
+            const std::complex<Real> lng 
+                = std::log((1.0 - gt*std::exp(-d*tau))/(1.0 - gt));
+            
+            C =(kappa*theta)/sigma2*((t1-d)*tau-2.0*lng)
+                + std::complex<Real>(0.0, phi*segments_[i].drift*tau) + C;
         }
+        return v0_*D+C;
     }
         
     Real AnalyticPTDHestonEngine::Fj_Helper::operator()(Real phi) const {
@@ -81,43 +176,8 @@ namespace QuantLib {
         // todo: use l'Hospital's rule use to get lim_{phi->0}
         phi = std::max(Real(std::numeric_limits<float>::epsilon()), phi);
         
-        std::complex<Real> D = 0.0;
-        std::complex<Real> C = 0.0;
-
-        for (Size i=timeGrid_.size()-1; i > 0; --i) {
-            const Time begin = timeGrid_[i-1];
-            if (begin < term_) {
-                const Time end = std::min(term_, timeGrid_[i]);
-                const Time tau = end-begin;
-                const Time t   = 0.5*(end+begin);
-                
-                const Real rho = model_->rho(t);
-                const Real sigma = model_->sigma(t);
-                const Real kappa = model_->kappa(t);
-                const Real theta = model_->theta(t);
-
-                const Real sigma2 = sigma*sigma;
-                const Real t0 = kappa - ((j_== 1)? rho*sigma : 0);
-                const Real rpsig = rho*sigma*phi;
-
-                const std::complex<Real> t1 = t0+std::complex<Real>(0, -rpsig);
-                const std::complex<Real> d  = std::sqrt(t1*t1 - sigma2*phi
-                                 *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
-                const std::complex<Real> g = (t1-d)/(t1+d);
-                const std::complex<Real> gt 
-                                       = (t1-d - D*sigma2)/(t1+d - D*sigma2);
-                
-                D = (t1+d)/sigma2*(g-gt*std::exp(-d*tau))
-                    /(1.0-gt*std::exp(-d*tau));
-                
-                const std::complex<Real> lng 
-                    = std::log((1.0 - gt*std::exp(-d*tau))/(1.0 - gt));
-                
-                C =(kappa*theta)/sigma2*((t1-d)*tau-2.0*lng)
-                    + std::complex<Real>(0.0, phi*(r_[i-1]-q_[i-1])*tau) + C;
-            }
-        }
-        return std::exp(v0_*D+C+std::complex<Real>(0.0, phi*(x_ - sx_))).imag()
+        return std::exp(exponent(phi)
+                        + std::complex<Real>(0.0, phi*(x_ - sx_))).imag()
                 /phi; 
     }
 
@@ -126,15 +186,14 @@ namespace QuantLib {
       public:
         AP_Helper(Time term, Real s0, Real strike, Real ratio,
                   Volatility sigmaBS,
-                  const AnalyticPTDHestonEngine* const enginePtr)
+                  const Handle<PiecewiseTimeDependentHestonModel>& model)
         : term_(term),
           sigmaBS_(sigmaBS),
           x_(std::log(s0)),
           sx_(std::log(strike)),
           dd_(x_-std::log(ratio)),
-          enginePtr_(enginePtr) {
-            QL_REQUIRE(enginePtr != 0, "pricing engine required");
-        }
+          v0_(model->v0()),
+          segments_(segments(**model, term)) {}
 
         Real operator()(Real u) const {
             const std::complex<Real> z(u, -0.5);
@@ -144,66 +203,28 @@ namespace QuantLib {
                            *(z*z + std::complex<Real>(-z.imag(), z.real())));
 
             return (std::exp(std::complex<Real>(0.0, u*(dd_-sx_)))
-                * (phiBS - enginePtr_->chF(z, term_)) / (u*u + 0.25)).real();
+                * (phiBS - std::exp(piecewiseLnChF(segments_, v0_, z)))
+                / (u*u + 0.25)).real();
         }
 
       private:
         const Time term_;
         const Volatility sigmaBS_;
-        const Real x_, sx_, dd_;
-        const AnalyticPTDHestonEngine* const enginePtr_;
+        const Real x_, sx_, dd_, v0_;
+        const std::vector<Segment> segments_;
     };
 
 
     std::complex<Real> AnalyticPTDHestonEngine::lnChF(
         const std::complex<Real>& z, Time T) const {
 
-        const Real v0 = model_->v0();
-
-        std::complex<Real> D = 0.0;
-        std::complex<Real> C = 0.0;
-
-        const TimeGrid& timeGrid = model_->timeGrid();
-        const Time lastModelTime = timeGrid.back();
+        const Time lastModelTime = model_->timeGrid().back();
 
         QL_REQUIRE(T <= lastModelTime,
                    "maturity (" << T << ") is too large, "
                    "time grid is bounded by " << lastModelTime);
 
-        const Size lastI = std::distance(timeGrid.begin(),
-            std::lower_bound(timeGrid.begin(), timeGrid.end(), T));
-
-        for (Integer i=lastI-1; i >= 0; --i) {
-            const Time begin = timeGrid[i];
-            const Time end = std::min(T, timeGrid[i+1]);
-            const Time tau = end - begin;
-
-            const Time t     = 0.5*(end+begin);
-            const Real kappa = model_->kappa(t);
-            const Real sigma = model_->sigma(t);
-            const Real theta = model_->theta(t);
-            const Real rho   = model_->rho(t);
-
-            const Real sigma2 = sigma*sigma;
-
-            const std::complex<Real> k
-                = kappa + rho*sigma*std::complex<Real>(z.imag(), -z.real());
-
-            const std::complex<Real> d = std::sqrt(
-                k*k + (z*z + std::complex<Real>(-z.imag(), z.real()))*sigma2);
-
-            const std::complex<Real> g = (k-d)/(k+d);
-
-            const std::complex<Real> gt = (k-d-D*sigma2)/(k+d-D*sigma2);
-
-            C += kappa*theta/sigma2*( (k-d)*tau
-                   - 2.0*std::log((1.0-gt*std::exp(-d*tau))/(1.0-gt)));
-
-            D = (k+d)/sigma2 * (g - gt*std::exp(-d*tau))
-                    /(1.0 - gt*std::exp(-d*tau));
-        }
-
-        return D*v0 + C;
+        return piecewiseLnChF(segments(**model_, T), model_->v0(), z);
     }
 
     std::complex<Real> AnalyticPTDHestonEngine::chF(
@@ -252,6 +273,54 @@ namespace QuantLib {
     }
 
 
+    Size AnalyticPTDHestonEngine::numberOfEvaluations() const {
+        return evaluations_;
+    }
+
+    void AnalyticPTDHestonEngine::update() {
+        quadratureCache_.clear();
+        GenericModelEngine<PiecewiseTimeDependentHestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    const AnalyticPTDHestonEngine::QuadratureCache&
+    AnalyticPTDHestonEngine::quadratureCache(Time term, Real c_inf) const {
+        std::map<Time, QuadratureCache>::iterator i =
+            quadratureCache_.find(term);
+        if (i != quadratureCache_.end())
+            return i->second;
+
+        // unit spot and strike; the strike-dependent phase is added
+        // when the cache is used
+        const Fj_Helper f1(model_, term, 1.0, 1);
+        const Fj_Helper f2(model_, term, 1.0, 2);
+
+        QuadratureCache cache;
+        std::vector<Real> weights;
+        integration_->quadratureNodes(c_inf, cache.nodes, weights);
+
+        const Size n = cache.nodes.size();
+        cache.amplitude1.resize(n, 0.0);
+        cache.phase1.resize(n, 0.0);
+        cache.amplitude2.resize(n, 0.0);
+        cache.phase2.resize(n, 0.0);
+        for (Size k=0; k<n; ++k) {
+            const Real u = std::max(
+                Real(std::numeric_limits<float>::epsilon()), cache.nodes[k]);
+            if (weights[k] != 0.0) {
+                const std::complex<Real> e1 = f1.exponent(u);
+                cache.amplitude1[k] = weights[k]*std::exp(e1.real())/u;
+                cache.phase1[k] = e1.imag();
+                const std::complex<Real> e2 = f2.exponent(u);
+                cache.amplitude2[k] = weights[k]*std::exp(e2.real())/u;
+                cache.phase2[k] = e2.imag();
+            }
+        }
+        return quadratureCache_.insert(std::make_pair(term, cache)).first
+            ->second;
+    }
+
     void AnalyticPTDHestonEngine::calculate() const {
         // this is an european option pricer
         QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
@@ -306,13 +375,36 @@ namespace QuantLib {
                 std::sqrt(1.0-square<Real>()(rhoAvg))/sigmaAvg))
                 *(v0 + kappaAvg*thetaAvg*term);
 
-            const Real p1 = integration_->calculate(c_inf,
+            Real p1, p2;
+            if (integration_->isGaussianQuadrature()) {
+                const Size cachedExpiries = quadratureCache_.size();
+                const QuadratureCache& cache = quadratureCache(term, c_inf);
+                if (quadratureCache_.size() > cachedExpiries)
+                    evaluations_ += 2*cache.nodes.size();
+
+                // log-moneyness, i.e., x-sx in Fj_Helper
+                const Real y = std::log(spotPrice/strike);
+
+                const Size n = cache.nodes.size();
+                p1 = p2 = 0.0;
+                for (Size k=0; k<n; ++k) {
+                    p1 += cache.amplitude1[k]
+                        *std::sin(cache.phase1[k] + cache.nodes[k]*y);
+                    p2 += cache.amplitude2[k]
+                        *std::sin(cache.phase2[k] + cache.nodes[k]*y);
+                }
+                p1 /= M_PI;
+                p2 /= M_PI;
+            }
+            else {
+                p1 = integration_->calculate(c_inf,
                                     Fj_Helper(model_, term, strike, 1))/M_PI;
-            evaluations_ += integration_->numberOfEvaluations();
+                evaluations_ += integration_->numberOfEvaluations();
 
-            const Real p2 = integration_->calculate(c_inf,
+                p2 = integration_->calculate(c_inf,
                                     Fj_Helper(model_, term, strike, 2))/M_PI;
-            evaluations_ += integration_->numberOfEvaluations();
+                evaluations_ += integration_->numberOfEvaluations();
+            }
 
             switch (payoff->optionType())
             {
@@ -341,23 +433,13 @@ namespace QuantLib {
                       std::sqrt(1-square<Real>()(model_->rho(t05))),
                       model_->rho(t05)) / model_->sigma(t05);
 
-              const Size lastI = std::distance(timeGrid.begin(),
-                  std::lower_bound(timeGrid.begin(), timeGrid.end(), term));
-
+              const std::vector<Segment> segs = segments(**model_, term);
               std::complex<Real> C_u_inf(0.0, 0.0);
-              for (Size i=0; i < lastI; ++i) {
-                  const Time begin = timeGrid[i];
-                  const Time end   = std::min(term, timeGrid[i+1]);
-                  const Time tau   = end - begin;
-                  const Time t     = 0.5*(end+begin);
-
-                  const Real kappa = model_->kappa(t);
-                  const Real theta = model_->theta(t);
-                  const Real sigma = model_->sigma(t);
-                  const Real rho = model_->rho(t);
-
-                  C_u_inf += -kappa*theta*tau / sigma
-                      *std::complex<Real>(std::sqrt(1-rho*rho), rho);
+              for (Size i=0; i < segs.size(); ++i) {
+                  C_u_inf += -segs[i].kappa*segs[i].theta*segs[i].tau
+                      / segs[i].sigma
+                      *std::complex<Real>(std::sqrt(1-square<Real>()(segs[i].rho)),
+                                          segs[i].rho);
               }
 
               const Real ratio = riskFreeDiscount/dividendDiscount;
@@ -383,7 +465,7 @@ namespace QuantLib {
 
               const Real h_cv = integration_->calculate(c_inf,
                       AP_Helper(term, spotPrice, strike,
-                                ratio, std::sqrt(vAvg), this),uM)
+                                ratio, std::sqrt(vAvg), model_),uM)
                   * std::sqrt(strike * fwdPrice)*riskFreeDiscount/M_PI;
               evaluations_ += integration_->numberOfEvaluations();
 
@@ -47,6 +47,14 @@ namespace QuantLib {
         transform methods: application to Heston’s model,
         http://arxiv.org/pdf/0708.2020
 
+        Strike batching:
+        As in AnalyticHestonEngine, when Gatheral's formulation is
+        used together with a Gaussian quadrature the engine stores the
+        characteristic function at the quadrature nodes for each
+        expiry it prices, so that further options with the same expiry
+        don't integrate the piecewise model again.  The stored values
+        are discarded whenever the model notifies a change.
+
         \ingroup vanillaengines
     */
     class AnalyticPTDHestonEngine
@@ -80,6 +88,7 @@ namespace QuantLib {
             Real andersenPiterbargEpsilon = 1e-8);
 
 
+        void update();
         void calculate() const;
         Size numberOfEvaluations() const;
 
@@ -90,7 +99,18 @@ namespace QuantLib {
       private:
         class Fj_Helper;
         class AP_Helper;
-        
+
+        // characteristic function at the quadrature nodes for a given
+        // expiry; the integrand of P_j for the log-moneyness y is
+        // amplitude_j[i]*sin(phase_j[i] + nodes[i]*y)
+        struct QuadratureCache {
+            std::vector<Real> nodes;
+            std::vector<Real> amplitude1, phase1;
+            std::vector<Real> amplitude2, phase2;
+        };
+        const QuadratureCache& quadratureCache(Time term, Real c_inf) const;
+
+        mutable std::map<Time, QuadratureCache> quadratureCache_;
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const boost::shared_ptr<Integration> integration_;
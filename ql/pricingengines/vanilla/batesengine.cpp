@@ -48,6 +48,30 @@ namespace QuantLib {
                           -g*(std::exp(nu_+delta2_) - 1.0));
     }
 
+    std::vector<std::complex<Real> > BatesEngine::addOnTermGradient(
+                                            Real phi, Time t, Size j) const {
+
+        boost::shared_ptr<BatesModel> batesModel =
+                            boost::dynamic_pointer_cast<BatesModel>(*model_);
+
+        const Real nu     = batesModel->nu();
+        const Real delta  = batesModel->delta();
+        const Real delta2 = 0.5*delta*delta;
+        const Real lambda = batesModel->lambda();
+        const Real i      = (j == 1)? 1.0 : 0.0;
+        const std::complex<Real> g(i, phi);
+
+        const std::complex<Real> e1 = std::exp(nu*g + delta2*g*g);
+        const Real e0 = std::exp(nu+delta2);
+
+        // same order as the model parameters: nu, delta, lambda
+        std::vector<std::complex<Real> > gradient(3);
+        gradient[0] = t*lambda*g*(e1 - e0);
+        gradient[1] = t*lambda*delta*(g*g*e1 - g*e0);
+        gradient[2] = t*(e1 - 1.0 - g*(e0 - 1.0));
+        return gradient;
+    }
+
 
     BatesDetJumpEngine::BatesDetJumpEngine(
         const boost::shared_ptr<BatesDetJumpModel>& model,
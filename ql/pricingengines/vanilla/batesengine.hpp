@@ -112,6 +112,8 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const;
+        std::vector<std::complex<Real> > addOnTermGradient(
+                                              Real phi, Time t, Size j) const;
     };
 
 
@@ -53,19 +53,38 @@ namespace QuantLib {
     template <class T>
     class BinomialVanillaEngine : public VanillaOption::engine {
       public:
+        /*! If more than one extrapolation point is required, the
+            option is also priced on trees with about twice and four
+            times the given number of steps (the parity of the number
+            of steps is preserved, since some trees use odd numbers
+            only) and the results are extrapolated to an infinite
+            number of steps by Richardson extrapolation in 1/n.  Two
+            points remove the error of order 1/n; three points also
+            remove the error of order 1/n^2.  The extrapolation is
+            only effective for trees whose convergence is smooth, such
+            as LeisenReimer or Joshi4, and not for oscillating ones.
+        */
         BinomialVanillaEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
-             Size timeSteps)
-        : process_(process), timeSteps_(timeSteps) {
+             Size timeSteps,
+             Size extrapolationPoints = 1)
+        : process_(process), timeSteps_(timeSteps),
+          extrapolationPoints_(extrapolationPoints) {
             QL_REQUIRE(timeSteps >= 2,
                        "at least 2 time steps required, "
                        << timeSteps << " provided");
+            QL_REQUIRE(extrapolationPoints >= 1 && extrapolationPoints <= 3,
+                       "1, 2 or 3 extrapolation points required, "
+                       << extrapolationPoints << " provided");
             registerWith(process_);
         }
         void calculate() const;
       private:
+        void calculate(const boost::shared_ptr<StochasticProcess1D>& bs,
+                       Rate r, Time maturity, Real strike, Size timeSteps,
+                       Real& value, Real& delta, Real& gamma) const;
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
-        Size timeSteps_;
+        Size timeSteps_, extrapolationPoints_;
     };
 
 
@@ -112,13 +131,51 @@ namespace QuantLib {
                                       process_->stateVariable(),
                                       flatDividends, flatRiskFree, flatVol));
 
-        TimeGrid grid(maturity, timeSteps_);
+        // the process above is shared by all the trees
+        std::vector<Size> steps(extrapolationPoints_, timeSteps_);
+        for (Size k=1; k<steps.size(); ++k)
+            steps[k] = 2*steps[k-1] + steps[k-1]%2;
+
+        Real p0 = 0.0, delta = 0.0, gamma = 0.0;
+        for (Size k=0; k<steps.size(); ++k) {
+            // Lagrange weight of the k-th point when interpolating
+            // in 1/n and evaluating at 1/n = 0
+            Real weight = 1.0;
+            for (Size l=0; l<steps.size(); ++l) {
+                if (l != k)
+                    weight *= (1.0/steps[l]) / (1.0/steps[l] - 1.0/steps[k]);
+            }
+            Real value_k, delta_k, gamma_k;
+            calculate(bs, r, maturity, payoff->strike(), steps[k],
+                      value_k, delta_k, gamma_k);
+            p0 += weight*value_k;
+            delta += weight*delta_k;
+            gamma += weight*gamma_k;
+        }
+
+        // Store results
+        results_.value = p0;
+        results_.delta = delta;
+        results_.gamma = gamma;
+        results_.theta = blackScholesTheta(process_,
+                                           results_.value,
+                                           results_.delta,
+                                           results_.gamma);
+    }
 
-        boost::shared_ptr<T> tree(new T(bs, maturity, timeSteps_,
-                                        payoff->strike()));
+    template <class T>
+    void BinomialVanillaEngine<T>::calculate(
+                            const boost::shared_ptr<StochasticProcess1D>& bs,
+                            Rate r, Time maturity, Real strike,
+                            Size timeSteps,
+                            Real& value, Real& delta, Real& gamma) const {
+
+        TimeGrid grid(maturity, timeSteps);
+
+        boost::shared_ptr<T> tree(new T(bs, maturity, timeSteps, strike));
 
         boost::shared_ptr<BlackScholesLattice<T> > lattice(
-            new BlackScholesLattice<T>(tree, r, maturity, timeSteps_));
+            new BlackScholesLattice<T>(tree, r, maturity, timeSteps));
 
         DiscretizedVanillaOption option(arguments_, *process_, grid);
 
@@ -143,7 +200,7 @@ namespace QuantLib {
         // calculate gamma by taking the first derivate of the two deltas
         Real delta2u = (p2u - p2m)/(s2u-s2m);
         Real delta2d = (p2m-p2d)/(s2m-s2d);
-        Real gamma = (delta2u - delta2d) / ((s2u-s2d)/2);
+        gamma = (delta2u - delta2d) / ((s2u-s2d)/2);
 
         // Rollback to second-last step, and get option values (p1) at
         // this point
@@ -155,20 +212,11 @@ namespace QuantLib {
         Real s1u = lattice->underlying(1, 1); // up (high) price
         Real s1d = lattice->underlying(1, 0); // down (low) price
 
-        Real delta = (p1u - p1d) / (s1u - s1d);
+        delta = (p1u - p1d) / (s1u - s1d);
 
         // Finally, rollback to t=0
         option.rollback(0.0);
-        Real p0 = option.presentValue();
-
-        // Store results
-        results_.value = p0;
-        results_.delta = delta;
-        results_.gamma = gamma;
-        results_.theta = blackScholesTheta(process_,
-                                           results_.value,
-                                           results_.delta,
-                                           results_.gamma);
+        value = option.presentValue();
     }
 
 }
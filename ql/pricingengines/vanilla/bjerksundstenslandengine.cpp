@@ -42,38 +42,6 @@ namespace QuantLib {
                 cumNormalDist(d - 2.0 * std::log(I/S) / std::sqrt(variance)));
         }
 
-
-        Real americanCallApproximation(Real S, Real X,
-                                       Real rfD, Real dD, Real variance) {
-
-            Real bT = std::log(dD/rfD);
-            Real rT = std::log(1.0/rfD);
-
-            Real beta = (0.5 - bT/variance) +
-                std::sqrt(std::pow((bT/variance - 0.5), Real(2.0))
-                          + 2.0 * rT/variance);
-            Real BInfinity = beta / (beta - 1.0) * X;
-            // Real B0 = std::max(X, std::log(rfD) / std::log(dD) * X);
-            Real B0 = std::max(X, rT / (rT - bT) * X);
-            Real ht = -(bT + 2.0*std::sqrt(variance)) * B0 / (BInfinity - B0);
-
-            // investigate what happen to I for dD->0.0
-            Real I = B0 + (BInfinity - B0) * (1 - std::exp(ht));
-            QL_REQUIRE(I >= X,
-                       "Bjerksund-Stensland approximation not applicable "
-                       "to this set of parameters");
-            if (S >= I) {
-                return S - X;
-            } else {
-                // investigate what happen to alpha for dD->0.0
-                return (I - X) * std::pow(S/I, beta)
-                        *(1 - phi(S, beta, I, I, rT, bT, variance))
-                    +    S *  phi(S,  1.0, I, I, rT, bT, variance)
-                    -    S *  phi(S,  1.0, X, I, rT, bT, variance)
-                    -    X *  phi(S,  0.0, I, I, rT, bT, variance)
-                    +    X *  phi(S,  0.0, X, I, rT, bT, variance);
-            }
-        }
     }
 
     BjerksundStenslandApproximationEngine::
@@ -83,6 +51,41 @@ namespace QuantLib {
         registerWith(process_);
     }
 
+    Real BjerksundStenslandApproximationEngine::americanCallApproximation(
+                                                    Real S, Real X,
+                                                    DiscountFactor rfD,
+                                                    DiscountFactor dD,
+                                                    Real variance) {
+
+        Real bT = std::log(dD/rfD);
+        Real rT = std::log(1.0/rfD);
+
+        Real beta = (0.5 - bT/variance) +
+            std::sqrt(std::pow((bT/variance - 0.5), Real(2.0))
+                      + 2.0 * rT/variance);
+        Real BInfinity = beta / (beta - 1.0) * X;
+        // Real B0 = std::max(X, std::log(rfD) / std::log(dD) * X);
+        Real B0 = std::max(X, rT / (rT - bT) * X);
+        Real ht = -(bT + 2.0*std::sqrt(variance)) * B0 / (BInfinity - B0);
+
+        // investigate what happen to I for dD->0.0
+        Real I = B0 + (BInfinity - B0) * (1 - std::exp(ht));
+        QL_REQUIRE(I >= X,
+                   "Bjerksund-Stensland approximation not applicable "
+                   "to this set of parameters");
+        if (S >= I) {
+            return S - X;
+        } else {
+            // investigate what happen to alpha for dD->0.0
+            return (I - X) * std::pow(S/I, beta)
+                    *(1 - phi(S, beta, I, I, rT, bT, variance))
+                +    S *  phi(S,  1.0, I, I, rT, bT, variance)
+                -    S *  phi(S,  1.0, X, I, rT, bT, variance)
+                -    X *  phi(S,  0.0, I, I, rT, bT, variance)
+                +    X *  phi(S,  0.0, X, I, rT, bT, variance);
+        }
+    }
+
     void BjerksundStenslandApproximationEngine::calculate() const {
 
         QL_REQUIRE(arguments_.exercise->type() == Exercise::American,
@@ -41,6 +41,15 @@ namespace QuantLib {
       public:
         BjerksundStenslandApproximationEngine(
                     const boost::shared_ptr<GeneralizedBlackScholesProcess>&);
+        //! value of an American call when early exercise can be optimal
+        /*! Puts can be priced by put-call symmetry, i.e., by swapping
+            spot and strike and the two discount factors.
+        */
+        static Real americanCallApproximation(Real spot,
+                                              Real strike,
+                                              DiscountFactor riskFreeDiscount,
+                                              DiscountFactor dividendDiscount,
+                                              Real variance);
         void calculate() const;
       private:
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
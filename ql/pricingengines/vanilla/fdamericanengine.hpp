@@ -26,14 +26,16 @@
 #define quantlib_fd_american_engine_hpp
 
 #include <ql/instruments/oneassetoption.hpp>
-#include <ql/pricingengines/vanilla/fdstepconditionengine.hpp>
-#include <ql/pricingengines/vanilla/fdconditions.hpp>
-#include <ql/methods/finitedifferences/fdtypedefs.hpp>
+#include <ql/pricingengines/vanilla/fdmvanillaengineadapter.hpp>
 
 namespace QuantLib {
 
     //! Finite-differences pricing engine for American one asset options
-    /*! \ingroup vanillaengines
+    /*! The option is priced by FdmBlackScholesSolver through
+        FdmVanillaEngineAdapter.  The timeDependent flag is kept for
+        backward compatibility and ignored.
+
+        \ingroup vanillaengines
 
         \test
         - the correctness of the returned value is tested by
@@ -43,18 +45,16 @@ namespace QuantLib {
     */
     template <template <class> class Scheme = CrankNicolson>
     class FDAmericanEngine
-        : public FDEngineAdapter<FDAmericanCondition<
-                                     FDStepConditionEngine<Scheme> >,
-                                 OneAssetOption::engine> {
-        typedef FDEngineAdapter<FDAmericanCondition<
-                                     FDStepConditionEngine<Scheme> >,
-                                OneAssetOption::engine> super;
+        : public FdmVanillaEngineAdapter<OneAssetOption::engine> {
+        typedef FdmVanillaEngineAdapter<OneAssetOption::engine> super;
       public:
         FDAmericanEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
              Size timeSteps=100, Size gridPoints=100,
              bool timeDependent = false)
-        : super(process, timeSteps, gridPoints,timeDependent) {}
+        : super(process, timeSteps, gridPoints,
+                FdmSchemeFor<Scheme>::desc(),
+                FdmVanillaCondition::American) {}
     };
 
 }
@@ -26,45 +26,31 @@
 #define quantlib_fd_bermudan_engine_hpp
 
 #include <ql/instruments/vanillaoption.hpp>
-#include <ql/pricingengines/vanilla/fdmultiperiodengine.hpp>
+#include <ql/pricingengines/vanilla/fdmvanillaengineadapter.hpp>
 
 namespace QuantLib {
 
     //! Finite-differences Bermudan engine
-    /*! \ingroup vanillaengines */
+    /*! The option is priced by FdmBlackScholesSolver through
+        FdmVanillaEngineAdapter, which applies the exercise condition
+        on each of the exercise dates.  The timeDependent flag is kept
+        for backward compatibility and ignored.
+
+        \ingroup vanillaengines
+    */
     template <template <class> class Scheme = CrankNicolson>
-    class FDBermudanEngine : public VanillaOption::engine,
-                             public FDMultiPeriodEngine<Scheme> {
+    class FDBermudanEngine
+        : public FdmVanillaEngineAdapter<VanillaOption::engine> {
+        typedef FdmVanillaEngineAdapter<VanillaOption::engine> super;
       public:
-        // constructor
         FDBermudanEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
              Size timeSteps = 100,
              Size gridPoints = 100,
              bool timeDependent = false)
-        : FDMultiPeriodEngine<Scheme>(process, timeSteps,
-                                      gridPoints, timeDependent) {}
-        void calculate() const {
-            this->setupArguments(&arguments_);
-            FDMultiPeriodEngine<Scheme>::calculate(&results_);
-        }
-      protected:
-        using FDMultiPeriodEngine<Scheme>::calculate;
-
-        Real extraTermInBermudan ;
-        void initializeStepCondition() const {
-            this->stepCondition_ =
-                boost::shared_ptr<StandardStepCondition>(
-                                                  new NullCondition<Array>());
-        };
-        void executeIntermediateStep(Size ) const {
-            Size size = this->intrinsicValues_.size();
-            for (Size j=0; j<size; j++) {
-                this->prices_.value(j) =
-                    std::max(this->prices_.value(j),
-                             this->intrinsicValues_.value(j));
-            }
-        }
+        : super(process, timeSteps, gridPoints,
+                FdmSchemeFor<Scheme>::desc(),
+                FdmVanillaCondition::Exercise) {}
     };
 
 }
@@ -0,0 +1,219 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/timegrid.hpp>
+#include <ql/instruments/payoffs.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmdividendhandler.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesbatchpricer.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        struct BatchContract {
+            Size position;
+            Time maturity;
+            Time exerciseStart;
+            bool american;
+            boost::shared_ptr<StrikedTypePayoff> payoff;
+        };
+
+        bool laterMaturity(const BatchContract& c1,
+                           const BatchContract& c2) {
+            return c1.maturity > c2.maturity;
+        }
+
+    }
+
+    FdBlackScholesBatchPricer::FdBlackScholesBatchPricer(
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Size tGrid, Size xGrid, Size dampingSteps,
+            bool localVol, Real illegalLocalVolOverwrite)
+    : process_(process),
+      tGrid_(tGrid), xGrid_(xGrid), dampingSteps_(dampingSteps),
+      localVol_(localVol),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+        QL_REQUIRE(process_, "null process given");
+        QL_REQUIRE(tGrid_ > 0, "at least one time step required");
+    }
+
+    std::vector<Real> FdBlackScholesBatchPricer::NPVs(
+        const std::vector<boost::shared_ptr<VanillaOption> >& options,
+        const DividendSchedule& dividends) const {
+
+        const Size n = options.size();
+        if (n == 0)
+            return std::vector<Real>();
+
+        // 1. contracts, sorted by decreasing maturity
+        std::vector<BatchContract> contracts(n);
+        for (Size i=0; i<n; ++i) {
+            BatchContract& c = contracts[i];
+            const boost::shared_ptr<Exercise> exercise = options[i]->exercise();
+            QL_REQUIRE(exercise->type() == Exercise::European
+                       || exercise->type() == Exercise::American,
+                       "option #" << i << ": only European and American "
+                       "exercises are supported");
+            c.payoff = boost::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                       options[i]->payoff());
+            QL_REQUIRE(c.payoff,
+                       "option #" << i << ": non-striked payoff given");
+            c.position = i;
+            c.maturity = process_->time(exercise->lastDate());
+            QL_REQUIRE(c.maturity > 0.0, "option #" << i << " is expired");
+            c.american = (exercise->type() == Exercise::American);
+            c.exerciseStart = c.american ?
+                std::max(process_->time(exercise->dates().front()), 0.0) :
+                c.maturity;
+        }
+        std::stable_sort(contracts.begin(), contracts.end(), laterMaturity);
+
+        // 2. common mesher and operator
+        const Real spot = process_->x0();
+        const Time maxMaturity = contracts.front().maturity;
+        const boost::shared_ptr<Fdm1dMesher> equityMesher(
+            new FdmBlackScholesMesher(
+                    xGrid_, process_, maxMaturity, spot,
+                    Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                    std::pair<Real, Real>(spot, 0.1)));
+        const boost::shared_ptr<FdmMesher> mesher(
+            new FdmMesherComposite(equityMesher));
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        const Size size = layout->size();
+
+        FdmBlackScholesOp op(mesher, process_, spot,
+                             localVol_, illegalLocalVolOverwrite_);
+        const bool timeDependent = op.isTimeDependent();
+
+        const FdmDividendHandler dividendHandler(
+            dividends, mesher,
+            process_->riskFreeRate()->referenceDate(),
+            process_->riskFreeRate()->dayCounter(), 0);
+
+        // 3. time grid including all maturities and ex-dividend times
+        std::vector<Time> mandatoryTimes(n);
+        for (Size i=0; i<n; ++i)
+            mandatoryTimes[i] = contracts[i].maturity;
+        const std::vector<Time>& dividendTimes =
+            dividendHandler.dividendTimes();
+        for (Size i=0; i<dividendTimes.size(); ++i) {
+            if (dividendTimes[i] > 0.0 && dividendTimes[i] < maxMaturity)
+                mandatoryTimes.push_back(dividendTimes[i]);
+        }
+        const TimeGrid grid(mandatoryTimes.begin(), mandatoryTimes.end(),
+                            tGrid_);
+
+        // 4. roll back; the columns of the value matrix follow the
+        //    order of the contracts, the first ones are alive
+        Matrix values(size, 0), explicitPart, rhs;
+        std::vector<Array> exerciseValues;
+        Size alive = 0, stepsSinceMaturity = 0;
+        bool timeSet = false;
+
+        for (Size i=grid.size()-1; i>0; --i) {
+            const Time t = grid[i];
+
+            Size entering = alive;
+            while (entering < n
+                   && grid.closestIndex(contracts[entering].maturity) == i)
+                ++entering;
+            if (entering > alive) {
+                Matrix tmp(size, entering);
+                for (Size j=0; j<size; ++j) {
+                    std::copy(values.row_begin(j), values.row_end(j),
+                              tmp.row_begin(j));
+                }
+                for (Size k=alive; k<entering; ++k) {
+                    FdmLogInnerValue calculator(contracts[k].payoff,
+                                                mesher, 0);
+                    Array exercise(size);
+                    for (FdmLinearOpIterator iter = layout->begin();
+                         iter != layout->end(); ++iter) {
+                        const Size j = iter.index();
+                        tmp[j][k] = calculator.avgInnerValue(iter, t);
+                        exercise[j] = calculator.innerValue(iter, t);
+                    }
+                    exerciseValues.push_back(exercise);
+                }
+                values.swap(tmp);
+                explicitPart = Matrix(size, entering);
+                rhs = Matrix(size, entering);
+                alive = entering;
+                stepsSinceMaturity = 0;
+            }
+
+            const Time dt = t - grid[i-1];
+            if (timeDependent || !timeSet) {
+                op.setTime(grid[i-1], t);
+                timeSet = true;
+            }
+
+            const Real theta = (stepsSinceMaturity < dampingSteps_) ? 1.0 : 0.5;
+            if (theta < 1.0) {
+                op.apply_columns(values, explicitPart);
+                for (Size j=0; j<size; ++j) {
+                    const Real* v = values.row_begin(j);
+                    const Real* e = explicitPart.row_begin(j);
+                    Real* r = rhs.row_begin(j);
+                    for (Size k=0; k<alive; ++k)
+                        r[k] = v[k] + (1.0-theta)*dt*e[k];
+                }
+                op.solve_splitting_columns(rhs, -theta*dt, values);
+            } else {
+                op.solve_splitting_columns(values, -dt, rhs);
+                values.swap(rhs);
+            }
+            ++stepsSinceMaturity;
+
+            dividendHandler.applyTo(values, grid[i-1]);
+
+            for (Size k=0; k<alive; ++k) {
+                if (contracts[k].american
+                    && grid[i-1] >= contracts[k].exerciseStart) {
+                    const Array& exercise = exerciseValues[k];
+                    for (Size j=0; j<size; ++j)
+                        values[j][k] = std::max(values[j][k], exercise[j]);
+                }
+            }
+        }
+        QL_ENSURE(alive == n, "not all the options entered the roll-back");
+
+        // 5. interpolation at the spot
+        const std::vector<Real>& x = equityMesher->locations();
+        const Real logSpot = std::log(spot);
+        std::vector<Real> npvs(n);
+        Array column(size);
+        for (Size k=0; k<n; ++k) {
+            std::copy(values.column_begin(k), values.column_end(k),
+                      column.begin());
+            npvs[contracts[k].position] =
+                MonotonicCubicNaturalSpline(x.begin(), x.end(),
+                                            column.begin())(logSpot);
+        }
+        return npvs;
+    }
+
+}
@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdblackscholesbatchpricer.hpp
+    \brief Finite-differences pricing of several vanilla options
+           sharing the same Black-Scholes process
+*/
+
+#ifndef quantlib_fd_black_scholes_batch_pricer_hpp
+#define quantlib_fd_black_scholes_batch_pricer_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/instruments/dividendschedule.hpp>
+#include <ql/utilities/null.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class GeneralizedBlackScholesProcess;
+
+    //! Finite-differences pricer for a book of vanilla options
+    /*! Options on the same underlying differ only in their payoffs
+        and exercises; instead of building a mesher, an operator and a
+        solver for each of them, as FdBlackScholesVanillaEngine does,
+        this class builds them once for the longest maturity and
+        rolls back the values of all the options together.  The
+        values are stored as the columns of a matrix, so that each
+        pass of the tridiagonal solver processes all the options.
+
+        An option enters the roll-back at its maturity; the time grid
+        contains all the maturities.  European and American exercises
+        are supported; for the latter, the early-exercise condition is
+        applied at each step.  The first steps after each maturity can
+        be taken with implicit Euler to damp the effect of the kinks
+        of the payoffs.
+
+        \warning Since the mesh is shared, it is concentrated around
+                 the spot rather than around the strikes; options
+                 with strikes far from the spot might need a finer
+                 mesh than with FdBlackScholesVanillaEngine.
+
+        \ingroup vanillaengines
+
+        \test the returned values are tested against those of
+              FdBlackScholesVanillaEngine.
+    */
+    class FdBlackScholesBatchPricer {
+      public:
+        /*! \param tGrid  number of time steps up to the longest
+                          maturity.
+        */
+        FdBlackScholesBatchPricer(
+                const boost::shared_ptr<GeneralizedBlackScholesProcess>&,
+                Size tGrid = 100, Size xGrid = 100, Size dampingSteps = 0,
+                bool localVol = false,
+                Real illegalLocalVolOverwrite = -Null<Real>());
+
+        //! values of the given options, in the same order
+        /*! Cash dividends paid by the underlying can be passed; as in
+            FdBlackScholesVanillaEngine, the values of the options
+            alive at each ex-dividend date are shifted along the spot
+            direction.
+        */
+        std::vector<Real> NPVs(
+            const std::vector<boost::shared_ptr<VanillaOption> >&,
+            const DividendSchedule& dividends = DividendSchedule()) const;
+
+      private:
+        const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        const Size tGrid_, xGrid_, dampingSteps_;
+        const bool localVol_;
+        const Real illegalLocalVolOverwrite_;
+    };
+
+}
+
+#endif
@@ -28,11 +28,17 @@
 #include <ql/instruments/dividendvanillaoption.hpp>
 #include <ql/pricingengines/vanilla/fddividendengine.hpp>
 #include <ql/pricingengines/vanilla/fdconditions.hpp>
+#include <ql/pricingengines/vanilla/fdmvanillaengineadapter.hpp>
 
 namespace QuantLib {
 
     //! Finite-differences pricing engine for dividend American options
-    /*! \ingroup vanillaengines
+    /*! The option is priced by FdmBlackScholesSolver through
+        FdmVanillaEngineAdapter; each dividend is modeled as a jump of
+        the underlying on its payment date.  The timeDependent flag is
+        kept for backward compatibility and ignored.
+
+        \ingroup vanillaengines
 
         \test
         - the correctness of the returned greeks is tested by
@@ -42,16 +48,16 @@ namespace QuantLib {
     */
     template <template <class> class Scheme = CrankNicolson>
     class FDDividendAmericanEngine
-        : public FDEngineAdapter<FDAmericanCondition<FDDividendEngine<Scheme> >,
-                                 DividendVanillaOption::engine> {
-        typedef FDEngineAdapter<FDAmericanCondition<FDDividendEngine<Scheme> >,
-                                DividendVanillaOption::engine> super;
+        : public FdmVanillaEngineAdapter<DividendVanillaOption::engine> {
+        typedef FdmVanillaEngineAdapter<DividendVanillaOption::engine> super;
       public:
         FDDividendAmericanEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
              Size timeSteps=100, Size gridPoints=100,
              bool timeDependent = false)
-        : super(process, timeSteps, gridPoints,timeDependent) {}
+        : super(process, timeSteps, gridPoints,
+                FdmSchemeFor<Scheme>::desc(),
+                FdmVanillaCondition::American) {}
     };
 
 
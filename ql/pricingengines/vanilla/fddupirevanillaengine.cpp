@@ -0,0 +1,188 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/timegrid.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/instruments/payoffs.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmdupireop.hpp>
+#include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+#include <ql/pricingengines/vanilla/fddupirevanillaengine.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    FdDupireVanillaEngine::FdDupireVanillaEngine(
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Size tGrid, Size xGrid, Size dampingSteps,
+            Real illegalLocalVolOverwrite)
+    : process_(process),
+      tGrid_(tGrid), xGrid_(xGrid), dampingSteps_(dampingSteps),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      solved_(false) {
+        QL_REQUIRE(tGrid_ > 0, "at least one time step required");
+        QL_REQUIRE(xGrid_ > 3, "at least four strikes required");
+
+        registerWith(process_);
+    }
+
+    void FdDupireVanillaEngine::update() {
+        solved_ = false;
+        VanillaOption::engine::update();
+    }
+
+    void FdDupireVanillaEngine::addExpiries(const std::vector<Date>& dates) {
+        for (Size i=0; i<dates.size(); ++i)
+            addExpiry(process_->time(dates[i]));
+    }
+
+    void FdDupireVanillaEngine::addExpiry(Time t) const {
+        QL_REQUIRE(t > 0.0, "expiry time (" << t << ") must be positive");
+        std::vector<Time>::iterator i =
+            std::lower_bound(expiryTimes_.begin(), expiryTimes_.end(), t);
+        if (i == expiryTimes_.end() || !close_enough(*i, t)) {
+            expiryTimes_.insert(i, t);
+            solved_ = false;
+        }
+    }
+
+    const std::vector<Time>& FdDupireVanillaEngine::expiryTimes() const {
+        return expiryTimes_;
+    }
+
+    Disposable<Array> FdDupireVanillaEngine::strikes() const {
+        if (!solved_)
+            solve();
+        Array strikes = Exp(logStrikes_);
+        return strikes;
+    }
+
+    const Matrix& FdDupireVanillaEngine::callPrices() const {
+        if (!solved_)
+            solve();
+        return callPrices_;
+    }
+
+    void FdDupireVanillaEngine::solve() const {
+        QL_REQUIRE(!expiryTimes_.empty(), "no expiry given");
+
+        const Real spot = process_->x0();
+        const Time maturity = expiryTimes_.back();
+
+        // the strike grid is centered on the spot, where the initial
+        // payoff has its kink
+        const boost::shared_ptr<Fdm1dMesher> strikeMesher(
+            new FdmBlackScholesMesher(
+                    xGrid_, process_, maturity, spot,
+                    Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                    std::pair<Real, Real>(spot, 0.1)));
+        const boost::shared_ptr<FdmMesher> mesher(
+            new FdmMesherComposite(strikeMesher));
+
+        const std::vector<Real>& y = strikeMesher->locations();
+        logStrikes_ = Array(y.begin(), y.end());
+        callPrices_ = Matrix(expiryTimes_.size(), y.size());
+
+        Array c(y.size());
+        for (Size j=0; j<y.size(); ++j)
+            c[j] = std::max(spot - std::exp(y[j]), 0.0);
+
+        const boost::shared_ptr<FdmDupireOp> op(
+            new FdmDupireOp(mesher,
+                            process_->riskFreeRate().currentLink(),
+                            process_->dividendYield().currentLink(),
+                            process_->localVolatility().currentLink(),
+                            illegalLocalVolOverwrite_));
+        ImplicitEulerScheme implicitEuler(op);
+        DouglasScheme crankNicolson(0.5, op);
+
+        const TimeGrid grid(expiryTimes_.begin(), expiryTimes_.end(),
+                            std::max(tGrid_, expiryTimes_.size()));
+
+        Size expiry = 0;
+        for (Size i=1; i<grid.size(); ++i) {
+            const Time dt = grid[i] - grid[i-1];
+            if (i <= dampingSteps_) {
+                implicitEuler.setStep(dt);
+                implicitEuler.step(c, grid[i]);
+            } else {
+                crankNicolson.setStep(dt);
+                crankNicolson.step(c, grid[i]);
+            }
+
+            while (expiry < expiryTimes_.size()
+                   && close_enough(grid[i], expiryTimes_[expiry])) {
+                std::copy(c.begin(), c.end(), callPrices_.row_begin(expiry));
+                ++expiry;
+            }
+        }
+        QL_ENSURE(expiry == expiryTimes_.size(),
+                  "expiry times not found on the time grid");
+
+        solved_ = true;
+    }
+
+    Real FdDupireVanillaEngine::callPrice(Size expiry, Real strike) const {
+        const Real y = std::log(strike);
+        QL_REQUIRE(y >= logStrikes_.front() && y <= logStrikes_.back(),
+                   "strike " << strike << " outside the grid ["
+                   << std::exp(logStrikes_.front()) << ", "
+                   << std::exp(logStrikes_.back()) << "]");
+
+        return CubicNaturalSpline(logStrikes_.begin(), logStrikes_.end(),
+                                  callPrices_.row_begin(expiry))(y);
+    }
+
+    void FdDupireVanillaEngine::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        const boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        const Date maturityDate = arguments_.exercise->lastDate();
+        const Time t = process_->time(maturityDate);
+        addExpiry(t);
+        if (!solved_)
+            solve();
+
+        const Size expiry =
+            std::lower_bound(expiryTimes_.begin(), expiryTimes_.end(),
+                             t*(1.0-QL_EPSILON)) - expiryTimes_.begin();
+
+        const Real strike = payoff->strike();
+        const Real call = callPrice(expiry, strike);
+        switch (payoff->optionType()) {
+          case Option::Call:
+            results_.value = call;
+            break;
+          case Option::Put:
+            results_.value = call
+                - process_->x0()*process_->dividendYield()->discount(t)
+                + strike*process_->riskFreeRate()->discount(t);
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fddupirevanillaengine.hpp
+    \brief Finite-differences engine pricing all strikes and expiries
+           with a single forward (Dupire) solve
+*/
+
+#ifndef quantlib_fd_dupire_vanilla_engine_hpp
+#define quantlib_fd_dupire_vanilla_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/utilities/null.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class GeneralizedBlackScholesProcess;
+
+    //! Finite-differences engine for European options based on the Dupire equation
+    /*! Instead of solving one backward equation per option, the engine
+        evolves the call prices forward in the maturity, using the
+        log-strike as the spatial variable and the local volatility
+        of the process (see FdmDupireOp).  A single solve thus gives
+        the prices of the calls for all the strikes of the grid at all
+        the expiries known to the engine; puts follow from put-call
+        parity and strikes between grid points are obtained by cubic
+        interpolation.
+
+        Expiries are collected as options are priced: an option with
+        an expiry not yet known triggers a new solve including all the
+        expiries seen so far. Calling addExpiries() beforehand prices
+        a whole surface with a single solve.  The solution is
+        discarded when the process changes.
+
+        Crank-Nicolson steps are used, optionally preceded by implicit
+        Euler damping steps to smooth the kink of the initial payoff.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with Black pricing and with the backward
+              finite-differences engine under local volatility.
+    */
+    class FdDupireVanillaEngine : public VanillaOption::engine {
+      public:
+        FdDupireVanillaEngine(
+                const boost::shared_ptr<GeneralizedBlackScholesProcess>&,
+                Size tGrid = 100, Size xGrid = 200, Size dampingSteps = 2,
+                Real illegalLocalVolOverwrite = -Null<Real>());
+
+        void calculate() const;
+        void update();
+
+        //! adds expiries to be priced by the next solve
+        void addExpiries(const std::vector<Date>& expiries);
+
+        //! \name Full price grid
+        //@{
+        //! times to the known expiries, sorted
+        const std::vector<Time>& expiryTimes() const;
+        Disposable<Array> strikes() const;
+        //! call prices, with one row per expiry and one column per strike
+        const Matrix& callPrices() const;
+        //@}
+      private:
+        void addExpiry(Time t) const;
+        void solve() const;
+        Real callPrice(Size expiry, Real strike) const;
+
+        const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        const Size tGrid_, xGrid_, dampingSteps_;
+        const Real illegalLocalVolOverwrite_;
+
+        mutable std::vector<Time> expiryTimes_;
+        mutable Array logStrikes_;
+        mutable Matrix callPrices_;
+        mutable bool solved_;
+    };
+}
+
+#endif
@@ -26,63 +26,38 @@
 #define quantlib_fd_european_engine_hpp
 
 #include <ql/instruments/oneassetoption.hpp>
-#include <ql/pricingengines/vanilla/fdvanillaengine.hpp>
-#include <ql/pricingengines/greeks.hpp>
-#include <ql/methods/finitedifferences/cranknicolson.hpp>
+#include <ql/pricingengines/vanilla/fdmvanillaengineadapter.hpp>
 #include <ql/math/sampledcurve.hpp>
 
 namespace QuantLib {
 
     //! Pricing engine for European options using finite-differences
-    /*! \ingroup vanillaengines
+    /*! The option is priced by FdmBlackScholesSolver through
+        FdmVanillaEngineAdapter; the price curve on the mesh is
+        returned as the "priceCurve" additional result.  The
+        timeDependent flag is kept for backward compatibility and
+        ignored, since the Fdm operators always use the
+        time-dependent rates and volatility.
+
+        \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
               checking it against analytic results.
     */
     template <template <class> class Scheme = CrankNicolson>
-    class FDEuropeanEngine : public OneAssetOption::engine,
-                             public FDVanillaEngine {
+    class FDEuropeanEngine
+        : public FdmVanillaEngineAdapter<OneAssetOption::engine> {
+        typedef FdmVanillaEngineAdapter<OneAssetOption::engine> super;
       public:
         FDEuropeanEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
              Size timeSteps=100, Size gridPoints=100,
              bool timeDependent = false)
-        : FDVanillaEngine(process, timeSteps, gridPoints, timeDependent),
-          prices_(gridPoints) {
-            registerWith(process);
-        }
-      private:
-        mutable SampledCurve prices_;
-        void calculate() const;
+        : super(process, timeSteps, gridPoints,
+                FdmSchemeFor<Scheme>::desc(),
+                FdmVanillaCondition::European) {}
     };
 
-
-    template <template <class> class Scheme>
-    void FDEuropeanEngine<Scheme>::calculate() const {
-        setupArguments(&arguments_);
-        setGridLimits();
-        initializeInitialCondition();
-        initializeOperator();
-        initializeBoundaryConditions();
-
-        FiniteDifferenceModel<Scheme<TridiagonalOperator> > model(
-                                             finiteDifferenceOperator_, BCs_);
-
-        prices_ = intrinsicValues_;
-
-        model.rollback(prices_.values(), getResidualTime(),
-                       0, timeSteps_);
-
-        results_.value = prices_.valueAtCenter();
-        results_.delta = prices_.firstDerivativeAtCenter();
-        results_.gamma = prices_.secondDerivativeAtCenter();
-        results_.theta = blackScholesTheta(process_,
-                                           results_.value,
-                                           results_.delta,
-                                           results_.gamma);
-        results_.additionalResults["priceCurve"] = prices_;
-    }
-
 }
 
 
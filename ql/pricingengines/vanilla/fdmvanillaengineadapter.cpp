@@ -0,0 +1,203 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/instruments/payoffs.hpp>
+#include <ql/math/sampledcurve.hpp>
+#include <ql/pricingengines/greeks.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmshoutloginnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/boundarycondition.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/pricingengines/vanilla/fdmvanillaengineadapter.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* Neumann condition as in the legacy engines: the difference
+           between the values at the boundary and at its neighbour is
+           kept equal to the one of the payoff.  Unlike the boundary
+           rows of the Fdm operators, which drop the diffusion term,
+           this is exact for a payoff linear in the underlying.
+        */
+        class FdmPayoffSlopeBoundary : public BoundaryCondition<FdmLinearOp> {
+          public:
+            FdmPayoffSlopeBoundary(Size boundary, Size neighbour,
+                                   Real difference)
+            : boundary_(boundary), neighbour_(neighbour),
+              difference_(difference) {}
+            void setTime(Time) {}
+            void applyBeforeApplying(operator_type&) const {}
+            void applyBeforeSolving(operator_type&, array_type&) const {}
+            void applyAfterApplying(array_type& a) const {
+                a[boundary_] = a[neighbour_] + difference_;
+            }
+            void applyAfterSolving(array_type& a) const {
+                applyAfterApplying(a);
+            }
+          private:
+            Size boundary_, neighbour_;
+            Real difference_;
+        };
+
+    }
+
+    namespace detail {
+
+        void fdmVanillaCalculate(
+               const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+               Size timeSteps, Size gridPoints,
+               const FdmSchemeDesc& schemeDesc,
+               FdmVanillaCondition::Type condition,
+               const boost::shared_ptr<Payoff>& p,
+               const boost::shared_ptr<QuantLib::Exercise>& optionExercise,
+               const DividendSchedule& dividends,
+               OneAssetOption::results& results) {
+
+            const boost::shared_ptr<StrikedTypePayoff> payoff =
+                boost::dynamic_pointer_cast<StrikedTypePayoff>(p);
+            QL_REQUIRE(payoff, "non-striked payoff given");
+
+            const Date maturityDate = optionExercise->lastDate();
+            const Time maturity = process->time(maturityDate);
+
+            // 1. Mesher
+            // same grid as the legacy engines: uniform in the log of
+            // the underlying, centered on the spot value and wide
+            // enough to include the strike
+            const Real spot = process->x0();
+            QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+            QL_REQUIRE(maturity > 0.0, "negative or zero residual time");
+            const Real volSqrtTime = std::sqrt(
+                  process->blackVolatility()->blackVariance(maturity, spot));
+            // the prefactor fine tunes performance at small volatilities
+            const Real prefactor = 1.0 + 0.02/volSqrtTime;
+            const Real minMaxFactor = std::exp(4.0*prefactor*volSqrtTime);
+            const Real safetyZoneFactor = 1.1;
+            Real sMin = spot/minMaxFactor, sMax = spot*minMaxFactor;
+            const Real strike = payoff->strike();
+            if (sMin > strike/safetyZoneFactor) {
+                sMin = strike/safetyZoneFactor;
+                sMax = spot/(sMin/spot);
+            }
+            if (sMax < strike*safetyZoneFactor) {
+                sMax = strike*safetyZoneFactor;
+                sMin = spot/(sMax/spot);
+            }
+
+            const Size minGridPoints = 10, minGridPointsPerYear = 2;
+            const Size size = std::max<Size>(
+                gridPoints,
+                maturity > 1.0
+                    ? Size(minGridPoints + (maturity-1.0)*minGridPointsPerYear)
+                    : minGridPoints);
+
+            const boost::shared_ptr<Fdm1dMesher> equityMesher(
+                new FdmBlackScholesMesher(
+                        size, process, maturity, strike,
+                        std::log(sMin), std::log(sMax), 0.0001, 1.0,
+                        std::pair<Real, Real>(Null<Real>(), Null<Real>())));
+
+            const boost::shared_ptr<FdmMesher> mesher(
+                new FdmMesherComposite(equityMesher));
+
+            // 2. Calculator
+            boost::shared_ptr<FdmInnerValueCalculator> calculator;
+            if (condition == FdmVanillaCondition::Shout) {
+                calculator = boost::shared_ptr<FdmInnerValueCalculator>(
+                    new FdmShoutLogInnerValueCalculator(
+                        process, maturity,
+                        boost::dynamic_pointer_cast<PlainVanillaPayoff>(p),
+                        mesher, 0));
+            } else {
+                calculator = boost::shared_ptr<FdmInnerValueCalculator>(
+                                   new FdmLogInnerValue(payoff, mesher, 0));
+            }
+
+            // 3. Step conditions
+            boost::shared_ptr<QuantLib::Exercise> exercise;
+            switch (condition) {
+              case FdmVanillaCondition::European:
+                exercise = boost::shared_ptr<QuantLib::Exercise>(
+                                      new EuropeanExercise(maturityDate));
+                break;
+              case FdmVanillaCondition::American:
+              case FdmVanillaCondition::Shout:
+                exercise = boost::shared_ptr<QuantLib::Exercise>(
+                                      new AmericanExercise(maturityDate));
+                break;
+              case FdmVanillaCondition::Exercise:
+                exercise = optionExercise;
+                break;
+              default:
+                QL_FAIL("unknown condition");
+            }
+
+            const boost::shared_ptr<FdmStepConditionComposite> conditions =
+                FdmStepConditionComposite::vanillaComposite(
+                                    dividends, exercise, mesher, calculator,
+                                    process->riskFreeRate()->referenceDate(),
+                                    process->riskFreeRate()->dayCounter());
+
+            // 4. Boundary conditions
+            const std::vector<Real>& x = equityMesher->locations();
+            const Size n = x.size();
+            FdmBoundaryConditionSet boundaries;
+            boundaries.push_back(boost::shared_ptr<FdmPayoffSlopeBoundary>(
+                new FdmPayoffSlopeBoundary(
+                      0, 1, (*payoff)(std::exp(x[0]))
+                           -(*payoff)(std::exp(x[1])))));
+            boundaries.push_back(boost::shared_ptr<FdmPayoffSlopeBoundary>(
+                new FdmPayoffSlopeBoundary(
+                      n-1, n-2, (*payoff)(std::exp(x[n-1]))
+                               -(*payoff)(std::exp(x[n-2])))));
+
+            // 5. Solver
+            FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
+                                         calculator, maturity, timeSteps, 0 };
+
+            const FdmBlackScholesSolver solver(
+                             Handle<GeneralizedBlackScholesProcess>(process),
+                             strike, solverDesc, schemeDesc);
+
+            results.value = solver.valueAt(spot);
+            results.delta = solver.deltaAt(spot);
+            results.gamma = solver.gammaAt(spot);
+            results.theta = blackScholesTheta(process,
+                                              results.value,
+                                              results.delta,
+                                              results.gamma);
+
+            // the end points are left out since the interpolation
+            // can't be evaluated beyond them
+            SampledCurve priceCurve(n-2);
+            for (Size i=1; i<n-1; ++i) {
+                const Real s = std::exp(x[i]);
+                priceCurve.gridValue(i-1) = s;
+                priceCurve.value(i-1) = solver.valueAt(s);
+            }
+            results.additionalResults["priceCurve"] = priceCurve;
+        }
+
+    }
+
+}
@@ -0,0 +1,141 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmvanillaengineadapter.hpp
+    \brief finite-difference vanilla engines based on the Fdm framework
+*/
+
+#ifndef quantlib_fdm_vanilla_engine_adapter_hpp
+#define quantlib_fdm_vanilla_engine_adapter_hpp
+
+#include <ql/instruments/dividendvanillaoption.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/cranknicolson.hpp>
+#include <ql/methods/finitedifferences/impliciteuler.hpp>
+#include <ql/methods/finitedifferences/expliciteuler.hpp>
+
+namespace QuantLib {
+
+    class GeneralizedBlackScholesProcess;
+
+    //! Fdm scheme corresponding to a finite-difference evolver
+    /*! Specializations are provided for the Crank-Nicolson, implicit
+        and explicit Euler schemes.
+    */
+    template <template <class> class Scheme>
+    struct FdmSchemeFor;
+
+    template <>
+    struct FdmSchemeFor<CrankNicolson> {
+        // the Douglas scheme with theta = 1/2 is Crank-Nicolson in 1D
+        static FdmSchemeDesc desc() { return FdmSchemeDesc::Douglas(); }
+    };
+
+    template <>
+    struct FdmSchemeFor<ImplicitEuler> {
+        static FdmSchemeDesc desc() { return FdmSchemeDesc::ImplicitEuler(); }
+    };
+
+    template <>
+    struct FdmSchemeFor<ExplicitEuler> {
+        static FdmSchemeDesc desc() { return FdmSchemeDesc::ExplicitEuler(); }
+    };
+
+
+    //! conditions applied by the adapted finite-difference engines
+    struct FdmVanillaCondition {
+        enum Type {
+            European,  //!< exercise at the last exercise date only
+            American,  //!< exercise at any time until the last date
+            Exercise,  //!< the exercise of the priced option
+            Shout      //!< shout at any time until the last date
+        };
+    };
+
+
+    namespace detail {
+
+        void fdmVanillaCalculate(
+               const boost::shared_ptr<GeneralizedBlackScholesProcess>&,
+               Size timeSteps, Size gridPoints,
+               const FdmSchemeDesc& schemeDesc,
+               FdmVanillaCondition::Type condition,
+               const boost::shared_ptr<Payoff>& payoff,
+               const boost::shared_ptr<QuantLib::Exercise>& exercise,
+               const DividendSchedule& dividends,
+               OneAssetOption::results& results);
+
+        inline DividendSchedule fdmDividends(
+                                        const OneAssetOption::arguments&) {
+            return DividendSchedule();
+        }
+
+        inline DividendSchedule fdmDividends(
+                              const DividendVanillaOption::arguments& args) {
+            return args.cashFlow;
+        }
+
+    }
+
+
+    //! finite-difference vanilla engine based on the Fdm framework
+    /*! This class implements the interface of the finite-difference
+        engines built on FiniteDifferenceModel (i.e., FDEuropeanEngine,
+        FDAmericanEngine, FDBermudanEngine, FDDividendAmericanEngine
+        and FDShoutEngine) on top of FdmBlackScholesSolver.  The
+        solver works on the same log-spot grid as the legacy engines,
+        with the same Neumann conditions at its ends; it averages the
+        payoff over the cells around the kink and steps in time
+        without allocating.  Dividends are applied by
+        FdmDividendHandler as jumps of the underlying, and
+        early-exercise and shout conditions by the step conditions
+        of FdmStepConditionComposite.
+
+        Besides the value and the greeks, the price curve on the mesh
+        is returned as the "priceCurve" additional result.
+    */
+    template <class base_engine>
+    class FdmVanillaEngineAdapter : public base_engine {
+      public:
+        FdmVanillaEngineAdapter(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Size timeSteps, Size gridPoints,
+             const FdmSchemeDesc& schemeDesc,
+             FdmVanillaCondition::Type condition)
+        : process_(process), timeSteps_(timeSteps), gridPoints_(gridPoints),
+          schemeDesc_(schemeDesc), condition_(condition) {
+            this->registerWith(process_);
+        }
+        void calculate() const {
+            detail::fdmVanillaCalculate(process_, timeSteps_, gridPoints_,
+                                        schemeDesc_, condition_,
+                                        this->arguments_.payoff,
+                                        this->arguments_.exercise,
+                                        detail::fdmDividends(this->arguments_),
+                                        this->results_);
+        }
+      protected:
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size timeSteps_, gridPoints_;
+        FdmSchemeDesc schemeDesc_;
+        FdmVanillaCondition::Type condition_;
+    };
+
+}
+
+
+#endif
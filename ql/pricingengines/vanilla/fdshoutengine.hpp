@@ -25,32 +25,36 @@
 #ifndef quantlib_fd_shout_engine_hpp
 #define quantlib_fd_shout_engine_hpp
 
-#include <ql/pricingengines/vanilla/fdstepconditionengine.hpp>
-#include <ql/pricingengines/vanilla/fdconditions.hpp>
-#include <ql/instruments/vanillaoption.hpp>
+#include <ql/instruments/oneassetoption.hpp>
+#include <ql/pricingengines/vanilla/fdmvanillaengineadapter.hpp>
 
 namespace QuantLib {
 
     //! Finite-differences pricing engine for shout vanilla options
-    /*! \ingroup vanillaengines
+    /*! The option is priced by FdmBlackScholesSolver through
+        FdmVanillaEngineAdapter; at each step, the value of shouting
+        is given by FdmShoutLogInnerValueCalculator, i.e., the
+        discounted intrinsic value locked in plus the value of an
+        at-the-money option on the remaining life.  The timeDependent
+        flag is kept for backward compatibility and ignored.
+
+        \ingroup vanillaengines
 
         \test the correctness of the returned greeks is tested by
               reproducing numerical derivatives.
     */
     template <template <class> class Scheme = CrankNicolson>
     class FDShoutEngine
-        : public FDEngineAdapter<FDShoutCondition<
-                                     FDStepConditionEngine<Scheme> >,
-                                 OneAssetOption::engine> {
-        typedef FDEngineAdapter<FDShoutCondition<
-                                     FDStepConditionEngine<Scheme> >,
-                                OneAssetOption::engine> super;
+        : public FdmVanillaEngineAdapter<OneAssetOption::engine> {
+        typedef FdmVanillaEngineAdapter<OneAssetOption::engine> super;
       public:
         FDShoutEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
              Size timeSteps=100, Size gridPoints=100,
              bool timeDependent = false)
-        : super(process, timeSteps, gridPoints,timeDependent) {}
+        : super(process, timeSteps, gridPoints,
+                FdmSchemeFor<Scheme>::desc(),
+                FdmVanillaCondition::Shout) {}
     };
 
 }
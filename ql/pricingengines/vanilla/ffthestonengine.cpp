@@ -0,0 +1,189 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/vanilla/ffthestonengine.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/instruments/payoffs.hpp>
+#include <ql/exercise.hpp>
+
+namespace QuantLib {
+
+    FFTHestonEngine::FFTHestonEngine(
+                              const boost::shared_ptr<HestonModel>& model,
+                              Size log2n, Real logStrikeSpacing, Real alpha)
+    : GenericModelEngine<HestonModel,
+                         VanillaOption::arguments,
+                         VanillaOption::results>(model),
+      log2n_(log2n), lambda_(logStrikeSpacing), alpha_(alpha) {
+        QL_REQUIRE(log2n_ > 1, "at least four grid points required");
+        QL_REQUIRE(lambda_ > 0.0, "positive log-strike spacing required");
+        QL_REQUIRE(alpha_ > 0.0, "positive damping factor required");
+    }
+
+    void FFTHestonEngine::update() {
+        slices_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    std::complex<Real> FFTHestonEngine::lnChF(
+                                const std::complex<Real>& z, Time t) const {
+
+        const Real kappa = model_->kappa();
+        const Real sigma = model_->sigma();
+        const Real theta = model_->theta();
+        const Real rho   = model_->rho();
+        const Real v0    = model_->v0();
+
+        const Real sigma2 = sigma*sigma;
+
+        const std::complex<Real> g
+            = kappa + rho*sigma*std::complex<Real>(z.imag(), -z.real());
+
+        const std::complex<Real> D = std::sqrt(
+            g*g + (z*z + std::complex<Real>(-z.imag(), z.real()))*sigma2);
+
+        const std::complex<Real> G = (g-D)/(g+D);
+
+        return v0/sigma2*(1.0-std::exp(-D*t))/(1.0-G*std::exp(-D*t))
+                *(g-D) + kappa*theta/sigma2*((g-D)*t
+                -2.0*std::log((1.0-G*std::exp(-D*t))/(1.0-G)));
+    }
+
+    std::complex<Real> FFTHestonEngine::chF(
+                                const std::complex<Real>& z, Time t) const {
+        return std::exp(lnChF(z, t));
+    }
+
+    const FFTHestonEngine::Slice& FFTHestonEngine::slice(Time t) const {
+        std::map<Time, boost::shared_ptr<Slice> >::const_iterator i =
+            slices_.find(t);
+        if (i != slices_.end())
+            return *(i->second);
+
+        const Size n = static_cast<Size>(1) << log2n_;
+
+        // log-moneyness range (equation 19, 20) and spacing of the
+        // integration grid (equation 23)
+        const Real b = n*lambda_/2.0;
+        const Real eta = 2.0*M_PI/(lambda_*n);
+
+        const std::complex<Real> i1(0.0, 1.0);
+        std::vector<std::complex<Real> > fti(n);
+        for (Size j=0; j<n; ++j) {
+            const Real v = eta*j;
+            // Simpson weights
+            const Real sw = eta*(3.0 + ((j % 2) == 0 ? -1.0 : 1.0)
+                                 - ((j == 0) ? 1.0 : 0.0))/3.0;
+
+            const std::complex<Real> psi =
+                chF(std::complex<Real>(v, -(alpha_+1.0)), t)
+                / std::complex<Real>(alpha_*alpha_ + alpha_ - v*v,
+                                     (2.0*alpha_ + 1.0)*v);
+
+            fti[j] = std::exp(i1*b*v)*sw*psi;
+        }
+
+        std::vector<std::complex<Real> > results(n);
+        FastFourierTransform fft(log2n_);
+        fft.transform(fti.begin(), fti.end(), results.begin());
+
+        boost::shared_ptr<Slice> s(new Slice);
+        s->logMoneyness.resize(n);
+        s->callPrices.resize(n);
+        for (Size j=0; j<n; ++j) {
+            const Real x = -b + lambda_*j;
+            s->logMoneyness[j] = x;
+            s->callPrices[j] = std::exp(-alpha_*x)/M_PI*results[j].real();
+        }
+        s->interpolation = CubicNaturalSpline(s->logMoneyness.begin(),
+                                              s->logMoneyness.end(),
+                                              s->callPrices.begin());
+        s->interpolation.update();
+
+        slices_[t] = s;
+        return *s;
+    }
+
+    Real FFTHestonEngine::value(Option::Type type, Real strike,
+                                Time t) const {
+        QL_REQUIRE(strike > 0.0, "positive strike required");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+        const DiscountFactor df = process->riskFreeRate()->discount(t, true);
+        const DiscountFactor div =
+            process->dividendYield()->discount(t, true);
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+        const Real fwd = spotPrice*div/df;
+
+        const Slice& s = slice(t);
+        const Real x = std::log(strike/fwd);
+        QL_REQUIRE(x >= s.logMoneyness.front() && x <= s.logMoneyness.back(),
+                   "strike " << strike << " outside the grid ["
+                   << fwd*std::exp(s.logMoneyness.front()) << ", "
+                   << fwd*std::exp(s.logMoneyness.back()) << "]");
+
+        const Real call = df*fwd*s.interpolation(x);
+        switch (type) {
+          case Option::Call:
+            return call;
+          case Option::Put:
+            return call - df*(fwd - strike);
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
+    void FFTHestonEngine::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        const Time t =
+            model_->process()->time(arguments_.exercise->lastDate());
+        results_.value = value(payoff->optionType(), payoff->strike(), t);
+    }
+
+
+    FFTBatesEngine::FFTBatesEngine(const boost::shared_ptr<BatesModel>& model,
+                                   Size log2n, Real logStrikeSpacing,
+                                   Real alpha)
+    : FFTHestonEngine(model, log2n, logStrikeSpacing, alpha) {}
+
+    std::complex<Real> FFTBatesEngine::lnChF(
+                                const std::complex<Real>& z, Time t) const {
+        boost::shared_ptr<BatesModel> batesModel =
+                            boost::dynamic_pointer_cast<BatesModel>(*model_);
+
+        const Real nu     = batesModel->nu();
+        const Real delta2 = 0.5*batesModel->delta()*batesModel->delta();
+        const Real lambda = batesModel->lambda();
+        const std::complex<Real> g(-z.imag(), z.real());
+
+        // compensated log-normal jumps, as in BatesEngine::addOnTerm
+        return FFTHestonEngine::lnChF(z, t)
+            + t*lambda*(std::exp(nu*g + delta2*g*g) - 1.0
+                        - g*(std::exp(nu+delta2) - 1.0));
+    }
+
+}
@@ -0,0 +1,118 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file ffthestonengine.hpp
+    \brief Carr-Madan FFT engines for the Heston and Bates models
+*/
+
+#ifndef quantlib_fft_heston_engine_hpp
+#define quantlib_fft_heston_engine_hpp
+
+#include <ql/pricingengines/genericmodelengine.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/models/equity/batesmodel.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/math/interpolation.hpp>
+#include <complex>
+#include <map>
+
+namespace QuantLib {
+
+    //! Carr-Madan FFT engine for the Heston model
+    /*! A single fast Fourier transform of the damped call price
+        gives the values of the calls on a whole grid of log-strikes
+        around the forward.  The engine stores the resulting slice
+        for each expiry it is asked to price, so that options with
+        the same expiry and any strike are then valued by cubic
+        interpolation on the grid.  The slices are discarded when the
+        model notifies a change.
+
+        Unlike the experimental FFTEngine, no list of options needs
+        to be given in advance.
+
+        \warning puts are obtained by put-call parity; far
+                 out-of-the-money puts can therefore lose some
+                 relative accuracy.
+
+        References:
+        Carr, P. and D. B. Madan (1998),
+        "Option Valuation using the fast Fourier transform,"
+        Journal of Computational Finance, 2, 61-73.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Heston and Bates engines.
+    */
+    class FFTHestonEngine
+        : public GenericModelEngine<HestonModel,
+                                    VanillaOption::arguments,
+                                    VanillaOption::results> {
+      public:
+        /*! \param log2n            the grid has 2^log2n points
+            \param logStrikeSpacing spacing of the log-strike grid; the
+                                    grid spans
+                                    \f$ \pm 2^{log2n-1} \f$ times the
+                                    spacing around the forward.
+            \param alpha            damping factor of the call price
+        */
+        FFTHestonEngine(const boost::shared_ptr<HestonModel>& model,
+                        Size log2n = 12,
+                        Real logStrikeSpacing = 0.005,
+                        Real alpha = 1.25);
+
+        void calculate() const;
+        void update();
+
+        //! value of a European option expiring at the given time
+        Real value(Option::Type type, Real strike, Time t) const;
+
+        //! normalized characteristic function of \f$ \log(S_t/F_t) \f$
+        std::complex<Real> chF(const std::complex<Real>& z, Time t) const;
+        virtual std::complex<Real> lnChF(const std::complex<Real>& z,
+                                         Time t) const;
+      private:
+        // undiscounted call prices, normalized by the forward, on
+        // the grid of log-moneyness for a given expiry
+        struct Slice {
+            std::vector<Real> logMoneyness, callPrices;
+            Interpolation interpolation;
+        };
+        const Slice& slice(Time t) const;
+
+        const Size log2n_;
+        const Real lambda_, alpha_;
+        mutable std::map<Time, boost::shared_ptr<Slice> > slices_;
+    };
+
+
+    //! Carr-Madan FFT engine for the Bates model
+    /*! \ingroup vanillaengines */
+    class FFTBatesEngine : public FFTHestonEngine {
+      public:
+        FFTBatesEngine(const boost::shared_ptr<BatesModel>& model,
+                       Size log2n = 12,
+                       Real logStrikeSpacing = 0.005,
+                       Real alpha = 1.25);
+
+        std::complex<Real> lnChF(const std::complex<Real>& z,
+                                 Time t) const;
+    };
+
+}
+
+#endif
@@ -58,6 +58,13 @@ namespace QuantLib {
                          formula_(formula) {
     }
 
+    void HestonExpansionEngine::update() {
+        expansions_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
     void HestonExpansionEngine::calculate() const
     {
         // this is a european option pricer
@@ -82,35 +89,37 @@ namespace QuantLib {
         const Real strikePrice = payoff->strike();
         const Real term = process->time(arguments_.exercise->lastDate());
 
-        //possible optimization:
-        //  if term=lastTerm & model=lastModel & formula=lastApprox, reuse approx.
         const Real forward = spotPrice*dividendDiscount/riskFreeDiscount;
-        Real vol;
-        switch(formula_) {
-          case LPP2: {
-            LPP2HestonExpansion expansion(model_->kappa(), model_->theta(),
-                                          model_->sigma(), model_->v0(),
-                                          model_->rho(), term);
-            vol = expansion.impliedVolatility(strikePrice, forward);
-            break;
-          }
-          case LPP3: {
-            LPP3HestonExpansion expansion(model_->kappa(), model_->theta(),
-                                          model_->sigma(), model_->v0(),
-                                          model_->rho(), term);
-            vol = expansion.impliedVolatility(strikePrice, forward);
-            break;
-          }
-          case Forde: {
-            FordeHestonExpansion expansion(model_->kappa(), model_->theta(),
-                                           model_->sigma(), model_->v0(),
-                                           model_->rho(), term);
-            vol = expansion.impliedVolatility(strikePrice, forward);
-            break;
-          }
-          default:
-            QL_FAIL("unknown expansion formula");
+
+        std::map<Time, boost::shared_ptr<HestonExpansion> >::const_iterator i =
+            expansions_.find(term);
+        if (i == expansions_.end()) {
+            boost::shared_ptr<HestonExpansion> expansion;
+            switch(formula_) {
+              case LPP2:
+                expansion = boost::shared_ptr<HestonExpansion>(
+                    new LPP2HestonExpansion(model_->kappa(), model_->theta(),
+                                            model_->sigma(), model_->v0(),
+                                            model_->rho(), term));
+                break;
+              case LPP3:
+                expansion = boost::shared_ptr<HestonExpansion>(
+                    new LPP3HestonExpansion(model_->kappa(), model_->theta(),
+                                            model_->sigma(), model_->v0(),
+                                            model_->rho(), term));
+                break;
+              case Forde:
+                expansion = boost::shared_ptr<HestonExpansion>(
+                    new FordeHestonExpansion(model_->kappa(), model_->theta(),
+                                             model_->sigma(), model_->v0(),
+                                             model_->rho(), term));
+                break;
+              default:
+                QL_FAIL("unknown expansion formula");
+            }
+            i = expansions_.insert(std::make_pair(term, expansion)).first;
         }
+        const Real vol = i->second->impliedVolatility(strikePrice, forward);
         const Real price = blackFormula(payoff, forward, vol*sqrt(term),
                                         riskFreeDiscount, 0);
         results_.value = price;
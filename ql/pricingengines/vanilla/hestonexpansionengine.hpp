@@ -28,9 +28,12 @@
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/instruments/vanillaoption.hpp>
 #include <boost/function.hpp>
+#include <map>
 
 namespace QuantLib {
 
+    class HestonExpansion;
+
     //! Heston-model engine for European options based on analytic expansions
     /*! References:
 
@@ -42,6 +45,13 @@ namespace QuantLib {
         multifactor local-stochastic vol models
         arXiv preprint arXiv:1306.5447v3, 2014 - arxiv.org
 
+        The coefficients of the expansion only depend on the model
+        parameters and on the expiry; the engine stores them for each
+        expiry it prices, so that further options with the same expiry
+        only cost the evaluation of a polynomial in the log-moneyness.
+        The stored coefficients are discarded whenever the model
+        notifies a change.
+
         \ingroup vanillaengines
     */
     class HestonExpansionEngine
@@ -54,10 +64,13 @@ namespace QuantLib {
         HestonExpansionEngine(const boost::shared_ptr<HestonModel>& model,
                               HestonExpansionFormula formula);
 
+        void update();
         void calculate() const;
 
       private:
         const HestonExpansionFormula formula_;
+        mutable std::map<Time, boost::shared_ptr<HestonExpansion> >
+                                                               expansions_;
     };
 
     /*! Interface to represent some Heston expansion formula.
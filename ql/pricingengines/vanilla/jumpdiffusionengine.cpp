@@ -19,15 +19,47 @@
 */
 
 #include <ql/pricingengines/vanilla/jumpdiffusionengine.hpp>
-#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/pricingengines/blackcalculator.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
-#include <ql/termstructures/yield/flatforward.hpp>
-#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/exercise.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        // Poisson weights and discount factors of the terms of the
+        // series, calculated when first needed
+        class Merton76Terms {
+          public:
+            Merton76Terms(Real meanJumps, Rate riskFreeRate,
+                          Real muPlusHalfSquareVol, Time t)
+            : p_(meanJumps), riskFreeRate_(riskFreeRate),
+              muPlusHalfSquareVol_(muPlusHalfSquareVol), t_(t) {}
+            Real weight(Size i) { extend(i); return weights_[i]; }
+            DiscountFactor discount(Size i) {
+                extend(i); return discounts_[i];
+            }
+          private:
+            void extend(Size i) {
+                while (weights_.size() <= i) {
+                    Size n = weights_.size();
+                    weights_.push_back(p_(n));
+                    // constant vol/rate assumption. It should be relaxed
+                    Rate r = riskFreeRate_ + n*muPlusHalfSquareVol_/t_;
+                    discounts_.push_back(std::exp(-r*t_));
+                }
+            }
+            PoissonDistribution p_;
+            Rate riskFreeRate_;
+            Real muPlusHalfSquareVol_;
+            Time t_;
+            std::vector<Real> weights_;
+            std::vector<DiscountFactor> discounts_;
+        };
+
+    }
+
     JumpDiffusionEngine::JumpDiffusionEngine(
         const boost::shared_ptr<Merton76Process>& process,
         Real relativeAccuracy,
@@ -40,6 +72,9 @@ namespace QuantLib {
 
     void JumpDiffusionEngine::calculate() const {
 
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
         Real jumpSquareVol = process_->logJumpVolatility()->value()
             * process_->logJumpVolatility()->value();
         Real muPlusHalfSquareVol = process_->logMeanJump()->value()
@@ -52,46 +87,29 @@ namespace QuantLib {
             boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non-striked payoff given");
 
+        Date maturity = arguments_.exercise->lastDate();
         Real variance =
-            process_->blackVolatility()->blackVariance(
-                                              arguments_.exercise->lastDate(),
-                                              payoff->strike());
+            process_->blackVolatility()->blackVariance(maturity,
+                                                       payoff->strike());
 
         DayCounter voldc = process_->blackVolatility()->dayCounter();
-        Calendar volcal = process_->blackVolatility()->calendar();
         Date volRefDate = process_->blackVolatility()->referenceDate();
-        Time t = voldc.yearFraction(volRefDate,
-                                    arguments_.exercise->lastDate());
+        Time t = voldc.yearFraction(volRefDate, maturity);
         Rate riskFreeRate = -std::log(process_->riskFreeRate()->discount(
-                                          arguments_.exercise->lastDate()))/t;
-        Date rateRefDate = process_->riskFreeRate()->referenceDate();
-
-        PoissonDistribution p(lambda*t);
-
-        Handle<Quote> stateVariable = process_->stateVariable();
-        Handle<YieldTermStructure> dividendTS = process_->dividendYield();
-        RelinkableHandle<YieldTermStructure> riskFreeTS(
-                                                   *process_->riskFreeRate());
-        RelinkableHandle<BlackVolTermStructure> volTS(
-                                                *process_->blackVolatility());
+                                          maturity))/t;
 
-        boost::shared_ptr<GeneralizedBlackScholesProcess> bsProcess(
-                 new GeneralizedBlackScholesProcess(stateVariable, dividendTS,
-                                                    riskFreeTS, volTS));
+        Real spot = process_->stateVariable()->value();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+        DiscountFactor dividendDiscount =
+            process_->dividendYield()->discount(maturity);
+        Time dividendTime = process_->dividendYield()->dayCounter()
+            .yearFraction(process_->dividendYield()->referenceDate(),
+                          maturity);
 
-        AnalyticEuropeanEngine baseEngine(bsProcess);
-
-        VanillaOption::arguments* baseArguments =
-            dynamic_cast<VanillaOption::arguments*>(baseEngine.getArguments());
-
-        baseArguments->payoff   = arguments_.payoff;
-        baseArguments->exercise = arguments_.exercise;
-
-        baseArguments->validate();
-
-        const VanillaOption::results* baseResults =
-            dynamic_cast<const VanillaOption::results*>(
-                                                     baseEngine.getResults());
+        Merton76Terms terms(lambda*t,
+                            riskFreeRate
+                            - process_->jumpIntensity()->value()*k,
+                            muPlusHalfSquareVol, t);
 
         results_.value       = 0.0;
         results_.delta       = 0.0;
@@ -101,7 +119,7 @@ namespace QuantLib {
         results_.rho         = 0.0;
         results_.dividendRho = 0.0;
 
-        Real r, v, weight, lastContribution = 1.0;
+        Real v, weight, lastContribution = 1.0;
         Size i;
         Real theta_correction;
         // Haug arbitrary criterium is:
@@ -109,62 +127,62 @@ namespace QuantLib {
         for (i=0;  (lastContribution>relativeAccuracy_ && i<maxIterations_) 
                  || i < Size(lambda*t); i++) {
 
-            // constant vol/rate assumption. It should be relaxed
-            v = std::sqrt((variance + i*jumpSquareVol)/t);
-            r = riskFreeRate - process_->jumpIntensity()->value()*k
-                + i*muPlusHalfSquareVol/t;
-            riskFreeTS.linkTo(boost::shared_ptr<YieldTermStructure>(new
-                FlatForward(rateRefDate, r, voldc)));
-            volTS.linkTo(boost::shared_ptr<BlackVolTermStructure>(new
-                BlackConstantVol(rateRefDate, volcal, v, voldc)));
-
-            baseArguments->validate();
-            baseEngine.calculate();
-
-            weight = p(Size(i));
-            results_.value       += weight * baseResults->value;
-            results_.delta       += weight * baseResults->delta;
-            results_.gamma       += weight * baseResults->gamma;
-            results_.vega        += weight * (std::sqrt(variance/t)/v)*
-                                                           baseResults->vega;
+            Real termVariance = variance + i*jumpSquareVol;
+            v = std::sqrt(termVariance/t);
+            DiscountFactor discount = terms.discount(i);
+            BlackCalculator black(payoff, spot*dividendDiscount/discount,
+                                  std::sqrt(termVariance), discount);
+
+            Real value = black.value();
+            Real delta = black.delta(spot);
+            Real gamma = black.gamma(spot);
+            Real vega = black.vega(t);
+            Real rho = black.rho(t);
+            Real dividendRho = black.dividendRho(dividendTime);
+            Real theta = black.theta(spot, t);
+
+            weight = terms.weight(i);
+            results_.value       += weight * value;
+            results_.delta       += weight * delta;
+            results_.gamma       += weight * gamma;
+            results_.vega        += weight * (std::sqrt(variance/t)/v)*vega;
             // theta modified
-            theta_correction = baseResults->vega*((i*jumpSquareVol)/
-                                                  (2.0*v*t*t)) +
-                baseResults->rho*i*muPlusHalfSquareVol/(t*t);
-            results_.theta += weight *(baseResults->theta + theta_correction +
-                                  lambda*baseResults->value);
+            theta_correction = vega*((i*jumpSquareVol)/(2.0*v*t*t)) +
+                rho*i*muPlusHalfSquareVol/(t*t);
+            results_.theta += weight *(theta + theta_correction +
+                                       lambda*value);
             if(i != 0){
-                 results_.theta -= (p(Size(i-1))*lambda* baseResults->value);
+                 results_.theta -= (terms.weight(i-1)*lambda*value);
             }
             //end theta calculation
-            results_.rho         += weight * baseResults->rho;
-            results_.dividendRho += weight * baseResults->dividendRho;
+            results_.rho         += weight * rho;
+            results_.dividendRho += weight * dividendRho;
 
-            lastContribution = std::fabs(baseResults->value /
+            lastContribution = std::fabs(value /
                 (std::fabs(results_.value)>QL_EPSILON ? results_.value : 1.0));
 
             lastContribution = std::max<Real>(lastContribution,
-                std::fabs(baseResults->delta /
+                std::fabs(delta /
                (std::fabs(results_.delta)>QL_EPSILON ? results_.delta : 1.0)));
 
             lastContribution = std::max<Real>(lastContribution,
-                std::fabs(baseResults->gamma /
+                std::fabs(gamma /
                (std::fabs(results_.gamma)>QL_EPSILON ? results_.gamma : 1.0)));
 
             lastContribution = std::max<Real>(lastContribution,
-                std::fabs(baseResults->theta /
+                std::fabs(theta /
                (std::fabs(results_.theta)>QL_EPSILON ? results_.theta : 1.0)));
 
             lastContribution = std::max<Real>(lastContribution,
-                std::fabs(baseResults->vega /
+                std::fabs(vega /
                (std::fabs(results_.vega)>QL_EPSILON ? results_.vega : 1.0)));
 
             lastContribution = std::max<Real>(lastContribution,
-                std::fabs(baseResults->rho /
+                std::fabs(rho /
                (std::fabs(results_.rho)>QL_EPSILON ? results_.rho : 1.0)));
 
             lastContribution = std::max<Real>(lastContribution,
-                std::fabs(baseResults->dividendRho /
+                std::fabs(dividendRho /
                (std::fabs(results_.dividendRho)>QL_EPSILON ?
                                           results_.dividendRho : 1.0)));
 
@@ -178,5 +196,66 @@ namespace QuantLib {
                   << " while the running sum was " << results_.value);
     }
 
-}
 
+    std::vector<Real> JumpDiffusionEngine::values(
+                                      Option::Type type,
+                                      const std::vector<Real>& strikes,
+                                      const Date& maturity) const {
+
+        Real jumpSquareVol = process_->logJumpVolatility()->value()
+            * process_->logJumpVolatility()->value();
+        Real muPlusHalfSquareVol = process_->logMeanJump()->value()
+            + 0.5*jumpSquareVol;
+        // mean jump size
+        Real k = std::exp(muPlusHalfSquareVol) - 1.0;
+        Real lambda = (k+1.0) * process_->jumpIntensity()->value();
+
+        DayCounter voldc = process_->blackVolatility()->dayCounter();
+        Date volRefDate = process_->blackVolatility()->referenceDate();
+        Time t = voldc.yearFraction(volRefDate, maturity);
+        Rate riskFreeRate = -std::log(process_->riskFreeRate()->discount(
+                                          maturity))/t;
+
+        Real spot = process_->stateVariable()->value();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+        DiscountFactor dividendDiscount =
+            process_->dividendYield()->discount(maturity);
+
+        Merton76Terms terms(lambda*t,
+                            riskFreeRate
+                            - process_->jumpIntensity()->value()*k,
+                            muPlusHalfSquareVol, t);
+
+        std::vector<Real> results(strikes.size(), 0.0);
+        for (Size j=0; j<strikes.size(); ++j) {
+            Real variance =
+                process_->blackVolatility()->blackVariance(maturity,
+                                                           strikes[j]);
+            Real lastContribution = 1.0;
+            Size i;
+            for (i=0;  (lastContribution>relativeAccuracy_
+                        && i<maxIterations_)
+                     || i < Size(lambda*t); i++) {
+                DiscountFactor discount = terms.discount(i);
+                Real value =
+                    BlackCalculator(type, strikes[j],
+                                    spot*dividendDiscount/discount,
+                                    std::sqrt(variance + i*jumpSquareVol),
+                                    discount).value();
+                Real weight = terms.weight(i);
+                results[j] += weight * value;
+                lastContribution = weight * std::fabs(value /
+                    (std::fabs(results[j])>QL_EPSILON ? results[j] : 1.0));
+            }
+            QL_ENSURE(i<maxIterations_,
+                      i << " iterations have been not enough to reach "
+                      << "the required " << relativeAccuracy_
+                      << " accuracy for strike " << strikes[j]
+                      << ". The " << io::ordinal(i)
+                      << " addendum was " << lastContribution
+                      << " while the running sum was " << results[j]);
+        }
+        return results;
+    }
+
+}
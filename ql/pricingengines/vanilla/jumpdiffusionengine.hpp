@@ -31,7 +31,11 @@
 namespace QuantLib {
 
     //! Jump-diffusion engine for vanilla options
-    /*! \ingroup vanillaengines
+    /*! The series of Poisson-weighted Black-Scholes prices is summed
+        in closed form, without building processes or term structures
+        for its terms.
+
+        \ingroup vanillaengines
 
         \test
         - the correctness of the returned value is tested by
@@ -45,6 +49,15 @@ namespace QuantLib {
                             Real relativeAccuracy_ = 1e-4,
                             Size maxIterations = 100);
         void calculate() const;
+        //! values of European options with the same maturity
+        /*! The Poisson weights and the discount factors of the terms
+            of the series are calculated once and shared by all
+            strikes, which makes this faster than pricing the options
+            one by one, e.g., during calibration.
+        */
+        std::vector<Real> values(Option::Type type,
+                                 const std::vector<Real>& strikes,
+                                 const Date& maturity) const;
       private:
         boost::shared_ptr<Merton76Process> process_;
         Real relativeAccuracy_;
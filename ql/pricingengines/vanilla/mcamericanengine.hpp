@@ -30,6 +30,7 @@
 #include <ql/payoff.hpp>
 #include <ql/exercise.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
+#include <ql/methods/montecarlo/blackscholesbackwardpathgenerator.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
@@ -40,6 +41,18 @@ namespace QuantLib {
     //! American Monte Carlo engine
     /*! References:
 
+        If backward calibration is chosen, the calibration paths are
+        generated backwards by Brownian bridging instead of being
+        simulated forwards and stored; the memory required by the
+        calibration is then proportional to the number of paths
+        instead of the number of paths times the number of steps.
+        This requires a volatility independent of the underlying; see
+        BlackScholesBackwardPathGenerator.  The calibration always
+        uses pseudo-random numbers in this case.
+
+        Otherwise, the stored calibration paths can be kept in single
+        precision to halve their memory; see SinglePrecisionPaths.
+
         \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
@@ -65,13 +78,16 @@ namespace QuantLib {
              LsmBasisSystem::PolynomType polynomType,
              Size nCalibrationSamples = Null<Size>(),
              boost::optional<bool> antitheticVariateCalibration = boost::none,
-             BigNatural seedCalibration = Null<Size>());
+             BigNatural seedCalibration = Null<Size>(),
+             bool backwardCalibration = false,
+             bool singlePrecisionPaths = false);
 
         void calculate() const;
         
       protected:
         boost::shared_ptr<LongstaffSchwartzPathPricer<Path> >
             lsmPathPricer() const;
+        void calibratePathPricer() const;
 
         Real controlVariateValue() const;
         boost::shared_ptr<PricingEngine> controlPricingEngine() const;
@@ -80,6 +96,8 @@ namespace QuantLib {
       private:
         const Size polynomOrder_;
         const LsmBasisSystem::PolynomType polynomType_;
+        const bool backwardCalibration_;
+        const bool singlePrecisionPaths_;
     };
 
     class AmericanPathPricer : public EarlyExercisePathPricer<Path>  {
@@ -123,6 +141,8 @@ namespace QuantLib {
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
         MakeMCAmericanEngine& withAntitheticVariateCalibration(bool b = true);
         MakeMCAmericanEngine& withSeedCalibration(BigNatural seed);
+        MakeMCAmericanEngine& withBackwardCalibration(bool b = true);
+        MakeMCAmericanEngine& withSinglePrecisionPaths(bool b = true);
 
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -137,6 +157,7 @@ namespace QuantLib {
         LsmBasisSystem::PolynomType polynomType_;
         boost::optional<bool> antitheticCalibration_;
         BigNatural seedCalibration_;
+        bool backwardCalibration_, singlePrecisionPaths_;
     };
 
     template <class RNG, class S, class RNG_Calibration>
@@ -147,14 +168,17 @@ namespace QuantLib {
         Size maxSamples, BigNatural seed, Size polynomOrder,
         LsmBasisSystem::PolynomType polynomType, Size nCalibrationSamples,
         boost::optional<bool> antitheticVariateCalibration,
-        BigNatural seedCalibration)
+        BigNatural seedCalibration, bool backwardCalibration,
+        bool singlePrecisionPaths)
         : MCLongstaffSchwartzEngine<VanillaOption::engine, SingleVariate, RNG,
                                     S, RNG_Calibration>(
               process, timeSteps, timeStepsPerYear, false, antitheticVariate,
               controlVariate, requiredSamples, requiredTolerance, maxSamples,
               seed, nCalibrationSamples, false, antitheticVariateCalibration,
               seedCalibration),
-          polynomOrder_(polynomOrder), polynomType_(polynomType) {}
+          polynomOrder_(polynomOrder), polynomType_(polynomType),
+          backwardCalibration_(backwardCalibration),
+          singlePrecisionPaths_(singlePrecisionPaths) {}
 
     template <class RNG, class S, class RNG_Calibration>
     inline void MCAmericanEngine<RNG, S, RNG_Calibration>::calculate() const {
@@ -190,7 +214,31 @@ namespace QuantLib {
              new LongstaffSchwartzPathPricer<Path>(
                                       this->timeGrid(),
                                       earlyExercisePathPricer,
-                                      *(process->riskFreeRate())));
+                                      *(process->riskFreeRate()),
+                                      singlePrecisionPaths_));
+    }
+
+    template <class RNG, class S, class RNG_Calibration>
+    inline void
+    MCAmericanEngine<RNG, S, RNG_Calibration>::calibratePathPricer() const {
+        if (!backwardCalibration_) {
+            MCLongstaffSchwartzEngine<VanillaOption::engine, SingleVariate,
+                                      RNG, S,
+                                      RNG_Calibration>::calibratePathPricer();
+            return;
+        }
+
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+            boost::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                                                              this->process_);
+        QL_REQUIRE(process, "generalized Black-Scholes process required");
+
+        BlackScholesBackwardPathGenerator generator(
+                                      process, this->timeGrid(),
+                                      this->nCalibrationSamples_,
+                                      this->antitheticVariateCalibration_,
+                                      this->seedCalibration_);
+        this->pathPricer_->calibrate(generator);
     }
 
     template <class RNG, class S, class RNG_Calibration>
@@ -259,7 +307,8 @@ namespace QuantLib {
           samples_(Null<Size>()), maxSamples_(Null<Size>()),
           calibrationSamples_(2048), tolerance_(Null<Real>()), seed_(0),
           polynomOrder_(2), polynomType_(LsmBasisSystem::Monomial),
-          antitheticCalibration_(boost::none), seedCalibration_(Null<Size>()) {}
+          antitheticCalibration_(boost::none), seedCalibration_(Null<Size>()),
+          backwardCalibration_(false), singlePrecisionPaths_(false) {}
 
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
@@ -367,6 +416,22 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withBackwardCalibration(
+        bool b) {
+        backwardCalibration_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withSinglePrecisionPaths(
+        bool b) {
+        singlePrecisionPaths_ = b;
+        return *this;
+    }
+
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration>::
     operator boost::shared_ptr<PricingEngine>() const {
@@ -387,7 +452,9 @@ namespace QuantLib {
                                      polynomType_,
                                      calibrationSamples_,
                                      antitheticCalibration_,
-                                     seedCalibration_));
+                                     seedCalibration_,
+                                     backwardCalibration_,
+                                     singlePrecisionPaths_));
     }
 
 }
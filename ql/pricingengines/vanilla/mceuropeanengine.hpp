@@ -30,14 +30,31 @@
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
 
 namespace QuantLib {
 
     //! European option pricing engine using Monte Carlo simulation
     /*! \ingroup vanillaengines
 
-        \test the correctness of the returned value is tested by
-              checking it against analytic results.
+        \test
+        - the correctness of the returned value is tested by
+          checking it against analytic results.
+        - the results obtained with several workers are checked
+          for reproducibility.
+        - the pathwise Greeks are tested by checking them against
+          analytic results.
+
+        When pathwise Greeks are required, delta, vega and rho are
+        estimated from the same paths as the value by differentiating
+        the discounted payoff of each path with respect to the
+        underlying value, to a parallel shift of the Black
+        volatility, and to a parallel shift of the risk-free rate.
+
+        \warning The pathwise vega assumes that the simulated
+                 terminal variance is the Black variance at the
+                 strike, i.e., that the volatility doesn't depend on
+                 the underlying value.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCEuropeanEngine : public MCVanillaEngine<SingleVariate,RNG,S> {
@@ -60,9 +77,18 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             Size workers = 1,
+             bool pathwiseGreeks = false);
+        void calculate() const;
       protected:
         boost::shared_ptr<path_pricer_type> pathPricer() const;
+      private:
+        bool pathwiseGreeks_;
+        // one sample accumulator for each path pricer; the workers
+        // don't share them
+        mutable std::vector<boost::shared_ptr<SequenceStatisticsInc> >
+                                                                  greeks_;
     };
 
     //! Monte Carlo European engine factory
@@ -80,6 +106,11 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withWorkers(Size workers);
+        MakeMCEuropeanEngine& withPathwiseGreeks(bool b = true);
+        //! distributes the samples, see McSimulation::distributeSamples
+        MakeMCEuropeanEngine& withCommunicator(
+                            const boost::shared_ptr<SampleCommunicator>&);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -89,6 +120,9 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size workers_;
+        bool pathwiseGreeks_;
+        boost::shared_ptr<SampleCommunicator> communicator_;
     };
 
     class EuropeanPathPricer : public PathPricer<Path> {
@@ -102,6 +136,33 @@ namespace QuantLib {
         DiscountFactor discount_;
     };
 
+    //! European path pricer also returning pathwise Greeks
+    /*! The value of each path is returned, while its derivatives
+        with respect to the underlying value, the Black volatility
+        and the risk-free rate are added to the given accumulator.
+    */
+    class EuropeanPathwisePathPricer : public PathPricer<Path> {
+      public:
+        EuropeanPathwisePathPricer(
+                    Option::Type type,
+                    Real strike,
+                    DiscountFactor discount,
+                    Real underlying,
+                    Real forward,
+                    Volatility volatility,
+                    Time maturity,
+                    const boost::shared_ptr<SequenceStatisticsInc>& greeks);
+        Real operator()(const Path& path) const;
+      private:
+        PlainVanillaPayoff payoff_;
+        DiscountFactor discount_;
+        Real underlying_, forward_;
+        Volatility volatility_;
+        Time maturity_;
+        boost::shared_ptr<SequenceStatisticsInc> greeks_;
+        mutable std::vector<Real> sample_;
+    };
+
 
     // inline definitions
 
@@ -116,7 +177,9 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             Size workers,
+             bool pathwiseGreeks)
     : MCVanillaEngine<SingleVariate,RNG,S>(process,
                                            timeSteps,
                                            timeStepsPerYear,
@@ -126,7 +189,34 @@ namespace QuantLib {
                                            requiredSamples,
                                            requiredTolerance,
                                            maxSamples,
-                                           seed) {}
+                                           seed,
+                                           workers),
+      pathwiseGreeks_(pathwiseGreeks) {}
+
+
+    template <class RNG, class S>
+    inline void MCEuropeanEngine<RNG,S>::calculate() const {
+        greeks_.clear();
+        MCVanillaEngine<SingleVariate,RNG,S>::calculate();
+        if (!pathwiseGreeks_)
+            return;
+
+        Real samples = 0.0, delta = 0.0, vega = 0.0, rho = 0.0;
+        for (Size i=0; i<greeks_.size(); ++i) {
+            Real n = greeks_[i]->samples();
+            if (n == 0.0)
+                continue;
+            std::vector<Real> mean = greeks_[i]->mean();
+            delta += n*mean[0];
+            vega += n*mean[1];
+            rho += n*mean[2];
+            samples += n;
+        }
+        QL_REQUIRE(samples > 0.0, "no pathwise Greeks sampled");
+        this->results_.delta = delta/samples;
+        this->results_.vega = vega/samples;
+        this->results_.rho = rho/samples;
+    }
 
 
     template <class RNG, class S>
@@ -144,12 +234,32 @@ namespace QuantLib {
                 this->process_);
         QL_REQUIRE(process, "Black-Scholes process required");
 
+        Time maturity = this->timeGrid().back();
+        DiscountFactor discount =
+            process->riskFreeRate()->discount(maturity);
+
+        if (!pathwiseGreeks_)
+            return boost::shared_ptr<
+                       typename MCEuropeanEngine<RNG,S>::path_pricer_type>(
+                new EuropeanPathPricer(payoff->optionType(),
+                                       payoff->strike(),
+                                       discount));
+
+        Real underlying = process->x0();
+        Real forward = underlying *
+            process->dividendYield()->discount(maturity) / discount;
+        Volatility volatility =
+            process->blackVolatility()->blackVol(maturity, payoff->strike(),
+                                                 true);
+        greeks_.push_back(boost::shared_ptr<SequenceStatisticsInc>(
+                                                new SequenceStatisticsInc(3)));
         return boost::shared_ptr<
                        typename MCEuropeanEngine<RNG,S>::path_pricer_type>(
-          new EuropeanPathPricer(
-              payoff->optionType(),
-              payoff->strike(),
-              process->riskFreeRate()->discount(this->timeGrid().back())));
+            new EuropeanPathwisePathPricer(payoff->optionType(),
+                                           payoff->strike(),
+                                           discount, underlying, forward,
+                                           volatility, maturity,
+                                           greeks_.back()));
     }
 
 
@@ -159,7 +269,8 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0),
+      workers_(1), pathwiseGreeks_(false) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
@@ -224,6 +335,28 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withWorkers(Size workers) {
+        workers_ = workers;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withPathwiseGreeks(bool b) {
+        pathwiseGreeks_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withCommunicator(
+                     const boost::shared_ptr<SampleCommunicator>& comm) {
+        communicator_ = comm;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -232,7 +365,12 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(new
+        // the pathwise Greeks are accumulated by the path pricers of
+        // each process
+        QL_REQUIRE(!pathwiseGreeks_ || !communicator_,
+                   "pathwise Greeks not available "
+                   "in distributed simulations");
+        boost::shared_ptr<MCEuropeanEngine<RNG,S> > engine(new
             MCEuropeanEngine<RNG,S>(process_,
                                     steps_,
                                     stepsPerYear_,
@@ -240,7 +378,11 @@ namespace QuantLib {
                                     antithetic_,
                                     samples_, tolerance_,
                                     maxSamples_,
-                                    seed_));
+                                    seed_,
+                                    workers_,
+                                    pathwiseGreeks_));
+        engine->distributeSamples(communicator_);
+        return engine;
     }
 
 
@@ -258,6 +400,52 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+
+    inline EuropeanPathwisePathPricer::EuropeanPathwisePathPricer(
+                    Option::Type type,
+                    Real strike,
+                    DiscountFactor discount,
+                    Real underlying,
+                    Real forward,
+                    Volatility volatility,
+                    Time maturity,
+                    const boost::shared_ptr<SequenceStatisticsInc>& greeks)
+    : payoff_(type, strike), discount_(discount), underlying_(underlying),
+      forward_(forward), volatility_(volatility), maturity_(maturity),
+      greeks_(greeks), sample_(3) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+        QL_REQUIRE(volatility>0.0,
+                   "positive volatility required");
+        QL_REQUIRE(greeks_, "null accumulator given");
+    }
+
+    inline Real EuropeanPathwisePathPricer::operator()(
+                                                   const Path& path) const {
+        QL_REQUIRE(path.length() > 0, "the path cannot be empty");
+        Real s = path.back();
+        Real value = payoff_(s) * discount_;
+
+        // derivative of the payoff with respect to the terminal value
+        Real dPayoff = 0.0;
+        if (payoff_.optionType() == Option::Call && s > payoff_.strike())
+            dPayoff = 1.0;
+        else if (payoff_.optionType() == Option::Put && s < payoff_.strike())
+            dPayoff = -1.0;
+
+        // ln s = ln F - sigma^2 T/2 + sigma W_T, with d/dS0 ln F = 1/S0,
+        // d/dr ln F = T and sigma W_T = ln(s/F) + sigma^2 T/2
+        Real dsdSigma = s * (std::log(s/forward_)
+                             - 0.5*volatility_*volatility_*maturity_)
+                      / volatility_;
+        sample_[0] = discount_ * dPayoff * s / underlying_;
+        sample_[1] = discount_ * dPayoff * dsdSigma;
+        sample_[2] = discount_ * dPayoff * s * maturity_ - maturity_ * value;
+        greeks_->add(sample_);
+
+        return value;
+    }
+
 }
 
 
@@ -65,15 +65,24 @@ namespace QuantLib {
                         Size requiredSamples,
                         Real requiredTolerance,
                         Size maxSamples,
-                        BigNatural seed);
+                        BigNatural seed,
+                        Size workers = 1);
         // McSimulation implementation
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_generator_type> pathGenerator() const {
+            return pathGenerator(seed_);
+        }
+        boost::shared_ptr<path_generator_type>
+        workerPathGenerator(Size worker) const {
+            return pathGenerator(this->workerSeed(seed_, worker));
+        }
+        boost::shared_ptr<path_generator_type>
+        pathGenerator(BigNatural seed) const {
 
             Size dimensions = process_->factors();
             TimeGrid grid = this->timeGrid();
             typename RNG::rsg_type generator =
-                RNG::make_sequence_generator(dimensions*(grid.size()-1),seed_);
+                RNG::make_sequence_generator(dimensions*(grid.size()-1),seed);
             return boost::shared_ptr<path_generator_type>(
                    new path_generator_type(process_, grid,
                                            generator, brownianBridge_));
@@ -86,6 +95,7 @@ namespace QuantLib {
         Real requiredTolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        mutable TimeGridCache timeGrids_;
     };
 
 
@@ -102,8 +112,9 @@ namespace QuantLib {
                           Size requiredSamples,
                           Real requiredTolerance,
                           Size maxSamples,
-                          BigNatural seed)
-    : McSimulation<MC,RNG,S>(antitheticVariate, controlVariate),
+                          BigNatural seed,
+                          Size workers)
+    : McSimulation<MC,RNG,S>(antitheticVariate, controlVariate, workers),
       process_(process), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
@@ -158,10 +169,10 @@ namespace QuantLib {
         Date lastExerciseDate = this->arguments_.exercise->lastDate();
         Time t = process_->time(lastExerciseDate);
         if (this->timeSteps_ != Null<Size>()) {
-            return TimeGrid(t, this->timeSteps_);
+            return timeGrids_.grid(t, this->timeSteps_);
         } else if (this->timeStepsPerYear_ != Null<Size>()) {
             Size steps = static_cast<Size>(this->timeStepsPerYear_*t);
-            return TimeGrid(t, std::max<Size>(steps, 1));
+            return timeGrids_.grid(t, std::max<Size>(steps, 1));
         } else {
             QL_FAIL("time steps not specified");
         }
@@ -59,6 +59,12 @@ namespace QuantLib {
         return retVal;
     }
 
+    void BatesProcess::evolveBatch(Time t0, const Matrix& x0,
+                                   Time dt, const Matrix& dw,
+                                   Matrix& x) const {
+        StochasticProcess::evolveBatch(t0, x0, dt, dw, x);
+    }
+
     Size BatesProcess::factors() const {
         return 4;
     }
@@ -21,6 +21,7 @@
 */
 
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/math/fastmath.hpp>
 #include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/localvolcurve.hpp>
 #include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
@@ -127,6 +128,38 @@ namespace QuantLib {
                                  stdDeviation(t0, x0, dt) * dw);
     }
 
+    void GeneralizedBlackScholesProcess::evolveBatch(Time t0,
+                                                     const Matrix& x0,
+                                                     Time dt,
+                                                     const Matrix& dw,
+                                                     Matrix& x) const {
+        localVolatility(); // trigger update
+        if (!isStrikeIndependent_ || forceDiscretization_ || x0.empty()) {
+            StochasticProcess1D::evolveBatch(t0, x0, dt, dw, x);
+            return;
+        }
+
+        QL_REQUIRE(x0.rows() == 1 && dw.rows() == 1
+                   && dw.columns() == x0.columns(),
+                   "wrong batch dimensions: " << x0.rows() << "x"
+                   << x0.columns() << " state variables and " << dw.rows()
+                   << "x" << dw.columns() << " factors given");
+        if (x.rows() != 1 || x.columns() != x0.columns())
+            x = Matrix(1, x0.columns());
+
+        // exact values for curves, the same for all paths
+        Real var = variance(t0, x0[0][0], dt);
+        Real drift = (riskFreeRate_->forwardRate(t0, t0 + dt, Continuous,
+                                                 NoFrequency, true) -
+                      dividendYield_->forwardRate(t0, t0 + dt, Continuous,
+                                                  NoFrequency, true)) *
+                         dt -
+                     0.5 * var;
+        Real stdDev = std::sqrt(var);
+        for (Size k=0; k<x0.columns(); ++k)
+            x[0][k] = x0[0][k] * KernelMath::exp(stdDev * dw[0][k] + drift);
+    }
+
     Time GeneralizedBlackScholesProcess::time(const Date& d) const {
         return riskFreeRate_->dayCounter().yearFraction(
                                            riskFreeRate_->referenceDate(), d);
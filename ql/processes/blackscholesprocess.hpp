@@ -77,6 +77,12 @@ namespace QuantLib {
         Real stdDeviation(Time t0, Real x0, Time dt) const;
         Real variance(Time t0, Real x0, Time dt) const;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        /*! when the volatility doesn't depend on the underlying
+            value, the drift and variance are calculated once for all
+            the paths in the batch.
+        */
+        void evolveBatch(Time t0, const Matrix& x0, Time dt,
+                         const Matrix& dw, Matrix& x) const;
         //@}
         Time time(const Date&) const;
         //! \name Observer interface
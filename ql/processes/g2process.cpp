@@ -38,14 +38,55 @@ namespace QuantLib {
         return tmp;
     }
 
+    namespace {
+
+        FixedArray<2> state(const Array& x) {
+            FixedArray<2> s;
+            s[0] = x[0];
+            s[1] = x[1];
+            return s;
+        }
+
+    }
+
     Disposable<Array> G2Process::drift(Time t, const Array& x) const {
-        Array tmp(2);
+        return drift(t, state(x)).toArray();
+    }
+
+    Disposable<Matrix> G2Process::diffusion(Time t, const Array& x) const {
+        return diffusion(t, state(x)).toMatrix();
+    }
+
+    Disposable<Array> G2Process::expectation(Time t0, const Array& x0,
+                                             Time dt) const {
+        return expectation(t0, state(x0), dt).toArray();
+    }
+
+    Disposable<Matrix> G2Process::stdDeviation(Time t0, const Array& x0,
+                                               Time dt) const {
+        return stdDeviation(t0, state(x0), dt).toMatrix();
+    }
+
+    Disposable<Matrix> G2Process::covariance(Time t0, const Array& x0,
+                                             Time dt) const {
+        return covariance(t0, state(x0), dt).toMatrix();
+    }
+
+    Disposable<Array> G2Process::evolve(Time t0, const Array& x0,
+                                        Time dt, const Array& dw) const {
+        QL_REQUIRE(dw.size() == 2,
+                   "2 factors required, " << dw.size() << " given");
+        return evolve(t0, state(x0), dt, state(dw)).toArray();
+    }
+
+    FixedArray<2> G2Process::drift(Time t, const FixedArray<2>& x) const {
+        FixedArray<2> tmp;
         tmp[0] = xProcess_->drift(t, x[0]);
         tmp[1] = yProcess_->drift(t, x[1]);
         return tmp;
     }
 
-    Disposable<Matrix> G2Process::diffusion(Time, const Array&) const {
+    FixedMatrix<2,2> G2Process::diffusion(Time, const FixedArray<2>&) const {
         /* the correlation matrix is
            |  1   rho |
            | rho   1  |
@@ -53,7 +94,7 @@ namespace QuantLib {
            |  1          0       |
            | rho   sqrt(1-rho^2) |
         */
-        Matrix tmp(2,2);
+        FixedMatrix<2,2> tmp;
         Real sigma1 = sigma_;
         Real sigma2 = eta_;
         tmp[0][0] = sigma1;       tmp[0][1] = 0.0;
@@ -61,16 +102,16 @@ namespace QuantLib {
         return tmp;
     }
 
-    Disposable<Array> G2Process::expectation(Time t0, const Array& x0,
-                                             Time dt) const {
-        Array tmp(2);
+    FixedArray<2> G2Process::expectation(Time t0, const FixedArray<2>& x0,
+                                         Time dt) const {
+        FixedArray<2> tmp;
         tmp[0] = xProcess_->expectation(t0, x0[0], dt);
         tmp[1] = yProcess_->expectation(t0, x0[1], dt);
         return tmp;
     }
 
-    Disposable<Matrix> G2Process::stdDeviation(Time t0, const Array& x0,
-                                               Time dt) const {
+    FixedMatrix<2,2> G2Process::stdDeviation(Time t0, const FixedArray<2>& x0,
+                                             Time dt) const {
         /* the correlation matrix is
            |  1   rho |
            | rho   1  |
@@ -78,7 +119,7 @@ namespace QuantLib {
            |  1          0       |
            | rho   sqrt(1-rho^2) |
         */
-        Matrix tmp(2,2);
+        FixedMatrix<2,2> tmp;
         Real sigma1 = xProcess_->stdDeviation(t0, x0[0], dt);
         Real sigma2 = yProcess_->stdDeviation(t0, x0[1], dt);
         Real expa = std::exp(-a_*dt), expb = std::exp(-b_*dt);
@@ -93,11 +134,15 @@ namespace QuantLib {
         return tmp;
     }
 
-    Disposable<Matrix> G2Process::covariance(Time t0, const Array& x0,
-                                             Time dt) const {
-        Matrix sigma = stdDeviation(t0, x0, dt);
-        Matrix result = sigma*transpose(sigma);
-        return result;
+    FixedMatrix<2,2> G2Process::covariance(Time t0, const FixedArray<2>& x0,
+                                           Time dt) const {
+        FixedMatrix<2,2> sigma = stdDeviation(t0, x0, dt);
+        return sigma*transpose(sigma);
+    }
+
+    FixedArray<2> G2Process::evolve(Time t0, const FixedArray<2>& x0,
+                                    Time dt, const FixedArray<2>& dw) const {
+        return expectation(t0, x0, dt) + stdDeviation(t0, x0, dt)*dw;
     }
 
     Real G2Process::x0() const {
@@ -26,11 +26,17 @@
 
 #include <ql/processes/forwardmeasureprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
+#include <ql/math/fixedmatrix.hpp>
 
 namespace QuantLib {
 
     //! %G2 stochastic process
-    /*! \ingroup processes */
+    /*! The overloads taking and returning fixed-size arrays give the
+        same results as the ones based on Array, but they don't
+        allocate memory.
+
+        \ingroup processes
+    */
     class G2Process : public StochasticProcess {
       public:
         G2Process(Real a, Real sigma, Real b, Real eta, Real rho);
@@ -44,6 +50,21 @@ namespace QuantLib {
         Disposable<Matrix> stdDeviation(Time t0, const Array& x0,
                                         Time dt) const;
         Disposable<Matrix> covariance(Time t0, const Array& x0, Time dt) const;
+        Disposable<Array> evolve(Time t0, const Array& x0,
+                                 Time dt, const Array& dw) const;
+        //@}
+        //! \name Fixed-size interface
+        //@{
+        FixedArray<2> drift(Time t, const FixedArray<2>& x) const;
+        FixedMatrix<2,2> diffusion(Time t, const FixedArray<2>& x) const;
+        FixedArray<2> expectation(Time t0, const FixedArray<2>& x0,
+                                  Time dt) const;
+        FixedMatrix<2,2> stdDeviation(Time t0, const FixedArray<2>& x0,
+                                      Time dt) const;
+        FixedMatrix<2,2> covariance(Time t0, const FixedArray<2>& x0,
+                                    Time dt) const;
+        FixedArray<2> evolve(Time t0, const FixedArray<2>& x0,
+                             Time dt, const FixedArray<2>& dw) const;
         //@}
         Real x0() const;
         Real y0() const;
@@ -40,6 +40,25 @@ namespace QuantLib {
         registerWith(riskFreeRate_);
         registerWith(dividendYield_);
         registerWith(s0_);
+
+        const Real N = CumulativeNormalDistribution()(lambda_);
+        const Real n = std::exp(-lambda_*lambda_/2.0)/std::sqrt(2*M_PI);
+        const Real sigma2 = 2.0 + 4.0*lambda_*lambda_;
+        const Real q2 = 1.0 + lambda_*lambda_;
+        const Real q3 = lambda_*n + N + lambda_*lambda_*N;
+        const Real Eml_e4 = lambda_*lambda_*lambda_*n + 5.0*lambda_*n 
+            + 3.0*N + lambda_*lambda_*lambda_*lambda_*N 
+            + 6.0*lambda_*lambda_*N;
+        const Real sigma3 = Eml_e4 - q3*q3;
+        const Real sigma12 = -2.0*lambda_;
+        const Real sigma13 = -2.0*n - 2*lambda_*N;
+        const Real sigma23 = 2.0*N + sigma12*sigma13;
+        varianceDrift_ = beta_ + alpha_*q2 + gamma_*q3 - 1.0;
+        rho1_ = std::sqrt(daysPerYear_)*(alpha_*sigma12 + gamma_*sigma13);
+        rho2_ = std::sqrt(daysPerYear_)
+            *std::sqrt(alpha_*alpha_*(sigma2 - sigma12*sigma12) 
+                       + gamma_*gamma_*(sigma3 - sigma13*sigma13) 
+                       + 2.0*alpha_*gamma_*(sigma23 - sigma12*sigma13));
     }
 
     Size GJRGARCHProcess::size() const {
@@ -55,10 +74,6 @@ namespace QuantLib {
 
     Disposable<Array> GJRGARCHProcess::drift(Time t, const Array& x) const {
         Array tmp(2);
-        const Real N = CumulativeNormalDistribution()(lambda_);
-        const Real n = std::exp(-lambda_*lambda_/2.0)/std::sqrt(2*M_PI);
-        const Real q2 = 1.0 + lambda_*lambda_;
-        const Real q3 = lambda_*n + N + lambda_*lambda_*N;
         const Real vol = (x[1] > 0.0) ? std::sqrt(x[1])
                          : (discretization_ == Reflection) ? - std::sqrt(-x[1])
                          : 0.0;
@@ -67,8 +82,7 @@ namespace QuantLib {
                - dividendYield_->forwardRate(t, t, Continuous)
                - 0.5 * vol * vol;
 
-        tmp[1] = daysPerYear_*daysPerYear_*omega_ + daysPerYear_*(beta_ 
-                                             + alpha_*q2 + gamma_*q3 - 1.0) *
+        tmp[1] = daysPerYear_*daysPerYear_*omega_ + daysPerYear_*varianceDrift_ *
            ((discretization_==PartialTruncation) ? x[1] : vol*vol);
         return tmp;
     }
@@ -82,27 +96,12 @@ namespace QuantLib {
            | rho   std::sqrt(1-rho^2) |
         */
         Matrix tmp(2,2);
-        const Real N = CumulativeNormalDistribution()(lambda_);
-        const Real n = std::exp(-lambda_*lambda_/2.0)/std::sqrt(2*M_PI);
-        const Real sigma2 = 2.0 + 4.0*lambda_*lambda_;
-        const Real q3 = lambda_*n + N + lambda_*lambda_*N;
-        const Real Eml_e4 = lambda_*lambda_*lambda_*n + 5.0*lambda_*n 
-            + 3.0*N + lambda_*lambda_*lambda_*lambda_*N 
-            + 6.0*lambda_*lambda_*N;
-        const Real sigma3 = Eml_e4 - q3*q3;
-        const Real sigma12 = -2.0*lambda_;
-        const Real sigma13 = -2.0*n - 2*lambda_*N;
-        const Real sigma23 = 2.0*N + sigma12*sigma13;
         const Real vol = (x[1] > 0.0) ? std::sqrt(x[1])
                          : (discretization_ == Reflection) ? - std::sqrt(-x[1])
                          : 1e-8; // set vol to (almost) zero but still
                                  // expose some correlation information
-        const Real rho1 = std::sqrt(daysPerYear_)*(alpha_*sigma12 
-                                            + gamma_*sigma13) * vol * vol;
-        const Real rho2 = vol*vol*std::sqrt(daysPerYear_)
-            *std::sqrt(alpha_*alpha_*(sigma2 - sigma12*sigma12) 
-                       + gamma_*gamma_*(sigma3 - sigma13*sigma13) 
-                       + 2.0*alpha_*gamma_*(sigma23 - sigma12*sigma13)); 
+        const Real rho1 = rho1_ * vol * vol;
+        const Real rho2 = vol * vol * rho2_;
 
             // tmp[0][0], tmp[0][1] are the coefficients of dW_1 and dW_2 
             // in asset return stochastic process
@@ -119,29 +118,20 @@ namespace QuantLib {
         return tmp;
     }
 
+    Rate GJRGARCHProcess::rateDrift(Time t0, Time dt) const {
+        return riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
+             - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+    }
+
     Disposable<Array> GJRGARCHProcess::evolve(Time t0, const Array& x0,
                                             Time dt, const Array& dw) const {
         Array retVal(2);
         Real vol, mu, nu;
 
         const Real sdt = std::sqrt(dt);
-        const Real N = CumulativeNormalDistribution()(lambda_);
-        const Real n = std::exp(-lambda_*lambda_/2.0)/std::sqrt(2*M_PI);
-        const Real sigma2 = 2.0 + 4.0*lambda_*lambda_;
-        const Real q2 = 1.0 + lambda_*lambda_;
-        const Real q3 = lambda_*n + N + lambda_*lambda_*N;
-        const Real Eml_e4 = lambda_*lambda_*lambda_*n + 5.0*lambda_*n 
-            + 3.0*N + lambda_*lambda_*lambda_*lambda_*N 
-            + 6.0*lambda_*lambda_*N;
-        const Real sigma3 = Eml_e4 - q3*q3;
-        const Real sigma12 = -2.0*lambda_;
-        const Real sigma13 = -2.0*n - 2*lambda_*N;
-        const Real sigma23 = 2.0*N + sigma12*sigma13;
-        const Real rho1 = std::sqrt(daysPerYear_)*(alpha_*sigma12 + gamma_*sigma13);
-        const Real rho2 = std::sqrt(daysPerYear_)
-            *std::sqrt(alpha_*alpha_*(sigma2 - sigma12*sigma12) 
-                       + gamma_*gamma_*(sigma3 - sigma13*sigma13) 
-                       + 2.0*alpha_*gamma_*(sigma23 - sigma12*sigma13));
+        const Rate drift = rateDrift(t0, dt);
+        const Real nu0 = daysPerYear_*daysPerYear_*omega_;
+        const Real nu1 = daysPerYear_*varianceDrift_;
 
         switch (discretization_) {
           // For the definition of PartialTruncation, FullTruncation
@@ -151,37 +141,28 @@ namespace QuantLib {
           // Working Paper, Tinbergen Institute
           case PartialTruncation:
             vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : 0.0;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous)
-                    - 0.5 * vol * vol;
-            nu = daysPerYear_*daysPerYear_*omega_ 
-                + daysPerYear_*(beta_ + alpha_*q2 + gamma_*q3 - 1.0) * x0[1];
+            mu = drift - 0.5 * vol * vol;
+            nu = nu0 + nu1 * x0[1];
 
             retVal[0] = x0[0] * std::exp(mu*dt+vol*dw[0]*sdt);
-            retVal[1] = x0[1] + nu*dt + sdt*vol*vol*(rho1*dw[0] + rho2*dw[1]);
+            retVal[1] = x0[1] + nu*dt + sdt*vol*vol*(rho1_*dw[0] + rho2_*dw[1]);
             break;
           case FullTruncation:
             vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : 0.0;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous)
-                    - 0.5 * vol * vol;
-            nu = daysPerYear_*daysPerYear_*omega_ 
-                + daysPerYear_*(beta_ + alpha_*q2 + gamma_*q3 - 1.0) * vol *vol;
+            mu = drift - 0.5 * vol * vol;
+            nu = nu0 + nu1 * vol * vol;
 
             retVal[0] = x0[0] * std::exp(mu*dt+vol*dw[0]*sdt);
-            retVal[1] = x0[1] + nu*dt + sdt*vol*vol*(rho1*dw[0] + rho2*dw[1]);
+            retVal[1] = x0[1] + nu*dt + sdt*vol*vol*(rho1_*dw[0] + rho2_*dw[1]);
             break;
           case Reflection:
             vol = std::sqrt(std::fabs(x0[1]));
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous)
-                    - 0.5 * vol*vol;
-            nu = daysPerYear_*daysPerYear_*omega_ 
-                + daysPerYear_*(beta_ + alpha_*q2 + gamma_*q3 - 1.0) * vol * vol;
+            mu = drift - 0.5 * vol*vol;
+            nu = nu0 + nu1 * vol * vol;
 
             retVal[0] = x0[0]*std::exp(mu*dt+vol*dw[0]*sdt);
             retVal[1] = vol*vol
-                        +nu*dt + sdt*vol*vol*(rho1*dw[0] + rho2*dw[1]);
+                        +nu*dt + sdt*vol*vol*(rho1_*dw[0] + rho2_*dw[1]);
             break;
           default:
             QL_FAIL("unknown discretization schema");
@@ -190,6 +171,65 @@ namespace QuantLib {
         return retVal;
     }
 
+    void GJRGARCHProcess::evolveBatch(Time t0, const Matrix& x0,
+                                      Time dt, const Matrix& dw,
+                                      Matrix& x) const {
+        QL_REQUIRE(x0.rows() == 2 && dw.rows() == 2
+                   && dw.columns() == x0.columns(),
+                   "wrong batch dimensions: " << x0.rows() << "x"
+                   << x0.columns() << " state variables and " << dw.rows()
+                   << "x" << dw.columns() << " factors given");
+        if (x.rows() != 2 || x.columns() != x0.columns())
+            x = Matrix(2, x0.columns());
+
+        // the same for all paths
+        const Size n = x0.columns();
+        const Real sdt = std::sqrt(dt);
+        const Rate drift = rateDrift(t0, dt);
+        const Real nu0 = daysPerYear_*daysPerYear_*omega_;
+        const Real nu1 = daysPerYear_*varianceDrift_;
+
+        const Real* s0 = x0.row_begin(0);
+        const Real* v0 = x0.row_begin(1);
+        const Real* z1 = dw.row_begin(0);
+        const Real* z2 = dw.row_begin(1);
+        Real* s = x.row_begin(0);
+        Real* v = x.row_begin(1);
+
+        switch (discretization_) {
+          case PartialTruncation:
+            for (Size k=0; k<n; ++k) {
+                const Real vol = (v0[k] > 0.0) ? std::sqrt(v0[k]) : 0.0;
+                const Real mu = drift - 0.5 * vol * vol;
+                const Real nu = nu0 + nu1 * v0[k];
+                s[k] = s0[k] * std::exp(mu*dt+vol*z1[k]*sdt);
+                v[k] = v0[k] + nu*dt + sdt*vol*vol*(rho1_*z1[k] + rho2_*z2[k]);
+            }
+            break;
+          case FullTruncation:
+            for (Size k=0; k<n; ++k) {
+                const Real vol = (v0[k] > 0.0) ? std::sqrt(v0[k]) : 0.0;
+                const Real mu = drift - 0.5 * vol * vol;
+                const Real nu = nu0 + nu1 * vol * vol;
+                s[k] = s0[k] * std::exp(mu*dt+vol*z1[k]*sdt);
+                v[k] = v0[k] + nu*dt + sdt*vol*vol*(rho1_*z1[k] + rho2_*z2[k]);
+            }
+            break;
+          case Reflection:
+            for (Size k=0; k<n; ++k) {
+                const Real vol = std::sqrt(std::fabs(v0[k]));
+                const Real mu = drift - 0.5 * vol*vol;
+                const Real nu = nu0 + nu1 * vol * vol;
+                s[k] = s0[k]*std::exp(mu*dt+vol*z1[k]*sdt);
+                v[k] = vol*vol
+                       +nu*dt + sdt*vol*vol*(rho1_*z1[k] + rho2_*z2[k]);
+            }
+            break;
+          default:
+            QL_FAIL("unknown discretization schema");
+        }
+    }
+
     const Handle<Quote>& GJRGARCHProcess::s0() const {
         return s0_;
     }
@@ -80,6 +80,13 @@ namespace QuantLib {
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        /*! The rate drift and the coefficients of the discretization
+            are calculated once for all the paths in the batch, which
+            are then evolved in a single loop for the chosen scheme.
+            The results are the same as those of evolve().
+        */
+        void evolveBatch(Time t0, const Matrix& x0, Time dt,
+                         const Matrix& dw, Matrix& x) const;
 
         Real v0()     const { return v0_; }
         Real lambda() const { return lambda_; }
@@ -95,10 +102,13 @@ namespace QuantLib {
 
         Time time(const Date&) const;
       private:
+        Rate rateDrift(Time t0, Time dt) const;
         Handle<YieldTermStructure> riskFreeRate_, dividendYield_;
         Handle<Quote> s0_;
         Real v0_, omega_, alpha_, beta_, gamma_, lambda_, daysPerYear_;
         Discretization discretization_;
+        // constant coefficients of the variance dynamics
+        Real varianceDrift_, rho1_, rho2_;
     };
 
 }
@@ -17,6 +17,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/math/fastmath.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/modifiedbessel.hpp>
 #include <ql/math/solvers1d/brent.hpp>
@@ -77,8 +78,32 @@ namespace QuantLib {
         return tmp;
     }
 
+    namespace {
+
+        FixedArray<2> state(const Array& x) {
+            FixedArray<2> s;
+            s[0] = x[0];
+            s[1] = x[1];
+            return s;
+        }
+
+    }
+
     Disposable<Array> HestonProcess::drift(Time t, const Array& x) const {
-        Array tmp(2);
+        return drift(t, state(x)).toArray();
+    }
+
+    Disposable<Matrix> HestonProcess::diffusion(Time t, const Array& x) const {
+        return diffusion(t, state(x)).toMatrix();
+    }
+
+    Disposable<Array> HestonProcess::apply(const Array& x0,
+                                           const Array& dx) const {
+        return apply(state(x0), state(dx)).toArray();
+    }
+
+    FixedArray<2> HestonProcess::drift(Time t, const FixedArray<2>& x) const {
+        FixedArray<2> tmp;
         const Real vol = (x[1] > 0.0) ? std::sqrt(x[1])
                          : (discretization_ == Reflection) ? - std::sqrt(-x[1])
                          : 0.0;
@@ -92,7 +117,8 @@ namespace QuantLib {
         return tmp;
     }
 
-    Disposable<Matrix> HestonProcess::diffusion(Time, const Array& x) const {
+    FixedMatrix<2,2> HestonProcess::diffusion(Time,
+                                              const FixedArray<2>& x) const {
         /* the correlation matrix is
            |  1   rho |
            | rho   1  |
@@ -100,7 +126,7 @@ namespace QuantLib {
            |  1          0       |
            | rho   sqrt(1-rho^2) |
         */
-        Matrix tmp(2,2);
+        FixedMatrix<2,2> tmp;
         const Real vol = (x[1] > 0.0) ? std::sqrt(x[1])
                          : (discretization_ == Reflection) ? -std::sqrt(-x[1])
                          : 1e-8; // set vol to (almost) zero but still
@@ -113,9 +139,9 @@ namespace QuantLib {
         return tmp;
     }
 
-    Disposable<Array> HestonProcess::apply(const Array& x0,
-                                           const Array& dx) const {
-        Array tmp(2);
+    FixedArray<2> HestonProcess::apply(const FixedArray<2>& x0,
+                                       const FixedArray<2>& dx) const {
+        FixedArray<2> tmp;
         tmp[0] = x0[0] * std::exp(dx[0]);
         tmp[1] = x0[1] + dx[1];
         return tmp;
@@ -366,6 +392,131 @@ namespace QuantLib {
         }
     }
 
+    namespace {
+
+        // Distribution of the integrated variance, conditional on
+        // the values of the variance at the start and end of the
+        // step, as calculated by cdf_nu_ds().  The values of the
+        // characteristic function used by the Laguerre and
+        // trapezoidal integrations, as well as the upper bound of
+        // the integration, don't depend on the point at which the
+        // distribution is evaluated; they're calculated once, so
+        // that they're not repeated at each iteration of the root
+        // finding.  The results are the same as those of cdf_nu_ds().
+        class IntegratedVarianceDistribution {
+          public:
+            IntegratedVarianceDistribution(
+                            const HestonProcess& process,
+                            Real nu_0, Real nu_t, Time dt,
+                            HestonProcess::Discretization discretization)
+            : process_(process), nu_0_(nu_0), nu_t_(nu_t), dt_(dt),
+              discretization_(discretization), upper_(0.0) {
+                const Real eps = 1e-4;
+                switch (discretization) {
+                  case HestonProcess::BroadieKayaExactSchemeLaguerre:
+                  {
+                    const GaussLaguerreIntegration& integration =
+                        laguerreIntegration();
+                    phi_.resize(integration.order());
+                    for (Size i=0; i<phi_.size(); ++i)
+                        phi_[i] = Phi(process, integration.x()[i],
+                                      nu_0, nu_t, dt).real();
+                  }
+                    // fall through
+                  case HestonProcess::BroadieKayaExactSchemeLobatto:
+                  {
+                    const Real u_eps = std::min(100.0, std::max(0.1,
+                        cornishFisherEps(process, nu_0, nu_t, dt, eps)));
+                    upper_ = u_eps/2.0;
+                    while (std::abs(Phi(process,upper_,nu_0,nu_t,dt)/upper_)
+                           > eps) upper_*=2.0;
+                    break;
+                  }
+                  case HestonProcess::BroadieKayaExactSchemeTrapezoidal:
+                  {
+                    const Real h = 0.05;
+                    std::complex<Real> f;
+                    Size j = 0;
+                    do {
+                        ++j;
+                        f = Phi(process, h*j, nu_0, nu_t, dt);
+                        phi_.push_back(f.real());
+                    }
+                    while (M_2_PI*std::abs(f)/j > eps);
+                    break;
+                  }
+                  default:
+                    QL_FAIL("unknown integration method");
+                }
+            }
+
+            Real operator()(Real x) const {
+                switch (discretization_) {
+                  case HestonProcess::BroadieKayaExactSchemeLaguerre:
+                  {
+                    if (x >= upper_)
+                        return 1.0;
+                    const GaussLaguerreIntegration& integration =
+                        laguerreIntegration();
+                    const Array& w = integration.weights();
+                    const Array& u = integration.x();
+                    Real sum = 0.0;
+                    for (Integer i = Integer(phi_.size())-1; i >= 0; --i)
+                        sum += w[i] * (M_2_PI*std::sin(u[i]*x)/u[i]*phi_[i]);
+                    return std::max(0.0, std::min(1.0, sum));
+                  }
+                  case HestonProcess::BroadieKayaExactSchemeLobatto:
+                    return (x < upper_)
+                        ? std::max(0.0, std::min(1.0,
+                            GaussLobattoIntegral(Null<Size>(), 1e-4)(
+                                boost::bind(&ch, boost::cref(process_), x,
+                                            _1, nu_0_, nu_t_, dt_),
+                                QL_EPSILON, upper_)))
+                        : 1.0;
+                  case HestonProcess::BroadieKayaExactSchemeTrapezoidal:
+                  {
+                    const Real h = 0.05;
+                    Real si = Si(0.5*h*x);
+                    Real s = M_2_PI*si;
+                    for (Size j=1; j<=phi_.size(); ++j) {
+                        const Real u = h*j;
+                        const Real si_n = Si(x*(u+0.5*h));
+                        s+= M_2_PI*phi_[j-1]*(si_n-si);
+                        si = si_n;
+                    }
+                    return s;
+                  }
+                  default:
+                    QL_FAIL("unknown integration method");
+                }
+            }
+          private:
+            static const GaussLaguerreIntegration& laguerreIntegration() {
+                static const GaussLaguerreIntegration integration(128);
+                return integration;
+            }
+            const HestonProcess& process_;
+            Real nu_0_, nu_t_;
+            Time dt_;
+            HestonProcess::Discretization discretization_;
+            Real upper_;
+            std::vector<Real> phi_;
+        };
+
+        class IntegratedVarianceQuantile {
+          public:
+            IntegratedVarianceQuantile(
+                                const IntegratedVarianceDistribution& cdf,
+                                Real p)
+            : cdf_(cdf), p_(p) {}
+            Real operator()(Real x) const { return cdf_(x) - p_; }
+          private:
+            const IntegratedVarianceDistribution& cdf_;
+            Real p_;
+        };
+
+    }
+
     Real cdf_nu_ds_minus_x(const HestonProcess &process, Real x, Real nu_0,
                            Real nu_t, Time dt,
                            HestonProcess::Discretization discretization,
@@ -410,9 +561,130 @@ namespace QuantLib {
                      v/k) / k;
      }
 
+    Rate HestonProcess::rateDrift(Time t0, Time dt) const {
+        return riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
+            - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+    }
+
     Disposable<Array> HestonProcess::evolve(Time t0, const Array& x0,
                                             Time dt, const Array& dw) const {
-        Array retVal(2);
+        return evolve(t0, state(x0), dt, dw.begin(),
+                      rateDrift(t0, dt)).toArray();
+    }
+
+    void HestonProcess::evolveBatch(Time t0, const Matrix& x0,
+                                    Time dt, const Matrix& dw,
+                                    Matrix& x) const {
+        QL_REQUIRE(x0.rows() == 2 && dw.rows() == factors()
+                   && dw.columns() == x0.columns(),
+                   "wrong batch dimensions: " << x0.rows() << "x"
+                   << x0.columns() << " state variables and " << dw.rows()
+                   << "x" << dw.columns() << " factors given");
+        if (x.rows() != 2 || x.columns() != x0.columns())
+            x = Matrix(2, x0.columns());
+
+        // the same for all paths
+        const Rate drift = rateDrift(t0, dt);
+
+        if (discretization_ == QuadraticExponential
+            || discretization_ == QuadraticExponentialMartingale) {
+            quadraticExponentialBatch(x0, dt, dw, drift, x);
+            return;
+        }
+
+        FixedArray<2> s;
+        FixedArray<3> w;
+        for (Size k=0; k<x0.columns(); ++k) {
+            s[0] = x0[0][k];
+            s[1] = x0[1][k];
+            for (Size j=0; j<dw.rows(); ++j)
+                w[j] = dw[j][k];
+            const FixedArray<2> y = evolve(t0, s, dt, w.begin(), drift);
+            x[0][k] = y[0];
+            x[1][k] = y[1];
+        }
+    }
+
+    void HestonProcess::quadraticExponentialBatch(const Matrix& x0,
+                                                  Time dt,
+                                                  const Matrix& dw,
+                                                  Rate rateDrift,
+                                                  Matrix& x) const {
+        const Size n = x0.columns();
+        const Real* s0 = x0.row_begin(0);
+        const Real* v0 = x0.row_begin(1);
+        const Real* z1 = dw.row_begin(0);
+        const Real* z2 = dw.row_begin(1);
+
+        // the same quantities as in evolve(), calculated once
+        const Real ex = std::exp(-kappa_*dt);
+        const Real g1 =  0.5;
+        const Real g2 =  0.5;
+        const Real k0 = -rho_*kappa_*theta_*dt/sigma_;
+        const Real k1 =  g1*dt*(kappa_*rho_/sigma_-0.5)-rho_/sigma_;
+        const Real k2 =  g2*dt*(kappa_*rho_/sigma_-0.5)+rho_/sigma_;
+        const Real k3 =  g1*dt*(1-rho_*rho_);
+        const Real k4 =  g2*dt*(1-rho_*rho_);
+        const Real A  =  k2+0.5*k4;
+        const Real mu =  rateDrift;
+        const bool martingale =
+            (discretization_ == QuadraticExponentialMartingale);
+
+        std::vector<Real> u(n);
+        CumulativeNormalDistribution()(z2, &u[0], n);
+
+        // Both schemes are calculated for each path, and one of the
+        // results is selected.  The value of psi and the arguments of
+        // the logarithms are restricted so that the discarded scheme
+        // doesn't produce invalid values.
+        bool valid = true;
+        Real* s = x.row_begin(0);
+        Real* v = x.row_begin(1);
+        for (Size k=0; k<n; ++k) {
+            const Real m  =  theta_+(v0[k]-theta_)*ex;
+            const Real s2 =  v0[k]*sigma_*sigma_*ex/kappa_*(1-ex)
+                           + theta_*sigma_*sigma_/(2*kappa_)*(1-ex)*(1-ex);
+            const Real psi = s2/(m*m);
+            const bool quadratic = (psi < 1.5);
+
+            // quadratic scheme
+            const Real psiQ = std::min(psi, 1.5);
+            const Real b2 = 2/psiQ-1+std::sqrt(2/psiQ*(2/psiQ-1));
+            const Real b  = std::sqrt(b2);
+            const Real a  = m/(1+b2);
+            const Real vQ = a*(b+z2[k])*(b+z2[k]);
+
+            // exponential scheme
+            const Real psiE = std::max(psi, 1.5);
+            const Real p = (psiE-1)/(psiE+1);
+            const Real beta = (1-p)/m;
+            const Real vE =
+                ((u[k] <= p) ? 0.0 : KernelMath::log((1-p)/(1-u[k]))/beta);
+
+            Real k0k = k0;
+            if (martingale) {
+                valid = valid && (quadratic ? A < 1/(2*a) : A < beta);
+                const Real k0Q = -A*b2*a/(1-2*A*a)
+                    +0.5*KernelMath::log(1-(quadratic ? 2*A*a : 0.0))
+                    -(k1+0.5*k3)*v0[k];
+                const Real k0E =
+                    -KernelMath::log(quadratic ? 1.0 : p+beta*(1-p)/(beta-A))
+                    -(k1+0.5*k3)*v0[k];
+                k0k = quadratic ? k0Q : k0E;
+            }
+
+            const Real vk = quadratic ? vQ : vE;
+            s[k] = s0[k]*KernelMath::exp(mu*dt + k0k + k1*v0[k] + k2*vk
+                                         +std::sqrt(k3*v0[k]+k4*vk)*z1[k]);
+            v[k] = vk;
+        }
+        QL_REQUIRE(valid, "illegal value");
+    }
+
+    FixedArray<2> HestonProcess::evolve(Time t0, const FixedArray<2>& x0,
+                                        Time dt, const Real* dw,
+                                        Rate rateDrift) const {
+        FixedArray<2> retVal;
         Real vol, vol2, mu, nu, dy;
 
         const Real sdt = std::sqrt(dt);
@@ -427,8 +699,7 @@ namespace QuantLib {
           case PartialTruncation:
             vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : 0.0;
             vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous)
+            mu =    rateDrift
                     - 0.5 * vol * vol;
             nu = kappa_*(theta_ - x0[1]);
 
@@ -438,8 +709,7 @@ namespace QuantLib {
           case FullTruncation:
             vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : 0.0;
             vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous)
+            mu =    rateDrift
                     - 0.5 * vol * vol;
             nu = kappa_*(theta_ - vol*vol);
 
@@ -449,8 +719,7 @@ namespace QuantLib {
           case Reflection:
             vol = std::sqrt(std::fabs(x0[1]));
             vol2 = sigma_ * vol;
-            mu =    riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                  - dividendYield_->forwardRate(t0, t0+dt, Continuous)
+            mu =    rateDrift
                     - 0.5 * vol*vol;
             nu = kappa_*(theta_ - vol*vol);
 
@@ -465,8 +734,7 @@ namespace QuantLib {
             // process. For further details please read the Wilmott thread
             // "QuantLib code is very high quality"
             vol = (x0[1] > 0.0) ? std::sqrt(x0[1]) : 0.0;
-            mu =   riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                 - dividendYield_->forwardRate(t0, t0+dt, Continuous)
+            mu =   rateDrift
                    - 0.5 * vol*vol;
 
             retVal[1] = varianceDistribution(x0[1], dw[1], dt);
@@ -524,8 +792,7 @@ namespace QuantLib {
                 retVal[1] = ((u <= p) ? 0.0 : std::log((1-p)/(1-u))/beta);
             }
 
-            mu =   riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                 - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+            mu =   rateDrift;
 
             retVal[0] = x0[0]*std::exp(mu*dt + k0 + k1*x0[1] + k2*retVal[1]
                                        +std::sqrt(k3*x0[1]+k4*retVal[1])*dw[0]);
@@ -541,16 +808,16 @@ namespace QuantLib {
             const Real x = std::min(1.0-QL_EPSILON,
                 std::max(0.0, CumulativeNormalDistribution()(dw[2])));
 
+            const IntegratedVarianceDistribution cdf(*this, nu_0, nu_t, dt,
+                                                     discretization_);
             const Real vds = Brent().solve(
-                boost::bind(&cdf_nu_ds_minus_x, *this, _1,
-                            nu_0, nu_t, dt, discretization_, x),
+                IntegratedVarianceQuantile(cdf, x),
                 1e-5, theta_*dt, 0.1*theta_*dt);
 
             const Real vdw
                 = (nu_t - nu_0 - kappa_*theta_*dt + kappa_*vds)/sigma_;
 
-            mu = ( riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
-                  -dividendYield_->forwardRate(t0, t0+dt, Continuous))*dt
+            mu = ( rateDrift)*dt
                 - 0.5*vds + rho_*vdw;
 
             const Volatility sig = std::sqrt((1-rho_*rho_)*vds);
@@ -25,6 +25,7 @@
 #define quantlib_heston_process_hpp
 
 #include <ql/stochasticprocess.hpp>
+#include <ql/math/fixedmatrix.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/quote.hpp>
 
@@ -41,6 +42,15 @@ namespace QuantLib {
         \end{array}
         \f]
 
+        The overloads taking and returning fixed-size arrays give the
+        same results as the ones based on Array, but they don't
+        allocate memory; they can be used in simulation kernels where
+        the process is known to be a Heston one.
+
+        \warning the fixed-size overloads are not virtual; they are
+                 not overridden by derived processes such as the
+                 Bates one.
+
         \ingroup processes
     */
     class HestonProcess : public StochasticProcess {
@@ -71,6 +81,31 @@ namespace QuantLib {
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        /*! the rate drift is calculated once for all the paths in
+            the batch.  The quadratic-exponential schemes are applied
+            to all the paths in a single loop without branches, in
+            which both the quadratic and the exponential variance
+            are calculated and one of them is selected; the uniform
+            variates needed by the latter are calculated for all the
+            paths in a separate pass by the batch version of
+            CumulativeNormalDistribution.  The results agree with
+            those of evolve() up to the differences between the two
+            implementations of the cumulative normal distribution.
+        */
+        void evolveBatch(Time t0, const Matrix& x0, Time dt,
+                         const Matrix& dw, Matrix& x) const;
+
+        //! \name Fixed-size interface
+        //@{
+        FixedArray<2> drift(Time t, const FixedArray<2>& x) const;
+        FixedMatrix<2,2> diffusion(Time t, const FixedArray<2>& x) const;
+        FixedArray<2> apply(const FixedArray<2>& x0,
+                            const FixedArray<2>& dx) const;
+        /*! \pre F must be at least equal to the number of factors */
+        template <Size F>
+        FixedArray<2> evolve(Time t0, const FixedArray<2>& x0,
+                             Time dt, const FixedArray<F>& dw) const;
+        //@}
 
         Real v0()    const { return v0_; }
         Real rho()   const { return rho_; }
@@ -89,6 +124,13 @@ namespace QuantLib {
         Real pdf(Real x, Real v, Time t, Real eps=1e-3) const;
 
       private:
+        Rate rateDrift(Time t0, Time dt) const;
+        FixedArray<2> evolve(Time t0, const FixedArray<2>& x0,
+                             Time dt, const Real* dw,
+                             Rate rateDrift) const;
+        void quadraticExponentialBatch(const Matrix& x0, Time dt,
+                                       const Matrix& dw, Rate rateDrift,
+                                       Matrix& x) const;
         Real varianceDistribution(Real v, Real dw, Time dt) const;
 
         Handle<YieldTermStructure> riskFreeRate_, dividendYield_;
@@ -96,5 +138,19 @@ namespace QuantLib {
         Real v0_, kappa_, theta_, sigma_, rho_;
         Discretization discretization_;
     };
+
+
+    // inline definitions
+
+    template <Size F>
+    inline FixedArray<2> HestonProcess::evolve(Time t0,
+                                               const FixedArray<2>& x0,
+                                               Time dt,
+                                               const FixedArray<F>& dw) const {
+        QL_REQUIRE(F >= factors(),
+                   F << " factors given, " << factors() << " required");
+        return evolve(t0, x0, dt, dw.begin(), rateDrift(t0, dt));
+    }
+
 }
 #endif
@@ -112,9 +112,28 @@ namespace QuantLib {
         return retVal;
     }
 
+    namespace {
+
+        FixedArray<3> state(const Array& x) {
+            FixedArray<3> s;
+            s[0] = x[0];
+            s[1] = x[1];
+            s[2] = x[2];
+            return s;
+        }
+
+    }
+
     Disposable<Array> 
     HybridHestonHullWhiteProcess::evolve(Time t0, const Array& x0,
                                          Time dt, const Array& dw) const {
+        return evolve(t0, state(x0), dt, state(dw)).toArray();
+    }
+
+    FixedArray<3>
+    HybridHestonHullWhiteProcess::evolve(Time t0, const FixedArray<3>& x0,
+                                         Time dt,
+                                         const FixedArray<3>& dw) const {
 
         const Rate r         = x0[2];
         const Real a         = hullWhiteProcess_->a();
@@ -154,7 +173,7 @@ namespace QuantLib {
 
         const Real mu = m1 + m2 + m3 + m4 + m5;
 
-        Array retVal(3);
+        FixedArray<3> retVal;
         
         const Real eta2 = hestonProcess_->sigma() * eta;
         const Real nu
@@ -37,6 +37,10 @@ namespace QuantLib {
         \bug This class was not tested enough to guarantee
              its functionality... work in progress
 
+        The overload of evolve() taking and returning fixed-size
+        arrays gives the same results as the one based on Array, but
+        it doesn't allocate memory.
+
         \ingroup processes
     */
     class HybridHestonHullWhiteProcess : public StochasticProcess {
@@ -57,6 +61,8 @@ namespace QuantLib {
 
         Disposable<Array> evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        FixedArray<3> evolve(Time t0, const FixedArray<3>& x0,
+                             Time dt, const FixedArray<3>& dw) const;
 
         DiscountFactor numeraire(Time t, const Array& x) const;
 
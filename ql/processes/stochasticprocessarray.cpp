@@ -107,6 +107,29 @@ namespace QuantLib {
         return tmp;
     }
 
+    void StochasticProcessArray::evolveBatch(Time t0, const Matrix& x0,
+                                             Time dt, const Matrix& dw,
+                                             Matrix& x) const {
+        QL_REQUIRE(x0.rows() == size() && dw.rows() == factors()
+                   && dw.columns() == x0.columns(),
+                   "wrong batch dimensions: " << x0.rows() << "x"
+                   << x0.columns() << " state variables and " << dw.rows()
+                   << "x" << dw.columns() << " factors given");
+        const Size n = x0.columns();
+        if (x.rows() != size() || x.columns() != n)
+            x = Matrix(size(), n);
+
+        const Matrix dz = sqrtCorrelation_ * dw;
+
+        Matrix xi(1, n), dzi(1, n), yi(1, n);
+        for (Size i=0; i<size(); ++i) {
+            std::copy(x0.row_begin(i), x0.row_end(i), xi.begin());
+            std::copy(dz.row_begin(i), dz.row_end(i), dzi.begin());
+            processes_[i]->evolveBatch(t0, xi, dt, dzi, yi);
+            std::copy(yi.begin(), yi.end(), x.row_begin(i));
+        }
+    }
+
     Disposable<Array> StochasticProcessArray::apply(const Array& x0,
                                                     const Array& dx) const {
         Array tmp(size());
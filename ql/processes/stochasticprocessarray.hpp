@@ -51,6 +51,11 @@ namespace QuantLib {
         Disposable<Array> apply(const Array& x0, const Array& dx) const;
         Disposable<Array> evolve(Time t0, const Array& x0,
                                   Time dt, const Array& dw) const;
+        /*! the factors of all the paths are correlated by a single
+            matrix product; each process then evolves its own batch.
+        */
+        void evolveBatch(Time t0, const Matrix& x0, Time dt,
+                         const Matrix& dw, Matrix& x) const;
 
         Time time(const Date&) const;
         // inspectors
@@ -50,7 +50,7 @@
    The idea is to provide a hook for defining QL_REAL and at the
    same time including any necessary headers for the new type.
 */
-#define INCLUDE_FILE(F) INCLUDE_FILE__(F)
+#define INCLUDE_FILE(F) INCLUDE_FILE_(F)
 #define INCLUDE_FILE_(F) #F
 #ifdef QL_INCLUDE_FIRST
 #    include INCLUDE_FILE(QL_INCLUDE_FIRST)
@@ -110,6 +110,16 @@
     #endif
 #endif
 
+// Disposable is needed to emulate move semantics on legacy compilers
+// (older Boost versions don't define the macros below)
+#if BOOST_VERSION < 105100 \
+    || defined(BOOST_NO_CXX11_RVALUE_REFERENCES) \
+    || defined(BOOST_NO_CXX11_TEMPLATE_ALIASES)
+    #ifndef QL_USE_DISPOSABLE
+        #define QL_USE_DISPOSABLE
+    #endif
+#endif
+
 #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
     #if BOOST_VERSION < 105800
         #error Boost version 1.58 or higher is required for the thread-safe observer pattern
@@ -122,6 +132,13 @@
     #endif
 #endif
 
+// thread-local storage for variables of built-in type
+#if defined(_MSC_VER)
+    #define QL_THREAD_LOCAL __declspec(thread)
+#else
+    #define QL_THREAD_LOCAL __thread
+#endif
+
 // ensure that needed math constants are defined
 #include <ql/mathconstants.hpp>
 
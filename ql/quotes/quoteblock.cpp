@@ -0,0 +1,150 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/quotes/quoteblock.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+
+namespace QuantLib {
+
+    QuoteBlock::QuoteBlock(Size size, Real value)
+    : values_(size, value) {}
+
+    QuoteBlock::QuoteBlock(const std::vector<Real>& values)
+    : values_(values) {}
+
+    Real QuoteBlock::setValue(Size i, Real value) {
+        QL_REQUIRE(i < values_.size(),
+                   "index (" << i << ") out of range [0, "
+                   << values_.size() << ")");
+        Real diff = value-values_[i];
+        if (diff != 0.0) {
+            values_[i] = value;
+            notifyObservers();
+        }
+        return diff;
+    }
+
+
+    QuoteBlockElement::QuoteBlockElement(
+                              const boost::shared_ptr<QuoteBlock>& block,
+                              Size index)
+    : block_(block), index_(index) {
+        QL_REQUIRE(block_, "null quote block");
+        QL_REQUIRE(index_ < block_->size(),
+                   "index (" << index_ << ") out of range [0, "
+                   << block_->size() << ")");
+        registerWith(block_);
+    }
+
+
+    namespace {
+
+        // splits a line at commas, ignoring a trailing carriage return
+        void split(const std::string& line,
+                   std::vector<std::string>& fields) {
+            fields.clear();
+            std::string::size_type end = line.size();
+            if (end > 0 && line[end-1] == '\r')
+                --end;
+            std::string::size_type begin = 0;
+            for (;;) {
+                std::string::size_type comma = line.find(',', begin);
+                if (comma == std::string::npos || comma > end) {
+                    fields.push_back(line.substr(begin, end-begin));
+                    return;
+                }
+                fields.push_back(line.substr(begin, comma-begin));
+                begin = comma+1;
+            }
+        }
+
+        Real parse(const std::string& field, Size row) {
+            std::string::size_type begin = field.find_first_not_of(" \t");
+            if (begin == std::string::npos)
+                return Null<Real>();
+            const char* start = field.c_str() + begin;
+            char* stop;
+            Real value = std::strtod(start, &stop);
+            QL_REQUIRE(stop != start &&
+                       field.find_first_not_of(" \t",
+                                               stop-field.c_str())
+                       == std::string::npos,
+                       "invalid value '" << field << "' at row " << row);
+            return value;
+        }
+
+    }
+
+    void loadQuoteBlock(QuoteBlock& block, std::istream& csv,
+                        const std::string& column) {
+        std::string line;
+        std::vector<std::string> fields;
+        QL_REQUIRE(std::getline(csv, line), "missing header line");
+        split(line, fields);
+        Size index = std::find(fields.begin(), fields.end(), column)
+                   - fields.begin();
+        QL_REQUIRE(index < fields.size(),
+                   "column '" << column << "' not found");
+
+        std::vector<Real> values;
+        values.reserve(block.size());
+        while (std::getline(csv, line)) {
+            if (line.empty() || line == "\r")
+                continue;
+            split(line, fields);
+            Size row = values.size()+1;
+            QL_REQUIRE(index < fields.size(),
+                       "missing column '" << column << "' at row " << row);
+            values.push_back(parse(fields[index], row));
+        }
+        QL_REQUIRE(values.size() == block.size(),
+                   values.size() << " values read; "
+                   << block.size() << " required");
+        block.setValues(values);
+    }
+
+    void loadQuoteBlock(QuoteBlock& block, std::istream& binary) {
+        boost::uint64_t n;
+        binary.read(reinterpret_cast<char*>(&n), sizeof(n));
+        QL_REQUIRE(binary, "missing number of values");
+        QL_REQUIRE(n == block.size(),
+                   n << " values given; " << block.size() << " required");
+
+        std::vector<double> values(block.size());
+        if (!values.empty())
+            binary.read(reinterpret_cast<char*>(&values[0]),
+                        values.size()*sizeof(double));
+        QL_REQUIRE(binary, "unexpected end of data");
+        block.setValues(values.begin(), values.end());
+    }
+
+    void saveQuoteBlock(const QuoteBlock& block, std::ostream& binary) {
+        boost::uint64_t n = block.size();
+        binary.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        std::vector<double> values(block.values().begin(),
+                                   block.values().end());
+        if (!values.empty())
+            binary.write(reinterpret_cast<const char*>(&values[0]),
+                         values.size()*sizeof(double));
+        QL_REQUIRE(binary, "error while writing quote block");
+    }
+
+}
@@ -0,0 +1,170 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file quoteblock.hpp
+    \brief contiguous block of market values
+*/
+
+#ifndef quantlib_quote_block_hpp
+#define quantlib_quote_block_hpp
+
+#include <ql/quote.hpp>
+#include <ql/handle.hpp>
+#include <ql/utilities/null.hpp>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! contiguous block of market values
+    /*! The block stores a large number of market values in a single
+        vector and notifies its observers once for any change,
+        however many values were modified.  Single values are
+        available as quotes through QuoteBlockElement instances,
+        which are only needed for the values actually used by term
+        structures or instruments.
+
+        Invalid values are stored as Null<Real>().
+    */
+    class QuoteBlock : public Observable {
+      public:
+        explicit QuoteBlock(Size size, Real value = Null<Real>());
+        explicit QuoteBlock(const std::vector<Real>& values);
+        //! \name Inspectors
+        //@{
+        Size size() const { return values_.size(); }
+        Real value(Size i) const;
+        bool isValid(Size i) const;
+        const std::vector<Real>& values() const { return values_; }
+        //@}
+        //! \name Modifiers
+        //@{
+        //! returns the difference between the new value and the old value
+        Real setValue(Size i, Real value = Null<Real>());
+        /*! Observers are notified once if any of the values changed. */
+        void setValues(const std::vector<Real>& values);
+        /*! Observers are notified once if any of the values changed. */
+        template <class Iterator>
+        void setValues(Iterator begin, Iterator end);
+        //@}
+      private:
+        std::vector<Real> values_;
+    };
+
+
+    //! market element returning a value stored in a QuoteBlock
+    class QuoteBlockElement : public Quote, public Observer {
+      public:
+        QuoteBlockElement(const boost::shared_ptr<QuoteBlock>& block,
+                          Size index);
+        //! \name Quote interface
+        //@{
+        Real value() const;
+        bool isValid() const;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+        //! \name Inspectors
+        //@{
+        const boost::shared_ptr<QuoteBlock>& block() const { return block_; }
+        Size index() const { return index_; }
+        //@}
+      private:
+        boost::shared_ptr<QuoteBlock> block_;
+        Size index_;
+    };
+
+
+    //! \name Loading quote blocks
+    //@{
+    /*! Reads the values from a column of comma-separated data.  The
+        first line must contain the column names; each of the
+        following non-empty lines provides a value.  Empty fields are
+        read as invalid values.  The number of values must equal the
+        size of the block, whose observers are notified once.
+    */
+    void loadQuoteBlock(QuoteBlock& block, std::istream& csv,
+                        const std::string& column);
+
+    /*! Reads binary data made of the number of values, as a 64-bit
+        unsigned integer, followed by the values as doubles, both in
+        the byte order of the machine.  The number of values must
+        equal the size of the block, whose observers are notified
+        once.  The stream must be opened in binary mode.
+    */
+    void loadQuoteBlock(QuoteBlock& block, std::istream& binary);
+
+    /*! Writes the values in the format read by loadQuoteBlock(). */
+    void saveQuoteBlock(const QuoteBlock& block, std::ostream& binary);
+    //@}
+
+
+    // inline definitions
+
+    inline Real QuoteBlock::value(Size i) const {
+        QL_REQUIRE(i < values_.size(),
+                   "index (" << i << ") out of range [0, "
+                   << values_.size() << ")");
+        return values_[i];
+    }
+
+    inline bool QuoteBlock::isValid(Size i) const {
+        return value(i) != Null<Real>();
+    }
+
+    template <class Iterator>
+    void QuoteBlock::setValues(Iterator begin, Iterator end) {
+        bool changed = false;
+        std::vector<Real>::iterator v = values_.begin();
+        for (; begin != end && v != values_.end(); ++begin, ++v) {
+            Real value = *begin;
+            if (value != *v) {
+                *v = value;
+                changed = true;
+            }
+        }
+        QL_REQUIRE(begin == end && v == values_.end(),
+                   "wrong number of values given for quote block of size "
+                   << values_.size());
+        if (changed)
+            notifyObservers();
+    }
+
+    inline void QuoteBlock::setValues(const std::vector<Real>& values) {
+        setValues(values.begin(), values.end());
+    }
+
+    inline Real QuoteBlockElement::value() const {
+        Real result = block_->value(index_);
+        QL_ENSURE(result != Null<Real>(), "invalid QuoteBlockElement");
+        return result;
+    }
+
+    inline bool QuoteBlockElement::isValid() const {
+        return block_->isValid(index_);
+    }
+
+    inline void QuoteBlockElement::update() {
+        notifyObservers();
+    }
+
+}
+
+#endif
@@ -23,6 +23,12 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        QL_THREAD_LOCAL ValuationContext* currentContext_ = 0;
+
+    }
+
     Settings::DateProxy::DateProxy()
     : ObservableValue<Date>(Date()) {}
 
@@ -37,13 +43,88 @@ namespace QuantLib {
 
     void Settings::anchorEvaluationDate() {
         // set to today's date if not already set.
-        if (evaluationDate_.value() == Date())
-            evaluationDate_ = Date::todaysDate();
+        if (evaluationDate().value() == Date())
+            evaluationDate() = Date::todaysDate();
         // If set, no-op since the date is already anchored.
     }
 
     void Settings::resetEvaluationDate() {
-        evaluationDate_ = Date();
+        evaluationDate() = Date();
+    }
+
+    Settings::DateProxy& Settings::evaluationDate() {
+        return currentContext_ ? currentContext_->evaluationDate_
+                               : evaluationDate_;
+    }
+
+    const Settings::DateProxy& Settings::evaluationDate() const {
+        return currentContext_ ? currentContext_->evaluationDate_
+                               : evaluationDate_;
+    }
+
+    bool& Settings::includeReferenceDateEvents() {
+        return currentContext_ ? currentContext_->includeReferenceDateEvents_
+                               : includeReferenceDateEvents_;
+    }
+
+    bool Settings::includeReferenceDateEvents() const {
+        return currentContext_ ? currentContext_->includeReferenceDateEvents_
+                               : includeReferenceDateEvents_;
+    }
+
+    boost::optional<bool>& Settings::includeTodaysCashFlows() {
+        return currentContext_ ? currentContext_->includeTodaysCashFlows_
+                               : includeTodaysCashFlows_;
+    }
+
+    boost::optional<bool> Settings::includeTodaysCashFlows() const {
+        return currentContext_ ? currentContext_->includeTodaysCashFlows_
+                               : includeTodaysCashFlows_;
+    }
+
+    bool& Settings::enforcesTodaysHistoricFixings() {
+        return currentContext_
+            ? currentContext_->enforcesTodaysHistoricFixings_
+            : enforcesTodaysHistoricFixings_;
+    }
+
+    bool Settings::enforcesTodaysHistoricFixings() const {
+        return currentContext_
+            ? currentContext_->enforcesTodaysHistoricFixings_
+            : enforcesTodaysHistoricFixings_;
+    }
+
+
+    ValuationContext::ValuationContext()
+    : includeReferenceDateEvents_(
+                        Settings::instance().includeReferenceDateEvents()),
+      includeTodaysCashFlows_(Settings::instance().includeTodaysCashFlows()),
+      enforcesTodaysHistoricFixings_(
+                        Settings::instance().enforcesTodaysHistoricFixings()) {
+        // the raw value, so that a null date keeps following today's date
+        evaluationDate_ = Settings::instance().evaluationDate().value();
+    }
+
+    ValuationContext::ValuationContext(const Date& evaluationDate)
+    : includeReferenceDateEvents_(
+                        Settings::instance().includeReferenceDateEvents()),
+      includeTodaysCashFlows_(Settings::instance().includeTodaysCashFlows()),
+      enforcesTodaysHistoricFixings_(
+                        Settings::instance().enforcesTodaysHistoricFixings()) {
+        evaluationDate_ = evaluationDate;
+    }
+
+    ValuationContext* ValuationContext::current() {
+        return currentContext_;
+    }
+
+    ValuationContext::Binding::Binding(ValuationContext& context)
+    : previous_(currentContext_) {
+        currentContext_ = &context;
+    }
+
+    ValuationContext::Binding::~Binding() {
+        currentContext_ = previous_;
     }
 
     SavedSettings::SavedSettings()
@@ -33,9 +33,15 @@
 
 namespace QuantLib {
 
+    class ValuationContext;
+
     //! global repository for run-time library settings
+    /*! If a ValuationContext is bound to the current thread, the
+        settings are read from and written to the context instead.
+    */
     class Settings : public Singleton<Settings> {
         friend class Singleton<Settings>;
+        friend class ValuationContext;
       private:
         Settings();
         class DateProxy : public ObservableValue<Date> {
@@ -115,6 +121,61 @@ namespace QuantLib {
     };
 
 
+    //! valuation settings bound to a thread
+    /*! A context holds its own copy of the settings.  While it is
+        bound to a thread, the methods of Settings called from that
+        thread access the copy held by the context instead of the
+        global one; in particular, objects registering with the
+        evaluation date (e.g., term structures with a moving reference
+        date) are only notified of changes made in the same context.
+        This allows different threads to price at different
+        evaluation dates:
+        \code
+        // in each worker thread
+        ValuationContext context(today + i);
+        ValuationContext::Binding binding(context);
+        // build and price instruments; Settings::instance()
+        // now refers to the settings of the context
+        \endcode
+
+        A context takes precedence over sessions, if enabled.
+
+        \warning objects should be built and used within the same
+                 context.  A context can be bound to a single thread
+                 at a time; the context must outlive its bindings.
+    */
+    class ValuationContext : private boost::noncopyable {
+        friend class Settings;
+      public:
+        //! copies the settings in use
+        ValuationContext();
+        /*! copies the settings in use except for the evaluation
+            date, which is set to the given value
+        */
+        explicit ValuationContext(const Date& evaluationDate);
+
+        //! binds a context to the current thread during its lifetime
+        /*! The previously bound context, if any, is restored upon
+            destruction; bindings can therefore be nested.
+        */
+        class Binding : private boost::noncopyable {
+          public:
+            explicit Binding(ValuationContext&);
+            ~Binding();
+          private:
+            ValuationContext* previous_;
+        };
+
+        //! the context bound to the current thread, if any
+        static ValuationContext* current();
+      private:
+        Settings::DateProxy evaluationDate_;
+        bool includeReferenceDateEvents_;
+        boost::optional<bool> includeTodaysCashFlows_;
+        bool enforcesTodaysHistoricFixings_;
+    };
+
+
     // helper class to temporarily and safely change the settings
     class SavedSettings {
       public:
@@ -142,38 +203,6 @@ namespace QuantLib {
         return *this;
     }
 
-    inline Settings::DateProxy& Settings::evaluationDate() {
-        return evaluationDate_;
-    }
-
-    inline const Settings::DateProxy& Settings::evaluationDate() const {
-        return evaluationDate_;
-    }
-
-    inline bool& Settings::includeReferenceDateEvents() {
-        return includeReferenceDateEvents_;
-    }
-
-    inline bool Settings::includeReferenceDateEvents() const {
-        return includeReferenceDateEvents_;
-    }
-
-    inline boost::optional<bool>& Settings::includeTodaysCashFlows() {
-        return includeTodaysCashFlows_;
-    }
-
-    inline boost::optional<bool> Settings::includeTodaysCashFlows() const {
-        return includeTodaysCashFlows_;
-    }
-
-    inline bool& Settings::enforcesTodaysHistoricFixings() {
-        return enforcesTodaysHistoricFixings_;
-    }
-
-    inline bool Settings::enforcesTodaysHistoricFixings() const {
-        return enforcesTodaysHistoricFixings_;
-    }
-
 }
 
 #endif
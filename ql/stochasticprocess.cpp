@@ -64,6 +64,26 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    void StochasticProcess::evolveBatch(Time t0, const Matrix& x0,
+                                        Time dt, const Matrix& dw,
+                                        Matrix& x) const {
+        QL_REQUIRE(x0.rows() == size() && dw.rows() == factors()
+                   && dw.columns() == x0.columns(),
+                   "wrong batch dimensions: " << x0.rows() << "x"
+                   << x0.columns() << " state variables and " << dw.rows()
+                   << "x" << dw.columns() << " factors given");
+        if (x.rows() != x0.rows() || x.columns() != x0.columns())
+            x = Matrix(x0.rows(), x0.columns());
+
+        Array s(x0.rows()), w(dw.rows());
+        for (Size k=0; k<x0.columns(); ++k) {
+            std::copy(x0.column_begin(k), x0.column_end(k), s.begin());
+            std::copy(dw.column_begin(k), dw.column_end(k), w.begin());
+            const Array y = evolve(t0, s, dt, w);
+            std::copy(y.begin(), y.end(), x.column_begin(k));
+        }
+    }
+
     Time StochasticProcess::time(const Date& ) const {
         QL_FAIL("date/time conversion not supported");
     }
@@ -128,6 +128,19 @@ namespace QuantLib {
         */
         virtual Disposable<Array> apply(const Array& x0,
                                         const Array& dx) const;
+        /*! evolves a batch of independent paths over the same time
+            interval.  Each column of \f$ x_0 \f$, \f$ \Delta w \f$
+            and \f$ x \f$ holds the state variables, the factors and
+            the results of one path, respectively.  By default, it
+            calls evolve() on each column; derived classes can
+            override it so that time-dependent quantities are
+            calculated once for all the paths.
+        */
+        virtual void evolveBatch(Time t0,
+                                 const Matrix& x0,
+                                 Time dt,
+                                 const Matrix& dw,
+                                 Matrix& x) const;
         //@}
 
         //! \name utilities
@@ -3,7 +3,9 @@
 
 #include <ql/termstructures/bootstraperror.hpp>
 #include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/termstructures/bootstrapscheduler.hpp>
 #include <ql/termstructures/defaulttermstructure.hpp>
+#include <ql/termstructures/globalbootstrap.hpp>
 #include <ql/termstructures/inflationtermstructure.hpp>
 #include <ql/termstructures/interpolatedcurve.hpp>
 #include <ql/termstructures/iterativebootstrap.hpp>
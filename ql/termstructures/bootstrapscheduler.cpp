@@ -0,0 +1,170 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/bootstrapscheduler.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <string>
+
+namespace QuantLib {
+
+    namespace {
+
+        class Flag : public Observer {
+          public:
+            Flag() : up_(false) {}
+            void update() { up_ = true; }
+            bool isUp() const { return up_; }
+            void lower() { up_ = false; }
+          private:
+            bool up_;
+        };
+
+    }
+
+    Size BootstrapScheduler::add(
+               const boost::shared_ptr<TermStructure>& curve,
+               const std::vector<boost::shared_ptr<Observable> >& helpers) {
+        QL_REQUIRE(curve, "null curve given");
+        curves_.push_back(curve);
+        helpers_.push_back(helpers);
+        dependencies_.push_back(std::vector<Size>());
+        buildTimes_.push_back(0.0);
+        dependenciesDetected_ = false;
+        return curves_.size()-1;
+    }
+
+    void BootstrapScheduler::resetDependencies() {
+        dependenciesDetected_ = false;
+    }
+
+    const boost::shared_ptr<TermStructure>&
+    BootstrapScheduler::curve(Size i) const {
+        QL_REQUIRE(i < curves_.size(),
+                   "curve #" << i << " not available; "
+                   << curves_.size() << " curves given");
+        return curves_[i];
+    }
+
+    const std::vector<Size>& BootstrapScheduler::dependencies(Size i) const {
+        QL_REQUIRE(i < curves_.size(),
+                   "curve #" << i << " not available; "
+                   << curves_.size() << " curves given");
+        return dependencies_[i];
+    }
+
+    Real BootstrapScheduler::buildTime(Size i) const {
+        QL_REQUIRE(i < curves_.size(),
+                   "curve #" << i << " not available; "
+                   << curves_.size() << " curves given");
+        return buildTimes_[i];
+    }
+
+    void BootstrapScheduler::detectDependencies() {
+        Size n = curves_.size();
+        std::vector<Flag> flags(n);
+        for (Size i=0; i<n; ++i)
+            for (Size j=0; j<helpers_[i].size(); ++j)
+                flags[i].registerWith(helpers_[i][j]);
+
+        for (Size i=0; i<n; ++i)
+            dependencies_[i].clear();
+        for (Size j=0; j<n; ++j) {
+            for (Size i=0; i<n; ++i)
+                flags[i].lower();
+            curves_[j]->notifyObservers();
+            for (Size i=0; i<n; ++i)
+                if (i != j && flags[i].isUp())
+                    dependencies_[i].push_back(j);
+        }
+        dependenciesDetected_ = true;
+    }
+
+    void BootstrapScheduler::build() {
+        // the detection notifies all curves, which would then be
+        // bootstrapped from scratch; it's done only when needed
+        if (!dependenciesDetected_)
+            detectDependencies();
+
+        // each curve is assigned to the level following those of the
+        // curves it depends upon; the curves in each level are
+        // independent of each other
+        Size n = curves_.size();
+        std::vector<Size> level(n, 0);
+        std::vector<bool> assigned(n, false);
+        Size remaining = n, levels = 0;
+        while (remaining > 0) {
+            std::vector<Size> current;
+            for (Size i=0; i<n; ++i) {
+                if (assigned[i])
+                    continue;
+                bool ready = true;
+                for (Size k=0; k<dependencies_[i].size() && ready; ++k)
+                    ready = assigned[dependencies_[i][k]];
+                if (ready)
+                    current.push_back(i);
+            }
+            QL_REQUIRE(!current.empty(),
+                       "circular dependency among the remaining "
+                       << remaining << " curves");
+            for (Size k=0; k<current.size(); ++k) {
+                assigned[current[k]] = true;
+                level[current[k]] = levels;
+            }
+            remaining -= current.size();
+            ++levels;
+        }
+
+        for (Size l=0; l<levels; ++l) {
+            std::vector<Size> current;
+            for (Size i=0; i<n; ++i)
+                if (level[i] == l)
+                    current.push_back(i);
+
+            Size m = current.size();
+            std::vector<std::string> errors(m);
+            // not vector<bool>, whose elements can't be written
+            // concurrently
+            std::vector<int> failed(m, 0);
+
+            #pragma omp parallel for schedule(dynamic)
+            for (Size k=0; k<m; ++k) {
+                Size i = current[k];
+                boost::posix_time::ptime start =
+                    boost::posix_time::microsec_clock::universal_time();
+                try {
+                    curves_[i]->maxDate();
+                } catch (std::exception& e) {
+                    errors[k] = e.what();
+                    failed[k] = 1;
+                } catch (...) {
+                    errors[k] = "unknown error";
+                    failed[k] = 1;
+                }
+                boost::posix_time::time_duration elapsed =
+                    boost::posix_time::microsec_clock::universal_time()
+                    - start;
+                buildTimes_[i] = elapsed.total_microseconds()*1.0e-6;
+            }
+
+            for (Size k=0; k<m; ++k)
+                QL_REQUIRE(!failed[k],
+                           "curve #" << current[k] << " failed: "
+                           << errors[k]);
+        }
+    }
+
+}
@@ -0,0 +1,109 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file bootstrapscheduler.hpp
+    \brief concurrent bootstrap of interdependent curves
+*/
+
+#ifndef quantlib_bootstrap_scheduler_hpp
+#define quantlib_bootstrap_scheduler_hpp
+
+#include <ql/termstructure.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! concurrent bootstrap of interdependent curves
+    /*! This class bootstraps a set of curves, such as instances of
+        PiecewiseYieldCurve or PiecewiseDefaultCurve, whose helpers
+        might reference other curves in the set (e.g., through an
+        exogenous discounting curve).
+
+        At the first build after curves are added, the dependencies
+        between the curves are detected through the observer pattern:
+        each curve in turn sends a notification, and the curves whose
+        helpers receive it are marked as depending on it.  The curves
+        are then bootstrapped in dependency order; the curves that
+        don't depend on each other are bootstrapped concurrently if
+        OpenMP is enabled.  For instance, a set of default curves
+        sharing a discount curve is bootstrapped concurrently once
+        the discount curve is built.
+
+        Later builds use the same dependencies and only bootstrap the
+        curves that were notified in the meantime, e.g., by a change
+        in their quotes; the iterative bootstrap restarts such curves
+        from the first pillar affected by the change.
+
+        \warning The curves bootstrapped concurrently must not share
+                 helpers or any other object being modified during
+                 the bootstrap; this is the case for curves built on
+                 distinct sets of helpers.  The notifications used to
+                 detect the dependencies invalidate the objects
+                 observing the curves.
+
+        \warning UpfrontCdsHelper temporarily modifies the global
+                 settings while pricing; curves using it should not be
+                 bootstrapped concurrently.
+
+        \ingroup yieldtermstructures
+    */
+    class BootstrapScheduler {
+      public:
+        BootstrapScheduler() : dependenciesDetected_(false) {}
+        //! adds a curve, whose helpers are used to detect dependencies
+        template <class Curve>
+        Size add(const boost::shared_ptr<Curve>& curve) {
+            return add(curve,
+                       std::vector<boost::shared_ptr<Observable> >(
+                                                curve->instruments().begin(),
+                                                curve->instruments().end()));
+        }
+        //! adds a curve bootstrapped on the given helpers
+        /*! The bootstrap is triggered by calling the maxDate()
+            method of the curve.
+        */
+        Size add(const boost::shared_ptr<TermStructure>& curve,
+                 const std::vector<boost::shared_ptr<Observable> >& helpers);
+        //! bootstraps all curves
+        void build();
+        //! forces the detection of the dependencies at the next build
+        /*! This should be called if the helpers were relinked to
+            different curves.
+        */
+        void resetDependencies();
+        //! \name Inspectors
+        //@{
+        Size size() const { return curves_.size(); }
+        const boost::shared_ptr<TermStructure>& curve(Size i) const;
+        //! curves on which the i-th curve depends, as of the last build
+        const std::vector<Size>& dependencies(Size i) const;
+        //! wall-clock time taken by the i-th curve in the last build
+        /*! The time is given in seconds. */
+        Real buildTime(Size i) const;
+        //@}
+      private:
+        void detectDependencies();
+        std::vector<boost::shared_ptr<TermStructure> > curves_;
+        std::vector<std::vector<boost::shared_ptr<Observable> > > helpers_;
+        std::vector<std::vector<Size> > dependencies_;
+        std::vector<Real> buildTimes_;
+        bool dependenciesDetected_;
+    };
+
+}
+
+#endif
@@ -83,16 +83,20 @@ namespace QuantLib {
     void CdsHelper::setTermStructure(DefaultProbabilityTermStructure* ts) {
         RelativeDateDefaultProbabilityHelper::setTermStructure(ts);
 
+        // the swap and its engine are kept; they're rebuilt only when
+        // the dates change, so that repeated bootstraps don't register
+        // new observers with the discount curve (which might be shared
+        // with curves being bootstrapped concurrently)
         probability_.linkTo(
             boost::shared_ptr<DefaultProbabilityTermStructure>(ts, null_deleter()),
             false);
-
-        resetEngine();
     }
 
     void CdsHelper::update() {
+        Date previousDate = evaluationDate_;
         RelativeDateDefaultProbabilityHelper::update();
-        resetEngine();
+        if (evaluationDate_ != previousDate)
+            resetEngine();
     }
 
     void CdsHelper::initializeDates() {
@@ -150,7 +154,9 @@ namespace QuantLib {
     : CdsHelper(runningSpread, tenor, settlementDays, calendar,
                 frequency, paymentConvention, rule, dayCounter,
                 recoveryRate, discountCurve, settlesAccrual, paysAtDefaultTime,
-                startDate, lastPeriodDayCounter, rebatesAccrual, model) {}
+                startDate, lastPeriodDayCounter, rebatesAccrual, model) {
+        resetEngine();
+    }
 
     SpreadCdsHelper::SpreadCdsHelper(
                               Rate runningSpread,
@@ -172,7 +178,9 @@ namespace QuantLib {
     : CdsHelper(runningSpread, tenor, settlementDays, calendar,
                 frequency, paymentConvention, rule, dayCounter,
                 recoveryRate, discountCurve, settlesAccrual, paysAtDefaultTime,
-                startDate, lastPeriodDayCounter,rebatesAccrual, model) {}
+                startDate, lastPeriodDayCounter,rebatesAccrual, model) {
+        resetEngine();
+    }
 
     Real SpreadCdsHelper::impliedQuote() const {
         swap_->recalculate();
@@ -227,6 +235,7 @@ namespace QuantLib {
       upfrontSettlementDays_(upfrontSettlementDays),
       runningSpread_(runningSpread) {
         initializeDates();
+        resetEngine();
     }
 
     UpfrontCdsHelper::UpfrontCdsHelper(
@@ -255,6 +264,7 @@ namespace QuantLib {
       upfrontSettlementDays_(upfrontSettlementDays),
       runningSpread_(runningSpread) {
         initializeDates();
+        resetEngine();
     }
 
     void UpfrontCdsHelper::initializeDates() {
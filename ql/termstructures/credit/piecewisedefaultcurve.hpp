@@ -28,12 +28,15 @@
 #define quantlib_piecewise_default_curve_hpp
 
 #include <ql/termstructures/iterativebootstrap.hpp>
+#include <ql/termstructures/globalbootstrap.hpp>
 #include <ql/termstructures/credit/probabilitytraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/quote.hpp>
 
 namespace QuantLib {
 
+    class MarketSnapshot;
+
     //! Piecewise default-probability term structure
     /*! This term structure is bootstrapped on a number of credit
         instruments which are passed as a vector of handles to
@@ -148,6 +151,14 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Inspectors
+        //@{
+        //! bootstrap helpers (sorted by pillar once bootstrapped)
+        const std::vector<boost::shared_ptr<typename Traits::helper> >&
+        instruments() const {
+            return instruments_;
+        }
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -171,6 +182,7 @@ namespace QuantLib {
         // already.
         friend class Bootstrap<this_curve>;
         friend class BootstrapError<this_curve>;
+        friend class MarketSnapshot;
         Bootstrap<this_curve> bootstrap_;
     };
 
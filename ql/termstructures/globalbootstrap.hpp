@@ -0,0 +1,254 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file globalbootstrap.hpp
+    \brief simultaneous bootstrap of all curve pillars
+*/
+
+#ifndef quantlib_global_bootstrap_hpp
+#define quantlib_global_bootstrap_hpp
+
+#include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/math/optimization/costfunction.hpp>
+#include <ql/math/optimization/constraint.hpp>
+#include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/math/optimization/problem.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        // quote errors of all helpers as a function of the curve nodes
+        template <class Curve>
+        class GlobalBootstrapErrors : public CostFunction {
+            typedef typename Curve::traits_type Traits;
+            typedef typename Traits::helper helper;
+          public:
+            GlobalBootstrapErrors(
+                       std::vector<Real>& data,
+                       Interpolation& interpolation,
+                       const std::vector<boost::shared_ptr<helper> >& helpers)
+            : data_(data), interpolation_(interpolation), helpers_(helpers) {}
+            Real value(const Array& x) const {
+                Array errors = values(x);
+                return std::sqrt(DotProduct(errors, errors));
+            }
+            Disposable<Array> values(const Array& x) const {
+                for (Size i=0; i<x.size(); ++i)
+                    Traits::updateGuess(data_, x[i], i+1);
+                interpolation_.update();
+                Array errors(x.size());
+                for (Size i=0; i<x.size(); ++i)
+                    errors[i] = helpers_[i]->quoteError();
+                return errors;
+            }
+          private:
+            std::vector<Real>& data_;
+            Interpolation& interpolation_;
+            const std::vector<boost::shared_ptr<helper> >& helpers_;
+        };
+
+    }
+
+    //! Simultaneous bootstrapper for most curve types
+    /*! The pillars of the curve are determined at once by solving the
+        system formed by the quote errors of all the helpers with the
+        Levenberg-Marquardt algorithm.
+
+        Unlike IterativeBootstrap, which repeats its pillar-by-pillar
+        root search until the nodes stop changing, this class doesn't
+        rely on the locality of the interpolation; it is therefore
+        suited to non-local interpolations such as Cubic or
+        ConvexMonotone, for which the iterative bootstrap might need a
+        large number of sweeps.  Local interpolations are better
+        served by IterativeBootstrap.
+
+        When the curve is recalculated with the same pillars, its
+        current nodes are used as a starting point.  As in
+        IterativeBootstrap, helpers whose pillar is not after the
+        initial date of the curve are expired and are skipped.
+
+        \warning The Jacobian of the system is estimated by forward
+                 differences, i.e., by repricing all the helpers once
+                 for each pillar at each iteration.
+    */
+    template <class Curve>
+    class GlobalBootstrap {
+        typedef typename Curve::traits_type Traits;
+        typedef typename Curve::interpolator_type Interpolator;
+      public:
+        /*! \param accuracy  required accuracy on the quote errors of
+                             the helpers; if not given, the accuracy of
+                             the curve is used.
+        */
+        explicit GlobalBootstrap(Real accuracy = Null<Real>());
+        void setup(Curve* ts);
+        void calculate() const;
+      private:
+        Curve* ts_;
+        Real accuracy_;
+        mutable bool validCurve_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    GlobalBootstrap<Curve>::GlobalBootstrap(Real accuracy)
+    : ts_(0), accuracy_(accuracy), validCurve_(false) {}
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setup(Curve* ts) {
+        ts_ = ts;
+
+        Size n = ts_->instruments_.size();
+        QL_REQUIRE(n+1 >= Interpolator::requiredPoints,
+                   "not enough instruments: " << n << " provided, " <<
+                   Interpolator::requiredPoints-1 << " required");
+
+        for (Size i=0; i<n; ++i)
+            ts_->registerWith(ts_->instruments_[i]);
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::calculate() const {
+
+        // ensure helpers are sorted
+        std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
+                  detail::BootstrapHelperSorter());
+
+        // skip expired helpers
+        Date firstDate = Traits::initialDate(ts_);
+        QL_REQUIRE(ts_->instruments_.back()->pillarDate() > firstDate,
+                   "all instruments expired");
+        Size firstAliveHelper = 0;
+        while (ts_->instruments_[firstAliveHelper]->pillarDate() <= firstDate)
+            ++firstAliveHelper;
+        const std::vector<boost::shared_ptr<typename Traits::helper> >
+            helpers(ts_->instruments_.begin()+firstAliveHelper,
+                    ts_->instruments_.end());
+        Size n = helpers.size();
+        QL_REQUIRE(n+1 >= Interpolator::requiredPoints,
+                   "not enough alive instruments: " << n << " provided, " <<
+                   Interpolator::requiredPoints-1 << " required");
+
+        // setup helpers
+        for (Size i=0; i<n; ++i) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                                                  helpers[i];
+            QL_REQUIRE(helper->quote()->isValid(),
+                       io::ordinal(firstAliveHelper+i+1) <<
+                       " instrument (maturity: " <<
+                       helper->maturityDate() << ", pillar: " <<
+                       helper->pillarDate() << ") has an invalid quote");
+            // don't try this at home!
+            // This call creates helpers, and removes "const".
+            // There is a significant interaction with observability.
+            helper->setTermStructure(const_cast<Curve*>(ts_));
+        }
+
+        // calculate dates and times
+        std::vector<Date> dates(n+1);
+        std::vector<Time> times(n+1);
+        dates[0] = firstDate;
+        times[0] = ts_->timeFromReference(firstDate);
+        Date maxDate = firstDate;
+        for (Size i=1; i<=n; ++i) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                                                helpers[i-1];
+            dates[i] = helper->pillarDate();
+            times[i] = ts_->timeFromReference(dates[i]);
+            QL_REQUIRE(dates[i-1] < dates[i],
+                       io::ordinal(firstAliveHelper+i) <<
+                       " instrument (pillar: " << dates[i] <<
+                       ") is not after the previous pillar ("
+                       << dates[i-1] << ")");
+            maxDate = std::max(maxDate, helper->latestRelevantDate());
+        }
+
+        // the current nodes are a good starting point if the pillars
+        // didn't move; otherwise, extrapolate from the previous pillars
+        bool validData = validCurve_ && ts_->data_.size() == n+1
+                      && ts_->dates_ == dates;
+        validCurve_ = false;
+        ts_->dates_ = dates;
+        ts_->times_ = times;
+        ts_->maxDate_ = maxDate;
+        if (!validData) {
+            ts_->data_ = std::vector<Real>(n+1, Traits::initialValue(ts_));
+            for (Size i=1; i<=n; ++i) {
+                // the guess extrapolates the curve on the previous
+                // pillars; as in the iterative bootstrap, fall back to
+                // Linear while there are too few of them
+                if (i > 1) {
+                    try {
+                        ts_->interpolation_ = ts_->interpolator_.interpolate(
+                            ts_->times_.begin(), ts_->times_.begin()+i,
+                            ts_->data_.begin());
+                    } catch (...) {
+                        ts_->interpolation_ = Linear().interpolate(
+                            ts_->times_.begin(), ts_->times_.begin()+i,
+                            ts_->data_.begin());
+                    }
+                    ts_->interpolation_.update();
+                }
+                Traits::updateGuess(ts_->data_,
+                                    Traits::guess(i, ts_, false,
+                                                  firstAliveHelper), i);
+            }
+        }
+
+        ts_->interpolation_ =
+            ts_->interpolator_.interpolate(ts_->times_.begin(),
+                                           ts_->times_.end(),
+                                           ts_->data_.begin());
+
+        Array guess(n);
+        for (Size i=0; i<n; ++i)
+            guess[i] = ts_->data_[i+1];
+
+        Real accuracy = accuracy_ != Null<Real>() ? accuracy_ : ts_->accuracy_;
+        detail::GlobalBootstrapErrors<Curve> errors(ts_->data_,
+                                                ts_->interpolation_,
+                                                helpers);
+        NoConstraint noConstraint;
+        Problem problem(errors, noConstraint, guess);
+        LevenbergMarquardt solver(ts_->accuracy_,
+                                  ts_->accuracy_,
+                                  ts_->accuracy_);
+        EndCriteria endCriteria(100*(n+1), 10, 0.0, accuracy*accuracy, 0.0);
+        solver.minimize(problem, endCriteria);
+
+        // leave the curve on the solution and check it
+        Array finalErrors = errors.values(problem.currentValue());
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(std::fabs(finalErrors[i]) <= accuracy,
+                       "global bootstrap failed to reprice the " <<
+                       io::ordinal(firstAliveHelper+i+1) <<
+                       " instrument (pillar: " <<
+                       dates[i+1] << "): quote error " << finalErrors[i] <<
+                       ", required accuracy " << accuracy);
+        validCurve_ = true;
+    }
+
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include <ql/termstructures/inflation/inflationhelpers.hpp>
 #include <ql/indexes/inflationindex.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/cashflows/indexedcashflow.hpp>
 
 #include <ql/utilities/null_deleter.hpp>
 
@@ -76,8 +77,11 @@ namespace QuantLib {
         // what does the term structure imply?
         // in this case just the same value ... trivial case
         // (would not be so for an inflation-linked bond)
-        zciis_->recalculate();
-        return zciis_->fairRate();
+        // This is the fair rate of the swap, as returned by
+        // zciis_->fairRate(), without pricing the swap.
+        Real growth = bootstrapIndex_->fixing(obsDate_) /
+                      bootstrapIndex_->fixing(baseDate_);
+        return std::pow(growth, 1.0/yearFraction_) - 1.0;
     }
 
     void ZeroCouponInflationSwapHelper::setTermStructure(
@@ -108,6 +112,19 @@ namespace QuantLib {
         // standard discounting swap engine.
         zciis_->setPricingEngine(boost::shared_ptr<PricingEngine>(
                 new DiscountingSwapEngine(z->nominalTermStructure())));
+
+        // the dates and year fraction used by the fair rate
+        boost::shared_ptr<IndexedCashFlow> icf =
+            boost::dynamic_pointer_cast<IndexedCashFlow>(
+                                             zciis_->inflationLeg().at(0));
+        QL_REQUIRE(icf, "failed to downcast to IndexedCashFlow");
+        bootstrapIndex_ = new_zii;
+        baseDate_ = icf->baseDate();
+        obsDate_ = icf->fixingDate();
+        yearFraction_ = inflationYearFraction(zii_->frequency(),
+                                              zii_->interpolated(),
+                                              dayCounter_,
+                                              baseDate_, obsDate_);
     }
 
 
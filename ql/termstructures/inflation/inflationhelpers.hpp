@@ -33,6 +33,12 @@
 namespace QuantLib {
 
     //! Zero-coupon inflation-swap bootstrap helper
+    /*! The swap is built when the term structure is set; during the
+        bootstrap, its fair rate is obtained directly from the index
+        fixings at its base and observation dates, which are stored
+        together with the corresponding year fraction, instead of
+        pricing the swap at each iteration.
+    */
     class ZeroCouponInflationSwapHelper
     : public BootstrapHelper<ZeroInflationTermStructure> {
     public:
@@ -55,6 +61,11 @@ namespace QuantLib {
         DayCounter dayCounter_;
         boost::shared_ptr<ZeroInflationIndex> zii_;
         boost::shared_ptr<ZeroCouponInflationSwap> zciis_;
+      private:
+        // index linked to the bootstrapped curve and swap data
+        boost::shared_ptr<ZeroInflationIndex> bootstrapIndex_;
+        Date baseDate_, obsDate_;
+        Time yearFraction_;
     };
 
 
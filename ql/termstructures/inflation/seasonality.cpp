@@ -23,9 +23,20 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/termstructures/inflation/seasonality.hpp>
 #include <ql/termstructures/inflationtermstructure.hpp>
 #include <ql/errors.hpp>
+#include <map>
 
 namespace QuantLib {
 
+    void Seasonality::correctZeroRates(const std::vector<Date>& dates,
+                                       std::vector<Rate>& rates,
+                                       const InflationTermStructure& iTS) const {
+        QL_REQUIRE(dates.size() == rates.size(),
+                   "size mismatch between dates (" << dates.size()
+                   << ") and rates (" << rates.size() << ")");
+        for (Size i=0; i<dates.size(); ++i)
+            rates[i] = correctZeroRate(dates[i], rates[i], iTS);
+    }
+
     bool Seasonality::isConsistent(const InflationTermStructure&) const {
         return true;
     }
@@ -130,6 +141,37 @@ namespace QuantLib {
     }
 
 
+    void MultiplicativePriceSeasonality::correctZeroRates(
+                                    const std::vector<Date>& dates,
+                                    std::vector<Rate>& rates,
+                                    const InflationTermStructure& iTS) const {
+        QL_REQUIRE(dates.size() == rates.size(),
+                   "size mismatch between dates (" << dates.size()
+                   << ") and rates (" << rates.size() << ")");
+        std::pair<Date,Date> lim = inflationPeriod(iTS.baseDate(), iTS.frequency());
+        Date curveBaseDate = lim.second;
+        DayCounter dc = iTS.dayCounter();
+        Real factorBase = this->seasonalityFactor(curveBaseDate);
+
+        // the factors are constant over each seasonality period, so
+        // they're only calculated once for each of them
+        bool byPeriod = (Period(frequency()).units() == Months);
+        std::map<Date,Real> factors;
+        for (Size i=0; i<dates.size(); ++i) {
+            Date key = byPeriod ?
+                inflationPeriod(dates[i], frequency()).first : dates[i];
+            std::map<Date,Real>::const_iterator f = factors.find(key);
+            if (f == factors.end())
+                f = factors.insert(std::make_pair(
+                         key, this->seasonalityFactor(dates[i]))).first;
+            Real seasonalityAt = f->second / factorBase;
+            Time timeFromCurveBase = dc.yearFraction(curveBaseDate, dates[i]);
+            rates[i] = (rates[i] + 1)*std::pow(seasonalityAt,
+                                               1/timeFromCurveBase) - 1;
+        }
+    }
+
+
     Rate MultiplicativePriceSeasonality::correctYoYRate(const Date &d,
                                                         const Rate r,
                                                         const InflationTermStructure& iTS) const {
@@ -250,6 +292,15 @@ namespace QuantLib {
         return seasonalCorrection;
     }
 
+    void KerkhofSeasonality::correctZeroRates(
+                                    const std::vector<Date>& dates,
+                                    std::vector<Rate>& rates,
+                                    const InflationTermStructure& iTS) const {
+        // the correction is not the multiplicative one; go through
+        // seasonalityCorrection for each date
+        Seasonality::correctZeroRates(dates, rates, iTS);
+    }
+
     Rate KerkhofSeasonality::seasonalityCorrection(Rate rate,
                                                    const Date& atDate,
                                                    const DayCounter& dc,
@@ -62,6 +62,14 @@ namespace QuantLib {
                                      const InflationTermStructure& iTS) const = 0;
         virtual Rate correctYoYRate(const Date &d, const Rate r,
                                     const InflationTermStructure& iTS) const = 0;
+        /*! Corrects the zero rates at the given dates in place.  The
+            default implementation calls correctZeroRate for each
+            date; derived classes can override it to share the work
+            between dates.
+        */
+        virtual void correctZeroRates(const std::vector<Date>& dates,
+                                      std::vector<Rate>& rates,
+                                      const InflationTermStructure& iTS) const;
         /*! It is possible for multi-year seasonalities to be
             inconsistent with the inflation term structure they are
             given to.  This method enables testing - but programmers
@@ -153,6 +161,12 @@ namespace QuantLib {
                                          const InflationTermStructure& iTS) const;
             virtual Rate correctYoYRate(const Date &d, const Rate r,
                                         const InflationTermStructure& iTS) const;
+            /*! The normalization factor is calculated once, and the
+                seasonality factor once for each seasonality period.
+            */
+            virtual void correctZeroRates(const std::vector<Date>& dates,
+                                          std::vector<Rate>& rates,
+                                          const InflationTermStructure& iTS) const;
             virtual bool isConsistent(const InflationTermStructure& iTS) const;
             //@}
 
@@ -175,6 +189,9 @@ namespace QuantLib {
 
         /*Rate correctZeroRate(const Date &d, const Rate r,
                                const InflationTermStructure& iTS) const;*/
+        void correctZeroRates(const std::vector<Date>& dates,
+                              std::vector<Rate>& rates,
+                              const InflationTermStructure& iTS) const;
         Real seasonalityFactor(const Date &to) const;
       protected:
         virtual Rate seasonalityCorrection(Rate rate,
@@ -155,7 +155,48 @@ namespace QuantLib {
             useLag = observationLag();
         }
 
-        Rate zeroRate;
+        Rate zeroRate = unseasonedZeroRate(d, useLag,
+                                           forceLinearInterpolation,
+                                           extrapolate);
+
+        if (hasSeasonality()) {
+            zeroRate = seasonality()->correctZeroRate(d-useLag, zeroRate, *this);
+        }
+        return zeroRate;
+    }
+
+    std::vector<Rate> ZeroInflationTermStructure::zeroRates(
+                                        const std::vector<Date>& dates,
+                                        const Period& instObsLag,
+                                        bool forceLinearInterpolation,
+                                        bool extrapolate) const {
+
+        Period useLag = instObsLag;
+        if (instObsLag == Period(-1,Days)) {
+            useLag = observationLag();
+        }
+
+        std::vector<Rate> zeroRates(dates.size());
+        for (Size i=0; i<dates.size(); ++i)
+            zeroRates[i] = unseasonedZeroRate(dates[i], useLag,
+                                              forceLinearInterpolation,
+                                              extrapolate);
+
+        if (hasSeasonality()) {
+            std::vector<Date> observationDates(dates.size());
+            for (Size i=0; i<dates.size(); ++i)
+                observationDates[i] = dates[i]-useLag;
+            seasonality()->correctZeroRates(observationDates, zeroRates,
+                                            *this);
+        }
+        return zeroRates;
+    }
+
+    Rate ZeroInflationTermStructure::unseasonedZeroRate(
+                                        const Date& d,
+                                        const Period& useLag,
+                                        bool forceLinearInterpolation,
+                                        bool extrapolate) const {
         if (forceLinearInterpolation) {
             std::pair<Date,Date> dd = inflationPeriod(d-useLag, frequency());
             dd.second = dd.second + Period(1,Days);
@@ -168,24 +209,19 @@ namespace QuantLib {
             Time t2 = timeFromReference(dd.second);
             Rate z1 = zeroRateImpl(t1);
             Rate z2 = zeroRateImpl(t2);
-            zeroRate = z1 + (z2-z1) * (dt/dp);
+            return z1 + (z2-z1) * (dt/dp);
         } else {
             if (indexIsInterpolated()) {
                 InflationTermStructure::checkRange(d-useLag, extrapolate);
                 Time t = timeFromReference(d-useLag);
-                zeroRate = zeroRateImpl(t);
+                return zeroRateImpl(t);
             } else {
                 std::pair<Date,Date> dd = inflationPeriod(d-useLag, frequency());
                 InflationTermStructure::checkRange(dd.first, extrapolate);
                 Time t = timeFromReference(dd.first);
-                zeroRate = zeroRateImpl(t);
+                return zeroRateImpl(t);
             }
         }
-
-        if (hasSeasonality()) {
-            zeroRate = seasonality()->correctZeroRate(d-useLag, zeroRate, *this);
-        }
-        return zeroRate;
     }
 
     Rate ZeroInflationTermStructure::zeroRate(Time t,
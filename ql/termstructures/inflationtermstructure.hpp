@@ -172,6 +172,15 @@ namespace QuantLib {
         Rate zeroRate(const Date &d, const Period& instObsLag = Period(-1,Days),
                       bool forceLinearInterpolation = false,
                       bool extrapolate = false) const;
+        //! zero-coupon inflation rates at the given dates.
+        /*! The results are the same as those of zeroRate(d, ...)
+            for each date, but the seasonality correction is applied
+            to all the dates at once.
+        */
+        std::vector<Rate> zeroRates(const std::vector<Date>& dates,
+                                    const Period& instObsLag = Period(-1,Days),
+                                    bool forceLinearInterpolation = false,
+                                    bool extrapolate = false) const;
         //! zero-coupon inflation rate.
         /*! \warning Since inflation is highly linked to dates (lags,
                      interpolation, months for seasonality, etc) this
@@ -185,6 +194,11 @@ namespace QuantLib {
       protected:
         //! to be defined in derived classes
         virtual Rate zeroRateImpl(Time t) const = 0;
+      private:
+        // zero rate without seasonality correction
+        Rate unseasonedZeroRate(const Date& d, const Period& useLag,
+                                bool forceLinearInterpolation,
+                                bool extrapolate) const;
     };
 
 
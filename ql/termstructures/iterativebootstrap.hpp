@@ -30,13 +30,24 @@
 #include <ql/termstructures/bootstraphelper.hpp>
 #include <ql/termstructures/bootstraperror.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/utilities/null_deleter.hpp>
+#include <ql/utilities/instrumentation.hpp>
 
 namespace QuantLib {
 
     //! Universal piecewise-term-structure boostrapper.
+    /*! When the interpolation is local and each pillar coincides
+        with the latest relevant date of its helper, the pillars
+        before a given helper don't depend on its quote.  In this
+        case, the bootstrapper keeps track of the helpers that sent
+        a notification since the last calculation and restarts from
+        the first pillar they affect, using the previous values of
+        the following pillars as guesses.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
@@ -45,8 +56,56 @@ namespace QuantLib {
         IterativeBootstrap();
         void setup(Curve* ts);
         void calculate() const;
+        //! sensitivities of the pillar values to the helper quotes
+        /*! The returned matrix has elements
+            \f$ \partial z_i / \partial q_j \f$, where the
+            \f$ z_i \f$ are the values at the pillars of the curve
+            and the \f$ q_j \f$ are the quotes of the alive helpers,
+            both in increasing pillar order.
+
+            Since the bootstrapped curve satisfies
+            \f$ R(z) = q \f$, where \f$ R \f$ gives the quotes
+            implied by the helpers, the matrix is calculated as the
+            inverse of the Jacobian of \f$ R \f$ (implicit function
+            theorem).  The latter is obtained by central differences
+            on the pillar values without bootstrapping the curve
+            again; when the convergence loop is not required, it is
+            lower triangular and is inverted by forward substitution.
+        */
+        Matrix pillarSensitivities() const;
       private:
         void initialize() const;
+        Size firstChangedPillar() const;
+        void watchOtherObservables() const;
+        // records the notifications sent by a helper
+        class HelperObserver : public Observer {
+          public:
+            explicit HelperObserver(
+                     const boost::shared_ptr<typename Traits::helper>& h)
+            : helper_(h), changed_(true) {
+                registerWith(helper_);
+            }
+            void update() { changed_ = true; }
+            const boost::shared_ptr<typename Traits::helper>& helper() const {
+                return helper_;
+            }
+            bool changed() const { return changed_; }
+            void reset() { changed_ = false; }
+          private:
+            boost::shared_ptr<typename Traits::helper> helper_;
+            bool changed_;
+        };
+        // records the notifications sent by the other observables
+        // of the curve (e.g., jumps or the evaluation date)
+        class OtherObserver : public Observer {
+          public:
+            OtherObserver() : changed_(true) {}
+            void update() { changed_ = true; }
+            bool changed() const { return changed_; }
+            void reset() { changed_ = false; }
+          private:
+            bool changed_;
+        };
         Curve* ts_;
         Size n_;
         Brent firstSolver_;
@@ -55,6 +114,10 @@ namespace QuantLib {
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
         mutable std::vector<boost::shared_ptr<BootstrapError<Curve> > > errors_;
+        std::vector<boost::shared_ptr<HelperObserver> > helperObservers_;
+        boost::shared_ptr<OtherObserver> otherObserver_;
+        // pillar dates of the last successful bootstrap
+        mutable std::vector<Date> bootstrappedDates_;
     };
 
 
@@ -71,8 +134,13 @@ namespace QuantLib {
         ts_ = ts;
         n_ = ts_->instruments_.size();
         QL_REQUIRE(n_ > 0, "no bootstrap helpers given")
-        for (Size j=0; j<n_; ++j)
+        helperObservers_.resize(n_);
+        for (Size j=0; j<n_; ++j) {
             ts_->registerWith(ts_->instruments_[j]);
+            helperObservers_[j] = boost::shared_ptr<HelperObserver>(
+                               new HelperObserver(ts_->instruments_[j]));
+        }
+        otherObserver_ = boost::shared_ptr<OtherObserver>(new OtherObserver);
 
         // do not initialize yet: instruments could be invalid here
         // but valid later when bootstrapping is actually required
@@ -149,6 +217,43 @@ namespace QuantLib {
         initialized_ = true;
     }
 
+    template <class Curve>
+    Size IterativeBootstrap<Curve>::firstChangedPillar() const {
+        // a full bootstrap is needed if the pillars moved, if the
+        // last one failed, or if the curve was notified by something
+        // other than its helpers (e.g., jumps)
+        if (loopRequired_ || !validCurve_ || otherObserver_->changed()
+            || bootstrappedDates_ != ts_->dates_)
+            return 1;
+
+        Date firstChange = Date::maxDate();
+        for (Size j=0; j<n_; ++j) {
+            if (helperObservers_[j]->changed())
+                firstChange = std::min(firstChange,
+                                   helperObservers_[j]->helper()->pillarDate());
+        }
+        if (firstChange == Date::maxDate())
+            return 1;
+
+        const std::vector<Date>& dates = ts_->dates_;
+        Size i = 1;
+        while (i < alive_ && dates[i] < firstChange)
+            ++i;
+        return i;
+    }
+
+    template <class Curve>
+    void IterativeBootstrap<Curve>::watchOtherObservables() const {
+        // the curve might have registered with further observables
+        // since the last calculation, so the registrations are renewed
+        otherObserver_->unregisterWithAll();
+        otherObserver_->registerWithObservables(
+                         boost::shared_ptr<Observer>(ts_, null_deleter()));
+        for (Size j=0; j<n_; ++j)
+            otherObserver_->unregisterWith(ts_->instruments_[j]);
+        otherObserver_->reset();
+    }
+
     template <class Curve>
     void IterativeBootstrap<Curve>::calculate() const {
 
@@ -160,6 +265,9 @@ namespace QuantLib {
         if (!initialized_ || ts_->moving_)
             initialize();
 
+        Size firstPillar = firstChangedPillar();
+        bootstrappedDates_.clear();
+
         // setup helpers
         for (Size j=firstAliveHelper_; j<n_; ++j) {
             const boost::shared_ptr<typename Traits::helper>& helper =
@@ -174,6 +282,10 @@ namespace QuantLib {
             // There is a significant interaction with observability.
             helper->setTermStructure(const_cast<Curve*>(ts_));
         }
+        // notifications from now on are caused by the bootstrap itself
+        for (Size j=0; j<n_; ++j)
+            helperObservers_[j]->reset();
+        watchOtherObservables();
 
         const std::vector<Time>& times = ts_->times_;
         const std::vector<Real>& data = ts_->data_;
@@ -185,9 +297,10 @@ namespace QuantLib {
         bool validData = validCurve_;
 
         for (Size iteration=0; ; ++iteration) {
+            QL_INSTRUMENT_OBJECT_SCOPE("IterativeBootstrap::iteration", ts_);
             previousData_ = ts_->data_;
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 // bracket root and calculate guess
                 Real min = Traits::minValueAfter(i, ts_, validData,
@@ -259,6 +372,58 @@ namespace QuantLib {
             validData = true;
         }
         validCurve_ = true;
+        bootstrappedDates_ = ts_->dates_;
+    }
+
+    template <class Curve>
+    Matrix IterativeBootstrap<Curve>::pillarSensitivities() const {
+        ts_->calculate();
+
+        // Jacobian of the implied quotes with respect to the pillars;
+        // when the bootstrap is local, the helpers before a pillar
+        // don't depend on it.
+        const Real h = 1.0e-5;
+        std::vector<Real>& data = ts_->data_;
+        Matrix jacobian(alive_, alive_, 0.0);
+        for (Size j=1; j<=alive_; ++j) {
+            const Size first = loopRequired_ ? 1 : j;
+            const Real z = data[j];
+            const Real z0 = data[0];
+
+            Traits::updateGuess(data, z+h, j);
+            ts_->interpolation_.update();
+            for (Size i=first; i<=alive_; ++i)
+                jacobian[i-1][j-1] = errors_[i]->helper()->impliedQuote();
+
+            Traits::updateGuess(data, z-h, j);
+            ts_->interpolation_.update();
+            for (Size i=first; i<=alive_; ++i)
+                jacobian[i-1][j-1] = (jacobian[i-1][j-1] -
+                              errors_[i]->helper()->impliedQuote()) / (2.0*h);
+
+            data[j] = z;
+            data[0] = z0;
+            ts_->interpolation_.update();
+        }
+
+        if (loopRequired_)
+            return inverse(jacobian);
+
+        // forward substitution, one column of the inverse at a time
+        Matrix result(alive_, alive_, 0.0);
+        for (Size k=0; k<alive_; ++k) {
+            for (Size i=k; i<alive_; ++i) {
+                Real sum = (i == k) ? 1.0 : 0.0;
+                for (Size j=k; j<i; ++j)
+                    sum -= jacobian[i][j]*result[j][k];
+                QL_REQUIRE(jacobian[i][i] != 0.0,
+                           io::ordinal(i+1) << " alive helper (pillar "
+                           << ts_->dates_[i+1] << ") doesn't depend "
+                           "on its pillar");
+                result[i][k] = sum/jacobian[i][i];
+            }
+        }
+        return result;
     }
 
 }
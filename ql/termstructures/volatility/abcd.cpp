@@ -25,6 +25,34 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // integrals of s^k e^{-lambda s} between 0 and u for
+        // k = 0, ..., n-1; the series expansion is used for small
+        // lambda*u, where the recursion would lose precision
+        void exponentialMoments(Real lambda, Time u, Size n, Real* I) {
+            Real x = lambda*u;
+            if (std::fabs(x) < 1.0) {
+                for (Size k=0; k<n; ++k) {
+                    Real term = 1.0, sum = 0.0;
+                    for (Size m=0; m<30; ++m) {
+                        sum += term/(k+m+1);
+                        term *= -x/(m+1);
+                    }
+                    I[k] = sum*std::pow(u, Real(k+1));
+                }
+            } else {
+                Real e = std::exp(-x), uk = 1.0;
+                I[0] = (1.0-e)/lambda;
+                for (Size k=1; k<n; ++k) {
+                    uk *= u;
+                    I[k] = (k*I[k-1] - uk*e)/lambda;
+                }
+            }
+        }
+
+    }
+
     AbcdFunction::AbcdFunction(Real a, Real b, Real c, Real d)
     : AbcdMathFunction(a, b, c, d) {}
 
@@ -43,6 +71,47 @@ namespace QuantLib {
         return (*this)(T-t) * (*this)(S-t);
     }
 
+    Disposable<Matrix> AbcdFunction::covariance(
+                            Time t1, Time t2, const std::vector<Time>& T) const {
+        QL_REQUIRE(t1<=t2,
+                   "integrations bounds (" << t1 <<
+                   "," << t2 << ") are in reverse order");
+        Size n = T.size();
+        Matrix result(n, n, 0.0);
+        if (close(c_,0.0)) {
+            for (Size i=0; i<n; ++i)
+                for (Size j=i; j<n; ++j)
+                    result[i][j] = result[j][i] =
+                        covariance(t1, t2, T[i], T[j]);
+            return result;
+        }
+
+        std::vector<Real> expT(n);
+        for (Size i=0; i<n; ++i)
+            expT[i] = std::exp(c_*T[i]);
+        Real exp1 = std::exp(c_*t1), exp2 = std::exp(c_*t2);
+        for (Size i=0; i<n; ++i) {
+            for (Size j=i; j<n; ++j) {
+                // same as covariance(t1, t2, T[i], T[j])
+                Size first = T[i]<=T[j] ? i : j;
+                Time cutOff = T[first];
+                if (t1<cutOff) {
+                    Real expCutOff = expT[first];
+                    if (t2<cutOff) {
+                        cutOff = t2;
+                        expCutOff = exp2;
+                    }
+                    result[i][j] = result[j][i] =
+                        primitive(cutOff, T[i], T[j],
+                                  expCutOff, expT[i], expT[j])
+                        - primitive(t1, T[i], T[j],
+                                    exp1, expT[i], expT[j]);
+                }
+            }
+        }
+        return result;
+    }
+
     Real AbcdFunction::covariance(Time t1, Time t2, Time T, Time S) const {
         QL_REQUIRE(t1<=t2,
                    "integrations bounds (" << t1 <<
@@ -77,8 +146,12 @@ namespace QuantLib {
             return t*(v*v+v*b_*S+v*b_*T-v*b_*t+b_*b_*S*T-0.5*b_*b_*t*(S+T)+b_*b_*t*t/3.0);
         }
 
-        Real k1=std::exp(c_*t), k2=std::exp(c_*S), k3=std::exp(c_*T);
+        return primitive(t, T, S,
+                         std::exp(c_*t), std::exp(c_*T), std::exp(c_*S));
+    }
 
+    Real AbcdFunction::primitive(Time t, Time T, Time S,
+                                 Real k1, Real k3, Real k2) const {
         return (b_*b_*(-1 - 2*c_*c_*S*T - c_*(S + T)
                      + k1*k1*(1 + c_*(S + T - 2*t) + 2*c_*c_*(S - t)*(T - t)))
                 + 2*c_*c_*(2*d_*a_*(k2 + k3)*(k1 - 1)
@@ -91,6 +164,38 @@ namespace QuantLib {
                 ) / (4*c_*c_*c_*k2*k3);
     }
 
+    Real abcdBlackVolatility(Time u, Real a, Real b, Real c, Real d,
+                             std::vector<Real>& derivatives) {
+        derivatives.resize(4);
+        if (u==0.0) {
+            Real sign = a+d >= 0.0 ? 1.0 : -1.0;
+            derivatives[0] = derivatives[3] = sign;
+            derivatives[1] = derivatives[2] = 0.0;
+            return std::fabs(a+d);
+        }
+
+        // the variance is the integral of
+        // f^2(s) = (a+bs)^2 e^{-2cs} + 2d(a+bs) e^{-cs} + d^2
+        // between 0 and u, and so are its derivatives
+        Real E[3], F[4];
+        exponentialMoments(c, u, 3, E);
+        exponentialMoments(2.0*c, u, 4, F);
+
+        Real variance = a*a*F[0] + 2.0*a*b*F[1] + b*b*F[2]
+                      + 2.0*d*(a*E[0] + b*E[1]) + d*d*u;
+        Real volatility = std::sqrt(variance/u);
+
+        Real dVariance[4];
+        dVariance[0] = 2.0*(a*F[0] + b*F[1] + d*E[0]);
+        dVariance[1] = 2.0*(a*F[1] + b*F[2] + d*E[1]);
+        dVariance[2] = -2.0*(a*a*F[1] + 2.0*a*b*F[2] + b*b*F[3])
+                       -2.0*d*(a*E[1] + b*E[2]);
+        dVariance[3] = 2.0*(a*E[0] + b*E[1] + d*u);
+        for (Size i=0; i<4; ++i)
+            derivatives[i] = dVariance[i]/(2.0*u*volatility);
+        return volatility;
+    }
+
 //===========================================================================//
 //                               AbcdSquared                                //
 //===========================================================================//
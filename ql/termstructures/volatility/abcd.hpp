@@ -25,6 +25,7 @@
 #include <ql/types.hpp>
 #include <ql/errors.hpp>
 #include <ql/math/abcdmathfunction.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
     
@@ -57,6 +58,15 @@ namespace QuantLib {
             \f[ \int_{t1}^{t2} f(T-t)f(S-t)dt \f] */
         Real covariance(Time t1, Time t2, Time T, Time S) const;
 
+        /*! integrals of the instantaneous covariance function between
+            time t1 and t2 for each pair of the given fixing times,
+            i.e., the symmetric matrix whose (i,j) element is
+            covariance(t1, t2, T[i], T[j]).  The exponentials are
+            calculated once per fixing time instead of once per pair.
+        */
+        Disposable<Matrix> covariance(Time t1, Time t2,
+                                      const std::vector<Time>& T) const;
+
          /*! average volatility in [tMin,tMax] of T-fixing rate:
             \f[ \sqrt{ \frac{\int_{tMin}^{tMax} f^2(T-u)du}{tMax-tMin} } \f] */
         Real volatility(Time tMin, Time tMax, Time T) const;
@@ -85,7 +95,12 @@ namespace QuantLib {
             time t between T-fixing and S-fixing rates
             \f[ \int f(T-t)f(S-t)dt \f] */
         Real primitive(Time t, Time T, Time S) const;
-        
+
+      private:
+        // primitive for non-null c, given the exponentials of c*t,
+        // c*T and c*S
+        Real primitive(Time t, Time T, Time S,
+                       Real expt, Real expT, Real expS) const;
     };
 
     
@@ -105,6 +120,13 @@ namespace QuantLib {
         AbcdFunction model(a,b,c,d);
         return model.volatility(0.,u,u);
     }
+
+    /*! Black volatility as above, together with its derivatives with
+        respect to a, b, c and d (in this order) which are calculated
+        analytically and stored in the given vector.
+    */
+    Real abcdBlackVolatility(Time u, Real a, Real b, Real c, Real d,
+                             std::vector<Real>& derivatives);
 }
 
 #endif
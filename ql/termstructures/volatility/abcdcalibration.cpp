@@ -50,6 +50,24 @@ namespace QuantLib {
         return y_;
     }
 
+    void AbcdCalibration::AbcdError::jacobian(Matrix& jac,
+                                              const Array& x) const {
+        const Array y = abcd_->transformation_->direct(x);
+        abcd_->a_ = y[0];
+        abcd_->b_ = y[1];
+        abcd_->c_ = y[2];
+        abcd_->d_ = y[3];
+        Matrix errorsJacobian = abcd_->errorsJacobian();
+        // chain rule with the derivatives of
+        // AbcdParametersTransformation::direct
+        for (Size i=0; i<errorsJacobian.rows(); ++i) {
+            jac[i][0] = errorsJacobian[i][0] * (y[0] + y[3]);
+            jac[i][1] = errorsJacobian[i][1];
+            jac[i][2] = errorsJacobian[i][2] * y[2];
+            jac[i][3] = (errorsJacobian[i][3] - errorsJacobian[i][0]) * y[3];
+        }
+    }
+
     // to constrained <- from unconstrained
 
     AbcdCalibration::AbcdCalibration(
@@ -79,7 +97,8 @@ namespace QuantLib {
             Real epsfcn = 1.0e-8;
             Real xtol = 1.0e-8;
             Real gtol = 1.0e-8;
-            bool useCostFunctionsJacobian = false;
+            // the jacobian of the errors is calculated analytically
+            bool useCostFunctionsJacobian = true;
             optMethod_ = boost::shared_ptr<OptimizationMethod>(new
                 LevenbergMarquardt(epsfcn, xtol, gtol, useCostFunctionsJacobian));
         }
@@ -202,6 +221,18 @@ namespace QuantLib {
         return results;
     }
 
+    Disposable<Matrix> AbcdCalibration::errorsJacobian() const {
+        Matrix results(times_.size(), 4);
+        std::vector<Real> derivatives(4);
+        for (Size i=0; i<times_.size() ; i++) {
+            abcdBlackVolatility(times_[i], a_, b_, c_, d_, derivatives);
+            Real w = std::sqrt(weights_[i]);
+            for (Size j=0; j<4; ++j)
+                results[i][j] = derivatives[j] * w;
+        }
+        return results;
+    }
+
     EndCriteria::Type AbcdCalibration::endCriteria() const{
         return abcdEndCriteria_;
     }
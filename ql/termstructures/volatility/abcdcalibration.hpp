@@ -27,6 +27,7 @@
 #include <ql/math/optimization/endcriteria.hpp>
 #include <ql/math/optimization/projectedcostfunction.hpp>
 #include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
 
 #include <boost/shared_ptr.hpp>
 
@@ -61,6 +62,7 @@ namespace QuantLib {
                 abcd_->d_ = y[3];
                 return abcd_->errors();
             }
+            void jacobian(Matrix& jac, const Array& x) const;
           private:
             AbcdCalibration* abcd_;
         };
@@ -103,6 +105,8 @@ namespace QuantLib {
         Real error() const;
         Real maxError() const;
         Disposable<Array> errors() const;
+        //! derivatives of the weighted errors with respect to a, b, c, d
+        Disposable<Matrix> errorsJacobian() const;
         EndCriteria::Type endCriteria() const;
         Real a() const { return a_; }
         Real b() const { return b_; }
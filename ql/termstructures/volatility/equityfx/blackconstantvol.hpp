@@ -31,6 +31,8 @@
 
 namespace QuantLib {
 
+    class MarketCloner;
+
     //! Constant Black volatility, no time-strike dependence
     /*! This class implements the BlackVolatilityTermStructure
         interface for a constant Black volatility (no time/strike
@@ -68,6 +70,7 @@ namespace QuantLib {
         virtual void accept(AcyclicVisitor&);
         //@}
       protected:
+        friend class MarketCloner;
         virtual Volatility blackVolImpl(Time t, Real) const;
       private:
         Handle<Quote> volatility_;
@@ -64,6 +64,24 @@ namespace QuantLib {
         setInterpolation<Bilinear>();
     }
 
+    Disposable<Array> BlackVarianceSurface::blackVariances(
+                                                   const Array& times,
+                                                   const Array& strikes,
+                                                   bool extrapolate) const {
+        QL_REQUIRE(times.size() == strikes.size(),
+                   "mismatch between times (" << times.size()
+                   << ") and strikes (" << strikes.size() << ")");
+        Array result(times.size());
+        for (Size i=0; i<times.size(); ++i) {
+            checkRange(times[i], extrapolate);
+            checkStrike(strikes[i], extrapolate);
+            // no virtual dispatch here
+            result[i] = BlackVarianceSurface::blackVarianceImpl(times[i],
+                                                                strikes[i]);
+        }
+        return result;
+    }
+
     Real BlackVarianceSurface::blackVarianceImpl(Time t, Real strike) const {
 
         if (t==0.0) return 0.0;
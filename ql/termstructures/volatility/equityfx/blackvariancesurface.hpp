@@ -27,6 +27,7 @@
 
 #include <ql/termstructures/volatility/equityfx/blackvoltermstructure.hpp>
 #include <ql/math/matrix.hpp>
+#include <ql/math/array.hpp>
 #include <ql/math/interpolations/interpolation2d.hpp>
 #include <ql/time/daycounters/actual365fixed.hpp>
 
@@ -74,6 +75,13 @@ namespace QuantLib {
             return strikes_.back();
         }
         //@}
+        //! \name Bulk queries
+        //@{
+        //! variances at the given (time, strike) pairs
+        Disposable<Array> blackVariances(const Array& times,
+                                         const Array& strikes,
+                                         bool extrapolate = false) const;
+        //@}
         //! \name Modifiers
         //@{
         template <class Interpolator>
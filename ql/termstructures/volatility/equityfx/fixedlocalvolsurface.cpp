@@ -151,12 +151,27 @@ namespace QuantLib {
         return strikes_.back()->back();
     }
 
+    Size FixedLocalVolSurface::timeIndex(Time t) const {
+        return std::distance(times_.begin(),
+            std::lower_bound(times_.begin(), times_.end(), t));
+    }
+
     Volatility FixedLocalVolSurface::localVolImpl(Time t, Real strike) const {
         t = std::min(times_.back(), std::max(t, times_.front()));
+        return localVolImpl(t, timeIndex(t), strike);
+    }
 
-        const Size idx = std::distance(times_.begin(),
-            std::lower_bound(times_.begin(), times_.end(), t));
+    void FixedLocalVolSurface::localVolsImpl(Time t,
+                                             const Array& strikes,
+                                             Array& vols) const {
+        t = std::min(times_.back(), std::max(t, times_.front()));
+        const Size idx = timeIndex(t);
+        for (Size i=0; i < strikes.size(); ++i)
+            vols[i] = localVolImpl(t, idx, strikes[i]);
+    }
 
+    Volatility FixedLocalVolSurface::localVolImpl(
+                                    Time t, Size idx, Real strike) const {
         if (close_enough(t, times_[idx])) {
             if (strikes_[idx]->front() < strikes_[idx]->back())
                 return localVolInterpol_[idx](strike, true);
@@ -82,8 +82,28 @@ namespace QuantLib {
             notifyObservers();
         }
 
+        //! rebuilds the interpolation of the given time slice only
+        /*! This is meant for surfaces filled one time slice at a
+            time, e.g., during the calibration of a leverage function;
+            the other slices keep their current interpolations.
+        */
+        template <class Interpolator>
+        void setInterpolation(Size timeIndex,
+                              const Interpolator& i = Interpolator()) {
+            QL_REQUIRE(timeIndex < times_.size(),
+                       "time index (" << timeIndex << ") out of range");
+            localVolInterpol_[timeIndex] = i.interpolate(
+                strikes_[timeIndex]->begin(), strikes_[timeIndex]->end(),
+                localVolMatrix_->column_begin(timeIndex));
+            notifyObservers();
+        }
+
       protected:
         Volatility localVolImpl(Time t, Real strike) const;
+        /*! The time slices bracketing \c t are located once for all
+            strikes.
+        */
+        void localVolsImpl(Time t, const Array& strikes, Array& vols) const;
 
         const Date maxDate_;
         std::vector<Time> times_;
@@ -95,6 +115,8 @@ namespace QuantLib {
 
       private:
         void checkSurface();
+        Size timeIndex(Time t) const;
+        Volatility localVolImpl(Time t, Size idx, Real strike) const;
     };
 }
 
@@ -47,14 +47,16 @@ namespace QuantLib {
     }
 
     HestonBlackVolSurface::HestonBlackVolSurface(
-        const Handle<HestonModel>& hestonModel)
+        const Handle<HestonModel>& hestonModel,
+        const boost::shared_ptr<FFTHestonEngine>& fftEngine)
     : BlackVolTermStructure(
           hestonModel->process()->riskFreeRate()->referenceDate(),
           NullCalendar(),
           Following,
           hestonModel->process()->riskFreeRate()->dayCounter()),
       hestonModel_(hestonModel),
-      integration_(AnalyticHestonEngine::Integration::gaussLaguerre(164)) {
+      integration_(AnalyticHestonEngine::Integration::gaussLaguerre(164)),
+      fftEngine_(fftEngine) {
         registerWith(hestonModel_);
     }
 
@@ -104,11 +106,15 @@ namespace QuantLib {
         Real npv;
         Size evaluations;
 
-        AnalyticHestonEngine::doCalculation(
-            df, div, spotPrice, strike, t,
-            kappa, theta, sigma, v0, rho,
-            payoff, integration_, cpxLogFormula,
-            hestonEnginePtr, npv, evaluations);
+        if (fftEngine_) {
+            npv = fftEngine_->value(payoff.optionType(), strike, t);
+        } else {
+            AnalyticHestonEngine::doCalculation(
+                df, div, spotPrice, strike, t,
+                kappa, theta, sigma, v0, rho,
+                payoff, integration_, cpxLogFormula,
+                hestonEnginePtr, npv, evaluations);
+        }
 
         if (npv <= 0.0) return std::sqrt(theta);
 
@@ -28,12 +28,22 @@
 
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/ffthestonengine.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvoltermstructure.hpp>
 
 namespace QuantLib {
+    //! Black volatility surface implied by a Heston model
+    /*! If an FFT engine is given, the option prices are taken from the
+        strike slices of the engine, so that the whole smile of each
+        expiry costs a single transform.  The engine must be built on
+        the same model.
+    */
     class HestonBlackVolSurface : public BlackVolTermStructure {
       public:
-        explicit HestonBlackVolSurface(const Handle<HestonModel>& hestonModel);
+        explicit HestonBlackVolSurface(
+            const Handle<HestonModel>& hestonModel,
+            const boost::shared_ptr<FFTHestonEngine>& fftEngine
+                                   = boost::shared_ptr<FFTHestonEngine>());
 
         DayCounter dayCounter() const;
         Date maxDate() const;
@@ -47,6 +57,7 @@ namespace QuantLib {
       private:
         const Handle<HestonModel> hestonModel_;
         const AnalyticHestonEngine::Integration integration_;
+        const boost::shared_ptr<FFTHestonEngine> fftEngine_;
     };
 }
 
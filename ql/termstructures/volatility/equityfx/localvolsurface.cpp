@@ -83,13 +83,55 @@ namespace QuantLib {
             LocalVolTermStructure::accept(v);
     }
 
+    // discount factors and forward shared by all levels at a given time
+    struct LocalVolSurface::TimeSlice {
+        Time t, dt;
+        DiscountFactor dr, dq, drpt, dqpt, drmt, dqmt;
+        Real forwardValue;
+    };
+
+    LocalVolSurface::TimeSlice LocalVolSurface::timeSlice(Time t) const {
+        TimeSlice s;
+        s.t = t;
+        s.dr = riskFreeTS_->discount(t, true);
+        s.dq = dividendTS_->discount(t, true);
+        s.forwardValue = underlying_->value()*s.dq/s.dr;
+        if (t==0.0) {
+            s.dt = 0.0001;
+            s.drpt = riskFreeTS_->discount(t+s.dt, true);
+            s.dqpt = dividendTS_->discount(t+s.dt, true);
+            s.drmt = s.dqmt = Null<DiscountFactor>();
+        } else {
+            s.dt = std::min<Time>(0.0001, t/2.0);
+            s.drpt = riskFreeTS_->discount(t+s.dt, true);
+            s.drmt = riskFreeTS_->discount(t-s.dt, true);
+            s.dqpt = dividendTS_->discount(t+s.dt, true);
+            s.dqmt = dividendTS_->discount(t-s.dt, true);
+        }
+        return s;
+    }
+
+    void LocalVolSurface::localVolsImpl(Time t,
+                                        const Array& strikes,
+                                        Array& vols) const {
+        TimeSlice s = timeSlice(t);
+        for (Size i=0; i<strikes.size(); ++i)
+            vols[i] = localVolImpl(s, strikes[i]);
+    }
+
     Volatility LocalVolSurface::localVolImpl(Time t, Real underlyingLevel)
                                                                      const {
+        return localVolImpl(timeSlice(t), underlyingLevel);
+    }
+
+    Volatility LocalVolSurface::localVolImpl(const TimeSlice& s,
+                                             Real underlyingLevel) const {
+
+        Time t = s.t;
+        DiscountFactor dr = s.dr;
+        DiscountFactor dq = s.dq;
+        Real forwardValue = s.forwardValue;
 
-        DiscountFactor dr = riskFreeTS_->discount(t, true);
-        DiscountFactor dq = dividendTS_->discount(t, true);
-        Real forwardValue = underlying_->value()*dq/dr;
-        
         // strike derivatives
         Real strike, y, dy, strikep, strikem;
         Real w, wp, wm, dwdy, d2wdy2;
@@ -107,9 +149,9 @@ namespace QuantLib {
         // time derivative
         Real dt, wpt, wmt, dwdt;
         if (t==0.0) {
-            dt = 0.0001;
-            DiscountFactor drpt = riskFreeTS_->discount(t+dt, true);
-            DiscountFactor dqpt = dividendTS_->discount(t+dt, true);           
+            dt = s.dt;
+            DiscountFactor drpt = s.drpt;
+            DiscountFactor dqpt = s.dqpt;
             Real strikept = strike*dr*dqpt/(drpt*dq);
         
             wpt = blackTS_->blackVariance(t+dt, strikept, true);
@@ -118,12 +160,13 @@ namespace QuantLib {
                       << " between time " << t << " and time " << t+dt);
             dwdt = (wpt-w)/dt;
         } else {
-            dt = std::min<Time>(0.0001, t/2.0);
-            DiscountFactor drpt = riskFreeTS_->discount(t+dt, true);
-            DiscountFactor drmt = riskFreeTS_->discount(t-dt, true);
-            DiscountFactor dqpt = dividendTS_->discount(t+dt, true);
-            DiscountFactor dqmt = dividendTS_->discount(t-dt, true);
-            
+            dt = s.dt;
+            DiscountFactor drpt = s.drpt;
+            DiscountFactor drmt = s.drmt;
+            DiscountFactor dqpt = s.dqpt;
+            DiscountFactor dqmt = s.dqmt;
+
+
             Real strikept = strike*dr*dqpt/(drpt*dq);
             Real strikemt = strike*dr*dqmt/(drmt*dq);
             
@@ -25,6 +25,7 @@
 #define quantlib_localvolsurface_hpp
 
 #include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
+#include <ql/math/array.hpp>
 
 namespace QuantLib {
 
@@ -69,7 +70,14 @@ namespace QuantLib {
         //@}
       protected:
         Volatility localVolImpl(Time, Real) const;
+        /*! The discount factors needed for the forward and for the
+            time derivative are retrieved once for all strikes.
+        */
+        void localVolsImpl(Time t, const Array& strikes, Array& vols) const;
       private:
+        struct TimeSlice;
+        TimeSlice timeSlice(Time t) const;
+        Volatility localVolImpl(const TimeSlice&, Real) const;
         Handle<BlackVolTermStructure> blackTS_;
         Handle<YieldTermStructure> riskFreeTS_, dividendTS_;
         Handle<Quote> underlying_;
@@ -54,6 +54,34 @@ namespace QuantLib {
         return localVolImpl(t, underlyingLevel);
     }
 
+    void LocalVolTermStructure::localVols(Time t,
+                                          const Array& underlyingLevels,
+                                          Array& vols,
+                                          bool extrapolate) const {
+        checkRange(t, extrapolate);
+        for (Size i=0; i<underlyingLevels.size(); ++i)
+            checkStrike(underlyingLevels[i], extrapolate);
+        if (vols.size() != underlyingLevels.size())
+            vols = Array(underlyingLevels.size());
+        localVolsImpl(t, underlyingLevels, vols);
+    }
+
+    Disposable<Array> LocalVolTermStructure::localVols(
+                                          Time t,
+                                          const Array& underlyingLevels,
+                                          bool extrapolate) const {
+        Array vols(underlyingLevels.size());
+        localVols(t, underlyingLevels, vols, extrapolate);
+        return vols;
+    }
+
+    void LocalVolTermStructure::localVolsImpl(Time t,
+                                              const Array& strikes,
+                                              Array& vols) const {
+        for (Size i=0; i<strikes.size(); ++i)
+            vols[i] = localVolImpl(t, strikes[i]);
+    }
+
     void LocalVolTermStructure::accept(AcyclicVisitor& v) {
         Visitor<LocalVolTermStructure>* v1 =
             dynamic_cast<Visitor<LocalVolTermStructure>*>(&v);
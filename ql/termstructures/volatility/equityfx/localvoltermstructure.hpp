@@ -27,6 +27,7 @@
 
 #include <ql/termstructures/voltermstructure.hpp>
 #include <ql/patterns/visitor.hpp>
+#include <ql/math/array.hpp>
 
 namespace QuantLib {
 
@@ -69,6 +70,19 @@ namespace QuantLib {
         Volatility localVol(Time t,
                             Real underlyingLevel,
                             bool extrapolate = false) const;
+        //! local volatilities at several underlying levels
+        /*! The results are stored in \c vols, which is resized if
+            needed; this allows a caller evaluating the surface at each
+            time step, e.g., on the nodes of a mesh or on a set of
+            paths, to reuse the same storage.
+        */
+        void localVols(Time t,
+                       const Array& underlyingLevels,
+                       Array& vols,
+                       bool extrapolate = false) const;
+        Disposable<Array> localVols(Time t,
+                                    const Array& underlyingLevels,
+                                    bool extrapolate = false) const;
         //@}
         //! \name Visitability
         //@{
@@ -85,6 +99,15 @@ namespace QuantLib {
         //@{
         //! local vol calculation
         virtual Volatility localVolImpl(Time t, Real strike) const = 0;
+        //! local vol calculation at several strikes
+        /*! The default implementation calls localVolImpl for each
+            strike; derived classes can override it in order to share
+            the work depending on the time only.  \c vols has already
+            the same size as \c strikes.
+        */
+        virtual void localVolsImpl(Time t,
+                                   const Array& strikes,
+                                   Array& vols) const;
         //@}
     };
 
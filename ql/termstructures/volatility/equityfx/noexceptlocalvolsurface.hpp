@@ -59,6 +59,16 @@ namespace QuantLib {
             return vol;
         }
 
+        void localVolsImpl(Time t, const Array& strikes, Array& vols) const {
+            try {
+                LocalVolSurface::localVolsImpl(t, strikes, vols);
+            } catch (Error&) {
+                // only the failing strikes are overwritten
+                for (Size i=0; i < strikes.size(); ++i)
+                    vols[i] = localVolImpl(t, strikes[i]);
+            }
+        }
+
       private:
         const Real illegalLocalVolOverwrite_;
     };
@@ -31,6 +31,7 @@
 namespace QuantLib {
 
     class Quote;
+    class MarketCloner;
 
     //! Constant caplet volatility, no time-strike dependence
     class ConstantOptionletVolatility : public OptionletVolatilityStructure {
@@ -76,6 +77,7 @@ namespace QuantLib {
         Real displacement() const;
 
       protected:
+        friend class MarketCloner;
         boost::shared_ptr<SmileSection> smileSectionImpl(const Date& d) const;
         boost::shared_ptr<SmileSection> smileSectionImpl(Time) const;
         Volatility volatilityImpl(Time,
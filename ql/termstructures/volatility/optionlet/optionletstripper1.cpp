@@ -24,13 +24,12 @@
 
 #include <ql/termstructures/volatility/optionlet/optionletstripper1.hpp>
 #include <ql/instruments/makecapfloor.hpp>
-#include <ql/pricingengines/capfloor/blackcapfloorengine.hpp>
-#include <ql/pricingengine.hpp>
-#include <ql/pricingengines/capfloor/bacheliercapfloorengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/batchblackformula.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <string>
 
 using boost::shared_ptr;
 
@@ -57,28 +56,70 @@ OptionletStripper1::OptionletStripper1(
 
     void OptionletStripper1::performCalculations() const {
 
+        // the caps only depend on the evaluation date
+        Date today = Settings::instance().evaluationDate();
+        if (capFloors_.empty() || capFloorsDate_ != today) {
+            capFloors_.resize(nOptionletTenors_);
+            for (Size i=0; i<nOptionletTenors_; ++i) {
+                capFloors_[i] = MakeCapFloor(CapFloor::Cap,
+                                             capFloorLengths_[i],
+                                             iborIndex_,
+                                             0.04, // dummy strike
+                                             0*Days);
+            }
+            capFloorsDate_ = today;
+        }
+
+        const Handle<YieldTermStructure>& discountCurve =
+            discount_.empty() ?
+                iborIndex_->forwardingTermStructure() :
+                discount_;
+        Date settlement = discountCurve->referenceDate();
+
         // update dates
         const Date& referenceDate = termVolSurface_->referenceDate();
         const DayCounter& dc = termVolSurface_->dayCounter();
-        shared_ptr<BlackCapFloorEngine> dummy(new
-                    BlackCapFloorEngine(// discounting does not matter here
-                                        iborIndex_->forwardingTermStructure(),
-                                        0.20, dc));
+
+        // caplets of all the caps, as used by the Black and Bachelier
+        // cap/floor engines (whose volatility reference date is today);
+        // expired caplets are discarded. The caplets of the i-th cap
+        // are in [firstCaplet[i], firstCaplet[i+1]).
+        std::vector<Size> firstCaplet(1, 0);
+        std::vector<Rate> forwards;
+        std::vector<Real> annuities, gearings, spreads;
+        std::vector<Time> fixingTimes;
+        std::vector<DiscountFactor> optionletAnnuities(nOptionletTenors_);
         for (Size i=0; i<nOptionletTenors_; ++i) {
-            CapFloor temp = MakeCapFloor(CapFloor::Cap,
-                                         capFloorLengths_[i],
-                                         iborIndex_,
-                                         0.04, // dummy strike
-                                         0*Days)
-                .withPricingEngine(dummy);
             shared_ptr<FloatingRateCoupon> lFRC =
-                                                temp.lastFloatingRateCoupon();
+                                      capFloors_[i]->lastFloatingRateCoupon();
             optionletDates_[i] = lFRC->fixingDate();
             optionletPaymentDates_[i] = lFRC->date();
             optionletAccrualPeriods_[i] = lFRC->accrualPeriod();
             optionletTimes_[i] = dc.yearFraction(referenceDate,
                                                  optionletDates_[i]);
             atmOptionletRate_[i] = lFRC->indexFixing();
+            optionletAnnuities[i] = optionletAccrualPeriods_[i] *
+                discountCurve->discount(optionletPaymentDates_[i]);
+
+            CapFloor::arguments arguments;
+            capFloors_[i]->setupArguments(&arguments);
+            for (Size k=0; k<arguments.endDates.size(); ++k) {
+                Date paymentDate = arguments.endDates[k];
+                if (paymentDate > settlement) {
+                    forwards.push_back(arguments.forwards[k]);
+                    annuities.push_back(arguments.nominals[k] *
+                                        arguments.gearings[k] *
+                                        discountCurve->discount(paymentDate) *
+                                        arguments.accrualTimes[k]);
+                    gearings.push_back(arguments.gearings[k]);
+                    spreads.push_back(arguments.spreads[k]);
+                    Date fixingDate = arguments.fixingDates[k];
+                    fixingTimes.push_back(fixingDate > today ?
+                                          dc.yearFraction(today, fixingDate) :
+                                          0.0);
+                }
+            }
+            firstCaplet.push_back(forwards.size());
         }
 
         if (floatingSwitchStrike_) {
@@ -89,69 +130,91 @@ OptionletStripper1::OptionletStripper1(
             switchStrike_ = averageAtmOptionletRate / nOptionletTenors_;
         }
 
-        const Handle<YieldTermStructure>& discountCurve =
-            discount_.empty() ?
-                iborIndex_->forwardingTermStructure() :
-                discount_;
+        QL_REQUIRE(volatilityType_ == ShiftedLognormal ||
+                   volatilityType_ == Normal,
+                   "unknown volatility type: " << volatilityType_);
 
         const std::vector<Rate>& strikes = termVolSurface_->strikes();
 
-        boost::shared_ptr<PricingEngine> capFloorEngine;
-        boost::shared_ptr<SimpleQuote> volQuote(new SimpleQuote);
-
-        if (volatilityType_ == ShiftedLognormal) {
-            capFloorEngine = boost::shared_ptr<BlackCapFloorEngine>(
-                        new BlackCapFloorEngine(
-                            discountCurve, Handle<Quote>(volQuote),
-                            dc, displacement_));
-        } else if (volatilityType_ == Normal) {
-            capFloorEngine = boost::shared_ptr<BachelierCapFloorEngine>(
-                        new BachelierCapFloorEngine(
-                            discountCurve, Handle<Quote>(volQuote),
-                            dc));
-        } else {
-            QL_FAIL("unknown volatility type: " << volatilityType_);
+        for (Size i=0; i<nOptionletTenors_; ++i) {
+            for (Size j=0; j<nStrikes_; ++j)
+                capFloorVols_[i][j] = termVolSurface_->volatility(
+                    capFloorLengths_[i], strikes[j], true);
         }
 
+        // from here on, the strikes are independent and only use the
+        // data collected above; errors are rethrown after the loop,
+        // for the first failing strike, as a serial loop would do.
+        std::vector<std::string> errors(nStrikes_);
+        // not vector<bool>, whose elements can't be written concurrently
+        std::vector<int> failed(nStrikes_, 0);
+
+        #pragma omp parallel for schedule(dynamic)
         for (Size j=0; j<nStrikes_; ++j) {
+          try {
             // using out-of-the-money options
-            CapFloor::Type capFloorType =
-                strikes[j] < switchStrike_ ? CapFloor::Floor : CapFloor::Cap;
             Option::Type optionletType =
                 strikes[j] < switchStrike_ ? Option::Put : Option::Call;
 
             Real previousCapFloorPrice = 0.0;
             for (Size i=0; i<nOptionletTenors_; ++i) {
-
-                capFloorVols_[i][j] = termVolSurface_->volatility(
-                    capFloorLengths_[i], strikes[j], true);
-                volQuote->setValue(capFloorVols_[i][j]);
-                boost::shared_ptr<CapFloor> capFloor =
-                    MakeCapFloor(capFloorType, capFloorLengths_[i],
-                                 iborIndex_, strikes[j], -0 * Days)
-                        .withPricingEngine(capFloorEngine);
-                capFloorPrices_[i][j] = capFloor->NPV();
+                Volatility vol = capFloorVols_[i][j];
+                Real capFloorPrice = 0.0;
+                for (Size k=firstCaplet[i]; k<firstCaplet[i+1]; ++k) {
+                    Rate strike = (strikes[j]-spreads[k])/gearings[k];
+                    Real stdDev = std::sqrt(vol*vol*fixingTimes[k]);
+                    if (volatilityType_ == ShiftedLognormal)
+                        capFloorPrice += blackFormula(optionletType,
+                            strike, forwards[k], stdDev, annuities[k],
+                            displacement_);
+                    else
+                        capFloorPrice += bachelierBlackFormula(optionletType,
+                            strike, forwards[k], stdDev, annuities[k]);
+                }
+                capFloorPrices_[i][j] = capFloorPrice;
                 optionletPrices_[i][j] = capFloorPrices_[i][j] -
                                                         previousCapFloorPrice;
                 previousCapFloorPrice = capFloorPrices_[i][j];
-                DiscountFactor d =
-                    discountCurve->discount(optionletPaymentDates_[i]);
-                DiscountFactor optionletAnnuity=optionletAccrualPeriods_[i]*d;
+            }
+
+            std::vector<Real> stdDevs(nOptionletTenors_);
+            if (volatilityType_ == ShiftedLognormal) {
+                std::vector<Real> optionletStrikes(nOptionletTenors_,
+                                                   strikes[j]);
+                std::vector<Real> prices(nOptionletTenors_);
+                for (Size i=0; i<nOptionletTenors_; ++i)
+                    prices[i] = optionletPrices_[i][j];
+                // failures are retried below, one by one
+                blackFormulaImpliedStdDev(optionletType, nOptionletTenors_,
+                                          &optionletStrikes[0],
+                                          &atmOptionletRate_[0],
+                                          &prices[0],
+                                          &optionletAnnuities[0],
+                                          &stdDevs[0],
+                                          displacement_, accuracy_,
+                                          maxIter_);
+            }
+
+            for (Size i=0; i<nOptionletTenors_; ++i) {
+                DiscountFactor optionletAnnuity = optionletAnnuities[i];
                 try {
                   if (volatilityType_ == ShiftedLognormal) {
-                    optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
-                        optionletType, strikes[j], atmOptionletRate_[i],
-                        optionletPrices_[i][j], optionletAnnuity, displacement_,
-                        optionletStDevs_[i][j], accuracy_, maxIter_);
-                  } else if (volatilityType_ == Normal) {
+                    if (stdDevs[i] == Null<Real>()) {
+                        // the scalar solver reports the failure
+                        stdDevs[i] = blackFormulaImpliedStdDev(
+                            optionletType, strikes[j], atmOptionletRate_[i],
+                            optionletPrices_[i][j], optionletAnnuity,
+                            displacement_, optionletStDevs_[i][j],
+                            accuracy_, maxIter_);
+                    }
+                    optionletStDevs_[i][j] = stdDevs[i];
+                  } else {
                     optionletStDevs_[i][j] =
                         std::sqrt(optionletTimes_[i]) *
                         bachelierBlackFormulaImpliedVol(
                             optionletType, strikes[j], atmOptionletRate_[i],
                             optionletTimes_[i], optionletPrices_[i][j],
                             optionletAnnuity);
-                  } else {
-                    QL_FAIL("Unknown volatility type: " << volatilityType_);
                   }
                 }
                 catch (std::exception &e) {
@@ -170,8 +233,17 @@ OptionletStripper1::OptionletStripper1(
                 optionletVolatilities_[i][j] = optionletStDevs_[i][j] /
                                                 std::sqrt(optionletTimes_[i]);
             }
+          } catch (std::exception& e) {
+              errors[j] = e.what();
+              failed[j] = 1;
+          } catch (...) {
+              errors[j] = "unknown error";
+              failed[j] = 1;
+          }
         }
 
+        for (Size j=0; j<nStrikes_; ++j)
+            QL_REQUIRE(!failed[j], errors[j]);
     }
 
     const Matrix &OptionletStripper1::capletVols() const {
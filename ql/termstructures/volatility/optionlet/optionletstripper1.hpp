@@ -43,6 +43,12 @@ namespace QuantLib {
     /*! Helper class to strip optionlet (i.e. caplet/floorlet) volatilities
         (a.k.a. forward-forward volatilities) from the (cap/floor) term
         volatilities of a CapFloorTermVolSurface.
+
+        The caps are built once for each evaluation date and reused
+        when the curves or the volatilities change; their caplets
+        are priced directly from the cap term volatilities, and the
+        optionlet volatilities for the different strikes are stripped
+        in parallel if the library is compiled with OpenMP support.
     */
     class OptionletStripper1 : public OptionletStripper {
       public:
@@ -77,6 +83,9 @@ namespace QuantLib {
         Real accuracy_;
         Natural maxIter_;
         bool dontThrow_;
+        // caps with a dummy strike, one for each optionlet tenor
+        mutable std::vector<boost::shared_ptr<CapFloor> > capFloors_;
+        mutable Date capFloorsDate_;
     };
 
 }
@@ -34,37 +34,8 @@ namespace QuantLib {
                               Real beta,
                               Real nu,
                               Real rho) {
-        const Real oneMinusBeta = 1.0-beta;
-        const Real A = std::pow(forward*strike, oneMinusBeta);
-        const Real sqrtA= std::sqrt(A);
-        Real logM;
-        if (!close(forward, strike))
-            logM = std::log(forward/strike);
-        else {
-            const Real epsilon = (forward-strike)/strike;
-            logM = epsilon - .5 * epsilon * epsilon ;
-        }
-        const Real z = (nu/alpha)*sqrtA*logM;
-        const Real B = 1.0-2.0*rho*z+z*z;
-        const Real C = oneMinusBeta*oneMinusBeta*logM*logM;
-        const Real tmp = (std::sqrt(B)+z-rho)/(1.0-rho);
-        const Real xx = std::log(tmp);
-        const Real D = sqrtA*(1.0+C/24.0+C*C/1920.0);
-        const Real d = 1.0 + expiryTime *
-            (oneMinusBeta*oneMinusBeta*alpha*alpha/(24.0*A)
-                                + 0.25*rho*beta*nu*alpha/sqrtA
-                                    +(2.0-3.0*rho*rho)*(nu*nu/24.0));
-
-        Real multiplier;
-        // computations become precise enough if the square of z worth
-        // slightly more than the precision machine (hence the m)
-        static const Real m = 10;
-        if (std::fabs(z*z)>QL_EPSILON * m)
-            multiplier = z/xx;
-        else {
-            multiplier = 1.0 - 0.5*rho*z - (3.0*rho*rho-2.0)*z*z/12.0;
-        }
-        return (alpha/D)*multiplier*d;
+        return detail::SabrExpansion(forward, expiryTime,
+                                     alpha, beta, nu, rho)(strike);
     }
 
     Real unsafeShiftedSabrVolatility(Rate strike,
@@ -132,4 +103,44 @@ namespace QuantLib {
                                              alpha, beta, nu, rho,shift);
     }
 
+    std::vector<Volatility> sabrVolatilities(
+                                        const std::vector<Rate>& strikes,
+                                        Rate forward,
+                                        Time expiryTime,
+                                        Real alpha,
+                                        Real beta,
+                                        Real nu,
+                                        Real rho) {
+        return shiftedSabrVolatilities(strikes, forward, expiryTime,
+                                       alpha, beta, nu, rho, 0.0);
+    }
+
+    std::vector<Volatility> shiftedSabrVolatilities(
+                                        const std::vector<Rate>& strikes,
+                                        Rate forward,
+                                        Time expiryTime,
+                                        Real alpha,
+                                        Real beta,
+                                        Real nu,
+                                        Real rho,
+                                        Real shift) {
+        for (Size i=0; i<strikes.size(); ++i)
+            QL_REQUIRE(strikes[i] + shift > 0.0,
+                       "strike+shift must be positive: "
+                       << io::rate(strikes[i]) << "+" << io::rate(shift)
+                       << " not allowed");
+        QL_REQUIRE(forward + shift > 0.0, "at the money forward rate + shift must be "
+                   "positive: " << io::rate(forward) << " " << io::rate(shift) << " not allowed");
+        QL_REQUIRE(expiryTime>=0.0, "expiry time must be non-negative: "
+                                   << expiryTime << " not allowed");
+        validateSabrParameters(alpha, beta, nu, rho);
+
+        detail::SabrExpansion sabr(forward+shift, expiryTime,
+                                   alpha, beta, nu, rho);
+        std::vector<Volatility> result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            result[i] = sabr(strikes[i]+shift);
+        return result;
+    }
+
 }
@@ -28,9 +28,39 @@
 #define quantlib_sabr_hpp
 
 #include <ql/types.hpp>
+#include <ql/math/comparison.hpp>
+#include <cmath>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        //! SABR expansion for given forward, expiry and parameters
+        /*! The terms of the Hagan expansion that don't depend on the
+            strike are computed once at construction, so that the
+            volatility can be evaluated at many strikes cheaply.  No
+            checks are performed; the results are the same as those
+            of unsafeSabrVolatility.
+        */
+        class SabrExpansion {
+          public:
+            SabrExpansion() {}
+            SabrExpansion(Rate forward,
+                          Time expiryTime,
+                          Real alpha,
+                          Real beta,
+                          Real nu,
+                          Real rho);
+            Real operator()(Rate strike) const;
+          private:
+            Real forward_, expiryTime_, alpha_, beta_, rho_, oneMinusBeta_;
+            Real nuOverAlpha_, oneMinusRho_, alphaTerm_, rhoTerm_, nuTerm_;
+            Real halfRho_, zTerm_;
+        };
+
+    }
+
     Real unsafeSabrVolatility(Rate strike,
                               Rate forward,
                               Time expiryTime,
@@ -70,6 +100,84 @@ namespace QuantLib {
                                 Real nu,
                                 Real rho);
 
+    //! SABR volatilities at several strikes
+    /*! The inputs are checked once for all strikes, and the terms of
+        the expansion not depending on the strike are only computed
+        once; the results are the same as those of sabrVolatility.
+    */
+    std::vector<Volatility> sabrVolatilities(
+                                        const std::vector<Rate>& strikes,
+                                        Rate forward,
+                                        Time expiryTime,
+                                        Real alpha,
+                                        Real beta,
+                                        Real nu,
+                                        Real rho);
+
+    //! shifted SABR volatilities at several strikes
+    /*! See sabrVolatilities. */
+    std::vector<Volatility> shiftedSabrVolatilities(
+                                        const std::vector<Rate>& strikes,
+                                        Rate forward,
+                                        Time expiryTime,
+                                        Real alpha,
+                                        Real beta,
+                                        Real nu,
+                                        Real rho,
+                                        Real shift);
+
+
+    // inline definitions
+
+    namespace detail {
+
+        inline SabrExpansion::SabrExpansion(Rate forward,
+                                            Time expiryTime,
+                                            Real alpha,
+                                            Real beta,
+                                            Real nu,
+                                            Real rho)
+        : forward_(forward), expiryTime_(expiryTime), alpha_(alpha),
+          beta_(beta), rho_(rho), oneMinusBeta_(1.0-beta),
+          nuOverAlpha_(nu/alpha), oneMinusRho_(1.0-rho),
+          alphaTerm_(oneMinusBeta_*oneMinusBeta_*alpha*alpha),
+          rhoTerm_(0.25*rho*beta*nu*alpha),
+          nuTerm_((2.0-3.0*rho*rho)*(nu*nu/24.0)),
+          halfRho_(0.5*rho), zTerm_(3.0*rho*rho-2.0) {}
+
+        inline Real SabrExpansion::operator()(Rate strike) const {
+            const Real A = std::pow(forward_*strike, oneMinusBeta_);
+            const Real sqrtA = std::sqrt(A);
+            Real logM;
+            if (!close(forward_, strike))
+                logM = std::log(forward_/strike);
+            else {
+                const Real epsilon = (forward_-strike)/strike;
+                logM = epsilon - .5 * epsilon * epsilon ;
+            }
+            const Real z = nuOverAlpha_*sqrtA*logM;
+            const Real B = 1.0-2.0*rho_*z+z*z;
+            const Real C = oneMinusBeta_*oneMinusBeta_*logM*logM;
+            const Real tmp = (std::sqrt(B)+z-rho_)/oneMinusRho_;
+            const Real xx = std::log(tmp);
+            const Real D = sqrtA*(1.0+C/24.0+C*C/1920.0);
+            const Real d = 1.0 + expiryTime_ *
+                (alphaTerm_/(24.0*A) + rhoTerm_/sqrtA + nuTerm_);
+
+            Real multiplier;
+            // computations become precise enough if the square of z worth
+            // slightly more than the precision machine (hence the m)
+            static const Real m = 10;
+            if (std::fabs(z*z)>QL_EPSILON * m)
+                multiplier = z/xx;
+            else {
+                multiplier = 1.0 - halfRho_*z - zTerm_*z*z/12.0;
+            }
+            return (alpha_/D)*multiplier*d;
+        }
+
+    }
+
 }
 
 #endif
@@ -20,6 +20,7 @@
 
 #include <ql/termstructures/volatility/sabrsmilesection.hpp>
 #include <ql/termstructures/volatility/sabr.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 namespace QuantLib {
@@ -30,7 +31,7 @@ namespace QuantLib {
                                        const Real shift)
         : SmileSection(timeToExpiry,DayCounter(),
                        ShiftedLognormal,shift),
-          forward_(forward), shift_(shift) {
+          forward_(forward), shift_(shift), expansionTime_(Null<Time>()) {
 
         alpha_ = sabrParams[0];
         beta_ = sabrParams[1];
@@ -51,7 +52,7 @@ namespace QuantLib {
                                        const DayCounter& dc,
                                        const Real shift)
         : SmileSection(d, dc,Date(),ShiftedLognormal,shift),
-          forward_(forward), shift_(shift) {
+          forward_(forward), shift_(shift), expansionTime_(Null<Time>()) {
 
         alpha_ = sabrParams[0];
         beta_ = sabrParams[1];
@@ -66,16 +67,52 @@ namespace QuantLib {
         validateSabrParameters(alpha_, beta_, nu_, rho_);
     }
 
+     const detail::SabrExpansion& SabrSmileSection::expansion() const {
+        Time t = exerciseTime();
+        if (t != expansionTime_) {
+            expansion_ = detail::SabrExpansion(forward_ + shift_, t,
+                                               alpha_, beta_, nu_, rho_);
+            expansionTime_ = t;
+        }
+        return expansion_;
+     }
+
      Real SabrSmileSection::varianceImpl(Rate strike) const {
         strike = std::max(0.00001 - shift(),strike);
-        Volatility vol = unsafeShiftedSabrVolatility(
-            strike, forward_, exerciseTime(), alpha_, beta_, nu_, rho_, shift_);
+        Volatility vol = expansion()(strike + shift_);
         return vol * vol * exerciseTime();
      }
 
      Real SabrSmileSection::volatilityImpl(Rate strike) const {
         strike = std::max(0.00001 - shift(),strike);
-        return unsafeShiftedSabrVolatility(strike, forward_, exerciseTime(),
-                                           alpha_, beta_, nu_, rho_, shift_);
+        return expansion()(strike + shift_);
+     }
+
+     std::vector<Volatility> SabrSmileSection::volatilities(
+                                     const std::vector<Rate>& strikes) const {
+        const detail::SabrExpansion& sabr = expansion();
+        Real minStrike = 0.00001 - shift();
+        std::vector<Volatility> result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            result[i] = sabr(std::max(minStrike, strikes[i]) + shift_);
+        return result;
+     }
+
+     std::vector<Real> SabrSmileSection::optionPrices(
+                                          const std::vector<Rate>& strikes,
+                                          Option::Type type,
+                                          Real discount) const {
+        // same as SmileSection::optionPrice, with a single
+        // evaluation of the strike-independent terms
+        std::vector<Volatility> vols = volatilities(strikes);
+        Time t = exerciseTime();
+        std::vector<Real> result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i) {
+            Real stdDev = std::fabs(strikes[i]+shift_) < QL_EPSILON ?
+                0.2 : std::sqrt(vols[i]*vols[i]*t);
+            result[i] = blackFormula(type, strikes[i], forward_, stdDev,
+                                     discount, shift_);
+        }
+        return result;
      }
 }
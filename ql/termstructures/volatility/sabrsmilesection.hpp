@@ -26,11 +26,17 @@
 #define quantlib_sabr_smile_section_hpp
 
 #include <ql/termstructures/volatility/smilesection.hpp>
+#include <ql/termstructures/volatility/sabr.hpp>
 #include <ql/time/daycounters/actual365fixed.hpp>
 #include <vector>
 
 namespace QuantLib {
 
+    //! smile section given by SABR parameters
+    /*! The terms of the SABR expansion that don't depend on the
+        strike are stored, so that repeated calls to volatility() and
+        variance(), as done by CMS replication, are cheap.
+    */
     class SabrSmileSection : public SmileSection {
       public:
         SabrSmileSection(Time timeToExpiry,
@@ -45,11 +51,22 @@ namespace QuantLib {
         Real minStrike () const { return -shift_; }
         Real maxStrike () const { return QL_MAX_REAL; }
         Real atmLevel() const { return forward_; }
+        //! volatilities at the given strikes
+        std::vector<Volatility> volatilities(
+                                      const std::vector<Rate>& strikes) const;
+        //! option prices at the given strikes, using volatilities()
+        std::vector<Real> optionPrices(const std::vector<Rate>& strikes,
+                                       Option::Type type = Option::Call,
+                                       Real discount = 1.0) const;
       protected:
         Real varianceImpl(Rate strike) const;
         Volatility volatilityImpl(Rate strike) const;
       private:
+        const detail::SabrExpansion& expansion() const;
         Real alpha_, beta_, nu_, rho_, forward_, shift_;
+        // rebuilt if the exercise time changes with the reference date
+        mutable detail::SabrExpansion expansion_;
+        mutable Time expansionTime_;
     };
 
 
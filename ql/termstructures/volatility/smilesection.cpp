@@ -84,6 +84,16 @@ namespace QuantLib {
             return bachelierBlackFormula(type,strike,atm,sqrt(variance(strike)),discount);
     }
 
+    std::vector<Real> SmileSection::optionPrices(
+                                          const std::vector<Rate>& strikes,
+                                          Option::Type type,
+                                          Real discount) const {
+        std::vector<Real> result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            result[i] = optionPrice(strikes[i], type, discount);
+        return result;
+    }
+
     Real SmileSection::digitalOptionPrice(Rate strike,
                                           Option::Type type,
                                           Real discount,
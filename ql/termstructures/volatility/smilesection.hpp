@@ -30,6 +30,7 @@
 #include <ql/utilities/null.hpp>
 #include <ql/option.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -68,6 +69,15 @@ namespace QuantLib {
         virtual Real optionPrice(Rate strike,
                                  Option::Type type = Option::Call,
                                  Real discount=1.0) const;
+        //! option prices at the given strikes
+        /*! The default implementation calls optionPrice() for each
+            strike; sections that can evaluate their smile over
+            several strikes at once should override it.
+        */
+        virtual std::vector<Real> optionPrices(
+                                     const std::vector<Rate>& strikes,
+                                     Option::Type type = Option::Call,
+                                     Real discount=1.0) const;
         virtual Real digitalOptionPrice(Rate strike,
                                         Option::Type type = Option::Call,
                                         Real discount=1.0,
@@ -32,6 +32,7 @@
 namespace QuantLib {
 
     class Quote;
+    class MarketCloner;
 
     //! Constant swaption volatility, no time-strike dependence
     class ConstantSwaptionVolatility : public SwaptionVolatilityStructure {
@@ -84,6 +85,7 @@ namespace QuantLib {
         //! volatility type
         VolatilityType volatilityType() const;
       protected:
+        friend class MarketCloner;
         boost::shared_ptr<SmileSection> smileSectionImpl(const Date&,
                                                          const Period&) const;
         boost::shared_ptr<SmileSection> smileSectionImpl(Time,
@@ -37,6 +37,7 @@
 #include <ql/math/interpolations/backwardflatlinearinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/quote.hpp>
+#include <ql/utilities/dataformatters.hpp>
 
 #include <boost/make_shared.hpp>
 
@@ -52,6 +53,7 @@ namespace QuantLib {
     class Interpolation2D;
     class EndCriteria;
     class OptimizationMethod;
+    class MarketSnapshot;
 
     template<class Model>
     class SwaptionVolCube1x : public SwaptionVolatilityCube {
@@ -162,7 +164,42 @@ namespace QuantLib {
                            const std::vector<Real> &beta,
                            const Period& swapTenor);
         void updateAfterRecalibration();
+        //! \name Calibration settings
+        //@{
+        /*! The smiles at the cube nodes are calibrated concurrently
+            when QuantLib is compiled with OpenMP support.
+
+            \warning This requires the default optimization method,
+                     which is created for each node; a given
+                     optimization method can't be used concurrently.
+        */
+        void enableParallelCalibration(bool b = true);
+        /*! When the cube is recalculated, each node is calibrated
+            starting from its previous parameters rather than from the
+            guesses (fixed parameters are still taken from the
+            guesses).  In any case, nodes whose inputs didn't change
+            are not recalibrated.
+        */
+        void enableWarmStart(bool b = true);
+        //@}
      protected:
+        // inputs and results of the smile calibration at a node
+        struct NodeCalibration {
+            std::vector<Real> strikes, volatilities, guess;
+            Rate forward;
+            Real shift;
+            Time optionTime;
+            std::vector<Real> parameters;
+            Real error, maxError;
+            EndCriteria::Type endCriteria;
+            bool sameInputs(const NodeCalibration& other) const {
+                return forward == other.forward && shift == other.shift
+                    && optionTime == other.optionTime
+                    && strikes == other.strikes
+                    && volatilities == other.volatilities
+                    && guess == other.guess;
+            }
+        };
         void registerWithParametersGuess();
         void setParameterGuess() const;
         boost::shared_ptr<SmileSection> smileSection(
@@ -170,6 +207,13 @@ namespace QuantLib {
                                     Time swapLength,
                                     const Cube& sabrParametersCube) const;
         Cube sabrCalibration(const Cube &marketVolCube) const;
+        /*! Nodes whose inputs are the same as in the given previous
+            calibrations are not recalibrated; the calibrations are
+            then replaced with the current ones.
+        */
+        Cube sabrCalibration(
+                        const Cube &marketVolCube,
+                        std::vector<NodeCalibration>& calibrations) const;
         void fillVolatilityCube() const;
         void createSparseSmiles() const;
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
@@ -194,6 +238,9 @@ namespace QuantLib {
         const Size maxGuesses_;
         const bool backwardFlat_;
         const Real cutoffStrike_;
+        bool parallelCalibration_, warmStart_;
+        mutable std::vector<NodeCalibration> sparseCalibrations_,
+                                             denseCalibrations_;
 
         class PrivateObserver : public Observer {
           public:
@@ -209,6 +256,8 @@ namespace QuantLib {
 
        boost::shared_ptr<PrivateObserver> privateObserver_;
 
+        friend class MarketSnapshot;
+
     };
 
     //=======================================================================//
@@ -240,7 +289,8 @@ namespace QuantLib {
           isAtmCalibrated_(isAtmCalibrated), endCriteria_(endCriteria),
           optMethod_(optMethod),
           useMaxError_(useMaxError), maxGuesses_(maxGuesses),
-          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike) {
+          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike),
+          parallelCalibration_(false), warmStart_(false) {
 
         // the current implementations are all lognormal, if we have
         // a normal one, we can move this check to the implementing classes
@@ -311,7 +361,8 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        sparseParameters_ = sabrCalibration(marketVolCube_,
+                                            sparseCalibrations_);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -319,7 +370,8 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseCalibrations_);
             denseParameters_.updateInterpolators();
         }
     }
@@ -328,15 +380,38 @@ namespace QuantLib {
         volCubeAtmCalibrated_ = marketVolCube_;
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseCalibrations_);
             denseParameters_.updateInterpolators();
         }
         notifyObservers();
     }
 
+    template<class Model>
+    void SwaptionVolCube1x<Model>::enableParallelCalibration(bool b) {
+        QL_REQUIRE(!b || !optMethod_,
+                   "parallel calibration requires the default "
+                   "optimization method");
+        parallelCalibration_ = b;
+    }
+
+    template<class Model>
+    void SwaptionVolCube1x<Model>::enableWarmStart(bool b) {
+        warmStart_ = b;
+    }
+
     template <class Model>
     typename SwaptionVolCube1x<Model>::Cube
     SwaptionVolCube1x<Model>::sabrCalibration(const Cube &marketVolCube) const {
+        std::vector<NodeCalibration> calibrations;
+        return sabrCalibration(marketVolCube, calibrations);
+    }
+
+    template <class Model>
+    typename SwaptionVolCube1x<Model>::Cube
+    SwaptionVolCube1x<Model>::sabrCalibration(
+                        const Cube &marketVolCube,
+                        std::vector<NodeCalibration>& calibrations) const {
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
@@ -353,33 +428,69 @@ namespace QuantLib {
 
         const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
 
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
-
+        // collect the inputs of each node; forwards and shifts come
+        // from lazy objects, so this is done before any parallel loop
+        Size nSwaps = swapLengths.size();
+        Size nNodes = optionTimes.size()*nSwaps;
+        bool previousAvailable = (calibrations.size() == nNodes);
+        std::vector<NodeCalibration> nodes(nNodes);
+        std::vector<Size> toBeCalibrated;
         for (Size j=0; j<optionTimes.size(); j++) {
-            for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-                strikes.clear();
-                volatilities.clear();
+            for (Size k=0; k<nSwaps; k++) {
+                NodeCalibration& node = nodes[j*nSwaps+k];
+                node.optionTime = optionTimes[j];
+                node.forward = atmStrike(optionDates[j], swapTenors[k]);
+                node.shift = atmVol_->shift(optionTimes[j], swapLengths[k]);
                 for (Size i=0; i<nStrikes_; i++){
-                    Real strike = atmForward+strikeSpreads_[i];
-                    if(strike + shiftTmp >=cutoffStrike_) {
-                        strikes.push_back(strike);
-                        volatilities.push_back(tmpMarketVolCube[i][j][k]);
+                    Real strike = node.forward+strikeSpreads_[i];
+                    if(strike + node.shift >=cutoffStrike_) {
+                        node.strikes.push_back(strike);
+                        node.volatilities.push_back(tmpMarketVolCube[i][j][k]);
                     }
                 }
-
-                const std::vector<Real>& guess = parametersGuess_.operator()(
+                node.guess = parametersGuess_.operator()(
                     optionTimes[j], swapLengths[k]);
 
+                if (previousAvailable) {
+                    const NodeCalibration& previous =
+                        calibrations[j*nSwaps+k];
+                    if (previous.sameInputs(node)) {
+                        // nothing changed; keep the results
+                        node = previous;
+                        continue;
+                    }
+                }
+                toBeCalibrated.push_back(j*nSwaps+k);
+            }
+        }
+
+        Size n = toBeCalibrated.size();
+        std::vector<std::string> messages(n);
+        // not vector<bool>, whose elements can't be written
+        // concurrently
+        std::vector<int> failed(n, 0);
+
+        #pragma omp parallel for schedule(dynamic) if (parallelCalibration_)
+        for (Size l=0; l<n; l++) {
+            Size m = toBeCalibrated[l];
+            NodeCalibration& node = nodes[m];
+            // free parameters start from their previous values if
+            // required; fixed ones are always taken from the guess
+            std::vector<Real> start = node.guess;
+            if (warmStart_ && previousAvailable
+                && calibrations[m].parameters.size() == 4) {
+                for (Size i=0; i<4; i++)
+                    if (!isParameterFixed_[i])
+                        start[i] = calibrations[m].parameters[i];
+            }
+            try {
                 const boost::shared_ptr<typename Model::Interpolation> sabrInterpolation =
                     boost::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
-                                          guess[0], guess[1],
-                                          guess[2], guess[3],
+                                          (typename Model::Interpolation)(node.strikes.begin(), node.strikes.end(),
+                                          node.volatilities.begin(),
+                                          node.optionTime, node.forward,
+                                          start[0], start[1],
+                                          start[2], start[3],
                                           isParameterFixed_[0],
                                           isParameterFixed_[1],
                                           isParameterFixed_[2],
@@ -390,19 +501,49 @@ namespace QuantLib {
                                           errorAccept_,
                                           useMaxError_,
                                           maxGuesses_,
-                                          shiftTmp));
+                                          node.shift));
                 sabrInterpolation->update();
 
-                Real rmsError = sabrInterpolation->rmsError();
-                Real maxError = sabrInterpolation->maxError();
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
+                node.parameters.resize(4);
+                node.parameters[0] = sabrInterpolation->alpha();
+                node.parameters[1] = sabrInterpolation->beta();
+                node.parameters[2] = sabrInterpolation->nu();
+                node.parameters[3] = sabrInterpolation->rho();
+                node.error = sabrInterpolation->rmsError();
+                node.maxError = sabrInterpolation->maxError();
+                node.endCriteria = sabrInterpolation->endCriteria();
+            } catch (std::exception& e) {
+                messages[l] = e.what();
+                failed[l] = 1;
+            } catch (...) {
+                messages[l] = "unknown error";
+                failed[l] = 1;
+            }
+        }
+
+        for (Size l=0; l<n; l++) {
+            Size m = toBeCalibrated[l];
+            QL_REQUIRE(!failed[l],
+                       "global swaptions calibration failed: "
+                       "option maturity = " << optionDates[m/nSwaps] <<
+                       ", swap tenor = " << swapTenors[m%nSwaps] <<
+                       ": " << messages[l]);
+        }
+        calibrations = nodes;
+
+        for (Size j=0; j<optionTimes.size(); j++) {
+            for (Size k=0; k<nSwaps; k++) {
+                const NodeCalibration& node = nodes[j*nSwaps+k];
+                Real rmsError = node.error;
+                Real maxError = node.maxError;
+                alphas     [j][k] = node.parameters[0];
+                betas      [j][k] = node.parameters[1];
+                nus        [j][k] = node.parameters[2];
+                rhos       [j][k] = node.parameters[3];
+                forwards   [j][k] = node.forward;
                 errors     [j][k] = rmsError;
                 maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
+                endCriteria[j][k] = node.endCriteria;
 
                 QL_ENSURE(endCriteria[j][k]!=EndCriteria::MaxIterations,
                           "global swaptions calibration failed: "
@@ -20,13 +20,69 @@
 */
 
 #include <ql/termstructures/volatility/swaption/swaptionvolcube2.hpp>
-#include <ql/termstructures/volatility/interpolatedsmilesection.hpp>
+#include <ql/termstructures/volatility/smilesection.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/rounding.hpp>
 #include <ql/indexes/swapindex.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <boost/make_shared.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        /* Smile section linearly interpolating (and extrapolating) the
+           volatilities at the given strikes, as an
+           InterpolatedSmileSection<Linear> would, but without the
+           quotes, the lazy-object machinery and the interpolation
+           object that the latter allocates.
+        */
+        class LinearSmileSection : public SmileSection {
+          public:
+            LinearSmileSection(Time optionTime,
+                               const std::vector<Rate>& strikes,
+                               const std::vector<Volatility>& vols,
+                               Rate atmLevel,
+                               VolatilityType type,
+                               Real shift)
+            : SmileSection(optionTime, Actual365Fixed(), type, shift),
+              strikes_(strikes), vols_(vols), atmLevel_(atmLevel) {
+                QL_REQUIRE(strikes_.size() >= 2,
+                           "not enough points to interpolate: at least 2 "
+                           "required, " << strikes_.size() << " provided");
+            }
+            Real minStrike() const { return strikes_.front(); }
+            Real maxStrike() const { return strikes_.back(); }
+            Real atmLevel() const { return atmLevel_; }
+          protected:
+            Volatility volatilityImpl(Rate strike) const {
+                Size i;
+                if (strike < strikes_.front())
+                    i = 0;
+                else if (strike > strikes_.back())
+                    i = strikes_.size()-2;
+                else
+                    i = std::upper_bound(strikes_.begin(), strikes_.end()-1,
+                                         strike) - strikes_.begin() - 1;
+                Real slope = (vols_[i+1]-vols_[i])/(strikes_[i+1]-strikes_[i]);
+                return vols_[i] + (strike-strikes_[i])*slope;
+            }
+          private:
+            std::vector<Rate> strikes_;
+            std::vector<Volatility> vols_;
+            Rate atmLevel_;
+        };
+
+    }
+
+    bool SwaptionVolCube2::CacheKey::operator<(const CacheKey& other) const {
+        if (optionDate != other.optionDate)
+            return optionDate < other.optionDate;
+        if (length != other.length)
+            return length < other.length;
+        return units < other.units;
+    }
+
     SwaptionVolCube2::SwaptionVolCube2(
         const Handle<SwaptionVolatilityStructure>& atmVolStructure,
         const std::vector<Period>& optionTenors,
@@ -35,13 +91,15 @@ namespace QuantLib {
         const std::vector<std::vector<Handle<Quote> > >& volSpreads,
         const boost::shared_ptr<SwapIndex>& swapIndexBase,
         const boost::shared_ptr<SwapIndex>& shortSwapIndexBase,
-        bool vegaWeightedSmileFit)
+        bool vegaWeightedSmileFit,
+        Size smileSectionCacheSize)
     : SwaptionVolatilityCube(atmVolStructure, optionTenors, swapTenors,
                              strikeSpreads, volSpreads, swapIndexBase,
                              shortSwapIndexBase,
                              vegaWeightedSmileFit),
       volSpreadsInterpolator_(nStrikes_),
-      volSpreadsMatrix_(nStrikes_, Matrix(optionTenors.size(), swapTenors.size(), 0.0)) {
+      volSpreadsMatrix_(nStrikes_, Matrix(optionTenors.size(), swapTenors.size(), 0.0)),
+      smileSectionCacheSize_(smileSectionCacheSize) {
     }
 
     void SwaptionVolCube2::performCalculations() const{
@@ -62,6 +120,26 @@ namespace QuantLib {
                 volSpreadsMatrix_[i]);
             volSpreadsInterpolator_[i].enableExtrapolation();
         }
+        cacheEntries_.clear();
+        cacheIndex_.clear();
+    }
+
+    void SwaptionVolCube2::volSpreads(Time length, Time optionTime,
+                                      std::vector<Real>& spreads) const {
+        // all the interpolations share the same grid; this reproduces
+        // BilinearInterpolation, locating the point only once
+        const Interpolation2D& grid = volSpreadsInterpolator_.front();
+        Size i = grid.locateX(length), j = grid.locateY(optionTime);
+        Real t = (length-swapLengths_[i])/(swapLengths_[i+1]-swapLengths_[i]);
+        Real u = (optionTime-optionTimes_[j])/
+                 (optionTimes_[j+1]-optionTimes_[j]);
+        Real w1 = (1.0-t)*(1.0-u), w2 = t*(1.0-u),
+             w3 = (1.0-t)*u, w4 = t*u;
+        for (Size k=0; k<nStrikes_; ++k) {
+            const Matrix& m = volSpreadsMatrix_[k];
+            spreads[k] = w1*m[j][i] + w2*m[j][i+1]
+                       + w3*m[j+1][i] + w4*m[j+1][i+1];
+        }
     }
 
     boost::shared_ptr<SmileSection>
@@ -85,30 +163,44 @@ namespace QuantLib {
     SwaptionVolCube2::smileSectionImpl(const Date& optionDate,
                                        const Period& swapTenor) const {
         calculate();
+
+        CacheKey key = { optionDate, swapTenor.length(), swapTenor.units() };
+        if (smileSectionCacheSize_ > 0) {
+            std::map<CacheKey, cache_entries::iterator>::const_iterator i =
+                cacheIndex_.find(key);
+            if (i != cacheIndex_.end()) {
+                cacheEntries_.splice(cacheEntries_.begin(), cacheEntries_,
+                                     i->second);
+                return i->second->second;
+            }
+        }
+
         Rate atmForward = atmStrike(optionDate, swapTenor);
         Volatility atmVol = atmVol_->volatility(optionDate,
                                                 swapTenor,
                                                 atmForward);
         Time optionTime = timeFromReference(optionDate);
-        Real exerciseTimeSqrt = std::sqrt(optionTime);
-        std::vector<Real> strikes, stdDevs;
-        strikes.reserve(nStrikes_);
-        stdDevs.reserve(nStrikes_);
         Time length = swapLength(swapTenor);
+        std::vector<Real> strikes(nStrikes_), vols(nStrikes_);
+        volSpreads(length, optionTime, vols);
         for (Size i=0; i<nStrikes_; ++i) {
-            strikes.push_back(atmForward + strikeSpreads_[i]);
-            stdDevs.push_back(exerciseTimeSqrt*(
-                atmVol + volSpreadsInterpolator_[i](length, optionTime)));
+            strikes[i] = atmForward + strikeSpreads_[i];
+            vols[i] += atmVol;
         }
         Real shift = atmVol_->shift(optionTime,length);
-        return boost::shared_ptr<SmileSection>(new
-            InterpolatedSmileSection<Linear>(optionTime,
-                                             strikes,
-                                             stdDevs,
-                                             atmForward,
-                                             Linear(),
-                                             Actual365Fixed(),
-                                             volatilityType(),
-                                             shift));
+        boost::shared_ptr<SmileSection> section =
+            boost::make_shared<LinearSmileSection>(optionTime, strikes, vols,
+                                                   atmForward,
+                                                   volatilityType(), shift);
+
+        if (smileSectionCacheSize_ > 0) {
+            cacheEntries_.push_front(std::make_pair(key, section));
+            cacheIndex_[key] = cacheEntries_.begin();
+            if (cacheEntries_.size() > smileSectionCacheSize_) {
+                cacheIndex_.erase(cacheEntries_.back().first);
+                cacheEntries_.pop_back();
+            }
+        }
+        return section;
     }
 }
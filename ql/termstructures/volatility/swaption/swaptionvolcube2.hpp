@@ -26,6 +26,8 @@
 
 #include <ql/termstructures/volatility/swaption/swaptionvolcube.hpp>
 #include <ql/math/interpolations/interpolation2d.hpp>
+#include <list>
+#include <map>
 
 namespace QuantLib {
 
@@ -42,6 +44,12 @@ namespace QuantLib {
               e.g. the EUR case: swap vs 6M Euribor is used for length>1Y,
               while swap vs 3M Euribor is used for the 1Y length. The
               shortSwapIndexBase is used to identify this second family.
+
+              The smile sections returned for the most recently used
+              pairs of option date and swap tenor (up to the given
+              number of pairs) are stored and returned again on
+              subsequent requests, until the cube is recalculated; a
+              null size disables the cache.
         */
         SwaptionVolCube2(
             const Handle<SwaptionVolatilityStructure>& atmVolStructure,
@@ -51,7 +59,8 @@ namespace QuantLib {
             const std::vector<std::vector<Handle<Quote> > >& volSpreads,
             const boost::shared_ptr<SwapIndex>& swapIndexBase,
             const boost::shared_ptr<SwapIndex>& shortSwapIndexBase,
-            bool vegaWeightedSmileFit);
+            bool vegaWeightedSmileFit,
+            Size smileSectionCacheSize = 100);
         //! \name LazyObject interface
         //@{
         void performCalculations() const;
@@ -67,8 +76,25 @@ namespace QuantLib {
                                               Time swapLength) const;
         //@}
       private:
+        // interpolated vol spreads for all strikes at once
+        void volSpreads(Time swapLength, Time optionTime,
+                        std::vector<Real>& spreads) const;
         mutable std::vector<Interpolation2D> volSpreadsInterpolator_;
         mutable std::vector<Matrix> volSpreadsMatrix_;
+        // smile sections by option date and swap tenor,
+        // most recently used first
+        struct CacheKey {
+            Date optionDate;
+            Integer length;
+            TimeUnit units;
+            bool operator<(const CacheKey& other) const;
+        };
+        typedef std::list<std::pair<CacheKey,
+                                    boost::shared_ptr<SmileSection> > >
+                                                               cache_entries;
+        Size smileSectionCacheSize_;
+        mutable cache_entries cacheEntries_;
+        mutable std::map<CacheKey, cache_entries::iterator> cacheIndex_;
     };
 
 }
@@ -0,0 +1,146 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cacheddiscountcurve.hpp
+    \brief term structure memoizing the discount factors of another
+*/
+
+#ifndef quantlib_cached_discount_curve_hpp
+#define quantlib_cached_discount_curve_hpp
+
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <map>
+
+namespace QuantLib {
+
+    //! Term structure memoizing the discount factors of another
+    /*! This term structure returns the same discount factors as the
+        underlying curve, but stores them as they're calculated; later
+        requests for the same dates or times are served from the
+        store.  This saves the interpolation and the jump adjustments
+        of the underlying curve when a large number of instruments
+        are priced on the same schedule, e.g., by the
+        DiscountingSwapEngine.
+
+        The store is cleared as soon as a notification is received
+        from the underlying curve or its handle.
+
+        \note The store is not bounded; this class is meant to be
+              used when the requested dates come from a limited set.
+
+        \warning The store is filled from the const discount methods
+                 without any locking; an instance (or a handle to it)
+                 must not be used concurrently from several threads,
+                 e.g., by engines pricing in parallel.
+
+        \ingroup yieldtermstructures
+    */
+    class CachedDiscountCurve : public YieldTermStructure,
+                                public LazyObject {
+      public:
+        explicit CachedDiscountCurve(const Handle<YieldTermStructure>&);
+        //! \name YieldTermStructure interface
+        //@{
+        DayCounter dayCounter() const;
+        Calendar calendar() const;
+        Natural settlementDays() const;
+        const Date& referenceDate() const;
+        Date maxDate() const;
+        Time maxTime() const;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+        //! \name Inspectors
+        //@{
+        //! number of discount factors currently stored
+        Size cachedDiscounts() const;
+        //@}
+      protected:
+        void performCalculations() const;
+        DiscountFactor discountImpl(Time) const;
+      private:
+        Handle<YieldTermStructure> originalCurve_;
+        mutable std::map<Time, DiscountFactor> discounts_;
+    };
+
+
+    // inline definitions
+
+    inline CachedDiscountCurve::CachedDiscountCurve(
+                                          const Handle<YieldTermStructure>& h)
+    : originalCurve_(h) {
+        if (!originalCurve_.empty())
+            enableExtrapolation(originalCurve_->allowsExtrapolation());
+        registerWith(originalCurve_);
+    }
+
+    inline DayCounter CachedDiscountCurve::dayCounter() const {
+        return originalCurve_->dayCounter();
+    }
+
+    inline Calendar CachedDiscountCurve::calendar() const {
+        return originalCurve_->calendar();
+    }
+
+    inline Natural CachedDiscountCurve::settlementDays() const {
+        return originalCurve_->settlementDays();
+    }
+
+    inline const Date& CachedDiscountCurve::referenceDate() const {
+        return originalCurve_->referenceDate();
+    }
+
+    inline Date CachedDiscountCurve::maxDate() const {
+        return originalCurve_->maxDate();
+    }
+
+    inline Time CachedDiscountCurve::maxTime() const {
+        return originalCurve_->maxTime();
+    }
+
+    inline void CachedDiscountCurve::update() {
+        // it dispatches notifications only if (!calculated_ && !frozen_)
+        LazyObject::update();
+        if (!originalCurve_.empty())
+            enableExtrapolation(originalCurve_->allowsExtrapolation());
+    }
+
+    inline Size CachedDiscountCurve::cachedDiscounts() const {
+        return calculated_ ? discounts_.size() : 0;
+    }
+
+    inline void CachedDiscountCurve::performCalculations() const {
+        discounts_.clear();
+    }
+
+    inline DiscountFactor CachedDiscountCurve::discountImpl(Time t) const {
+        calculate();
+        std::map<Time, DiscountFactor>::const_iterator i = discounts_.find(t);
+        if (i != discounts_.end())
+            return i->second;
+        DiscountFactor d = originalCurve_->discount(t, true);
+        discounts_.insert(std::make_pair(t, d));
+        return d;
+    }
+
+}
+
+
+#endif
@@ -27,6 +27,7 @@
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/time/daycounters/simpledaycounter.hpp>
 #include <boost/make_shared.hpp>
+#include <string>
 
 using boost::shared_ptr;
 using std::vector;
@@ -41,9 +42,30 @@ namespace QuantLib {
                        FittedBondDiscountCurve::FittingMethod* fittingMethod);
         Real value(const Array& x) const;
         Disposable<Array> values(const Array& x) const;
+        void gradient(Array& grad, const Array& x) const;
+        Real valueAndGradient(Array& grad, const Array& x) const;
+        void jacobian(Matrix& jac, const Array& x) const;
+        Disposable<Array> valuesAndJacobian(Matrix& jac,
+                                            const Array& x) const;
       private:
+        // reads the cashflows of the bonds
+        void setup();
+        // weighted price errors and, if a matrix is passed, their
+        // derivatives with respect to x
+        void errors(const Array& x, Array& errors, Matrix* jac) const;
+        void bondError(Size i, const Array& x, Array& errors, Matrix* jac,
+                       Array& discountGradient, Array& priceGradient) const;
         FittedBondDiscountCurve::FittingMethod* fittingMethod_;
-        mutable vector<Size> firstCashFlow_;
+        // cashflows of the i-th bond are in [firstCashFlow_[i],
+        // firstCashFlow_[i+1])
+        vector<Size> firstCashFlow_;
+        vector<Time> cashFlowTimes_;
+        vector<Real> cashFlowAmounts_;
+        // Null<Time>() if the bond settles at the reference date
+        vector<Time> settlementTimes_;
+        // accrued amount, or 0 for helpers quoting dirty prices
+        vector<Real> accruedAmounts_;
+        vector<Real> marketPrices_;
     };
 
 
@@ -143,19 +165,7 @@ namespace QuantLib {
 
         Size n = curve_->bondHelpers_.size();
         costFunction_ = shared_ptr<FittingCost>(new FittingCost(this));
-        costFunction_->firstCashFlow_.resize(n);
-
-        for (Size i=0; i<curve_->bondHelpers_.size(); ++i) {
-            shared_ptr<Bond> bond = curve_->bondHelpers_[i]->bond();
-            const Leg& cf = bond->cashflows();
-            Date bondSettlement = bond->settlementDate();
-            for (Size k=0; k<cf.size(); ++k) {
-                if (!cf[k]->hasOccurred(bondSettlement, false)) {
-                    costFunction_->firstCashFlow_[i] = k;
-                    break;
-                }
-            }
-        }
+        costFunction_->setup();
 
         if (calculateWeights_) {
             if (weights_.empty())
@@ -235,11 +245,149 @@ namespace QuantLib {
     }
 
 
+    void FittedBondDiscountCurve::FittingMethod::discountFunctionGradient(
+                                                    Array&, const Array&,
+                                                    Time) const {
+        QL_FAIL("discount-function gradient not implemented");
+    }
+
+
     FittedBondDiscountCurve::FittingMethod::FittingCost::FittingCost(
                         FittedBondDiscountCurve::FittingMethod* fittingMethod)
     : fittingMethod_(fittingMethod) {}
 
 
+    void FittedBondDiscountCurve::FittingMethod::FittingCost::setup() {
+        Date refDate  = fittingMethod_->curve_->referenceDate();
+        const DayCounter& dc = fittingMethod_->curve_->dayCounter();
+        const vector<shared_ptr<BondHelper> >& helpers =
+            fittingMethod_->curve_->bondHelpers_;
+        Size n = helpers.size();
+
+        firstCashFlow_.assign(1, 0);
+        cashFlowTimes_.clear();
+        cashFlowAmounts_.clear();
+        settlementTimes_.resize(n);
+        accruedAmounts_.resize(n);
+        marketPrices_.resize(n);
+
+        for (Size i=0; i<n; ++i) {
+            shared_ptr<Bond> bond = helpers[i]->bond();
+            Date bondSettlement = bond->settlementDate();
+
+            const Leg& cf = bond->cashflows();
+            for (Size k=0; k<cf.size(); ++k) {
+                if (!cf[k]->hasOccurred(bondSettlement, false)) {
+                    cashFlowTimes_.push_back(
+                                   dc.yearFraction(refDate, cf[k]->date()));
+                    cashFlowAmounts_.push_back(cf[k]->amount());
+                }
+            }
+            firstCashFlow_.push_back(cashFlowTimes_.size());
+
+            accruedAmounts_[i] = helpers[i]->useCleanPrice() ?
+                bond->accruedAmount(bondSettlement) : 0.0;
+            settlementTimes_[i] = bondSettlement != refDate ?
+                dc.yearFraction(refDate, bondSettlement) : Null<Time>();
+            marketPrices_[i] = helpers[i]->quote()->value();
+        }
+    }
+
+
+    void FittedBondDiscountCurve::FittingMethod::FittingCost::errors(
+                                                    const Array& x,
+                                                    Array& errors,
+                                                    Matrix* jac) const {
+        Size n = settlementTimes_.size(), m = x.size();
+        errors = Array(n);
+        if (jac)
+            *jac = Matrix(n, m);
+
+        if (!fittingMethod_->isThreadSafe()) {
+            Array d(m), s(m);
+            for (Size i=0; i<n; ++i)
+                bondError(i, x, errors, jac, d, s);
+            return;
+        }
+
+        // the bonds are independent and can be repriced concurrently;
+        // exceptions can't leave the parallel region, so they're
+        // collected and rethrown afterwards.
+        std::string error;
+        bool failed = false;
+        #pragma omp parallel
+        {
+            Array d(m), s(m);
+            #pragma omp for
+            for (Size i=0; i<n; ++i) {
+                try {
+                    bondError(i, x, errors, jac, d, s);
+                } catch (std::exception& e) {
+                    #pragma omp critical
+                    {
+                        failed = true;
+                        error = e.what();
+                    }
+                } catch (...) {
+                    #pragma omp critical
+                    {
+                        failed = true;
+                        error = "unknown error";
+                    }
+                }
+            }
+        }
+        QL_REQUIRE(!failed, error);
+    }
+
+
+    void FittedBondDiscountCurve::FittingMethod::FittingCost::bondError(
+                                                    Size i,
+                                                    const Array& x,
+                                                    Array& errors,
+                                                    Matrix* jac,
+                                                    Array& d,
+                                                    Array& s) const {
+        const FittingMethod& method = *fittingMethod_;
+        Size m = x.size();
+
+        // CleanPrice_i = sum( cf_k * d(t_k) ) - accruedAmount
+        Real modelPrice = 0.0;
+        if (jac)
+            std::fill(s.begin(), s.end(), 0.0);
+        for (Size k=firstCashFlow_[i]; k<firstCashFlow_[i+1]; ++k) {
+            Time t = cashFlowTimes_[k];
+            Real amount = cashFlowAmounts_[k];
+            modelPrice += amount * method.discountFunction(x, t);
+            if (jac) {
+                method.discountFunctionGradient(d, x, t);
+                for (Size j=0; j<m; ++j)
+                    s[j] += amount * d[j];
+            }
+        }
+        modelPrice -= accruedAmounts_[i];
+
+        // adjust price (NPV) for forward settlement
+        if (settlementTimes_[i] != Null<Time>()) {
+            Time t = settlementTimes_[i];
+            DiscountFactor ds = method.discountFunction(x, t);
+            modelPrice /= ds;
+            if (jac) {
+                method.discountFunctionGradient(d, x, t);
+                for (Size j=0; j<m; ++j)
+                    s[j] = (s[j] - modelPrice*d[j])/ds;
+            }
+        }
+
+        Real w = method.weights_[i];
+        errors[i] = w * (modelPrice - marketPrices_[i]);
+        if (jac) {
+            for (Size j=0; j<m; ++j)
+                (*jac)[i][j] = w * s[j];
+        }
+    }
+
+
     Real FittedBondDiscountCurve::FittingMethod::FittingCost::value(
                                                        const Array& x) const {
         Real squaredError = 0.0;
@@ -253,37 +401,58 @@ namespace QuantLib {
     Disposable<Array>
     FittedBondDiscountCurve::FittingMethod::FittingCost::values(
                                                        const Array &x) const {
-        Date refDate  = fittingMethod_->curve_->referenceDate();
-        const DayCounter& dc = fittingMethod_->curve_->dayCounter();
-        Size n = fittingMethod_->curve_->bondHelpers_.size();
-        Array values(n);
-        for (Size i=0; i<n; ++i) {
-            shared_ptr<BondHelper> helper =
-                fittingMethod_->curve_->bondHelpers_[i];
+        Array values;
+        errors(x, values, 0);
+        for (Size i=0; i<values.size(); ++i)
+            values[i] *= values[i];
+        return values;
+    }
 
-            shared_ptr<Bond> bond = helper->bond();
-            Date bondSettlement = bond->settlementDate();
+    void FittedBondDiscountCurve::FittingMethod::FittingCost::gradient(
+                                                        Array& grad,
+                                                        const Array& x) const {
+        valueAndGradient(grad, x);
+    }
 
-            // CleanPrice_i = sum( cf_k * d(t_k) ) - accruedAmount
-            Real modelPrice = 0.0;
-            const Leg& cf = bond->cashflows();
-            for (Size k=firstCashFlow_[i]; k<cf.size(); ++k) {
-                Time tenor = dc.yearFraction(refDate, cf[k]->date());
-                modelPrice += cf[k]->amount() *
-                                    fittingMethod_->discountFunction(x, tenor);
-            }
-            if (helper->useCleanPrice())
-                modelPrice -= bond->accruedAmount(bondSettlement);
+    Real FittedBondDiscountCurve::FittingMethod::FittingCost::valueAndGradient(
+                                                        Array& grad,
+                                                        const Array& x) const {
+        if (!fittingMethod_->hasDiscountFunctionGradient())
+            return CostFunction::valueAndGradient(grad, x);
 
-            // adjust price (NPV) for forward settlement
-            if (bondSettlement != refDate ) {
-                Time tenor = dc.yearFraction(refDate, bondSettlement);
-                modelPrice /= fittingMethod_->discountFunction(x, tenor);
-            }
-            Real marketPrice = helper->quote()->value();
-            Real error = modelPrice - marketPrice;
-            Real weightedError = fittingMethod_->weights_[i] * error;
-            values[i] = weightedError * weightedError;
+        Array e;
+        Matrix jac;
+        errors(x, e, &jac);
+        Real squaredError = 0.0;
+        std::fill(grad.begin(), grad.end(), 0.0);
+        for (Size i=0; i<e.size(); ++i) {
+            squaredError += e[i]*e[i];
+            for (Size j=0; j<grad.size(); ++j)
+                grad[j] += 2.0*e[i]*jac[i][j];
+        }
+        return squaredError;
+    }
+
+    void FittedBondDiscountCurve::FittingMethod::FittingCost::jacobian(
+                                                        Matrix& jac,
+                                                        const Array& x) const {
+        valuesAndJacobian(jac, x);
+    }
+
+    Disposable<Array>
+    FittedBondDiscountCurve::FittingMethod::FittingCost::valuesAndJacobian(
+                                                        Matrix& jac,
+                                                        const Array& x) const {
+        if (!fittingMethod_->hasDiscountFunctionGradient())
+            return CostFunction::valuesAndJacobian(jac, x);
+
+        Array values;
+        Matrix errorJacobian;
+        errors(x, values, &errorJacobian);
+        for (Size i=0; i<values.size(); ++i) {
+            for (Size j=0; j<x.size(); ++j)
+                jac[i][j] = 2.0*values[i]*errorJacobian[i][j];
+            values[i] *= values[i];
         }
         return values;
     }
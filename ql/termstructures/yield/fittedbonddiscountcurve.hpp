@@ -34,6 +34,8 @@
 
 namespace QuantLib {
 
+    class MarketCloner;
+
     //! Discount curve fitted to a set of fixed-coupon bonds
     /*! This class fits a discount function \f$ d(t) \f$ over a set of
         bonds, using a user defined fitting method. The discount
@@ -53,11 +55,17 @@ namespace QuantLib {
         compares various bond discount curve fitting methodologies
         \endlink
 
+        The cashflows of the bonds are read once at the start of each
+        fit; the cost function then only evaluates the discount
+        function at the precalculated cashflow times.
+
         \warning The method can be slow if there are many bonds to
                  fit. Speed also depends on the particular choice of
                  fitting method chosen and its convergence properties
-                 under optimization.  See also todo list for
-                 BondDiscountCurveFittingMethod.
+                 under optimization.  Fitting methods providing an
+                 analytic gradient are best used with a gradient-based
+                 optimization method such as BFGS.  See also todo list
+                 for BondDiscountCurveFittingMethod.
 
         \todo refactor the bond helper class so that it is pure
               virtual and returns a generic bond or its cash
@@ -131,6 +139,7 @@ namespace QuantLib {
         //@}
 
       private:
+        friend class MarketCloner;
         void setup();
         void performCalculations() const;
         DiscountFactor discountImpl(Time) const;
@@ -205,6 +214,16 @@ namespace QuantLib {
 		boost::shared_ptr<OptimizationMethod> optimizationMethod() const;
 		//! open discountFunction to public
 		DiscountFactor discount(const Array& x, Time t) const;
+        //! whether discountFunctionGradient() is implemented
+        virtual bool hasDiscountFunctionGradient() const { return false; }
+        //! open discountFunctionGradient to public
+        void discountGradient(Array& gradient,
+                              const Array& x, Time t) const;
+        //! whether discountFunction() can be called concurrently
+        /*! If true, the bonds are repriced in parallel during the
+            fit when the library is compiled with OpenMP support.
+        */
+        virtual bool isThreadSafe() const { return false; }
       protected:
         //! constructor
         FittingMethod(bool constrainAtZero = true, const Array& weights = Array(),
@@ -215,6 +234,16 @@ namespace QuantLib {
         //! discount function called by FittedBondDiscountCurve
         virtual DiscountFactor discountFunction(const Array& x,
                                                 Time t) const = 0;
+        //! gradient of the discount function with respect to x
+        /*! Fitting methods that implement it should also override
+            hasDiscountFunctionGradient(); the cost function will
+            then use it instead of finite differences, which makes
+            gradient-based optimization methods (e.g., BFGS) much
+            faster than the default Simplex.
+        */
+        virtual void discountFunctionGradient(Array& gradient,
+                                              const Array& x,
+                                              Time t) const;
 
         //! constrains discount function to unity at \f$ T=0 \f$, if true
         bool constrainAtZero_;
@@ -309,6 +338,11 @@ namespace QuantLib {
 		return discountFunction(x, t);
 	}
 
+    inline void FittedBondDiscountCurve::FittingMethod::discountGradient(
+                                 Array& gradient, const Array& x, Time t) const {
+        discountFunctionGradient(gradient, x, t);
+    }
+
 }
 
 #endif
@@ -31,6 +31,8 @@
 
 namespace QuantLib {
 
+    class MarketCloner;
+
     //! Flat interest-rate curve
     /*! \ingroup yieldtermstructures */
     class FlatForward : public YieldTermStructure,
@@ -76,6 +78,7 @@ namespace QuantLib {
         void update();
         //@}
       private:
+        friend class MarketCloner;
         //! \name LazyObject interface
         //@{
         void performCalculations() const;
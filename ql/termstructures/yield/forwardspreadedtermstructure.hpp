@@ -30,6 +30,8 @@
 
 namespace QuantLib {
 
+    class MarketCloner;
+
     //! Term structure with added spread on the instantaneous forward rate
     /*! \note This term structure will remain linked to the original
               structure, i.e., any changes in the latter will be
@@ -61,6 +63,7 @@ namespace QuantLib {
         void update();
         //@}
       protected:
+        friend class MarketCloner;
         //! \name ForwardRateStructure implementation
         //@{
         Rate forwardImpl(Time t) const;
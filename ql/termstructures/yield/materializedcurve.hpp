@@ -0,0 +1,252 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file materializedcurve.hpp
+    \brief interpolated copy of another term structure on a given grid
+*/
+
+#ifndef quantlib_materialized_curve_hpp
+#define quantlib_materialized_curve_hpp
+
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/termstructures/interpolatedcurve.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/patterns/lazyobject.hpp>
+
+namespace QuantLib {
+
+    //! Interpolated copy of another term structure on a given grid
+    /*! This term structure samples the discount factors of the
+        underlying curve on a grid of dates and interpolates them.
+        It is meant to replace a chain of spreaded or implied term
+        structures (e.g., a ZeroSpreadedTermStructure over an
+        ImpliedTermStructure over a PiecewiseYieldCurve) in
+        calculations requiring a large number of discount factors:
+        each of them is then obtained from a single interpolation,
+        instead of traversing the whole chain.
+
+        The grid is either a set of fixed dates or a set of tenors
+        from the reference date of the underlying curve.  The discount
+        factors are sampled again, lazily, as soon as a notification
+        is received from the underlying curve or its handle.  Beyond
+        the last grid date, forwards are extrapolated flat.
+
+        \note The result is only as accurate as the grid allows; the
+              discount factors are exact at the grid dates.
+
+        \ingroup yieldtermstructures
+
+        \test the discount factors are tested against those of the
+              underlying curve at and between the grid dates, and
+              after a change of the underlying data.
+    */
+    template <class Interpolator>
+    class InterpolatedMaterializedCurve
+        : public YieldTermStructure,
+          public LazyObject,
+          protected InterpolatedCurve<Interpolator> {
+      public:
+        InterpolatedMaterializedCurve(
+                            const Handle<YieldTermStructure>&,
+                            const std::vector<Date>& dates,
+                            const Interpolator& interpolator = Interpolator());
+        InterpolatedMaterializedCurve(
+                            const Handle<YieldTermStructure>&,
+                            const std::vector<Period>& tenors,
+                            const Interpolator& interpolator = Interpolator());
+        //! \name YieldTermStructure interface
+        //@{
+        DayCounter dayCounter() const;
+        Calendar calendar() const;
+        Natural settlementDays() const;
+        const Date& referenceDate() const;
+        Date maxDate() const;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Date>& dates() const;
+        const std::vector<Time>& times() const;
+        const std::vector<DiscountFactor>& discounts() const;
+        //@}
+      protected:
+        void performCalculations() const;
+        DiscountFactor discountImpl(Time) const;
+      private:
+        Handle<YieldTermStructure> originalCurve_;
+        std::vector<Date> fixedDates_;
+        std::vector<Period> tenors_;
+        mutable std::vector<Date> dates_;
+    };
+
+    //! Materialized curve based on log-linear interpolation of discounts
+    /*! \ingroup yieldtermstructures */
+    typedef InterpolatedMaterializedCurve<LogLinear> MaterializedCurve;
+
+
+    // inline definitions
+
+    template <class T>
+    InterpolatedMaterializedCurve<T>::InterpolatedMaterializedCurve(
+                                          const Handle<YieldTermStructure>& h,
+                                          const std::vector<Date>& dates,
+                                          const T& interpolator)
+    : InterpolatedCurve<T>(interpolator), originalCurve_(h),
+      fixedDates_(dates) {
+        QL_REQUIRE(!fixedDates_.empty(), "no dates given");
+        for (Size i=1; i<fixedDates_.size(); ++i)
+            QL_REQUIRE(fixedDates_[i] > fixedDates_[i-1],
+                       "dates not sorted or duplicated: "
+                       << fixedDates_[i-1] << ", " << fixedDates_[i]);
+        if (!originalCurve_.empty())
+            enableExtrapolation(originalCurve_->allowsExtrapolation());
+        registerWith(originalCurve_);
+    }
+
+    template <class T>
+    InterpolatedMaterializedCurve<T>::InterpolatedMaterializedCurve(
+                                          const Handle<YieldTermStructure>& h,
+                                          const std::vector<Period>& tenors,
+                                          const T& interpolator)
+    : InterpolatedCurve<T>(interpolator), originalCurve_(h),
+      tenors_(tenors) {
+        QL_REQUIRE(!tenors_.empty(), "no tenors given");
+        if (!originalCurve_.empty())
+            enableExtrapolation(originalCurve_->allowsExtrapolation());
+        registerWith(originalCurve_);
+    }
+
+    template <class T>
+    inline DayCounter InterpolatedMaterializedCurve<T>::dayCounter() const {
+        return originalCurve_->dayCounter();
+    }
+
+    template <class T>
+    inline Calendar InterpolatedMaterializedCurve<T>::calendar() const {
+        return originalCurve_->calendar();
+    }
+
+    template <class T>
+    inline Natural InterpolatedMaterializedCurve<T>::settlementDays() const {
+        return originalCurve_->settlementDays();
+    }
+
+    template <class T>
+    inline const Date&
+    InterpolatedMaterializedCurve<T>::referenceDate() const {
+        return originalCurve_->referenceDate();
+    }
+
+    template <class T>
+    inline Date InterpolatedMaterializedCurve<T>::maxDate() const {
+        calculate();
+        return std::min(originalCurve_->maxDate(), dates_.back());
+    }
+
+    template <class T>
+    inline void InterpolatedMaterializedCurve<T>::update() {
+        // it dispatches notifications only if (!calculated_ && !frozen_)
+        LazyObject::update();
+        if (!originalCurve_.empty())
+            enableExtrapolation(originalCurve_->allowsExtrapolation());
+    }
+
+    template <class T>
+    inline const std::vector<Date>&
+    InterpolatedMaterializedCurve<T>::dates() const {
+        calculate();
+        return dates_;
+    }
+
+    template <class T>
+    inline const std::vector<Time>&
+    InterpolatedMaterializedCurve<T>::times() const {
+        calculate();
+        return this->times_;
+    }
+
+    template <class T>
+    inline const std::vector<DiscountFactor>&
+    InterpolatedMaterializedCurve<T>::discounts() const {
+        calculate();
+        return this->data_;
+    }
+
+    template <class T>
+    void InterpolatedMaterializedCurve<T>::performCalculations() const {
+        QL_REQUIRE(!originalCurve_.empty(), "null underlying curve");
+
+        Date today = originalCurve_->referenceDate();
+        dates_.clear();
+        dates_.push_back(today);
+        if (tenors_.empty()) {
+            for (Size i=0; i<fixedDates_.size(); ++i)
+                if (fixedDates_[i] > today)
+                    dates_.push_back(fixedDates_[i]);
+        } else {
+            for (Size i=0; i<tenors_.size(); ++i) {
+                Date d = today + tenors_[i];
+                QL_REQUIRE(d > dates_.back(),
+                           "tenors not sorted or duplicated: "
+                           << tenors_[i] << " gives " << d
+                           << " after " << dates_.back());
+                dates_.push_back(d);
+            }
+        }
+        QL_REQUIRE(dates_.size() > 1,
+                   "no grid date after the reference date " << today);
+
+        this->times_.resize(dates_.size());
+        this->data_.resize(dates_.size());
+        this->times_[0] = 0.0;
+        this->data_[0] = 1.0;
+        for (Size i=1; i<dates_.size(); ++i) {
+            this->times_[i] = originalCurve_->timeFromReference(dates_[i]);
+            QL_REQUIRE(this->times_[i] > this->times_[i-1],
+                       "dates " << dates_[i-1] << " and " << dates_[i]
+                       << " correspond to the same time");
+            this->data_[i] = originalCurve_->discount(this->times_[i], true);
+        }
+
+        this->interpolation_ =
+            this->interpolator_.interpolate(this->times_.begin(),
+                                            this->times_.end(),
+                                            this->data_.begin());
+        this->interpolation_.update();
+    }
+
+    template <class T>
+    DiscountFactor
+    InterpolatedMaterializedCurve<T>::discountImpl(Time t) const {
+        calculate();
+        if (t <= this->times_.back())
+            return this->interpolation_(t, true);
+
+        // flat fwd extrapolation
+        Time tMax = this->times_.back();
+        DiscountFactor dMax = this->data_.back();
+        Rate instFwdMax = - this->interpolation_.derivative(tMax) / dMax;
+        return dMax * std::exp(- instFwdMax * (t-tMax));
+    }
+
+}
+
+
+#endif
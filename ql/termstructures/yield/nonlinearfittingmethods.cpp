@@ -64,6 +64,32 @@ namespace QuantLib {
         return d;
     }
 
+    void ExponentialSplinesFitting::discountFunctionGradient(Array& gradient,
+                                                             const Array& x,
+                                                             Time t) const {
+        Size N = size();
+        Real kappa = x[N-1];
+        gradient[N-1] = 0.0;
+
+        if (!constrainAtZero_) {
+            for (Size i=0; i<N-1; ++i) {
+                Real e = std::exp(-kappa * (i+1) * t);
+                gradient[i] = e;
+                gradient[N-1] -= x[i] * (i+1) * t * e;
+            }
+        } else {
+            Real e1 = std::exp(-kappa * t);
+            Real coeff = 1.0;
+            for (Size i=0; i<N-1; i++) {
+                Real e = std::exp(-kappa * (i+2) * t);
+                gradient[i] = e - e1;
+                gradient[N-1] -= x[i] * (i+2) * t * e;
+                coeff -= x[i];
+            }
+            gradient[N-1] -= coeff * t * e1;
+        }
+    }
+
 
 
     NelsonSiegelFitting::NelsonSiegelFitting(const Array& weights,
@@ -91,6 +117,23 @@ namespace QuantLib {
         return d;
     }
 
+    void NelsonSiegelFitting::discountFunctionGradient(Array& gradient,
+                                                       const Array& x,
+                                                       Time t) const {
+        Real kappa = x[size()-1];
+        Real e = std::exp(-kappa*t);
+        Real a = (kappa+QL_EPSILON)*(t+QL_EPSILON);
+        Real g = (1.0 - e)/a;
+        Real zeroRate = x[0] + (x[1] + x[2])*g - x[2]*e;
+        // d(discount)/dx = -t * discount * d(zeroRate)/dx
+        Real f = -t * std::exp(-zeroRate * t);
+        Real dg = t*e/a - g/(kappa+QL_EPSILON);
+        gradient[0] = f;
+        gradient[1] = f * g;
+        gradient[2] = f * (g - e);
+        gradient[3] = f * ((x[1] + x[2])*dg + x[2]*t*e);
+    }
+
 
     SvenssonFitting::SvenssonFitting(const Array& weights,
                                      boost::shared_ptr<OptimizationMethod> optimizationMethod)
@@ -120,6 +163,28 @@ namespace QuantLib {
         return d;
     }
 
+    void SvenssonFitting::discountFunctionGradient(Array& gradient,
+                                                   const Array& x,
+                                                   Time t) const {
+        Real kappa = x[size()-2];
+        Real kappa_1 = x[size()-1];
+        Real e = std::exp(-kappa*t), e_1 = std::exp(-kappa_1*t);
+        Real a = (kappa+QL_EPSILON)*(t+QL_EPSILON);
+        Real a_1 = (kappa_1+QL_EPSILON)*(t+QL_EPSILON);
+        Real g = (1.0 - e)/a, g_1 = (1.0 - e_1)/a_1;
+        Real zeroRate = x[0] + (x[1] + x[2])*g - x[2]*e + x[3]*(g_1 - e_1);
+        // d(discount)/dx = -t * discount * d(zeroRate)/dx
+        Real f = -t * std::exp(-zeroRate * t);
+        Real dg = t*e/a - g/(kappa+QL_EPSILON);
+        Real dg_1 = t*e_1/a_1 - g_1/(kappa_1+QL_EPSILON);
+        gradient[0] = f;
+        gradient[1] = f * g;
+        gradient[2] = f * (g - e);
+        gradient[3] = f * (g_1 - e_1);
+        gradient[4] = f * ((x[1] + x[2])*dg + x[2]*t*e);
+        gradient[5] = f * x[3] * (dg_1 + t*e_1);
+    }
+
 
 
     CubicBSplinesFitting::CubicBSplinesFitting(const std::vector<Time>& knots,
@@ -190,6 +255,22 @@ namespace QuantLib {
         return d;
     }
 
+    void CubicBSplinesFitting::discountFunctionGradient(Array& gradient,
+                                                        const Array&,
+                                                        Time t) const {
+        if (!constrainAtZero_) {
+            for (Size i=0; i<size_; ++i)
+                gradient[i] = splines_(i,t);
+        } else {
+            const Real T = 0.0;
+            Real n = splines_(N_,t)/splines_(N_,T);
+            for (Size i=0; i<size_; ++i) {
+                Natural j = i < N_ ? i : i+1;
+                gradient[i] = splines_(j,t) - splines_(j,T)*n;
+            }
+        }
+    }
+
 
     SimplePolynomialFitting::SimplePolynomialFitting(Natural degree,
                                                      bool constrainAtZero,
@@ -222,6 +303,17 @@ namespace QuantLib {
         }
         return d;
     }
+
+    void SimplePolynomialFitting::discountFunctionGradient(Array& gradient,
+                                                           const Array&,
+                                                           Time t) const {
+        for (Size i=0; i<size_; ++i) {
+            if (!constrainAtZero_)
+                gradient[i] = BernsteinPolynomial::get(i,i,t);
+            else
+                gradient[i] = BernsteinPolynomial::get(i+1,i+1,t);
+        }
+    }
 	
 	SpreadFittingMethod::SpreadFittingMethod(boost::shared_ptr<FittingMethod> method,
                         Handle<YieldTermStructure> discountCurve)
@@ -246,6 +338,17 @@ namespace QuantLib {
         return method_->discount(x, t)*discountingCurve_->discount(t, true)/rebase_;
     }
 
+    bool SpreadFittingMethod::hasDiscountFunctionGradient() const {
+        return method_->hasDiscountFunctionGradient();
+    }
+
+    void SpreadFittingMethod::discountFunctionGradient(Array& gradient,
+                                                       const Array& x,
+                                                       Time t) const {
+        method_->discountGradient(gradient, x, t);
+        gradient *= discountingCurve_->discount(t, true)/rebase_;
+    }
+
 	void SpreadFittingMethod::init(){
 		//In case discount curve has a different reference date,
 		//discount to this curve's reference date
@@ -51,9 +51,13 @@ namespace QuantLib {
                                   boost::shared_ptr<OptimizationMethod> optimizationMethod
                                           = boost::shared_ptr<OptimizationMethod>());
         std::auto_ptr<FittedBondDiscountCurve::FittingMethod> clone() const;
+        bool hasDiscountFunctionGradient() const { return true; }
+        bool isThreadSafe() const { return true; }
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(Array& gradient,
+                                      const Array& x, Time t) const;
     };
 
 
@@ -74,9 +78,13 @@ namespace QuantLib {
                             boost::shared_ptr<OptimizationMethod> optimizationMethod
                                           = boost::shared_ptr<OptimizationMethod>());
         std::auto_ptr<FittedBondDiscountCurve::FittingMethod> clone() const;
+        bool hasDiscountFunctionGradient() const { return true; }
+        bool isThreadSafe() const { return true; }
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(Array& gradient,
+                                      const Array& x, Time t) const;
     };
 
 
@@ -99,9 +107,13 @@ namespace QuantLib {
                         boost::shared_ptr<OptimizationMethod> optimizationMethod
                                = boost::shared_ptr<OptimizationMethod>());
         std::auto_ptr<FittedBondDiscountCurve::FittingMethod> clone() const;
+        bool hasDiscountFunctionGradient() const { return true; }
+        bool isThreadSafe() const { return true; }
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(Array& gradient,
+                                      const Array& x, Time t) const;
     };
 
 
@@ -135,9 +147,13 @@ namespace QuantLib {
         //! cubic B-spline basis functions
         Real basisFunction(Integer i, Time t) const;
         std::auto_ptr<FittedBondDiscountCurve::FittingMethod> clone() const;
+        bool hasDiscountFunctionGradient() const { return true; }
+        bool isThreadSafe() const { return true; }
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(Array& gradient,
+                                      const Array& x, Time t) const;
         BSpline splines_;
         Size size_;
         //! N_th basis function coefficient to solve for when d(0)=1
@@ -164,9 +180,13 @@ namespace QuantLib {
                                 boost::shared_ptr<OptimizationMethod> optimizationMethod
                                        = boost::shared_ptr<OptimizationMethod>());
         std::auto_ptr<FittedBondDiscountCurve::FittingMethod> clone() const;
+        bool hasDiscountFunctionGradient() const { return true; }
+        bool isThreadSafe() const { return true; }
       private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(Array& gradient,
+                                      const Array& x, Time t) const;
         Size size_;
     };
 
@@ -180,11 +200,14 @@ namespace QuantLib {
          SpreadFittingMethod(boost::shared_ptr<FittingMethod> method,
                         Handle<YieldTermStructure> discountCurve);
         std::auto_ptr<FittedBondDiscountCurve::FittingMethod> clone() const;
+        bool hasDiscountFunctionGradient() const;
 	protected:
 		void init();
 	  private:
         Size size() const;
         DiscountFactor discountFunction(const Array& x, Time t) const;
+        void discountFunctionGradient(Array& gradient,
+                                      const Array& x, Time t) const;
 		// underlying parametric method
 		boost::shared_ptr<FittingMethod> method_;
         // adjustment in case underlying discount curve has different reference date
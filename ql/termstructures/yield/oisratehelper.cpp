@@ -21,6 +21,7 @@
 #include <ql/termstructures/yield/oisratehelper.hpp>
 #include <ql/instruments/makeois.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/cashflows/overnightindexedcoupon.hpp>
 
 #include <ql/utilities/null_deleter.hpp>
 
@@ -28,6 +29,74 @@ using boost::shared_ptr;
 
 namespace QuantLib {
 
+    namespace detail {
+
+        OISQuoteTable::OISQuoteTable(const OvernightIndexedSwap& swap) {
+            const Leg& fixedLeg = swap.fixedLeg();
+            fixedPaymentDates_.reserve(fixedLeg.size());
+            fixedAccruals_.reserve(fixedLeg.size());
+            for (Size i=0; i<fixedLeg.size(); ++i) {
+                shared_ptr<Coupon> c =
+                    boost::dynamic_pointer_cast<Coupon>(fixedLeg[i]);
+                QL_REQUIRE(c, "fixed-rate coupon expected");
+                fixedPaymentDates_.push_back(c->date());
+                fixedAccruals_.push_back(c->nominal()*c->accrualPeriod());
+            }
+
+            const Leg& overnightLeg = swap.overnightLeg();
+            Size n = overnightLeg.size();
+            QL_REQUIRE(n > 0, "no overnight coupons given");
+            paymentDates_.reserve(n);
+            startDates_.reserve(n);
+            endDates_.reserve(n);
+            nominals_.reserve(n);
+            spreadAmounts_.reserve(n);
+            for (Size i=0; i<n; ++i) {
+                shared_ptr<OvernightIndexedCoupon> c =
+                    boost::dynamic_pointer_cast<OvernightIndexedCoupon>(
+                                                          overnightLeg[i]);
+                QL_REQUIRE(c, "overnight-indexed coupon expected");
+                paymentDates_.push_back(c->date());
+                startDates_.push_back(c->startValueDate());
+                endDates_.push_back(c->endValueDate());
+                nominals_.push_back(c->nominal()*c->gearing());
+                spreadAmounts_.push_back(
+                               c->nominal()*c->spread()*c->accrualPeriod());
+                if (i == 0 || c->firstFixingDate() < firstDate_)
+                    firstDate_ = c->firstFixingDate();
+            }
+            for (Size i=0; i<fixedPaymentDates_.size(); ++i)
+                firstDate_ = std::min(firstDate_, fixedPaymentDates_[i]);
+        }
+
+        bool OISQuoteTable::forecastOnly(const Date& today) const {
+            // the fixing dates precede the overnight payments
+            return !paymentDates_.empty() && firstDate_ > today;
+        }
+
+        Rate OISQuoteTable::fairRate(
+                              const YieldTermStructure& forwarding,
+                              const YieldTermStructure& discounting) const {
+            // same as the fixed rate minus NPV/(BPS/basisPoint) of
+            // the swap, whose fixed rate is null; the discount at the
+            // NPV date cancels out.
+            Real annuity = 0.0;
+            for (Size i=0; i<fixedPaymentDates_.size(); ++i)
+                annuity += fixedAccruals_[i] *
+                           discounting.discount(fixedPaymentDates_[i]);
+            Real overnightNPV = 0.0;
+            for (Size i=0; i<paymentDates_.size(); ++i) {
+                Real compoundFactor = forwarding.discount(startDates_[i]) /
+                                      forwarding.discount(endDates_[i]);
+                overnightNPV +=
+                    (nominals_[i]*(compoundFactor - 1.0) + spreadAmounts_[i])
+                    * discounting.discount(paymentDates_[i]);
+            }
+            return overnightNPV/annuity;
+        }
+
+    }
+
     OISRateHelper::OISRateHelper(
                     Natural settlementDays,
                     const Period& tenor, // swap maturity
@@ -59,6 +128,7 @@ namespace QuantLib {
             .withDiscountingTermStructure(discountRelinkableHandle_)
             .withSettlementDays(settlementDays_)
             .withTelescopicValueDates(telescopicValueDates_);
+        table_ = detail::OISQuoteTable(*swap_);
 
         earliestDate_ = swap_->startDate();
         latestDate_ = swap_->maturityDate();
@@ -82,6 +152,9 @@ namespace QuantLib {
 
     Real OISRateHelper::impliedQuote() const {
         QL_REQUIRE(termStructure_ != 0, "term structure not set");
+        if (table_.forecastOnly(Settings::instance().evaluationDate()))
+            return table_.fairRate(*termStructure_,
+                                   **discountRelinkableHandle_);
         // we didn't register as observers - force calculation
         swap_->recalculate();
         return swap_->fairRate();
@@ -123,6 +196,7 @@ namespace QuantLib {
             .withEffectiveDate(startDate)
             .withTerminationDate(endDate)
             .withTelescopicValueDates(telescopicValueDates_);
+        table_ = detail::OISQuoteTable(*swap_);
 
         earliestDate_ = swap_->startDate();
         latestDate_ = swap_->maturityDate();
@@ -146,6 +220,9 @@ namespace QuantLib {
 
     Real DatedOISRateHelper::impliedQuote() const {
         QL_REQUIRE(termStructure_ != 0, "term structure not set");
+        if (table_.forecastOnly(Settings::instance().evaluationDate()))
+            return table_.fairRate(*termStructure_,
+                                   **discountRelinkableHandle_);
         // we didn't register as observers - force calculation
         swap_->recalculate();
         return swap_->fairRate();
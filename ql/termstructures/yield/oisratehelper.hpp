@@ -30,7 +30,45 @@
 
 namespace QuantLib {
 
+    namespace detail {
+
+        //! dates and amounts needed for the fair rate of an OIS
+        /*! The fair rate is obtained from the discount factors at the
+            payment dates and from the forwarding discount factors at
+            the first and last value dates of each overnight coupon,
+            as done by the coupon pricer when no fixing is in the
+            past; no cashflow is walked or priced.
+        */
+        class OISQuoteTable {
+          public:
+            OISQuoteTable() {}
+            explicit OISQuoteTable(const OvernightIndexedSwap& swap);
+            //! whether the fair rate can be calculated from the table
+            /*! This is not the case when some of the fixings are in
+                the past, or when some cashflow has already been paid.
+            */
+            bool forecastOnly(const Date& today) const;
+            Rate fairRate(const YieldTermStructure& forwarding,
+                          const YieldTermStructure& discounting) const;
+          private:
+            Date firstDate_;
+            // fixed leg: payment dates and nominal times accrual
+            std::vector<Date> fixedPaymentDates_;
+            std::vector<Real> fixedAccruals_;
+            // overnight leg: payment and value dates, nominal times
+            // gearing, and nominal times spread times accrual
+            std::vector<Date> paymentDates_, startDates_, endDates_;
+            std::vector<Real> nominals_, spreadAmounts_;
+        };
+
+    }
+
     //! Rate helper for bootstrapping over Overnight Indexed Swap rates
+    /*! The swap is built when the dates are initialized; during the
+        bootstrap, its fair rate is calculated from a compact table of
+        its payment dates, value dates and accruals unless some of its
+        fixings are in the past.
+    */
     class OISRateHelper : public RelativeDateRateHelper {
       public:
         OISRateHelper(Natural settlementDays,
@@ -67,9 +105,11 @@ namespace QuantLib {
         Handle<YieldTermStructure> discountHandle_;
         bool telescopicValueDates_;
         RelinkableHandle<YieldTermStructure> discountRelinkableHandle_;
+        detail::OISQuoteTable table_;
     };
 
     //! Rate helper for bootstrapping over Overnight Indexed Swap rates
+    /*! The fair rate is calculated as in OISRateHelper. */
     class DatedOISRateHelper : public RateHelper {
       public:
         DatedOISRateHelper(
@@ -97,6 +137,7 @@ namespace QuantLib {
         Handle<YieldTermStructure> discountHandle_;
         bool telescopicValueDates_;
         RelinkableHandle<YieldTermStructure> discountRelinkableHandle_;
+        detail::OISQuoteTable table_;
     };
 
 }
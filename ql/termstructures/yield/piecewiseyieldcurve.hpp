@@ -28,12 +28,15 @@
 
 #include <ql/termstructures/iterativebootstrap.hpp>
 #include <ql/termstructures/localbootstrap.hpp>
+#include <ql/termstructures/globalbootstrap.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
 
 namespace QuantLib {
 
     class MultiCurveSensitivities;
+    class MarketCloner;
+    class MarketSnapshot;
 
     //! Piecewise yield term structure
     /*! This term structure is bootstrapped on a number of interest
@@ -169,6 +172,14 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Inspectors
+        //@{
+        //! bootstrap helpers (sorted by pillar once bootstrapped)
+        const std::vector<boost::shared_ptr<typename Traits::helper> >&
+        instruments() const {
+            return instruments_;
+        }
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -189,6 +200,8 @@ namespace QuantLib {
         // it would increase the complexity---which is high enough
         // already.
         friend class MultiCurveSensitivities;
+        friend class MarketCloner;
+        friend class MarketSnapshot;
         friend class Bootstrap<this_curve>;
         friend class BootstrapError<this_curve> ;
         friend class PenaltyFunction<this_curve>;
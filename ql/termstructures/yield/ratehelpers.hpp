@@ -40,6 +40,7 @@ namespace QuantLib {
 
     class SwapIndex;
     class Quote;
+    class MarketCloner;
 
     typedef BootstrapHelper<YieldTermStructure> RateHelper;
     typedef RelativeDateBootstrapHelper<YieldTermStructure>
@@ -137,6 +138,7 @@ namespace QuantLib {
         void accept(AcyclicVisitor&);
         //@}
       private:
+        friend class MarketCloner;
         void initializeDates();
         Date fixingDate_;
         boost::shared_ptr<IborIndex> iborIndex_;
@@ -217,6 +219,7 @@ namespace QuantLib {
         void accept(AcyclicVisitor&);
         //@}
       private:
+        friend class MarketCloner;
         void initializeDates();
         Date fixingDate_;
         Period periodToStart_;
@@ -298,6 +301,7 @@ namespace QuantLib {
         void accept(AcyclicVisitor&);
         //@}
       protected:
+        friend class MarketCloner;
         void initializeDates();
         Natural settlementDays_;
         Period tenor_;
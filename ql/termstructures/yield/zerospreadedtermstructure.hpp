@@ -30,6 +30,8 @@
 
 namespace QuantLib {
 
+    class MarketCloner;
+
     //! Term structure with an added spread on the zero yield rate
     /*! \note This term structure will remain linked to the original
               structure, i.e., any changes in the latter will be
@@ -64,6 +66,7 @@ namespace QuantLib {
         void update();
         //@}
       protected:
+        friend class MarketCloner;
         //! returns the spreaded zero yield rate
         Rate zeroYieldImpl(Time) const;
         //! returns the spreaded forward rate
@@ -21,12 +21,24 @@
 
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
     namespace {
         // time interval used in finite differences
         const Time dt = 0.0001;
+
+        class DateIndexSorter {
+          public:
+            explicit DateIndexSorter(const std::vector<Date>& dates)
+            : dates_(dates) {}
+            bool operator()(Size i, Size j) const {
+                return dates_[i] < dates_[j];
+            }
+          private:
+            const std::vector<Date>& dates_;
+        };
     }
 
     YieldTermStructure::YieldTermStructure(
@@ -113,6 +125,45 @@ namespace QuantLib {
         return jumpEffect * discountImpl(t);
     }
 
+    void YieldTermStructure::discounts(const std::vector<Date>& dates,
+                                       Array& result,
+                                       bool extrapolate) const {
+        Size n = dates.size();
+        if (result.size() != n)
+            result = Array(n);
+        if (n == 0)
+            return;
+
+        std::vector<Size> order(n);
+        for (Size i=0; i<n; ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), DateIndexSorter(dates));
+
+        // the valid range is an interval; checking its ends is enough
+        checkRange(dates[order.front()], extrapolate);
+        checkRange(dates[order.back()], extrapolate);
+
+        // times of the distinct dates, calculated in one batch
+        std::vector<Date> distinct;
+        distinct.reserve(n);
+        for (Size k=0; k<n; ++k) {
+            if (k == 0 || dates[order[k]] != distinct.back())
+                distinct.push_back(dates[order[k]]);
+        }
+        std::vector<Date> references(distinct.size(), referenceDate());
+        std::vector<Time> times(distinct.size());
+        dayCounter().yearFractions(&references[0], &distinct[0],
+                                   &times[0], distinct.size());
+
+        Size j = 0;
+        DiscountFactor d = discount(times[0], true);
+        for (Size k=0; k<n; ++k) {
+            if (dates[order[k]] != distinct[j])
+                d = discount(times[++j], true);
+            result[order[k]] = d;
+        }
+    }
+
     InterestRate YieldTermStructure::zeroRate(const Date& d,
                                               const DayCounter& dayCounter,
                                               Compounding comp,
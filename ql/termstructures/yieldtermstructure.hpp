@@ -29,6 +29,7 @@
 #include <ql/termstructure.hpp>
 #include <ql/interestrate.hpp>
 #include <ql/quote.hpp>
+#include <ql/math/array.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -77,6 +78,14 @@ namespace QuantLib {
         */
         DiscountFactor discount(Time t,
                                 bool extrapolate = false) const;
+        /*! Returns in the passed array the discount factors for the
+            given dates, which don't need to be sorted.  The range
+            check and the time calculation are performed once for
+            each distinct date.
+        */
+        void discounts(const std::vector<Date>& dates,
+                       Array& result,
+                       bool extrapolate = false) const;
         //@}
 
         /*! \name Zero-yield rates
@@ -148,6 +157,7 @@ namespace QuantLib {
 
         //! \name Jump inspectors
         //@{
+        const std::vector<Handle<Quote> >& jumps() const;
         const std::vector<Date>& jumpDates() const;
         const std::vector<Time>& jumpTimes() const;
         //@}
@@ -197,6 +207,11 @@ namespace QuantLib {
         return forwardRate(d, d+p, dayCounter, comp, freq, extrapolate);
     }
 
+    inline const std::vector<Handle<Quote> >&
+    YieldTermStructure::jumps() const {
+        return this->jumps_;
+    }
+
     inline const std::vector<Date>& YieldTermStructure::jumpDates() const {
         return this->jumpDates_;
     }
@@ -22,9 +22,113 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
+#ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#endif
 
 namespace QuantLib {
 
+    namespace {
+
+        // incremented whenever a calendar is modified; caches built
+        // for a previous version are discarded, which also takes care
+        // of joint calendars built over the modified one
+        unsigned long businessDaysVersion = 1;
+
+        #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        // guards the version above and the caches of all calendars,
+        // which are shared among copies and possibly among threads
+        boost::mutex businessDaysMutex;
+        #endif
+
+        const boost::uint64_t one = 1;
+
+        Integer popcount(boost::uint64_t x) {
+            x = x - ((x >> 1) & UINT64_C(0x5555555555555555));
+            x = (x & UINT64_C(0x3333333333333333))
+                + ((x >> 2) & UINT64_C(0x3333333333333333));
+            x = (x + (x >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+            return Integer((x * UINT64_C(0x0101010101010101)) >> 56);
+        }
+
+    }
+
+    Integer Calendar::BusinessDays::rank(Day i) const {
+        return before[i/64] + popcount(bits[i/64] & ((one << (i%64)) - 1));
+    }
+
+    const Calendar::BusinessDays&
+    Calendar::Impl::businessDays(Year y) const {
+        #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        boost::lock_guard<boost::mutex> lock(businessDaysMutex);
+        #endif
+        if (cacheVersion_ != businessDaysVersion) {
+            cache_.clear();
+            cache_.resize(Date::maxDate().year()-Date::minDate().year()+1);
+            cacheVersion_ = businessDaysVersion;
+        }
+        QL_REQUIRE(y >= Date::minDate().year() && y <= Date::maxDate().year(),
+                   "year " << y << " out of bound. It must be in ["
+                   << Date::minDate().year() << ","
+                   << Date::maxDate().year() << "]");
+        boost::shared_ptr<BusinessDays>& b = cache_[y-Date::minDate().year()];
+        if (!b) {
+            boost::shared_ptr<BusinessDays> data(new BusinessDays);
+            std::fill(data->bits, data->bits+6, boost::uint64_t(0));
+            fillBusinessDays(y, data->bits);
+
+            // removed holidays first, so that added ones take precedence
+            Date first(1, January, y), last(31, December, y);
+            std::set<Date>::const_iterator i;
+            for (i = removedHolidays.lower_bound(first);
+                 i != removedHolidays.end() && *i <= last; ++i) {
+                Day k = i->dayOfYear()-1;
+                data->bits[k/64] |= one << (k%64);
+            }
+            for (i = addedHolidays.lower_bound(first);
+                 i != addedHolidays.end() && *i <= last; ++i) {
+                Day k = i->dayOfYear()-1;
+                data->bits[k/64] &= ~(one << (k%64));
+            }
+
+            data->before[0] = 0;
+            for (Size w=1; w<6; ++w)
+                data->before[w] = data->before[w-1]
+                                + popcount(data->bits[w-1]);
+            Day n = Date::isLeap(y) ? 366 : 365;
+            data->days.reserve(data->before[5] + popcount(data->bits[5]));
+            for (Day k=0; k<n; ++k)
+                if (data->isBusinessDay(k))
+                    data->days.push_back(k);
+            b = data;
+        }
+        return *b;
+    }
+
+    void Calendar::Impl::fillBusinessDays(Year y,
+                                          boost::uint64_t bits[6]) const {
+        Date first(1, January, y);
+        Day n = Date::isLeap(y) ? 366 : 365;
+        for (Day k=0; k<n; ++k)
+            if (isBusinessDay(first + k))
+                bits[k/64] |= one << (k%64);
+    }
+
+    void Calendar::Impl::resetBusinessDays() {
+        #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        boost::lock_guard<boost::mutex> lock(businessDaysMutex);
+        #endif
+        ++businessDaysVersion;
+    }
+
+    const Calendar::BusinessDays& Calendar::businessDays(const Calendar& c,
+                                                         Year y) {
+        QL_REQUIRE(c.impl_, "no implementation provided");
+        return c.impl_->businessDays(y);
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no implementation provided");
         // if d was a genuine holiday previously removed, revert the change
@@ -33,6 +137,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(d))
             impl_->addedHolidays.insert(d);
+        Impl::resetBusinessDays();
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -43,6 +148,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(d))
             impl_->removedHolidays.insert(d);
+        Impl::resetBusinessDays();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -99,23 +205,27 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
-            Date d1 = d;
+            QL_REQUIRE(impl_, "no implementation provided");
+            // find the position of the target among the business
+            // days of the year, moving to other years as needed
+            Year y = d.year();
+            Day i = d.dayOfYear()-1;
+            const BusinessDays* b = &impl_->businessDays(y);
+            Integer k;
             if (n > 0) {
-                while (n > 0) {
-                    d1++;
-                    while (isHoliday(d1))
-                        d1++;
-                    n--;
+                k = b->rank(i) + (b->isBusinessDay(i) ? 1 : 0) + n - 1;
+                while (k >= Integer(b->days.size())) {
+                    k -= Integer(b->days.size());
+                    b = &impl_->businessDays(++y);
                 }
             } else {
-                while (n < 0) {
-                    d1--;
-                    while(isHoliday(d1))
-                        d1--;
-                    n++;
+                k = b->rank(i) + n;
+                while (k < 0) {
+                    b = &impl_->businessDays(--y);
+                    k += Integer(b->days.size());
                 }
             }
-            return d1;
+            return Date(1, January, y) + b->days[k];
         } else if (unit == Weeks) {
             Date d1 = d + n*unit;
             return adjust(d1,c);
@@ -143,23 +253,19 @@ namespace QuantLib {
                                                     bool includeLast) const {
         Date::serial_type wd = 0;
         if (from != to) {
-            if (from < to) {
-                // the last one is treated separately to avoid
-                // incrementing Date::maxDate()
-                for (Date d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (Date d = to; d < from; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(from))
-                    ++wd;
-            }
+            QL_REQUIRE(impl_, "no implementation provided");
+            // business days between the earlier and the later date,
+            // both included
+            const Date& d1 = std::min(from, to);
+            const Date& d2 = std::max(from, to);
+            Year y1 = d1.year(), y2 = d2.year();
+            Day i1 = d1.dayOfYear()-1, i2 = d2.dayOfYear()-1;
+            const BusinessDays& b1 = impl_->businessDays(y1);
+            wd = -b1.rank(i1);
+            for (Year y = y1; y < y2; ++y)
+                wd += impl_->businessDays(y).days.size();
+            const BusinessDays& b2 = impl_->businessDays(y2);
+            wd += b2.rank(i2) + (b2.isBusinessDay(i2) ? 1 : 0);
 
             if (isBusinessDay(from) && !includeFirst)
                 wd--;
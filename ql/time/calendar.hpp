@@ -30,6 +30,7 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
 #include <set>
 #include <vector>
 #include <string>
@@ -50,6 +51,27 @@ namespace QuantLib {
         or for general country holiday schedule. Legacy city holiday schedule
         calendars will be moved to the exchange/country convention.
 
+        Business days are cached in a per-year bitmap, built on first
+        use; this makes business-day counts and day-based advances of
+        any length run in constant time per year spanned.  The cache
+        is shared by all the copies of a calendar and is discarded
+        whenever holidays are added or removed.
+
+        \warning the cache assumes that the business days returned by
+                 Impl::isBusinessDay() never change; implementations
+                 with mutable rules must call Impl::resetBusinessDays()
+                 after modifying them.
+
+        \warning the cache is built lazily from const methods.  When
+                 QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN is defined, its
+                 construction is serialized by a lock and calendars
+                 (and their copies) can be queried from several
+                 threads; otherwise, a calendar must not be used
+                 concurrently from different threads.  In either case,
+                 holidays must not be added or removed while the
+                 calendar (or any other calendar) is being used by
+                 another thread.
+
         \ingroup datetime
 
         \test the methods for adding and removing holidays are tested
@@ -58,16 +80,49 @@ namespace QuantLib {
     */
     class Calendar {
       protected:
+        //! business days of a year
+        struct BusinessDays {
+            //! one bit per day, starting from January 1st
+            boost::uint64_t bits[6];
+            //! number of business days before each word of bits
+            Integer before[6];
+            //! days of the year (0-based) of each business day, in order
+            std::vector<Day> days;
+            //! whether the given day of the year (0-based) is a business day
+            bool isBusinessDay(Day i) const {
+                return ((bits[i/64] >> (i%64)) & 1) != 0;
+            }
+            //! number of business days before the given day of the year
+            Integer rank(Day i) const;
+        };
         //! abstract base class for calendar implementations
         class Impl {
           public:
+            Impl() : cacheVersion_(0) {}
             virtual ~Impl() {}
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
             std::set<Date> addedHolidays, removedHolidays;
+            //! business days of the given year, built on demand
+            const BusinessDays& businessDays(Year) const;
+            //! discards the cached business days of all calendars
+            static void resetBusinessDays();
+          protected:
+            /*! sets the bits corresponding to the business days of the
+                given year; added and removed holidays are applied
+                afterwards.  The default implementation calls
+                isBusinessDay() for each day of the year.
+            */
+            virtual void fillBusinessDays(Year,
+                                          boost::uint64_t bits[6]) const;
+          private:
+            mutable std::vector<boost::shared_ptr<BusinessDays> > cache_;
+            mutable unsigned long cacheVersion_;
         };
         boost::shared_ptr<Impl> impl_;
+        //! business days of the given calendar for the given year
+        static const BusinessDays& businessDays(const Calendar&, Year);
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -196,11 +251,7 @@ namespace QuantLib {
 
     inline bool Calendar::isBusinessDay(const Date& d) const {
         QL_REQUIRE(impl_, "no implementation provided");
-        if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
-            return false;
-        if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
-            return true;
-        return impl_->isBusinessDay(d);
+        return impl_->businessDays(d.year()).isBusinessDay(d.dayOfYear()-1);
     }
 
     inline bool Calendar::isEndOfMonth(const Date& d) const {
@@ -20,6 +20,7 @@
 
 #include <ql/time/calendars/jointcalendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 #include <sstream>
 
 namespace QuantLib {
@@ -114,6 +115,30 @@ namespace QuantLib {
         }
     }
 
+    void JointCalendar::Impl::fillBusinessDays(
+                                     Year y, boost::uint64_t bits[6]) const {
+        std::vector<Calendar>::const_iterator i;
+        switch (rule_) {
+          case JoinHolidays:
+            std::fill(bits, bits+6, ~boost::uint64_t(0));
+            for (i=calendars_.begin(); i!=calendars_.end(); ++i) {
+                const BusinessDays& b = Calendar::businessDays(*i, y);
+                for (Size w=0; w<6; ++w)
+                    bits[w] &= b.bits[w];
+            }
+            break;
+          case JoinBusinessDays:
+            for (i=calendars_.begin(); i!=calendars_.end(); ++i) {
+                const BusinessDays& b = Calendar::businessDays(*i, y);
+                for (Size w=0; w<6; ++w)
+                    bits[w] |= b.bits[w];
+            }
+            break;
+          default:
+            QL_FAIL("unknown joint calendar rule");
+        }
+    }
+
 
     JointCalendar::JointCalendar(const Calendar& c1,
                                  const Calendar& c2,
@@ -65,6 +65,8 @@ namespace QuantLib {
             std::string name() const;
             bool isWeekend(Weekday) const;
             bool isBusinessDay(const Date&) const;
+          protected:
+            void fillBusinessDays(Year, boost::uint64_t bits[6]) const;
           private:
             JointCalendarRule rule_;
             std::vector<Calendar> calendars_;
@@ -59,6 +59,38 @@ namespace QuantLib {
         checkSerialNumber(serialNumber);
     }
 
+    namespace {
+
+        // Conversion from serial number to day, month and year in a
+        // single pass, based on the algorithm by Howard Hinnant
+        // described at <http://howardhinnant.github.io/date_algorithms.html>.
+        // Years are counted from March 1st, so that the leap day is
+        // the last day of the year, and days are counted from March
+        // 1st, 1600, so that all quantities are positive in the range
+        // of valid dates.  The conversion in the other direction is
+        // already done by table lookups in the constructor.
+
+        // serial number of March 1st, 1600
+        const Date::serial_type civilOrigin = -109511;
+
+        inline void civilFromSerial(Date::serial_type serial,
+                                    Day& d, Month& m, Year& y) {
+            // unsigned arithmetic lets the compiler replace the
+            // divisions by multiplications and shifts
+            Size z = Size(serial - civilOrigin);
+            Size era = z / 146097;
+            Size doe = z - era*146097;                        // [0, 146096]
+            Size yoe =
+                (doe - doe/1460 + doe/36524 - doe/146096) / 365;  // [0, 399]
+            Size doy = doe - (365*yoe + yoe/4 - yoe/100);     // [0, 365]
+            Size mp = (5*doy + 2)/153;                        // [0, 11]
+            d = Day(doy - (153*mp + 2)/5 + 1);
+            m = Month(mp < 10 ? mp + 3 : mp - 9);
+            y = Year(1600 + 400*era + yoe + (mp >= 10 ? 1 : 0));
+        }
+
+    }
+
     Date::Date(Day d, Month m, Year y) {
         QL_REQUIRE(y > 1900 && y < 2200,
                    "year " << y << " out of bound. It must be in [1901,2199]");
@@ -75,15 +107,16 @@ namespace QuantLib {
         serialNumber_ = d + offset + yearOffset(y);
     }
 
+    Day Date::dayOfMonth() const {
+        Day d; Month m; Year y;
+        civilFromSerial(serialNumber_, d, m, y);
+        return d;
+    }
+
     Month Date::month() const {
-        Day d = dayOfYear(); // dayOfYear is 1 based
-        Integer m = d/30 + 1;
-        bool leap = isLeap(year());
-        while (d <= monthOffset(Month(m),leap))
-            --m;
-        while (d > monthOffset(Month(m+1),leap))
-            ++m;
-        return Month(m);
+        Day d; Month m; Year y;
+        civilFromSerial(serialNumber_, d, m, y);
+        return m;
     }
 
     Year Date::year() const {
@@ -94,6 +127,45 @@ namespace QuantLib {
         return y;
     }
 
+    void Date::dayMonthYear(const std::vector<Date>& dates,
+                            std::vector<Day>& days,
+                            std::vector<Month>& months,
+                            std::vector<Year>& years) {
+        Size n = dates.size();
+        days.resize(n);
+        months.resize(n);
+        years.resize(n);
+        for (Size i=0; i<n; ++i)
+            civilFromSerial(dates[i].serialNumber_,
+                            days[i], months[i], years[i]);
+    }
+
+    std::vector<Date> Date::fromDayMonthYear(const std::vector<Day>& days,
+                                             const std::vector<Month>& months,
+                                             const std::vector<Year>& years) {
+        Size n = days.size();
+        QL_REQUIRE(months.size() == n && years.size() == n,
+                   "mismatch between number of days (" << n
+                   << "), months (" << months.size()
+                   << ") and years (" << years.size() << ")");
+        std::vector<Date> dates(n);
+        for (Size i=0; i<n; ++i) {
+            Day d = days[i];
+            Month m = months[i];
+            Year y = years[i];
+            QL_REQUIRE(y > 1900 && y < 2200 &&
+                       Integer(m) > 0 && Integer(m) < 13,
+                       "invalid date #" << i << ": day " << d
+                       << ", month " << Integer(m) << ", year " << y);
+            bool leap = isLeap(y);
+            QL_REQUIRE(d > 0 && d <= monthLength(m, leap),
+                       "invalid date #" << i << ": day " << d
+                       << ", month " << Integer(m) << ", year " << y);
+            dates[i].serialNumber_ = d + monthOffset(m,leap) + yearOffset(y);
+        }
+        return dates;
+    }
+
     Date& Date::operator+=(Date::serial_type days) {
         Date::serial_type serial = serialNumber_ + days;
         checkSerialNumber(serial);
@@ -139,17 +211,13 @@ namespace QuantLib {
           case Weeks:
             return date + 7*n;
           case Months: {
-            Day d = date.dayOfMonth();
-            Integer m = Integer(date.month())+n;
-            Year y = date.year();
-            while (m > 12) {
-                m -= 12;
-                y += 1;
-            }
-            while (m < 1) {
-                m += 12;
-                y -= 1;
-            }
+            Day d; Month month; Year y;
+            civilFromSerial(date.serialNumber_, d, month, y);
+            Integer m = Integer(month)+n;
+            // floor division, since m can be negative
+            Integer years = (m > 0 ? m-1 : m-12)/12;
+            m -= 12*years;
+            y += years;
 
             QL_ENSURE(y >= 1900 && y <= 2199,
                       "year " << y << " out of bounds. "
@@ -162,9 +230,9 @@ namespace QuantLib {
             return Date(d, Month(m), y);
           }
           case Years: {
-              Day d = date.dayOfMonth();
-              Month m = date.month();
-              Year y = date.year()+n;
+              Day d; Month m; Year y;
+              civilFromSerial(date.serialNumber_, d, m, y);
+              y += n;
 
               QL_ENSURE(y >= 1900 && y <= 2199,
                         "year " << y << " out of bounds. "
@@ -556,6 +624,37 @@ namespace QuantLib {
         return dateTime_.date().year();
     }
 
+    void Date::dayMonthYear(const std::vector<Date>& dates,
+                            std::vector<Day>& days,
+                            std::vector<Month>& months,
+                            std::vector<Year>& years) {
+        Size n = dates.size();
+        days.resize(n);
+        months.resize(n);
+        years.resize(n);
+        for (Size i=0; i<n; ++i) {
+            boost::gregorian::date d = dates[i].dateTime_.date();
+            days[i] = d.day();
+            months[i] = mapBoostDateType2QL<compatibleEnums>(d.month());
+            years[i] = d.year();
+        }
+    }
+
+    std::vector<Date> Date::fromDayMonthYear(const std::vector<Day>& days,
+                                             const std::vector<Month>& months,
+                                             const std::vector<Year>& years) {
+        Size n = days.size();
+        QL_REQUIRE(months.size() == n && years.size() == n,
+                   "mismatch between number of days (" << n
+                   << "), months (" << months.size()
+                   << ") and years (" << years.size() << ")");
+        std::vector<Date> dates;
+        dates.reserve(n);
+        for (Size i=0; i<n; ++i)
+            dates.push_back(Date(days[i], months[i], years[i]));
+        return dates;
+    }
+
     Hour Date::hours() const {
         return dateTime_.time_of_day().hours();
     }
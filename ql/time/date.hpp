@@ -40,6 +40,7 @@
 #endif
 
 #include <utility>
+#include <vector>
 #include <functional>
 #include <string>
 
@@ -227,6 +228,19 @@ namespace QuantLib {
                                Weekday w,
                                Month m,
                                Year y);
+        //! day, month and year of each of the given dates
+        /*! This is equivalent to, but faster than, calling
+            dayOfMonth(), month() and year() on each date.
+        */
+        static void dayMonthYear(const std::vector<Date>& dates,
+                                 std::vector<Day>& days,
+                                 std::vector<Month>& months,
+                                 std::vector<Year>& years);
+        //! dates with the given days, months and years
+        static std::vector<Date> fromDayMonthYear(
+                                         const std::vector<Day>& days,
+                                         const std::vector<Month>& months,
+                                         const std::vector<Year>& years);
 
 #ifdef QL_HIGH_RESOLUTION_DATE
         //! local date time, based on the time zone settings of the computer
@@ -363,10 +377,6 @@ namespace QuantLib {
         return Weekday(w == 0 ? 7 : w);
     }
 
-    inline Day Date::dayOfMonth() const {
-        return dayOfYear() - monthOffset(month(),isLeap(year()));
-    }
-
     inline Day Date::dayOfYear() const {
         return serialNumber_ - yearOffset(year());
     }
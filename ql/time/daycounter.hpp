@@ -56,6 +56,14 @@ namespace QuantLib {
                                       const Date& d2,
                                       const Date& refPeriodStart,
                                       const Date& refPeriodEnd) const = 0;
+            //! to be overloaded by day counters with a faster batch path
+            virtual void yearFractions(const Date* d1,
+                                       const Date* d2,
+                                       Time* result,
+                                       Size n) const {
+                for (Size i=0; i<n; ++i)
+                    result[i] = yearFraction(d1[i], d2[i], Date(), Date());
+            }
         };
         boost::shared_ptr<Impl> impl_;
         /*! This constructor can be invoked by derived classes which
@@ -85,6 +93,14 @@ namespace QuantLib {
         Time yearFraction(const Date&, const Date&,
                           const Date& refPeriodStart = Date(),
                           const Date& refPeriodEnd = Date()) const;
+        //! Returns the year fractions between the given pairs of dates.
+        /*! The \f$ i \f$-th result is the year fraction between
+            <tt>d1[i]</tt> and <tt>d2[i]</tt>, calculated with no
+            reference period; the whole batch is dispatched to the
+            implementation at once.
+        */
+        void yearFractions(const Date* d1, const Date* d2,
+                           Time* result, Size n) const;
         //@}
     };
 
@@ -129,6 +145,12 @@ namespace QuantLib {
             return impl_->yearFraction(d1,d2,refPeriodStart,refPeriodEnd);
     }
 
+    inline void DayCounter::yearFractions(const Date* d1, const Date* d2,
+                                          Time* result, Size n) const {
+        QL_REQUIRE(impl_, "no implementation provided");
+        impl_->yearFractions(d1, d2, result, n);
+    }
+
 
     inline bool operator==(const DayCounter& d1, const DayCounter& d2) {
         return (d1.empty() && d2.empty())
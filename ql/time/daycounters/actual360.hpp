@@ -58,6 +58,14 @@ namespace QuantLib {
                 return (daysBetween(d1,d2)
                         + (includeLastDay_ ? 1.0 : 0.0))/360.0;
             }
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* result,
+                               Size n) const {
+                Real extra = includeLastDay_ ? 1.0 : 0.0;
+                for (Size i=0; i<n; ++i)
+                    result[i] = (daysBetween(d1[i],d2[i]) + extra)/360.0;
+            }
         };
       public:
         explicit Actual360(const bool includeLastDay = false)
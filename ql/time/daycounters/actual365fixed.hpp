@@ -57,6 +57,13 @@ namespace QuantLib {
                               const Date&) const {
                 return daysBetween(d1,d2)/365.0;
             }
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* result,
+                               Size n) const {
+                for (Size i=0; i<n; ++i)
+                    result[i] = daysBetween(d1[i],d2[i])/365.0;
+            }
         };
         class CA_Impl : public DayCounter::Impl {
           public:
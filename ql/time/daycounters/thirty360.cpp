@@ -72,4 +72,29 @@ namespace QuantLib {
             std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
     }
 
+    void Thirty360::US_Impl::yearFractions(const Date* d1,
+                                           const Date* d2,
+                                           Time* result,
+                                           Size n) const {
+        // qualified calls avoid a virtual dispatch for each pair
+        for (Size i=0; i<n; ++i)
+            result[i] = US_Impl::dayCount(d1[i],d2[i])/360.0;
+    }
+
+    void Thirty360::EU_Impl::yearFractions(const Date* d1,
+                                           const Date* d2,
+                                           Time* result,
+                                           Size n) const {
+        for (Size i=0; i<n; ++i)
+            result[i] = EU_Impl::dayCount(d1[i],d2[i])/360.0;
+    }
+
+    void Thirty360::IT_Impl::yearFractions(const Date* d1,
+                                           const Date* d2,
+                                           Time* result,
+                                           Size n) const {
+        for (Size i=0; i<n; ++i)
+            result[i] = IT_Impl::dayCount(d1[i],d2[i])/360.0;
+    }
+
 }
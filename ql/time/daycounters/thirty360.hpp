@@ -67,6 +67,10 @@ namespace QuantLib {
                               const Date&, 
                               const Date&) const {
                 return dayCount(d1,d2)/360.0; }
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* result,
+                               Size n) const;
         };
         class EU_Impl : public DayCounter::Impl {
           public:
@@ -78,6 +82,10 @@ namespace QuantLib {
                               const Date&,
                               const Date&) const {
                 return dayCount(d1,d2)/360.0; }
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* result,
+                               Size n) const;
         };
         class IT_Impl : public DayCounter::Impl {
           public:
@@ -88,6 +96,10 @@ namespace QuantLib {
                               const Date&,
                               const Date&) const {
                 return dayCount(d1,d2)/360.0; }
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* result,
+                               Size n) const;
         };
         static boost::shared_ptr<DayCounter::Impl> implementation(
                                                                Convention c);
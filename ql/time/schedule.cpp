@@ -69,6 +69,9 @@ namespace QuantLib {
     }
 
 
+    Schedule::Schedule()
+    : dates_(new std::vector<Date>), isRegular_(new std::vector<bool>) {}
+
     Schedule::Schedule(const std::vector<Date>& dates,
                        const Calendar& calendar,
                        BusinessDayConvention convention,
@@ -82,7 +85,8 @@ namespace QuantLib {
       convention_(convention),
       terminationDateConvention_(terminationDateConvention),
       rule_(rule),
-      dates_(dates), isRegular_(isRegular) {
+      dates_(new std::vector<Date>(dates)),
+      isRegular_(new std::vector<bool>(isRegular)) {
 
         if (tenor != boost::none && !allowsEndOfMonth(*tenor))
             endOfMonth_ = false;
@@ -90,9 +94,9 @@ namespace QuantLib {
             endOfMonth_ = endOfMonth;
 
         QL_REQUIRE(
-            isRegular_.size() == 0 || isRegular_.size() == dates.size() - 1,
+            isRegular.size() == 0 || isRegular.size() == dates.size() - 1,
             "isRegular size ("
-                << isRegular_.size()
+                << isRegular.size()
                 << ") must be zero or equal to the number of dates minus 1 ("
                 << dates.size() - 1 << ")");
     }
@@ -113,6 +117,13 @@ namespace QuantLib {
       firstDate_(first==effectiveDate ? Date() : first),
       nextToLastDate_(nextToLast==terminationDate ? Date() : nextToLast)
     {
+        // the dates are generated in place and shared afterwards
+        boost::shared_ptr<std::vector<Date> > datesPtr(new std::vector<Date>);
+        boost::shared_ptr<std::vector<bool> > isRegularPtr(
+                                                      new std::vector<bool>);
+        std::vector<Date>& dates = *datesPtr;
+        std::vector<bool>& isRegular = *isRegularPtr;
+
         // sanity checks
         QL_REQUIRE(terminationDate != Date(), "null termination date");
 
@@ -212,24 +223,24 @@ namespace QuantLib {
 
           case DateGeneration::Zero:
             tenor_ = 0*Years;
-            dates_.push_back(effectiveDate);
-            dates_.push_back(terminationDate);
-            isRegular_.push_back(true);
+            dates.push_back(effectiveDate);
+            dates.push_back(terminationDate);
+            isRegular.push_back(true);
             break;
 
           case DateGeneration::Backward:
 
-            dates_.push_back(terminationDate);
+            dates.push_back(terminationDate);
 
             seed = terminationDate;
             if (nextToLastDate_ != Date()) {
-                dates_.insert(dates_.begin(), nextToLastDate_);
+                dates.insert(dates.begin(), nextToLastDate_);
                 Date temp = nullCalendar.advance(seed,
                     -periods*(*tenor_), convention, *endOfMonth_);
                 if (temp!=nextToLastDate_)
-                    isRegular_.insert(isRegular_.begin(), false);
+                    isRegular.insert(isRegular.begin(), false);
                 else
-                    isRegular_.insert(isRegular_.begin(), true);
+                    isRegular.insert(isRegular.begin(), true);
                 seed = nextToLastDate_;
             }
 
@@ -242,28 +253,28 @@ namespace QuantLib {
                     -periods*(*tenor_), convention, *endOfMonth_);
                 if (temp < exitDate) {
                     if (firstDate_ != Date() &&
-                        (calendar_.adjust(dates_.front(),convention)!=
+                        (calendar_.adjust(dates.front(),convention)!=
                          calendar_.adjust(firstDate_,convention))) {
-                        dates_.insert(dates_.begin(), firstDate_);
-                        isRegular_.insert(isRegular_.begin(), false);
+                        dates.insert(dates.begin(), firstDate_);
+                        isRegular.insert(isRegular.begin(), false);
                     }
                     break;
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.front(),convention)!=
+                    if (calendar_.adjust(dates.front(),convention)!=
                         calendar_.adjust(temp,convention)) {
-                        dates_.insert(dates_.begin(), temp);
-                        isRegular_.insert(isRegular_.begin(), true);
+                        dates.insert(dates.begin(), temp);
+                        isRegular.insert(isRegular.begin(), true);
                     }
                     ++periods;
                 }
             }
 
-            if (calendar_.adjust(dates_.front(),convention)!=
+            if (calendar_.adjust(dates.front(),convention)!=
                 calendar_.adjust(effectiveDate,convention)) {
-                dates_.insert(dates_.begin(), effectiveDate);
-                isRegular_.insert(isRegular_.begin(), false);
+                dates.insert(dates.begin(), effectiveDate);
+                isRegular.insert(isRegular.begin(), false);
             }
             break;
 
@@ -280,21 +291,21 @@ namespace QuantLib {
           case DateGeneration::Forward:
 
             if (*rule_ == DateGeneration::CDS || *rule_ == DateGeneration::CDS2015) {
-                dates_.push_back(previousTwentieth(effectiveDate, *rule_));
+                dates.push_back(previousTwentieth(effectiveDate, *rule_));
             } else {
-                dates_.push_back(effectiveDate);
+                dates.push_back(effectiveDate);
             }
 
-            seed = dates_.back();
+            seed = dates.back();
 
             if (firstDate_!=Date()) {
-                dates_.push_back(firstDate_);
+                dates.push_back(firstDate_);
                 Date temp = nullCalendar.advance(seed, periods*(*tenor_),
                                                  convention, *endOfMonth_);
                 if (temp!=firstDate_)
-                    isRegular_.push_back(false);
+                    isRegular.push_back(false);
                 else
-                    isRegular_.push_back(true);
+                    isRegular.push_back(true);
                 seed = firstDate_;
             } else if (*rule_ == DateGeneration::Twentieth ||
                        *rule_ == DateGeneration::TwentiethIMM ||
@@ -311,8 +322,8 @@ namespace QuantLib {
                     }
                 }
                 if (next20th != effectiveDate) {
-                    dates_.push_back(next20th);
-                    isRegular_.push_back(false);
+                    dates.push_back(next20th);
+                    isRegular.push_back(false);
                     seed = next20th;
                 }
             }
@@ -330,42 +341,42 @@ namespace QuantLib {
                                                  convention, *endOfMonth_);
                 if (temp > exitDate) {
                     if (nextToLastDate_ != Date() &&
-                        (calendar_.adjust(dates_.back(),convention)!=
+                        (calendar_.adjust(dates.back(),convention)!=
                          calendar_.adjust(nextToLastDate_,convention))) {
-                        dates_.push_back(nextToLastDate_);
-                        isRegular_.push_back(false);
+                        dates.push_back(nextToLastDate_);
+                        isRegular.push_back(false);
                     }
                     break;
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.back(),convention)!=
+                    if (calendar_.adjust(dates.back(),convention)!=
                         calendar_.adjust(temp,convention)) {
-                        dates_.push_back(temp);
-                        isRegular_.push_back(true);
+                        dates.push_back(temp);
+                        isRegular.push_back(true);
                     }
                     ++periods;
                 }
             }
 
-            if (calendar_.adjust(dates_.back(),terminationDateConvention)!=
+            if (calendar_.adjust(dates.back(),terminationDateConvention)!=
                 calendar_.adjust(terminationDate,terminationDateConvention)) {
                 if (*rule_ == DateGeneration::Twentieth ||
                     *rule_ == DateGeneration::TwentiethIMM ||
                     *rule_ == DateGeneration::OldCDS ||
                     *rule_ == DateGeneration::CDS) {
-                    dates_.push_back(nextTwentieth(terminationDate, *rule_));
-                    isRegular_.push_back(true);
+                    dates.push_back(nextTwentieth(terminationDate, *rule_));
+                    isRegular.push_back(true);
                 } else if(*rule_ == DateGeneration::CDS2015) {
                     Date tentativeTerminationDate =
                         nextTwentieth(terminationDate, *rule_);
                     if(tentativeTerminationDate.month() %2 == 0) {
-                        dates_.push_back(tentativeTerminationDate);
-                        isRegular_.push_back(true);
+                        dates.push_back(tentativeTerminationDate);
+                        isRegular.push_back(true);
                     }
                 } else {
-                    dates_.push_back(terminationDate);
-                    isRegular_.push_back(false);
+                    dates.push_back(terminationDate);
+                    isRegular.push_back(false);
                 }
             }
 
@@ -377,37 +388,37 @@ namespace QuantLib {
 
         // adjustments
         if (*rule_==DateGeneration::ThirdWednesday)
-            for (Size i=1; i<dates_.size()-1; ++i)
-                dates_[i] = Date::nthWeekday(3, Wednesday,
-                                             dates_[i].month(),
-                                             dates_[i].year());
+            for (Size i=1; i<dates.size()-1; ++i)
+                dates[i] = Date::nthWeekday(3, Wednesday,
+                                             dates[i].month(),
+                                             dates[i].year());
 
         if (*endOfMonth_ && calendar_.isEndOfMonth(seed)) {
             // adjust to end of month
             if (convention == Unadjusted) {
-                for (Size i=1; i<dates_.size()-1; ++i)
-                    dates_[i] = Date::endOfMonth(dates_[i]);
+                for (Size i=1; i<dates.size()-1; ++i)
+                    dates[i] = Date::endOfMonth(dates[i]);
             } else {
-                for (Size i=1; i<dates_.size()-1; ++i)
-                    dates_[i] = calendar_.endOfMonth(dates_[i]);
+                for (Size i=1; i<dates.size()-1; ++i)
+                    dates[i] = calendar_.endOfMonth(dates[i]);
             }
             if (terminationDateConvention != Unadjusted) {
-                dates_.front() = calendar_.endOfMonth(dates_.front());
-                dates_.back() = calendar_.endOfMonth(dates_.back());
+                dates.front() = calendar_.endOfMonth(dates.front());
+                dates.back() = calendar_.endOfMonth(dates.back());
             } else {
                 // the termination date is the first if going backwards,
                 // the last otherwise.
                 if (*rule_ == DateGeneration::Backward)
-                    dates_.back() = Date::endOfMonth(dates_.back());
+                    dates.back() = Date::endOfMonth(dates.back());
                 else
-                    dates_.front() = Date::endOfMonth(dates_.front());
+                    dates.front() = Date::endOfMonth(dates.front());
             }
         } else {
             // first date not adjusted for old CDS schedules
             if (*rule_ != DateGeneration::OldCDS)
-                dates_[0] = calendar_.adjust(dates_[0], convention);
-            for (Size i=1; i<dates_.size()-1; ++i)
-                dates_[i] = calendar_.adjust(dates_[i], convention);
+                dates[0] = calendar_.adjust(dates[0], convention);
+            for (Size i=1; i<dates.size()-1; ++i)
+                dates[i] = calendar_.adjust(dates[i], convention);
 
             // termination date is NOT adjusted as per ISDA
             // specifications, unless otherwise specified in the
@@ -416,7 +427,7 @@ namespace QuantLib {
             if (terminationDateConvention != Unadjusted
                 && *rule_ != DateGeneration::CDS
                 && *rule_ != DateGeneration::CDS2015) {
-                dates_.back() = calendar_.adjust(dates_.back(),
+                dates.back() = calendar_.adjust(dates.back(),
                                                  terminationDateConvention);
             }
         }
@@ -425,23 +436,23 @@ namespace QuantLib {
         // necessary.  It can happen to be equal or later than the end
         // date due to EOM adjustments (see the Schedule test suite
         // for an example).
-        if (dates_.size() >= 2 && dates_[dates_.size()-2] >= dates_.back()) {
-            isRegular_[isRegular_.size()-2] =
-                (dates_[dates_.size()-2] == dates_.back());
-            dates_[dates_.size()-2] = dates_.back();
-            dates_.pop_back();
-            isRegular_.pop_back();
+        if (dates.size() >= 2 && dates[dates.size()-2] >= dates.back()) {
+            isRegular[isRegular.size()-2] =
+                (dates[dates.size()-2] == dates.back());
+            dates[dates.size()-2] = dates.back();
+            dates.pop_back();
+            isRegular.pop_back();
         }
-        if (dates_.size() >= 2 && dates_[1] <= dates_.front()) {
-            isRegular_[1] =
-                (dates_[1] == dates_.front());
-            dates_[1] = dates_.front();
-            dates_.erase(dates_.begin());
-            isRegular_.erase(isRegular_.begin());
+        if (dates.size() >= 2 && dates[1] <= dates.front()) {
+            isRegular[1] =
+                (dates[1] == dates.front());
+            dates[1] = dates.front();
+            dates.erase(dates.begin());
+            isRegular.erase(isRegular.begin());
         }
 
-        QL_ENSURE(dates_.size()>1,
-            "degenerate single date (" << dates_[0] << ") schedule" <<
+        QL_ENSURE(dates.size()>1,
+            "degenerate single date (" << dates[0] << ") schedule" <<
             "\n seed date: " << seed <<
             "\n exit date: " << exitDate <<
             "\n effective date: " << effectiveDate <<
@@ -451,27 +462,34 @@ namespace QuantLib {
             "\n generation rule: " << *rule_ <<
             "\n end of month: " << *endOfMonth_);
 
+        dates_ = datesPtr;
+        isRegular_ = isRegularPtr;
     }
 
 
     Schedule Schedule::until(const Date& truncationDate) const {
         Schedule result = *this;
 
-        QL_REQUIRE(truncationDate>result.dates_[0],
+        QL_REQUIRE(truncationDate>result.dates_->front(),
                    "truncation date " << truncationDate <<
                    " must be later than schedule first date " <<
-                   result.dates_[0]);
-        if (truncationDate<result.dates_.back()) {
+                   result.dates_->front());
+        if (truncationDate<result.dates_->back()) {
+            boost::shared_ptr<std::vector<Date> > dates(
+                                            new std::vector<Date>(*dates_));
+            boost::shared_ptr<std::vector<bool> > isRegular(
+                                        new std::vector<bool>(*isRegular_));
+
             // remove later dates
-            while (result.dates_.back()>truncationDate) {
-                result.dates_.pop_back();
-                result.isRegular_.pop_back();
+            while (dates->back()>truncationDate) {
+                dates->pop_back();
+                isRegular->pop_back();
             }
 
             // add truncationDate if missing
-            if (truncationDate!=result.dates_.back()) {
-                result.dates_.push_back(truncationDate);
-                result.isRegular_.push_back(false);
+            if (truncationDate!=dates->back()) {
+                dates->push_back(truncationDate);
+                isRegular->push_back(false);
                 result.terminationDateConvention_ = Unadjusted;
             } else {
                 result.terminationDateConvention_ = convention_;
@@ -481,6 +499,9 @@ namespace QuantLib {
                 result.nextToLastDate_ = Date();
             if (result.firstDate_>=truncationDate)
                 result.firstDate_ = Date();
+
+            result.dates_ = dates;
+            result.isRegular_ = isRegular;
         }
 
         return result;
@@ -491,12 +512,12 @@ namespace QuantLib {
         Date d = (refDate==Date() ?
                   Settings::instance().evaluationDate() :
                   refDate);
-        return std::lower_bound(dates_.begin(), dates_.end(), d);
+        return std::lower_bound(dates_->begin(), dates_->end(), d);
     }
 
     Date Schedule::nextDate(const Date& refDate) const {
         std::vector<Date>::const_iterator res = lower_bound(refDate);
-        if (res!=dates_.end())
+        if (res!=dates_->end())
             return *res;
         else
             return Date();
@@ -504,25 +525,25 @@ namespace QuantLib {
 
     Date Schedule::previousDate(const Date& refDate) const {
         std::vector<Date>::const_iterator res = lower_bound(refDate);
-        if (res!=dates_.begin())
+        if (res!=dates_->begin())
             return *(--res);
         else
             return Date();
     }
 
     bool Schedule::isRegular(Size i) const {
-        QL_REQUIRE(isRegular_.size() > 0,
+        QL_REQUIRE(isRegular_->size() > 0,
                    "full interface (isRegular) not available");
-        QL_REQUIRE(i<=isRegular_.size() && i>0,
+        QL_REQUIRE(i<=isRegular_->size() && i>0,
                    "index (" << i << ") must be in [1, " <<
-                   isRegular_.size() <<"]");
-        return isRegular_[i-1];
+                   isRegular_->size() <<"]");
+        return (*isRegular_)[i-1];
     }
 
     const std::vector<bool>& Schedule::isRegular() const {
-        QL_REQUIRE(isRegular_.size() > 0,
+        QL_REQUIRE(isRegular_->size() > 0,
                    "full interface (isRegular) not available");
-        return isRegular_;
+        return *isRegular_;
     }
 
     MakeSchedule::MakeSchedule()
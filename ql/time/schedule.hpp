@@ -32,11 +32,17 @@
 #include <ql/time/dategenerationrule.hpp>
 #include <ql/errors.hpp>
 #include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace QuantLib {
 
     //! Payment schedule
-    /*! \ingroup datetime */
+    /*! The dates of a schedule are never modified after construction
+        and are shared between its copies, which are therefore cheap
+        to make.
+
+        \ingroup datetime
+    */
     class Schedule {
       public:
         /*! constructor that takes any list of dates, and optionally
@@ -64,22 +70,22 @@ namespace QuantLib {
                  bool endOfMonth,
                  const Date& firstDate = Date(),
                  const Date& nextToLastDate = Date());
-        Schedule() {}
+        Schedule();
         //! \name Date access
         //@{
-        Size size() const { return dates_.size(); }
+        Size size() const { return dates_->size(); }
         const Date& operator[](Size i) const;
         const Date& at(Size i) const;
         const Date& date(Size i) const;
         Date previousDate(const Date& refDate) const;
         Date nextDate(const Date& refDate) const;
-        const std::vector<Date>& dates() const { return dates_; }
+        const std::vector<Date>& dates() const { return *dates_; }
         bool isRegular(Size i) const;
         const std::vector<bool>& isRegular() const;
         //@}
         //! \name Other inspectors
         //@{
-        bool empty() const { return dates_.empty(); }
+        bool empty() const { return dates_->empty(); }
         const Calendar& calendar() const;
         const Date& startDate() const;
         const Date& endDate() const;
@@ -92,8 +98,8 @@ namespace QuantLib {
         //! \name Iterators
         //@{
         typedef std::vector<Date>::const_iterator const_iterator;
-        const_iterator begin() const { return dates_.begin(); }
-        const_iterator end() const { return dates_.end(); }
+        const_iterator begin() const { return dates_->begin(); }
+        const_iterator end() const { return dates_->end(); }
         const_iterator lower_bound(const Date& d = Date()) const;
         //@}
         //! \name Utilities
@@ -109,8 +115,8 @@ namespace QuantLib {
         boost::optional<DateGeneration::Rule> rule_;
         boost::optional<bool> endOfMonth_;
         Date firstDate_, nextToLastDate_;
-        std::vector<Date> dates_;
-        std::vector<bool> isRegular_;
+        boost::shared_ptr<const std::vector<Date> > dates_;
+        boost::shared_ptr<const std::vector<bool> > isRegular_;
     };
 
 
@@ -151,19 +157,19 @@ namespace QuantLib {
     // inline definitions
 
     inline const Date& Schedule::date(Size i) const {
-        return dates_.at(i);
+        return dates_->at(i);
     }
 
     inline const Date& Schedule::operator[](Size i) const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
-        return dates_.at(i);
+        return dates_->at(i);
         #else
-        return dates_[i];
+        return (*dates_)[i];
         #endif
     }
 
     inline const Date& Schedule::at(Size i) const {
-        return dates_.at(i);
+        return dates_->at(i);
     }
 
     inline const Calendar& Schedule::calendar() const {
@@ -171,10 +177,10 @@ namespace QuantLib {
     }
 
     inline const Date& Schedule::startDate() const {
-        return dates_.front();
+        return dates_->front();
     }
 
-    inline const Date &Schedule::endDate() const { return dates_.back(); }
+    inline const Date &Schedule::endDate() const { return dates_->back(); }
 
     inline const Period& Schedule::tenor() const {
         QL_REQUIRE(tenor_ != boost::none,
@@ -0,0 +1,93 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/schedulecache.hpp>
+
+namespace QuantLib {
+
+    bool ScheduleCache::Key::operator==(const Key& o) const {
+        return effectiveDate == o.effectiveDate
+            && terminationDate == o.terminationDate
+            && tenor.length() == o.tenor.length()
+            && tenor.units() == o.tenor.units()
+            && calendar == o.calendar
+            && convention == o.convention
+            && terminationDateConvention == o.terminationDateConvention
+            && rule == o.rule
+            && endOfMonth == o.endOfMonth
+            && firstDate == o.firstDate
+            && nextToLastDate == o.nextToLastDate;
+    }
+
+    std::size_t ScheduleCache::KeyHasher::operator()(const Key& x) const {
+        std::size_t seed = 0;
+        boost::hash_combine(seed, x.effectiveDate.serialNumber());
+        boost::hash_combine(seed, x.terminationDate.serialNumber());
+        boost::hash_combine(seed, x.tenor.length());
+        boost::hash_combine(seed, Integer(x.tenor.units()));
+        boost::hash_combine(seed, x.calendar);
+        boost::hash_combine(seed, Integer(x.convention));
+        boost::hash_combine(seed, Integer(x.terminationDateConvention));
+        boost::hash_combine(seed, Integer(x.rule));
+        boost::hash_combine(seed, x.endOfMonth);
+        boost::hash_combine(seed, x.firstDate.serialNumber());
+        boost::hash_combine(seed, x.nextToLastDate.serialNumber());
+        return seed;
+    }
+
+    Schedule ScheduleCache::schedule(
+                             const Date& effectiveDate,
+                             const Date& terminationDate,
+                             const Period& tenor,
+                             const Calendar& calendar,
+                             BusinessDayConvention convention,
+                             BusinessDayConvention terminationDateConvention,
+                             DateGeneration::Rule rule,
+                             bool endOfMonth,
+                             const Date& firstDate,
+                             const Date& nextToLastDate) {
+        if (effectiveDate == Date())
+            return Schedule(effectiveDate, terminationDate, tenor, calendar,
+                            convention, terminationDateConvention, rule,
+                            endOfMonth, firstDate, nextToLastDate);
+
+        Key key;
+        key.effectiveDate = effectiveDate;
+        key.terminationDate = terminationDate;
+        key.tenor = tenor;
+        key.calendar = calendar.empty() ? std::string() : calendar.name();
+        key.convention = convention;
+        key.terminationDateConvention = terminationDateConvention;
+        key.rule = rule;
+        key.endOfMonth = endOfMonth;
+        key.firstDate = firstDate;
+        key.nextToLastDate = nextToLastDate;
+
+        boost::unordered_map<Key, Schedule, KeyHasher>::const_iterator i =
+            schedules_.find(key);
+        if (i != schedules_.end())
+            return i->second;
+
+        Schedule s(effectiveDate, terminationDate, tenor, calendar,
+                   convention, terminationDateConvention, rule,
+                   endOfMonth, firstDate, nextToLastDate);
+        schedules_.insert(std::make_pair(key, s));
+        return s;
+    }
+
+}
+
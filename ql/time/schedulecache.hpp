@@ -0,0 +1,84 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file schedulecache.hpp
+    \brief cache of rule-based schedules
+*/
+
+#ifndef quantlib_schedule_cache_hpp
+#define quantlib_schedule_cache_hpp
+
+#include <ql/time/schedule.hpp>
+#include <boost/unordered_map.hpp>
+
+namespace QuantLib {
+
+    //! cache of rule-based schedules
+    /*! Schedules are stored by their generation parameters; when a
+        schedule is requested again, the stored instance is returned,
+        whose dates are shared with those of all the other copies.
+        This saves both the generation time and the memory when a
+        large number of instruments (e.g., a portfolio of swaps) are
+        built on a limited set of schedules.
+
+        \warning calendars are identified by their names; the cache
+                 must be cleared if holidays are added or removed
+                 after schedules were built on them.
+
+        \ingroup datetime
+    */
+    class ScheduleCache {
+      public:
+        /*! returns the schedule corresponding to the given
+            parameters, as built by the rule-based Schedule
+            constructor.  Schedules with a null effective date depend
+            on the evaluation date and are not cached.
+        */
+        Schedule schedule(const Date& effectiveDate,
+                          const Date& terminationDate,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const Date& firstDate = Date(),
+                          const Date& nextToLastDate = Date());
+        //! number of cached schedules
+        Size size() const { return schedules_.size(); }
+        void clear() { schedules_.clear(); }
+      private:
+        struct Key {
+            Date effectiveDate, terminationDate;
+            Period tenor;
+            std::string calendar;
+            BusinessDayConvention convention, terminationDateConvention;
+            DateGeneration::Rule rule;
+            bool endOfMonth;
+            Date firstDate, nextToLastDate;
+            bool operator==(const Key&) const;
+        };
+        struct KeyHasher : std::unary_function<Key, std::size_t> {
+            std::size_t operator()(const Key&) const;
+        };
+        boost::unordered_map<Key, Schedule, KeyHasher> schedules_;
+    };
+
+}
+
+
+#endif
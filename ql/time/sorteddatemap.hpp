@@ -0,0 +1,351 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file sorteddatemap.hpp
+    \brief date-indexed container stored in sorted contiguous arrays
+*/
+
+#ifndef quantlib_sorted_date_map_hpp
+#define quantlib_sorted_date_map_hpp
+
+#include <ql/time/date.hpp>
+#include <ql/errors.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/iterator/reverse_iterator.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! date-indexed container stored in sorted contiguous arrays
+    /*! This class can be used as the container of a TimeSeries in
+        place of the default std::map, e.g., as in
+        <tt>TimeSeries<Real, SortedDateMap<Real> ></tt>.  Dates and
+        values are stored in two separate arrays sorted by date;
+        lookups are binary searches, and the values can be read as a
+        contiguous array through the data() method without copying
+        them.
+
+        The container is meant for long histories which are loaded
+        once and extended with later data.  Appending a datum after
+        the last date takes amortized constant time; inserting it
+        before takes linear time.
+
+        The data can be saved to a binary file and read back by
+        mapping the file in memory, so that only the pages being
+        accessed are loaded and the data are shared between
+        processes.  A mapped container is read-only; the data are
+        copied in memory when the container is first modified.
+        Copies of a mapped container share the mapping.
+
+        \pre T must be trivially copyable for the data to be saved
+             and mapped.
+
+        \warning The dates are stored as serial numbers; the time of
+                 the day is not stored when intraday dates are
+                 enabled.  The binary format uses the native byte
+                 order and is not portable across platforms.
+    */
+    template <class T>
+    class SortedDateMap {
+      public:
+        typedef Date key_type;
+        typedef T mapped_type;
+        typedef std::pair<Date, T> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Size size_type;
+
+        //! random-access iterator returning the data by value
+        class const_iterator {
+          public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef typename SortedDateMap::value_type value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef value_type reference;
+            class pointer {
+              public:
+                explicit pointer(const value_type& v) : v_(v) {}
+                const value_type* operator->() const { return &v_; }
+              private:
+                value_type v_;
+            };
+
+            const_iterator() : m_(0), i_(0) {}
+            reference operator*() const {
+                return value_type(m_->date(i_), m_->data()[i_]);
+            }
+            pointer operator->() const { return pointer(**this); }
+            reference operator[](difference_type n) const {
+                return *(*this + n);
+            }
+            const_iterator& operator++() { ++i_; return *this; }
+            const_iterator operator++(int) {
+                const_iterator tmp = *this; ++i_; return tmp;
+            }
+            const_iterator& operator--() { --i_; return *this; }
+            const_iterator operator--(int) {
+                const_iterator tmp = *this; --i_; return tmp;
+            }
+            const_iterator& operator+=(difference_type n) {
+                i_ += n; return *this;
+            }
+            const_iterator& operator-=(difference_type n) {
+                i_ -= n; return *this;
+            }
+            const_iterator operator+(difference_type n) const {
+                return const_iterator(m_, i_+n);
+            }
+            const_iterator operator-(difference_type n) const {
+                return const_iterator(m_, i_-n);
+            }
+            difference_type operator-(const const_iterator& j) const {
+                return i_ - j.i_;
+            }
+            bool operator==(const const_iterator& j) const {
+                return i_ == j.i_;
+            }
+            bool operator!=(const const_iterator& j) const {
+                return i_ != j.i_;
+            }
+            bool operator<(const const_iterator& j) const {
+                return i_ < j.i_;
+            }
+            bool operator>(const const_iterator& j) const {
+                return i_ > j.i_;
+            }
+            bool operator<=(const const_iterator& j) const {
+                return i_ <= j.i_;
+            }
+            bool operator>=(const const_iterator& j) const {
+                return i_ >= j.i_;
+            }
+            //! the position of the datum in the container
+            Size index() const { return Size(i_); }
+          private:
+            friend class SortedDateMap;
+            const_iterator(const SortedDateMap* m, difference_type i)
+            : m_(m), i_(i) {}
+            const SortedDateMap* m_;
+            difference_type i_;
+        };
+        typedef const_iterator iterator;
+        typedef boost::reverse_iterator<const_iterator>
+                                                     const_reverse_iterator;
+
+        SortedDateMap() : dates_(0), values_(0), size_(0) {}
+        SortedDateMap(const SortedDateMap& m)
+        : mapping_(m.mapping_), serials_(m.serials_), data_(m.data_),
+          dates_(m.dates_), values_(m.values_), size_(m.size_) {
+            refresh(size_);
+        }
+        SortedDateMap& operator=(const SortedDateMap& m) {
+            if (&m != this) {
+                mapping_ = m.mapping_;
+                serials_ = m.serials_;
+                data_ = m.data_;
+                dates_ = m.dates_;
+                values_ = m.values_;
+                refresh(m.size_);
+            }
+            return *this;
+        }
+        //! maps in memory a file written by save()
+        static SortedDateMap map(const std::string& filename);
+        //! writes the data to a binary file
+        void save(const std::string& filename) const;
+
+        //! \name Inspectors
+        //@{
+        Size size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        //! whether the data are read from a mapped file
+        bool mapped() const { return static_cast<bool>(mapping_); }
+        Date date(Size i) const { return Date(dates_[i]); }
+        //@}
+
+        //! \name Contiguous access
+        /*! The returned arrays have size() elements and are valid
+            until the container is modified.
+        */
+        //@{
+        const T* data() const { return values_; }
+        const boost::int32_t* serialNumbers() const { return dates_; }
+        //@}
+
+        //! \name Associative-container interface
+        //@{
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, size_); }
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+        const_iterator find(const Date& d) const {
+            Size i = lowerBound(d);
+            return (i < size_ && dates_[i] == d.serialNumber()) ?
+                const_iterator(this, i) : end();
+        }
+        //! returns the datum for the given date, inserting it if missing
+        T& operator[](const Date& d);
+        void clear() {
+            mapping_.reset();
+            serials_.clear();
+            data_.clear();
+            refresh(0);
+        }
+        //@}
+      private:
+        struct Header {
+            char tag[8];
+            boost::uint64_t size;
+            boost::uint32_t dateSize, valueSize;
+            boost::uint64_t valuesOffset;
+        };
+        static const char* tag() { return "QLSDMAP1"; }
+        static boost::uint64_t valuesOffset(boost::uint64_t n) {
+            // the values are aligned to 16 bytes
+            boost::uint64_t offset =
+                sizeof(Header) + n*sizeof(boost::int32_t);
+            return (offset + 15) / 16 * 16;
+        }
+        struct Mapping {
+            boost::interprocess::file_mapping file;
+            boost::interprocess::mapped_region region;
+        };
+        Size lowerBound(const Date& d) const {
+            return std::lower_bound(dates_, dates_+size_,
+                                    boost::int32_t(d.serialNumber()))
+                - dates_;
+        }
+        // points to the owned arrays unless the data are mapped
+        void refresh(Size n) {
+            if (!mapping_) {
+                dates_ = serials_.empty() ? 0 : &serials_[0];
+                values_ = data_.empty() ? 0 : &data_[0];
+            }
+            size_ = n;
+        }
+        void copyOnWrite() {
+            if (mapping_) {
+                serials_.assign(dates_, dates_+size_);
+                data_.assign(values_, values_+size_);
+                mapping_.reset();
+                refresh(size_);
+            }
+        }
+        boost::shared_ptr<Mapping> mapping_;
+        std::vector<boost::int32_t> serials_;
+        std::vector<T> data_;
+        const boost::int32_t* dates_;
+        const T* values_;
+        Size size_;
+    };
+
+
+    // template definitions
+
+    template <class T>
+    T& SortedDateMap<T>::operator[](const Date& d) {
+        copyOnWrite();
+        boost::int32_t s = boost::int32_t(d.serialNumber());
+        if (size_ == 0 || s > serials_.back()) {
+            // appending is the common case
+            serials_.push_back(s);
+            data_.push_back(T());
+            refresh(size_+1);
+            return data_.back();
+        }
+        Size i = lowerBound(d);
+        if (serials_[i] != s) {
+            serials_.insert(serials_.begin()+i, s);
+            data_.insert(data_.begin()+i, T());
+            refresh(size_+1);
+        }
+        return data_[i];
+    }
+
+    template <class T>
+    void SortedDateMap<T>::save(const std::string& filename) const {
+        std::ofstream out(filename.c_str(),
+                          std::ios::out | std::ios::binary | std::ios::trunc);
+        QL_REQUIRE(out.good(), "cannot open " << filename << " for writing");
+        Header h;
+        std::memset(&h, 0, sizeof(Header));
+        std::memcpy(h.tag, tag(), sizeof(h.tag));
+        h.size = size_;
+        h.dateSize = sizeof(boost::int32_t);
+        h.valueSize = sizeof(T);
+        h.valuesOffset = valuesOffset(size_);
+        out.write(reinterpret_cast<const char*>(&h), sizeof(Header));
+        out.write(reinterpret_cast<const char*>(dates_),
+                  size_*sizeof(boost::int32_t));
+        std::vector<char> padding(h.valuesOffset - sizeof(Header)
+                                  - size_*sizeof(boost::int32_t), 0);
+        if (!padding.empty())
+            out.write(&padding[0], padding.size());
+        out.write(reinterpret_cast<const char*>(values_), size_*sizeof(T));
+        QL_REQUIRE(out.good(), "error while writing " << filename);
+    }
+
+    template <class T>
+    SortedDateMap<T> SortedDateMap<T>::map(const std::string& filename) {
+        using namespace boost::interprocess;
+        boost::shared_ptr<Mapping> m(new Mapping);
+        try {
+            file_mapping(filename.c_str(), read_only).swap(m->file);
+            mapped_region(m->file, read_only).swap(m->region);
+        } catch (std::exception& e) {
+            QL_FAIL("cannot map " << filename << ": " << e.what());
+        }
+
+        const char* base = static_cast<const char*>(m->region.get_address());
+        Size length = m->region.get_size();
+        QL_REQUIRE(length >= sizeof(Header),
+                   filename << " is not a date-map file");
+        Header h;
+        std::memcpy(&h, base, sizeof(Header));
+        QL_REQUIRE(std::memcmp(h.tag, tag(), sizeof(h.tag)) == 0,
+                   filename << " is not a date-map file");
+        QL_REQUIRE(h.dateSize == sizeof(boost::int32_t) &&
+                   h.valueSize == sizeof(T),
+                   filename << " was written for a different value type");
+        QL_REQUIRE(h.valuesOffset == valuesOffset(h.size) &&
+                   length >= h.valuesOffset + h.size*sizeof(T),
+                   filename << " is truncated");
+
+        SortedDateMap result;
+        result.mapping_ = m;
+        result.dates_ =
+            reinterpret_cast<const boost::int32_t*>(base + sizeof(Header));
+        result.values_ = reinterpret_cast<const T*>(base + h.valuesOffset);
+        result.size_ = Size(h.size);
+        return result;
+    }
+
+}
+
+#endif
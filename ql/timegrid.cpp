@@ -23,43 +23,127 @@
 
 namespace QuantLib {
 
+    TimeGrid::TimeGrid() : data_(new Data) {}
+
     TimeGrid::TimeGrid(Time end, Size steps) {
         // We seem to assume that the grid begins at 0.
         // Let's enforce the assumption for the time being
         // (even though I'm not sure that I agree.)
         QL_REQUIRE(end > 0.0,
                    "negative times not allowed");
+        boost::shared_ptr<Data> data(new Data);
         Time dt = end/steps;
-        times_.reserve(steps+1);
+        data->times.reserve(steps+1);
         for (Size i=0; i<=steps; i++)
-            times_.push_back(dt*i);
+            data->times.push_back(dt*i);
+
+        data->mandatoryTimes = std::vector<Time>(1);
+        data->mandatoryTimes[0] = end;
+
+        data->dt = std::vector<Time>(steps,dt);
+        data_ = data;
+    }
+
+    void TimeGrid::initialize(std::vector<Time>& mandatoryTimes,
+                              bool addSteps, Size steps) {
+        QL_REQUIRE(!mandatoryTimes.empty(), "no times given");
+        std::sort(mandatoryTimes.begin(),mandatoryTimes.end());
+        // We seem to assume that the grid begins at 0.
+        // Let's enforce the assumption for the time being
+        // (even though I'm not sure that I agree.)
+        QL_REQUIRE(mandatoryTimes.front() >= 0.0,
+                   "negative times not allowed");
+        std::vector<Time>::iterator e =
+            std::unique(mandatoryTimes.begin(),mandatoryTimes.end(),
+                        std::ptr_fun(close_enough));
+        mandatoryTimes.resize(e - mandatoryTimes.begin());
+
+        boost::shared_ptr<Data> data(new Data);
+        std::vector<Time>& times = data->times;
+
+        if (!addSteps) {
+            times.reserve(mandatoryTimes.size()+1);
+            if (mandatoryTimes[0] > 0.0)
+                times.push_back(0.0);
+            times.insert(times.end(),
+                         mandatoryTimes.begin(), mandatoryTimes.end());
+        } else {
+            Time last = mandatoryTimes.back();
+            Time dtMax;
+            // The resulting timegrid have points at times listed in the
+            // input list. Between these points, there are inner-points
+            // which are regularly spaced.
+            if (steps == 0) {
+                std::vector<Time> diff;
+                std::adjacent_difference(mandatoryTimes.begin(),
+                                         mandatoryTimes.end(),
+                                         std::back_inserter(diff));
+                if (diff.front()==0.0)
+                    diff.erase(diff.begin());
+                dtMax = *(std::min_element(diff.begin(), diff.end()));
+            } else {
+                dtMax = last/steps;
+            }
+
+            // the number of steps in each period is determined first,
+            // so that the grid can be allocated at once
+            std::vector<Size> periodSteps(mandatoryTimes.size(), 0);
+            Size totalSteps = 0;
+            Time periodBegin = 0.0;
+            for (Size i=0; i<mandatoryTimes.size(); ++i) {
+                Time periodEnd = mandatoryTimes[i];
+                if (periodEnd != 0.0) {
+                    // the nearest integer
+                    Size nSteps = Size((periodEnd - periodBegin)/dtMax+0.5);
+                    // at least one time step!
+                    periodSteps[i] = (nSteps!=0 ? nSteps : 1);
+                    totalSteps += periodSteps[i];
+                }
+                periodBegin = periodEnd;
+            }
 
-        mandatoryTimes_ = std::vector<Time>(1);
-        mandatoryTimes_[0] = end;
+            times.reserve(totalSteps+1);
+            times.push_back(0.0);
+            periodBegin = 0.0;
+            for (Size i=0; i<mandatoryTimes.size(); ++i) {
+                Time periodEnd = mandatoryTimes[i];
+                if (periodSteps[i] != 0) {
+                    Time dt = (periodEnd - periodBegin)/periodSteps[i];
+                    for (Size n=1; n<=periodSteps[i]; ++n)
+                        times.push_back(periodBegin + n*dt);
+                }
+                periodBegin = periodEnd;
+            }
+        }
 
-        dt_ = std::vector<Time>(steps,dt);
+        data->dt.reserve(times.size()-1);
+        std::adjacent_difference(times.begin()+1,times.end(),
+                                 std::back_inserter(data->dt));
+        data->mandatoryTimes.swap(mandatoryTimes);
+        data_ = data;
     }
 
     Size TimeGrid::index(Time t) const {
+        const std::vector<Time>& times = data_->times;
         Size i = closestIndex(t);
-        if (close_enough(t,times_[i])) {
+        if (close_enough(t,times[i])) {
             return i;
         } else {
-            if (t < times_.front()) {
+            if (t < times.front()) {
                 QL_FAIL("using inadequate time grid: all nodes "
                         "are later than the required time t = "
                         << std::setprecision(12) << t
                         << " (earliest node is t1 = "
-                        << std::setprecision(12) << times_.front() << ")");
-            } else if (t > times_.back()) {
+                        << std::setprecision(12) << times.front() << ")");
+            } else if (t > times.back()) {
                 QL_FAIL("using inadequate time grid: all nodes "
                         "are earlier than the required time t = "
                         << std::setprecision(12) << t
                         << " (latest node is t1 = "
-                        << std::setprecision(12) << times_.back() << ")");
+                        << std::setprecision(12) << times.back() << ")");
             } else {
                 Size j, k;
-                if (t > times_[i]) {
+                if (t > times[i]) {
                     j = i;
                     k = i+1;
                 } else {
@@ -70,15 +154,16 @@ namespace QuantLib {
                         "to the required time t = "
                         << std::setprecision(12) << t
                         << " are t1 = "
-                        << std::setprecision(12) << times_[j]
+                        << std::setprecision(12) << times[j]
                         << " and t2 = "
-                        << std::setprecision(12) << times_[k]);
+                        << std::setprecision(12) << times[k]);
             }
         }
     }
 
     Size TimeGrid::closestIndex(Time t) const {
-        const_iterator begin = times_.begin(), end = times_.end();
+        const_iterator begin = data_->times.begin(),
+                       end = data_->times.end();
         const_iterator result = std::lower_bound(begin, end, t);
         if (result == begin) {
             return 0;
@@ -94,5 +179,43 @@ namespace QuantLib {
         }
     }
 
-}
 
+    TimeGridCache::TimeGridCache(Size maxSize)
+    : maxSize_(maxSize) {
+        QL_REQUIRE(maxSize_ > 0, "null maximum size given");
+    }
+
+    TimeGrid TimeGridCache::grid(Time end, Size steps) {
+        Key key(std::make_pair(Regular, steps), std::vector<Time>(1, end));
+        std::map<Key, TimeGrid>::const_iterator i = grids_.find(key);
+        if (i != grids_.end())
+            return i->second;
+        return insert(key, TimeGrid(end, steps));
+    }
+
+    TimeGrid TimeGridCache::grid(const std::vector<Time>& mandatoryTimes) {
+        Key key(std::make_pair(Mandatory, Size(0)), mandatoryTimes);
+        std::map<Key, TimeGrid>::const_iterator i = grids_.find(key);
+        if (i != grids_.end())
+            return i->second;
+        return insert(key, TimeGrid(mandatoryTimes.begin(),
+                                    mandatoryTimes.end()));
+    }
+
+    TimeGrid TimeGridCache::grid(const std::vector<Time>& mandatoryTimes,
+                                 Size steps) {
+        Key key(std::make_pair(MandatoryWithSteps, steps), mandatoryTimes);
+        std::map<Key, TimeGrid>::const_iterator i = grids_.find(key);
+        if (i != grids_.end())
+            return i->second;
+        return insert(key, TimeGrid(mandatoryTimes.begin(),
+                                    mandatoryTimes.end(), steps));
+    }
+
+    TimeGrid& TimeGridCache::insert(const Key& key, const TimeGrid& grid) {
+        if (grids_.size() >= maxSize_)
+            grids_.clear();
+        return grids_[key] = grid;
+    }
+
+}
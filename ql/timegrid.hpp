@@ -27,13 +27,19 @@
 
 #include <ql/errors.hpp>
 #include <ql/math/comparison.hpp>
+#include <boost/shared_ptr.hpp>
 #include <vector>
+#include <map>
 #include <numeric>
+#include <algorithm>
 
 namespace QuantLib {
 
     //! time grid class
-    /*! \todo what was the rationale for limiting the grid to
+    /*! Copies of a time grid share the same (immutable) data, so
+        that they can be stored cheaply by paths and lattices.
+
+        \todo what was the rationale for limiting the grid to
               positive times? Investigate and see whether we
               can use it for negative ones as well.
     */
@@ -41,7 +47,7 @@ namespace QuantLib {
       public:
         //! \name Constructors
         //@{
-        TimeGrid() {}
+        TimeGrid();
         //! Regularly spaced time-grid
         TimeGrid(Time end, Size steps);
         //! Time grid with mandatory time points
@@ -49,28 +55,9 @@ namespace QuantLib {
             No additional points are added.
         */
         template <class Iterator>
-        TimeGrid(Iterator begin, Iterator end)
-        : mandatoryTimes_(begin, end) {
-            std::sort(mandatoryTimes_.begin(),mandatoryTimes_.end());
-            // We seem to assume that the grid begins at 0.
-            // Let's enforce the assumption for the time being
-            // (even though I'm not sure that I agree.)
-            QL_REQUIRE(mandatoryTimes_.front() >= 0.0,
-                       "negative times not allowed");
-            std::vector<Time>::iterator e =
-                std::unique(mandatoryTimes_.begin(),mandatoryTimes_.end(),
-                            std::ptr_fun(close_enough));
-            mandatoryTimes_.resize(e - mandatoryTimes_.begin());
-
-            if (mandatoryTimes_[0] > 0.0)
-                times_.push_back(0.0);
-
-            times_.insert(times_.end(),
-                          mandatoryTimes_.begin(), mandatoryTimes_.end());
-
-            std::adjacent_difference(times_.begin()+1,times_.end(),
-                                     std::back_inserter(dt_));
-
+        TimeGrid(Iterator begin, Iterator end) {
+            std::vector<Time> mandatoryTimes(begin, end);
+            initialize(mandatoryTimes, false, 0);
         }
         //! Time grid with mandatory time points
         /*! Mandatory points are guaranteed to belong to the grid.
@@ -79,57 +66,9 @@ namespace QuantLib {
             desired number of steps.
         */
         template <class Iterator>
-        TimeGrid(Iterator begin, Iterator end, Size steps)
-        : mandatoryTimes_(begin, end) {
-            std::sort(mandatoryTimes_.begin(),mandatoryTimes_.end());
-            // We seem to assume that the grid begins at 0.
-            // Let's enforce the assumption for the time being
-            // (even though I'm not sure that I agree.)
-            QL_REQUIRE(mandatoryTimes_.front() >= 0.0,
-                       "negative times not allowed");
-            std::vector<Time>::iterator e =
-                std::unique(mandatoryTimes_.begin(),mandatoryTimes_.end(),
-                            std::ptr_fun(close_enough));
-            mandatoryTimes_.resize(e - mandatoryTimes_.begin());
-
-            Time last = mandatoryTimes_.back();
-            Time dtMax;
-            // The resulting timegrid have points at times listed in the input
-            // list. Between these points, there are inner-points which are
-            // regularly spaced.
-            if (steps == 0) {
-                std::vector<Time> diff;
-                std::adjacent_difference(mandatoryTimes_.begin(),
-                                         mandatoryTimes_.end(),
-                                         std::back_inserter(diff));
-                if (diff.front()==0.0)
-                    diff.erase(diff.begin());
-                dtMax = *(std::min_element(diff.begin(), diff.end()));
-            } else {
-                dtMax = last/steps;
-            }
-
-            Time periodBegin = 0.0;
-            times_.push_back(periodBegin);
-            for (std::vector<Time>::const_iterator t=mandatoryTimes_.begin();
-                                                   t<mandatoryTimes_.end();
-                                                   ++t) {
-                Time periodEnd = *t;
-                if (periodEnd != 0.0) {
-                    // the nearest integer
-                    Size nSteps = Size((periodEnd - periodBegin)/dtMax+0.5);
-                    // at least one time step!
-                    nSteps = (nSteps!=0 ? nSteps : 1);
-                    Time dt = (periodEnd - periodBegin)/nSteps;
-                    times_.reserve(nSteps);
-                    for (Size n=1; n<=nSteps; ++n)
-                        times_.push_back(periodBegin + n*dt);
-                }
-                periodBegin = periodEnd;
-            }
-
-            std::adjacent_difference(times_.begin()+1,times_.end(),
-                                     std::back_inserter(dt_));
+        TimeGrid(Iterator begin, Iterator end, Size steps) {
+            std::vector<Time> mandatoryTimes(begin, end);
+            initialize(mandatoryTimes, true, steps);
         }
         //@}
         //! \name Time grid interface
@@ -140,12 +79,12 @@ namespace QuantLib {
         Size closestIndex(Time t) const;
         //! returns the time on the grid closest to the given t
         Time closestTime(Time t) const {
-            return times_[closestIndex(t)];
+            return data_->times[closestIndex(t)];
         }
         const std::vector<Time>& mandatoryTimes() const {
-            return mandatoryTimes_;
+            return data_->mandatoryTimes;
         }
-        Time dt(Size i) const { return dt_[i]; }
+        Time dt(Size i) const { return data_->dt[i]; }
         //@}
         //! \name sequence interface
         //@{
@@ -153,21 +92,60 @@ namespace QuantLib {
         typedef std::vector<Time>::const_reverse_iterator
                                           const_reverse_iterator;
 
-        Time operator[](Size i) const { return times_[i]; }
-        Time at(Size i) const { return times_.at(i); }
-        Size size() const { return times_.size(); }
-        bool empty() const { return times_.empty(); }
-        const_iterator begin() const { return times_.begin(); }
-        const_iterator end() const { return times_.end(); }
-        const_reverse_iterator rbegin() const { return times_.rbegin(); }
-        const_reverse_iterator rend() const { return times_.rend(); }
-        Time front() const { return times_.front(); }
-        Time back() const { return times_.back(); }
+        Time operator[](Size i) const { return data_->times[i]; }
+        Time at(Size i) const { return data_->times.at(i); }
+        Size size() const { return data_->times.size(); }
+        bool empty() const { return data_->times.empty(); }
+        const_iterator begin() const { return data_->times.begin(); }
+        const_iterator end() const { return data_->times.end(); }
+        const_reverse_iterator rbegin() const {
+            return data_->times.rbegin();
+        }
+        const_reverse_iterator rend() const { return data_->times.rend(); }
+        Time front() const { return data_->times.front(); }
+        Time back() const { return data_->times.back(); }
         //@}
       private:
-        std::vector<Time> times_;
-        std::vector<Time> dt_;
-        std::vector<Time> mandatoryTimes_;
+        struct Data {
+            std::vector<Time> times;
+            std::vector<Time> dt;
+            std::vector<Time> mandatoryTimes;
+        };
+        void initialize(std::vector<Time>& mandatoryTimes,
+                        bool addSteps, Size steps);
+        boost::shared_ptr<const Data> data_;
+    };
+
+
+    //! cache of time grids
+    /*! The cache returns the same grid, whose data are shared by all
+        its copies, when asked repeatedly for a grid with the same
+        mandatory times and number of steps.  It can be used by
+        engines that would otherwise build the same grid for each
+        instrument they price.
+
+        The cache is emptied when it reaches its maximum size.
+
+        \warning The cache is not thread-safe; each thread should
+                 use its own.
+    */
+    class TimeGridCache {
+      public:
+        explicit TimeGridCache(Size maxSize = 100);
+        //! same as TimeGrid(end, steps)
+        TimeGrid grid(Time end, Size steps);
+        //! same as TimeGrid(times.begin(), times.end())
+        TimeGrid grid(const std::vector<Time>& mandatoryTimes);
+        //! same as TimeGrid(times.begin(), times.end(), steps)
+        TimeGrid grid(const std::vector<Time>& mandatoryTimes, Size steps);
+        Size size() const { return grids_.size(); }
+        void clear() { grids_.clear(); }
+      private:
+        enum Kind { Regular, Mandatory, MandatoryWithSteps };
+        typedef std::pair<std::pair<Kind, Size>, std::vector<Time> > Key;
+        TimeGrid& insert(const Key& key, const TimeGrid& grid);
+        Size maxSize_;
+        std::map<Key, TimeGrid> grids_;
     };
 
 }
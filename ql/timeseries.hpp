@@ -45,6 +45,10 @@ namespace QuantLib {
 
         \pre The <c>Container</c> type must satisfy the requirements
              set by the C++ standard for associative containers.
+
+        \note SortedDateMap can be used as a container for long
+              histories; it stores the data in contiguous arrays and
+              can read them from a memory-mapped file.
     */
     template <class T, class Container = std::map<Date, T> >
     class TimeSeries {
@@ -56,6 +60,11 @@ namespace QuantLib {
       public:
         /*! Default constructor */
         TimeSeries() {}
+        /*! This constructor initializes the history with the data
+            stored in the given container, e.g., a SortedDateMap
+            mapped from a file.
+        */
+        explicit TimeSeries(const Container& values) : values_(values) {}
         /*! This constructor initializes the history with a set of
             values passed as two sequences, the first containing dates
             and the second containing corresponding values.
@@ -93,8 +102,9 @@ namespace QuantLib {
         //@{
         //! returns the (possibly null) datum corresponding to the given date
         T operator[](const Date& d) const {
-            if (values_.find(d) != values_.end())
-                return values_[d];
+            const_iterator i = values_.find(d);
+            if (i != values_.end())
+                return i->second;
             else
                 return Null<T>();
         }
@@ -226,6 +236,12 @@ namespace QuantLib {
         std::vector<Date> dates() const;
         //! returns the historical data
         std::vector<T> values() const;
+        //! returns the underlying container
+        /*! This allows to access the data without copying them when
+            the container provides a suitable interface, e.g., the
+            contiguous arrays of SortedDateMap.
+        */
+        const Container& container() const { return values_; }
         //@}
 
       private:
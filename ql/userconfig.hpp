@@ -47,6 +47,12 @@
 //#   define QL_ENABLE_TRACING
 #endif
 
+/* Define this if timers and counters on hot paths should be allowed
+   (whether they are actually recorded will depend on run-time settings.) */
+#ifndef QL_ENABLE_INSTRUMENTATION
+//#   define QL_ENABLE_INSTRUMENTATION
+#endif
+
 /* Define this if negative rates should be allowed. */
 #ifndef QL_NEGATIVE_RATES
 #   define QL_NEGATIVE_RATES
@@ -80,6 +86,13 @@
 //#    define QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 #endif
 
+/* Define this to use the Disposable class template instead of move
+   semantics on compilers supporting rvalue references.  It is always
+   used on compilers that don't. */
+#ifndef QL_USE_DISPOSABLE
+//#    define QL_USE_DISPOSABLE
+#endif
+
 /* Define this to enable a date resolution down to microseconds and
    allow for accurate intraday pricing.*/
 #ifndef QL_HIGH_RESOLUTION_DATE
@@ -91,11 +104,40 @@
 //#    define QL_ENABLE_PARALLEL_UNIT_TEST_RUNNER
 #endif
 
-/* Define this to make Singleton initialization thread-safe.
-   Note: There is no support for thread safety and multiple sessions.
-*/
+/* Define this to make Singleton initialization thread-safe.  When
+   sessions are enabled, the creation of the instance for a new
+   session is serialized. */
 #ifndef QL_ENABLE_SINGLETON_THREAD_SAFE_INIT
 //#   define QL_ENABLE_SINGLETON_THREAD_SAFE_INIT
 #endif
 
+/* Define this to enable the MPI implementation of SampleCommunicator,
+   which distributes Monte Carlo simulations among processes.  The
+   code using it must then be compiled and linked with MPI.
+*/
+#ifndef QL_ENABLE_MPI
+//#   define QL_ENABLE_MPI
+#endif
+
+/* Define this to delegate matrix products and decompositions to BLAS
+   and LAPACK. The library must then be linked to an implementation
+   of both, e.g., the reference one, OpenBLAS or MKL.
+*/
+#ifndef QL_USE_LAPACK
+//#   define QL_USE_LAPACK
+#endif
+
+/* Define this to use polynomial approximations of exponentials and
+   logarithms in the Monte Carlo kernels (see ql/math/fastmath.hpp),
+   with a relative error below 1e-12. Define QL_FAST_MATH_LOW_ACCURACY
+   as well to lower it to 1e-7. The approximations are only faster
+   when the compiler vectorizes them.
+*/
+#ifndef QL_FAST_MATH
+//#   define QL_FAST_MATH
+#endif
+#ifndef QL_FAST_MATH_LOW_ACCURACY
+//#   define QL_FAST_MATH_LOW_ACCURACY
+#endif
+
 #endif
@@ -5,9 +5,11 @@
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/utilities/dataparsers.hpp>
 #include <ql/utilities/disposable.hpp>
+#include <ql/utilities/instrumentation.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/utilities/null_deleter.hpp>
 #include <ql/utilities/observablevalue.hpp>
+#include <ql/utilities/smallset.hpp>
 #include <ql/utilities/steppingiterator.hpp>
 #include <ql/utilities/tracing.hpp>
 #include <ql/utilities/vectors.hpp>
@@ -28,6 +28,8 @@
 
 namespace QuantLib {
 
+    #if defined(QL_USE_DISPOSABLE)
+
     //! generic disposable object with move semantics
     /*! This class can be used for returning a value by copy. It relies
         on the returned object exposing a <tt>swap(T\&)</tt> method through
@@ -59,6 +61,11 @@ namespace QuantLib {
             return temp;
         }
         \endcode
+
+        \note This class is only used on compilers without rvalue
+              references, or if QL_USE_DISPOSABLE is defined.
+              Otherwise, <tt>Disposable\<T\></tt> is an alias for
+              <tt>T</tt> and the returned objects are moved.
     */
     template <class T>
     class Disposable : public T {
@@ -87,6 +94,13 @@ namespace QuantLib {
         return *this;
     }
 
+    #else
+
+    template <class T>
+    using Disposable = T;
+
+    #endif
+
 }
 
 
@@ -0,0 +1,304 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/utilities/instrumentation.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace QuantLib {
+
+    bool Instrumentation::enabled_ = false;
+
+    namespace {
+
+        // microseconds from an arbitrary origin, on a monotonic clock
+        Real now() {
+            #if defined(_WIN32)
+            LARGE_INTEGER frequency, counter;
+            QueryPerformanceFrequency(&frequency);
+            QueryPerformanceCounter(&counter);
+            return Real(counter.QuadPart)*1.0e6/Real(frequency.QuadPart);
+            #else
+            timespec t;
+            clock_gettime(CLOCK_MONOTONIC, &t);
+            return t.tv_sec*1.0e6 + t.tv_nsec*1.0e-3;
+            #endif
+        }
+
+        struct Totals {
+            const char* name;
+            Size count;
+            Real total, max;
+        };
+
+        // Names are looked up by address, since they're usually the
+        // same literal; few distinct names are expected on a thread,
+        // so a linear search is faster than a map.
+        struct ThreadData {
+            Size thread, depth;
+            std::vector<Instrumentation::Event> ring;
+            Size recorded;
+            std::vector<Totals> timers;
+            std::vector<std::pair<const char*, Size> > counters;
+        };
+
+        Size bufferSize_ = 65536;
+
+        // The data of a thread are kept after it ends, so that they
+        // can still be aggregated.
+        std::vector<ThreadData*>& registry() {
+            static std::vector<ThreadData*> threads;
+            return threads;
+        }
+
+        QL_THREAD_LOCAL ThreadData* data_ = 0;
+
+        ThreadData* threadData() {
+            if (!data_) {
+                ThreadData* d = new ThreadData;
+                d->depth = 0;
+                d->recorded = 0;
+                #pragma omp critical(ql_instrumentation_registry)
+                {
+                    d->ring.resize(bufferSize_);
+                    d->thread = registry().size();
+                    registry().push_back(d);
+                }
+                data_ = d;
+            }
+            return data_;
+        }
+
+        bool earlier(const Instrumentation::Event& e1,
+                     const Instrumentation::Event& e2) {
+            return e1.start < e2.start;
+        }
+
+        void writeEscaped(std::ostream& out, const std::string& s) {
+            for (Size i=0; i<s.size(); ++i) {
+                if (s[i] == '"' || s[i] == '\\')
+                    out << '\\';
+                out << s[i];
+            }
+        }
+
+    }
+
+    void Instrumentation::Scope::start() {
+        ++threadData()->depth;
+        start_ = now();
+    }
+
+    void Instrumentation::Scope::stop() {
+        Real end = now();
+        ThreadData* d = threadData();
+        --d->depth;
+
+        if (!d->ring.empty()) {
+            Event& e = d->ring[d->recorded % d->ring.size()];
+            e.name = name_;
+            e.object = object_;
+            e.thread = d->thread;
+            e.depth = d->depth;
+            e.start = start_;
+            e.duration = end - start_;
+        }
+        ++d->recorded;
+
+        for (Size i=0; i<d->timers.size(); ++i) {
+            Totals& t = d->timers[i];
+            if (t.name == name_) {
+                ++t.count;
+                t.total += end - start_;
+                t.max = std::max(t.max, end - start_);
+                return;
+            }
+        }
+        Totals t = { name_, 1, end - start_, end - start_ };
+        d->timers.push_back(t);
+    }
+
+    void Instrumentation::enable() {
+        #if defined(QL_ENABLE_INSTRUMENTATION)
+        enabled_ = true;
+        #else
+        QL_FAIL("instrumentation support not available");
+        #endif
+    }
+
+    void Instrumentation::setBufferSize(Size events) {
+        #pragma omp critical(ql_instrumentation_registry)
+        bufferSize_ = events;
+    }
+
+    void Instrumentation::add(const char* name, Size n) {
+        ThreadData* d = threadData();
+        for (Size i=0; i<d->counters.size(); ++i) {
+            if (d->counters[i].first == name) {
+                d->counters[i].second += n;
+                return;
+            }
+        }
+        d->counters.push_back(std::make_pair(name, n));
+    }
+
+    std::vector<Instrumentation::Event> Instrumentation::events() {
+        std::vector<Event> result;
+        const std::vector<ThreadData*>& threads = registry();
+        for (Size i=0; i<threads.size(); ++i) {
+            const ThreadData* d = threads[i];
+            Size n = std::min(d->recorded, d->ring.size());
+            result.insert(result.end(), d->ring.begin(), d->ring.begin()+n);
+        }
+        std::sort(result.begin(), result.end(), earlier);
+        return result;
+    }
+
+    std::vector<Instrumentation::TimerTotals> Instrumentation::timers() {
+        std::map<std::string, TimerTotals> totals;
+        const std::vector<ThreadData*>& threads = registry();
+        for (Size i=0; i<threads.size(); ++i) {
+            const std::vector<Totals>& timers = threads[i]->timers;
+            for (Size j=0; j<timers.size(); ++j) {
+                TimerTotals& t = totals[timers[j].name];
+                if (t.name.empty()) {
+                    t.name = timers[j].name;
+                    t.count = 0;
+                    t.total = t.max = 0.0;
+                }
+                t.count += timers[j].count;
+                t.total += timers[j].total;
+                t.max = std::max(t.max, timers[j].max);
+            }
+        }
+        std::vector<TimerTotals> result;
+        std::map<std::string, TimerTotals>::const_iterator i;
+        for (i=totals.begin(); i!=totals.end(); ++i)
+            result.push_back(i->second);
+        return result;
+    }
+
+    std::vector<Instrumentation::CounterTotals>
+    Instrumentation::counters() {
+        std::map<std::string, Size> totals;
+        const std::vector<ThreadData*>& threads = registry();
+        for (Size i=0; i<threads.size(); ++i) {
+            const std::vector<std::pair<const char*, Size> >& counters =
+                threads[i]->counters;
+            for (Size j=0; j<counters.size(); ++j)
+                totals[counters[j].first] += counters[j].second;
+        }
+        std::vector<CounterTotals> result;
+        std::map<std::string, Size>::const_iterator i;
+        for (i=totals.begin(); i!=totals.end(); ++i) {
+            CounterTotals c = { i->first, i->second };
+            result.push_back(c);
+        }
+        return result;
+    }
+
+    void Instrumentation::reset() {
+        const std::vector<ThreadData*>& threads = registry();
+        for (Size i=0; i<threads.size(); ++i) {
+            threads[i]->recorded = 0;
+            threads[i]->timers.clear();
+            threads[i]->counters.clear();
+        }
+    }
+
+    void Instrumentation::writeChromeTrace(std::ostream& out) {
+        std::vector<Event> recorded = events();
+        Real origin = recorded.empty() ? 0.0 : recorded.front().start;
+        Real last = 0.0;
+
+        out << "{\"traceEvents\":[";
+        std::ios::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::fixed << std::setprecision(3);
+        bool first = true;
+        for (Size i=0; i<recorded.size(); ++i) {
+            const Event& e = recorded[i];
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"name\":\"";
+            writeEscaped(out, e.name);
+            out << "\",\"cat\":\"quantlib\",\"ph\":\"X\""
+                << ",\"ts\":" << e.start - origin
+                << ",\"dur\":" << e.duration
+                << ",\"pid\":0,\"tid\":" << e.thread;
+            if (e.object)
+                out << ",\"args\":{\"object\":\"" << e.object << "\"}";
+            out << "}";
+            last = std::max(last, e.start + e.duration - origin);
+        }
+        // counters are reported with their final value
+        std::vector<CounterTotals> totals = counters();
+        for (Size i=0; i<totals.size(); ++i) {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"name\":\"";
+            writeEscaped(out, totals[i].name);
+            out << "\",\"cat\":\"quantlib\",\"ph\":\"C\""
+                << ",\"ts\":" << last
+                << ",\"pid\":0,\"args\":{\"value\":" << totals[i].value
+                << "}}";
+        }
+        out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    void Instrumentation::writeSummary(std::ostream& out) {
+        std::ios::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+
+        std::vector<TimerTotals> t = timers();
+        out << std::left << std::setw(40) << "timer"
+            << std::right << std::setw(12) << "count"
+            << std::setw(16) << "total [us]"
+            << std::setw(14) << "mean [us]"
+            << std::setw(14) << "max [us]" << "\n";
+        out << std::fixed << std::setprecision(1);
+        for (Size i=0; i<t.size(); ++i) {
+            out << std::left << std::setw(40) << t[i].name
+                << std::right << std::setw(12) << t[i].count
+                << std::setw(16) << t[i].total
+                << std::setw(14) << t[i].total/t[i].count
+                << std::setw(14) << t[i].max << "\n";
+        }
+
+        std::vector<CounterTotals> c = counters();
+        out << "\n" << std::left << std::setw(40) << "counter"
+            << std::right << std::setw(12) << "value" << "\n";
+        for (Size i=0; i<c.size(); ++i) {
+            out << std::left << std::setw(40) << c[i].name
+                << std::right << std::setw(12) << c[i].value << "\n";
+        }
+
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+}
@@ -0,0 +1,218 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file instrumentation.hpp
+    \brief low-overhead timers and counters for hot paths
+*/
+
+#ifndef quantlib_instrumentation_hpp
+#define quantlib_instrumentation_hpp
+
+#include <ql/types.hpp>
+#include <boost/noncopyable.hpp>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! low-overhead timers and counters for hot paths
+    /*! The library is instrumented with scoped timers at the
+        boundaries of its main calculations (lazy-object
+        recalculations, instrument and engine calculations, bootstrap
+        iterations, finite-difference rollbacks and Monte Carlo
+        sampling) and with counters of notifications and steps.  The
+        instrumentation is only compiled in when QL_ENABLE_INSTRUMENTATION
+        is defined; even then, nothing is recorded until it's enabled
+        at run time.
+
+        Each thread records its data in buffers of its own, so that no
+        lock is taken on the hot path: a ring buffer of the most recent
+        timed events, plus running totals per timer and counter that
+        are not limited by the size of the ring.  The data of all
+        threads are aggregated on demand and can be exported in the
+        Chrome trace-event format, readable by chrome://tracing,
+        Perfetto or speedscope, where the nesting of the events shows
+        which calculations a slow one was waiting on.
+
+        \warning The data are read without synchronization: they should
+                 be inspected or reset while no other thread is
+                 recording.  Timer and counter names must be string
+                 literals or otherwise outlive the recorded data.
+    */
+    class Instrumentation {
+      public:
+        //! a timed scope
+        struct Event {
+            const char* name;
+            //! the object the scope refers to, if any
+            const void* object;
+            //! sequential number of the recording thread
+            Size thread;
+            //! number of enclosing timed scopes on the same thread
+            Size depth;
+            //! in microseconds since an arbitrary origin
+            Real start;
+            //! in microseconds
+            Real duration;
+        };
+        //! totals for a timer over all threads
+        struct TimerTotals {
+            std::string name;
+            Size count;
+            //! in microseconds
+            Real total, max;
+        };
+        //! totals for a counter over all threads
+        struct CounterTotals {
+            std::string name;
+            Size value;
+        };
+
+        //! records the duration of its lifetime, if enabled
+        class Scope : private boost::noncopyable {
+          public:
+            explicit Scope(const char* name, const void* object = 0)
+            : name_(name), object_(object), active_(enabled_) {
+                if (active_)
+                    start();
+            }
+            ~Scope() {
+                if (active_)
+                    stop();
+            }
+          private:
+            void start();
+            void stop();
+            const char* name_;
+            const void* object_;
+            bool active_;
+            Real start_;
+        };
+
+        /*! \name Run-time settings
+            Enabling fails if the library was compiled without
+            QL_ENABLE_INSTRUMENTATION.
+        */
+        //@{
+        static void enable();
+        static void disable() { enabled_ = false; }
+        static bool enabled() { return enabled_; }
+        //! number of events kept by threads starting to record later
+        static void setBufferSize(Size events);
+        //@}
+
+        //! adds n to the given counter, if enabled
+        static void count(const char* name, Size n = 1) {
+            if (enabled_)
+                add(name, n);
+        }
+
+        //! \name Aggregated data
+        //@{
+        //! recorded events still in the buffers, sorted by start time
+        static std::vector<Event> events();
+        static std::vector<TimerTotals> timers();
+        static std::vector<CounterTotals> counters();
+        //! discards the data recorded so far
+        static void reset();
+        //@}
+
+        //! \name Output
+        //@{
+        //! writes the events and counters in Chrome trace-event format
+        static void writeChromeTrace(std::ostream&);
+        //! writes a table of the timer and counter totals
+        static void writeSummary(std::ostream&);
+        //@}
+      private:
+        static void add(const char* name, Size n);
+        static bool enabled_;
+    };
+
+}
+
+/*! \addtogroup macros
+    @{
+*/
+
+/*! \defgroup instrumentationMacros Instrumentation macros
+
+    These macros are removed by the preprocessor unless
+    QL_ENABLE_INSTRUMENTATION is defined.
+
+    @{
+*/
+
+/*! \def QL_INSTRUMENT_SCOPE
+    \brief times the enclosing scope
+
+    The statement
+    \code
+    QL_INSTRUMENT_SCOPE("Foo::bar");
+    \endcode
+    records the time spent until the end of the enclosing scope;
+    refer to QuantLib::Instrumentation for details.
+*/
+
+/*! \def QL_INSTRUMENT_OBJECT_SCOPE
+    \brief times the enclosing scope for a given object
+
+    As QL_INSTRUMENT_SCOPE, but the address of the given object is
+    also recorded, so that calculations for different objects can be
+    told apart.
+*/
+
+/*! \def QL_INSTRUMENT_COUNT
+    \brief increments a counter
+
+    The statement
+    \code
+    QL_INSTRUMENT_COUNT("Foo::steps", n);
+    \endcode
+    adds n to the given counter.
+*/
+
+/*! @} */
+
+/*! @} */
+
+#if defined(QL_ENABLE_INSTRUMENTATION)
+
+#define QL_INSTRUMENT_CONCATENATE_(a, b) a##b
+#define QL_INSTRUMENT_CONCATENATE(a, b) QL_INSTRUMENT_CONCATENATE_(a, b)
+
+#define QL_INSTRUMENT_SCOPE(name) \
+QuantLib::Instrumentation::Scope \
+    QL_INSTRUMENT_CONCATENATE(ql_instrument_scope_, __LINE__)(name)
+
+#define QL_INSTRUMENT_OBJECT_SCOPE(name, object) \
+QuantLib::Instrumentation::Scope \
+    QL_INSTRUMENT_CONCATENATE(ql_instrument_scope_, __LINE__)(name, object)
+
+#define QL_INSTRUMENT_COUNT(name, n) \
+QuantLib::Instrumentation::count(name, n)
+
+#else
+
+#define QL_INSTRUMENT_SCOPE(name)
+#define QL_INSTRUMENT_OBJECT_SCOPE(name, object)
+#define QL_INSTRUMENT_COUNT(name, n)
+
+#endif
+
+#endif
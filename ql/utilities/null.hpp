@@ -69,14 +69,17 @@ namespace QuantLib {
 
     }
 
-    // default implementation for built-in types
+    // default implementation for built-in types; Real is also
+    // treated as floating point when QL_REAL is defined as a class,
+    // e.g., as the active type of an automatic differentiation tool
     template <typename T>
     class Null {
       public:
         Null() {}
         operator T() const {
             return T(detail::FloatingPointNull<
-                         boost::is_floating_point<T>::value>::nullValue());
+                         boost::is_floating_point<T>::value ||
+                         boost::is_same<T, Real>::value>::nullValue());
         }
     };
 
@@ -0,0 +1,189 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file smallset.hpp
+    \brief set storing a few elements inline
+*/
+
+#ifndef quantlib_small_set_hpp
+#define quantlib_small_set_hpp
+
+#include <ql/types.hpp>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace QuantLib {
+
+    //! set storing a few elements inline
+    /*! Up to N elements are stored in an array inside the object and
+        looked up linearly, so that small sets don't allocate any
+        memory.  When a further element is inserted, the elements are
+        moved to a set of type S, which is used until the set is
+        emptied or cleared.
+
+        Only the operations needed by the observer pattern are
+        provided.  The order of iteration is unspecified, and any
+        insertion or erasure invalidates the iterators.
+
+        \pre T must be default-constructible and equality-comparable;
+             S must be a set of T, such as std::set<T> or
+             boost::unordered_set<T>.
+    */
+    template <class T, class S, Size N = 3>
+    class SmallSet {
+      public:
+        typedef T value_type;
+        class const_iterator
+            : public std::iterator<std::forward_iterator_tag, T,
+                                   std::ptrdiff_t, const T*, const T&> {
+            friend class SmallSet;
+          public:
+            const_iterator() : item_(0) {}
+            const T& operator*() const { return item_ ? *item_ : *i_; }
+            const T* operator->() const { return &(**this); }
+            const_iterator& operator++() {
+                if (item_)
+                    ++item_;
+                else
+                    ++i_;
+                return *this;
+            }
+            const_iterator operator++(int) {
+                const_iterator tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+            bool operator==(const const_iterator& j) const {
+                return item_ == j.item_ && (item_ != 0 || i_ == j.i_);
+            }
+            bool operator!=(const const_iterator& j) const {
+                return !(*this == j);
+            }
+          private:
+            explicit const_iterator(const T* item) : item_(item) {}
+            explicit const_iterator(typename S::const_iterator i)
+            : item_(0), i_(i) {}
+            // points into the inline array, or null if the set spilled
+            const T* item_;
+            typename S::const_iterator i_;
+        };
+        typedef const_iterator iterator;
+
+        SmallSet() : size_(0), set_(0) {}
+        SmallSet(const SmallSet& s) : size_(s.size_), set_(0) {
+            std::copy(s.items_, s.items_+s.size_, items_);
+            if (s.set_)
+                set_ = new S(*s.set_);
+        }
+        SmallSet& operator=(const SmallSet& s) {
+            if (&s != this) {
+                SmallSet tmp(s);
+                swap(tmp);
+            }
+            return *this;
+        }
+        ~SmallSet() { delete set_; }
+
+        //! \name Inspectors
+        //@{
+        Size size() const { return set_ ? set_->size() : size_; }
+        bool empty() const { return size() == 0; }
+        const_iterator begin() const {
+            return set_ ? const_iterator(set_->begin())
+                        : const_iterator(items_);
+        }
+        const_iterator end() const {
+            return set_ ? const_iterator(set_->end())
+                        : const_iterator(items_+size_);
+        }
+        Size count(const T& x) const {
+            if (set_)
+                return set_->count(x);
+            for (Size i=0; i<size_; ++i)
+                if (items_[i] == x)
+                    return 1;
+            return 0;
+        }
+        //@}
+
+        //! \name Modifiers
+        //@{
+        std::pair<const_iterator, bool> insert(const T& x) {
+            if (set_) {
+                std::pair<typename S::iterator, bool> p = set_->insert(x);
+                return std::make_pair(const_iterator(
+                             typename S::const_iterator(p.first)), p.second);
+            }
+            for (Size i=0; i<size_; ++i)
+                if (items_[i] == x)
+                    return std::make_pair(const_iterator(items_+i), false);
+            if (size_ < N) {
+                items_[size_] = x;
+                return std::make_pair(const_iterator(items_+(size_++)),
+                                      true);
+            }
+            // no more room; the elements are moved to the set
+            set_ = new S(items_, items_+N);
+            clearItems();
+            return insert(x);
+        }
+        Size erase(const T& x) {
+            if (set_) {
+                Size n = set_->erase(x);
+                if (set_->empty()) {
+                    delete set_;
+                    set_ = 0;
+                }
+                return n;
+            }
+            for (Size i=0; i<size_; ++i) {
+                if (items_[i] == x) {
+                    // the last element takes the place of the erased one
+                    std::swap(items_[i], items_[size_-1]);
+                    items_[--size_] = T();
+                    return 1;
+                }
+            }
+            return 0;
+        }
+        void clear() {
+            delete set_;
+            set_ = 0;
+            clearItems();
+        }
+        void swap(SmallSet& s) {
+            for (Size i=0; i<N; ++i)
+                std::swap(items_[i], s.items_[i]);
+            std::swap(size_, s.size_);
+            std::swap(set_, s.set_);
+        }
+        //@}
+      private:
+        void clearItems() {
+            for (Size i=0; i<size_; ++i)
+                items_[i] = T();
+            size_ = 0;
+        }
+        T items_[N];
+        Size size_;
+        S* set_;
+    };
+
+}
+
+#endif
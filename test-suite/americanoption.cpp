@@ -23,11 +23,18 @@
 #include "utilities.hpp"
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/instruments/vanillaoption.hpp>
+#include <ql/instruments/dividendvanillaoption.hpp>
 #include <ql/pricingengines/vanilla/baroneadesiwhaleyengine.hpp>
 #include <ql/pricingengines/vanilla/bjerksundstenslandengine.hpp>
 #include <ql/pricingengines/vanilla/juquadraticengine.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fdshoutengine.hpp>
+#include <ql/pricingengines/vanilla/fdbermudanengine.hpp>
+#include <ql/pricingengines/vanilla/fdeuropeanengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesbatchpricer.hpp>
+#include <ql/pricingengines/vanilla/americanapproximationbatchpricer.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -569,6 +576,439 @@ void AmericanOptionTest::testFdShoutGreeks() {
     testFdGreeks<FDShoutEngine<CrankNicolson> >();
 }
 
+void AmericanOptionTest::testFdBermudanValues() {
+    BOOST_TEST_MESSAGE("Testing finite-differences Bermudan option values...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS =
+        flatVol(today, 0.30, dc);
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    boost::shared_ptr<PricingEngine> europeanEngine(
+                            new FDEuropeanEngine<CrankNicolson>(process));
+    boost::shared_ptr<PricingEngine> bermudanEngine(
+                            new FDBermudanEngine<CrankNicolson>(process));
+    boost::shared_ptr<PricingEngine> americanEngine(
+                            new FDAmericanEngine<CrankNicolson>(process));
+
+    Date maturity = today + 360;
+    std::vector<Date> monthly;
+    for (Size i=1; i<=12; ++i)
+        monthly.push_back(today + Integer(30*i));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                  new PlainVanillaPayoff(Option::Put, 100.0));
+    VanillaOption european(payoff, boost::shared_ptr<Exercise>(
+                                            new EuropeanExercise(maturity)));
+    VanillaOption single(payoff, boost::shared_ptr<Exercise>(
+                     new BermudanExercise(std::vector<Date>(1, maturity))));
+    VanillaOption bermudan(payoff, boost::shared_ptr<Exercise>(
+                                            new BermudanExercise(monthly)));
+    VanillaOption american(payoff, boost::shared_ptr<Exercise>(
+                                    new AmericanExercise(today, maturity)));
+
+    european.setPricingEngine(europeanEngine);
+    single.setPricingEngine(bermudanEngine);
+    bermudan.setPricingEngine(bermudanEngine);
+    american.setPricingEngine(americanEngine);
+
+    // a single exercise date at maturity gives the European value,
+    // up to the exercise condition replacing the averaged payoff
+    Real tolerance = 5.0e-3;
+    if (std::fabs(single.NPV() - european.NPV()) > tolerance)
+        BOOST_ERROR("failed to reproduce European value"
+                    << "\n    Bermudan value: " << single.NPV()
+                    << "\n    European value: " << european.NPV()
+                    << "\n    tolerance:      " << tolerance);
+
+    // more exercise rights can only add value
+    if (bermudan.NPV() <= european.NPV()
+        || bermudan.NPV() > american.NPV())
+        BOOST_ERROR("Bermudan value out of bounds"
+                    << "\n    European value: " << european.NPV()
+                    << "\n    Bermudan value: " << bermudan.NPV()
+                    << "\n    American value: " << american.NPV());
+}
+
+void AmericanOptionTest::testFdBatchPricer() {
+    BOOST_TEST_MESSAGE("Testing batched finite-differences pricing...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    Integer lengths[] = { 90, 180, 360, 720 };
+    Real strikes[] = { 80.0, 95.0, 100.0, 110.0, 125.0 };
+    Option::Type types[] = { Option::Put, Option::Call };
+
+    std::vector<boost::shared_ptr<VanillaOption> > options;
+    for (Size i=0; i<LENGTH(lengths); ++i) {
+        const Date exDate = today + lengths[i];
+        for (Size j=0; j<LENGTH(strikes); ++j) {
+            for (Size k=0; k<LENGTH(types); ++k) {
+                boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(types[k], strikes[j]));
+                boost::shared_ptr<Exercise> exercise;
+                if ((i+j+k) % 2 == 0)
+                    exercise = boost::shared_ptr<Exercise>(
+                                     new AmericanExercise(today, exDate));
+                else
+                    exercise = boost::shared_ptr<Exercise>(
+                                               new EuropeanExercise(exDate));
+                options.push_back(boost::shared_ptr<VanillaOption>(
+                                        new VanillaOption(payoff, exercise)));
+            }
+        }
+    }
+
+    const Size tGrid = 200, xGrid = 400, dampingSteps = 2;
+    const std::vector<Real> calculated =
+        FdBlackScholesBatchPricer(process, tGrid, xGrid, dampingSteps)
+        .NPVs(options);
+
+    if (calculated.size() != options.size())
+        BOOST_FAIL(calculated.size() << " values returned for "
+                   << options.size() << " options");
+
+    boost::shared_ptr<PricingEngine> engine(
+        new FdBlackScholesVanillaEngine(process, tGrid, xGrid, dampingSteps));
+
+    const Real tolerance = 1.0e-2;
+    for (Size i=0; i<options.size(); ++i) {
+        options[i]->setPricingEngine(engine);
+        const Real expected = options[i]->NPV();
+        if (std::fabs(calculated[i] - expected) > tolerance) {
+            boost::shared_ptr<StrikedTypePayoff> payoff =
+                boost::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                       options[i]->payoff());
+            BOOST_ERROR("failed to reproduce option value"
+                        << "\n    option:     " << payoff->optionType()
+                        << "\n    strike:     " << payoff->strike()
+                        << "\n    exercise:   "
+                        << (options[i]->exercise()->type()
+                                == Exercise::American ?
+                                "American" : "European")
+                        << "\n    maturity:   "
+                        << options[i]->exercise()->lastDate()
+                        << "\n    calculated: " << calculated[i]
+                        << "\n    expected:   " << expected
+                        << "\n    tolerance:  " << tolerance);
+        }
+    }
+}
+
+void AmericanOptionTest::testFdBatchPricerWithDividends() {
+    BOOST_TEST_MESSAGE(
+        "Testing batched finite-differences pricing with dividends...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.0, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    // quarterly dividends
+    std::vector<Date> dividendDates;
+    std::vector<Real> dividendAmounts;
+    for (Integer d=45; d<720; d+=90) {
+        dividendDates.push_back(today + d);
+        dividendAmounts.push_back(1.5);
+    }
+    const DividendSchedule dividends =
+        DividendVector(dividendDates, dividendAmounts);
+
+    Integer lengths[] = { 180, 400, 720 };
+    Real strikes[] = { 85.0, 100.0, 115.0 };
+    Option::Type types[] = { Option::Put, Option::Call };
+
+    std::vector<boost::shared_ptr<VanillaOption> > options;
+    std::vector<boost::shared_ptr<DividendVanillaOption> > references;
+    for (Size i=0; i<LENGTH(lengths); ++i) {
+        const Date exDate = today + lengths[i];
+        for (Size j=0; j<LENGTH(strikes); ++j) {
+            for (Size k=0; k<LENGTH(types); ++k) {
+                boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(types[k], strikes[j]));
+                boost::shared_ptr<Exercise> exercise;
+                if ((i+j+k) % 2 == 0)
+                    exercise = boost::shared_ptr<Exercise>(
+                                     new AmericanExercise(today, exDate));
+                else
+                    exercise = boost::shared_ptr<Exercise>(
+                                               new EuropeanExercise(exDate));
+                options.push_back(boost::shared_ptr<VanillaOption>(
+                                        new VanillaOption(payoff, exercise)));
+
+                std::vector<Date> dates;
+                std::vector<Real> amounts;
+                for (Size d=0; d<dividendDates.size(); ++d) {
+                    if (dividendDates[d] < exDate) {
+                        dates.push_back(dividendDates[d]);
+                        amounts.push_back(dividendAmounts[d]);
+                    }
+                }
+                references.push_back(boost::shared_ptr<DividendVanillaOption>(
+                      new DividendVanillaOption(payoff, exercise,
+                                                dates, amounts)));
+            }
+        }
+    }
+
+    const Size tGrid = 800, xGrid = 400, dampingSteps = 2;
+    const std::vector<Real> calculated =
+        FdBlackScholesBatchPricer(process, tGrid, xGrid, dampingSteps)
+        .NPVs(options, dividends);
+
+    boost::shared_ptr<PricingEngine> engine(
+        new FdBlackScholesVanillaEngine(process, tGrid, xGrid, dampingSteps));
+
+    const Real tolerance = 1.0e-2;
+    for (Size i=0; i<options.size(); ++i) {
+        references[i]->setPricingEngine(engine);
+        const Real expected = references[i]->NPV();
+        if (std::fabs(calculated[i] - expected) > tolerance) {
+            boost::shared_ptr<StrikedTypePayoff> payoff =
+                boost::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                       options[i]->payoff());
+            BOOST_ERROR("failed to reproduce option value with dividends"
+                        << "\n    option:     " << payoff->optionType()
+                        << "\n    strike:     " << payoff->strike()
+                        << "\n    exercise:   "
+                        << (options[i]->exercise()->type()
+                                == Exercise::American ?
+                                "American" : "European")
+                        << "\n    maturity:   "
+                        << options[i]->exercise()->lastDate()
+                        << "\n    calculated: " << calculated[i]
+                        << "\n    expected:   " << expected
+                        << "\n    tolerance:  " << tolerance);
+        }
+    }
+}
+
+void AmericanOptionTest::testApproximationBatchPricer() {
+    BOOST_TEST_MESSAGE("Testing batched analytic American approximations...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    Integer lengths[] = { 30, 90, 180, 360, 720 };
+    Real strikes[] = { 60.0, 80.0, 95.0, 100.0, 110.0, 125.0, 160.0 };
+    Option::Type types[] = { Option::Put, Option::Call };
+    Rate qRates[] = { 0.0, 0.04, 0.10 };
+
+    std::vector<boost::shared_ptr<VanillaOption> > options;
+    for (Size i=0; i<LENGTH(lengths); ++i) {
+        boost::shared_ptr<Exercise> exercise(
+                          new AmericanExercise(today, today + lengths[i]));
+        for (Size j=0; j<LENGTH(strikes); ++j) {
+            for (Size k=0; k<LENGTH(types); ++k) {
+                boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(types[k], strikes[j]));
+                options.push_back(boost::shared_ptr<VanillaOption>(
+                                        new VanillaOption(payoff, exercise)));
+            }
+        }
+    }
+
+    AmericanApproximationBatchPricer::Approximation approximations[] = {
+        AmericanApproximationBatchPricer::BaroneAdesiWhaley,
+        AmericanApproximationBatchPricer::BjerksundStensland,
+        AmericanApproximationBatchPricer::JuQuadratic
+    };
+    std::string names[] = {
+        "Barone-Adesi-Whaley", "Bjerksund-Stensland", "Ju"
+    };
+    boost::shared_ptr<PricingEngine> engines[] = {
+        boost::shared_ptr<PricingEngine>(
+                     new BaroneAdesiWhaleyApproximationEngine(process)),
+        boost::shared_ptr<PricingEngine>(
+                     new BjerksundStenslandApproximationEngine(process)),
+        boost::shared_ptr<PricingEngine>(
+                     new JuQuadraticApproximationEngine(process))
+    };
+
+    const Real tolerance = 1.0e-8;
+    for (Size l=0; l<LENGTH(qRates); ++l) {
+        qRate->setValue(qRates[l]);
+        for (Size m=0; m<LENGTH(approximations); ++m) {
+            const std::vector<Real> calculated =
+                AmericanApproximationBatchPricer(process, approximations[m])
+                .NPVs(options);
+
+            if (calculated.size() != options.size())
+                BOOST_FAIL(calculated.size() << " values returned for "
+                           << options.size() << " options");
+
+            for (Size i=0; i<options.size(); ++i) {
+                options[i]->setPricingEngine(engines[m]);
+                const Real expected = options[i]->NPV();
+                if (std::fabs(calculated[i] - expected) > tolerance) {
+                    boost::shared_ptr<StrikedTypePayoff> payoff =
+                        boost::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                       options[i]->payoff());
+                    BOOST_ERROR("failed to reproduce " << names[m]
+                                << " value"
+                                << "\n    option:         "
+                                << payoff->optionType()
+                                << "\n    strike:         "
+                                << payoff->strike()
+                                << "\n    dividend yield: "
+                                << io::rate(qRates[l])
+                                << "\n    maturity:       "
+                                << options[i]->exercise()->lastDate()
+                                << "\n    calculated:     " << calculated[i]
+                                << "\n    expected:       " << expected
+                                << "\n    tolerance:      " << tolerance);
+                }
+            }
+        }
+    }
+}
+
+void AmericanOptionTest::testImpliedVolatilitySolver() {
+    BOOST_TEST_MESSAGE("Testing implied volatilities of option chains...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    // floating term structures, which move with the evaluation date
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(0.30, dc);
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    boost::shared_ptr<PricingEngine> americanEngine(
+                            new FDAmericanEngine<CrankNicolson>(process));
+    boost::shared_ptr<PricingEngine> europeanEngine(
+                            new AnalyticEuropeanEngine(process));
+
+    Real strikes[] = { 80.0, 90.0, 95.0, 100.0, 105.0, 110.0, 120.0 };
+    Option::Type types[] = { Option::Put, Option::Call };
+
+    std::vector<boost::shared_ptr<VanillaOption> > options;
+    std::vector<Real> prices;
+    for (Size k=0; k<LENGTH(types); ++k) {
+        for (Size i=0; i<2; ++i) {
+            boost::shared_ptr<Exercise> exercise;
+            if (i == 0)
+                exercise = boost::shared_ptr<Exercise>(
+                                new AmericanExercise(today, today + 180));
+            else
+                exercise = boost::shared_ptr<Exercise>(
+                                new EuropeanExercise(today + 180));
+            for (Size j=0; j<LENGTH(strikes); ++j) {
+                boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(types[k], strikes[j]));
+                boost::shared_ptr<VanillaOption> option(
+                                        new VanillaOption(payoff, exercise));
+                option->setPricingEngine(i == 0 ? americanEngine
+                                                : europeanEngine);
+                options.push_back(option);
+                prices.push_back(option->NPV());
+            }
+        }
+    }
+
+    VanillaImpliedVolatilitySolver solver(process, 1.0e-6);
+    std::vector<Volatility> calculated =
+        solver.impliedVolatilities(options, prices);
+
+    const Real tolerance = 1.0e-4;
+    for (Size i=0; i<options.size(); ++i) {
+        Volatility expected =
+            options[i]->impliedVolatility(prices[i], process, 1.0e-6);
+        if (std::fabs(calculated[i] - expected) > tolerance
+            || std::fabs(calculated[i] - 0.30) > tolerance) {
+            boost::shared_ptr<StrikedTypePayoff> payoff =
+                boost::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                       options[i]->payoff());
+            BOOST_ERROR("failed to reproduce implied volatility"
+                        << "\n    option:     " << payoff->optionType()
+                        << "\n    strike:     " << payoff->strike()
+                        << "\n    exercise:   "
+                        << (options[i]->exercise()->type()
+                                == Exercise::American ?
+                                "American" : "European")
+                        << "\n    price:      " << prices[i]
+                        << "\n    calculated: " << calculated[i]
+                        << "\n    single:     " << expected
+                        << "\n    expected:   " << 0.30
+                        << "\n    tolerance:  " << tolerance);
+        }
+    }
+
+    // the solver must follow changes in the evaluation date
+    Settings::instance().evaluationDate() = today + 30;
+    for (Size i=0; i<options.size(); ++i)
+        prices[i] = options[i]->NPV();
+    calculated = solver.impliedVolatilities(options, prices);
+    for (Size i=0; i<options.size(); ++i) {
+        if (std::fabs(calculated[i] - 0.30) > tolerance)
+            BOOST_ERROR("failed to reproduce implied volatility "
+                        "after changing the evaluation date"
+                        << "\n    calculated: " << calculated[i]
+                        << "\n    expected:   " << 0.30
+                        << "\n    tolerance:  " << tolerance);
+    }
+}
+
 test_suite* AmericanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("American option tests");
     suite->add(
@@ -583,6 +1023,14 @@ test_suite* AmericanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAmericanGreeks));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdShoutGreeks));
+    suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdBermudanValues));
+    suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdBatchPricer));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AmericanOptionTest::testFdBatchPricerWithDividends));
+    suite->add(QUANTLIB_TEST_CASE(
+                       &AmericanOptionTest::testApproximationBatchPricer));
+    suite->add(QUANTLIB_TEST_CASE(
+                       &AmericanOptionTest::testImpliedVolatilitySolver));
     return suite;
 }
 
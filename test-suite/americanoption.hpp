@@ -35,6 +35,11 @@ class AmericanOptionTest {
     static void testFdValues();
     static void testFdAmericanGreeks();
     static void testFdShoutGreeks();
+    static void testFdBermudanValues();
+    static void testFdBatchPricer();
+    static void testFdBatchPricerWithDividends();
+    static void testApproximationBatchPricer();
+    static void testImpliedVolatilitySolver();
     static boost::unit_test_framework::test_suite* suite();
 };
 
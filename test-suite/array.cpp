@@ -20,7 +20,12 @@
 #include "array.hpp"
 #include "utilities.hpp"
 #include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/math/fixedmatrix.hpp>
+#include <ql/math/memorypool.hpp>
+#include <ql/math/hugepageallocator.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <utility>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -208,10 +213,338 @@ void ArrayTest::testArrayFunctions() {
 
 }
 
+void ArrayTest::testExpressions() {
+
+    BOOST_TEST_MESSAGE("Testing array expressions...");
+
+    const Size n = 7;
+    Array x(n), y(n), z(n);
+    for (Size i=0; i<n; ++i) {
+        x[i] = std::sin(Real(i))+1.5;
+        y[i] = std::cos(Real(i))-2.0;
+        z[i] = Real(i)/n;
+    }
+    const Real a = 0.3, b = -1.7;
+    const Real tol = 100*QL_EPSILON;
+
+    Array r1 = a*x + b*y - z;
+    Array r2 = (x - 1.0)/(2.0 - y) * (z + x/a);
+    Array r3 = -x + (1.0/y) - (+z*b);
+    Array r4 = x;
+    // in-place evaluation reads each element before overwriting it
+    r4 = r4*r4 - x*z;
+    Array r5(z);
+    r5 += x*y;
+    r5 -= 2.0*z;
+    r5 *= y + 1.0;
+    r5 /= x;
+
+    for (Size i=0; i<n; ++i) {
+        Real e1 = a*x[i] + b*y[i] - z[i];
+        Real e2 = (x[i] - 1.0)/(2.0 - y[i]) * (z[i] + x[i]/a);
+        Real e3 = -x[i] + 1.0/y[i] - z[i]*b;
+        Real e4 = x[i]*x[i] - x[i]*z[i];
+        Real e5 = (z[i] + x[i]*y[i] - 2.0*z[i])*(y[i] + 1.0)/x[i];
+        if (std::fabs(r1[i]-e1) > tol || std::fabs(r2[i]-e2) > tol
+            || std::fabs(r3[i]-e3) > tol || std::fabs(r4[i]-e4) > tol
+            || std::fabs(r5[i]-e5) > tol)
+            BOOST_ERROR("wrong result from array expression at index "
+                        << i << ":"
+                        << "\n    (" << r1[i] << ", " << r2[i] << ", "
+                        << r3[i] << ", " << r4[i] << ", " << r5[i] << ")"
+                        << "\n    (" << e1 << ", " << e2 << ", "
+                        << e3 << ", " << e4 << ", " << e5 << ")");
+    }
+
+    // expressions are converted into arrays where these are expected
+    if (std::fabs(DotProduct(x - y, x + y)
+                  - (DotProduct(x, x) - DotProduct(y, y))) > 1.0e3*tol)
+        BOOST_ERROR("wrong dot product of array expressions");
+
+    Array empty;
+    empty = x + y;
+    if (empty.size() != n)
+        BOOST_ERROR("array not resized by expression assignment");
+
+    BOOST_CHECK_THROW(Array(x + Array(n+1)), Error);
+    BOOST_CHECK_THROW(r1 += Array(n+1)*2.0, Error);
+}
+
+void ArrayTest::testMoveSemantics() {
+
+    BOOST_TEST_MESSAGE("Testing move semantics of arrays and matrices...");
+
+    #if !defined(QL_USE_DISPOSABLE)
+    Array a(10, 1.0);
+    const Real* storage = a.begin();
+    Array b(std::move(a));
+    if (b.begin() != storage || b.size() != 10 || !a.empty())
+        BOOST_ERROR("array storage not transferred by move construction");
+
+    Array c(5, 2.0);
+    c = std::move(b);
+    if (c.begin() != storage || c.size() != 10)
+        BOOST_ERROR("array storage not transferred by move assignment");
+
+    Matrix m(3, 4, 1.0);
+    const Real* mStorage = m.begin();
+    Matrix n(std::move(m));
+    if (n.begin() != mStorage || n.rows() != 3 || n.columns() != 4
+        || !m.empty())
+        BOOST_ERROR("matrix storage not transferred by move construction");
+    #endif
+}
+
+void ArrayTest::testMemoryPool() {
+
+    BOOST_TEST_MESSAGE("Testing pooled storage of arrays and matrices...");
+
+    const Size n = 10;
+    Array a(n, 1.0), b(n, 2.0);
+    Matrix m(n, n, 0.5);
+
+    {
+        MemoryPool::Scope pool;
+        if (!MemoryPool::active())
+            BOOST_FAIL("memory pool not active within scope");
+
+        Array c(n);
+        for (Size i=0; i<10; ++i) {
+            Array t = a + b*2.0;
+            Matrix tm = m*m;
+            c = m*t;
+            // the first iteration fills the free lists, from which
+            // the following ones are served
+            if (i == 0)
+                MemoryPool::resetCounters();
+        }
+        if (MemoryPool::heapAllocations() != 0)
+            BOOST_ERROR(MemoryPool::heapAllocations()
+                        << " heap allocations within pooled loop");
+        if (MemoryPool::pooledAllocations() == 0)
+            BOOST_ERROR("no allocation served by the pool");
+
+        for (Size i=0; i<n; ++i) {
+            if (std::fabs(c[i] - 25.0) > 1.0e-12)
+                BOOST_ERROR("wrong result from pooled operations:\n"
+                            << "    calculated: " << c[i] << "\n"
+                            << "    expected:   " << 25.0);
+        }
+    }
+
+    if (MemoryPool::active())
+        BOOST_FAIL("memory pool still active after scope");
+
+    // storage obtained within the scope outlives it
+    MemoryPool::resetCounters();
+    Array d(n, 3.0);
+    if (MemoryPool::heapAllocations() != 1)
+        BOOST_ERROR("heap not used outside pool scope");
+    if (std::fabs(DotProduct(a, d) - 3.0*n) > 1.0e-12)
+        BOOST_ERROR("wrong dot product after pool scope");
+}
+
+namespace {
+
+    class CountingAllocator : public LargeBufferAllocator {
+      public:
+        explicit CountingAllocator(
+                        const boost::shared_ptr<LargeBufferAllocator>& a)
+        : allocator_(a), allocations(0), deallocations(0) {}
+        void* allocate(Size bytes) {
+            ++allocations;
+            return allocator_->allocate(bytes);
+        }
+        void deallocate(void* p, Size bytes) {
+            ++deallocations;
+            allocator_->deallocate(p, bytes);
+        }
+      private:
+        boost::shared_ptr<LargeBufferAllocator> allocator_;
+      public:
+        Size allocations, deallocations;
+    };
+
+}
+
+void ArrayTest::testLargeBufferAllocator() {
+
+    BOOST_TEST_MESSAGE("Testing allocation of large arrays "
+                       "on huge pages...");
+
+    const HugePageAllocator::Placement placements[] = {
+        HugePageAllocator::FirstTouch,
+        HugePageAllocator::Interleaved,
+        HugePageAllocator::ParallelFirstTouch
+    };
+
+    boost::shared_ptr<LargeBufferAllocator> previous =
+        MemoryPool::largeBufferAllocator();
+
+    const Size threshold = 1000, n = 300000;
+    for (Size k=0; k<LENGTH(placements); ++k) {
+        for (Size h=0; h<2; ++h) {
+            boost::shared_ptr<CountingAllocator> allocator(
+                new CountingAllocator(
+                    boost::shared_ptr<LargeBufferAllocator>(
+                        new HugePageAllocator(h == 1, placements[k]))));
+            MemoryPool::setLargeBufferAllocator(allocator, threshold);
+            if (MemoryPool::largeBufferAllocator() != allocator)
+                BOOST_FAIL("allocator not installed");
+
+            {
+                Array small(threshold-1, 1.0);
+                if (allocator->allocations != 0)
+                    BOOST_ERROR("small array allocated as large buffer");
+
+                Array x(n), y(n, 2.0);
+                for (Size i=0; i<n; ++i)
+                    x[i] = Real(i % 7);
+                Matrix m(600, 600, 0.5);
+                boost::shared_array<Size> indices =
+                    detail::pooledArray<Size>(n);
+                for (Size i=0; i<n; ++i)
+                    indices[i] = n-1-i;
+                if (allocator->allocations != 4)
+                    BOOST_ERROR(allocator->allocations
+                                << " large buffers allocated instead of 4");
+
+                {
+                    // large temporaries are pooled as the others
+                    MemoryPool::Scope pool;
+                    Array z(n);
+                    Size allocations = 0;
+                    for (Size i=0; i<5; ++i) {
+                        Array t = x*2.0;
+                        z = t + y;
+                        if (i == 0)
+                            allocations = allocator->allocations;
+                    }
+                    if (allocator->allocations != allocations)
+                        BOOST_ERROR(allocator->allocations - allocations
+                                    << " large buffers allocated "
+                                    "within pooled loop");
+                    Real expected = 0.0, sum = 0.0;
+                    for (Size i=0; i<n; ++i) {
+                        expected += 2.0*(i % 7) + 2.0;
+                        sum += z[indices[n-1-i]];
+                    }
+                    if (std::fabs(sum - expected) > 1.0e-12*expected)
+                        BOOST_ERROR("wrong result from large buffers:"
+                                    << "\n    placement:  " << k
+                                    << "\n    huge pages: " << h
+                                    << "\n    calculated: " << sum
+                                    << "\n    expected:   " << expected);
+                }
+
+                Real trace = 0.0;
+                for (Size i=0; i<m.rows(); ++i)
+                    trace += m[i][i];
+                if (std::fabs(trace - 300.0) > 1.0e-12)
+                    BOOST_ERROR("wrong trace of large matrix: " << trace);
+            }
+
+            if (allocator->deallocations != allocator->allocations)
+                BOOST_ERROR(allocator->allocations
+                            << " large buffers allocated and "
+                            << allocator->deallocations << " released");
+        }
+    }
+
+    MemoryPool::setLargeBufferAllocator(previous, threshold);
+
+    // buffers allocated before a change are released correctly
+    Array a(n, 1.0);
+    MemoryPool::setLargeBufferAllocator(
+        boost::shared_ptr<LargeBufferAllocator>(new HugePageAllocator),
+        threshold);
+    Array b(n, 1.0);
+    MemoryPool::setLargeBufferAllocator(previous, threshold);
+    if (std::fabs(DotProduct(a, b) - Real(n)) > 1.0e-12)
+        BOOST_ERROR("wrong dot product of large arrays");
+}
+
+void ArrayTest::testFixedSize() {
+
+    BOOST_TEST_MESSAGE("Testing fixed-size arrays and matrices...");
+
+    const Size n = 3;
+    Array x(n), y(n);
+    Matrix m(n, n), p(n, n);
+    for (Size i=0; i<n; ++i) {
+        x[i] = std::sin(Real(i))+1.5;
+        y[i] = std::cos(Real(i))-2.0;
+        for (Size j=0; j<n; ++j) {
+            m[i][j] = std::sin(Real(i*n+j));
+            p[i][j] = std::cos(Real(i+j*n));
+        }
+    }
+    const FixedArray<n> fx(x), fy(y);
+    const FixedMatrix<n,n> fm(m), fp(p);
+
+    const Real a = 0.3;
+    FixedArray<n> fz = fy;
+    fz *= fx;
+    fz += 1.0;
+    fz /= a;
+    const Array z = (y*x + 1.0)/a;
+
+    const Array results[] = {
+        (fx + fy*a).toArray(), (fx - a*fy).toArray(), fz.toArray(),
+        (fm*fx).toArray(), (fx*fm).toArray()
+    };
+    const Array expected[] = {
+        x + y*a, x - a*y, z, m*x, x*m
+    };
+    const Real tol = 100*QL_EPSILON;
+    for (Size k=0; k<LENGTH(results); ++k) {
+        for (Size i=0; i<n; ++i) {
+            if (std::fabs(results[k][i]-expected[k][i]) > tol)
+                BOOST_ERROR("wrong result from fixed-size array operation "
+                            << k << " at index " << i << ":"
+                            << "\n    calculated: " << results[k][i]
+                            << "\n    expected:   " << expected[k][i]);
+        }
+    }
+
+    if (std::fabs(DotProduct(fx, fy) - DotProduct(x, y)) > tol)
+        BOOST_ERROR("wrong dot product of fixed-size arrays");
+
+    const Matrix mresults[] = {
+        (fm*fp).toMatrix(), transpose(fm).toMatrix(), (fm + fp*a).toMatrix()
+    };
+    const Matrix mexpected[] = {
+        m*p, transpose(m), m + p*a
+    };
+    for (Size k=0; k<LENGTH(mresults); ++k) {
+        for (Size i=0; i<n; ++i) {
+            for (Size j=0; j<n; ++j) {
+                if (std::fabs(mresults[k][i][j]-mexpected[k][i][j]) > tol)
+                    BOOST_ERROR("wrong result from fixed-size matrix "
+                                "operation " << k << " at indices ("
+                                << i << ", " << j << "):"
+                                << "\n    calculated: " << mresults[k][i][j]
+                                << "\n    expected:   "
+                                << mexpected[k][i][j]);
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW((FixedArray<2>(x)), Error);
+    BOOST_CHECK_THROW((FixedMatrix<3,2>(m)), Error);
+}
+
 test_suite* ArrayTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("array tests");
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testArrayFunctions));
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testExpressions));
+    #if !defined(QL_USE_DISPOSABLE)
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testMoveSemantics));
+    #endif
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testMemoryPool));
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testLargeBufferAllocator));
+    suite->add(QUANTLIB_TEST_CASE(&ArrayTest::testFixedSize));
     return suite;
 }
 
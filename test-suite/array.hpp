@@ -29,6 +29,11 @@ class ArrayTest {
   public:
     static void testConstruction();
     static void testArrayFunctions();
+    static void testExpressions();
+    static void testMoveSemantics();
+    static void testMemoryPool();
+    static void testLargeBufferAllocator();
+    static void testFixedSize();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -671,7 +671,7 @@ void AsianOptionTest::testMCDiscreteArithmeticAveragePrice() {
                         vol->value(), expected, calculated, tolerance);
         }
 
-        if(cases4[l].fixings < 100) {
+        if(cases4[l].fixings <= 250) {
             engine = boost::shared_ptr<PricingEngine>(
                     new FdBlackScholesAsianEngine(stochProcess, 100, 100, 100));
             option.setPricingEngine(engine);
@@ -1128,6 +1128,168 @@ void AsianOptionTest::testPastFixings() {
 
 }
 
+void AsianOptionTest::testMCBatchSimulation() {
+
+    BOOST_TEST_MESSAGE("Testing batch simulation in MC Asian engines...");
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.03));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    boost::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.06));
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.20));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                  new PlainVanillaPayoff(Option::Put, 100.0));
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(today + 1*Years));
+
+    std::vector<Date> fixingDates;
+    for (Integer i=1; i<=12; ++i)
+        fixingDates.push_back(today + i*Months);
+
+    DiscreteAveragingAsianOption arithmetic(Average::Arithmetic, 0.0, 0,
+                                            fixingDates, payoff, exercise);
+    DiscreteAveragingAsianOption geometric(Average::Geometric, 1.0, 0,
+                                           fixingDates, payoff, exercise);
+
+    // the batches draw the same sequences as the paths generated one
+    // by one, so the prices must agree up to rounding
+    Size samples = 1000, lanes = 16;
+    BigNatural seed = 42;
+    Real tolerance = 1.0e-8;
+
+    for (Size workers=1; workers<=2; ++workers) {
+        for (Size bb=0; bb<2; ++bb) {
+            for (Size cv=0; cv<2; ++cv) {
+                boost::shared_ptr<PricingEngine> scalar =
+                    MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(
+                                                               stochProcess)
+                    .withSamples(samples)
+                    .withSeed(seed)
+                    .withBrownianBridge(bb == 1)
+                    .withAntitheticVariate()
+                    .withControlVariate(cv == 1)
+                    .withWorkers(workers);
+                boost::shared_ptr<PricingEngine> batch =
+                    MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(
+                                                               stochProcess)
+                    .withSamples(samples)
+                    .withSeed(seed)
+                    .withBrownianBridge(bb == 1)
+                    .withAntitheticVariate()
+                    .withControlVariate(cv == 1)
+                    .withWorkers(workers)
+                    .withLanes(lanes);
+
+                arithmetic.setPricingEngine(scalar);
+                Real expected = arithmetic.NPV();
+                arithmetic.setPricingEngine(batch);
+                Real calculated = arithmetic.NPV();
+                if (std::fabs(calculated-expected) > tolerance)
+                    BOOST_ERROR("failed to reproduce arithmetic "
+                                "average-price value in batch mode"
+                                << "\n    workers:    " << workers
+                                << "\n    bridge:     " << bb
+                                << "\n    control:    " << cv
+                                << "\n    expected:   " << expected
+                                << "\n    calculated: " << calculated);
+            }
+
+            boost::shared_ptr<PricingEngine> scalar =
+                MakeMCDiscreteArithmeticASEngine<PseudoRandom>(stochProcess)
+                .withSamples(samples)
+                .withSeed(seed)
+                .withBrownianBridge(bb == 1)
+                .withAntitheticVariate()
+                .withWorkers(workers);
+            boost::shared_ptr<PricingEngine> batch =
+                MakeMCDiscreteArithmeticASEngine<PseudoRandom>(stochProcess)
+                .withSamples(samples)
+                .withSeed(seed)
+                .withBrownianBridge(bb == 1)
+                .withAntitheticVariate()
+                .withWorkers(workers)
+                .withLanes(lanes);
+
+            arithmetic.setPricingEngine(scalar);
+            Real expected = arithmetic.NPV();
+            arithmetic.setPricingEngine(batch);
+            Real calculated = arithmetic.NPV();
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("failed to reproduce arithmetic "
+                            "average-strike value in batch mode"
+                            << "\n    workers:    " << workers
+                            << "\n    bridge:     " << bb
+                            << "\n    expected:   " << expected
+                            << "\n    calculated: " << calculated);
+
+            scalar =
+                MakeMCDiscreteGeometricAPEngine<PseudoRandom>(stochProcess)
+                .withSamples(samples)
+                .withSeed(seed)
+                .withBrownianBridge(bb == 1)
+                .withAntitheticVariate()
+                .withWorkers(workers);
+            batch =
+                MakeMCDiscreteGeometricAPEngine<PseudoRandom>(stochProcess)
+                .withSamples(samples)
+                .withSeed(seed)
+                .withBrownianBridge(bb == 1)
+                .withAntitheticVariate()
+                .withWorkers(workers)
+                .withLanes(lanes);
+
+            geometric.setPricingEngine(scalar);
+            expected = geometric.NPV();
+            geometric.setPricingEngine(batch);
+            calculated = geometric.NPV();
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("failed to reproduce geometric "
+                            "average-price value in batch mode"
+                            << "\n    workers:    " << workers
+                            << "\n    bridge:     " << bb
+                            << "\n    expected:   " << expected
+                            << "\n    calculated: " << calculated);
+        }
+    }
+
+    // the cached control-variate price must follow the market
+    boost::shared_ptr<PricingEngine> engine =
+        MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+        .withSamples(samples)
+        .withSeed(seed)
+        .withControlVariate()
+        .withLanes(lanes);
+    arithmetic.setPricingEngine(engine);
+    arithmetic.NPV();
+
+    spot->setValue(90.0);
+    Real calculated = arithmetic.NPV();
+
+    arithmetic.setPricingEngine(
+        MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+        .withSamples(samples)
+        .withSeed(seed)
+        .withControlVariate()
+        .withLanes(lanes));
+    Real expected = arithmetic.NPV();
+
+    if (calculated != expected)
+        BOOST_ERROR("cached control-variate value not updated"
+                    << "\n    expected:   " << expected
+                    << "\n    calculated: " << calculated);
+}
+
 namespace {
 
     struct ContinuousAverageData {
@@ -1328,6 +1490,8 @@ test_suite* AsianOptionTest::suite() {
         &AsianOptionTest::testAnalyticDiscreteGeometricAveragePriceGreeks));
     suite->add(QUANTLIB_TEST_CASE(
         &AsianOptionTest::testPastFixings));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AsianOptionTest::testMCBatchSimulation));
 
     return suite;
 }
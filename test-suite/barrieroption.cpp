@@ -616,6 +616,90 @@ void BarrierOptionTest::testBeagleholeValues() {
     }
 }
 
+void BarrierOptionTest::testMonteCarloFamily() {
+
+    BOOST_TEST_MESSAGE(
+           "Testing Monte Carlo pricing of a family of barrier options...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    boost::shared_ptr<SimpleQuote> underlying =
+        boost::make_shared<SimpleQuote>(100.0);
+    boost::shared_ptr<YieldTermStructure> qTS =
+        flatRate(today, boost::make_shared<SimpleQuote>(0.02), dc);
+    boost::shared_ptr<YieldTermStructure> rTS =
+        flatRate(today, boost::make_shared<SimpleQuote>(0.05), dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS =
+        flatVol(today, boost::make_shared<SimpleQuote>(0.25), dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        boost::make_shared<BlackScholesMertonProcess>(
+                                      Handle<Quote>(underlying),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS));
+
+    boost::shared_ptr<Exercise> exercise =
+        boost::make_shared<EuropeanExercise>(today+360);
+
+    // rebates are only given to knock-in options, for which they
+    // are paid at expiry both here and in the analytic engine
+    std::vector<BarrierOptionTerms> family;
+    family.push_back(BarrierOptionTerms(Barrier::DownOut, 90.0, 0.0,
+                                        Option::Call, 100.0));
+    family.push_back(BarrierOptionTerms(Barrier::DownIn, 90.0, 3.0,
+                                        Option::Call, 100.0));
+    family.push_back(BarrierOptionTerms(Barrier::DownOut, 95.0, 0.0,
+                                        Option::Put, 105.0));
+    family.push_back(BarrierOptionTerms(Barrier::UpOut, 130.0, 0.0,
+                                        Option::Call, 100.0));
+    family.push_back(BarrierOptionTerms(Barrier::UpIn, 110.0, 2.0,
+                                        Option::Call, 95.0));
+    family.push_back(BarrierOptionTerms(Barrier::UpIn, 120.0, 0.0,
+                                        Option::Put, 110.0));
+
+    boost::shared_ptr<PricingEngine> analyticEngine =
+        boost::make_shared<AnalyticBarrierEngine>(stochProcess);
+    boost::shared_ptr<PricingEngine> mcEngine =
+        MakeMCBarrierEngine<PseudoRandom>(stochProcess)
+        .withStepsPerYear(12)
+        .withAntitheticVariate()
+        .withSamples(50000)
+        .withSeed(42)
+        .withFamily(family);
+
+    for (Size i=0; i<family.size(); i++) {
+        boost::shared_ptr<StrikedTypePayoff> payoff =
+            boost::make_shared<PlainVanillaPayoff>(family[i].type,
+                                                   family[i].strike);
+        BarrierOption option(family[i].barrierType, family[i].barrier,
+                             family[i].rebate, payoff, exercise);
+
+        option.setPricingEngine(analyticEngine);
+        Real expected = option.NPV();
+
+        option.setPricingEngine(mcEngine);
+        Real calculated = option.NPV();
+        Real tolerance = 4.0*option.errorEstimate();
+        Real error = std::fabs(calculated-expected);
+        if (error > tolerance) {
+            REPORT_FAILURE("value", family[i].barrierType, family[i].barrier,
+                           family[i].rebate, payoff, exercise, 100.0,
+                           0.02, 0.05, today, 0.25,
+                           expected, calculated, error, tolerance);
+        }
+    }
+
+    // options not in the family can't be priced
+    BarrierOption other(Barrier::DownOut, 80.0, 0.0,
+                        boost::make_shared<PlainVanillaPayoff>(Option::Call,
+                                                               100.0),
+                        exercise);
+    other.setPricingEngine(mcEngine);
+    BOOST_CHECK_THROW(other.NPV(), Error);
+}
+
 void BarrierOptionTest::testPerturbative() {
     BOOST_TEST_MESSAGE("Testing perturbative engine for barrier options...");
 
@@ -1092,11 +1176,101 @@ void BarrierOptionTest::testVannaVolgaSimpleBarrierValues() {
 }
 
 
+void BarrierOptionTest::testVannaVolgaBarrierCalculator() {
+    BOOST_TEST_MESSAGE("Testing batch Vanna/Volga pricing of barrier "
+                       "FX options against the engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today(5, March, 2013);
+    Settings::instance().evaluationDate() = today;
+
+    Real s = 1.30265;
+    Time t = 1.0;
+    Date exDate = today + 365;
+    boost::shared_ptr<SimpleQuote> spot = boost::make_shared<SimpleQuote>(s);
+    boost::shared_ptr<YieldTermStructure> qTS =
+        flatRate(today, boost::make_shared<SimpleQuote>(0.0003541), dc);
+    boost::shared_ptr<YieldTermStructure> rTS =
+        flatRate(today, boost::make_shared<SimpleQuote>(0.0033871), dc);
+
+    Handle<DeltaVolQuote> volAtmQuote(boost::make_shared<DeltaVolQuote>(
+        Handle<Quote>(boost::make_shared<SimpleQuote>(0.08925)),
+        DeltaVolQuote::Fwd, t, DeltaVolQuote::AtmDeltaNeutral));
+    Handle<DeltaVolQuote> vol25PutQuote(boost::make_shared<DeltaVolQuote>(
+        -0.25, Handle<Quote>(boost::make_shared<SimpleQuote>(0.10087)),
+        t, DeltaVolQuote::Fwd));
+    Handle<DeltaVolQuote> vol25CallQuote(boost::make_shared<DeltaVolQuote>(
+        0.25, Handle<Quote>(boost::make_shared<SimpleQuote>(0.08463)),
+        t, DeltaVolQuote::Fwd));
+
+    boost::shared_ptr<PricingEngine> engine =
+        boost::make_shared<VannaVolgaBarrierEngine>(
+            volAtmQuote, vol25PutQuote, vol25CallQuote,
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(rTS),
+            Handle<YieldTermStructure>(qTS));
+
+    VannaVolgaBarrierCalculator calculator(
+        **volAtmQuote, **vol25PutQuote, **vol25CallQuote, s,
+        *rTS, *qTS, exDate);
+
+    Barrier::Type barrierTypes[] = { Barrier::UpOut, Barrier::UpIn,
+                                     Barrier::DownOut, Barrier::DownIn };
+    Real barriers[] = { 1.1, 1.25, 1.4, 1.5 };
+    Real strikes[] = { 1.13321, 1.22687, 1.31179, 1.44298 };
+    Option::Type types[] = { Option::Call, Option::Put };
+
+    // the book includes options whose barrier was already touched
+    std::vector<Barrier::Type> bookBarrierTypes;
+    std::vector<Real> bookBarriers, bookRebates, bookStrikes;
+    std::vector<Option::Type> bookTypes;
+    for (Size i=0; i<LENGTH(barrierTypes); ++i)
+        for (Size j=0; j<LENGTH(barriers); ++j)
+            for (Size k=0; k<LENGTH(strikes); ++k)
+                for (Size l=0; l<LENGTH(types); ++l) {
+                    bookBarrierTypes.push_back(barrierTypes[i]);
+                    bookBarriers.push_back(barriers[j]);
+                    bookRebates.push_back(0.0);
+                    bookStrikes.push_back(strikes[k]);
+                    bookTypes.push_back(types[l]);
+                }
+
+    std::vector<Real> calculated =
+        calculator.values(bookBarrierTypes, bookBarriers, bookRebates,
+                          bookTypes, bookStrikes);
+
+    boost::shared_ptr<Exercise> exercise =
+        boost::make_shared<EuropeanExercise>(exDate);
+    const Real tol = 1.0e-12;
+    for (Size i=0; i<calculated.size(); ++i) {
+        boost::shared_ptr<StrikedTypePayoff> payoff =
+            boost::make_shared<PlainVanillaPayoff>(bookTypes[i],
+                                                   bookStrikes[i]);
+        BarrierOption option(bookBarrierTypes[i], bookBarriers[i],
+                             bookRebates[i], payoff, exercise);
+        option.setPricingEngine(engine);
+        Real expected = option.NPV();
+        if (std::fabs(calculated[i]-expected) > tol)
+            BOOST_ERROR("failed to reproduce engine value"
+                        << "\n    barrier type: " << bookBarrierTypes[i]
+                        << "\n    barrier:      " << bookBarriers[i]
+                        << "\n    option type:  " << bookTypes[i]
+                        << "\n    strike:       " << bookStrikes[i]
+                        << std::setprecision(12)
+                        << "\n    engine:       " << expected
+                        << "\n    calculator:   " << calculated[i]);
+    }
+}
+
+
 test_suite* BarrierOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Barrier option tests");
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testHaugValues));
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testBabsiriValues));
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testBeagleholeValues));
+    suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testMonteCarloFamily));
     suite->add(QUANTLIB_TEST_CASE(
                         &BarrierOptionTest::testLocalVolAndHestonComparison));
     return suite;
@@ -1107,5 +1281,7 @@ test_suite* BarrierOptionTest::experimental() {
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testPerturbative));
     suite->add(QUANTLIB_TEST_CASE(
                       &BarrierOptionTest::testVannaVolgaSimpleBarrierValues));
+    suite->add(QUANTLIB_TEST_CASE(
+                      &BarrierOptionTest::testVannaVolgaBarrierCalculator));
     return suite;
 }
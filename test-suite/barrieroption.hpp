@@ -30,9 +30,11 @@ class BarrierOptionTest {
     static void testHaugValues();
     static void testBabsiriValues();
     static void testBeagleholeValues();
+    static void testMonteCarloFamily();
     static void testPerturbative();
     static void testLocalVolAndHestonComparison();
     static void testVannaVolgaSimpleBarrierValues();
+    static void testVannaVolgaBarrierCalculator();
     static void testVannaVolgaDoubleBarrierValues();
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
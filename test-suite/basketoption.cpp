@@ -35,6 +35,7 @@
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/hestonblackvolsurface.hpp>
 #include <ql/pricingengines/basket/fd2dblackscholesvanillaengine.hpp>
+#include <ql/experimental/mcbasket/mcscenariobasketengines.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 #include <boost/progress.hpp>
@@ -588,6 +589,27 @@ void BasketOptionTest::testBarraquandThreeValues() {
                              mcRelativeErrorTolerance);
         }
 
+        // ...or several steps, built from their principal components
+        boost::shared_ptr<PricingEngine> mcSpectralEngine =
+            MakeMCEuropeanBasketEngine<LowDiscrepancy>(process)
+            .withSteps(10)
+            .withSpectralConstruction()
+            .withSamples(8091)
+            .withSeed(42);
+        euroBasketOption.setPricingEngine(mcSpectralEngine);
+
+        calculated = euroBasketOption.NPV();
+        relError = relativeError(calculated, expected, values[i].s1);
+        if (relError > mcRelativeErrorTolerance ) {
+            REPORT_FAILURE_3("MC Quasi value (spectral construction)",
+                             values[i].basketType, payoff,
+                             exercise, values[i].s1, values[i].s2,
+                             values[i].s3, values[i].r, today, values[i].v1,
+                             values[i].v2, values[i].v3, values[i].rho,
+                             values[i].euroValue, calculated, relError,
+                             mcRelativeErrorTolerance);
+        }
+
 
         Size requiredSamples = 1000;
         Size timeSteps = 500;
@@ -1093,6 +1115,126 @@ void BasketOptionTest::test2DPDEGreeks() {
     }
 }
 
+void BasketOptionTest::testScenarioSetEngines() {
+
+    BOOST_TEST_MESSAGE("Testing basket engines on shared scenario sets...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+
+    Real spots[] = { 100.0, 95.0, 105.0 };
+    Volatility vols[] = { 0.30, 0.20, 0.25 };
+    std::vector<boost::shared_ptr<StochasticProcess1D> > procs;
+    for (Size i=0; i<LENGTH(spots); ++i) {
+        procs.push_back(boost::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(boost::make_shared<SimpleQuote>(spots[i])),
+            qTS, rTS,
+            Handle<BlackVolTermStructure>(flatVol(today, vols[i], dc))));
+    }
+
+    Matrix correlation(3, 3, 1.0);
+    correlation[0][1] = correlation[1][0] = 0.5;
+    correlation[0][2] = correlation[2][0] = 0.2;
+    correlation[1][2] = correlation[2][1] = -0.3;
+    boost::shared_ptr<StochasticProcessArray> process =
+        boost::make_shared<StochasticProcessArray>(procs, correlation);
+
+    // the two products are fixed on different dates and depend on
+    // different assets; they're priced on the same set of paths.
+    Date shortDate = today + 180, longDate = today + 360;
+    std::vector<Date> dates;
+    dates.push_back(longDate);
+    dates.push_back(shortDate);
+
+    Size samples = 20000;
+    BigNatural seed = 42;
+    boost::shared_ptr<MultiPathScenarioSet<> > scenarios =
+        boost::make_shared<MultiPathScenarioSet<> >(process, dates,
+                                                    samples, seed, true);
+    boost::shared_ptr<MultiPathScenarioSet<> > singleScenarios =
+        boost::make_shared<MultiPathScenarioSet<> >(process, dates,
+                                                    samples, seed, true,
+                                                    Null<Size>(), true);
+
+    struct Product {
+        std::vector<Size> assets;
+        boost::shared_ptr<BasketPayoff> payoff;
+        Date exerciseDate;
+    };
+    Product products[2];
+    products[0].assets.push_back(0);
+    products[0].assets.push_back(1);
+    products[0].payoff = boost::make_shared<MaxBasketPayoff>(
+        boost::make_shared<PlainVanillaPayoff>(Option::Call, 100.0));
+    products[0].exerciseDate = longDate;
+    products[1].assets.push_back(1);
+    products[1].assets.push_back(2);
+    products[1].payoff = boost::make_shared<MinBasketPayoff>(
+        boost::make_shared<PlainVanillaPayoff>(Option::Put, 100.0));
+    products[1].exerciseDate = shortDate;
+
+    for (Size i=0; i<LENGTH(products); ++i) {
+        const Product& p = products[i];
+        BasketOption option(p.payoff,
+                            boost::make_shared<EuropeanExercise>(
+                                                          p.exerciseDate));
+
+        boost::shared_ptr<GeneralizedBlackScholesProcess> p1 =
+            boost::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                                                      procs[p.assets[0]]);
+        boost::shared_ptr<GeneralizedBlackScholesProcess> p2 =
+            boost::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                                                      procs[p.assets[1]]);
+        option.setPricingEngine(boost::make_shared<StulzEngine>(
+                     p1, p2, correlation[p.assets[0]][p.assets[1]]));
+        Real expected = option.NPV();
+
+        option.setPricingEngine(
+            boost::make_shared<MCScenarioBasketEngine<> >(scenarios,
+                                                          p.assets));
+        Real calculated = option.NPV();
+        Real errorEstimate = option.errorEstimate();
+        if (std::fabs(calculated-expected) > 4.0*errorEstimate) {
+            BOOST_ERROR("failed to reproduce analytic price"
+                        << " on scenario set for product " << i
+                        << std::fixed << std::setprecision(6)
+                        << "\n    calculated:     " << calculated
+                        << "\n    expected:       " << expected
+                        << "\n    error estimate: " << errorEstimate);
+        }
+
+        option.setPricingEngine(
+            boost::make_shared<MCScenarioBasketEngine<> >(scenarios,
+                                                          p.assets, 2));
+        Real parallel = option.NPV();
+        if (parallel != calculated) {
+            BOOST_ERROR("parallel evaluation changed the price"
+                        << " of product " << i
+                        << std::setprecision(12)
+                        << "\n    one worker:  " << calculated
+                        << "\n    two workers: " << parallel);
+        }
+
+        option.setPricingEngine(
+            boost::make_shared<MCScenarioBasketEngine<> >(singleScenarios,
+                                                          p.assets));
+        Real single = option.NPV();
+        if (std::fabs(single-calculated) > 1.0e-5*calculated) {
+            BOOST_ERROR("single-precision scenarios changed the price"
+                        << " of product " << i
+                        << std::setprecision(12)
+                        << "\n    double precision: " << calculated
+                        << "\n    single precision: " << single);
+        }
+    }
+}
+
 test_suite* BasketOptionTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Basket option tests");
 
@@ -1103,6 +1245,8 @@ test_suite* BasketOptionTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(
         &BasketOptionTest::testLocalVolatilitySpreadOption));
     suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::test2DPDEGreeks));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BasketOptionTest::testScenarioSetEngines));
 
     if (speed <= Fast) {
         const Size nTestCases = std::min(Size(5), LENGTH(oneDataValues));
@@ -35,6 +35,7 @@ class BasketOptionTest {
     static void testOddSamples();
     static void testLocalVolatilitySpreadOption();
     static void test2DPDEGreeks();
+    static void testScenarioSetEngines();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
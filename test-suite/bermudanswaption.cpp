@@ -22,6 +22,7 @@
 #include "utilities.hpp"
 #include <ql/instruments/swaption.hpp>
 #include <ql/pricingengines/swaption/treeswaptionengine.hpp>
+#include <ql/pricingengines/swaption/discretizedswaption.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/pricingengines/swaption/fdhullwhiteswaptionengine.hpp>
 #include <ql/pricingengines/swaption/fdg2swaptionengine.hpp>
@@ -298,10 +299,92 @@ void BermudanSwaptionTest::testCachedG2Values() {
     }
 }
 
+void BermudanSwaptionTest::testBatchRollback() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing batched tree rollback of Bermudan swaptions...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+
+    Settings::instance().evaluationDate() = vars.today;
+
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                          0.04875825,
+                                          Actual365Fixed()));
+
+    Rate atmRate = vars.makeSwap(0.0)->fairRate();
+
+    boost::shared_ptr<HullWhite> model(new HullWhite(vars.termStructure,
+                                                     0.048696, 0.0058904));
+
+    boost::shared_ptr<VanillaSwap> atmSwap = vars.makeSwap(atmRate);
+    std::vector<Date> exerciseDates;
+    const Leg& leg = atmSwap->fixedLeg();
+    for (Size i=0; i<leg.size(); i++) {
+        boost::shared_ptr<Coupon> coupon =
+            boost::dynamic_pointer_cast<Coupon>(leg[i]);
+        exerciseDates.push_back(coupon->accrualStartDate());
+    }
+    boost::shared_ptr<Exercise> exercise(new BermudanExercise(exerciseDates));
+
+    Date referenceDate = vars.termStructure->referenceDate();
+    DayCounter dayCounter = vars.termStructure->dayCounter();
+
+    Real moneyness[] = { 0.8, 0.9, 1.0, 1.1, 1.2 };
+    std::vector<boost::shared_ptr<Swaption> > swaptions;
+    std::vector<boost::shared_ptr<DiscretizedSwaption> > discretized;
+    std::vector<Time> times;
+    for (Size i=0; i<LENGTH(moneyness); i++) {
+        swaptions.push_back(boost::make_shared<Swaption>(
+                       vars.makeSwap(moneyness[i]*atmRate), exercise));
+        Swaption::arguments arguments;
+        swaptions.back()->setupArguments(&arguments);
+        discretized.push_back(boost::make_shared<DiscretizedSwaption>(
+                                    arguments, referenceDate, dayCounter));
+        std::vector<Time> t = discretized.back()->mandatoryTimes();
+        times.insert(times.end(), t.begin(), t.end());
+    }
+    TimeGrid grid(times.begin(), times.end(), 50);
+    boost::shared_ptr<Lattice> lattice = model->tree(grid);
+
+    Time lastExercise = dayCounter.yearFraction(referenceDate,
+                                                exerciseDates.back());
+    Time firstExercise = dayCounter.yearFraction(referenceDate,
+                                                 exerciseDates.front());
+    std::vector<DiscretizedAsset*> assets;
+    for (Size i=0; i<discretized.size(); i++) {
+        discretized[i]->initialize(lattice, lastExercise);
+        assets.push_back(discretized[i].get());
+    }
+    lattice->rollback(assets, firstExercise);
+
+    boost::shared_ptr<PricingEngine> treeEngine(
+                                          new TreeSwaptionEngine(model, grid));
+
+    Real tolerance = 1.0e-10;
+
+    for (Size i=0; i<swaptions.size(); i++) {
+        swaptions[i]->setPricingEngine(treeEngine);
+        Real expected = swaptions[i]->NPV();
+        Real calculated = discretized[i]->presentValue();
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("failed to reproduce single swaption value "
+                        "with batched rollback:\n"
+                        << std::setprecision(12)
+                        << "moneyness:  " << moneyness[i] << "\n"
+                        << "calculated: " << calculated << "\n"
+                        << "expected:   " << expected);
+    }
+}
+
 test_suite* BermudanSwaptionTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Bermudan swaption tests");
 
     suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testCachedValues));
+    suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testBatchRollback));
 
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(
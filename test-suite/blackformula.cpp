@@ -23,6 +23,7 @@
 #include "blackformula.hpp"
 #include "utilities.hpp"
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/batchblackformula.hpp>
 
 #include <boost/make_shared.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -278,6 +279,180 @@ void BlackFormulaTest::testImpliedVolAdaptiveSuccessiveOverRelaxation() {
     }
 }
 
+void BlackFormulaTest::testBatchBlackFormula() {
+    BOOST_TEST_MESSAGE("Testing Black formula for batches of options...");
+
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const Real forwards[] = { 0.01, 0.5, 80.0, 100.0, 125.0 };
+    const Real moneyness[] = { 0.0, 0.25, 0.8, 1.0, 1.2, 4.0 };
+    const Real stdDevs[] = { 0.0, 1e-4, 0.05, 0.2, 0.6, 2.0, 8.0 };
+    const Real discounts[] = { 0.6, 0.95, 1.0 };
+    const Real displacements[] = { 0.0, 0.2 };
+
+    std::vector<Real> strike, forward, stdDev, discount;
+    for (Size i=0; i<LENGTH(forwards); ++i)
+        for (Size j=0; j<LENGTH(moneyness); ++j)
+            for (Size k=0; k<LENGTH(stdDevs); ++k)
+                for (Size l=0; l<LENGTH(discounts); ++l) {
+                    forward.push_back(forwards[i]);
+                    strike.push_back(forwards[i]*moneyness[j]);
+                    stdDev.push_back(stdDevs[k]);
+                    discount.push_back(discounts[l]);
+                }
+    const Size n = forward.size();
+
+    const Real tol = 1e-13;
+
+    for (Size i=0; i<LENGTH(types); ++i) {
+        for (Size j=0; j<LENGTH(displacements); ++j) {
+            const Real displacement = displacements[j];
+
+            std::vector<Real> prices(n), derivatives(n), pricesOnly(n);
+            blackFormula(types[i], n, &strike[0], &forward[0], &stdDev[0],
+                         &discount[0], &prices[0], &derivatives[0],
+                         displacement);
+            blackFormula(types[i], n, &strike[0], &forward[0], &stdDev[0],
+                         &discount[0], &pricesOnly[0], 0, displacement);
+
+            for (Size k=0; k<n; ++k) {
+                const Real expectedPrice = blackFormula(
+                    types[i], strike[k], forward[k], stdDev[k],
+                    discount[k], displacement);
+                const Real expectedDerivative = blackFormulaStdDevDerivative(
+                    strike[k], forward[k], stdDev[k],
+                    discount[k], displacement);
+
+                const Real scale = forward[k] + displacement;
+                if (std::fabs(prices[k] - expectedPrice) > tol*scale
+                    || pricesOnly[k] != prices[k]
+                    || std::fabs(derivatives[k] - expectedDerivative)
+                                                         > tol*scale) {
+                    BOOST_ERROR("failed to reproduce Black formula"
+                                << "\n    type:         " << types[i]
+                                << "\n    strike:       " << strike[k]
+                                << "\n    forward:      " << forward[k]
+                                << "\n    stdDev:       " << stdDev[k]
+                                << "\n    discount:     " << discount[k]
+                                << "\n    displacement: " << displacement
+                                << std::setprecision(16)
+                                << "\n    price:        " << prices[k]
+                                << "\n    expected:     " << expectedPrice
+                                << "\n    derivative:   " << derivatives[k]
+                                << "\n    expected:     "
+                                << expectedDerivative);
+                }
+            }
+        }
+    }
+
+    std::vector<Real> prices(n);
+    std::vector<Real> negativeStdDev(stdDev);
+    negativeStdDev[n/2] = -0.1;
+    BOOST_CHECK_THROW(
+        blackFormula(Option::Call, n, &strike[0], &forward[0],
+                     &negativeStdDev[0], &discount[0], &prices[0]),
+        Error);
+}
+
+void BlackFormulaTest::testBatchImpliedStdDev() {
+    BOOST_TEST_MESSAGE(
+        "Testing implied standard deviation for batches of quotes...");
+
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const Real moneyness[] = { 0.2, 0.5, 0.8, 0.95, 1.0, 1.1, 1.5, 3.0 };
+    const Real stdDevs[] = { 0.01, 0.05, 0.1, 0.3, 0.7, 1.5, 3.0 };
+    const Real displacements[] = { 0.0, 20.0 };
+    const Real forward = 100.0, discount = 0.9;
+
+    const Real tol = 1e-8;
+
+    for (Size i=0; i<LENGTH(types); ++i) {
+        for (Size j=0; j<LENGTH(displacements); ++j) {
+            const Real displacement = displacements[j];
+
+            std::vector<Real> strikes, forwards, prices, discounts, expected;
+            for (Size k=0; k<LENGTH(moneyness); ++k) {
+                for (Size l=0; l<LENGTH(stdDevs); ++l) {
+                    // skip quotes with no significant time value,
+                    // whose implied standard deviation is undetermined
+                    const Real strike = forward*moneyness[k];
+                    const Real price = blackFormula(types[i], strike,
+                                                    forward, stdDevs[l],
+                                                    discount, displacement);
+                    const Real otherPrice =
+                        price - types[i]*(forward-strike)*discount;
+                    const Real call =
+                        types[i] == Option::Call ? price : otherPrice;
+                    const Real put =
+                        types[i] == Option::Put ? price : otherPrice;
+                    if (std::min(call, put) < 1e-3
+                        || (forward + displacement)*discount - call < 1e-3
+                        || (strike + displacement)*discount - put < 1e-3)
+                        continue;
+                    strikes.push_back(strike);
+                    forwards.push_back(forward);
+                    discounts.push_back(discount);
+                    expected.push_back(stdDevs[l]);
+                    prices.push_back(price);
+                }
+            }
+            const Size n = strikes.size();
+
+            std::vector<Real> results(n);
+            const Size flagged = blackFormulaImpliedStdDev(
+                types[i], n, &strikes[0], &forwards[0], &prices[0],
+                &discounts[0], &results[0], displacement);
+
+            if (flagged != 0)
+                BOOST_ERROR(flagged << " valid quotes were flagged"
+                            << "\n    type:         " << types[i]
+                            << "\n    displacement: " << displacement);
+
+            for (Size k=0; k<n; ++k) {
+                const Real error = std::fabs(results[k] - expected[k]);
+                if (error > tol) {
+                    BOOST_ERROR("failed to reproduce standard deviation"
+                                << "\n    type:         " << types[i]
+                                << "\n    strike:       " << strikes[k]
+                                << "\n    displacement: " << displacement
+                                << "\n    price:        " << prices[k]
+                                << "\n    result:       " << results[k]
+                                << "\n    expected:     " << expected[k]
+                                << "\n    error:        " << error
+                                << "\n    tolerance:    " << tol);
+                }
+            }
+        }
+    }
+
+    // quotes outside the arbitrage bounds are flagged
+    const Real strikes[] = { 100.0, 80.0, 120.0, 100.0, 90.0 };
+    const Real forwards[] = { 100.0, 100.0, 100.0, -1.0, 100.0 };
+    const Real prices[] = { 0.0, 15.0, 0.5, 5.0, 101.0 };
+    const Real discounts[] = { 1.0, 1.0, 1.0, 1.0, 1.0 };
+    const bool valid[] = { true, false, true, false, false };
+    Real results[LENGTH(strikes)];
+
+    const Size flagged = blackFormulaImpliedStdDev(
+        Option::Call, LENGTH(strikes), strikes, forwards, prices,
+        discounts, results);
+    if (flagged != 3)
+        BOOST_ERROR("3 invalid quotes expected, " << flagged << " found");
+    for (Size k=0; k<LENGTH(strikes); ++k) {
+        if (valid[k] != (results[k] != Null<Real>())) {
+            BOOST_ERROR("unexpected result for quote #" << k
+                        << "\n    strike:       " << strikes[k]
+                        << "\n    forward:      " << forwards[k]
+                        << "\n    price:        " << prices[k]
+                        << "\n    result:       " << results[k]);
+        }
+    }
+    if (results[0] != 0.0 || !(results[2] > 0.0))
+        BOOST_ERROR("unexpected results for valid quotes"
+                    << "\n    null time value:     " << results[0]
+                    << "\n    positive time value: " << results[2]);
+}
+
 
 test_suite* BlackFormulaTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Black formula tests");
@@ -292,6 +467,8 @@ test_suite* BlackFormulaTest::suite() {
         &BlackFormulaTest::testRadoicicStefanicaLowerBound));
     suite->add(QUANTLIB_TEST_CASE(
         &BlackFormulaTest::testImpliedVolAdaptiveSuccessiveOverRelaxation));
+    suite->add(QUANTLIB_TEST_CASE(&BlackFormulaTest::testBatchBlackFormula));
+    suite->add(QUANTLIB_TEST_CASE(&BlackFormulaTest::testBatchImpliedStdDev));
 
     return suite;
 }
@@ -32,6 +32,8 @@ class BlackFormulaTest {
     static void testRadoicicStefanicaImpliedVol();
     static void testRadoicicStefanicaLowerBound();
     static void testImpliedVolAdaptiveSuccessiveOverRelaxation();
+    static void testBatchBlackFormula();
+    static void testBatchImpliedStdDev();
 
     static boost::unit_test_framework::test_suite* suite();
 };
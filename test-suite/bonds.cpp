@@ -45,6 +45,7 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <ql/pricingengines/bond/bondbatch.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -1423,6 +1424,142 @@ void BondTest::testThirty360BondWithSettlementOn31st(){
     ASSERT_CLOSE("accrued", settlement, accrued, 0.7, 1e-6);
 }
 
+void BondTest::testBatch() {
+
+    BOOST_TEST_MESSAGE("Testing batch bond yield/price calculations...");
+
+    CommonVars vars;
+
+    Integer issueMonths[] = { -18, -6, 0, 6 };
+    Integer lengths[] = { 2, 5, 10, 30 };
+    Real coupons[] = { 0.0, 0.03, 0.07 };
+    Frequency frequency = Semiannual;
+    DayCounter bondDayCount = Thirty360();
+
+    std::vector<shared_ptr<Bond> > bonds;
+    for (Size i=0; i<LENGTH(issueMonths); i++) {
+        for (Size j=0; j<LENGTH(lengths); j++) {
+            for (Size k=0; k<LENGTH(coupons); k++) {
+                Date issue = vars.calendar.advance(vars.today,
+                                                   issueMonths[i], Months);
+                Date maturity = vars.calendar.advance(issue,
+                                                      lengths[j], Years);
+                Schedule sch(issue, maturity, Period(frequency),
+                             vars.calendar, Unadjusted, Unadjusted,
+                             DateGeneration::Backward, false);
+                bonds.push_back(shared_ptr<Bond>(
+                    new FixedRateBond(3, vars.faceAmount, sch,
+                                      std::vector<Rate>(1, coupons[k]),
+                                      bondDayCount, ModifiedFollowing,
+                                      100.0, issue)));
+            }
+        }
+    }
+
+    // a floating-rate bond, whose cashflows change with the curve
+    RelinkableHandle<YieldTermStructure> forecastCurve(
+                               flatRate(vars.today, 0.025, Actual360()));
+    shared_ptr<IborIndex> index(new USDLibor(6*Months, forecastCurve));
+    Date start = vars.calendar.advance(vars.today, 1, Weeks);
+    Schedule floatingSchedule(start, start + 5*Years,
+                              Period(Semiannual), vars.calendar,
+                              ModifiedFollowing, ModifiedFollowing,
+                              DateGeneration::Backward, false);
+    shared_ptr<Bond> floatingBond(
+        new FloatingRateBond(2, vars.faceAmount, floatingSchedule,
+                             index, Actual360(), ModifiedFollowing, 2,
+                             std::vector<Real>(), std::vector<Spread>(),
+                             std::vector<Rate>(), std::vector<Rate>(),
+                             false, 100.0, start));
+    setCouponPricer(floatingBond->cashflows(),
+                    shared_ptr<IborCouponPricer>(new BlackIborCouponPricer));
+    bonds.push_back(floatingBond);
+
+    BondBatch batch(bonds);
+    const Size n = bonds.size();
+
+    Compounding compounding[] = { Compounded, Continuous, Simple,
+                                  SimpleThenCompounded };
+    Rate yield = 0.04;
+    Real yieldTolerance = 1.0e-8, tolerance = 1.0e-8;
+
+    std::vector<Rate> inputYields(n, yield), yields(n);
+    std::vector<Real> prices(n), durations(n), convexities(n);
+
+    for (Size l=0; l<LENGTH(compounding); ++l) {
+        Compounding c = compounding[l];
+
+        Size failures = batch.cleanPrices(&inputYields[0], bondDayCount, c,
+                                          frequency, &prices[0]);
+        if (failures != 0)
+            BOOST_FAIL(failures << " prices not calculated");
+        failures = batch.yields(&prices[0], bondDayCount, c, frequency,
+                                &yields[0]);
+        if (failures != 0)
+            BOOST_FAIL(failures << " yields not calculated");
+        batch.durations(&yields[0], bondDayCount, c, frequency,
+                        Duration::Modified, &durations[0]);
+        batch.convexities(&yields[0], bondDayCount, c, frequency,
+                          &convexities[0]);
+
+        for (Size i=0; i<n; ++i) {
+            const Bond& bond = *bonds[i];
+            Real price = BondFunctions::cleanPrice(bond, yield, bondDayCount,
+                                                   c, frequency);
+            Rate expectedYield = BondFunctions::yield(bond, price,
+                                                      bondDayCount, c,
+                                                      frequency);
+            Time duration = BondFunctions::duration(bond, yields[i],
+                                                    bondDayCount, c,
+                                                    frequency,
+                                                    Duration::Modified);
+            Real convexity = BondFunctions::convexity(bond, yields[i],
+                                                      bondDayCount, c,
+                                                      frequency);
+            if (std::fabs(prices[i]-price) > tolerance*price
+                || std::fabs(yields[i]-expectedYield) > yieldTolerance
+                || std::fabs(durations[i]-duration) > tolerance*duration
+                || std::fabs(convexities[i]-convexity)
+                                                  > tolerance*convexity) {
+                BOOST_ERROR("failed to reproduce bond functions"
+                            << "\n    bond:        " << i
+                            << "\n    compounding: " << Integer(c)
+                            << std::setprecision(12)
+                            << "\n    price:       " << prices[i]
+                            << " (expected " << price << ")"
+                            << "\n    yield:       " << yields[i]
+                            << " (expected " << expectedYield << ")"
+                            << "\n    duration:    " << durations[i]
+                            << " (expected " << duration << ")"
+                            << "\n    convexity:   " << convexities[i]
+                            << " (expected " << convexity << ")");
+            }
+        }
+    }
+
+    // a change of the forecast curve must be seen by the batch
+    forecastCurve.linkTo(flatRate(vars.today, 0.035, Actual360()));
+    batch.cleanPrices(&inputYields[0], bondDayCount, Compounded, frequency,
+                      &prices[0]);
+    Real expected = BondFunctions::cleanPrice(*floatingBond, yield,
+                                              bondDayCount, Compounded,
+                                              frequency);
+    if (std::fabs(prices[n-1]-expected) > tolerance*expected) {
+        BOOST_ERROR("failed to update floating-rate bond price"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << prices[n-1]
+                    << "\n    expected:   " << expected);
+    }
+
+    // prices that no yield can reproduce
+    std::vector<Real> wrongPrices(n, -200.0);
+    Size failures = batch.yields(&wrongPrices[0], bondDayCount, Compounded,
+                                 frequency, &yields[0]);
+    if (failures != n || yields[0] != Null<Rate>())
+        BOOST_ERROR("failed to flag unreachable prices"
+                    << "\n    flagged: " << failures << " of " << n);
+}
+
 test_suite* BondTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bond tests");
 
@@ -1439,6 +1576,7 @@ test_suite* BondTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testExCouponAustralianBond));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testBondFromScheduleWithDateVector));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testThirty360BondWithSettlementOn31st));
+    suite->add(QUANTLIB_TEST_CASE(&BondTest::testBatch));
     return suite;
 }
 
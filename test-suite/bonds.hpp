@@ -40,6 +40,7 @@ class BondTest {
     static void testExCouponAustralianBond();
     static void testBondFromScheduleWithDateVector();
     static void testThirty360BondWithSettlementOn31st();
+    static void testBatch();
     static boost::unit_test_framework::test_suite* suite();
 };
 
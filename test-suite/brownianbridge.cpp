@@ -21,8 +21,10 @@
 #include "utilities.hpp"
 #include <ql/methods/montecarlo/brownianbridge.hpp>
 #include <ql/methods/montecarlo/pathgenerator.hpp>
+#include <ql/methods/montecarlo/spectralpathconstruction.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
+#include <ql/math/randomnumbers/sobolbrownianbridgersg.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -268,10 +270,179 @@ void BrownianBridgeTest::testPathGeneration() {
     }
 }
 
+void BrownianBridgeTest::testBlockGeneration() {
+
+    BOOST_TEST_MESSAGE("Testing generation of blocks of "
+                       "Sobol Brownian-bridge paths...");
+
+    const Size factors = 3, steps = 11, blockSize = 7, blocks = 4;
+    const Real tolerance = 1.0e-12;
+
+    SobolBrownianGenerator single(factors, steps,
+                                  SobolBrownianGenerator::Diagonal,
+                                  42, SobolRsg::JoeKuoD7);
+    SobolBrownianGenerator block(factors, steps,
+                                 SobolBrownianGenerator::Diagonal,
+                                 42, SobolRsg::JoeKuoD7);
+
+    std::vector<Real> weights, stepWeights, variates, step(factors);
+    for (Size b=0; b<blocks; ++b) {
+        block.nextPaths(blockSize, weights, stepWeights, variates);
+        for (Size k=0; k<blockSize; ++k) {
+            Real w = single.nextPath();
+            if (std::fabs(w - weights[k]) > tolerance)
+                BOOST_FAIL("weight mismatch for path #" << k
+                           << " of block #" << b);
+            for (Size j=0; j<steps; ++j) {
+                single.nextStep(step);
+                for (Size i=0; i<factors; ++i) {
+                    Real expected = step[i];
+                    Real calculated = variates[(j*factors+i)*blockSize+k];
+                    if (std::fabs(calculated - expected) > tolerance)
+                        BOOST_FAIL("failed to reproduce variate"
+                                   << "\n    block:      " << b
+                                   << "\n    path:       " << k
+                                   << "\n    step:       " << j
+                                   << "\n    factor:     " << i
+                                   << std::setprecision(16)
+                                   << "\n    calculated: " << calculated
+                                   << "\n    expected:   " << expected);
+                }
+            }
+        }
+    }
+
+    // the sequence generator, drawing blocks internally
+    SobolBrownianBridgeRsg rsg1(factors, steps,
+                                SobolBrownianGenerator::Steps, 42);
+    SobolBrownianBridgeRsg rsg2(factors, steps,
+                                SobolBrownianGenerator::Steps, 42,
+                                SobolRsg::JoeKuoD7, blockSize);
+    for (Size n=0; n<blocks*blockSize+3; ++n) {
+        const std::vector<Real>& expected = rsg1.nextSequence().value;
+        const std::vector<Real>& calculated = rsg2.nextSequence().value;
+        for (Size d=0; d<rsg1.dimension(); ++d) {
+            if (std::fabs(calculated[d] - expected[d]) > tolerance)
+                BOOST_FAIL("failed to reproduce sequence #" << n
+                           << " at dimension " << d
+                           << std::setprecision(16)
+                           << "\n    calculated: " << calculated[d]
+                           << "\n    expected:   " << expected[d]);
+        }
+    }
+}
+
+void BrownianBridgeTest::testSpectralConstruction() {
+
+    BOOST_TEST_MESSAGE("Testing spectral construction of "
+                       "multi-factor paths...");
+
+    Time times[] = { 0.1, 0.2, 0.3, 0.5, 0.75, 1.0, 2.0, 5.0 };
+    TimeGrid grid(times, times+LENGTH(times));
+    const Size steps = grid.size()-1;
+
+    Matrix correlation(3,3);
+    correlation[0][0] = 1.0; correlation[0][1] = 0.9; correlation[0][2] = 0.7;
+    correlation[1][0] = 0.9; correlation[1][1] = 1.0; correlation[1][2] = 0.4;
+    correlation[2][0] = 0.7; correlation[2][1] = 0.4; correlation[2][2] = 1.0;
+    const Size factors = correlation.rows();
+    const Size dimension = steps*factors;
+
+    SpectralPathConstructionCache cache;
+    SpectralPathConstruction construction =
+        cache.construction(grid, correlation);
+
+    const Real tolerance = 1.0e-12;
+
+    // the normalized variations must be independent with unit
+    // variance; the transformation is linear, so we check that its
+    // matrix is orthogonal
+    Matrix A(dimension, dimension);
+    std::vector<Real> e(dimension, 0.0), column(dimension);
+    for (Size k=0; k<dimension; ++k) {
+        e[k] = 1.0;
+        construction.transform(e.begin(), e.end(), column.begin());
+        e[k] = 0.0;
+        for (Size d=0; d<dimension; ++d)
+            A[d][k] = column[d];
+    }
+    Matrix covariance = A*transpose(A);
+    for (Size i=0; i<dimension; ++i) {
+        for (Size j=0; j<dimension; ++j) {
+            Real expected = (i == j ? 1.0 : 0.0);
+            if (std::fabs(covariance[i][j] - expected) > tolerance)
+                BOOST_FAIL("failed to reproduce covariance of variations"
+                           << "\n    indices:    " << i << ", " << j
+                           << "\n    calculated: " << covariance[i][j]
+                           << "\n    expected:   " << expected);
+        }
+    }
+
+    // the first variate must drive the principal component of the
+    // first factor, i.e., the total variance it gives to the path
+    // must be the largest eigenvalue of the covariance
+    Real w = 0.0, variance = 0.0;
+    for (Size i=0; i<steps; ++i) {
+        w += A[i*factors][0]*std::sqrt(grid.dt(i));
+        variance += w*w;
+    }
+    if (construction.variate(0,0) != 0 ||
+        std::fabs(variance - construction.eigenvalues()[0]) > tolerance)
+        BOOST_ERROR("first variate not driving the principal component"
+                    << "\n    variance:   " << variance
+                    << "\n    eigenvalue: "
+                    << construction.eigenvalues()[0]);
+    for (Size j=1; j<steps; ++j) {
+        if (construction.eigenvalues()[j] >
+            construction.eigenvalues()[j-1])
+            BOOST_ERROR("eigenvalues not in decreasing order");
+    }
+
+    // blocks of paths, straddling the blocks used internally
+    const Size lanes = 70;
+    std::vector<Real> input(dimension*lanes), output(dimension*lanes);
+    SobolRsg sobol(dimension, 42);
+    InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> generator(sobol);
+    for (Size l=0; l<lanes; ++l) {
+        const std::vector<Real>& sample = generator.nextSequence().value;
+        for (Size k=0; k<dimension; ++k)
+            input[k*lanes+l] = sample[k];
+    }
+    construction.transformLanes(&input[0], &output[0], lanes);
+    std::vector<Real> sample(dimension), expected(dimension);
+    for (Size l=0; l<lanes; ++l) {
+        for (Size k=0; k<dimension; ++k)
+            sample[k] = input[k*lanes+l];
+        construction.transform(sample.begin(), sample.end(),
+                               expected.begin());
+        for (Size d=0; d<dimension; ++d) {
+            Real calculated = output[d*lanes+l];
+            if (std::fabs(calculated - expected[d]) > tolerance)
+                BOOST_FAIL("failed to reproduce variation"
+                           << "\n    lane:       " << l
+                           << "\n    dimension:  " << d
+                           << std::setprecision(16)
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected[d]);
+        }
+    }
+
+    // cached constructions share their data
+    SpectralPathConstruction copy = cache.construction(grid, correlation);
+    if (&copy.eigenvalues() != &construction.eigenvalues())
+        BOOST_ERROR("cached constructions don't share their data");
+    cache.construction(grid, factors);
+    if (cache.size() != 2)
+        BOOST_ERROR(cache.size() << " constructions cached; 2 expected");
+}
+
 test_suite* BrownianBridgeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Brownian bridge tests");
     suite->add(QUANTLIB_TEST_CASE(&BrownianBridgeTest::testVariates));
     suite->add(QUANTLIB_TEST_CASE(&BrownianBridgeTest::testPathGeneration));
+    suite->add(QUANTLIB_TEST_CASE(&BrownianBridgeTest::testBlockGeneration));
+    suite->add(
+          QUANTLIB_TEST_CASE(&BrownianBridgeTest::testSpectralConstruction));
     return suite;
 }
 
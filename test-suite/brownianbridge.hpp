@@ -29,6 +29,8 @@ class BrownianBridgeTest {
   public:
     static void testVariates();
     static void testPathGeneration();
+    static void testBlockGeneration();
+    static void testSpectralConstruction();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -1897,6 +1897,80 @@ void CalendarTest::testBespokeCalendars() {
 
 }
 
+void CalendarTest::testBusinessDayCache() {
+
+    BOOST_TEST_MESSAGE("Testing cached business days against "
+                       "day-by-day calculations...");
+
+    Calendar target = TARGET(), uk = UnitedKingdom(), us = UnitedStates();
+    std::vector<Calendar> calendars;
+    calendars.push_back(target);
+    calendars.push_back(Japan());
+    calendars.push_back(JointCalendar(target, uk, us, JoinHolidays));
+    calendars.push_back(JointCalendar(target, uk, JoinBusinessDays));
+
+    Date start(20, December, 2011);
+    Integer offsets[] = { -700, -260, -12, -1, 1, 3, 17, 261, 700 };
+    for (Size i=0; i<calendars.size(); ++i) {
+        const Calendar& c = calendars[i];
+        for (Date d = start; d < start + 20; ++d) {
+            for (Size j=0; j<LENGTH(offsets); ++j) {
+                Integer n = offsets[j];
+                Date expected = d;
+                for (Integer k=0; k<std::abs(n); ++k) {
+                    do {
+                        expected += (n > 0 ? 1 : -1);
+                    } while (!c.isBusinessDay(expected));
+                }
+                Date calculated = c.advance(d, n, Days);
+                if (calculated != expected)
+                    BOOST_FAIL(c.name() << ": advancing " << d << " by "
+                               << n << " business days:"
+                               << "\n    calculated: " << calculated
+                               << "\n    expected:   " << expected);
+
+                Date::serial_type count = 0;
+                Date d1 = std::min(d, expected), d2 = std::max(d, expected);
+                for (Date t = d1+1; t < d2; ++t)
+                    if (c.isBusinessDay(t))
+                        ++count;
+                if (n < 0)
+                    count = -count;
+                Date::serial_type calculatedCount =
+                    c.businessDaysBetween(d, expected, false, false);
+                if (calculatedCount != count)
+                    BOOST_FAIL(c.name() << ": business days between "
+                               << d << " and " << expected << ":"
+                               << "\n    calculated: " << calculatedCount
+                               << "\n    expected:   " << count);
+            }
+        }
+    }
+
+    // modifying a calendar must be reflected in the joint
+    // calendars built upon it
+    Calendar joint = JointCalendar(target, uk, JoinHolidays);
+    Date d(15, June, 2012);
+    if (!joint.isBusinessDay(d))
+        BOOST_FAIL(d << " not a business day for " << joint.name());
+    target.addHoliday(d);
+    bool afterAdding = joint.isBusinessDay(d);
+    Date advanced = joint.advance(d - 1, 1, Days);
+    target.removeHoliday(d);
+    if (afterAdding)
+        BOOST_ERROR(d << " still a business day for " << joint.name()
+                    << " after adding it as a TARGET holiday");
+    if (advanced != Date(18, June, 2012))
+        BOOST_ERROR("advancing " << d - 1 << " by one business day for "
+                    << joint.name() << " after adding " << d
+                    << " as a TARGET holiday:"
+                    << "\n    calculated: " << advanced
+                    << "\n    expected:   " << Date(18, June, 2012));
+    if (!joint.isBusinessDay(d))
+        BOOST_ERROR(d << " not a business day for " << joint.name()
+                    << " after removing it as a TARGET holiday");
+}
+
 
 test_suite* CalendarTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Calendar tests");
@@ -1934,6 +2008,7 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDayCache));
 
     return suite;
 }
@@ -20,16 +20,21 @@
 #include "cashflows.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compactleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/legnotifier.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/termstructures/volatility/optionlet/constantoptionletvol.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <ql/patterns/observergraph.hpp>
 #include <ql/settings.hpp>
 
 using namespace QuantLib;
@@ -310,6 +315,250 @@ void CashFlowsTest::testIrregularLastCouponReferenceDatesAtEndOfMonth() {
                             "got " << lastCoupon->referencePeriodEnd());
 }
 
+void CashFlowsTest::testBulkNpvBps() {
+    BOOST_TEST_MESSAGE("Testing NPV and BPS of several legs at once...");
+
+    SavedSettings backup;
+
+    Date today = Date(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+    FlatForward curve(today, 0.03, Actual365Fixed());
+
+    std::vector<Leg> legs;
+    for (Integer i=1; i<=5; ++i) {
+        Schedule schedule =
+            MakeSchedule()
+            .from(today-i*Months).to(today+(2*i)*Years)
+            .withFrequency(i%2 == 0 ? Annual : Semiannual)
+            .withCalendar(TARGET())
+            .withConvention(Following)
+            .backwards();
+        Leg leg = FixedRateLeg(schedule)
+                  .withNotionals(100.0*i)
+                  .withCouponRates(0.01*i, Actual360());
+        leg.push_back(shared_ptr<CashFlow>(
+                          new SimpleCashFlow(100.0*i, schedule.endDate())));
+        legs.push_back(leg);
+    }
+    legs.push_back(Leg());
+
+    std::vector<Real> npvs, bps;
+    CashFlows::npvbps(legs, curve, false, today, today, npvs, bps);
+
+    if (npvs.size() != legs.size() || bps.size() != legs.size())
+        BOOST_FAIL("wrong number of results returned");
+
+    Real tolerance = 1.0e-10;
+    for (Size i=0; i<legs.size(); ++i) {
+        Real expectedNpv = CashFlows::npv(legs[i], curve, false, today, today),
+             expectedBps = CashFlows::bps(legs[i], curve, false, today, today);
+        if (std::fabs(npvs[i] - expectedNpv) > tolerance)
+            BOOST_ERROR("NPV mismatch for " << io::ordinal(i+1) << " leg:"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << npvs[i]
+                        << "\n    expected:   " << expectedNpv);
+        if (std::fabs(bps[i] - expectedBps) > tolerance)
+            BOOST_ERROR("BPS mismatch for " << io::ordinal(i+1) << " leg:"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << bps[i]
+                        << "\n    expected:   " << expectedBps);
+    }
+}
+
+void CashFlowsTest::testCompactLeg() {
+    BOOST_TEST_MESSAGE("Testing compact representation of legs...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today = Date(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> curve(shared_ptr<YieldTermStructure>(
+                            new FlatForward(today, 0.03, Actual365Fixed())));
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(today-2*Months).to(today+10*Years)
+        .withFrequency(Quarterly)
+        .withCalendar(TARGET())
+        .withConvention(ModifiedFollowing)
+        .backwards();
+
+    Leg fixedLeg = FixedRateLeg(schedule)
+                   .withNotionals(100.0)
+                   .withCouponRates(0.02, Actual360());
+    fixedLeg.push_back(shared_ptr<CashFlow>(
+                           new Redemption(100.0, schedule.endDate())));
+
+    shared_ptr<IborIndex> index(new USDLibor(3*Months, curve));
+    Leg floatingLeg = IborLeg(schedule, index)
+                      .withNotionals(100.0)
+                      .withSpreads(0.001);
+    // the first two coupons (the first being a short stub) fix in the past
+    for (Size i=0; i<2; ++i) {
+        shared_ptr<FloatingRateCoupon> c =
+            boost::dynamic_pointer_cast<FloatingRateCoupon>(floatingLeg[i]);
+        index->addFixing(c->fixingDate(), 0.015 + i*0.001);
+    }
+
+    Leg legs[] = { fixedLeg, floatingLeg };
+    for (Size j=0; j<LENGTH(legs); ++j) {
+        const Leg& leg = legs[j];
+        CompactLeg compact(leg);
+
+        if (compact.size() != leg.size())
+            BOOST_FAIL("compact leg has " << compact.size()
+                       << " cash flows; " << leg.size() << " expected");
+
+        for (Size i=0; i<leg.size(); ++i) {
+            if (compact.date(i) != leg[i]->date())
+                BOOST_ERROR("payment date mismatch for "
+                            << io::ordinal(i+1) << " cash flow");
+            if (std::fabs(compact.amount(i) - leg[i]->amount()) > 1.0e-12)
+                BOOST_ERROR("amount mismatch for "
+                            << io::ordinal(i+1) << " cash flow:"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << compact.amount(i)
+                            << "\n    expected:   " << leg[i]->amount());
+        }
+
+        Real npv, bps;
+        CashFlows::npvbps(compact, **curve, false, today, today, npv, bps);
+        Real expectedNpv = CashFlows::npv(leg, **curve, false, today, today),
+             expectedBps = CashFlows::bps(leg, **curve, false, today, today);
+        if (std::fabs(npv - expectedNpv) > 1.0e-10)
+            BOOST_ERROR("NPV mismatch:"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << npv
+                        << "\n    expected:   " << expectedNpv);
+        if (std::fabs(bps - expectedBps) > 1.0e-10)
+            BOOST_ERROR("BPS mismatch:"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << bps
+                        << "\n    expected:   " << expectedBps);
+    }
+}
+
+void CashFlowsTest::testBatchedIborFixings() {
+    BOOST_TEST_MESSAGE("Testing batched forecast of ibor fixings...");
+
+    SavedSettings backup;
+
+    Date today = Date(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+    RelinkableHandle<YieldTermStructure> curve(shared_ptr<YieldTermStructure>(
+                            new FlatForward(today, 0.03, Actual365Fixed())));
+    shared_ptr<IborIndex> index(new USDLibor(6*Months, curve));
+
+    std::vector<Leg> legs, references;
+    for (Integer i=1; i<=3; ++i) {
+        Schedule schedule =
+            MakeSchedule()
+            .from(today+i*Months).to(today+(5*i)*Years)
+            .withFrequency(Semiannual)
+            .withCalendar(TARGET())
+            .withConvention(ModifiedFollowing)
+            .backwards();
+        legs.push_back(IborLeg(schedule, index).withNotionals(100.0));
+        references.push_back(IborLeg(schedule, index).withNotionals(100.0));
+    }
+
+    forecastIborFixings(legs);
+
+    for (Size k=0; k<2; ++k) {
+        for (Size j=0; j<legs.size(); ++j) {
+            for (Size i=0; i<legs[j].size(); ++i) {
+                Real calculated = legs[j][i]->amount(),
+                     expected = references[j][i]->amount();
+                if (std::fabs(calculated - expected) > 1.0e-12)
+                    BOOST_ERROR("amount mismatch for " << io::ordinal(i+1)
+                                << " coupon of " << io::ordinal(j+1)
+                                << " leg" << (k == 0 ? "" : " after relinking")
+                                << ":" << std::setprecision(12)
+                                << "\n    calculated: " << calculated
+                                << "\n    expected:   " << expected);
+            }
+        }
+        // the stored fixings must be discarded
+        curve.linkTo(shared_ptr<YieldTermStructure>(
+                            new FlatForward(today, 0.04, Actual365Fixed())));
+    }
+}
+
+void CashFlowsTest::testLegNotifier() {
+    BOOST_TEST_MESSAGE("Testing shared registration of leg cash flows...");
+
+    SavedSettings backup;
+
+    Date today = Date(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+    RelinkableHandle<YieldTermStructure> curve(shared_ptr<YieldTermStructure>(
+                            new FlatForward(today, 0.03, Actual365Fixed())));
+    shared_ptr<IborIndex> index(new USDLibor(6*Months, curve));
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(today+1*Months).to(today+10*Years)
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(ModifiedFollowing)
+        .backwards();
+    Leg leg = IborLeg(schedule, index).withNotionals(100.0);
+    Leg reference = IborLeg(schedule, index).withNotionals(100.0);
+    Size n = leg.size();
+
+    std::vector<shared_ptr<Flag> > flags(n);
+    for (Size i=0; i<n; ++i) {
+        flags[i] = shared_ptr<Flag>(new Flag);
+        flags[i]->registerWith(leg[i]);
+    }
+
+    {
+        LegNotifier notifier(leg);
+        if (notifier.size() != n)
+            BOOST_FAIL(notifier.size() << " cash flows notified; "
+                       << n << " expected");
+
+        Size fanOut = ObserverGraph(*index).nodes()[0].fanOut;
+        if (fanOut != n+1)
+            BOOST_FAIL("index observed by " << fanOut << " objects; "
+                       << n+1 << " expected");
+
+        for (Size k=0; k<2; ++k) {
+            for (Size i=0; i<n; ++i) {
+                Real calculated = leg[i]->amount(),
+                     expected = reference[i]->amount();
+                if (std::fabs(calculated - expected) > 1.0e-12)
+                    BOOST_FAIL("amount mismatch for " << io::ordinal(i+1)
+                               << " coupon" << (k == 0 ? "" : " after relinking")
+                               << ":" << std::setprecision(12)
+                               << "\n    calculated: " << calculated
+                               << "\n    expected:   " << expected);
+            }
+            curve.linkTo(shared_ptr<YieldTermStructure>(
+                            new FlatForward(today, 0.04, Actual365Fixed())));
+            for (Size i=0; i<n; ++i) {
+                if (!flags[i]->isUp())
+                    BOOST_FAIL("observer of " << io::ordinal(i+1)
+                               << " coupon not notified");
+                flags[i]->lower();
+            }
+        }
+    }
+
+    // the cash flows are registered again with their observables
+    Size fanOut = ObserverGraph(*index).nodes()[0].fanOut;
+    if (fanOut != 2*n)
+        BOOST_FAIL("index observed by " << fanOut << " objects after "
+                   "destruction of the notifier; " << 2*n << " expected");
+    Settings::instance().evaluationDate() = today+1;
+    for (Size i=0; i<n; ++i) {
+        if (!flags[i]->isUp())
+            BOOST_FAIL("observer of " << io::ordinal(i+1) << " coupon not "
+                       "notified after destruction of the notifier");
+    }
+}
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
@@ -322,6 +571,10 @@ test_suite* CashFlowsTest::suite() {
                              &CashFlowsTest::testIrregularFirstCouponReferenceDatesAtEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(
                              &CashFlowsTest::testIrregularLastCouponReferenceDatesAtEndOfMonth));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testBulkNpvBps));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testCompactLeg));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testBatchedIborFixings));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testLegNotifier));
     return suite;
 }
 
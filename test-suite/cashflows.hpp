@@ -30,6 +30,10 @@ class CashFlowsTest {
     static void testNullFixingDays();
     static void testIrregularFirstCouponReferenceDatesAtEndOfMonth();
     static void testIrregularLastCouponReferenceDatesAtEndOfMonth();
+    static void testBulkNpvBps();
+    static void testCompactLeg();
+    static void testBatchedIborFixings();
+    static void testLegNotifier();
     static boost::unit_test_framework::test_suite* suite();
 };
 
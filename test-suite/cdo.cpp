@@ -28,6 +28,8 @@
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
 
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
+#include <ql/experimental/credit/recursivelossmodel.hpp>
+#include <ql/experimental/credit/fftlossmodel.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/time/calendars/target.hpp>
@@ -39,6 +41,7 @@
 #include <boost/bind.hpp>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 
 using namespace QuantLib;
 using namespace std;
@@ -221,7 +224,20 @@ void CdoTest::testHW(unsigned dataSet) {
         relativeTolerancePeriod.push_back(0.5);
         // Binomial...
         // Saddle point...
-        // Recursive ...
+        // recursive gaussian
+        modelNames.push_back("Recursive gaussian");
+        basketModels.push_back(boost::shared_ptr<DefaultLossModel>(new
+            RecursiveGaussLossModel(gaussKtLossLM)));
+        absoluteTolerance.push_back(1.);
+        relativeToleranceMidp.push_back(0.04);
+        relativeTolerancePeriod.push_back(0.04);
+        // FFT gaussian
+        modelNames.push_back("FFT gaussian");
+        basketModels.push_back(boost::shared_ptr<DefaultLossModel>(new
+            FFTGaussLossModel(gaussKtLossLM)));
+        absoluteTolerance.push_back(1.);
+        relativeToleranceMidp.push_back(0.04);
+        relativeTolerancePeriod.push_back(0.04);
     }
     else if (hwData7[i].nm > 0 && hwData7[i].nz > 0) {
         TCopulaPolicy::initTraits initTG;
@@ -369,9 +385,173 @@ void CdoTest::testHW(unsigned dataSet) {
 }
 
 
+void CdoTest::testExpectedTrancheLosses() {
+    #ifndef QL_PATCH_SOLARIS
+
+    BOOST_TEST_MESSAGE("Testing expected tranche losses at several dates...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    // a heterogeneous pool, so that the loss buckets differ by name
+    Size poolSize = 20;
+    boost::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    vector<Real> nominals, recoveries;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        nominals.push_back(i % 2 == 0 ? 100.0 : 200.0);
+        recoveries.push_back(i % 3 == 0 ? 0.4 : 0.25);
+        Handle<Quote> hazardRate(boost::shared_ptr<Quote>(
+                                      new SimpleQuote(0.005 + 0.001*i)));
+        vector<pair<DefaultProbKey,
+               Handle<DefaultProbabilityTermStructure> > > probabilities;
+        probabilities.push_back(std::make_pair(
+            NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                       Period(0,Weeks), 10.),
+            Handle<DefaultProbabilityTermStructure>(
+                boost::shared_ptr<DefaultProbabilityTermStructure>(
+                    new FlatHazardRate(asofDate, hazardRate,
+                                       ActualActual())))));
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+
+    Handle<Quote> correlation(boost::shared_ptr<Quote>(new SimpleQuote(0.3)));
+    boost::shared_ptr<GaussianConstantLossLM> lossLM(
+        new GaussianConstantLossLM(correlation, recoveries,
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            GaussianCopulaPolicy::initTraits()));
+
+    std::vector<Date> dates;
+    for (Size i=1; i<=20; ++i)
+        dates.push_back(asofDate + Period(3*i, Months));
+
+    Real tolerance = 1.0e-12;
+
+    for (Size j = 0; j < LENGTH(hwAttachment); j ++) {
+        boost::shared_ptr<Basket> basket(
+            new Basket(asofDate, names, nominals, pool,
+                       hwAttachment[j], hwDetachment[j]));
+        basket->setLossModel(boost::shared_ptr<DefaultLossModel>(
+                                     new RecursiveGaussLossModel(lossLM, 2)));
+
+        std::vector<Real> losses = basket->expectedTrancheLosses(dates);
+        for (Size i=0; i<dates.size(); ++i) {
+            Real expected = basket->expectedTrancheLoss(dates[i]);
+            if (std::fabs(losses[i] - expected)
+                > tolerance * basket->trancheNotional())
+                BOOST_ERROR("failed to reproduce expected tranche loss"
+                            << "\n    tranche:    [" << hwAttachment[j]
+                            << ", " << hwDetachment[j] << "]"
+                            << "\n    date:       " << dates[i]
+                            << std::setprecision(12)
+                            << "\n    calculated: " << losses[i]
+                            << "\n    expected:   " << expected);
+        }
+    }
+    #endif
+}
+
+
+void CdoTest::testFFTLossModel() {
+    #ifndef QL_PATCH_SOLARIS
+
+    BOOST_TEST_MESSAGE("Testing FFT loss model against recursive model...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    Size poolSize = 60;
+    boost::shared_ptr<Pool> pool(new Pool());
+    vector<string> names;
+    vector<Real> nominals, recoveries;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        nominals.push_back(100.0 * (1 + i % 4));
+        recoveries.push_back(i % 3 == 0 ? 0.4 : 0.25);
+        Handle<Quote> hazardRate(boost::shared_ptr<Quote>(
+                                      new SimpleQuote(0.005 + 0.0005*i)));
+        vector<pair<DefaultProbKey,
+               Handle<DefaultProbabilityTermStructure> > > probabilities;
+        probabilities.push_back(std::make_pair(
+            NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                       Period(0,Weeks), 10.),
+            Handle<DefaultProbabilityTermStructure>(
+                boost::shared_ptr<DefaultProbabilityTermStructure>(
+                    new FlatHazardRate(asofDate, hazardRate,
+                                       ActualActual())))));
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                             Period(), 1.));
+    }
+
+    Handle<Quote> correlation(boost::shared_ptr<Quote>(new SimpleQuote(0.3)));
+    boost::shared_ptr<GaussianConstantLossLM> lossLM(
+        new GaussianConstantLossLM(correlation, recoveries,
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            GaussianCopulaPolicy::initTraits()));
+
+    std::vector<Date> dates;
+    for (Size i=1; i<=5; ++i)
+        dates.push_back(asofDate + Period(i, Years));
+
+    // both models convolve the same discretized losses; only the
+    // roundoff of the transforms differs
+    Real tolerance = 1.0e-10;
+
+    for (Size j = 0; j < LENGTH(hwAttachment); j ++) {
+        boost::shared_ptr<Basket> basket(
+            new Basket(asofDate, names, nominals, pool,
+                       hwAttachment[j], hwDetachment[j]));
+        basket->setLossModel(boost::shared_ptr<DefaultLossModel>(
+                                     new RecursiveGaussLossModel(lossLM, 2)));
+        std::vector<Real> expected = basket->expectedTrancheLosses(dates);
+
+        boost::shared_ptr<FFTGaussLossModel> fftModel(
+                                          new FFTGaussLossModel(lossLM, 2));
+        basket->setLossModel(fftModel);
+        std::vector<Real> calculated = basket->expectedTrancheLosses(dates);
+
+        for (Size i=0; i<dates.size(); ++i) {
+            if (std::fabs(calculated[i] - expected[i])
+                > tolerance * basket->trancheNotional())
+                BOOST_ERROR("failed to reproduce expected tranche loss"
+                            << "\n    tranche:    [" << hwAttachment[j]
+                            << ", " << hwDetachment[j] << "]"
+                            << "\n    date:       " << dates[i]
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated[i]
+                            << "\n    expected:   " << expected[i]);
+        }
+
+        std::vector<Real> probs = fftModel->lossProbability(dates.back());
+        Real total = std::accumulate(probs.begin(), probs.end(), Real(0.0));
+        if (std::fabs(total - 1.0) > 1.0e-10)
+            BOOST_ERROR("loss probabilities don't add up to one"
+                        << "\n    tranche:    [" << hwAttachment[j]
+                        << ", " << hwDetachment[j] << "]"
+                        << std::setprecision(12)
+                        << "\n    total:      " << total);
+    }
+    #endif
+}
+
+
 test_suite* CdoTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("CDO tests");
     #ifndef QL_PATCH_SOLARIS
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testExpectedTrancheLosses));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testFFTLossModel));
     if (speed == Slow) {
         for (unsigned i=0; i < LENGTH(hwData7); ++i)
             suite->add(QUANTLIB_TEST_CASE(
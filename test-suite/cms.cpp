@@ -494,10 +494,97 @@ void CmsTest::testParity() {
     }
 }
 
+void CmsTest::testReplicationCache() {
+
+    BOOST_TEST_MESSAGE("Testing cached replication in CMS-coupon pricers...");
+
+    CommonVars vars;
+
+    shared_ptr<SimpleQuote> meanReversion(new SimpleQuote(0.0));
+    Handle<Quote> meanReversionHandle(meanReversion);
+
+    // pricers with and without cache
+    std::vector<shared_ptr<CmsCouponPricer> > cached, uncached;
+    cached.push_back(shared_ptr<CmsCouponPricer>(new
+        NumericHaganPricer(vars.SabrVolCube1,
+                           GFunctionFactory::NonParallelShifts,
+                           meanReversionHandle)));
+    uncached.push_back(shared_ptr<CmsCouponPricer>(new
+        NumericHaganPricer(vars.SabrVolCube1,
+                           GFunctionFactory::NonParallelShifts,
+                           meanReversionHandle,
+                           0.0, 1.0, 1.0e-6, QL_MAX_REAL, 0)));
+    cached.push_back(shared_ptr<CmsCouponPricer>(new
+        LinearTsrPricer(vars.SabrVolCube1, meanReversionHandle)));
+    uncached.push_back(shared_ptr<CmsCouponPricer>(new
+        LinearTsrPricer(vars.SabrVolCube1, meanReversionHandle,
+                        Handle<YieldTermStructure>(),
+                        LinearTsrPricer::Settings(),
+                        shared_ptr<Integrator>(), 0)));
+
+    shared_ptr<SwapIndex> swapIndex(new
+        EuriborSwapIsdaFixA(10*Years, vars.termStructure));
+
+    // the coupons of the two swaps share their fixing dates
+    std::vector<shared_ptr<Swap> > cms(2);
+    cms[0] = MakeCms(10*Years, swapIndex, vars.iborIndex, 0.0, 10*Days);
+    cms[1] = MakeCms(10*Years, swapIndex, vars.iborIndex, 0.0010, 10*Days);
+
+    Real tolerance = 1.0e-12;
+
+    for (Size scenario=0; scenario<3; ++scenario) {
+        if (scenario == 1)
+            vars.termStructure.linkTo(
+                flatRate(vars.termStructure->referenceDate(), 0.04,
+                         Actual365Fixed()));
+        if (scenario == 2)
+            meanReversion->setValue(0.01);
+
+        for (Size j=0; j<cached.size(); ++j) {
+            for (Size k=0; k<cms.size(); ++k) {
+                setCouponPricer(cms[k]->leg(0), uncached[j]);
+                Real expected = cms[k]->NPV();
+                setCouponPricer(cms[k]->leg(0), cached[j]);
+                Real calculated = cms[k]->NPV();
+                if (std::fabs(calculated-expected) > tolerance)
+                    BOOST_FAIL("failed to reproduce uncached CMS price:"
+                               << "\n    pricer:     "
+                               << (j == 0 ? "numeric Hagan" : "linear TSR")
+                               << "\n    scenario:   " << scenario
+                               << "\n    swap:       " << k
+                               << std::setprecision(12)
+                               << "\n    calculated: " << calculated
+                               << "\n    expected:   " << expected);
+            }
+        }
+    }
+
+    // integration on fixed Gauss-Legendre nodes
+    shared_ptr<CmsCouponPricer> gaussLegendre(new
+        LinearTsrPricer(vars.SabrVolCube1, meanReversionHandle,
+                        Handle<YieldTermStructure>(),
+                        LinearTsrPricer::Settings()
+                            .withGaussLegendreNodes(64)));
+    for (Size k=0; k<cms.size(); ++k) {
+        setCouponPricer(cms[k]->leg(0), uncached[1]);
+        Real expected = cms[k]->NPV();
+        setCouponPricer(cms[k]->leg(0), gaussLegendre);
+        Real calculated = cms[k]->NPV();
+        if (std::fabs(calculated-expected) > 1.0e-6)
+            BOOST_FAIL("failed to reproduce CMS price "
+                       "with Gauss-Legendre integration:"
+                       << "\n    swap:       " << k
+                       << std::setprecision(12)
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected);
+    }
+}
+
 test_suite* CmsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cms tests");
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testCmsSwap));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testParity));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testReplicationCache));
     return suite;
 }
@@ -359,6 +359,24 @@ void ConvertibleBondTest::testOption() {
                     << "\n    error:      " << error
                     << "\n    tolerance:      " << tolerance);
     }
+
+    // the sensitivities are read from the same tree
+    Real expectedDelta = vars.conversionRatio*euOption.delta();
+    error = std::fabs(euZero.delta()-expectedDelta);
+    if (error > 1.0e-3) {
+        BOOST_ERROR("failed to reproduce plain-option delta:"
+                    << "\n    calculated: " << euZero.delta()
+                    << "\n    expected:   " << expectedDelta
+                    << "\n    error:      " << error);
+    }
+    Real expectedGamma = vars.conversionRatio*euOption.gamma();
+    error = std::fabs(euZero.gamma()-expectedGamma);
+    if (error > 1.0e-4) {
+        BOOST_ERROR("failed to reproduce plain-option gamma:"
+                    << "\n    calculated: " << euZero.gamma()
+                    << "\n    expected:   " << expectedGamma
+                    << "\n    error:      " << error);
+    }
 }
 
 void ConvertibleBondTest::testRegression() {
@@ -713,6 +713,118 @@ void CreditDefaultSwapTest::testIsdaEngine() {
 
 }
 
+void CreditDefaultSwapTest::testIsdaEngineSharedByMaturities() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing ISDA engine shared by a strip of credit-default swaps...");
+
+    SavedSettings backup;
+
+    Date tradeDate(21, May, 2009);
+    Settings::instance().evaluationDate() = tradeDate;
+
+    std::vector<boost::shared_ptr<RateHelper> > rateHelpers;
+    Integer depositTenors[] = {1, 3, 6, 12};
+    Rate depositQuotes[] = {0.003081, 0.007163, 0.012413, 0.015488};
+    for (Size i=0; i<LENGTH(depositTenors); ++i) {
+        rateHelpers.push_back(boost::make_shared<DepositRateHelper>(
+                                 depositQuotes[i], depositTenors[i] * Months,
+                                 2, WeekendsOnly(), ModifiedFollowing,
+                                 false, Actual360()));
+    }
+    boost::shared_ptr<IborIndex> ibor = boost::make_shared<IborIndex>(
+        "IsdaIbor", 3 * Months, 2, USDCurrency(), WeekendsOnly(),
+        ModifiedFollowing, false, Actual360());
+    Integer swapTenors[] = {2, 3, 5, 7, 10, 12};
+    Rate swapQuotes[] = {0.011907, 0.01699, 0.02444, 0.028967, 0.03279,
+                         0.034535};
+    for (Size i=0; i<LENGTH(swapTenors); ++i) {
+        rateHelpers.push_back(boost::make_shared<SwapRateHelper>(
+                                  swapQuotes[i], swapTenors[i] * Years,
+                                  WeekendsOnly(), Semiannual,
+                                  ModifiedFollowing, Thirty360(), ibor));
+    }
+    Handle<YieldTermStructure> discountCurve(
+            boost::make_shared<PiecewiseYieldCurve<Discount, LogLinear> >(
+                0, WeekendsOnly(), rateHelpers, Actual365Fixed()));
+
+    std::vector<Date> hazardDates;
+    hazardDates.push_back(tradeDate);
+    hazardDates.push_back(Date(20, June, 2010));
+    hazardDates.push_back(Date(20, June, 2012));
+    hazardDates.push_back(Date(20, June, 2014));
+    hazardDates.push_back(Date(20, June, 2021));
+    std::vector<Real> hazardRates;
+    hazardRates.push_back(0.01);
+    hazardRates.push_back(0.01);
+    hazardRates.push_back(0.015);
+    hazardRates.push_back(0.02);
+    hazardRates.push_back(0.025);
+
+    RelinkableHandle<DefaultProbabilityTermStructure> probabilityCurve;
+    probabilityCurve.linkTo(
+        boost::make_shared<InterpolatedHazardRateCurve<BackwardFlat> >(
+                               hazardDates, hazardRates, Actual365Fixed()));
+
+    Real recoveryRate = 0.4;
+    boost::shared_ptr<PricingEngine> sharedEngine =
+        boost::make_shared<IsdaCdsEngine>(probabilityCurve, recoveryRate,
+                                          discountCurve);
+
+    // the maturities fall both on and between the curve nodes
+    std::vector<Date> maturities;
+    for (Integer year=2009; year<=2019; ++year) {
+        maturities.push_back(Date(20, June, year));
+        maturities.push_back(Date(20, December, year));
+    }
+    std::vector<boost::shared_ptr<CreditDefaultSwap> > strip;
+    for (Size i=0; i<maturities.size(); ++i) {
+        strip.push_back(
+            MakeCreditDefaultSwap(maturities[i], 0.01)
+            .withNominal(10000000.)
+            .withPricingEngine(sharedEngine));
+    }
+
+    Real tolerance = 1.0e-8;
+
+    for (Size pass=0; pass<2; ++pass) {
+        for (Size i=0; i<strip.size(); ++i) {
+            boost::shared_ptr<CreditDefaultSwap> single =
+                MakeCreditDefaultSwap(maturities[i], 0.01)
+                .withNominal(10000000.)
+                .withPricingEngine(boost::make_shared<IsdaCdsEngine>(
+                                         probabilityCurve, recoveryRate,
+                                         discountCurve));
+
+            Real expected = single->NPV();
+            Real calculated = strip[i]->NPV();
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce NPV with shared engine:"
+                            << "\n    maturity:   " << maturities[i]
+                            << std::setprecision(10)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+
+            expected = single->defaultLegNPV();
+            calculated = strip[i]->defaultLegNPV();
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce default-leg NPV "
+                            "with shared engine:"
+                            << "\n    maturity:   " << maturities[i]
+                            << std::setprecision(10)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+
+        // the stored results must not survive a change of curve
+        for (Size i=0; i<hazardRates.size(); ++i)
+            hazardRates[i] *= 1.5;
+        probabilityCurve.linkTo(
+            boost::make_shared<InterpolatedHazardRateCurve<BackwardFlat> >(
+                               hazardDates, hazardRates, Actual365Fixed()));
+    }
+}
+
 test_suite* CreditDefaultSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Credit-default swap tests");
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testCachedValue));
@@ -723,5 +835,7 @@ test_suite* CreditDefaultSwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairUpfront));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testIsdaEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &CreditDefaultSwapTest::testIsdaEngineSharedByMaturities));
     return suite;
 }
@@ -119,8 +119,103 @@ void CreditRiskPlusTest::testReferenceValues() {
                    << cr.lossQuantile(0.99) << ", should be 250)");
 }
 
+void CreditRiskPlusTest::testFourierAndTruncation() {
+
+    BOOST_TEST_MESSAGE("Testing Fourier inversion and truncation of "
+                       "credit risk plus loss distribution...");
+
+    // heterogeneous portfolio on three sectors
+    const Size obligors = 3000;
+    std::vector<Real> exposure(obligors), pd(obligors);
+    std::vector<Size> sector(obligors);
+    for (Size i = 0; i < obligors; ++i) {
+        exposure[i] = 1.0 + 0.25 * (i % 37);
+        pd[i] = 0.005 + 0.001 * (i % 11);
+        sector[i] = i % 3;
+    }
+    std::vector<Real> relativeDefaultVariance(3);
+    relativeDefaultVariance[0] = 0.5;
+    relativeDefaultVariance[1] = 0.75;
+    relativeDefaultVariance[2] = 1.0;
+    Matrix rho(3, 3, 0.3);
+    for (Size i = 0; i < 3; ++i)
+        rho[i][i] = 1.0;
+    const Real unit = 0.25;
+
+    CreditRiskPlus recursion(exposure, pd, sector, relativeDefaultVariance,
+                             rho, unit);
+    CreditRiskPlus fourier(exposure, pd, sector, relativeDefaultVariance,
+                           rho, unit, CreditRiskPlus::Fourier);
+
+    const Size maxLossUnits = 4000;
+    CreditRiskPlus truncated(exposure, pd, sector, relativeDefaultVariance,
+                             rho, unit, CreditRiskPlus::Recursion,
+                             maxLossUnits);
+    CreditRiskPlus truncatedFourier(exposure, pd, sector,
+                                    relativeDefaultVariance, rho, unit,
+                                    CreditRiskPlus::Fourier, maxLossUnits);
+
+    const std::vector<Real>& expected = recursion.loss();
+    if (fourier.loss().size() != expected.size())
+        BOOST_FAIL("wrong size of Fourier loss distribution: "
+                   << fourier.loss().size() << " instead of "
+                   << expected.size());
+    if (truncated.loss().size() != maxLossUnits ||
+        truncatedFourier.loss().size() != maxLossUnits)
+        BOOST_FAIL("wrong size of truncated loss distributions: "
+                   << truncated.loss().size() << " and "
+                   << truncatedFourier.loss().size() << " instead of "
+                   << maxLossUnits);
+
+    const Real tol = 1.0e-12;
+    for (Size n = 0; n < expected.size(); ++n) {
+        if (std::fabs(fourier.loss()[n] - expected[n]) > tol)
+            BOOST_FAIL("failed to reproduce loss distribution with "
+                       "Fourier inversion at " << n << " units:"
+                       << std::scientific
+                       << "\n    recursion: " << expected[n]
+                       << "\n    Fourier:   " << fourier.loss()[n]);
+        if (n < maxLossUnits) {
+            if (truncated.loss()[n] != expected[n])
+                BOOST_FAIL("truncated loss distribution differs at "
+                           << n << " units:" << std::scientific
+                           << "\n    full:      " << expected[n]
+                           << "\n    truncated: " << truncated.loss()[n]);
+            if (std::fabs(truncatedFourier.loss()[n] - expected[n]) > tol)
+                BOOST_FAIL("truncated Fourier loss distribution differs at "
+                           << n << " units:" << std::scientific
+                           << "\n    full:      " << expected[n]
+                           << "\n    truncated: "
+                           << truncatedFourier.loss()[n]);
+        }
+    }
+
+    Real p[] = { 0.9, 0.99, 0.999 };
+    for (Size i = 0; i < LENGTH(p); ++i) {
+        Real q = recursion.lossQuantile(p[i]);
+        CreditRiskPlus* models[] = { &fourier, &truncated, &truncatedFourier };
+        for (Size j = 0; j < LENGTH(models); ++j) {
+            Real calculated = models[j]->lossQuantile(p[i]);
+            if (std::fabs(calculated - q) > 1.0e-7 * q)
+                BOOST_FAIL("failed to reproduce " << p[i] << " quantile "
+                           "with model #" << j << ":"
+                           << "\n    expected:   " << q
+                           << "\n    calculated: " << calculated);
+        }
+    }
+
+    // marginal contributions don't depend on the method
+    for (Size k = 0; k < obligors; ++k) {
+        if (fourier.marginalLoss()[k] != recursion.marginalLoss()[k] ||
+            truncated.marginalLoss()[k] != recursion.marginalLoss()[k])
+            BOOST_FAIL("marginal loss of obligor " << k << " differs");
+    }
+}
+
 test_suite *CreditRiskPlusTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("Credit risk plus tests");
     suite->add(QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testReferenceValues));
+    suite->add(
+        QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testFourierAndTruncation));
     return suite;
 }
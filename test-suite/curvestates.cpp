@@ -33,6 +33,7 @@
 #include <ql/time/schedule.hpp>
 #include <ql/time/daycounters/simpledaycounter.hpp>
 #include <sstream>
+#include <iomanip>
 
 #if defined(BOOST_MSVC)
 #include <float.h>
@@ -121,6 +122,77 @@ namespace {
         }
     };
 
+    // cm swap rate calculated from scratch on the given discounts
+    Rate cmSwapRate(const std::vector<DiscountFactor>& discounts,
+                    const std::vector<Real>& accruals,
+                    Size i, Size spanningForwards) {
+        Size last = std::min(i+spanningForwards, accruals.size());
+        Real annuity = 0.0;
+        for (Size j=i; j<last; ++j)
+            annuity += accruals[j]*discounts[j+1];
+        return (discounts[i]-discounts[last])/annuity;
+    }
+
+    std::vector<DiscountFactor> discountsFromForwards(
+                                         const std::vector<Rate>& forwards,
+                                         const std::vector<Real>& accruals) {
+        std::vector<DiscountFactor> discounts(forwards.size()+1, 1.0);
+        for (Size i=0; i<forwards.size(); ++i)
+            discounts[i+1] = discounts[i]/(1.0+forwards[i]*accruals[i]);
+        return discounts;
+    }
+
+    void checkCurveState(const CurveState& cs,
+                         const std::vector<Rate>& forwards,
+                         const std::vector<Real>& accruals,
+                         Size first,
+                         const std::string& description) {
+        const Real tolerance = 1.0e-12;
+        Size n = forwards.size();
+        std::vector<DiscountFactor> discounts =
+            discountsFromForwards(forwards, accruals);
+
+        // cm swap rates are cached by spanning forwards; the spans
+        // are alternated to check that the cache is refreshed
+        Size spans[] = { 1, 3, 1, 2, n, 3 };
+        for (Size k=0; k<LENGTH(spans); ++k) {
+            for (Size i=first; i<n; ++i) {
+                Rate expected = cmSwapRate(discounts, accruals, i, spans[k]);
+                Rate calculated = (k % 2 == 0 ?
+                                   cs.cmSwapRate(i, spans[k]) :
+                                   cs.cmSwapRates(spans[k])[i]);
+                if (std::fabs(calculated-expected) > tolerance)
+                    BOOST_ERROR(description << ": "
+                                << io::ordinal(i+1) << " cm swap rate "
+                                << "spanning " << spans[k] << " forwards"
+                                << std::setprecision(12)
+                                << "\n    calculated: " << calculated
+                                << "\n    expected:   " << expected);
+            }
+        }
+
+        for (Size i=first; i<n; ++i) {
+            Rate expected = cmSwapRate(discounts, accruals, i, n);
+            Rate calculated1 = cs.coterminalSwapRate(i);
+            Rate calculated2 = cs.coterminalSwapRates()[i];
+            if (std::fabs(calculated1-expected) > tolerance ||
+                std::fabs(calculated2-expected) > tolerance)
+                BOOST_ERROR(description << ": "
+                            << io::ordinal(i+1) << " coterminal swap rate"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated1
+                            << ", " << calculated2
+                            << "\n    expected:   " << expected);
+            Rate forward = cs.forwardRate(i);
+            if (std::fabs(forward-forwards[i]) > tolerance)
+                BOOST_ERROR(description << ": "
+                            << io::ordinal(i+1) << " forward rate"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << forward
+                            << "\n    expected:   " << forwards[i]);
+        }
+    }
+
 }
 
 
@@ -129,6 +201,26 @@ void CurveStatesTest::testLMMCurveState() {
     BOOST_TEST_MESSAGE("Testing Libor-market-model curve state...");
 
     CommonVars vars;
+
+    LMMCurveState cs(vars.rateTimes);
+    cs.setOnForwardRates(vars.todaysForwards);
+    checkCurveState(cs, vars.todaysForwards, vars.accruals, 0,
+                    "initial state");
+
+    // the cached quantities must be refreshed when the state changes
+    std::vector<Rate> forwards(vars.todaysForwards);
+    for (Size i=0; i<forwards.size(); ++i)
+        forwards[i] += 0.002*i;
+    Size first = 3;
+    cs.setOnForwardRates(forwards, first);
+    checkCurveState(cs, forwards, vars.accruals, first,
+                    "state set on forward rates");
+
+    std::vector<DiscountFactor> discounts =
+        discountsFromForwards(vars.todaysForwards, vars.accruals);
+    cs.setOnDiscountRatios(discounts, first);
+    checkCurveState(cs, vars.todaysForwards, vars.accruals, first,
+                    "state set on discount ratios");
 }
 
 void CurveStatesTest::testCoterminalSwapCurveState() {
@@ -136,6 +228,22 @@ void CurveStatesTest::testCoterminalSwapCurveState() {
     BOOST_TEST_MESSAGE("Testing coterminal-swap-market-model curve state...");
 
     CommonVars vars;
+
+    CoterminalSwapCurveState cs(vars.rateTimes);
+    cs.setOnCoterminalSwapRates(vars.todaysCoterminalSwapRates);
+    checkCurveState(cs, vars.todaysForwards, vars.accruals, 0,
+                    "initial state");
+
+    // the cached quantities must be refreshed when the state changes
+    std::vector<Rate> forwards(vars.todaysForwards);
+    for (Size i=0; i<forwards.size(); ++i)
+        forwards[i] += 0.002*i;
+    LMMCurveState lmm(vars.rateTimes);
+    lmm.setOnForwardRates(forwards);
+    Size first = 3;
+    cs.setOnCoterminalSwapRates(lmm.coterminalSwapRates(), first);
+    checkCurveState(cs, forwards, vars.accruals, first,
+                    "state set on coterminal swap rates");
 }
 
 
@@ -203,8 +311,8 @@ void CurveStatesTest::testCMSwapCurveState() {
 // --- Call the desired tests
 test_suite* CurveStatesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Curve States tests");
-    //suite->add(QUANTLIB_TEST_CASE(&CurveStatesTest::testLMMCurveState));
-    //suite->add(QUANTLIB_TEST_CASE(&CurveStatesTest::testCoterminalSwapCurveState));
+    suite->add(QUANTLIB_TEST_CASE(&CurveStatesTest::testLMMCurveState));
+    suite->add(QUANTLIB_TEST_CASE(&CurveStatesTest::testCoterminalSwapCurveState));
     suite->add(QUANTLIB_TEST_CASE(&CurveStatesTest::testCMSwapCurveState));
     return suite;
 }
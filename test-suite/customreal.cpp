@@ -0,0 +1,146 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/* This file checks that the headers below can be compiled with a
+   class type as Real, as done by automatic-differentiation tools.
+   It is only compiled, not linked: the library and the test suite
+   use the built-in type, and running the code below would require a
+   build of the library using the class type. */
+
+#include <cmath>
+#include <limits>
+#include <ostream>
+
+// a minimal class wrapping a double; as the active types of most AD
+// tools, it doesn't convert implicitly back to double
+class CustomReal {
+  public:
+    CustomReal() : x_(0.0) {}
+    CustomReal(double x) : x_(x) {}
+    double value() const { return x_; }
+    CustomReal operator-() const { return CustomReal(-x_); }
+    CustomReal& operator+=(const CustomReal& y) { x_ += y.x_; return *this; }
+    CustomReal& operator-=(const CustomReal& y) { x_ -= y.x_; return *this; }
+    CustomReal& operator*=(const CustomReal& y) { x_ *= y.x_; return *this; }
+    CustomReal& operator/=(const CustomReal& y) { x_ /= y.x_; return *this; }
+  private:
+    double x_;
+};
+
+inline CustomReal operator+(CustomReal x, const CustomReal& y) {
+    return x += y;
+}
+inline CustomReal operator-(CustomReal x, const CustomReal& y) {
+    return x -= y;
+}
+inline CustomReal operator*(CustomReal x, const CustomReal& y) {
+    return x *= y;
+}
+inline CustomReal operator/(CustomReal x, const CustomReal& y) {
+    return x /= y;
+}
+inline bool operator==(const CustomReal& x, const CustomReal& y) {
+    return x.value() == y.value();
+}
+inline bool operator!=(const CustomReal& x, const CustomReal& y) {
+    return x.value() != y.value();
+}
+inline bool operator<(const CustomReal& x, const CustomReal& y) {
+    return x.value() < y.value();
+}
+inline bool operator<=(const CustomReal& x, const CustomReal& y) {
+    return x.value() <= y.value();
+}
+inline bool operator>(const CustomReal& x, const CustomReal& y) {
+    return x.value() > y.value();
+}
+inline bool operator>=(const CustomReal& x, const CustomReal& y) {
+    return x.value() >= y.value();
+}
+inline std::ostream& operator<<(std::ostream& out, const CustomReal& x) {
+    return out << x.value();
+}
+
+// AD tools provide the math functions and limits in namespace std
+namespace std {
+
+    inline CustomReal fabs(CustomReal x) {
+        return CustomReal(std::fabs(x.value()));
+    }
+    inline CustomReal abs(CustomReal x) {
+        return CustomReal(std::fabs(x.value()));
+    }
+    inline CustomReal sqrt(CustomReal x) {
+        return CustomReal(std::sqrt(x.value()));
+    }
+    inline CustomReal exp(CustomReal x) {
+        return CustomReal(std::exp(x.value()));
+    }
+    inline CustomReal log(CustomReal x) {
+        return CustomReal(std::log(x.value()));
+    }
+    inline CustomReal pow(CustomReal x, CustomReal y) {
+        return CustomReal(std::pow(x.value(), y.value()));
+    }
+
+    template <>
+    class numeric_limits<CustomReal> : public numeric_limits<double> {
+      public:
+        static CustomReal min() { return numeric_limits<double>::min(); }
+        static CustomReal max() { return numeric_limits<double>::max(); }
+        static CustomReal epsilon() {
+            return numeric_limits<double>::epsilon();
+        }
+    };
+
+}
+
+#define QL_REAL CustomReal
+
+#include <ql/utilities/null.hpp>
+#include <ql/math/interpolations/kernelinterpolation.hpp>
+#include <ql/math/kernelfunctions.hpp>
+#include <vector>
+
+using namespace QuantLib;
+
+namespace {
+
+    // Null<Real> must convert to the floating-point null value
+    bool isNull(Real x) {
+        return x == Null<Real>();
+    }
+
+    Real kernelInterpolation(const std::vector<Real>& x,
+                             const std::vector<Real>& y,
+                             Real z) {
+        GaussianKernel kernel(0.0, 1.0);
+        // would not compile if the epsilon were still a double
+        Real epsilon = 1.0e-7;
+        KernelInterpolation f(x.begin(), x.end(), y.begin(), kernel,
+                              epsilon);
+        return isNull(z) ? f(x.front()) : f(z);
+    }
+
+}
+
+// not meant to be called; its instantiations are the check
+Real customRealCheck(const std::vector<Real>& x,
+                     const std::vector<Real>& y,
+                     Real z) {
+    return kernelInterpolation(x, y, z);
+}
@@ -326,6 +326,47 @@ void DateTest::testConsistency() {
 
 }
 
+void DateTest::bulkConversions() {
+    BOOST_TEST_MESSAGE("Testing bulk date conversions...");
+
+    std::vector<Date> dates;
+    Date::serial_type minDate = Date::minDate().serialNumber(),
+                      maxDate = Date::maxDate().serialNumber();
+    for (Date::serial_type i=minDate; i<maxDate; i+=17)
+        dates.push_back(Date(i));
+    dates.push_back(Date(maxDate));
+
+    std::vector<Day> days;
+    std::vector<Month> months;
+    std::vector<Year> years;
+    Date::dayMonthYear(dates, days, months, years);
+    if (days.size() != dates.size() || months.size() != dates.size()
+        || years.size() != dates.size())
+        BOOST_FAIL("wrong number of decomposed dates");
+
+    for (Size i=0; i<dates.size(); ++i) {
+        if (days[i] != dates[i].dayOfMonth() ||
+            months[i] != dates[i].month() ||
+            years[i] != dates[i].year())
+            BOOST_FAIL("inconsistent decomposition:\n"
+                       << "    date:  " << dates[i] << "\n"
+                       << "    day:   " << days[i] << "\n"
+                       << "    month: " << months[i] << "\n"
+                       << "    year:  " << years[i]);
+    }
+
+    std::vector<Date> rebuilt = Date::fromDayMonthYear(days, months, years);
+    if (rebuilt != dates)
+        BOOST_FAIL("dates not reproduced by bulk construction");
+
+    // invalid dates are rejected
+    days[0] = 30;
+    months[0] = February;
+    BOOST_CHECK_THROW(Date::fromDayMonthYear(days, months, years), Error);
+    days.pop_back();
+    BOOST_CHECK_THROW(Date::fromDayMonthYear(days, months, years), Error);
+}
+
 void DateTest::isoDates() {
     BOOST_TEST_MESSAGE("Testing ISO dates...");
     std::string input_date("2006-01-15");
@@ -437,6 +478,7 @@ test_suite* DateTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Date tests");
 
     suite->add(QUANTLIB_TEST_CASE(&DateTest::testConsistency));
+    suite->add(QUANTLIB_TEST_CASE(&DateTest::bulkConversions));
     suite->add(QUANTLIB_TEST_CASE(&DateTest::ecbDates));
     suite->add(QUANTLIB_TEST_CASE(&DateTest::immDates));
     suite->add(QUANTLIB_TEST_CASE(&DateTest::isoDates));
@@ -29,6 +29,7 @@
 class DateTest {
   public:
     static void testConsistency();
+    static void bulkConversions();
     static void ecbDates();
     static void immDates();
     static void asxDates();
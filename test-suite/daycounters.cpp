@@ -538,6 +538,42 @@ void DayCounterTest::testIntraday() {
 #endif
 }
 
+void DayCounterTest::testBatchedYearFractions() {
+
+    BOOST_TEST_MESSAGE("Testing batched year fractions...");
+
+    DayCounter dayCounters[] = { Actual360(), Actual360(true),
+                                 Actual365Fixed(),
+                                 Actual365Fixed(Actual365Fixed::NoLeap),
+                                 Thirty360(Thirty360::USA),
+                                 Thirty360(Thirty360::European),
+                                 Thirty360(Thirty360::Italian),
+                                 ActualActual(ActualActual::ISDA),
+                                 SimpleDayCounter(), OneDayCounter() };
+
+    std::vector<Date> d1, d2;
+    Date start(28, January, 2002);
+    for (Integer i=0; i<200; ++i) {
+        d1.push_back(start + i*7);
+        d2.push_back(d1.back() + (i%13)*Months + (i%31)*Days);
+    }
+
+    std::vector<Time> times(d1.size());
+    for (Size i=0; i<LENGTH(dayCounters); ++i) {
+        DayCounter dc = dayCounters[i];
+        dc.yearFractions(&d1[0], &d2[0], &times[0], d1.size());
+        for (Size j=0; j<d1.size(); ++j) {
+            Time expected = dc.yearFraction(d1[j], d2[j]);
+            if (times[j] != expected)
+                BOOST_FAIL(dc.name() << ": year fraction between "
+                           << d1[j] << " and " << d2[j] << ":\n"
+                           << std::setprecision(12)
+                           << "    batched:  " << times[j] << "\n"
+                           << "    expected: " << expected);
+        }
+    }
+}
+
 
 test_suite* DayCounterTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Day counter tests");
@@ -548,6 +584,7 @@ test_suite* DayCounterTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBusiness252));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testThirty360_BondBasis));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testThirty360_EurobondBasis));
+    suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBatchedYearFractions));
 
 #ifdef QL_HIGH_RESOLUTION_DATE
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testIntraday));
@@ -35,6 +35,7 @@ class DayCounterTest {
     static void testThirty360_BondBasis();
     static void testThirty360_EurobondBasis();
     static void testIntraday();
+    static void testBatchedYearFractions();
     static boost::unit_test_framework::test_suite* suite();
 };
 
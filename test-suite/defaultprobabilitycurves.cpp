@@ -24,10 +24,14 @@
 #include <ql/termstructures/credit/defaultprobabilityhelpers.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/termstructures/bootstrapscheduler.hpp>
 #include <ql/instruments/creditdefaultswap.hpp>
 #include <ql/pricingengines/credit/midpointcdsengine.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/math/interpolations/loginterpolation.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
@@ -139,7 +143,7 @@ void DefaultProbabilityCurveTest::testFlatHazardRate() {
 
 namespace {
 
-    template <class T, class I>
+    template <class T, class I, template <class> class B>
     void testBootstrapFromSpread() {
 
         Calendar calendar = TARGET();
@@ -184,8 +188,8 @@ namespace {
         RelinkableHandle<DefaultProbabilityTermStructure> piecewiseCurve;
         piecewiseCurve.linkTo(
             boost::shared_ptr<DefaultProbabilityTermStructure>(
-                new PiecewiseDefaultCurve<T,I>(today, helpers,
-                                               Thirty360())));
+                new PiecewiseDefaultCurve<T,I,B>(today, helpers,
+                                                 Thirty360())));
 
         Real notional = 1.0;
         double tolerance = 1.0e-6;
@@ -324,28 +328,35 @@ namespace {
 
 void DefaultProbabilityCurveTest::testFlatHazardConsistency() {
     BOOST_TEST_MESSAGE("Testing piecewise-flat hazard-rate consistency...");
-    testBootstrapFromSpread<HazardRate,BackwardFlat>();
+    testBootstrapFromSpread<HazardRate,BackwardFlat,IterativeBootstrap>();
     testBootstrapFromUpfront<HazardRate,BackwardFlat>();
 }
 
 void DefaultProbabilityCurveTest::testFlatDensityConsistency() {
     BOOST_TEST_MESSAGE("Testing piecewise-flat default-density consistency...");
-    testBootstrapFromSpread<DefaultDensity,BackwardFlat>();
+    testBootstrapFromSpread<DefaultDensity,BackwardFlat,IterativeBootstrap>();
     testBootstrapFromUpfront<DefaultDensity,BackwardFlat>();
 }
 
 void DefaultProbabilityCurveTest::testLinearDensityConsistency() {
     BOOST_TEST_MESSAGE("Testing piecewise-linear default-density consistency...");
-    testBootstrapFromSpread<DefaultDensity,Linear>();
+    testBootstrapFromSpread<DefaultDensity,Linear,IterativeBootstrap>();
     testBootstrapFromUpfront<DefaultDensity,Linear>();
 }
 
 void DefaultProbabilityCurveTest::testLogLinearSurvivalConsistency() {
     BOOST_TEST_MESSAGE("Testing log-linear survival-probability consistency...");
-    testBootstrapFromSpread<SurvivalProbability,LogLinear>();
+    testBootstrapFromSpread<SurvivalProbability,LogLinear,IterativeBootstrap>();
     testBootstrapFromUpfront<SurvivalProbability,LogLinear>();
 }
 
+void DefaultProbabilityCurveTest::testGlobalBootstrapConsistency() {
+    BOOST_TEST_MESSAGE("Testing consistency of global-bootstrap algorithm "
+                       "on default curves...");
+    testBootstrapFromSpread<HazardRate,Cubic,GlobalBootstrap>();
+    testBootstrapFromSpread<SurvivalProbability,LogLinear,GlobalBootstrap>();
+}
+
 void DefaultProbabilityCurveTest::testSingleInstrumentBootstrap() {
     BOOST_TEST_MESSAGE("Testing single-instrument curve bootstrap...");
 
@@ -397,6 +408,197 @@ void DefaultProbabilityCurveTest::testUpfrontBootstrap() {
         BOOST_ERROR("Cash-flow settings improperly modified");
 }
 
+namespace {
+
+    class CountingSpreadCdsHelper : public SpreadCdsHelper {
+      public:
+        CountingSpreadCdsHelper(const Handle<Quote>& spread,
+                                const Period& tenor,
+                                const Handle<YieldTermStructure>& discount)
+        : SpreadCdsHelper(spread, tenor, 1, TARGET(), Quarterly, Following,
+                          DateGeneration::TwentiethIMM, Thirty360(), 0.4,
+                          discount),
+          calls_(0) {}
+        Real impliedQuote() const {
+            ++calls_;
+            return SpreadCdsHelper::impliedQuote();
+        }
+        Size calls() const { return calls_; }
+        void reset() { calls_ = 0; }
+      private:
+        mutable Size calls_;
+    };
+
+    struct CdsCurve {
+        std::vector<boost::shared_ptr<SimpleQuote> > spreads;
+        std::vector<boost::shared_ptr<CountingSpreadCdsHelper> > helpers;
+        boost::shared_ptr<PiecewiseDefaultCurve<HazardRate,BackwardFlat> >
+                                                                       curve;
+
+        CdsCurve(const Date& today, Rate firstSpread,
+                 const Handle<YieldTermStructure>& discountCurve) {
+            Integer n[] = { 1, 2, 3, 5, 7, 10 };
+            std::vector<boost::shared_ptr<DefaultProbabilityHelper> >
+                                                                 instruments;
+            for (Size i=0; i<LENGTH(n); ++i) {
+                spreads.push_back(boost::shared_ptr<SimpleQuote>(
+                                new SimpleQuote(firstSpread + i*0.0005)));
+                helpers.push_back(
+                    boost::shared_ptr<CountingSpreadCdsHelper>(
+                        new CountingSpreadCdsHelper(
+                                         Handle<Quote>(spreads.back()),
+                                         n[i]*Years, discountCurve)));
+                instruments.push_back(helpers.back());
+            }
+            curve = boost::shared_ptr<
+                PiecewiseDefaultCurve<HazardRate,BackwardFlat> >(
+                    new PiecewiseDefaultCurve<HazardRate,BackwardFlat>(
+                                           today, instruments, Thirty360()));
+        }
+
+        void resetCalls() {
+            for (Size i=0; i<helpers.size(); ++i)
+                helpers[i]->reset();
+        }
+
+        Real maxQuoteError() const {
+            Real error = 0.0;
+            for (Size i=0; i<helpers.size(); ++i)
+                error = std::max(error, std::fabs(helpers[i]->quoteError()));
+            return error;
+        }
+    };
+
+}
+
+void DefaultProbabilityCurveTest::testIncrementalBootstrap() {
+    BOOST_TEST_MESSAGE("Testing incremental bootstrap "
+                       "after a single CDS quote change...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> discountCurve(
+        boost::shared_ptr<YieldTermStructure>(
+                                    new FlatForward(today,0.06,Actual360())));
+
+    CdsCurve cds(today, 0.005, discountCurve);
+    cds.curve->recalculate();
+
+    Real tolerance = 1.0e-9;
+
+    // a change in the last quote doesn't affect the previous pillars
+    cds.resetCalls();
+    cds.spreads.back()->setValue(cds.spreads.back()->value() + 0.001);
+    cds.curve->survivalProbability(1.0);
+
+    for (Size i=0; i<cds.helpers.size()-1; ++i) {
+        if (cds.helpers[i]->calls() != 0)
+            BOOST_ERROR(io::ordinal(i+1) << " helper re-bootstrapped "
+                        "after a change in the last quote");
+    }
+    if (cds.helpers.back()->calls() == 0)
+        BOOST_ERROR("last helper not re-bootstrapped after a change "
+                    "in its quote");
+    Real error = cds.maxQuoteError();
+    if (error > tolerance)
+        BOOST_ERROR("helpers not repriced after a change in the last quote:"
+                    << "\n    quote error: " << error
+                    << "\n    tolerance:   " << tolerance);
+
+    // a change in the discount curve affects the whole curve
+    boost::shared_ptr<SimpleQuote> rate(new SimpleQuote(0.06));
+    boost::shared_ptr<FlatForward> flatCurve(
+        new FlatForward(today, Handle<Quote>(rate), Actual360()));
+    CdsCurve cds2(today, 0.005, Handle<YieldTermStructure>(flatCurve));
+    cds2.curve->recalculate();
+    cds2.resetCalls();
+    rate->setValue(0.05);
+    cds2.curve->survivalProbability(1.0);
+
+    for (Size i=0; i<cds2.helpers.size(); ++i) {
+        if (cds2.helpers[i]->calls() == 0)
+            BOOST_ERROR(io::ordinal(i+1) << " helper not re-bootstrapped "
+                        "after a change in the discount curve");
+    }
+    error = cds2.maxQuoteError();
+    if (error > tolerance)
+        BOOST_ERROR("helpers not repriced after a change "
+                    "in the discount curve:"
+                    << "\n    quote error: " << error
+                    << "\n    tolerance:   " << tolerance);
+}
+
+void DefaultProbabilityCurveTest::testScheduledBootstrap() {
+    BOOST_TEST_MESSAGE("Testing scheduled bootstrap of default curves "
+                       "sharing a discount curve...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+
+    std::vector<boost::shared_ptr<RateHelper> > deposits;
+    Integer n[] = { 1, 3, 6, 12 };
+    for (Size i=0; i<LENGTH(n); ++i) {
+        deposits.push_back(boost::shared_ptr<RateHelper>(
+            new DepositRateHelper(Handle<Quote>(boost::shared_ptr<Quote>(
+                                        new SimpleQuote(0.02 + i*0.002))),
+                                  n[i]*Months, 2, TARGET(), ModifiedFollowing,
+                                  false, Actual360())));
+    }
+    boost::shared_ptr<PiecewiseYieldCurve<Discount,LogLinear> > yieldCurve(
+        new PiecewiseYieldCurve<Discount,LogLinear>(today, deposits,
+                                                    Actual360()));
+    yieldCurve->enableExtrapolation();
+    Handle<YieldTermStructure> discountCurve(yieldCurve);
+
+    std::vector<boost::shared_ptr<CdsCurve> > names;
+    for (Size i=0; i<8; ++i)
+        names.push_back(boost::shared_ptr<CdsCurve>(
+                         new CdsCurve(today, 0.004 + i*0.001, discountCurve)));
+
+    BootstrapScheduler scheduler;
+    Size discount = scheduler.add(yieldCurve);
+    for (Size i=0; i<names.size(); ++i)
+        scheduler.add(names[i]->curve);
+    scheduler.build();
+
+    for (Size i=0; i<names.size(); ++i) {
+        if (scheduler.dependencies(i+1) != std::vector<Size>(1, discount))
+            BOOST_ERROR("dependency of " << io::ordinal(i+1)
+                        << " default curve on discount curve not detected");
+    }
+
+    Real tolerance = 1.0e-9;
+
+    // a tick on a single name only rebuilds its curve
+    for (Size i=0; i<names.size(); ++i)
+        names[i]->resetCalls();
+    boost::shared_ptr<SimpleQuote> spread = names[3]->spreads[4];
+    spread->setValue(spread->value() + 0.0005);
+    scheduler.build();
+
+    for (Size i=0; i<names.size(); ++i) {
+        for (Size j=0; j<names[i]->helpers.size(); ++j) {
+            bool rebuilt = names[i]->helpers[j]->calls() != 0;
+            bool expected = (i == 3 && j >= 4);
+            if (rebuilt != expected)
+                BOOST_ERROR(io::ordinal(j+1) << " helper of "
+                            << io::ordinal(i+1) << " default curve "
+                            << (rebuilt ? "" : "not ")
+                            << "re-bootstrapped after a change in the "
+                            "5th quote of the 4th curve");
+        }
+    }
+    for (Size i=0; i<names.size(); ++i) {
+        Real error = names[i]->maxQuoteError();
+        if (error > tolerance)
+            BOOST_ERROR(io::ordinal(i+1) << " default curve not repriced:"
+                        << "\n    quote error: " << error
+                        << "\n    tolerance:   " << tolerance);
+    }
+}
+
 
 test_suite* DefaultProbabilityCurveTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Default-probability curve tests");
@@ -412,9 +614,15 @@ test_suite* DefaultProbabilityCurveTest::suite() {
                  &DefaultProbabilityCurveTest::testLinearDensityConsistency));
     suite->add(QUANTLIB_TEST_CASE(
              &DefaultProbabilityCurveTest::testLogLinearSurvivalConsistency));
+    suite->add(QUANTLIB_TEST_CASE(
+               &DefaultProbabilityCurveTest::testGlobalBootstrapConsistency));
     suite->add(QUANTLIB_TEST_CASE(
                 &DefaultProbabilityCurveTest::testSingleInstrumentBootstrap));
     suite->add(QUANTLIB_TEST_CASE(
                          &DefaultProbabilityCurveTest::testUpfrontBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                     &DefaultProbabilityCurveTest::testIncrementalBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                       &DefaultProbabilityCurveTest::testScheduledBootstrap));
     return suite;
 }
@@ -34,8 +34,11 @@ class DefaultProbabilityCurveTest {
     static void testFlatDensityConsistency();
     static void testLinearDensityConsistency();
     static void testLogLinearSurvivalConsistency();
+    static void testGlobalBootstrapConsistency();
     static void testSingleInstrumentBootstrap();
     static void testUpfrontBootstrap();
+    static void testIncrementalBootstrap();
+    static void testScheduledBootstrap();
     static boost::unit_test_framework::test_suite* suite();
 };
 
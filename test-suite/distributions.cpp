@@ -30,6 +30,8 @@
 #include <ql/math/distributions/chisquaredistribution.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
 #include <ql/math/randomnumbers/stochasticcollocationinvcdf.hpp>
+#include <ql/math/randomnumbers/inversecumulativersg.hpp>
+#include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/math/functional.hpp>
 
@@ -710,6 +712,124 @@ void DistributionTest::testInvCDFviaStochasticCollocation() {
     }
 }
 
+void DistributionTest::testInverseCumulativeNormalSequence() {
+    BOOST_TEST_MESSAGE(
+        "Testing sequence evaluation of inverse cumulative normal...");
+
+    const InverseCumulativeNormal icn(average, sigma);
+
+    // the central region and both tails
+    std::vector<Real> x;
+    for (Real u=1.0e-8; u<1.0; u*=1.5)
+        x.push_back(u);
+    for (Real u=0.001; u<1.0; u+=0.001)
+        x.push_back(u);
+    for (Real u=1.0e-8; u<1.0; u*=1.5)
+        x.push_back(1.0-u);
+
+    std::vector<Real> calculated(x.size());
+    icn.transform(x.begin(), x.end(), calculated.begin());
+    for (Size i=0; i<x.size(); ++i) {
+        Real expected = icn(x[i]);
+        if (calculated[i] != expected)
+            BOOST_FAIL("sequence and scalar evaluation differ"
+                       << std::setprecision(16)
+                       << "\n    x:          " << x[i]
+                       << "\n    sequence:   " << calculated[i]
+                       << "\n    scalar:     " << expected);
+    }
+
+    // the generator should dispatch to the sequence evaluation
+    const Size dimension = 50;
+    InverseCumulativeRsg<SobolRsg, InverseCumulativeNormal>
+        rsg(SobolRsg(dimension, 42), icn);
+    SobolRsg usg(dimension, 42);
+    for (Size k=0; k<100; ++k) {
+        const std::vector<Real>& values = rsg.nextSequence().value;
+        const std::vector<Real>& uniforms = usg.nextSequence().value;
+        for (Size i=0; i<dimension; ++i) {
+            if (values[i] != icn(uniforms[i]))
+                BOOST_FAIL("inverse cumulative generator and scalar "
+                           "evaluation differ"
+                           << std::setprecision(16)
+                           << "\n    sample:     " << k
+                           << "\n    dimension:  " << i
+                           << "\n    generator:  " << values[i]
+                           << "\n    scalar:     " << icn(uniforms[i]));
+        }
+    }
+}
+
+void DistributionTest::testNormalBatch() {
+    BOOST_TEST_MESSAGE(
+        "Testing batch evaluation of univariate and bivariate normal...");
+
+    const CumulativeNormalDistribution cn(average, sigma);
+
+    std::vector<Real> x;
+    for (Real z=-37.0; z<=37.0; z+=0.0185)
+        x.push_back(average + z*sigma);
+
+    std::vector<Real> calculated(x.size());
+    cn(&x[0], &calculated[0], x.size());
+    for (Size i=0; i<x.size(); ++i) {
+        Real expected = cn(x[i]);
+        if (std::fabs(calculated[i] - expected) > 1.0e-15)
+            BOOST_FAIL("batch and scalar evaluation of cumulative "
+                       "normal differ"
+                       << std::setprecision(16)
+                       << "\n    x:          " << x[i]
+                       << "\n    batch:      " << calculated[i]
+                       << "\n    scalar:     " << expected);
+    }
+
+    std::vector<Real> a, b;
+    for (Integer i=-20; i<=20; ++i) {
+        for (Integer j=-20; j<=20; ++j) {
+            a.push_back(0.3*i);
+            b.push_back(0.3*j);
+        }
+    }
+    std::vector<Real> bivariate(a.size());
+
+    const Real rhos[] = { -1.0, -0.999, -0.95, -0.8, -0.5, -0.1, 0.0,
+                          0.2, 0.6, 0.9, 0.95, 0.999, 1.0 };
+    for (Size k=0; k<LENGTH(rhos); ++k) {
+        BivariateCumulativeNormalDistributionWe04DP we04(rhos[k]);
+        we04(&a[0], &b[0], &bivariate[0], a.size());
+        for (Size i=0; i<a.size(); ++i) {
+            Real expected = we04(a[i], b[i]);
+            if (std::fabs(bivariate[i] - expected) > 1.0e-15)
+                BOOST_FAIL("batch and scalar evaluation of bivariate "
+                           "cumulative normal (We04DP) differ"
+                           << std::setprecision(16)
+                           << "\n    rho:        " << rhos[k]
+                           << "\n    a:          " << a[i]
+                           << "\n    b:          " << b[i]
+                           << "\n    batch:      " << bivariate[i]
+                           << "\n    scalar:     " << expected);
+        }
+
+        if (std::fabs(rhos[k]) == 1.0)
+            continue;
+
+        BivariateCumulativeNormalDistributionDr78 dr78(rhos[k]);
+        dr78(&a[0], &b[0], &bivariate[0], a.size());
+        for (Size i=0; i<a.size(); ++i) {
+            Real expected = dr78(a[i], b[i]);
+            if (bivariate[i] != expected)
+                BOOST_FAIL("batch and scalar evaluation of bivariate "
+                           "cumulative normal (Dr78) differ"
+                           << std::setprecision(16)
+                           << "\n    rho:        " << rhos[k]
+                           << "\n    a:          " << a[i]
+                           << "\n    b:          " << b[i]
+                           << "\n    batch:      " << bivariate[i]
+                           << "\n    scalar:     " << expected);
+        }
+    }
+}
+
 test_suite* DistributionTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Distribution tests");
 
@@ -723,6 +843,9 @@ test_suite* DistributionTest::suite(SpeedLevel speed) {
                           &DistributionTest::testBivariateCumulativeStudent));
     suite->add(QUANTLIB_TEST_CASE(
                    &DistributionTest::testInvCDFviaStochasticCollocation));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &DistributionTest::testInverseCumulativeNormalSequence));
+    suite->add(QUANTLIB_TEST_CASE(&DistributionTest::testNormalBatch));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -38,6 +38,8 @@ class DistributionTest {
     static void testBivariateCumulativeStudent();
     static void testBivariateCumulativeStudentVsBivariate();
     static void testInvCDFviaStochasticCollocation();
+    static void testInverseCumulativeNormalSequence();
+    static void testNormalBatch();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -30,16 +30,21 @@
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/binomialengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/fddupirevanillaengine.hpp>
 #include <ql/experimental/variancegamma/fftvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/integralengine.hpp>
+#include <ql/pricingengines/gridcalibrator.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
+#include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/fixedlocalvolsurface.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <boost/progress.hpp>
+#include <boost/bind.hpp>
 #include <map>
 
 using namespace QuantLib;
@@ -1250,6 +1255,300 @@ void EuropeanOptionTest::testMcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testMcEngineWorkers() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo European engine "
+                       "with several workers...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Call, 105.0));
+    boost::shared_ptr<Exercise> exercise(
+                                 new EuropeanExercise(today + Period(1, Years)));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new AnalyticEuropeanEngine(process)));
+    Real expected = option.NPV();
+
+    // a single worker must reproduce the serial engine
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(10000)
+                            .withSeed(42));
+    Real serial = option.NPV();
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(10000)
+                            .withSeed(42)
+                            .withWorkers(1));
+    Real calculated = option.NPV();
+    if (calculated != serial)
+        BOOST_ERROR("failed to reproduce serial Monte Carlo result"
+                    << "\n    serial:     " << serial
+                    << "\n    calculated: " << calculated);
+
+    // results must be reproducible for a given seed and number of workers
+    const Size workers = 4;
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(40000)
+                            .withSeed(42)
+                            .withWorkers(workers));
+    Real first = option.NPV();
+    Real error = option.errorEstimate();
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(40000)
+                            .withSeed(42)
+                            .withWorkers(workers));
+    Real second = option.NPV();
+    if (first != second)
+        BOOST_ERROR("failed to reproduce multi-worker Monte Carlo result"
+                    << "\n    workers:    " << workers
+                    << "\n    first:      " << first
+                    << "\n    second:     " << second);
+    if (first == serial)
+        BOOST_ERROR("workers are not using independent streams");
+    if (std::fabs(first - expected) > 4.0*error)
+        BOOST_ERROR("failed to reproduce analytic result"
+                    << "\n    workers:    " << workers
+                    << "\n    calculated: " << first
+                    << "\n    expected:   " << expected
+                    << "\n    error:      " << error);
+
+    // the tolerance-driven loop must still converge
+    Real tolerance = 0.05;
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withAbsoluteTolerance(tolerance)
+                            .withSeed(42)
+                            .withWorkers(workers));
+    calculated = option.NPV();
+    error = option.errorEstimate();
+    if (error > tolerance)
+        BOOST_ERROR("required tolerance not reached"
+                    << "\n    tolerance:  " << tolerance
+                    << "\n    error:      " << error);
+    if (std::fabs(calculated - expected) > 4.0*error)
+        BOOST_ERROR("failed to reproduce analytic result"
+                    << "\n    workers:    " << workers
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    error:      " << error);
+}
+
+void EuropeanOptionTest::testMcEngineDistribution() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo European engine "
+                       "distributed among processes...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    // the processes draw disjoint blocks of the serial stream
+    typedef MonteCarloModel<SingleVariate,PseudoRandom> model_type;
+    typedef model_type::path_generator_type generator_type;
+    const BigNatural seed = 42;
+    const Size samples = 1000, processes = 3;
+    TimeGrid grid(1.0, 4);
+    boost::shared_ptr<model_type::path_pricer_type> pricer(
+                      new EuropeanPathPricer(Option::Call, 105.0, 0.95));
+
+    model_type serialModel(
+        boost::shared_ptr<generator_type>(new generator_type(
+            process, grid,
+            PseudoRandom::make_sequence_generator(grid.size()-1, seed),
+            false)),
+        pricer, Statistics(), true);
+    std::vector<std::pair<Real,Real> > expected;
+    serialModel.drawSamples(samples, expected);
+
+    std::vector<std::pair<Real,Real> > calculated;
+    for (Size i=0; i<processes; ++i) {
+        model_type model(
+            boost::shared_ptr<generator_type>(new generator_type(
+                process, grid,
+                PseudoRandom::make_sequence_generator(grid.size()-1, seed),
+                false)),
+            pricer, Statistics(), true);
+        Size first = i*(samples/processes);
+        Size n = (i == processes-1 ? samples-first : samples/processes);
+        model.jumpAhead(first);
+        model.drawSamples(n, calculated);
+    }
+
+    for (Size j=0; j<samples; ++j) {
+        if (calculated[j] != expected[j])
+            BOOST_FAIL("failed to reproduce serial sample"
+                       << "\n    sample:     " << j
+                       << "\n    serial:     " << expected[j].first
+                       << "\n    calculated: " << calculated[j].first);
+    }
+
+    // the distributed engine must reproduce the serial one
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Call, 105.0));
+    boost::shared_ptr<Exercise> exercise(
+                                 new EuropeanExercise(today + Period(1, Years)));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(10000)
+                            .withSeed(seed));
+    Real serial = option.NPV();
+    Real serialError = option.errorEstimate();
+
+    // with a fixed number of samples, the data are exchanged once;
+    // the first round posts them, the second one collects them
+    boost::shared_ptr<std::vector<std::vector<Real> > > board(
+                           new std::vector<std::vector<Real> >(processes));
+    for (Size round=0; round<2; ++round) {
+        for (Size i=0; i<processes; ++i) {
+            boost::shared_ptr<SampleCommunicator> communicator(
+                                        new SharedBoardCommunicator(i, board));
+            option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                                    .withSteps(1)
+                                    .withSamples(10000)
+                                    .withSeed(seed)
+                                    .withCommunicator(communicator));
+            Real distributed = option.NPV();
+            Real distributedError = option.errorEstimate();
+            if (round == 1 && (distributed != serial
+                               || distributedError != serialError))
+                BOOST_ERROR("failed to reproduce serial Monte Carlo result"
+                            << std::setprecision(12)
+                            << "\n    process:     " << i
+                            << "\n    serial:      " << serial
+                            << " +/- " << serialError
+                            << "\n    distributed: " << distributed
+                            << " +/- " << distributedError);
+        }
+    }
+
+    // in a single process, the tolerance-driven loop must also
+    // reproduce the serial one
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withAbsoluteTolerance(0.05)
+                            .withSeed(seed));
+    serial = option.NPV();
+    serialError = option.errorEstimate();
+    boost::shared_ptr<SampleCommunicator> communicator(
+        new SharedBoardCommunicator(0,
+            boost::shared_ptr<std::vector<std::vector<Real> > >(
+                                  new std::vector<std::vector<Real> >(1))));
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withAbsoluteTolerance(0.05)
+                            .withSeed(seed)
+                            .withCommunicator(communicator));
+    Real distributed = option.NPV();
+    Real distributedError = option.errorEstimate();
+    if (distributed != serial || distributedError != serialError)
+        BOOST_ERROR("failed to reproduce serial Monte Carlo result"
+                    << std::setprecision(12)
+                    << "\n    tolerance:   " << 0.05
+                    << "\n    serial:      " << serial
+                    << " +/- " << serialError
+                    << "\n    distributed: " << distributed
+                    << " +/- " << distributedError);
+}
+
+void EuropeanOptionTest::testMcPathwiseGreeks() {
+
+    BOOST_TEST_MESSAGE("Testing pathwise Greeks of Monte Carlo "
+                       "European engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    boost::shared_ptr<Exercise> exercise(
+                                 new EuropeanExercise(today + Period(1, Years)));
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    for (Size i=0; i<LENGTH(types); ++i) {
+        boost::shared_ptr<StrikedTypePayoff> payoff(
+                                     new PlainVanillaPayoff(types[i], 105.0));
+        EuropeanOption option(payoff, exercise);
+
+        option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new AnalyticEuropeanEngine(process)));
+        Real expectedValue = option.NPV();
+        Real expectedDelta = option.delta();
+        Real expectedVega = option.vega();
+        Real expectedRho = option.rho();
+
+        option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                                .withSteps(1)
+                                .withSamples(50000)
+                                .withAntitheticVariate()
+                                .withSeed(42)
+                                .withWorkers(2)
+                                .withPathwiseGreeks());
+        Real value = option.NPV();
+        Real error = option.errorEstimate();
+        Real delta = option.delta();
+        Real vega = option.vega();
+        Real rho = option.rho();
+
+        if (std::fabs(value - expectedValue) > 4.0*error)
+            BOOST_ERROR("failed to reproduce analytic value"
+                        << "\n    type:       " << types[i]
+                        << "\n    calculated: " << value
+                        << "\n    expected:   " << expectedValue
+                        << "\n    error:      " << error);
+        if (std::fabs(delta - expectedDelta) > 0.01)
+            BOOST_ERROR("failed to reproduce analytic delta"
+                        << "\n    type:       " << types[i]
+                        << "\n    calculated: " << delta
+                        << "\n    expected:   " << expectedDelta);
+        if (std::fabs(vega - expectedVega) > 0.02*std::fabs(expectedVega))
+            BOOST_ERROR("failed to reproduce analytic vega"
+                        << "\n    type:       " << types[i]
+                        << "\n    calculated: " << vega
+                        << "\n    expected:   " << expectedVega);
+        if (std::fabs(rho - expectedRho) > 0.02*std::fabs(expectedRho))
+            BOOST_ERROR("failed to reproduce analytic rho"
+                        << "\n    type:       " << types[i]
+                        << "\n    calculated: " << rho
+                        << "\n    expected:   " << expectedRho);
+    }
+}
+
 void EuropeanOptionTest::testQmcEngines() {
 
     BOOST_TEST_MESSAGE("Testing Quasi Monte Carlo European engines "
@@ -1265,6 +1564,182 @@ void EuropeanOptionTest::testQmcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testRandomizedQmcEngines() {
+
+    BOOST_TEST_MESSAGE("Testing randomized Quasi Monte Carlo European "
+                       "engines against analytic results...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Call, 105.0));
+    boost::shared_ptr<Exercise> exercise(
+                                 new EuropeanExercise(today + Period(1, Years)));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new AnalyticEuropeanEngine(process)));
+    Real expected = option.NPV();
+
+    const Size samples = 16384;
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(42));
+    Real mcError = option.errorEstimate();
+
+    // the randomizations give an error estimate, which must be much
+    // smaller than the pseudo-random one for the same samples
+    option.setPricingEngine(
+                     MakeMCEuropeanEngine<RandomizedLowDiscrepancy>(process)
+                     .withSteps(1)
+                     .withSamples(samples)
+                     .withSeed(42));
+    Real calculated = option.NPV();
+    Real error = option.errorEstimate();
+    if (error <= 0.0 || error > 0.1*mcError)
+        BOOST_ERROR("unexpected randomized QMC error estimate"
+                    << "\n    randomized QMC: " << error
+                    << "\n    pseudo-random:  " << mcError);
+    if (std::fabs(calculated - expected) > 4.0*error)
+        BOOST_ERROR("failed to reproduce analytic result"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    error:      " << error);
+
+    // results are reproducible for a given seed
+    option.setPricingEngine(
+                     MakeMCEuropeanEngine<RandomizedLowDiscrepancy>(process)
+                     .withSteps(1)
+                     .withSamples(samples)
+                     .withSeed(42));
+    if (option.NPV() != calculated)
+        BOOST_ERROR("failed to reproduce randomized QMC result"
+                    << "\n    first:  " << calculated
+                    << "\n    second: " << option.NPV());
+
+    // the tolerance-driven loop must converge
+    Real tolerance = 0.002;
+    option.setPricingEngine(
+                     MakeMCEuropeanEngine<RandomizedLowDiscrepancy>(process)
+                     .withSteps(1)
+                     .withAbsoluteTolerance(tolerance)
+                     .withSeed(42));
+    calculated = option.NPV();
+    error = option.errorEstimate();
+    if (error > tolerance)
+        BOOST_ERROR("required tolerance not reached"
+                    << "\n    tolerance:  " << tolerance
+                    << "\n    error:      " << error);
+    if (std::fabs(calculated - expected) > 4.0*error)
+        BOOST_ERROR("failed to reproduce analytic result"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    error:      " << error);
+}
+
+namespace {
+
+    boost::shared_ptr<PricingEngine> makeFdEngine(
+                const boost::shared_ptr<GeneralizedBlackScholesProcess>& p,
+                const GridCalibrator::Grid& grid) {
+        return boost::shared_ptr<PricingEngine>(
+            new FdBlackScholesVanillaEngine(p, grid.tGrid, grid.xGrid,
+                                            grid.dampingSteps));
+    }
+
+}
+
+void EuropeanOptionTest::testGridCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing accuracy-targeted calibration "
+                       "of finite-difference grids...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Put, 95.0));
+    boost::shared_ptr<Exercise> exercise(
+                                 new EuropeanExercise(today + Period(1, Years)));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new AnalyticEuropeanEngine(process)));
+    Real expected = option.NPV();
+
+    Real tolerance = 1.0e-3;
+    std::vector<Time> maturities(1, 2.0);
+    std::vector<Real> moneyness(1, 1.0);
+    GridCalibrator calibrator(boost::bind(makeFdEngine, process, _1),
+                              GridCalibrator::Grid(10, 20, 0, 1),
+                              tolerance, 8, 2.0, maturities, moneyness);
+
+    GridCalibrator::Study study = calibrator.study(option);
+    Size selected = study.selected;
+    if (selected < 1 || selected+1 > study.prices.size())
+        BOOST_FAIL("unexpected selected grid: " << selected
+                   << " out of " << study.prices.size());
+    // the coarsest grid is not accurate enough; the selected one is
+    if (std::fabs(study.prices[0] - expected) <= tolerance)
+        BOOST_ERROR("coarsest grid unexpectedly accurate"
+                    << "\n    price:    " << study.prices[0]
+                    << "\n    expected: " << expected);
+    if (std::fabs(study.prices[selected] - expected) > 2.0*tolerance)
+        BOOST_ERROR("failed to reach the required accuracy"
+                    << "\n    grid:      " << study.grids[selected].tGrid
+                    << " x " << study.grids[selected].xGrid
+                    << "\n    price:     " << study.prices[selected]
+                    << "\n    expected:  " << expected
+                    << "\n    estimated error: " << study.errors[selected]);
+    // second-order convergence of the Douglas scheme
+    if (study.order == Null<Real>() || std::fabs(study.order-2.0) > 0.5)
+        BOOST_ERROR("unexpected order of convergence: " << study.order);
+    if (std::fabs(study.extrapolatedPrice - expected) > 0.5*tolerance)
+        BOOST_ERROR("failed to extrapolate the price"
+                    << "\n    extrapolated: " << study.extrapolatedPrice
+                    << "\n    expected:     " << expected);
+
+    // grids are cached by bucket
+    GridCalibrator::Grid grid =
+        calibrator.grid("european put", 1.0, 0.95, option);
+    if (grid.tGrid != study.grids[selected].tGrid
+        || grid.xGrid != study.grids[selected].xGrid)
+        BOOST_ERROR("cached grid differs from the selected one");
+    if (!calibrator.hasGrid("european put", 0.5, 0.8)
+        || calibrator.hasGrid("european put", 3.0, 0.8)
+        || calibrator.hasGrid("european put", 1.0, 1.2)
+        || calibrator.hasGrid("european call", 1.0, 0.95))
+        BOOST_ERROR("wrong bucketing of the cached grids");
+
+    option.setPricingEngine(calibrator.engine("european put", 1.5, 0.9));
+    if (std::fabs(option.NPV() - study.prices[selected]) > 1.0e-12)
+        BOOST_ERROR("failed to reproduce the price on the cached grid"
+                    << "\n    price:    " << option.NPV()
+                    << "\n    expected: " << study.prices[selected]);
+}
+
 void EuropeanOptionTest::testFFTEngines() {
 
     BOOST_TEST_MESSAGE("Testing FFT European engines "
@@ -1513,6 +1988,194 @@ void EuropeanOptionTest::testLocalVolatility() {
     }
 }
 
+void EuropeanOptionTest::testLocalVolatilitySlices() {
+    BOOST_TEST_MESSAGE("Testing bulk local and Black variance queries...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Calendar calendar = TARGET();
+
+    std::vector<Date> dates;
+    dates.push_back(today + 3*Months);
+    dates.push_back(today + 1*Years);
+    dates.push_back(today + 2*Years);
+
+    Real tmp[] = { 3000.0, 4000.0, 4500.0, 5000.0, 6000.0 };
+    const std::vector<Real> strikes(tmp, tmp+LENGTH(tmp));
+
+    Volatility v[] = { 0.36, 0.33, 0.31,
+                       0.31, 0.29, 0.28,
+                       0.28, 0.27, 0.26,
+                       0.26, 0.25, 0.25,
+                       0.25, 0.24, 0.24 };
+    Matrix blackVolMatrix(strikes.size(), dates.size());
+    for (Size i=0; i < strikes.size(); ++i)
+        for (Size j=0; j < dates.size(); ++j)
+            blackVolMatrix[i][j] = v[i*dates.size()+j];
+
+    const boost::shared_ptr<BlackVarianceSurface> volTS(
+        new BlackVarianceSurface(today, calendar, dates,
+                                 strikes, blackVolMatrix, dayCounter));
+    volTS->setInterpolation<Bicubic>();
+
+    const Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(4500.0)));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.03, dayCounter));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.01, dayCounter));
+    const LocalVolSurface localVol(Handle<BlackVolTermStructure>(volTS),
+                                   rTS, qTS, s0);
+
+    Array levels(9), times(9);
+    for (Size i=0; i<levels.size(); ++i)
+        levels[i] = 3500.0 + 250.0*i;
+
+    Time t[] = { 0.0, 0.1, 0.5, 1.5 };
+    for (Size k=0; k<LENGTH(t); ++k) {
+        std::fill(times.begin(), times.end(), t[k]);
+        Array variances = volTS->blackVariances(times, levels);
+        Array vols = localVol.localVols(t[k], levels);
+        for (Size i=0; i<levels.size(); ++i) {
+            Real expectedVariance = volTS->blackVariance(t[k], levels[i]);
+            Volatility expectedVol = localVol.localVol(t[k], levels[i]);
+            if (variances[i] != expectedVariance)
+                BOOST_ERROR("failed to reproduce Black variance"
+                            << "\n    time:       " << t[k]
+                            << "\n    strike:     " << levels[i]
+                            << "\n    calculated: " << variances[i]
+                            << "\n    expected:   " << expectedVariance);
+            if (vols[i] != expectedVol)
+                BOOST_ERROR("failed to reproduce local volatility"
+                            << "\n    time:       " << t[k]
+                            << "\n    level:      " << levels[i]
+                            << "\n    calculated: " << vols[i]
+                            << "\n    expected:   " << expectedVol);
+        }
+    }
+
+    // a precomputed grid, queried between and outside its slices
+    std::vector<Time> gridTimes(dates.size());
+    const boost::shared_ptr<Matrix> localVolMatrix(
+                               new Matrix(strikes.size(), dates.size()));
+    for (Size j=0; j < dates.size(); ++j) {
+        gridTimes[j] = dayCounter.yearFraction(today, dates[j]);
+        for (Size i=0; i < strikes.size(); ++i)
+            (*localVolMatrix)[i][j] =
+                localVol.localVol(gridTimes[j], strikes[i]);
+    }
+    const FixedLocalVolSurface fixedLocalVol(
+        today, gridTimes, strikes, localVolMatrix, dayCounter);
+
+    Array vols;
+    Time tf[] = { 0.1, 0.5, gridTimes[1], 1.5 };
+    for (Size k=0; k<LENGTH(tf); ++k) {
+        fixedLocalVol.localVols(tf[k], levels, vols, true);
+        for (Size i=0; i<levels.size(); ++i) {
+            Volatility expectedVol =
+                fixedLocalVol.localVol(tf[k], levels[i], true);
+            if (vols[i] != expectedVol)
+                BOOST_ERROR("failed to reproduce fixed local volatility"
+                            << "\n    time:       " << tf[k]
+                            << "\n    level:      " << levels[i]
+                            << "\n    calculated: " << vols[i]
+                            << "\n    expected:   " << expectedVol);
+        }
+    }
+}
+
+void EuropeanOptionTest::testFdDupireEngine() {
+    BOOST_TEST_MESSAGE("Testing forward finite-differences Dupire engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    boost::shared_ptr<FdDupireVanillaEngine> dupireEngine(
+                          new FdDupireVanillaEngine(process, 200, 400));
+    boost::shared_ptr<PricingEngine> analyticEngine(
+                                      new AnalyticEuropeanEngine(process));
+
+    Integer months[] = { 3, 6, 12, 24 };
+    Real strikes[] = { 70.0, 85.0, 100.0, 115.0, 130.0 };
+    Option::Type types[] = { Option::Call, Option::Put };
+
+    std::vector<Date> expiries;
+    for (Size i=0; i<LENGTH(months); ++i)
+        expiries.push_back(today + months[i]*Months);
+    dupireEngine->addExpiries(expiries);
+
+    if (dupireEngine->expiryTimes().size() != LENGTH(months))
+        BOOST_FAIL(dupireEngine->expiryTimes().size() << " expiries given, "
+                   << LENGTH(months) << " expected");
+    const Matrix& prices = dupireEngine->callPrices();
+    if (prices.rows() != LENGTH(months)
+        || prices.columns() != dupireEngine->strikes().size())
+        BOOST_FAIL("price grid has " << prices.rows() << "x"
+                   << prices.columns() << " elements; "
+                   << LENGTH(months) << "x"
+                   << dupireEngine->strikes().size() << " expected");
+
+    const Real tol = 1.0e-2;
+    for (Integer k=0; k<2; ++k) {
+        for (Size i=0; i<expiries.size(); ++i) {
+            for (Size j=0; j<LENGTH(strikes); ++j) {
+                for (Size l=0; l<LENGTH(types); ++l) {
+                    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(types[l], strikes[j]));
+                    boost::shared_ptr<Exercise> exercise(
+                                          new EuropeanExercise(expiries[i]));
+                    EuropeanOption option(payoff, exercise);
+
+                    option.setPricingEngine(analyticEngine);
+                    const Real expected = option.NPV();
+                    option.setPricingEngine(dupireEngine);
+                    const Real calculated = option.NPV();
+
+                    if (std::fabs(calculated - expected) > tol)
+                        BOOST_ERROR("failed to reproduce option price"
+                                    << "\n    type:       " << types[l]
+                                    << "\n    strike:     " << strikes[j]
+                                    << "\n    maturity:   " << expiries[i]
+                                    << "\n    volatility: " << vol->value()
+                                    << "\n    calculated: " << calculated
+                                    << "\n    expected:   " << expected);
+                }
+            }
+        }
+        // the engine must solve again for the new volatility
+        vol->setValue(0.35);
+    }
+
+    // an expiry not given beforehand is added to the grid
+    const Date newExpiry = today + 18*Months;
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                              new PlainVanillaPayoff(Option::Call, 100.0));
+    EuropeanOption option(payoff, boost::shared_ptr<Exercise>(
+                                           new EuropeanExercise(newExpiry)));
+    option.setPricingEngine(analyticEngine);
+    const Real expected = option.NPV();
+    option.setPricingEngine(dupireEngine);
+    const Real calculated = option.NPV();
+    if (std::fabs(calculated - expected) > tol)
+        BOOST_ERROR("failed to reproduce price for additional expiry"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+    if (dupireEngine->expiryTimes().size() != LENGTH(months)+1)
+        BOOST_ERROR("additional expiry not added to the grid");
+}
+
 void EuropeanOptionTest::testAnalyticEngineDiscountCurve() {
     BOOST_TEST_MESSAGE(
         "Testing separate discount curve for analytic European engine...");
@@ -1561,6 +2224,63 @@ void EuropeanOptionTest::testAnalyticEngineDiscountCurve() {
     BOOST_CHECK_NE(npvSingleCurve, npvMultiCurve);
 }
 
+void EuropeanOptionTest::testBinomialExtrapolation() {
+    BOOST_TEST_MESSAGE(
+        "Testing Richardson extrapolation in binomial engines...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+            Handle<YieldTermStructure>(qTS),
+            Handle<YieldTermStructure>(rTS),
+            Handle<BlackVolTermStructure>(volTS)));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(new
+        PlainVanillaPayoff(Option::Put, 105.0));
+    Date exDate = today + Period(1, Years);
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exDate));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                  new AnalyticEuropeanEngine(stochProcess)));
+    Real expected = option.NPV();
+    Real expectedDelta = option.delta();
+
+    // the extrapolated price uses trees with 31, 63 and 127 steps
+    Size steps = 31;
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new BinomialVanillaEngine<LeisenReimer>(stochProcess, 4*steps+3)));
+    Real largestTreeError = std::fabs(option.NPV() - expected);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new BinomialVanillaEngine<LeisenReimer>(stochProcess, steps, 3)));
+    Real error = std::fabs(option.NPV() - expected);
+    Real deltaError = std::fabs(option.delta() - expectedDelta);
+
+    if (error > largestTreeError/5.0)
+        BOOST_ERROR("extrapolated price not more accurate than "
+                    "the largest tree:"
+                    << "\n    extrapolated error: " << error
+                    << "\n    largest tree error: " << largestTreeError);
+    if (deltaError > 1.0e-4)
+        BOOST_ERROR("failed to reproduce analytic delta:"
+                    << "\n    calculated: " << option.delta()
+                    << "\n    expected:   " << expectedDelta
+                    << "\n    error:      " << deltaError);
+
+    BOOST_CHECK_THROW(BinomialVanillaEngine<LeisenReimer>(stochProcess,
+                                                          steps, 4),
+                      Error);
+}
+
 test_suite* EuropeanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("European option tests");
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testValues));
@@ -1579,15 +2299,27 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLRBinomialEngines));
     suite->add(QUANTLIB_TEST_CASE(
                               &EuropeanOptionTest::testJOSHIBinomialEngines));
+    suite->add(QUANTLIB_TEST_CASE(
+                             &EuropeanOptionTest::testBinomialExtrapolation));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testFdEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngineWorkers));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &EuropeanOptionTest::testMcEngineDistribution));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcPathwiseGreeks));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &EuropeanOptionTest::testRandomizedQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testGridCalibration));
 
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(
+                          &EuropeanOptionTest::testLocalVolatilitySlices));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testFdDupireEngine));
 
     suite->add(QUANTLIB_TEST_CASE(
                        &EuropeanOptionTest::testAnalyticEngineDiscountCurve));
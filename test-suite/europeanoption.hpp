@@ -40,13 +40,21 @@ class EuropeanOptionTest {
     static void testTIANBinomialEngines();
     static void testLRBinomialEngines();
     static void testJOSHIBinomialEngines();
+    static void testBinomialExtrapolation();
     static void testFdEngines();
     static void testIntegralEngines();
     static void testQmcEngines();
+    static void testRandomizedQmcEngines();
+    static void testGridCalibration();
     static void testMcEngines();
+    static void testMcEngineWorkers();
+    static void testMcEngineDistribution();
+    static void testMcPathwiseGreeks();
     static void testFFTEngines();
     static void testPriceCurve();
     static void testLocalVolatility();
+    static void testLocalVolatilitySlices();
+    static void testFdDupireEngine();
     static void testAnalyticEngineDiscountCurve();
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
@@ -374,6 +374,106 @@ void ExchangeRateTest::testSmartLookup() {
     }
 }
 
+void ExchangeRateTest::testCachedLookup() {
+
+    BOOST_TEST_MESSAGE("Testing cached lookup of exchange rates...");
+
+    Currency EUR = EURCurrency(), USD = USDCurrency(), GBP = GBPCurrency(),
+             CHF = CHFCurrency(), ITL = ITLCurrency();
+
+    ExchangeRateManager& rateManager = ExchangeRateManager::instance();
+    rateManager.clear();
+
+    Date today(4,August,2004);
+    rateManager.add(ExchangeRate(EUR, USD, 1.1983), today);
+    rateManager.add(ExchangeRate(USD, CHF, 1.2847), today);
+
+    Money m = 100000.0 * ITL;
+
+    // triangulated through EUR, then derived through USD
+    for (Size i=0; i<2; ++i) {
+        Money calculated = rateManager.lookup(ITL, CHF, today).exchange(m);
+        Money expected(m.value()*1.1983*1.2847/1936.27, CHF);
+        if (!close(calculated,expected))
+            BOOST_ERROR("Wrong result at lookup #" << i << ": \n"
+                        << "    expected:   " << expected << "\n"
+                        << "    calculated: " << calculated);
+    }
+
+    // a rate added later takes precedence...
+    rateManager.add(ExchangeRate(EUR, USD, 1.2042), today);
+    Money calculated = rateManager.lookup(ITL, CHF, today).exchange(m);
+    Money expected(m.value()*1.2042*1.2847/1936.27, CHF);
+    if (!close(calculated,expected))
+        BOOST_ERROR("Wrong result after adding a rate: \n"
+                    << "    expected:   " << expected << "\n"
+                    << "    calculated: " << calculated);
+
+    // ...and a direct one replaces the chain
+    rateManager.add(ExchangeRate(EUR, CHF, 1.5200), today);
+    calculated = rateManager.lookup(ITL, CHF, today).exchange(m);
+    expected = Money(m.value()*1.5200/1936.27, CHF);
+    if (!close(calculated,expected))
+        BOOST_ERROR("Wrong result after adding a direct rate: \n"
+                    << "    expected:   " << expected << "\n"
+                    << "    calculated: " << calculated);
+
+    // rates are not available after clearing
+    rateManager.clear();
+    BOOST_CHECK_THROW(rateManager.lookup(ITL, CHF, today), Error);
+    BOOST_CHECK_THROW(rateManager.lookup(GBP, USD, today), Error);
+}
+
+void ExchangeRateTest::testBulkConversion() {
+
+    BOOST_TEST_MESSAGE("Testing bulk conversion of amounts...");
+
+    Currency EUR = EURCurrency(), USD = USDCurrency(), GBP = GBPCurrency(),
+             CHF = CHFCurrency(), SEK = SEKCurrency(), JPY = JPYCurrency();
+
+    ExchangeRateManager& rateManager = ExchangeRateManager::instance();
+    rateManager.clear();
+
+    Date today(4,August,2004);
+    rateManager.add(ExchangeRate(EUR, USD, 1.1983), today);
+    rateManager.add(ExchangeRate(GBP, EUR, 1.0/0.6596), today);
+    rateManager.add(ExchangeRate(USD, CHF, 1.2847), today);
+    rateManager.add(ExchangeRate(SEK, CHF, 0.1674), today);
+    rateManager.add(ExchangeRate(SEK, JPY, 14.5450), today);
+
+    Currency currencies[] = { EUR, USD, GBP, CHF, SEK, JPY };
+    std::vector<Money> amounts;
+    for (Size i=0; i<60; ++i)
+        amounts.push_back((1000.0 + 137.0*i) * currencies[i % 6]);
+
+    for (Size k=0; k<LENGTH(currencies); ++k) {
+        const Currency& target = currencies[k];
+        std::vector<Money> converted =
+            rateManager.convert(amounts, target, today);
+        BOOST_REQUIRE(converted.size() == amounts.size());
+        for (Size i=0; i<amounts.size(); ++i) {
+            Money expected = amounts[i];
+            if (amounts[i].currency() != target)
+                expected = rateManager.lookup(amounts[i].currency(), target,
+                                              today).exchange(amounts[i]);
+            expected = expected.rounded();
+            // rounding to the accuracy of the target currency
+            Real tolerance = 1.0e-8 * std::fabs(expected.value())
+                           + std::pow(10.0, -target.rounding().precision());
+            if (converted[i].currency() != target
+                || std::fabs(converted[i].value() - expected.value())
+                                                               > tolerance)
+                BOOST_ERROR("Wrong result for amount #" << i << ": \n"
+                            << "    expected:   " << expected << "\n"
+                            << "    calculated: " << converted[i]);
+        }
+    }
+
+    // unavailable rates
+    amounts.push_back(1000.0 * INRCurrency());
+    BOOST_CHECK_THROW(rateManager.convert(amounts, EUR, today), Error);
+}
+
 test_suite* ExchangeRateTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Exchange-rate tests");
     suite->add(QUANTLIB_TEST_CASE(&ExchangeRateTest::testDirect));
@@ -381,6 +481,8 @@ test_suite* ExchangeRateTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ExchangeRateTest::testDirectLookup));
     suite->add(QUANTLIB_TEST_CASE(&ExchangeRateTest::testTriangulatedLookup));
     suite->add(QUANTLIB_TEST_CASE(&ExchangeRateTest::testSmartLookup));
+    suite->add(QUANTLIB_TEST_CASE(&ExchangeRateTest::testCachedLookup));
+    suite->add(QUANTLIB_TEST_CASE(&ExchangeRateTest::testBulkConversion));
     return suite;
 }
 
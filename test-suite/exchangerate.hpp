@@ -32,6 +32,8 @@ class ExchangeRateTest {
     static void testDirectLookup();
     static void testTriangulatedLookup();
     static void testSmartLookup();
+    static void testCachedLookup();
+    static void testBulkConversion();
     static boost::unit_test_framework::test_suite* suite();
 };
 
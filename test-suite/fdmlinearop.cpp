@@ -43,6 +43,8 @@
 #include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmmultigridsolver.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/meshers/uniformgridmesher.hpp>
@@ -62,6 +64,8 @@
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmndimsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsparsegridsolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmmultisnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm3dimsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmamericanstepcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
@@ -70,6 +74,7 @@
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
 #include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
+#include <ql/math/matrixutilities/csrilupreconditioner.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -216,6 +221,43 @@ void FdmLinearOpTest::testFdmLinearOpLayout() {
             }
         }
     }
+
+    // coordinates, lines and neighbour offsets must be consistent
+    // with the iterator and with neighbourhood()
+    for (iter = layout.begin(); iter != layout.end(); ++iter) {
+        const Size i = iter.index();
+        for (Size d=0; d < dim.size(); ++d) {
+            if (layout.coordinate(i, d) != iter.coordinates()[d])
+                BOOST_FAIL("coordinate " << d << " of point " << i
+                           << " is " << layout.coordinate(i, d)
+                           << " but should be " << iter.coordinates()[d]);
+            for (Integer offset=-1; offset <= 1; offset+=2) {
+                const Size expected = layout.neighbourhood(iter, d, offset);
+                const Size calculated = i +
+                    layout.neighbourOffsets(d, offset)[iter.coordinates()[d]];
+                if (calculated != expected)
+                    BOOST_FAIL("neighbour offset along direction " << d
+                               << " leads to index " << calculated
+                               << " but should lead to " << expected);
+            }
+        }
+    }
+
+    for (Size d=0; d < dim.size(); ++d) {
+        std::vector<Size> visited(layout.size(), 0);
+        for (Size l=0; l < layout.lines(d); ++l) {
+            const Size start = layout.lineStart(d, l);
+            if (layout.coordinate(start, d) != 0)
+                BOOST_FAIL("line " << l << " along direction " << d
+                           << " doesn't start at its first point");
+            for (Size k=0; k < dim[d]; ++k)
+                ++visited[start + k*layout.spacing()[d]];
+        }
+        if (std::count(visited.begin(), visited.end(), 1)
+                                                != Integer(layout.size()))
+            BOOST_FAIL("lines along direction " << d
+                       << " don't cover each point exactly once");
+    }
 }
 
 void FdmLinearOpTest::testUniformGridMesher() {
@@ -756,6 +798,79 @@ void FdmLinearOpTest::testTripleBandMapSolve() {
     }
 }
 
+void FdmLinearOpTest::testTripleBandMapFactorizationReuse() {
+
+    BOOST_TEST_MESSAGE("Testing reuse of triple-band map factorizations...");
+
+    SavedSettings backup;
+
+    Size dims[] = {50, 80};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>( 0, 1.0));
+    boundaries.push_back(std::pair<Real, Real>( 0, 1.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    TripleBandLinearOp op(SecondDerivativeOp(1, mesher));
+    op.axpyb(Array(1, 0.3), FirstDerivativeOp(1, mesher), op, Array(1, -0.1));
+
+    Array u(layout->size()), w(layout->size());
+    for (Size i=0; i < layout->size(); ++i) {
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+        w[i] = std::cos(0.2*i);
+    }
+
+    // solving (a*op + b) x = r several times, possibly with the stored
+    // factorization; the solutions must be consistent with apply()
+    const Real a[] = { -0.01, -0.01, -0.02, -0.02 };
+    const Real b[] = {  1.0,   1.0,   1.0,   2.0 };
+    for (Size k=0; k < LENGTH(a); ++k) {
+        for (Size n=0; n < 2; ++n) {
+            const Array& r = (n == 0) ? u : w;
+            const Array x = op.solve_splitting(r, a[k], b[k]);
+            const Array y = a[k]*op.apply(x) + b[k]*x;
+            for (Size i=0; i < r.size(); ++i) {
+                if (std::fabs(y[i] - r[i]) > 1e-10) {
+                    BOOST_FAIL("solve and apply are not consistent "
+                               << "\n a             : " << a[k]
+                               << "\n b             : " << b[k]
+                               << "\n expected      : " << r[i]
+                               << "\n calculated    : " << y[i]);
+                }
+            }
+        }
+
+        // modifying the operator must discard the factorization
+        op.axpyb(Array(), op, op, Array(1, 0.05));
+    }
+
+    // time dependence of the Black-Scholes operator
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(100.0))),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.3, dc))));
+
+    const boost::shared_ptr<Fdm1dMesher> equityMesher(
+                     new FdmBlackScholesMesher(100, process, 1.0, 100.0));
+    const boost::shared_ptr<FdmMesher> bsMesher(
+                     new FdmMesherComposite(equityMesher));
+
+    if (FdmBlackScholesOp(bsMesher, process, 100.0).isTimeDependent())
+        BOOST_ERROR("flat Black-Scholes operator is time dependent");
+    if (!FdmBlackScholesOp(bsMesher, process, 100.0, true).isTimeDependent())
+        BOOST_ERROR("local volatility operator is time independent");
+}
 
 void FdmLinearOpTest::testFdmHestonBarrier() {
 
@@ -1235,6 +1350,90 @@ void FdmLinearOpTest::testFdmHestonHullWhiteOp() {
     }
 }
 
+namespace {
+    class HestonHullWhiteSparseGridProblem : public FdmSparseGridProblem {
+      public:
+        explicit HestonHullWhiteSparseGridProblem(
+            const boost::shared_ptr<HybridHestonHullWhiteProcess>& process)
+        : process_(process) {}
+
+        FdmSolverDesc solverDesc(const std::vector<Size>& dim) const {
+            return createSolverDesc(dim, process_);
+        }
+        boost::shared_ptr<FdmLinearOpComposite> op(
+                        const boost::shared_ptr<FdmMesher>& mesher) const {
+            const boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = process_->hullWhiteProcess();
+            const boost::shared_ptr<HullWhiteProcess> hwProcess(
+                new HullWhiteProcess(
+                    process_->hestonProcess()->riskFreeRate(),
+                    hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+            return boost::shared_ptr<FdmLinearOpComposite>(
+                new FdmHestonHullWhiteOp(mesher, process_->hestonProcess(),
+                                         hwProcess, process_->eta()));
+        }
+      private:
+        const boost::shared_ptr<HybridHestonHullWhiteProcess> process_;
+    };
+}
+
+void FdmLinearOpTest::testSparseGridCombination() {
+    BOOST_TEST_MESSAGE("Testing sparse-grid combination technique "
+                       "with Heston Hull-White model...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    Date exerciseDate(28, March, 2012);
+    const Time maturity = Actual365Fixed().yearFraction(today, exerciseDate);
+
+    const boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    const boost::shared_ptr<FdmSparseGridProblem> problem(
+                       new HestonHullWhiteSparseGridProblem(jointProcess));
+
+    Size dims[] = {13, 9, 9};
+    const std::vector<Size> minGrid(dims, dims+LENGTH(dims));
+    const Size level = 2;
+
+    FdmSparseGridSolver<3> solver(problem, minGrid, level,
+                                  FdmSchemeDesc::Hundsdorfer());
+
+    // 6 grids with |l| = 2, 3 grids with |l| = 1 and one with |l| = 0
+    const std::vector<std::vector<Size> >& grids = solver.grids();
+    const std::vector<Real>& coefficients = solver.coefficients();
+    Real sumOfCoefficients = 0.0;
+    for (Size i=0; i < coefficients.size(); ++i)
+        sumOfCoefficients += coefficients[i];
+
+    if (grids.size() != 10 || std::fabs(sumOfCoefficients - 1.0) > 1e-14) {
+        BOOST_FAIL("unexpected combination grids"
+                   << "\n number of grids:     " << grids.size()
+                   << "\n sum of coefficients: " << sumOfCoefficients);
+    }
+
+    std::vector<Real> x(3);
+    x[0] = std::log(100.0);
+    x[1] = jointProcess->hestonProcess()->v0();
+    x[2] = 0.0;
+
+    const Real calculated = solver.interpolateAt(x);
+
+    // full-grid value, see testFdmHestonHullWhiteOp
+    const Real expected = 4.73;
+    const Real tol = 0.075;
+    if (std::fabs(calculated - expected) > tol) {
+        BOOST_FAIL("Error in calculating PV for Heston Hull White Option "
+                   "with the sparse-grid combination technique"
+                   << "\n calculated: " << calculated
+                   << "\n expected:   " << expected
+                   << "\n tolerance:  " << tol);
+    }
+}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
 namespace {
     Disposable<Array> axpy(
@@ -1279,6 +1478,85 @@ namespace {
 }
 #endif
 
+void FdmLinearOpTest::testFdmHestonOpInPlace() {
+    BOOST_TEST_MESSAGE("Testing in-place variants of the FDM Heston operator...");
+
+    Size dims[] = {60, 30};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> index(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(3.8, std::log(220.0)));
+    boundaries.push_back(std::pair<Real, Real>(0.000, 1.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+                            new UniformGridMesher(index, boundaries));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    boost::shared_ptr<FdmHestonOp> op(new FdmHestonOp(mesher, hestonProcess));
+    op->setTime(0.5, 0.51);
+
+    Array u(index->size());
+    for (Size i=0; i < u.size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    Array out(u.size());
+
+    const Array expectedApply = op->apply(u);
+    op->apply(u, out);
+    if (out != expectedApply)
+        BOOST_ERROR("in-place apply differs from apply");
+
+    const Array expectedMixed = op->apply_mixed(u);
+    op->apply_mixed(u, out);
+    if (out != expectedMixed)
+        BOOST_ERROR("in-place apply_mixed differs from apply_mixed");
+
+    for (Size direction=0; direction < op->size(); ++direction) {
+        const Array expectedDirection = op->apply_direction(direction, u);
+        op->apply_direction(direction, u, out);
+        if (out != expectedDirection)
+            BOOST_ERROR("in-place apply_direction differs from "
+                        "apply_direction for direction " << direction);
+
+        const Array expectedSolve = op->solve_splitting(direction, u, -0.01);
+        op->solve_splitting(direction, u, -0.01, out);
+        if (out != expectedSolve)
+            BOOST_ERROR("in-place solve_splitting differs from "
+                        "solve_splitting for direction " << direction);
+    }
+
+    // the Douglas scheme works on preallocated buffers; compare
+    // repeated steps with the same steps written in terms of the
+    // allocating operator methods
+    const Real theta = 0.5, dt = 0.01;
+    DouglasScheme scheme(theta, op);
+    scheme.setStep(dt);
+
+    Array a(u), expected(u);
+    for (Size k=0; k < 3; ++k) {
+        const Time t = 0.5 - k*dt;
+        scheme.step(a, t);
+
+        op->setTime(t-dt, t);
+        Array y = expected + dt*op->apply(expected);
+        for (Size i=0; i < op->size(); ++i) {
+            Array rhs = y - theta*dt*op->apply_direction(i, expected);
+            y = op->solve_splitting(i, rhs, -theta*dt);
+        }
+        expected = y;
+    }
+    if (a != expected)
+        BOOST_ERROR("Douglas scheme step differs from reference step");
+}
+
 void FdmLinearOpTest::testBiCGstab() {
 #if !defined(QL_NO_UBLAS_SUPPORT)
     BOOST_TEST_MESSAGE(
@@ -1376,6 +1654,265 @@ void FdmLinearOpTest::testGMRES() {
 #endif
 }
 
+void FdmLinearOpTest::testCsrMatrix() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing compressed sparse-row matrices...");
+
+    const Size n=41, m=21;
+    const Real theta = 1.0;
+    const boost::numeric::ublas::compressed_matrix<Real> a
+        = createTestMatrix(n, m, theta);
+    const CsrMatrix csr(a);
+
+    Array b(n*m);
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < b.size(); ++i) {
+        b[i] = rng.next().value;
+    }
+
+    const Real tol = 1e-12;
+
+    const Array expected = axpy(a, b);
+    const Array calculated = csr.apply(b);
+    if (Norm2(calculated - expected) > tol*Norm2(expected)) {
+        BOOST_FAIL("CSR matrix product differs from ublas product" <<
+                "\n tolerance:  " << tol <<
+                "\n error:      " << Norm2(calculated - expected));
+    }
+
+    // <y, A x> = <A^T y, x>
+    Array transposed(n*m);
+    csr.transposeMultiply(b, transposed);
+    const Real lhs = DotProduct(b, expected);
+    const Real rhs = DotProduct(transposed, b);
+    if (std::fabs(lhs - rhs) > tol*std::fabs(lhs)) {
+        BOOST_FAIL("transposed CSR matrix product failed" <<
+                "\n <b, A b>:   " << lhs <<
+                "\n <A^T b, b>: " << rhs);
+    }
+
+    const SparseMatrix back = csr.toSparseMatrix();
+    for (Size i=0; i < n*m; ++i) {
+        for (Size j=0; j < n*m; ++j) {
+            if (back(i, j) != a(i, j) || csr(i, j) != a(i, j))
+                BOOST_FAIL("element (" << i << ", " << j
+                           << ") differs after conversion" <<
+                           "\n original:  " << a(i, j) <<
+                           "\n CSR:       " << csr(i, j) <<
+                           "\n converted: " << back(i, j));
+        }
+    }
+
+    // ILU(0) must be the ILU(k) factorization without fill-in
+    const CsrILUPreconditioner ilu(csr);
+    const SparseILUPreconditioner reference(a, 0);
+    const Array preconditioned = ilu.apply(b);
+    const Array expectedPreconditioned = reference.apply(b);
+    if (Norm2(preconditioned - expectedPreconditioned)
+                                > tol*Norm2(expectedPreconditioned)) {
+        BOOST_FAIL("ILU(0) preconditioner differs from reference" <<
+                "\n tolerance:  " << tol <<
+                "\n error:      "
+                << Norm2(preconditioned - expectedPreconditioned));
+    }
+
+    const boost::function<Disposable<Array>(const Array&)> precond(
+         boost::bind(&CsrILUPreconditioner::apply, &ilu, _1));
+    const Real solverTol = 1e-10;
+
+    const Array x = BiCGstab(csr, n*m, solverTol, precond).solve(b).x;
+    Real error = Norm2(b - axpy(a, x))/Norm2(b);
+    if (error > solverTol) {
+        BOOST_FAIL("Error calculating the inverse using BiCGstab "
+                   "on a CSR matrix" <<
+                "\n tolerance:  " << solverTol <<
+                "\n error:      " << error);
+    }
+
+    const Array y = GMRES(csr, n*m, solverTol, precond).solve(b, b).x;
+    error = Norm2(b - axpy(a, y))/Norm2(b);
+    if (error > solverTol) {
+        BOOST_FAIL("Error calculating the inverse using GMRES "
+                   "on a CSR matrix" <<
+                "\n tolerance:  " << solverTol <<
+                "\n error:      " << error);
+    }
+#endif
+}
+
+void FdmLinearOpTest::testMultigrid() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing multigrid solver...");
+
+    Size dims[] = {65, 33};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(3.8, std::log(220.0)));
+    boundaries.push_back(std::pair<Real, Real>(0.000, 1.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+                            new UniformGridMesher(layout, boundaries));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    boost::shared_ptr<FdmHestonOp> op(new FdmHestonOp(mesher, hestonProcess));
+    const Time dt = 0.01;
+    op->setTime(0.5, 0.5+dt);
+
+    SparseMatrix a = -dt*op->toMatrix();
+    for (Size i=0; i < a.size1(); ++i)
+        a(i, i) += 1.0;
+
+    Array b(layout->size());
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < b.size(); ++i)
+        b[i] = rng.next().value;
+
+    const Real tol = 1e-10;
+    const FdmMultigridSolver multigrid(a, layout, 50, tol);
+
+    if (multigrid.levels() < 3)
+        BOOST_ERROR("only " << multigrid.levels()
+                    << " multigrid levels built");
+
+    const FdmMultigridResult result = multigrid.solve(b);
+    const Real error = Norm2(b - prod(a, result.x))/Norm2(b);
+    if (error > tol) {
+        BOOST_ERROR("Error calculating the inverse using multigrid" <<
+                    "\n tolerance:  " << tol <<
+                    "\n error:      " << error);
+    }
+
+    // implicit Euler steps with the multigrid and the Krylov solvers
+    Array u(layout->size()), v(layout->size());
+    for (FdmLinearOpIterator iter = layout->begin();
+         iter != layout->end(); ++iter) {
+        const Size i = iter.index();
+        u[i] = v[i] = std::max(std::exp(mesher->location(iter, 0))-100.0, 0.0);
+    }
+    ImplicitEulerScheme multigridScheme(
+        op, ImplicitEulerScheme::bc_set(), 1e-10,
+        ImplicitEulerScheme::Multigrid, layout);
+    ImplicitEulerScheme biCGstabScheme(op, ImplicitEulerScheme::bc_set(),
+                                       1e-10);
+    multigridScheme.setStep(dt);
+    biCGstabScheme.setStep(dt);
+    for (Size i=0; i < 5; ++i) {
+        const Time t = 0.5 - i*dt;
+        multigridScheme.step(u, t);
+        biCGstabScheme.step(v, t);
+    }
+
+    const Real diff = Norm2(u - v)/Norm2(v);
+    if (diff > 1e-8) {
+        BOOST_ERROR("multigrid and BiCGstab implicit Euler steps differ" <<
+                    "\n relative difference: " << diff);
+    }
+#endif
+}
+
+void FdmLinearOpTest::testSnapshotWarmStart() {
+    BOOST_TEST_MESSAGE("Testing value snapshots and warm-started "
+                       "implicit Euler rollbacks...");
+
+    Size dims[] = {33, 17};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(3.8, std::log(220.0)));
+    boundaries.push_back(std::pair<Real, Real>(0.000, 1.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+                            new UniformGridMesher(layout, boundaries));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    const Time maturity = 0.5;
+    const Size steps = 20;
+
+    std::vector<Time> times;
+    Time t = maturity;
+    for (Size i=0; i < steps; ++i, t -= maturity/steps)
+        times.push_back(t - maturity/steps);
+    times.back() = 0.0;
+
+    Array initial(layout->size());
+    for (FdmLinearOpIterator iter = layout->begin();
+         iter != layout->end(); ++iter) {
+        initial[iter.index()] =
+            std::max(std::exp(mesher->location(iter, 0))-100.0, 0.0);
+    }
+
+    const Real sigmas[] = { 0.66, 0.67 };
+    std::vector<Array> values;
+    std::vector<Size> iterations;
+
+    const boost::shared_ptr<FdmMultiSnapshotCondition> snapshots(
+                                    new FdmMultiSnapshotCondition(times));
+
+    // base run, bumped run from scratch, bumped run with warm start
+    for (Size i=0; i < 3; ++i) {
+        const boost::shared_ptr<HestonProcess> hestonProcess(
+            new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04,
+                              sigmas[std::min(i, Size(1))], -0.8));
+        const boost::shared_ptr<FdmHestonOp> op(
+                                new FdmHestonOp(mesher, hestonProcess));
+
+        ImplicitEulerScheme scheme(op, ImplicitEulerScheme::bc_set(), 1e-10);
+        if (i == 2)
+            scheme.setWarmStart(snapshots);
+
+        const boost::shared_ptr<FdmMultiSnapshotCondition> condition =
+            (i == 1) ? boost::shared_ptr<FdmMultiSnapshotCondition>(
+                                       new FdmMultiSnapshotCondition(times))
+                     : snapshots;
+
+        Array a = initial;
+        FiniteDifferenceModel<ImplicitEulerScheme>(scheme, times)
+            .rollback(a, maturity, 0.0, steps, *condition);
+
+        if (i == 0) {
+            // the snapshots keep the values without loss of precision
+            const Array mid = condition->values(condition->index(times[9]));
+            Array b = initial;
+            ImplicitEulerScheme check(op, ImplicitEulerScheme::bc_set(),
+                                      1e-10);
+            FiniteDifferenceModel<ImplicitEulerScheme>(check)
+                .rollback(b, maturity, times[9], 10);
+
+            if (!(condition->values(0) == a)
+                || Norm2(mid - b)/Norm2(b) > 1e-12)
+                BOOST_ERROR("snapshot values differ from the rollback");
+        }
+
+        values.push_back(a);
+        iterations.push_back(scheme.numberOfIterations());
+    }
+
+    const Real diff = Norm2(values[2] - values[1])/Norm2(values[1]);
+    if (diff > 1e-8) {
+        BOOST_ERROR("warm-started rollback differs from the cold one" <<
+                    "\n relative difference: " << diff);
+    }
+    if (iterations[2] >= iterations[1]) {
+        BOOST_ERROR("warm start doesn't reduce the number of iterations" <<
+                    "\n cold start: " << iterations[1] <<
+                    "\n warm start: " << iterations[2]);
+    }
+}
+
 void FdmLinearOpTest::testCrankNicolsonWithDamping() {
 
     BOOST_TEST_MESSAGE("Testing Crank-Nicolson with initial implicit damping steps "
@@ -1468,6 +2005,97 @@ void FdmLinearOpTest::testCrankNicolsonWithDamping() {
     }
 }
 
+void FdmLinearOpTest::testAdaptiveTimeStepping() {
+
+    BOOST_TEST_MESSAGE("Testing adaptive time stepping with step doubling...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.3, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> process(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Put, 105.0));
+
+    // Bermudan exercise: the adaptive steps must end on the exercise dates
+    std::vector<Date> exerciseDates;
+    for (Size i=1; i <= 4; ++i)
+        exerciseDates.push_back(today + Period(3*i, Months) - 5);
+    boost::shared_ptr<Exercise> exercise(new BermudanExercise(exerciseDates));
+    const Time maturity = process->time(exerciseDates.back());
+
+    const boost::shared_ptr<Fdm1dMesher> equityMesher(
+        new FdmBlackScholesMesher(
+                200, process, maturity, payoff->strike(),
+                Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                std::pair<Real, Real>(payoff->strike(), 0.1)));
+    const boost::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(equityMesher));
+
+    const boost::shared_ptr<FdmInnerValueCalculator> calculator(
+                                     new FdmLogInnerValue(payoff, mesher, 0));
+    const boost::shared_ptr<FdmStepConditionComposite> conditions =
+        FdmStepConditionComposite::vanillaComposite(
+                                DividendSchedule(), exercise, mesher,
+                                calculator, today, dc);
+
+    const boost::shared_ptr<FdmBlackScholesOp> op(
+                   new FdmBlackScholesOp(mesher, process, payoff->strike()));
+
+    const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+    Array initial(layout->size()), x(layout->size());
+    for (FdmLinearOpIterator iter = layout->begin(); iter != layout->end();
+         ++iter) {
+        initial[iter.index()] = calculator->avgInnerValue(iter, maturity);
+        x[iter.index()] = mesher->location(iter, 0);
+    }
+
+    const Size referenceSteps = 2000, dampingSteps = 2;
+    Array reference = initial;
+    FdmBackwardSolver(op, FdmBoundaryConditionSet(), conditions,
+                      FdmSchemeDesc::Douglas())
+        .rollback(reference, maturity, 0.0, referenceSteps, dampingSteps);
+
+    Array adaptive = initial;
+    const Size steps =
+        FdmBackwardSolver(op, FdmBoundaryConditionSet(), conditions,
+                          FdmSchemeDesc::Douglas())
+        .rollbackAdaptive(adaptive, maturity, 0.0, 1e-5, 20, dampingSteps);
+
+    const Real s = std::log(spot->value());
+    const Real expected =
+        MonotonicCubicNaturalSpline(x.begin(), x.end(), reference.begin())(s);
+    const Real calculated =
+        MonotonicCubicNaturalSpline(x.begin(), x.end(), adaptive.begin())(s);
+
+    const Real tol = 1e-3;
+    if (std::fabs(calculated - expected) > tol) {
+        BOOST_ERROR("Failed to reproduce Bermudan option value "
+                    "with adaptive time steps" <<
+                    "\n adaptive steps:  " << steps <<
+                    "\n calculated:      " << calculated <<
+                    "\n expected:        " << expected <<
+                    "\n tolerance:       " << tol);
+    }
+    if (steps >= referenceSteps/10) {
+        BOOST_ERROR("too many adaptive steps" <<
+                    "\n adaptive steps:  " << steps <<
+                    "\n fixed steps:     " << referenceSteps);
+    }
+}
+
 void FdmLinearOpTest::testSpareMatrixReference() {
 #ifndef QL_NO_UBLAS_SUPPORT
     BOOST_TEST_MESSAGE("Testing SparseMatrixReference type...");
@@ -1605,6 +2233,75 @@ void FdmLinearOpTest::testFdmMesherIntegral() {
 }
 
 
+void FdmLinearOpTest::testFdmLogInnerValueAverages() {
+    BOOST_TEST_MESSAGE("Testing cell averages of log inner values...");
+
+    const Real strike = 100.0;
+    const boost::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(
+            boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(0.0, 1.0, 3)),
+            boost::shared_ptr<Fdm1dMesher>(new Concentrating1dMesher(
+                std::log(50.0), std::log(200.0), 31,
+                std::pair<Real, Real>(std::log(strike), 0.1)))));
+    const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+
+    std::vector<boost::shared_ptr<Payoff> > payoffs;
+    for (Integer j=-1; j <= 1; j+=2) {
+        const Option::Type type = Option::Type(j);
+        payoffs.push_back(boost::shared_ptr<Payoff>(
+                                  new PlainVanillaPayoff(type, strike)));
+        payoffs.push_back(boost::shared_ptr<Payoff>(
+                                  new CashOrNothingPayoff(type, strike, 5.0)));
+        payoffs.push_back(boost::shared_ptr<Payoff>(
+                                  new AssetOrNothingPayoff(type, strike)));
+    }
+
+    const Size n = 20000;
+    const Real tol = 1e-5;
+    for (Size i=0; i < payoffs.size(); ++i) {
+        FdmLogInnerValue calculator(payoffs[i], mesher, 1);
+
+        for (FdmLinearOpIterator iter = layout->begin();
+             iter != layout->end(); ++iter) {
+            const Size coord = iter.coordinates()[1];
+            const Real x = mesher->location(iter, 1);
+            const Real a = (coord > 0) ? x - mesher->dminus(iter, 1)/2 : x;
+            const Real b = (coord < layout->dim()[1]-1)
+                           ? x + mesher->dplus(iter, 1)/2 : x;
+
+            // reference value by the midpoint rule on both sides
+            // of the discontinuity at the strike
+            const Real c = std::min(std::max(std::log(strike), a), b);
+            Real expected = 0.0;
+            for (Size k=0; k < n; ++k) {
+                expected += (*payoffs[i])(std::exp(a + (k+0.5)*(c-a)/n))
+                            * (c-a)/n;
+                expected += (*payoffs[i])(std::exp(c + (k+0.5)*(b-c)/n))
+                            * (b-c)/n;
+            }
+            expected /= b-a;
+
+            const Real calculated = calculator.avgInnerValue(iter, 0.0);
+            if (std::fabs(calculated - expected) > tol*std::max(1.0, expected))
+                BOOST_FAIL("failed to reproduce cell average"
+                           << "\n    payoff:     " << payoffs[i]->description()
+                           << "\n    location:   " << x
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected);
+
+            const Real innerValue = (*payoffs[i])(std::exp(x));
+            if (calculator.innerValue(iter, 0.0) != innerValue)
+                BOOST_FAIL("failed to reproduce inner value"
+                           << "\n    payoff:     " << payoffs[i]->description()
+                           << "\n    location:   " << x
+                           << "\n    calculated: "
+                           << calculator.innerValue(iter, 0.0)
+                           << "\n    expected:   " << innerValue);
+        }
+    }
+}
+
+
 test_suite* FdmLinearOpTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("linear operator tests");
 
@@ -1622,19 +2319,31 @@ test_suite* FdmLinearOpTest::suite() {
         &FdmLinearOpTest::testSecondOrderMixedDerivativesMapApply));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapSolve));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testTripleBandMapFactorizationReuse));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonHullWhiteOp));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSparseGridCombination));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonOpInPlace));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBiCGstab));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGMRES));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCsrMatrix));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testMultigrid));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSnapshotWarmStart));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonWithDamping));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testAdaptiveTimeStepping));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSpareMatrixReference));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSparseMatrixZeroAssignment));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmMesherIntegral));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmLogInnerValueAverages));
 
     return suite;
     
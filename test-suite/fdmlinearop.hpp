@@ -36,16 +36,24 @@ public:
     static void testDerivativeWeightsOnNonUniformGrids();
     static void testSecondOrderMixedDerivativesMapApply();
     static void testTripleBandMapSolve();
+    static void testTripleBandMapFactorizationReuse();
     static void testFdmHestonBarrier();
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
     static void testFdmHestonHullWhiteOp();
+    static void testSparseGridCombination();
+    static void testFdmHestonOpInPlace();
     static void testBiCGstab();
     static void testGMRES();
+    static void testCsrMatrix();
+    static void testMultigrid();
+    static void testSnapshotWarmStart();
     static void testCrankNicolsonWithDamping();
+    static void testAdaptiveTimeStepping();
     static void testSpareMatrixReference();
     static void testSparseMatrixZeroAssignment();
     static void testFdmMesherIntegral();
+    static void testFdmLogInnerValueAverages();
 
     static boost::unit_test_framework::test_suite* suite();
 };
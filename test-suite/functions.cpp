@@ -24,6 +24,11 @@
 #include <ql/math/factorial.hpp>
 #include <ql/math/distributions/gammadistribution.hpp>
 #include <ql/math/modifiedbessel.hpp>
+#include <ql/math/fastmath.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <iomanip>
+#include <vector>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -309,6 +314,120 @@ void FunctionsTest::testWeightedModifiedBesselFunctions() {
     }
 }
 
+
+namespace {
+
+    template <class M>
+    void checkApproximateMath(const std::string& name, Real tolerance) {
+
+        Real maxExpError = 0.0, maxLogError = 0.0;
+        std::vector<Real> x(1001), y(1001);
+        for (Size i=0; i<x.size(); ++i)
+            x[i] = -700.0 + 1.4*i;
+        M::exp(x.size(), &x[0], &y[0]);
+        for (Size i=0; i<x.size(); ++i) {
+            Real expected = std::exp(x[i]);
+            maxExpError = std::max(maxExpError,
+                                   std::fabs(y[i]-expected)/expected);
+            maxExpError = std::max(maxExpError,
+                                   std::fabs(M::exp(x[i])-expected)/expected);
+        }
+        for (Size i=0; i<x.size(); ++i)
+            x[i] = 0.25 + 0.0025*i;
+        x.push_back(1.0e-300);
+        x.push_back(1.0e300);
+        y.resize(x.size());
+        M::log(x.size(), &x[0], &y[0]);
+        for (Size i=0; i<x.size(); ++i) {
+            Real expected = std::log(x[i]);
+            if (expected != 0.0)
+                maxLogError = std::max(maxLogError,
+                                       std::fabs(y[i]/expected - 1.0));
+            else if (y[i] != 0.0)
+                BOOST_ERROR(name << ": non-null logarithm of 1: " << y[i]);
+        }
+
+        if (maxExpError > tolerance)
+            BOOST_ERROR(name << ": exponential outside tolerance"
+                        << "\n relative error: " << maxExpError
+                        << "\n tolerance:      " << tolerance);
+        if (maxLogError > tolerance)
+            BOOST_ERROR(name << ": logarithm outside tolerance"
+                        << "\n relative error: " << maxLogError
+                        << "\n tolerance:      " << tolerance);
+
+        const Real inf = std::numeric_limits<Real>::infinity();
+        if (M::exp(800.0) != inf || M::exp(-800.0) != 0.0
+            || M::log(0.0) != -inf || M::log(inf) != inf
+            || !(M::log(-1.0) != M::log(-1.0)))
+            BOOST_ERROR(name << ": wrong results for special arguments");
+
+        Real power = M::pow(1.05, 10.0), expectedPower = std::pow(1.05, 10.0);
+        if (std::fabs(power/expectedPower - 1.0) > 10.0*tolerance)
+            BOOST_ERROR(name << ": power outside tolerance"
+                        << "\n calculated: " << power
+                        << "\n expected:   " << expectedPower);
+    }
+
+    // European call on monthly-simulated geometric Brownian paths
+    template <class M>
+    Real monteCarloCall(const std::vector<Real>& z) {
+        const Real s0 = 100.0, strike = 105.0, r = 0.03, sigma = 0.25;
+        const Size steps = 12, paths = z.size()/steps;
+        const Time dt = 1.0/steps;
+        const Real drift = (r - 0.5*sigma*sigma)*dt;
+        const Real stdDev = sigma*std::sqrt(dt);
+
+        std::vector<Real> s(paths, s0), dx(paths);
+        for (Size j=0; j<steps; ++j) {
+            for (Size i=0; i<paths; ++i)
+                dx[i] = drift + stdDev*z[j*paths+i];
+            M::exp(paths, &dx[0], &dx[0]);
+            for (Size i=0; i<paths; ++i)
+                s[i] *= dx[i];
+        }
+        Real sum = 0.0;
+        for (Size i=0; i<paths; ++i)
+            sum += std::max(s[i] - strike, 0.0);
+        return std::exp(-r)*sum/paths;
+    }
+
+}
+
+void FunctionsTest::testApproximateMath() {
+    BOOST_TEST_MESSAGE("Testing approximate exponentials and logarithms...");
+
+    for (Real x = -5.0; x <= 5.0; x += 0.25) {
+        if (StandardMath::exp(x) != std::exp(x)
+            || StandardMath::log(x+5.5) != std::log(x+5.5))
+            BOOST_ERROR("standard math policy differs from std functions"
+                        << "\n argument: " << x);
+    }
+
+    checkApproximateMath<AccurateApproximateMath>("accurate policy", 1.0e-12);
+    checkApproximateMath<FastApproximateMath>("fast policy", 1.0e-7);
+
+    MersenneTwisterUniformRng rng(42);
+    InverseCumulativeNormal invNormal;
+    std::vector<Real> z(12*10000);
+    for (Size i=0; i<z.size(); ++i)
+        z[i] = invNormal(rng.nextReal());
+
+    const Real expected = monteCarloCall<StandardMath>(z);
+    const Real accurate = monteCarloCall<AccurateApproximateMath>(z);
+    const Real fast = monteCarloCall<FastApproximateMath>(z);
+    if (std::fabs(accurate/expected - 1.0) > 1.0e-11)
+        BOOST_ERROR("accurate policy: Monte Carlo price outside tolerance"
+                    << std::setprecision(12)
+                    << "\n calculated: " << accurate
+                    << "\n expected:   " << expected);
+    if (std::fabs(fast/expected - 1.0) > 1.0e-6)
+        BOOST_ERROR("fast policy: Monte Carlo price outside tolerance"
+                    << std::setprecision(12)
+                    << "\n calculated: " << fast
+                    << "\n expected:   " << expected);
+}
+
 test_suite* FunctionsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Factorial tests");
     suite->add(QUANTLIB_TEST_CASE(&FunctionsTest::testFactorial));
@@ -318,5 +437,6 @@ test_suite* FunctionsTest::suite() {
                         &FunctionsTest::testModifiedBesselFunctions));
     suite->add(QUANTLIB_TEST_CASE(
                         &FunctionsTest::testWeightedModifiedBesselFunctions));
+    suite->add(QUANTLIB_TEST_CASE(&FunctionsTest::testApproximateMath));
     return suite;
 }
@@ -33,6 +33,7 @@ class FunctionsTest {
     static void testGammaValues();
     static void testModifiedBesselFunctions();
     static void testWeightedModifiedBesselFunctions();
+    static void testApproximateMath();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -22,6 +22,7 @@
 #include <ql/models/volatility/garch.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/math/optimization/bfgs.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
@@ -145,6 +146,45 @@ void GARCHTest::testCalibration() {
     CHECK(expected3, cgarch4, logLikelihood, tolerance);
 }
 
+void GARCHTest::testGradientCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing GARCH model calibration with "
+                       "gradient-based optimization...");
+
+    Date start(7, July, 1962), d = start;
+    TimeSeries<Volatility> ts;
+    Garch11 garch(0.2, 0.3, 0.4);
+    GaussianGenerator rng(MersenneTwisterUniformRng(48));
+
+    Volatility r = 0.0, v = 0.0;
+    for (std::size_t i = 0; i < 50000; ++i, d += 1) {
+        v = garch.forecast(r, v);
+        r = rng.next().value * std::sqrt(v);
+        ts[d] = r;
+    }
+
+    // same optimum as the simplex calibration in testCalibration
+    Results calibrated = { 0.207592, 0.281979, 0.204647, -0.0217413 };
+
+    // the optimizer relies on the analytic gradient of the
+    // log-likelihood, starting from the type 1 initial guess
+    Array guess(3);
+    guess[0] = 0.230964;
+    guess[1] = 0.265749;
+    guess[2] = 0.156956;
+
+    Garch11 cgarch(0.0, 0.0, 0.0);
+    BFGS bfgs;
+    cgarch.calibrate(ts, bfgs, EndCriteria(1000, 100, 1e-12, 1e-12, 1e-12),
+                     guess);
+
+    Real tol = 1.0e-4;
+    CHECK(calibrated, cgarch, alpha, tol);
+    CHECK(calibrated, cgarch, beta, tol);
+    CHECK(calibrated, cgarch, omega, tol);
+    CHECK(calibrated, cgarch, logLikelihood, tolerance);
+}
+
 namespace {
 
     static Real expected_calc[] = {
@@ -189,6 +229,7 @@ void GARCHTest::testCalculation() {
 test_suite* GARCHTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("GARCH model tests");
     suite->add(QUANTLIB_TEST_CASE(&GARCHTest::testCalibration));
+    suite->add(QUANTLIB_TEST_CASE(&GARCHTest::testGradientCalibration));
     suite->add(QUANTLIB_TEST_CASE(&GARCHTest::testCalculation));
     return suite;
 }
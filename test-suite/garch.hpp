@@ -25,6 +25,7 @@
 class GARCHTest {
   public:
     static void testCalibration();
+    static void testGradientCalibration();
     static void testCalculation();
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -26,8 +26,12 @@
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/experimental/math/gaussiannoncentralchisquaredpolynomial.hpp>
+#include <ql/experimental/math/multidimquadrature.hpp>
 
 #include <boost/math/distributions/non_central_chi_squared.hpp>
+#include <boost/bind.hpp>
+#include <iomanip>
+#include <numeric>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -83,6 +87,51 @@ namespace {
             boost::math::non_central_chi_squared_distribution<Real>(1.0,1.0),x);
     }
 
+    class ArrayCosine {
+      public:
+        Disposable<Array> operator()(const Array& x) const {
+            Array result(x.size());
+            for (Size i=0; i<x.size(); ++i)
+                result[i] = std::cos(x[i]);
+            return result;
+        }
+    };
+
+    // probability of a one-factor default event conditional on the
+    // factors, times their density; its integral is known
+    class ConditionalProbability {
+      public:
+        ConditionalProbability(const std::vector<Real>& beta,
+                               Real threshold, Real sigma)
+        : beta_(beta), threshold_(threshold), sigma_(sigma) {}
+        Real operator()(const std::vector<Real>& z) const {
+            Real bz = 0.0, density = 1.0;
+            for (Size i=0; i<z.size(); ++i) {
+                bz += beta_[i]*z[i];
+                density *= NormalDistribution()(z[i]);
+            }
+            return density
+                *CumulativeNormalDistribution()((threshold_-bz)/sigma_);
+        }
+        Disposable<std::vector<Real> > values(
+                                      const std::vector<Real>& z) const {
+            std::vector<Real> result(2);
+            result[0] = (*this)(z);
+            result[1] = 2.0*result[0];
+            return result;
+        }
+        Real integral() const {
+            Real variance = sigma_*sigma_;
+            for (Size i=0; i<beta_.size(); ++i)
+                variance += beta_[i]*beta_[i];
+            return CumulativeNormalDistribution()(
+                                          threshold_/std::sqrt(variance));
+        }
+      private:
+        std::vector<Real> beta_;
+        Real threshold_, sigma_;
+    };
+
     template <class T>
     void testSingleJacobi(const T& I) {
         testSingle(I, "f(x) = 1",
@@ -188,6 +237,123 @@ void GaussianQuadraturesTest::testTabulated() {
                          (2.0/5.0), 1.0e-13);
 }
 
+void GaussianQuadraturesTest::testCachedRules() {
+    BOOST_TEST_MESSAGE("Testing cached Gaussian quadrature rules...");
+
+    const Size n = 24;
+    const GaussHermiteIntegration first(n, 0.5);
+    const GaussHermiteIntegration second(n, 0.5);
+    const GaussianQuadrature uncached(n, GaussHermitePolynomial(0.5));
+    for (Size i=0; i<n; ++i) {
+        if (first.x()[i] != uncached.x()[i]
+            || first.weights()[i] != uncached.weights()[i]
+            || second.x()[i] != uncached.x()[i]
+            || second.weights()[i] != uncached.weights()[i]) {
+            BOOST_ERROR("cached node " << i << " differs from the "
+                        "calculated one"
+                        << std::setprecision(16)
+                        << "\n    calculated: " << uncached.x()[i]
+                        << ", " << uncached.weights()[i]
+                        << "\n    cached:     " << first.x()[i]
+                        << ", " << first.weights()[i]);
+        }
+    }
+
+    // different parameters must give different rules
+    const GaussHermiteIntegration other(n, 0.0);
+    if (other.weights()[0] == first.weights()[0])
+        BOOST_ERROR("Gauss-Hermite rules with different parameters "
+                    "share their weights");
+
+    // Legendre and Jacobi rules with the same parameters coincide
+    const GaussLegendreIntegration legendre(n);
+    const GaussJacobiIntegration jacobi(n, 0.0, 0.0);
+    for (Size i=0; i<n; ++i) {
+        if (legendre.x()[i] != jacobi.x()[i]
+            || legendre.weights()[i] != jacobi.weights()[i])
+            BOOST_ERROR("Gauss-Legendre and Gauss-Jacobi(0,0) rules "
+                        "differ at node " << i);
+    }
+
+    // integration of an array-valued function
+    const Real expected = legendre(std::ptr_fun<Real,Real>(std::cos));
+    const Real calculated = legendre.integrateOnNodes(ArrayCosine());
+    if (calculated != expected) {
+        BOOST_ERROR("failed to integrate on all nodes at once"
+                    << std::setprecision(16)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+    }
+}
+
+void GaussianQuadraturesTest::testMultidimIntegrators() {
+    BOOST_TEST_MESSAGE("Testing multi-dimensional Gaussian quadratures...");
+
+    const Size dimension = 3;
+    std::vector<Real> beta(dimension);
+    beta[0] = 0.3; beta[1] = 0.4; beta[2] = 0.2;
+    const ConditionalProbability p(beta, -1.0, 0.8);
+    const boost::function<Real (const std::vector<Real>&)> f(p);
+    const boost::function<Disposable<std::vector<Real> > (
+                                        const std::vector<Real>&)>
+        fv(boost::bind(&ConditionalProbability::values, &p, _1));
+    const Real expected = p.integral();
+    const Real tol = 1.0e-6;
+
+    const GaussianQuadMultidimIntegrator tensor(dimension, 15);
+    const GaussianQuadMultidimIntegrator parallelTensor(dimension, 15,
+                                                        0.0, true);
+    const GaussianQuadSparseGridIntegrator sparse(dimension, 9);
+    const GaussianQuadSparseGridIntegrator parallelSparse(dimension, 9,
+                                                          0.0, true);
+
+    const Real tensorValue = tensor.integrate<Real>(f);
+    const Real sparseValue = sparse.integrate<Real>(f);
+    if (std::fabs(tensorValue - expected) > tol
+        || std::fabs(sparseValue - expected) > tol) {
+        BOOST_ERROR("failed to integrate conditional probability"
+                    << std::setprecision(10)
+                    << "\n    tensor grid: " << tensorValue
+                    << "\n    sparse grid: " << sparseValue
+                    << "\n    expected:    " << expected);
+    }
+
+    // the results can't depend on the number of threads
+    if (parallelTensor.integrate<Real>(f) != tensorValue
+        || parallelSparse.integrate<Real>(f) != sparseValue)
+        BOOST_ERROR("parallel integration differs from serial one");
+
+    const std::vector<Real> tensorValues =
+        tensor.integrate<Disposable<std::vector<Real> > >(fv);
+    const std::vector<Real> parallelValues =
+        parallelTensor.integrate<Disposable<std::vector<Real> > >(fv);
+    const std::vector<Real> sparseValues =
+        sparse.integrate<Disposable<std::vector<Real> > >(fv);
+    if (tensorValues.size() != 2 || parallelValues != tensorValues
+        || tensorValues[0] != tensorValue
+        || tensorValues[1] != 2.0*tensorValue
+        || sparseValues.size() != 2
+        || std::fabs(sparseValues[0] - sparseValue) > 1.0e-15
+        || std::fabs(sparseValues[1] - 2.0*sparseValue) > 1.0e-15)
+        BOOST_ERROR("vector integrand not integrated consistently");
+
+    // each of the combined rules integrates the Gauss-Hermite
+    // weight exactly, and so does the sparse grid
+    Real sum = 0.0;
+    for (Size i=0; i<sparse.size(); ++i) {
+        const std::vector<Real> x = sparse.point(i);
+        sum += sparse.weights()[i]
+            * std::exp(-std::inner_product(x.begin(), x.end(),
+                                           x.begin(), 0.0));
+    }
+    const Real volume = std::pow(M_PI, 0.5*dimension);
+    if (std::fabs(sum - volume) > 1.0e-10)
+        BOOST_ERROR("failed to integrate Gauss-Hermite weight"
+                    << std::setprecision(16)
+                    << "\n    calculated: " << sum
+                    << "\n    expected:   " << volume);
+}
+
 void GaussianQuadraturesTest::testNonCentralChiSquared() {
      BOOST_TEST_MESSAGE(
          "Testing Gauss non-central chi-squared integration...");
@@ -256,6 +422,7 @@ test_suite* GaussianQuadraturesTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testHermite));
     suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testHyperbolic));
     suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testTabulated));
+    suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testCachedRules));
     return suite;
 }
 
@@ -263,6 +430,8 @@ test_suite* GaussianQuadraturesTest::experimental() {
     test_suite* suite = BOOST_TEST_SUITE(
         "Gaussian quadratures experimental tests");
 
+    suite->add(QUANTLIB_TEST_CASE(
+        &GaussianQuadraturesTest::testMultidimIntegrators));
     suite->add(QUANTLIB_TEST_CASE(
         &GaussianQuadraturesTest::testNonCentralChiSquared));
     suite->add(QUANTLIB_TEST_CASE(
@@ -32,6 +32,8 @@ class GaussianQuadraturesTest {
     static void testHermite();
     static void testHyperbolic();
     static void testTabulated();
+    static void testCachedRules();
+    static void testMultidimIntegrators();
     static void testNonCentralChiSquared();
     static void testNonCentralChiSquaredSumOfNotes();
 
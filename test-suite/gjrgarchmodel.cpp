@@ -304,11 +304,90 @@ void GJRGARCHModelTest::testDAXCalibration() {
     }
 }
 
+void GJRGARCHModelTest::testCachedAnalyticValues() {
+    BOOST_TEST_MESSAGE(
+         "Testing analytic GJR-GARCH engine on option chains...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+
+    DayCounter dayCounter = Actual365Fixed();
+    boost::shared_ptr<SimpleQuote> rate(new SimpleQuote(0.05));
+    Handle<YieldTermStructure> riskFreeTS(flatRate(today, rate, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(today, 0.01, dayCounter));
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(50.0)));
+
+    const Real omega = 2.0e-6;
+    const Real alpha = 0.024;
+    const Real beta = 0.93;
+    const Real gamma = 0.059;
+    const Real lambda = 0.1;
+    const Real daysPerYear = 365.0;
+    const Real v0 = 1.5e-4;
+
+    boost::shared_ptr<GJRGARCHProcess> process(new GJRGARCHProcess(
+                             riskFreeTS, dividendTS, s0, v0,
+                             omega, alpha, beta, gamma, lambda, daysPerYear));
+    boost::shared_ptr<GJRGARCHModel> model(new GJRGARCHModel(process));
+    boost::shared_ptr<PricingEngine> engine(new AnalyticGJRGARCHEngine(model));
+
+    // a chain with interleaved maturities, priced by the same engine
+    const Period maturities[] = { Period(30, Days), Period(90, Days) };
+    const Real strikes[] = { 40.0, 45.0, 50.0, 55.0, 60.0 };
+    const Option::Type types[] = { Option::Call, Option::Put };
+    std::vector<boost::shared_ptr<StrikedTypePayoff> > payoffs;
+    std::vector<boost::shared_ptr<Exercise> > exercises;
+    std::vector<boost::shared_ptr<VanillaOption> > options;
+    for (Size j = 0; j < LENGTH(strikes); ++j) {
+        for (Size i = 0; i < LENGTH(maturities); ++i) {
+            payoffs.push_back(boost::shared_ptr<StrikedTypePayoff>(
+                         new PlainVanillaPayoff(types[j%2], strikes[j])));
+            exercises.push_back(boost::shared_ptr<Exercise>(
+                         new EuropeanExercise(today + maturities[i])));
+            options.push_back(boost::shared_ptr<VanillaOption>(
+                         new VanillaOption(payoffs.back(),
+                                           exercises.back())));
+            options.back()->setPricingEngine(engine);
+        }
+    }
+
+    const Real tolerance = 1.0e-10;
+    for (Size n = 0; n < 2; ++n) {
+        // the rates are not part of the stored values
+        if (n == 1)
+            rate->setValue(0.03);
+
+        for (Size i = 0; i < options.size(); ++i) {
+            const Real calculated = options[i]->NPV();
+
+            VanillaOption option(payoffs[i], exercises[i]);
+            option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                               new AnalyticGJRGARCHEngine(
+                                   boost::shared_ptr<GJRGARCHModel>(
+                                       new GJRGARCHModel(process)))));
+            const Real expected = option.NPV();
+
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce GJR-GARCH value "
+                            "with stored moments"
+                            << "\n    rate:       " << rate->value()
+                            << "\n    option:     " << i
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
 test_suite* GJRGARCHModelTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("GJR-GARCH model tests");
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&GJRGARCHModelTest::testDAXCalibration));
+        suite->add(QUANTLIB_TEST_CASE(
+                          &GJRGARCHModelTest::testCachedAnalyticValues));
     }
 
     if (speed == Slow) {
@@ -30,6 +30,7 @@ class GJRGARCHModelTest {
   public:
     static void testEngines();
     static void testDAXCalibration();
+    static void testCachedAnalyticValues();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -26,6 +26,8 @@
 #include <ql/pricingengines/swaption/gaussian1dswaptionengine.hpp>
 #include <ql/pricingengines/swaption/gaussian1djamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swaption/gaussian1dnonstandardswaptionengine.hpp>
+#include <ql/pricingengines/swaption/gaussian1dfloatfloatswaptionengine.hpp>
+#include <ql/instruments/floatfloatswaption.hpp>
 #include <ql/indexes/swap/euriborswap.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/target.hpp>
@@ -285,9 +287,246 @@ void GsrTest::testGsrModel() {
                     << GsrJamNpv << ")");
 }
 
+void GsrTest::testZerobondGrid() {
+
+    BOOST_TEST_MESSAGE("Testing GSR zero bonds and numeraires on state grids...");
+
+    Date refDate = Settings::instance().evaluationDate();
+
+    std::vector<Date> stepDates;
+    for (Size i = 1; i < 10; i++)
+        stepDates.push_back(refDate + (i * Years));
+    std::vector<Real> vols, reversions;
+    for (Size i = 0; i <= stepDates.size(); i++) {
+        vols.push_back(0.01 + 0.001 * i);
+        reversions.push_back(0.01 - 0.0005 * i);
+    }
+
+    Handle<YieldTermStructure> yts(boost::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+    Handle<YieldTermStructure> discountCurve(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(0, TARGET(), 0.025, Actual365Fixed())));
+    boost::shared_ptr<Gsr> model(
+        new Gsr(yts, stepDates, vols, reversions, 20.0));
+
+    Real tol = 1E-14;
+
+    Time times[] = { 0.0, 0.5, 3.2, 7.0 };
+    for (Size i = 0; i < LENGTH(times); i++) {
+        Time t = times[i];
+        Array y = model->yGrid(7.0, 16, t + 1.0, t, 0.2);
+        std::vector<Time> T;
+        for (Size j = 1; j <= 12; j++)
+            T.push_back(t + 0.75 * j);
+        for (Size c = 0; c < 2; c++) {
+            Handle<YieldTermStructure> curve =
+                c == 0 ? Handle<YieldTermStructure>() : discountCurve;
+            Matrix zerobonds = model->zerobond(T, t, y, curve);
+            Array numeraires = model->numeraire(t, y, curve);
+            for (Size k = 0; k < y.size(); k++) {
+                Real expected = model->numeraire(t, y[k], curve);
+                if (std::fabs(numeraires[k] - expected) > tol * expected)
+                    BOOST_ERROR("numeraire on state grid ("
+                                << numeraires[k] << ") deviates from "
+                                << "single numeraire (" << expected
+                                << ") at t=" << t << ", y=" << y[k]);
+                for (Size j = 0; j < T.size(); j++) {
+                    expected = model->zerobond(T[j], t, y[k], curve);
+                    if (std::fabs(zerobonds[j][k] - expected) >
+                        tol * expected)
+                        BOOST_ERROR("zerobond on state grid ("
+                                    << zerobonds[j][k] << ") deviates from "
+                                    << "single zerobond (" << expected
+                                    << ") at t=" << t << ", T=" << T[j]
+                                    << ", y=" << y[k]);
+                }
+            }
+        }
+    }
+}
+
+void GsrTest::testSwapRateGrid() {
+
+    BOOST_TEST_MESSAGE("Testing GSR forward rates, swap rates and annuities "
+                       "on state grids...");
+
+    Date refDate = Settings::instance().evaluationDate();
+
+    std::vector<Date> stepDates;
+    for (Size i = 1; i < 10; i++)
+        stepDates.push_back(refDate + (i * Years));
+    std::vector<Real> vols(stepDates.size() + 1, 0.01);
+
+    Handle<YieldTermStructure> yts(boost::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+    Handle<YieldTermStructure> forwardCurve(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(0, TARGET(), 0.035, Actual365Fixed())));
+    Handle<YieldTermStructure> discountCurve(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(0, TARGET(), 0.025, Actual365Fixed())));
+    boost::shared_ptr<Gsr> model(
+        new Gsr(yts, stepDates, vols, 0.01, 30.0));
+
+    // single and multi-curve setups
+    boost::shared_ptr<SwapIndex> indexes[] = {
+        boost::shared_ptr<SwapIndex>(new EuriborSwapIsdaFixA(10 * Years)),
+        boost::shared_ptr<SwapIndex>(new EuriborSwapIsdaFixA(
+            10 * Years, forwardCurve, discountCurve))
+    };
+    boost::shared_ptr<IborIndex> iborIndexes[] = {
+        boost::shared_ptr<IborIndex>(new Euribor6M),
+        boost::shared_ptr<IborIndex>(new Euribor6M(forwardCurve))
+    };
+
+    Real tol = 1E-12;
+
+    for (Size c = 0; c < LENGTH(indexes); c++) {
+        for (Size i = 1; i <= 4; i++) {
+            Date referenceDate = TARGET().advance(refDate, i * 2 * Years);
+            Date fixing = TARGET().advance(referenceDate, 6 * Months);
+            Time t = yts->timeFromReference(referenceDate);
+            Array y = model->yGrid(7.0, 16, t + 0.5, t, 0.0);
+            Array rates = model->swapRate(fixing, 10 * Years, referenceDate,
+                                          y, indexes[c]);
+            Array annuities = model->swapAnnuity(
+                fixing, 10 * Years, referenceDate, y, indexes[c]);
+            Array forwards =
+                model->forwardRate(fixing, referenceDate, y, iborIndexes[c]);
+            for (Size k = 0; k < y.size(); k++) {
+                Real expectedForward = model->forwardRate(
+                    fixing, referenceDate, y[k], iborIndexes[c]);
+                if (std::fabs(forwards[k] - expectedForward) > tol)
+                    BOOST_ERROR("forward rate on state grid ("
+                                << forwards[k] << ") deviates from "
+                                << "single forward rate (" << expectedForward
+                                << ") at fixing " << fixing << ", y="
+                                << y[k] << " for curve setup #" << c);
+                Real expected = model->swapRate(fixing, 10 * Years,
+                                                referenceDate, y[k],
+                                                indexes[c]);
+                // rates can be negative or close to zero
+                if (std::fabs(rates[k] - expected) > tol)
+                    BOOST_ERROR("swap rate on state grid ("
+                                << rates[k] << ") deviates from "
+                                << "single swap rate (" << expected
+                                << ") at fixing " << fixing << ", y="
+                                << y[k] << " for curve setup #" << c);
+                expected = model->swapAnnuity(fixing, 10 * Years,
+                                              referenceDate, y[k],
+                                              indexes[c]);
+                if (std::fabs(annuities[k] - expected) > tol * expected)
+                    BOOST_ERROR("annuity on state grid ("
+                                << annuities[k] << ") deviates from "
+                                << "single annuity (" << expected
+                                << ") at fixing " << fixing << ", y="
+                                << y[k] << " for curve setup #" << c);
+            }
+        }
+    }
+}
+
+void GsrTest::testFloatFloatSwaption() {
+
+    BOOST_TEST_MESSAGE("Testing GSR float-float swaption engine against "
+                       "nonstandard swaption engine...");
+
+    Date refDate = Settings::instance().evaluationDate();
+
+    Handle<YieldTermStructure> yts(boost::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+    boost::shared_ptr<IborIndex> euribor6m(new Euribor6M(yts));
+
+    Date effectiveDate = TARGET().advance(refDate, 2 * Days);
+    Date maturityDate = TARGET().advance(effectiveDate, 10 * Years);
+    Schedule fixedSchedule(effectiveDate, maturityDate, 1 * Years, TARGET(),
+                           ModifiedFollowing, ModifiedFollowing,
+                           DateGeneration::Forward, false);
+    Schedule floatingSchedule(effectiveDate, maturityDate, 6 * Months,
+                              TARGET(), ModifiedFollowing, ModifiedFollowing,
+                              DateGeneration::Forward, false);
+
+    // the fixed leg of the float-float swap is represented by ibor
+    // coupons with zero gearing
+    Real strike = 0.035;
+    boost::shared_ptr<NonstandardSwap> underlying(new NonstandardSwap(
+        VanillaSwap(VanillaSwap::Payer, 1.0, fixedSchedule, strike,
+                    Thirty360(), floatingSchedule, euribor6m, 0.0,
+                    Actual360())));
+    boost::shared_ptr<FloatFloatSwap> underlying2(new FloatFloatSwap(
+        VanillaSwap::Payer, 1.0, 1.0, fixedSchedule, euribor6m, Thirty360(),
+        floatingSchedule, euribor6m, Actual360(), false, false, 0.0,
+        strike));
+
+    std::vector<Date> exerciseDates;
+    for (Size i = 1; i < 10; ++i)
+        exerciseDates.push_back(
+            TARGET().advance(fixedSchedule[i], -2 * Days));
+    boost::shared_ptr<Exercise> exercise(
+        new BermudanExercise(exerciseDates, false));
+
+    boost::shared_ptr<NonstandardSwaption> swaption(
+        new NonstandardSwaption(underlying, exercise));
+    boost::shared_ptr<FloatFloatSwaption> swaption2(
+        new FloatFloatSwaption(underlying2, exercise));
+
+    std::vector<Date> stepDates(exerciseDates.begin(),
+                                exerciseDates.end() - 1);
+    std::vector<Real> sigmas(stepDates.size() + 1, 0.01);
+    boost::shared_ptr<Gsr> model(new Gsr(yts, stepDates, sigmas, 0.01));
+
+    swaption->setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new Gaussian1dNonstandardSwaptionEngine(model, 64, 7.0, true,
+                                                false)));
+    swaption2->setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new Gaussian1dFloatFloatSwaptionEngine(model, 64, 7.0, true,
+                                               false)));
+
+    Real npv = swaption->NPV();
+    Real npv2 = swaption2->NPV();
+    Real tol = 2E-6;
+    if (std::fabs(npv - npv2) > tol)
+        BOOST_ERROR("Gaussian1dFloatFloatSwaptionEngine NPV ("
+                    << npv2
+                    << ") deviates from Gaussian1dNonstandardSwaptionEngine "
+                    << "NPV (" << npv << ")");
+
+    // the calibration baskets are based on the underlying npvs as of
+    // the exercise dates, which the float-float engine calculates by
+    // rolling back the deal; the gamma of the underlying is obtained
+    // by finite differences, so that the baskets are only close
+    boost::shared_ptr<SwapIndex> swapBase(
+        new EuriborSwapIsdaFixA(10 * Years, yts));
+    boost::shared_ptr<SwaptionVolatilityStructure> swaptionVol(
+        new ConstantSwaptionVolatility(0, TARGET(), ModifiedFollowing, 0.20,
+                                       Actual365Fixed()));
+    std::vector<boost::shared_ptr<CalibrationHelper> > basket =
+        swaption->calibrationBasket(swapBase, swaptionVol);
+    std::vector<boost::shared_ptr<CalibrationHelper> > basket2 =
+        swaption2->calibrationBasket(swapBase, swaptionVol);
+
+    if (basket.size() != basket2.size())
+        BOOST_FAIL("calibration basket of float-float swaption has "
+                   << basket2.size() << " helpers, "
+                   << basket.size() << " expected");
+    for (Size i = 0; i < basket.size(); ++i) {
+        Real value = basket[i]->marketValue();
+        Real value2 = basket2[i]->marketValue();
+        if (std::fabs(value - value2) > 1E-2 * value)
+            BOOST_ERROR("market value of " << io::ordinal(i + 1)
+                        << " calibration helper of float-float swaption ("
+                        << value2 << ") deviates from nonstandard swaption ("
+                        << value << ")");
+    }
+}
+
 test_suite *GsrTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("GSR model tests");
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrProcess));
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrModel));
+    suite->add(QUANTLIB_TEST_CASE(&GsrTest::testZerobondGrid));
+    suite->add(QUANTLIB_TEST_CASE(&GsrTest::testSwapRateGrid));
+    suite->add(QUANTLIB_TEST_CASE(&GsrTest::testFloatFloatSwaption));
     return suite;
 }
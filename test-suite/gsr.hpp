@@ -29,6 +29,9 @@ class GsrTest {
   public:
     static void testGsrProcess();
     static void testGsrModel();
+    static void testZerobondGrid();
+    static void testSwapRateGrid();
+    static void testFloatFloatSwaption();
     static void testNonstandardSwaption();
     static void testDummy();
     static boost::unit_test_framework::test_suite *suite();
@@ -23,12 +23,16 @@
 #include <ql/instruments/dividendvanillaoption.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/memorypool.hpp>
 #include <ql/math/integrals/gausslobattointegral.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/batesengine.hpp>
+#include <ql/pricingengines/vanilla/ffthestonengine.hpp>
+#include <ql/termstructures/volatility/equityfx/hestonblackvolsurface.hpp>
 #include <ql/pricingengines/vanilla/hestonexpansionengine.hpp>
 #include <ql/pricingengines/vanilla/coshestonengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
@@ -2671,6 +2675,576 @@ void HestonModelTest::testPiecewiseTimeDependentChFAsymtotic() {
     }
 }
 
+void HestonModelTest::testStrikeBatchedAnalyticEngine() {
+    BOOST_TEST_MESSAGE("Testing strike batching of the analytic Heston "
+                       "engine...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2017);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const Handle<Quote> s0(boost::make_shared<SimpleQuote>(100.0));
+
+    const boost::shared_ptr<HestonProcess> process =
+        boost::make_shared<HestonProcess>(
+            riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.06, 0.5, -0.6);
+    const boost::shared_ptr<HestonModel> model =
+        boost::make_shared<HestonModel>(process);
+
+    std::vector<AnalyticHestonEngine::Integration> integrations;
+    integrations.push_back(
+        AnalyticHestonEngine::Integration::gaussLaguerre(160));
+    integrations.push_back(
+        AnalyticHestonEngine::Integration::gaussLegendre(256));
+
+    const Period maturities[] = { Period(3, Months), Period(1, Years),
+                                  Period(5, Years) };
+    const Real strikes[] = { 50.0, 80.0, 95.0, 100.0, 110.0, 150.0 };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    const Real tol = 1e-10;
+
+    for (Size l=0; l<integrations.size(); ++l) {
+        const Size order = integrations[l].numberOfEvaluations();
+        const boost::shared_ptr<AnalyticHestonEngine> engine =
+            boost::make_shared<AnalyticHestonEngine>(
+                model, AnalyticHestonEngine::Gatheral, integrations[l]);
+
+        for (Size run=0; run<2; ++run) {
+            if (run == 1) {
+                // a change in the model parameters must reset the cache
+                Array params = model->params();
+                params[0] = 0.08; params[3] = -0.3;
+                model->setParams(params);
+            }
+
+            for (Size i=0; i<LENGTH(maturities); ++i) {
+                const Date maturity = settlementDate + maturities[i];
+                const boost::shared_ptr<Exercise> exercise =
+                    boost::make_shared<EuropeanExercise>(maturity);
+                const Time term = process->time(maturity);
+
+                for (Size j=0; j<LENGTH(strikes); ++j) {
+                    for (Size k=0; k<LENGTH(types); ++k) {
+                        const boost::shared_ptr<PlainVanillaPayoff> payoff =
+                            boost::make_shared<PlainVanillaPayoff>(
+                                                    types[k], strikes[j]);
+                        VanillaOption option(payoff, exercise);
+                        option.setPricingEngine(engine);
+                        const Real calculated = option.NPV();
+
+                        Real expected;
+                        Size evaluations;
+                        AnalyticHestonEngine::doCalculation(
+                            riskFreeTS->discount(maturity),
+                            dividendTS->discount(maturity),
+                            s0->value(), strikes[j], term,
+                            model->kappa(), model->theta(), model->sigma(),
+                            model->v0(), model->rho(), *payoff,
+                            integrations[l], AnalyticHestonEngine::Gatheral,
+                            engine.get(), expected, evaluations);
+
+                        if (std::fabs(calculated-expected) > tol)
+                            BOOST_ERROR("failed to reproduce Heston price "
+                                        "with strike batching"
+                                        << "\n    maturity:   "
+                                        << maturities[i]
+                                        << "\n    strike:     "
+                                        << strikes[j]
+                                        << "\n    type:       " << types[k]
+                                        << std::setprecision(12)
+                                        << "\n    calculated: " << calculated
+                                        << "\n    expected:   " << expected);
+
+                        // the characteristic function is only evaluated
+                        // for the first option of each expiry
+                        const Size expectedEvaluations =
+                            (j == 0 && k == 0) ? 2*order : 0;
+                        if (engine->numberOfEvaluations()
+                                                  != expectedEvaluations)
+                            BOOST_ERROR("unexpected number of evaluations"
+                                        << "\n    maturity:   "
+                                        << maturities[i]
+                                        << "\n    strike:     "
+                                        << strikes[j]
+                                        << "\n    calculated: "
+                                        << engine->numberOfEvaluations()
+                                        << "\n    expected:   "
+                                        << expectedEvaluations);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void HestonModelTest::testStrikeBatchedPiecewiseTimeDependentEngines() {
+    BOOST_TEST_MESSAGE("Testing strike batching of the piecewise time "
+                       "dependent and expansion Heston engines...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2017);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dc = Actual365Fixed();
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.02, dc));
+    const Handle<Quote> s0(boost::make_shared<SimpleQuote>(100.0));
+
+    std::vector<Time> modelTimes;
+    modelTimes.push_back(0.25);
+    modelTimes.push_back(0.75);
+    modelTimes.push_back(10.0);
+    const TimeGrid modelGrid(modelTimes.begin(), modelTimes.end());
+
+    ConstantParameter theta(0.1, PositiveConstraint());
+    ConstantParameter kappa(1.0, PositiveConstraint());
+    ConstantParameter rho(-0.75, BoundaryConstraint(-1.0, 1.0));
+    std::vector<Time> pTimes(2);
+    pTimes[0] = 0.25;
+    pTimes[1] = 0.75;
+    PiecewiseConstantParameter sigma(pTimes, PositiveConstraint());
+    sigma.setParam(0, 0.30);
+    sigma.setParam(1, 0.15);
+    sigma.setParam(2, 1.25);
+
+    const boost::shared_ptr<PiecewiseTimeDependentHestonModel> ptdModel =
+        boost::make_shared<PiecewiseTimeDependentHestonModel>(
+            rTS, qTS, s0, 0.1, theta, kappa, sigma, rho, modelGrid);
+
+    const Size order = 144;
+    const boost::shared_ptr<AnalyticPTDHestonEngine> batchedEngine =
+        boost::make_shared<AnalyticPTDHestonEngine>(ptdModel, order);
+    const boost::shared_ptr<AnalyticPTDHestonEngine> referenceEngine =
+        boost::make_shared<AnalyticPTDHestonEngine>(
+            ptdModel, AnalyticPTDHestonEngine::AndersenPiterbarg,
+            AnalyticPTDHestonEngine::Integration::discreteTrapezoid(256),
+            1e-12);
+
+    const boost::shared_ptr<HestonModel> model =
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                rTS, qTS, s0, 0.04, 1.5, 0.06, 0.5, -0.6));
+    const boost::shared_ptr<HestonExpansionEngine> expansionEngine =
+        boost::make_shared<HestonExpansionEngine>(
+            model, HestonExpansionEngine::LPP3);
+
+    const Period maturities[] = { Period(3, Months), Period(1, Years),
+                                  Period(2, Years) };
+    const Real strikes[] = { 60.0, 80.0, 95.0, 100.0, 110.0, 140.0 };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    for (Size run=0; run<2; ++run) {
+        if (run == 1) {
+            // a change in the model parameters must reset the caches
+            Array params = ptdModel->params();
+            params[3] = 0.5;
+            ptdModel->setParams(params);
+
+            params = model->params();
+            params[0] = 0.08; params[3] = -0.3;
+            model->setParams(params);
+        }
+
+        for (Size i=0; i<LENGTH(maturities); ++i) {
+            const boost::shared_ptr<Exercise> exercise =
+                boost::make_shared<EuropeanExercise>(
+                                       settlementDate + maturities[i]);
+
+            for (Size j=0; j<LENGTH(strikes); ++j) {
+                for (Size k=0; k<LENGTH(types); ++k) {
+                    VanillaOption option(
+                        boost::make_shared<PlainVanillaPayoff>(
+                                                   types[k], strikes[j]),
+                        exercise);
+
+                    option.setPricingEngine(batchedEngine);
+                    const Real calculated = option.NPV();
+
+                    // the characteristic function is only evaluated
+                    // for the first option of each expiry
+                    const Size expectedEvaluations =
+                        (j == 0 && k == 0) ? 2*order : 0;
+                    if (batchedEngine->numberOfEvaluations()
+                                                  != expectedEvaluations)
+                        BOOST_ERROR("unexpected number of evaluations"
+                                    << "\n    maturity:   "
+                                    << maturities[i]
+                                    << "\n    strike:     " << strikes[j]
+                                    << "\n    calculated: "
+                                    << batchedEngine->numberOfEvaluations()
+                                    << "\n    expected:   "
+                                    << expectedEvaluations);
+
+                    option.setPricingEngine(referenceEngine);
+                    const Real expected = option.NPV();
+
+                    if (std::fabs(calculated-expected) > 1e-8)
+                        BOOST_ERROR("failed to reproduce piecewise time "
+                                    "dependent Heston price with strike "
+                                    "batching"
+                                    << "\n    maturity:   "
+                                    << maturities[i]
+                                    << "\n    strike:     " << strikes[j]
+                                    << "\n    type:       " << types[k]
+                                    << std::setprecision(12)
+                                    << "\n    calculated: " << calculated
+                                    << "\n    expected:   " << expected);
+
+                    option.setPricingEngine(expansionEngine);
+                    const Real calculatedExpansion = option.NPV();
+                    option.setPricingEngine(
+                        boost::make_shared<HestonExpansionEngine>(
+                                      model, HestonExpansionEngine::LPP3));
+                    const Real expectedExpansion = option.NPV();
+
+                    if (std::fabs(calculatedExpansion-expectedExpansion)
+                                                                 > 1e-14)
+                        BOOST_ERROR("failed to reproduce Heston expansion "
+                                    "price with stored coefficients"
+                                    << "\n    maturity:   "
+                                    << maturities[i]
+                                    << "\n    strike:     " << strikes[j]
+                                    << "\n    type:       " << types[k]
+                                    << std::setprecision(12)
+                                    << "\n    calculated: "
+                                    << calculatedExpansion
+                                    << "\n    expected:   "
+                                    << expectedExpansion);
+                }
+            }
+        }
+    }
+}
+
+namespace {
+
+    void checkParameterGradient(
+                 const boost::shared_ptr<HestonModel>& model,
+                 const boost::shared_ptr<AnalyticHestonEngine>& engine,
+                 const Date& settlementDate,
+                 const std::string& name) {
+
+        if (!engine->hasValueGradient()) {
+            BOOST_ERROR("parameter gradient not available for " << name);
+            return;
+        }
+
+        const Period maturities[] = { Period(2, Months), Period(1, Years),
+                                      Period(3, Years) };
+        const Real strikes[] = { 70.0, 100.0, 130.0 };
+        const Array params = model->params();
+
+        for (Size i=0; i<LENGTH(maturities); ++i) {
+            for (Size j=0; j<LENGTH(strikes); ++j) {
+                VanillaOption option(
+                    boost::make_shared<PlainVanillaPayoff>(
+                                                Option::Call, strikes[j]),
+                    boost::make_shared<EuropeanExercise>(
+                                      settlementDate + maturities[i]));
+                option.setPricingEngine(engine);
+
+                VanillaOption::arguments arguments;
+                option.setupArguments(&arguments);
+                const Array calculated = engine->valueGradient(arguments);
+
+                for (Size k=0; k<params.size(); ++k) {
+                    const Real h = 1e-5;
+                    Array bumped(params);
+                    bumped[k] = params[k] + h;
+                    model->setParams(bumped);
+                    const Real up = option.NPV();
+                    bumped[k] = params[k] - h;
+                    model->setParams(bumped);
+                    const Real down = option.NPV();
+                    model->setParams(params);
+
+                    const Real expected = (up-down)/(2*h);
+                    if (std::fabs(calculated[k]-expected) > 1e-5)
+                        BOOST_ERROR("failed to reproduce parameter gradient"
+                                    << "\n    engine:     " << name
+                                    << "\n    maturity:   "
+                                    << maturities[i]
+                                    << "\n    strike:     " << strikes[j]
+                                    << "\n    parameter:  " << k
+                                    << std::setprecision(10)
+                                    << "\n    calculated: " << calculated[k]
+                                    << "\n    expected:   " << expected);
+                }
+            }
+        }
+    }
+
+}
+
+void HestonModelTest::testAnalyticParameterGradient() {
+    BOOST_TEST_MESSAGE("Testing analytic parameter gradient of "
+                       "Heston and Bates engines...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2017);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Calendar calendar = NullCalendar();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const Handle<Quote> s0(boost::make_shared<SimpleQuote>(100.0));
+
+    const boost::shared_ptr<HestonModel> hestonModel =
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.06, 0.5, -0.6));
+    checkParameterGradient(
+        hestonModel,
+        boost::make_shared<AnalyticHestonEngine>(hestonModel, 160),
+        settlementDate, "AnalyticHestonEngine");
+    checkParameterGradient(
+        hestonModel,
+        boost::make_shared<AnalyticHestonEngine>(
+            hestonModel, AnalyticHestonEngine::Gatheral,
+            AnalyticHestonEngine::Integration::gaussLegendre(256)),
+        settlementDate, "AnalyticHestonEngine with Gauss-Legendre");
+
+    const boost::shared_ptr<BatesModel> batesModel =
+        boost::make_shared<BatesModel>(
+            boost::make_shared<BatesProcess>(
+                riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.06, 0.5, -0.6,
+                0.3, -0.1, 0.15));
+    checkParameterGradient(
+        batesModel, boost::make_shared<BatesEngine>(batesModel, 160),
+        settlementDate, "BatesEngine");
+
+    // adaptive integrations don't provide the gradient
+    if (AnalyticHestonEngine(hestonModel, 1e-8, 1000).hasValueGradient())
+        BOOST_ERROR("parameter gradient unexpectedly available "
+                    "with adaptive integration");
+
+    // calibration to prices generated by a known model using the
+    // analytic Jacobian
+    std::vector<boost::shared_ptr<CalibrationHelper> > helpers;
+    const Period maturities[] = { Period(3, Months), Period(6, Months),
+                                  Period(1, Years), Period(2, Years) };
+    const Real strikes[] = { 80.0, 90.0, 100.0, 110.0, 120.0 };
+    const boost::shared_ptr<PricingEngine> referenceEngine =
+        boost::make_shared<AnalyticHestonEngine>(hestonModel, 160);
+    for (Size i=0; i<LENGTH(maturities); ++i) {
+        for (Size j=0; j<LENGTH(strikes); ++j) {
+            const boost::shared_ptr<SimpleQuote> vol =
+                boost::make_shared<SimpleQuote>(0.2);
+            const boost::shared_ptr<HestonModelHelper> helper =
+                boost::make_shared<HestonModelHelper>(
+                    maturities[i], calendar, s0, strikes[j],
+                    Handle<Quote>(vol), riskFreeTS, dividendTS,
+                    CalibrationHelper::PriceError);
+            helper->setPricingEngine(referenceEngine);
+            vol->setValue(helper->impliedVolatility(
+                       helper->modelValue(), 1e-12, 1000, 0.001, 10.0));
+            helpers.push_back(helper);
+        }
+    }
+
+    const boost::shared_ptr<HestonModel> model =
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS, s0, 0.05, 1.0, 0.05, 0.4, -0.4));
+    const boost::shared_ptr<PricingEngine> engine =
+        boost::make_shared<AnalyticHestonEngine>(model, 160);
+    for (Size i=0; i<helpers.size(); ++i) {
+        helpers[i]->setPricingEngine(engine);
+        if (!helpers[i]->hasModelValueGradient())
+            BOOST_FAIL("model value gradient not available");
+    }
+
+    LevenbergMarquardt om(1e-10, 1e-10, 1e-10, true);
+    model->calibrate(helpers, om,
+                     EndCriteria(400, 40, 1.0e-10, 1.0e-10, 1.0e-10));
+
+    Real error = 0.0;
+    for (Size i=0; i<helpers.size(); ++i)
+        error += square<Real>()(helpers[i]->calibrationError());
+    error = std::sqrt(error);
+
+    const Real tol = 1e-6;
+    if (error > tol)
+        BOOST_ERROR("failed to calibrate Heston model with analytic Jacobian"
+                    << "\n    calibration error: " << error
+                    << "\n    tolerance:         " << tol
+                    << "\n    parameters:        " << model->params());
+}
+
+void HestonModelTest::testFFTEngine() {
+    BOOST_TEST_MESSAGE("Testing Carr-Madan FFT engines for the Heston "
+                       "and Bates models...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2017);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const Handle<Quote> s0(boost::make_shared<SimpleQuote>(100.0));
+
+    const boost::shared_ptr<HestonModel> hestonModel =
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.06, 0.5, -0.6));
+    const boost::shared_ptr<BatesModel> batesModel =
+        boost::make_shared<BatesModel>(
+            boost::make_shared<BatesProcess>(
+                riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.06, 0.5, -0.6,
+                0.3, -0.1, 0.15));
+
+    // the default grid is accurate to about 1e-4; a finer spacing
+    // of the integration grid is needed for the tolerance below
+    const Size log2n = 14;
+
+    std::vector<boost::shared_ptr<PricingEngine> > fftEngines, engines;
+    std::vector<std::string> names;
+    fftEngines.push_back(
+        boost::make_shared<FFTHestonEngine>(hestonModel, log2n));
+    engines.push_back(boost::make_shared<AnalyticHestonEngine>(
+        hestonModel, AnalyticHestonEngine::Gatheral,
+        AnalyticHestonEngine::Integration::gaussLaguerre(192)));
+    names.push_back("Heston");
+    fftEngines.push_back(
+        boost::make_shared<FFTBatesEngine>(batesModel, log2n));
+    engines.push_back(boost::make_shared<BatesEngine>(batesModel, 192));
+    names.push_back("Bates");
+
+    const Period maturities[] = { Period(1, Months), Period(6, Months),
+                                  Period(2, Years), Period(10, Years) };
+    const Real strikes[] = { 50.0, 75.0, 90.0, 99.5, 100.0, 112.3,
+                             150.0, 200.0 };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    const Real tol = 1e-6;
+    for (Size l=0; l<engines.size(); ++l) {
+        for (Size i=0; i<LENGTH(maturities); ++i) {
+            const boost::shared_ptr<Exercise> exercise =
+                boost::make_shared<EuropeanExercise>(
+                                      settlementDate + maturities[i]);
+            for (Size j=0; j<LENGTH(strikes); ++j) {
+                for (Size k=0; k<LENGTH(types); ++k) {
+                    VanillaOption option(
+                        boost::make_shared<PlainVanillaPayoff>(
+                                                 types[k], strikes[j]),
+                        exercise);
+                    option.setPricingEngine(fftEngines[l]);
+                    const Real calculated = option.NPV();
+                    option.setPricingEngine(engines[l]);
+                    const Real expected = option.NPV();
+
+                    if (std::fabs(calculated-expected) > tol)
+                        BOOST_ERROR("failed to reproduce " << names[l]
+                                    << " price with FFT engine"
+                                    << "\n    maturity:   "
+                                    << maturities[i]
+                                    << "\n    strike:     " << strikes[j]
+                                    << "\n    type:       " << types[k]
+                                    << std::setprecision(12)
+                                    << "\n    calculated: " << calculated
+                                    << "\n    expected:   " << expected
+                                    << "\n    tolerance:  " << tol);
+                }
+            }
+        }
+    }
+
+    // the volatility surface gives the same smile with the FFT engine
+    const Handle<HestonModel> hestonHandle(hestonModel);
+    const HestonBlackVolSurface surface(hestonHandle);
+    const HestonBlackVolSurface fftSurface(
+        hestonHandle,
+        boost::make_shared<FFTHestonEngine>(hestonModel, log2n));
+    // the wings of the shortest maturity are worth less than the
+    // accuracy of the transform and have no meaningful volatility
+    for (Size i=1; i<LENGTH(maturities); ++i) {
+        const Date maturity = settlementDate + maturities[i];
+        for (Size j=0; j<LENGTH(strikes); ++j) {
+            const Volatility expected = surface.blackVol(maturity, strikes[j]);
+            const Volatility calculated =
+                fftSurface.blackVol(maturity, strikes[j]);
+            if (std::fabs(calculated-expected) > 1e-6)
+                BOOST_ERROR("failed to reproduce Heston implied volatility "
+                            << "with FFT engine"
+                            << "\n    maturity:   " << maturities[i]
+                            << "\n    strike:     " << strikes[j]
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
+void HestonModelTest::testFixedSizeEvolve() {
+    BOOST_TEST_MESSAGE("Testing fixed-size evolution of Heston processes...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2017);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const Handle<Quote> s0(boost::make_shared<SimpleQuote>(100.0));
+
+    const HestonProcess::Discretization discretizations[] = {
+        HestonProcess::PartialTruncation,
+        HestonProcess::FullTruncation,
+        HestonProcess::Reflection,
+        HestonProcess::NonCentralChiSquareVariance,
+        HestonProcess::QuadraticExponential,
+        HestonProcess::QuadraticExponentialMartingale,
+        HestonProcess::BroadieKayaExactSchemeTrapezoidal
+    };
+
+    Array x0(2), dw(3);
+    x0[0] = 95.0;  x0[1] = 0.05;
+    dw[0] = 0.7;   dw[1] = -1.2;  dw[2] = 0.3;
+    FixedArray<2> fx0(x0);
+    FixedArray<3> fdw(dw);
+    const Time t0 = 0.5, dt = 0.1;
+
+    for (Size i=0; i<LENGTH(discretizations); ++i) {
+        const HestonProcess process(riskFreeTS, dividendTS, s0,
+                                    0.04, 1.5, 0.06, 0.5, -0.6,
+                                    discretizations[i]);
+
+        const Array x = process.evolve(t0, x0, dt, dw);
+        MemoryPool::resetCounters();
+        const FixedArray<2> fx = process.evolve(t0, fx0, dt, fdw);
+        if (MemoryPool::heapAllocations() != 0)
+            BOOST_ERROR(MemoryPool::heapAllocations()
+                        << " arrays allocated by fixed-size evolution");
+        if (fx[0] != x[0] || fx[1] != x[1])
+            BOOST_ERROR("fixed-size evolution differs from dynamic one"
+                        << "\n    discretization: " << discretizations[i]
+                        << "\n    fixed-size:     " << fx
+                        << "\n    dynamic:        " << x);
+
+        const Array drift = process.drift(t0, x0);
+        const FixedArray<2> fdrift = process.drift(t0, fx0);
+        const Matrix diffusion = process.diffusion(t0, x0);
+        const FixedMatrix<2,2> fdiffusion = process.diffusion(t0, fx0);
+        if (fdrift != FixedArray<2>(drift)
+            || !std::equal(diffusion.begin(), diffusion.end(),
+                           fdiffusion.begin()))
+            BOOST_ERROR("fixed-size drift or diffusion differs from "
+                        "dynamic one"
+                        << "\n    discretization: " << discretizations[i]);
+    }
+}
+
 test_suite* HestonModelTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Heston model tests");
 
@@ -2709,6 +3283,14 @@ test_suite* HestonModelTest::suite(SpeedLevel speed) {
         &HestonModelTest::testPiecewiseTimeDependentComparison));
     suite->add(QUANTLIB_TEST_CASE(
         &HestonModelTest::testPiecewiseTimeDependentChFAsymtotic));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonModelTest::testStrikeBatchedAnalyticEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonModelTest::testStrikeBatchedPiecewiseTimeDependentEngines));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonModelTest::testAnalyticParameterGradient));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFFTEngine));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFixedSizeEvolve));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -54,6 +54,11 @@ class HestonModelTest {
     static void testPiecewiseTimeDependentChFvsHestonChF();
     static void testPiecewiseTimeDependentComparison();
     static void testPiecewiseTimeDependentChFAsymtotic();
+    static void testStrikeBatchedAnalyticEngine();
+    static void testStrikeBatchedPiecewiseTimeDependentEngines();
+    static void testAnalyticParameterGradient();
+    static void testFFTEngine();
+    static void testFixedSizeEvolve();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
     static boost::unit_test_framework::test_suite* experimental();
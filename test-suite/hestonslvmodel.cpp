@@ -63,6 +63,7 @@
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/predefined1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/uniform1dmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/uniformgridmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
@@ -2483,6 +2484,86 @@ void HestonSLVModelTest::testMoustacheGraph() {
     }
 }
 
+void HestonSLVModelTest::testHestonFwdOpInPlace() {
+    BOOST_TEST_MESSAGE("Testing in-place application of the "
+                       "Heston forward operator...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate = Date(28, Dec, 2012);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Handle<Quote> spot(boost::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(todaysDate, 0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(todaysDate, 0.02, dc));
+
+    const boost::shared_ptr<HestonProcess> hestonProcess(
+        boost::make_shared<HestonProcess>(
+            rTS, qTS, spot, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    const boost::shared_ptr<LocalVolTermStructure> leverageFct(
+        boost::make_shared<LocalConstantVol>(todaysDate, 1.2, dc));
+
+    const FdmSquareRootFwdOp::TransformationType types[] = {
+        FdmSquareRootFwdOp::Plain, FdmSquareRootFwdOp::Log };
+    const Real vLower[] = { 0.01, std::log(0.01) };
+    const Real vUpper[] = { 1.0, 0.0 };
+
+    for (Size i=0; i < LENGTH(types); ++i) {
+        std::vector<Size> dim(2);
+        dim[0] = 60; dim[1] = 30;
+        std::vector<std::pair<Real, Real> > boundaries;
+        boundaries.push_back(std::make_pair(std::log(20.0), std::log(500.0)));
+        boundaries.push_back(std::make_pair(vLower[i], vUpper[i]));
+        const boost::shared_ptr<FdmMesher> mesher(
+            boost::make_shared<UniformGridMesher>(
+                boost::make_shared<FdmLinearOpLayout>(dim), boundaries));
+
+        for (Size j=0; j < 2; ++j) {
+            const boost::shared_ptr<FdmHestonFwdOp> op(
+                boost::make_shared<FdmHestonFwdOp>(
+                    mesher, hestonProcess, types[i],
+                    j == 0 ? boost::shared_ptr<LocalVolTermStructure>()
+                           : leverageFct));
+            op->setTime(0.5, 0.51);
+
+            Array u(mesher->layout()->size());
+            for (Size k=0; k < u.size(); ++k)
+                u[k] = std::sin(0.1*k) + 1.0;
+
+            Array out(u.size());
+            op->apply(u, out);
+            if (op->apply(u) != out)
+                BOOST_FAIL("in-place apply differs from the allocating one"
+                           << "\n    transformation: " << types[i]
+                           << "\n    leverage:       " << j);
+            op->apply_mixed(u, out);
+            if (op->apply_mixed(u) != out)
+                BOOST_FAIL("in-place apply_mixed differs from the "
+                           "allocating one"
+                           << "\n    transformation: " << types[i]
+                           << "\n    leverage:       " << j);
+            for (Size d=0; d < 2; ++d) {
+                op->apply_direction(d, u, out);
+                if (op->apply_direction(d, u) != out)
+                    BOOST_FAIL("in-place apply_direction differs from the "
+                               "allocating one"
+                               << "\n    direction:      " << d
+                               << "\n    transformation: " << types[i]
+                               << "\n    leverage:       " << j);
+                op->solve_splitting(d, u, -0.01, out);
+                if (op->solve_splitting(d, u, -0.01) != out)
+                    BOOST_FAIL("in-place solve_splitting differs from the "
+                               "allocating one"
+                               << "\n    direction:      " << d
+                               << "\n    transformation: " << types[i]
+                               << "\n    leverage:       " << j);
+            }
+        }
+    }
+}
+
 
 test_suite* HestonSLVModelTest::experimental(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE(
@@ -2502,6 +2583,8 @@ test_suite* HestonSLVModelTest::experimental(SpeedLevel speed) {
         &HestonSLVModelTest::testHestonFokkerPlanckFwdEquationLogLVLeverage));
     suite->add(QUANTLIB_TEST_CASE(
         &HestonSLVModelTest::testBarrierPricingViaHestonLocalVol));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonSLVModelTest::testHestonFwdOpInPlace));
     suite->add(QUANTLIB_TEST_CASE(
         &HestonSLVModelTest::testMonteCarloVsFdmPricing));
 
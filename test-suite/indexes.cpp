@@ -0,0 +1,170 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "indexes.hpp"
+#include "utilities.hpp"
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <sstream>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+void IndexTest::testFixingObservability() {
+    BOOST_TEST_MESSAGE("Testing observability of index fixings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    boost::shared_ptr<IborIndex> index(new Euribor6M);
+    Flag flag;
+    flag.registerWith(index);
+
+    Date fixingDate = Date(14, March, 2018);
+    index->addFixing(fixingDate, 0.01);
+    if (!flag.isUp())
+        BOOST_FAIL("observer was not notified of added fixing");
+
+    flag.lower();
+    index->clearFixings();
+    if (!flag.isUp())
+        BOOST_FAIL("observer was not notified of cleared fixings");
+
+    // the registration must survive clearing the history
+    flag.lower();
+    index->addFixing(fixingDate, 0.02);
+    if (!flag.isUp())
+        BOOST_FAIL("observer was not notified of fixing added "
+                   "after clearing");
+
+    flag.lower();
+    TimeSeries<Real> history;
+    history[fixingDate] = 0.03;
+    IndexManager::instance().setHistory(index->name(), history);
+    if (!flag.isUp())
+        BOOST_FAIL("observer was not notified of replaced history");
+}
+
+void IndexTest::testFixingStorage() {
+    BOOST_TEST_MESSAGE("Testing storage of index fixings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today = Date(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+    boost::shared_ptr<IborIndex> index(new Euribor6M);
+
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    for (Date d = today - 2*Years; d < today; ++d) {
+        if (index->isValidFixingDate(d)) {
+            dates.push_back(d);
+            values.push_back(0.01 + 1.0e-5*dates.size());
+        }
+    }
+    // added in reverse order to exercise the growth of the store
+    index->addFixings(dates.rbegin(), dates.rend(), values.rbegin());
+
+    const TimeSeries<Real>& history = index->timeSeries();
+    if (history.size() != dates.size())
+        BOOST_ERROR("history has " << history.size() << " fixings; "
+                    << dates.size() << " expected");
+    for (Size i=0; i<dates.size(); ++i) {
+        if (index->fixing(dates[i]) != values[i])
+            BOOST_ERROR("wrong fixing for " << dates[i] << ":"
+                        << "\n    retrieved: " << index->fixing(dates[i])
+                        << "\n    expected:  " << values[i]);
+        if (history[dates[i]] != values[i])
+            BOOST_ERROR("wrong time-series value for " << dates[i]);
+    }
+
+    // conflicting fixings are rejected, and the stored value is kept
+    BOOST_CHECK_THROW(index->addFixing(dates[0], 0.05), Error);
+    if (index->fixing(dates[0]) != values[0])
+        BOOST_ERROR("stored fixing modified by rejected duplicate");
+    index->addFixing(dates[0], 0.05, true);
+    if (index->fixing(dates[0]) != 0.05)
+        BOOST_ERROR("stored fixing not overwritten");
+    if (history[dates[0]] != 0.05)
+        BOOST_ERROR("time series not updated after overwriting fixing");
+
+    IndexManager& manager = IndexManager::instance();
+    if (!manager.hasHistory(index->name()))
+        BOOST_ERROR("history of " << index->name() << " not found");
+    index->clearFixings();
+    if (manager.hasHistory(index->name()))
+        BOOST_ERROR("history of " << index->name() << " not cleared");
+    if (!history.empty())
+        BOOST_ERROR("time series not emptied after clearing fixings");
+    BOOST_CHECK_THROW(index->fixing(dates[0]), Error);
+}
+
+void IndexTest::testFixingPersistence() {
+    BOOST_TEST_MESSAGE("Testing bulk saving and loading of index fixings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today = Date(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+    boost::shared_ptr<IborIndex> euribor3m(new Euribor3M),
+                                 euribor6m(new Euribor6M);
+
+    std::vector<Date> dates;
+    for (Date d = today - 1*Years; d < today; ++d)
+        if (TARGET().isBusinessDay(d))
+            dates.push_back(d);
+    for (Size i=0; i<dates.size(); ++i) {
+        euribor3m->addFixing(dates[i], 0.01 + 1.0e-5*i);
+        if (i % 5 == 0)
+            euribor6m->addFixing(dates[i], 0.02 + 1.0e-5*i);
+    }
+
+    IndexManager& manager = IndexManager::instance();
+    std::stringstream data;
+    manager.save(data);
+    manager.clearHistories();
+
+    Flag flag;
+    flag.registerWith(euribor6m);
+    manager.load(data);
+    if (!flag.isUp())
+        BOOST_ERROR("observer was not notified of loaded fixings");
+
+    for (Size i=0; i<dates.size(); ++i) {
+        if (euribor3m->fixing(dates[i]) != 0.01 + 1.0e-5*i)
+            BOOST_ERROR("wrong " << euribor3m->name() << " fixing for "
+                        << dates[i] << " after loading");
+        Real expected = i % 5 == 0 ? 0.02 + 1.0e-5*i : Null<Real>();
+        if (euribor6m->timeSeries()[dates[i]] != expected)
+            BOOST_ERROR("wrong " << euribor6m->name() << " fixing for "
+                        << dates[i] << " after loading");
+    }
+
+    std::stringstream garbage("not fixing data");
+    BOOST_CHECK_THROW(manager.load(garbage), Error);
+}
+
+test_suite* IndexTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Index tests");
+    suite->add(QUANTLIB_TEST_CASE(&IndexTest::testFixingObservability));
+    suite->add(QUANTLIB_TEST_CASE(&IndexTest::testFixingStorage));
+    suite->add(QUANTLIB_TEST_CASE(&IndexTest::testFixingPersistence));
+    return suite;
+}
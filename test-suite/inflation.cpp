@@ -470,6 +470,24 @@ void InflationTest::testZeroTermStructure() {
         }
     }
 
+    //Testing bulk fixings and zero rates with seasonality
+    //
+    std::vector<Date> bulkDates;
+    for (Size i=0; i<testIndex.size(); i++)
+        bulkDates.push_back(testIndex[i] + 13);
+    std::vector<Rate> bulkFixings = ii->fixings(bulkDates);
+    std::vector<Rate> bulkZeros = hz->zeroRates(bulkDates, Period(0,Days));
+    for (Size i=0; i<bulkDates.size(); i++) {
+        if (std::fabs(bulkFixings[i] - ii->fixing(bulkDates[i])) > 1.0e-12)
+            BOOST_ERROR("bulk fixing differs from single fixing for "
+                        << bulkDates[i] << ": " << bulkFixings[i]
+                        << " vs " << ii->fixing(bulkDates[i]));
+        if (std::fabs(bulkZeros[i] - hz->zeroRate(bulkDates[i], Period(0,Days))) > 1.0e-12)
+            BOOST_ERROR("bulk zero rate differs from single zero rate for "
+                        << bulkDates[i] << ": " << bulkZeros[i]
+                        << " vs " << hz->zeroRate(bulkDates[i], Period(0,Days)));
+    }
+
     //Testing Unset function
     //
     QL_REQUIRE(hz->hasSeasonality(),"[4] incorrectly believes NO seasonality correction");
@@ -23,8 +23,18 @@
 #include <ql/instruments/compositeinstrument.hpp>
 #include <ql/instruments/europeanoption.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/pricingengines/cachingengine.hpp>
+#include <ql/experimental/risk/scenariorunner.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/pricingengines/portfoliopricer.hpp>
+#include <ql/pricingengines/pricingenginepool.hpp>
+#include <ql/pricingengines/valuationqueue.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/daycounters/actual360.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -114,11 +124,535 @@ void InstrumentTest::testCompositeWhenShiftingDates() {
         BOOST_FAIL("Composite didn't recalculate");
 }
 
+
+namespace {
+
+    struct AnalyticEuropeanEngineFactory {
+        explicit AnalyticEuropeanEngineFactory(
+              const shared_ptr<GeneralizedBlackScholesProcess>& process)
+        : process(process) {}
+        shared_ptr<PricingEngine> operator()() const {
+            return shared_ptr<PricingEngine>(
+                                       new AnalyticEuropeanEngine(process));
+        }
+        shared_ptr<GeneralizedBlackScholesProcess> process;
+    };
+
+    struct ConstantEngineFactory {
+        explicit ConstantEngineFactory(const shared_ptr<PricingEngine>& e)
+        : engine(e) {}
+        shared_ptr<PricingEngine> operator()() const { return engine; }
+        shared_ptr<PricingEngine> engine;
+    };
+
+    class CountingObject : public LazyObject {
+      public:
+        CountingObject() : calculations(0) {}
+        mutable Size calculations;
+      private:
+        void performCalculations() const { ++calculations; }
+    };
+
+    std::string europeanOptionKey(const OneAssetOption::arguments& args) {
+        shared_ptr<StrikedTypePayoff> payoff =
+            boost::dynamic_pointer_cast<StrikedTypePayoff>(args.payoff);
+        std::ostringstream key;
+        key << std::setprecision(17) << payoff->optionType() << " "
+            << payoff->strike() << " " << args.exercise->lastDate();
+        return key.str();
+    }
+
+}
+
+void InstrumentTest::testPortfolioPricer() {
+
+    BOOST_TEST_MESSAGE("Testing concurrent pricing of a portfolio...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    DayCounter dc = Actual360();
+
+    shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    shared_ptr<BlackScholesMertonProcess> process1(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(
+                                                      flatRate(0.0, dc)),
+                                      Handle<YieldTermStructure>(
+                                                      flatRate(0.01, dc)),
+                                      Handle<BlackVolTermStructure>(
+                                                      flatVol(0.1, dc))));
+    shared_ptr<BlackScholesMertonProcess> process2(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(
+                                                      flatRate(0.02, dc)),
+                                      Handle<YieldTermStructure>(
+                                                      flatRate(0.03, dc)),
+                                      Handle<BlackVolTermStructure>(
+                                                      flatVol(0.2, dc))));
+
+    PortfolioPricer pricer;
+    Size group1 = pricer.addGroup(AnalyticEuropeanEngineFactory(process1));
+    Size group2 = pricer.addGroup(AnalyticEuropeanEngineFactory(process2));
+
+    std::vector<Real> expected;
+    for (Size i=0; i<50; ++i) {
+        Option::Type type = (i % 2 == 0 ? Option::Call : Option::Put);
+        shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(type, 80.0 + i));
+        shared_ptr<Exercise> exercise(
+                                 new EuropeanExercise(today + 30*(i+1)));
+        shared_ptr<Instrument> option(new EuropeanOption(payoff, exercise));
+
+        Size group = (i % 3 == 0 ? group2 : group1);
+        option->setPricingEngine(
+                group == group1 ? AnalyticEuropeanEngineFactory(process1)()
+                                : AnalyticEuropeanEngineFactory(process2)());
+        expected.push_back(option->NPV());
+        pricer.add(option, group);
+    }
+
+    // an engine can't price American options; the error is recorded
+    shared_ptr<Instrument> american(
+        new VanillaOption(shared_ptr<StrikedTypePayoff>(
+                                 new PlainVanillaPayoff(Option::Put, 100.0)),
+                          shared_ptr<Exercise>(
+                                 new AmericanExercise(today, today+360))));
+    Size failing = pricer.add(american, group1);
+
+    pricer.calculate();
+
+    for (Size i=0; i<expected.size(); ++i) {
+        if (pricer.NPV(i) != expected[i])
+            BOOST_ERROR("wrong NPV for instrument #" << i << ":"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << pricer.NPV(i)
+                        << "\n    expected:   " << expected[i]);
+        if (!pricer.error(i).empty())
+            BOOST_ERROR("unexpected error for instrument #" << i << ": "
+                        << pricer.error(i));
+        if (pricer.pricingTime(i) < 0.0)
+            BOOST_ERROR("negative pricing time for instrument #" << i);
+    }
+    if (pricer.NPV(failing) != Null<Real>())
+        BOOST_ERROR("NPV returned for instrument that can't be priced");
+    if (pricer.error(failing).empty())
+        BOOST_ERROR("no error recorded for instrument that can't be priced");
+}
+
+void InstrumentTest::testValuationQueue() {
+
+    BOOST_TEST_MESSAGE("Testing deferred valuation of instruments...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    DayCounter dc = Actual360();
+
+    shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(
+                                                      flatRate(0.0, dc)),
+                                      Handle<YieldTermStructure>(
+                                                      flatRate(0.01, dc)),
+                                      Handle<BlackVolTermStructure>(
+                                                      flatVol(0.1, dc))));
+
+    ValuationQueue queue;
+    Size group = queue.addGroup(AnalyticEuropeanEngineFactory(process));
+    shared_ptr<CountingObject> marketObject(new CountingObject);
+    queue.addMarketObject(marketObject);
+
+    std::vector<shared_ptr<Instrument> > options;
+    std::vector<ValuationQueue::Future> futures;
+    std::vector<Real> expected;
+    for (Size i=0; i<20; ++i) {
+        shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Call, 90.0+i));
+        shared_ptr<Exercise> exercise(new EuropeanExercise(today+30*(i+1)));
+        shared_ptr<Instrument> option(new EuropeanOption(payoff, exercise));
+        option->setPricingEngine(AnalyticEuropeanEngineFactory(process)());
+        expected.push_back(option->NPV());
+        options.push_back(option);
+        futures.push_back(queue.submit(option, group));
+    }
+
+    // submitting a pending instrument returns the same valuation
+    ValuationQueue::Future duplicate = queue.submit(options[3], group);
+    if (queue.pending() != options.size())
+        BOOST_ERROR("wrong number of pending valuations: "
+                    << queue.pending() << " instead of " << options.size());
+
+    shared_ptr<Instrument> american(
+        new VanillaOption(shared_ptr<StrikedTypePayoff>(
+                                 new PlainVanillaPayoff(Option::Put, 100.0)),
+                          shared_ptr<Exercise>(
+                                 new AmericanExercise(today, today+360))));
+    ValuationQueue::Future failing = queue.submit(american, group);
+
+    for (Size i=0; i<futures.size(); ++i) {
+        if (futures[i].ready())
+            BOOST_FAIL("valuation performed before being requested");
+    }
+
+    // requesting one result performs all pending valuations...
+    Real npv = futures[0].get();
+    if (npv != expected[0])
+        BOOST_ERROR("wrong NPV for the first instrument:"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << npv
+                    << "\n    expected:   " << expected[0]);
+    if (queue.pending() != 0)
+        BOOST_ERROR(queue.pending() << " valuations still pending");
+    // ...sharing the calculation of the market objects
+    if (marketObject->calculations != 1)
+        BOOST_ERROR("market object calculated "
+                    << marketObject->calculations << " times");
+
+    for (Size i=0; i<futures.size(); ++i) {
+        if (!futures[i].ready())
+            BOOST_ERROR("valuation #" << i << " not performed");
+        else if (futures[i].get() != expected[i])
+            BOOST_ERROR("wrong NPV for instrument #" << i << ":"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << futures[i].get()
+                        << "\n    expected:   " << expected[i]);
+    }
+    if (duplicate.get() != futures[3].get())
+        BOOST_ERROR("duplicate submission returned a different NPV");
+
+    if (failing.error().empty())
+        BOOST_ERROR("no error recorded for instrument that can't be priced");
+    BOOST_CHECK_THROW(failing.get(), Error);
+
+    // later submissions are performed in a new run
+    spot->setValue(105.0);
+    options[0]->setPricingEngine(AnalyticEuropeanEngineFactory(process)());
+    Real newExpected = options[0]->NPV();
+    ValuationQueue::Future future = queue.submit(options[0], group);
+    queue.run();
+    if (!future.ready() || future.get() != newExpected)
+        BOOST_ERROR("wrong NPV after market change:"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << future.get()
+                    << "\n    expected:   " << newExpected);
+    if (futures[0].get() != expected[0])
+        BOOST_ERROR("completed future modified by later run");
+
+    // pending futures outliving their queue are completed with an error
+    ValuationQueue::Future orphan;
+    {
+        ValuationQueue temporary;
+        temporary.addGroup(AnalyticEuropeanEngineFactory(process));
+        orphan = temporary.submit(options[1], 0);
+    }
+    if (!orphan.ready() || orphan.error().empty())
+        BOOST_ERROR("orphaned future not completed with an error");
+}
+
+void InstrumentTest::testPricingEnginePool() {
+
+    BOOST_TEST_MESSAGE("Testing pool of per-thread pricing engines...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    DayCounter dc = Actual360();
+
+    shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(
+                                                      flatRate(0.0, dc)),
+                                      Handle<YieldTermStructure>(
+                                                      flatRate(0.01, dc)),
+                                      Handle<BlackVolTermStructure>(
+                                                      flatVol(0.1, dc))));
+    AnalyticEuropeanEngineFactory factory(process);
+
+    shared_ptr<PricingEngine> pool(new PricingEnginePool(factory, 4));
+
+    shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Call, 100.0));
+    shared_ptr<Exercise> exercise(new EuropeanExercise(today+90));
+    shared_ptr<Instrument> pooled(new EuropeanOption(payoff, exercise));
+    shared_ptr<Instrument> plain(new EuropeanOption(payoff, exercise));
+    pooled->setPricingEngine(pool);
+    plain->setPricingEngine(factory());
+
+    if (pooled->NPV() != plain->NPV())
+        BOOST_ERROR("pooled engine returned different NPV:"
+                    << std::setprecision(12)
+                    << "\n    pooled: " << pooled->NPV()
+                    << "\n    plain:  " << plain->NPV());
+
+    Flag flag;
+    flag.registerWith(pooled);
+    spot->setValue(105.0);
+    if (!flag.isUp())
+        BOOST_FAIL("instrument not notified through engine pool");
+    if (pooled->NPV() != plain->NPV())
+        BOOST_ERROR("pooled engine returned different NPV after change:"
+                    << std::setprecision(12)
+                    << "\n    pooled: " << pooled->NPV()
+                    << "\n    plain:  " << plain->NPV());
+
+    BOOST_CHECK_THROW(
+        PricingEnginePool(ConstantEngineFactory(factory()), 2), Error);
+}
+
+void InstrumentTest::testCachingEngine() {
+
+    BOOST_TEST_MESSAGE("Testing caching of engine results...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    DayCounter dc = Actual360();
+
+    shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(
+                                                      flatRate(0.0, dc)),
+                                      Handle<YieldTermStructure>(
+                                                      flatRate(0.01, dc)),
+                                      Handle<BlackVolTermStructure>(
+                                                      flatVol(0.1, dc))));
+    shared_ptr<PricingEngine> analytic(new AnalyticEuropeanEngine(process));
+
+    typedef CachingEngine<OneAssetOption::arguments,
+                          OneAssetOption::results> CachingOptionEngine;
+    shared_ptr<CachingOptionEngine> cached(
+                  new CachingOptionEngine(analytic, europeanOptionKey, 2));
+
+    shared_ptr<Exercise> exercise(new EuropeanExercise(today+90));
+    Real strikes[] = { 90.0, 100.0, 110.0 };
+    std::vector<shared_ptr<Instrument> > options, plain;
+    for (Size i=0; i<LENGTH(strikes); ++i) {
+        shared_ptr<StrikedTypePayoff> payoff(
+                           new PlainVanillaPayoff(Option::Call, strikes[i]));
+        // two options with the same terms for each strike
+        for (Size j=0; j<2; ++j) {
+            options.push_back(shared_ptr<Instrument>(
+                                      new EuropeanOption(payoff, exercise)));
+            options.back()->setPricingEngine(cached);
+        }
+        plain.push_back(shared_ptr<Instrument>(
+                                      new EuropeanOption(payoff, exercise)));
+        plain.back()->setPricingEngine(analytic);
+    }
+
+    // strikes are priced in order, so that each one evicts the
+    // least recently used when the capacity is exceeded
+    for (Size i=0; i<options.size(); ++i) {
+        if (options[i]->NPV() != plain[i/2]->NPV())
+            BOOST_ERROR("cached engine returned different NPV:"
+                        << std::setprecision(12)
+                        << "\n    strike: " << strikes[i/2]
+                        << "\n    cached: " << options[i]->NPV()
+                        << "\n    plain:  " << plain[i/2]->NPV());
+    }
+    if (cached->hits() != 3 || cached->misses() != 3)
+        BOOST_ERROR("unexpected cache usage:"
+                    << "\n    hits:   " << cached->hits()
+                    << "\n    misses: " << cached->misses());
+    if (cached->size() != 2)
+        BOOST_ERROR("capacity exceeded: " << cached->size()
+                    << " results stored");
+
+    Flag flag;
+    flag.registerWith(options[0]);
+    spot->setValue(105.0);
+    if (!flag.isUp())
+        BOOST_FAIL("instrument not notified through caching engine");
+    if (cached->size() != 0)
+        BOOST_ERROR("results not discarded after market change");
+    for (Size i=0; i<options.size(); ++i) {
+        if (options[i]->NPV() != plain[i/2]->NPV())
+            BOOST_ERROR("cached engine returned different NPV "
+                        "after change:"
+                        << std::setprecision(12)
+                        << "\n    strike: " << strikes[i/2]
+                        << "\n    cached: " << options[i]->NPV()
+                        << "\n    plain:  " << plain[i/2]->NPV());
+    }
+    if (cached->hits() != 6 || cached->misses() != 6)
+        BOOST_ERROR("unexpected cache usage after change:"
+                    << "\n    hits:   " << cached->hits()
+                    << "\n    misses: " << cached->misses());
+}
+
+namespace {
+
+    // spot, volatility and four deposit rates; European options
+    // priced on a curve bootstrapped over the deposits
+    ScenarioRunner::Market optionMarket() {
+        ScenarioRunner::Market market;
+        DayCounter dc = Actual360();
+        Calendar calendar = TARGET();
+        Date today = Settings::instance().evaluationDate();
+
+        shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+        shared_ptr<SimpleQuote> vol(new SimpleQuote(0.2));
+        market.quotes.push_back(spot);
+        market.quotes.push_back(vol);
+
+        std::vector<shared_ptr<RateHelper> > helpers;
+        Integer months[] = { 1, 3, 6, 12 };
+        for (Size i=0; i<LENGTH(months); ++i) {
+            shared_ptr<SimpleQuote> rate(new SimpleQuote(0.01 + 0.002*i));
+            market.quotes.push_back(rate);
+            helpers.push_back(shared_ptr<RateHelper>(
+                new DepositRateHelper(Handle<Quote>(rate),
+                                      months[i]*Months, 0, calendar,
+                                      ModifiedFollowing, false, dc)));
+        }
+        Handle<YieldTermStructure> riskFree(
+            shared_ptr<YieldTermStructure>(
+                new PiecewiseYieldCurve<Discount,LogLinear>(
+                                                 today, helpers, dc)));
+        Handle<BlackVolTermStructure> volatility(
+            shared_ptr<BlackVolTermStructure>(
+                new BlackConstantVol(today, calendar,
+                                     Handle<Quote>(vol), dc)));
+        shared_ptr<BlackScholesMertonProcess> process(
+            new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                          Handle<YieldTermStructure>(
+                                                   flatRate(today, 0.0, dc)),
+                                          riskFree, volatility));
+        shared_ptr<PricingEngine> engine(new AnalyticEuropeanEngine(process));
+
+        for (Size i=0; i<10; ++i) {
+            Option::Type type = (i % 2 == 0 ? Option::Call : Option::Put);
+            shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(type, 90.0 + 2*i));
+            shared_ptr<Exercise> exercise(
+                                 new EuropeanExercise(today + 30*(i+1)));
+            shared_ptr<Instrument> option(new EuropeanOption(payoff,
+                                                             exercise));
+            option->setPricingEngine(engine);
+            market.instruments.push_back(option);
+        }
+        return market;
+    }
+
+}
+
+void InstrumentTest::testScenarioRunner() {
+
+    BOOST_TEST_MESSAGE("Testing concurrent evaluation of scenarios...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(15, March, 2013);
+
+    ScenarioRunner runner(optionMarket, 4);
+    Size nQuotes = 6;
+    std::vector<ScenarioRunner::Scenario> scenarios =
+        ScenarioRunner::bucketScenarios(nQuotes, 0.0001);
+    scenarios.push_back(ScenarioRunner::parallelScenario(nQuotes, 0.0001));
+    ScenarioRunner::Scenario spotAndRates;
+    spotAndRates.push_back(std::make_pair(Size(0), 5.0));
+    for (Size i=2; i<nQuotes; ++i)
+        spotAndRates.push_back(std::make_pair(i, -0.005));
+    // shifts of the same quote add up
+    spotAndRates.push_back(std::make_pair(Size(0), -2.0));
+    scenarios.push_back(spotAndRates);
+    for (Size i=0; i<20; ++i)
+        scenarios.push_back(
+            ScenarioRunner::parallelScenario(nQuotes, 0.0001*(i+1)));
+    // a negative spot can't be priced; the error is recorded
+    ScenarioRunner::Scenario negativeSpot;
+    negativeSpot.push_back(std::make_pair(Size(0), -150.0));
+    Size failing = scenarios.size();
+    scenarios.push_back(negativeSpot);
+
+    Matrix results = runner.calculate(scenarios);
+
+    // serial bump and reprice on a separate copy of the market
+    ScenarioRunner::Market market = optionMarket();
+    Size nInstruments = market.instruments.size();
+    std::vector<Real> base(nQuotes), baseNPVs(nInstruments);
+    for (Size i=0; i<nQuotes; ++i)
+        base[i] = market.quotes[i]->value();
+    for (Size j=0; j<nInstruments; ++j)
+        baseNPVs[j] = market.instruments[j]->NPV();
+
+    if (results.rows() != scenarios.size() ||
+        results.columns() != nInstruments)
+        BOOST_FAIL("wrong result size: "
+                   << results.rows() << "x" << results.columns());
+
+    Real tolerance = 1.0e-8;
+    for (Size j=0; j<nInstruments; ++j) {
+        if (std::fabs(runner.baseNPVs()[j] - baseNPVs[j]) > tolerance)
+            BOOST_ERROR("wrong base NPV for instrument #" << j << ":"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << runner.baseNPVs()[j]
+                        << "\n    expected:   " << baseNPVs[j]);
+    }
+
+    for (Size s=0; s<failing; ++s) {
+        for (Size k=0; k<scenarios[s].size(); ++k) {
+            Size i = scenarios[s][k].first;
+            market.quotes[i]->setValue(market.quotes[i]->value()
+                                       + scenarios[s][k].second);
+        }
+        for (Size j=0; j<nInstruments; ++j) {
+            Real expected = market.instruments[j]->NPV() - baseNPVs[j];
+            if (std::fabs(results[s][j] - expected) > tolerance)
+                BOOST_ERROR("wrong P&L for instrument #" << j
+                            << " in scenario #" << s << ":"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << results[s][j]
+                            << "\n    expected:   " << expected);
+        }
+        if (!runner.error(s).empty())
+            BOOST_ERROR("unexpected error in scenario #" << s << ": "
+                        << runner.error(s));
+        for (Size i=0; i<nQuotes; ++i)
+            market.quotes[i]->setValue(base[i]);
+    }
+
+    if (runner.error(failing).empty())
+        BOOST_ERROR("no error recorded for scenario that can't be priced");
+    for (Size j=0; j<nInstruments; ++j) {
+        if (results[failing][j] != Null<Real>())
+            BOOST_ERROR("P&L returned for instrument #" << j
+                        << " in scenario that can't be priced");
+    }
+
+    // the quotes are restored, so that the calculation can be repeated
+    Matrix again = runner.calculate(scenarios);
+    for (Size s=0; s<failing; ++s) {
+        for (Size j=0; j<nInstruments; ++j) {
+            if (std::fabs(again[s][j] - results[s][j]) > tolerance)
+                BOOST_ERROR("different P&L for instrument #" << j
+                            << " in scenario #" << s
+                            << " on second calculation:"
+                            << std::setprecision(12)
+                            << "\n    first:  " << results[s][j]
+                            << "\n    second: " << again[s][j]);
+        }
+    }
+
+    std::vector<ScenarioRunner::Scenario> wrong(1);
+    wrong[0].push_back(std::make_pair(nQuotes, 0.0001));
+    BOOST_CHECK_THROW(runner.calculate(wrong), Error);
+}
+
 test_suite* InstrumentTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Instrument tests");
     suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testObservable));
     suite->add(QUANTLIB_TEST_CASE(
                             &InstrumentTest::testCompositeWhenShiftingDates));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testPortfolioPricer));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testValuationQueue));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testPricingEnginePool));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testCachingEngine));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testScenarioRunner));
     return suite;
 }
 
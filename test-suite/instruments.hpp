@@ -30,6 +30,11 @@ class InstrumentTest {
   public:
     static void testObservable();
     static void testCompositeWhenShiftingDates();
+    static void testPortfolioPricer();
+    static void testValuationQueue();
+    static void testPricingEnginePool();
+    static void testCachingEngine();
+    static void testScenarioRunner();
     static boost::unit_test_framework::test_suite* suite();
 };
 
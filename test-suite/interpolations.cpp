@@ -30,6 +30,8 @@
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
 #include <ql/math/interpolations/forwardflatinterpolation.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
+#include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/interpolations/multicubicspline.hpp>
 #include <ql/math/interpolations/sabrinterpolation.hpp>
 #include <ql/math/interpolations/kernelinterpolation.hpp>
@@ -41,12 +43,17 @@
 #include <ql/math/functional.hpp>
 #include <ql/math/richardsonextrapolation.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/experimental/math/laplaceinterpolation.hpp>
 #include <ql/experimental/volatility/noarbsabrinterpolation.hpp>
+#include <ql/termstructures/volatility/sabrsmilesection.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <boost/foreach.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/assign/std/vector.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <iomanip>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -1586,6 +1593,149 @@ void InterpolationTest::testKernelInterpolation2D(){
 }
 
 
+void InterpolationTest::testCompactKernelInterpolation() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing kernel interpolations with compactly supported kernel...");
+
+    // with a compactly supported kernel, the sparse calibration and
+    // the local evaluation must reproduce the dense interpolation
+    const Real tolerance = 1.0e-8;
+
+    std::vector<Real> x(200), y(x.size());
+    for (Size i=0; i<x.size(); ++i) {
+        x[i] = i/Real(x.size()-1);
+        y[i] = std::sin(2*M_PI*x[i]) + 0.1*x[i];
+    }
+
+    const WendlandKernel kernel(0.05);
+    const KernelInterpolation dense(x.begin(), x.end(), y.begin(), kernel);
+    const KernelInterpolation sparse(x.begin(), x.end(), y.begin(), kernel,
+                                     1.0e-7, kernel.radius());
+
+    for (Size i=0; i<=1000; ++i) {
+        const Real t = i/1000.0;
+        const Real expected = dense(t), calculated = sparse(t);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("1D compact kernel interpolation failed at x = " << t
+                        << std::scientific
+                        << "\n    sparse value: " << calculated
+                        << "\n    dense value:  " << expected);
+    }
+    for (Size i=0; i<x.size(); ++i) {
+        if (std::fabs(sparse(x[i])-y[i]) > tolerance)
+            BOOST_ERROR("1D compact kernel interpolation failed at x = "
+                        << x[i] << std::scientific
+                        << "\n    interpolated value: " << sparse(x[i])
+                        << "\n    expected value:     " << y[i]);
+    }
+
+    std::vector<Real> x1(30), x2(20);
+    for (Size i=0; i<x1.size(); ++i)
+        x1[i] = i/Real(x1.size()-1);
+    for (Size j=0; j<x2.size(); ++j)
+        x2[j] = 0.5 + j/Real(x2.size()-1);
+
+    Matrix z(x1.size(), x2.size());
+    for (Size i=0; i<x1.size(); ++i)
+        for (Size j=0; j<x2.size(); ++j)
+            z[i][j] = 0.2 + 0.05*std::sin(3*x1[i])*std::cos(2*x2[j]);
+
+    const WendlandKernel kernel2D(0.15);
+    KernelInterpolation2D dense2D(x1.begin(), x1.end(), x2.begin(), x2.end(),
+                                  z, kernel2D);
+    KernelInterpolation2D sparse2D(x1.begin(), x1.end(), x2.begin(), x2.end(),
+                                   z, kernel2D, kernel2D.radius());
+
+    for (Size i=0; i<=50; ++i) {
+        for (Size j=0; j<=50; ++j) {
+            const Real t1 = i/50.0, t2 = 0.5 + j/50.0;
+            const Real expected = dense2D(t1, t2);
+            const Real calculated = sparse2D(t1, t2);
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("2D compact kernel interpolation failed at x = "
+                            << t1 << ", y = " << t2 << std::scientific
+                            << "\n    sparse value: " << calculated
+                            << "\n    dense value:  " << expected);
+        }
+    }
+    for (Size i=0; i<x1.size(); ++i) {
+        for (Size j=0; j<x2.size(); ++j) {
+            if (std::fabs(sparse2D(x1[i], x2[j])-z[i][j]) > tolerance)
+                BOOST_ERROR("2D compact kernel interpolation failed at x = "
+                            << x1[i] << ", y = " << x2[j] << std::scientific
+                            << "\n    interpolated value: "
+                            << sparse2D(x1[i], x2[j])
+                            << "\n    expected value:     " << z[i][j]);
+        }
+    }
+}
+
+
+void InterpolationTest::testLaplaceInterpolation() {
+
+    BOOST_TEST_MESSAGE("Testing Laplace interpolation of missing values...");
+
+    // linear functions are reproduced at interior points
+    const Real tolerance = 1.0e-6;
+
+    Matrix A(6, 5);
+    for (Size i=0; i<A.rows(); ++i)
+        for (Size j=0; j<A.columns(); ++j)
+            A[i][j] = 1.0 + 0.5*i - 0.2*j;
+
+    Matrix B = A;
+    B[1][1] = B[2][1] = B[2][2] = B[3][3] = B[4][2] = Null<Real>();
+    laplaceInterpolation(B, 1.0e-10);
+
+    for (Size i=0; i<A.rows(); ++i)
+        for (Size j=0; j<A.columns(); ++j)
+            if (std::fabs(B[i][j]-A[i][j]) > tolerance)
+                BOOST_ERROR("failed to reproduce matrix value"
+                            << "\n    row:        " << i
+                            << "\n    column:     " << j
+                            << "\n    calculated: " << B[i][j]
+                            << "\n    expected:   " << A[i][j]);
+
+    std::vector<Size> dims(3);
+    dims[0] = 4; dims[1] = 5; dims[2] = 6;
+    std::vector<Real> cube(dims[0]*dims[1]*dims[2]), expected(cube.size());
+    for (Size i=0, l=0; i<dims[0]; ++i) {
+        for (Size j=0; j<dims[1]; ++j) {
+            for (Size k=0; k<dims[2]; ++k, ++l) {
+                expected[l] = 0.2 + 0.01*i + 0.02*j - 0.005*k;
+                const bool interior = i > 0 && i < dims[0]-1
+                                   && j > 0 && j < dims[1]-1
+                                   && k > 0 && k < dims[2]-1;
+                cube[l] = (interior && (i+j+k) % 3 != 0)
+                        ? Null<Real>() : expected[l];
+            }
+        }
+    }
+    laplaceInterpolation(cube, dims, 1.0e-10);
+
+    for (Size l=0; l<cube.size(); ++l)
+        if (std::fabs(cube[l]-expected[l]) > tolerance)
+            BOOST_ERROR("failed to reproduce cube value"
+                        << "\n    index:      " << l
+                        << "\n    calculated: " << cube[l]
+                        << "\n    expected:   " << expected[l]);
+
+    // missing values on the border are filled as well
+    B = A;
+    B[0][0] = B[0][3] = B[5][4] = Null<Real>();
+    laplaceInterpolation(B);
+    for (Size i=0; i<B.rows(); ++i)
+        for (Size j=0; j<B.columns(); ++j)
+            if (B[i][j] == Null<Real>()
+                || B[i][j] < 0.0 || B[i][j] > 4.0)
+                BOOST_ERROR("invalid value at the border"
+                            << "\n    row:        " << i
+                            << "\n    column:     " << j
+                            << "\n    calculated: " << B[i][j]);
+}
+
+
 void InterpolationTest::testBicubicDerivatives() {
     BOOST_TEST_MESSAGE("Testing bicubic spline derivatives...");
 
@@ -1909,6 +2059,80 @@ void InterpolationTest::testSabrSingleCases() {
 
 }
 
+void InterpolationTest::testSabrVolatilities() {
+
+    BOOST_TEST_MESSAGE("Testing Sabr volatilities over several strikes...");
+
+    SavedSettings backup;
+
+    Real alpha = 0.04, beta = 0.6, nu = 0.45, rho = -0.3;
+    Real forward = 0.025, tte = 3.5;
+
+    std::vector<Real> strikes;
+    for (Size i=0; i<40; ++i)
+        strikes.push_back(0.0025*(i+1));
+    // at the money, where the expansion is treated separately
+    strikes.push_back(forward);
+
+    Real shifts[] = { 0.0, 0.02 };
+    for (Size k=0; k<LENGTH(shifts); ++k) {
+        std::vector<Volatility> vols =
+            shiftedSabrVolatilities(strikes, forward, tte,
+                                    alpha, beta, nu, rho, shifts[k]);
+        for (Size i=0; i<strikes.size(); ++i) {
+            Volatility expected =
+                shiftedSabrVolatility(strikes[i], forward, tte,
+                                      alpha, beta, nu, rho, shifts[k]);
+            if (vols[i] != expected)
+                BOOST_ERROR("failed to reproduce Sabr volatility"
+                            << std::setprecision(16)
+                            << "\n    strike:     " << strikes[i]
+                            << "\n    shift:      " << shifts[k]
+                            << "\n    calculated: " << vols[i]
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    BOOST_CHECK_THROW(sabrVolatilities(strikes, forward, tte,
+                                       alpha, beta, nu, 1.5), Error);
+    strikes.push_back(-0.01);
+    BOOST_CHECK_THROW(sabrVolatilities(strikes, forward, tte,
+                                       alpha, beta, nu, rho), Error);
+    strikes.pop_back();
+
+    // smile sections store the expansion, which must follow the
+    // exercise time when the evaluation date moves
+    Date today(30, October, 2017);
+    Settings::instance().evaluationDate() = today;
+    std::vector<Real> params;
+    params.push_back(alpha);
+    params.push_back(beta);
+    params.push_back(nu);
+    params.push_back(rho);
+    SabrSmileSection section(today + 3*Years, forward, params,
+                             Actual365Fixed(), 0.01);
+    for (Size n=0; n<2; ++n) {
+        std::vector<Volatility> vols = section.volatilities(strikes);
+        for (Size i=0; i<strikes.size(); ++i) {
+            Volatility expected =
+                shiftedSabrVolatility(strikes[i], forward,
+                                      section.exerciseTime(),
+                                      alpha, beta, nu, rho, 0.01);
+            if (section.volatility(strikes[i]) != expected
+                || vols[i] != expected)
+                BOOST_ERROR("failed to reproduce Sabr volatility "
+                            "in smile section"
+                            << std::setprecision(16)
+                            << "\n    strike:      " << strikes[i]
+                            << "\n    single:      "
+                            << section.volatility(strikes[i])
+                            << "\n    array:       " << vols[i]
+                            << "\n    expected:    " << expected);
+        }
+        Settings::instance().evaluationDate() = today + 6*Months;
+    }
+}
+
 void InterpolationTest::testTransformations() {
 
     BOOST_TEST_MESSAGE("Testing Sabr and no-arbitrage Sabr transformation functions...");
@@ -2202,6 +2426,171 @@ void InterpolationTest::testBSplines() {
     }
 }
 
+namespace {
+
+    // increasing, decreasing and random points, including the nodes
+    // and points outside the range
+    std::vector<std::vector<Real> > queryPoints(
+                                        const std::vector<Real>& nodes) {
+        std::vector<Real> increasing;
+        increasing.push_back(nodes.front()-1.0);
+        for (Size i=0; i<nodes.size()-1; ++i)
+            for (Size k=0; k<4; ++k)
+                increasing.push_back(nodes[i] + k*(nodes[i+1]-nodes[i])/4);
+        increasing.push_back(nodes.back());
+        increasing.push_back(nodes.back()+1.0);
+
+        std::vector<Real> decreasing(increasing.rbegin(), increasing.rend());
+
+        std::vector<Real> random;
+        MersenneTwisterUniformRng rng(42);
+        for (Size i=0; i<increasing.size(); ++i)
+            random.push_back(increasing[rng.nextInt32() % increasing.size()]);
+
+        std::vector<std::vector<Real> > points;
+        points.push_back(increasing);
+        points.push_back(decreasing);
+        points.push_back(random);
+        return points;
+    }
+
+    template <class I>
+    void checkSequentialQueries(const std::string& name,
+                                const std::vector<Real>& x,
+                                const std::vector<Real>& y) {
+        I f(x.begin(), x.end(), y.begin());
+        std::vector<std::vector<Real> > points = queryPoints(x);
+        std::string order[] = { "increasing", "decreasing", "random" };
+        for (Size k=0; k<points.size(); ++k) {
+            const std::vector<Real>& p = points[k];
+            Array q(p.begin(), p.end()), values;
+            f(q, values, true);
+            for (Size i=0; i<p.size(); ++i) {
+                // a new instance has no information on earlier calls
+                I g(x.begin(), x.end(), y.begin());
+                Real expected = g(p[i], true);
+                Real calculated = f(p[i], true);
+                if (calculated != expected || values[i] != expected)
+                    BOOST_ERROR(name << " interpolation, " << order[k]
+                                << " points: wrong value at " << p[i]
+                                << std::setprecision(12)
+                                << "\n    single request: " << calculated
+                                << "\n    sequence:       " << values[i]
+                                << "\n    expected:       " << expected);
+            }
+        }
+    }
+
+}
+
+void InterpolationTest::testSequentialQueries() {
+
+    BOOST_TEST_MESSAGE("Testing sequences of interpolation requests...");
+
+    std::vector<Real> x, y, z;
+    for (Size i=0; i<12; ++i) {
+        x.push_back(0.25*i*i + i);
+        y.push_back(std::exp(-0.1*x.back()) * (1.5 + std::sin(x.back())));
+    }
+
+    checkSequentialQueries<LinearInterpolation>("linear", x, y);
+    checkSequentialQueries<LogLinearInterpolation>("log-linear", x, y);
+    checkSequentialQueries<CubicNaturalSpline>("natural cubic", x, y);
+    checkSequentialQueries<BackwardFlatInterpolation>("backward-flat", x, y);
+
+    for (Size j=0; j<7; ++j)
+        z.push_back(1.0 + 0.5*j*j);
+    Matrix data(z.size(), x.size());
+    for (Size j=0; j<z.size(); ++j)
+        for (Size i=0; i<x.size(); ++i)
+            data[j][i] = y[i]*std::log(1.0+z[j]);
+
+    BilinearInterpolation f(x.begin(), x.end(), z.begin(), z.end(), data);
+    std::vector<std::vector<Real> > xPoints = queryPoints(x),
+                                    zPoints = queryPoints(z);
+    for (Size k=0; k<xPoints.size(); ++k) {
+        for (Size i=0; i<xPoints[k].size(); ++i) {
+            for (Size j=0; j<zPoints[k].size(); ++j) {
+                Real u = xPoints[k][i], v = zPoints[k][j];
+                BilinearInterpolation g(x.begin(), x.end(),
+                                        z.begin(), z.end(), data);
+                Real expected = g(u, v, true);
+                Real calculated = f(u, v, true);
+                if (calculated != expected)
+                    BOOST_ERROR("bilinear interpolation: wrong value at ("
+                                << u << ", " << v << ")"
+                                << std::setprecision(12)
+                                << "\n    calculated: " << calculated
+                                << "\n    expected:   " << expected);
+            }
+        }
+    }
+}
+
+void InterpolationTest::testCubicIncrementalUpdate() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing cubic interpolation updates after changes of single values...");
+
+    CubicInterpolation::DerivativeApprox schemes[] = {
+        CubicInterpolation::Spline, CubicInterpolation::SplineOM1,
+        CubicInterpolation::SplineOM2, CubicInterpolation::Parabolic,
+        CubicInterpolation::FritschButland, CubicInterpolation::Akima,
+        CubicInterpolation::Kruger, CubicInterpolation::Harmonic
+    };
+    std::string names[] = { "spline", "spline OM1", "spline OM2",
+                            "parabolic", "Fritsch-Butland", "Akima",
+                            "Kruger", "harmonic" };
+
+    const Size n = 15;
+    std::vector<Real> x(n), y(n);
+    for (Size j=0; j<LENGTH(schemes); ++j) {
+        for (Size m=0; m<2; ++m) {
+            bool monotonic = (m == 1);
+            MersenneTwisterUniformRng rng(42);
+            for (Size i=0; i<n; ++i) {
+                x[i] = i + 0.5*rng.nextReal();
+                y[i] = std::sin(x[i]) + 0.2*rng.nextReal();
+            }
+            CubicInterpolation f(x.begin(), x.end(), y.begin(),
+                                 schemes[j], monotonic,
+                                 CubicInterpolation::SecondDerivative, 0.0,
+                                 CubicInterpolation::SecondDerivative, 0.0);
+            for (Size k=0; k<3*n; ++k) {
+                // change one or two values, as in a bootstrap
+                y[k%n] += 0.2*(rng.nextReal()-0.5);
+                if (k%4 == 0)
+                    y[(7*k+3)%n] -= 0.1;
+                f.update();
+
+                CubicInterpolation g(x.begin(), x.end(), y.begin(),
+                                     schemes[j], monotonic,
+                                     CubicInterpolation::SecondDerivative, 0.0,
+                                     CubicInterpolation::SecondDerivative, 0.0);
+                for (Real t=x[0]; t<x[n-1]; t+=0.1) {
+                    Real results[][2] = {
+                        { f(t), g(t) },
+                        { f.derivative(t), g.derivative(t) },
+                        { f.primitive(t), g.primitive(t) }
+                    };
+                    std::string what[] = { "value", "derivative",
+                                           "primitive" };
+                    for (Size l=0; l<LENGTH(results); ++l) {
+                        if (std::fabs(results[l][0]-results[l][1]) > 1.0e-12)
+                            BOOST_FAIL(names[j]
+                                       << (monotonic ? " monotonic" : "")
+                                       << " interpolation: wrong " << what[l]
+                                       << " at " << t << " after update"
+                                       << std::setprecision(12)
+                                       << "\n    updated:  " << results[l][0]
+                                       << "\n    expected: " << results[l][1]);
+                    }
+                }
+            }
+        }
+    }
+}
+
 test_suite* InterpolationTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Interpolation tests");
 
@@ -2227,12 +2616,16 @@ test_suite* InterpolationTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testKernelInterpolation));
     suite->add(QUANTLIB_TEST_CASE(
                               &InterpolationTest::testKernelInterpolation2D));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &InterpolationTest::testCompactKernelInterpolation));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testLaplaceInterpolation));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBicubicDerivatives));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBicubicUpdate));
     suite->add(QUANTLIB_TEST_CASE(
                             &InterpolationTest::testRichardsonExtrapolation));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testNoArbSabrInterpolation));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testSabrSingleCases));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testSabrVolatilities));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testTransformations));
     suite->add(QUANTLIB_TEST_CASE(
         &InterpolationTest::testLagrangeInterpolation));
@@ -2243,6 +2636,9 @@ test_suite* InterpolationTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
         &InterpolationTest::testLagrangeInterpolationOnChebyshevPoints));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBSplines));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testSequentialQueries));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &InterpolationTest::testCubicIncrementalUpdate));
 
     return suite;
 }
@@ -46,17 +46,22 @@ class InterpolationTest {
     static void testSabrInterpolation();
     static void testKernelInterpolation();
     static void testKernelInterpolation2D();
+    static void testCompactKernelInterpolation();
+    static void testLaplaceInterpolation();
     static void testBicubicDerivatives();
     static void testBicubicUpdate();
     static void testRichardsonExtrapolation();
     static void testNoArbSabrInterpolation();
     static void testSabrSingleCases();
+    static void testSabrVolatilities();
     static void testTransformations();
     static void testLagrangeInterpolation();
     static void testLagrangeInterpolationAtSupportPoint();
     static void testLagrangeInterpolationDerivative();
     static void testLagrangeInterpolationOnChebyshevPoints();
     static void testBSplines();
+    static void testSequentialQueries();
+    static void testCubicIncrementalUpdate();
 
     static boost::unit_test_framework::test_suite* suite();
 };
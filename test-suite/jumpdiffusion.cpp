@@ -532,9 +532,71 @@ void JumpDiffusionTest::testGreeks() {
 }
 
 
+void JumpDiffusionTest::testBatchValues() {
+
+    BOOST_TEST_MESSAGE("Testing jump-diffusion batch values "
+                       "against single options...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.03, dc));
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    Handle<BlackVolTermStructure> volTS(flatVol(today, 0.20, dc));
+
+    boost::shared_ptr<Merton76Process> stochProcess(
+          new Merton76Process(Handle<Quote>(spot), qTS, rTS, volTS,
+              Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(2.0))),
+              Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(-0.1))),
+              Handle<Quote>(boost::shared_ptr<Quote>(
+                                                new SimpleQuote(0.25)))));
+
+    boost::shared_ptr<JumpDiffusionEngine> engine(
+                                 new JumpDiffusionEngine(stochProcess,1e-10));
+
+    Option::Type types[] = { Option::Put, Option::Call };
+    Real strikes[] = { 50.0, 80.0, 95.0, 100.0, 105.0, 120.0, 150.0 };
+    Integer days[] = { 30, 180, 360, 1800 };
+
+    std::vector<Real> strikeVector(strikes, strikes+LENGTH(strikes));
+    for (Size i=0; i<LENGTH(types); i++) {
+        for (Size k=0; k<LENGTH(days); k++) {
+            Date exDate = today + days[k];
+            std::vector<Real> calculated =
+                engine->values(types[i], strikeVector, exDate);
+
+            boost::shared_ptr<Exercise> exercise(
+                                             new EuropeanExercise(exDate));
+            for (Size j=0; j<LENGTH(strikes); j++) {
+                boost::shared_ptr<StrikedTypePayoff> payoff(new
+                    PlainVanillaPayoff(types[i], strikes[j]));
+                EuropeanOption option(payoff, exercise);
+                option.setPricingEngine(engine);
+                Real expected = option.NPV();
+                Real error = std::fabs(calculated[j] - expected);
+                if (error > 1.0e-8*std::max(expected, 1.0))
+                    BOOST_ERROR("failed to reproduce single-option value"
+                                << "\n    type:       " << types[i]
+                                << "\n    strike:     " << strikes[j]
+                                << "\n    maturity:   " << exDate
+                                << std::setprecision(12)
+                                << "\n    expected:   " << expected
+                                << "\n    calculated: " << calculated[j]
+                                << "\n    error:      " << error);
+            }
+        }
+    }
+}
+
+
 test_suite* JumpDiffusionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Jump-diffusion tests");
     suite->add(QUANTLIB_TEST_CASE(&JumpDiffusionTest::testMerton76));
     suite->add(QUANTLIB_TEST_CASE(&JumpDiffusionTest::testGreeks));
+    suite->add(QUANTLIB_TEST_CASE(&JumpDiffusionTest::testBatchValues));
     return suite;
 }
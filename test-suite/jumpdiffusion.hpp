@@ -29,6 +29,7 @@ class JumpDiffusionTest {
   public:
     static void testMerton76();
     static void testGreeks();
+    static void testBatchValues();
     static boost::unit_test_framework::test_suite* suite();
 };
 
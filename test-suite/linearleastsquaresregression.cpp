@@ -23,6 +23,7 @@
 #include <ql/math/functional.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/linearleastsquaresregression.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -250,6 +251,64 @@ void LinearLeastSquaresRegressionTest::test1dLinearRegression() {
 }
 
 
+void LinearLeastSquaresRegressionTest::testIncrementalRegression() {
+
+    BOOST_TEST_MESSAGE("Testing incremental linear least-squares "
+                       "regression...");
+
+    const Size nr=10000;
+    PseudoRandom::rng_type rng(PseudoRandom::urng_type(1234u));
+
+    std::vector<boost::function1<Real, Real> > v;
+    v.push_back(constant<Real, Real>(1.0));
+    v.push_back(identity<Real>());
+    v.push_back(square<Real>());
+    v.push_back(std::ptr_fun<Real, Real>(std::sin));
+
+    // a singular design matrix
+    std::vector<boost::function1<Real, Real> > w(v);
+    w.push_back(square<Real>());
+
+    std::vector<Real> x(nr), y(nr);
+    for (Size i=0; i<nr; ++i) {
+        x[i] = 2.0*rng.next().value;
+        y[i] = 1.0 - 0.5*x[i] + 0.2*x[i]*x[i] + rng.next().value;
+    }
+
+    const std::vector<boost::function1<Real, Real> >* bases[] = { &v, &w };
+    for (Size k=0; k<LENGTH(bases); ++k) {
+        const std::vector<boost::function1<Real, Real> >& basis = *bases[k];
+        const Array expected =
+            GeneralLinearLeastSquares(x, y, basis).coefficients();
+
+        IncrementalLinearLeastSquares regression(basis.size());
+        Array values(basis.size());
+        for (Size i=0; i<nr; ++i) {
+            for (Size l=0; l<basis.size(); ++l)
+                values[l] = basis[l](x[i]);
+            regression.add(values, y[i]);
+        }
+        const Array calculated = regression.coefficients();
+
+        if (regression.size() != nr)
+            BOOST_FAIL("wrong number of samples: "
+                       << regression.size() << " instead of " << nr);
+
+        const Real tolerance = 1.0e-8;
+        for (Size l=0; l<basis.size(); ++l) {
+            if (std::fabs(calculated[l]-expected[l])
+                > tolerance*std::max(1.0, std::fabs(expected[l])))
+                BOOST_FAIL("failed to reproduce regression coefficient #"
+                           << l << " with " << basis.size()
+                           << " basis functions:"
+                           << std::setprecision(12)
+                           << "\n    calculated: " << calculated[l]
+                           << "\n    expected:   " << expected[l]
+                           << "\n    tolerance:  " << tolerance);
+        }
+    }
+}
+
 test_suite* LinearLeastSquaresRegressionTest::suite() {
     test_suite* suite =
         BOOST_TEST_SUITE("linear least squares regression tests");
@@ -259,6 +318,8 @@ test_suite* LinearLeastSquaresRegressionTest::suite() {
         &LinearLeastSquaresRegressionTest::testMultiDimRegression));
     suite->add(QUANTLIB_TEST_CASE(
         &LinearLeastSquaresRegressionTest::test1dLinearRegression));
+    suite->add(QUANTLIB_TEST_CASE(
+        &LinearLeastSquaresRegressionTest::testIncrementalRegression));
     return suite;
 }
 
@@ -1069,8 +1069,10 @@ void LowDiscrepancyTest::testSobolSkipping() {
             for (Size l=0; l<skip[k]; l++)
                 rsg1.nextInt32Sequence();
 
-            // skip n samples at once
+            // skip n samples at once, after having drawn a few
             SobolRsg rsg2(dimensionality[j], seed, integers[i]);
+            for (Size l=0; l<k; l++)
+                rsg2.nextInt32Sequence();
             rsg2.skipTo(skip[k]);
 
             // compare next 100 samples
@@ -1095,6 +1097,138 @@ void LowDiscrepancyTest::testSobolSkipping() {
 }
 
 
+void LowDiscrepancyTest::testSobolSharedDirectionIntegers() {
+
+    BOOST_TEST_MESSAGE("Testing Sobol generators sharing direction integers...");
+
+    // the direction integers of a generator can be reused by
+    // generators of lower dimensionality with the same settings
+    unsigned long seed = 2718;
+    Size low = 50, high = 500;
+    Size samples = 1000;
+
+    SobolRsg rsg1(low, seed, SobolRsg::Jaeckel);
+    std::vector<std::vector<unsigned long> > expected(samples);
+    for (Size i=0; i<samples; i++)
+        expected[i] = rsg1.nextInt32Sequence();
+
+    SobolRsg rsg2(high, seed, SobolRsg::Jaeckel);
+    SobolRsg rsg3(low, seed, SobolRsg::Jaeckel);
+    SobolRsg rsg4 = rsg3;
+    for (Size i=0; i<samples; i++) {
+        const std::vector<unsigned long>& s2 = rsg2.nextInt32Sequence();
+        const std::vector<unsigned long>& s3 = rsg3.nextInt32Sequence();
+        const std::vector<unsigned long>& s4 = rsg4.nextInt32Sequence();
+        if (s3.size() != low)
+            BOOST_FAIL("wrong dimensionality: " << s3.size()
+                       << " instead of " << low);
+        for (Size j=0; j<low; j++) {
+            if (s2[j] != expected[i][j]
+                || s3[j] != expected[i][j]
+                || s4[j] != expected[i][j])
+                BOOST_FAIL("Mismatch between generators:"
+                           << "\n  sample:    " << i
+                           << "\n  dimension: " << j
+                           << "\n  expected:  " << expected[i][j]
+                           << "\n  size " << high << ": " << s2[j]
+                           << "\n  size " << low << ":  " << s3[j]
+                           << "\n  copy:      " << s4[j]);
+        }
+    }
+
+    rsg1.skipTo(12345);
+    rsg3.skipTo(12345);
+    const std::vector<unsigned long>& s1 = rsg1.nextInt32Sequence();
+    const std::vector<unsigned long>& s3 = rsg3.nextInt32Sequence();
+    for (Size j=0; j<low; j++) {
+        if (s1[j] != s3[j])
+            BOOST_FAIL("Mismatch after skipping:"
+                       << "\n  dimension: " << j
+                       << "\n  expected:  " << s1[j]
+                       << "\n  found:     " << s3[j]);
+    }
+}
+
+void LowDiscrepancyTest::testScrambledSobol() {
+
+    BOOST_TEST_MESSAGE("Testing scrambled Sobol sequences...");
+
+    Size dimensionality = 20;
+    const Size m = 10, points = 1 << m;
+
+    SobolRsg rsg(dimensionality, 42);
+    rsg.randomize(42);
+    // the first points drawn are those with indices 1 to 2^m-1; the
+    // next block of 2^m points must still be a net, i.e., have
+    // exactly one point in each interval of width 2^-m
+    for (Size i=1; i<points; ++i)
+        rsg.nextSequence();
+    std::vector<std::vector<Size> > counts(dimensionality,
+                                           std::vector<Size>(points, 0));
+    for (Size i=0; i<points; ++i) {
+        const std::vector<Real>& x = rsg.nextSequence().value;
+        for (Size k=0; k<dimensionality; ++k) {
+            if (x[k] <= 0.0 || x[k] >= 1.0)
+                BOOST_FAIL("scrambled value out of (0,1):"
+                           << "\n  sample:    " << points+i
+                           << "\n  dimension: " << k
+                           << "\n  value:     " << x[k]);
+            ++counts[k][Size(x[k]*points)];
+        }
+    }
+    for (Size k=0; k<dimensionality; ++k) {
+        for (Size j=0; j<points; ++j) {
+            if (counts[k][j] != 1)
+                BOOST_FAIL("scrambling broke the stratification:"
+                           << "\n  dimension: " << k
+                           << "\n  interval:  " << j
+                           << "\n  points:    " << counts[k][j]);
+        }
+    }
+
+    // the same seed gives the same scrambling and restarts the
+    // sequence; batches of points match single draws
+    SobolRsg rsg2(dimensionality, 42), rsg3(dimensionality, 42);
+    rsg2.randomize(42);
+    rsg3.nextSequence();
+    rsg3.randomize(42);
+    SobolRsg rsg4(dimensionality, 42);
+    rsg4.randomize(43);
+    std::vector<Real> batch(points*dimensionality);
+    rsg3.nextSequences(points, &batch[0]);
+    bool different = false;
+    for (Size i=0; i<points; ++i) {
+        std::vector<Real> x = rsg2.nextSequence().value;
+        const std::vector<Real>& y = rsg4.nextSequence().value;
+        for (Size k=0; k<dimensionality; ++k) {
+            if (batch[k*points+i] != x[k])
+                BOOST_FAIL("failed to reproduce scrambled sequence:"
+                           << "\n  sample:    " << i
+                           << "\n  dimension: " << k
+                           << "\n  expected:  " << x[k]
+                           << "\n  found:     " << batch[k*points+i]);
+            if (y[k] != x[k])
+                different = true;
+        }
+    }
+    if (!different)
+        BOOST_ERROR("different seeds gave the same scrambling");
+
+    // skipping is consistent with sequential draws
+    rsg2.skipTo(points);
+    rsg.skipTo(points);
+    const std::vector<Real>& x = rsg.nextSequence().value;
+    const std::vector<Real>& y = rsg2.nextSequence().value;
+    for (Size k=0; k<dimensionality; ++k) {
+        if (x[k] != y[k])
+            BOOST_FAIL("Mismatch after skipping:"
+                       << "\n  dimension: " << k
+                       << "\n  expected:  " << x[k]
+                       << "\n  found:     " << y[k]);
+    }
+}
+
+
 test_suite* LowDiscrepancyTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Low-discrepancy sequence tests");
 
@@ -1132,6 +1266,10 @@ test_suite* LowDiscrepancyTest::suite() {
            &LowDiscrepancyTest::testSobolLevitanLemieuxSobolDiscrepancy));
 
     suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testSobolSkipping));
+    suite->add(QUANTLIB_TEST_CASE(
+           &LowDiscrepancyTest::testSobolSharedDirectionIntegers));
+    suite->add(QUANTLIB_TEST_CASE(
+           &LowDiscrepancyTest::testScrambledSobol));
 
     suite->add(QUANTLIB_TEST_CASE(
            &LowDiscrepancyTest::testRandomizedLowDiscrepancySequence));
@@ -48,6 +48,8 @@ class LowDiscrepancyTest {
     static void testRandomizedLowDiscrepancySequence();
 
     static void testSobolSkipping();
+    static void testSobolSharedDirectionIntegers();
+    static void testScrambledSobol();
 
     static void testRandomizedLattices();
 
@@ -25,6 +25,9 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include "marketmodel.hpp"
 #include "utilities.hpp"
 #include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/batchaccountingengine.hpp>
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
+#include <ql/models/marketmodels/distributedaccountingengine.hpp>
 #include <ql/models/marketmodels/browniangenerators/mtbrowniangenerator.hpp>
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <ql/models/marketmodels/callability/collectnodedata.hpp>
@@ -35,6 +38,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/callability/swapratetrigger.hpp>
 #include <ql/models/marketmodels/callability/triggeredswapexercise.hpp>
 #include <ql/models/marketmodels/callability/upperboundengine.hpp>
+#include <ql/models/marketmodels/callability/parallelupperboundengine.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeuler.hpp>
@@ -42,6 +46,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcbatch.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/models/abcdvol.hpp>
@@ -49,6 +54,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/correlations/expcorrelations.hpp>
 #include <ql/models/marketmodels/correlations/timehomogeneousforwardcorrelation.hpp>
 #include <ql/models/marketmodels/products/multiproductcomposite.hpp>
+#include <ql/models/marketmodels/products/singleproductcomposite.hpp>
 #include <ql/models/marketmodels/products/multistep/callspecifiedmultiproduct.hpp>
 #include <ql/models/marketmodels/products/multistep/exerciseadapter.hpp>
 #include <ql/models/marketmodels/products/multistep/multistepcoinitialswaps.hpp>
@@ -68,6 +74,11 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/models/fwdtocotswapadapter.hpp>
 #include <ql/models/marketmodels/models/cotswaptofwdadapter.hpp>
 #include <ql/models/marketmodels/utilities.hpp>
+#include <ql/models/marketmodels/historicalforwardratesanalysis.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/indexes/swap/euriborswap.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/methods/montecarlo/genericlsregression.hpp>
 #include <ql/legacy/libormarketmodels/lmlinexpcorrmodel.hpp>
 #include <ql/legacy/libormarketmodels/lmextlinexpvolmodel.hpp>
@@ -4374,6 +4385,34 @@ void MarketModelTest::testAbcdVolatilityIntegration() {
             }
         }
     }
+
+    // all the fixing times at once
+    std::vector<Time> fixingTimes(N);
+    for (Size i=0; i<N; i++)
+        fixingTimes[i] = 0.5*(N-i);
+    for (Size j=0; j<N; j++) {
+        Real xMin = 0.5*j;
+        for (Size l=0; l<N-j; l++) {
+            Real xMax = xMin + 0.25*l;
+            Matrix covariances =
+                instVol->covariance(xMin, xMax, fixingTimes);
+            for (Size i=0; i<N; i++) {
+                for (Size k=0; k<N; k++) {
+                    Real expected = instVol->covariance(xMin, xMax,
+                                                        fixingTimes[i],
+                                                        fixingTimes[k]);
+                    if (std::abs(covariances[i][k]-expected)>1e-15) {
+                        BOOST_ERROR("     T1=" << fixingTimes[i] << "," <<
+                            "T2=" << fixingTimes[k] << ",\t\t" <<
+                            "xMin=" << xMin << "," <<
+                            "xMax=" << xMax << ",\t\t" <<
+                            "matrix: " << covariances[i][k] << ",\t" <<
+                            "scalar: " << expected);
+                    }
+                }
+            }
+        }
+    }
 }
 
 void MarketModelTest::testAbcdVolatilityCompare() {
@@ -4437,6 +4476,36 @@ void MarketModelTest::testAbcdVolatilityFit() {
     Real d0 = instVol.d();
     Real error0 = instVol.error();
 
+    // analytic derivatives of the Black volatilities
+    std::vector<Real> derivatives(4);
+    Real parameters[] = { a0, b0, c0, d0 };
+    Real h = 1.0e-6;
+    for (Size i=0; i<rateTimes.size()-1; i++) {
+        Real u = rateTimes[i];
+        Real vol = abcdBlackVolatility(u, a0, b0, c0, d0, derivatives);
+        if (std::abs(vol - abcdBlackVolatility(u, a0, b0, c0, d0))>1e-14)
+            BOOST_ERROR("\n Fixing Time = " << u <<
+                        "\n volatility  = " << vol <<
+                        "\n expected    = " <<
+                        abcdBlackVolatility(u, a0, b0, c0, d0));
+        for (Size j=0; j<4; j++) {
+            Real up[4], down[4];
+            std::copy(parameters, parameters+4, up);
+            std::copy(parameters, parameters+4, down);
+            up[j] += h;
+            down[j] -= h;
+            Real numerical =
+                (abcdBlackVolatility(u, up[0], up[1], up[2], up[3]) -
+                 abcdBlackVolatility(u, down[0], down[1], down[2], down[3]))
+                / (2.0*h);
+            if (std::abs(derivatives[j]-numerical)>1e-8)
+                BOOST_ERROR("\n Fixing Time = " << u <<
+                            "\n parameter   = " << j <<
+                            "\n analytical  = " << derivatives[j] <<
+                            "\n numerical   = " << numerical);
+        }
+    }
+
     instVol.compute();
 
     EndCriteria::Type ec = instVol.endCriteria();
@@ -4860,6 +4929,667 @@ void MarketModelTest::testCovariance() {
     }
 }
 
+void MarketModelTest::testParallelAccountingEngine() {
+
+    BOOST_TEST_MESSAGE("Testing parallel accounting engine "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    std::vector<boost::shared_ptr<Payoff> > optionletPayoffs(
+                                                     todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i)
+        optionletPayoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+    MultiStepOptionlets product(rateTimes, accruals,
+                                paymentTimes, optionletPayoffs);
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationFlatVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    const Size paths = 4001;
+    SobolBrownianGeneratorFactory serialFactory(
+                                     SobolBrownianGenerator::Diagonal, seed_);
+    boost::shared_ptr<MarketModelEvolver> serialEvolver =
+        makeMarketModelEvolver(marketModel, numeraires, serialFactory, Pc);
+    AccountingEngine serialEngine(serialEvolver, product,
+                                  initialNumeraireValue);
+    SequenceStatisticsInc expected(product.numberOfProducts());
+    serialEngine.multiplePathValues(expected, paths);
+
+    const Size workers = 3;
+    typedef ParallelAccountingEngine<AccountingEngine> parallel_engine;
+    std::vector<boost::shared_ptr<AccountingEngine> > engines;
+    for (Size i=0; i<workers; ++i) {
+        SobolBrownianGeneratorFactory factory(
+                         SobolBrownianGenerator::Diagonal, seed_,
+                         SobolRsg::Jaeckel,
+                         parallel_engine::firstPath(i, workers, paths));
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            makeMarketModelEvolver(marketModel, numeraires, factory, Pc);
+        engines.push_back(boost::shared_ptr<AccountingEngine>(
+                 new AccountingEngine(evolver, product,
+                                      initialNumeraireValue)));
+    }
+    parallel_engine engine(engines);
+    SequenceStatisticsInc calculated(product.numberOfProducts());
+    engine.multiplePathValues(calculated, paths);
+
+    if (calculated.samples() != paths)
+        BOOST_FAIL("wrong number of samples: "
+                   << calculated.samples() << " instead of " << paths);
+
+    std::vector<Real> expectedMeans = expected.mean();
+    std::vector<Real> calculatedMeans = calculated.mean();
+    std::vector<Real> expectedErrors = expected.errorEstimate();
+    std::vector<Real> calculatedErrors = calculated.errorEstimate();
+    const Real tolerance = 1.0e-12;
+    for (Size i=0; i<expectedMeans.size(); ++i) {
+        if (std::fabs(calculatedMeans[i]-expectedMeans[i]) > tolerance
+            || std::fabs(calculatedErrors[i]-expectedErrors[i]) > tolerance)
+            BOOST_FAIL("failed to reproduce serial simulation for "
+                       << io::ordinal(i+1) << " optionlet:"
+                       << std::setprecision(12)
+                       << "\n    serial mean:      " << expectedMeans[i]
+                       << "\n    parallel mean:    " << calculatedMeans[i]
+                       << "\n    serial error:     " << expectedErrors[i]
+                       << "\n    parallel error:   " << calculatedErrors[i]);
+    }
+}
+
+void MarketModelTest::testDistributedAccountingEngine() {
+
+    BOOST_TEST_MESSAGE("Testing distributed accounting engine "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    std::vector<boost::shared_ptr<Payoff> > optionletPayoffs(
+                                                     todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i)
+        optionletPayoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+    MultiStepOptionlets product(rateTimes, accruals,
+                                paymentTimes, optionletPayoffs);
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationFlatVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    const Size paths = 4001;
+    MTBrownianGeneratorFactory serialFactory(seed_);
+    boost::shared_ptr<MarketModelEvolver> serialEvolver =
+        makeMarketModelEvolver(marketModel, numeraires, serialFactory, Pc);
+    AccountingEngine serialEngine(serialEvolver, product,
+                                  initialNumeraireValue);
+    SequenceStatisticsInc expected(product.numberOfProducts());
+    serialEngine.multiplePathValues(expected, paths);
+
+    // the first process collects the path values; it is run last so
+    // that the values of the others are available
+    const Size processes = 3;
+    typedef DistributedAccountingEngine<AccountingEngine> distributed_engine;
+    boost::shared_ptr<std::vector<std::vector<Real> > > board(
+                           new std::vector<std::vector<Real> >(processes));
+    for (Size i=processes; i>0; --i) {
+        Size rank = i-1;
+        MTBrownianGeneratorFactory factory(
+                 seed_, distributed_engine::firstPath(rank, processes, paths));
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            makeMarketModelEvolver(marketModel, numeraires, factory, Pc);
+        distributed_engine engine(
+            boost::shared_ptr<AccountingEngine>(
+                 new AccountingEngine(evolver, product,
+                                      initialNumeraireValue)),
+            boost::shared_ptr<SampleCommunicator>(
+                                   new SharedBoardCommunicator(rank, board)));
+        SequenceStatisticsInc calculated(product.numberOfProducts());
+        engine.multiplePathValues(calculated, paths);
+
+        if (rank > 0) {
+            if (calculated.samples() != 0)
+                BOOST_FAIL("statistics modified in process " << rank);
+            continue;
+        }
+
+        if (calculated.samples() != paths)
+            BOOST_FAIL("wrong number of samples: "
+                       << calculated.samples() << " instead of " << paths);
+
+        std::vector<Real> expectedMeans = expected.mean();
+        std::vector<Real> calculatedMeans = calculated.mean();
+        std::vector<Real> expectedErrors = expected.errorEstimate();
+        std::vector<Real> calculatedErrors = calculated.errorEstimate();
+        const Real tolerance = 1.0e-12;
+        for (Size j=0; j<expectedMeans.size(); ++j) {
+            if (std::fabs(calculatedMeans[j]-expectedMeans[j]) > tolerance
+                || std::fabs(calculatedErrors[j]-expectedErrors[j])
+                                                              > tolerance)
+                BOOST_FAIL("failed to reproduce serial simulation for "
+                           << io::ordinal(j+1) << " optionlet:"
+                           << std::setprecision(12)
+                           << "\n    serial mean:       "
+                           << expectedMeans[j]
+                           << "\n    distributed mean:  "
+                           << calculatedMeans[j]
+                           << "\n    serial error:      "
+                           << expectedErrors[j]
+                           << "\n    distributed error: "
+                           << calculatedErrors[j]);
+        }
+    }
+}
+
+namespace {
+
+    // the serial engine skips no paths; the workers skip the paths
+    // simulated by the previous ones
+    boost::shared_ptr<UpperBoundEngine> makeUpperBoundEngine(
+                const boost::shared_ptr<MarketModel>& marketModel,
+                const std::vector<Size>& numeraires,
+                const std::valarray<bool>& isExerciseTime,
+                const MultiStepSwap& swap,
+                const NothingExerciseValue& rebate,
+                const SwapRateTrigger& strategy,
+                Real initialNumeraireValue,
+                unsigned long seed,
+                Size outerSkip, Size innerSkip) {
+        SobolBrownianGeneratorFactory outerFactory(
+                                    SobolBrownianGenerator::Diagonal, seed,
+                                    SobolRsg::Jaeckel, outerSkip);
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            makeMarketModelEvolver(marketModel, numeraires,
+                                   outerFactory, Pc);
+        // same seed for all the inner simulations, which therefore
+        // use common random numbers
+        std::vector<boost::shared_ptr<MarketModelEvolver> > inner;
+        for (Size s=0; s<isExerciseTime.size(); ++s) {
+            if (isExerciseTime[s]) {
+                SobolBrownianGeneratorFactory innerFactory(
+                                    SobolBrownianGenerator::Diagonal, seed+1,
+                                    SobolRsg::Jaeckel, innerSkip);
+                inner.push_back(makeMarketModelEvolver(marketModel,
+                                                       numeraires,
+                                                       innerFactory,
+                                                       Pc, s));
+            }
+        }
+        return boost::shared_ptr<UpperBoundEngine>(
+            new UpperBoundEngine(evolver, inner,
+                                 swap, rebate, swap, rebate,
+                                 strategy, initialNumeraireValue));
+    }
+
+}
+
+void MarketModelTest::testParallelPathwiseVegas() {
+
+    BOOST_TEST_MESSAGE("Testing parallel pathwise vegas "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    MarketModelPathwiseMultiDeflatedCaplet caplets(rateTimes, accruals,
+                                                   paymentTimes,
+                                                   todaysForwards);
+
+    EvolutionDescription evolution = caplets.evolution();
+    std::vector<Size> numeraires = caplets.suggestedNumeraires();
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationAbcdVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    // one bump per step, scaling the whole pseudo-root of the step
+    Size steps = evolution.numberOfSteps();
+    std::vector<std::vector<Matrix> > bumps(steps);
+    for (Size i=0; i<steps; ++i) {
+        for (Size j=0; j<steps; ++j) {
+            if (i == j)
+                bumps[i].push_back(marketModel->pseudoRoot(i));
+            else
+                bumps[i].push_back(Matrix(marketModel->numberOfRates(),
+                                          marketModel->numberOfFactors(),
+                                          0.0));
+        }
+    }
+
+    const Size paths = 1001;
+    MTBrownianGeneratorFactory serialFactory(seed_);
+    PathwiseVegasAccountingEngine serialEngine(
+        boost::shared_ptr<LogNormalFwdRateEuler>(new
+            LogNormalFwdRateEuler(marketModel, serialFactory, numeraires)),
+        caplets, marketModel, bumps, initialNumeraireValue);
+    std::vector<Real> expectedMeans, expectedErrors;
+    serialEngine.multiplePathValues(expectedMeans, expectedErrors, paths);
+
+    const Size workers = 3;
+    typedef ParallelAccountingEngine<PathwiseVegasAccountingEngine>
+                                                             parallel_engine;
+    std::vector<boost::shared_ptr<PathwiseVegasAccountingEngine> > engines;
+    for (Size i=0; i<workers; ++i) {
+        MTBrownianGeneratorFactory factory(
+                     seed_, parallel_engine::firstPath(i, workers, paths));
+        engines.push_back(boost::shared_ptr<PathwiseVegasAccountingEngine>(
+            new PathwiseVegasAccountingEngine(
+                boost::shared_ptr<LogNormalFwdRateEuler>(new
+                    LogNormalFwdRateEuler(marketModel, factory, numeraires)),
+                caplets, marketModel, bumps, initialNumeraireValue)));
+    }
+    parallel_engine engine(engines);
+    std::vector<Real> calculatedMeans, calculatedErrors;
+    engine.multiplePathValues(calculatedMeans, calculatedErrors, paths);
+
+    if (calculatedMeans.size() != expectedMeans.size())
+        BOOST_FAIL("wrong number of values: " << calculatedMeans.size()
+                   << " instead of " << expectedMeans.size());
+
+    const Real tolerance = 1.0e-12;
+    for (Size i=0; i<expectedMeans.size(); ++i) {
+        if (std::fabs(calculatedMeans[i]-expectedMeans[i]) > tolerance
+            || std::fabs(calculatedErrors[i]-expectedErrors[i]) > tolerance)
+            BOOST_FAIL("failed to reproduce serial simulation for "
+                       << io::ordinal(i+1) << " value:"
+                       << std::setprecision(12)
+                       << "\n    serial mean:      " << expectedMeans[i]
+                       << "\n    parallel mean:    " << calculatedMeans[i]
+                       << "\n    serial error:     " << expectedErrors[i]
+                       << "\n    parallel error:   " << calculatedErrors[i]);
+    }
+}
+
+void MarketModelTest::testParallelUpperBoundEngine() {
+
+    BOOST_TEST_MESSAGE("Testing parallel upper-bound engine "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+                               fixedRate, false);
+
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    EvolutionDescription evolution = receiverSwap.evolution();
+    std::vector<Size> numeraires = terminalMeasure(evolution);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationFlatVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+    std::valarray<bool> isExerciseTime =
+        isInSubset(evolution.evolutionTimes(), naifStrategy.exerciseTimes());
+
+    const Size outerPaths = 31, innerPaths = 16;
+
+    Statistics expected;
+    makeUpperBoundEngine(marketModel, numeraires, isExerciseTime,
+                         receiverSwap, nullRebate, naifStrategy,
+                         initialNumeraireValue, seed_, 0, 0)
+        ->multiplePathValues(expected, outerPaths, innerPaths);
+
+    const Size workers = 3;
+    std::vector<boost::shared_ptr<UpperBoundEngine> > engines;
+    for (Size i=0; i<workers; ++i) {
+        Size first =
+            ParallelUpperBoundEngine::firstPath(i, workers, outerPaths);
+        engines.push_back(makeUpperBoundEngine(marketModel, numeraires,
+                                               isExerciseTime, receiverSwap,
+                                               nullRebate, naifStrategy,
+                                               initialNumeraireValue, seed_,
+                                               first, first*innerPaths));
+    }
+    ParallelUpperBoundEngine engine(engines);
+    Statistics calculated;
+    engine.multiplePathValues(calculated, outerPaths, innerPaths);
+
+    if (calculated.samples() != outerPaths)
+        BOOST_FAIL("wrong number of samples: "
+                   << calculated.samples() << " instead of " << outerPaths);
+
+    const Real tolerance = 1.0e-12;
+    if (std::fabs(calculated.mean()-expected.mean()) > tolerance
+        || std::fabs(calculated.errorEstimate()-expected.errorEstimate())
+                                                                > tolerance)
+        BOOST_FAIL("failed to reproduce serial upper-bound estimate:"
+                   << std::setprecision(12)
+                   << "\n    serial mean:      " << expected.mean()
+                   << "\n    parallel mean:    " << calculated.mean()
+                   << "\n    serial error:     " << expected.errorEstimate()
+                   << "\n    parallel error:   "
+                   << calculated.errorEstimate());
+
+    if (engine.workerTimes().size() != workers
+        || engine.cpuTime() < 0.0 || engine.elapsedTime() < 0.0
+        || engine.workNormalizedVariance(calculated) < 0.0)
+        BOOST_ERROR("invalid cost report:"
+                    << "\n    CPU time:      " << engine.cpuTime()
+                    << "\n    elapsed time:  " << engine.elapsedTime()
+                    << "\n    work-normalized variance: "
+                    << engine.workNormalizedVariance(calculated));
+}
+
+void MarketModelTest::testBatchAccountingEngine() {
+
+    BOOST_TEST_MESSAGE("Testing batch accounting engine "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    std::vector<boost::shared_ptr<Payoff> > optionletPayoffs(
+                                                     todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i)
+        optionletPayoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+    MultiStepOptionlets optionlets(rateTimes, accruals,
+                                   paymentTimes, optionletPayoffs);
+    MultiStepSwap swap(rateTimes, accruals, accruals, paymentTimes,
+                       0.04, true);
+    MultiProductComposite product;
+    product.add(optionlets);
+    product.add(swap);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    const Size paths = 1001, lanes = 64;
+    // reduced and full factors use different drift calculations
+    Size factors[] = { 3, todaysForwards.size() };
+    for (Size k=0; k<LENGTH(factors); ++k) {
+        boost::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, factors[k],
+                            ExponentialCorrelationFlatVolatility);
+        SobolBrownianGeneratorFactory factory(
+                                     SobolBrownianGenerator::Diagonal, seed_);
+
+        boost::shared_ptr<MarketModelEvolver> evolver =
+            makeMarketModelEvolver(marketModel, numeraires, factory, Pc);
+        AccountingEngine serialEngine(evolver, product,
+                                      initialNumeraireValue);
+        SequenceStatisticsInc expected(product.numberOfProducts());
+        serialEngine.multiplePathValues(expected, paths);
+
+        boost::shared_ptr<LogNormalFwdRatePcBatch> batchEvolver(
+              new LogNormalFwdRatePcBatch(marketModel, factory,
+                                          numeraires, lanes));
+        BatchAccountingEngine batchEngine(batchEvolver, product,
+                                          initialNumeraireValue);
+        SequenceStatisticsInc calculated(product.numberOfProducts());
+        batchEngine.multiplePathValues(calculated, paths);
+
+        if (calculated.samples() != paths)
+            BOOST_FAIL("wrong number of samples: "
+                       << calculated.samples() << " instead of " << paths);
+
+        std::vector<Real> expectedMeans = expected.mean();
+        std::vector<Real> calculatedMeans = calculated.mean();
+        std::vector<Real> expectedErrors = expected.errorEstimate();
+        std::vector<Real> calculatedErrors = calculated.errorEstimate();
+        const Real tolerance = 1.0e-12;
+        for (Size i=0; i<expectedMeans.size(); ++i) {
+            if (std::fabs(calculatedMeans[i]-expectedMeans[i]) > tolerance
+                || std::fabs(calculatedErrors[i]-expectedErrors[i])
+                                                                > tolerance)
+                BOOST_ERROR("failed to reproduce serial simulation for "
+                            << io::ordinal(i+1) << " product with "
+                            << factors[k] << " factors:"
+                            << std::setprecision(12)
+                            << "\n    serial mean:    " << expectedMeans[i]
+                            << "\n    batch mean:     " << calculatedMeans[i]
+                            << "\n    serial error:   " << expectedErrors[i]
+                            << "\n    batch error:    "
+                            << calculatedErrors[i]);
+        }
+    }
+}
+
+void MarketModelTest::testParallelCompositeEvaluation() {
+
+    BOOST_TEST_MESSAGE("Testing parallel evaluation of composite products "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    // interleaved products of two types
+    MultiProductComposite product;
+    SingleProductComposite book;
+    Real strikes[] = { 0.03, 0.04, 0.05 };
+    for (Size j=0; j<LENGTH(strikes); ++j) {
+        std::vector<boost::shared_ptr<Payoff> > optionletPayoffs(
+                                                     todaysForwards.size());
+        for (Size i=0; i<todaysForwards.size(); ++i)
+            optionletPayoffs[i] = boost::shared_ptr<Payoff>(new
+                PlainVanillaPayoff(Option::Call, strikes[j]));
+        MultiStepOptionlets optionlets(rateTimes, accruals,
+                                       paymentTimes, optionletPayoffs);
+        MultiStepSwap swap(rateTimes, accruals, accruals, paymentTimes,
+                           strikes[j], j % 2 == 0);
+        product.add(optionlets);
+        product.add(swap);
+        book.add(optionlets, 0.5);
+        book.subtract(swap);
+    }
+    product.finalize();
+    book.finalize();
+
+    if (product.batches().size() != 2)
+        BOOST_FAIL("wrong number of batches: "
+                   << product.batches().size() << " instead of 2");
+    for (Size b=0; b<product.batches().size(); ++b) {
+        const std::vector<Size>& batch = product.batches()[b];
+        for (Size k=0; k<batch.size(); ++k) {
+            if (batch[k] != 2*k+b)
+                BOOST_FAIL("wrong composition of " << io::ordinal(b+1)
+                           << " batch");
+        }
+    }
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationFlatVolatility);
+    SobolBrownianGeneratorFactory factory(SobolBrownianGenerator::Diagonal,
+                                          seed_);
+
+    const Size paths = 1001;
+    MarketModelComposite* composites[] = { &product, &book };
+    for (Size c=0; c<LENGTH(composites); ++c) {
+        MarketModelComposite& composite = *composites[c];
+        SequenceStatisticsInc expected(composite.numberOfProducts());
+        {
+            boost::shared_ptr<MarketModelEvolver> evolver =
+                makeMarketModelEvolver(marketModel, numeraires, factory, Pc);
+            AccountingEngine engine(evolver, composite,
+                                    initialNumeraireValue);
+            engine.multiplePathValues(expected, paths);
+        }
+
+        composite.setParallelEvaluation(true);
+        SequenceStatisticsInc calculated(composite.numberOfProducts());
+        {
+            boost::shared_ptr<MarketModelEvolver> evolver =
+                makeMarketModelEvolver(marketModel, numeraires, factory, Pc);
+            AccountingEngine engine(evolver, composite,
+                                    initialNumeraireValue);
+            engine.multiplePathValues(calculated, paths);
+        }
+        composite.setParallelEvaluation(false);
+
+        std::vector<Real> expectedMeans = expected.mean();
+        std::vector<Real> calculatedMeans = calculated.mean();
+        const Real tolerance = 1.0e-12;
+        for (Size i=0; i<expectedMeans.size(); ++i) {
+            if (std::fabs(calculatedMeans[i]-expectedMeans[i]) > tolerance)
+                BOOST_ERROR("failed to reproduce serial evaluation for "
+                            << io::ordinal(i+1) << " product of "
+                            << (c == 0 ? "multi-product" : "single-product")
+                            << " composite:"
+                            << std::setprecision(12)
+                            << "\n    serial mean:    " << expectedMeans[i]
+                            << "\n    parallel mean:  "
+                            << calculatedMeans[i]);
+        }
+    }
+}
+
+namespace {
+
+    // synthetic quote of the given tenor (in years) on the n-th date
+    Rate historicalQuote(Real tenor, Size n) {
+        return 0.02 + 0.03*(1.0-std::exp(-tenor/3.0))
+             + 0.001*std::sin(0.3*n) + 0.0005*std::cos(0.7*n)*tenor/10.0;
+    }
+
+}
+
+void MarketModelTest::testHistoricalForwardRatesAnalysis() {
+
+    BOOST_TEST_MESSAGE("Testing historical forward-rate analysis "
+                       "against a serial bootstrap...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    std::vector<boost::shared_ptr<IborIndex> > iborIndexes;
+    iborIndexes.push_back(boost::shared_ptr<IborIndex>(new Euribor1M));
+    iborIndexes.push_back(boost::shared_ptr<IborIndex>(new Euribor3M));
+    iborIndexes.push_back(boost::shared_ptr<IborIndex>(new Euribor6M));
+    iborIndexes.push_back(boost::shared_ptr<IborIndex>(new Euribor1Y));
+    std::vector<boost::shared_ptr<SwapIndex> > swapIndexes;
+    Integer swapTenors[] = { 2, 3, 5, 7, 10 };
+    for (Size j=0; j<LENGTH(swapTenors); ++j)
+        swapIndexes.push_back(boost::shared_ptr<SwapIndex>(
+                        new EuriborSwapIsdaFixA(swapTenors[j]*Years)));
+
+    // the 5-year swap fixing is missing on every seventh date, which
+    // is therefore skipped
+    Calendar calendar = TARGET();
+    Date startDate(1, February, 2010), endDate(31, May, 2010);
+    std::vector<Date> expectedSkippedDates;
+    Size n = 0;
+    for (Date d = calendar.advance(startDate, 1*Days, Following);
+         d <= endDate; d = calendar.advance(d, 1*Days, Following), ++n) {
+        for (Size j=0; j<iborIndexes.size(); ++j)
+            iborIndexes[j]->addFixing(d, historicalQuote(
+                    iborIndexes[j]->tenor().length()/
+                    (iborIndexes[j]->tenor().units() == Months ? 12.0 : 1.0),
+                    n));
+        for (Size j=0; j<swapIndexes.size(); ++j) {
+            if (swapTenors[j] == 5 && n % 7 == 3)
+                continue;
+            swapIndexes[j]->addFixing(d, historicalQuote(swapTenors[j], n));
+        }
+        if (n % 7 == 3)
+            expectedSkippedDates.push_back(d);
+    }
+
+    boost::shared_ptr<InterestRateIndex> fwdIndex(new Euribor3M);
+    Period initialGap = 3*Months, horizon = 5*Years;
+    DayCounter dayCounter = Actual365Fixed();
+
+    SequenceStatistics statistics;
+    std::vector<Date> skippedDates, failedDates;
+    std::vector<std::string> skippedMessages, failedMessages;
+    std::vector<Period> fixingPeriods;
+    historicalForwardRatesAnalysis<ZeroYield,Linear>(
+                statistics, skippedDates, skippedMessages,
+                failedDates, failedMessages, fixingPeriods,
+                startDate, endDate, 1*Days, fwdIndex, initialGap, horizon,
+                iborIndexes, swapIndexes, dayCounter);
+
+    if (skippedDates != expectedSkippedDates)
+        BOOST_FAIL("wrong skipped dates: " << skippedDates.size()
+                   << " skipped, " << expectedSkippedDates.size()
+                   << " expected");
+    if (!failedDates.empty())
+        BOOST_FAIL("unexpected failure on " << failedDates.front()
+                   << ": " << failedMessages.front());
+
+    // serial calculation: a new curve is bootstrapped on each date
+    Size nRates = fixingPeriods.size();
+    SequenceStatistics expected(nRates);
+    std::vector<Rate> fwdRates(nRates), previousFwdRates(nRates),
+                      fwdRatesDiff(nRates);
+    bool first = true;
+    Settings::instance().enforcesTodaysHistoricFixings() = true;
+    for (Date d = calendar.advance(startDate, 1*Days, Following);
+         d <= endDate; d = calendar.advance(d, 1*Days, Following)) {
+        if (std::find(expectedSkippedDates.begin(),
+                      expectedSkippedDates.end(), d)
+            != expectedSkippedDates.end())
+            continue;
+        Settings::instance().evaluationDate() = d;
+        std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+        for (Size j=0; j<iborIndexes.size(); ++j)
+            quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                          new SimpleQuote(iborIndexes[j]->fixing(d))));
+        for (Size j=0; j<swapIndexes.size(); ++j)
+            quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                          new SimpleQuote(swapIndexes[j]->fixing(d))));
+        PiecewiseYieldCurve<ZeroYield,Linear> curve(
+               0, calendar,
+               detail::historicalRateHelpers(iborIndexes, swapIndexes, quotes),
+               dayCounter);
+        for (Size j=0; j<nRates; ++j)
+            fwdRates[j] = curve.forwardRate(d + fixingPeriods[j],
+                                            fwdIndex->tenor(),
+                                            fwdIndex->dayCounter(),
+                                            Simple);
+        if (!first) {
+            for (Size j=0; j<nRates; ++j)
+                fwdRatesDiff[j] = fwdRates[j]/previousFwdRates[j] - 1.0;
+            expected.add(fwdRatesDiff.begin(), fwdRatesDiff.end());
+        }
+        first = false;
+        std::swap(previousFwdRates, fwdRates);
+    }
+
+    if (statistics.samples() != expected.samples())
+        BOOST_FAIL("wrong number of samples: " << statistics.samples()
+                   << " instead of " << expected.samples());
+
+    std::vector<Real> calculatedMeans = statistics.mean();
+    std::vector<Real> expectedMeans = expected.mean();
+    Matrix calculatedCovariance = statistics.covariance();
+    Matrix expectedCovariance = expected.covariance();
+    const Real tolerance = 1.0e-10;
+    for (Size i=0; i<nRates; ++i) {
+        if (std::fabs(calculatedMeans[i]-expectedMeans[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce serial mean of "
+                        << io::ordinal(i+1) << " forward-rate change:"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculatedMeans[i]
+                        << "\n    expected:   " << expectedMeans[i]);
+        for (Size j=0; j<nRates; ++j) {
+            if (std::fabs(calculatedCovariance[i][j]
+                          -expectedCovariance[i][j]) > tolerance)
+                BOOST_ERROR("failed to reproduce serial covariance of "
+                            << io::ordinal(i+1) << " and "
+                            << io::ordinal(j+1) << " forward-rate changes:"
+                            << std::setprecision(12)
+                            << "\n    calculated: "
+                            << calculatedCovariance[i][j]
+                            << "\n    expected:   "
+                            << expectedCovariance[i][j]);
+        }
+    }
+}
+
 // --- Call the desired tests
 test_suite* MarketModelTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Market-model tests");
@@ -4887,6 +5617,20 @@ test_suite* MarketModelTest::suite(SpeedLevel speed) {
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdDegenerateCases));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCovariance));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &MarketModelTest::testParallelAccountingEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &MarketModelTest::testDistributedAccountingEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &MarketModelTest::testParallelPathwiseVegas));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &MarketModelTest::testParallelUpperBoundEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &MarketModelTest::testBatchAccountingEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+                     &MarketModelTest::testParallelCompositeEvaluation));
+    suite->add(QUANTLIB_TEST_CASE(
+                     &MarketModelTest::testHistoricalForwardRatesAnalysis));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPathwiseVegas));
@@ -55,6 +55,13 @@ class MarketModelTest {
     static void testIsInSubset();
     static void testAbcdDegenerateCases();
     static void testCovariance();
+    static void testParallelAccountingEngine();
+    static void testDistributedAccountingEngine();
+    static void testParallelPathwiseVegas();
+    static void testParallelUpperBoundEngine();
+    static void testBatchAccountingEngine();
+    static void testParallelCompositeEvaluation();
+    static void testHistoricalForwardRatesAnalysis();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -1748,6 +1748,68 @@ void MarkovFunctionalTest::testBermudanSwaption() {
     Settings::instance().evaluationDate() = savedEvalDate;
 }
 
+void MarkovFunctionalTest::testRecalibrationAfterCurveChange() {
+
+    BOOST_TEST_MESSAGE("Testing Markov functional recalculation after a "
+                       "change of the yield term structure...");
+
+    Date savedEvalDate = Settings::instance().evaluationDate();
+    Date referenceDate(14, November, 2012);
+    Settings::instance().evaluationDate() = referenceDate;
+
+    Handle<YieldTermStructure> flatYts_ = flatYts();
+    Handle<YieldTermStructure> md0Yts_ = md0Yts();
+    Handle<SwaptionVolatilityStructure> md0SwaptionVts_ = md0SwaptionVts();
+
+    boost::shared_ptr<SwapIndex> swapIndexBase(
+        new EuriborSwapIsdaFixA(1 * Years));
+
+    std::vector<Date> volStepDates;
+    std::vector<Real> vols;
+    vols.push_back(1.0);
+
+    MarkovFunctional::ModelSettings settings =
+        MarkovFunctional::ModelSettings()
+            .withYGridPoints(32)
+            .withYStdDevs(7.0)
+            .withGaussHermitePoints(16)
+            .withMarketRateAccuracy(1e-7)
+            .withDigitalGap(1e-5)
+            .withLowerRateBound(0.0)
+            .withUpperRateBound(2.0);
+
+    RelinkableHandle<YieldTermStructure> yts(*flatYts_);
+
+    // the tabulation on the flat curve provides the initial guesses
+    // for the one on the new curve
+    boost::shared_ptr<MarkovFunctional> mf1(new MarkovFunctional(
+        yts, 0.01, volStepDates, vols, md0SwaptionVts_, expiriesCalBasket1(),
+        tenorsCalBasket1(), swapIndexBase, settings));
+    mf1->zerobond(10.0, 5.0, 0.0);
+    yts.linkTo(*md0Yts_);
+
+    boost::shared_ptr<MarkovFunctional> mf2(new MarkovFunctional(
+        md0Yts_, 0.01, volStepDates, vols, md0SwaptionVts_,
+        expiriesCalBasket1(), tenorsCalBasket1(), swapIndexBase, settings));
+
+    const Real tol = 1.0E-5;
+
+    for (Real t = 1.0; t <= 5.0; t += 1.0) {
+        for (Real y = -3.0; y <= 3.0; y += 0.5) {
+            Real recalculated = mf1->zerobond(t + 10.0, t, y);
+            Real fresh = mf2->zerobond(t + 10.0, t, y);
+            if (std::fabs(recalculated - fresh) > tol)
+                BOOST_ERROR("recalculated model zerobond ("
+                            << recalculated
+                            << ") deviates from the one of a new model ("
+                            << fresh << ") at t=" << t << ", y=" << y
+                            << "\n    tolerance: " << tol);
+        }
+    }
+
+    Settings::instance().evaluationDate() = savedEvalDate;
+}
+
 test_suite *MarkovFunctionalTest::suite(SpeedLevel speed) {
     test_suite *suite = BOOST_TEST_SUITE("Markov functional model tests");
 
@@ -1756,6 +1818,8 @@ test_suite *MarkovFunctionalTest::suite(SpeedLevel speed) {
         &MarkovFunctionalTest::testKahaleSmileSection));
     suite->add(QUANTLIB_TEST_CASE(
         &MarkovFunctionalTest::testBermudanSwaption));
+    suite->add(QUANTLIB_TEST_CASE(
+        &MarkovFunctionalTest::testRecalibrationAfterCurveChange));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -185,6 +185,68 @@ void MatricesTest::testHighamSqrt() {
     }
 }
 
+void MatricesTest::testPseudoSqrtCalculator() {
+    BOOST_TEST_MESSAGE("Testing pseudo square roots of sequences "
+                       "of matrices...");
+
+    setup();
+
+    // the Higham correction must be the same as the one of the function
+    PseudoSqrtCalculator higham(SalvagingAlgorithm::Higham);
+    Matrix tempSqrt = higham.pseudoSqrt(M5);
+    Matrix ansSqrt = pseudoSqrt(M6, SalvagingAlgorithm::None);
+    Real error = norm(ansSqrt - tempSqrt);
+    Real tolerance = 1.0e-4;
+    if (error>tolerance) {
+        BOOST_FAIL("Higham matrix correction failed\n"
+                   << "original matrix:\n" << M5
+                   << "pseudoSqrt:\n" << tempSqrt
+                   << "should be:\n" << ansSqrt
+                   << "\nerror:     " << error
+                   << "\ntolerance: " << tolerance);
+    }
+
+    // slowly changing correlation matrices
+    Size size = 20;
+    Matrix correlation(size, size);
+    PseudoSqrtCalculator calculator(SalvagingAlgorithm::Spectral);
+    tolerance = 1.0e-12;
+    for (Size n=0; n<10; ++n) {
+        Real beta = 0.1 + 1.0e-6*n;
+        for (Size i=0; i<size; ++i)
+            for (Size j=0; j<size; ++j)
+                correlation[i][j] =
+                    std::exp(-beta*std::fabs(Real(i)-Real(j)));
+
+        Matrix expected = pseudoSqrt(correlation,
+                                     SalvagingAlgorithm::Spectral);
+        Matrix calculated = calculator.pseudoSqrt(correlation);
+        error = norm(expected - calculated);
+        if (error>tolerance) {
+            BOOST_FAIL("pseudo square root failed for beta = " << beta
+                       << "\ncalculated:\n" << calculated
+                       << "expected:\n" << expected
+                       << "\nerror:     " << error
+                       << "\ntolerance: " << tolerance);
+        }
+
+        expected = rankReducedSqrt(correlation, 5, 1.0,
+                                   SalvagingAlgorithm::Spectral);
+        calculated = calculator.rankReducedSqrt(correlation, 5, 1.0);
+        error = norm(expected - calculated);
+        if (error>tolerance) {
+            BOOST_FAIL("rank-reduced square root failed for beta = " << beta
+                       << "\ncalculated:\n" << calculated
+                       << "expected:\n" << expected
+                       << "\nerror:     " << error
+                       << "\ntolerance: " << tolerance);
+        }
+    }
+
+    if (calculator.warmStarts() == 0)
+        BOOST_ERROR("previous decompositions were never used");
+}
+
 void MatricesTest::testSVD() {
 
     BOOST_TEST_MESSAGE("Testing singular value decomposition...");
@@ -681,6 +743,47 @@ void MatricesTest::testIterativeSolvers() {
     #endif
 }
 
+void MatricesTest::testElementwiseExpressions() {
+
+    BOOST_TEST_MESSAGE("Testing element-wise matrix expressions...");
+
+    setup();
+
+    const Real tol = 100*QL_EPSILON;
+
+    Matrix r1 = 2.0*M1 - M2/4.0 + I*0.5;
+    Matrix r2 = M7;
+    // in-place evaluation reads each element before overwriting it
+    r2 = r2 - M7*3.0;
+    Matrix r3(M1);
+    r3 += M2*2.0;
+    r3 -= M7 - I;
+
+    for (Size i=0; i<N; ++i) {
+        for (Size j=0; j<N; ++j) {
+            Real e1 = 2.0*M1[i][j] - M2[i][j]/4.0 + I[i][j]*0.5;
+            Real e2 = -2.0*M7[i][j];
+            Real e3 = M1[i][j] + 2.0*M2[i][j] - M7[i][j] + I[i][j];
+            if (std::fabs(r1[i][j]-e1) > tol
+                || std::fabs(r2[i][j]-e2) > tol
+                || std::fabs(r3[i][j]-e3) > tol
+                || std::fabs((M1-M2)(i,j) - (M1[i][j]-M2[i][j])) > tol)
+                BOOST_ERROR("wrong result from matrix expression at ("
+                            << i << ", " << j << "):"
+                            << "\n    (" << r1[i][j] << ", " << r2[i][j]
+                            << ", " << r3[i][j] << ")"
+                            << "\n    (" << e1 << ", " << e2
+                            << ", " << e3 << ")");
+        }
+    }
+
+    // expressions are converted into matrices where these are expected
+    if (norm((M1 - M2)*I - (M1 - M2)) > tol)
+        BOOST_ERROR("wrong product of matrix expressions");
+
+    BOOST_CHECK_THROW(Matrix(M1 + M3), Error);
+}
+
 test_suite* MatricesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Matrix tests");
 
@@ -689,6 +792,7 @@ test_suite* MatricesTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testSqrt));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testSVD));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testHighamSqrt));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testPseudoSqrtCalculator));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testQRDecomposition));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testQRSolve));
     #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -698,6 +802,7 @@ test_suite* MatricesTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testCholeskyDecomposition));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testMoorePenroseInverse));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testIterativeSolvers));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testElementwiseExpressions));
     return suite;
 }
 
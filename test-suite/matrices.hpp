@@ -32,6 +32,7 @@ class MatricesTest {
     static void testEigenvectors();
     static void testSqrt();
     static void testHighamSqrt();
+    static void testPseudoSqrtCalculator();
     static void testSVD();
     static void testQRDecomposition();
     static void testQRSolve();
@@ -41,6 +42,7 @@ class MatricesTest {
     static void testCholeskyDecomposition();
     static void testMoorePenroseInverse();
     static void testIterativeSolvers();
+    static void testElementwiseExpressions();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -24,10 +24,13 @@
 #include <ql/instruments/vanillaoption.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
+#include <ql/methods/montecarlo/singleprecisionpaths.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/mcamericanengine.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 
@@ -315,6 +318,236 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testBackwardCalibration() {
+    BOOST_TEST_MESSAGE("Testing Monte-Carlo pricing of American options "
+                       "with backward calibration paths...");
+
+    SavedSettings backup;
+
+    const Option::Type type(Option::Put);
+    const Real underlying = 36;
+    const Spread dividendYield = 0.02;
+    const Rate riskFreeRate = 0.06;
+
+    const Date todaysDate(15, May, 1998);
+    const Date settlementDate(17, May, 1998);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Date maturity(17, May, 1999);
+    const DayCounter dayCounter = Actual365Fixed();
+
+    boost::shared_ptr<Exercise> americanExercise(
+        new AmericanExercise(settlementDate, maturity));
+
+    Handle<YieldTermStructure> flatTermStructure(
+            boost::shared_ptr<YieldTermStructure>(
+                new FlatForward(settlementDate, riskFreeRate, dayCounter)));
+    Handle<YieldTermStructure> flatDividendTS(
+            boost::shared_ptr<YieldTermStructure>(
+                new FlatForward(settlementDate, dividendYield, dayCounter)));
+    Handle<Quote> underlyingH(
+                boost::shared_ptr<Quote>(new SimpleQuote(underlying)));
+
+    // a constant and a time-dependent volatility
+    std::vector<Date> dates;
+    dates.push_back(settlementDate + 3*Months);
+    dates.push_back(settlementDate + 6*Months);
+    dates.push_back(maturity + 1*Months);
+    std::vector<Volatility> vols;
+    vols.push_back(0.35);
+    vols.push_back(0.30);
+    vols.push_back(0.25);
+    boost::shared_ptr<BlackVolTermStructure> volatilities[] = {
+        boost::shared_ptr<BlackVolTermStructure>(
+                    new BlackConstantVol(settlementDate, NullCalendar(),
+                                         0.20, dayCounter)),
+        boost::shared_ptr<BlackVolTermStructure>(
+                    new BlackVarianceCurve(settlementDate, dates, vols,
+                                           dayCounter))
+    };
+
+    for (Size i=0; i<LENGTH(volatilities); ++i) {
+        boost::shared_ptr<GeneralizedBlackScholesProcess>
+            stochasticProcess(new GeneralizedBlackScholesProcess(
+                                      underlyingH, flatDividendTS,
+                                      flatTermStructure,
+                                      Handle<BlackVolTermStructure>(
+                                                          volatilities[i])));
+
+        for (Size j=0; j<2; ++j) {
+            boost::shared_ptr<StrikedTypePayoff> payoff(
+                new PlainVanillaPayoff(type, underlying+4*j));
+            VanillaOption americanOption(payoff, americanExercise);
+
+            americanOption.setPricingEngine(
+                MakeMCAmericanEngine<PseudoRandom>(stochasticProcess)
+                  .withSteps(75)
+                  .withAntitheticVariate()
+                  .withAbsoluteTolerance(0.02)
+                  .withSeed(42)
+                  .withPolynomOrder(3)
+                  .withCalibrationSamples(16384)
+                  .withBackwardCalibration());
+            const Real calculated = americanOption.NPV();
+            const Real errorEstimate = americanOption.errorEstimate();
+
+            americanOption.setPricingEngine(
+                MakeMCAmericanEngine<PseudoRandom>(stochasticProcess)
+                  .withSteps(75)
+                  .withAntitheticVariate()
+                  .withAbsoluteTolerance(0.02)
+                  .withSeed(42)
+                  .withPolynomOrder(3)
+                  .withCalibrationSamples(16384));
+            const Real forward = americanOption.NPV();
+
+            // unlike FDAmericanEngine, this engine follows the
+            // term structure of the volatility
+            americanOption.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                        new FdBlackScholesVanillaEngine(stochasticProcess,
+                                                        200, 400)));
+            const Real expected = americanOption.NPV();
+
+            // the pricing paths are the same; only the exercise
+            // strategies differ
+            if (std::fabs(calculated - expected) > 2.34*errorEstimate
+                || std::fabs(calculated - forward) > errorEstimate) {
+                BOOST_ERROR("Failed to reproduce american option prices"
+                            << "\n    volatility: "
+                            << (i == 0 ? "constant" : "time-dependent")
+                            << "\n    strike:     " << payoff->strike()
+                            << "\n    expected:   " << expected
+                            << "\n    forward calibration:  " << forward
+                            << "\n    backward calibration: " << calculated
+                            << " +/- " << errorEstimate);
+            }
+        }
+    }
+}
+
+void MCLongstaffSchwartzEngineTest::testSinglePrecisionPaths() {
+    BOOST_TEST_MESSAGE("Testing Monte-Carlo pricing of American options "
+                       "with calibration paths stored in single precision...");
+
+    SavedSettings backup;
+
+    const Option::Type type(Option::Put);
+    const Real underlying = 36;
+    const Spread dividendYield = 0.02;
+    const Rate riskFreeRate = 0.06;
+    const Volatility volatility = 0.20;
+
+    const Date todaysDate(15, May, 1998);
+    const Date settlementDate(17, May, 1998);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Date maturity(17, May, 1999);
+    const DayCounter dayCounter = Actual365Fixed();
+
+    boost::shared_ptr<Exercise> americanExercise(
+        new AmericanExercise(settlementDate, maturity));
+
+    Handle<YieldTermStructure> flatTermStructure(
+            boost::shared_ptr<YieldTermStructure>(
+                new FlatForward(settlementDate, riskFreeRate, dayCounter)));
+    Handle<YieldTermStructure> flatDividendTS(
+            boost::shared_ptr<YieldTermStructure>(
+                new FlatForward(settlementDate, dividendYield, dayCounter)));
+    Handle<BlackVolTermStructure> flatVolTS(
+            boost::shared_ptr<BlackVolTermStructure>(
+                new BlackConstantVol(settlementDate, NullCalendar(),
+                                     volatility, dayCounter)));
+    Handle<Quote> underlyingH(
+                boost::shared_ptr<Quote>(new SimpleQuote(underlying)));
+
+    boost::shared_ptr<GeneralizedBlackScholesProcess>
+        stochasticProcess(new GeneralizedBlackScholesProcess(
+                                  underlyingH, flatDividendTS,
+                                  flatTermStructure, flatVolTS));
+
+    // stored values
+    typedef PseudoRandom::rsg_type rsg_type;
+    typedef PathGenerator<rsg_type> generator_type;
+    TimeGrid grid(1.0, 50);
+    rsg_type rsg = PseudoRandom::make_sequence_generator(50, 42);
+    generator_type generator(stochasticProcess, grid, rsg, false);
+
+    const Size nPaths = 100;
+    std::vector<Path> paths;
+    SinglePrecisionPaths<Path> compactPaths;
+    for (Size j=0; j<nPaths; ++j) {
+        paths.push_back(generator.next().value);
+        compactPaths.add(paths.back());
+    }
+
+    if (compactPaths.size() != nPaths)
+        BOOST_FAIL("wrong number of stored paths: "
+                   << compactPaths.size() << " instead of " << nPaths);
+    if (compactPaths.bytes() >= nPaths*grid.size()*sizeof(Real))
+        BOOST_ERROR("no memory saved by single-precision storage: "
+                    << compactPaths.bytes() << " bytes used");
+
+    const Real tolerance = 1.0e-7;
+    for (Size i=0; i<grid.size(); ++i) {
+        compactPaths.moveTo(i);
+        for (Size j=0; j<nPaths; ++j) {
+            Real expected = paths[j][i];
+            Real stored = compactPaths.value(j, 0, i);
+            Real read = compactPaths.path(j)[i];
+            if (std::fabs(stored-expected)/expected > tolerance
+                || read != stored) {
+                BOOST_FAIL("failed to reproduce stored path value"
+                           << "\n    path:     " << j
+                           << "\n    time:     " << i
+                           << "\n    expected: " << expected
+                           << "\n    stored:   " << stored
+                           << "\n    read:     " << read);
+            }
+        }
+    }
+
+    // resulting prices
+    for (Size j=0; j<2; ++j) {
+        boost::shared_ptr<StrikedTypePayoff> payoff(
+            new PlainVanillaPayoff(type, underlying+4*j));
+        VanillaOption americanOption(payoff, americanExercise);
+
+        americanOption.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(stochasticProcess)
+              .withSteps(75)
+              .withAntitheticVariate()
+              .withAbsoluteTolerance(0.02)
+              .withSeed(42)
+              .withPolynomOrder(3)
+              .withCalibrationSamples(16384)
+              .withSinglePrecisionPaths());
+        const Real calculated = americanOption.NPV();
+        const Real errorEstimate = americanOption.errorEstimate();
+
+        americanOption.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(stochasticProcess)
+              .withSteps(75)
+              .withAntitheticVariate()
+              .withAbsoluteTolerance(0.02)
+              .withSeed(42)
+              .withPolynomOrder(3)
+              .withCalibrationSamples(16384));
+        const Real expected = americanOption.NPV();
+
+        // the exercise strategies differ by rounding errors only, so
+        // the difference should be much smaller than the MC error
+        if (std::fabs(calculated - expected) > 0.1*errorEstimate) {
+            BOOST_ERROR("Failed to reproduce american option prices"
+                        << "\n    strike:           " << payoff->strike()
+                        << "\n    double paths:     " << expected
+                        << "\n    single precision: " << calculated
+                        << " +/- " << errorEstimate
+                        << "\n    difference:       "
+                        << calculated - expected);
+        }
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
     // FLOATING_POINT_EXCEPTION
@@ -322,6 +555,10 @@ test_suite* MCLongstaffSchwartzEngineTest::suite() {
          &MCLongstaffSchwartzEngineTest::testAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(
          &MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testBackwardCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testSinglePrecisionPaths));
     return suite;
 }
 
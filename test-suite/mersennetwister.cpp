@@ -20,6 +20,10 @@
 #include "mersennetwister.hpp"
 #include "utilities.hpp"
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/experimental/math/zigguratrng.hpp>
+#include <ql/experimental/math/polarstudenttrng.hpp>
+#include <ql/experimental/math/claytoncopularng.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -481,10 +485,186 @@ void MersenneTwisterTest::testValues() {
                    "during parallel computation");
 }
 
+void MersenneTwisterTest::testJumpAhead() {
+
+    BOOST_TEST_MESSAGE("Testing Mersenne twister jump-ahead...");
+
+    unsigned long seed = 42;
+    // the larger skips exercise the polynomial jump
+    unsigned long skip[] = { 0, 1, 42, 623, 624, 625, 1248,
+                             100000, 6241248, 7000001 };
+    Size drawn[] = { 0, 1, 624, 700 };
+
+    for (Size i=0; i<LENGTH(drawn); i++) {
+        for (Size j=0; j<LENGTH(skip); j++) {
+            MersenneTwisterUniformRng mt1(seed), mt2(seed);
+            for (Size k=0; k<drawn[i]; k++) {
+                mt1.nextInt32();
+                mt2.nextInt32();
+            }
+
+            for (unsigned long k=0; k<skip[j]; k++)
+                mt1.nextInt32();
+            mt2.jumpAhead(skip[j]);
+
+            for (Size k=0; k<1000; k++) {
+                unsigned long expected = mt1.nextInt32();
+                unsigned long calculated = mt2.nextInt32();
+                if (expected != calculated)
+                    BOOST_FAIL("Mismatch after jumping ahead:"
+                               << "\n  drawn:      " << drawn[i]
+                               << "\n  skipped:    " << skip[j]
+                               << "\n  at index:   " << k
+                               << "\n  expected:   " << expected
+                               << "\n  calculated: " << calculated);
+            }
+        }
+    }
+
+    // jumps must compose
+    MersenneTwisterUniformRng mt3(seed), mt4(seed);
+    mt3.jumpAhead(12345678UL);
+    mt3.jumpAhead(87654321UL);
+    mt4.jumpAhead(12345678UL + 87654321UL);
+    for (Size k=0; k<1000; k++) {
+        if (mt3.nextInt32() != mt4.nextInt32())
+            BOOST_FAIL("Mismatch after composed jumps at index " << k);
+    }
+
+    // jumps beyond 2^32 draws must not be truncated
+    MersenneTwisterUniformRng mt5(seed), mt6(seed);
+    mt5.jumpAhead(boost::uint64_t(1) << 31);
+    mt5.jumpAhead(boost::uint64_t(1) << 31);
+    mt5.jumpAhead(5);
+    mt6.jumpAhead((boost::uint64_t(1) << 32) + 5);
+    for (Size k=0; k<1000; k++) {
+        if (mt5.nextInt32() != mt6.nextInt32())
+            BOOST_FAIL("Mismatch after jump beyond 2^32 at index " << k);
+    }
+
+    // sequence generators starting at a given sequence
+    Size dimension = 10, firstSequence = 1000;
+    PseudoRandom::rsg_type rsg1 =
+        PseudoRandom::make_sequence_generator(dimension, seed);
+    PseudoRandom::rsg_type rsg2 =
+        PseudoRandom::make_sequence_generator(dimension, seed,
+                                              firstSequence);
+    for (Size k=0; k<firstSequence; k++)
+        rsg1.nextSequence();
+    for (Size k=0; k<100; k++) {
+        const std::vector<Real>& s1 = rsg1.nextSequence().value;
+        const std::vector<Real>& s2 = rsg2.nextSequence().value;
+        for (Size l=0; l<dimension; l++) {
+            if (s1[l] != s2[l])
+                BOOST_FAIL("Mismatch in sequence generator "
+                           "starting at sequence " << firstSequence
+                           << "\n  at sequence: " << k
+                           << "\n  at index:    " << l
+                           << "\n  expected:    " << s1[l]
+                           << "\n  calculated:  " << s2[l]);
+        }
+    }
+}
+
+
+void MersenneTwisterTest::testBlockGeneration() {
+
+    BOOST_TEST_MESSAGE("Testing block generation of random numbers...");
+
+    unsigned long seed = 42;
+    // sizes around the state size of the Mersenne twister and the
+    // internal blocks of the other generators
+    Size sizes[] = { 1, 100, 256, 623, 624, 625, 2000 };
+
+    for (Size i=0; i<LENGTH(sizes); i++) {
+        Size n = sizes[i];
+        std::vector<unsigned long> integers(n);
+        std::vector<Real> reals(n), others(n);
+
+        MersenneTwisterUniformRng mt1(seed), mt2(seed);
+        // start in the middle of the state
+        mt1.nextInt32();
+        mt2.nextInt32();
+        mt2.nextInt32s(n, &integers[0]);
+        for (Size k=0; k<n; k++) {
+            unsigned long expected = mt1.nextInt32();
+            if (integers[k] != expected)
+                BOOST_FAIL("Mismatch in block of integers:"
+                           << "\n  size:       " << n
+                           << "\n  at index:   " << k
+                           << "\n  expected:   " << expected
+                           << "\n  calculated: " << integers[k]);
+        }
+        mt2.nextReals(n, &reals[0]);
+        for (Size k=0; k<n; k++) {
+            Real expected = mt1.nextReal();
+            if (reals[k] != expected)
+                BOOST_FAIL("Mismatch in block of reals:"
+                           << "\n  size:       " << n
+                           << "\n  at index:   " << k
+                           << "\n  expected:   " << expected
+                           << "\n  calculated: " << reals[k]);
+        }
+        if (mt1.nextInt32() != mt2.nextInt32())
+            BOOST_FAIL("Mismatch after block of size " << n);
+
+        // the other generators must also leave their underlying
+        // generator where single draws would
+        ZigguratRng z1(seed), z2(seed);
+        z2.nextReals(n, &reals[0]);
+        for (Size k=0; k<n; k++) {
+            Real expected = z1.next().value;
+            if (reals[k] != expected)
+                BOOST_FAIL("Mismatch in block of Ziggurat variates:"
+                           << "\n  size:       " << n
+                           << "\n  at index:   " << k
+                           << "\n  expected:   " << expected
+                           << "\n  calculated: " << reals[k]);
+        }
+        if (z1.next().value != z2.next().value)
+            BOOST_FAIL("Mismatch after block of " << n
+                       << " Ziggurat variates");
+
+        PolarStudentTRng<MersenneTwisterUniformRng> t1(5.0, seed),
+                                                    t2(5.0, seed);
+        t2.nextReals(n, &reals[0]);
+        for (Size k=0; k<n; k++) {
+            Real expected = t1.next().value;
+            if (reals[k] != expected)
+                BOOST_FAIL("Mismatch in block of Student-t variates:"
+                           << "\n  size:       " << n
+                           << "\n  at index:   " << k
+                           << "\n  expected:   " << expected
+                           << "\n  calculated: " << reals[k]);
+        }
+        if (t1.next().value != t2.next().value)
+            BOOST_FAIL("Mismatch after block of " << n
+                       << " Student-t variates");
+
+        MersenneTwisterUniformRng mt3(seed);
+        ClaytonCopulaRng<MersenneTwisterUniformRng> c1(mt3, 2.0),
+                                                    c2(mt3, 2.0);
+        c2.nextReals(n, &reals[0], &others[0]);
+        for (Size k=0; k<n; k++) {
+            std::vector<Real> expected = c1.next().value;
+            if (reals[k] != expected[0] || others[k] != expected[1])
+                BOOST_FAIL("Mismatch in block of copula samples:"
+                           << "\n  size:       " << n
+                           << "\n  at index:   " << k
+                           << "\n  expected:   " << expected[0]
+                           << ", " << expected[1]
+                           << "\n  calculated: " << reals[k]
+                           << ", " << others[k]);
+        }
+    }
+}
 
 test_suite* MersenneTwisterTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Mersenne twister tests");
     suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testValues));
+    suite->add(QUANTLIB_TEST_CASE(&MersenneTwisterTest::testJumpAhead));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &MersenneTwisterTest::testBlockGeneration));
     return suite;
 }
 
@@ -28,6 +28,8 @@
 class MersenneTwisterTest {
   public:
     static void testValues();
+    static void testJumpAhead();
+    static void testBlockGeneration();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -122,10 +122,51 @@ void NoArbSabrTest::testConsistencyWithHagan() {
 
 }
 
+void NoArbSabrTest::testBatchedOptionPrices() {
+
+    BOOST_TEST_MESSAGE("Testing noarb-sabr prices over several strikes...");
+
+    // parameters taken from Doust's paper, figure 3
+
+    Real tau = 1.0;
+    Real beta = 0.5;
+    Real alpha = 0.026;
+    Real rho = -0.1;
+    Real nu = 0.4;
+    Real f = 0.0488;
+
+    NoArbSabrSmileSection noarbsabr(tau,f,boost::assign::list_of(alpha)(beta)(nu)(rho));
+
+    // unsorted, with a repeated strike
+    std::vector<Real> strikes;
+    for (Real strike = 0.005; strike < 0.15; strike += 0.005)
+        strikes.push_back(strike);
+    std::reverse(strikes.begin(), strikes.begin() + 10);
+    strikes.push_back(f);
+    strikes.push_back(strikes.front());
+
+    std::vector<Real> prices = noarbsabr.model()->optionPrices(strikes);
+    std::vector<Volatility> vols = noarbsabr.volatilities(strikes);
+    for (Size i=0; i<strikes.size(); ++i) {
+        Real price = noarbsabr.model()->optionPrice(strikes[i]);
+        // the batch integrates all strikes up to twice the highest
+        // one, which is slightly more accurate for high strikes
+        if (std::fabs(prices[i] - price) > 1e-7)
+            BOOST_ERROR("batched noarb-sabr price (" << prices[i]
+                        << ") inconsistent with single price (" << price
+                        << ") at strike " << strikes[i]);
+        Volatility vol = noarbsabr.volatility(strikes[i]);
+        if (strikes[i] <= f && std::fabs(vols[i] - vol) > 1e-6)
+            BOOST_ERROR("batched noarb-sabr volatility (" << vols[i]
+                        << ") inconsistent with single volatility (" << vol
+                        << ") at strike " << strikes[i]);
+    }
+}
 
 test_suite* NoArbSabrTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("NoArbSabrModel tests");
     suite->add(QUANTLIB_TEST_CASE(&NoArbSabrTest::testAbsorptionMatrix));
     suite->add(QUANTLIB_TEST_CASE(&NoArbSabrTest::testConsistencyWithHagan));
+    suite->add(QUANTLIB_TEST_CASE(&NoArbSabrTest::testBatchedOptionPrices));
     return suite;
 }
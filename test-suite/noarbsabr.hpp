@@ -29,6 +29,7 @@ class NoArbSabrTest {
   public:
     static void testAbsorptionMatrix();
     static void testConsistencyWithHagan();
+    static void testBatchedOptionPrices();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -30,6 +30,8 @@
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/math/solvers1d/brent.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/currencies/europe.hpp>
 #include <iostream>
@@ -97,6 +99,45 @@ namespace {
 
 #endif
 
+void NthToDefaultTest::testDefaultTimeLookup() {
+
+    BOOST_TEST_MESSAGE("Testing tabulated lookup of simulated default "
+                       "times...");
+
+    SavedSettings backup;
+
+    Date today = Date(15, March, 2016);
+    Settings::instance().evaluationDate() = today;
+
+    Size horizon = 3650;
+    Real intensities[] = { 0.001, 0.01, 0.05, 0.2 };
+
+    for (Size i=0; i<LENGTH(intensities); ++i) {
+        Handle<DefaultProbabilityTermStructure> curve(
+            boost::shared_ptr<DefaultProbabilityTermStructure>(
+                new FlatHazardRate(today, intensities[i], Actual365Fixed())));
+        QuantLib::detail::DefaultDayTable table(curve, horizon);
+
+        Probability horizonProbability =
+            curve->defaultProbability(today + Period(horizon, Days), true);
+        Size n = 1000;
+        for (Size j=1; j<n; ++j) {
+            Probability p = horizonProbability * j / n;
+            Size expected = static_cast<Size>(
+                Brent().solve(QuantLib::detail::Root(curve, p), 1.0e-6, 0.0, 1.0));
+            Size calculated = table.defaultDay(p);
+            Size error = std::max(expected, calculated)
+                       - std::min(expected, calculated);
+            if (error > 1)
+                BOOST_FAIL("failed to reproduce default day"
+                           << "\n    intensity:  " << intensities[i]
+                           << "\n    probability: " << p
+                           << "\n    solver:     " << expected
+                           << "\n    table:      " << calculated);
+        }
+    }
+}
+
 void NthToDefaultTest::testGauss() {
     #ifndef QL_PATCH_SOLARIS
     BOOST_TEST_MESSAGE("Testing nth-to-default against Hull-White values "
@@ -390,6 +431,7 @@ void NthToDefaultTest::testGaussStudent() {
 test_suite* NthToDefaultTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Nth-to-default tests");
     #ifndef QL_PATCH_SOLARIS
+    suite->add(QUANTLIB_TEST_CASE(&NthToDefaultTest::testDefaultTimeLookup));
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(&NthToDefaultTest::testGauss));
         suite->add(QUANTLIB_TEST_CASE(&NthToDefaultTest::testGaussStudent));
@@ -28,6 +28,7 @@
 
 class NthToDefaultTest {
   public:
+    static void testDefaultTimeLookup();
     static void testGauss();
     static void testGaussStudent();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
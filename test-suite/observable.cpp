@@ -19,8 +19,13 @@
 
 #include "observable.hpp"
 #include "utilities.hpp"
+#include <ql/patterns/lazyobject.hpp>
 #include <ql/patterns/observable.hpp>
+#include <ql/patterns/observergraph.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <algorithm>
+#include <sstream>
+#include <vector>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -91,6 +96,234 @@ void ObservableTest::testObservableSettings() {
 }
 
 
+void ObservableTest::testObserverStorage() {
+
+    BOOST_TEST_MESSAGE("Testing storage of small and large observer sets...");
+
+    // the first few links are stored inline; check the transition
+    // to and from the spilled storage on both sides
+    const Size n = 10;
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+    std::vector<boost::shared_ptr<UpdateCounter> > counters;
+    for (Size i=0; i<n; ++i) {
+        quotes.push_back(boost::shared_ptr<SimpleQuote>(new SimpleQuote));
+        counters.push_back(
+                      boost::shared_ptr<UpdateCounter>(new UpdateCounter));
+    }
+
+    for (Size i=0; i<n; ++i) {
+        for (Size j=0; j<=i; ++j) {
+            counters[i]->registerWith(quotes[j]);
+            // registering twice has no effect
+            if (counters[i]->registerWith(quotes[j]).second)
+                BOOST_FAIL("observable #" << j
+                           << " registered twice with observer #" << i);
+        }
+    }
+
+    // quote #j is observed by counters #j to #n-1
+    for (Size j=0; j<n; ++j)
+        quotes[j]->setValue(1.0);
+    for (Size i=0; i<n; ++i) {
+        if (counters[i]->counter() != i+1)
+            BOOST_FAIL("observer #" << i << " updated "
+                       << counters[i]->counter() << " times ("
+                       << i+1 << " expected)");
+    }
+
+    // unregister in reverse order, then notify again
+    for (Size i=0; i<n; ++i) {
+        for (Size j=i+1; j>0; --j) {
+            if (j % 2 == 0 && counters[i]->unregisterWith(quotes[j-1]) != 1)
+                BOOST_FAIL("observable #" << j-1
+                           << " not unregistered from observer #" << i);
+        }
+    }
+    for (Size j=0; j<n; ++j)
+        quotes[j]->setValue(2.0);
+    for (Size i=0; i<n; ++i) {
+        Size expected = i+1 + (i+2)/2;
+        if (counters[i]->counter() != expected)
+            BOOST_FAIL("observer #" << i << " updated "
+                       << counters[i]->counter() << " times ("
+                       << expected << " expected)");
+    }
+
+    // copies are registered with the same observables
+    UpdateCounter copy(*counters[n-1]);
+    copy.unregisterWith(quotes[0]);
+    for (Size j=0; j<n; ++j)
+        quotes[j]->setValue(3.0);
+    if (copy.counter() != counters[n-1]->counter()-1)
+        BOOST_FAIL("copy updated " << copy.counter() << " times ("
+                   << counters[n-1]->counter()-1 << " expected)");
+
+    // destroyed observers are removed from the observables
+    Size updates = copy.counter();
+    counters.clear();
+    for (Size j=0; j<n; ++j)
+        quotes[j]->setValue(4.0);
+    if (copy.counter() != updates + n/2-1)
+        BOOST_FAIL("copy updated " << copy.counter()-updates << " times ("
+                   << n/2-1 << " expected)");
+
+    copy.unregisterWithAll();
+    quotes[2]->setValue(5.0);
+    if (copy.counter() != updates + n/2-1)
+        BOOST_FAIL("copy updated after unregistering");
+}
+
+namespace {
+
+    // unregisters a sibling and registers new observers with the
+    // quote from within its update
+    class SiblingRemover : public Observer {
+      public:
+        SiblingRemover(const boost::shared_ptr<SimpleQuote>& quote,
+                       const boost::shared_ptr<UpdateCounter>& sibling,
+                       Size newcomers)
+        : quote_(quote), sibling_(sibling), newcomers_(newcomers),
+          counter_(0) {}
+        void update() {
+            ++counter_;
+            sibling_->unregisterWith(quote_);
+            for (Size i=0; i<newcomers_; ++i) {
+                boost::shared_ptr<UpdateCounter> c(new UpdateCounter);
+                c->registerWith(quote_);
+                added.push_back(c);
+            }
+            newcomers_ = 0;
+        }
+        Size counter() const { return counter_; }
+        std::vector<boost::shared_ptr<UpdateCounter> > added;
+      private:
+        boost::shared_ptr<SimpleQuote> quote_;
+        boost::shared_ptr<UpdateCounter> sibling_;
+        Size newcomers_;
+        Size counter_;
+    };
+
+}
+
+void ObservableTest::testUnregisteringDuringNotification() {
+
+    BOOST_TEST_MESSAGE("Testing observers unregistering siblings "
+                       "during notification...");
+
+    // the sibling is registered first, so that it's visited before
+    // the remover; the newcomers make the observer set grow past its
+    // inline storage while it's being notified
+    Size others[] = { 1, 2, 5 };
+    Size newcomers[] = { 0, 2, 4 };
+    for (Size i=0; i<LENGTH(others); ++i) {
+        for (Size j=0; j<LENGTH(newcomers); ++j) {
+            boost::shared_ptr<SimpleQuote> quote(new SimpleQuote(0.0));
+            boost::shared_ptr<UpdateCounter> sibling(new UpdateCounter);
+            sibling->registerWith(quote);
+            SiblingRemover remover(quote, sibling, newcomers[j]);
+            remover.registerWith(quote);
+            std::vector<boost::shared_ptr<UpdateCounter> > counters;
+            for (Size k=0; k<others[i]; ++k) {
+                counters.push_back(
+                      boost::shared_ptr<UpdateCounter>(new UpdateCounter));
+                counters.back()->registerWith(quote);
+            }
+
+            quote->setValue(1.0);
+
+            if (remover.counter() != 1)
+                BOOST_FAIL("remover updated " << remover.counter()
+                           << " times (1 expected)");
+            if (sibling->counter() > 1)
+                BOOST_FAIL("sibling updated " << sibling->counter()
+                           << " times (at most 1 expected)");
+            for (Size k=0; k<counters.size(); ++k) {
+                if (counters[k]->counter() != 1)
+                    BOOST_FAIL("observer #" << k << " of " << others[i]
+                               << " updated " << counters[k]->counter()
+                               << " times (1 expected) with "
+                               << newcomers[j] << " newcomers");
+            }
+
+            // the changes are effective for the next notification
+            quote->setValue(2.0);
+            if (sibling->counter() > 1)
+                BOOST_FAIL("sibling updated after unregistering");
+            for (Size k=0; k<remover.added.size(); ++k) {
+                if (remover.added[k]->counter() < 1)
+                    BOOST_FAIL("newcomer #" << k << " not updated");
+            }
+        }
+    }
+}
+
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+
+namespace {
+
+    class Forwarder : public Observer, public Observable {
+      public:
+        explicit Forwarder(std::vector<const Forwarder*>& log)
+        : log_(log) {}
+        void update() {
+            log_.push_back(this);
+            notifyObservers();
+        }
+      private:
+        std::vector<const Forwarder*>& log_;
+    };
+
+}
+
+void ObservableTest::testNotificationBatch() {
+
+    BOOST_TEST_MESSAGE("Testing batched notifications...");
+
+    std::vector<const Forwarder*> log;
+
+    const boost::shared_ptr<SimpleQuote> q1(new SimpleQuote(0.0));
+    const boost::shared_ptr<SimpleQuote> q2(new SimpleQuote(0.0));
+    const boost::shared_ptr<Forwarder> a(new Forwarder(log));
+    const boost::shared_ptr<Forwarder> b(new Forwarder(log));
+    const boost::shared_ptr<Forwarder> c(new Forwarder(log));
+    a->registerWith(q1);
+    b->registerWith(q1);
+    b->registerWith(q2);
+    c->registerWith(a);
+    c->registerWith(b);
+    c->registerWith(q2);
+
+    q1->setValue(1.0);
+    if (log.size() != 4)
+        BOOST_FAIL("unexpected number of updates without batching:"
+                   << "\n    expected:   4"
+                   << "\n    calculated: " << log.size());
+    log.clear();
+
+    NotificationBatch batch;
+    for (Size i=0; i < 10; ++i) {
+        NotificationBatch nested;
+        q1->setValue(Real(i+2));
+        q2->setValue(Real(i+2));
+        nested.close();
+    }
+    if (!log.empty())
+        BOOST_FAIL("notifications sent before closing the batch");
+
+    batch.close();
+    if (log.size() != 3
+        || std::count(log.begin(), log.end(), a.get()) != 1
+        || std::count(log.begin(), log.end(), b.get()) != 1)
+        BOOST_FAIL("each observer should have been updated once");
+    if (log.back() != c.get())
+        BOOST_FAIL("observer updated before its observables");
+    if (!ObservableSettings::instance().updatesEnabled())
+        BOOST_FAIL("updates not enabled after closing the batch");
+}
+
+#endif
+
+
 #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
 #include <boost/atomic.hpp>
@@ -105,20 +338,27 @@ namespace {
 
     class MTUpdateCounter : public Observer {
       public:
-        MTUpdateCounter() : counter_(0) {
+        MTUpdateCounter() : counter_(0), running_(false), overlaps_(0) {
             ++instanceCounter_;
         }
         ~MTUpdateCounter() {
             --instanceCounter_;
         }
         void update() {
+            // updates of the same observer are serialized
+            if (running_.exchange(true))
+                ++overlaps_;
             ++counter_;
+            running_ = false;
         }
         int counter() { return counter_; }
+        int overlaps() { return overlaps_; }
         static int instanceCounter() { return instanceCounter_; }
 
       private:
         boost::atomic<int> counter_;
+        boost::atomic<bool> running_;
+        boost::atomic<int> overlaps_;
         static boost::atomic<int> instanceCounter_;
     };
 
@@ -247,19 +487,177 @@ void ObservableTest::testMultiThreadingGlobalSettings() {
         }
     }
 }
+
+
+namespace {
+
+    class Notifier {
+      public:
+        Notifier(const boost::shared_ptr<Observable>& observable,
+                 Size notifications)
+        : observable_(observable), notifications_(notifications) {}
+
+        void run() {
+            for (Size i=0; i < notifications_; ++i)
+                observable_->notifyObservers();
+        }
+      private:
+        boost::shared_ptr<Observable> observable_;
+        Size notifications_;
+    };
+
+}
+
+void ObservableTest::testMultiThreadingNotification() {
+    BOOST_TEST_MESSAGE("Testing concurrent notification and registration "
+                       "of observers...");
+
+    const boost::shared_ptr<Observable> observable(new Observable);
+
+    const boost::shared_ptr<MTUpdateCounter> persistent(new MTUpdateCounter);
+    persistent->registerWith(observable);
+
+    const Size nThreads = 4, notifications = 20000;
+    std::vector<boost::shared_ptr<boost::thread> > threads;
+    std::vector<Notifier> notifiers(nThreads,
+                                    Notifier(observable, notifications));
+    for (Size i=0; i < nThreads; ++i)
+        threads.push_back(boost::shared_ptr<boost::thread>(
+            new boost::thread(&Notifier::run, &notifiers[i])));
+
+    // observers are registered and destroyed while the notifications
+    // are in progress; the ones on the stack are not owned by a
+    // shared_ptr and rely on their proxy to stop the updates before
+    // they're gone
+    for (Size i=0; i < 2000; ++i) {
+        const boost::shared_ptr<MTUpdateCounter> observer(
+                                                       new MTUpdateCounter);
+        observer->registerWith(observable);
+        MTUpdateCounter local;
+        local.registerWith(observable);
+        if (i % 2 == 0)
+            local.unregisterWith(observable);
+    }
+
+    for (Size i=0; i < nThreads; ++i)
+        threads[i]->join();
+
+    if (persistent->counter() != int(nThreads*notifications))
+        BOOST_FAIL("wrong number of notifications received:"
+                   << "\n    expected:   " << nThreads*notifications
+                   << "\n    calculated: " << persistent->counter());
+
+    if (persistent->overlaps() != 0)
+        BOOST_FAIL(persistent->overlaps() << " concurrent updates of "
+                   "the same observer detected");
+
+    if (MTUpdateCounter::instanceCounter() != 1)
+        BOOST_FAIL("observers were not released");
+
+    // registering twice doesn't duplicate the notification
+    persistent->registerWith(observable);
+    observable->notifyObservers();
+    if (persistent->counter() != int(nThreads*notifications + 1))
+        BOOST_FAIL("duplicate notification received");
+}
 #endif
 
 
 
+namespace {
+
+    class Dependent : public LazyObject {
+      public:
+        void calculate() const { LazyObject::calculate(); }
+      private:
+        void performCalculations() const {}
+    };
+
+}
+
+void ObservableTest::testObserverGraph() {
+
+    BOOST_TEST_MESSAGE("Testing inspection of observer graph...");
+
+    const boost::shared_ptr<SimpleQuote> q(new SimpleQuote(0.0));
+    const boost::shared_ptr<Dependent> a(new Dependent);
+    const boost::shared_ptr<Dependent> b(new Dependent);
+    const boost::shared_ptr<Dependent> c(new Dependent);
+    Flag flag;
+    a->registerWith(q);
+    b->registerWith(q);
+    c->registerWith(a);
+    c->registerWith(b);
+    flag.registerWith(c);
+    a->calculate();
+    b->calculate();
+    c->calculate();
+
+    ObserverGraph graph(*q);
+    if (graph.nodes().size() != 5 || graph.edges().size() != 5)
+        BOOST_FAIL("wrong graph size:"
+                   << "\n    nodes: " << graph.nodes().size()
+                   << " (5 expected)"
+                   << "\n    edges: " << graph.edges().size()
+                   << " (5 expected)");
+    if (graph.depth() != 3)
+        BOOST_ERROR("wrong graph depth: " << graph.depth()
+                    << " (3 expected)");
+    if (graph.lazyObjects() != 3)
+        BOOST_ERROR("wrong number of lazy objects: " << graph.lazyObjects()
+                    << " (3 expected)");
+    if (graph.nodes()[0].fanOut != 2 || graph.nodes()[0].observer != 0)
+        BOOST_ERROR("wrong root node");
+
+    // the second notification reaching c is not forwarded
+    ObserverGraph::Notification n = graph.dryNotify();
+    if (n.updates != 5 || n.depth != 3 || n.invalidated != 3)
+        BOOST_ERROR("wrong simulated notification:"
+                    << "\n    updates:     " << n.updates << " (5 expected)"
+                    << "\n    depth:       " << n.depth << " (3 expected)"
+                    << "\n    invalidated: " << n.invalidated
+                    << " (3 expected)");
+    if (flag.isUp())
+        BOOST_FAIL("notification sent by simulation");
+
+    std::ostringstream dot;
+    graph.write(dot);
+    if (dot.str().find("digraph") != 0)
+        BOOST_ERROR("wrong graph written:\n" << dot.str());
+
+    q->setValue(1.0);
+    if (!flag.isUp())
+        BOOST_FAIL("notification not sent");
+
+    // invalidated objects stop the cascade
+    n = ObserverGraph(*q).dryNotify();
+    if (n.updates != 2 || n.depth != 1 || n.invalidated != 0)
+        BOOST_ERROR("wrong simulated notification after invalidation:"
+                    << "\n    updates:     " << n.updates << " (2 expected)"
+                    << "\n    depth:       " << n.depth << " (1 expected)"
+                    << "\n    invalidated: " << n.invalidated
+                    << " (0 expected)");
+}
+
+
 test_suite* ObservableTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Observer tests");
 
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testObservableSettings));
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testObserverStorage));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &ObservableTest::testUnregisteringDuringNotification));
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testNotificationBatch));
+#endif
+    suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testObserverGraph));
 
 #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
     suite->add(QUANTLIB_TEST_CASE(&ObservableTest::testAsyncGarbagCollector));
     suite->add(QUANTLIB_TEST_CASE(
         &ObservableTest::testMultiThreadingGlobalSettings));
+    suite->add(QUANTLIB_TEST_CASE(
+        &ObservableTest::testMultiThreadingNotification));
 #endif
 
     return suite;
@@ -28,8 +28,13 @@
 class ObservableTest {
   public:
     static void testObservableSettings();
+    static void testObserverStorage();
+    static void testUnregisteringDuringNotification();
+    static void testNotificationBatch();
+    static void testObserverGraph();
     static void testAsyncGarbagCollector();
     static void testMultiThreadingGlobalSettings();
+    static void testMultiThreadingNotification();
 
     static boost::unit_test_framework::test_suite* suite();
 };
@@ -22,6 +22,7 @@
 #include "utilities.hpp"
 #include <ql/experimental/math/expm.hpp>
 #include <ql/math/ode/adaptiverungekutta.hpp>
+#include <ql/math/ode/batchadaptiverungekutta.hpp>
 #include <complex>
 
 using namespace QuantLib;
@@ -135,6 +136,107 @@ void OdeTest::testAdaptiveRungeKutta() {
     }
 }
 
+namespace {
+
+    // f''=-w^2 f for a different w in each lane
+    template <class T>
+    struct batchOde {
+        explicit batchOde(const std::vector<Real>& w) : w_(w) {}
+        void operator()(const Real*, const T* y, T* dydx) const {
+            const Size lanes = w_.size();
+            for (Size k=0; k<lanes; ++k) {
+                dydx[k] = y[lanes+k];
+                dydx[lanes+k] = -w_[k]*w_[k]*y[k];
+            }
+        }
+        std::vector<Real> w_;
+    };
+
+    // the same for a single lane
+    struct singleOde {
+        explicit singleOde(Real w) : w_(w) {}
+        Disposable<std::vector<Real> > operator()(Real,
+                                                  const std::vector<Real>& y) {
+            std::vector<Real> r(2);
+            r[0] = y[1]; r[1] = -w_*w_*y[0];
+            return r;
+        }
+        Real w_;
+    };
+
+}
+
+void OdeTest::testBatchAdaptiveRungeKutta() {
+
+    BOOST_TEST_MESSAGE("Testing batch adaptive Runge Kutta...");
+
+    const Size lanes = 7;
+    std::vector<Real> w(lanes);
+    for (Size k=0; k<lanes; ++k)
+        w[k] = 0.5 + 0.75*k;
+
+    // f(0)=0, f'(0)=w, i.e., f(x) = sin(w x)
+    std::vector<Real> y0(2*lanes);
+    std::vector<std::complex<Real> > z0(2*lanes);
+    for (Size k=0; k<lanes; ++k) {
+        y0[lanes+k] = w[k];
+        // complex solution exp(i w x)
+        z0[k] = 1.0;
+        z0[lanes+k] = std::complex<Real>(0.0, w[k]);
+    }
+
+    BatchAdaptiveRungeKutta<Real> perLane(
+        2, lanes, BatchAdaptiveRungeKutta<Real>::PerLane, 1E-12, 1E-4, 0.0);
+    BatchAdaptiveRungeKutta<Real> shared(
+        2, lanes, BatchAdaptiveRungeKutta<Real>::Shared, 1E-12, 1E-4, 0.0);
+    BatchAdaptiveRungeKutta<std::complex<Real> > complexPerLane(
+        2, lanes, BatchAdaptiveRungeKutta<std::complex<Real> >::PerLane,
+        1E-12, 1E-4, 0.0);
+    AdaptiveRungeKutta<Real> single(1E-12, 1E-4, 0.0);
+
+    const BatchAdaptiveRungeKutta<Real>::OdeFct ode = batchOde<Real>(w);
+    const BatchAdaptiveRungeKutta<std::complex<Real> >::OdeFct complexOde =
+        batchOde<std::complex<Real> >(w);
+    const Real tol = 1E-9;
+
+    for (Real x=0.5; x<5.0; x+=0.5) {
+        std::vector<Real> y1(y0), y2(y0);
+        std::vector<std::complex<Real> > z(z0);
+        perLane(ode, y1, 0.0, x);
+        shared(ode, y2, 0.0, x);
+        complexPerLane(complexOde, z, 0.0, x);
+
+        for (Size k=0; k<lanes; ++k) {
+            const Real exact = std::sin(w[k]*x);
+            const std::complex<Real> exactComplex =
+                std::exp(std::complex<Real>(0.0, w[k]*x));
+
+            std::vector<Real> s(2);
+            s[1] = w[k];
+            s = single(singleOde(w[k]), s, 0.0, x);
+
+            // with per-lane step control, each lane follows the
+            // same steps as the integration of its single system
+            if (std::fabs(y1[k] - s[0]) > 1E-14)
+                BOOST_FAIL("per-lane batch integration differs from "
+                           "single integration at x=" << x
+                           << " for w=" << w[k]
+                           << "\n batch:  " << y1[k]
+                           << "\n single: " << s[0]);
+            if (std::fabs(y2[k] - exact) > tol)
+                BOOST_FAIL("shared-step batch integration failed at x="
+                           << x << " for w=" << w[k]
+                           << "\n calculated: " << y2[k]
+                           << "\n exact:      " << exact);
+            if (std::abs(z[k] - exactComplex) > tol)
+                BOOST_FAIL("complex batch integration failed at x="
+                           << x << " for w=" << w[k]
+                           << "\n calculated: " << z[k]
+                           << "\n exact:      " << exactComplex);
+        }
+    }
+}
+
 namespace {
     Real frobenuiusNorm(const Matrix& m) {
         return std::sqrt(DotProduct((m*transpose(m)).diagonal(),
@@ -215,6 +317,7 @@ void OdeTest::testMatrixExponentialOfZero() {
 test_suite* OdeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("ode tests");
     suite->add(QUANTLIB_TEST_CASE(&OdeTest::testAdaptiveRungeKutta));
+    suite->add(QUANTLIB_TEST_CASE(&OdeTest::testBatchAdaptiveRungeKutta));
     suite->add(QUANTLIB_TEST_CASE(&OdeTest::testMatrixExponential));
     suite->add(QUANTLIB_TEST_CASE(&OdeTest::testMatrixExponentialOfZero));
     return suite;
@@ -28,6 +28,7 @@
 class OdeTest {
   public:
     static void testAdaptiveRungeKutta();
+    static void testBatchAdaptiveRungeKutta();
     static void testMatrixExponential();
     static void testMatrixExponentialOfZero();
 
@@ -33,6 +33,7 @@
 #include <ql/math/optimization/costfunction.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/optimization/differentialevolution.hpp>
+#include <ql/math/optimization/populationevaluator.hpp>
 #include <ql/math/optimization/goldstein.hpp>
 
 using namespace QuantLib;
@@ -448,6 +449,30 @@ namespace {
             return fx - p + 1.0;
         }
     };
+
+    // residuals of the extended Rosenbrock function; the Jacobian
+    // is block-diagonal, with 2x2 blocks
+    class ExtendedRosenbrock : public CostFunction {
+      public:
+        Disposable<Array> values(const Array& x) const {
+            Array r(x.size());
+            for (Size i=0; i<x.size()/2; ++i) {
+                r[2*i] = 10.0*(x[2*i+1]-x[2*i]*x[2*i]);
+                r[2*i+1] = 1.0-x[2*i];
+            }
+            return r;
+        }
+    };
+
+    class BatchedGriewangk : public Griewangk {
+      public:
+        BatchedGriewangk() : batches(0) {}
+        Disposable<Array> populationValues(const std::vector<Array>& x) const {
+            ++batches;
+            return Griewangk::populationValues(x);
+        }
+        mutable Size batches;
+    };
 }
 
 void OptimizersTest::testDifferentialEvolution() {
@@ -553,6 +578,117 @@ void OptimizersTest::testDifferentialEvolution() {
     }
 }
 
+void OptimizersTest::testPopulationEvaluation() {
+    BOOST_TEST_MESSAGE("Testing population evaluation policies "
+                       "in differential evolution...");
+
+    BatchedGriewangk costFunction;
+    BoundaryConstraint constraint(-600.0, 600.0);
+    EndCriteria endCriteria(100, 50, 1e-12, 1e-10, Null<Real>());
+
+    PopulationEvaluator::Type types[] = { PopulationEvaluator::Serial,
+                                          PopulationEvaluator::Parallel,
+                                          PopulationEvaluator::Batched };
+    std::vector<Array> results;
+    std::vector<Real> values;
+    for (Size i=0; i<LENGTH(types); ++i) {
+        DifferentialEvolution::Configuration conf =
+            DifferentialEvolution::Configuration()
+            .withStepsizeWeight(1.8)
+            .withBounds()
+            .withCrossoverProbability(0.9)
+            .withPopulationMembers(200)
+            .withStrategy(DifferentialEvolution::Rand1SelfadaptiveWithRotation)
+            .withAdaptiveCrossover()
+            .withSeed(3242)
+            .withEvaluator(PopulationEvaluator(types[i]));
+        DifferentialEvolution optimizer(conf);
+
+        // random_shuffle draws from the C library generator
+        std::srand(42);
+        Problem problem(costFunction, constraint, Array(10, 100.0));
+        optimizer.minimize(problem, endCriteria);
+        results.push_back(problem.currentValue());
+        values.push_back(problem.functionValue());
+    }
+
+    if (costFunction.batches == 0)
+        BOOST_ERROR("batched evaluation not used");
+
+    for (Size i=1; i<LENGTH(types); ++i) {
+        if (values[i] != values[0])
+            BOOST_ERROR("evaluator #" << i << " gives a different minimum"
+                        << std::setprecision(16)
+                        << "\n    calculated: " << values[i]
+                        << "\n    expected:   " << values[0]);
+        for (Size j=0; j<results[0].size(); ++j) {
+            if (results[i][j] != results[0][j])
+                BOOST_ERROR("evaluator #" << i
+                            << " gives a different minimizer"
+                            << std::setprecision(16)
+                            << "\n    coordinate: " << j
+                            << "\n    calculated: " << results[i][j]
+                            << "\n    expected:   " << results[0][j]);
+        }
+    }
+}
+
+void OptimizersTest::testSparseJacobian() {
+    BOOST_TEST_MESSAGE("Testing Levenberg-Marquardt with sparse Jacobian...");
+
+    Size n = 40;
+    SparseMatrix pattern(n, n);
+    for (Size i=0; i<n/2; ++i) {
+        pattern(2*i, 2*i) = 1.0;
+        pattern(2*i, 2*i+1) = 1.0;
+        pattern(2*i+1, 2*i) = 1.0;
+    }
+
+    ExtendedRosenbrock costFunction;
+    NoConstraint constraint;
+    Array guess(n);
+    for (Size i=0; i<n; ++i)
+        guess[i] = (i % 2 == 0) ? -1.2 : 1.0;
+    EndCriteria endCriteria(1000, 100, 1e-12, 1e-12, 1e-12);
+
+    LevenbergMarquardt dense(1e-8, 1e-10, 1e-10);
+    Problem denseProblem(costFunction, constraint, guess);
+    dense.minimize(denseProblem, endCriteria);
+
+    LevenbergMarquardt sparse(pattern, 1e-8, 1e-10, 1e-10);
+    Problem sparseProblem(costFunction, constraint, guess);
+    sparse.minimize(sparseProblem, endCriteria);
+
+    if (sparse.jacobianGroups() != 2)
+        BOOST_ERROR("unexpected number of column groups"
+                    << "\n    calculated: " << sparse.jacobianGroups()
+                    << "\n    expected:   2");
+
+    Real tolerance = 1.0e-6;
+    for (Size i=0; i<n; ++i) {
+        if (std::fabs(sparseProblem.currentValue()[i] - 1.0) > tolerance
+            || std::fabs(denseProblem.currentValue()[i] - 1.0) > tolerance)
+            BOOST_ERROR("failed to find minimum"
+                        << std::setprecision(12)
+                        << "\n    variable: " << i
+                        << "\n    sparse:   "
+                        << sparseProblem.currentValue()[i]
+                        << "\n    dense:    "
+                        << denseProblem.currentValue()[i]
+                        << "\n    expected: 1.0");
+    }
+
+    if (sparseProblem.functionEvaluation()
+        >= denseProblem.functionEvaluation())
+        BOOST_ERROR("no evaluations saved by the sparse Jacobian"
+                    << "\n    sparse: " << sparseProblem.functionEvaluation()
+                    << "\n    dense:  " << denseProblem.functionEvaluation());
+
+    // mismatched pattern
+    Problem wrongProblem(costFunction, constraint, Array(n+2, 0.5));
+    BOOST_CHECK_THROW(sparse.minimize(wrongProblem, endCriteria), Error);
+}
+
 test_suite* OptimizersTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Optimizers tests");
 
@@ -563,6 +699,8 @@ test_suite* OptimizersTest::suite(SpeedLevel speed) {
         suite->add(QUANTLIB_TEST_CASE(
             &OptimizersTest::testDifferentialEvolution));
     }
+    suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::testPopulationEvaluation));
+    suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::testSparseJacobian));
 
     return suite;
 }
@@ -822,6 +822,53 @@ void OptionletStripperTest::testSwitchStrike() {
                    << "\ntolerance:     " << io::rate(vars.tolerance));
 }
 
+void OptionletStripperTest::testEvaluationDateChange() {
+    BOOST_TEST_MESSAGE("Testing optionlet stripping after a change "
+                       "of evaluation date...");
+
+    CommonVars vars;
+    Settings::instance().evaluationDate() = Date(28, October, 2013);
+    vars.setTermStructure();
+    vars.setCapFloorTermVolSurface();
+
+    shared_ptr< IborIndex > iborIndex(new Euribor6M(vars.yieldTermStructure));
+
+    OptionletStripper1 optionletStripper(vars.capFloorVolSurface, iborIndex,
+                                         Null< Rate >(), vars.accuracy);
+    // strips the volatilities at the first date
+    optionletStripper.optionletFixingDates();
+
+    Settings::instance().evaluationDate() = Date(4, November, 2013);
+
+    OptionletStripper1 expectedStripper(vars.capFloorVolSurface, iborIndex,
+                                        Null< Rate >(), vars.accuracy);
+
+    const std::vector<Date>& dates = optionletStripper.optionletFixingDates();
+    const std::vector<Date>& expectedDates =
+        expectedStripper.optionletFixingDates();
+    for (Size i=0; i<dates.size(); ++i) {
+        if (dates[i] != expectedDates[i])
+            BOOST_FAIL("\nfixing dates not updated:"
+                       << "\noptionlet:  " << i
+                       << "\ncalculated: " << dates[i]
+                       << "\nexpected:   " << expectedDates[i]);
+
+        const std::vector<Volatility>& vols =
+            optionletStripper.optionletVolatilities(i);
+        const std::vector<Volatility>& expectedVols =
+            expectedStripper.optionletVolatilities(i);
+        for (Size j=0; j<vols.size(); ++j) {
+            if (std::fabs(vols[j] - expectedVols[j]) > 1.0e-12)
+                BOOST_FAIL("\nvolatilities not updated:"
+                           << "\noptionlet:  " << i
+                           << "\nstrike:     " << j
+                           << "\ncalculated: " << io::volatility(vols[j])
+                           << "\nexpected:   "
+                           << io::volatility(expectedVols[j]));
+        }
+    }
+}
+
 test_suite* OptionletStripperTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("OptionletStripper Tests");
     suite->add(QUANTLIB_TEST_CASE(
@@ -834,6 +881,8 @@ test_suite* OptionletStripperTest::suite() {
                        &OptionletStripperTest::testTermVolatilityStripping2));
     suite->add(QUANTLIB_TEST_CASE(
                        &OptionletStripperTest::testSwitchStrike));
+    suite->add(QUANTLIB_TEST_CASE(
+                       &OptionletStripperTest::testEvaluationDateChange));
 
     #if defined(QL_NEGATIVE_RATES)
     suite->add(QUANTLIB_TEST_CASE(
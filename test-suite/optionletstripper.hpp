@@ -36,6 +36,7 @@ class OptionletStripperTest {
     static void testFlatTermVolatilityStripping2();
     static void testTermVolatilityStripping2();
     static void testSwitchStrike();
+    static void testEvaluationDateChange();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -23,9 +23,12 @@
 
 #include <ql/termstructures/yield/oisratehelper.hpp>
 #include <ql/instruments/makeois.hpp>
+#include <ql/experimental/averageois/arithmeticoisratehelper.hpp>
+#include <ql/experimental/averageois/averageoiscouponpricer.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
@@ -38,6 +41,8 @@
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/overnightindexedcoupon.hpp>
+#include <ql/indexes/indexmanager.hpp>
 #include <ql/currencies/europe.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
@@ -176,6 +181,7 @@ namespace {
 
         // cleanup
         SavedSettings backup;
+        IndexHistoryCleaner indexCleaner;
 
         // utilities
         shared_ptr<OvernightIndexedSwap> makeSwap(Period length,
@@ -215,6 +221,50 @@ namespace {
         }
     };
 
+    Rate compoundedRate(const OvernightIndexedCoupon& coupon,
+                        const Handle<YieldTermStructure>& curve) {
+        // straightforward compounding of each daily rate
+        const std::vector<Date>& fixingDates = coupon.fixingDates();
+        const std::vector<Date>& valueDates = coupon.valueDates();
+        const std::vector<Time>& dt = coupon.dt();
+        Date today = Settings::instance().evaluationDate();
+        Real compoundFactor = 1.0;
+        for (Size i=0; i<dt.size(); ++i) {
+            Rate fixing = Null<Rate>();
+            if (fixingDates[i] <= today)
+                fixing = IndexManager::instance()
+                    .getHistory(coupon.index()->name())[fixingDates[i]];
+            if (fixing == Null<Rate>())
+                fixing = (curve->discount(valueDates[i])
+                          / curve->discount(valueDates[i+1]) - 1.0) / dt[i];
+            compoundFactor *= 1.0 + fixing*dt[i];
+        }
+        return coupon.gearing()*(compoundFactor - 1.0)/coupon.accrualPeriod()
+            + coupon.spread();
+    }
+
+    Rate averagedRate(const OvernightIndexedCoupon& coupon,
+                      const Handle<YieldTermStructure>& curve) {
+        // straightforward sum of each daily rate
+        const std::vector<Date>& fixingDates = coupon.fixingDates();
+        const std::vector<Date>& valueDates = coupon.valueDates();
+        const std::vector<Time>& dt = coupon.dt();
+        Date today = Settings::instance().evaluationDate();
+        Real accumulatedRate = 0.0;
+        for (Size i=0; i<dt.size(); ++i) {
+            Rate fixing = Null<Rate>();
+            if (fixingDates[i] <= today)
+                fixing = IndexManager::instance()
+                    .getHistory(coupon.index()->name())[fixingDates[i]];
+            if (fixing == Null<Rate>())
+                fixing = (curve->discount(valueDates[i])
+                          / curve->discount(valueDates[i+1]) - 1.0) / dt[i];
+            accumulatedRate += fixing*dt[i];
+        }
+        return coupon.gearing()*accumulatedRate/coupon.accrualPeriod()
+            + coupon.spread();
+    }
+
 }
 
 
@@ -505,6 +555,256 @@ void OvernightIndexedSwapTest::testSeasonedSwaps() {
 }
 
 
+void OvernightIndexedSwapTest::testCompoundingCache() {
+
+    BOOST_TEST_MESSAGE("Testing cached compounding of overnight fixings...");
+
+    CommonVars vars;
+
+    Date effectiveDate = Date(2, February, 2009);
+    vars.eoniaIndex->addFixing(Date(2,February,2009), 0.0010);
+    vars.eoniaIndex->addFixing(Date(3,February,2009), 0.0011);
+    vars.eoniaIndex->addFixing(Date(4,February,2009), 0.0012);
+
+    const Real tolerance = 1.0e-12;
+
+    // the first and last value dates must agree with the schedule
+    for (Size k=0; k<2; ++k) {
+        bool telescopicValueDates = (k == 1);
+        Leg leg = vars.makeSwap(30*Years, 0.0, 0.0, telescopicValueDates,
+                                effectiveDate)->overnightLeg();
+        for (Size i=0; i<leg.size(); ++i) {
+            shared_ptr<OvernightIndexedCoupon> c =
+                boost::dynamic_pointer_cast<OvernightIndexedCoupon>(leg[i]);
+            if (c->startValueDate() != c->valueDates().front()
+                || c->endValueDate() != c->valueDates().back()
+                || c->firstFixingDate() != c->fixingDates().front())
+                BOOST_ERROR("value dates don't match schedule:"
+                            << "\n    coupon:     " << i
+                            << "\n    start:      " << c->startValueDate()
+                            << " vs " << c->valueDates().front()
+                            << "\n    end:        " << c->endValueDate()
+                            << " vs " << c->valueDates().back()
+                            << "\n    first fixing: "
+                            << c->firstFixingDate()
+                            << " vs " << c->fixingDates().front());
+            Rate calculated = c->rate();
+            Rate expected = compoundedRate(*c, vars.eoniaTermStructure);
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce compounded rate:"
+                            << "\n    coupon:     " << i
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    Leg leg = vars.makeSwap(1*Years, 0.0, 0.0, false,
+                            effectiveDate)->overnightLeg();
+    shared_ptr<OvernightIndexedCoupon> coupon =
+        boost::dynamic_pointer_cast<OvernightIndexedCoupon>(leg.front());
+
+    Date dates[] = {
+        Date(5,February,2009), Date(5,February,2009),
+        Date(11,February,2009), Date(9,February,2009),
+        Date(5,February,2009)
+    };
+    for (Size i=0; i<LENGTH(dates); ++i) {
+        Settings::instance().evaluationDate() = dates[i];
+        if (i == 1) {
+            // a fixing changes after the product was cached
+            vars.eoniaIndex->addFixing(Date(3,February,2009), 0.0020, true);
+        } else if (i == 2) {
+            // new fixings are available
+            vars.eoniaIndex->addFixing(Date(5,February,2009), 0.0013);
+            vars.eoniaIndex->addFixing(Date(6,February,2009), 0.0014);
+            vars.eoniaIndex->addFixing(Date(9,February,2009), 0.0015);
+            vars.eoniaIndex->addFixing(Date(10,February,2009), 0.0016);
+        }
+        Rate calculated = coupon->rate();
+        Rate expected = compoundedRate(*coupon, vars.eoniaTermStructure);
+        if (std::fabs(calculated - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce compounded rate:"
+                        << "\n    evaluation date: " << dates[i]
+                        << std::setprecision(12)
+                        << "\n    calculated:      " << calculated
+                        << "\n    expected:        " << expected);
+    }
+}
+
+
+void OvernightIndexedSwapTest::testHelperQuotes() {
+
+    BOOST_TEST_MESSAGE("Testing implied quotes of OIS rate helpers...");
+
+    CommonVars vars;
+
+    // a sloped forwarding curve and a different discount curve
+    std::vector<Date> dates;
+    std::vector<Rate> rates;
+    dates.push_back(vars.today);                   rates.push_back(0.010);
+    dates.push_back(vars.today + 1*Years);         rates.push_back(0.015);
+    dates.push_back(vars.today + 5*Years);         rates.push_back(0.030);
+    dates.push_back(vars.today + 40*Years);        rates.push_back(0.040);
+    ZeroCurve forwarding(dates, rates, Actual365Fixed());
+    Handle<YieldTermStructure> discounting(flatRate(vars.today, 0.02,
+                                                    Actual365Fixed()));
+    vars.eoniaTermStructure.linkTo(
+             shared_ptr<YieldTermStructure>(new ZeroCurve(forwarding)));
+
+    Handle<Quote> quote(shared_ptr<Quote>(new SimpleQuote(0.02)));
+    Period lengths[] = { 1*Weeks, 3*Months, 1*Years, 5*Years, 30*Years };
+    Date startDates[] = { vars.settlement, vars.today + 1*Years,
+                          Date(2, February, 2009) };
+    vars.eoniaIndex->addFixing(Date(2,February,2009), 0.0010);
+    vars.eoniaIndex->addFixing(Date(3,February,2009), 0.0011);
+    vars.eoniaIndex->addFixing(Date(4,February,2009), 0.0012);
+
+    const Real tolerance = 1.0e-12;
+
+    for (Size i=0; i<LENGTH(lengths); ++i) {
+        for (Size k=0; k<2; ++k) {
+            Handle<YieldTermStructure> exogenous =
+                k == 0 ? Handle<YieldTermStructure>() : discounting;
+            OISRateHelper helper(2, lengths[i], quote, vars.eoniaIndex,
+                                 exogenous);
+            helper.setTermStructure(&forwarding);
+            Rate calculated = helper.impliedQuote();
+            helper.swap()->recalculate();
+            Rate expected = helper.swap()->fairRate();
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce OIS fair rate:"
+                            << "\n    length:     " << lengths[i]
+                            << "\n    discount:   "
+                            << (k == 0 ? "forwarding" : "exogenous")
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+
+            // forward-starting and seasoned swaps
+            for (Size j=0; j<LENGTH(startDates); ++j) {
+                Date endDate = vars.calendar.advance(startDates[j],
+                                                     lengths[i]);
+                DatedOISRateHelper datedHelper(startDates[j], endDate,
+                                               quote, vars.eoniaIndex,
+                                               exogenous);
+                datedHelper.setTermStructure(&forwarding);
+                calculated = datedHelper.impliedQuote();
+                shared_ptr<OvernightIndexedSwap> swap =
+                    MakeOIS(Period(), vars.eoniaIndex, 0.0)
+                    .withEffectiveDate(startDates[j])
+                    .withTerminationDate(endDate)
+                    .withDiscountingTermStructure(
+                        k == 0 ? Handle<YieldTermStructure>(
+                                                 vars.eoniaTermStructure)
+                               : discounting);
+                expected = swap->fairRate();
+                if (std::fabs(calculated - expected) > tolerance)
+                    BOOST_ERROR("failed to reproduce dated OIS fair rate:"
+                                << "\n    start:      " << startDates[j]
+                                << "\n    end:        " << endDate
+                                << "\n    discount:   "
+                                << (k == 0 ? "forwarding" : "exogenous")
+                                << std::setprecision(12)
+                                << "\n    calculated: " << calculated
+                                << "\n    expected:   " << expected);
+            }
+        }
+    }
+}
+
+
+void OvernightIndexedSwapTest::testArithmeticAverage() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing arithmetic averages of overnight fixings...");
+
+    CommonVars vars;
+
+    Date effectiveDate = Date(2, February, 2009);
+    vars.eoniaIndex->addFixing(Date(2,February,2009), 0.0010);
+    vars.eoniaIndex->addFixing(Date(3,February,2009), 0.0011);
+    vars.eoniaIndex->addFixing(Date(4,February,2009), 0.0012);
+
+    const Real tolerance = 1.0e-12;
+
+    Leg leg = vars.makeSwap(1*Years, 0.0, 0.0, false,
+                            effectiveDate)->overnightLeg();
+    shared_ptr<OvernightIndexedCoupon> coupon =
+        boost::dynamic_pointer_cast<OvernightIndexedCoupon>(leg.front());
+    coupon->setPricer(shared_ptr<FloatingRateCouponPricer>(
+                new ArithmeticAveragedOvernightIndexedCouponPricer()));
+
+    Date dates[] = {
+        Date(5,February,2009), Date(11,February,2009),
+        Date(9,February,2009)
+    };
+    for (Size i=0; i<LENGTH(dates); ++i) {
+        Settings::instance().evaluationDate() = dates[i];
+        if (i == 1) {
+            vars.eoniaIndex->addFixing(Date(5,February,2009), 0.0013);
+            vars.eoniaIndex->addFixing(Date(6,February,2009), 0.0014);
+            vars.eoniaIndex->addFixing(Date(9,February,2009), 0.0015);
+            vars.eoniaIndex->addFixing(Date(10,February,2009), 0.0016);
+        }
+        Rate calculated = coupon->rate();
+        Rate expected = averagedRate(*coupon, vars.eoniaTermStructure);
+        if (std::fabs(calculated - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce averaged rate:"
+                        << "\n    evaluation date: " << dates[i]
+                        << std::setprecision(12)
+                        << "\n    calculated:      " << calculated
+                        << "\n    expected:        " << expected);
+    }
+    Settings::instance().evaluationDate() = vars.today;
+
+    // the helpers must reproduce the fair rates of their swaps
+    std::vector<Date> curveDates;
+    std::vector<Rate> rates;
+    curveDates.push_back(vars.today);            rates.push_back(0.010);
+    curveDates.push_back(vars.today + 1*Years);  rates.push_back(0.015);
+    curveDates.push_back(vars.today + 5*Years);  rates.push_back(0.030);
+    curveDates.push_back(vars.today + 40*Years); rates.push_back(0.040);
+    ZeroCurve forwarding(curveDates, rates, Actual365Fixed());
+    Handle<YieldTermStructure> discounting(flatRate(vars.today, 0.02,
+                                                    Actual365Fixed()));
+
+    Handle<Quote> quote(shared_ptr<Quote>(new SimpleQuote(0.02)));
+    Handle<Quote> spread(shared_ptr<Quote>(new SimpleQuote(0.001)));
+    Period lengths[] = { 1*Years, 5*Years, 20*Years };
+    Real volatilities[] = { 0.0, 0.01 };
+    const Spread basisPoint = 1.0e-4;
+
+    for (Size i=0; i<LENGTH(lengths); ++i) {
+      for (Size j=0; j<LENGTH(volatilities); ++j) {
+        for (Size k=0; k<2; ++k) {
+            bool byApprox = (k == 1);
+            ArithmeticOISRateHelper helper(2, lengths[i], Annual, quote,
+                                           vars.eoniaIndex, Annual, spread,
+                                           0.03, volatilities[j], byApprox,
+                                           discounting);
+            helper.setTermStructure(&forwarding);
+            Rate calculated = helper.impliedQuote();
+            shared_ptr<ArithmeticAverageOIS> swap = helper.swap();
+            swap->recalculate();
+            Rate expected =
+                -(swap->overnightLegNPV()
+                  + swap->overnightLegBPS()/basisPoint*spread->value())
+                / (swap->fixedLegBPS()/basisPoint);
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce arithmetic OIS quote:"
+                            << "\n    length:     " << lengths[i]
+                            << "\n    volatility: " << volatilities[j]
+                            << "\n    approx:     " << byApprox
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+      }
+    }
+}
+
+
 test_suite* OvernightIndexedSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Overnight-indexed swap tests");
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairRate));
@@ -514,5 +814,11 @@ test_suite* OvernightIndexedSwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
         &OvernightIndexedSwapTest::testBootstrapWithTelescopicDates));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testSeasonedSwaps));
+    suite->add(QUANTLIB_TEST_CASE(
+        &OvernightIndexedSwapTest::testCompoundingCache));
+    suite->add(QUANTLIB_TEST_CASE(
+        &OvernightIndexedSwapTest::testHelperQuotes));
+    suite->add(QUANTLIB_TEST_CASE(
+        &OvernightIndexedSwapTest::testArithmeticAverage));
     return suite;
 }
@@ -34,6 +34,9 @@ class OvernightIndexedSwapTest {
     static void testBootstrap();
     static void testBootstrapWithTelescopicDates();
     static void testSeasonedSwaps();
+    static void testCompoundingCache();
+    static void testHelperQuotes();
+    static void testArithmeticAverage();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -20,6 +20,10 @@
 #include "pathgenerator.hpp"
 #include "utilities.hpp"
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/multipathbatchgenerator.hpp>
+#include <ql/processes/batesprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/processes/gjrgarchprocess.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
@@ -138,6 +142,76 @@ namespace {
         }
     }
 
+    void testBatch(const boost::shared_ptr<StochasticProcess>& process,
+                   const std::string& tag, bool spectral = false) {
+        typedef PseudoRandom::rsg_type rsg_type;
+        typedef MultiPathGenerator<rsg_type>::sample_type sample_type;
+
+        BigNatural seed = 42;
+        Time length = 10;
+        Size timeSteps = 12;
+        Size lanes = 8;
+        Size dimension = timeSteps*process->factors();
+        const TimeGrid grid(length, timeSteps);
+
+        boost::shared_ptr<MultiPathGenerator<rsg_type> > generator;
+        boost::shared_ptr<MultiPathBatchGenerator<rsg_type> > batchGenerator;
+        if (spectral) {
+            SpectralPathConstruction construction(grid, process->factors());
+            generator.reset(new MultiPathGenerator<rsg_type>(
+                process, grid,
+                PseudoRandom::make_sequence_generator(dimension, seed),
+                construction));
+            batchGenerator.reset(new MultiPathBatchGenerator<rsg_type>(
+                process, grid,
+                PseudoRandom::make_sequence_generator(dimension, seed),
+                lanes, construction));
+        } else {
+            generator.reset(new MultiPathGenerator<rsg_type>(
+                process, grid,
+                PseudoRandom::make_sequence_generator(dimension, seed),
+                false));
+            batchGenerator.reset(new MultiPathBatchGenerator<rsg_type>(
+                process, grid,
+                PseudoRandom::make_sequence_generator(dimension, seed),
+                lanes));
+        }
+
+        MultiPath path;
+        const Real tolerance = 1.0e-12;
+        for (Size n=0; n<3; ++n) {
+            bool antithetic = (n == 2);
+            const MultiPathBatch& batch = antithetic
+                ? batchGenerator->antithetic()
+                : batchGenerator->next();
+            for (Size k=0; k<lanes; ++k) {
+                // the antithetic batch is checked on its last lane only
+                if (antithetic && k < lanes-1)
+                    continue;
+                const sample_type& sample = antithetic
+                    ? generator->antithetic()
+                    : generator->next();
+                batch.path(k, path);
+                for (Size j=0; j<process->size(); ++j) {
+                    for (Size i=0; i<path.pathSize(); ++i) {
+                        Real expected = sample.value[j][i];
+                        Real calculated = path[j][i];
+                        if (std::fabs(calculated-expected)
+                                > tolerance*std::max(1.0,
+                                                    std::fabs(expected)))
+                            BOOST_FAIL("using " << tag << " process "
+                                       << "(" << io::ordinal(j+1)
+                                       << " asset, lane " << k
+                                       << ", time " << i << "):\n"
+                                       << std::setprecision(13)
+                                       << "    calculated: " << calculated
+                                       << "\n    expected:   " << expected);
+                    }
+                }
+            }
+        }
+    }
+
 }
 
 
@@ -290,11 +364,138 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+void PathGeneratorTest::testMultiPathBatchGenerator() {
+
+    BOOST_TEST_MESSAGE("Testing batch n-D path generation...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    Matrix correlation(3,3);
+    correlation[0][0] = 1.0; correlation[0][1] = 0.9; correlation[0][2] = 0.7;
+    correlation[1][0] = 0.9; correlation[1][1] = 1.0; correlation[1][2] = 0.4;
+    correlation[2][0] = 0.7; correlation[2][1] = 0.4; correlation[2][2] = 1.0;
+
+    std::vector<boost::shared_ptr<StochasticProcess1D> > processes(3);
+    processes[0] = boost::shared_ptr<StochasticProcess1D>(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    processes[1] = boost::shared_ptr<StochasticProcess1D>(
+                       new GeometricBrownianMotionProcess(100.0, 0.03, 0.20));
+    processes[2] = boost::shared_ptr<StochasticProcess1D>(
+                                 new SquareRootProcess(0.1, 0.1, 0.20, 10.0));
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                          new StochasticProcessArray(processes, correlation)),
+              "process-array");
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                          new StochasticProcessArray(processes, correlation)),
+              "process-array (spectral construction)", true);
+
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                  new HestonProcess(r, q, x0, 0.04, 1.5, 0.04, 0.3, -0.7)),
+              "Heston");
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                  new HestonProcess(r, q, x0, 0.04, 1.5, 0.04, 0.3, -0.7)),
+              "Heston (spectral construction)", true);
+
+    // in this regime, the variance is drawn by both the quadratic
+    // and the exponential schemes
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                  new HestonProcess(r, q, x0, 0.04, 0.5, 0.04, 0.5, -0.5,
+                                    HestonProcess::QuadraticExponential)),
+              "Heston (QE)");
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                  new HestonProcess(
+                          r, q, x0, 0.04, 0.5, 0.04, 0.5, -0.5,
+                          HestonProcess::QuadraticExponentialMartingale)),
+              "Heston (QE martingale)");
+
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                  new BatesProcess(r, q, x0, 0.04, 1.5, 0.04, 0.3, -0.7,
+                                   0.2, -0.1, 0.1)),
+              "Bates");
+
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                  new GJRGARCHProcess(r, q, x0, 1.5e-4, 2.0e-6, 0.024, 0.93,
+                                      0.059, 0.1, 365.0,
+                                      GJRGARCHProcess::PartialTruncation)),
+              "GJR-GARCH (partial truncation)");
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                  new GJRGARCHProcess(r, q, x0, 1.5e-4, 2.0e-6, 0.024, 0.93,
+                                      0.059, 0.1, 365.0,
+                                      GJRGARCHProcess::FullTruncation)),
+              "GJR-GARCH (full truncation)");
+    testBatch(boost::shared_ptr<StochasticProcess>(
+                  new GJRGARCHProcess(r, q, x0, 1.5e-4, 2.0e-6, 0.024, 0.93,
+                                      0.059, 0.1, 365.0,
+                                      GJRGARCHProcess::Reflection)),
+              "GJR-GARCH (reflection)");
+}
+
+void PathGeneratorTest::testTimeGridCache() {
+
+    BOOST_TEST_MESSAGE("Testing time-grid cache...");
+
+    Time times[] = { 2.0, 0.5, 1.0, 1.0+1.0e-16, 3.5 };
+    std::vector<Time> mandatoryTimes(times, times+LENGTH(times));
+
+    TimeGridCache cache(3);
+    for (Size k=0; k<2; ++k) {
+        TimeGrid grids[] = {
+            cache.grid(3.5, 7),
+            cache.grid(mandatoryTimes),
+            cache.grid(mandatoryTimes, 10)
+        };
+        TimeGrid expected[] = {
+            TimeGrid(3.5, 7),
+            TimeGrid(mandatoryTimes.begin(), mandatoryTimes.end()),
+            TimeGrid(mandatoryTimes.begin(), mandatoryTimes.end(), 10)
+        };
+        for (Size i=0; i<LENGTH(grids); ++i) {
+            if (grids[i].size() != expected[i].size())
+                BOOST_FAIL("grid #" << i << " has " << grids[i].size()
+                           << " points; " << expected[i].size()
+                           << " expected");
+            if (grids[i].mandatoryTimes() != expected[i].mandatoryTimes())
+                BOOST_ERROR("wrong mandatory times for grid #" << i);
+            for (Size j=0; j<grids[i].size(); ++j) {
+                if (grids[i][j] != expected[i][j]
+                    || (j > 0 && grids[i].dt(j-1) != expected[i].dt(j-1)))
+                    BOOST_ERROR("grid #" << i << " differs at point #" << j
+                                << ":\n"
+                                << "    time:     " << grids[i][j] << "\n"
+                                << "    expected: " << expected[i][j]);
+            }
+        }
+    }
+
+    if (cache.size() != 3)
+        BOOST_ERROR(cache.size() << " grids cached; 3 expected");
+    cache.grid(1.0, 4);
+    if (cache.size() != 1)
+        BOOST_ERROR("cache not emptied at its maximum size");
+
+    // copies share their points
+    TimeGrid grid = cache.grid(mandatoryTimes, 10);
+    TimeGrid copy = cache.grid(mandatoryTimes, 10);
+    if (&*grid.begin() != &*copy.begin())
+        BOOST_ERROR("cached grids don't share their points");
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(
+        QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathBatchGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testTimeGridCache));
     return suite;
 }
 
@@ -20,6 +20,7 @@
 #include "piecewiseyieldcurve.hpp"
 #include "utilities.hpp"
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/bootstrapscheduler.hpp>
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/termstructures/yield/bondhelpers.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -48,6 +49,7 @@
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/experimental/termstructures/multicurvesensitivities.hpp>
 #include <boost/make_shared.hpp>
 #include <iomanip>
 
@@ -763,6 +765,46 @@ void PiecewiseYieldCurveTest::testLocalBootstrapConsistency() {
 }
 
 
+void PiecewiseYieldCurveTest::testGlobalBootstrapConsistency() {
+    BOOST_TEST_MESSAGE(
+        "Testing consistency of global-bootstrap algorithm...");
+
+    CommonVars vars;
+    Cubic spline(CubicInterpolation::Spline, true,
+                 CubicInterpolation::SecondDerivative, 0.0,
+                 CubicInterpolation::SecondDerivative, 0.0);
+    testCurveConsistency<ZeroYield,Cubic,GlobalBootstrap>(vars, spline);
+    testBMACurveConsistency<ZeroYield,Cubic,GlobalBootstrap>(vars, spline);
+    testCurveConsistency<ForwardRate,ConvexMonotone,GlobalBootstrap>(vars);
+    testBMACurveConsistency<ForwardRate,ConvexMonotone,
+                            GlobalBootstrap>(vars);
+
+    // helpers whose pillar is not after the reference date are skipped
+    boost::shared_ptr<SimpleQuote> overnight(new SimpleQuote(0.01));
+    std::vector<boost::shared_ptr<RateHelper> > instruments =
+                                                         vars.instruments;
+    instruments.push_back(boost::shared_ptr<RateHelper>(
+        new DepositRateHelper(Handle<Quote>(overnight), 1*Days, 0,
+                              vars.calendar, Following, false,
+                              Actual360())));
+    PiecewiseYieldCurve<ZeroYield,Cubic,GlobalBootstrap> curve(
+                           vars.settlement, instruments, Actual360(), spline);
+
+    if (curve.dates().size() != vars.instruments.size()+1)
+        BOOST_ERROR("expired helper not skipped:"
+                    << "\n    pillars:  " << curve.dates().size()-1
+                    << "\n    expected: " << vars.instruments.size());
+    Real tolerance = 1.0e-9;
+    for (Size i=0; i<vars.instruments.size(); ++i) {
+        Real error = std::fabs(vars.instruments[i]->quoteError());
+        if (error > tolerance)
+            BOOST_ERROR(io::ordinal(i+1) << " instrument not repriced:"
+                        << "\n    quote error: " << error
+                        << "\n    tolerance:   " << tolerance);
+    }
+}
+
+
 void PiecewiseYieldCurveTest::testObservability() {
 
     BOOST_TEST_MESSAGE("Testing observability of piecewise yield curve...");
@@ -1052,6 +1094,305 @@ void PiecewiseYieldCurveTest::testSwapRateHelperLastRelevantDate() {
 }
 
 
+namespace {
+
+    class CountingDepositRateHelper : public DepositRateHelper {
+      public:
+        CountingDepositRateHelper(const Handle<Quote>& rate,
+                                  const Period& tenor,
+                                  const boost::shared_ptr<IborIndex>& index)
+        : DepositRateHelper(rate, tenor, index->fixingDays(),
+                            index->fixingCalendar(),
+                            index->businessDayConvention(),
+                            index->endOfMonth(), index->dayCounter()),
+          calls_(0) {}
+        Real impliedQuote() const {
+            ++calls_;
+            return DepositRateHelper::impliedQuote();
+        }
+        Size calls() const { return calls_; }
+        void reset() { calls_ = 0; }
+      private:
+        mutable Size calls_;
+    };
+
+    void checkAgainstFullBootstrap(
+             const PiecewiseYieldCurve<Discount,LogLinear>& curve,
+             const std::vector<boost::shared_ptr<RateHelper> >& instruments,
+             const std::vector<Handle<Quote> >& jumps,
+             const std::vector<Date>& jumpDates,
+             const std::string& change) {
+        // the nodes must be read before the full bootstrap, which
+        // links the helpers to the new curve; the helpers are linked
+        // back to the tested curve when it's recalculated
+        std::vector<Real> calculated = curve.data();
+        PiecewiseYieldCurve<Discount,LogLinear> full(curve.referenceDate(),
+                                                     instruments,
+                                                     curve.dayCounter(),
+                                                     jumps, jumpDates);
+        const std::vector<Real>& expected = full.data();
+
+        Real tolerance = 1.0e-12;
+        for (Size i=0; i<expected.size(); ++i) {
+            Real error = std::fabs(calculated[i]-expected[i]);
+            if (error > tolerance)
+                BOOST_ERROR("failed to reproduce full bootstrap after "
+                            << change << ":"
+                            << "\n    node:       " << i
+                            << "\n    calculated: " << calculated[i]
+                            << "\n    expected:   " << expected[i]
+                            << "\n    error:      " << error);
+        }
+    }
+
+}
+
+void PiecewiseYieldCurveTest::testIncrementalBootstrap() {
+    BOOST_TEST_MESSAGE("Testing incremental bootstrap "
+                       "after a single quote change...");
+
+    CommonVars vars;
+
+    boost::shared_ptr<IborIndex> euribor6m(new Euribor6M);
+    std::vector<boost::shared_ptr<CountingDepositRateHelper> > deposits;
+    std::vector<boost::shared_ptr<RateHelper> > instruments;
+    for (Size i=0; i<vars.deposits; i++) {
+        Handle<Quote> r(vars.rates[i]);
+        deposits.push_back(boost::shared_ptr<CountingDepositRateHelper>(
+            new CountingDepositRateHelper(
+                 r, depositData[i].n*depositData[i].units, euribor6m)));
+        instruments.push_back(deposits.back());
+    }
+    for (Size i=0; i<vars.swaps; i++)
+        instruments.push_back(vars.instruments[i+vars.deposits]);
+
+    // the jump is not a helper; it affects all the pillars after it
+    boost::shared_ptr<SimpleQuote> jump(new SimpleQuote(0.999));
+    std::vector<Handle<Quote> > jumps(1, Handle<Quote>(jump));
+    std::vector<Date> jumpDates(1, vars.settlement + 2*Weeks);
+
+    PiecewiseYieldCurve<Discount,LogLinear> curve(vars.settlement,
+                                                  instruments,
+                                                  Actual360(),
+                                                  jumps, jumpDates);
+    curve.discount(1.0);
+
+    Real tolerance = 1.0e-9;
+
+    // a change in the last swap quote doesn't affect the deposits
+    for (Size i=0; i<vars.deposits; i++)
+        deposits[i]->reset();
+    const boost::shared_ptr<SimpleQuote>& last = vars.rates.back();
+    last->setValue(last->value() + 0.001);
+    curve.discount(1.0);
+
+    for (Size i=0; i<vars.deposits; i++) {
+        if (deposits[i]->calls() != 0)
+            BOOST_ERROR(io::ordinal(i+1) << " deposit re-bootstrapped "
+                        "after a change in the last swap quote");
+    }
+    for (Size i=0; i<instruments.size(); i++) {
+        Real error = std::fabs(instruments[i]->quoteError());
+        if (error > tolerance)
+            BOOST_ERROR(io::ordinal(i+1) << " instrument not repriced:"
+                        << "\n    quote error: " << error
+                        << "\n    tolerance:   " << tolerance);
+    }
+    checkAgainstFullBootstrap(curve, instruments, jumps, jumpDates,
+                              "a change in the last swap quote");
+
+    // a change in the first deposit quote affects the whole curve
+    vars.rates[0]->setValue(vars.rates[0]->value() + 0.001);
+    curve.discount(1.0);
+
+    for (Size i=0; i<vars.deposits; i++) {
+        if (deposits[i]->calls() == 0)
+            BOOST_ERROR(io::ordinal(i+1) << " deposit not re-bootstrapped "
+                        "after a change in the first deposit quote");
+    }
+    for (Size i=0; i<instruments.size(); i++) {
+        Real error = std::fabs(instruments[i]->quoteError());
+        if (error > tolerance)
+            BOOST_ERROR(io::ordinal(i+1) << " instrument not repriced:"
+                        << "\n    quote error: " << error
+                        << "\n    tolerance:   " << tolerance);
+    }
+    checkAgainstFullBootstrap(curve, instruments, jumps, jumpDates,
+                              "a change in the first deposit quote");
+
+    // a notification from something other than the helpers (here,
+    // the jump) together with a change in the last swap quote
+    // requires a full bootstrap
+    for (Size i=0; i<vars.deposits; i++)
+        deposits[i]->reset();
+    last->setValue(last->value() - 0.001);
+    jump->setValue(0.998);
+    curve.discount(1.0);
+
+    for (Size i=0; i<vars.deposits; i++) {
+        if (deposits[i]->calls() == 0)
+            BOOST_ERROR(io::ordinal(i+1) << " deposit not re-bootstrapped "
+                        "after a change in the jump");
+    }
+    for (Size i=0; i<instruments.size(); i++) {
+        Real error = std::fabs(instruments[i]->quoteError());
+        if (error > tolerance)
+            BOOST_ERROR(io::ordinal(i+1) << " instrument not repriced:"
+                        << "\n    quote error: " << error
+                        << "\n    tolerance:   " << tolerance);
+    }
+    checkAgainstFullBootstrap(curve, instruments, jumps, jumpDates,
+                              "a change in the jump and in the last swap quote");
+}
+
+
+namespace {
+
+    typedef PiecewiseYieldCurve<ZeroYield,Linear> ZeroLinearCurve;
+
+    void checkParQuoteSensitivities(
+         const std::map<std::string, Handle<YieldTermStructure> >& curves,
+         const std::vector<boost::shared_ptr<SimpleQuote> >& quotes) {
+
+        typedef std::map<std::string,
+                         Handle<YieldTermStructure> >::const_iterator iter;
+
+        MultiCurveSensitivities sensitivities(curves);
+        Matrix calculated = sensitivities.sensitivities();
+
+        Real h = 1.0e-6, tolerance = 1.0e-6;
+        for (Size j=0; j<quotes.size(); ++j) {
+            Real q = quotes[j]->value();
+            std::vector<Real> up, down;
+            quotes[j]->setValue(q+h);
+            for (iter c=curves.begin(); c!=curves.end(); ++c) {
+                const std::vector<Real>& data =
+                    boost::dynamic_pointer_cast<ZeroLinearCurve>(
+                                           c->second.currentLink())->data();
+                up.insert(up.end(), data.begin()+1, data.end());
+            }
+            quotes[j]->setValue(q-h);
+            for (iter c=curves.begin(); c!=curves.end(); ++c) {
+                const std::vector<Real>& data =
+                    boost::dynamic_pointer_cast<ZeroLinearCurve>(
+                                           c->second.currentLink())->data();
+                down.insert(down.end(), data.begin()+1, data.end());
+            }
+            quotes[j]->setValue(q);
+
+            for (Size i=0; i<up.size(); ++i) {
+                Real expected = (up[i]-down[i])/(2.0*h);
+                if (std::fabs(calculated[j][i]-expected) > tolerance)
+                    BOOST_ERROR("failed to reproduce sensitivity of "
+                                << io::ordinal(i+1) << " node to "
+                                << io::ordinal(j+1) << " quote:"
+                                << "\n    calculated: " << calculated[j][i]
+                                << "\n    expected:   " << expected
+                                << "\n    tolerance:  " << tolerance);
+            }
+        }
+    }
+
+}
+
+void PiecewiseYieldCurveTest::testParQuoteSensitivities() {
+    BOOST_TEST_MESSAGE("Testing sensitivities of curve nodes "
+                       "to par quotes...");
+
+    CommonVars vars;
+
+    std::map<std::string, Handle<YieldTermStructure> > curves;
+    Handle<YieldTermStructure> discountCurve(
+        boost::shared_ptr<YieldTermStructure>(
+            new ZeroLinearCurve(vars.settlement, vars.instruments,
+                                Actual360())));
+    curves["discount"] = discountCurve;
+
+    // a single curve uses the sensitivities from the bootstrapper
+    checkParQuoteSensitivities(curves, vars.rates);
+
+    // a forwarding curve discounted on the first one
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes = vars.rates;
+    std::vector<boost::shared_ptr<RateHelper> > helpers;
+    boost::shared_ptr<IborIndex> euribor6m(new Euribor6M);
+    for (Size i=0; i<vars.swaps; i++) {
+        boost::shared_ptr<SimpleQuote> q(
+                               new SimpleQuote(swapData[i].rate/100 + 0.002));
+        quotes.push_back(q);
+        helpers.push_back(boost::shared_ptr<RateHelper>(
+            new SwapRateHelper(Handle<Quote>(q),
+                               swapData[i].n*swapData[i].units,
+                               vars.calendar, vars.fixedLegFrequency,
+                               vars.fixedLegConvention,
+                               vars.fixedLegDayCounter, euribor6m,
+                               Handle<Quote>(), 0*Days, discountCurve)));
+    }
+    curves["forward"] = Handle<YieldTermStructure>(
+        boost::shared_ptr<YieldTermStructure>(
+            new ZeroLinearCurve(vars.settlement, helpers, Actual360())));
+
+    checkParQuoteSensitivities(curves, quotes);
+}
+
+
+void PiecewiseYieldCurveTest::testBootstrapScheduler() {
+    BOOST_TEST_MESSAGE("Testing scheduled bootstrap of "
+                       "interdependent curves...");
+
+    CommonVars vars;
+
+    boost::shared_ptr<ZeroLinearCurve> discountCurve(
+        new ZeroLinearCurve(vars.settlement, vars.instruments, Actual360()));
+    Handle<YieldTermStructure> discountHandle(discountCurve);
+
+    std::vector<boost::shared_ptr<RateHelper> > helpers;
+    boost::shared_ptr<IborIndex> euribor6m(new Euribor6M);
+    for (Size i=0; i<vars.swaps; i++) {
+        Handle<Quote> q(boost::shared_ptr<Quote>(
+                              new SimpleQuote(swapData[i].rate/100 + 0.002)));
+        helpers.push_back(boost::shared_ptr<RateHelper>(
+            new SwapRateHelper(q, swapData[i].n*swapData[i].units,
+                               vars.calendar, vars.fixedLegFrequency,
+                               vars.fixedLegConvention,
+                               vars.fixedLegDayCounter, euribor6m,
+                               Handle<Quote>(), 0*Days, discountHandle)));
+    }
+    boost::shared_ptr<ZeroLinearCurve> forwardCurve(
+        new ZeroLinearCurve(vars.settlement, helpers, Actual360()));
+
+    BootstrapScheduler scheduler;
+    Size forward = scheduler.add(forwardCurve);
+    Size discount = scheduler.add(discountCurve);
+    scheduler.build();
+
+    if (scheduler.dependencies(forward) != std::vector<Size>(1, discount))
+        BOOST_ERROR("dependency of forward curve on discount curve "
+                    "not detected");
+    if (!scheduler.dependencies(discount).empty())
+        BOOST_ERROR("spurious dependency of discount curve detected");
+    for (Size i=0; i<scheduler.size(); ++i) {
+        if (scheduler.buildTime(i) < 0.0)
+            BOOST_ERROR("negative build time for curve #" << i);
+    }
+
+    Real tolerance = 1.0e-9;
+    for (Size i=0; i<vars.instruments.size(); ++i) {
+        Real error = std::fabs(vars.instruments[i]->quoteError());
+        if (error > tolerance)
+            BOOST_ERROR(io::ordinal(i+1) << " discount helper not repriced:"
+                        << "\n    quote error: " << error
+                        << "\n    tolerance:   " << tolerance);
+    }
+    for (Size i=0; i<helpers.size(); ++i) {
+        Real error = std::fabs(helpers[i]->quoteError());
+        if (error > tolerance)
+            BOOST_ERROR(io::ordinal(i+1) << " forward helper not repriced:"
+                        << "\n    quote error: " << error
+                        << "\n    tolerance:   " << tolerance);
+    }
+}
+
+
 test_suite* PiecewiseYieldCurveTest::suite() {
 
     test_suite* suite = BOOST_TEST_SUITE("Piecewise yield curve tests");
@@ -1089,6 +1430,8 @@ test_suite* PiecewiseYieldCurveTest::suite() {
              &PiecewiseYieldCurveTest::testConvexMonotoneForwardConsistency));
     suite->add(QUANTLIB_TEST_CASE(
              &PiecewiseYieldCurveTest::testLocalBootstrapConsistency));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testGlobalBootstrapConsistency));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testObservability));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testLiborFixing));
@@ -1100,5 +1443,12 @@ test_suite* PiecewiseYieldCurveTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testZeroCopy));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testSwapRateHelperLastRelevantDate));
+
+    suite->add(QUANTLIB_TEST_CASE(
+                   &PiecewiseYieldCurveTest::testIncrementalBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &PiecewiseYieldCurveTest::testParQuoteSensitivities));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &PiecewiseYieldCurveTest::testBootstrapScheduler));
     return suite;
 }
@@ -41,6 +41,7 @@ class PiecewiseYieldCurveTest {
 
     static void testConvexMonotoneForwardConsistency();
     static void testLocalBootstrapConsistency();
+    static void testGlobalBootstrapConsistency();
 
     static void testObservability();
     static void testLiborFixing();
@@ -53,6 +54,10 @@ class PiecewiseYieldCurveTest {
 
     static void testSwapRateHelperLastRelevantDate();
 
+    static void testIncrementalBootstrap();
+    static void testParQuoteSensitivities();
+    static void testBootstrapScheduler();
+
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -79,6 +79,9 @@
 
 #include <ql/types.hpp>
 #include <ql/version.hpp>
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/timer.hpp>
 #include <iostream>
@@ -157,6 +160,79 @@ namespace {
                              // point operations (not per sec!)
     };
 
+    /* Element-wise arithmetic of an explicit finite-difference step,
+       with 6 floating point operations per grid point.  The first
+       version is evaluated in a single loop through the expression
+       templates of Array; the second one materializes each partial
+       result as the operators used to do, and gives the baseline. */
+    const QuantLib::Size fdmGridSize = 10000, fdmSteps = 10000;
+    const double fdmStepMflop = 6.0*fdmGridSize*fdmSteps/1.0e6;
+
+    void fdmStepExpressions() {
+        using namespace QuantLib;
+        const Real dt = 1.0e-3;
+        const Array a(fdmGridSize, 0.3), b(fdmGridSize, -0.2),
+                    c(fdmGridSize, 0.01);
+        Array x(fdmGridSize, 1.0), y(fdmGridSize, 1.0);
+        for (Size i=0; i<fdmSteps; ++i) {
+            y = x + dt*(a*x + b*y - c);
+            x.swap(y);
+        }
+        BOOST_CHECK(x[0] > 1.0);
+    }
+
+    void fdmStepTemporaries() {
+        using namespace QuantLib;
+        const Real dt = 1.0e-3;
+        const Array a(fdmGridSize, 0.3), b(fdmGridSize, -0.2),
+                    c(fdmGridSize, 0.01);
+        Array x(fdmGridSize, 1.0), y(fdmGridSize, 1.0);
+        for (Size i=0; i<fdmSteps; ++i) {
+            const Array ax = a*x, by = b*y;
+            const Array sum = ax + by;
+            const Array rhs = sum - c;
+            const Array increment = dt*rhs;
+            y = x + increment;
+            x.swap(y);
+        }
+        BOOST_CHECK(x[0] > 1.0);
+    }
+
+    /* Covariance handling of a 120-rate market model: the covariance
+       is built from volatilities and correlations, and decomposed by
+       Cholesky, spectral and rank-reduced square roots.  The flop
+       count is nominal, i.e., 4n^3 for the products, n^3/3 for the
+       Cholesky decomposition and 9n^3 for each eigendecomposition.
+       Comparing runs with and without QL_USE_LAPACK shows the gain
+       of the BLAS and LAPACK backend. */
+    const QuantLib::Size covarianceSize = 120, covarianceSteps = 50;
+    const double covarianceMflop =
+        (4.0+1.0/3.0+18.0)*covarianceSize*covarianceSize*covarianceSize
+        *covarianceSteps/1.0e6;
+
+    void lmmCovarianceHandling() {
+        using namespace QuantLib;
+        const Size n = covarianceSize;
+        Matrix correlation(n, n), volatility(n, n, 0.0);
+        for (Size i=0; i<n; ++i) {
+            volatility[i][i] = 0.1 + 0.001*i;
+            for (Size j=0; j<n; ++j)
+                correlation[i][j] =
+                    0.3 + 0.7*std::exp(-0.05*std::fabs(Real(i)-Real(j)));
+        }
+        Real check = 0.0;
+        for (Size k=0; k<covarianceSteps; ++k) {
+            const Matrix covariance = volatility*correlation*volatility;
+            const Matrix L = CholeskyDecomposition(covariance);
+            const Matrix S = pseudoSqrt(covariance,
+                                        SalvagingAlgorithm::Spectral);
+            const Matrix R = rankReducedSqrt(covariance, 10, 1.0,
+                                             SalvagingAlgorithm::Spectral);
+            check += L[n-1][n-1] + S[0][0] + R[0][0];
+        }
+        BOOST_CHECK(check > 0.0);
+    }
+
     boost::timer t;
     std::list<double> runTimes;
     std::list<Benchmark> bm;
@@ -235,6 +311,10 @@ test_suite* init_unit_test_suite(int, char*[]) {
         &AmericanOptionTest::testFdAmericanGreeks, 518.31));
     bm.push_back(Benchmark("AmericanOption::FdShoutGreeks",
         &AmericanOptionTest::testFdShoutGreeks, 546.58));
+    bm.push_back(Benchmark("Array::FdmStepExpressions",
+        &fdmStepExpressions, fdmStepMflop));
+    bm.push_back(Benchmark("Array::FdmStepTemporaries",
+        &fdmStepTemporaries, fdmStepMflop));
     bm.push_back(Benchmark("AsianOption::MCArithmeticAveragePrice",
         &AsianOptionTest::testMCDiscreteArithmeticAveragePrice, 5186.13));
     bm.push_back(Benchmark("BarrierOption::BabsiriValues",
@@ -277,6 +357,8 @@ test_suite* init_unit_test_suite(int, char*[]) {
     bm.push_back(Benchmark("MarketModelSmmTest::testMultiSmmSwaptions",
         &MarketModelSmmTest::testMultiStepCoterminalSwapsAndSwaptions,
         11244.95));
+    bm.push_back(Benchmark("Matrix::LmmCovarianceHandling",
+        &lmmCovarianceHandling, covarianceMflop));
     bm.push_back(Benchmark("QuantoOption::ForwardGreeks",
         &QuantoOptionTest::testForwardGreeks, 90.98));
     bm.push_back(Benchmark("RandomNumber::MersenneTwisterDescrepancy",
@@ -0,0 +1,940 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*
+ QuantLib Micro-Benchmarks
+
+ Times a set of kernels on which the performance of typical
+ applications depends.  Unlike quantlib-benchmark, which reports a
+ single aggregate index, each kernel is timed separately so that
+ regressions can be traced to the corresponding code path.
+
+ Each kernel is first run for a number of warm-up repetitions, during
+ which the number of iterations per repetition is chosen so that a
+ repetition lasts at least the given minimum time.  The kernel is
+ then timed over the given number of repetitions; the mean, standard
+ deviation, minimum, median and maximum of the time per iteration are
+ reported.
+
+ Usage: quantlib-microbenchmark [options]
+     --filter=<text>       only run the kernels whose name contains text
+     --repetitions=<n>     number of timed repetitions (default: 10)
+     --warmup=<n>          number of warm-up repetitions (default: 2)
+     --min-time=<seconds>  minimum duration of a repetition (default: 0.1)
+     --json=<file>         also write the results to file in the JSON
+                           format of Google Benchmark, which most CI
+                           trend-tracking tools can read
+     --list                list the available kernels and exit
+*/
+
+#include <ql/types.hpp>
+#include <ql/version.hpp>
+#include <ql/settings.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/termstructures/yield/oisratehelper.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/credit/flathazardrate.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/indexes/swap/euriborswap.hpp>
+#include <ql/indexes/ibor/eonia.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/instruments/makecds.hpp>
+#include <ql/instruments/makeois.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/pricingengines/credit/isdacdsengine.hpp>
+#include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/baroneadesiwhaleyengine.hpp>
+#include <ql/pricingengines/vanilla/americanapproximationbatchpricer.hpp>
+#include <ql/pricingengines/vanilla/fdamericanengine.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/inversecumulativersg.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/experimental/math/zigguratrng.hpp>
+#include <ql/experimental/math/claytoncopularng.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/statistics/generalstatistics.hpp>
+#include <ql/models/marketmodels/all.hpp>
+#include <ql/termstructures/volatility/swaption/swaptionvolcube1.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+#include <ql/utilities/dataparsers.hpp>
+
+#include "swaptionvolstructuresutilities.hpp"
+
+#define BOOST_CHRONO_HEADER_ONLY
+#include <boost/chrono.hpp>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace QuantLib;
+using boost::shared_ptr;
+
+#define LENGTH(a) (sizeof(a)/sizeof(a[0]))
+
+#if defined(QL_ENABLE_SESSIONS)
+namespace QuantLib {
+
+    Integer sessionId() { return 0; }
+
+}
+#endif
+
+
+namespace {
+
+    // results are accumulated here so that the compiler can't
+    // optimize away the calculations
+    volatile Real sink = 0.0;
+
+    class Kernel {
+      public:
+        virtual ~Kernel() {}
+        virtual std::string name() const = 0;
+        //! performs one iteration
+        virtual void run() = 0;
+    };
+
+    const Date today(15, January, 2018);
+
+
+    class BlackFormulaKernel : public Kernel {
+      public:
+        std::string name() const { return "blackFormula"; }
+        void run() {
+            Real sum = 0.0;
+            for (Size i=0; i<1000; ++i) {
+                Real strike = 50.0 + 0.1*i;
+                sum += blackFormula(Option::Call, strike, 100.0, 0.2, 0.95);
+            }
+            sink = sink + sum;
+        }
+    };
+
+
+    class CurveBootstrapKernel : public Kernel {
+      public:
+        CurveBootstrapKernel() {
+            DayCounter dc = Actual360();
+            Calendar calendar = TARGET();
+            shared_ptr<IborIndex> euribor6m(new Euribor6M);
+
+            std::vector<shared_ptr<RateHelper> > helpers;
+            Integer depositMonths[] = { 1, 3, 6, 9, 12 };
+            for (Size i=0; i<LENGTH(depositMonths); ++i) {
+                shared_ptr<SimpleQuote> q(new SimpleQuote(0.01+0.0005*i));
+                quotes_.push_back(q);
+                helpers.push_back(shared_ptr<RateHelper>(
+                    new DepositRateHelper(Handle<Quote>(q),
+                                          depositMonths[i]*Months, 2,
+                                          calendar, ModifiedFollowing,
+                                          true, dc)));
+            }
+            Integer swapYears[] = { 2, 3, 4, 5, 7, 10, 12, 15, 20, 30 };
+            for (Size i=0; i<LENGTH(swapYears); ++i) {
+                shared_ptr<SimpleQuote> q(new SimpleQuote(0.015+0.001*i));
+                quotes_.push_back(q);
+                helpers.push_back(shared_ptr<RateHelper>(
+                    new SwapRateHelper(Handle<Quote>(q),
+                                       swapYears[i]*Years, calendar,
+                                       Annual, Unadjusted,
+                                       Thirty360(Thirty360::European),
+                                       euribor6m)));
+            }
+            curve_ = shared_ptr<YieldTermStructure>(
+                new PiecewiseYieldCurve<Discount,LogLinear>(today, helpers,
+                                                            dc));
+            bump_ = 0.0001;
+        }
+        std::string name() const { return "PiecewiseYieldCurve"; }
+        void run() {
+            // moving a quote back and forth triggers a full bootstrap
+            quotes_[0]->setValue(quotes_[0]->value() + bump_);
+            bump_ = -bump_;
+            sink = sink + curve_->discount(30.0);
+        }
+      private:
+        std::vector<shared_ptr<SimpleQuote> > quotes_;
+        shared_ptr<YieldTermStructure> curve_;
+        Real bump_;
+    };
+
+
+    class OISBootstrapKernel : public Kernel {
+      public:
+        OISBootstrapKernel() {
+            shared_ptr<OvernightIndex> eonia(new Eonia);
+            std::vector<shared_ptr<RateHelper> > helpers;
+            for (Integer i=1; i<=60; ++i) {
+                // monthly pillars up to one year, yearly afterwards
+                Period tenor = i <= 12 ? Period(i, Months)
+                                       : Period(i-11, Years);
+                shared_ptr<SimpleQuote> q(new SimpleQuote(0.01+0.0002*i));
+                quotes_.push_back(q);
+                helpers.push_back(shared_ptr<RateHelper>(
+                    new OISRateHelper(2, tenor, Handle<Quote>(q), eonia)));
+            }
+            curve_ = shared_ptr<YieldTermStructure>(
+                new PiecewiseYieldCurve<Discount,LogLinear>(
+                                           today, helpers, Actual365Fixed()));
+            bump_ = 0.0001;
+        }
+        std::string name() const { return "PiecewiseYieldCurve/OIS"; }
+        void run() {
+            quotes_[0]->setValue(quotes_[0]->value() + bump_);
+            bump_ = -bump_;
+            sink = sink + curve_->discount(30.0);
+        }
+      private:
+        std::vector<shared_ptr<SimpleQuote> > quotes_;
+        shared_ptr<YieldTermStructure> curve_;
+        Real bump_;
+    };
+
+
+    class SwapKernel : public Kernel {
+      public:
+        SwapKernel() {
+            Handle<YieldTermStructure> curve(
+                   shared_ptr<YieldTermStructure>(
+                          new FlatForward(today, 0.02, Actual365Fixed())));
+            shared_ptr<IborIndex> euribor6m(new Euribor6M(curve));
+            swap_ = MakeVanillaSwap(10*Years, euribor6m, 0.02)
+                .withPricingEngine(shared_ptr<PricingEngine>(
+                                          new DiscountingSwapEngine(curve)));
+        }
+        std::string name() const { return "DiscountingSwapEngine"; }
+        void run() {
+            swap_->recalculate();
+            sink = sink + swap_->NPV();
+        }
+      private:
+        shared_ptr<VanillaSwap> swap_;
+    };
+
+
+    class OvernightSwapKernel : public Kernel {
+      public:
+        OvernightSwapKernel()
+        : curve_(shared_ptr<YieldTermStructure>(
+                          new FlatForward(today, 0.02, Actual365Fixed()))),
+          eonia_(new Eonia(curve_)) {
+            // a seasoned swap, so that past fixings are compounded
+            Date start(2, January, 2018);
+            for (Date d = start; d < today; ++d)
+                if (eonia_->isValidFixingDate(d))
+                    eonia_->addFixing(d, 0.01, true);
+        }
+        std::string name() const { return "MakeOIS/30Y"; }
+        void run() {
+            // built at each run, as in the helpers of a bootstrap
+            shared_ptr<OvernightIndexedSwap> swap =
+                MakeOIS(30*Years, eonia_, 0.02)
+                .withEffectiveDate(Date(2, January, 2018))
+                .withDiscountingTermStructure(curve_);
+            sink = sink + swap->NPV();
+        }
+      private:
+        Handle<YieldTermStructure> curve_;
+        shared_ptr<OvernightIndex> eonia_;
+    };
+
+
+    class CalendarKernel : public Kernel {
+      public:
+        std::string name() const { return "Calendar::advance"; }
+        void run() {
+            Calendar calendar = TARGET();
+            BigInteger sum = 0;
+            for (Integer i=0; i<1000; ++i) {
+                Date d = today + i;
+                sum += calendar.advance(d, 2, Days).serialNumber();
+                sum += calendar.advance(d, 3, Months, ModifiedFollowing,
+                                        true).serialNumber();
+            }
+            sink = sink + Real(sum);
+        }
+    };
+
+
+    class DateKernel : public Kernel {
+      public:
+        DateKernel() : dates_(10000) {
+            for (Size i=0; i<dates_.size(); ++i)
+                dates_[i] = today + Integer(i);
+        }
+        std::string name() const { return "Date decomposition"; }
+        void run() {
+            BigInteger sum = 0;
+            for (Size i=0; i<dates_.size(); i+=10) {
+                const Date& d = dates_[i];
+                sum += d.dayOfMonth() + d.month() + d.year();
+                sum += (d + 3*Months).serialNumber();
+            }
+            Date::dayMonthYear(dates_, days_, months_, years_);
+            sum += days_.back() + months_.back() + years_.back();
+            sum += Date::fromDayMonthYear(days_, months_, years_)
+                   .back().serialNumber();
+            sink = sink + Real(sum);
+        }
+      private:
+        std::vector<Date> dates_;
+        std::vector<Day> days_;
+        std::vector<Month> months_;
+        std::vector<Year> years_;
+    };
+
+
+    class SobolNormalKernel : public Kernel {
+      public:
+        SobolNormalKernel()
+        : rsg_(SobolRsg(dimension, 42)) {}
+        std::string name() const { return "Sobol+InverseCumulativeNormal"; }
+        void run() {
+            Real sum = 0.0;
+            for (Size i=0; i<100; ++i)
+                sum += rsg_.nextSequence().value[dimension-1];
+            sink = sink + sum;
+        }
+      private:
+        static const Size dimension = 100;
+        InverseCumulativeRsg<SobolRsg, InverseCumulativeNormal> rsg_;
+    };
+
+
+    // throughput of the random-number generators, drawing the same
+    // numbers one at a time or in blocks
+    class MersenneTwisterKernel : public Kernel {
+      public:
+        explicit MersenneTwisterKernel(bool block)
+        : rng_(42), block_(block), values_(size) {}
+        std::string name() const {
+            return block_ ? "MersenneTwister (block)" : "MersenneTwister";
+        }
+        void run() {
+            if (block_) {
+                rng_.nextReals(size, &values_[0]);
+            } else {
+                for (Size i=0; i<size; ++i)
+                    values_[i] = rng_.nextReal();
+            }
+            sink = sink + values_[size-1];
+        }
+      private:
+        static const Size size = 10000;
+        MersenneTwisterUniformRng rng_;
+        bool block_;
+        std::vector<Real> values_;
+    };
+
+
+    class ZigguratKernel : public Kernel {
+      public:
+        explicit ZigguratKernel(bool block)
+        : rng_(42), block_(block), values_(size) {}
+        std::string name() const {
+            return block_ ? "Ziggurat (block)" : "Ziggurat";
+        }
+        void run() {
+            if (block_) {
+                rng_.nextReals(size, &values_[0]);
+            } else {
+                for (Size i=0; i<size; ++i)
+                    values_[i] = rng_.next().value;
+            }
+            sink = sink + values_[size-1];
+        }
+      private:
+        static const Size size = 10000;
+        ZigguratRng rng_;
+        bool block_;
+        std::vector<Real> values_;
+    };
+
+
+    class ClaytonCopulaKernel : public Kernel {
+      public:
+        explicit ClaytonCopulaKernel(bool block)
+        : rng_(MersenneTwisterUniformRng(42), 2.0), block_(block),
+          u1_(size), u2_(size) {}
+        std::string name() const {
+            return block_ ? "ClaytonCopula (block)" : "ClaytonCopula";
+        }
+        void run() {
+            if (block_) {
+                rng_.nextReals(size, &u1_[0], &u2_[0]);
+            } else {
+                for (Size i=0; i<size; ++i) {
+                    std::vector<Real> u = rng_.next().value;
+                    u1_[i] = u[0];
+                    u2_[i] = u[1];
+                }
+            }
+            sink = sink + u2_[size-1];
+        }
+      private:
+        static const Size size = 10000;
+        ClaytonCopulaRng<MersenneTwisterUniformRng> rng_;
+        bool block_;
+        std::vector<Real> u1_, u2_;
+    };
+
+
+    class FdHestonAmericanKernel : public Kernel {
+      public:
+        FdHestonAmericanKernel() {
+            Handle<Quote> s0(shared_ptr<Quote>(new SimpleQuote(100.0)));
+            Handle<YieldTermStructure> rTS(shared_ptr<YieldTermStructure>(
+                           new FlatForward(today, 0.05, Actual365Fixed())));
+            Handle<YieldTermStructure> qTS(shared_ptr<YieldTermStructure>(
+                           new FlatForward(today, 0.0, Actual365Fixed())));
+            shared_ptr<HestonProcess> process(
+                new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+            shared_ptr<Exercise> exercise(
+                                   new AmericanExercise(today + 1*Years));
+            shared_ptr<StrikedTypePayoff> payoff(
+                                   new PlainVanillaPayoff(Option::Put, 100));
+            option_ = shared_ptr<VanillaOption>(
+                                       new VanillaOption(payoff, exercise));
+            option_->setPricingEngine(shared_ptr<PricingEngine>(
+                new FdHestonVanillaEngine(
+                    shared_ptr<HestonModel>(new HestonModel(process)),
+                    50, 100, 25)));
+        }
+        std::string name() const { return "FdHestonVanillaEngine/American"; }
+        void run() {
+            option_->recalculate();
+            sink = sink + option_->NPV();
+        }
+      private:
+        shared_ptr<VanillaOption> option_;
+    };
+
+
+    class LmmBermudanKernel : public Kernel {
+      public:
+        LmmBermudanKernel() {
+            Size numberRates = 20;
+            Real accrual = 0.5, firstTime = 0.5;
+            std::vector<Time> rateTimes(numberRates+1);
+            for (Size i=0; i<rateTimes.size(); ++i)
+                rateTimes[i] = firstTime + i*accrual;
+            std::vector<Time> paymentTimes(numberRates);
+            std::vector<Real> accruals(numberRates, accrual);
+            for (Size i=0; i<paymentTimes.size(); ++i)
+                paymentTimes[i] = firstTime + (i+1)*accrual;
+
+            Rate fixedRate = 0.05;
+            MultiStepSwap payerSwap(rateTimes, accruals, accruals,
+                                    paymentTimes, fixedRate, true);
+
+            // exercise on every rate time but the last when the swap
+            // rate is above the fixed rate
+            std::vector<Time> exerciseTimes(rateTimes);
+            exerciseTimes.pop_back();
+            std::vector<Rate> triggers(exerciseTimes.size(), fixedRate);
+            SwapRateTrigger strategy(rateTimes, triggers, exerciseTimes);
+
+            CallSpecifiedMultiProduct bermudan(
+                MultiStepNothing(EvolutionDescription(rateTimes)),
+                strategy, payerSwap);
+            EvolutionDescription evolution = bermudan.evolution();
+
+            Real volLevel = 0.11, beta = 0.2, gamma = 1.0;
+            std::vector<Rate> initialRates(numberRates, 0.05);
+            std::vector<Volatility> volatilities(numberRates, volLevel);
+            std::vector<Spread> displacements(numberRates, 0.02);
+            shared_ptr<PiecewiseConstantCorrelation> correlations(
+                new ExponentialForwardCorrelation(rateTimes, volLevel,
+                                                  beta, gamma));
+            shared_ptr<MarketModel> model(
+                new FlatVol(volatilities, correlations, evolution, 5,
+                            initialRates, displacements));
+
+            SobolBrownianGeneratorFactory factory(
+                                   SobolBrownianGenerator::Diagonal, 12332);
+            std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+            shared_ptr<MarketModelEvolver> evolver(
+                        new LogNormalFwdRatePc(model, factory, numeraires));
+
+            engine_ = shared_ptr<AccountingEngine>(
+                new AccountingEngine(
+                        evolver, Clone<MarketModelMultiProduct>(bermudan),
+                        0.95));
+        }
+        std::string name() const { return "AccountingEngine/LMM Bermudan"; }
+        void run() {
+            SequenceStatisticsInc stats;
+            engine_->multiplePathValues(stats, 1024);
+            sink = sink + stats.mean()[0];
+        }
+      private:
+        shared_ptr<AccountingEngine> engine_;
+    };
+
+
+    class SwaptionVolCubeKernel : public Kernel {
+      public:
+        SwaptionVolCubeKernel() {
+            SwaptionMarketConventions conventions;
+            conventions.setConventions();
+            atm_.setMarketData();
+            cubeData_.setMarketData();
+
+            Handle<SwaptionVolatilityStructure> atmVolMatrix(
+                shared_ptr<SwaptionVolatilityStructure>(
+                    new SwaptionVolatilityMatrix(conventions.calendar,
+                                                 conventions.optionBdc,
+                                                 atm_.tenors.options,
+                                                 atm_.tenors.swaps,
+                                                 atm_.volsHandle,
+                                                 conventions.dayCounter)));
+            Handle<YieldTermStructure> curve(shared_ptr<YieldTermStructure>(
+                            new FlatForward(0, conventions.calendar, 0.05,
+                                            Actual365Fixed())));
+            shared_ptr<SwapIndex> swapIndexBase(
+                                   new EuriborSwapIsdaFixA(2*Years, curve));
+            shared_ptr<SwapIndex> shortSwapIndexBase(
+                                   new EuriborSwapIsdaFixA(1*Years, curve));
+
+            Size n = cubeData_.tenors.options.size()*cubeData_.tenors.swaps.size();
+            std::vector<std::vector<Handle<Quote> > > guess(n);
+            for (Size i=0; i<n; ++i) {
+                Real values[] = { 0.2, 0.5, 0.4, 0.0 };
+                for (Size j=0; j<LENGTH(values); ++j)
+                    guess[i].push_back(Handle<Quote>(
+                             shared_ptr<Quote>(new SimpleQuote(values[j]))));
+            }
+            cube_ = shared_ptr<SwaptionVolCube1>(
+                new SwaptionVolCube1(atmVolMatrix,
+                                     cubeData_.tenors.options,
+                                     cubeData_.tenors.swaps,
+                                     cubeData_.strikeSpreads,
+                                     cubeData_.volSpreadsHandle,
+                                     swapIndexBase, shortSwapIndexBase,
+                                     false, guess,
+                                     std::vector<bool>(4, false), true));
+            spread_ = boost::dynamic_pointer_cast<SimpleQuote>(
+                             cubeData_.volSpreadsHandle[0][0].currentLink());
+            bump_ = 0.0001;
+        }
+        std::string name() const { return "SwaptionVolCube1"; }
+        void run() {
+            // a change of smile quote triggers a full rebuild
+            spread_->setValue(spread_->value() + bump_);
+            bump_ = -bump_;
+            sink = sink + cube_->volatility(5*Years, 10*Years, 0.04, true);
+        }
+      private:
+        AtmVolatility atm_;
+        VolatilityCube cubeData_;
+        shared_ptr<SwaptionVolCube1> cube_;
+        shared_ptr<SimpleQuote> spread_;
+        Real bump_;
+    };
+
+
+    class IsdaCdsKernel : public Kernel {
+      public:
+        IsdaCdsKernel() {
+            Handle<YieldTermStructure> discountCurve(
+                shared_ptr<YieldTermStructure>(
+                          new FlatForward(today, 0.02, Actual365Fixed())));
+            Handle<DefaultProbabilityTermStructure> probabilityCurve(
+                shared_ptr<DefaultProbabilityTermStructure>(
+                       new FlatHazardRate(today, 0.015, Actual365Fixed())));
+            cds_ = MakeCreditDefaultSwap(5*Years, 0.01)
+                .withNominal(10000000.0)
+                .withPricingEngine(shared_ptr<PricingEngine>(
+                    new IsdaCdsEngine(probabilityCurve, 0.4,
+                                      discountCurve)));
+        }
+        std::string name() const { return "IsdaCdsEngine"; }
+        void run() {
+            cds_->recalculate();
+            sink = sink + cds_->NPV();
+        }
+      private:
+        shared_ptr<CreditDefaultSwap> cds_;
+    };
+
+
+    // a chain of American options on the same underlying
+    class AmericanChainKernel : public Kernel {
+      public:
+        AmericanChainKernel() {
+            Handle<Quote> s0(shared_ptr<Quote>(new SimpleQuote(100.0)));
+            Handle<YieldTermStructure> rTS(shared_ptr<YieldTermStructure>(
+                           new FlatForward(today, 0.05, Actual365Fixed())));
+            Handle<YieldTermStructure> qTS(shared_ptr<YieldTermStructure>(
+                           new FlatForward(today, 0.02, Actual365Fixed())));
+            Handle<BlackVolTermStructure> volTS(
+                shared_ptr<BlackVolTermStructure>(
+                    new BlackConstantVol(today, TARGET(), 0.25,
+                                         Actual365Fixed())));
+            process_ = shared_ptr<GeneralizedBlackScholesProcess>(
+                   new BlackScholesMertonProcess(s0, qTS, rTS, volTS));
+
+            Option::Type types[] = { Option::Put, Option::Call };
+            for (Size i=1; i<=8; ++i) {
+                shared_ptr<Exercise> exercise(
+                             new AmericanExercise(today, today + i*3*Months));
+                for (Size j=0; j<25; ++j) {
+                    for (Size k=0; k<LENGTH(types); ++k) {
+                        shared_ptr<StrikedTypePayoff> payoff(
+                            new PlainVanillaPayoff(types[k], 70.0 + 2.5*j));
+                        options_.push_back(shared_ptr<VanillaOption>(
+                                       new VanillaOption(payoff, exercise)));
+                    }
+                }
+            }
+        }
+      protected:
+        shared_ptr<GeneralizedBlackScholesProcess> process_;
+        std::vector<shared_ptr<VanillaOption> > options_;
+    };
+
+    class BaroneAdesiWhaleyChainKernel : public AmericanChainKernel {
+      public:
+        BaroneAdesiWhaleyChainKernel() {
+            shared_ptr<PricingEngine> engine(
+                   new BaroneAdesiWhaleyApproximationEngine(process_));
+            for (Size i=0; i<options_.size(); ++i)
+                options_[i]->setPricingEngine(engine);
+        }
+        std::string name() const {
+            return "BaroneAdesiWhaleyApproximationEngine/chain";
+        }
+        void run() {
+            Real sum = 0.0;
+            for (Size i=0; i<options_.size(); ++i) {
+                options_[i]->recalculate();
+                sum += options_[i]->NPV();
+            }
+            sink = sink + sum;
+        }
+    };
+
+    class AmericanApproximationBatchKernel : public AmericanChainKernel {
+      public:
+        AmericanApproximationBatchKernel()
+        : pricer_(process_,
+                  AmericanApproximationBatchPricer::BaroneAdesiWhaley) {}
+        std::string name() const {
+            return "AmericanApproximationBatchPricer/chain";
+        }
+        void run() {
+            std::vector<Real> values = pricer_.NPVs(options_);
+            Real sum = 0.0;
+            for (Size i=0; i<values.size(); ++i)
+                sum += values[i];
+            sink = sink + sum;
+        }
+      private:
+        AmericanApproximationBatchPricer pricer_;
+    };
+
+
+    // implied volatilities of a chain of American options
+    class AmericanImpliedVolKernel : public Kernel {
+      public:
+        AmericanImpliedVolKernel() {
+            Handle<Quote> s0(shared_ptr<Quote>(new SimpleQuote(100.0)));
+            Handle<YieldTermStructure> rTS(shared_ptr<YieldTermStructure>(
+                           new FlatForward(today, 0.05, Actual365Fixed())));
+            Handle<YieldTermStructure> qTS(shared_ptr<YieldTermStructure>(
+                           new FlatForward(today, 0.02, Actual365Fixed())));
+            Handle<BlackVolTermStructure> volTS(
+                shared_ptr<BlackVolTermStructure>(
+                    new BlackConstantVol(today, TARGET(), 0.25,
+                                         Actual365Fixed())));
+            process_ = shared_ptr<GeneralizedBlackScholesProcess>(
+                   new BlackScholesMertonProcess(s0, qTS, rTS, volTS));
+
+            shared_ptr<PricingEngine> engine(
+                           new FDAmericanEngine<CrankNicolson>(process_));
+            shared_ptr<Exercise> exercise(
+                             new AmericanExercise(today, today + 6*Months));
+            for (Size j=0; j<10; ++j) {
+                shared_ptr<StrikedTypePayoff> payoff(
+                         new PlainVanillaPayoff(Option::Put, 80.0 + 4.0*j));
+                shared_ptr<VanillaOption> option(
+                                        new VanillaOption(payoff, exercise));
+                option->setPricingEngine(engine);
+                options_.push_back(option);
+                prices_.push_back(option->NPV());
+            }
+        }
+      protected:
+        shared_ptr<GeneralizedBlackScholesProcess> process_;
+        std::vector<shared_ptr<VanillaOption> > options_;
+        std::vector<Real> prices_;
+    };
+
+    class ImpliedVolatilityKernel : public AmericanImpliedVolKernel {
+      public:
+        std::string name() const {
+            return "VanillaOption::impliedVolatility/American";
+        }
+        void run() {
+            Real sum = 0.0;
+            for (Size i=0; i<options_.size(); ++i)
+                sum += options_[i]->impliedVolatility(prices_[i], process_);
+            sink = sink + sum;
+        }
+    };
+
+    class ImpliedVolatilitySolverKernel : public AmericanImpliedVolKernel {
+      public:
+        ImpliedVolatilitySolverKernel() : solver_(process_) {}
+        std::string name() const {
+            return "VanillaImpliedVolatilitySolver/American";
+        }
+        void run() {
+            // each run starts cold, as for a new chain
+            solver_.reset();
+            std::vector<Volatility> vols =
+                solver_.impliedVolatilities(options_, prices_);
+            Real sum = 0.0;
+            for (Size i=0; i<vols.size(); ++i)
+                sum += vols[i];
+            sink = sink + sum;
+        }
+      private:
+        VanillaImpliedVolatilitySolver solver_;
+    };
+
+
+    struct Result {
+        std::string name;
+        Size iterations, repetitions;
+        // time per iteration, in microseconds
+        Real mean, standardDeviation, min, median, max;
+    };
+
+    typedef boost::chrono::steady_clock Clock;
+
+    Real elapsed(Kernel& kernel, Size iterations) {
+        Clock::time_point start = Clock::now();
+        for (Size i=0; i<iterations; ++i)
+            kernel.run();
+        boost::chrono::duration<Real> d = Clock::now() - start;
+        return d.count();
+    }
+
+    Result measure(Kernel& kernel, Size warmup, Size repetitions,
+                   Real minTime) {
+        // warm-up: caches are filled and the number of iterations
+        // is increased until a repetition lasts long enough
+        Size iterations = 1;
+        for (Size i=0; i<std::max<Size>(warmup,1); ++i) {
+            Real t = elapsed(kernel, iterations);
+            while (t < minTime) {
+                Real factor = t > 0.0 ? 1.2*minTime/t : 10.0;
+                iterations = std::max<Size>(
+                    iterations+1,
+                    Size(iterations*std::min<Real>(factor, 10.0)));
+                t = elapsed(kernel, iterations);
+            }
+        }
+
+        GeneralStatistics stats;
+        for (Size i=0; i<repetitions; ++i)
+            stats.add(1.0e6*elapsed(kernel, iterations)/iterations);
+
+        Result result;
+        result.name = kernel.name();
+        result.iterations = iterations;
+        result.repetitions = repetitions;
+        result.mean = stats.mean();
+        result.standardDeviation =
+            repetitions > 1 ? stats.standardDeviation() : 0.0;
+        result.min = stats.min();
+        result.median = stats.percentile(0.5);
+        result.max = stats.max();
+        return result;
+    }
+
+    std::string escaped(const std::string& s) {
+        std::string result;
+        for (Size i=0; i<s.size(); ++i) {
+            if (s[i] == '"' || s[i] == '\\')
+                result += '\\';
+            result += s[i];
+        }
+        return result;
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Result>& results) {
+        out << "{\n"
+            << "  \"context\": {\n"
+            << "    \"library\": \"QuantLib\",\n"
+            << "    \"library_version\": \"" << QL_VERSION << "\",\n"
+            << "    \"library_build_type\": \""
+            #ifdef QL_DEBUG
+            << "debug"
+            #else
+            << "release"
+            #endif
+            << "\"\n"
+            << "  },\n"
+            << "  \"benchmarks\": [";
+        const char* aggregates[] = { "mean", "stddev", "min",
+                                     "median", "max" };
+        bool first = true;
+        out << std::setprecision(10);
+        for (Size i=0; i<results.size(); ++i) {
+            const Result& r = results[i];
+            Real values[] = { r.mean, r.standardDeviation, r.min,
+                              r.median, r.max };
+            for (Size j=0; j<LENGTH(values); ++j) {
+                out << (first ? "\n" : ",\n");
+                first = false;
+                out << "    {\n"
+                    << "      \"name\": \"" << escaped(r.name) << "_"
+                    << aggregates[j] << "\",\n"
+                    << "      \"run_name\": \"" << escaped(r.name)
+                    << "\",\n"
+                    << "      \"run_type\": \"aggregate\",\n"
+                    << "      \"aggregate_name\": \"" << aggregates[j]
+                    << "\",\n"
+                    << "      \"repetitions\": " << r.repetitions << ",\n"
+                    << "      \"iterations\": " << r.iterations << ",\n"
+                    << "      \"real_time\": " << values[j] << ",\n"
+                    << "      \"cpu_time\": " << values[j] << ",\n"
+                    << "      \"time_unit\": \"us\"\n"
+                    << "    }";
+            }
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    bool hasOption(const std::string& arg, const std::string& option,
+                   std::string& value) {
+        std::string prefix = "--" + option + "=";
+        if (arg.compare(0, prefix.size(), prefix) != 0)
+            return false;
+        value = arg.substr(prefix.size());
+        return true;
+    }
+
+}
+
+
+int main(int argc, char* argv[]) {
+
+    std::string filter, jsonFile, value;
+    Size repetitions = 10, warmup = 2;
+    Real minTime = 0.1;
+    bool listOnly = false;
+
+    try {
+        for (int i=1; i<argc; ++i) {
+            std::string arg(argv[i]);
+            if (hasOption(arg, "filter", value))
+                filter = value;
+            else if (hasOption(arg, "repetitions", value))
+                repetitions = io::to_integer(value);
+            else if (hasOption(arg, "warmup", value))
+                warmup = io::to_integer(value);
+            else if (hasOption(arg, "min-time", value))
+                minTime = std::atof(value.c_str());
+            else if (hasOption(arg, "json", value))
+                jsonFile = value;
+            else if (arg == "--list")
+                listOnly = true;
+            else
+                QL_FAIL("unknown option: " << arg);
+        }
+        QL_REQUIRE(repetitions > 0, "at least one repetition required");
+        QL_REQUIRE(minTime > 0.0, "positive minimum time required");
+
+        Settings::instance().evaluationDate() = today;
+
+        std::vector<shared_ptr<Kernel> > kernels;
+        kernels.push_back(shared_ptr<Kernel>(new BlackFormulaKernel));
+        kernels.push_back(shared_ptr<Kernel>(new CurveBootstrapKernel));
+        kernels.push_back(shared_ptr<Kernel>(new OISBootstrapKernel));
+        kernels.push_back(shared_ptr<Kernel>(new SwapKernel));
+        kernels.push_back(shared_ptr<Kernel>(new OvernightSwapKernel));
+        kernels.push_back(shared_ptr<Kernel>(new CalendarKernel));
+        kernels.push_back(shared_ptr<Kernel>(new DateKernel));
+        kernels.push_back(shared_ptr<Kernel>(new SobolNormalKernel));
+        kernels.push_back(shared_ptr<Kernel>(new MersenneTwisterKernel(false)));
+        kernels.push_back(shared_ptr<Kernel>(new MersenneTwisterKernel(true)));
+        kernels.push_back(shared_ptr<Kernel>(new ZigguratKernel(false)));
+        kernels.push_back(shared_ptr<Kernel>(new ZigguratKernel(true)));
+        kernels.push_back(shared_ptr<Kernel>(new ClaytonCopulaKernel(false)));
+        kernels.push_back(shared_ptr<Kernel>(new ClaytonCopulaKernel(true)));
+        kernels.push_back(shared_ptr<Kernel>(new FdHestonAmericanKernel));
+        kernels.push_back(
+                   shared_ptr<Kernel>(new BaroneAdesiWhaleyChainKernel));
+        kernels.push_back(
+                   shared_ptr<Kernel>(new AmericanApproximationBatchKernel));
+        kernels.push_back(shared_ptr<Kernel>(new ImpliedVolatilityKernel));
+        kernels.push_back(
+                      shared_ptr<Kernel>(new ImpliedVolatilitySolverKernel));
+        kernels.push_back(shared_ptr<Kernel>(new LmmBermudanKernel));
+        kernels.push_back(shared_ptr<Kernel>(new SwaptionVolCubeKernel));
+        kernels.push_back(shared_ptr<Kernel>(new IsdaCdsKernel));
+
+        std::vector<Result> results;
+        for (Size i=0; i<kernels.size(); ++i) {
+            if (kernels[i]->name().find(filter) == std::string::npos)
+                continue;
+            if (listOnly) {
+                std::cout << kernels[i]->name() << std::endl;
+                continue;
+            }
+            Result r = measure(*kernels[i], warmup, repetitions, minTime);
+            results.push_back(r);
+            std::cout << std::left << std::setw(34) << r.name
+                      << std::right << std::fixed << std::setprecision(3)
+                      << " mean " << std::setw(12) << r.mean << " us"
+                      << "  sd " << std::setw(10) << r.standardDeviation
+                      << "  min " << std::setw(12) << r.min
+                      << "  median " << std::setw(12) << r.median
+                      << "  max " << std::setw(12) << r.max
+                      << "  (" << r.repetitions << " x "
+                      << r.iterations << " iterations)" << std::endl;
+        }
+
+        if (!jsonFile.empty() && !listOnly) {
+            std::ofstream out(jsonFile.c_str());
+            QL_REQUIRE(out, "unable to open " << jsonFile);
+            writeJson(out, results);
+        }
+        return 0;
+    } catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    } catch (...) {
+        std::cerr << "unknown error" << std::endl;
+        return 1;
+    }
+}
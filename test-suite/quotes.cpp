@@ -24,11 +24,13 @@
 #include <ql/quotes/compositequote.hpp>
 #include <ql/quotes/forwardvaluequote.hpp>
 #include <ql/quotes/impliedstddevquote.hpp>
+#include <ql/quotes/quoteblock.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <sstream>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -43,6 +45,13 @@ namespace {
     Real mul(Real x, Real y) { return x*y; }
     Real sub(Real x, Real y) { return x-y; }
 
+    class Counter : public Observer {
+      public:
+        Counter() : count(0) {}
+        void update() { ++count; }
+        Size count;
+    };
+
 }
 
 
@@ -195,6 +204,66 @@ void QuoteTest::testForwardValueQuoteAndImpliedStdevQuote(){
 
 }
 
+void QuoteTest::testQuoteBlock() {
+
+    BOOST_TEST_MESSAGE("Testing quote blocks...");
+
+    boost::shared_ptr<QuoteBlock> block(new QuoteBlock(4));
+    Handle<Quote> h1(boost::shared_ptr<Quote>(
+                                         new QuoteBlockElement(block, 1)));
+    Handle<Quote> h3(boost::shared_ptr<Quote>(
+                                         new QuoteBlockElement(block, 3)));
+    Counter c1, c3;
+    c1.registerWith(h1);
+    c3.registerWith(h3);
+
+    if (h1->isValid())
+        BOOST_ERROR("quote with null value is valid");
+
+    std::istringstream csv("name,bid,ask\r\n"
+                           "a,0.010,0.011\r\n"
+                           "b,0.020,0.021\r\n"
+                           "c,,\r\n"
+                           "d,0.040, 0.041 \r\n");
+    loadQuoteBlock(*block, csv, "ask");
+    if (c1.count != 1 || c3.count != 1)
+        BOOST_ERROR("observers notified " << c1.count << " and "
+                    << c3.count << " times instead of once");
+    if (h1->value() != 0.021 || h3->value() != 0.041 || block->isValid(2))
+        BOOST_ERROR("wrong values loaded:"
+                    << "\n    quote #1: " << h1->value()
+                    << "\n    quote #3: " << h3->value());
+
+    // unchanged values don't notify
+    block->setValues(block->values());
+    if (c1.count != 1)
+        BOOST_ERROR("observer notified when no value changed");
+    block->setValue(0, 0.5);
+    if (c1.count != 2)
+        BOOST_ERROR("observer not notified of value change");
+
+    std::stringstream binary(std::ios::in | std::ios::out |
+                             std::ios::binary);
+    saveQuoteBlock(*block, binary);
+    QuoteBlock copy(4, 0.0);
+    loadQuoteBlock(copy, binary);
+    for (Size i=0; i<4; ++i) {
+        if (copy.value(i) != block->value(i))
+            BOOST_ERROR("failed to reload value #" << i << ":"
+                        << "\n    expected: " << block->value(i)
+                        << "\n    reloaded: " << copy.value(i));
+    }
+
+    std::istringstream shortCsv("ask\n0.1\n0.2\n");
+    BOOST_CHECK_THROW(loadQuoteBlock(*block, shortCsv, "ask"), Error);
+    std::istringstream badCsv("ask\n0.1\nfoo\n0.3\n0.4\n");
+    BOOST_CHECK_THROW(loadQuoteBlock(*block, badCsv, "ask"), Error);
+    std::istringstream missingColumn("bid\n0.1\n0.2\n0.3\n0.4\n");
+    BOOST_CHECK_THROW(loadQuoteBlock(*block, missingColumn, "ask"), Error);
+    if (c1.count != 2)
+        BOOST_ERROR("observer notified by failed load");
+}
+
 
 test_suite* QuoteTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Quote tests");
@@ -204,6 +273,7 @@ test_suite* QuoteTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testComposite));
     suite->add(QUANTLIB_TEST_CASE(
                       &QuoteTest::testForwardValueQuoteAndImpliedStdevQuote));
+    suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testQuoteBlock));
     return suite;
 }
 
@@ -32,6 +32,7 @@ class QuoteTest {
     static void testDerived();
     static void testComposite();
     static void testForwardValueQuoteAndImpliedStdevQuote();
+    static void testQuoteBlock();
     static boost::unit_test_framework::test_suite* suite();
 };
 
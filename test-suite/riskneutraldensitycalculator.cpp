@@ -738,6 +738,69 @@ void RiskNeutralDensityCalculatorTest::testBlackScholesWithSkew() {
     }
 }
 
+void RiskNeutralDensityCalculatorTest::testBatchInverseCDF() {
+    BOOST_TEST_MESSAGE("Testing batched inverse cumulative distributions...");
+
+    SavedSettings backup;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Date todaysDate = Settings::instance().evaluationDate();
+
+    const Handle<Quote> spot(
+        boost::shared_ptr<SimpleQuote>(new SimpleQuote(100.0)));
+    const Handle<YieldTermStructure> rTS(
+        flatRate(todaysDate, 0.05, dayCounter));
+    const Handle<YieldTermStructure> qTS(
+        flatRate(todaysDate, 0.02, dayCounter));
+
+    const HestonRNDCalculator heston(
+        boost::make_shared<HestonProcess>(
+            rTS, qTS, spot, 0.04, 1.5, 0.06, 0.6, -0.7), 1e-8);
+
+    const BSMRNDCalculator bsm(
+        boost::make_shared<BlackScholesMertonProcess>(
+            spot, qTS, rTS,
+            Handle<BlackVolTermStructure>(flatVol(0.25, dayCounter))));
+
+    Array probs(41);
+    probs[0] = 1e-4;
+    probs[probs.size()-1] = 1.0-1e-4;
+    for (Size i=1; i < probs.size()-1; ++i)
+        probs[i] = 0.025*i;
+
+    const Time times[] = { 0.25, 1.0, 3.0 };
+    for (Size i=0; i < LENGTH(times); ++i) {
+        const Time t = times[i];
+
+        const Array hestonX = heston.invcdf(probs, t);
+        const Array bsmX = bsm.invcdf(probs, t);
+
+        for (Size j=0; j < probs.size(); ++j) {
+            const Real expected = heston.invcdf(probs[j], t);
+
+            const Real tol = 1e-6;
+            if (std::fabs(hestonX[j] - expected) > tol) {
+                BOOST_FAIL("failed to reproduce the inverse cdf of the "
+                           "Heston model with the batched version"
+                        << "\n   time:       " << t
+                        << "\n   prob:       " << probs[j]
+                        << "\n   calculated: " << hestonX[j]
+                        << "\n   expected:   " << expected
+                        << "\n   diff:       " << hestonX[j] - expected
+                        << "\n   tol:        " << tol);
+            }
+
+            if (bsmX[j] != bsm.invcdf(probs[j], t)) {
+                BOOST_FAIL("failed to reproduce the inverse cdf of the "
+                           "Black-Scholes-Merton model with the batched "
+                           "version"
+                        << "\n   time:       " << t
+                        << "\n   prob:       " << probs[j]);
+            }
+        }
+    }
+}
+
 test_suite* RiskNeutralDensityCalculatorTest::experimental(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Risk neutral density calculator tests");
 
@@ -749,6 +812,8 @@ test_suite* RiskNeutralDensityCalculatorTest::experimental(SpeedLevel speed) {
         &RiskNeutralDensityCalculatorTest::testLocalVolatilityRND));
     suite->add(QUANTLIB_TEST_CASE(
         &RiskNeutralDensityCalculatorTest::testSquareRootProcessRND));
+    suite->add(QUANTLIB_TEST_CASE(
+        &RiskNeutralDensityCalculatorTest::testBatchInverseCDF));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -34,6 +34,7 @@ class RiskNeutralDensityCalculatorTest {
     static void testLocalVolatilityRND();
     static void testSquareRootProcessRND();
     static void testBlackScholesWithSkew();
+    static void testBatchInverseCDF();
     static boost::unit_test_framework::test_suite* experimental(SpeedLevel);
 };
 
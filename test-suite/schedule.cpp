@@ -20,6 +20,7 @@
 #include "schedule.hpp"
 #include "utilities.hpp"
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
@@ -360,6 +361,53 @@ void ScheduleTest::testFourWeeksTenor() {
     }
 }
 
+void ScheduleTest::testScheduleCache() {
+    BOOST_TEST_MESSAGE("Testing cached schedules...");
+
+    ScheduleCache cache;
+    Date start(17, January, 2017), end(17, January, 2027);
+    Calendar calendar = TARGET();
+
+    Schedule s1 = cache.schedule(start, end, 6*Months, calendar,
+                                 ModifiedFollowing, ModifiedFollowing,
+                                 DateGeneration::Backward, false);
+    Schedule s2 = cache.schedule(start, end, 6*Months, TARGET(),
+                                 ModifiedFollowing, ModifiedFollowing,
+                                 DateGeneration::Backward, false);
+    Schedule s3 = cache.schedule(start, end, 3*Months, calendar,
+                                 ModifiedFollowing, ModifiedFollowing,
+                                 DateGeneration::Backward, false);
+
+    if (cache.size() != 2)
+        BOOST_ERROR(cache.size() << " schedules cached, 2 expected");
+    if (&s1.dates() != &s2.dates())
+        BOOST_ERROR("dates not shared between equal cached schedules");
+    if (&s1.dates() == &s3.dates())
+        BOOST_ERROR("dates shared between different cached schedules");
+
+    Schedule copy = s1;
+    if (&copy.dates() != &s1.dates())
+        BOOST_ERROR("dates not shared between copies of a schedule");
+
+    Schedule expected(start, end, 6*Months, calendar,
+                      ModifiedFollowing, ModifiedFollowing,
+                      DateGeneration::Backward, false);
+    check_dates(s1, expected.dates());
+    if (s1.isRegular() != expected.isRegular())
+        BOOST_ERROR("regular-period flags differ from uncached schedule");
+
+    // truncating a cached schedule must leave the cached dates alone
+    Schedule truncated = s1.until(Date(1, March, 2020));
+    if (truncated.size() != 8)
+        BOOST_ERROR("truncated schedule has " << truncated.size()
+                    << " dates; 8 expected");
+    check_dates(s1, expected.dates());
+
+    cache.clear();
+    if (cache.size() != 0)
+        BOOST_ERROR("cache not emptied");
+}
+
 
 test_suite* ScheduleTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Schedule tests");
@@ -378,5 +426,6 @@ test_suite* ScheduleTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testCDS2015Convention));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testDateConstructor));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testFourWeeksTenor));
+    suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testScheduleCache));
     return suite;
 }
@@ -37,6 +37,7 @@ class ScheduleTest {
     static void testCDS2015Convention();
     static void testDateConstructor();
     static void testFourWeeksTenor();
+    static void testScheduleCache();
     static boost::unit_test_framework::test_suite* suite();
 };
 
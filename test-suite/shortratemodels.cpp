@@ -24,10 +24,13 @@
 #include "shortratemodels.hpp"
 #include "utilities.hpp"
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/models/shortrate/onefactormodels/blackkarasinski.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/processes/hullwhiteprocess.hpp>
+#include <ql/methods/montecarlo/exposureprofile.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/math/optimization/simplex.hpp>
@@ -128,6 +131,83 @@ void ShortRateModelTest::testCachedHullWhite() {
     }
 }
 
+void ShortRateModelTest::testParallelCalibration() {
+    BOOST_TEST_MESSAGE("Testing Hull-White calibration with parallel "
+                       "evaluation of the helpers...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    boost::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    boost::shared_ptr<HullWhite> serialModel(new HullWhite(termStructure));
+    boost::shared_ptr<HullWhite> parallelModel(new HullWhite(termStructure));
+    parallelModel->enableParallelCalibration();
+
+    boost::shared_ptr<PricingEngine> engine(
+                                   new JamshidianSwaptionEngine(serialModel));
+
+    std::vector<boost::shared_ptr<CalibrationHelper> > serialHelpers,
+                                                       parallelHelpers;
+    for (Size i=0; i<LENGTH(data); i++) {
+        boost::shared_ptr<Quote> vol(new SimpleQuote(data[i].volatility));
+        for (Size k=0; k<2; k++) {
+            boost::shared_ptr<CalibrationHelper> helper(
+                             new SwaptionHelper(Period(data[i].start, Years),
+                                                Period(data[i].length, Years),
+                                                Handle<Quote>(vol),
+                                                index,
+                                                Period(1, Years), Thirty360(),
+                                                Actual360(), termStructure));
+            if (k == 0) {
+                helper->setPricingEngine(engine);
+                serialHelpers.push_back(helper);
+            } else {
+                // one engine per helper
+                helper->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                new JamshidianSwaptionEngine(parallelModel)));
+                parallelHelpers.push_back(helper);
+            }
+        }
+    }
+
+    LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8);
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+
+    serialModel->calibrate(serialHelpers, optimizationMethod, endCriteria);
+    parallelModel->calibrate(parallelHelpers, optimizationMethod,
+                             endCriteria);
+
+    Real tolerance = 1.0e-12;
+    Array expected = serialModel->params();
+    Array calculated = parallelModel->params();
+    for (Size i=0; i<expected.size(); i++) {
+        if (std::fabs(calculated[i]-expected[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce serial calibration:\n"
+                        << std::setprecision(12)
+                        << "    parameter:  #" << i << "\n"
+                        << "    calculated: " << calculated[i] << "\n"
+                        << "    expected:   " << expected[i]);
+    }
+
+    // helpers sharing an engine are rejected
+    parallelModel->setParams(expected);
+    BOOST_CHECK_THROW(parallelModel->calibrate(serialHelpers,
+                                               optimizationMethod,
+                                               endCriteria),
+                      Error);
+}
+
 void ShortRateModelTest::testCachedHullWhiteFixedReversion() {
     BOOST_TEST_MESSAGE("Testing Hull-White calibration with fixed reversion against cached values...");
 
@@ -427,6 +507,259 @@ void ShortRateModelTest::testFuturesConvexityBias() {
     }
 }
 
+void ShortRateModelTest::testTreeRollback() {
+    BOOST_TEST_MESSAGE("Testing Hull-White tree rollback...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> termStructure(flatRate(today, 0.04,
+                                                      Actual365Fixed()));
+    boost::shared_ptr<HullWhite> model(
+                                  new HullWhite(termStructure, 0.1, 0.01));
+
+    TimeGrid grid(10.0, 200);
+    boost::shared_ptr<Lattice> lattice = model->tree(grid);
+
+    Real tolerance = 1.0e-12;
+
+    Size steps[] = { 1, 20, 57, 200 };
+    for (Size k=0; k<LENGTH(steps); ++k) {
+        Time maturity = grid[steps[k]];
+        DiscountFactor expected = termStructure->discount(maturity);
+        // the second rollback uses the stored discount factors
+        for (Size n=0; n<2; ++n) {
+            DiscretizedDiscountBond bond;
+            bond.initialize(lattice, maturity);
+            bond.rollback(0.0);
+            Real error = std::fabs(bond.presentValue() - expected);
+            if (error > tolerance)
+                BOOST_ERROR("failed to reproduce discount bond "
+                            "by tree rollback:"
+                            << "\n    maturity:   " << maturity
+                            << std::setprecision(12)
+                            << "\n    calculated: " << bond.presentValue()
+                            << "\n    expected:   " << expected
+                            << std::scientific
+                            << "\n    error:      " << error
+                            << "\n    tolerance:  " << tolerance);
+        }
+    }
+}
+
+void ShortRateModelTest::testTreeCache() {
+    BOOST_TEST_MESSAGE("Testing caching of fitted short-rate trees...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    RelinkableHandle<YieldTermStructure> termStructure(
+                               flatRate(today, 0.04, Actual365Fixed()));
+
+    boost::shared_ptr<ShortRateModel> models[] = {
+        boost::shared_ptr<ShortRateModel>(
+                                 new HullWhite(termStructure, 0.1, 0.01)),
+        boost::shared_ptr<ShortRateModel>(
+                           new BlackKarasinski(termStructure, 0.1, 0.1))
+    };
+    std::string names[] = { "Hull-White", "Black-Karasinski" };
+
+    TimeGrid grid(10.0, 100), otherGrid(10.0, 120);
+
+    for (Size k=0; k<LENGTH(models); ++k) {
+        boost::shared_ptr<Lattice> tree = models[k]->tree(grid);
+        if (models[k]->tree(grid) != tree)
+            BOOST_ERROR(names[k] << " tree not reused for the same grid");
+        if (models[k]->tree(TimeGrid(10.0, 100)) != tree)
+            BOOST_ERROR(names[k] << " tree not reused for an equal grid");
+        if (models[k]->tree(otherGrid) == tree)
+            BOOST_ERROR(names[k] << " tree reused for a different grid");
+
+        Array params = models[k]->params();
+        params[1] *= 1.1;
+        models[k]->setParams(params);
+        boost::shared_ptr<Lattice> newTree = models[k]->tree(grid);
+        if (newTree == tree)
+            BOOST_ERROR(names[k] << " tree reused after parameter change");
+
+        termStructure.linkTo(flatRate(today, 0.05, Actual365Fixed()));
+        tree = models[k]->tree(grid);
+        if (tree == newTree)
+            BOOST_ERROR(names[k] << " tree reused after curve change");
+
+        // the tree is fitted to the new curve
+        Real tolerance = 1.0e-6;
+        Time maturity = grid.back();
+        DiscretizedDiscountBond bond;
+        bond.initialize(tree, maturity);
+        bond.rollback(0.0);
+        DiscountFactor expected = termStructure->discount(maturity);
+        Real error = std::fabs(bond.presentValue() - expected);
+        if (error > tolerance)
+            BOOST_ERROR("failed to reproduce discount bond "
+                        "with " << names[k] << " tree:"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << bond.presentValue()
+                        << "\n    expected:   " << expected
+                        << std::scientific
+                        << "\n    error:      " << error
+                        << "\n    tolerance:  " << tolerance);
+
+        termStructure.linkTo(flatRate(today, 0.04, Actual365Fixed()));
+    }
+}
+
+void ShortRateModelTest::testScenarioCubeExposure() {
+    BOOST_TEST_MESSAGE("Testing Hull-White exposure profiles "
+                       "on a scenario cube...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> termStructure(
+                                 flatRate(today, 0.04, Actual360()));
+    Real a = 0.1, sigma = 0.01;
+    boost::shared_ptr<HullWhite> model(
+                                 new HullWhite(termStructure, a, sigma));
+    boost::shared_ptr<HullWhiteProcess> process(
+                          new HullWhiteProcess(termStructure, a, sigma));
+
+    std::vector<Time> times;
+    for (Size i=1; i<=10; ++i)
+        times.push_back(0.5*i);
+    const Size paths = 4095;
+    const BigNatural seed = 42;
+
+    ScenarioCube cube(times, paths, 1);
+    simulateScenarioCube<PseudoRandom>(cube, process, seed);
+    ScenarioCube diskCube(times, paths, 1, "scenariocube.tmp");
+    simulateScenarioCube<PseudoRandom>(diskCube, process, seed);
+    ScenarioCube singleCube(times, paths, 1, ScenarioCube::Single);
+    simulateScenarioCube<PseudoRandom>(singleCube, process, seed);
+    ScenarioCube singleDiskCube(times, paths, 1, "scenariocube32.tmp",
+                                ScenarioCube::Single);
+    simulateScenarioCube<PseudoRandom>(singleDiskCube, process, seed);
+
+    // the simulated short rates must have the right distribution
+    // and be the same in both cubes
+    for (Size d=0; d<times.size(); ++d) {
+        const Real* rates = cube.slice(d);
+        const Real* diskRates = diskCube.slice(d);
+        Real sum = 0.0;
+        for (Size p=0; p<paths; ++p) {
+            if (rates[p] != diskRates[p])
+                BOOST_FAIL("in-memory and on-disk cubes differ"
+                           << "\n    date:      " << times[d]
+                           << "\n    path:      " << p
+                           << "\n    in memory: " << rates[p]
+                           << "\n    on disk:   " << diskRates[p]);
+            sum += rates[p];
+        }
+        // single-precision cubes only differ by rounding
+        const Real* singleRates = singleCube.slice(d);
+        const Real* singleDiskRates = singleDiskCube.slice(d);
+        for (Size p=0; p<paths; ++p) {
+            if (std::fabs(singleRates[p]-rates[p])
+                                    > 1.0e-7*std::fabs(rates[p])
+                || singleDiskRates[p] != singleRates[p])
+                BOOST_FAIL("single-precision cubes differ"
+                           << std::setprecision(12)
+                           << "\n    date:             " << times[d]
+                           << "\n    path:             " << p
+                           << "\n    double precision: " << rates[p]
+                           << "\n    in memory:        " << singleRates[p]
+                           << "\n    on disk:          "
+                           << singleDiskRates[p]);
+        }
+        Real mean = sum/paths;
+        Real expected = process->expectation(0.0, process->x0(), times[d]);
+        Real error = process->stdDeviation(0.0, process->x0(), times[d])
+                   / std::sqrt(Real(paths));
+        if (std::fabs(mean-expected) > 4.0*error)
+            BOOST_ERROR("failed to reproduce expected short rate"
+                        << "\n    time:       " << times[d]
+                        << "\n    simulated:  " << mean
+                        << "\n    expected:   " << expected
+                        << "\n    tolerance:  " << 4.0*error);
+    }
+
+    // a netting set receiving and paying fixed cash flows...
+    std::vector<Time> receiveTimes(1, 3.0), payTimes(1, 5.5);
+    std::vector<Real> receiveAmounts(1, 1.0), payAmounts(1, -1.0);
+    std::vector<boost::shared_ptr<ScenarioValuation> > nettingSet;
+    nettingSet.push_back(boost::shared_ptr<ScenarioValuation>(
+         new AffineCashFlowValuation(model, receiveTimes, receiveAmounts)));
+    nettingSet.push_back(boost::shared_ptr<ScenarioValuation>(
+         new AffineCashFlowValuation(model, payTimes, payAmounts)));
+    ExposureProfile profile(cube, nettingSet);
+    ExposureProfile diskProfile(diskCube, nettingSet);
+    ExposureProfile singleProfile(singleCube, nettingSet);
+
+    // ...whose value on each path is calculated directly
+    const Real tolerance = 1.0e-12;
+    for (Size d=0; d<times.size(); ++d) {
+        Time t = times[d];
+        const Real* rates = cube.slice(d);
+        Real epe = 0.0, ene = 0.0;
+        for (Size p=0; p<paths; ++p) {
+            Real value = - model->discountBond(t, payTimes[0], rates[p]);
+            if (t < receiveTimes[0])
+                value += model->discountBond(t, receiveTimes[0], rates[p]);
+            epe += std::max(value, 0.0);
+            ene += std::min(value, 0.0);
+        }
+        epe /= paths;
+        ene /= paths;
+
+        if (std::fabs(profile.expectedPositiveExposure()[d]-epe) > tolerance
+            || std::fabs(profile.expectedNegativeExposure()[d]-ene)
+                                                                > tolerance
+            || std::fabs(profile.expectedValue()[d]-(epe+ene)) > tolerance)
+            BOOST_ERROR("failed to reproduce exposure profile"
+                        << std::setprecision(12)
+                        << "\n    time:         " << t
+                        << "\n    EPE:          "
+                        << profile.expectedPositiveExposure()[d]
+                        << "\n    expected EPE: " << epe
+                        << "\n    ENE:          "
+                        << profile.expectedNegativeExposure()[d]
+                        << "\n    expected ENE: " << ene
+                        << "\n    EV:           "
+                        << profile.expectedValue()[d]);
+
+        if (profile.expectedPositiveExposure()[d]
+                                != diskProfile.expectedPositiveExposure()[d]
+            || profile.expectedNegativeExposure()[d]
+                                != diskProfile.expectedNegativeExposure()[d])
+            BOOST_ERROR("in-memory and on-disk profiles differ"
+                        << std::setprecision(12)
+                        << "\n    time:          " << t
+                        << "\n    EPE in memory: "
+                        << profile.expectedPositiveExposure()[d]
+                        << "\n    EPE on disk:   "
+                        << diskProfile.expectedPositiveExposure()[d]);
+
+        const Real singleTolerance = 1.0e-8;
+        if (std::fabs(profile.expectedPositiveExposure()[d]
+                      - singleProfile.expectedPositiveExposure()[d])
+                                                        > singleTolerance
+            || std::fabs(profile.expectedNegativeExposure()[d]
+                         - singleProfile.expectedNegativeExposure()[d])
+                                                        > singleTolerance)
+            BOOST_ERROR("single-precision profile differs"
+                        << std::setprecision(12)
+                        << "\n    time:                 " << t
+                        << "\n    EPE:                  "
+                        << profile.expectedPositiveExposure()[d]
+                        << "\n    single-precision EPE: "
+                        << singleProfile.expectedPositiveExposure()[d]
+                        << "\n    ENE:                  "
+                        << profile.expectedNegativeExposure()[d]
+                        << "\n    single-precision ENE: "
+                        << singleProfile.expectedNegativeExposure()[d]);
+    }
+}
+
 test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Short-rate model tests");
 
@@ -434,6 +767,11 @@ test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhiteFixedReversion));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite2));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testScenarioCubeExposure));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testTreeRollback));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testTreeCache));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &ShortRateModelTest::testParallelCalibration));
 
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
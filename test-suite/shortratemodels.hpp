@@ -33,6 +33,10 @@ class ShortRateModelTest {
     static void testCachedHullWhiteFixedReversion();
     static void testCachedHullWhite2();
     static void testSwaps();
+    static void testScenarioCubeExposure();
+    static void testTreeRollback();
+    static void testTreeCache();
+    static void testParallelCalibration();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
@@ -24,6 +24,7 @@
 #include "utilities.hpp"
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/statistics/tdigeststatistics.hpp>
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
@@ -32,6 +33,7 @@
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <iomanip>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -124,6 +126,7 @@ void StatisticsTest::testStatistics() {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<TDigestRiskStatistics>(std::string("TDigestRiskStatistics"));
 }
 
 
@@ -338,9 +341,11 @@ void StatisticsTest::testIncrementalStatistics() {
     BOOST_TEST_MESSAGE("Testing incremental statistics...");
 
     // With QuantLib 1.7 IncrementalStatistics was changed to
-    // a wrapper to the boost accumulator library. This is
-    // a test of the new implementation against results from
-    // the old one.
+    // a wrapper to the boost accumulator library, and later to
+    // the accumulation of central moments. This is a test of the
+    // current implementation against cached results; the mean
+    // and the moments differ from those of the boost-based one
+    // by a few units in the 14th digit.
 
     MersenneTwisterUniformRng mt(42);
 
@@ -357,12 +362,12 @@ void StatisticsTest::testIncrementalStatistics() {
                     << ") can not be reproduced against cached result ("
                     << 500000 << ")");
     TEST_INC_STAT(stat.weightSum(), 2.5003623600676749e+05);
-    TEST_INC_STAT(stat.mean(), 4.9122325964293845e-01);
-    TEST_INC_STAT(stat.variance(),  5.0706503959683329e+05);
-    TEST_INC_STAT(stat.standardDeviation(),  7.1208499464378076e+02);
-    TEST_INC_STAT(stat.errorEstimate(), 1.0070402569876076e+00);
-    TEST_INC_STAT(stat.skewness(), -1.7360169326720038e-03);
-    TEST_INC_STAT(stat.kurtosis(), -1.1990742562085395e+00);
+    TEST_INC_STAT(stat.mean(), 4.9122325964292923e-01);
+    TEST_INC_STAT(stat.variance(),  5.0706503959682264e+05);
+    TEST_INC_STAT(stat.standardDeviation(),  7.1208499464377326e+02);
+    TEST_INC_STAT(stat.errorEstimate(), 1.0070402569875969e+00);
+    TEST_INC_STAT(stat.skewness(), -1.7360169326719806e-03);
+    TEST_INC_STAT(stat.kurtosis(), -1.1990742562084638e+00);
     TEST_INC_STAT(stat.min(), -1.2339945045639761e+03);
     TEST_INC_STAT(stat.max(),  1.2339958308008499e+03);
     TEST_INC_STAT(stat.downsideVariance(), 5.0786776146975247e+05);
@@ -389,11 +394,253 @@ void StatisticsTest::testIncrementalStatistics() {
                                  << tol);
 }
 
+void StatisticsTest::testTDigestStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing bounded-memory statistics...");
+
+    // with few samples, the centroids hold single samples and the
+    // percentiles are the same as those of the full sample set
+    Statistics full;
+    TDigestRiskStatistics digest;
+    for (Size i=0; i<LENGTH(data); i++) {
+        full.add(data[i], weights[i]);
+        digest.add(data[i], weights[i]);
+    }
+    for (Size i=1; i<=20; ++i) {
+        Real p = i/20.0;
+        if (digest.percentile(p) != full.percentile(p))
+            BOOST_ERROR("percentile " << p << " of small sample set "
+                        "not reproduced:"
+                        << "\n    calculated: " << digest.percentile(p)
+                        << "\n    expected:   " << full.percentile(p));
+    }
+
+    // with a large sample set, the results are approximated; a few
+    // accumulators are merged and compared with a single one
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+                                                                normal(mt);
+
+    Real compression = 500.0;
+    full.reset();
+    TDigestRiskStatistics single((TDigestStatistics(compression)));
+    std::vector<TDigestRiskStatistics> partial(
+                       4, TDigestRiskStatistics(TDigestStatistics(compression)));
+    for (Size i=0; i<200000; ++i) {
+        Real x = normal.next().value;
+        full.add(x);
+        single.add(x);
+        partial[i%4].add(x);
+    }
+    TDigestRiskStatistics merged = partial[0];
+    for (Size k=1; k<partial.size(); ++k)
+        merged.merge(partial[k]);
+
+    const TDigestRiskStatistics* digests[] = { &single, &merged };
+    std::string names[] = { "single", "merged" };
+    for (Size k=0; k<LENGTH(digests); ++k) {
+        const TDigestRiskStatistics& s = *digests[k];
+
+        if (s.samples() != full.samples())
+            BOOST_ERROR(names[k] << " digest: wrong number of samples"
+                        << "\n    calculated: " << s.samples()
+                        << "\n    expected:   " << full.samples());
+        if (s.centroids() > compression)
+            BOOST_ERROR(names[k] << " digest: too many centroids"
+                        << "\n    centroids:   " << s.centroids()
+                        << "\n    compression: " << compression);
+
+        Real tolerance = 1.0e-10;
+        Real moments[][2] = {
+            { s.mean(), full.mean() },
+            { s.variance(), full.variance() },
+            { s.skewness(), full.skewness() },
+            { s.kurtosis(), full.kurtosis() },
+            { s.min(), full.min() },
+            { s.max(), full.max() }
+        };
+        std::string momentNames[] = { "mean", "variance", "skewness",
+                                      "kurtosis", "minimum", "maximum" };
+        for (Size i=0; i<LENGTH(moments); ++i) {
+            if (std::fabs(moments[i][0]-moments[i][1]) > tolerance)
+                BOOST_ERROR(names[k] << " digest: wrong " << momentNames[i]
+                            << std::setprecision(12)
+                            << "\n    calculated: " << moments[i][0]
+                            << "\n    expected:   " << moments[i][1]);
+        }
+
+        tolerance = 5.0e-3;
+        Real percentiles[] = { 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99 };
+        for (Size i=0; i<LENGTH(percentiles); ++i) {
+            Real p = percentiles[i];
+            if (std::fabs(s.percentile(p)-full.percentile(p)) > tolerance)
+                BOOST_ERROR(names[k] << " digest: wrong percentile " << p
+                            << "\n    calculated: " << s.percentile(p)
+                            << "\n    expected:   " << full.percentile(p));
+        }
+
+        Real risk[][2] = {
+            { s.valueAtRisk(0.99), full.valueAtRisk(0.99) },
+            { s.expectedShortfall(0.99), full.expectedShortfall(0.99) },
+            { s.expectedShortfall(0.975), full.expectedShortfall(0.975) },
+            { s.semiVariance(), full.semiVariance() },
+            { s.shortfall(-1.0), full.shortfall(-1.0) }
+        };
+        std::string riskNames[] = { "99% value at risk",
+                                    "99% expected shortfall",
+                                    "97.5% expected shortfall",
+                                    "semivariance", "shortfall" };
+        for (Size i=0; i<LENGTH(risk); ++i) {
+            if (std::fabs(risk[i][0]-risk[i][1]) > tolerance)
+                BOOST_ERROR(names[k] << " digest: wrong " << riskNames[i]
+                            << "\n    calculated: " << risk[i][0]
+                            << "\n    expected:   " << risk[i][1]);
+        }
+    }
+}
+
+namespace {
+
+    template <class S>
+    void checkMergedSequence(const std::string& name) {
+
+        // correlated samples, added to a few partial accumulators;
+        // the number of samples is not a multiple of the batch size
+        // used for the covariance
+        MersenneTwisterUniformRng mt(42);
+        InverseCumulativeRng<MersenneTwisterUniformRng,
+                             InverseCumulativeNormal> normal(mt);
+
+        Size dimension = 3, samples = 1003;
+        std::vector<std::vector<Real> > x(samples, std::vector<Real>(3));
+        std::vector<Real> w(samples);
+        GenericSequenceStatistics<S> single;
+        std::vector<GenericSequenceStatistics<S> > partial(3);
+        for (Size k=0; k<samples; ++k) {
+            Real z0 = normal.next().value, z1 = normal.next().value,
+                 z2 = normal.next().value;
+            x[k][0] = z0;
+            x[k][1] = 0.5*z0 + z1;
+            x[k][2] = 10.0 - 2.0*z2;
+            w[k] = 0.5 + mt.nextReal();
+            single.add(x[k], w[k]);
+            partial[k%3].add(x[k], w[k]);
+        }
+        GenericSequenceStatistics<S> merged;
+        for (Size j=0; j<partial.size(); ++j)
+            merged.merge(partial[j]);
+
+        // two-pass calculation
+        Real weightSum = std::accumulate(w.begin(), w.end(), Real(0.0));
+        std::vector<Real> mean(dimension, 0.0);
+        for (Size k=0; k<samples; ++k)
+            for (Size i=0; i<dimension; ++i)
+                mean[i] += w[k]*x[k][i]/weightSum;
+        Matrix expected(dimension, dimension, 0.0);
+        for (Size k=0; k<samples; ++k)
+            for (Size i=0; i<dimension; ++i)
+                for (Size j=0; j<dimension; ++j)
+                    expected[i][j] += w[k]*(x[k][i]-mean[i])*(x[k][j]-mean[j])
+                        / weightSum * samples/(samples-1.0);
+
+        const GenericSequenceStatistics<S>* stats[] = { &single, &merged };
+        std::string names[] = { "single", "merged" };
+        Real tolerance = 1.0e-10;
+        for (Size n=0; n<LENGTH(stats); ++n) {
+            if (stats[n]->samples() != samples)
+                BOOST_ERROR("SequenceStatistics<" << name << ">, "
+                            << names[n] << ": wrong number of samples"
+                            << "\n    calculated: " << stats[n]->samples()
+                            << "\n    expected:   " << samples);
+            Matrix calculated = stats[n]->covariance();
+            for (Size i=0; i<dimension; ++i) {
+                for (Size j=0; j<dimension; ++j) {
+                    if (std::fabs(calculated[i][j]-expected[i][j])
+                                                             > tolerance)
+                        BOOST_ERROR("SequenceStatistics<" << name << ">, "
+                                    << names[n] << ": wrong covariance ("
+                                    << i << "," << j << ")"
+                                    << std::setprecision(12)
+                                    << "\n    calculated: "
+                                    << calculated[i][j]
+                                    << "\n    expected:   "
+                                    << expected[i][j]);
+                }
+            }
+        }
+    }
+
+}
+
+void StatisticsTest::testMergedStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing merged statistics...");
+
+    // partial accumulators are merged and compared with the
+    // full sample set
+    MersenneTwisterUniformRng mt(42);
+
+    Statistics full;
+    IncrementalStatistics single;
+    std::vector<IncrementalStatistics> partial(4);
+    for (Size i=0; i<100000; ++i) {
+        Real x = 2.0 * (mt.nextReal() - 0.4) * 1234.0;
+        Real w = mt.nextReal();
+        full.add(x, w);
+        single.add(x, w);
+        // partial sets of different sizes
+        partial[(i%7)%4].add(x, w);
+    }
+    IncrementalStatistics merged;
+    for (Size k=0; k<partial.size(); ++k)
+        merged.merge(partial[k]);
+
+    const IncrementalStatistics* stats[] = { &single, &merged };
+    std::string names[] = { "single", "merged" };
+    for (Size k=0; k<LENGTH(stats); ++k) {
+        const IncrementalStatistics& s = *stats[k];
+
+        if (s.samples() != full.samples())
+            BOOST_ERROR(names[k] << " statistics: wrong number of samples"
+                        << "\n    calculated: " << s.samples()
+                        << "\n    expected:   " << full.samples());
+
+        Real results[][2] = {
+            { s.weightSum(), full.weightSum() },
+            { s.mean(), full.mean() },
+            { s.variance(), full.variance() },
+            { s.skewness(), full.skewness() },
+            { s.kurtosis(), full.kurtosis() },
+            { s.min(), full.min() },
+            { s.max(), full.max() },
+            { s.downsideVariance(), full.downsideVariance() }
+        };
+        std::string resultNames[] = { "weight sum", "mean", "variance",
+                                      "skewness", "kurtosis", "minimum",
+                                      "maximum", "downside variance" };
+        Real tolerance = 1.0e-10;
+        for (Size i=0; i<LENGTH(results); ++i) {
+            Real error = std::fabs(results[i][0]-results[i][1]);
+            if (error > tolerance*std::max(1.0, std::fabs(results[i][1])))
+                BOOST_ERROR(names[k] << " statistics: wrong "
+                            << resultNames[i] << std::setprecision(12)
+                            << "\n    calculated: " << results[i][0]
+                            << "\n    expected:   " << results[i][1]);
+        }
+    }
+
+    checkMergedSequence<IncrementalStatistics>(
+                                         std::string("IncrementalStatistics"));
+    checkMergedSequence<Statistics>(std::string("Statistics"));
+}
+
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testIncrementalStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testTDigestStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testMergedStatistics));
     return suite;
 }
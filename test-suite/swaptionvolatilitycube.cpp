@@ -27,6 +27,9 @@
 #include <ql/termstructures/volatility/swaption/swaptionvolcube2.hpp>
 #include <ql/termstructures/volatility/swaption/swaptionvolcube1.hpp>
 #include <ql/termstructures/volatility/swaption/spreadedswaptionvol.hpp>
+#include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/experimental/risk/marketsnapshot.hpp>
+#include <sstream>
 #include <ql/utilities/dataformatters.hpp>
 
 using namespace QuantLib;
@@ -442,6 +445,273 @@ void SwaptionVolatilityCubeTest::testObservability() {
     Settings::instance().evaluationDate() = referenceDate;
 }
 
+void SwaptionVolatilityCubeTest::testParallelAndWarmStartCalibration() {
+    BOOST_TEST_MESSAGE("Testing parallel and warm-started "
+                       "volatility cube calibration...");
+
+    CommonVars vars;
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (Size i=0; i<vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size(); i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    SwaptionVolCube1 serialCube(vars.atmVolMatrix,
+                                vars.cube.tenors.options,
+                                vars.cube.tenors.swaps,
+                                vars.cube.strikeSpreads,
+                                vars.cube.volSpreadsHandle,
+                                vars.swapIndexBase,
+                                vars.shortSwapIndexBase,
+                                vars.vegaWeighedSmileFit,
+                                parametersGuess,
+                                isParameterFixed,
+                                true);
+    SwaptionVolCube1 parallelCube(vars.atmVolMatrix,
+                                  vars.cube.tenors.options,
+                                  vars.cube.tenors.swaps,
+                                  vars.cube.strikeSpreads,
+                                  vars.cube.volSpreadsHandle,
+                                  vars.swapIndexBase,
+                                  vars.shortSwapIndexBase,
+                                  vars.vegaWeighedSmileFit,
+                                  parametersGuess,
+                                  isParameterFixed,
+                                  true);
+    parallelCube.enableParallelCalibration();
+    parallelCube.enableWarmStart();
+
+    Rate dummyStrike = 0.03;
+    for (Size i=0; i<vars.cube.tenors.options.size(); i++) {
+        for (Size j=0; j<vars.cube.tenors.swaps.size(); j++) {
+            for (Size k=0; k<vars.cube.strikeSpreads.size(); k++) {
+                Rate strike = dummyStrike + vars.cube.strikeSpreads[k];
+                Volatility v0 =
+                    serialCube.volatility(vars.cube.tenors.options[i],
+                                          vars.cube.tenors.swaps[j],
+                                          strike, false);
+                Volatility v1 =
+                    parallelCube.volatility(vars.cube.tenors.options[i],
+                                            vars.cube.tenors.swaps[j],
+                                            strike, false);
+                if (std::fabs(v0 - v1) > 1e-14)
+                    BOOST_ERROR("parallel calibration failed to reproduce "
+                                "the serial results:"
+                                "\n option tenor = " << vars.cube.tenors.options[i] <<
+                                "\n   swap tenor = " << vars.cube.tenors.swaps[j] <<
+                                "\n       strike = " << io::rate(strike) <<
+                                "\n       serial = " << io::volatility(v0) <<
+                                "\n     parallel = " << io::volatility(v1));
+            }
+        }
+    }
+
+    // move a market quote; the warm-started cube must still
+    // reproduce the market smiles
+    Volatility bump = 0.0010;
+    vars.cube.volSpreads[4][0] += bump;
+    boost::dynamic_pointer_cast<SimpleQuote>(
+        vars.cube.volSpreadsHandle[4][0].currentLink())
+        ->setValue(vars.cube.volSpreads[4][0]);
+
+    Real tolerance = 3.0e-4;
+    vars.makeAtmVolTest(parallelCube, tolerance);
+    tolerance = 12.0e-4;
+    vars.makeVolSpreadsTest(parallelCube, tolerance);
+
+    BOOST_CHECK_THROW(
+        SwaptionVolCube1(vars.atmVolMatrix,
+                         vars.cube.tenors.options,
+                         vars.cube.tenors.swaps,
+                         vars.cube.strikeSpreads,
+                         vars.cube.volSpreadsHandle,
+                         vars.swapIndexBase,
+                         vars.shortSwapIndexBase,
+                         vars.vegaWeighedSmileFit,
+                         parametersGuess,
+                         isParameterFixed,
+                         true,
+                         boost::shared_ptr<EndCriteria>(),
+                         Null<Real>(),
+                         boost::shared_ptr<OptimizationMethod>(
+                                    new LevenbergMarquardt))
+        .enableParallelCalibration(),
+        Error);
+}
+
+void SwaptionVolatilityCubeTest::testSmileSectionCache() {
+    BOOST_TEST_MESSAGE("Testing caching of swaption volatility cube "
+                       "smile sections...");
+
+    CommonVars vars;
+
+    SwaptionVolCube2 cachedCube(vars.atmVolMatrix,
+                                vars.cube.tenors.options,
+                                vars.cube.tenors.swaps,
+                                vars.cube.strikeSpreads,
+                                vars.cube.volSpreadsHandle,
+                                vars.swapIndexBase,
+                                vars.shortSwapIndexBase,
+                                vars.vegaWeighedSmileFit);
+    SwaptionVolCube2 uncachedCube(vars.atmVolMatrix,
+                                  vars.cube.tenors.options,
+                                  vars.cube.tenors.swaps,
+                                  vars.cube.strikeSpreads,
+                                  vars.cube.volSpreadsHandle,
+                                  vars.swapIndexBase,
+                                  vars.shortSwapIndexBase,
+                                  vars.vegaWeighedSmileFit,
+                                  0);
+
+    Rate strike = 0.04;
+
+    for (Size i=0; i<vars.cube.tenors.options.size(); i++) {
+        for (Size j=0; j<vars.cube.tenors.swaps.size(); j++) {
+            const Period& optionTenor = vars.cube.tenors.options[i];
+            const Period& swapTenor = vars.cube.tenors.swaps[j];
+            boost::shared_ptr<SmileSection> section =
+                cachedCube.smileSection(optionTenor, swapTenor);
+            if (cachedCube.smileSection(optionTenor, swapTenor) != section)
+                BOOST_ERROR("smile section not reused:"
+                            "\n    option tenor = " << optionTenor <<
+                            "\n      swap tenor = " << swapTenor);
+            if (uncachedCube.smileSection(optionTenor, swapTenor) ==
+                uncachedCube.smileSection(optionTenor, swapTenor))
+                BOOST_ERROR("smile section reused with disabled cache:"
+                            "\n    option tenor = " << optionTenor <<
+                            "\n      swap tenor = " << swapTenor);
+        }
+    }
+
+    // a change in the vol spreads must discard the cached sections
+    const Period& optionTenor = vars.cube.tenors.options[0];
+    const Period& swapTenor = vars.cube.tenors.swaps[0];
+    Volatility oldVol =
+        cachedCube.smileSection(optionTenor, swapTenor)->volatility(strike);
+    for (Size k=0; k<vars.cube.strikeSpreads.size(); k++) {
+        boost::shared_ptr<SimpleQuote> quote =
+            boost::dynamic_pointer_cast<SimpleQuote>(
+                            vars.cube.volSpreadsHandle[0][k].currentLink());
+        quote->setValue(quote->value() + 0.01);
+    }
+    Volatility vol =
+        cachedCube.smileSection(optionTenor, swapTenor)->volatility(strike);
+    Volatility expected =
+        uncachedCube.smileSection(optionTenor, swapTenor)->volatility(strike);
+    if (std::fabs(vol - expected) > 1.0e-16 ||
+        std::fabs(vol - oldVol - 0.01) > 1.0e-12)
+        BOOST_ERROR("cached smile section not updated:"
+                    "\n   old vol = " << io::volatility(oldVol) <<
+                    "\n   new vol = " << io::volatility(vol) <<
+                    "\n  expected = " << io::volatility(expected));
+}
+
+void SwaptionVolatilityCubeTest::testSnapshot() {
+    BOOST_TEST_MESSAGE("Testing snapshots of swaption volatility "
+                       "cube calibrations...");
+
+    CommonVars vars;
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (Size i=0; i<vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size(); i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    SwaptionVolCube1 volCube(vars.atmVolMatrix,
+                             vars.cube.tenors.options,
+                             vars.cube.tenors.swaps,
+                             vars.cube.strikeSpreads,
+                             vars.cube.volSpreadsHandle,
+                             vars.swapIndexBase,
+                             vars.shortSwapIndexBase,
+                             vars.vegaWeighedSmileFit,
+                             parametersGuess,
+                             isParameterFixed,
+                             true);
+
+    MarketSnapshot snapshot;
+    snapshot.add("cube", volCube);
+    std::stringstream stream(std::ios::in | std::ios::out |
+                             std::ios::binary);
+    snapshot.save(stream);
+    MarketSnapshot loaded;
+    loaded.load(stream);
+
+    // a few iterations are not enough to calibrate the cube, so
+    // the results must be taken from the snapshot
+    boost::shared_ptr<EndCriteria> endCriteria(
+                           new EndCriteria(3, 2, 1.0e-8, 1.0e-8, 1.0e-8));
+    SwaptionVolCube1 restoredCube(vars.atmVolMatrix,
+                                  vars.cube.tenors.options,
+                                  vars.cube.tenors.swaps,
+                                  vars.cube.strikeSpreads,
+                                  vars.cube.volSpreadsHandle,
+                                  vars.swapIndexBase,
+                                  vars.shortSwapIndexBase,
+                                  vars.vegaWeighedSmileFit,
+                                  parametersGuess,
+                                  isParameterFixed,
+                                  true,
+                                  endCriteria);
+    if (!loaded.restore("cube", restoredCube))
+        BOOST_FAIL("failed to restore cube");
+
+    Rate dummyStrike = 0.03;
+    for (Size i=0; i<vars.cube.tenors.options.size(); i++) {
+        for (Size j=0; j<vars.cube.tenors.swaps.size(); j++) {
+            for (Size k=0; k<vars.cube.strikeSpreads.size(); k++) {
+                Rate strike = dummyStrike + vars.cube.strikeSpreads[k];
+                Volatility v0 =
+                    volCube.volatility(vars.cube.tenors.options[i],
+                                       vars.cube.tenors.swaps[j],
+                                       strike, false);
+                Volatility v1 =
+                    restoredCube.volatility(vars.cube.tenors.options[i],
+                                            vars.cube.tenors.swaps[j],
+                                            strike, false);
+                if (v0 != v1)
+                    BOOST_ERROR("restored cube failed to reproduce "
+                                "the calibrated one:"
+                                "\n option tenor = " << vars.cube.tenors.options[i] <<
+                                "\n   swap tenor = " << vars.cube.tenors.swaps[j] <<
+                                "\n       strike = " << io::rate(strike) <<
+                                "\n   calibrated = " << io::volatility(v0) <<
+                                "\n     restored = " << io::volatility(v1));
+            }
+        }
+    }
+
+    // nodes whose inputs changed are calibrated again
+    boost::dynamic_pointer_cast<SimpleQuote>(
+        vars.cube.volSpreadsHandle[4][0].currentLink())
+        ->setValue(vars.cube.volSpreads[4][0] + 0.0010);
+    BOOST_CHECK_THROW(
+        restoredCube.volatility(vars.cube.tenors.options[0],
+                                vars.cube.tenors.swaps[0],
+                                dummyStrike, false),
+        Error);
+}
+
 test_suite* SwaptionVolatilityCubeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swaption Volatility Cube tests");
 
@@ -458,6 +728,11 @@ test_suite* SwaptionVolatilityCubeTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(
                              &SwaptionVolatilityCubeTest::testObservability));
+    suite->add(QUANTLIB_TEST_CASE(
+           &SwaptionVolatilityCubeTest::testParallelAndWarmStartCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &SwaptionVolatilityCubeTest::testSmileSectionCache));
+    suite->add(QUANTLIB_TEST_CASE(&SwaptionVolatilityCubeTest::testSnapshot));
 
     return suite;
 }
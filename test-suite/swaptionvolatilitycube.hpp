@@ -33,6 +33,9 @@ class SwaptionVolatilityCubeTest {
     static void testSabrVols();
     static void testSpreadedCube();
     static void testObservability();
+    static void testParallelAndWarmStartCalibration();
+    static void testSmileSectionCache();
+    static void testSnapshot();
 
     static boost::unit_test_framework::test_suite* suite();
 };
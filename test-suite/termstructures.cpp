@@ -25,14 +25,27 @@
 #include <ql/termstructures/yield/impliedtermstructure.hpp>
 #include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/cacheddiscountcurve.hpp>
+#include <ql/termstructures/yield/materializedcurve.hpp>
+#include <ql/termstructures/yield/fittedbonddiscountcurve.hpp>
+#include <ql/termstructures/yield/nonlinearfittingmethods.hpp>
+#include <ql/termstructures/yield/bondhelpers.hpp>
+#include <ql/experimental/risk/marketcloner.hpp>
+#include <ql/experimental/risk/marketsnapshot.hpp>
+#include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <ql/math/optimization/bfgs.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/quotes/simplequote.hpp>
 #include <ql/indexes/iborindex.hpp>
 #include <ql/currency.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <sstream>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -114,6 +127,42 @@ namespace {
         }
     };
 
+    typedef PiecewiseYieldCurve<Discount,LogLinear> SnapshotCurve;
+
+    boost::shared_ptr<SnapshotCurve> snapshotCurve(
+                    const std::vector<boost::shared_ptr<SimpleQuote> >& quotes,
+                    std::vector<boost::shared_ptr<RateHelper> >& helpers) {
+        Calendar calendar = TARGET();
+        boost::shared_ptr<IborIndex> index(
+            new IborIndex("dummy", 6*Months, 2, Currency(), calendar,
+                          ModifiedFollowing, false, Actual360()));
+        Integer months[] = { 3, 6, 24, 60, 120 };
+        helpers.clear();
+        for (Size i=0; i<LENGTH(months); ++i) {
+            if (months[i] < 12)
+                helpers.push_back(boost::shared_ptr<RateHelper>(
+                    new DepositRateHelper(Handle<Quote>(quotes[i]),
+                                          months[i]*Months, 2, calendar,
+                                          ModifiedFollowing, false,
+                                          Actual360())));
+            else
+                helpers.push_back(boost::shared_ptr<RateHelper>(
+                    new SwapRateHelper(Handle<Quote>(quotes[i]),
+                                       months[i]*Months, calendar, Annual,
+                                       Unadjusted, Thirty360(), index)));
+        }
+        return boost::shared_ptr<SnapshotCurve>(
+                      new SnapshotCurve(2, calendar, helpers, Actual360()));
+    }
+
+    std::vector<boost::shared_ptr<SimpleQuote> > snapshotQuotes() {
+        std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+        for (Size i=0; i<5; ++i)
+            quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                                          new SimpleQuote(0.01 + 0.002*i)));
+        return quotes;
+    }
+
 }
 
 
@@ -334,6 +383,572 @@ void TermStructureTest::testLinkToNullUnderlying() {
     underlying.linkTo(boost::shared_ptr<YieldTermStructure>());
 }
 
+void TermStructureTest::testCachedDiscounts() {
+    BOOST_TEST_MESSAGE("Testing cached discount factors...");
+
+    CommonVars vars;
+
+    RelinkableHandle<YieldTermStructure> h(vars.termStructure);
+    boost::shared_ptr<CachedDiscountCurve> cached(new CachedDiscountCurve(h));
+    Flag flag;
+    flag.registerWith(cached);
+
+    Date today = Settings::instance().evaluationDate();
+    std::vector<Date> dates;
+    for (Integer i=1; i<=10; ++i)
+        dates.push_back(today + i*Years);
+
+    Real tolerance = 1.0e-14;
+    for (Size k=0; k<2; ++k) {
+        for (Size i=0; i<dates.size(); ++i) {
+            DiscountFactor expected = vars.termStructure->discount(dates[i]),
+                           calculated = cached->discount(dates[i]);
+            if (std::fabs(expected - calculated) > tolerance)
+                BOOST_ERROR("unable to reproduce discount factor at "
+                            << dates[i] << ":"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+    if (cached->cachedDiscounts() != dates.size())
+        BOOST_ERROR(cached->cachedDiscounts() << " discounts stored, "
+                    << dates.size() << " expected");
+
+    h.linkTo(vars.dummyTermStructure);
+    if (!flag.isUp())
+        BOOST_ERROR("Observer was not notified of term structure change");
+    if (cached->cachedDiscounts() != 0)
+        BOOST_ERROR("stored discounts not cleared after notification");
+    for (Size i=0; i<dates.size(); ++i) {
+        DiscountFactor expected = vars.dummyTermStructure->discount(dates[i]),
+                       calculated = cached->discount(dates[i]);
+        if (std::fabs(expected - calculated) > tolerance)
+            BOOST_ERROR("unable to reproduce discount factor at "
+                        << dates[i] << " after relinking:"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+}
+
+void TermStructureTest::testBulkDiscounts() {
+    BOOST_TEST_MESSAGE("Testing bulk calculation of discount factors...");
+
+    CommonVars vars;
+
+    Date today = vars.termStructure->referenceDate();
+    std::vector<Date> dates;
+    Integer days[] = { 3650, 30, 1800, 30, 365, 7300, 1 };
+    for (Size i=0; i<LENGTH(days); ++i)
+        dates.push_back(today + days[i]);
+
+    Array discounts;
+    vars.termStructure->discounts(dates, discounts);
+    if (discounts.size() != dates.size())
+        BOOST_FAIL(discounts.size() << " discounts returned, "
+                   << dates.size() << " expected");
+
+    for (Size i=0; i<dates.size(); ++i) {
+        DiscountFactor expected = vars.termStructure->discount(dates[i]);
+        if (std::fabs(expected - discounts[i]) > 1.0e-15)
+            BOOST_ERROR("unable to reproduce discount factor at "
+                        << dates[i] << ":"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << discounts[i]
+                        << "\n    expected:   " << expected);
+    }
+
+    dates.push_back(vars.termStructure->maxDate() + 1);
+    BOOST_CHECK_THROW(vars.termStructure->discounts(dates, discounts),
+                      Error);
+}
+void TermStructureTest::testMaterializedCurve() {
+    BOOST_TEST_MESSAGE("Testing materialized chain of term structures...");
+
+    CommonVars vars;
+
+    // a stack of implied and spreaded curves
+    RelinkableHandle<YieldTermStructure> h(vars.termStructure);
+    Date today = Settings::instance().evaluationDate();
+    Date start = vars.calendar.advance(today, 1, Months);
+    boost::shared_ptr<SimpleQuote> fwdSpread(new SimpleQuote(0.0020)),
+                                   zeroSpread(new SimpleQuote(-0.0010));
+    boost::shared_ptr<YieldTermStructure> implied(
+                                         new ImpliedTermStructure(h, start));
+    boost::shared_ptr<YieldTermStructure> forwardSpreaded(
+        new ForwardSpreadedTermStructure(
+                                  Handle<YieldTermStructure>(implied),
+                                  Handle<Quote>(fwdSpread)));
+    boost::shared_ptr<YieldTermStructure> chain(
+        new ZeroSpreadedTermStructure(
+                                  Handle<YieldTermStructure>(forwardSpreaded),
+                                  Handle<Quote>(zeroSpread)));
+
+    std::vector<Period> tenors;
+    for (Integer i=1; i<=12; ++i)
+        tenors.push_back(i*Weeks);
+    for (Integer i=4; i<=29*12; ++i)
+        tenors.push_back(i*Months);
+    boost::shared_ptr<MaterializedCurve> materialized(
+           new MaterializedCurve(Handle<YieldTermStructure>(chain), tenors));
+    Flag flag;
+    flag.registerWith(materialized);
+
+    for (Size k=0; k<3; ++k) {
+        // exact at the grid dates...
+        const std::vector<Date>& dates = materialized->dates();
+        if (dates.size() != tenors.size()+1)
+            BOOST_ERROR(dates.size() << " grid dates, "
+                        << tenors.size()+1 << " expected");
+        for (Size i=0; i<dates.size(); ++i) {
+            DiscountFactor expected = chain->discount(dates[i]),
+                           calculated = materialized->discount(dates[i]);
+            if (std::fabs(expected - calculated) > 1.0e-14)
+                BOOST_ERROR("unable to reproduce discount factor at "
+                            << dates[i] << ":"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+        // ...and close enough between them; the error is largest
+        // between grid dates around a jump of the underlying forwards
+        Real tolerance = 1.0e-4;
+        for (Date d = start+3; d < dates.back(); d += 17) {
+            DiscountFactor expected = chain->discount(d),
+                           calculated = materialized->discount(d);
+            if (std::fabs(expected - calculated) > tolerance)
+                BOOST_ERROR("unable to approximate discount factor at "
+                            << d << ":"
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected
+                            << "\n    tolerance:  " << tolerance);
+        }
+
+        if (k == 2)
+            break;
+        flag.lower();
+        if (k == 0)
+            zeroSpread->setValue(0.0015);
+        else
+            h.linkTo(vars.dummyTermStructure);
+        if (!flag.isUp())
+            BOOST_ERROR("Observer was not notified of term structure change");
+    }
+}
+
+void TermStructureTest::testValuationContexts() {
+
+    BOOST_TEST_MESSAGE("Testing term structures in different "
+                       "valuation contexts...");
+
+    SavedSettings backup;
+
+    Date today(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    ValuationContext context1(today+1), context2(today+2);
+    boost::shared_ptr<YieldTermStructure> curve1, curve2;
+    {
+        ValuationContext::Binding binding(context1);
+        curve1 = boost::shared_ptr<YieldTermStructure>(
+                 new FlatForward(0, NullCalendar(), 0.03, Actual360()));
+    }
+    {
+        ValuationContext::Binding binding(context2);
+        curve2 = boost::shared_ptr<YieldTermStructure>(
+                 new FlatForward(0, NullCalendar(), 0.03, Actual360()));
+    }
+
+    Flag flag1, flag2, globalFlag;
+    flag1.registerWith(curve1);
+    flag2.registerWith(curve2);
+    globalFlag.registerWith(Settings::instance().evaluationDate());
+
+    {
+        ValuationContext::Binding binding(context1);
+        if (curve1->referenceDate() != today+1)
+            BOOST_ERROR("wrong reference date in first context:"
+                        << "\n    calculated: " << curve1->referenceDate()
+                        << "\n    expected:   " << today+1);
+        Settings::instance().evaluationDate() = today+3;
+        if (curve1->referenceDate() != today+3)
+            BOOST_ERROR("reference date not updated in first context:"
+                        << "\n    calculated: " << curve1->referenceDate()
+                        << "\n    expected:   " << today+3);
+    }
+    if (!flag1.isUp())
+        BOOST_ERROR("term structure not notified of change "
+                    "in its own context");
+    if (flag2.isUp())
+        BOOST_ERROR("term structure notified of change in another context");
+    if (globalFlag.isUp())
+        BOOST_ERROR("global evaluation date notified of change "
+                    "in a context");
+
+    if (Settings::instance().evaluationDate() != today)
+        BOOST_ERROR("global evaluation date modified by context:"
+                    << "\n    calculated: "
+                    << Settings::instance().evaluationDate()
+                    << "\n    expected:   " << today);
+    if (ValuationContext::current() != 0)
+        BOOST_ERROR("context still bound after binding went out of scope");
+
+    ValuationContext::Binding binding(context2);
+    if (curve2->referenceDate() != today+2)
+        BOOST_ERROR("wrong reference date in second context:"
+                    << "\n    calculated: " << curve2->referenceDate()
+                    << "\n    expected:   " << today+2);
+}
+
+
+void TermStructureTest::testFittedBondCurveGradients() {
+    BOOST_TEST_MESSAGE("Testing analytic gradients of bond-curve "
+                       "fitting methods...");
+
+    SavedSettings backup;
+
+    Date today(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    std::vector<Time> knots;
+    Time knotTimes[] = { -30.0, -20.0, 0.0, 5.0, 10.0, 15.0,
+                         20.0, 25.0, 30.0, 40.0, 50.0 };
+    knots.assign(knotTimes, knotTimes+LENGTH(knotTimes));
+
+    std::vector<boost::shared_ptr<FittedBondDiscountCurve::FittingMethod> >
+        methods;
+    methods.push_back(boost::shared_ptr<FittedBondDiscountCurve::FittingMethod>(
+                                     new ExponentialSplinesFitting(true)));
+    methods.push_back(boost::shared_ptr<FittedBondDiscountCurve::FittingMethod>(
+                                     new ExponentialSplinesFitting(false)));
+    methods.push_back(boost::shared_ptr<FittedBondDiscountCurve::FittingMethod>(
+                                     new NelsonSiegelFitting));
+    methods.push_back(boost::shared_ptr<FittedBondDiscountCurve::FittingMethod>(
+                                     new SvenssonFitting));
+    methods.push_back(boost::shared_ptr<FittedBondDiscountCurve::FittingMethod>(
+                                     new CubicBSplinesFitting(knots, true)));
+    methods.push_back(boost::shared_ptr<FittedBondDiscountCurve::FittingMethod>(
+                                     new CubicBSplinesFitting(knots, false)));
+    methods.push_back(boost::shared_ptr<FittedBondDiscountCurve::FittingMethod>(
+                                     new SimplePolynomialFitting(3, true)));
+    methods.push_back(boost::shared_ptr<FittedBondDiscountCurve::FittingMethod>(
+                                     new SimplePolynomialFitting(3, false)));
+
+    Time times[] = { 0.0, 0.5, 2.0, 7.3, 19.0 };
+    Real h = 1.0e-6, tolerance = 1.0e-6;
+
+    for (Size i=0; i<methods.size(); ++i) {
+        const FittedBondDiscountCurve::FittingMethod& method = *methods[i];
+        if (!method.hasDiscountFunctionGradient())
+            BOOST_FAIL("no gradient for " << io::ordinal(i+1) << " method");
+        Size n = method.size();
+        Array x(n), gradient(n);
+        for (Size j=0; j<n; ++j)
+            x[j] = 0.01*(j+1);
+        // positive speeds of mean reversion, where present
+        x[n-1] = 0.3;
+        for (Size k=0; k<LENGTH(times); ++k) {
+            method.discountGradient(gradient, x, times[k]);
+            for (Size j=0; j<n; ++j) {
+                Array xp = x, xm = x;
+                xp[j] += h;
+                xm[j] -= h;
+                Real expected = (method.discount(xp, times[k]) -
+                                 method.discount(xm, times[k]))/(2.0*h);
+                if (std::fabs(gradient[j]-expected) > tolerance)
+                    BOOST_ERROR("wrong gradient for "
+                                << io::ordinal(i+1) << " method:"
+                                << "\n    time:       " << times[k]
+                                << "\n    parameter:  " << j
+                                << "\n    calculated: " << gradient[j]
+                                << "\n    expected:   " << expected);
+            }
+        }
+    }
+
+    // the curve fitted with a gradient-based optimizer must reprice
+    // bonds priced off a curve that the fitting method can reproduce.
+    DayCounter dayCounter = Actual365Fixed();
+    FlatForward flatCurve(today, 0.04, dayCounter, Continuous);
+    Natural settlementDays = 2;
+
+    std::vector<boost::shared_ptr<BondHelper> > helpers;
+    for (Integer length=2; length<=30; length+=2) {
+        Date start = NullCalendar().advance(today, settlementDays*Days);
+        Schedule schedule(start, start + length*Years, Period(Annual),
+                          NullCalendar(), Unadjusted, Unadjusted,
+                          DateGeneration::Backward, false);
+        std::vector<Rate> coupons(1, 0.02 + 0.001*length);
+        boost::shared_ptr<SimpleQuote> quote(new SimpleQuote(100.0));
+        boost::shared_ptr<BondHelper> helper(
+            new FixedRateBondHelper(Handle<Quote>(quote), settlementDays,
+                                    100.0, schedule, coupons, dayCounter));
+        boost::shared_ptr<Bond> bond = helper->bond();
+        quote->setValue(BondFunctions::cleanPrice(*bond, flatCurve,
+                                                  bond->settlementDate()));
+        helpers.push_back(helper);
+    }
+
+    NelsonSiegelFitting nelsonSiegel(
+                   Array(), boost::shared_ptr<OptimizationMethod>(new BFGS));
+    Array guess(4, 0.0);
+    guess[3] = 0.5;
+    FittedBondDiscountCurve fittedCurve(today, helpers, dayCounter,
+                                        nelsonSiegel, 1.0e-10, 10000, guess);
+
+    for (Size i=0; i<helpers.size(); ++i) {
+        boost::shared_ptr<Bond> bond = helpers[i]->bond();
+        Real price = BondFunctions::cleanPrice(*bond, fittedCurve,
+                                               bond->settlementDate());
+        Real expected = helpers[i]->quote()->value();
+        if (std::fabs(price-expected) > 1.0e-4)
+            BOOST_ERROR("failed to reprice " << io::ordinal(i+1)
+                        << " bond:"
+                        << "\n    calculated: " << price
+                        << "\n    expected:   " << expected);
+    }
+}
+
+void TermStructureTest::testMarketCloner() {
+    BOOST_TEST_MESSAGE("Testing deep copy of market objects...");
+
+    SavedSettings backup;
+
+    Calendar calendar = TARGET();
+    Date today(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+    DayCounter dayCounter = Actual360();
+
+    RelinkableHandle<YieldTermStructure> forecast;
+    boost::shared_ptr<IborIndex> index(
+        new IborIndex("dummy", 6*Months, 2, Currency(), calendar,
+                      ModifiedFollowing, false, dayCounter, forecast));
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+    std::vector<boost::shared_ptr<RateHelper> > helpers;
+    Integer depositMonths[] = { 1, 3, 6 };
+    for (Size i=0; i<LENGTH(depositMonths); ++i) {
+        quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                                           new SimpleQuote(0.01 + 0.001*i)));
+        helpers.push_back(boost::shared_ptr<RateHelper>(
+            new DepositRateHelper(Handle<Quote>(quotes.back()),
+                                  depositMonths[i]*Months, 2, calendar,
+                                  ModifiedFollowing, false, dayCounter)));
+    }
+    Integer swapYears[] = { 2, 5, 10 };
+    for (Size i=0; i<LENGTH(swapYears); ++i) {
+        quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                                           new SimpleQuote(0.015 + 0.002*i)));
+        helpers.push_back(boost::shared_ptr<RateHelper>(
+            new SwapRateHelper(Handle<Quote>(quotes.back()),
+                               swapYears[i]*Years, calendar, Annual,
+                               Unadjusted, Thirty360(), index)));
+    }
+    boost::shared_ptr<YieldTermStructure> curve(
+        new PiecewiseYieldCurve<Discount,LogLinear>(2, calendar, helpers,
+                                                    dayCounter));
+    curve->enableExtrapolation();
+    forecast.linkTo(curve);
+
+    boost::shared_ptr<SimpleQuote> spread(new SimpleQuote(0.001));
+    boost::shared_ptr<YieldTermStructure> spreaded(
+        new ZeroSpreadedTermStructure(Handle<YieldTermStructure>(curve),
+                                      Handle<Quote>(spread)));
+
+    std::vector<boost::shared_ptr<BondHelper> > bondHelpers;
+    for (Integer length=2; length<=10; length+=2) {
+        Schedule schedule(today, today + length*Years, Period(Annual),
+                          NullCalendar(), Unadjusted, Unadjusted,
+                          DateGeneration::Backward, false);
+        std::vector<Rate> coupons(1, 0.02 + 0.001*length);
+        boost::shared_ptr<SimpleQuote> price(new SimpleQuote(100.0));
+        bondHelpers.push_back(boost::shared_ptr<BondHelper>(
+            new FixedRateBondHelper(Handle<Quote>(price), 0, 100.0,
+                                    schedule, coupons, dayCounter)));
+    }
+    NelsonSiegelFitting nelsonSiegel(
+                   Array(), boost::shared_ptr<OptimizationMethod>(new BFGS));
+    Array guess(4, 0.0);
+    guess[3] = 0.5;
+    boost::shared_ptr<YieldTermStructure> fitted(
+        new FittedBondDiscountCurve(today, bondHelpers, dayCounter,
+                                    nelsonSiegel, 1.0e-10, 10000, guess));
+
+    Date dates[] = { today + 1*Months, today + 1*Years, today + 7*Years,
+                     today + 9*Years };
+    for (Size k=0; k<LENGTH(dates); ++k) {
+        curve->discount(dates[k]);
+        fitted->discount(dates[k]);
+    }
+
+    MarketCloner cloner;
+    boost::shared_ptr<IborIndex> clonedIndex = cloner.clone(index);
+    boost::shared_ptr<YieldTermStructure> clonedSpreaded =
+        cloner.clone(spreaded);
+    boost::shared_ptr<YieldTermStructure> clonedFitted = cloner.clone(fitted);
+    boost::shared_ptr<YieldTermStructure> clonedCurve = cloner.clone(curve);
+
+    // objects reached through different paths are copied once
+    if (clonedIndex->forwardingTermStructure().currentLink() != clonedCurve)
+        BOOST_ERROR("curve copied more than once");
+    if (clonedCurve == curve || cloner.clone(quotes[0]) == quotes[0])
+        BOOST_ERROR("original objects returned instead of copies");
+    if (!clonedCurve->allowsExtrapolation())
+        BOOST_ERROR("extrapolation setting not copied");
+
+    // the bootstrapped state is copied; the helpers of the copy
+    // haven't been linked to it by a bootstrap yet
+    BOOST_CHECK_THROW(cloner.clone(helpers[0])->impliedQuote(), Error);
+
+    Real tolerance = 1.0e-14;
+    for (Size k=0; k<LENGTH(dates); ++k) {
+        if (std::fabs(clonedCurve->discount(dates[k]) -
+                      curve->discount(dates[k])) > tolerance)
+            BOOST_ERROR("failed to reproduce bootstrapped curve at "
+                        << dates[k] << std::setprecision(12)
+                        << "\n    original: " << curve->discount(dates[k])
+                        << "\n    copy:     "
+                        << clonedCurve->discount(dates[k]));
+        if (std::fabs(clonedSpreaded->discount(dates[k]) -
+                      spreaded->discount(dates[k])) > tolerance)
+            BOOST_ERROR("failed to reproduce spreaded curve at "
+                        << dates[k] << std::setprecision(12)
+                        << "\n    original: " << spreaded->discount(dates[k])
+                        << "\n    copy:     "
+                        << clonedSpreaded->discount(dates[k]));
+        if (std::fabs(clonedFitted->discount(dates[k]) -
+                      fitted->discount(dates[k])) > tolerance)
+            BOOST_ERROR("failed to reproduce fitted curve at "
+                        << dates[k] << std::setprecision(12)
+                        << "\n    original: " << fitted->discount(dates[k])
+                        << "\n    copy:     "
+                        << clonedFitted->discount(dates[k]));
+    }
+    Date fixingDate = calendar.advance(today, 1*Years);
+    if (std::fabs(clonedIndex->fixing(fixingDate) -
+                  index->fixing(fixingDate)) > tolerance)
+        BOOST_ERROR("failed to reproduce index forecast:"
+                    << std::setprecision(12)
+                    << "\n    original: " << index->fixing(fixingDate)
+                    << "\n    copy:     " << clonedIndex->fixing(fixingDate));
+
+    // the copies are independent of the originals
+    Date d = today + 7*Years;
+    Real base = clonedSpreaded->discount(d);
+    quotes[4]->setValue(0.02);
+    spread->setValue(0.002);
+    if (clonedSpreaded->discount(d) != base)
+        BOOST_ERROR("copy affected by changes in the original quotes");
+
+    // and are bootstrapped again when their own quotes change
+    cloner.clone(quotes[4])->setValue(0.02);
+    cloner.clone(spread)->setValue(0.002);
+    if (std::fabs(clonedSpreaded->discount(d) -
+                  spreaded->discount(d)) > 1.0e-12)
+        BOOST_ERROR("failed to reproduce modified curve:"
+                    << std::setprecision(12)
+                    << "\n    original: " << spreaded->discount(d)
+                    << "\n    copy:     " << clonedSpreaded->discount(d));
+
+    boost::shared_ptr<YieldTermStructure> implied(
+        new ImpliedTermStructure(Handle<YieldTermStructure>(curve),
+                                 today + 1*Years));
+    BOOST_CHECK_THROW(cloner.clone(implied), Error);
+}
+
+void TermStructureTest::testMarketSnapshot() {
+    BOOST_TEST_MESSAGE("Testing snapshots of curves and models...");
+
+    SavedSettings backup;
+
+    Date today(15, March, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes = snapshotQuotes();
+    std::vector<boost::shared_ptr<RateHelper> > helpers;
+    boost::shared_ptr<SnapshotCurve> curve = snapshotCurve(quotes, helpers);
+    Handle<YieldTermStructure> flatCurve(
+        boost::shared_ptr<YieldTermStructure>(
+                               new FlatForward(today, 0.02, Actual360())));
+    boost::shared_ptr<HullWhite> model(new HullWhite(flatCurve, 0.05, 0.008));
+
+    MarketSnapshot snapshot;
+    snapshot.add("curve", *curve);
+    snapshot.add("model", *model);
+    std::stringstream stream(std::ios::in | std::ios::out |
+                             std::ios::binary);
+    snapshot.save(stream);
+
+    MarketSnapshot loaded;
+    loaded.load(stream);
+    if (loaded.size() != 2 || !loaded.has("curve") || !loaded.has("model"))
+        BOOST_FAIL("failed to load snapshot");
+
+    // a new instance, as after a restart
+    std::vector<boost::shared_ptr<SimpleQuote> > newQuotes =
+        snapshotQuotes();
+    std::vector<boost::shared_ptr<RateHelper> > newHelpers;
+    boost::shared_ptr<SnapshotCurve> newCurve =
+        snapshotCurve(newQuotes, newHelpers);
+    boost::shared_ptr<HullWhite> newModel(
+                                       new HullWhite(flatCurve, 0.1, 0.01));
+    Flag flag;
+    flag.registerWith(newCurve);
+
+    if (!loaded.restore("curve", *newCurve))
+        BOOST_FAIL("failed to restore curve");
+    loaded.restore("model", *newModel);
+    BOOST_CHECK_THROW(loaded.restore("curve", *newModel), Error);
+
+    // the curve was not bootstrapped; its helpers are not linked to it
+    BOOST_CHECK_THROW(newHelpers[0]->impliedQuote(), Error);
+
+    if (newCurve->dates() != curve->dates() ||
+        newCurve->data() != curve->data())
+        BOOST_ERROR("failed to restore curve nodes");
+    Date dates[] = { today + 1*Months, today + 1*Years, today + 7*Years };
+    for (Size k=0; k<LENGTH(dates); ++k) {
+        if (newCurve->discount(dates[k]) != curve->discount(dates[k]))
+            BOOST_ERROR("failed to reproduce bootstrapped curve at "
+                        << dates[k] << std::setprecision(12)
+                        << "\n    original: " << curve->discount(dates[k])
+                        << "\n    restored: "
+                        << newCurve->discount(dates[k]));
+    }
+    if (newModel->params() != model->params())
+        BOOST_ERROR("failed to restore model parameters:"
+                    << "\n    original: " << model->params()
+                    << "\n    restored: " << newModel->params());
+
+    // the restored curve is still notified of changes
+    flag.lower();
+    quotes[3]->setValue(0.02);
+    newQuotes[3]->setValue(0.02);
+    if (!flag.isUp())
+        BOOST_ERROR("observer was not notified of quote change");
+    Date d = today + 7*Years;
+    if (std::fabs(newCurve->discount(d) - curve->discount(d)) > 1.0e-10)
+        BOOST_ERROR("failed to bootstrap restored curve again:"
+                    << std::setprecision(12)
+                    << "\n    original: " << curve->discount(d)
+                    << "\n    restored: " << newCurve->discount(d));
+
+    // stale snapshots are not used
+    std::vector<boost::shared_ptr<RateHelper> > otherHelpers;
+    boost::shared_ptr<SnapshotCurve> otherCurve =
+        snapshotCurve(newQuotes, otherHelpers);
+    if (loaded.restore("curve", *otherCurve))
+        BOOST_ERROR("stale snapshot restored");
+
+    std::stringstream garbage("not a snapshot");
+    BOOST_CHECK_THROW(loaded.load(garbage), Error);
+    if (loaded.size() != 2)
+        BOOST_ERROR("snapshot modified by failed load");
+}
+
+
 test_suite* TermStructureTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -347,6 +962,14 @@ test_suite* TermStructureTest::suite() {
                          &TermStructureTest::testCreateWithNullUnderlying));
     suite->add(QUANTLIB_TEST_CASE(
                              &TermStructureTest::testLinkToNullUnderlying));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testCachedDiscounts));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testBulkDiscounts));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testMaterializedCurve));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testValuationContexts));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &TermStructureTest::testFittedBondCurveGradients));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testMarketCloner));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testMarketSnapshot));
     return suite;
 }
 
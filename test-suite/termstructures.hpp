@@ -36,6 +36,13 @@ class TermStructureTest {
     static void testZSpreadedObs();
     static void testCreateWithNullUnderlying();
     static void testLinkToNullUnderlying();
+    static void testCachedDiscounts();
+    static void testBulkDiscounts();
+    static void testMaterializedCurve();
+    static void testValuationContexts();
+    static void testFittedBondCurveGradients();
+    static void testMarketCloner();
+    static void testMarketSnapshot();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -22,7 +22,10 @@
 #include "utilities.hpp"
 #include <ql/timeseries.hpp>
 #include <ql/prices.hpp>
+#include <ql/time/sorteddatemap.hpp>
+#include <ql/models/volatility/constantestimator.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
+#include <cstdio>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -193,11 +196,84 @@ void TimeSeriesTest::testIterators() {
     }
 }
 
+void TimeSeriesTest::testSortedDateMap() {
+    BOOST_TEST_MESSAGE("Testing time series stored in sorted arrays...");
+
+    typedef TimeSeries<Volatility, SortedDateMap<Volatility> > FlatSeries;
+
+    TimeSeries<Volatility> reference;
+    FlatSeries flat;
+    Date d0(3, January, 2005);
+    // appended data, followed by a datum inserted in the middle
+    for (Integer i=0; i<200; ++i) {
+        Volatility v = 0.2 + 0.05*std::sin(0.1*i);
+        reference[d0 + 2*i] = v;
+        flat[d0 + 2*i] = v;
+    }
+    reference[d0 + 101] = 0.25;
+    flat[d0 + 101] = 0.25;
+
+    if (flat.size() != reference.size())
+        BOOST_FAIL("size mismatch: " << flat.size() << " data stored; "
+                   << reference.size() << " expected");
+    if (!std::equal(flat.cbegin_time(), flat.cend_time(),
+                    reference.cbegin_time()))
+        BOOST_FAIL("dates do not match");
+    if (!std::equal(flat.cbegin_values(), flat.cend_values(),
+                    reference.cbegin_values()))
+        BOOST_FAIL("values do not match");
+    if (!std::equal(flat.container().data(),
+                    flat.container().data() + flat.size(),
+                    reference.cbegin_values()))
+        BOOST_FAIL("contiguous values do not match");
+    if (flat.lastDate() != reference.lastDate()
+        || flat.crbegin()->second != reference.crbegin()->second)
+        BOOST_FAIL("last datum does not match");
+
+    const FlatSeries& constFlat = flat;
+    if (constFlat[d0 + 101] != 0.25 || constFlat[d0 + 1] != Null<Real>())
+        BOOST_FAIL("lookup failed");
+    if (flat.size() != reference.size())
+        BOOST_FAIL("datum inserted by const lookup");
+
+    // save, map and read back
+    std::string filename = "sorteddatemap.bin";
+    flat.container().save(filename);
+    {
+        FlatSeries mapped(SortedDateMap<Volatility>::map(filename));
+        FlatSeries copy = mapped;
+        if (!mapped.container().mapped() || !copy.container().mapped())
+            BOOST_FAIL("data not mapped");
+        if (!std::equal(mapped.cbegin_time(), mapped.cend_time(),
+                        reference.cbegin_time())
+            || !std::equal(mapped.cbegin_values(), mapped.cend_values(),
+                           reference.cbegin_values()))
+            BOOST_FAIL("mapped data do not match");
+
+        ConstantEstimator estimator(10);
+        TimeSeries<Volatility> expected = estimator.calculate(reference),
+                               calculated = estimator.calculate(mapped);
+        if (expected.size() != calculated.size()
+            || !std::equal(expected.cbegin_values(), expected.cend_values(),
+                           calculated.cbegin_values()))
+            BOOST_FAIL("estimated volatilities do not match");
+
+        // modifications apply to a copy of the data
+        copy[reference.lastDate() + 1] = 0.3;
+        if (copy.container().mapped() || copy.size() != mapped.size()+1)
+            BOOST_FAIL("mapped data not copied upon modification");
+        if (copy[d0] != mapped[d0] || mapped.size() != reference.size())
+            BOOST_FAIL("mapped data modified");
+    }
+    std::remove(filename.c_str());
+}
+
 test_suite* TimeSeriesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("time series tests");
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIntervalPrice));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIterators));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testSortedDateMap));
     return suite;
 }
 
@@ -20,8 +20,11 @@
 #include "tracing.hpp"
 #include "utilities.hpp"
 #include <ql/utilities/tracing.hpp>
+#include <ql/utilities/instrumentation.hpp>
+#include <ql/quotes/simplequote.hpp>
 #include <sstream>
 #include <iostream>
+#include <map>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -80,11 +83,90 @@ void TracingTest::testOutput() {
     testTraceOutput(true,  "trace[0]: i = 42\n");
 }
 
+void TracingTest::testInstrumentation() {
+
+    BOOST_TEST_MESSAGE("Testing instrumentation...");
+
+    #if defined(QL_ENABLE_INSTRUMENTATION)
+
+    Instrumentation::enable();
+    Instrumentation::reset();
+
+    boost::shared_ptr<SimpleQuote> quote(new SimpleQuote(1.0));
+    Flag flag;
+    flag.registerWith(quote);
+    {
+        QL_INSTRUMENT_OBJECT_SCOPE("outer", quote.get());
+        for (Size i=0; i<3; ++i) {
+            QL_INSTRUMENT_SCOPE("inner");
+            quote->setValue(i+2.0);
+        }
+    }
+    QL_INSTRUMENT_COUNT("test counter", 5);
+    Instrumentation::disable();
+    {
+        QL_INSTRUMENT_SCOPE("not recorded");
+        quote->setValue(0.0);
+    }
+
+    std::vector<Instrumentation::TimerTotals> timers =
+        Instrumentation::timers();
+    if (timers.size() != 2
+        || timers[0].name != "inner" || timers[0].count != 3
+        || timers[1].name != "outer" || timers[1].count != 1)
+        BOOST_FAIL("wrong timer totals recorded");
+    if (timers[1].total < timers[0].total)
+        BOOST_ERROR("outer scope (" << timers[1].total << " us) "
+                    "shorter than inner ones (" << timers[0].total
+                    << " us)");
+
+    std::vector<Instrumentation::Event> events = Instrumentation::events();
+    if (events.size() != 4)
+        BOOST_FAIL(events.size() << " events recorded, 4 expected");
+    if (events[0].object != quote.get() || events[0].depth != 0)
+        BOOST_ERROR("wrong outer event recorded");
+    for (Size i=1; i<4; ++i) {
+        if (events[i].depth != 1 || events[i].start < events[i-1].start)
+            BOOST_ERROR("wrong inner event recorded");
+    }
+
+    std::vector<Instrumentation::CounterTotals> counters =
+        Instrumentation::counters();
+    std::map<std::string, Size> values;
+    for (Size i=0; i<counters.size(); ++i)
+        values[counters[i].name] = counters[i].value;
+    if (values["test counter"] != 5)
+        BOOST_ERROR("wrong test counter: " << values["test counter"]);
+    if (values["Observable::notifyObservers"] != 3)
+        BOOST_ERROR("wrong count of notifications: "
+                    << values["Observable::notifyObservers"]);
+
+    std::ostringstream trace;
+    Instrumentation::writeChromeTrace(trace);
+    if (trace.str().find("{\"traceEvents\":[") != 0
+        || trace.str().find("\"name\":\"inner\"") == std::string::npos)
+        BOOST_ERROR("wrong trace written:\n" << trace.str());
+
+    Instrumentation::reset();
+    if (!Instrumentation::events().empty()
+        || !Instrumentation::timers().empty())
+        BOOST_ERROR("data not discarded by reset");
+
+    #else
+
+    BOOST_CHECK_THROW(Instrumentation::enable(), Error);
+    if (Instrumentation::enabled())
+        BOOST_ERROR("instrumentation enabled without support");
+
+    #endif
+}
+
 
 test_suite* TracingTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Tracing tests");
 
     suite->add(QUANTLIB_TEST_CASE(&TracingTest::testOutput));
+    suite->add(QUANTLIB_TEST_CASE(&TracingTest::testInstrumentation));
     return suite;
 }
 
@@ -28,6 +28,7 @@
 class TracingTest {
   public:
     static void testOutput();
+    static void testInstrumentation();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -26,6 +26,7 @@
 #include <ql/termstructures/volatility/equityfx/blackvoltermstructure.hpp>
 #include <ql/quote.hpp>
 #include <ql/patterns/observable.hpp>
+#include <ql/methods/montecarlo/samplecommunicator.hpp>
 #include <ql/time/daycounters/actual365fixed.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/test/floating_point_comparison.hpp>
@@ -160,6 +161,36 @@ namespace QuantLib {
     };
 
 
+    // emulates several processes in a single one: each process
+    // posts its data on the shared board and reads whatever the
+    // processes posted so far.  Running all the processes twice
+    // emulates a single exchange of data among them.
+    class SharedBoardCommunicator : public SampleCommunicator {
+      public:
+        SharedBoardCommunicator(
+            Size rank,
+            const boost::shared_ptr<std::vector<std::vector<Real> > >& board)
+        : rank_(rank), board_(board) {}
+        Size rank() const { return rank_; }
+        Size size() const { return board_->size(); }
+        void allGather(const std::vector<Real>& data,
+                       std::vector<std::vector<Real> >& values) const {
+            (*board_)[rank_] = data;
+            values = *board_;
+        }
+        void gather(const std::vector<Real>& data,
+                    std::vector<std::vector<Real> >& values) const {
+            (*board_)[rank_] = data;
+            values.clear();
+            if (rank_ == 0)
+                values = *board_;
+        }
+      private:
+        Size rank_;
+        boost::shared_ptr<std::vector<std::vector<Real> > > board_;
+    };
+
+
     // Allow streaming vectors to error messages.
 
     // The standard forbids defining new overloads in the std
@@ -40,6 +40,8 @@
 #include <ql/experimental/processes/extendedornsteinuhlenbeckprocess.hpp>
 #include <ql/experimental/finitedifferences/vanillavppoption.hpp>
 #include <ql/experimental/finitedifferences/fdmklugeextouop.hpp>
+#include <ql/experimental/finitedifferences/fdmextoujumpop.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/experimental/finitedifferences/fdsimpleextoustorageengine.hpp>
 #include <ql/experimental/finitedifferences/fdklugeextouspreadengine.hpp>
 #include <ql/experimental/finitedifferences/fdmvppstepconditionfactory.hpp>
@@ -966,6 +968,91 @@ void VPPTest::testKlugeExtOUMatrixDecomposition() {
 }
 
 
+void VPPTest::testExtOUJumpIntegral() {
+    BOOST_TEST_MESSAGE("Testing jump integral of the Kluge operator...");
+
+    SavedSettings backup;
+
+    const Date today = Date(18, December, 2011);
+    Settings::instance().evaluationDate() = today;
+
+    const boost::shared_ptr<ExtOUWithJumpsProcess> klugeProcess
+        = createKlugeProcess();
+
+    const Size xGrid = 20;
+    const Size yGrid = 30;
+    const Time maturity = 1;
+
+    const boost::shared_ptr<FdmMesherComposite> mesher(
+        new FdmMesherComposite(
+            boost::shared_ptr<Fdm1dMesher>(
+                new FdmSimpleProcess1dMesher(
+                    xGrid,
+                    klugeProcess->getExtendedOrnsteinUhlenbeckProcess(),
+                    maturity)),
+            boost::shared_ptr<Fdm1dMesher>(
+                new ExponentialJump1dMesher(yGrid,
+                                            klugeProcess->beta(),
+                                            klugeProcess->jumpIntensity(),
+                                            klugeProcess->eta()))));
+
+    const Size order = 32;
+    const FdmExtOUJumpOp op(mesher, klugeProcess,
+                            flatRate(today, 0.0, ActualActual()),
+                            FdmBoundaryConditionSet(), order);
+
+    const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+    const std::vector<Real>& y = mesher->getFdm1dMeshers()[1]->locations();
+
+    Array f(layout->size());
+    Matrix values(xGrid, yGrid);
+    PseudoRandom::rng_type rng(PseudoRandom::urng_type(1234ul));
+    const FdmLinearOpIterator endIter = layout->end();
+    for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+         ++iter) {
+        const Size i = iter.coordinates()[0], j = iter.coordinates()[1];
+        f[iter.index()] = values[i][j] = rng.next().value;
+    }
+
+    const Array calculated = op.apply_mixed(f);
+    Array calculatedInPlace(f.size());
+    op.apply_mixed(f, calculatedInPlace);
+
+    // direct quadrature of the linear interpolation of the values
+    const GaussLaguerreIntegration integration(order);
+    const Real eta = klugeProcess->eta();
+    const Real lambda = klugeProcess->jumpIntensity();
+    const Real tol = 1e-12;
+
+    for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+         ++iter) {
+        const Size i = iter.coordinates()[0], j = iter.coordinates()[1];
+        const LinearInterpolation interpolation(y.begin(), y.end(),
+                                                values.row_begin(i));
+        Real integral = 0.0;
+        for (Size k=0; k < order; ++k) {
+            const Real u = integration.x()[k];
+            integral += integration.weights()[k]*std::exp(-u)
+                * interpolation(y[j] + u/eta, true);
+        }
+        const Real expected = lambda*(integral - f[iter.index()]);
+
+        const Real diff = std::fabs(calculated[iter.index()] - expected);
+        if (diff > tol*std::max(1.0, std::fabs(expected))) {
+            BOOST_ERROR("Failed to reproduce jump integral" <<
+                     "\n    expected  : " << expected <<
+                     "\n    calculated: " << calculated[iter.index()] <<
+                     "\n    diff      : " << diff);
+        }
+        if (calculatedInPlace[iter.index()] != calculated[iter.index()]) {
+            BOOST_ERROR("Failed to reproduce jump integral in place" <<
+                     "\n    expected  : " << calculated[iter.index()] <<
+                     "\n    calculated: " << calculatedInPlace[iter.index()]);
+        }
+    }
+}
+
+
 test_suite* VPPTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("VPP Test");
 
@@ -975,6 +1062,7 @@ test_suite* VPPTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&VPPTest::testVPPIntrinsicValue));
     suite->add(QUANTLIB_TEST_CASE(
         &VPPTest::testKlugeExtOUMatrixDecomposition));
+    suite->add(QUANTLIB_TEST_CASE(&VPPTest::testExtOUJumpIntegral));
 
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(&VPPTest::testVPPPricing));
@@ -34,6 +34,7 @@ class VPPTest {
     static void testVPPIntrinsicValue();
     static void testVPPPricing();
     static void testKlugeExtOUMatrixDecomposition();
+    static void testExtOUJumpIntegral();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 